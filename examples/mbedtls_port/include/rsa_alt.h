@@ -87,6 +87,9 @@ typedef struct mbedtls_rsa_context
                                      as specified in md.h for use in the MGF
                                      mask generating function used in the
                                      EME-OAEP and EMSA-PSS encodings. */
+    unsigned char *public_key;  /*!<  Cached public key (N, E) in the OPTIGA
+                                      format, built on the first use. */
+    size_t public_key_len;      /*!<  The size of \p public_key in Bytes. */
 #if defined(MBEDTLS_THREADING_C)
     mbedtls_threading_mutex_t mutex;    /*!<  Thread-safety mutex. */
 #endif
@@ -0,0 +1,118 @@
+/**
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \file trustm_crypt_pool.h
+*
+* \brief   This file declares the pool of crypt instances and the scratch arenas, which are shared by the mbedTLS
+*          alternative implementations.
+*
+* @{
+*/
+#ifndef TRUSTM_CRYPT_POOL_H
+#define TRUSTM_CRYPT_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "optiga/optiga_crypt.h"
+
+/// Number of long-lived crypt instances, which serve the operations of the port
+#ifndef TRUSTM_CRYPT_POOL_SIZE
+#define TRUSTM_CRYPT_POOL_SIZE      (2)
+#endif
+
+/// Size of a scratch arena in bytes, which holds the buffers of one operation of the port. The largest are the
+/// decrypted and the encoded block of RSA 2048 verification on host, the DER public key and signature of P-521 are smaller
+#ifndef TRUSTM_SCRATCH_ARENA_SIZE
+#define TRUSTM_SCRATCH_ARENA_SIZE   (0x200)
+#endif
+
+/// Number of scratch arenas, one for each thread which performs an operation of the port at the same time
+#ifndef TRUSTM_SCRATCH_ARENA_COUNT
+#define TRUSTM_SCRATCH_ARENA_COUNT  (TRUSTM_CRYPT_POOL_SIZE)
+#endif
+
+/**
+ * \brief Acquires a crypt instance for one operation of the port.
+ *
+ * \details
+ * Takes a free instance of the pool. The instances are created with the first use and kept afterwards,
+ * hence no heap allocation and registration with the command layer is done per operation.
+ * - If all the instances of the pool are in use, a temporary instance is created, which is destroyed on release.
+ *
+ * \param[in]      handler                       Callback handler, invoked on completion of the operations of the instance.
+ * \param[in]      caller_context                Context of the caller, provided to the callback handler.
+ *
+ * \retval         Pointer to the crypt instance, NULL if no instance is available.
+ */
+optiga_crypt_t * trustm_crypt_acquire(callback_handler_t handler, void * caller_context);
+
+/**
+ * \brief Releases the crypt instance acquired using #trustm_crypt_acquire.
+ *
+ * \details
+ * Returns the instance to the pool, a temporary instance is destroyed.
+ *
+ * \note
+ * - The operation of the instance must be completed. NULL is ignored.
+ *
+ * \param[in]      me                            Crypt instance from #trustm_crypt_acquire.
+ */
+void trustm_crypt_release(optiga_crypt_t * me);
+
+/**
+ * \brief Acquires a scratch arena for the buffers of one operation of the port.
+ *
+ * \details
+ * Takes a free arena of #TRUSTM_SCRATCH_ARENA_SIZE bytes out of static memory, which replaces the buffers of the
+ * DER public keys, signatures and RSA blocks on the stack and the heap.
+ * - If all the arenas are in use, a temporary arena is allocated on the heap, which is freed on release.
+ *   Set #TRUSTM_SCRATCH_ARENA_COUNT to the number of threads using the port, to avoid any allocation.
+ *
+ * \retval         Pointer to the arena, NULL if no arena is available.
+ */
+uint8_t * trustm_scratch_acquire(void);
+
+/**
+ * \brief Releases the scratch arena acquired using #trustm_scratch_acquire.
+ *
+ * \details
+ * Clears the arena, since it may hold secrets (e.g. shared secret), and returns it. A temporary arena is freed.
+ *
+ * \note
+ * - NULL is ignored.
+ *
+ * \param[in]      p_arena                       Arena from #trustm_scratch_acquire.
+ */
+void trustm_scratch_release(uint8_t * p_arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*TRUSTM_CRYPT_POOL_H*/
+
+/**
+* @}
+*/
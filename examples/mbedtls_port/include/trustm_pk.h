@@ -0,0 +1,120 @@
+/**
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \file trustm_pk.h
+*
+* \brief   This file declares the mbedTLS PK contexts, of which the private key is stored in OPTIGA.
+*
+* @{
+*/
+#ifndef TRUSTM_PK_H
+#define TRUSTM_PK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include "mbedtls/pk.h"
+#include "optiga/optiga_crypt.h"
+
+#if defined(MBEDTLS_PK_C)
+
+/**
+ * \brief Sets up a PK context with an ECC private key of OPTIGA.
+ *
+ * \details
+ * The context is of type MBEDTLS_PK_ECKEY and holds the public key as mbedtls_ecp_keypair, hence mbedtls_pk_ec
+ * and the key writers can be used. Only the signature is generated by OPTIGA, the verification runs on the host.
+ * - Other PK contexts are not affected, the ECDSA alternative implementations of the port are not required.
+ *
+ * \param[in,out]  pk                            PK context, must be initialized using mbedtls_pk_init.
+ * \param[in]      key_id                        OPTIGA key, e.g. OPTIGA_KEY_ID_E0F0.
+ * \param[in]      public_key                    Public key of the OPTIGA key, e.g. pk of the device certificate.
+ *
+ * \retval         0                             Successful invocation.
+ * \retval         MBEDTLS_ERR_PK_TYPE_MISMATCH  public_key is not an ECC key.
+ * \retval         MBEDTLS_ERR_PK_ALLOC_FAILED   Context could not be allocated.
+ */
+int trustm_pk_setup_ecdsa(mbedtls_pk_context * pk, optiga_key_id_t key_id, const mbedtls_pk_context * public_key);
+
+/**
+ * \brief Sets up a PK context with an RSA private key of OPTIGA.
+ *
+ * \details
+ * The context is of type MBEDTLS_PK_RSA and holds the public key as mbedtls_rsa_context, hence mbedtls_pk_rsa
+ * can be used. PKCS#1 v1.5 signature (SHA-256, SHA-384) and decryption are performed by OPTIGA,
+ * the verification and encryption run on the host.
+ *
+ * \param[in,out]  pk                            PK context, must be initialized using mbedtls_pk_init.
+ * \param[in]      key_id                        OPTIGA key, e.g. OPTIGA_KEY_ID_E0FC.
+ * \param[in]      public_key                    Public key of the OPTIGA key, e.g. pk of the device certificate.
+ *
+ * \retval         0                             Successful invocation.
+ * \retval         MBEDTLS_ERR_PK_TYPE_MISMATCH  public_key is not an RSA key.
+ * \retval         MBEDTLS_ERR_PK_ALLOC_FAILED   Context could not be allocated.
+ */
+int trustm_pk_setup_rsa(mbedtls_pk_context * pk, optiga_key_id_t key_id, const mbedtls_pk_context * public_key);
+
+#if defined(MBEDTLS_MD_C)
+/**
+ * \brief Signs the data with host digest.
+ *
+ * \details
+ * Hashes the data with the message digest of mbedTLS and signs the digest with the key of the PK context.
+ * For a context from #trustm_pk_setup_ecdsa or #trustm_pk_setup_rsa, this is one command to OPTIGA per signature,
+ * no optiga_crypt_hash is used. The same applies to mbedtls_x509write_csr_der and mbedtls_x509write_crt_der
+ * with such a context set as key, since the writers hash the TBS data on host as well.
+ *
+ * \param[in]      pk                            PK context of the signing key.
+ * \param[in]      md_alg                        Message digest, e.g. MBEDTLS_MD_SHA256.
+ * \param[in]      data                          Data to be signed.
+ * \param[in]      data_len                      Length of the data.
+ * \param[out]     sig                           Signature, at least MBEDTLS_PK_SIGNATURE_MAX_SIZE bytes.
+ * \param[out]     sig_len                       Length of the signature.
+ *
+ * \retval         0                             Successful invocation.
+ * \retval         MBEDTLS_ERR_PK_BAD_INPUT_DATA md_alg is not available.
+ * \retval         Error code                    As returned by mbedtls_md or mbedtls_pk_sign.
+ */
+int trustm_pk_sign_data(mbedtls_pk_context * pk, mbedtls_md_type_t md_alg,
+                        const unsigned char * data, size_t data_len,
+                        unsigned char * sig, size_t * sig_len);
+#endif //MBEDTLS_MD_C
+
+#endif //MBEDTLS_PK_C
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*TRUSTM_PK_H*/
+
+/**
+* @}
+*/
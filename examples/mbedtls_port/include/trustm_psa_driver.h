@@ -0,0 +1,331 @@
+/**
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \file trustm_psa_driver.h
+*
+* \brief   This file declares the PSA Crypto driver of OPTIGA, for the PSA Crypto API of mbedTLS 3.x.
+*
+* \details
+* The driver is built with TRUSTM_PSA_DRIVER_ENABLED and complements the *_ALT port of mbedTLS 2.x.
+* - Opaque keys of the location #TRUSTM_PSA_LOCATION refer to a key or secret of OPTIGA, the key buffer holds the
+*   OID (2 bytes, big endian). Sign hash, key agreement, HMAC and AES (ECB, CBC without padding) are performed by
+*   OPTIGA with these keys.
+* - As transparent driver, the ECDSA verification with a public key and the entropy are provided.
+* - The multipart MAC and cipher operations are mapped onto the start, update/continue and final sequences of
+*   OPTIGA. The operation keeps a crypt instance for the whole sequence and holds back the data, which is
+*   required for the final command.
+* - #trustm_psa_sign_hash_start and #trustm_psa_sign_hash_complete sign without blocking, following the
+*   interruptible sign hash of PSA.
+* The operation types are listed in the driver description, hence the PSA core embeds them into its operations.
+*
+* @{
+*/
+#ifndef TRUSTM_PSA_DRIVER_H
+#define TRUSTM_PSA_DRIVER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef TRUSTM_PSA_DRIVER_ENABLED
+
+#include "psa/crypto.h"
+#include "optiga/optiga_crypt.h"
+
+/// Location of the OPTIGA keys, in the vendor range of the PSA key locations
+#ifndef TRUSTM_PSA_LOCATION
+#define TRUSTM_PSA_LOCATION                 ((psa_key_location_t)0x800001)
+#endif
+/// Size of the key buffer of an opaque key, the OID
+#define TRUSTM_PSA_KEY_BUFFER_SIZE          (2)
+/// Size of the MAC data, which is held back until the next update or the finish
+#ifndef TRUSTM_PSA_MAC_BUFFER_SIZE
+#define TRUSTM_PSA_MAC_BUFFER_SIZE          (0x40)
+#endif
+/// Block size of AES
+#define TRUSTM_PSA_AES_BLOCK_SIZE           (16)
+/// Size of the signature of OPTIGA, sufficient for RSA 2048
+#define TRUSTM_PSA_SIGNATURE_SIZE           (0x100)
+
+/** \brief Sign hash operation, signs without blocking the caller */
+typedef struct trustm_psa_sign_hash_operation
+{
+    /// Crypt instance, acquired until the completion
+    optiga_crypt_t * me;
+    /// Status of the OPTIGA operation, updated by the callback handler
+    volatile optiga_lib_status_t status;
+    /// Copy of the digest, which is taken by OPTIGA after the start
+    uint8_t hash[64];
+    /// Signature of OPTIGA
+    uint8_t signature[TRUSTM_PSA_SIGNATURE_SIZE];
+    /// Length of the signature of OPTIGA
+    uint16_t signature_length;
+    /// Length of r and s in the PSA signature, 0 for RSA
+    uint16_t curve_length;
+}trustm_psa_sign_hash_operation_t;
+
+#ifdef OPTIGA_CRYPT_HMAC_ENABLED
+/** \brief Multipart MAC operation on an HMAC secret of OPTIGA */
+typedef struct trustm_psa_mac_operation
+{
+    /// Crypt instance, acquired for the sequence
+    optiga_crypt_t * me;
+    /// Status of the OPTIGA operation, updated by the callback handler
+    volatile optiga_lib_status_t status;
+    /// OID of the secret
+    uint16_t secret;
+    /// HMAC type of OPTIGA
+    optiga_hmac_type_t type;
+    /// Indicates the hmac start is sent
+    uint8_t started;
+    /// Data held back for the next command
+    uint8_t pending[TRUSTM_PSA_MAC_BUFFER_SIZE];
+    /// Length of the data held back
+    uint32_t pending_length;
+}trustm_psa_mac_operation_t;
+#endif //OPTIGA_CRYPT_HMAC_ENABLED
+
+#if defined (OPTIGA_CRYPT_SYM_ENCRYPT_ENABLED) && defined (OPTIGA_CRYPT_SYM_DECRYPT_ENABLED)
+/** \brief Multipart cipher operation on an AES key of OPTIGA */
+typedef struct trustm_psa_cipher_operation
+{
+    /// Crypt instance, acquired for the sequence
+    optiga_crypt_t * me;
+    /// Status of the OPTIGA operation, updated by the callback handler
+    volatile optiga_lib_status_t status;
+    /// OID of the key
+    optiga_key_id_t key;
+    /// Mode of OPTIGA
+    optiga_symmetric_encryption_mode_t mode;
+    /// TRUE for encryption
+    uint8_t encrypt;
+    /// Indicates the start is sent
+    uint8_t started;
+    /// IV of CBC
+    uint8_t iv[TRUSTM_PSA_AES_BLOCK_SIZE];
+    /// Length of the IV, 0 for ECB
+    uint16_t iv_length;
+    /// Block held back for the next command
+    uint8_t pending[TRUSTM_PSA_AES_BLOCK_SIZE];
+    /// Length of the data held back
+    uint32_t pending_length;
+}trustm_psa_cipher_operation_t;
+#endif //OPTIGA_CRYPT_SYM_ENCRYPT_ENABLED && OPTIGA_CRYPT_SYM_DECRYPT_ENABLED
+
+/**
+ * \brief Size of the key buffer of an opaque key (size_function of the driver description).
+ */
+size_t trustm_psa_opaque_size_function(psa_key_type_t key_type, size_t key_bits);
+
+/**
+ * \brief Imports an opaque key, the data is the OID of the key or secret in OPTIGA (2 bytes, big endian).
+ *
+ * \note
+ * - The key is not transferred to OPTIGA, the key bits must be set in the attributes.
+ */
+psa_status_t trustm_psa_opaque_import_key(const psa_key_attributes_t * attributes,
+                                          const uint8_t * data,
+                                          size_t data_length,
+                                          uint8_t * key_buffer,
+                                          size_t key_buffer_size,
+                                          size_t * key_buffer_length,
+                                          size_t * bits);
+
+/**
+ * \brief Generates the signature of the hash with an ECC or RSA key of OPTIGA (ECDSA, RSA PKCS#1 v1.5 SHA-256/384).
+ */
+psa_status_t trustm_psa_opaque_sign_hash(const psa_key_attributes_t * attributes,
+                                         const uint8_t * key_buffer,
+                                         size_t key_buffer_size,
+                                         psa_algorithm_t alg,
+                                         const uint8_t * hash,
+                                         size_t hash_length,
+                                         uint8_t * signature,
+                                         size_t signature_size,
+                                         size_t * signature_length);
+
+/**
+ * \brief Starts the signature of the hash, without waiting for OPTIGA.
+ *
+ * \details
+ * Same arguments as #trustm_psa_opaque_sign_hash. The hash is copied into the operation.
+ *
+ * \retval         PSA_SUCCESS                   The operation is started, complete using #trustm_psa_sign_hash_complete.
+ */
+psa_status_t trustm_psa_sign_hash_start(trustm_psa_sign_hash_operation_t * operation,
+                                        const psa_key_attributes_t * attributes,
+                                        const uint8_t * key_buffer,
+                                        size_t key_buffer_size,
+                                        psa_algorithm_t alg,
+                                        const uint8_t * hash,
+                                        size_t hash_length);
+
+/**
+ * \brief Completes the signature started using #trustm_psa_sign_hash_start.
+ *
+ * \details
+ * Returns without waiting, if OPTIGA has not completed the signature. The operation is released on completion.
+ *
+ * \retval         PSA_OPERATION_INCOMPLETE      The signature is not yet completed, retry later.
+ * \retval         PSA_SUCCESS                   The signature is provided.
+ */
+psa_status_t trustm_psa_sign_hash_complete(trustm_psa_sign_hash_operation_t * operation,
+                                           uint8_t * signature,
+                                           size_t signature_size,
+                                           size_t * signature_length);
+
+/**
+ * \brief Aborts the signature started using #trustm_psa_sign_hash_start.
+ *
+ * \note
+ * - OPTIGA can't abort the command, hence the completion is awaited.
+ */
+psa_status_t trustm_psa_sign_hash_abort(trustm_psa_sign_hash_operation_t * operation);
+
+/**
+ * \brief Verifies an ECDSA signature with a public key (transparent driver), by OPTIGA.
+ *
+ * \retval         PSA_ERROR_NOT_SUPPORTED       Key or algorithm is left to the software implementation.
+ */
+psa_status_t trustm_psa_verify_hash(const psa_key_attributes_t * attributes,
+                                    const uint8_t * key_buffer,
+                                    size_t key_buffer_size,
+                                    psa_algorithm_t alg,
+                                    const uint8_t * hash,
+                                    size_t hash_length,
+                                    const uint8_t * signature,
+                                    size_t signature_length);
+
+/**
+ * \brief Calculates the ECDH shared secret with an ECC key of OPTIGA and the peer public key (0x04 || X || Y).
+ */
+psa_status_t trustm_psa_opaque_key_agreement(const psa_key_attributes_t * attributes,
+                                             const uint8_t * key_buffer,
+                                             size_t key_buffer_size,
+                                             psa_algorithm_t alg,
+                                             const uint8_t * peer_key,
+                                             size_t peer_key_length,
+                                             uint8_t * shared_secret,
+                                             size_t shared_secret_size,
+                                             size_t * shared_secret_length);
+
+/**
+ * \brief Provides the entropy of the TRNG of OPTIGA (entropy driver).
+ */
+psa_status_t trustm_psa_get_entropy(uint32_t flags,
+                                    size_t * estimate_bits,
+                                    uint8_t * output,
+                                    size_t output_size);
+
+#ifdef OPTIGA_CRYPT_HMAC_ENABLED
+/**
+ * \brief Sets up an HMAC operation with a secret of OPTIGA.
+ */
+psa_status_t trustm_psa_opaque_mac_sign_setup(trustm_psa_mac_operation_t * operation,
+                                              const psa_key_attributes_t * attributes,
+                                              const uint8_t * key_buffer,
+                                              size_t key_buffer_size,
+                                              psa_algorithm_t alg);
+
+/**
+ * \brief Adds data to the HMAC operation.
+ */
+psa_status_t trustm_psa_opaque_mac_update(trustm_psa_mac_operation_t * operation,
+                                          const uint8_t * input,
+                                          size_t input_length);
+
+/**
+ * \brief Finishes the HMAC operation and provides the MAC.
+ */
+psa_status_t trustm_psa_opaque_mac_sign_finish(trustm_psa_mac_operation_t * operation,
+                                               uint8_t * mac,
+                                               size_t mac_size,
+                                               size_t * mac_length);
+
+/**
+ * \brief Aborts the HMAC operation.
+ */
+psa_status_t trustm_psa_opaque_mac_abort(trustm_psa_mac_operation_t * operation);
+#endif //OPTIGA_CRYPT_HMAC_ENABLED
+
+#if defined (OPTIGA_CRYPT_SYM_ENCRYPT_ENABLED) && defined (OPTIGA_CRYPT_SYM_DECRYPT_ENABLED)
+/**
+ * \brief Sets up an AES encryption with a key of OPTIGA (PSA_ALG_ECB_NO_PADDING, PSA_ALG_CBC_NO_PADDING).
+ */
+psa_status_t trustm_psa_opaque_cipher_encrypt_setup(trustm_psa_cipher_operation_t * operation,
+                                                    const psa_key_attributes_t * attributes,
+                                                    const uint8_t * key_buffer,
+                                                    size_t key_buffer_size,
+                                                    psa_algorithm_t alg);
+
+/**
+ * \brief Sets up an AES decryption with a key of OPTIGA (PSA_ALG_ECB_NO_PADDING, PSA_ALG_CBC_NO_PADDING).
+ */
+psa_status_t trustm_psa_opaque_cipher_decrypt_setup(trustm_psa_cipher_operation_t * operation,
+                                                    const psa_key_attributes_t * attributes,
+                                                    const uint8_t * key_buffer,
+                                                    size_t key_buffer_size,
+                                                    psa_algorithm_t alg);
+
+/**
+ * \brief Sets the IV of the CBC operation.
+ */
+psa_status_t trustm_psa_opaque_cipher_set_iv(trustm_psa_cipher_operation_t * operation,
+                                             const uint8_t * iv,
+                                             size_t iv_length);
+
+/**
+ * \brief Processes the input, the output is provided for the blocks which are not held back.
+ */
+psa_status_t trustm_psa_opaque_cipher_update(trustm_psa_cipher_operation_t * operation,
+                                             const uint8_t * input,
+                                             size_t input_length,
+                                             uint8_t * output,
+                                             size_t output_size,
+                                             size_t * output_length);
+
+/**
+ * \brief Processes the block held back and completes the sequence.
+ */
+psa_status_t trustm_psa_opaque_cipher_finish(trustm_psa_cipher_operation_t * operation,
+                                             uint8_t * output,
+                                             size_t output_size,
+                                             size_t * output_length);
+
+/**
+ * \brief Aborts the cipher operation.
+ */
+psa_status_t trustm_psa_opaque_cipher_abort(trustm_psa_cipher_operation_t * operation);
+#endif //OPTIGA_CRYPT_SYM_ENCRYPT_ENABLED && OPTIGA_CRYPT_SYM_DECRYPT_ENABLED
+
+#endif //TRUSTM_PSA_DRIVER_ENABLED
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*TRUSTM_PSA_DRIVER_H*/
+
+/**
+* @}
+*/
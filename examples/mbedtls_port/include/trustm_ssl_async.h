@@ -0,0 +1,151 @@
+/**
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \file trustm_ssl_async.h
+*
+* \brief   This file declares the asynchronous private key operations of mbedTLS (MBEDTLS_SSL_ASYNC_PRIVATE),
+*          which are executed by OPTIGA using the crypt completion queue.
+*
+* @{
+*/
+#ifndef TRUSTM_SSL_ASYNC_H
+#define TRUSTM_SSL_ASYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include "mbedtls/ssl.h"
+#include "optiga/optiga_crypt_cq.h"
+
+#if defined(MBEDTLS_SSL_ASYNC_PRIVATE) && defined(OPTIGA_CRYPT_CQ_ENABLED)
+
+/// Number of private key operations in flight, one per handshake waiting for OPTIGA
+#ifndef TRUSTM_SSL_ASYNC_DEPTH
+#define TRUSTM_SSL_ASYNC_DEPTH          (2)
+#endif
+/// Size of the input and output buffer of an operation, sufficient for RSA 2048
+#ifndef TRUSTM_SSL_ASYNC_BUFFER_SIZE
+#define TRUSTM_SSL_ASYNC_BUFFER_SIZE    (0x100)
+#endif
+
+/** \brief Private key operation of a handshake */
+typedef struct trustm_ssl_async_operation
+{
+    /// Copy of the hash or ciphertext, which is valid only during the start callback of mbedTLS
+    uint8_t input[TRUSTM_SSL_ASYNC_BUFFER_SIZE];
+    /// Signature or decrypted data, an ECDSA signature leaves room for the SEQUENCE header
+    uint8_t output[TRUSTM_SSL_ASYNC_BUFFER_SIZE + 4];
+    /// Length of the output
+    uint16_t output_length;
+    /// Status of the completed operation
+    optiga_lib_status_t status;
+    /// Indicates the output is an ECDSA signature
+    uint8_t is_ecdsa;
+    /// Indicates the operation is completed by OPTIGA
+    uint8_t completed;
+    /// Indicates the handshake is closed, the operation is released once completed
+    uint8_t cancelled;
+    /// Indicates the operation is in use
+    uint8_t in_use;
+}trustm_ssl_async_operation_t;
+
+/** \brief Asynchronous private key operations of an mbedTLS configuration */
+typedef struct trustm_ssl_async
+{
+    /// Completion queue, which executes the operations
+    optiga_crypt_cq_t cq;
+    /// Slots of the completion queue
+    optiga_crypt_cq_slot_t slots[TRUSTM_SSL_ASYNC_DEPTH];
+    /// Operations, one per slot
+    trustm_ssl_async_operation_t operations[TRUSTM_SSL_ASYNC_DEPTH];
+    /// Private key of the ECC certificate
+    optiga_key_id_t ecc_private_key;
+    /// Private key of the RSA certificate
+    optiga_key_id_t rsa_private_key;
+}trustm_ssl_async_t;
+
+/**
+ * \brief Registers the asynchronous private key operations of OPTIGA with the configuration.
+ *
+ * \details
+ * Initializes the completion queue and registers the callbacks using mbedtls_ssl_conf_async_private_cb.
+ * - The sign start and decrypt start callbacks submit the operation and return MBEDTLS_ERR_SSL_ASYNC_IN_PROGRESS.
+ * - The resume callback reaps the completion queue and returns the output, once the operation is completed.
+ * - Hence a single-threaded server keeps the other handshakes progressing, while OPTIGA works. The descriptor from
+ *   #trustm_ssl_async_get_descriptor becomes readable, when a handshake is ready to be continued.
+ *
+ * \note
+ * - ECDSA signatures, RSA PKCS1 v1.5 signatures with SHA256 or SHA384 and RSA PKCS1 v1.5 decryption are supported.
+ *   Other operations fall through to the private key of mbedTLS.
+ * - The time of the RSA decryption is defined by OPTIGA and does not depend on the result of the padding check on host.
+ *
+ * \param[in,out]  p_async                       Asynchronous operations, must be valid until #trustm_ssl_async_free.
+ * \param[in,out]  conf                          mbedTLS configuration.
+ * \param[in]      ecc_private_key               OPTIGA OID of the private key of the ECC certificate.
+ * \param[in]      rsa_private_key               OPTIGA OID of the private key of the RSA certificate.
+ *
+ * \retval         0                             Successful invocation.
+ * \retval         MBEDTLS_ERR_PK_ALLOC_FAILED   Initialization of the completion queue failed.
+ */
+int trustm_ssl_async_setup(trustm_ssl_async_t * p_async,
+                           mbedtls_ssl_config * conf,
+                           optiga_key_id_t ecc_private_key,
+                           optiga_key_id_t rsa_private_key);
+
+/**
+ * \brief Provides the pollable descriptor, which becomes readable when an operation is completed.
+ *
+ * \param[in]      p_async                       Asynchronous operations from #trustm_ssl_async_setup.
+ *
+ * \retval         Descriptor, -1 if the platform does not provide a pollable descriptor (Refer #optiga_crypt_cq_get_descriptor).
+ */
+int trustm_ssl_async_get_descriptor(const trustm_ssl_async_t * p_async);
+
+/**
+ * \brief Releases the completion queue of the asynchronous operations.
+ *
+ * \note
+ * - All the handshakes using the configuration must be closed and their operations completed.
+ *
+ * \param[in,out]  p_async                       Asynchronous operations from #trustm_ssl_async_setup.
+ */
+void trustm_ssl_async_free(trustm_ssl_async_t * p_async);
+
+#endif //MBEDTLS_SSL_ASYNC_PRIVATE && OPTIGA_CRYPT_CQ_ENABLED
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*TRUSTM_SSL_ASYNC_H*/
+
+/**
+* @}
+*/
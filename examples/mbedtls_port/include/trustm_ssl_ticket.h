@@ -0,0 +1,168 @@
+/**
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \file trustm_ssl_ticket.h
+*
+* \brief   This file declares the session ticket keys of mbedTLS (MBEDTLS_SSL_SESSION_TICKETS), which are derived
+*          by OPTIGA from a secret held in the chip.
+*
+* @{
+*/
+#ifndef TRUSTM_SSL_TICKET_H
+#define TRUSTM_SSL_TICKET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include "mbedtls/ssl.h"
+#include "mbedtls/gcm.h"
+#if defined(MBEDTLS_THREADING_C)
+#include "mbedtls/threading.h"
+#endif
+#include "optiga/optiga_crypt.h"
+
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_SRV_C) && defined(MBEDTLS_GCM_C) && \
+    defined(MBEDTLS_HAVE_TIME) && defined(OPTIGA_CRYPT_HKDF_ENABLED)
+
+/// Label of the HKDF info, followed by the epoch of the key (big endian)
+#ifndef TRUSTM_SSL_TICKET_LABEL
+#define TRUSTM_SSL_TICKET_LABEL             "trustm tls ticket key"
+#endif
+/// Size of the AES-GCM key of a ticket
+#define TRUSTM_SSL_TICKET_KEY_SIZE          (32)
+/// Size of the key name, which is the first field of a ticket
+#define TRUSTM_SSL_TICKET_KEY_NAME_SIZE     (4)
+
+/** \brief Ticket key of an epoch, cached on host until the next but one epoch */
+typedef struct trustm_ssl_ticket_key
+{
+    /// AES-256-GCM context of the key
+    mbedtls_gcm_context gcm;
+    /// Key name, derived together with the key
+    uint8_t name[TRUSTM_SSL_TICKET_KEY_NAME_SIZE];
+    /// Epoch of the key (time / rotation interval)
+    uint32_t epoch;
+    /// Indicates the key is derived
+    uint8_t valid;
+}trustm_ssl_ticket_key_t;
+
+/** \brief Session ticket keys of an mbedTLS configuration */
+typedef struct trustm_ssl_ticket
+{
+    /// Key of the current epoch and key of the previous epoch
+    trustm_ssl_ticket_key_t keys[2];
+    /// Index of the key of the current epoch
+    uint8_t active;
+    /// OPTIGA OID of the secret, from which the keys are derived
+    uint16_t secret_oid;
+    /// Rotation interval of the keys in seconds, which is also the lifetime of a ticket
+    uint32_t rotation_interval;
+    /// Number of keys derived by OPTIGA
+    uint32_t derivations;
+    /// Random generator of the IVs
+    int (*f_rng)(void *, unsigned char *, size_t);
+    /// Context of the random generator
+    void * p_rng;
+#if defined(MBEDTLS_THREADING_C)
+    /// Serializes the handshakes of the configuration
+    mbedtls_threading_mutex_t mutex;
+#endif
+}trustm_ssl_ticket_t;
+
+/**
+ * \brief Registers the session ticket keys of OPTIGA with the configuration.
+ *
+ * \details
+ * Derives the key of the current epoch and registers the callbacks using mbedtls_ssl_conf_session_tickets_cb.
+ * - The key of an epoch (mbedtls_time / rotation_interval) is derived with #optiga_crypt_hkdf (SHA256) from the secret
+ *   in OPTIGA, with the info #TRUSTM_SSL_TICKET_LABEL || epoch. The derived key is kept on host for two epochs, hence
+ *   OPTIGA is used once per rotation instead of once per handshake.
+ * - The ticket format is the one of mbedtls_ssl_ticket_write (key name, IV, encrypted state, tag).
+ * - A ticket of an unknown or older key is rejected and mbedTLS falls back to a full handshake.
+ *
+ * \note
+ * - The secret must be a data object of type PRESSEC or a session context, which allows the derivation
+ *   (Refer #optiga_crypt_hkdf). The keys do not depend on the host, hence the tickets survive a restart and are accepted
+ *   by all the servers sharing the secret.
+ *
+ * \param[in,out]  p_ticket                      Ticket keys, must be valid until #trustm_ssl_ticket_free.
+ * \param[in,out]  conf                          mbedTLS configuration.
+ * \param[in]      f_rng                         Random generator of the IVs.
+ * \param[in]      p_rng                         Context of the random generator.
+ * \param[in]      secret_oid                    OPTIGA OID of the secret.
+ * \param[in]      rotation_interval             Rotation interval of the keys in seconds, must not be 0.
+ *
+ * \retval         0                             Successful invocation.
+ * \retval         MBEDTLS_ERR_SSL_BAD_INPUT_DATA   Invalid rotation interval.
+ * \retval         MBEDTLS_ERR_SSL_HW_ACCEL_FAILED  Derivation of the key by OPTIGA failed.
+ */
+int trustm_ssl_ticket_setup(trustm_ssl_ticket_t * p_ticket,
+                            mbedtls_ssl_config * conf,
+                            int (*f_rng)(void *, unsigned char *, size_t),
+                            void * p_rng,
+                            uint16_t secret_oid,
+                            uint32_t rotation_interval);
+
+/**
+ * \brief Writes the session ticket (mbedtls_ssl_ticket_write_t), the key is rotated at the start of an epoch.
+ */
+int trustm_ssl_ticket_write(void * p_ticket,
+                            const mbedtls_ssl_session * session,
+                            unsigned char * start,
+                            const unsigned char * end,
+                            size_t * tlen,
+                            uint32_t * lifetime);
+
+/**
+ * \brief Parses the session ticket (mbedtls_ssl_ticket_parse_t), without involving OPTIGA.
+ */
+int trustm_ssl_ticket_parse(void * p_ticket,
+                            mbedtls_ssl_session * session,
+                            unsigned char * buf,
+                            size_t len);
+
+/**
+ * \brief Releases the ticket keys and clears the cached keys.
+ *
+ * \param[in,out]  p_ticket                      Ticket keys from #trustm_ssl_ticket_setup.
+ */
+void trustm_ssl_ticket_free(trustm_ssl_ticket_t * p_ticket);
+
+#endif //MBEDTLS_SSL_SESSION_TICKETS && MBEDTLS_SSL_SRV_C && MBEDTLS_GCM_C && MBEDTLS_HAVE_TIME && OPTIGA_CRYPT_HKDF_ENABLED
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*TRUSTM_SSL_TICKET_H*/
+
+/**
+* @}
+*/
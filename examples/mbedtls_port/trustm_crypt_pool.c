@@ -0,0 +1,196 @@
+/**
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \file trustm_crypt_pool.c
+*
+* \brief   This file implements the pool of crypt instances and the scratch arenas, which are shared by the mbedTLS
+*          alternative implementations.
+*
+* @{
+*/
+
+#include "trustm_crypt_pool.h"
+#include "optiga/pal/pal_os_lock.h"
+#include "optiga/pal/pal_os_memory.h"
+
+/** \brief Crypt instance of the pool */
+typedef struct trustm_crypt_pool_entry
+{
+    /// Crypt instance, created with the first use
+    optiga_crypt_t * me;
+    /// Callback handler of the current user of the instance
+    callback_handler_t handler;
+    /// Context of the current user of the instance
+    void * caller_context;
+    /// Indicates the instance is acquired
+    uint8_t in_use;
+}trustm_crypt_pool_entry_t;
+
+static trustm_crypt_pool_entry_t trustm_crypt_pool[TRUSTM_CRYPT_POOL_SIZE];
+
+static uint8_t trustm_scratch_arena[TRUSTM_SCRATCH_ARENA_COUNT][TRUSTM_SCRATCH_ARENA_SIZE];
+static uint8_t trustm_scratch_arena_in_use[TRUSTM_SCRATCH_ARENA_COUNT];
+
+/*
+* Forwards the completion of the operation to the current user of the instance
+*/
+static void trustm_crypt_pool_event_handler(void * context, optiga_lib_status_t return_status)
+{
+    trustm_crypt_pool_entry_t * p_entry = (trustm_crypt_pool_entry_t *)context;
+
+    if (NULL != p_entry->handler)
+    {
+        p_entry->handler(p_entry->caller_context, return_status);
+    }
+}
+
+optiga_crypt_t * trustm_crypt_acquire(callback_handler_t handler, void * caller_context)
+{
+    trustm_crypt_pool_entry_t * p_entry = NULL;
+    optiga_crypt_t * me = NULL;
+    uint8_t index;
+
+    pal_os_lock_enter_critical_section();
+    for (index = 0; index < TRUSTM_CRYPT_POOL_SIZE; index++)
+    {
+        if (FALSE == trustm_crypt_pool[index].in_use)
+        {
+            p_entry = &trustm_crypt_pool[index];
+            p_entry->in_use = TRUE;
+            break;
+        }
+    }
+    pal_os_lock_exit_critical_section();
+
+    do
+    {
+        if (NULL == p_entry)
+        {
+            // Pool is exhausted, hence a temporary instance serves the operation
+            me = optiga_crypt_create(0, handler, caller_context);
+            break;
+        }
+        p_entry->handler = handler;
+        p_entry->caller_context = caller_context;
+        if (NULL == p_entry->me)
+        {
+            p_entry->me = optiga_crypt_create(0, trustm_crypt_pool_event_handler, p_entry);
+        }
+        if (NULL == p_entry->me)
+        {
+            p_entry->in_use = FALSE;
+            break;
+        }
+        me = p_entry->me;
+    } while (FALSE);
+
+    return (me);
+}
+
+void trustm_crypt_release(optiga_crypt_t * me)
+{
+    uint8_t index;
+
+    do
+    {
+        if (NULL == me)
+        {
+            break;
+        }
+        for (index = 0; index < TRUSTM_CRYPT_POOL_SIZE; index++)
+        {
+            if (me == trustm_crypt_pool[index].me)
+            {
+                break;
+            }
+        }
+        if (TRUSTM_CRYPT_POOL_SIZE == index)
+        {
+            // Temporary instance
+            (void)optiga_crypt_destroy(me);
+            break;
+        }
+        trustm_crypt_pool[index].handler = NULL;
+        trustm_crypt_pool[index].caller_context = NULL;
+        trustm_crypt_pool[index].in_use = FALSE;
+    } while (FALSE);
+}
+
+uint8_t * trustm_scratch_acquire(void)
+{
+    uint8_t * p_arena = NULL;
+    uint8_t index;
+
+    pal_os_lock_enter_critical_section();
+    for (index = 0; index < TRUSTM_SCRATCH_ARENA_COUNT; index++)
+    {
+        if (FALSE == trustm_scratch_arena_in_use[index])
+        {
+            trustm_scratch_arena_in_use[index] = TRUE;
+            p_arena = trustm_scratch_arena[index];
+            break;
+        }
+    }
+    pal_os_lock_exit_critical_section();
+
+    if (NULL == p_arena)
+    {
+        // All arenas are in use, hence a temporary arena serves the operation
+        p_arena = (uint8_t *)pal_os_calloc(1, TRUSTM_SCRATCH_ARENA_SIZE);
+    }
+    return (p_arena);
+}
+
+void trustm_scratch_release(uint8_t * p_arena)
+{
+    uint8_t index;
+
+    do
+    {
+        if (NULL == p_arena)
+        {
+            break;
+        }
+        pal_os_memset(p_arena, 0x00, TRUSTM_SCRATCH_ARENA_SIZE);
+        for (index = 0; index < TRUSTM_SCRATCH_ARENA_COUNT; index++)
+        {
+            if (p_arena == trustm_scratch_arena[index])
+            {
+                break;
+            }
+        }
+        if (TRUSTM_SCRATCH_ARENA_COUNT == index)
+        {
+            // Temporary arena
+            pal_os_free(p_arena);
+            break;
+        }
+        pal_os_lock_enter_critical_section();
+        trustm_scratch_arena_in_use[index] = FALSE;
+        pal_os_lock_exit_critical_section();
+    } while (FALSE);
+}
+
+/**
+* @}
+*/
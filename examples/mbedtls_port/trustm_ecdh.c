@@ -35,12 +35,17 @@
 #include "optiga/optiga_util.h"
 #include "optiga/pal/pal_os_timer.h"
 #include "optiga/common/optiga_lib_common.h"
+#include "optiga/optiga_crypt_keypair_cache.h"
+#include "trustm_crypt_pool.h"
 
 #define PRINT_ECDH_PUBLICKEY   0
 
 // We use here Session Context ID 0xE103 (you can choose between 0xE100 - E104)
 #define OPTIGA_TRUSTM_KEYID_TO_STORE_PRIVATE_KEY  0xE103
 
+// Size of the DER public key and the shared secret of the largest curve (P-521) in the scratch arena
+#define TRUSTM_ECDH_BUFFER_SIZE    (150)
+
 /**
  * Callback when optiga_crypt_xxxx operation is completed asynchronously
  */
@@ -56,6 +61,14 @@ static void optiga_crypt_event_completed(void * context, optiga_lib_status_t ret
     }
 }
 
+#ifdef OPTIGA_CRYPT_KEYPAIR_CACHE_ENABLED
+// Keypairs of NIST P256 pregenerated in session contexts, initialized with the first handshake
+static optiga_crypt_keypair_cache_t keypair_cache;
+static uint8_t keypair_cache_initialized = FALSE;
+// Crypt instance holding the private key of the ongoing handshake, if taken from the cache
+static optiga_crypt_t * p_keypair_crypt = NULL;
+#endif //OPTIGA_CRYPT_KEYPAIR_CACHE_ENABLED
+
 #ifdef MBEDTLS_ECDH_GEN_PUBLIC_ALT
 /*
  * Generate public key: simple wrapper around mbedtls_ecp_gen_keypair
@@ -65,8 +78,8 @@ int mbedtls_ecdh_gen_public(mbedtls_ecp_group *grp, mbedtls_mpi *d,
 		void *p_rng) {
 
 	int return_status = MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
-	uint8_t public_key[200];
-	size_t public_key_len = sizeof(public_key);
+	uint8_t * public_key = NULL;
+	size_t public_key_len = TRUSTM_ECDH_BUFFER_SIZE;
 	uint8_t public_key_offset = 3;
 	optiga_ecc_curve_t curve_id;
 	optiga_key_id_t optiga_key_id = OPTIGA_TRUSTM_KEYID_TO_STORE_PRIVATE_KEY;
@@ -105,7 +118,53 @@ int mbedtls_ecdh_gen_public(mbedtls_ecp_group *grp, mbedtls_mpi *d,
 		public_key_offset = 4;
 	}
 
-	me = optiga_crypt_create(0, optiga_crypt_event_completed, NULL);
+#ifdef OPTIGA_CRYPT_KEYPAIR_CACHE_ENABLED
+	if (OPTIGA_ECC_CURVE_NIST_P_256 == curve_id)
+	{
+		const uint8_t * p_cached_public_key;
+		uint16_t cached_public_key_length;
+
+		if (FALSE == keypair_cache_initialized)
+		{
+			if (OPTIGA_LIB_SUCCESS == optiga_crypt_keypair_cache_init(&keypair_cache, 0, OPTIGA_ECC_CURVE_NIST_P_256,
+					(uint8_t) (OPTIGA_KEY_USAGE_KEY_AGREEMENT | OPTIGA_KEY_USAGE_AUTHENTICATION)))
+			{
+				keypair_cache_initialized = TRUE;
+			}
+		}
+		// Keypair of an unfinished handshake is not used again
+		if (NULL != p_keypair_crypt)
+		{
+			(void)optiga_crypt_keypair_cache_release(&keypair_cache, p_keypair_crypt);
+			p_keypair_crypt = NULL;
+		}
+		if (TRUE == keypair_cache_initialized)
+		{
+			p_keypair_crypt = optiga_crypt_keypair_cache_acquire(&keypair_cache, optiga_crypt_event_completed, NULL,
+					&p_cached_public_key, &cached_public_key_length);
+		}
+		// If no keypair is ready, it is generated right away
+		if (NULL != p_keypair_crypt)
+		{
+			return_status = MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+			if (mbedtls_ecp_point_read_binary(grp, Q, &p_cached_public_key[public_key_offset], (size_t) cached_public_key_length - public_key_offset) == 0)
+			{
+				return_status = 0;
+			}
+			goto cleanup;
+		}
+	}
+#endif //OPTIGA_CRYPT_KEYPAIR_CACHE_ENABLED
+
+	// Public key is taken from the scratch arena
+	public_key = trustm_scratch_acquire();
+	if (NULL == public_key)
+	{
+		return_status = MBEDTLS_ERR_ECP_ALLOC_FAILED;
+		goto cleanup;
+	}
+
+	me = trustm_crypt_acquire(optiga_crypt_event_completed, NULL);
 	if (NULL == me)
 	{
 		return_status = MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
@@ -145,11 +204,12 @@ int mbedtls_ecdh_gen_public(mbedtls_ecp_group *grp, mbedtls_mpi *d,
 
 	return_status = 0;
 cleanup:
-	// destroy crypt instances
+	// release crypt instances
 	if (me != NULL)
 	{
-		(void)optiga_crypt_destroy(me);
+		trustm_crypt_release(me);
 	}
+	trustm_scratch_release(public_key);
 
 	return return_status;
 
@@ -168,8 +228,8 @@ int mbedtls_ecdh_compute_shared(mbedtls_ecp_group *grp, mbedtls_mpi *z,
 	int return_status = MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
 	public_key_from_host_t pk;
 	size_t pk_size;
-	uint8_t pk_out[150];
-	uint8_t buf[150];
+	uint8_t * pk_out = NULL;
+	uint8_t * buf = NULL;
 	size_t public_key_len = 0;
 	uint8_t publickey_offset = 3;
 	optiga_crypt_t * me = NULL;
@@ -189,6 +249,15 @@ int mbedtls_ecdh_compute_shared(mbedtls_ecp_group *grp, mbedtls_mpi *z,
 		return_status = MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
 		goto cleanup;
 	}
+
+	// Public key and shared secret are taken from the scratch arena, which is cleared on release
+	pk_out = trustm_scratch_acquire();
+	if (NULL == pk_out)
+	{
+		return_status = MBEDTLS_ERR_ECP_ALLOC_FAILED;
+		goto cleanup;
+	}
+	buf = pk_out + TRUSTM_ECDH_BUFFER_SIZE;
 	
 	pk_out[0] = 0x03;
 	pk_out[publickey_offset-2] = 0x42;
@@ -225,7 +294,7 @@ int mbedtls_ecdh_compute_shared(mbedtls_ecp_group *grp, mbedtls_mpi *z,
 	}
 	
 	pk_out[publickey_offset-1] = 0x00;
-	mbedtls_ecp_point_write_binary(grp, Q, MBEDTLS_ECP_PF_UNCOMPRESSED, &pk_size, &pk_out[publickey_offset], 150);
+	mbedtls_ecp_point_write_binary(grp, Q, MBEDTLS_ECP_PF_UNCOMPRESSED, &pk_size, &pk_out[publickey_offset], TRUSTM_ECDH_BUFFER_SIZE - publickey_offset);
 
 	pk.public_key = pk_out;
 	pk.length = pk_size + publickey_offset;
@@ -261,7 +330,18 @@ int mbedtls_ecdh_compute_shared(mbedtls_ecp_group *grp, mbedtls_mpi *z,
     }
 #endif
 
-	me = optiga_crypt_create(0, optiga_crypt_event_completed, NULL);
+#ifdef OPTIGA_CRYPT_KEYPAIR_CACHE_ENABLED
+	// Private key is in the session context of the instance, which is taken from the cache
+	me = p_keypair_crypt;
+	if (NULL != me)
+	{
+		optiga_key_id = OPTIGA_KEY_ID_SESSION_BASED;
+	}
+	else
+#endif //OPTIGA_CRYPT_KEYPAIR_CACHE_ENABLED
+	{
+		me = trustm_crypt_acquire(optiga_crypt_event_completed, NULL);
+	}
 	if (NULL == me)
 	{
 		return_status = MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
@@ -294,11 +374,21 @@ int mbedtls_ecdh_compute_shared(mbedtls_ecp_group *grp, mbedtls_mpi *z,
 	return_status = 0;
 
 cleanup:
-	// destroy crypt instances
+#ifdef OPTIGA_CRYPT_KEYPAIR_CACHE_ENABLED
+	// Keypair is used once, a fresh one is generated into the session context
+	if ((me != NULL) && (me == p_keypair_crypt))
+	{
+		(void)optiga_crypt_keypair_cache_release(&keypair_cache, me);
+		p_keypair_crypt = NULL;
+		me = NULL;
+	}
+#endif //OPTIGA_CRYPT_KEYPAIR_CACHE_ENABLED
+	// release crypt instances
 	if (me != NULL)
 	{
-    	(void)optiga_crypt_destroy(me);
+    	trustm_crypt_release(me);
 	}
+	trustm_scratch_release(pk_out);
 	return return_status;
 
 }
@@ -36,11 +36,15 @@
 #include "optiga/optiga_util.h"
 #include "optiga/pal/pal_os_timer.h"
 #include "optiga/common/optiga_lib_common.h"
+#include "trustm_crypt_pool.h"
 
 #define PRINT_SIGNATURE   0
 #define PRINT_HASH        0
 #define PRINT_PUBLICKEY   0
 
+// Size of the DER public key and the DER signature of the largest curve (P-521) in the scratch arena
+#define TRUSTM_ECDSA_BUFFER_SIZE    (150)
+
 #ifndef CONFIG_OPTIGA_TRUST_M_PRIVKEY_SLOT
 #define CONFIG_OPTIGA_TRUST_M_PRIVKEY_SLOT OPTIGA_KEY_ID_E0F0
 #endif
@@ -64,17 +68,24 @@ int mbedtls_ecdsa_sign( mbedtls_ecp_group *grp, mbedtls_mpi *r, mbedtls_mpi *s,
 {
 
     int return_status = MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
-    uint8_t der_signature[150];
-    uint16_t dslen = sizeof(der_signature);
-    uint8_t *p = der_signature;
+    uint8_t * der_signature = NULL;
+    uint16_t dslen = TRUSTM_ECDSA_BUFFER_SIZE;
+    uint8_t *p = NULL;
     const uint8_t * end = NULL;
     optiga_crypt_t * me = NULL;
     optiga_lib_status_t crypt_sync_status = OPTIGA_CRYPT_ERROR;
 
+    // Signature is taken from the scratch arena, which is cleared
+    der_signature = trustm_scratch_acquire();
+    if (NULL == der_signature)
+    {
+    	return_status = MBEDTLS_ERR_ECP_ALLOC_FAILED;
+    	goto cleanup;
+    }
+    p = der_signature;
     end = (der_signature + dslen);
-    memset(der_signature, 0x00, sizeof(der_signature));
 
-    me = optiga_crypt_create(0, optiga_crypt_event_completed, NULL);
+    me = trustm_crypt_acquire(optiga_crypt_event_completed, NULL);
     if (NULL == me)
     {
     	return_status = MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
@@ -114,7 +125,7 @@ int mbedtls_ecdsa_sign( mbedtls_ecp_group *grp, mbedtls_mpi *r, mbedtls_mpi *s,
 	}
 
 #if (PRINT_SIGNATURE==1)
-	for(int x=0; x<sizeof(der_signature);)
+	for(int x=0; x<dslen;)
 	{
 		printf(("%.2X %.2X %.2X %.2X %.2X %.2X %.2X %.2X \r\n",
 				der_signature[x],der_signature[x+1],
@@ -139,11 +150,12 @@ int mbedtls_ecdsa_sign( mbedtls_ecp_group *grp, mbedtls_mpi *r, mbedtls_mpi *s,
 
 	return_status = 0;
 cleanup:
-	// destroy crypt instances
+	// release crypt instances
 	if (me != NULL)
 	{
-		(void)optiga_crypt_destroy(me);
+		trustm_crypt_release(me);
 	}
+	trustm_scratch_release(der_signature);
 
     return return_status;
 
@@ -159,9 +171,9 @@ int mbedtls_ecdsa_verify( mbedtls_ecp_group *grp,
     int return_status = MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
     optiga_lib_status_t crypt_sync_status = OPTIGA_CRYPT_ERROR;
     public_key_from_host_t public_key;
-    uint8_t public_key_out [150];
+    uint8_t * public_key_out = NULL;
 	uint8_t publickey_offset = 3;
-    uint8_t signature [150];
+    uint8_t * signature = NULL;
     uint8_t * p = NULL;
     size_t  signature_len = 0;
     size_t public_key_len = 0;
@@ -169,10 +181,17 @@ int mbedtls_ecdsa_verify( mbedtls_ecp_group *grp,
     
     optiga_crypt_t * me = NULL;
 
-    p = signature + sizeof(signature);
-    memset(signature, 0x00, sizeof(signature));
+    // Public key and signature are taken from the scratch arena, which is cleared
+    public_key_out = trustm_scratch_acquire();
+    if (NULL == public_key_out)
+    {
+    	return_status = MBEDTLS_ERR_ECP_ALLOC_FAILED;
+    	goto cleanup;
+    }
+    signature = public_key_out + TRUSTM_ECDSA_BUFFER_SIZE;
+    p = signature + TRUSTM_ECDSA_BUFFER_SIZE;
 
-    me = optiga_crypt_create(0, optiga_crypt_event_completed, NULL);
+    me = trustm_crypt_acquire(optiga_crypt_event_completed, NULL);
     if (NULL == me)
     {
     	return_status = MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
@@ -220,7 +239,7 @@ int mbedtls_ecdsa_verify( mbedtls_ecp_group *grp,
 	signature_len += mbedtls_asn1_write_mpi( &p, signature, r );
 
 #if (PRINT_SIGNATURE==1)
-	for(int x=0; x<sizeof(signature);)
+	for(int x=0; x<TRUSTM_ECDSA_BUFFER_SIZE;)
 	{
 		printf(("%.2X %.2X %.2X %.2X %.2X %.2X %.2X %.2X \n\r",
 				signature[x],signature[x+1],signature[x+2],signature[x+3],
@@ -233,7 +252,7 @@ int mbedtls_ecdsa_verify( mbedtls_ecp_group *grp,
 
 	if (mbedtls_ecp_point_write_binary( grp, Q,
 										MBEDTLS_ECP_PF_UNCOMPRESSED, &public_key_len,
-										&public_key_out[publickey_offset], sizeof( public_key_out ) ) != 0 )
+										&public_key_out[publickey_offset], TRUSTM_ECDSA_BUFFER_SIZE - publickey_offset ) != 0 )
 	{
 		return_status = MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
 		goto cleanup;
@@ -303,11 +322,12 @@ int mbedtls_ecdsa_verify( mbedtls_ecp_group *grp,
 	}
 	return_status = 0;
 cleanup:
-	// destroy crypt instances
+	// release crypt instances
 	if (me != NULL)
 	{
-		(void)optiga_crypt_destroy(me);
+		trustm_crypt_release(me);
 	}
+	trustm_scratch_release(public_key_out);
     return return_status;
 
 }
@@ -327,7 +347,7 @@ int mbedtls_ecdsa_genkey( mbedtls_ecdsa_context *ctx, mbedtls_ecp_group_id gid,
     uint16_t privkey_oid = OPTIGA_KEY_ID_E0F0;
     optiga_crypt_t * me = NULL;
 
-    me = optiga_crypt_create(0, optiga_crypt_event_completed, NULL);
+    me = trustm_crypt_acquire(optiga_crypt_event_completed, NULL);
     if (NULL == me)
     {
         return_status = MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
@@ -392,10 +412,10 @@ int mbedtls_ecdsa_genkey( mbedtls_ecdsa_context *ctx, mbedtls_ecp_group_id gid,
     }
     return_status = 0;
 cleanup:
-	// destroy crypt instances
+	// release crypt instances
 	if (me != NULL)
 	{
-		(void)optiga_crypt_destroy(me);
+		trustm_crypt_release(me);
 	}
 
     return return_status;
@@ -0,0 +1,529 @@
+/**
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \file trustm_pk.c
+*
+* \brief   This file implements the mbedTLS PK contexts, of which the private key is stored in OPTIGA.
+*
+* @{
+*/
+
+#include "trustm_pk.h"
+
+#if defined(MBEDTLS_PK_C)
+
+#include <string.h>
+#include "mbedtls/pk_internal.h"
+#include "mbedtls/ecdsa.h"
+#include "mbedtls/rsa.h"
+#include "mbedtls/platform.h"
+#include "mbedtls/platform_util.h"
+#include "mbedtls/md.h"
+#include "optiga/pal/pal_os_timer.h"
+#include "trustm_crypt_pool.h"
+
+/** \brief ECC key of OPTIGA, the public key must be the first member for mbedtls_pk_ec */
+typedef struct trustm_pk_ecdsa_context
+{
+    mbedtls_ecp_keypair public_key;
+    optiga_key_id_t key_id;
+}trustm_pk_ecdsa_context_t;
+
+/** \brief RSA key of OPTIGA, the public key must be the first member for mbedtls_pk_rsa */
+typedef struct trustm_pk_rsa_context
+{
+    mbedtls_rsa_context public_key;
+    optiga_key_id_t key_id;
+}trustm_pk_rsa_context_t;
+
+//lint --e{818} suppress "context is the status of the waiting operation"
+static void trustm_pk_event_completed(void * context, optiga_lib_status_t return_status)
+{
+    *((volatile optiga_lib_status_t *)context) = return_status;
+}
+
+/*
+* Waits for the completion of the started operation and releases the instance
+*/
+static optiga_lib_status_t trustm_pk_wait(optiga_crypt_t * me,
+                                          optiga_lib_status_t crypt_status,
+                                          volatile optiga_lib_status_t * p_status)
+{
+    if (OPTIGA_LIB_SUCCESS == crypt_status)
+    {
+        while (OPTIGA_LIB_BUSY == *p_status)
+        {
+            pal_os_timer_delay_in_milliseconds(5);
+        }
+        crypt_status = *p_status;
+    }
+    trustm_crypt_release(me);
+    return (crypt_status);
+}
+
+#if defined(MBEDTLS_ECDSA_C)
+static size_t trustm_pk_ecdsa_get_bitlen(const void * ctx)
+{
+    return (((const trustm_pk_ecdsa_context_t *)ctx)->public_key.grp.pbits);
+}
+
+static int trustm_pk_ecdsa_can_do(mbedtls_pk_type_t type)
+{
+    return ((MBEDTLS_PK_ECKEY == type) || (MBEDTLS_PK_ECDSA == type));
+}
+
+static int trustm_pk_ecdsa_verify(void * ctx, mbedtls_md_type_t md_alg,
+                                  const unsigned char * hash, size_t hash_len,
+                                  const unsigned char * sig, size_t sig_len)
+{
+    int ret;
+    ((void)md_alg);
+
+    // Verification with the public key is left to the host
+    ret = mbedtls_ecdsa_read_signature((mbedtls_ecdsa_context *)ctx, hash, hash_len, sig, sig_len);
+    if (MBEDTLS_ERR_ECP_SIG_LEN_MISMATCH == ret)
+    {
+        ret = MBEDTLS_ERR_PK_SIG_LEN_MISMATCH;
+    }
+    return (ret);
+}
+
+static int trustm_pk_ecdsa_sign(void * ctx, mbedtls_md_type_t md_alg,
+                                const unsigned char * hash, size_t hash_len,
+                                unsigned char * sig, size_t * sig_len,
+                                int (*f_rng)(void *, unsigned char *, size_t),
+                                void * p_rng)
+{
+    trustm_pk_ecdsa_context_t * p_key = (trustm_pk_ecdsa_context_t *)ctx;
+    volatile optiga_lib_status_t crypt_status = OPTIGA_LIB_BUSY;
+    optiga_crypt_t * me;
+    uint8_t signature[MBEDTLS_ECDSA_MAX_LEN];
+    uint16_t signature_length = sizeof(signature) - 3;
+    size_t order_length = (p_key->public_key.grp.nbits + 7) / 8;
+    uint8_t header_length;
+    ((void)md_alg);
+    ((void)f_rng);
+    ((void)p_rng);
+
+    // The digest is truncated to the length of the group order, as part of ECDSA
+    if (hash_len > order_length)
+    {
+        hash_len = order_length;
+    }
+    me = trustm_crypt_acquire(trustm_pk_event_completed, (void *)&crypt_status);
+    if (NULL == me)
+    {
+        return (MBEDTLS_ERR_PK_ALLOC_FAILED);
+    }
+    if (OPTIGA_LIB_SUCCESS != trustm_pk_wait(me,
+                                             optiga_crypt_ecdsa_sign(me,
+                                                                     (uint8_t *)hash,
+                                                                     (uint8_t)hash_len,
+                                                                     p_key->key_id,
+                                                                     &signature[3],
+                                                                     &signature_length),
+                                             &crypt_status))
+    {
+        return (MBEDTLS_ERR_PK_HW_ACCEL_FAILED);
+    }
+
+    // OPTIGA provides the integers r and s, the PK layer provides the DER encoded Ecdsa-Sig-Value
+    header_length = (signature_length < 0x80) ? 2 : 3;
+    signature[3 - header_length] = 0x30;
+    if (3 == header_length)
+    {
+        signature[1] = 0x81;
+    }
+    signature[2] = (uint8_t)signature_length;
+    memcpy(sig, &signature[3 - header_length], signature_length + header_length);
+    *sig_len = signature_length + header_length;
+    return (0);
+}
+
+static int trustm_pk_ecdsa_check_pair(const void * pub, const void * prv)
+{
+    const mbedtls_ecp_keypair * p_public = (const mbedtls_ecp_keypair *)pub;
+    const mbedtls_ecp_keypair * p_private = &((const trustm_pk_ecdsa_context_t *)prv)->public_key;
+
+    // The private key doesn't leave OPTIGA, hence the public keys are compared
+    if ((p_public->grp.id != p_private->grp.id) ||
+        (0 != mbedtls_mpi_cmp_mpi(&p_public->Q.X, &p_private->Q.X)) ||
+        (0 != mbedtls_mpi_cmp_mpi(&p_public->Q.Y, &p_private->Q.Y)))
+    {
+        return (MBEDTLS_ERR_ECP_BAD_INPUT_DATA);
+    }
+    return (0);
+}
+
+static void * trustm_pk_ecdsa_alloc(void)
+{
+    trustm_pk_ecdsa_context_t * p_key = mbedtls_calloc(1, sizeof(trustm_pk_ecdsa_context_t));
+
+    if (NULL != p_key)
+    {
+        mbedtls_ecp_keypair_init(&p_key->public_key);
+    }
+    return (p_key);
+}
+
+static void trustm_pk_ecdsa_free(void * ctx)
+{
+    mbedtls_ecp_keypair_free(&((trustm_pk_ecdsa_context_t *)ctx)->public_key);
+    mbedtls_free(ctx);
+}
+
+static void trustm_pk_ecdsa_debug(const void * ctx, mbedtls_pk_debug_item * items)
+{
+    items->type = MBEDTLS_PK_DEBUG_ECP;
+    items->name = "eckey.Q";
+    items->value = &(((const trustm_pk_ecdsa_context_t *)ctx)->public_key.Q);
+}
+
+static const mbedtls_pk_info_t trustm_pk_ecdsa_info =
+{
+    MBEDTLS_PK_ECKEY,
+    "OPTIGA_EC",
+    trustm_pk_ecdsa_get_bitlen,
+    trustm_pk_ecdsa_can_do,
+    trustm_pk_ecdsa_verify,
+    trustm_pk_ecdsa_sign,
+#if defined(MBEDTLS_ECP_RESTARTABLE)
+    NULL,
+    NULL,
+#endif
+    NULL,
+    NULL,
+    trustm_pk_ecdsa_check_pair,
+    trustm_pk_ecdsa_alloc,
+    trustm_pk_ecdsa_free,
+#if defined(MBEDTLS_ECP_RESTARTABLE)
+    NULL,
+    NULL,
+#endif
+    trustm_pk_ecdsa_debug,
+};
+
+int trustm_pk_setup_ecdsa(mbedtls_pk_context * pk, optiga_key_id_t key_id, const mbedtls_pk_context * public_key)
+{
+    trustm_pk_ecdsa_context_t * p_key;
+    const mbedtls_ecp_keypair * p_public;
+    int ret;
+
+    if (!mbedtls_pk_can_do(public_key, MBEDTLS_PK_ECKEY))
+    {
+        return (MBEDTLS_ERR_PK_TYPE_MISMATCH);
+    }
+    p_public = (const mbedtls_ecp_keypair *)public_key->pk_ctx;
+    ret = mbedtls_pk_setup(pk, &trustm_pk_ecdsa_info);
+    if (0 != ret)
+    {
+        return (ret);
+    }
+    p_key = (trustm_pk_ecdsa_context_t *)pk->pk_ctx;
+    p_key->key_id = key_id;
+    ret = mbedtls_ecp_group_copy(&p_key->public_key.grp, &p_public->grp);
+    if (0 == ret)
+    {
+        ret = mbedtls_ecp_copy(&p_key->public_key.Q, &p_public->Q);
+    }
+    if (0 != ret)
+    {
+        mbedtls_pk_free(pk);
+        ret = MBEDTLS_ERR_PK_ALLOC_FAILED;
+    }
+    return (ret);
+}
+#endif //MBEDTLS_ECDSA_C
+
+#if defined(MBEDTLS_RSA_C)
+static size_t trustm_pk_rsa_get_bitlen(const void * ctx)
+{
+    return (8 * mbedtls_rsa_get_len(&((const trustm_pk_rsa_context_t *)ctx)->public_key));
+}
+
+static int trustm_pk_rsa_can_do(mbedtls_pk_type_t type)
+{
+    return ((MBEDTLS_PK_RSA == type) || (MBEDTLS_PK_RSASSA_PSS == type));
+}
+
+static int trustm_pk_rsa_verify(void * ctx, mbedtls_md_type_t md_alg,
+                                const unsigned char * hash, size_t hash_len,
+                                const unsigned char * sig, size_t sig_len)
+{
+    mbedtls_rsa_context * p_rsa = &((trustm_pk_rsa_context_t *)ctx)->public_key;
+    int ret;
+
+    if (sig_len < mbedtls_rsa_get_len(p_rsa))
+    {
+        return (MBEDTLS_ERR_RSA_VERIFY_FAILED);
+    }
+    ret = mbedtls_rsa_pkcs1_verify(p_rsa, NULL, NULL, MBEDTLS_RSA_PUBLIC, md_alg, (unsigned int)hash_len, hash, sig);
+    if ((0 == ret) && (sig_len > mbedtls_rsa_get_len(p_rsa)))
+    {
+        ret = MBEDTLS_ERR_PK_SIG_LEN_MISMATCH;
+    }
+    return (ret);
+}
+
+static int trustm_pk_rsa_sign(void * ctx, mbedtls_md_type_t md_alg,
+                              const unsigned char * hash, size_t hash_len,
+                              unsigned char * sig, size_t * sig_len,
+                              int (*f_rng)(void *, unsigned char *, size_t),
+                              void * p_rng)
+{
+#ifdef OPTIGA_CRYPT_RSA_SIGN_ENABLED
+    trustm_pk_rsa_context_t * p_key = (trustm_pk_rsa_context_t *)ctx;
+    volatile optiga_lib_status_t crypt_status = OPTIGA_LIB_BUSY;
+    optiga_crypt_t * me;
+    uint16_t signature_length = (uint16_t)mbedtls_rsa_get_len(&p_key->public_key);
+    ((void)f_rng);
+    ((void)p_rng);
+
+    // OPTIGA encodes the DigestInfo, hence only the digests of its signature schemes are supported
+    if ((MBEDTLS_MD_SHA256 != md_alg) && (MBEDTLS_MD_SHA384 != md_alg))
+    {
+        return (MBEDTLS_ERR_PK_FEATURE_UNAVAILABLE);
+    }
+    me = trustm_crypt_acquire(trustm_pk_event_completed, (void *)&crypt_status);
+    if (NULL == me)
+    {
+        return (MBEDTLS_ERR_PK_ALLOC_FAILED);
+    }
+    if (OPTIGA_LIB_SUCCESS != trustm_pk_wait(me,
+                                             optiga_crypt_rsa_sign(me,
+                                                                   (MBEDTLS_MD_SHA384 == md_alg) ?
+                                                                   OPTIGA_RSASSA_PKCS1_V15_SHA384 :
+                                                                   OPTIGA_RSASSA_PKCS1_V15_SHA256,
+                                                                   hash,
+                                                                   (uint8_t)hash_len,
+                                                                   p_key->key_id,
+                                                                   sig,
+                                                                   &signature_length,
+                                                                   0x0000),
+                                             &crypt_status))
+    {
+        return (MBEDTLS_ERR_PK_HW_ACCEL_FAILED);
+    }
+    *sig_len = signature_length;
+    return (0);
+#else
+    ((void)ctx);
+    ((void)md_alg);
+    ((void)hash);
+    ((void)hash_len);
+    ((void)sig);
+    ((void)sig_len);
+    ((void)f_rng);
+    ((void)p_rng);
+    return (MBEDTLS_ERR_PK_FEATURE_UNAVAILABLE);
+#endif //OPTIGA_CRYPT_RSA_SIGN_ENABLED
+}
+
+static int trustm_pk_rsa_decrypt(void * ctx,
+                                 const unsigned char * input, size_t ilen,
+                                 unsigned char * output, size_t * olen, size_t osize,
+                                 int (*f_rng)(void *, unsigned char *, size_t),
+                                 void * p_rng)
+{
+#ifdef OPTIGA_CRYPT_RSA_DECRYPT_ENABLED
+    trustm_pk_rsa_context_t * p_key = (trustm_pk_rsa_context_t *)ctx;
+    volatile optiga_lib_status_t crypt_status = OPTIGA_LIB_BUSY;
+    optiga_crypt_t * me;
+    uint16_t message_length = (osize > 0xFFFF) ? 0xFFFF : (uint16_t)osize;
+    ((void)f_rng);
+    ((void)p_rng);
+
+    if (ilen != mbedtls_rsa_get_len(&p_key->public_key))
+    {
+        return (MBEDTLS_ERR_RSA_BAD_INPUT_DATA);
+    }
+    me = trustm_crypt_acquire(trustm_pk_event_completed, (void *)&crypt_status);
+    if (NULL == me)
+    {
+        return (MBEDTLS_ERR_PK_ALLOC_FAILED);
+    }
+    if (OPTIGA_LIB_SUCCESS != trustm_pk_wait(me,
+                                             optiga_crypt_rsa_decrypt_and_export(me,
+                                                                                 OPTIGA_RSAES_PKCS1_V15,
+                                                                                 input,
+                                                                                 (uint16_t)ilen,
+                                                                                 NULL,
+                                                                                 0,
+                                                                                 p_key->key_id,
+                                                                                 output,
+                                                                                 &message_length),
+                                             &crypt_status))
+    {
+        return (MBEDTLS_ERR_PK_HW_ACCEL_FAILED);
+    }
+    *olen = message_length;
+    return (0);
+#else
+    ((void)ctx);
+    ((void)input);
+    ((void)ilen);
+    ((void)output);
+    ((void)olen);
+    ((void)osize);
+    ((void)f_rng);
+    ((void)p_rng);
+    return (MBEDTLS_ERR_PK_FEATURE_UNAVAILABLE);
+#endif //OPTIGA_CRYPT_RSA_DECRYPT_ENABLED
+}
+
+static int trustm_pk_rsa_encrypt(void * ctx,
+                                 const unsigned char * input, size_t ilen,
+                                 unsigned char * output, size_t * olen, size_t osize,
+                                 int (*f_rng)(void *, unsigned char *, size_t),
+                                 void * p_rng)
+{
+    mbedtls_rsa_context * p_rsa = &((trustm_pk_rsa_context_t *)ctx)->public_key;
+
+    *olen = mbedtls_rsa_get_len(p_rsa);
+    if (*olen > osize)
+    {
+        return (MBEDTLS_ERR_RSA_OUTPUT_TOO_LARGE);
+    }
+    return (mbedtls_rsa_pkcs1_encrypt(p_rsa, f_rng, p_rng, MBEDTLS_RSA_PUBLIC, ilen, input, output));
+}
+
+static int trustm_pk_rsa_check_pair(const void * pub, const void * prv)
+{
+    const mbedtls_rsa_context * p_private = &((const trustm_pk_rsa_context_t *)prv)->public_key;
+    mbedtls_mpi public_n, public_e, private_n, private_e;
+    int ret = MBEDTLS_ERR_RSA_KEY_CHECK_FAILED;
+
+    mbedtls_mpi_init(&public_n);
+    mbedtls_mpi_init(&public_e);
+    mbedtls_mpi_init(&private_n);
+    mbedtls_mpi_init(&private_e);
+    // The private key doesn't leave OPTIGA, hence the public keys are compared
+    if ((0 == mbedtls_rsa_export((const mbedtls_rsa_context *)pub, &public_n, NULL, NULL, NULL, &public_e)) &&
+        (0 == mbedtls_rsa_export(p_private, &private_n, NULL, NULL, NULL, &private_e)) &&
+        (0 == mbedtls_mpi_cmp_mpi(&public_n, &private_n)) &&
+        (0 == mbedtls_mpi_cmp_mpi(&public_e, &private_e)))
+    {
+        ret = 0;
+    }
+    mbedtls_mpi_free(&public_n);
+    mbedtls_mpi_free(&public_e);
+    mbedtls_mpi_free(&private_n);
+    mbedtls_mpi_free(&private_e);
+    return (ret);
+}
+
+static void * trustm_pk_rsa_alloc(void)
+{
+    trustm_pk_rsa_context_t * p_key = mbedtls_calloc(1, sizeof(trustm_pk_rsa_context_t));
+
+    if (NULL != p_key)
+    {
+        mbedtls_rsa_init(&p_key->public_key, MBEDTLS_RSA_PKCS_V15, 0);
+    }
+    return (p_key);
+}
+
+static void trustm_pk_rsa_free(void * ctx)
+{
+    mbedtls_rsa_free(&((trustm_pk_rsa_context_t *)ctx)->public_key);
+    mbedtls_free(ctx);
+}
+
+static const mbedtls_pk_info_t trustm_pk_rsa_info =
+{
+    MBEDTLS_PK_RSA,
+    "OPTIGA_RSA",
+    trustm_pk_rsa_get_bitlen,
+    trustm_pk_rsa_can_do,
+    trustm_pk_rsa_verify,
+    trustm_pk_rsa_sign,
+#if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_RESTARTABLE)
+    NULL,
+    NULL,
+#endif
+    trustm_pk_rsa_decrypt,
+    trustm_pk_rsa_encrypt,
+    trustm_pk_rsa_check_pair,
+    trustm_pk_rsa_alloc,
+    trustm_pk_rsa_free,
+#if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_RESTARTABLE)
+    NULL,
+    NULL,
+#endif
+    NULL,
+};
+
+int trustm_pk_setup_rsa(mbedtls_pk_context * pk, optiga_key_id_t key_id, const mbedtls_pk_context * public_key)
+{
+    trustm_pk_rsa_context_t * p_key;
+    int ret;
+
+    if (MBEDTLS_PK_RSA != mbedtls_pk_get_type(public_key))
+    {
+        return (MBEDTLS_ERR_PK_TYPE_MISMATCH);
+    }
+    ret = mbedtls_pk_setup(pk, &trustm_pk_rsa_info);
+    if (0 != ret)
+    {
+        return (ret);
+    }
+    p_key = (trustm_pk_rsa_context_t *)pk->pk_ctx;
+    p_key->key_id = key_id;
+    if (0 != mbedtls_rsa_copy(&p_key->public_key, (const mbedtls_rsa_context *)public_key->pk_ctx))
+    {
+        mbedtls_pk_free(pk);
+        ret = MBEDTLS_ERR_PK_ALLOC_FAILED;
+    }
+    return (ret);
+}
+#endif //MBEDTLS_RSA_C
+
+#if defined(MBEDTLS_MD_C)
+int trustm_pk_sign_data(mbedtls_pk_context * pk, mbedtls_md_type_t md_alg,
+                        const unsigned char * data, size_t data_len,
+                        unsigned char * sig, size_t * sig_len)
+{
+    const mbedtls_md_info_t * p_md_info = mbedtls_md_info_from_type(md_alg);
+    unsigned char hash[MBEDTLS_MD_MAX_SIZE];
+    int ret;
+
+    if (NULL == p_md_info)
+    {
+        return (MBEDTLS_ERR_PK_BAD_INPUT_DATA);
+    }
+    // The data is hashed on host, only the digest is sent to OPTIGA
+    ret = mbedtls_md(p_md_info, data, data_len, hash);
+    if (0 == ret)
+    {
+        ret = mbedtls_pk_sign(pk, md_alg, hash, mbedtls_md_get_size(p_md_info), sig, sig_len, NULL, NULL);
+    }
+    mbedtls_platform_zeroize(hash, sizeof(hash));
+    return (ret);
+}
+#endif //MBEDTLS_MD_C
+
+#endif //MBEDTLS_PK_C
+
+/**
+* @}
+*/
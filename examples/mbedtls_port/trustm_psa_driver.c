@@ -0,0 +1,976 @@
+/**
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \file trustm_psa_driver.c
+*
+* \brief   This file implements the PSA Crypto driver of OPTIGA, for the PSA Crypto API of mbedTLS 3.x.
+*
+* @{
+*/
+
+#include "trustm_psa_driver.h"
+
+#ifdef TRUSTM_PSA_DRIVER_ENABLED
+
+#include <string.h>
+#include "optiga/pal/pal_os_timer.h"
+#include "trustm_crypt_pool.h"
+
+/// Minimum and maximum length of a random number of OPTIGA
+#define TRUSTM_PSA_RANDOM_MIN_LENGTH        (0x08)
+#define TRUSTM_PSA_RANDOM_MAX_LENGTH        (0x100)
+/// Maximum length of a public key from host, BIT STRING of 0x04 || X || Y of NIST P521
+#define TRUSTM_PSA_PUBLIC_KEY_SIZE          (0x90)
+
+//lint --e{818} suppress "context is the status of the waiting operation"
+static void trustm_psa_event_completed(void * context, optiga_lib_status_t return_status)
+{
+    *((volatile optiga_lib_status_t *)context) = return_status;
+}
+
+/*
+* Waits for the completion of the started operation
+*/
+static optiga_lib_status_t trustm_psa_wait(volatile optiga_lib_status_t * p_status, optiga_lib_status_t crypt_status)
+{
+    if (OPTIGA_LIB_SUCCESS == crypt_status)
+    {
+        while (OPTIGA_LIB_BUSY == *p_status)
+        {
+            pal_os_timer_delay_in_milliseconds(5);
+        }
+        crypt_status = *p_status;
+    }
+    return (crypt_status);
+}
+
+static psa_status_t trustm_psa_get_oid(const uint8_t * key_buffer, size_t key_buffer_size, uint16_t * p_oid)
+{
+    if (TRUSTM_PSA_KEY_BUFFER_SIZE != key_buffer_size)
+    {
+        return (PSA_ERROR_INVALID_ARGUMENT);
+    }
+    *p_oid = (uint16_t)(((uint16_t)key_buffer[0] << 8) | key_buffer[1]);
+    return (PSA_SUCCESS);
+}
+
+/*
+* Provides the curve of OPTIGA for the family and size of the ECC key
+*/
+static psa_status_t trustm_psa_get_curve(const psa_key_attributes_t * attributes, uint8_t * p_curve)
+{
+    psa_ecc_family_t family = PSA_KEY_TYPE_ECC_GET_FAMILY(psa_get_key_type(attributes));
+    size_t bits = psa_get_key_bits(attributes);
+
+    if ((PSA_ECC_FAMILY_SECP_R1 == family) && (256 == bits))
+    {
+        *p_curve = (uint8_t)OPTIGA_ECC_CURVE_NIST_P_256;
+    }
+    else if ((PSA_ECC_FAMILY_SECP_R1 == family) && (384 == bits))
+    {
+        *p_curve = (uint8_t)OPTIGA_ECC_CURVE_NIST_P_384;
+    }
+#ifdef OPTIGA_CRYPT_ECC_NIST_P_521_ENABLED
+    else if ((PSA_ECC_FAMILY_SECP_R1 == family) && (521 == bits))
+    {
+        *p_curve = (uint8_t)OPTIGA_ECC_CURVE_NIST_P_521;
+    }
+#endif
+#ifdef OPTIGA_CRYPT_ECC_BRAINPOOL_P_R1_ENABLED
+    else if ((PSA_ECC_FAMILY_BRAINPOOL_P_R1 == family) && (256 == bits))
+    {
+        *p_curve = (uint8_t)OPTIGA_ECC_CURVE_BRAIN_POOL_P_256R1;
+    }
+    else if ((PSA_ECC_FAMILY_BRAINPOOL_P_R1 == family) && (384 == bits))
+    {
+        *p_curve = (uint8_t)OPTIGA_ECC_CURVE_BRAIN_POOL_P_384R1;
+    }
+    else if ((PSA_ECC_FAMILY_BRAINPOOL_P_R1 == family) && (512 == bits))
+    {
+        *p_curve = (uint8_t)OPTIGA_ECC_CURVE_BRAIN_POOL_P_512R1;
+    }
+#endif
+    else
+    {
+        return (PSA_ERROR_NOT_SUPPORTED);
+    }
+    return (PSA_SUCCESS);
+}
+
+/*
+* Encodes the public key of PSA (0x04 || X || Y) as BIT STRING, the format of OPTIGA
+*/
+static psa_status_t trustm_psa_set_public_key(const psa_key_attributes_t * attributes,
+                                              const uint8_t * point,
+                                              size_t point_length,
+                                              uint8_t * p_buffer,
+                                              public_key_from_host_t * p_public_key)
+{
+    uint8_t offset = (point_length + 1 < 0x80) ? 3 : 4;
+
+    if ((point_length != 1 + 2 * PSA_BITS_TO_BYTES(psa_get_key_bits(attributes))) ||
+        (0x04 != point[0]) ||
+        (point_length + offset > TRUSTM_PSA_PUBLIC_KEY_SIZE))
+    {
+        return (PSA_ERROR_INVALID_ARGUMENT);
+    }
+    p_buffer[0] = 0x03;
+    if (4 == offset)
+    {
+        p_buffer[1] = 0x81;
+    }
+    p_buffer[offset - 2] = (uint8_t)(point_length + 1);
+    p_buffer[offset - 1] = 0x00;
+    memcpy(&p_buffer[offset], point, point_length);
+    p_public_key->public_key = p_buffer;
+    p_public_key->length = (uint16_t)(point_length + offset);
+    return (trustm_psa_get_curve(attributes, &p_public_key->key_type));
+}
+
+/*
+* Converts r and s of OPTIGA (INTEGER TLVs) into the signature of PSA (r || s, each of curve length)
+*/
+static psa_status_t trustm_psa_signature_from_der(const uint8_t * p_der,
+                                                  uint16_t der_length,
+                                                  uint16_t curve_length,
+                                                  uint8_t * p_signature)
+{
+    uint16_t offset = 0;
+    uint16_t length;
+    uint8_t index;
+
+    for (index = 0; index < 2; index++)
+    {
+        if ((offset + 2 > der_length) || (0x02 != p_der[offset]) || (p_der[offset + 1] >= 0x80))
+        {
+            return (PSA_ERROR_HARDWARE_FAILURE);
+        }
+        length = p_der[offset + 1];
+        offset += 2;
+        if (offset + length > der_length)
+        {
+            return (PSA_ERROR_HARDWARE_FAILURE);
+        }
+        // The sign byte of a positive integer is not part of the PSA signature
+        while ((length > curve_length) && (0x00 == p_der[offset]))
+        {
+            offset++;
+            length--;
+        }
+        if (length > curve_length)
+        {
+            return (PSA_ERROR_HARDWARE_FAILURE);
+        }
+        memset(p_signature, 0x00, curve_length - length);
+        memcpy(p_signature + curve_length - length, &p_der[offset], length);
+        p_signature += curve_length;
+        offset += length;
+    }
+    return (PSA_SUCCESS);
+}
+
+/*
+* Converts the signature of PSA into r and s as INTEGER TLVs, the format of OPTIGA
+*/
+static uint16_t trustm_psa_signature_to_der(const uint8_t * p_signature, uint16_t curve_length, uint8_t * p_der)
+{
+    uint16_t offset = 0;
+    uint16_t length;
+    uint8_t index;
+    const uint8_t * p_integer;
+
+    for (index = 0; index < 2; index++)
+    {
+        p_integer = p_signature + index * curve_length;
+        length = curve_length;
+        while ((length > 1) && (0x00 == *p_integer))
+        {
+            p_integer++;
+            length--;
+        }
+        p_der[offset++] = 0x02;
+        if (0x80 & *p_integer)
+        {
+            p_der[offset++] = (uint8_t)(length + 1);
+            p_der[offset++] = 0x00;
+        }
+        else
+        {
+            p_der[offset++] = (uint8_t)length;
+        }
+        memcpy(&p_der[offset], p_integer, length);
+        offset += length;
+    }
+    return (offset);
+}
+
+size_t trustm_psa_opaque_size_function(psa_key_type_t key_type, size_t key_bits)
+{
+    (void)key_type;
+    (void)key_bits;
+    return (TRUSTM_PSA_KEY_BUFFER_SIZE);
+}
+
+psa_status_t trustm_psa_opaque_import_key(const psa_key_attributes_t * attributes,
+                                          const uint8_t * data,
+                                          size_t data_length,
+                                          uint8_t * key_buffer,
+                                          size_t key_buffer_size,
+                                          size_t * key_buffer_length,
+                                          size_t * bits)
+{
+    // Only the reference is stored, the size of the key in OPTIGA is known by the caller
+    if ((TRUSTM_PSA_KEY_BUFFER_SIZE != data_length) || (0 == psa_get_key_bits(attributes)))
+    {
+        return (PSA_ERROR_INVALID_ARGUMENT);
+    }
+    if (key_buffer_size < TRUSTM_PSA_KEY_BUFFER_SIZE)
+    {
+        return (PSA_ERROR_BUFFER_TOO_SMALL);
+    }
+    memcpy(key_buffer, data, TRUSTM_PSA_KEY_BUFFER_SIZE);
+    *key_buffer_length = TRUSTM_PSA_KEY_BUFFER_SIZE;
+    *bits = psa_get_key_bits(attributes);
+    return (PSA_SUCCESS);
+}
+
+psa_status_t trustm_psa_sign_hash_start(trustm_psa_sign_hash_operation_t * operation,
+                                        const psa_key_attributes_t * attributes,
+                                        const uint8_t * key_buffer,
+                                        size_t key_buffer_size,
+                                        psa_algorithm_t alg,
+                                        const uint8_t * hash,
+                                        size_t hash_length)
+{
+    psa_key_type_t key_type = psa_get_key_type(attributes);
+    optiga_lib_status_t crypt_status = OPTIGA_CRYPT_ERROR;
+    uint16_t oid;
+    psa_status_t status;
+
+    status = trustm_psa_get_oid(key_buffer, key_buffer_size, &oid);
+    if (PSA_SUCCESS != status)
+    {
+        return (status);
+    }
+    if (hash_length > sizeof(operation->hash))
+    {
+        return (PSA_ERROR_INVALID_ARGUMENT);
+    }
+    memset(operation, 0x00, sizeof(trustm_psa_sign_hash_operation_t));
+    // The hash of the caller is valid only during this call, while OPTIGA takes it later
+    memcpy(operation->hash, hash, hash_length);
+    operation->signature_length = sizeof(operation->signature);
+
+    if (PSA_KEY_TYPE_IS_ECC_KEY_PAIR(key_type) && PSA_ALG_IS_ECDSA(alg))
+    {
+        operation->curve_length = (uint16_t)PSA_BITS_TO_BYTES(psa_get_key_bits(attributes));
+        // The digest is truncated to the length of the group order, as part of ECDSA
+        if (hash_length > operation->curve_length)
+        {
+            hash_length = operation->curve_length;
+        }
+        operation->me = trustm_crypt_acquire(trustm_psa_event_completed, (void *)&operation->status);
+        if (NULL == operation->me)
+        {
+            return (PSA_ERROR_INSUFFICIENT_MEMORY);
+        }
+        operation->status = OPTIGA_LIB_BUSY;
+        crypt_status = optiga_crypt_ecdsa_sign(operation->me,
+                                               operation->hash,
+                                               (uint8_t)hash_length,
+                                               (optiga_key_id_t)oid,
+                                               operation->signature,
+                                               &operation->signature_length);
+    }
+#ifdef OPTIGA_CRYPT_RSA_SIGN_ENABLED
+    else if ((PSA_KEY_TYPE_RSA_KEY_PAIR == key_type) && PSA_ALG_IS_RSA_PKCS1V15_SIGN(alg) &&
+             ((PSA_ALG_SHA_256 == PSA_ALG_SIGN_GET_HASH(alg)) || (PSA_ALG_SHA_384 == PSA_ALG_SIGN_GET_HASH(alg))))
+    {
+        operation->me = trustm_crypt_acquire(trustm_psa_event_completed, (void *)&operation->status);
+        if (NULL == operation->me)
+        {
+            return (PSA_ERROR_INSUFFICIENT_MEMORY);
+        }
+        operation->status = OPTIGA_LIB_BUSY;
+        crypt_status = optiga_crypt_rsa_sign(operation->me,
+                                             (PSA_ALG_SHA_384 == PSA_ALG_SIGN_GET_HASH(alg)) ?
+                                             OPTIGA_RSASSA_PKCS1_V15_SHA384 : OPTIGA_RSASSA_PKCS1_V15_SHA256,
+                                             operation->hash,
+                                             (uint8_t)hash_length,
+                                             (optiga_key_id_t)oid,
+                                             operation->signature,
+                                             &operation->signature_length,
+                                             0x0000);
+    }
+#endif //OPTIGA_CRYPT_RSA_SIGN_ENABLED
+    else
+    {
+        return (PSA_ERROR_NOT_SUPPORTED);
+    }
+
+    if (OPTIGA_LIB_SUCCESS != crypt_status)
+    {
+        trustm_crypt_release(operation->me);
+        operation->me = NULL;
+        return (PSA_ERROR_HARDWARE_FAILURE);
+    }
+    return (PSA_SUCCESS);
+}
+
+psa_status_t trustm_psa_sign_hash_complete(trustm_psa_sign_hash_operation_t * operation,
+                                           uint8_t * signature,
+                                           size_t signature_size,
+                                           size_t * signature_length)
+{
+    psa_status_t status;
+
+    if (NULL == operation->me)
+    {
+        return (PSA_ERROR_BAD_STATE);
+    }
+    if (OPTIGA_LIB_BUSY == operation->status)
+    {
+        return (PSA_OPERATION_INCOMPLETE);
+    }
+    trustm_crypt_release(operation->me);
+    operation->me = NULL;
+
+    if (OPTIGA_LIB_SUCCESS != operation->status)
+    {
+        return (PSA_ERROR_HARDWARE_FAILURE);
+    }
+    if (0 != operation->curve_length)
+    {
+        if (signature_size < 2 * (size_t)operation->curve_length)
+        {
+            return (PSA_ERROR_BUFFER_TOO_SMALL);
+        }
+        status = trustm_psa_signature_from_der(operation->signature,
+                                               operation->signature_length,
+                                               operation->curve_length,
+                                               signature);
+        *signature_length = (PSA_SUCCESS == status) ? 2 * (size_t)operation->curve_length : 0;
+        return (status);
+    }
+    if (signature_size < operation->signature_length)
+    {
+        return (PSA_ERROR_BUFFER_TOO_SMALL);
+    }
+    memcpy(signature, operation->signature, operation->signature_length);
+    *signature_length = operation->signature_length;
+    return (PSA_SUCCESS);
+}
+
+psa_status_t trustm_psa_sign_hash_abort(trustm_psa_sign_hash_operation_t * operation)
+{
+    if (NULL != operation->me)
+    {
+        // OPTIGA can't abort the command, the instance is released once completed
+        //lint --e{534} suppress "The result is discarded"
+        trustm_psa_wait(&operation->status, OPTIGA_LIB_SUCCESS);
+        trustm_crypt_release(operation->me);
+        operation->me = NULL;
+    }
+    return (PSA_SUCCESS);
+}
+
+psa_status_t trustm_psa_opaque_sign_hash(const psa_key_attributes_t * attributes,
+                                         const uint8_t * key_buffer,
+                                         size_t key_buffer_size,
+                                         psa_algorithm_t alg,
+                                         const uint8_t * hash,
+                                         size_t hash_length,
+                                         uint8_t * signature,
+                                         size_t signature_size,
+                                         size_t * signature_length)
+{
+    trustm_psa_sign_hash_operation_t operation;
+    psa_status_t status;
+
+    status = trustm_psa_sign_hash_start(&operation, attributes, key_buffer, key_buffer_size, alg, hash, hash_length);
+    while (PSA_SUCCESS == status)
+    {
+        status = trustm_psa_sign_hash_complete(&operation, signature, signature_size, signature_length);
+        if (PSA_OPERATION_INCOMPLETE != status)
+        {
+            break;
+        }
+        status = PSA_SUCCESS;
+        pal_os_timer_delay_in_milliseconds(5);
+    }
+    return (status);
+}
+
+psa_status_t trustm_psa_verify_hash(const psa_key_attributes_t * attributes,
+                                    const uint8_t * key_buffer,
+                                    size_t key_buffer_size,
+                                    psa_algorithm_t alg,
+                                    const uint8_t * hash,
+                                    size_t hash_length,
+                                    const uint8_t * signature,
+                                    size_t signature_length)
+{
+    volatile optiga_lib_status_t crypt_event_status = OPTIGA_LIB_BUSY;
+    optiga_lib_status_t crypt_status;
+    public_key_from_host_t public_key;
+    uint8_t public_key_buffer[TRUSTM_PSA_PUBLIC_KEY_SIZE];
+    uint8_t der_signature[TRUSTM_PSA_PUBLIC_KEY_SIZE];
+    uint16_t der_length;
+    uint16_t curve_length = (uint16_t)PSA_BITS_TO_BYTES(psa_get_key_bits(attributes));
+    optiga_crypt_t * me;
+    psa_status_t status;
+
+    // Key pairs and other algorithms are left to the software implementation
+    if ((!PSA_KEY_TYPE_IS_ECC_PUBLIC_KEY(psa_get_key_type(attributes))) || (!PSA_ALG_IS_ECDSA(alg)))
+    {
+        return (PSA_ERROR_NOT_SUPPORTED);
+    }
+    status = trustm_psa_set_public_key(attributes, key_buffer, key_buffer_size, public_key_buffer, &public_key);
+    if (PSA_SUCCESS != status)
+    {
+        return ((PSA_ERROR_INVALID_ARGUMENT == status) ? PSA_ERROR_NOT_SUPPORTED : status);
+    }
+    if (signature_length != 2 * (size_t)curve_length)
+    {
+        return (PSA_ERROR_INVALID_SIGNATURE);
+    }
+    if (hash_length > curve_length)
+    {
+        hash_length = curve_length;
+    }
+    der_length = trustm_psa_signature_to_der(signature, curve_length, der_signature);
+
+    me = trustm_crypt_acquire(trustm_psa_event_completed, (void *)&crypt_event_status);
+    if (NULL == me)
+    {
+        return (PSA_ERROR_INSUFFICIENT_MEMORY);
+    }
+    crypt_status = optiga_crypt_ecdsa_verify(me,
+                                             hash,
+                                             (uint8_t)hash_length,
+                                             der_signature,
+                                             der_length,
+                                             OPTIGA_CRYPT_HOST_DATA,
+                                             &public_key);
+    if (OPTIGA_LIB_SUCCESS != crypt_status)
+    {
+        status = PSA_ERROR_HARDWARE_FAILURE;
+    }
+    // The command is executed, hence a failure is a mismatch of the signature
+    else if (OPTIGA_LIB_SUCCESS != trustm_psa_wait(&crypt_event_status, crypt_status))
+    {
+        status = PSA_ERROR_INVALID_SIGNATURE;
+    }
+    trustm_crypt_release(me);
+    return (status);
+}
+
+psa_status_t trustm_psa_opaque_key_agreement(const psa_key_attributes_t * attributes,
+                                             const uint8_t * key_buffer,
+                                             size_t key_buffer_size,
+                                             psa_algorithm_t alg,
+                                             const uint8_t * peer_key,
+                                             size_t peer_key_length,
+                                             uint8_t * shared_secret,
+                                             size_t shared_secret_size,
+                                             size_t * shared_secret_length)
+{
+    volatile optiga_lib_status_t crypt_event_status = OPTIGA_LIB_BUSY;
+    public_key_from_host_t public_key;
+    uint8_t public_key_buffer[TRUSTM_PSA_PUBLIC_KEY_SIZE];
+    size_t secret_length = PSA_BITS_TO_BYTES(psa_get_key_bits(attributes));
+    optiga_crypt_t * me;
+    uint16_t oid;
+    psa_status_t status;
+
+    if ((PSA_ALG_ECDH != alg) || (!PSA_KEY_TYPE_IS_ECC_KEY_PAIR(psa_get_key_type(attributes))))
+    {
+        return (PSA_ERROR_NOT_SUPPORTED);
+    }
+    status = trustm_psa_get_oid(key_buffer, key_buffer_size, &oid);
+    if (PSA_SUCCESS != status)
+    {
+        return (status);
+    }
+    status = trustm_psa_set_public_key(attributes, peer_key, peer_key_length, public_key_buffer, &public_key);
+    if (PSA_SUCCESS != status)
+    {
+        return (status);
+    }
+    if (shared_secret_size < secret_length)
+    {
+        return (PSA_ERROR_BUFFER_TOO_SMALL);
+    }
+
+    me = trustm_crypt_acquire(trustm_psa_event_completed, (void *)&crypt_event_status);
+    if (NULL == me)
+    {
+        return (PSA_ERROR_INSUFFICIENT_MEMORY);
+    }
+    if (OPTIGA_LIB_SUCCESS != trustm_psa_wait(&crypt_event_status,
+                                              optiga_crypt_ecdh(me, (optiga_key_id_t)oid, &public_key, TRUE, shared_secret)))
+    {
+        status = PSA_ERROR_HARDWARE_FAILURE;
+    }
+    trustm_crypt_release(me);
+    *shared_secret_length = (PSA_SUCCESS == status) ? secret_length : 0;
+    return (status);
+}
+
+psa_status_t trustm_psa_get_entropy(uint32_t flags,
+                                    size_t * estimate_bits,
+                                    uint8_t * output,
+                                    size_t output_size)
+{
+    volatile optiga_lib_status_t crypt_event_status;
+    uint8_t random[TRUSTM_PSA_RANDOM_MIN_LENGTH];
+    uint16_t length;
+    optiga_crypt_t * me;
+    size_t offset = 0;
+    psa_status_t status = PSA_SUCCESS;
+    (void)flags;
+
+    me = trustm_crypt_acquire(trustm_psa_event_completed, (void *)&crypt_event_status);
+    if (NULL == me)
+    {
+        return (PSA_ERROR_INSUFFICIENT_MEMORY);
+    }
+    while (offset < output_size)
+    {
+        length = (uint16_t)(((output_size - offset) > TRUSTM_PSA_RANDOM_MAX_LENGTH) ?
+                            TRUSTM_PSA_RANDOM_MAX_LENGTH : (output_size - offset));
+        crypt_event_status = OPTIGA_LIB_BUSY;
+        // OPTIGA provides at least 8 bytes, a shorter rest is taken from a full random
+        if (length < TRUSTM_PSA_RANDOM_MIN_LENGTH)
+        {
+            if (OPTIGA_LIB_SUCCESS != trustm_psa_wait(&crypt_event_status,
+                                                      optiga_crypt_random(me, OPTIGA_RNG_TYPE_TRNG,
+                                                                          random, sizeof(random))))
+            {
+                status = PSA_ERROR_HARDWARE_FAILURE;
+                break;
+            }
+            memcpy(output + offset, random, length);
+            memset(random, 0x00, sizeof(random));
+        }
+        else if (OPTIGA_LIB_SUCCESS != trustm_psa_wait(&crypt_event_status,
+                                                       optiga_crypt_random(me, OPTIGA_RNG_TYPE_TRNG,
+                                                                           output + offset, length)))
+        {
+            status = PSA_ERROR_HARDWARE_FAILURE;
+            break;
+        }
+        offset += length;
+    }
+    trustm_crypt_release(me);
+    *estimate_bits = (PSA_SUCCESS == status) ? 8 * output_size : 0;
+    return (status);
+}
+
+#ifdef OPTIGA_CRYPT_HMAC_ENABLED
+/*
+* Sends the data as hmac start or update of the sequence
+*/
+static psa_status_t trustm_psa_mac_send(trustm_psa_mac_operation_t * operation,
+                                        const uint8_t * input,
+                                        uint32_t input_length)
+{
+    optiga_lib_status_t crypt_status;
+
+    operation->status = OPTIGA_LIB_BUSY;
+    if (FALSE == operation->started)
+    {
+        crypt_status = optiga_crypt_hmac_start(operation->me, operation->type, operation->secret, input, input_length);
+        operation->started = TRUE;
+    }
+    else
+    {
+        crypt_status = optiga_crypt_hmac_update(operation->me, input, input_length);
+    }
+    return ((OPTIGA_LIB_SUCCESS == trustm_psa_wait(&operation->status, crypt_status)) ?
+            PSA_SUCCESS : PSA_ERROR_HARDWARE_FAILURE);
+}
+
+psa_status_t trustm_psa_opaque_mac_sign_setup(trustm_psa_mac_operation_t * operation,
+                                              const psa_key_attributes_t * attributes,
+                                              const uint8_t * key_buffer,
+                                              size_t key_buffer_size,
+                                              psa_algorithm_t alg)
+{
+    psa_status_t status;
+
+    if ((PSA_KEY_TYPE_HMAC != psa_get_key_type(attributes)) || (!PSA_ALG_IS_HMAC(alg)))
+    {
+        return (PSA_ERROR_NOT_SUPPORTED);
+    }
+    memset(operation, 0x00, sizeof(trustm_psa_mac_operation_t));
+    switch (PSA_ALG_HMAC_GET_HASH(alg))
+    {
+        case PSA_ALG_SHA_256:
+            operation->type = OPTIGA_HMAC_SHA_256;
+            break;
+        case PSA_ALG_SHA_384:
+            operation->type = OPTIGA_HMAC_SHA_384;
+            break;
+        case PSA_ALG_SHA_512:
+            operation->type = OPTIGA_HMAC_SHA_512;
+            break;
+        default:
+            return (PSA_ERROR_NOT_SUPPORTED);
+    }
+    status = trustm_psa_get_oid(key_buffer, key_buffer_size, &operation->secret);
+    if (PSA_SUCCESS != status)
+    {
+        return (status);
+    }
+    // The sequence is strict on OPTIGA, hence the instance is kept until the finish
+    operation->me = trustm_crypt_acquire(trustm_psa_event_completed, (void *)&operation->status);
+    return ((NULL == operation->me) ? PSA_ERROR_INSUFFICIENT_MEMORY : PSA_SUCCESS);
+}
+
+psa_status_t trustm_psa_opaque_mac_update(trustm_psa_mac_operation_t * operation,
+                                          const uint8_t * input,
+                                          size_t input_length)
+{
+    uint32_t length;
+    psa_status_t status;
+
+    if (NULL == operation->me)
+    {
+        return (PSA_ERROR_BAD_STATE);
+    }
+    length = (uint32_t)(TRUSTM_PSA_MAC_BUFFER_SIZE - operation->pending_length);
+    length = (input_length < length) ? (uint32_t)input_length : length;
+    memcpy(&operation->pending[operation->pending_length], input, length);
+    operation->pending_length += length;
+    input += length;
+    input_length -= length;
+    if (0 == input_length)
+    {
+        return (PSA_SUCCESS);
+    }
+
+    // More data follows, hence the pending data is sent and the end of the input is held back for the finish
+    status = trustm_psa_mac_send(operation, operation->pending, operation->pending_length);
+    operation->pending_length = 0;
+    if ((PSA_SUCCESS == status) && (input_length > TRUSTM_PSA_MAC_BUFFER_SIZE))
+    {
+        length = (uint32_t)(input_length - TRUSTM_PSA_MAC_BUFFER_SIZE);
+        status = trustm_psa_mac_send(operation, input, length);
+        input += length;
+        input_length -= length;
+    }
+    if (PSA_SUCCESS == status)
+    {
+        memcpy(operation->pending, input, input_length);
+        operation->pending_length = (uint32_t)input_length;
+    }
+    return (status);
+}
+
+psa_status_t trustm_psa_opaque_mac_sign_finish(trustm_psa_mac_operation_t * operation,
+                                               uint8_t * mac,
+                                               size_t mac_size,
+                                               size_t * mac_length)
+{
+    optiga_lib_status_t crypt_status;
+    uint32_t length = (uint32_t)mac_size;
+    psa_status_t status = PSA_ERROR_HARDWARE_FAILURE;
+
+    if (NULL == operation->me)
+    {
+        return (PSA_ERROR_BAD_STATE);
+    }
+    // OPTIGA requires data with the final command
+    if (0 == operation->pending_length)
+    {
+        //lint --e{534} suppress "The operation is aborted"
+        trustm_psa_opaque_mac_abort(operation);
+        return (PSA_ERROR_NOT_SUPPORTED);
+    }
+    operation->status = OPTIGA_LIB_BUSY;
+    if (FALSE == operation->started)
+    {
+        crypt_status = optiga_crypt_hmac(operation->me,
+                                         operation->type,
+                                         operation->secret,
+                                         operation->pending,
+                                         operation->pending_length,
+                                         mac,
+                                         &length);
+    }
+    else
+    {
+        crypt_status = optiga_crypt_hmac_finalize(operation->me,
+                                                  operation->pending,
+                                                  operation->pending_length,
+                                                  mac,
+                                                  &length);
+    }
+    if (OPTIGA_LIB_SUCCESS == trustm_psa_wait(&operation->status, crypt_status))
+    {
+        *mac_length = length;
+        status = PSA_SUCCESS;
+    }
+    operation->started = FALSE;
+    //lint --e{534} suppress "The operation is completed"
+    trustm_psa_opaque_mac_abort(operation);
+    return (status);
+}
+
+psa_status_t trustm_psa_opaque_mac_abort(trustm_psa_mac_operation_t * operation)
+{
+    if (NULL != operation->me)
+    {
+        trustm_crypt_release(operation->me);
+    }
+    memset(operation, 0x00, sizeof(trustm_psa_mac_operation_t));
+    return (PSA_SUCCESS);
+}
+#endif //OPTIGA_CRYPT_HMAC_ENABLED
+
+#if defined (OPTIGA_CRYPT_SYM_ENCRYPT_ENABLED) && defined (OPTIGA_CRYPT_SYM_DECRYPT_ENABLED)
+static psa_status_t trustm_psa_cipher_setup(trustm_psa_cipher_operation_t * operation,
+                                            const psa_key_attributes_t * attributes,
+                                            const uint8_t * key_buffer,
+                                            size_t key_buffer_size,
+                                            psa_algorithm_t alg,
+                                            uint8_t encrypt)
+{
+    uint16_t oid;
+    psa_status_t status;
+
+    if (PSA_KEY_TYPE_AES != psa_get_key_type(attributes))
+    {
+        return (PSA_ERROR_NOT_SUPPORTED);
+    }
+    memset(operation, 0x00, sizeof(trustm_psa_cipher_operation_t));
+    if (PSA_ALG_ECB_NO_PADDING == alg)
+    {
+        operation->mode = OPTIGA_SYMMETRIC_ECB;
+    }
+    else if (PSA_ALG_CBC_NO_PADDING == alg)
+    {
+        operation->mode = OPTIGA_SYMMETRIC_CBC;
+    }
+    else
+    {
+        return (PSA_ERROR_NOT_SUPPORTED);
+    }
+    status = trustm_psa_get_oid(key_buffer, key_buffer_size, &oid);
+    if (PSA_SUCCESS != status)
+    {
+        return (status);
+    }
+    operation->key = (optiga_key_id_t)oid;
+    operation->encrypt = encrypt;
+    // The sequence is strict on OPTIGA, hence the instance is kept until the finish
+    operation->me = trustm_crypt_acquire(trustm_psa_event_completed, (void *)&operation->status);
+    return ((NULL == operation->me) ? PSA_ERROR_INSUFFICIENT_MEMORY : PSA_SUCCESS);
+}
+
+/*
+* Sends block aligned data as start, continue or final of the sequence, a final without start is a single command
+*/
+static psa_status_t trustm_psa_cipher_send(trustm_psa_cipher_operation_t * operation,
+                                           const uint8_t * input,
+                                           uint32_t input_length,
+                                           uint8_t * output,
+                                           uint8_t final)
+{
+    optiga_lib_status_t crypt_status;
+    uint32_t output_length = input_length;
+    const uint8_t * iv = (0 != operation->iv_length) ? operation->iv : NULL;
+
+    operation->status = OPTIGA_LIB_BUSY;
+    if ((FALSE == operation->started) && (TRUE == final))
+    {
+        crypt_status = (TRUE == operation->encrypt) ?
+            optiga_crypt_symmetric_encrypt(operation->me, operation->mode, operation->key, input, input_length,
+                                           iv, operation->iv_length, NULL, 0, output, &output_length) :
+            optiga_crypt_symmetric_decrypt(operation->me, operation->mode, operation->key, input, input_length,
+                                           iv, operation->iv_length, NULL, 0, output, &output_length);
+    }
+    else if (FALSE == operation->started)
+    {
+        crypt_status = (TRUE == operation->encrypt) ?
+            optiga_crypt_symmetric_encrypt_start(operation->me, operation->mode, operation->key, input, input_length,
+                                                 iv, operation->iv_length, NULL, 0, 0, output, &output_length) :
+            optiga_crypt_symmetric_decrypt_start(operation->me, operation->mode, operation->key, input, input_length,
+                                                 iv, operation->iv_length, NULL, 0, 0, output, &output_length);
+        operation->started = TRUE;
+    }
+    else if (TRUE == final)
+    {
+        crypt_status = (TRUE == operation->encrypt) ?
+            optiga_crypt_symmetric_encrypt_final(operation->me, input, input_length, output, &output_length) :
+            optiga_crypt_symmetric_decrypt_final(operation->me, input, input_length, output, &output_length);
+    }
+    else
+    {
+        crypt_status = (TRUE == operation->encrypt) ?
+            optiga_crypt_symmetric_encrypt_continue(operation->me, input, input_length, output, &output_length) :
+            optiga_crypt_symmetric_decrypt_continue(operation->me, input, input_length, output, &output_length);
+    }
+    return ((OPTIGA_LIB_SUCCESS == trustm_psa_wait(&operation->status, crypt_status)) ?
+            PSA_SUCCESS : PSA_ERROR_HARDWARE_FAILURE);
+}
+
+psa_status_t trustm_psa_opaque_cipher_encrypt_setup(trustm_psa_cipher_operation_t * operation,
+                                                    const psa_key_attributes_t * attributes,
+                                                    const uint8_t * key_buffer,
+                                                    size_t key_buffer_size,
+                                                    psa_algorithm_t alg)
+{
+    return (trustm_psa_cipher_setup(operation, attributes, key_buffer, key_buffer_size, alg, TRUE));
+}
+
+psa_status_t trustm_psa_opaque_cipher_decrypt_setup(trustm_psa_cipher_operation_t * operation,
+                                                    const psa_key_attributes_t * attributes,
+                                                    const uint8_t * key_buffer,
+                                                    size_t key_buffer_size,
+                                                    psa_algorithm_t alg)
+{
+    return (trustm_psa_cipher_setup(operation, attributes, key_buffer, key_buffer_size, alg, FALSE));
+}
+
+psa_status_t trustm_psa_opaque_cipher_set_iv(trustm_psa_cipher_operation_t * operation,
+                                             const uint8_t * iv,
+                                             size_t iv_length)
+{
+    if ((NULL == operation->me) || (OPTIGA_SYMMETRIC_CBC != operation->mode) || (TRUE == operation->started))
+    {
+        return (PSA_ERROR_BAD_STATE);
+    }
+    if (TRUSTM_PSA_AES_BLOCK_SIZE != iv_length)
+    {
+        return (PSA_ERROR_INVALID_ARGUMENT);
+    }
+    memcpy(operation->iv, iv, TRUSTM_PSA_AES_BLOCK_SIZE);
+    operation->iv_length = TRUSTM_PSA_AES_BLOCK_SIZE;
+    return (PSA_SUCCESS);
+}
+
+psa_status_t trustm_psa_opaque_cipher_update(trustm_psa_cipher_operation_t * operation,
+                                             const uint8_t * input,
+                                             size_t input_length,
+                                             uint8_t * output,
+                                             size_t output_size,
+                                             size_t * output_length)
+{
+    uint32_t length;
+    uint32_t direct_length = 0;
+    psa_status_t status;
+
+    *output_length = 0;
+    if (NULL == operation->me)
+    {
+        return (PSA_ERROR_BAD_STATE);
+    }
+    length = TRUSTM_PSA_AES_BLOCK_SIZE - operation->pending_length;
+    length = (input_length < length) ? (uint32_t)input_length : length;
+    if (input_length > length)
+    {
+        // Whole blocks are processed, 1 to 16 bytes are held back for the final command
+        direct_length = (uint32_t)(((input_length - length - 1) / TRUSTM_PSA_AES_BLOCK_SIZE) *
+                                   TRUSTM_PSA_AES_BLOCK_SIZE);
+        if (output_size < TRUSTM_PSA_AES_BLOCK_SIZE + direct_length)
+        {
+            return (PSA_ERROR_BUFFER_TOO_SMALL);
+        }
+    }
+    memcpy(&operation->pending[operation->pending_length], input, length);
+    operation->pending_length += length;
+    input += length;
+    input_length -= length;
+    if (0 == input_length)
+    {
+        return (PSA_SUCCESS);
+    }
+
+    status = trustm_psa_cipher_send(operation, operation->pending, TRUSTM_PSA_AES_BLOCK_SIZE, output, FALSE);
+    if ((PSA_SUCCESS == status) && (0 != direct_length))
+    {
+        // The input of the caller is processed in place, without copy
+        status = trustm_psa_cipher_send(operation, input, direct_length, output + TRUSTM_PSA_AES_BLOCK_SIZE, FALSE);
+    }
+    if (PSA_SUCCESS != status)
+    {
+        return (status);
+    }
+    memcpy(operation->pending, input + direct_length, input_length - direct_length);
+    operation->pending_length = (uint32_t)(input_length - direct_length);
+    *output_length = TRUSTM_PSA_AES_BLOCK_SIZE + direct_length;
+    return (PSA_SUCCESS);
+}
+
+psa_status_t trustm_psa_opaque_cipher_finish(trustm_psa_cipher_operation_t * operation,
+                                             uint8_t * output,
+                                             size_t output_size,
+                                             size_t * output_length)
+{
+    psa_status_t status;
+
+    *output_length = 0;
+    if (NULL == operation->me)
+    {
+        return (PSA_ERROR_BAD_STATE);
+    }
+    // No padding is supported, the total input must be block aligned
+    if (TRUSTM_PSA_AES_BLOCK_SIZE != operation->pending_length)
+    {
+        status = PSA_ERROR_INVALID_ARGUMENT;
+    }
+    else if (output_size < TRUSTM_PSA_AES_BLOCK_SIZE)
+    {
+        status = PSA_ERROR_BUFFER_TOO_SMALL;
+    }
+    else
+    {
+        status = trustm_psa_cipher_send(operation, operation->pending, TRUSTM_PSA_AES_BLOCK_SIZE, output, TRUE);
+        if (PSA_SUCCESS == status)
+        {
+            *output_length = TRUSTM_PSA_AES_BLOCK_SIZE;
+        }
+    }
+    //lint --e{534} suppress "The operation is completed"
+    trustm_psa_opaque_cipher_abort(operation);
+    return (status);
+}
+
+psa_status_t trustm_psa_opaque_cipher_abort(trustm_psa_cipher_operation_t * operation)
+{
+    if (NULL != operation->me)
+    {
+        trustm_crypt_release(operation->me);
+    }
+    memset(operation, 0x00, sizeof(trustm_psa_cipher_operation_t));
+    return (PSA_SUCCESS);
+}
+#endif //OPTIGA_CRYPT_SYM_ENCRYPT_ENABLED && OPTIGA_CRYPT_SYM_DECRYPT_ENABLED
+
+#endif //TRUSTM_PSA_DRIVER_ENABLED
+
+/**
+* @}
+*/
@@ -37,15 +37,41 @@
 #include <sys/types.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 #if defined(MBEDTLS_ENTROPY_HARDWARE_ALT)
 
 #include "optiga/optiga_crypt.h"
 #include "optiga/optiga_util.h"
 #include "optiga/common/optiga_lib_common.h"
+#include "optiga/optiga_crypt_random_pool.h"
+#include "trustm_crypt_pool.h"
+#include "mbedtls/platform_util.h"
 
 optiga_lib_status_t crypt_event_completed_status;
 
+#ifdef OPTIGA_CRYPT_RANDOM_POOL_ENABLED
+// Random pool, which serves the requests from memory, initialized with the first request
+static optiga_crypt_random_pool_t random_pool;
+static uint8_t random_pool_initialized = FALSE;
+#endif //OPTIGA_CRYPT_RANDOM_POOL_ENABLED
+
+/// Size of the reserve, which is refilled with one GetRandom command (maximum length of the command)
+#ifndef TRUSTM_RANDOM_RESERVE_SIZE
+#define TRUSTM_RANDOM_RESERVE_SIZE          (0x100)
+#endif
+/// Number of polls served from one refill of the reserve, the remaining bytes are discarded afterwards
+#ifndef TRUSTM_RANDOM_RESERVE_MAX_POLLS
+#define TRUSTM_RANDOM_RESERVE_MAX_POLLS     (8)
+#endif
+
+// Reserve of random bytes for the polls, which can't be served from the random pool
+static uint8_t random_reserve[TRUSTM_RANDOM_RESERVE_SIZE];
+// Number of bytes not yet served, at the end of the reserve
+static uint16_t random_reserve_available = 0;
+// Number of polls served since the last refill
+static uint8_t random_reserve_polls = 0;
+
 //lint --e{818} suppress "argument "context" is not used in the sample provided"
 static void optiga_crypt_event_completed(void * context, optiga_lib_status_t return_status)
 {
@@ -56,50 +82,146 @@ static void optiga_crypt_event_completed(void * context, optiga_lib_status_t ret
     }
 }
 
-int mbedtls_hardware_poll( void *data,
-                           unsigned char *output, size_t len, size_t *olen )
+/*
+* Generates the random bytes with one GetRandom command, blocks until completion
+*/
+static int trustm_random_generate(uint8_t * p_random, uint16_t length)
 {
     int error = 0;
     optiga_crypt_t * me = NULL;
     optiga_lib_status_t command_queue_status = OPTIGA_CRYPT_ERROR;
 
-    if (olen != NULL)
+    me = trustm_crypt_acquire(optiga_crypt_event_completed, NULL);
+    if (NULL == me)
+    {
+        // MBEDTLS_ERR_PK_FEATURE_UNAVAILABLE
+        return (-0x0034);
+    }
+    crypt_event_completed_status = OPTIGA_LIB_BUSY;
+    command_queue_status = optiga_crypt_random(me, OPTIGA_RNG_TYPE_TRNG, p_random, length);
+    if (command_queue_status != OPTIGA_LIB_SUCCESS)
     {
-        me = optiga_crypt_create(0, optiga_crypt_event_completed, NULL);
-        if (NULL == me)
+        // MBEDTLS_ERR_PK_FEATURE_UNAVAILABLE
+        error = -0x0034;
+    }
+    if (!error)
+    {
+        while (OPTIGA_LIB_BUSY == crypt_event_completed_status)
+        {
+            pal_os_timer_delay_in_milliseconds(5);
+        }
+        if (crypt_event_completed_status != OPTIGA_LIB_SUCCESS)
         {
             // MBEDTLS_ERR_PK_FEATURE_UNAVAILABLE
             error = -0x0034;
         }
-        else
+    }
+    trustm_crypt_release(me);
+    return (error);
+}
+
+/*
+* Discards the reserve, the bytes are erased
+*/
+static void trustm_random_reserve_flush(void)
+{
+    mbedtls_platform_zeroize(random_reserve, sizeof(random_reserve));
+    random_reserve_available = 0;
+    random_reserve_polls = 0;
+}
+
+/*
+* Serves the random bytes from the reserve, which is refilled with one block of TRUSTM_RANDOM_RESERVE_SIZE bytes
+*/
+static int trustm_random_reserve_get(unsigned char * output, size_t len)
+{
+    int error = 0;
+    uint16_t offset;
+
+    if (len > random_reserve_available)
+    {
+        // The remaining bytes are too few, they are not combined with a new block
+        trustm_random_reserve_flush();
+        error = trustm_random_generate(random_reserve, TRUSTM_RANDOM_RESERVE_SIZE);
+        if (error)
         {
-            crypt_event_completed_status = OPTIGA_LIB_BUSY;
-            command_queue_status = optiga_crypt_random(me, OPTIGA_RNG_TYPE_TRNG, output, len);
-            if( command_queue_status != OPTIGA_LIB_SUCCESS)
+            trustm_random_reserve_flush();
+            return (error);
+        }
+        random_reserve_available = TRUSTM_RANDOM_RESERVE_SIZE;
+    }
+
+    // Every byte is served once and erased right away
+    offset = (uint16_t)(TRUSTM_RANDOM_RESERVE_SIZE - random_reserve_available);
+    memcpy(output, &random_reserve[offset], len);
+    mbedtls_platform_zeroize(&random_reserve[offset], len);
+    random_reserve_available -= (uint16_t)len;
+
+    // The bytes are not kept on host for more than TRUSTM_RANDOM_RESERVE_MAX_POLLS polls
+    random_reserve_polls++;
+    if (random_reserve_polls >= TRUSTM_RANDOM_RESERVE_MAX_POLLS)
+    {
+        trustm_random_reserve_flush();
+    }
+    return (error);
+}
+
+int mbedtls_hardware_poll( void *data,
+                           unsigned char *output, size_t len, size_t *olen )
+{
+    int error = 0;
+    uint8_t served_from_pool = FALSE;
+    size_t length;
+    size_t served = 0;
+
+#ifdef OPTIGA_CRYPT_RANDOM_POOL_ENABLED
+    if ((olen != NULL) && (len <= OPTIGA_CRYPT_RANDOM_POOL_SIZE))
+    {
+        if (FALSE == random_pool_initialized)
+        {
+            if (OPTIGA_LIB_SUCCESS == optiga_crypt_random_pool_init(&random_pool,
+                                                                    0,
+                                                                    OPTIGA_RNG_TYPE_TRNG,
+                                                                    OPTIGA_CRYPT_RANDOM_POOL_SIZE / 2))
             {
-                // MBEDTLS_ERR_PK_FEATURE_UNAVAILABLE
-                error = -0x0034;
+                random_pool_initialized = TRUE;
             }
+        }
+        // Requests, which can't be served from the pool, are sent to OPTIGA
+        if ((TRUE == random_pool_initialized) &&
+            (OPTIGA_LIB_SUCCESS == optiga_crypt_random_pool_get(&random_pool, output, (uint16_t)len)))
+        {
+            *olen = len;
+            served_from_pool = TRUE;
+        }
+    }
+#endif //OPTIGA_CRYPT_RANDOM_POOL_ENABLED
 
-            if (!error)
+    if ((olen != NULL) && (FALSE == served_from_pool))
+    {
+        // Full blocks are generated into the output, the rest is served from the reserve
+        while ((!error) && (served < len))
+        {
+            length = len - served;
+            if (length >= TRUSTM_RANDOM_RESERVE_SIZE)
             {
-                while (OPTIGA_LIB_BUSY == crypt_event_completed_status)
-                {
-                    pal_os_timer_delay_in_milliseconds(5);
-                }
-
-                if(crypt_event_completed_status!= OPTIGA_LIB_SUCCESS)
-                {
-                    // MBEDTLS_ERR_PK_FEATURE_UNAVAILABLE
-                    error = -0x0034;
-                }
-                else
-                {
-                    *olen = len;
-                }
+                length = TRUSTM_RANDOM_RESERVE_SIZE;
+                error = trustm_random_generate(&output[served], (uint16_t)length);
             }
+            else
+            {
+                error = trustm_random_reserve_get(&output[served], length);
+            }
+            served += length;
+        }
+        if (!error)
+        {
+            *olen = len;
+        }
+        else
+        {
+            mbedtls_platform_zeroize(output, len);
         }
-      optiga_crypt_destroy(me); //CCW => Seems to be missing?
     }
 
     return error;
@@ -62,6 +62,7 @@
 #include "optiga/common/optiga_lib_common.h"
 #include "optiga/pal/pal_os_memory.h"
 #include "optiga/pal/pal_os_timer.h"
+#include "trustm_crypt_pool.h"
 
 /* Parameter validation macros */
 #define RSA_VALIDATE_RET( cond )                                       \
@@ -74,9 +75,14 @@
 #define TRUSTM_RSA_1024_KEYSIZE              (0x0080)
 #define TRUSTM_RSA_2048_KEYSIZE              (0x0100)
 #define TRUSTM_RSA_PUBLIC_KEY_MAX_SIZE       (300)
-#define TRUSTM_RSA_SIGNATURE_LEN_MAX_SIZE    (300)
 #define TRUSTM_RSA_NEGATIVE_INTEGER          (0x7F)
 
+/*
+ * Signatures of public keys on host are verified with the bignum of mbedTLS.
+ * Define TRUSTM_RSA_VERIFY_ON_OPTIGA, if the policy requires the verification by OPTIGA.
+ */
+//#define TRUSTM_RSA_VERIFY_ON_OPTIGA
+
 #ifndef CONFIG_OPTIGA_TRUST_M_PRIVKEY_SLOT
 #define CONFIG_OPTIGA_TRUST_M_PRIVKEY_SLOT 		(0xE0FC)
 #endif
@@ -267,6 +273,65 @@ static int mbedtls_rsa_get_sig_len_key_type(uint16_t modulus_length,
     return (return_status);
 }
 
+/*
+ * Releases the cached public key, once N or E is changed
+ */
+static void mbedtls_rsa_reset_public_key(mbedtls_rsa_context * ctx)
+{
+    pal_os_free(ctx->public_key);
+    ctx->public_key = NULL;
+    ctx->public_key_len = 0;
+}
+
+/*
+ * Provides the public key in the OPTIGA format, which is built only on the first use of the context
+ */
+static int mbedtls_rsa_get_public_key(mbedtls_rsa_context * ctx, public_key_from_host_t * public_key)
+{
+    uint8_t * modulus_buffer = NULL;
+    uint8_t public_exponent_buffer[4] = {0x00};
+    uint16_t key_length = 0;
+    int return_status;
+
+    return_status = mbedtls_rsa_get_sig_len_key_type((uint16_t)ctx->len, NULL, &(public_key->key_type));
+    if (0 != return_status)
+    {
+        return (return_status);
+    }
+
+    if (NULL == ctx->public_key)
+    {
+        return_status = MBEDTLS_ERR_RSA_BAD_INPUT_DATA;
+        ctx->public_key = pal_os_calloc(1, TRUSTM_RSA_PUBLIC_KEY_MAX_SIZE);
+        // Modulus is taken from the scratch arena
+        modulus_buffer = trustm_scratch_acquire();
+        if ((NULL != ctx->public_key) && (NULL != modulus_buffer) && (ctx->len <= TRUSTM_SCRATCH_ARENA_SIZE) &&
+            (0 == mbedtls_mpi_write_binary(&(ctx->N), modulus_buffer, ctx->len)) &&
+            (0 == mbedtls_mpi_write_binary(&(ctx->E), public_exponent_buffer, sizeof(public_exponent_buffer))))
+        {
+            // RSA public key formation according to DER encoded format
+            mbedtls_rsa_create_public_key_bit_string_format(modulus_buffer,
+                                                            (uint16_t)ctx->len,
+                                                            public_exponent_buffer,
+                                                            sizeof(public_exponent_buffer),
+                                                            ctx->public_key,
+                                                            &key_length);
+            ctx->public_key_len = key_length;
+            return_status = 0;
+        }
+        trustm_scratch_release(modulus_buffer);
+        if (0 != return_status)
+        {
+            mbedtls_rsa_reset_public_key(ctx);
+            return (return_status);
+        }
+    }
+
+    public_key->public_key = ctx->public_key;
+    public_key->length = (uint16_t)ctx->public_key_len;
+    return (0);
+}
+
 #endif /* MBEDTLS_PKCS1_V15 */
 
 int mbedtls_rsa_import( mbedtls_rsa_context *ctx,
@@ -289,6 +354,11 @@ int mbedtls_rsa_import( mbedtls_rsa_context *ctx,
     if( N != NULL )
         ctx->len = mbedtls_mpi_size( &ctx->N );
 
+#if defined(MBEDTLS_PKCS1_V15)
+    if( N != NULL || E != NULL )
+        mbedtls_rsa_reset_public_key( ctx );
+#endif
+
     return( 0 );
 }
 
@@ -320,6 +390,11 @@ int mbedtls_rsa_import_raw( mbedtls_rsa_context *ctx,
     if( E != NULL )
         MBEDTLS_MPI_CHK( mbedtls_mpi_read_binary( &ctx->E, E, E_len ) );
 
+#if defined(MBEDTLS_PKCS1_V15)
+    if( N != NULL || E != NULL )
+        mbedtls_rsa_reset_public_key( ctx );
+#endif
+
 cleanup:
 
     if( ret != 0 )
@@ -1390,11 +1465,7 @@ int mbedtls_rsa_rsaes_pkcs1_v15_encrypt( mbedtls_rsa_context *ctx,
     optiga_crypt_t * me_crypt = NULL;
     int return_status = MBEDTLS_ERR_RSA_BAD_INPUT_DATA;
     public_key_from_host_t public_key_from_host;
-    uint8_t * bit_string_pb_key = NULL;
-    uint8_t * modulus_buffer = NULL;
-    uint8_t public_exponent_buffer[4] = {0x00};
-    uint16_t modulus_length = 0;
-    uint16_t public_exponent_length = 4;
+    uint16_t encrypted_length;
 
     RSA_VALIDATE_RET( ctx != NULL );
     RSA_VALIDATE_RET( mode == MBEDTLS_RSA_PRIVATE ||
@@ -1405,54 +1476,21 @@ int mbedtls_rsa_rsaes_pkcs1_v15_encrypt( mbedtls_rsa_context *ctx,
     if( mode == MBEDTLS_RSA_PRIVATE && ctx->padding != MBEDTLS_RSA_PKCS_V15 )
         return( MBEDTLS_ERR_RSA_BAD_INPUT_DATA );
 
-    me_crypt = optiga_crypt_create(0, optiga_crypt_event_completed, NULL);
+    me_crypt = trustm_crypt_acquire(optiga_crypt_event_completed, NULL);
     if (NULL == me_crypt)
     {
         return_status = MBEDTLS_ERR_RSA_BAD_INPUT_DATA;
         goto cleanup;
     }
 
-    modulus_length = ctx->len;
-
-    bit_string_pb_key = pal_os_calloc(1,TRUSTM_RSA_PUBLIC_KEY_MAX_SIZE);
-    if (NULL == bit_string_pb_key)
-    {
-        return_status = MBEDTLS_ERR_RSA_BAD_INPUT_DATA;
-        goto cleanup;
-    }
-    modulus_buffer = pal_os_calloc(1,modulus_length);
-    if (NULL == modulus_buffer)
-    {
-        return_status = MBEDTLS_ERR_RSA_BAD_INPUT_DATA;
-        goto cleanup;
-    }
-
-    // Write the public key components
-    return_status = mbedtls_mpi_write_binary(&(ctx->N), modulus_buffer, modulus_length);
-    return_status |= mbedtls_mpi_write_binary(&(ctx->E), public_exponent_buffer, public_exponent_length);
-
-    if (0 != return_status)
-    {
-        return_status = MBEDTLS_ERR_RSA_BAD_INPUT_DATA;
-        goto cleanup;
-    }
-
-    // Get the RSA key type
-    return_status = mbedtls_rsa_get_sig_len_key_type(modulus_length, NULL, &(public_key_from_host.key_type));
+    // The public key of the context is converted only once
+    return_status = mbedtls_rsa_get_public_key(ctx, &public_key_from_host);
     if (0 != return_status)
     {
         goto cleanup;
     }
-
-    // RSA public key formation according to DER encoded format
-    mbedtls_rsa_create_public_key_bit_string_format(modulus_buffer,
-                                                    modulus_length,
-                                                    public_exponent_buffer,
-                                                    public_exponent_length,
-                                                    bit_string_pb_key,
-                                                    &public_key_from_host.length);
-
-    public_key_from_host.public_key = bit_string_pb_key;
+    return_status = MBEDTLS_ERR_RSA_BAD_INPUT_DATA;
+    encrypted_length = (uint16_t)ctx->len;
 
     crypt_event_completed_status = OPTIGA_LIB_BUSY;
     crypt_sync_status = optiga_crypt_rsa_encrypt_message(me_crypt,
@@ -1464,7 +1502,7 @@ int mbedtls_rsa_rsaes_pkcs1_v15_encrypt( mbedtls_rsa_context *ctx,
 															OPTIGA_CRYPT_HOST_DATA,
 															&public_key_from_host,
 															output,
-															(uint16_t *)&ctx->len);
+															&encrypted_length);
     if (OPTIGA_LIB_SUCCESS != crypt_sync_status)
     {
         goto cleanup;
@@ -1482,13 +1520,11 @@ int mbedtls_rsa_rsaes_pkcs1_v15_encrypt( mbedtls_rsa_context *ctx,
     }
     return_status = 0;
 cleanup:
-	// destroy crypt instances
+	// release crypt instances
 	if (me_crypt != NULL)
 	{
-		(void)optiga_crypt_destroy(me_crypt);
+		trustm_crypt_release(me_crypt);
 	}
-	pal_os_free(modulus_buffer);
-	pal_os_free(bit_string_pb_key);
 
 	return (return_status);
 }
@@ -1698,7 +1734,7 @@ int mbedtls_rsa_rsaes_pkcs1_v15_decrypt( mbedtls_rsa_context *ctx,
     RSA_VALIDATE_RET( input != NULL );
     RSA_VALIDATE_RET( olen != NULL );
 
-    me_crypt = optiga_crypt_create(0, optiga_crypt_event_completed, NULL);
+    me_crypt = trustm_crypt_acquire(optiga_crypt_event_completed, NULL);
     if (NULL == me_crypt)
     {
         return_status = MBEDTLS_ERR_RSA_BAD_INPUT_DATA;
@@ -1731,10 +1767,10 @@ int mbedtls_rsa_rsaes_pkcs1_v15_decrypt( mbedtls_rsa_context *ctx,
     }
     return_status = 0;
 cleanup:
-    // destroy crypt instances
+    // release crypt instances
     if (me_crypt != NULL)
     {
-        (void)optiga_crypt_destroy(me_crypt);
+        trustm_crypt_release(me_crypt);
     }
 
     return (return_status);
@@ -1925,7 +1961,6 @@ int mbedtls_rsa_rsassa_pkcs1_v15_sign( mbedtls_rsa_context *ctx,
     optiga_rsa_signature_scheme_t signature_scheme;
     optiga_lib_status_t crypt_sync_status = OPTIGA_CRYPT_ERROR;
     optiga_crypt_t * me_crypt = NULL;
-    uint8_t * signature_buffer = NULL;
     uint16_t  signature_len = 0;
     int return_status = MBEDTLS_ERR_RSA_BAD_INPUT_DATA;
     uint16_t modulus_length = 0;
@@ -1941,7 +1976,7 @@ int mbedtls_rsa_rsassa_pkcs1_v15_sign( mbedtls_rsa_context *ctx,
         return(MBEDTLS_ERR_RSA_BAD_INPUT_DATA);
 
     // Create crypt instance
-    me_crypt = optiga_crypt_create(0, optiga_crypt_event_completed, NULL);
+    me_crypt = trustm_crypt_acquire(optiga_crypt_event_completed, NULL);
     if (NULL == me_crypt)
     {
         return_status = MBEDTLS_ERR_RSA_BAD_INPUT_DATA;
@@ -1957,15 +1992,7 @@ int mbedtls_rsa_rsassa_pkcs1_v15_sign( mbedtls_rsa_context *ctx,
 
     modulus_length = ctx->len;
 
-    signature_buffer = pal_os_calloc(1,TRUSTM_RSA_SIGNATURE_LEN_MAX_SIZE);
-    if (NULL == signature_buffer)
-    {
-        return_status = MBEDTLS_ERR_RSA_BAD_INPUT_DATA;
-        goto cleanup;
-    }
-    signature_len = TRUSTM_RSA_SIGNATURE_LEN_MAX_SIZE;
-
-    // Get the RSA signature length
+    // Get the RSA signature length, the signature is written to sig, which is of the modulus length
     return_status = mbedtls_rsa_get_sig_len_key_type(modulus_length, &signature_len, NULL);
     if (0 != return_status)
     {
@@ -1979,7 +2006,7 @@ int mbedtls_rsa_rsassa_pkcs1_v15_sign( mbedtls_rsa_context *ctx,
                                               hash,
                                               digest_length,
                                               CONFIG_OPTIGA_TRUST_M_PRIVKEY_SLOT,
-                                              signature_buffer,
+                                              sig,
                                               &signature_len,
                                               0);
 
@@ -2008,15 +2035,13 @@ int mbedtls_rsa_rsassa_pkcs1_v15_sign( mbedtls_rsa_context *ctx,
         goto cleanup;
     }
 
-    pal_os_memcpy(sig, signature_buffer, modulus_length);
     return_status = 0;
 
 cleanup:
-    pal_os_free(signature_buffer);
-    // destroy crypt instances
+    // release crypt instances
     if (me_crypt != NULL)
     {
-        (void)optiga_crypt_destroy(me_crypt);
+        trustm_crypt_release(me_crypt);
     }
 
     return (return_status);
@@ -2251,6 +2276,72 @@ int mbedtls_rsa_rsassa_pss_verify( mbedtls_rsa_context *ctx,
  * Implementation of the PKCS#1 v2.1 RSASSA-PKCS1-v1_5-VERIFY function
  */
 
+#if !defined(TRUSTM_RSA_VERIFY_ON_OPTIGA)
+/*
+ * Verifies the signature with the public key on host, EMSA-PKCS1-v1_5 encoding of the digest
+ */
+static int mbedtls_rsa_rsassa_pkcs1_v15_verify_on_host( mbedtls_rsa_context *ctx,
+                                                        mbedtls_md_type_t md_alg,
+                                                        const unsigned char *hash,
+                                                        const unsigned char *sig )
+{
+    // DigestInfo header of the digests supported by OPTIGA
+    static const uint8_t digest_info_sha256[] = {0x30, 0x31, 0x30, 0x0D, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01,
+                                                 0x65, 0x03, 0x04, 0x02, 0x01, 0x05, 0x00, 0x04, 0x20};
+    static const uint8_t digest_info_sha384[] = {0x30, 0x41, 0x30, 0x0D, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01,
+                                                 0x65, 0x03, 0x04, 0x02, 0x02, 0x05, 0x00, 0x04, 0x30};
+    static const uint8_t digest_info_sha512[] = {0x30, 0x51, 0x30, 0x0D, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01,
+                                                 0x65, 0x03, 0x04, 0x02, 0x03, 0x05, 0x00, 0x04, 0x40};
+    const uint8_t * digest_info;
+    uint8_t * decrypted = NULL;
+    uint8_t * encoded = NULL;
+    uint8_t digest_length = 0;
+    size_t padding_length;
+    int return_status;
+
+    return_status = mbedtls_rsa_get_sig_scheme_digest_len(md_alg, NULL, &digest_length);
+    if (0 != return_status)
+    {
+        return (return_status);
+    }
+    digest_info = (MBEDTLS_MD_SHA256 == md_alg) ? digest_info_sha256 :
+                  ((MBEDTLS_MD_SHA384 == md_alg) ? digest_info_sha384 : digest_info_sha512);
+    // 0x00 0x01 PS 0x00 DigestInfo, with at least 8 bytes of PS
+    if ((ctx->len < sizeof(digest_info_sha256) + digest_length + 11) || ((2 * ctx->len) > TRUSTM_SCRATCH_ARENA_SIZE))
+    {
+        return (MBEDTLS_ERR_RSA_BAD_INPUT_DATA);
+    }
+
+    // Decrypted and encoded block are taken from the scratch arena, which is cleared on release
+    decrypted = trustm_scratch_acquire();
+    if (NULL == decrypted)
+    {
+        return (MBEDTLS_ERR_MPI_ALLOC_FAILED);
+    }
+    encoded = decrypted + ctx->len;
+
+    return_status = mbedtls_rsa_public(ctx, sig, decrypted);
+    if (0 == return_status)
+    {
+        padding_length = ctx->len - sizeof(digest_info_sha256) - digest_length - 3;
+        encoded[0] = 0x00;
+        encoded[1] = 0x01;
+        memset(&encoded[2], 0xFF, padding_length);
+        encoded[2 + padding_length] = 0x00;
+        pal_os_memcpy(&encoded[3 + padding_length], digest_info, sizeof(digest_info_sha256));
+        pal_os_memcpy(&encoded[3 + padding_length + sizeof(digest_info_sha256)], hash, digest_length);
+
+        if (0 != mbedtls_safer_memcmp(decrypted, encoded, ctx->len))
+        {
+            return_status = MBEDTLS_ERR_RSA_VERIFY_FAILED;
+        }
+    }
+
+    trustm_scratch_release(decrypted);
+    return (return_status);
+}
+#endif
+
 int mbedtls_rsa_rsassa_pkcs1_v15_verify( mbedtls_rsa_context *ctx,
                                  int (*f_rng)(void *, unsigned char *, size_t),
                                  void *p_rng,
@@ -2260,20 +2351,15 @@ int mbedtls_rsa_rsassa_pkcs1_v15_verify( mbedtls_rsa_context *ctx,
                                  const unsigned char *hash,
                                  const unsigned char *sig )
 {
-
-
+#if defined(TRUSTM_RSA_VERIFY_ON_OPTIGA)
     optiga_rsa_signature_scheme_t signature_scheme;
     optiga_lib_status_t crypt_sync_status = OPTIGA_CRYPT_ERROR;
     public_key_from_host_t public_key;
     optiga_crypt_t * me_crypt = NULL;
-    uint8_t * bit_string_pb_key = NULL;
-    uint8_t * modulus_buffer = NULL;
-    uint8_t public_exponent_buffer[4] = {0x00};
     uint16_t  signature_len = 0;
     int return_status = MBEDTLS_ERR_RSA_BAD_INPUT_DATA;
-    uint16_t modulus_length = 0;
-    uint16_t public_exponent_length = 4;
     uint8_t digest_length = 0;
+#endif
 
     RSA_VALIDATE_RET( ctx != NULL );
     RSA_VALIDATE_RET( mode == MBEDTLS_RSA_PRIVATE ||
@@ -2286,8 +2372,12 @@ int mbedtls_rsa_rsassa_pkcs1_v15_verify( mbedtls_rsa_context *ctx,
     if( mode == MBEDTLS_RSA_PRIVATE && ctx->padding != MBEDTLS_RSA_PKCS_V15 )
         return( MBEDTLS_ERR_RSA_BAD_INPUT_DATA );
 
+#if !defined(TRUSTM_RSA_VERIFY_ON_OPTIGA)
+    // The public key is on host, hence no command to OPTIGA is required
+    return (mbedtls_rsa_rsassa_pkcs1_v15_verify_on_host(ctx, md_alg, hash, sig));
+#else
     // Create crypt instance
-    me_crypt = optiga_crypt_create(0, optiga_crypt_event_completed, NULL);
+    me_crypt = trustm_crypt_acquire(optiga_crypt_event_completed, NULL);
     if (NULL == me_crypt)
     {
         return_status = MBEDTLS_ERR_RSA_BAD_INPUT_DATA;
@@ -2301,48 +2391,20 @@ int mbedtls_rsa_rsassa_pkcs1_v15_verify( mbedtls_rsa_context *ctx,
         goto cleanup;
     }
 
-    bit_string_pb_key = pal_os_calloc(1,TRUSTM_RSA_PUBLIC_KEY_MAX_SIZE);
-    if (NULL == bit_string_pb_key)
-    {
-        return_status = MBEDTLS_ERR_RSA_BAD_INPUT_DATA;
-        goto cleanup;
-    }
-    modulus_buffer = pal_os_calloc(1,ctx->len);
-    if (NULL == modulus_buffer)
-    {
-        return_status = MBEDTLS_ERR_RSA_BAD_INPUT_DATA;
-        goto cleanup;
-    }
-
-    modulus_length = ctx->len;
-
-    // Write the public key components
-    return_status = mbedtls_mpi_write_binary(&(ctx->N), modulus_buffer, modulus_length);
-    return_status |= mbedtls_mpi_write_binary(&(ctx->E), public_exponent_buffer, public_exponent_length);
-
+    // Get the signature length
+    return_status = mbedtls_rsa_get_sig_len_key_type((uint16_t)ctx->len, &signature_len, NULL);
     if (0 != return_status)
     {
-        return_status = MBEDTLS_ERR_RSA_BAD_INPUT_DATA;
         goto cleanup;
     }
 
-    // Get the RSA key type and signature length
-    return_status = mbedtls_rsa_get_sig_len_key_type(modulus_length, &signature_len, &(public_key.key_type));
+    // The public key of the context is converted only once
+    return_status = mbedtls_rsa_get_public_key(ctx, &public_key);
     if (0 != return_status)
     {
         goto cleanup;
     }
 
-    // RSA public key formation according to DER encoded format
-    mbedtls_rsa_create_public_key_bit_string_format(modulus_buffer,
-                                                    modulus_length,
-                                                    public_exponent_buffer,
-                                                    public_exponent_length,
-                                                    bit_string_pb_key,
-                                                    &public_key.length);
-
-    public_key.public_key = bit_string_pb_key;
-
     crypt_event_completed_status = OPTIGA_LIB_BUSY;
     crypt_sync_status = optiga_crypt_rsa_verify(me_crypt,
                                                 signature_scheme,
@@ -2375,15 +2437,14 @@ int mbedtls_rsa_rsassa_pkcs1_v15_verify( mbedtls_rsa_context *ctx,
     return_status = 0;
 cleanup:
 
-    pal_os_free(modulus_buffer);
-    pal_os_free(bit_string_pb_key);
-    // destroy crypt instances
+    // release crypt instances
     if (me_crypt != NULL)
     {
-        (void)optiga_crypt_destroy(me_crypt);
+        trustm_crypt_release(me_crypt);
     }
 
     return (return_status);
+#endif
 }
 #endif /* MBEDTLS_PKCS1_V15 */
 
@@ -2461,6 +2522,11 @@ int mbedtls_rsa_copy( mbedtls_rsa_context *dst, const mbedtls_rsa_context *src )
     dst->padding = src->padding;
     dst->hash_id = src->hash_id;
 
+#if defined(MBEDTLS_PKCS1_V15)
+    // The cached public key is owned by src, dst builds its own
+    mbedtls_rsa_reset_public_key( dst );
+#endif
+
 cleanup:
     if( ret != 0 )
         mbedtls_rsa_free( dst );
@@ -2493,6 +2559,10 @@ void mbedtls_rsa_free( mbedtls_rsa_context *ctx )
     mbedtls_mpi_free( &ctx->DP );
 #endif /* MBEDTLS_RSA_NO_CRT */
 
+#if defined(MBEDTLS_PKCS1_V15)
+    mbedtls_rsa_reset_public_key( ctx );
+#endif
+
 #if defined(MBEDTLS_THREADING_C)
     mbedtls_mutex_free( &ctx->mutex );
 #endif
@@ -0,0 +1,326 @@
+/**
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \file trustm_ssl_async.c
+*
+* \brief   This file implements the asynchronous private key operations of mbedTLS (MBEDTLS_SSL_ASYNC_PRIVATE),
+*          which are executed by OPTIGA using the crypt completion queue.
+*
+* @{
+*/
+
+#include "trustm_ssl_async.h"
+
+#if defined(MBEDTLS_SSL_ASYNC_PRIVATE) && defined(OPTIGA_CRYPT_CQ_ENABLED)
+
+#include <string.h>
+#include "mbedtls/pk.h"
+#include "mbedtls/rsa.h"
+
+/// Operation types
+#define TRUSTM_SSL_ASYNC_ECDSA_SIGN     (0x01)
+#define TRUSTM_SSL_ASYNC_RSA_SIGN       (0x02)
+#define TRUSTM_SSL_ASYNC_RSA_DECRYPT    (0x03)
+/// Room for the SEQUENCE header of an ECDSA signature (tag, 0x81, length)
+#define TRUSTM_SSL_ASYNC_DER_HEADER     (0x03)
+
+/*
+* Takes the completions of the queue into the operations, without blocking
+*/
+static void trustm_ssl_async_reap(trustm_ssl_async_t * p_async)
+{
+    optiga_crypt_cq_completion_t completions[TRUSTM_SSL_ASYNC_DEPTH];
+    trustm_ssl_async_operation_t * p_operation;
+    uint8_t count;
+    uint8_t index;
+
+    count = optiga_crypt_cq_reap(&p_async->cq, completions, TRUSTM_SSL_ASYNC_DEPTH);
+    for (index = 0; index < count; index++)
+    {
+        p_operation = (trustm_ssl_async_operation_t *)completions[index].user_tag;
+        p_operation->status = completions[index].status;
+        p_operation->completed = TRUE;
+        // The handshake is closed, hence nobody takes the output
+        if (TRUE == p_operation->cancelled)
+        {
+            memset(p_operation, 0, sizeof(trustm_ssl_async_operation_t));
+        }
+    }
+}
+
+/*
+* Submits the operation to a crypt instance of the completion queue
+*/
+static int trustm_ssl_async_start(mbedtls_ssl_context * ssl,
+                                  uint8_t operation_type,
+                                  mbedtls_md_type_t md_alg,
+                                  const unsigned char * input,
+                                  size_t input_len)
+{
+    trustm_ssl_async_t * p_async = (trustm_ssl_async_t *)mbedtls_ssl_conf_get_async_config_data(ssl->conf);
+    trustm_ssl_async_operation_t * p_operation = NULL;
+    optiga_crypt_t * me;
+    optiga_lib_status_t crypt_status = OPTIGA_CRYPT_ERROR;
+    uint8_t index;
+
+    if (input_len > TRUSTM_SSL_ASYNC_BUFFER_SIZE)
+    {
+        return (MBEDTLS_ERR_SSL_HW_ACCEL_FALLTHROUGH);
+    }
+    // Operations of closed handshakes may still be completed in the meantime
+    trustm_ssl_async_reap(p_async);
+    for (index = 0; index < TRUSTM_SSL_ASYNC_DEPTH; index++)
+    {
+        if (FALSE == p_async->operations[index].in_use)
+        {
+            p_operation = &p_async->operations[index];
+            break;
+        }
+    }
+    if (NULL == p_operation)
+    {
+        return (MBEDTLS_ERR_PK_ALLOC_FAILED);
+    }
+    me = optiga_crypt_cq_acquire(&p_async->cq, p_operation);
+    if (NULL == me)
+    {
+        return (MBEDTLS_ERR_PK_ALLOC_FAILED);
+    }
+
+    memset(p_operation, 0, sizeof(trustm_ssl_async_operation_t));
+    p_operation->in_use = TRUE;
+    // The input of mbedTLS is valid only during this call, while OPTIGA takes it later
+    memcpy(p_operation->input, input, input_len);
+    p_operation->output_length = TRUSTM_SSL_ASYNC_BUFFER_SIZE;
+    switch (operation_type)
+    {
+        case TRUSTM_SSL_ASYNC_ECDSA_SIGN:
+        {
+            p_operation->is_ecdsa = TRUE;
+            crypt_status = optiga_crypt_ecdsa_sign(me,
+                                                   p_operation->input,
+                                                   (uint8_t)input_len,
+                                                   p_async->ecc_private_key,
+                                                   &p_operation->output[TRUSTM_SSL_ASYNC_DER_HEADER],
+                                                   &p_operation->output_length);
+            break;
+        }
+#ifdef OPTIGA_CRYPT_RSA_SIGN_ENABLED
+        case TRUSTM_SSL_ASYNC_RSA_SIGN:
+        {
+            crypt_status = optiga_crypt_rsa_sign(me,
+                                                 (MBEDTLS_MD_SHA384 == md_alg) ? OPTIGA_RSASSA_PKCS1_V15_SHA384 :
+                                                                                 OPTIGA_RSASSA_PKCS1_V15_SHA256,
+                                                 p_operation->input,
+                                                 (uint8_t)input_len,
+                                                 p_async->rsa_private_key,
+                                                 p_operation->output,
+                                                 &p_operation->output_length,
+                                                 0x0000);
+            break;
+        }
+#endif //OPTIGA_CRYPT_RSA_SIGN_ENABLED
+#ifdef OPTIGA_CRYPT_RSA_DECRYPT_ENABLED
+        case TRUSTM_SSL_ASYNC_RSA_DECRYPT:
+        {
+            crypt_status = optiga_crypt_rsa_decrypt_and_export(me,
+                                                               OPTIGA_RSAES_PKCS1_V15,
+                                                               p_operation->input,
+                                                               (uint16_t)input_len,
+                                                               NULL,
+                                                               0,
+                                                               p_async->rsa_private_key,
+                                                               p_operation->output,
+                                                               &p_operation->output_length);
+            break;
+        }
+#endif //OPTIGA_CRYPT_RSA_DECRYPT_ENABLED
+        default:
+            break;
+    }
+    if (OPTIGA_LIB_SUCCESS != crypt_status)
+    {
+        optiga_crypt_cq_cancel(&p_async->cq, me);
+        memset(p_operation, 0, sizeof(trustm_ssl_async_operation_t));
+        return (MBEDTLS_ERR_PK_HW_ACCEL_FAILED);
+    }
+
+    mbedtls_ssl_set_async_operation_data(ssl, p_operation);
+    return (MBEDTLS_ERR_SSL_ASYNC_IN_PROGRESS);
+}
+
+static int trustm_ssl_async_sign_start(mbedtls_ssl_context * ssl,
+                                       mbedtls_x509_crt * cert,
+                                       mbedtls_md_type_t md_alg,
+                                       const unsigned char * hash,
+                                       size_t hash_len)
+{
+    if (mbedtls_pk_can_do(&cert->pk, MBEDTLS_PK_ECDSA))
+    {
+        if (hash_len > 64)
+        {
+            return (MBEDTLS_ERR_SSL_HW_ACCEL_FALLTHROUGH);
+        }
+        return (trustm_ssl_async_start(ssl, TRUSTM_SSL_ASYNC_ECDSA_SIGN, md_alg, hash, hash_len));
+    }
+#ifdef OPTIGA_CRYPT_RSA_SIGN_ENABLED
+    // OPTIGA encodes the DigestInfo itself, hence only the digests of its signature schemes are taken
+    if ((mbedtls_pk_can_do(&cert->pk, MBEDTLS_PK_RSA)) &&
+        ((MBEDTLS_MD_SHA256 == md_alg) || (MBEDTLS_MD_SHA384 == md_alg)))
+    {
+        return (trustm_ssl_async_start(ssl, TRUSTM_SSL_ASYNC_RSA_SIGN, md_alg, hash, hash_len));
+    }
+#endif //OPTIGA_CRYPT_RSA_SIGN_ENABLED
+    return (MBEDTLS_ERR_SSL_HW_ACCEL_FALLTHROUGH);
+}
+
+static int trustm_ssl_async_decrypt_start(mbedtls_ssl_context * ssl,
+                                          mbedtls_x509_crt * cert,
+                                          const unsigned char * input,
+                                          size_t input_len)
+{
+#ifdef OPTIGA_CRYPT_RSA_DECRYPT_ENABLED
+    if (mbedtls_pk_can_do(&cert->pk, MBEDTLS_PK_RSA))
+    {
+        return (trustm_ssl_async_start(ssl, TRUSTM_SSL_ASYNC_RSA_DECRYPT, MBEDTLS_MD_NONE, input, input_len));
+    }
+#endif //OPTIGA_CRYPT_RSA_DECRYPT_ENABLED
+    return (MBEDTLS_ERR_SSL_HW_ACCEL_FALLTHROUGH);
+}
+
+static int trustm_ssl_async_resume(mbedtls_ssl_context * ssl,
+                                   unsigned char * output,
+                                   size_t * output_len,
+                                   size_t output_size)
+{
+    trustm_ssl_async_t * p_async = (trustm_ssl_async_t *)mbedtls_ssl_conf_get_async_config_data(ssl->conf);
+    trustm_ssl_async_operation_t * p_operation =
+        (trustm_ssl_async_operation_t *)mbedtls_ssl_get_async_operation_data(ssl);
+    uint8_t * p_output;
+    size_t length;
+    int return_status = MBEDTLS_ERR_PK_HW_ACCEL_FAILED;
+
+    trustm_ssl_async_reap(p_async);
+    if (FALSE == p_operation->completed)
+    {
+        return (MBEDTLS_ERR_SSL_ASYNC_IN_PROGRESS);
+    }
+
+    do
+    {
+        if (OPTIGA_LIB_SUCCESS != p_operation->status)
+        {
+            break;
+        }
+        p_output = p_operation->output;
+        length = p_operation->output_length;
+        if (TRUE == p_operation->is_ecdsa)
+        {
+            // OPTIGA provides the integers r and s, mbedTLS takes the DER encoded Ecdsa-Sig-Value
+            if (length < 0x80)
+            {
+                p_output = &p_operation->output[TRUSTM_SSL_ASYNC_DER_HEADER - 2];
+                p_output[1] = (uint8_t)length;
+                length += 2;
+            }
+            else
+            {
+                p_output = p_operation->output;
+                p_output[1] = 0x81;
+                p_output[2] = (uint8_t)length;
+                length += 3;
+            }
+            p_output[0] = 0x30;
+        }
+        if (length > output_size)
+        {
+            return_status = MBEDTLS_ERR_PK_BAD_INPUT_DATA;
+            break;
+        }
+        memcpy(output, p_output, length);
+        *output_len = length;
+        return_status = 0;
+    } while (FALSE);
+
+    // Output is not kept, once taken by mbedTLS
+    memset(p_operation, 0, sizeof(trustm_ssl_async_operation_t));
+    mbedtls_ssl_set_async_operation_data(ssl, NULL);
+    return (return_status);
+}
+
+static void trustm_ssl_async_cancel(mbedtls_ssl_context * ssl)
+{
+    trustm_ssl_async_operation_t * p_operation =
+        (trustm_ssl_async_operation_t *)mbedtls_ssl_get_async_operation_data(ssl);
+
+    // OPTIGA can't abort the command, hence the operation is released once completed
+    if (TRUE == p_operation->completed)
+    {
+        memset(p_operation, 0, sizeof(trustm_ssl_async_operation_t));
+    }
+    else
+    {
+        p_operation->cancelled = TRUE;
+    }
+    mbedtls_ssl_set_async_operation_data(ssl, NULL);
+}
+
+int trustm_ssl_async_setup(trustm_ssl_async_t * p_async,
+                           mbedtls_ssl_config * conf,
+                           optiga_key_id_t ecc_private_key,
+                           optiga_key_id_t rsa_private_key)
+{
+    memset(p_async->operations, 0, sizeof(p_async->operations));
+    p_async->ecc_private_key = ecc_private_key;
+    p_async->rsa_private_key = rsa_private_key;
+    if (OPTIGA_LIB_SUCCESS != optiga_crypt_cq_init(&p_async->cq, 0, p_async->slots, TRUSTM_SSL_ASYNC_DEPTH))
+    {
+        return (MBEDTLS_ERR_PK_ALLOC_FAILED);
+    }
+    mbedtls_ssl_conf_async_private_cb(conf,
+                                      trustm_ssl_async_sign_start,
+                                      trustm_ssl_async_decrypt_start,
+                                      trustm_ssl_async_resume,
+                                      trustm_ssl_async_cancel,
+                                      p_async);
+    return (0);
+}
+
+int trustm_ssl_async_get_descriptor(const trustm_ssl_async_t * p_async)
+{
+    return ((int)optiga_crypt_cq_get_descriptor(&p_async->cq));
+}
+
+void trustm_ssl_async_free(trustm_ssl_async_t * p_async)
+{
+    trustm_ssl_async_reap(p_async);
+    //lint --e{534} suppress "All the handshakes are closed, return value is not required to be checked"
+    optiga_crypt_cq_deinit(&p_async->cq);
+    memset(p_async->operations, 0, sizeof(p_async->operations));
+}
+
+#endif //MBEDTLS_SSL_ASYNC_PRIVATE && OPTIGA_CRYPT_CQ_ENABLED
+
+/**
+* @}
+*/
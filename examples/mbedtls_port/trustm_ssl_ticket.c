@@ -0,0 +1,481 @@
+/**
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \file trustm_ssl_ticket.c
+*
+* \brief   This file implements the session ticket keys of mbedTLS (MBEDTLS_SSL_SESSION_TICKETS), which are derived
+*          by OPTIGA from a secret held in the chip.
+*
+* @{
+*/
+
+#include "trustm_ssl_ticket.h"
+
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_SRV_C) && defined(MBEDTLS_GCM_C) && \
+    defined(MBEDTLS_HAVE_TIME) && defined(OPTIGA_CRYPT_HKDF_ENABLED)
+
+#include <string.h>
+#include "mbedtls/platform.h"
+#include "mbedtls/platform_util.h"
+#include "mbedtls/platform_time.h"
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+#include "mbedtls/x509_crt.h"
+#endif
+#include "optiga/pal/pal_os_timer.h"
+#include "trustm_crypt_pool.h"
+
+/// Size of the IV of a ticket
+#define TRUSTM_SSL_TICKET_IV_SIZE       (12)
+/// Size of the tag of a ticket
+#define TRUSTM_SSL_TICKET_TAG_SIZE      (16)
+/// Size of the header (key name, IV and length of the state), which is the additional data of the encryption
+#define TRUSTM_SSL_TICKET_HEADER_SIZE   (TRUSTM_SSL_TICKET_KEY_NAME_SIZE + TRUSTM_SSL_TICKET_IV_SIZE + 2)
+
+//lint --e{818} suppress "context is the status of the waiting operation"
+static void trustm_ssl_ticket_event_completed(void * context, optiga_lib_status_t return_status)
+{
+    *((volatile optiga_lib_status_t *)context) = return_status;
+}
+
+/*
+* Waits for the completion of the started operation and releases the instance
+*/
+static optiga_lib_status_t trustm_ssl_ticket_wait(optiga_crypt_t * me,
+                                                  optiga_lib_status_t crypt_status,
+                                                  volatile optiga_lib_status_t * p_status)
+{
+    if (OPTIGA_LIB_SUCCESS == crypt_status)
+    {
+        while (OPTIGA_LIB_BUSY == *p_status)
+        {
+            pal_os_timer_delay_in_milliseconds(5);
+        }
+        crypt_status = *p_status;
+    }
+    trustm_crypt_release(me);
+    return (crypt_status);
+}
+
+static uint32_t trustm_ssl_ticket_get_epoch(const trustm_ssl_ticket_t * p_ticket)
+{
+    return ((uint32_t)((uint64_t)mbedtls_time(NULL) / p_ticket->rotation_interval));
+}
+
+/*
+* Derives the key and the key name of the epoch by OPTIGA
+*/
+static int trustm_ssl_ticket_derive(trustm_ssl_ticket_t * p_ticket,
+                                    trustm_ssl_ticket_key_t * p_key,
+                                    uint32_t epoch)
+{
+    volatile optiga_lib_status_t crypt_status = OPTIGA_LIB_BUSY;
+    uint8_t info[sizeof(TRUSTM_SSL_TICKET_LABEL) - 1 + 4];
+    uint8_t derived[TRUSTM_SSL_TICKET_KEY_SIZE + TRUSTM_SSL_TICKET_KEY_NAME_SIZE];
+    optiga_crypt_t * me;
+    int ret;
+
+    p_key->valid = FALSE;
+
+    memcpy(info, TRUSTM_SSL_TICKET_LABEL, sizeof(TRUSTM_SSL_TICKET_LABEL) - 1);
+    info[sizeof(info) - 4] = (uint8_t)(epoch >> 24);
+    info[sizeof(info) - 3] = (uint8_t)(epoch >> 16);
+    info[sizeof(info) - 2] = (uint8_t)(epoch >> 8);
+    info[sizeof(info) - 1] = (uint8_t)(epoch);
+
+    me = trustm_crypt_acquire(trustm_ssl_ticket_event_completed, (void *)&crypt_status);
+    if (NULL == me)
+    {
+        return (MBEDTLS_ERR_SSL_HW_ACCEL_FAILED);
+    }
+    if (OPTIGA_LIB_SUCCESS != trustm_ssl_ticket_wait(me,
+                                                     optiga_crypt_hkdf(me,
+                                                                       OPTIGA_HKDF_SHA_256,
+                                                                       p_ticket->secret_oid,
+                                                                       NULL,
+                                                                       0,
+                                                                       info,
+                                                                       (uint16_t)sizeof(info),
+                                                                       (uint16_t)sizeof(derived),
+                                                                       TRUE,
+                                                                       derived),
+                                                     &crypt_status))
+    {
+        return (MBEDTLS_ERR_SSL_HW_ACCEL_FAILED);
+    }
+    p_ticket->derivations++;
+
+    ret = mbedtls_gcm_setkey(&p_key->gcm, MBEDTLS_CIPHER_ID_AES, derived, TRUSTM_SSL_TICKET_KEY_SIZE * 8);
+    if (0 == ret)
+    {
+        memcpy(p_key->name, &derived[TRUSTM_SSL_TICKET_KEY_SIZE], TRUSTM_SSL_TICKET_KEY_NAME_SIZE);
+        p_key->epoch = epoch;
+        p_key->valid = TRUE;
+    }
+    mbedtls_platform_zeroize(derived, sizeof(derived));
+    return (ret);
+}
+
+/*
+* Rotates the keys at the start of an epoch, the key of the previous epoch is kept for the issued tickets
+*/
+static int trustm_ssl_ticket_update_keys(trustm_ssl_ticket_t * p_ticket)
+{
+    trustm_ssl_ticket_key_t * p_previous = &p_ticket->keys[p_ticket->active];
+    uint32_t epoch = trustm_ssl_ticket_get_epoch(p_ticket);
+    uint8_t next = (uint8_t)(1 - p_ticket->active);
+    int ret;
+
+    if ((TRUE == p_previous->valid) && (epoch == p_previous->epoch))
+    {
+        return (0);
+    }
+    ret = trustm_ssl_ticket_derive(p_ticket, &p_ticket->keys[next], epoch);
+    if (0 != ret)
+    {
+        return (ret);
+    }
+    p_ticket->active = next;
+    // The key is older than the previous epoch or the time went back, hence its tickets are not accepted anymore
+    if ((epoch - 1) != p_previous->epoch)
+    {
+        p_previous->valid = FALSE;
+    }
+    return (0);
+}
+
+/*
+* Serializes the session, same as ssl_save_session of ssl_ticket.c
+*/
+static int trustm_ssl_ticket_save_session(const mbedtls_ssl_session * session,
+                                          unsigned char * buf,
+                                          size_t buf_len,
+                                          size_t * olen)
+{
+    unsigned char * p = buf;
+    size_t left = buf_len;
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+    size_t cert_len;
+#endif
+
+    if (left < sizeof(mbedtls_ssl_session))
+    {
+        return (MBEDTLS_ERR_SSL_BUFFER_TOO_SMALL);
+    }
+    memcpy(p, session, sizeof(mbedtls_ssl_session));
+    p += sizeof(mbedtls_ssl_session);
+    left -= sizeof(mbedtls_ssl_session);
+
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+    cert_len = (NULL == session->peer_cert) ? 0 : session->peer_cert->raw.len;
+    if (left < 3 + cert_len)
+    {
+        return (MBEDTLS_ERR_SSL_BUFFER_TOO_SMALL);
+    }
+    *p++ = (unsigned char)(cert_len >> 16);
+    *p++ = (unsigned char)(cert_len >> 8);
+    *p++ = (unsigned char)(cert_len);
+    if (NULL != session->peer_cert)
+    {
+        memcpy(p, session->peer_cert->raw.p, cert_len);
+    }
+    p += cert_len;
+#endif
+
+    *olen = (size_t)(p - buf);
+    return (0);
+}
+
+/*
+* Deserializes the session, same as ssl_load_session of ssl_ticket.c
+*/
+static int trustm_ssl_ticket_load_session(mbedtls_ssl_session * session,
+                                          const unsigned char * buf,
+                                          size_t len)
+{
+    const unsigned char * p = buf;
+    const unsigned char * const end = buf + len;
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+    size_t cert_len;
+    int ret;
+#endif
+
+    if (sizeof(mbedtls_ssl_session) > (size_t)(end - p))
+    {
+        return (MBEDTLS_ERR_SSL_BAD_INPUT_DATA);
+    }
+    memcpy(session, p, sizeof(mbedtls_ssl_session));
+    p += sizeof(mbedtls_ssl_session);
+
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+    // The pointer was copied from the ticket, it is not valid in this process
+    session->peer_cert = NULL;
+    if (3 > (size_t)(end - p))
+    {
+        return (MBEDTLS_ERR_SSL_BAD_INPUT_DATA);
+    }
+    cert_len = ((size_t)p[0] << 16) | ((size_t)p[1] << 8) | p[2];
+    p += 3;
+
+    if (0 != cert_len)
+    {
+        if (cert_len > (size_t)(end - p))
+        {
+            return (MBEDTLS_ERR_SSL_BAD_INPUT_DATA);
+        }
+        session->peer_cert = mbedtls_calloc(1, sizeof(mbedtls_x509_crt));
+        if (NULL == session->peer_cert)
+        {
+            return (MBEDTLS_ERR_SSL_ALLOC_FAILED);
+        }
+        mbedtls_x509_crt_init(session->peer_cert);
+        ret = mbedtls_x509_crt_parse_der(session->peer_cert, p, cert_len);
+        if (0 != ret)
+        {
+            mbedtls_x509_crt_free(session->peer_cert);
+            mbedtls_free(session->peer_cert);
+            session->peer_cert = NULL;
+            return (ret);
+        }
+        p += cert_len;
+    }
+#endif
+
+    return ((p == end) ? 0 : MBEDTLS_ERR_SSL_BAD_INPUT_DATA);
+}
+
+int trustm_ssl_ticket_setup(trustm_ssl_ticket_t * p_ticket,
+                            mbedtls_ssl_config * conf,
+                            int (*f_rng)(void *, unsigned char *, size_t),
+                            void * p_rng,
+                            uint16_t secret_oid,
+                            uint32_t rotation_interval)
+{
+    int ret;
+
+    if ((0 == rotation_interval) || (NULL == f_rng))
+    {
+        return (MBEDTLS_ERR_SSL_BAD_INPUT_DATA);
+    }
+    memset(p_ticket, 0, sizeof(trustm_ssl_ticket_t));
+    mbedtls_gcm_init(&p_ticket->keys[0].gcm);
+    mbedtls_gcm_init(&p_ticket->keys[1].gcm);
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_mutex_init(&p_ticket->mutex);
+#endif
+    p_ticket->secret_oid = secret_oid;
+    p_ticket->rotation_interval = rotation_interval;
+    p_ticket->f_rng = f_rng;
+    p_ticket->p_rng = p_rng;
+
+    // A secret, which cannot be used for the derivation, is reported at setup instead of the first handshake
+    ret = trustm_ssl_ticket_update_keys(p_ticket);
+    if (0 != ret)
+    {
+        trustm_ssl_ticket_free(p_ticket);
+        return (ret);
+    }
+    mbedtls_ssl_conf_session_tickets_cb(conf, trustm_ssl_ticket_write, trustm_ssl_ticket_parse, p_ticket);
+    return (0);
+}
+
+int trustm_ssl_ticket_write(void * p_ticket,
+                            const mbedtls_ssl_session * session,
+                            unsigned char * start,
+                            const unsigned char * end,
+                            size_t * tlen,
+                            uint32_t * lifetime)
+{
+    trustm_ssl_ticket_t * p_context = (trustm_ssl_ticket_t *)p_ticket;
+    trustm_ssl_ticket_key_t * p_key;
+    unsigned char * iv = start + TRUSTM_SSL_TICKET_KEY_NAME_SIZE;
+    unsigned char * state_length = iv + TRUSTM_SSL_TICKET_IV_SIZE;
+    unsigned char * state = start + TRUSTM_SSL_TICKET_HEADER_SIZE;
+    size_t clear_length;
+    int ret;
+
+    *tlen = 0;
+    if ((end - start) < (TRUSTM_SSL_TICKET_HEADER_SIZE + TRUSTM_SSL_TICKET_TAG_SIZE))
+    {
+        return (MBEDTLS_ERR_SSL_BUFFER_TOO_SMALL);
+    }
+#if defined(MBEDTLS_THREADING_C)
+    if (0 != (ret = mbedtls_mutex_lock(&p_context->mutex)))
+    {
+        return (ret);
+    }
+#endif
+    do
+    {
+        ret = trustm_ssl_ticket_update_keys(p_context);
+        if (0 != ret)
+        {
+            break;
+        }
+        p_key = &p_context->keys[p_context->active];
+        *lifetime = p_context->rotation_interval;
+
+        memcpy(start, p_key->name, TRUSTM_SSL_TICKET_KEY_NAME_SIZE);
+        ret = p_context->f_rng(p_context->p_rng, iv, TRUSTM_SSL_TICKET_IV_SIZE);
+        if (0 != ret)
+        {
+            break;
+        }
+        // The tag follows the state, hence it is reserved before the state is written
+        ret = trustm_ssl_ticket_save_session(session,
+                                             state,
+                                             (size_t)(end - state) - TRUSTM_SSL_TICKET_TAG_SIZE,
+                                             &clear_length);
+        if ((0 != ret) || (clear_length > 0xFFFF))
+        {
+            ret = (0 != ret) ? ret : MBEDTLS_ERR_SSL_BUFFER_TOO_SMALL;
+            break;
+        }
+        state_length[0] = (uint8_t)(clear_length >> 8);
+        state_length[1] = (uint8_t)(clear_length);
+
+        ret = mbedtls_gcm_crypt_and_tag(&p_key->gcm,
+                                        MBEDTLS_GCM_ENCRYPT,
+                                        clear_length,
+                                        iv,
+                                        TRUSTM_SSL_TICKET_IV_SIZE,
+                                        start,
+                                        TRUSTM_SSL_TICKET_HEADER_SIZE,
+                                        state,
+                                        state,
+                                        TRUSTM_SSL_TICKET_TAG_SIZE,
+                                        state + clear_length);
+        if (0 != ret)
+        {
+            break;
+        }
+        *tlen = TRUSTM_SSL_TICKET_HEADER_SIZE + clear_length + TRUSTM_SSL_TICKET_TAG_SIZE;
+    } while (FALSE);
+#if defined(MBEDTLS_THREADING_C)
+    if (0 != mbedtls_mutex_unlock(&p_context->mutex))
+    {
+        return (MBEDTLS_ERR_THREADING_MUTEX_ERROR);
+    }
+#endif
+    return (ret);
+}
+
+int trustm_ssl_ticket_parse(void * p_ticket,
+                            mbedtls_ssl_session * session,
+                            unsigned char * buf,
+                            size_t len)
+{
+    trustm_ssl_ticket_t * p_context = (trustm_ssl_ticket_t *)p_ticket;
+    trustm_ssl_ticket_key_t * p_key = NULL;
+    unsigned char * iv = buf + TRUSTM_SSL_TICKET_KEY_NAME_SIZE;
+    unsigned char * state = buf + TRUSTM_SSL_TICKET_HEADER_SIZE;
+    size_t state_length;
+    mbedtls_time_t current_time;
+    uint32_t epoch;
+    uint8_t index;
+    int ret;
+
+    if (len < (TRUSTM_SSL_TICKET_HEADER_SIZE + TRUSTM_SSL_TICKET_TAG_SIZE))
+    {
+        return (MBEDTLS_ERR_SSL_BAD_INPUT_DATA);
+    }
+    state_length = ((size_t)iv[TRUSTM_SSL_TICKET_IV_SIZE] << 8) | iv[TRUSTM_SSL_TICKET_IV_SIZE + 1];
+    if (len != (TRUSTM_SSL_TICKET_HEADER_SIZE + state_length + TRUSTM_SSL_TICKET_TAG_SIZE))
+    {
+        return (MBEDTLS_ERR_SSL_BAD_INPUT_DATA);
+    }
+#if defined(MBEDTLS_THREADING_C)
+    if (0 != (ret = mbedtls_mutex_lock(&p_context->mutex)))
+    {
+        return (ret);
+    }
+#endif
+    do
+    {
+        // Only the cached keys are used, a ticket never causes a derivation by OPTIGA
+        epoch = trustm_ssl_ticket_get_epoch(p_context);
+        for (index = 0; index < 2; index++)
+        {
+            if ((TRUE == p_context->keys[index].valid) &&
+                ((epoch - p_context->keys[index].epoch) <= 1) &&
+                (0 == memcmp(buf, p_context->keys[index].name, TRUSTM_SSL_TICKET_KEY_NAME_SIZE)))
+            {
+                p_key = &p_context->keys[index];
+                break;
+            }
+        }
+        if (NULL == p_key)
+        {
+            ret = MBEDTLS_ERR_SSL_SESSION_TICKET_EXPIRED;
+            break;
+        }
+        ret = mbedtls_gcm_auth_decrypt(&p_key->gcm,
+                                       state_length,
+                                       iv,
+                                       TRUSTM_SSL_TICKET_IV_SIZE,
+                                       buf,
+                                       TRUSTM_SSL_TICKET_HEADER_SIZE,
+                                       state + state_length,
+                                       TRUSTM_SSL_TICKET_TAG_SIZE,
+                                       state,
+                                       state);
+        if (0 != ret)
+        {
+            ret = (MBEDTLS_ERR_GCM_AUTH_FAILED == ret) ? MBEDTLS_ERR_SSL_INVALID_MAC : ret;
+            break;
+        }
+        ret = trustm_ssl_ticket_load_session(session, state, state_length);
+        if (0 != ret)
+        {
+            break;
+        }
+        current_time = mbedtls_time(NULL);
+        if ((current_time < session->start) ||
+            ((uint32_t)(current_time - session->start) > p_context->rotation_interval))
+        {
+            ret = MBEDTLS_ERR_SSL_SESSION_TICKET_EXPIRED;
+        }
+    } while (FALSE);
+#if defined(MBEDTLS_THREADING_C)
+    if (0 != mbedtls_mutex_unlock(&p_context->mutex))
+    {
+        return (MBEDTLS_ERR_THREADING_MUTEX_ERROR);
+    }
+#endif
+    return (ret);
+}
+
+void trustm_ssl_ticket_free(trustm_ssl_ticket_t * p_ticket)
+{
+    mbedtls_gcm_free(&p_ticket->keys[0].gcm);
+    mbedtls_gcm_free(&p_ticket->keys[1].gcm);
+#if defined(MBEDTLS_THREADING_C)
+    mbedtls_mutex_free(&p_ticket->mutex);
+#endif
+    mbedtls_platform_zeroize(p_ticket, sizeof(trustm_ssl_ticket_t));
+}
+
+#endif //MBEDTLS_SSL_SESSION_TICKETS && MBEDTLS_SSL_SRV_C && MBEDTLS_GCM_C && MBEDTLS_HAVE_TIME && OPTIGA_CRYPT_HKDF_ENABLED
+
+/**
+* @}
+*/
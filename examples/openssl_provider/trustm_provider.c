@@ -0,0 +1,1825 @@
+/**
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \file trustm_provider.c
+*
+* \brief   This file implements an OpenSSL 3 provider, which exposes the keys of OPTIGA for signature, key exchange
+*          and random generation.
+*
+* \details
+* The keys are loaded using the OSSL_STORE URI "optiga:<key OID>[?cert=<certificate OID>]", e.g. "optiga:0xE0F1".
+* The public key is taken from the certificate data object, which defaults to 0xE0E0 to 0xE0E3 for the keys
+* 0xE0F0 to 0xE0F3.
+* - The crypt instances of the completion queue are created once, when the provider is loaded.
+* - A reaper thread takes the completions and wakes the caller of the operation.
+* - Within an ASYNC_JOB, the job is paused on the descriptor of the operation instead of blocking the thread.
+* - Verification, digests and the operations on public keys are done by the other providers (e.g. default).
+*
+* @{
+*/
+
+#include <openssl/core.h>
+#include <openssl/core_dispatch.h>
+#include <openssl/core_names.h>
+#include <openssl/core_object.h>
+#include <openssl/params.h>
+#include <openssl/evp.h>
+#include <openssl/rsa.h>
+#include <openssl/x509.h>
+#include <openssl/async.h>
+
+#include <pthread.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "optiga/optiga_util.h"
+#include "optiga/optiga_crypt.h"
+#include "optiga/optiga_crypt_cq.h"
+#include "optiga/pal/pal.h"
+
+#if defined(OPTIGA_CRYPT_CQ_ENABLED) && defined(OPTIGA_LIB_SYNC_API_ENABLED)
+
+/// Number of operations in flight, one crypt instance of the completion queue each
+#ifndef TRUSTM_PROVIDER_POOL_SIZE
+#define TRUSTM_PROVIDER_POOL_SIZE               (4)
+#endif
+
+/// Property of the algorithms of the provider
+#define TRUSTM_PROVIDER_PROPERTY                "provider=trustm"
+/// Property query for the software implementations, used within the provider
+#define TRUSTM_PROVIDER_SOFTWARE_PROPQ          "provider!=trustm"
+/// Scheme of the OSSL_STORE URI
+#define TRUSTM_PROVIDER_URI_SCHEME              "optiga:"
+
+/// Maximum size of a certificate data object
+#define TRUSTM_PROVIDER_CERTIFICATE_MAX_SIZE    (1728)
+/// Maximum length of the ECDSA signature, r and s as DER INTEGERs for ECC NIST P521
+#define TRUSTM_PROVIDER_ECDSA_MAX_LENGTH        (0x8A)
+/// Room for the SEQUENCE header of an ECDSA signature (tag, 0x81, length)
+#define TRUSTM_PROVIDER_DER_HEADER              (0x03)
+/// Maximum length of the RSA signature (2048 bit key)
+#define TRUSTM_PROVIDER_RSA_MAX_LENGTH          (0x100)
+/// Maximum length of the uncompressed public point for ECC NIST P521
+#define TRUSTM_PROVIDER_ECC_POINT_MAX_LENGTH    (0x85)
+/// Length limits of a GetRandom command
+#define TRUSTM_PROVIDER_RANDOM_MIN_LENGTH       (0x08)
+#define TRUSTM_PROVIDER_RANDOM_MAX_LENGTH       (0x100)
+/// Security strength reported for the random generator
+#define TRUSTM_PROVIDER_RANDOM_STRENGTH         (256)
+
+/// Operation types
+#define TRUSTM_PROVIDER_ECDSA_SIGN              (0x01)
+#define TRUSTM_PROVIDER_RSA_SIGN                (0x02)
+#define TRUSTM_PROVIDER_ECDH                    (0x03)
+#define TRUSTM_PROVIDER_RANDOM                  (0x04)
+
+/** \brief Operation in flight, the caller waits on its descriptor */
+typedef struct trustm_provider_operation
+{
+    /// Descriptor signaled by the reaper on completion
+    int event_fd;
+    /// Status of the completed operation
+    optiga_lib_status_t status;
+    /// Indicates the operation is completed
+    uint8_t completed;
+    /// Indicates the operation is taken by a caller
+    uint8_t in_use;
+}trustm_provider_operation_t;
+
+/** \brief Context of the provider, one per loaded instance */
+typedef struct trustm_provider_ctx
+{
+    /// Handle of the core
+    const OSSL_CORE_HANDLE * p_core;
+    /// Child library context, to fetch the software implementations
+    OSSL_LIB_CTX * p_libctx;
+    /// Util instance, to read the certificates
+    optiga_util_t * me_util;
+    /// Serializes the use of the util instance
+    pthread_mutex_t util_lock;
+    /// Completion queue and its slots
+    optiga_crypt_cq_t cq;
+    optiga_crypt_cq_slot_t slots[TRUSTM_PROVIDER_POOL_SIZE];
+    /// Operations, one per slot of the completion queue
+    trustm_provider_operation_t operations[TRUSTM_PROVIDER_POOL_SIZE];
+    /// Protects the completion queue and the operations
+    pthread_mutex_t lock;
+    /// Signaled when an operation is released
+    pthread_cond_t operation_released;
+    /// Reaper thread and its stop descriptor
+    pthread_t reaper;
+    int stop_fd;
+}trustm_provider_ctx_t;
+
+/** \brief Arguments of an OPTIGA command */
+typedef struct trustm_provider_request
+{
+    /// Operation type
+    uint8_t type;
+    /// OID of the private key
+    uint16_t key_oid;
+    /// RSA signature scheme
+    optiga_rsa_signature_scheme_t signature_scheme;
+    /// Digest to be signed
+    const uint8_t * p_input;
+    uint16_t input_length;
+    /// Public key of the peer for ECDH
+    public_key_from_host_t * p_public_key;
+    /// Output and its length, updated on completion
+    uint8_t * p_output;
+    uint16_t output_length;
+}trustm_provider_request_t;
+
+/** \brief Key object of the key management */
+typedef struct trustm_provider_key
+{
+    /// Context of the provider
+    trustm_provider_ctx_t * p_ctx;
+    /// OID of the private key, 0 for a public key only
+    uint16_t key_oid;
+    /// EVP_PKEY_EC or EVP_PKEY_RSA
+    int key_type;
+    /// Curve (#optiga_ecc_curve_t) or RSA key type (#optiga_rsa_key_type_t)
+    uint8_t optiga_key_type;
+    /// Public key, owned by a software implementation
+    EVP_PKEY * p_public_key;
+}trustm_provider_key_t;
+
+/** \brief Context of a signature operation */
+typedef struct trustm_provider_signature
+{
+    trustm_provider_ctx_t * p_ctx;
+    trustm_provider_key_t * p_key;
+    /// Digest of the digest sign and verify operations
+    EVP_MD * p_md;
+    EVP_MD_CTX * p_md_ctx;
+}trustm_provider_signature_t;
+
+/** \brief Context of a key exchange operation */
+typedef struct trustm_provider_keyexch
+{
+    trustm_provider_ctx_t * p_ctx;
+    trustm_provider_key_t * p_key;
+    trustm_provider_key_t * p_peer;
+}trustm_provider_keyexch_t;
+
+/** \brief Context of the random generator */
+typedef struct trustm_provider_rand
+{
+    trustm_provider_ctx_t * p_ctx;
+    int state;
+}trustm_provider_rand_t;
+
+/** \brief Context of the OSSL_STORE loader */
+typedef struct trustm_provider_store
+{
+    trustm_provider_ctx_t * p_ctx;
+    uint16_t key_oid;
+    uint16_t certificate_oid;
+    uint8_t eof;
+}trustm_provider_store_t;
+
+/*
+* Callback of the util instance, which is used by the synchronous APIs only
+*/
+static void trustm_provider_util_callback(void * context, optiga_lib_status_t return_status)
+{
+    (void)context;
+    (void)return_status;
+}
+
+/*
+* Takes the completions of the queue and wakes the callers, until the provider is unloaded
+*/
+static void * trustm_provider_reaper(void * p_arg)
+{
+    trustm_provider_ctx_t * p_ctx = (trustm_provider_ctx_t *)p_arg;
+    optiga_crypt_cq_completion_t completions[TRUSTM_PROVIDER_POOL_SIZE];
+    trustm_provider_operation_t * p_operation;
+    struct pollfd fds[2];
+    uint64_t event = 1;
+    uint8_t count;
+    uint8_t index;
+
+    fds[0].fd = (int)optiga_crypt_cq_get_descriptor(&p_ctx->cq);
+    fds[0].events = POLLIN;
+    fds[1].fd = p_ctx->stop_fd;
+    fds[1].events = POLLIN;
+    for (;;)
+    {
+        if (0 > poll(fds, 2, -1))
+        {
+            continue;
+        }
+        if (0 != (fds[1].revents & POLLIN))
+        {
+            break;
+        }
+        pthread_mutex_lock(&p_ctx->lock);
+        count = optiga_crypt_cq_reap(&p_ctx->cq, completions, TRUSTM_PROVIDER_POOL_SIZE);
+        for (index = 0; index < count; index++)
+        {
+            p_operation = (trustm_provider_operation_t *)completions[index].user_tag;
+            p_operation->status = completions[index].status;
+            p_operation->completed = TRUE;
+            //lint --e{534} suppress "The counter of the eventfd doesn't overflow with one write per operation"
+            write(p_operation->event_fd, &event, sizeof(event));
+        }
+        pthread_mutex_unlock(&p_ctx->lock);
+    }
+    return (NULL);
+}
+
+/*
+* Starts the OPTIGA command of the request with the crypt instance of the completion queue
+*/
+static optiga_lib_status_t trustm_provider_submit(optiga_crypt_t * me, trustm_provider_request_t * p_request)
+{
+    optiga_lib_status_t crypt_status = OPTIGA_CRYPT_ERROR;
+
+    switch (p_request->type)
+    {
+#ifdef OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
+        case TRUSTM_PROVIDER_ECDSA_SIGN:
+        {
+            crypt_status = optiga_crypt_ecdsa_sign(me,
+                                                   p_request->p_input,
+                                                   (uint8_t)p_request->input_length,
+                                                   (optiga_key_id_t)p_request->key_oid,
+                                                   p_request->p_output,
+                                                   &p_request->output_length);
+            break;
+        }
+#endif //OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
+#ifdef OPTIGA_CRYPT_RSA_SIGN_ENABLED
+        case TRUSTM_PROVIDER_RSA_SIGN:
+        {
+            crypt_status = optiga_crypt_rsa_sign(me,
+                                                 p_request->signature_scheme,
+                                                 p_request->p_input,
+                                                 (uint8_t)p_request->input_length,
+                                                 (optiga_key_id_t)p_request->key_oid,
+                                                 p_request->p_output,
+                                                 &p_request->output_length,
+                                                 0x0000);
+            break;
+        }
+#endif //OPTIGA_CRYPT_RSA_SIGN_ENABLED
+#ifdef OPTIGA_CRYPT_ECDH_ENABLED
+        case TRUSTM_PROVIDER_ECDH:
+        {
+            crypt_status = optiga_crypt_ecdh(me,
+                                             (optiga_key_id_t)p_request->key_oid,
+                                             p_request->p_public_key,
+                                             TRUE,
+                                             p_request->p_output);
+            break;
+        }
+#endif //OPTIGA_CRYPT_ECDH_ENABLED
+#ifdef OPTIGA_CRYPT_RANDOM_ENABLED
+        case TRUSTM_PROVIDER_RANDOM:
+        {
+            crypt_status = optiga_crypt_random(me,
+                                               OPTIGA_RNG_TYPE_TRNG,
+                                               p_request->p_output,
+                                               p_request->output_length);
+            break;
+        }
+#endif //OPTIGA_CRYPT_RANDOM_ENABLED
+        default:
+            break;
+    }
+    return (crypt_status);
+}
+
+/*
+* Executes the request on OPTIGA. The caller is blocked until completion, an ASYNC_JOB is paused instead.
+*/
+static int trustm_provider_execute(trustm_provider_ctx_t * p_ctx, trustm_provider_request_t * p_request)
+{
+    trustm_provider_operation_t * p_operation = NULL;
+    optiga_lib_status_t crypt_status = OPTIGA_CRYPT_ERROR;
+    optiga_crypt_t * me;
+    ASYNC_JOB * p_job;
+    ASYNC_WAIT_CTX * p_wait_ctx = NULL;
+    uint64_t event;
+    uint8_t index;
+
+    pthread_mutex_lock(&p_ctx->lock);
+    // All the crypt instances are in use, wait for the release of an operation
+    while (NULL == p_operation)
+    {
+        for (index = 0; index < TRUSTM_PROVIDER_POOL_SIZE; index++)
+        {
+            if (FALSE == p_ctx->operations[index].in_use)
+            {
+                p_operation = &p_ctx->operations[index];
+                break;
+            }
+        }
+        if (NULL == p_operation)
+        {
+            pthread_cond_wait(&p_ctx->operation_released, &p_ctx->lock);
+        }
+    }
+    p_operation->in_use = TRUE;
+    p_operation->completed = FALSE;
+    me = optiga_crypt_cq_acquire(&p_ctx->cq, p_operation);
+    if (NULL != me)
+    {
+        crypt_status = trustm_provider_submit(me, p_request);
+        if (OPTIGA_LIB_SUCCESS != crypt_status)
+        {
+            optiga_crypt_cq_cancel(&p_ctx->cq, me);
+        }
+    }
+    if (OPTIGA_LIB_SUCCESS != crypt_status)
+    {
+        p_operation->in_use = FALSE;
+        pthread_cond_signal(&p_ctx->operation_released);
+        pthread_mutex_unlock(&p_ctx->lock);
+        return (0);
+    }
+
+    p_job = ASYNC_get_current_job();
+    if (NULL != p_job)
+    {
+        p_wait_ctx = ASYNC_get_wait_ctx(p_job);
+    }
+    if ((NULL != p_wait_ctx) &&
+        (0 != ASYNC_WAIT_CTX_set_wait_fd(p_wait_ctx, p_ctx, p_operation->event_fd, NULL, NULL)))
+    {
+        // The event loop of the application resumes the job, once the descriptor is readable
+        while (FALSE == p_operation->completed)
+        {
+            pthread_mutex_unlock(&p_ctx->lock);
+            //lint --e{534} suppress "The job is resumed by the application only, the completion is checked again"
+            ASYNC_pause_job();
+            pthread_mutex_lock(&p_ctx->lock);
+        }
+        //lint --e{534} suppress "The descriptor is owned by the provider, there is nothing to be cleaned up"
+        ASYNC_WAIT_CTX_clear_fd(p_wait_ctx, p_ctx);
+    }
+    pthread_mutex_unlock(&p_ctx->lock);
+
+    // Consumes the signal of the reaper, blocks until completion if not paused
+    //lint --e{534} suppress "The read is completed only when signaled"
+    read(p_operation->event_fd, &event, sizeof(event));
+
+    pthread_mutex_lock(&p_ctx->lock);
+    crypt_status = p_operation->status;
+    p_operation->in_use = FALSE;
+    p_operation->completed = FALSE;
+    pthread_cond_signal(&p_ctx->operation_released);
+    pthread_mutex_unlock(&p_ctx->lock);
+
+    return ((OPTIGA_LIB_SUCCESS == crypt_status) ? 1 : 0);
+}
+
+/*
+* Parses an OID of the URI (e.g. 0xE0F1 or E0F1)
+*/
+static int trustm_provider_parse_oid(const char * p_text, uint16_t * p_oid, const char ** p_end)
+{
+    char * p_text_end;
+    unsigned long value = strtoul(p_text, &p_text_end, 16);
+
+    if ((p_text_end == p_text) || (value > 0xFFFF))
+    {
+        return (0);
+    }
+    *p_oid = (uint16_t)value;
+    *p_end = p_text_end;
+    return (1);
+}
+
+/*
+* Reads the certificate of the key and takes its public key
+*/
+static EVP_PKEY * trustm_provider_read_public_key(trustm_provider_ctx_t * p_ctx, uint16_t certificate_oid)
+{
+    uint8_t * p_certificate = NULL;
+    const uint8_t * p_der;
+    uint16_t length = TRUSTM_PROVIDER_CERTIFICATE_MAX_SIZE;
+    optiga_lib_status_t util_status;
+    X509 * p_x509 = NULL;
+    EVP_PKEY * p_public_key = NULL;
+
+    do
+    {
+        p_certificate = OPENSSL_malloc(TRUSTM_PROVIDER_CERTIFICATE_MAX_SIZE);
+        if (NULL == p_certificate)
+        {
+            break;
+        }
+        pthread_mutex_lock(&p_ctx->util_lock);
+        util_status = optiga_util_read_data_sync(p_ctx->me_util, certificate_oid, 0, p_certificate, &length);
+        pthread_mutex_unlock(&p_ctx->util_lock);
+        if (OPTIGA_LIB_SUCCESS != util_status)
+        {
+            break;
+        }
+        p_der = p_certificate;
+        // TLS identity format: tag, length, chain length and length of the first certificate
+        if ((length > 9) && (0xC0 == p_certificate[0]))
+        {
+            p_der += 9;
+            length -= 9;
+        }
+        p_x509 = X509_new_ex(p_ctx->p_libctx, TRUSTM_PROVIDER_SOFTWARE_PROPQ);
+        if ((NULL == p_x509) || (NULL == d2i_X509(&p_x509, &p_der, length)))
+        {
+            break;
+        }
+        p_public_key = X509_get_pubkey(p_x509);
+    } while (FALSE);
+
+    X509_free(p_x509);
+    OPENSSL_free(p_certificate);
+    return (p_public_key);
+}
+
+/*
+* Takes the type of the OPTIGA key from the public key
+*/
+static int trustm_provider_key_set_type(trustm_provider_key_t * p_key)
+{
+    char group_name[32];
+    int return_status = 0;
+
+    do
+    {
+        if (EVP_PKEY_is_a(p_key->p_public_key, "RSA"))
+        {
+            p_key->key_type = EVP_PKEY_RSA;
+            if (1024 == EVP_PKEY_get_bits(p_key->p_public_key))
+            {
+                p_key->optiga_key_type = (uint8_t)OPTIGA_RSA_KEY_1024_BIT_EXPONENTIAL;
+            }
+            else if (2048 == EVP_PKEY_get_bits(p_key->p_public_key))
+            {
+                p_key->optiga_key_type = (uint8_t)OPTIGA_RSA_KEY_2048_BIT_EXPONENTIAL;
+            }
+            else
+            {
+                break;
+            }
+            return_status = 1;
+            break;
+        }
+        if ((!EVP_PKEY_is_a(p_key->p_public_key, "EC")) ||
+            (!EVP_PKEY_get_utf8_string_param(p_key->p_public_key,
+                                             OSSL_PKEY_PARAM_GROUP_NAME,
+                                             group_name,
+                                             sizeof(group_name),
+                                             NULL)))
+        {
+            break;
+        }
+        p_key->key_type = EVP_PKEY_EC;
+        return_status = 1;
+        if (0 == strcmp(group_name, "prime256v1"))
+        {
+            p_key->optiga_key_type = (uint8_t)OPTIGA_ECC_CURVE_NIST_P_256;
+        }
+        else if (0 == strcmp(group_name, "secp384r1"))
+        {
+            p_key->optiga_key_type = (uint8_t)OPTIGA_ECC_CURVE_NIST_P_384;
+        }
+#ifdef OPTIGA_CRYPT_ECC_NIST_P_521_ENABLED
+        else if (0 == strcmp(group_name, "secp521r1"))
+        {
+            p_key->optiga_key_type = (uint8_t)OPTIGA_ECC_CURVE_NIST_P_521;
+        }
+#endif
+#ifdef OPTIGA_CRYPT_ECC_BRAINPOOL_P_R1_ENABLED
+        else if (0 == strcmp(group_name, "brainpoolP256r1"))
+        {
+            p_key->optiga_key_type = (uint8_t)OPTIGA_ECC_CURVE_BRAIN_POOL_P_256R1;
+        }
+        else if (0 == strcmp(group_name, "brainpoolP384r1"))
+        {
+            p_key->optiga_key_type = (uint8_t)OPTIGA_ECC_CURVE_BRAIN_POOL_P_384R1;
+        }
+        else if (0 == strcmp(group_name, "brainpoolP512r1"))
+        {
+            p_key->optiga_key_type = (uint8_t)OPTIGA_ECC_CURVE_BRAIN_POOL_P_512R1;
+        }
+#endif
+        else
+        {
+            return_status = 0;
+        }
+    } while (FALSE);
+
+    return (return_status);
+}
+
+/**********************************************************************************************************************
+ * Key management
+ *********************************************************************************************************************/
+
+static void * trustm_provider_keymgmt_new(void * provctx)
+{
+    trustm_provider_key_t * p_key = OPENSSL_zalloc(sizeof(trustm_provider_key_t));
+
+    if (NULL != p_key)
+    {
+        p_key->p_ctx = (trustm_provider_ctx_t *)provctx;
+    }
+    return (p_key);
+}
+
+static void trustm_provider_keymgmt_free(void * keydata)
+{
+    trustm_provider_key_t * p_key = (trustm_provider_key_t *)keydata;
+
+    if (NULL != p_key)
+    {
+        EVP_PKEY_free(p_key->p_public_key);
+        OPENSSL_free(p_key);
+    }
+}
+
+static void * trustm_provider_keymgmt_load(const void * reference, size_t reference_sz)
+{
+    trustm_provider_key_t * p_key = NULL;
+
+    // The key object of the store is handed over once
+    if ((NULL != reference) && (sizeof(p_key) == reference_sz))
+    {
+        p_key = *(trustm_provider_key_t **)reference;
+        *(trustm_provider_key_t **)reference = NULL;
+    }
+    return (p_key);
+}
+
+static int trustm_provider_keymgmt_has(const void * keydata, int selection)
+{
+    const trustm_provider_key_t * p_key = (const trustm_provider_key_t *)keydata;
+    int return_status = 0;
+
+    if (NULL != p_key)
+    {
+        return_status = 1;
+        if ((0 != (selection & OSSL_KEYMGMT_SELECT_PRIVATE_KEY)) && (0 == p_key->key_oid))
+        {
+            return_status = 0;
+        }
+        if ((0 != (selection & OSSL_KEYMGMT_SELECT_ALL_PARAMETERS)) ||
+            (0 != (selection & OSSL_KEYMGMT_SELECT_PUBLIC_KEY)))
+        {
+            return_status &= (NULL != p_key->p_public_key) ? 1 : 0;
+        }
+    }
+    return (return_status);
+}
+
+static int trustm_provider_keymgmt_match(const void * keydata1, const void * keydata2, int selection)
+{
+    const trustm_provider_key_t * p_key1 = (const trustm_provider_key_t *)keydata1;
+    const trustm_provider_key_t * p_key2 = (const trustm_provider_key_t *)keydata2;
+
+    (void)selection;
+    // Private keys of OPTIGA are identified by their public key
+    if ((NULL == p_key1->p_public_key) || (NULL == p_key2->p_public_key))
+    {
+        return (0);
+    }
+    return ((1 == EVP_PKEY_eq(p_key1->p_public_key, p_key2->p_public_key)) ? 1 : 0);
+}
+
+/*
+* Imports a public key, e.g. the peer key of ECDH. Private keys are not imported to OPTIGA.
+*/
+static int trustm_provider_keymgmt_import(void * keydata, int selection, const OSSL_PARAM params[], const char * name)
+{
+    trustm_provider_key_t * p_key = (trustm_provider_key_t *)keydata;
+    EVP_PKEY_CTX * p_pkey_ctx = NULL;
+    int return_status = 0;
+
+    do
+    {
+        if ((0 != (selection & OSSL_KEYMGMT_SELECT_PRIVATE_KEY)) ||
+            (0 == (selection & OSSL_KEYMGMT_SELECT_PUBLIC_KEY)))
+        {
+            break;
+        }
+        p_pkey_ctx = EVP_PKEY_CTX_new_from_name(p_key->p_ctx->p_libctx, name, TRUSTM_PROVIDER_SOFTWARE_PROPQ);
+        if ((NULL == p_pkey_ctx) || (1 != EVP_PKEY_fromdata_init(p_pkey_ctx)))
+        {
+            break;
+        }
+        EVP_PKEY_free(p_key->p_public_key);
+        p_key->p_public_key = NULL;
+        //lint --e{605} suppress "The parameters are not modified by EVP_PKEY_fromdata"
+        if ((1 != EVP_PKEY_fromdata(p_pkey_ctx, &p_key->p_public_key, EVP_PKEY_PUBLIC_KEY, (OSSL_PARAM *)params)) ||
+            (0 == trustm_provider_key_set_type(p_key)))
+        {
+            break;
+        }
+        return_status = 1;
+    } while (FALSE);
+
+    EVP_PKEY_CTX_free(p_pkey_ctx);
+    return (return_status);
+}
+
+static int trustm_provider_keymgmt_ec_import(void * keydata, int selection, const OSSL_PARAM params[])
+{
+    return (trustm_provider_keymgmt_import(keydata, selection, params, "EC"));
+}
+
+static int trustm_provider_keymgmt_rsa_import(void * keydata, int selection, const OSSL_PARAM params[])
+{
+    return (trustm_provider_keymgmt_import(keydata, selection, params, "RSA"));
+}
+
+static int trustm_provider_keymgmt_export(void * keydata, int selection, OSSL_CALLBACK * param_cb, void * cbarg)
+{
+    trustm_provider_key_t * p_key = (trustm_provider_key_t *)keydata;
+    OSSL_PARAM * p_params = NULL;
+    int return_status = 0;
+
+    // The private key doesn't leave OPTIGA
+    if ((0 == (selection & OSSL_KEYMGMT_SELECT_PRIVATE_KEY)) &&
+        (NULL != p_key->p_public_key) &&
+        (1 == EVP_PKEY_todata(p_key->p_public_key, EVP_PKEY_PUBLIC_KEY, &p_params)))
+    {
+        return_status = param_cb(p_params, cbarg);
+        OSSL_PARAM_free(p_params);
+    }
+    return (return_status);
+}
+
+static const OSSL_PARAM trustm_provider_ec_public_types[] =
+{
+    OSSL_PARAM_utf8_string(OSSL_PKEY_PARAM_GROUP_NAME, NULL, 0),
+    OSSL_PARAM_octet_string(OSSL_PKEY_PARAM_PUB_KEY, NULL, 0),
+    OSSL_PARAM_END
+};
+
+static const OSSL_PARAM trustm_provider_rsa_public_types[] =
+{
+    OSSL_PARAM_BN(OSSL_PKEY_PARAM_RSA_N, NULL, 0),
+    OSSL_PARAM_BN(OSSL_PKEY_PARAM_RSA_E, NULL, 0),
+    OSSL_PARAM_END
+};
+
+static const OSSL_PARAM * trustm_provider_keymgmt_ec_types(int selection)
+{
+    return ((0 == (selection & OSSL_KEYMGMT_SELECT_PRIVATE_KEY)) ? trustm_provider_ec_public_types : NULL);
+}
+
+static const OSSL_PARAM * trustm_provider_keymgmt_rsa_types(int selection)
+{
+    return ((0 == (selection & OSSL_KEYMGMT_SELECT_PRIVATE_KEY)) ? trustm_provider_rsa_public_types : NULL);
+}
+
+static int trustm_provider_keymgmt_get_params(void * keydata, OSSL_PARAM params[])
+{
+    trustm_provider_key_t * p_key = (trustm_provider_key_t *)keydata;
+
+    // Bits, security bits, maximum signature size and the public key are the ones of the public key
+    if (NULL == p_key->p_public_key)
+    {
+        return (0);
+    }
+    return (EVP_PKEY_get_params(p_key->p_public_key, params));
+}
+
+static const OSSL_PARAM trustm_provider_keymgmt_gettable[] =
+{
+    OSSL_PARAM_int(OSSL_PKEY_PARAM_BITS, NULL),
+    OSSL_PARAM_int(OSSL_PKEY_PARAM_SECURITY_BITS, NULL),
+    OSSL_PARAM_int(OSSL_PKEY_PARAM_MAX_SIZE, NULL),
+    OSSL_PARAM_utf8_string(OSSL_PKEY_PARAM_GROUP_NAME, NULL, 0),
+    OSSL_PARAM_octet_string(OSSL_PKEY_PARAM_ENCODED_PUBLIC_KEY, NULL, 0),
+    OSSL_PARAM_BN(OSSL_PKEY_PARAM_RSA_N, NULL, 0),
+    OSSL_PARAM_BN(OSSL_PKEY_PARAM_RSA_E, NULL, 0),
+    OSSL_PARAM_END
+};
+
+static const OSSL_PARAM * trustm_provider_keymgmt_gettable_params(void * provctx)
+{
+    (void)provctx;
+    return (trustm_provider_keymgmt_gettable);
+}
+
+static const char * trustm_provider_keymgmt_ec_operation_name(int operation_id)
+{
+    return ((OSSL_OP_KEYEXCH == operation_id) ? "ECDH" : "ECDSA");
+}
+
+static const char * trustm_provider_keymgmt_rsa_operation_name(int operation_id)
+{
+    (void)operation_id;
+    return ("RSA");
+}
+
+static const OSSL_DISPATCH trustm_provider_keymgmt_ec_functions[] =
+{
+    { OSSL_FUNC_KEYMGMT_NEW, (void (*)(void))trustm_provider_keymgmt_new },
+    { OSSL_FUNC_KEYMGMT_FREE, (void (*)(void))trustm_provider_keymgmt_free },
+    { OSSL_FUNC_KEYMGMT_LOAD, (void (*)(void))trustm_provider_keymgmt_load },
+    { OSSL_FUNC_KEYMGMT_HAS, (void (*)(void))trustm_provider_keymgmt_has },
+    { OSSL_FUNC_KEYMGMT_MATCH, (void (*)(void))trustm_provider_keymgmt_match },
+    { OSSL_FUNC_KEYMGMT_IMPORT, (void (*)(void))trustm_provider_keymgmt_ec_import },
+    { OSSL_FUNC_KEYMGMT_IMPORT_TYPES, (void (*)(void))trustm_provider_keymgmt_ec_types },
+    { OSSL_FUNC_KEYMGMT_EXPORT, (void (*)(void))trustm_provider_keymgmt_export },
+    { OSSL_FUNC_KEYMGMT_EXPORT_TYPES, (void (*)(void))trustm_provider_keymgmt_ec_types },
+    { OSSL_FUNC_KEYMGMT_GET_PARAMS, (void (*)(void))trustm_provider_keymgmt_get_params },
+    { OSSL_FUNC_KEYMGMT_GETTABLE_PARAMS, (void (*)(void))trustm_provider_keymgmt_gettable_params },
+    { OSSL_FUNC_KEYMGMT_QUERY_OPERATION_NAME, (void (*)(void))trustm_provider_keymgmt_ec_operation_name },
+    { 0, NULL }
+};
+
+static const OSSL_DISPATCH trustm_provider_keymgmt_rsa_functions[] =
+{
+    { OSSL_FUNC_KEYMGMT_NEW, (void (*)(void))trustm_provider_keymgmt_new },
+    { OSSL_FUNC_KEYMGMT_FREE, (void (*)(void))trustm_provider_keymgmt_free },
+    { OSSL_FUNC_KEYMGMT_LOAD, (void (*)(void))trustm_provider_keymgmt_load },
+    { OSSL_FUNC_KEYMGMT_HAS, (void (*)(void))trustm_provider_keymgmt_has },
+    { OSSL_FUNC_KEYMGMT_MATCH, (void (*)(void))trustm_provider_keymgmt_match },
+    { OSSL_FUNC_KEYMGMT_IMPORT, (void (*)(void))trustm_provider_keymgmt_rsa_import },
+    { OSSL_FUNC_KEYMGMT_IMPORT_TYPES, (void (*)(void))trustm_provider_keymgmt_rsa_types },
+    { OSSL_FUNC_KEYMGMT_EXPORT, (void (*)(void))trustm_provider_keymgmt_export },
+    { OSSL_FUNC_KEYMGMT_EXPORT_TYPES, (void (*)(void))trustm_provider_keymgmt_rsa_types },
+    { OSSL_FUNC_KEYMGMT_GET_PARAMS, (void (*)(void))trustm_provider_keymgmt_get_params },
+    { OSSL_FUNC_KEYMGMT_GETTABLE_PARAMS, (void (*)(void))trustm_provider_keymgmt_gettable_params },
+    { OSSL_FUNC_KEYMGMT_QUERY_OPERATION_NAME, (void (*)(void))trustm_provider_keymgmt_rsa_operation_name },
+    { 0, NULL }
+};
+
+/**********************************************************************************************************************
+ * Signature
+ *********************************************************************************************************************/
+
+static void * trustm_provider_signature_newctx(void * provctx, const char * propq)
+{
+    trustm_provider_signature_t * p_signature = OPENSSL_zalloc(sizeof(trustm_provider_signature_t));
+
+    (void)propq;
+    if (NULL != p_signature)
+    {
+        p_signature->p_ctx = (trustm_provider_ctx_t *)provctx;
+    }
+    return (p_signature);
+}
+
+static void trustm_provider_signature_freectx(void * ctx)
+{
+    trustm_provider_signature_t * p_signature = (trustm_provider_signature_t *)ctx;
+
+    if (NULL != p_signature)
+    {
+        EVP_MD_CTX_free(p_signature->p_md_ctx);
+        EVP_MD_free(p_signature->p_md);
+        OPENSSL_free(p_signature);
+    }
+}
+
+static void * trustm_provider_signature_dupctx(void * ctx)
+{
+    trustm_provider_signature_t * p_signature = (trustm_provider_signature_t *)ctx;
+    trustm_provider_signature_t * p_dup = OPENSSL_memdup(p_signature, sizeof(trustm_provider_signature_t));
+
+    do
+    {
+        if (NULL == p_dup)
+        {
+            break;
+        }
+        p_dup->p_md_ctx = NULL;
+        if ((NULL != p_dup->p_md) && (1 != EVP_MD_up_ref(p_dup->p_md)))
+        {
+            p_dup->p_md = NULL;
+            trustm_provider_signature_freectx(p_dup);
+            p_dup = NULL;
+            break;
+        }
+        if (NULL != p_signature->p_md_ctx)
+        {
+            p_dup->p_md_ctx = EVP_MD_CTX_new();
+            if ((NULL == p_dup->p_md_ctx) || (1 != EVP_MD_CTX_copy_ex(p_dup->p_md_ctx, p_signature->p_md_ctx)))
+            {
+                trustm_provider_signature_freectx(p_dup);
+                p_dup = NULL;
+                break;
+            }
+        }
+    } while (FALSE);
+
+    return (p_dup);
+}
+
+static int trustm_provider_signature_set_md(trustm_provider_signature_t * p_signature, const char * p_md_name)
+{
+    EVP_MD * p_md;
+
+    if ((NULL == p_md_name) || ('\0' == p_md_name[0]))
+    {
+        return (1);
+    }
+    p_md = EVP_MD_fetch(p_signature->p_ctx->p_libctx, p_md_name, TRUSTM_PROVIDER_SOFTWARE_PROPQ);
+    if (NULL == p_md)
+    {
+        return (0);
+    }
+    EVP_MD_free(p_signature->p_md);
+    p_signature->p_md = p_md;
+    return (1);
+}
+
+static int trustm_provider_signature_set_ctx_params(void * ctx, const OSSL_PARAM params[])
+{
+    trustm_provider_signature_t * p_signature = (trustm_provider_signature_t *)ctx;
+    const OSSL_PARAM * p_param;
+    const char * p_md_name = NULL;
+    int pad_mode;
+
+    p_param = OSSL_PARAM_locate_const(params, OSSL_SIGNATURE_PARAM_DIGEST);
+    if ((NULL != p_param) &&
+        ((1 != OSSL_PARAM_get_utf8_string_ptr(p_param, &p_md_name)) ||
+         (0 == trustm_provider_signature_set_md(p_signature, p_md_name))))
+    {
+        return (0);
+    }
+    // OPTIGA signs with PKCS#1 v1.5 padding only
+    p_param = OSSL_PARAM_locate_const(params, OSSL_SIGNATURE_PARAM_PAD_MODE);
+    if (NULL != p_param)
+    {
+        if (OSSL_PARAM_UTF8_STRING == p_param->data_type)
+        {
+            return ((0 == strcmp((const char *)p_param->data, OSSL_PKEY_RSA_PAD_MODE_PKCSV15)) ? 1 : 0);
+        }
+        return (((1 == OSSL_PARAM_get_int(p_param, &pad_mode)) && (RSA_PKCS1_PADDING == pad_mode)) ? 1 : 0);
+    }
+    return (1);
+}
+
+static const OSSL_PARAM trustm_provider_signature_settable[] =
+{
+    OSSL_PARAM_utf8_string(OSSL_SIGNATURE_PARAM_DIGEST, NULL, 0),
+    OSSL_PARAM_utf8_string(OSSL_SIGNATURE_PARAM_PAD_MODE, NULL, 0),
+    OSSL_PARAM_END
+};
+
+static const OSSL_PARAM * trustm_provider_signature_settable_ctx_params(void * ctx, void * provctx)
+{
+    (void)ctx;
+    (void)provctx;
+    return (trustm_provider_signature_settable);
+}
+
+static int trustm_provider_signature_get_ctx_params(void * ctx, OSSL_PARAM params[])
+{
+    trustm_provider_signature_t * p_signature = (trustm_provider_signature_t *)ctx;
+    OSSL_PARAM * p_param = OSSL_PARAM_locate(params, OSSL_SIGNATURE_PARAM_DIGEST);
+
+    if ((NULL != p_param) && (NULL != p_signature->p_md))
+    {
+        return (OSSL_PARAM_set_utf8_string(p_param, EVP_MD_get0_name(p_signature->p_md)));
+    }
+    return (1);
+}
+
+static const OSSL_PARAM trustm_provider_signature_gettable[] =
+{
+    OSSL_PARAM_utf8_string(OSSL_SIGNATURE_PARAM_DIGEST, NULL, 0),
+    OSSL_PARAM_END
+};
+
+static const OSSL_PARAM * trustm_provider_signature_gettable_ctx_params(void * ctx, void * provctx)
+{
+    (void)ctx;
+    (void)provctx;
+    return (trustm_provider_signature_gettable);
+}
+
+static int trustm_provider_signature_init(void * ctx, void * provkey, const OSSL_PARAM params[])
+{
+    trustm_provider_signature_t * p_signature = (trustm_provider_signature_t *)ctx;
+
+    p_signature->p_key = (trustm_provider_key_t *)provkey;
+    if (NULL == p_signature->p_key)
+    {
+        return (0);
+    }
+    return (trustm_provider_signature_set_ctx_params(ctx, params));
+}
+
+static int trustm_provider_signature_sign(void * ctx,
+                                          unsigned char * sig,
+                                          size_t * siglen,
+                                          size_t sigsize,
+                                          const unsigned char * tbs,
+                                          size_t tbslen)
+{
+    trustm_provider_signature_t * p_signature = (trustm_provider_signature_t *)ctx;
+    trustm_provider_request_t request;
+    uint8_t signature[TRUSTM_PROVIDER_DER_HEADER + TRUSTM_PROVIDER_ECDSA_MAX_LENGTH];
+    uint8_t * p_output;
+    size_t length;
+    int md_size;
+
+    if (0 == p_signature->p_key->key_oid)
+    {
+        return (0);
+    }
+    if (NULL == sig)
+    {
+        *siglen = (EVP_PKEY_RSA == p_signature->p_key->key_type) ? TRUSTM_PROVIDER_RSA_MAX_LENGTH :
+                                                                   sizeof(signature);
+        if (NULL != p_signature->p_key->p_public_key)
+        {
+            *siglen = (size_t)EVP_PKEY_get_size(p_signature->p_key->p_public_key);
+        }
+        return (1);
+    }
+    if (tbslen > 0x40)
+    {
+        return (0);
+    }
+
+    memset(&request, 0, sizeof(request));
+    request.key_oid = p_signature->p_key->key_oid;
+    request.p_input = tbs;
+    request.input_length = (uint16_t)tbslen;
+    if (EVP_PKEY_RSA == p_signature->p_key->key_type)
+    {
+        // OPTIGA encodes the DigestInfo, hence the scheme follows the digest
+        md_size = (NULL != p_signature->p_md) ? EVP_MD_get_size(p_signature->p_md) : (int)tbslen;
+        if ((int)tbslen != md_size)
+        {
+            return (0);
+        }
+#ifdef OPTIGA_CRYPT_RSA_SSA_SHA512_ENABLED
+        request.signature_scheme = (0x40 == tbslen) ? OPTIGA_RSASSA_PKCS1_V15_SHA512 :
+#else
+        request.signature_scheme =
+#endif
+                                   ((0x30 == tbslen) ? OPTIGA_RSASSA_PKCS1_V15_SHA384 : OPTIGA_RSASSA_PKCS1_V15_SHA256);
+        if (sigsize > 0xFFFF)
+        {
+            sigsize = 0xFFFF;
+        }
+        request.type = TRUSTM_PROVIDER_RSA_SIGN;
+        request.p_output = sig;
+        request.output_length = (uint16_t)sigsize;
+        if (0 == trustm_provider_execute(p_signature->p_ctx, &request))
+        {
+            return (0);
+        }
+        *siglen = request.output_length;
+        return (1);
+    }
+
+    request.type = TRUSTM_PROVIDER_ECDSA_SIGN;
+    request.p_output = &signature[TRUSTM_PROVIDER_DER_HEADER];
+    request.output_length = TRUSTM_PROVIDER_ECDSA_MAX_LENGTH;
+    if (0 == trustm_provider_execute(p_signature->p_ctx, &request))
+    {
+        return (0);
+    }
+    // OPTIGA provides the integers r and s, OpenSSL takes the DER encoded Ecdsa-Sig-Value
+    length = request.output_length;
+    if (length < 0x80)
+    {
+        p_output = &signature[TRUSTM_PROVIDER_DER_HEADER - 2];
+        p_output[1] = (uint8_t)length;
+        length += 2;
+    }
+    else
+    {
+        p_output = signature;
+        p_output[1] = 0x81;
+        p_output[2] = (uint8_t)length;
+        length += 3;
+    }
+    p_output[0] = 0x30;
+    if (length > sigsize)
+    {
+        return (0);
+    }
+    memcpy(sig, p_output, length);
+    *siglen = length;
+    return (1);
+}
+
+/*
+* Verifies the signature with the public key, by the software implementation
+*/
+static int trustm_provider_signature_verify(void * ctx,
+                                            const unsigned char * sig,
+                                            size_t siglen,
+                                            const unsigned char * tbs,
+                                            size_t tbslen)
+{
+    trustm_provider_signature_t * p_signature = (trustm_provider_signature_t *)ctx;
+    EVP_PKEY_CTX * p_pkey_ctx = NULL;
+    int return_status = 0;
+
+    do
+    {
+        if (NULL == p_signature->p_key->p_public_key)
+        {
+            break;
+        }
+        p_pkey_ctx = EVP_PKEY_CTX_new_from_pkey(p_signature->p_ctx->p_libctx,
+                                                p_signature->p_key->p_public_key,
+                                                TRUSTM_PROVIDER_SOFTWARE_PROPQ);
+        if ((NULL == p_pkey_ctx) || (1 != EVP_PKEY_verify_init(p_pkey_ctx)))
+        {
+            break;
+        }
+        if ((NULL != p_signature->p_md) && (1 != EVP_PKEY_CTX_set_signature_md(p_pkey_ctx, p_signature->p_md)))
+        {
+            break;
+        }
+        if ((EVP_PKEY_RSA == p_signature->p_key->key_type) &&
+            (1 != EVP_PKEY_CTX_set_rsa_padding(p_pkey_ctx, RSA_PKCS1_PADDING)))
+        {
+            break;
+        }
+        return_status = (1 == EVP_PKEY_verify(p_pkey_ctx, sig, siglen, tbs, tbslen)) ? 1 : 0;
+    } while (FALSE);
+
+    EVP_PKEY_CTX_free(p_pkey_ctx);
+    return (return_status);
+}
+
+static int trustm_provider_signature_digest_init(void * ctx,
+                                                 const char * mdname,
+                                                 void * provkey,
+                                                 const OSSL_PARAM params[])
+{
+    trustm_provider_signature_t * p_signature = (trustm_provider_signature_t *)ctx;
+
+    if ((0 == trustm_provider_signature_init(ctx, provkey, params)) ||
+        (0 == trustm_provider_signature_set_md(p_signature, (NULL != mdname) ? mdname : "SHA256")))
+    {
+        return (0);
+    }
+    if (NULL == p_signature->p_md_ctx)
+    {
+        p_signature->p_md_ctx = EVP_MD_CTX_new();
+    }
+    if ((NULL == p_signature->p_md_ctx) ||
+        (1 != EVP_DigestInit_ex2(p_signature->p_md_ctx, p_signature->p_md, NULL)))
+    {
+        return (0);
+    }
+    return (1);
+}
+
+static int trustm_provider_signature_digest_update(void * ctx, const unsigned char * data, size_t datalen)
+{
+    trustm_provider_signature_t * p_signature = (trustm_provider_signature_t *)ctx;
+
+    return ((1 == EVP_DigestUpdate(p_signature->p_md_ctx, data, datalen)) ? 1 : 0);
+}
+
+static int trustm_provider_signature_digest_sign_final(void * ctx,
+                                                       unsigned char * sig,
+                                                       size_t * siglen,
+                                                       size_t sigsize)
+{
+    trustm_provider_signature_t * p_signature = (trustm_provider_signature_t *)ctx;
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int digest_length = 0;
+
+    // Only the size is queried, the digest is kept open
+    if (NULL == sig)
+    {
+        return (trustm_provider_signature_sign(ctx, NULL, siglen, sigsize, NULL, 0));
+    }
+    if (1 != EVP_DigestFinal_ex(p_signature->p_md_ctx, digest, &digest_length))
+    {
+        return (0);
+    }
+    return (trustm_provider_signature_sign(ctx, sig, siglen, sigsize, digest, digest_length));
+}
+
+static int trustm_provider_signature_digest_verify_final(void * ctx, const unsigned char * sig, size_t siglen)
+{
+    trustm_provider_signature_t * p_signature = (trustm_provider_signature_t *)ctx;
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int digest_length = 0;
+
+    if (1 != EVP_DigestFinal_ex(p_signature->p_md_ctx, digest, &digest_length))
+    {
+        return (0);
+    }
+    return (trustm_provider_signature_verify(ctx, sig, siglen, digest, digest_length));
+}
+
+static const OSSL_DISPATCH trustm_provider_signature_functions[] =
+{
+    { OSSL_FUNC_SIGNATURE_NEWCTX, (void (*)(void))trustm_provider_signature_newctx },
+    { OSSL_FUNC_SIGNATURE_FREECTX, (void (*)(void))trustm_provider_signature_freectx },
+    { OSSL_FUNC_SIGNATURE_DUPCTX, (void (*)(void))trustm_provider_signature_dupctx },
+    { OSSL_FUNC_SIGNATURE_SIGN_INIT, (void (*)(void))trustm_provider_signature_init },
+    { OSSL_FUNC_SIGNATURE_SIGN, (void (*)(void))trustm_provider_signature_sign },
+    { OSSL_FUNC_SIGNATURE_VERIFY_INIT, (void (*)(void))trustm_provider_signature_init },
+    { OSSL_FUNC_SIGNATURE_VERIFY, (void (*)(void))trustm_provider_signature_verify },
+    { OSSL_FUNC_SIGNATURE_DIGEST_SIGN_INIT, (void (*)(void))trustm_provider_signature_digest_init },
+    { OSSL_FUNC_SIGNATURE_DIGEST_SIGN_UPDATE, (void (*)(void))trustm_provider_signature_digest_update },
+    { OSSL_FUNC_SIGNATURE_DIGEST_SIGN_FINAL, (void (*)(void))trustm_provider_signature_digest_sign_final },
+    { OSSL_FUNC_SIGNATURE_DIGEST_VERIFY_INIT, (void (*)(void))trustm_provider_signature_digest_init },
+    { OSSL_FUNC_SIGNATURE_DIGEST_VERIFY_UPDATE, (void (*)(void))trustm_provider_signature_digest_update },
+    { OSSL_FUNC_SIGNATURE_DIGEST_VERIFY_FINAL, (void (*)(void))trustm_provider_signature_digest_verify_final },
+    { OSSL_FUNC_SIGNATURE_GET_CTX_PARAMS, (void (*)(void))trustm_provider_signature_get_ctx_params },
+    { OSSL_FUNC_SIGNATURE_GETTABLE_CTX_PARAMS, (void (*)(void))trustm_provider_signature_gettable_ctx_params },
+    { OSSL_FUNC_SIGNATURE_SET_CTX_PARAMS, (void (*)(void))trustm_provider_signature_set_ctx_params },
+    { OSSL_FUNC_SIGNATURE_SETTABLE_CTX_PARAMS, (void (*)(void))trustm_provider_signature_settable_ctx_params },
+    { 0, NULL }
+};
+
+/**********************************************************************************************************************
+ * Key exchange
+ *********************************************************************************************************************/
+
+static void * trustm_provider_keyexch_newctx(void * provctx)
+{
+    trustm_provider_keyexch_t * p_keyexch = OPENSSL_zalloc(sizeof(trustm_provider_keyexch_t));
+
+    if (NULL != p_keyexch)
+    {
+        p_keyexch->p_ctx = (trustm_provider_ctx_t *)provctx;
+    }
+    return (p_keyexch);
+}
+
+static void trustm_provider_keyexch_freectx(void * ctx)
+{
+    OPENSSL_free(ctx);
+}
+
+static void * trustm_provider_keyexch_dupctx(void * ctx)
+{
+    return (OPENSSL_memdup(ctx, sizeof(trustm_provider_keyexch_t)));
+}
+
+static int trustm_provider_keyexch_init(void * ctx, void * provkey, const OSSL_PARAM params[])
+{
+    trustm_provider_keyexch_t * p_keyexch = (trustm_provider_keyexch_t *)ctx;
+
+    (void)params;
+    p_keyexch->p_key = (trustm_provider_key_t *)provkey;
+    return (((NULL != p_keyexch->p_key) && (0 != p_keyexch->p_key->key_oid)) ? 1 : 0);
+}
+
+static int trustm_provider_keyexch_set_peer(void * ctx, void * provkey)
+{
+    trustm_provider_keyexch_t * p_keyexch = (trustm_provider_keyexch_t *)ctx;
+
+    p_keyexch->p_peer = (trustm_provider_key_t *)provkey;
+    return (((NULL != p_keyexch->p_peer) && (NULL != p_keyexch->p_peer->p_public_key)) ? 1 : 0);
+}
+
+static int trustm_provider_keyexch_derive(void * ctx, unsigned char * secret, size_t * secretlen, size_t outlen)
+{
+    trustm_provider_keyexch_t * p_keyexch = (trustm_provider_keyexch_t *)ctx;
+    trustm_provider_request_t request;
+    public_key_from_host_t public_key;
+    uint8_t point[TRUSTM_PROVIDER_ECC_POINT_MAX_LENGTH];
+    uint8_t bit_string[4 + TRUSTM_PROVIDER_ECC_POINT_MAX_LENGTH];
+    uint8_t shared_secret[0x42];
+    size_t point_length = 0;
+    size_t secret_length;
+    uint8_t header_length;
+
+    if (NULL == p_keyexch->p_peer)
+    {
+        return (0);
+    }
+    // Size of the field, which is the length of the shared secret
+    secret_length = ((size_t)EVP_PKEY_get_bits(p_keyexch->p_peer->p_public_key) + 7) / 8;
+    if (NULL == secret)
+    {
+        *secretlen = secret_length;
+        return (1);
+    }
+    if ((outlen < secret_length) || (secret_length > sizeof(shared_secret)))
+    {
+        return (0);
+    }
+
+    // OPTIGA takes the uncompressed point of the peer as BIT STRING
+    if (1 != EVP_PKEY_get_octet_string_param(p_keyexch->p_peer->p_public_key,
+                                             OSSL_PKEY_PARAM_ENCODED_PUBLIC_KEY,
+                                             point,
+                                             sizeof(point),
+                                             &point_length))
+    {
+        return (0);
+    }
+    header_length = 0;
+    bit_string[header_length++] = 0x03;
+    if (point_length + 1 >= 0x80)
+    {
+        bit_string[header_length++] = 0x81;
+    }
+    bit_string[header_length++] = (uint8_t)(point_length + 1);
+    bit_string[header_length++] = 0x00;
+    memcpy(&bit_string[header_length], point, point_length);
+
+    public_key.public_key = bit_string;
+    public_key.length = (uint16_t)(header_length + point_length);
+    public_key.key_type = p_keyexch->p_peer->optiga_key_type;
+
+    memset(&request, 0, sizeof(request));
+    request.type = TRUSTM_PROVIDER_ECDH;
+    request.key_oid = p_keyexch->p_key->key_oid;
+    request.p_public_key = &public_key;
+    request.p_output = shared_secret;
+    if (0 == trustm_provider_execute(p_keyexch->p_ctx, &request))
+    {
+        return (0);
+    }
+    memcpy(secret, shared_secret, secret_length);
+    OPENSSL_cleanse(shared_secret, sizeof(shared_secret));
+    *secretlen = secret_length;
+    return (1);
+}
+
+static int trustm_provider_keyexch_set_ctx_params(void * ctx, const OSSL_PARAM params[])
+{
+    (void)ctx;
+    (void)params;
+    return (1);
+}
+
+static const OSSL_PARAM trustm_provider_empty_params[] =
+{
+    OSSL_PARAM_END
+};
+
+static const OSSL_PARAM * trustm_provider_keyexch_settable_ctx_params(void * ctx, void * provctx)
+{
+    (void)ctx;
+    (void)provctx;
+    return (trustm_provider_empty_params);
+}
+
+static const OSSL_DISPATCH trustm_provider_keyexch_functions[] =
+{
+    { OSSL_FUNC_KEYEXCH_NEWCTX, (void (*)(void))trustm_provider_keyexch_newctx },
+    { OSSL_FUNC_KEYEXCH_FREECTX, (void (*)(void))trustm_provider_keyexch_freectx },
+    { OSSL_FUNC_KEYEXCH_DUPCTX, (void (*)(void))trustm_provider_keyexch_dupctx },
+    { OSSL_FUNC_KEYEXCH_INIT, (void (*)(void))trustm_provider_keyexch_init },
+    { OSSL_FUNC_KEYEXCH_SET_PEER, (void (*)(void))trustm_provider_keyexch_set_peer },
+    { OSSL_FUNC_KEYEXCH_DERIVE, (void (*)(void))trustm_provider_keyexch_derive },
+    { OSSL_FUNC_KEYEXCH_SET_CTX_PARAMS, (void (*)(void))trustm_provider_keyexch_set_ctx_params },
+    { OSSL_FUNC_KEYEXCH_SETTABLE_CTX_PARAMS, (void (*)(void))trustm_provider_keyexch_settable_ctx_params },
+    { 0, NULL }
+};
+
+/**********************************************************************************************************************
+ * Random generator
+ *********************************************************************************************************************/
+
+static void * trustm_provider_rand_newctx(void * provctx, void * parent, const OSSL_DISPATCH * parent_calls)
+{
+    trustm_provider_rand_t * p_rand = OPENSSL_zalloc(sizeof(trustm_provider_rand_t));
+
+    (void)parent;
+    (void)parent_calls;
+    if (NULL != p_rand)
+    {
+        p_rand->p_ctx = (trustm_provider_ctx_t *)provctx;
+        p_rand->state = EVP_RAND_STATE_UNINITIALISED;
+    }
+    return (p_rand);
+}
+
+static void trustm_provider_rand_freectx(void * ctx)
+{
+    OPENSSL_free(ctx);
+}
+
+static int trustm_provider_rand_instantiate(void * ctx,
+                                            unsigned int strength,
+                                            int prediction_resistance,
+                                            const unsigned char * pstr,
+                                            size_t pstr_len,
+                                            const OSSL_PARAM params[])
+{
+    trustm_provider_rand_t * p_rand = (trustm_provider_rand_t *)ctx;
+
+    (void)prediction_resistance;
+    (void)pstr;
+    (void)pstr_len;
+    (void)params;
+    if (strength > TRUSTM_PROVIDER_RANDOM_STRENGTH)
+    {
+        return (0);
+    }
+    p_rand->state = EVP_RAND_STATE_READY;
+    return (1);
+}
+
+static int trustm_provider_rand_uninstantiate(void * ctx)
+{
+    trustm_provider_rand_t * p_rand = (trustm_provider_rand_t *)ctx;
+
+    p_rand->state = EVP_RAND_STATE_UNINITIALISED;
+    return (1);
+}
+
+static int trustm_provider_rand_generate(void * ctx,
+                                         unsigned char * out,
+                                         size_t outlen,
+                                         unsigned int strength,
+                                         int prediction_resistance,
+                                         const unsigned char * adin,
+                                         size_t adinlen)
+{
+    trustm_provider_rand_t * p_rand = (trustm_provider_rand_t *)ctx;
+    trustm_provider_request_t request;
+    uint8_t random[TRUSTM_PROVIDER_RANDOM_MIN_LENGTH];
+    size_t length;
+
+    (void)prediction_resistance;
+    (void)adin;
+    (void)adinlen;
+    if ((EVP_RAND_STATE_READY != p_rand->state) || (strength > TRUSTM_PROVIDER_RANDOM_STRENGTH))
+    {
+        return (0);
+    }
+    memset(&request, 0, sizeof(request));
+    request.type = TRUSTM_PROVIDER_RANDOM;
+    while (0 != outlen)
+    {
+        length = (outlen > TRUSTM_PROVIDER_RANDOM_MAX_LENGTH) ? TRUSTM_PROVIDER_RANDOM_MAX_LENGTH : outlen;
+        // The command returns at least 8 bytes
+        request.p_output = (length < TRUSTM_PROVIDER_RANDOM_MIN_LENGTH) ? random : out;
+        request.output_length = (length < TRUSTM_PROVIDER_RANDOM_MIN_LENGTH) ? TRUSTM_PROVIDER_RANDOM_MIN_LENGTH :
+                                                                               (uint16_t)length;
+        if (0 == trustm_provider_execute(p_rand->p_ctx, &request))
+        {
+            p_rand->state = EVP_RAND_STATE_ERROR;
+            return (0);
+        }
+        if (random == request.p_output)
+        {
+            memcpy(out, random, length);
+            OPENSSL_cleanse(random, sizeof(random));
+        }
+        out += length;
+        outlen -= length;
+    }
+    return (1);
+}
+
+static int trustm_provider_rand_enable_locking(void * ctx)
+{
+    // The operations are serialized by the provider
+    (void)ctx;
+    return (1);
+}
+
+static int trustm_provider_rand_lock(void * ctx)
+{
+    (void)ctx;
+    return (1);
+}
+
+static void trustm_provider_rand_unlock(void * ctx)
+{
+    (void)ctx;
+}
+
+static int trustm_provider_rand_get_ctx_params(void * ctx, OSSL_PARAM params[])
+{
+    trustm_provider_rand_t * p_rand = (trustm_provider_rand_t *)ctx;
+    OSSL_PARAM * p_param;
+
+    p_param = OSSL_PARAM_locate(params, OSSL_RAND_PARAM_STATE);
+    if ((NULL != p_param) && (1 != OSSL_PARAM_set_int(p_param, p_rand->state)))
+    {
+        return (0);
+    }
+    p_param = OSSL_PARAM_locate(params, OSSL_RAND_PARAM_STRENGTH);
+    if ((NULL != p_param) && (1 != OSSL_PARAM_set_uint(p_param, TRUSTM_PROVIDER_RANDOM_STRENGTH)))
+    {
+        return (0);
+    }
+    p_param = OSSL_PARAM_locate(params, OSSL_RAND_PARAM_MAX_REQUEST);
+    if ((NULL != p_param) && (1 != OSSL_PARAM_set_size_t(p_param, TRUSTM_PROVIDER_RANDOM_MAX_LENGTH)))
+    {
+        return (0);
+    }
+    return (1);
+}
+
+static const OSSL_PARAM trustm_provider_rand_gettable[] =
+{
+    OSSL_PARAM_int(OSSL_RAND_PARAM_STATE, NULL),
+    OSSL_PARAM_uint(OSSL_RAND_PARAM_STRENGTH, NULL),
+    OSSL_PARAM_size_t(OSSL_RAND_PARAM_MAX_REQUEST, NULL),
+    OSSL_PARAM_END
+};
+
+static const OSSL_PARAM * trustm_provider_rand_gettable_ctx_params(void * ctx, void * provctx)
+{
+    (void)ctx;
+    (void)provctx;
+    return (trustm_provider_rand_gettable);
+}
+
+static const OSSL_DISPATCH trustm_provider_rand_functions[] =
+{
+    { OSSL_FUNC_RAND_NEWCTX, (void (*)(void))trustm_provider_rand_newctx },
+    { OSSL_FUNC_RAND_FREECTX, (void (*)(void))trustm_provider_rand_freectx },
+    { OSSL_FUNC_RAND_INSTANTIATE, (void (*)(void))trustm_provider_rand_instantiate },
+    { OSSL_FUNC_RAND_UNINSTANTIATE, (void (*)(void))trustm_provider_rand_uninstantiate },
+    { OSSL_FUNC_RAND_GENERATE, (void (*)(void))trustm_provider_rand_generate },
+    { OSSL_FUNC_RAND_ENABLE_LOCKING, (void (*)(void))trustm_provider_rand_enable_locking },
+    { OSSL_FUNC_RAND_LOCK, (void (*)(void))trustm_provider_rand_lock },
+    { OSSL_FUNC_RAND_UNLOCK, (void (*)(void))trustm_provider_rand_unlock },
+    { OSSL_FUNC_RAND_GET_CTX_PARAMS, (void (*)(void))trustm_provider_rand_get_ctx_params },
+    { OSSL_FUNC_RAND_GETTABLE_CTX_PARAMS, (void (*)(void))trustm_provider_rand_gettable_ctx_params },
+    { 0, NULL }
+};
+
+/**********************************************************************************************************************
+ * Store loader
+ *********************************************************************************************************************/
+
+/*
+* Opens the URI "optiga:<key OID>[?cert=<certificate OID>]"
+*/
+static void * trustm_provider_store_open(void * provctx, const char * uri)
+{
+    trustm_provider_store_t * p_store = NULL;
+    const char * p_text;
+    uint16_t key_oid;
+    uint16_t certificate_oid;
+
+    do
+    {
+        if (0 != strncmp(uri, TRUSTM_PROVIDER_URI_SCHEME, sizeof(TRUSTM_PROVIDER_URI_SCHEME) - 1))
+        {
+            break;
+        }
+        p_text = uri + sizeof(TRUSTM_PROVIDER_URI_SCHEME) - 1;
+        if (0 == trustm_provider_parse_oid(p_text, &key_oid, &p_text))
+        {
+            break;
+        }
+        // The certificates of the device keys are stored in the data objects of the same index
+        certificate_oid = ((key_oid >= 0xE0F0) && (key_oid <= 0xE0F3)) ? (uint16_t)(key_oid - 0x10) : 0;
+        if ((0 == strncmp(p_text, "?cert=", 6)) && (0 == trustm_provider_parse_oid(p_text + 6, &certificate_oid, &p_text)))
+        {
+            break;
+        }
+        if (('\0' != *p_text) || (0 == certificate_oid))
+        {
+            break;
+        }
+        p_store = OPENSSL_zalloc(sizeof(trustm_provider_store_t));
+        if (NULL != p_store)
+        {
+            p_store->p_ctx = (trustm_provider_ctx_t *)provctx;
+            p_store->key_oid = key_oid;
+            p_store->certificate_oid = certificate_oid;
+        }
+    } while (FALSE);
+
+    return (p_store);
+}
+
+static int trustm_provider_store_load(void * loaderctx,
+                                      OSSL_CALLBACK * object_cb,
+                                      void * object_cbarg,
+                                      OSSL_PASSPHRASE_CALLBACK * pw_cb,
+                                      void * pw_cbarg)
+{
+    trustm_provider_store_t * p_store = (trustm_provider_store_t *)loaderctx;
+    trustm_provider_key_t * p_key = NULL;
+    OSSL_PARAM params[4];
+    int object_type = OSSL_OBJECT_PKEY;
+    int return_status = 0;
+
+    (void)pw_cb;
+    (void)pw_cbarg;
+    do
+    {
+        p_store->eof = TRUE;
+        p_key = trustm_provider_keymgmt_new(p_store->p_ctx);
+        if (NULL == p_key)
+        {
+            break;
+        }
+        p_key->key_oid = p_store->key_oid;
+        p_key->p_public_key = trustm_provider_read_public_key(p_store->p_ctx, p_store->certificate_oid);
+        if ((NULL == p_key->p_public_key) || (0 == trustm_provider_key_set_type(p_key)))
+        {
+            break;
+        }
+        // The key object is passed by reference, the key management takes it in its load
+        params[0] = OSSL_PARAM_construct_int(OSSL_OBJECT_PARAM_TYPE, &object_type);
+        params[1] = OSSL_PARAM_construct_utf8_string(OSSL_OBJECT_PARAM_DATA_TYPE,
+                                                     (EVP_PKEY_RSA == p_key->key_type) ? "RSA" : "EC",
+                                                     0);
+        params[2] = OSSL_PARAM_construct_octet_string(OSSL_OBJECT_PARAM_REFERENCE, &p_key, sizeof(p_key));
+        params[3] = OSSL_PARAM_construct_end();
+        return_status = object_cb(params, object_cbarg);
+    } while (FALSE);
+
+    // Not taken by the key management
+    trustm_provider_keymgmt_free(p_key);
+    return (return_status);
+}
+
+static int trustm_provider_store_eof(void * loaderctx)
+{
+    return (((trustm_provider_store_t *)loaderctx)->eof);
+}
+
+static int trustm_provider_store_close(void * loaderctx)
+{
+    OPENSSL_free(loaderctx);
+    return (1);
+}
+
+static int trustm_provider_store_set_ctx_params(void * loaderctx, const OSSL_PARAM params[])
+{
+    (void)loaderctx;
+    (void)params;
+    return (1);
+}
+
+static const OSSL_PARAM * trustm_provider_store_settable_ctx_params(void * provctx)
+{
+    (void)provctx;
+    return (trustm_provider_empty_params);
+}
+
+static const OSSL_DISPATCH trustm_provider_store_functions[] =
+{
+    { OSSL_FUNC_STORE_OPEN, (void (*)(void))trustm_provider_store_open },
+    { OSSL_FUNC_STORE_LOAD, (void (*)(void))trustm_provider_store_load },
+    { OSSL_FUNC_STORE_EOF, (void (*)(void))trustm_provider_store_eof },
+    { OSSL_FUNC_STORE_CLOSE, (void (*)(void))trustm_provider_store_close },
+    { OSSL_FUNC_STORE_SET_CTX_PARAMS, (void (*)(void))trustm_provider_store_set_ctx_params },
+    { OSSL_FUNC_STORE_SETTABLE_CTX_PARAMS, (void (*)(void))trustm_provider_store_settable_ctx_params },
+    { 0, NULL }
+};
+
+/**********************************************************************************************************************
+ * Provider
+ *********************************************************************************************************************/
+
+static const OSSL_ALGORITHM trustm_provider_keymgmt_algorithms[] =
+{
+    { "EC:id-ecPublicKey:1.2.840.10045.2.1", TRUSTM_PROVIDER_PROPERTY, trustm_provider_keymgmt_ec_functions, NULL },
+    { "RSA:rsaEncryption:1.2.840.113549.1.1.1", TRUSTM_PROVIDER_PROPERTY, trustm_provider_keymgmt_rsa_functions, NULL },
+    { NULL, NULL, NULL, NULL }
+};
+
+static const OSSL_ALGORITHM trustm_provider_signature_algorithms[] =
+{
+    { "ECDSA", TRUSTM_PROVIDER_PROPERTY, trustm_provider_signature_functions, NULL },
+    { "RSA:rsaEncryption:1.2.840.113549.1.1.1", TRUSTM_PROVIDER_PROPERTY, trustm_provider_signature_functions, NULL },
+    { NULL, NULL, NULL, NULL }
+};
+
+static const OSSL_ALGORITHM trustm_provider_keyexch_algorithms[] =
+{
+    { "ECDH", TRUSTM_PROVIDER_PROPERTY, trustm_provider_keyexch_functions, NULL },
+    { NULL, NULL, NULL, NULL }
+};
+
+static const OSSL_ALGORITHM trustm_provider_rand_algorithms[] =
+{
+    { "TRUSTM-TRNG", TRUSTM_PROVIDER_PROPERTY, trustm_provider_rand_functions, NULL },
+    { NULL, NULL, NULL, NULL }
+};
+
+static const OSSL_ALGORITHM trustm_provider_store_algorithms[] =
+{
+    { "optiga", TRUSTM_PROVIDER_PROPERTY, trustm_provider_store_functions, NULL },
+    { NULL, NULL, NULL, NULL }
+};
+
+static const OSSL_ALGORITHM * trustm_provider_query_operation(void * provctx, int operation_id, int * no_cache)
+{
+    const OSSL_ALGORITHM * p_algorithms = NULL;
+
+    (void)provctx;
+    *no_cache = 0;
+    switch (operation_id)
+    {
+        case OSSL_OP_KEYMGMT:
+            p_algorithms = trustm_provider_keymgmt_algorithms;
+            break;
+        case OSSL_OP_SIGNATURE:
+            p_algorithms = trustm_provider_signature_algorithms;
+            break;
+        case OSSL_OP_KEYEXCH:
+            p_algorithms = trustm_provider_keyexch_algorithms;
+            break;
+        case OSSL_OP_RAND:
+            p_algorithms = trustm_provider_rand_algorithms;
+            break;
+        case OSSL_OP_STORE:
+            p_algorithms = trustm_provider_store_algorithms;
+            break;
+        default:
+            break;
+    }
+    return (p_algorithms);
+}
+
+static const OSSL_PARAM trustm_provider_gettable[] =
+{
+    OSSL_PARAM_utf8_ptr(OSSL_PROV_PARAM_NAME, NULL, 0),
+    OSSL_PARAM_int(OSSL_PROV_PARAM_STATUS, NULL),
+    OSSL_PARAM_END
+};
+
+static const OSSL_PARAM * trustm_provider_gettable_params(void * provctx)
+{
+    (void)provctx;
+    return (trustm_provider_gettable);
+}
+
+static int trustm_provider_get_params(void * provctx, OSSL_PARAM params[])
+{
+    OSSL_PARAM * p_param;
+
+    (void)provctx;
+    p_param = OSSL_PARAM_locate(params, OSSL_PROV_PARAM_NAME);
+    if ((NULL != p_param) && (1 != OSSL_PARAM_set_utf8_ptr(p_param, "OPTIGA Trust M provider")))
+    {
+        return (0);
+    }
+    p_param = OSSL_PARAM_locate(params, OSSL_PROV_PARAM_STATUS);
+    if ((NULL != p_param) && (1 != OSSL_PARAM_set_int(p_param, 1)))
+    {
+        return (0);
+    }
+    return (1);
+}
+
+static void trustm_provider_teardown(void * provctx)
+{
+    trustm_provider_ctx_t * p_ctx = (trustm_provider_ctx_t *)provctx;
+    uint64_t event = 1;
+    uint8_t index;
+
+    //lint --e{534} suppress "The provider is unloaded, the return values are not required to be checked"
+    write(p_ctx->stop_fd, &event, sizeof(event));
+    pthread_join(p_ctx->reaper, NULL);
+    optiga_crypt_cq_deinit(&p_ctx->cq);
+    optiga_util_close_application_sync(p_ctx->me_util, 0);
+    optiga_util_destroy(p_ctx->me_util);
+    for (index = 0; index < TRUSTM_PROVIDER_POOL_SIZE; index++)
+    {
+        close(p_ctx->operations[index].event_fd);
+    }
+    close(p_ctx->stop_fd);
+    pthread_cond_destroy(&p_ctx->operation_released);
+    pthread_mutex_destroy(&p_ctx->lock);
+    pthread_mutex_destroy(&p_ctx->util_lock);
+    OSSL_LIB_CTX_free(p_ctx->p_libctx);
+    OPENSSL_free(p_ctx);
+}
+
+static const OSSL_DISPATCH trustm_provider_functions[] =
+{
+    { OSSL_FUNC_PROVIDER_TEARDOWN, (void (*)(void))trustm_provider_teardown },
+    { OSSL_FUNC_PROVIDER_GETTABLE_PARAMS, (void (*)(void))trustm_provider_gettable_params },
+    { OSSL_FUNC_PROVIDER_GET_PARAMS, (void (*)(void))trustm_provider_get_params },
+    { OSSL_FUNC_PROVIDER_QUERY_OPERATION, (void (*)(void))trustm_provider_query_operation },
+    { 0, NULL }
+};
+
+/*
+* Entry point of the provider, opens the application on OPTIGA and creates the crypt instances of the pool
+*/
+int OSSL_provider_init(const OSSL_CORE_HANDLE * handle,
+                       const OSSL_DISPATCH * in,
+                       const OSSL_DISPATCH ** out,
+                       void ** provctx)
+{
+    trustm_provider_ctx_t * p_ctx;
+    uint8_t index;
+    uint8_t fd_count = 0;
+    uint8_t progress = 0;
+    int return_status = 0;
+
+    p_ctx = OPENSSL_zalloc(sizeof(trustm_provider_ctx_t));
+    if (NULL == p_ctx)
+    {
+        return (0);
+    }
+    p_ctx->p_core = handle;
+    p_ctx->stop_fd = -1;
+    do
+    {
+        p_ctx->p_libctx = OSSL_LIB_CTX_new_child(handle, in);
+        if ((NULL == p_ctx->p_libctx) || (PAL_STATUS_SUCCESS != pal_init()))
+        {
+            break;
+        }
+        p_ctx->me_util = optiga_util_create(0, trustm_provider_util_callback, NULL);
+        if ((NULL == p_ctx->me_util) || (OPTIGA_LIB_SUCCESS != optiga_util_open_application_sync(p_ctx->me_util, 0)))
+        {
+            break;
+        }
+        progress = 1;
+        if ((OPTIGA_LIB_SUCCESS != optiga_crypt_cq_init(&p_ctx->cq, 0, p_ctx->slots, TRUSTM_PROVIDER_POOL_SIZE)) ||
+            (0 > optiga_crypt_cq_get_descriptor(&p_ctx->cq)))
+        {
+            break;
+        }
+        progress = 2;
+        for (fd_count = 0; fd_count < TRUSTM_PROVIDER_POOL_SIZE; fd_count++)
+        {
+            p_ctx->operations[fd_count].event_fd = eventfd(0, EFD_CLOEXEC);
+            if (0 > p_ctx->operations[fd_count].event_fd)
+            {
+                break;
+            }
+        }
+        p_ctx->stop_fd = eventfd(0, EFD_CLOEXEC);
+        if ((TRUSTM_PROVIDER_POOL_SIZE != fd_count) || (0 > p_ctx->stop_fd))
+        {
+            break;
+        }
+        pthread_mutex_init(&p_ctx->lock, NULL);
+        pthread_mutex_init(&p_ctx->util_lock, NULL);
+        pthread_cond_init(&p_ctx->operation_released, NULL);
+        if (0 != pthread_create(&p_ctx->reaper, NULL, trustm_provider_reaper, p_ctx))
+        {
+            pthread_cond_destroy(&p_ctx->operation_released);
+            pthread_mutex_destroy(&p_ctx->util_lock);
+            pthread_mutex_destroy(&p_ctx->lock);
+            break;
+        }
+        *out = trustm_provider_functions;
+        *provctx = p_ctx;
+        return_status = 1;
+    } while (FALSE);
+
+    if (0 == return_status)
+    {
+        //lint --e{534} suppress "The provider is not loaded, the return values are not required to be checked"
+        for (index = 0; index < fd_count; index++)
+        {
+            close(p_ctx->operations[index].event_fd);
+        }
+        if (0 <= p_ctx->stop_fd)
+        {
+            close(p_ctx->stop_fd);
+        }
+        if (progress > 1)
+        {
+            optiga_crypt_cq_deinit(&p_ctx->cq);
+        }
+        if (progress > 0)
+        {
+            optiga_util_close_application_sync(p_ctx->me_util, 0);
+        }
+        if (NULL != p_ctx->me_util)
+        {
+            optiga_util_destroy(p_ctx->me_util);
+        }
+        OSSL_LIB_CTX_free(p_ctx->p_libctx);
+        OPENSSL_free(p_ctx);
+    }
+    return (return_status);
+}
+
+#endif //OPTIGA_CRYPT_CQ_ENABLED && OPTIGA_LIB_SYNC_API_ENABLED
+
+/**
+* @}
+*/
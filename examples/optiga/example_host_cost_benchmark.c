@@ -0,0 +1,298 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file example_host_cost_benchmark.c
+*
+* \brief   This file provides the benchmark of the host CPU cost of the comms and command layer code paths.
+*
+* \ingroup grOptigaExamples
+*
+* @{
+*/
+
+#include "optiga/optiga_crypt.h"
+#include "optiga/optiga_util.h"
+#include "optiga/common/optiga_lib_profile.h"
+#include "optiga/pal/pal_os_timer.h"
+#include "optiga_example.h"
+#include <stdio.h>
+
+#ifdef OPTIGA_LIB_PROFILE_ENABLED
+
+#ifndef OPTIGA_INIT_DEINIT_DONE_EXCLUSIVELY
+extern void example_optiga_init(void);
+extern void example_optiga_deinit(void);
+#endif
+
+/// Number of operations of each case
+#ifndef OPTIGA_HOST_COST_ITERATIONS
+#define OPTIGA_HOST_COST_ITERATIONS         (16U)
+#endif
+/// Time after which an operation in progress is considered as lost
+#define OPTIGA_HOST_COST_TIMEOUT_US         (10000000U)
+/// Size of the data object of type 2, limits the size of the read cases
+#define OPTIGA_HOST_COST_BUFFER_SIZE        (1500U)
+/// Data object used by the read cases
+#define OPTIGA_HOST_COST_DATA_OBJECT        (0xF1E0U)
+
+#define OPTIGA_HOST_COST                    "[optiga host cost] : "
+
+/// Starts an operation of a case with the parameter of the case
+typedef optiga_lib_status_t (*optiga_host_cost_start_t)(uint16_t parameter);
+
+/** \brief Benchmark case */
+typedef struct optiga_host_cost_case
+{
+    /// Name of the case in the report
+    const char_t * p_name;
+    /// Starts one measured operation
+    optiga_host_cost_start_t start;
+    /// Parameter of the case, length of the data
+    uint16_t parameter;
+}optiga_host_cost_case_t;
+
+static optiga_util_t * p_host_cost_util = NULL;
+static optiga_crypt_t * p_host_cost_crypt = NULL;
+static volatile optiga_lib_status_t optiga_host_cost_status;
+static uint8_t optiga_host_cost_buffer[OPTIGA_HOST_COST_BUFFER_SIZE];
+static uint16_t optiga_host_cost_length;
+static optiga_lib_profile_stats_t optiga_host_cost_stats[OPTIGA_LIB_PROFILE_POINT_COUNT];
+
+// Names of the profiling points, indexed by optiga_lib_profile_point_t
+static const char_t * const optiga_host_cost_point_names[OPTIGA_LIB_PROFILE_POINT_COUNT] =
+{
+    "dl_crc", "tl_fragment", "prl_encrypt", "prl_decrypt", "cmd_prepare", "cmd_parse", "logger"
+};
+
+//lint --e{818} suppress "context is not used"
+static void optiga_host_cost_callback(void * context, optiga_lib_status_t return_status)
+{
+    optiga_host_cost_status = return_status;
+}
+
+/*
+* Waits for the completion of an operation
+*/
+static optiga_lib_status_t optiga_host_cost_wait(optiga_lib_status_t return_status)
+{
+    uint32_t start_time = pal_os_timer_get_time_in_microseconds();
+
+    if (OPTIGA_LIB_SUCCESS == return_status)
+    {
+        while (OPTIGA_LIB_BUSY == optiga_host_cost_status)
+        {
+            if ((pal_os_timer_get_time_in_microseconds() - start_time) > OPTIGA_HOST_COST_TIMEOUT_US)
+            {
+                break;
+            }
+        }
+        return_status = optiga_host_cost_status;
+    }
+    return (return_status);
+}
+
+static optiga_lib_status_t optiga_host_cost_read_data(uint16_t length)
+{
+    optiga_host_cost_length = length;
+    return (optiga_util_read_data(p_host_cost_util, OPTIGA_HOST_COST_DATA_OBJECT, 0, optiga_host_cost_buffer,
+                                  &optiga_host_cost_length));
+}
+
+#ifdef OPTIGA_CRYPT_HASH_ENABLED
+static optiga_lib_status_t optiga_host_cost_hash(uint16_t length)
+{
+    hash_data_from_host_t hash_data;
+
+    // The data of the host is copied to the APDU, when the operation is started
+    hash_data.buffer = optiga_host_cost_buffer;
+    hash_data.length = length;
+    return (optiga_crypt_hash(p_host_cost_crypt, OPTIGA_HASH_TYPE_SHA_256, OPTIGA_CRYPT_HOST_DATA, &hash_data,
+                              &optiga_host_cost_buffer[OPTIGA_HOST_COST_BUFFER_SIZE - 32]));
+}
+#endif
+
+#ifdef OPTIGA_CRYPT_RANDOM_ENABLED
+static optiga_lib_status_t optiga_host_cost_random(uint16_t length)
+{
+    return (optiga_crypt_random(p_host_cost_crypt, OPTIGA_RNG_TYPE_TRNG, optiga_host_cost_buffer, length));
+}
+#endif
+
+/*
+* Cases of the benchmark, the read cases are repeated with the shielded connection to cover the presentation layer
+*/
+static const optiga_host_cost_case_t optiga_host_cost_cases[] =
+{
+    {"read_data_1", optiga_host_cost_read_data, 1},
+    {"read_data_256", optiga_host_cost_read_data, 256},
+    {"read_data_1500", optiga_host_cost_read_data, OPTIGA_HOST_COST_BUFFER_SIZE},
+#ifdef OPTIGA_CRYPT_HASH_ENABLED
+    {"hash_sha256_64", optiga_host_cost_hash, 64},
+#endif
+#ifdef OPTIGA_CRYPT_RANDOM_ENABLED
+    {"random_trng_32", optiga_host_cost_random, 32},
+#endif
+};
+
+/*
+* Sets the protection level of the next operation, since the instances reset it after each operation
+*/
+//lint --e{715} suppress "protection_level is not required without the shielded connection"
+static void optiga_host_cost_set_protection(uint8_t protection_level)
+{
+    OPTIGA_CRYPT_SET_COMMS_PROTOCOL_VERSION(p_host_cost_crypt, OPTIGA_COMMS_PROTOCOL_VERSION_PRE_SHARED_SECRET);
+    OPTIGA_CRYPT_SET_COMMS_PROTECTION_LEVEL(p_host_cost_crypt, protection_level);
+    OPTIGA_UTIL_SET_COMMS_PROTOCOL_VERSION(p_host_cost_util, OPTIGA_COMMS_PROTOCOL_VERSION_PRE_SHARED_SECRET);
+    OPTIGA_UTIL_SET_COMMS_PROTECTION_LEVEL(p_host_cost_util, protection_level);
+}
+
+/*
+* Prints the cost of the profiling points of a case as one line of JSON each, e.g.
+* {"case":"read_data_256","protection":0,"failures":0,"point":"dl_crc","calls":96,"bytes":3072,
+*  "cycles_per_call":2210,"cycles_per_byte":69.06,"min":1890,"max":4012}
+*/
+static void optiga_host_cost_report(const optiga_host_cost_case_t * p_case, uint8_t protection_level,
+                                    uint16_t failures)
+{
+    char_t report[240];
+    const optiga_lib_profile_stats_t * p_stats;
+    uint32_t per_call;
+    uint32_t per_byte_x100;
+    uint8_t point;
+
+    // The stats are taken before printing, the report itself passes through the logger
+    optiga_lib_profile_get(optiga_host_cost_stats);
+    for (point = 0; point < OPTIGA_LIB_PROFILE_POINT_COUNT; point++)
+    {
+        p_stats = &optiga_host_cost_stats[point];
+        if (0 == p_stats->calls)
+        {
+            continue;
+        }
+        per_call = (uint32_t)(p_stats->cycles / p_stats->calls);
+        per_byte_x100 = (0 == p_stats->bytes) ? 0 : (uint32_t)((p_stats->cycles * 100U) / p_stats->bytes);
+        sprintf(report, "{\"case\":\"%s\",\"protection\":%u,\"failures\":%u,\"point\":\"%s\",\"calls\":%lu,"
+                "\"bytes\":%lu,\"cycles_per_call\":%lu,\"cycles_per_byte\":%lu.%02lu,\"min\":%lu,\"max\":%lu}",
+                p_case->p_name, protection_level, failures, optiga_host_cost_point_names[point],
+                (unsigned long)p_stats->calls, (unsigned long)p_stats->bytes, (unsigned long)per_call,
+                (unsigned long)(per_byte_x100 / 100U), (unsigned long)(per_byte_x100 % 100U),
+                (unsigned long)p_stats->min_cycles, (unsigned long)p_stats->max_cycles);
+        optiga_lib_print_message(report, OPTIGA_HOST_COST, OPTIGA_EXAMPLE_COLOR);
+    }
+}
+
+/**
+ * The below example measures the host CPU cost of the comms and command layer code paths.
+ *
+ * \details
+ * Each case executes #OPTIGA_HOST_COST_ITERATIONS operations one after the other, without and with the shielded
+ * connection (if enabled). For each profiling point of #optiga_lib_profile_point_t, which is passed by the case,
+ * one line of JSON is printed with the calls, the bytes, the cycles per call and per byte and the minimum and
+ * maximum cycles of a call.
+ * - The cycles are counted by #pal_os_timer_get_cycle_count, i.e. the DWT cycle counter on XMC4800 and the
+ *   nanoseconds of the monotonic clock on Linux.
+ * - To measure the host cost without the OPTIGA waiting time, record the I2C transfers once on Linux
+ *   (PAL_I2C_RECORD, #pal_linux_i2c_record_start) and rerun the benchmark with the replay PAL (PAL_I2C_REPLAY,
+ *   #pal_linux_i2c_replay_start with time scale 0).
+ * - The data object 0xF1E0 must be written before, e.g. by "optiga --benchmark".
+ *
+ */
+void example_host_cost_benchmark(void)
+{
+    const uint8_t protection_levels[] =
+    {
+        OPTIGA_COMMS_NO_PROTECTION,
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+        OPTIGA_COMMS_FULL_PROTECTION
+#endif
+    };
+    optiga_lib_status_t return_status = !OPTIGA_LIB_SUCCESS;
+    uint16_t index;
+    uint16_t iteration;
+    uint16_t failures;
+    uint8_t level;
+
+#ifndef OPTIGA_INIT_DEINIT_DONE_EXCLUSIVELY
+    example_optiga_init();
+#endif //OPTIGA_INIT_DEINIT_DONE_EXCLUSIVELY
+
+    OPTIGA_EXAMPLE_LOG_MESSAGE(__FUNCTION__);
+
+    do
+    {
+        p_host_cost_util = optiga_util_create(0, optiga_host_cost_callback, NULL);
+        p_host_cost_crypt = optiga_crypt_create(0, optiga_host_cost_callback, NULL);
+        if ((NULL == p_host_cost_util) || (NULL == p_host_cost_crypt))
+        {
+            break;
+        }
+        return_status = OPTIGA_LIB_SUCCESS;
+
+        for (level = 0; level < sizeof(protection_levels); level++)
+        {
+            for (index = 0; index < (sizeof(optiga_host_cost_cases) / sizeof(optiga_host_cost_cases[0])); index++)
+            {
+                failures = 0;
+                optiga_lib_profile_reset();
+                for (iteration = 0; iteration < OPTIGA_HOST_COST_ITERATIONS; iteration++)
+                {
+                    optiga_host_cost_set_protection(protection_levels[level]);
+                    optiga_host_cost_status = OPTIGA_LIB_BUSY;
+                    if (OPTIGA_LIB_SUCCESS != optiga_host_cost_wait(optiga_host_cost_cases[index].start(
+                                                                    optiga_host_cost_cases[index].parameter)))
+                    {
+                        failures++;
+                    }
+                }
+                optiga_host_cost_report(&optiga_host_cost_cases[index], protection_levels[level], failures);
+            }
+        }
+    } while (FALSE);
+    OPTIGA_EXAMPLE_LOG_STATUS(return_status);
+
+    if (NULL != p_host_cost_crypt)
+    {
+        (void)optiga_crypt_destroy(p_host_cost_crypt);
+        p_host_cost_crypt = NULL;
+    }
+    if (NULL != p_host_cost_util)
+    {
+        (void)optiga_util_destroy(p_host_cost_util);
+        p_host_cost_util = NULL;
+    }
+
+#ifndef OPTIGA_INIT_DEINIT_DONE_EXCLUSIVELY
+    example_optiga_deinit();
+#endif //OPTIGA_INIT_DEINIT_DONE_EXCLUSIVELY
+}
+
+#endif //OPTIGA_LIB_PROFILE_ENABLED
+
+/**
+* @}
+*/
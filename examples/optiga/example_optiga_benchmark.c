@@ -0,0 +1,1002 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file example_optiga_benchmark.c
+*
+* \brief   This file provides the throughput and latency benchmark of the crypt and util operations.
+*
+* \ingroup grOptigaExamples
+*
+* @{
+*/
+
+#include "optiga/optiga_crypt.h"
+#include "optiga/optiga_util.h"
+#include "optiga/optiga_lib_version.h"
+#include "optiga/pal/pal_os_timer.h"
+#include "optiga_example.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifndef OPTIGA_INIT_DEINIT_DONE_EXCLUSIVELY
+extern void example_optiga_init(void);
+extern void example_optiga_deinit(void);
+#endif
+
+/// Number of operations of each case
+#ifndef OPTIGA_BENCHMARK_ITERATIONS
+#define OPTIGA_BENCHMARK_ITERATIONS         (32U)
+#endif
+/// Number of operations, which are in progress at the same time (one util and one crypt instance each)
+#ifndef OPTIGA_BENCHMARK_CONCURRENCY
+#define OPTIGA_BENCHMARK_CONCURRENCY        (2U)
+#endif
+/// Maximum number of operations of a case run by a script, the latencies of all of them are kept for the report
+#ifndef OPTIGA_BENCHMARK_MAX_ITERATIONS
+#define OPTIGA_BENCHMARK_MAX_ITERATIONS     (256U)
+#endif
+/// Maximum concurrency of a case run by a script, the instances of all slots count on #OPTIGA_CMD_MAX_REGISTRATIONS
+#ifndef OPTIGA_BENCHMARK_MAX_CONCURRENCY
+#define OPTIGA_BENCHMARK_MAX_CONCURRENCY    (3U)
+#endif
+#if (OPTIGA_BENCHMARK_ITERATIONS > OPTIGA_BENCHMARK_MAX_ITERATIONS) || \
+    (OPTIGA_BENCHMARK_CONCURRENCY > OPTIGA_BENCHMARK_MAX_CONCURRENCY)
+#error "OPTIGA_BENCHMARK_ITERATIONS and OPTIGA_BENCHMARK_CONCURRENCY must not exceed the maximum of a script"
+#endif
+/// Time after which an operation in progress is considered as lost and the benchmark is stopped
+#define OPTIGA_BENCHMARK_TIMEOUT_US         (10000000U)
+/// Size of the data objects of type 2, limits the size of the read and write cases
+#define OPTIGA_BENCHMARK_BUFFER_SIZE        (1500U)
+/// Data object used by the read and write cases
+#define OPTIGA_BENCHMARK_DATA_OBJECT        (0xF1E0U)
+/// Shared secret used by the HMAC and HKDF cases, provisioned with "optiga --hmac"
+#define OPTIGA_BENCHMARK_SHARED_SECRET      (0xF1D0U)
+
+#define OPTIGA_BENCHMARK                    "[optiga benchmark] : "
+
+/** \brief Operation in progress, with the instances and the buffers it owns */
+typedef struct optiga_benchmark_slot
+{
+    /// Instances used by the operations of the slot
+    optiga_crypt_t * p_crypt;
+    optiga_util_t * p_util;
+    /// Status of the operation, set by the callback
+    volatile optiga_lib_status_t status;
+    /// Start time of the operation
+    uint32_t start_time;
+    /// Indicates an operation is in progress
+    uint8_t active;
+    /// Key of the operations, which generate a key
+    optiga_key_id_t key_id;
+    /// Data of the hash operation
+    hash_data_from_host_t hash_data;
+    /// Lengths of the output buffer, in and out
+    uint16_t length;
+    uint32_t length_32;
+    /// Output of the operation, respectively input of the write operation
+    uint8_t buffer[OPTIGA_BENCHMARK_BUFFER_SIZE];
+}optiga_benchmark_slot_t;
+
+/// Starts an operation of a case with the parameter of the case on the slot
+typedef optiga_lib_status_t (*optiga_benchmark_start_t)(optiga_benchmark_slot_t * p_slot, uint16_t parameter);
+
+/** \brief Benchmark case */
+typedef struct optiga_benchmark_case
+{
+    /// Name of the case in the report
+    const char_t * p_name;
+    /// Prepares the keys and reference data of the case and the following cases, can be NULL
+    optiga_benchmark_start_t prepare;
+    /// Starts one measured operation
+    optiga_benchmark_start_t start;
+    /// Parameter of the case, e.g. curve, key type or length
+    uint16_t parameter;
+}optiga_benchmark_case_t;
+
+static optiga_benchmark_slot_t optiga_benchmark_slots[OPTIGA_BENCHMARK_MAX_CONCURRENCY];
+static uint32_t optiga_benchmark_latencies[OPTIGA_BENCHMARK_MAX_ITERATIONS];
+static char_t optiga_benchmark_report_buffer[768];
+// Prepare function and parameter of the keys and reference data in place, the cases sharing them prepare once
+static optiga_benchmark_start_t optiga_benchmark_prepared;
+static uint16_t optiga_benchmark_prepared_parameter;
+
+// Reference data of the prepare functions, used by the following cases
+static uint8_t optiga_benchmark_public_key[0x140];
+static uint8_t optiga_benchmark_signature[0x110];
+static uint16_t optiga_benchmark_signature_length;
+static uint8_t optiga_benchmark_encrypted[0x110];
+static uint16_t optiga_benchmark_encrypted_length;
+static public_key_from_host_t optiga_benchmark_host_key = {optiga_benchmark_public_key, 0, 0};
+
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+static optiga_lib_statistics_t optiga_benchmark_statistics;
+#endif
+
+// Input of the operations (digest, message, plain data, salt and info)
+static const uint8_t optiga_benchmark_data[] =
+{
+    0x61, 0xC7, 0xDE, 0xF9, 0x0F, 0xD5, 0xCD, 0x7A, 0x8B, 0x7A, 0x36, 0x41, 0x04, 0xE0, 0x0D, 0x82,
+    0x38, 0x46, 0xBF, 0xB7, 0x70, 0xEE, 0xBF, 0x8F, 0x40, 0x25, 0x2E, 0x0A, 0x21, 0x42, 0xAF, 0x9C,
+    0x2B, 0x88, 0x4A, 0x27, 0x1D, 0x35, 0xEE, 0x51, 0x3E, 0x83, 0xF0, 0x7C, 0xC2, 0x6A, 0x14, 0x9B,
+    0x75, 0x02, 0xD9, 0x46, 0xB1, 0x23, 0xA8, 0x50, 0x0E, 0xCB, 0x67, 0x91, 0xFD, 0x3C, 0x58, 0xE4
+};
+
+// Initialization vector of the CBC cases
+static const uint8_t optiga_benchmark_iv[] =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+};
+
+//lint --e{818} suppress "context is the slot of the operation"
+static void optiga_benchmark_callback(void * context, optiga_lib_status_t return_status)
+{
+    ((optiga_benchmark_slot_t *)context)->status = return_status;
+}
+
+/*
+* Waits for the completion of an operation of the prepare functions
+*/
+static optiga_lib_status_t optiga_benchmark_wait(optiga_benchmark_slot_t * p_slot, optiga_lib_status_t return_status)
+{
+    uint32_t start_time = pal_os_timer_get_time_in_microseconds();
+
+    if (OPTIGA_LIB_SUCCESS == return_status)
+    {
+        while (OPTIGA_LIB_BUSY == p_slot->status)
+        {
+            if ((pal_os_timer_get_time_in_microseconds() - start_time) > OPTIGA_BENCHMARK_TIMEOUT_US)
+            {
+                break;
+            }
+        }
+        return_status = p_slot->status;
+    }
+    return (return_status);
+}
+
+#if defined (OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED) && defined (OPTIGA_CRYPT_ECDSA_SIGN_ENABLED) && \
+    defined (OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED)
+// Digest length matching the size of the curve
+static uint8_t optiga_benchmark_digest_length(uint16_t curve)
+{
+    uint8_t digest_length = 32;
+
+    if (OPTIGA_ECC_CURVE_NIST_P_384 == curve)
+    {
+        digest_length = 48;
+    }
+#ifdef OPTIGA_CRYPT_ECC_NIST_P_521_ENABLED
+    else if (OPTIGA_ECC_CURVE_NIST_P_521 == curve)
+    {
+        digest_length = 64;
+    }
+#endif
+#ifdef OPTIGA_CRYPT_ECC_BRAINPOOL_P_R1_ENABLED
+    else if (OPTIGA_ECC_CURVE_BRAIN_POOL_P_384R1 == curve)
+    {
+        digest_length = 48;
+    }
+    else if (OPTIGA_ECC_CURVE_BRAIN_POOL_P_512R1 == curve)
+    {
+        digest_length = 64;
+    }
+#endif
+    return (digest_length);
+}
+
+/*
+* Generates the key pair of the curve in E0F1 and the reference signature
+*/
+static optiga_lib_status_t optiga_benchmark_ecc_prepare(optiga_benchmark_slot_t * p_slot, uint16_t curve)
+{
+    optiga_lib_status_t return_status;
+
+    do
+    {
+        p_slot->key_id = OPTIGA_KEY_ID_E0F1;
+        optiga_benchmark_host_key.length = sizeof(optiga_benchmark_public_key);
+        optiga_benchmark_host_key.key_type = (uint8_t)curve;
+        p_slot->status = OPTIGA_LIB_BUSY;
+        return_status = optiga_benchmark_wait(p_slot,
+                                              optiga_crypt_ecc_generate_keypair(p_slot->p_crypt,
+                                                                                (optiga_ecc_curve_t)curve,
+                                                                                (uint8_t)(OPTIGA_KEY_USAGE_SIGN |
+                                                                                OPTIGA_KEY_USAGE_KEY_AGREEMENT),
+                                                                                FALSE,
+                                                                                &p_slot->key_id,
+                                                                                optiga_benchmark_public_key,
+                                                                                &optiga_benchmark_host_key.length));
+        if (OPTIGA_LIB_SUCCESS != return_status)
+        {
+            break;
+        }
+        optiga_benchmark_signature_length = sizeof(optiga_benchmark_signature);
+        p_slot->status = OPTIGA_LIB_BUSY;
+        return_status = optiga_benchmark_wait(p_slot,
+                                              optiga_crypt_ecdsa_sign(p_slot->p_crypt,
+                                                                      optiga_benchmark_data,
+                                                                      optiga_benchmark_digest_length(curve),
+                                                                      OPTIGA_KEY_ID_E0F1,
+                                                                      optiga_benchmark_signature,
+                                                                      &optiga_benchmark_signature_length));
+    } while (FALSE);
+    return (return_status);
+}
+
+static optiga_lib_status_t optiga_benchmark_ecc_generate_keypair(optiga_benchmark_slot_t * p_slot, uint16_t curve)
+{
+    p_slot->key_id = OPTIGA_KEY_ID_SESSION_BASED;
+    p_slot->length = sizeof(p_slot->buffer);
+    return (optiga_crypt_ecc_generate_keypair(p_slot->p_crypt, (optiga_ecc_curve_t)curve,
+                                              (uint8_t)OPTIGA_KEY_USAGE_KEY_AGREEMENT, FALSE, &p_slot->key_id,
+                                              p_slot->buffer, &p_slot->length));
+}
+
+static optiga_lib_status_t optiga_benchmark_ecdsa_sign(optiga_benchmark_slot_t * p_slot, uint16_t curve)
+{
+    p_slot->length = sizeof(p_slot->buffer);
+    return (optiga_crypt_ecdsa_sign(p_slot->p_crypt, optiga_benchmark_data, optiga_benchmark_digest_length(curve),
+                                    OPTIGA_KEY_ID_E0F1, p_slot->buffer, &p_slot->length));
+}
+
+static optiga_lib_status_t optiga_benchmark_ecdsa_verify(optiga_benchmark_slot_t * p_slot, uint16_t curve)
+{
+    return (optiga_crypt_ecdsa_verify(p_slot->p_crypt, optiga_benchmark_data, optiga_benchmark_digest_length(curve),
+                                      optiga_benchmark_signature, optiga_benchmark_signature_length,
+                                      OPTIGA_CRYPT_HOST_DATA, &optiga_benchmark_host_key));
+}
+
+#ifdef OPTIGA_CRYPT_ECDH_ENABLED
+//lint --e{715} suppress "The curve is given by the public key"
+static optiga_lib_status_t optiga_benchmark_ecdh(optiga_benchmark_slot_t * p_slot, uint16_t curve)
+{
+    // The own public key serves as the public key of the peer
+    return (optiga_crypt_ecdh(p_slot->p_crypt, OPTIGA_KEY_ID_E0F1, &optiga_benchmark_host_key, TRUE, p_slot->buffer));
+}
+#endif
+#endif
+
+#if defined (OPTIGA_CRYPT_RSA_GENERATE_KEYPAIR_ENABLED) && defined (OPTIGA_CRYPT_RSA_SIGN_ENABLED) && \
+    defined (OPTIGA_CRYPT_RSA_VERIFY_ENABLED) && defined (OPTIGA_CRYPT_RSA_ENCRYPT_ENABLED) && \
+    defined (OPTIGA_CRYPT_RSA_DECRYPT_ENABLED)
+/*
+* Generates the key pair of the key type in E0FC, the reference signature and the reference encrypted message
+*/
+static optiga_lib_status_t optiga_benchmark_rsa_prepare(optiga_benchmark_slot_t * p_slot, uint16_t key_type)
+{
+    optiga_lib_status_t return_status;
+
+    do
+    {
+        p_slot->key_id = OPTIGA_KEY_ID_E0FC;
+        optiga_benchmark_host_key.length = sizeof(optiga_benchmark_public_key);
+        optiga_benchmark_host_key.key_type = (uint8_t)key_type;
+        p_slot->status = OPTIGA_LIB_BUSY;
+        return_status = optiga_benchmark_wait(p_slot,
+                                              optiga_crypt_rsa_generate_keypair(p_slot->p_crypt,
+                                                                                (optiga_rsa_key_type_t)key_type,
+                                                                                (uint8_t)(OPTIGA_KEY_USAGE_SIGN |
+                                                                                OPTIGA_KEY_USAGE_ENCRYPTION),
+                                                                                FALSE,
+                                                                                &p_slot->key_id,
+                                                                                optiga_benchmark_public_key,
+                                                                                &optiga_benchmark_host_key.length));
+        if (OPTIGA_LIB_SUCCESS != return_status)
+        {
+            break;
+        }
+        optiga_benchmark_signature_length = sizeof(optiga_benchmark_signature);
+        p_slot->status = OPTIGA_LIB_BUSY;
+        return_status = optiga_benchmark_wait(p_slot,
+                                              optiga_crypt_rsa_sign(p_slot->p_crypt,
+                                                                    OPTIGA_RSASSA_PKCS1_V15_SHA256,
+                                                                    optiga_benchmark_data,
+                                                                    32,
+                                                                    OPTIGA_KEY_ID_E0FC,
+                                                                    optiga_benchmark_signature,
+                                                                    &optiga_benchmark_signature_length,
+                                                                    0));
+        if (OPTIGA_LIB_SUCCESS != return_status)
+        {
+            break;
+        }
+        optiga_benchmark_encrypted_length = sizeof(optiga_benchmark_encrypted);
+        p_slot->status = OPTIGA_LIB_BUSY;
+        return_status = optiga_benchmark_wait(p_slot,
+                                              optiga_crypt_rsa_encrypt_message(p_slot->p_crypt,
+                                                                               OPTIGA_RSAES_PKCS1_V15,
+                                                                               optiga_benchmark_data,
+                                                                               32,
+                                                                               NULL,
+                                                                               0,
+                                                                               OPTIGA_CRYPT_HOST_DATA,
+                                                                               &optiga_benchmark_host_key,
+                                                                               optiga_benchmark_encrypted,
+                                                                               &optiga_benchmark_encrypted_length));
+    } while (FALSE);
+    return (return_status);
+}
+
+//lint --e{715} suppress "The key type is given by the key in E0FC"
+static optiga_lib_status_t optiga_benchmark_rsa_sign(optiga_benchmark_slot_t * p_slot, uint16_t key_type)
+{
+    p_slot->length = sizeof(p_slot->buffer);
+    return (optiga_crypt_rsa_sign(p_slot->p_crypt, OPTIGA_RSASSA_PKCS1_V15_SHA256, optiga_benchmark_data, 32,
+                                  OPTIGA_KEY_ID_E0FC, p_slot->buffer, &p_slot->length, 0));
+}
+
+//lint --e{715} suppress "The key type is given by the public key"
+static optiga_lib_status_t optiga_benchmark_rsa_verify(optiga_benchmark_slot_t * p_slot, uint16_t key_type)
+{
+    return (optiga_crypt_rsa_verify(p_slot->p_crypt, OPTIGA_RSASSA_PKCS1_V15_SHA256, optiga_benchmark_data, 32,
+                                    optiga_benchmark_signature, optiga_benchmark_signature_length,
+                                    OPTIGA_CRYPT_HOST_DATA, &optiga_benchmark_host_key, 0));
+}
+
+//lint --e{715} suppress "The key type is given by the public key"
+static optiga_lib_status_t optiga_benchmark_rsa_encrypt(optiga_benchmark_slot_t * p_slot, uint16_t key_type)
+{
+    p_slot->length = sizeof(p_slot->buffer);
+    return (optiga_crypt_rsa_encrypt_message(p_slot->p_crypt, OPTIGA_RSAES_PKCS1_V15, optiga_benchmark_data, 32,
+                                             NULL, 0, OPTIGA_CRYPT_HOST_DATA, &optiga_benchmark_host_key,
+                                             p_slot->buffer, &p_slot->length));
+}
+
+//lint --e{715} suppress "The key type is given by the key in E0FC"
+static optiga_lib_status_t optiga_benchmark_rsa_decrypt(optiga_benchmark_slot_t * p_slot, uint16_t key_type)
+{
+    p_slot->length = sizeof(p_slot->buffer);
+    return (optiga_crypt_rsa_decrypt_and_export(p_slot->p_crypt, OPTIGA_RSAES_PKCS1_V15, optiga_benchmark_encrypted,
+                                                optiga_benchmark_encrypted_length, NULL, 0, OPTIGA_KEY_ID_E0FC,
+                                                p_slot->buffer, &p_slot->length));
+}
+#endif
+
+#ifdef OPTIGA_CRYPT_HMAC_ENABLED
+static optiga_lib_status_t optiga_benchmark_hmac(optiga_benchmark_slot_t * p_slot, uint16_t length)
+{
+    p_slot->length_32 = sizeof(p_slot->buffer);
+    return (optiga_crypt_hmac(p_slot->p_crypt, OPTIGA_HMAC_SHA_256, OPTIGA_BENCHMARK_SHARED_SECRET,
+                              optiga_benchmark_data, length, p_slot->buffer, &p_slot->length_32));
+}
+#endif
+
+#ifdef OPTIGA_CRYPT_HKDF_ENABLED
+static optiga_lib_status_t optiga_benchmark_hkdf(optiga_benchmark_slot_t * p_slot, uint16_t length)
+{
+    return (optiga_crypt_hkdf(p_slot->p_crypt, OPTIGA_HKDF_SHA_256, OPTIGA_BENCHMARK_SHARED_SECRET,
+                              optiga_benchmark_data, 16, &optiga_benchmark_data[16], 16, length, TRUE,
+                              p_slot->buffer));
+}
+#endif
+
+#if defined (OPTIGA_CRYPT_SYM_GENERATE_KEY_ENABLED) && defined (OPTIGA_CRYPT_SYM_ENCRYPT_ENABLED) && \
+    defined (OPTIGA_CRYPT_SYM_DECRYPT_ENABLED)
+/*
+* Generates the AES-128 key in the secret based key object (E200)
+*/
+//lint --e{715} suppress "The key type is fixed"
+static optiga_lib_status_t optiga_benchmark_aes_prepare(optiga_benchmark_slot_t * p_slot, uint16_t length)
+{
+    p_slot->key_id = OPTIGA_KEY_ID_SECRET_BASED;
+    p_slot->status = OPTIGA_LIB_BUSY;
+    return (optiga_benchmark_wait(p_slot,
+                                  optiga_crypt_symmetric_generate_key(p_slot->p_crypt,
+                                                                      OPTIGA_SYMMETRIC_AES_128,
+                                                                      (uint8_t)OPTIGA_KEY_USAGE_ENCRYPTION,
+                                                                      FALSE,
+                                                                      &p_slot->key_id)));
+}
+
+static optiga_lib_status_t optiga_benchmark_aes_ecb_encrypt(optiga_benchmark_slot_t * p_slot, uint16_t length)
+{
+    p_slot->length_32 = sizeof(p_slot->buffer);
+    return (optiga_crypt_symmetric_encrypt_ecb(p_slot->p_crypt, OPTIGA_KEY_ID_SECRET_BASED, optiga_benchmark_data,
+                                               length, p_slot->buffer, &p_slot->length_32));
+}
+
+// The decryption of arbitrary data of a multiple of the block size is valid without padding
+static optiga_lib_status_t optiga_benchmark_aes_ecb_decrypt(optiga_benchmark_slot_t * p_slot, uint16_t length)
+{
+    p_slot->length_32 = sizeof(p_slot->buffer);
+    return (optiga_crypt_symmetric_decrypt_ecb(p_slot->p_crypt, OPTIGA_KEY_ID_SECRET_BASED, optiga_benchmark_data,
+                                               length, p_slot->buffer, &p_slot->length_32));
+}
+
+static optiga_lib_status_t optiga_benchmark_aes_cbc_encrypt(optiga_benchmark_slot_t * p_slot, uint16_t length)
+{
+    p_slot->length_32 = sizeof(p_slot->buffer);
+    return (optiga_crypt_symmetric_encrypt(p_slot->p_crypt, OPTIGA_SYMMETRIC_CBC, OPTIGA_KEY_ID_SECRET_BASED,
+                                           optiga_benchmark_data, length, optiga_benchmark_iv,
+                                           sizeof(optiga_benchmark_iv), NULL, 0, p_slot->buffer,
+                                           &p_slot->length_32));
+}
+
+static optiga_lib_status_t optiga_benchmark_aes_cbc_decrypt(optiga_benchmark_slot_t * p_slot, uint16_t length)
+{
+    p_slot->length_32 = sizeof(p_slot->buffer);
+    return (optiga_crypt_symmetric_decrypt(p_slot->p_crypt, OPTIGA_SYMMETRIC_CBC, OPTIGA_KEY_ID_SECRET_BASED,
+                                           optiga_benchmark_data, length, optiga_benchmark_iv,
+                                           sizeof(optiga_benchmark_iv), NULL, 0, p_slot->buffer,
+                                           &p_slot->length_32));
+}
+
+static optiga_lib_status_t optiga_benchmark_aes_cbc_mac(optiga_benchmark_slot_t * p_slot, uint16_t length)
+{
+    p_slot->length_32 = sizeof(p_slot->buffer);
+    return (optiga_crypt_symmetric_encrypt(p_slot->p_crypt, OPTIGA_SYMMETRIC_CBC_MAC, OPTIGA_KEY_ID_SECRET_BASED,
+                                           optiga_benchmark_data, length, NULL, 0, NULL, 0, p_slot->buffer,
+                                           &p_slot->length_32));
+}
+#endif
+
+#ifdef OPTIGA_CRYPT_RANDOM_ENABLED
+static optiga_lib_status_t optiga_benchmark_random(optiga_benchmark_slot_t * p_slot, uint16_t length)
+{
+    return (optiga_crypt_random(p_slot->p_crypt, OPTIGA_RNG_TYPE_TRNG, p_slot->buffer, length));
+}
+#endif
+
+#ifdef OPTIGA_CRYPT_HASH_ENABLED
+static optiga_lib_status_t optiga_benchmark_hash(optiga_benchmark_slot_t * p_slot, uint16_t length)
+{
+    p_slot->hash_data.buffer = optiga_benchmark_data;
+    p_slot->hash_data.length = length;
+    return (optiga_crypt_hash(p_slot->p_crypt, OPTIGA_HASH_TYPE_SHA_256, OPTIGA_CRYPT_HOST_DATA,
+                              &p_slot->hash_data, p_slot->buffer));
+}
+#endif
+
+/*
+* Writes the complete data object, which is read by the read cases
+*/
+//lint --e{715} suppress "The complete data object is written"
+static optiga_lib_status_t optiga_benchmark_read_prepare(optiga_benchmark_slot_t * p_slot, uint16_t length)
+{
+    p_slot->status = OPTIGA_LIB_BUSY;
+    return (optiga_benchmark_wait(p_slot,
+                                  optiga_util_write_data(p_slot->p_util,
+                                                         OPTIGA_BENCHMARK_DATA_OBJECT,
+                                                         OPTIGA_UTIL_ERASE_AND_WRITE,
+                                                         0,
+                                                         p_slot->buffer,
+                                                         sizeof(p_slot->buffer))));
+}
+
+static optiga_lib_status_t optiga_benchmark_read_data(optiga_benchmark_slot_t * p_slot, uint16_t length)
+{
+    p_slot->length = length;
+    return (optiga_util_read_data(p_slot->p_util, OPTIGA_BENCHMARK_DATA_OBJECT, 0, p_slot->buffer, &p_slot->length));
+}
+
+static optiga_lib_status_t optiga_benchmark_write_data(optiga_benchmark_slot_t * p_slot, uint16_t length)
+{
+    return (optiga_util_write_data(p_slot->p_util, OPTIGA_BENCHMARK_DATA_OBJECT, OPTIGA_UTIL_ERASE_AND_WRITE, 0,
+                                   p_slot->buffer, length));
+}
+
+/*
+* Cases of the benchmark, the prepare function provides the keys and the reference data of the case.
+* It runs once for consecutive cases of the same prepare function and parameter.
+*/
+static const optiga_benchmark_case_t optiga_benchmark_cases[] =
+{
+#if defined (OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED) && defined (OPTIGA_CRYPT_ECDSA_SIGN_ENABLED) && \
+    defined (OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED)
+    {"ecc_generate_keypair_p256", NULL, optiga_benchmark_ecc_generate_keypair, OPTIGA_ECC_CURVE_NIST_P_256},
+    {"ecdsa_sign_p256", optiga_benchmark_ecc_prepare, optiga_benchmark_ecdsa_sign, OPTIGA_ECC_CURVE_NIST_P_256},
+    {"ecdsa_verify_p256", optiga_benchmark_ecc_prepare, optiga_benchmark_ecdsa_verify, OPTIGA_ECC_CURVE_NIST_P_256},
+#ifdef OPTIGA_CRYPT_ECDH_ENABLED
+    {"ecdh_p256", optiga_benchmark_ecc_prepare, optiga_benchmark_ecdh, OPTIGA_ECC_CURVE_NIST_P_256},
+#endif
+    {"ecdsa_sign_p384", optiga_benchmark_ecc_prepare, optiga_benchmark_ecdsa_sign, OPTIGA_ECC_CURVE_NIST_P_384},
+    {"ecdsa_verify_p384", optiga_benchmark_ecc_prepare, optiga_benchmark_ecdsa_verify, OPTIGA_ECC_CURVE_NIST_P_384},
+#ifdef OPTIGA_CRYPT_ECDH_ENABLED
+    {"ecdh_p384", optiga_benchmark_ecc_prepare, optiga_benchmark_ecdh, OPTIGA_ECC_CURVE_NIST_P_384},
+#endif
+#ifdef OPTIGA_CRYPT_ECC_NIST_P_521_ENABLED
+    {"ecdsa_sign_p521", optiga_benchmark_ecc_prepare, optiga_benchmark_ecdsa_sign, OPTIGA_ECC_CURVE_NIST_P_521},
+    {"ecdsa_verify_p521", optiga_benchmark_ecc_prepare, optiga_benchmark_ecdsa_verify, OPTIGA_ECC_CURVE_NIST_P_521},
+#endif
+#ifdef OPTIGA_CRYPT_ECC_BRAINPOOL_P_R1_ENABLED
+    {"ecdsa_sign_bp256r1", optiga_benchmark_ecc_prepare, optiga_benchmark_ecdsa_sign,
+     OPTIGA_ECC_CURVE_BRAIN_POOL_P_256R1},
+    {"ecdsa_verify_bp256r1", optiga_benchmark_ecc_prepare, optiga_benchmark_ecdsa_verify,
+     OPTIGA_ECC_CURVE_BRAIN_POOL_P_256R1},
+    {"ecdsa_sign_bp384r1", optiga_benchmark_ecc_prepare, optiga_benchmark_ecdsa_sign,
+     OPTIGA_ECC_CURVE_BRAIN_POOL_P_384R1},
+    {"ecdsa_verify_bp384r1", optiga_benchmark_ecc_prepare, optiga_benchmark_ecdsa_verify,
+     OPTIGA_ECC_CURVE_BRAIN_POOL_P_384R1},
+    {"ecdsa_sign_bp512r1", optiga_benchmark_ecc_prepare, optiga_benchmark_ecdsa_sign,
+     OPTIGA_ECC_CURVE_BRAIN_POOL_P_512R1},
+    {"ecdsa_verify_bp512r1", optiga_benchmark_ecc_prepare, optiga_benchmark_ecdsa_verify,
+     OPTIGA_ECC_CURVE_BRAIN_POOL_P_512R1},
+#endif
+#endif
+#if defined (OPTIGA_CRYPT_RSA_GENERATE_KEYPAIR_ENABLED) && defined (OPTIGA_CRYPT_RSA_SIGN_ENABLED) && \
+    defined (OPTIGA_CRYPT_RSA_VERIFY_ENABLED) && defined (OPTIGA_CRYPT_RSA_ENCRYPT_ENABLED) && \
+    defined (OPTIGA_CRYPT_RSA_DECRYPT_ENABLED)
+    {"rsa_sign_1024", optiga_benchmark_rsa_prepare, optiga_benchmark_rsa_sign, OPTIGA_RSA_KEY_1024_BIT_EXPONENTIAL},
+    {"rsa_verify_1024", optiga_benchmark_rsa_prepare, optiga_benchmark_rsa_verify,
+     OPTIGA_RSA_KEY_1024_BIT_EXPONENTIAL},
+    {"rsa_encrypt_1024", optiga_benchmark_rsa_prepare, optiga_benchmark_rsa_encrypt,
+     OPTIGA_RSA_KEY_1024_BIT_EXPONENTIAL},
+    {"rsa_decrypt_1024", optiga_benchmark_rsa_prepare, optiga_benchmark_rsa_decrypt,
+     OPTIGA_RSA_KEY_1024_BIT_EXPONENTIAL},
+    {"rsa_sign_2048", optiga_benchmark_rsa_prepare, optiga_benchmark_rsa_sign, OPTIGA_RSA_KEY_2048_BIT_EXPONENTIAL},
+    {"rsa_verify_2048", optiga_benchmark_rsa_prepare, optiga_benchmark_rsa_verify,
+     OPTIGA_RSA_KEY_2048_BIT_EXPONENTIAL},
+    {"rsa_encrypt_2048", optiga_benchmark_rsa_prepare, optiga_benchmark_rsa_encrypt,
+     OPTIGA_RSA_KEY_2048_BIT_EXPONENTIAL},
+    {"rsa_decrypt_2048", optiga_benchmark_rsa_prepare, optiga_benchmark_rsa_decrypt,
+     OPTIGA_RSA_KEY_2048_BIT_EXPONENTIAL},
+#endif
+#ifdef OPTIGA_CRYPT_HMAC_ENABLED
+    {"hmac_sha256_64", NULL, optiga_benchmark_hmac, 64},
+#endif
+#ifdef OPTIGA_CRYPT_HKDF_ENABLED
+    {"hkdf_sha256_32", NULL, optiga_benchmark_hkdf, 32},
+#endif
+#if defined (OPTIGA_CRYPT_SYM_GENERATE_KEY_ENABLED) && defined (OPTIGA_CRYPT_SYM_ENCRYPT_ENABLED) && \
+    defined (OPTIGA_CRYPT_SYM_DECRYPT_ENABLED)
+    {"aes128_ecb_encrypt_64", optiga_benchmark_aes_prepare, optiga_benchmark_aes_ecb_encrypt, 64},
+    {"aes128_ecb_decrypt_64", optiga_benchmark_aes_prepare, optiga_benchmark_aes_ecb_decrypt, 64},
+    {"aes128_cbc_encrypt_64", optiga_benchmark_aes_prepare, optiga_benchmark_aes_cbc_encrypt, 64},
+    {"aes128_cbc_decrypt_64", optiga_benchmark_aes_prepare, optiga_benchmark_aes_cbc_decrypt, 64},
+    {"aes128_cbc_mac_64", optiga_benchmark_aes_prepare, optiga_benchmark_aes_cbc_mac, 64},
+#endif
+#ifdef OPTIGA_CRYPT_RANDOM_ENABLED
+    {"random_trng_32", NULL, optiga_benchmark_random, 32},
+#endif
+#ifdef OPTIGA_CRYPT_HASH_ENABLED
+    {"hash_sha256_64", NULL, optiga_benchmark_hash, 64},
+#endif
+    {"read_data_1", optiga_benchmark_read_prepare, optiga_benchmark_read_data, 1},
+    {"read_data_64", optiga_benchmark_read_prepare, optiga_benchmark_read_data, 64},
+    {"read_data_256", optiga_benchmark_read_prepare, optiga_benchmark_read_data, 256},
+    {"read_data_1024", optiga_benchmark_read_prepare, optiga_benchmark_read_data, 1024},
+    {"read_data_1500", optiga_benchmark_read_prepare, optiga_benchmark_read_data, OPTIGA_BENCHMARK_BUFFER_SIZE},
+    {"write_data_1", NULL, optiga_benchmark_write_data, 1},
+    {"write_data_64", NULL, optiga_benchmark_write_data, 64},
+    {"write_data_256", NULL, optiga_benchmark_write_data, 256},
+    {"write_data_1024", NULL, optiga_benchmark_write_data, 1024},
+    {"write_data_1500", NULL, optiga_benchmark_write_data, OPTIGA_BENCHMARK_BUFFER_SIZE}
+};
+
+/*
+* Sets the protection level of the next operation, since the instances reset it after each operation
+*/
+//lint --e{715} suppress "protection_level is not required without the shielded connection"
+static void optiga_benchmark_set_protection(optiga_benchmark_slot_t * p_slot, uint8_t protection_level)
+{
+    OPTIGA_CRYPT_SET_COMMS_PROTOCOL_VERSION(p_slot->p_crypt, OPTIGA_COMMS_PROTOCOL_VERSION_PRE_SHARED_SECRET);
+    OPTIGA_CRYPT_SET_COMMS_PROTECTION_LEVEL(p_slot->p_crypt, protection_level);
+    OPTIGA_UTIL_SET_COMMS_PROTOCOL_VERSION(p_slot->p_util, OPTIGA_COMMS_PROTOCOL_VERSION_PRE_SHARED_SECRET);
+    OPTIGA_UTIL_SET_COMMS_PROTECTION_LEVEL(p_slot->p_util, protection_level);
+}
+
+// Number of bytes transferred on the I2C bus so far, 0 without the statistics
+static uint32_t optiga_benchmark_bus_bytes(void)
+{
+    uint32_t bus_bytes = 0;
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+    if (OPTIGA_LIB_SUCCESS == optiga_util_get_statistics(optiga_benchmark_slots[0].p_util,
+                                                          &optiga_benchmark_statistics))
+    {
+        bus_bytes = optiga_benchmark_statistics.comms.bus_bytes;
+    }
+#endif
+    return (bus_bytes);
+}
+
+/*
+* Prints the result of a case as one line of JSON, e.g.
+* {"case":"ecdsa_sign_p256","protection":0,"iterations":32,"concurrency":2,"failures":0,"ops_per_s":15.20,
+*  "p50_us":130512,"p99_us":131007,"bus_bytes_per_op":120,"histogram_us":[[131072,32]]}
+* The histogram counts the latencies per power of two, each bucket is given by its lower bound.
+*/
+static void optiga_benchmark_report(const char_t * p_name, uint8_t protection_level, uint16_t iterations,
+                                    uint8_t concurrency, uint16_t count, uint16_t failures, uint32_t elapsed_us,
+                                    uint32_t bus_bytes)
+{
+    char_t * p_report = optiga_benchmark_report_buffer;
+    uint32_t ops_per_s_x100 = 0;
+    uint32_t p50 = 0;
+    uint32_t p99 = 0;
+    uint32_t latency;
+    uint32_t bucket;
+    uint16_t bucket_count;
+    uint16_t index;
+    uint16_t position;
+    int32_t length;
+
+    if (0 != count)
+    {
+        // Insertion sort of the latencies for the percentiles
+        for (index = 1; index < count; index++)
+        {
+            latency = optiga_benchmark_latencies[index];
+            for (position = index; (position > 0) && (optiga_benchmark_latencies[position - 1] > latency); position--)
+            {
+                optiga_benchmark_latencies[position] = optiga_benchmark_latencies[position - 1];
+            }
+            optiga_benchmark_latencies[position] = latency;
+        }
+        p50 = optiga_benchmark_latencies[((count - 1) * 50U) / 100U];
+        p99 = optiga_benchmark_latencies[((count - 1) * 99U) / 100U];
+        ops_per_s_x100 = (0 == elapsed_us) ? 0 : (uint32_t)(((uint64_t)count * 100000000U) / elapsed_us);
+    }
+    length = sprintf(p_report, "{\"case\":\"%s\",\"protection\":%u,\"iterations\":%u,\"concurrency\":%u,"
+                     "\"failures\":%u,\"ops_per_s\":%lu.%02lu,\"p50_us\":%lu,\"p99_us\":%lu,\"bus_bytes_per_op\":%lu,"
+                     "\"histogram_us\":[",
+                     p_name, protection_level, iterations, concurrency, failures,
+                     (unsigned long)(ops_per_s_x100 / 100U), (unsigned long)(ops_per_s_x100 % 100U),
+                     (unsigned long)p50, (unsigned long)p99,
+                     (unsigned long)((0 == iterations) ? 0 : (bus_bytes / iterations)));
+    p_report += length;
+
+    // The sorted latencies of a bucket are consecutive
+    for (index = 0; index < count; index += bucket_count)
+    {
+        bucket = 1;
+        while (bucket <= (optiga_benchmark_latencies[index] >> 1))
+        {
+            bucket <<= 1;
+        }
+        bucket_count = 0;
+        while (((index + bucket_count) < count) &&
+               ((optiga_benchmark_latencies[index + bucket_count] >> 1) < bucket))
+        {
+            bucket_count++;
+        }
+        length = sprintf(p_report, "%s[%lu,%u]", (0 == index) ? "" : ",",
+                         (unsigned long)((0 == optiga_benchmark_latencies[index]) ? 0 : bucket), bucket_count);
+        p_report += length;
+    }
+    (void)sprintf(p_report, "]}");
+    optiga_lib_print_message(optiga_benchmark_report_buffer, OPTIGA_BENCHMARK, OPTIGA_EXAMPLE_COLOR);
+}
+
+/*
+* Runs the operations of a case on the given number of slots, returns FALSE if an operation timed out
+*/
+static bool_t optiga_benchmark_run(const optiga_benchmark_case_t * p_case, uint8_t protection_level,
+                                   uint16_t iterations, uint8_t concurrency)
+{
+    optiga_benchmark_slot_t * p_slot;
+    uint32_t start_time;
+    uint32_t current_time;
+    uint32_t bus_bytes;
+    uint16_t issued = 0;
+    uint16_t completed = 0;
+    uint16_t count = 0;
+    uint16_t failures = 0;
+    uint8_t index;
+    bool_t timed_out = FALSE;
+
+    if ((NULL != p_case->prepare) && ((optiga_benchmark_prepared != p_case->prepare) ||
+                                      (optiga_benchmark_prepared_parameter != p_case->parameter)))
+    {
+        optiga_benchmark_set_protection(&optiga_benchmark_slots[0], protection_level);
+        optiga_benchmark_prepared = p_case->prepare;
+        optiga_benchmark_prepared_parameter = p_case->parameter;
+        if (OPTIGA_LIB_SUCCESS != p_case->prepare(&optiga_benchmark_slots[0], p_case->parameter))
+        {
+            optiga_benchmark_prepared = NULL;
+            OPTIGA_EXAMPLE_LOG_MESSAGE("Preparation of the case failed, the results are invalid");
+        }
+    }
+
+    bus_bytes = optiga_benchmark_bus_bytes();
+    start_time = pal_os_timer_get_time_in_microseconds();
+    while ((completed < iterations) && (FALSE == timed_out))
+    {
+        for (index = 0; index < concurrency; index++)
+        {
+            p_slot = &optiga_benchmark_slots[index];
+            current_time = pal_os_timer_get_time_in_microseconds();
+            if ((TRUE == p_slot->active) && (OPTIGA_LIB_BUSY != p_slot->status))
+            {
+                p_slot->active = FALSE;
+                completed++;
+                if (OPTIGA_LIB_SUCCESS == p_slot->status)
+                {
+                    optiga_benchmark_latencies[count++] = current_time - p_slot->start_time;
+                }
+                else
+                {
+                    failures++;
+                }
+            }
+            if ((FALSE == p_slot->active) && (issued < iterations))
+            {
+                issued++;
+                optiga_benchmark_set_protection(p_slot, protection_level);
+                p_slot->status = OPTIGA_LIB_BUSY;
+                p_slot->start_time = pal_os_timer_get_time_in_microseconds();
+                if (OPTIGA_LIB_SUCCESS == p_case->start(p_slot, p_case->parameter))
+                {
+                    p_slot->active = TRUE;
+                }
+                else
+                {
+                    completed++;
+                    failures++;
+                }
+            }
+            else if ((TRUE == p_slot->active) && ((current_time - p_slot->start_time) > OPTIGA_BENCHMARK_TIMEOUT_US))
+            {
+                timed_out = TRUE;
+            }
+        }
+    }
+    current_time = pal_os_timer_get_time_in_microseconds();
+
+    optiga_benchmark_report(p_case->p_name, protection_level, iterations, concurrency, count, failures,
+                            current_time - start_time, optiga_benchmark_bus_bytes() - bus_bytes);
+    return ((TRUE == timed_out) ? FALSE : TRUE);
+}
+
+/*
+* Creates the crypt and util instances of the slots
+*/
+static optiga_lib_status_t optiga_benchmark_create(uint8_t concurrency)
+{
+    optiga_lib_status_t return_status = OPTIGA_LIB_SUCCESS;
+    uint8_t index;
+
+    for (index = 0; index < concurrency; index++)
+    {
+        optiga_benchmark_slots[index].active = FALSE;
+        optiga_benchmark_slots[index].p_crypt = optiga_crypt_create(0, optiga_benchmark_callback,
+                                                                    &optiga_benchmark_slots[index]);
+        optiga_benchmark_slots[index].p_util = optiga_util_create(0, optiga_benchmark_callback,
+                                                                  &optiga_benchmark_slots[index]);
+        if ((NULL == optiga_benchmark_slots[index].p_crypt) || (NULL == optiga_benchmark_slots[index].p_util))
+        {
+            return_status = !OPTIGA_LIB_SUCCESS;
+        }
+    }
+    return (return_status);
+}
+
+/*
+* Destroys the crypt and util instances of the slots
+*/
+static void optiga_benchmark_destroy(uint8_t concurrency)
+{
+    uint8_t index;
+
+    for (index = 0; index < concurrency; index++)
+    {
+        if (NULL != optiga_benchmark_slots[index].p_crypt)
+        {
+            (void)optiga_crypt_destroy(optiga_benchmark_slots[index].p_crypt);
+            optiga_benchmark_slots[index].p_crypt = NULL;
+        }
+        if (NULL != optiga_benchmark_slots[index].p_util)
+        {
+            (void)optiga_util_destroy(optiga_benchmark_slots[index].p_util);
+            optiga_benchmark_slots[index].p_util = NULL;
+        }
+    }
+}
+
+/**
+ * The below example measures the throughput and the latency of the crypt and util operations.
+ *
+ * \details
+ * Each case executes #OPTIGA_BENCHMARK_ITERATIONS operations, of which #OPTIGA_BENCHMARK_CONCURRENCY are in
+ * progress at the same time, without and with the shielded connection (if enabled). The result of each case is
+ * printed as one line of JSON with the operations per second, the 50th and 99th percentile of the latency,
+ * the bytes transferred on the I2C bus per operation (requires #OPTIGA_LIB_STATISTICS_ENABLED) and the histogram
+ * of the latencies.
+ * - The keys of OPTIGA_KEY_ID_E0F1, OPTIGA_KEY_ID_E0FC, the secret based key and the data object 0xF1E0 are
+ *   overwritten.
+ * - The HMAC and HKDF cases require the shared secret in 0xF1D0 (see "optiga --hmac").
+ * - The results include the effect of the enabled host side features (e.g. caches and random pool).
+ *
+ */
+void example_optiga_benchmark(void)
+{
+    const uint8_t protection_levels[] =
+    {
+        OPTIGA_COMMS_NO_PROTECTION,
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+        OPTIGA_COMMS_FULL_PROTECTION
+#endif
+    };
+    char_t report[80];
+    optiga_lib_status_t return_status = OPTIGA_LIB_SUCCESS;
+    uint16_t index;
+    uint8_t level;
+    bool_t completed = TRUE;
+
+#ifndef OPTIGA_INIT_DEINIT_DONE_EXCLUSIVELY
+    example_optiga_init();
+#endif //OPTIGA_INIT_DEINIT_DONE_EXCLUSIVELY
+
+    OPTIGA_EXAMPLE_LOG_MESSAGE(__FUNCTION__);
+
+    do
+    {
+        return_status = optiga_benchmark_create(OPTIGA_BENCHMARK_CONCURRENCY);
+        if (OPTIGA_LIB_SUCCESS != return_status)
+        {
+            break;
+        }
+
+        sprintf(report, "{\"version\":\"%s\",\"cases\":%u}", OPTIGA_LIB_VERSION,
+                (unsigned)(sizeof(optiga_benchmark_cases) / sizeof(optiga_benchmark_cases[0])));
+        optiga_lib_print_message(report, OPTIGA_BENCHMARK, OPTIGA_EXAMPLE_COLOR);
+
+        for (level = 0; (level < sizeof(protection_levels)) && (TRUE == completed); level++)
+        {
+            for (index = 0; index < (sizeof(optiga_benchmark_cases) / sizeof(optiga_benchmark_cases[0])); index++)
+            {
+                completed = optiga_benchmark_run(&optiga_benchmark_cases[index], protection_levels[level],
+                                                 OPTIGA_BENCHMARK_ITERATIONS, OPTIGA_BENCHMARK_CONCURRENCY);
+                if (FALSE == completed)
+                {
+                    // The operations in progress still refer to the slots, hence the instances are not destroyed
+                    OPTIGA_EXAMPLE_LOG_MESSAGE("Operation timed out, benchmark stopped");
+                    return_status = OPTIGA_LIB_BUSY;
+                    break;
+                }
+            }
+        }
+    } while (FALSE);
+    OPTIGA_EXAMPLE_LOG_STATUS(return_status);
+
+    if (TRUE == completed)
+    {
+        optiga_benchmark_destroy(OPTIGA_BENCHMARK_CONCURRENCY);
+    }
+
+#ifndef OPTIGA_INIT_DEINIT_DONE_EXCLUSIVELY
+    example_optiga_deinit();
+#endif //OPTIGA_INIT_DEINIT_DONE_EXCLUSIVELY
+}
+
+/**
+ * The below example runs one case of the benchmark, e.g. one command of a script of the shell.
+ *
+ * \details
+ * The result is printed as one line of JSON like with #example_optiga_benchmark. The keys and the reference data
+ * are prepared once for consecutive cases of the same key (e.g. "ecdsa_sign_p256" and "ecdsa_verify_p256").
+ *
+ * \param[in]  p_name              Name of the case, as given in the report of #example_optiga_benchmark
+ * \param[in]  iterations          Number of operations, up to #OPTIGA_BENCHMARK_MAX_ITERATIONS
+ * \param[in]  concurrency         Number of operations in progress at the same time, up to
+ *                                 #OPTIGA_BENCHMARK_MAX_CONCURRENCY
+ * \param[in]  protection_level    Protection level of the shielded connection, e.g. #OPTIGA_COMMS_NO_PROTECTION
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS      All operations are completed, failed operations are counted in the report
+ * \retval     #OPTIGA_LIB_BUSY         An operation timed out
+ * \retval     !#OPTIGA_LIB_SUCCESS     Unknown case, invalid count or the instances could not be created
+ */
+optiga_lib_status_t example_optiga_benchmark_case(const char_t * p_name, uint16_t iterations, uint8_t concurrency,
+                                                  uint8_t protection_level)
+{
+    optiga_lib_status_t return_status = !OPTIGA_LIB_SUCCESS;
+    const optiga_benchmark_case_t * p_case = NULL;
+    uint16_t index;
+    bool_t completed = TRUE;
+
+    for (index = 0; index < (sizeof(optiga_benchmark_cases) / sizeof(optiga_benchmark_cases[0])); index++)
+    {
+        if (0 == strcmp(p_name, optiga_benchmark_cases[index].p_name))
+        {
+            p_case = &optiga_benchmark_cases[index];
+            break;
+        }
+    }
+    if ((NULL == p_case) || (0 == iterations) || (iterations > OPTIGA_BENCHMARK_MAX_ITERATIONS) ||
+        (0 == concurrency) || (concurrency > OPTIGA_BENCHMARK_MAX_CONCURRENCY))
+    {
+        return (return_status);
+    }
+
+#ifndef OPTIGA_INIT_DEINIT_DONE_EXCLUSIVELY
+    example_optiga_init();
+#endif //OPTIGA_INIT_DEINIT_DONE_EXCLUSIVELY
+
+    do
+    {
+        return_status = optiga_benchmark_create(concurrency);
+        if (OPTIGA_LIB_SUCCESS != return_status)
+        {
+            break;
+        }
+        completed = optiga_benchmark_run(p_case, protection_level, iterations, concurrency);
+        if (FALSE == completed)
+        {
+            // The operations in progress still refer to the slots, hence the instances are not destroyed
+            OPTIGA_EXAMPLE_LOG_MESSAGE("Operation timed out, benchmark stopped");
+            return_status = OPTIGA_LIB_BUSY;
+        }
+    } while (FALSE);
+
+    if (TRUE == completed)
+    {
+        optiga_benchmark_destroy(concurrency);
+    }
+
+#ifndef OPTIGA_INIT_DEINIT_DONE_EXCLUSIVELY
+    example_optiga_deinit();
+#endif //OPTIGA_INIT_DEINIT_DONE_EXCLUSIVELY
+    return (return_status);
+}
+
+/**
+ * The below example measures a synchronous function (e.g. another example) executed repeatedly.
+ *
+ * \details
+ * The result is printed as one line of JSON like with #example_optiga_benchmark, with the concurrency of 1.
+ * The function runs with its own instances and protection level, it is counted as successful always.
+ *
+ * \param[in]  p_name              Name of the function in the report
+ * \param[in]  function            Function to be measured
+ * \param[in]  iterations          Number of executions, up to #OPTIGA_BENCHMARK_MAX_ITERATIONS
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS      All executions are completed
+ * \retval     !#OPTIGA_LIB_SUCCESS     Invalid count
+ */
+optiga_lib_status_t example_optiga_benchmark_function(const char_t * p_name, void (*function)(void),
+                                                      uint16_t iterations)
+{
+    uint32_t start_time;
+    uint32_t operation_start_time;
+    uint32_t bus_bytes;
+    uint16_t index;
+
+    if ((0 == iterations) || (iterations > OPTIGA_BENCHMARK_MAX_ITERATIONS))
+    {
+        return (!OPTIGA_LIB_SUCCESS);
+    }
+
+    // The instance serves to query the statistics only
+    optiga_benchmark_slots[0].p_util = optiga_util_create(0, optiga_benchmark_callback, &optiga_benchmark_slots[0]);
+    bus_bytes = optiga_benchmark_bus_bytes();
+    start_time = pal_os_timer_get_time_in_microseconds();
+    for (index = 0; index < iterations; index++)
+    {
+        operation_start_time = pal_os_timer_get_time_in_microseconds();
+        function();
+        optiga_benchmark_latencies[index] = pal_os_timer_get_time_in_microseconds() - operation_start_time;
+    }
+    optiga_benchmark_report(p_name, OPTIGA_COMMS_NO_PROTECTION, iterations, 1, iterations, 0,
+                            pal_os_timer_get_time_in_microseconds() - start_time,
+                            optiga_benchmark_bus_bytes() - bus_bytes);
+    optiga_benchmark_destroy(1);
+    return (OPTIGA_LIB_SUCCESS);
+}
+
+/**
+* @}
+*/
@@ -37,6 +37,7 @@
 */
 #include "optiga/optiga_util.h"
 #include "optiga/optiga_crypt.h"
+#include "optiga/common/optiga_lib_metadata.h"
 #include "optiga_example.h"
 
 #ifdef OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED
@@ -71,7 +72,9 @@ static void optiga_util_callback(void * context, optiga_lib_status_t return_stat
 /**
  * Sample metadata of 0xE0F1 
  */
-const uint8_t E0F1_metadata[] = { 0x20, 0x06, 0xD0, 0x01, 0x00, 0xD3, 0x01, 0x00 };
+OPTIGA_METADATA_DEFINE(E0F1_metadata,
+                       OPTIGA_METADATA_CHANGE_AC(OPTIGA_AC_ALW),
+                       OPTIGA_METADATA_EXECUTE_AC(OPTIGA_AC_ALW));
 
 /**
  * The below example demonstrates the generation of
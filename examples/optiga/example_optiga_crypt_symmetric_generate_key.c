@@ -37,6 +37,7 @@
 */
 #include "optiga/optiga_util.h"
 #include "optiga/optiga_crypt.h"
+#include "optiga/common/optiga_lib_metadata.h"
 #include "optiga_example.h"
 
 #ifdef OPTIGA_CRYPT_SYM_GENERATE_KEY_ENABLED
@@ -79,7 +80,9 @@ static void optiga_util_callback(void * context, optiga_lib_status_t return_stat
 /**
  * Sample metadata of 0xE200 
  */
-const uint8_t E200_metadata[] = { 0x20, 0x06, 0xD0, 0x01, 0x00, 0xD3, 0x01, 0x00 };
+OPTIGA_METADATA_DEFINE(E200_metadata,
+                       OPTIGA_METADATA_CHANGE_AC(OPTIGA_AC_ALW),
+                       OPTIGA_METADATA_EXECUTE_AC(OPTIGA_AC_ALW));
 
 /**
  * The below generates symmetric Key using optiga_crypt_symmetric_generate_key.
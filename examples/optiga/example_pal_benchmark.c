@@ -0,0 +1,337 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file example_pal_benchmark.c
+*
+* \brief   This file provides the conformance and latency benchmark of the PAL of a platform.
+*
+* \ingroup grOptigaExamples
+*
+* @{
+*/
+
+#include "optiga/pal/pal_os_event.h"
+#include "optiga/pal/pal_os_timer.h"
+#include "optiga/pal/pal_i2c.h"
+#include "optiga/pal/pal_gpio.h"
+#include "optiga/common/optiga_lib_return_codes.h"
+#include "optiga_example.h"
+#include <stdio.h>
+
+extern pal_i2c_t optiga_pal_i2c_context_0;
+extern pal_gpio_t optiga_reset_0;
+
+/// Number of measurements of each case
+#define PAL_BENCHMARK_ITERATIONS            (16U)
+/// Additional time to wait for an event or an I2C operation, before the case fails
+#define PAL_BENCHMARK_TIMEOUT_US            (1000000U)
+/// Number of attempts of an I2C operation, since OPTIGA might NACK until the guard time is elapsed
+#define PAL_BENCHMARK_I2C_RETRIES           (10U)
+/// I2C_STATE register of OPTIGA, which is read without side effects
+#define PAL_BENCHMARK_I2C_STATE_REG         (0x82U)
+/// Number of toggles of the reset pin
+#define PAL_BENCHMARK_GPIO_TOGGLES          (100U)
+
+#define PAL_BENCHMARK                       "[pal benchmark]    : "
+
+/// Minimum, maximum and sum of the measurements in microseconds
+typedef struct pal_benchmark_stats
+{
+    int32_t min;
+    int32_t max;
+    int32_t sum;
+    uint16_t count;
+    uint16_t failures;
+}pal_benchmark_stats_t;
+
+static volatile uint32_t pal_benchmark_event_time = 0;
+static volatile uint8_t pal_benchmark_event_done = FALSE;
+static volatile optiga_lib_status_t pal_benchmark_i2c_status = OPTIGA_LIB_BUSY;
+
+static void pal_benchmark_stats_reset(pal_benchmark_stats_t * p_stats)
+{
+    p_stats->min = 0x7FFFFFFF;
+    p_stats->max = -0x7FFFFFFF;
+    p_stats->sum = 0;
+    p_stats->count = 0;
+    p_stats->failures = 0;
+}
+
+static void pal_benchmark_stats_add(pal_benchmark_stats_t * p_stats, int32_t value)
+{
+    p_stats->min = (value < p_stats->min) ? value : p_stats->min;
+    p_stats->max = (value > p_stats->max) ? value : p_stats->max;
+    p_stats->sum += value;
+    p_stats->count++;
+}
+
+// Prints one line of the report, e.g. "event 1000us : min 12 avg 40 max 95 us, fail 0"
+static void pal_benchmark_report(const char_t * p_case, uint32_t parameter, const pal_benchmark_stats_t * p_stats)
+{
+    char_t report[100];
+
+    if (0 == p_stats->count)
+    {
+        sprintf(report, "%s %lu : no measurement, fail %u", p_case, (unsigned long)parameter, p_stats->failures);
+    }
+    else
+    {
+        sprintf(report, "%s %lu : min %ld avg %ld max %ld us, fail %u", p_case, (unsigned long)parameter,
+                (long)p_stats->min, (long)(p_stats->sum / (int32_t)p_stats->count), (long)p_stats->max,
+                p_stats->failures);
+    }
+    optiga_lib_print_message(report, PAL_BENCHMARK, OPTIGA_EXAMPLE_COLOR);
+}
+
+//lint --e{715} suppress "args is not required, the time of the callback is captured"
+static void pal_benchmark_event_callback(void * args)
+{
+    pal_benchmark_event_time = pal_os_timer_get_time_in_microseconds();
+    pal_benchmark_event_done = TRUE;
+}
+
+//lint --e{715} suppress "context is not required"
+static void pal_benchmark_i2c_callback(void * context, optiga_lib_status_t event)
+{
+    pal_benchmark_i2c_status = event;
+}
+
+/*
+* Resolution of pal_os_timer_get_time_in_microseconds, i.e. the smallest step of the time.
+* A step backwards (not wrap around) is reported as failure.
+*/
+static void pal_benchmark_timer(void)
+{
+    pal_benchmark_stats_t stats;
+    uint32_t start;
+    uint32_t now;
+    uint32_t loops;
+    uint8_t index;
+
+    pal_benchmark_stats_reset(&stats);
+    for (index = 0; index < PAL_BENCHMARK_ITERATIONS; index++)
+    {
+        start = pal_os_timer_get_time_in_microseconds();
+        loops = 0;
+        do
+        {
+            now = pal_os_timer_get_time_in_microseconds();
+            loops++;
+        } while ((now == start) && (loops < 0x00FFFFFFU));
+
+        if ((int32_t)(now - start) <= 0)
+        {
+            stats.failures++;
+            continue;
+        }
+        pal_benchmark_stats_add(&stats, (int32_t)(now - start));
+    }
+    pal_benchmark_report("timer resolution", 0, &stats);
+}
+
+/*
+* Lateness of the registered callback versus the requested delay.
+* A callback invoked before the requested delay is reported as failure.
+*/
+static void pal_benchmark_event(pal_os_event_t * p_event, uint32_t delay_us)
+{
+    pal_benchmark_stats_t stats;
+    uint32_t start;
+    int32_t lateness;
+    uint8_t index;
+
+    pal_benchmark_stats_reset(&stats);
+    for (index = 0; index < PAL_BENCHMARK_ITERATIONS; index++)
+    {
+        pal_benchmark_event_done = FALSE;
+        start = pal_os_timer_get_time_in_microseconds();
+        pal_os_event_register_callback_oneshot(p_event, pal_benchmark_event_callback, NULL, delay_us);
+        while ((FALSE == pal_benchmark_event_done) &&
+               ((pal_os_timer_get_time_in_microseconds() - start) < (delay_us + PAL_BENCHMARK_TIMEOUT_US)))
+        {
+        }
+        if (FALSE == pal_benchmark_event_done)
+        {
+            stats.failures++;
+            continue;
+        }
+        lateness = (int32_t)(pal_benchmark_event_time - start) - (int32_t)delay_us;
+        if (0 > lateness)
+        {
+            stats.failures++;
+        }
+        pal_benchmark_stats_add(&stats, lateness);
+    }
+    pal_benchmark_report("event lateness, delay us", delay_us, &stats);
+}
+
+// Waits for the completion of an I2C operation, returns the time from start in microseconds or -1 on failure
+static int32_t pal_benchmark_i2c_wait(uint32_t start)
+{
+    while ((OPTIGA_LIB_BUSY == pal_benchmark_i2c_status) &&
+           ((pal_os_timer_get_time_in_microseconds() - start) < PAL_BENCHMARK_TIMEOUT_US))
+    {
+    }
+    return ((PAL_I2C_EVENT_SUCCESS == pal_benchmark_i2c_status) ?
+            (int32_t)(pal_os_timer_get_time_in_microseconds() - start) : -1);
+}
+
+/*
+* Latency of the I2C write of the register address and the read of length bytes of I2C_STATE.
+*/
+static void pal_benchmark_i2c(uint16_t length)
+{
+    pal_benchmark_stats_t write_stats;
+    pal_benchmark_stats_t read_stats;
+    uint8_t reg_address = PAL_BENCHMARK_I2C_STATE_REG;
+    uint8_t reg_data[4];
+    uint32_t start;
+    int32_t latency;
+    uint8_t index;
+    uint8_t retry;
+
+    pal_benchmark_stats_reset(&write_stats);
+    pal_benchmark_stats_reset(&read_stats);
+    for (index = 0; index < PAL_BENCHMARK_ITERATIONS; index++)
+    {
+        latency = -1;
+        for (retry = 0; (0 > latency) && (retry < PAL_BENCHMARK_I2C_RETRIES); retry++)
+        {
+            pal_benchmark_i2c_status = OPTIGA_LIB_BUSY;
+            start = pal_os_timer_get_time_in_microseconds();
+            if (PAL_STATUS_SUCCESS == pal_i2c_write(&optiga_pal_i2c_context_0, &reg_address, 1))
+            {
+                latency = pal_benchmark_i2c_wait(start);
+            }
+        }
+        if (0 > latency)
+        {
+            write_stats.failures++;
+            continue;
+        }
+        pal_benchmark_stats_add(&write_stats, latency);
+
+        latency = -1;
+        for (retry = 0; (0 > latency) && (retry < PAL_BENCHMARK_I2C_RETRIES); retry++)
+        {
+            pal_benchmark_i2c_status = OPTIGA_LIB_BUSY;
+            start = pal_os_timer_get_time_in_microseconds();
+            if (PAL_STATUS_SUCCESS == pal_i2c_read(&optiga_pal_i2c_context_0, reg_data, length))
+            {
+                latency = pal_benchmark_i2c_wait(start);
+            }
+        }
+        if (0 > latency)
+        {
+            read_stats.failures++;
+            continue;
+        }
+        pal_benchmark_stats_add(&read_stats, latency);
+    }
+    pal_benchmark_report("i2c write, bytes", 1, &write_stats);
+    pal_benchmark_report("i2c read, bytes", length, &read_stats);
+}
+
+/*
+* Time of one toggle (low and high) of the reset pin. OPTIGA is reset, hence this is measured at last.
+*/
+static void pal_benchmark_gpio(void)
+{
+    pal_benchmark_stats_t stats;
+    uint32_t start;
+    uint16_t index;
+
+    pal_benchmark_stats_reset(&stats);
+    if (NULL != optiga_reset_0.p_gpio_hw)
+    {
+        start = pal_os_timer_get_time_in_microseconds();
+        for (index = 0; index < PAL_BENCHMARK_GPIO_TOGGLES; index++)
+        {
+            pal_gpio_set_low(&optiga_reset_0);
+            pal_gpio_set_high(&optiga_reset_0);
+        }
+        pal_benchmark_stats_add(&stats, (int32_t)((pal_os_timer_get_time_in_microseconds() - start) /
+                                                  PAL_BENCHMARK_GPIO_TOGGLES));
+        // Startup time of OPTIGA after the reset
+        pal_os_timer_delay_in_milliseconds(15);
+    }
+    pal_benchmark_report("gpio toggle, count", PAL_BENCHMARK_GPIO_TOGGLES, &stats);
+}
+
+/**
+ * The below example measures the timing of the PAL of the platform and prints a comparable report.
+ *
+ * - Timer resolution of #pal_os_timer_get_time_in_microseconds
+ * - Lateness of #pal_os_event_register_callback_oneshot versus the requested delay (jitter)
+ * - Latency of #pal_i2c_write and #pal_i2c_read per byte count, reading the I2C_STATE register of OPTIGA
+ * - Toggle time of #pal_gpio_set_low and #pal_gpio_set_high on the reset pin
+ *
+ * Conformance failures (e.g. callback before the requested delay, time running backwards, timeouts) are counted
+ * in "fail" of each line.
+ *
+ * \note
+ * - The PAL must be initialized using #pal_init. No optiga util or crypt instance must exist, since the
+ *   os event and the I2C context are used directly.
+ */
+void example_pal_benchmark(void)
+{
+    const uint32_t event_delays_us[] = {50, 1000, 5000, 10000, 50000};
+    pal_os_event_t * p_event;
+    void * p_upper_layer_ctx = optiga_pal_i2c_context_0.p_upper_layer_ctx;
+    void * upper_layer_event_handler = optiga_pal_i2c_context_0.upper_layer_event_handler;
+    uint16_t length;
+    uint8_t index;
+
+    OPTIGA_EXAMPLE_LOG_MESSAGE(__FUNCTION__);
+
+    pal_benchmark_timer();
+
+    p_event = pal_os_event_create(NULL, NULL);
+    for (index = 0; index < (sizeof(event_delays_us) / sizeof(event_delays_us[0])); index++)
+    {
+        pal_benchmark_event(p_event, event_delays_us[index]);
+    }
+
+    optiga_pal_i2c_context_0.p_upper_layer_ctx = NULL;
+    optiga_pal_i2c_context_0.upper_layer_event_handler = (void *)pal_benchmark_i2c_callback;
+    if (PAL_STATUS_SUCCESS == pal_i2c_init(&optiga_pal_i2c_context_0))
+    {
+        for (length = 1; length <= 4; length++)
+        {
+            pal_benchmark_i2c(length);
+        }
+    }
+    optiga_pal_i2c_context_0.p_upper_layer_ctx = p_upper_layer_ctx;
+    optiga_pal_i2c_context_0.upper_layer_event_handler = upper_layer_event_handler;
+
+    pal_benchmark_gpio();
+}
+
+/**
+* @}
+*/
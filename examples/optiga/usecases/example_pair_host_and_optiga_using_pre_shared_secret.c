@@ -37,6 +37,7 @@
 
 #include "optiga/optiga_util.h"
 #include "optiga/optiga_crypt.h"
+#include "optiga/common/optiga_lib_metadata.h"
 
 #include "optiga/pal/pal_os_datastore.h"
 #include "optiga_example.h"
@@ -57,32 +58,29 @@ uint32_t time_taken_for_pairing = 0;
 //Currently set to Creation state(defualt value). At the real time/customer side this needs to be LCSO_STATE_OPERATIONAL (0x07)
 #define FINAL_LCSO_STATE          (LCSO_STATE_CREATION)
 
+/**
+ * @brief Rotation policy of the platform binding secret.
+ * By default, a valid binding (the secret in pal_os_datastore matches the secret of OPTIGA) is kept and only verified
+ * at startup. If defined, a new secret is generated and written over the shielded connection on every pairing.
+ * To enable the rotation, define this macro.
+ */
+//#define PLATFORM_BINDING_SECRET_ROTATE_ON_STARTUP
+
 /* Platform Binding Shared Secret (0xE140) Metadata to be updated */
 
-const uint8_t platform_binding_shared_secret_metadata_final [] = {
-    //Metadata to be updated
-    0x20, 0x17,
-        // LcsO
-        0xC0, 0x01,
-                    FINAL_LCSO_STATE,       // Refer Macro to see the value or some more notes
-        // Change/Write Access tag
-        0xD0, 0x07,
-                    // This allows updating the binding secret during the runtime using shielded connection
-                    // If not required to update the secret over the runtime, set this to NEV and
-                    // update Metadata length accordingly
-                    0xE1, 0xFC, LCSO_STATE_OPERATIONAL,   // LcsO < Operational state
-                    0xFE,
-                    0x20, 0xE1, 0x40,
-        // Read Access tag
-        0xD1, 0x03,
-                    0xE1, 0xFC, LCSO_STATE_OPERATIONAL,   // LcsO < Operational state
-        // Execute Access tag
-        0xD3, 0x01,
-                    0x00,   // Always
-        // Data object Type
-        0xE8, 0x01,
-                    0x22,   // Platform binding secret type
-};
+OPTIGA_METADATA_DEFINE(platform_binding_shared_secret_metadata_final,
+    // LcsO, refer Macro to see the value or some more notes
+    OPTIGA_METADATA_LCSO(FINAL_LCSO_STATE),
+    // Change/Write Access: LcsO < Operational state or shielded connection with the binding secret.
+    // This allows updating the binding secret during the runtime using shielded connection
+    // If not required to update the secret over the runtime, set this to OPTIGA_AC_NEV
+    OPTIGA_METADATA_CHANGE_AC(OPTIGA_AC_LCSO_LT(LCSO_STATE_OPERATIONAL), OPTIGA_AC_OR, OPTIGA_AC_CONF(0xE140)),
+    // Read Access: LcsO < Operational state
+    OPTIGA_METADATA_READ_AC(OPTIGA_AC_LCSO_LT(LCSO_STATE_OPERATIONAL)),
+    // Execute Access: Always
+    OPTIGA_METADATA_EXECUTE_AC(OPTIGA_AC_ALW),
+    // Platform binding secret type
+    OPTIGA_METADATA_DATA_OBJECT_TYPE(0x22));
 
 /**
  * Callback when optiga_util_xxxx/optiga_crypt_xxxx operation is completed asynchronously
@@ -105,6 +103,7 @@ optiga_lib_status_t pair_host_and_optiga_using_pre_shared_secret(void)
     uint8_t platform_binding_secret_metadata[44];
     optiga_lib_status_t return_status = !OPTIGA_LIB_SUCCESS;
     pal_status_t pal_return_status;
+    uint8_t binding_valid;
     optiga_util_t * me_util = NULL;
     optiga_crypt_t * me_crypt = NULL;
 
@@ -135,30 +134,63 @@ optiga_lib_status_t pair_host_and_optiga_using_pre_shared_secret(void)
         OPTIGA_CRYPT_SET_COMMS_PROTOCOL_VERSION(me_crypt,OPTIGA_COMMS_PROTOCOL_VERSION_PRE_SHARED_SECRET);
 
         /**
-         * 3. Read Platform Binding Shared secret (0xE140) data object metadata from OPTIGA
-         *    using optiga_util_read_metadata.
+         * 3. Verify the existing binding by reading the Platform Binding Shared secret (0xE140) data object metadata
+         *    over the shielded connection.
+         *    This succeeds only if the secret stored on the Host (pal_os_datastore) matches the secret of OPTIGA.
+         *    Nothing is written then, which avoids the NVM writes on OPTIGA and the Host at every startup.
          */
         bytes_to_read = sizeof(platform_binding_secret_metadata);
         optiga_lib_status = OPTIGA_LIB_BUSY;
         
         START_PERFORMANCE_MEASUREMENT(time_taken_for_pairing);
         
+        OPTIGA_UTIL_SET_COMMS_PROTECTION_LEVEL(me_util,OPTIGA_COMMS_FULL_PROTECTION);
         return_status = optiga_util_read_metadata(me_util,
                                                   0xE140,
                                                   platform_binding_secret_metadata,
                                                   &bytes_to_read);
+        if (OPTIGA_LIB_SUCCESS == return_status)
+        {
+            while (OPTIGA_LIB_BUSY == optiga_lib_status)
+            { }
+            return_status = optiga_lib_status;
+        }
+        binding_valid = (OPTIGA_LIB_SUCCESS == return_status) ? TRUE : FALSE;
 
-        WAIT_AND_CHECK_STATUS(return_status, optiga_lib_status);
-
-        /**
-         * 4. Validate LcsO in the metadata.
-         *    Skip the rest of the procedure if LcsO is greater than or equal to operational state(0x07)
-         */
-        if (platform_binding_secret_metadata[4] >= LCSO_STATE_OPERATIONAL)
+#ifndef PLATFORM_BINDING_SECRET_ROTATE_ON_STARTUP
+        if (TRUE == binding_valid)
         {
-            // The LcsO is already greater than or equal to operational state
+            // The Host and OPTIGA are already paired
+            READ_PERFORMANCE_MEASUREMENT(time_taken_for_pairing);
             break;
         }
+#endif
+
+        if (FALSE == binding_valid)
+        {
+            /**
+             * 4. Read Platform Binding Shared secret (0xE140) data object metadata from OPTIGA
+             *    using optiga_util_read_metadata, without protection.
+             */
+            bytes_to_read = sizeof(platform_binding_secret_metadata);
+            optiga_lib_status = OPTIGA_LIB_BUSY;
+            return_status = optiga_util_read_metadata(me_util,
+                                                      0xE140,
+                                                      platform_binding_secret_metadata,
+                                                      &bytes_to_read);
+
+            WAIT_AND_CHECK_STATUS(return_status, optiga_lib_status);
+
+            /**
+             * Validate LcsO in the metadata.
+             * Skip the rest of the procedure if LcsO is greater than or equal to operational state(0x07)
+             */
+            if (platform_binding_secret_metadata[4] >= LCSO_STATE_OPERATIONAL)
+            {
+                // The LcsO is already greater than or equal to operational state
+                break;
+            }
+        }
 
         /**
          * 5. Generate Random using optiga_crypt_random
@@ -185,9 +217,12 @@ optiga_lib_status_t pair_host_and_optiga_using_pre_shared_secret(void)
 
         /**
          * 7. Write random(secret) to OPTIGA platform Binding shared secret data object (0xE140)
+         *    A valid binding is rotated over the shielded connection, as required by the final metadata.
          */
         optiga_lib_status = OPTIGA_LIB_BUSY;
-        OPTIGA_UTIL_SET_COMMS_PROTECTION_LEVEL(me_util,OPTIGA_COMMS_NO_PROTECTION);
+        OPTIGA_UTIL_SET_COMMS_PROTECTION_LEVEL(me_util,
+                                               (TRUE == binding_valid) ? OPTIGA_COMMS_FULL_PROTECTION :
+                                                                         OPTIGA_COMMS_NO_PROTECTION);
         return_status = optiga_util_write_data(me_util,
                                                0xE140,
                                                OPTIGA_UTIL_ERASE_AND_WRITE,
@@ -215,15 +250,19 @@ optiga_lib_status_t pair_host_and_optiga_using_pre_shared_secret(void)
 
         /**
          * 9. Update metadata of OPTIGA Platform Binding shared secret data object (0xE140)
+         *    The metadata of a valid binding is already final.
          */
-        optiga_lib_status = OPTIGA_LIB_BUSY;
-        OPTIGA_UTIL_SET_COMMS_PROTECTION_LEVEL(me_util,OPTIGA_COMMS_NO_PROTECTION);
-        return_status = optiga_util_write_metadata(me_util,
-                                                   0xE140,
-                                                   platform_binding_shared_secret_metadata_final,
-                                                   sizeof(platform_binding_shared_secret_metadata_final));
+        if (FALSE == binding_valid)
+        {
+            optiga_lib_status = OPTIGA_LIB_BUSY;
+            OPTIGA_UTIL_SET_COMMS_PROTECTION_LEVEL(me_util,OPTIGA_COMMS_NO_PROTECTION);
+            return_status = optiga_util_write_metadata(me_util,
+                                                       0xE140,
+                                                       platform_binding_shared_secret_metadata_final,
+                                                       sizeof(platform_binding_shared_secret_metadata_final));
 
-        WAIT_AND_CHECK_STATUS(return_status, optiga_lib_status);
+            WAIT_AND_CHECK_STATUS(return_status, optiga_lib_status);
+        }
         
         READ_PERFORMANCE_MEASUREMENT(time_taken_for_pairing);
         
@@ -257,6 +296,8 @@ optiga_lib_status_t pair_host_and_optiga_using_pre_shared_secret(void)
 
 /**
  * The below example demonstrates pairing the Host and OPTIGA using a preshared secret for the first time.
+ * If the Host and OPTIGA are already paired, the binding is only verified with a shielded command
+ * (refer PLATFORM_BINDING_SECRET_ROTATE_ON_STARTUP).
  *
  * Note:
  *   1) If the below example is executed once, the LcsO of Platform Binding shared secret is set to Initialization.
@@ -88,6 +88,15 @@ extern void example_optiga_crypt_hkdf(void);
 extern void example_optiga_crypt_symmetric_generate_key(void);
 extern void example_optiga_hmac_verify_with_authorization_reference(void);
 extern void example_optiga_crypt_clear_auto_state(void);
+extern void example_pal_benchmark(void);
+extern void example_optiga_benchmark(void);
+extern optiga_lib_status_t example_optiga_benchmark_case(const char_t * p_name, uint16_t iterations,
+                                                         uint8_t concurrency, uint8_t protection_level);
+extern optiga_lib_status_t example_optiga_benchmark_function(const char_t * p_name, void (*function)(void),
+                                                             uint16_t iterations);
+#ifdef OPTIGA_LIB_PROFILE_ENABLED
+extern void example_host_cost_benchmark(void);
+#endif
 
 extern pal_logger_t logger_console;
 /**
@@ -698,6 +707,35 @@ static void optiga_shell_crypt_hmac_verify_with_authorization_reference(void)
 }
 #endif
 
+static void optiga_shell_pal_benchmark(void)
+{
+    OPTIGA_SHELL_LOG_MESSAGE("Starting PAL benchmark, OPTIGA must not be initialized");
+    OPTIGA_SHELL_LOG_MESSAGE("1 Step: Timer resolution");
+    OPTIGA_SHELL_LOG_MESSAGE("2 Step: Event lateness per requested delay");
+    OPTIGA_SHELL_LOG_MESSAGE("3 Step: I2C write/read latency per byte count");
+    OPTIGA_SHELL_LOG_MESSAGE("4 Step: GPIO toggle time of the reset pin");
+    example_pal_benchmark();
+}
+
+static void optiga_shell_benchmark(void)
+{
+    OPTIGA_SHELL_LOG_MESSAGE("Starting throughput and latency benchmark of crypt and util operations");
+    OPTIGA_SHELL_LOG_MESSAGE("1 Step: Create the crypt and util instances of the concurrent operations");
+    OPTIGA_SHELL_LOG_MESSAGE("2 Step: Run each case without and with shielded connection");
+    OPTIGA_SHELL_LOG_MESSAGE("3 Step: Report each case as one line of JSON");
+    example_optiga_benchmark();
+}
+
+#ifdef OPTIGA_LIB_PROFILE_ENABLED
+static void optiga_shell_host_cost_benchmark(void)
+{
+    OPTIGA_SHELL_LOG_MESSAGE("Starting host CPU cost benchmark of comms and command layer code paths");
+    OPTIGA_SHELL_LOG_MESSAGE("1 Step: Run each case without and with shielded connection");
+    OPTIGA_SHELL_LOG_MESSAGE("2 Step: Report the cycles of each profiling point as one line of JSON");
+    example_host_cost_benchmark();
+}
+#endif
+
 #if defined (OPTIGA_CRYPT_GENERATE_AUTH_CODE_ENABLED) && defined (OPTIGA_CRYPT_HMAC_VERIFY_ENABLED) && defined (OPTIGA_CRYPT_CLEAR_AUTO_STATE_ENABLED)
 static void optiga_shell_crypt_clear_auto_state(void)
 {
@@ -883,6 +921,13 @@ optiga_example_cmd_t optiga_cmds [] =
 #if defined (OPTIGA_CRYPT_GENERATE_AUTH_CODE_ENABLED) && defined (OPTIGA_CRYPT_HMAC_VERIFY_ENABLED)        
         {"    hmac verify                              : optiga --","hmacverify",      optiga_shell_crypt_hmac_verify_with_authorization_reference},
 #endif        
+        {"    pal benchmark (without init)             : optiga --","palbench",        optiga_shell_pal_benchmark},
+        {"    benchmark of crypt and util operations   : optiga --","benchmark",       optiga_shell_benchmark},
+        {"    benchmark script, e.g. \"ecdsa_sign_p256 100 2; readdata 10\"\r\n"
+         "      <case or cmd> [repeat [concurrency [protection]]];... : optiga --","run <script>",    NULL},
+#ifdef OPTIGA_LIB_PROFILE_ENABLED
+        {"    host cpu cost of comms and command layer : optiga --","hostcost",        optiga_shell_host_cost_benchmark},
+#endif
 };
 
 #define OPTIGA_SIZE_OF_CMDS            (sizeof(optiga_cmds)/sizeof(optiga_example_cmd_t))
@@ -922,11 +967,98 @@ static void optiga_shell_trim_cmd(char_t * user_cmd)
     }
 }
 
+/**
+ * Runs a script of benchmark commands, separated by ';' or new lines, without user interaction.
+ *
+ * \details
+ * Each command is "<name> [<repeat> [<concurrency> [<protection level>]]]", e.g. "ecdsa_sign_p256 100 2; readdata 10".
+ * - The name is either a case of the benchmark (see "optiga --benchmark") or an option of the shell.
+ *   The options of the shell run with the concurrency of 1.
+ * - Each command prints one line of JSON with the throughput, the percentiles and the histogram of the latencies.
+ * - The script stops at an operation, which timed out.
+ *
+ * \param[in]  p_script            Script, terminated by '\0'
+ */
+void optiga_shell_run_script(const char_t * p_script)
+{
+    char_t command[64];
+    char_t name[32];
+    unsigned int repeat;
+    unsigned int concurrency;
+    unsigned int protection_level;
+    optiga_lib_status_t return_status;
+    const char_t * p_command;
+    uint32_t length;
+    uint32_t copy_length;
+    uint8_t index;
+
+    while ('\0' != *p_script)
+    {
+        p_command = p_script;
+        length = (uint32_t)strcspn(p_command, ";\r\n");
+        p_script += ('\0' == p_command[length]) ? length : (length + 1);
+
+        repeat = 1;
+        concurrency = 1;
+        protection_level = OPTIGA_COMMS_NO_PROTECTION;
+        return_status = !OPTIGA_LIB_SUCCESS;
+        // A command longer than the buffer is reported truncated
+        copy_length = (length < sizeof(command)) ? length : (sizeof(command) - 1);
+        memcpy(command, p_command, copy_length);
+        command[copy_length] = '\0';
+        do
+        {
+            if (length >= sizeof(command))
+            {
+                break;
+            }
+            if (sscanf(command, "%31s %u %u %u", name, &repeat, &concurrency, &protection_level) < 1)
+            {
+                // Empty command
+                return_status = OPTIGA_LIB_SUCCESS;
+                break;
+            }
+            if ((repeat > 0xFFFFU) || (concurrency > 0xFFU) || (protection_level > 0xFFU))
+            {
+                break;
+            }
+            for (index = 0; index < OPTIGA_SIZE_OF_CMDS; index++)
+            {
+                if ((0 == strcmp(name, optiga_cmds[index].cmd_options)) && (NULL != optiga_cmds[index].cmd_handler))
+                {
+                    if (1 == concurrency)
+                    {
+                        return_status = example_optiga_benchmark_function(name, optiga_cmds[index].cmd_handler,
+                                                                          (uint16_t)repeat);
+                    }
+                    break;
+                }
+            }
+            if (OPTIGA_SIZE_OF_CMDS == index)
+            {
+                return_status = example_optiga_benchmark_case(name, (uint16_t)repeat, (uint8_t)concurrency,
+                                                              (uint8_t)protection_level);
+            }
+        } while (FALSE);
+
+        if (OPTIGA_LIB_BUSY == return_status)
+        {
+            break;
+        }
+        if (OPTIGA_LIB_SUCCESS != return_status)
+        {
+            optiga_lib_print_string("Invalid command of the script : ");
+            optiga_lib_print_string_with_newline(command);
+        }
+    }
+}
+
 static void optiga_shell_execute_example(char_t * user_cmd)
 {
     uint8_t number_of_cmds = OPTIGA_SIZE_OF_CMDS;
     uint8_t index,cmd_found = 0;
     char_t * optiga_cmd_option = "optiga --";
+    char_t * optiga_run_option = "optiga --run ";
     optiga_example_cmd_t * current_cmd;
 
     
@@ -936,6 +1068,14 @@ static void optiga_shell_execute_example(char_t * user_cmd)
         {
             break;
         }
+        // The script keeps its spaces, hence it is not trimmed
+        if (0 == strncmp(user_cmd, optiga_run_option, strlen(optiga_run_option)))
+        {
+            optiga_shell_run_script(user_cmd + strlen(optiga_run_option));
+            optiga_lib_print_string_with_newline("");
+            cmd_found = 1;
+            break;
+        }
         optiga_shell_trim_cmd(user_cmd);
         for(index = 0; index < number_of_cmds; index++)
         {
@@ -974,7 +1114,7 @@ static void optiga_shell_show_prompt()
 void optiga_shell_begin(void)
 {
     uint8_t ch = 0;
-    char_t user_cmd[50];
+    char_t user_cmd[256];
     uint8_t index = 0;
 
     optiga_shell_show_prompt();
@@ -1001,7 +1141,10 @@ void optiga_shell_begin(void)
                 //keep adding
                 //lint --e{534,713} The return value is not used hence not checked*/
                 pal_logger_write(&logger_console, &ch, 1);
-                user_cmd[index++] = ch;
+                if (index < (sizeof(user_cmd) - 1))
+                {
+                    user_cmd[index++] = ch;
+                }
             }
         }
     }
@@ -39,25 +39,41 @@
 #define _PROTECTED_UPDATE_CBOR_H_
 
 #include <stdint.h>
+#include <stddef.h>
 
+// Writer of the cbor items. Without buffer, the items are only counted, to get the size before writing (size pass)
+typedef struct cbor_writer
+{
+    uint8_t * buffer;
+    uint32_t offset;
+}cbor_writer_t;
+
+// Initializes the writer, at the offset of the buffer. Buffer is NULL for the size pass
+void cbor_writer_init(cbor_writer_t * p_writer, uint8_t * buffer, uint32_t offset);
+// Gets the size of the cbor head (major type and argument) for the value
+uint32_t cbor_get_head_size(uint32_t value);
 // Encodes cbor NULL
-int32_t cbor_set_null(uint8_t * buffer, uint16_t * offset);
+void cbor_set_null(cbor_writer_t * p_writer);
 // Encodes cbor array
-int32_t cbor_set_array_of_data(uint8_t * buffer, uint32_t value, uint16_t * offset);
-// Encodes cbor unsiged integer
-int32_t cbor_set_unsigned_integer(uint8_t * buffer, uint32_t value, uint16_t * offset);
+void cbor_set_array_of_data(cbor_writer_t * p_writer, uint32_t value);
 // Encodes cbor unsiged integer
-int32_t cbor_set_signed_integer(uint8_t * buffer, int32_t value, uint16_t * offset);
-// Encodes cbor byte string
-int32_t cbor_set_byte_string(uint8_t * buffer, uint32_t value, uint16_t * offset);
+void cbor_set_unsigned_integer(cbor_writer_t * p_writer, uint32_t value);
+// Encodes cbor signed integer
+void cbor_set_signed_integer(cbor_writer_t * p_writer, int32_t value);
+// Encodes cbor byte string head, the content follows
+void cbor_set_byte_string(cbor_writer_t * p_writer, uint32_t value);
+// Copies the content of a byte string
+void cbor_set_data(cbor_writer_t * p_writer, const uint8_t * data, uint32_t data_length);
+// Encodes cbor byte string with the content
+void cbor_set_byte_string_data(cbor_writer_t * p_writer, const uint8_t * data, uint32_t data_length);
 // Set the tag for map
-void cbor_set_map_tag(uint8_t * buffer, uint8_t map_number, uint16_t * offset);
+void cbor_set_map_tag(cbor_writer_t * p_writer, uint8_t map_number);
 // Encodes cbor map for unsigned type
-int32_t cbor_set_map_unsigned_type(uint8_t * buffer, uint32_t key_data_item, uint32_t value_data_item, uint16_t * offset);
+void cbor_set_map_unsigned_type(cbor_writer_t * p_writer, uint32_t key_data_item, uint32_t value_data_item);
 // Encodes cbor map for signed type
-int32_t cbor_set_map_signed_type(uint8_t * buffer, uint32_t key_data_item, int32_t value_data_item, uint16_t * offset);
-// Encodes cbor map for byte array type
-int32_t cbor_set_map_byte_string_type(uint8_t * buffer, uint32_t key_data_item, const uint8_t * value_data_item, uint16_t value_data_item_len, uint16_t * offset);
+void cbor_set_map_signed_type(cbor_writer_t * p_writer, uint32_t key_data_item, int32_t value_data_item);
+// Encodes cbor map for byte array type, the value is copied in reverse byte order
+void cbor_set_map_byte_string_type(cbor_writer_t * p_writer, uint32_t key_data_item, const uint8_t * value_data_item, uint16_t value_data_item_len);
 
 #endif //_PROTECTED_UPDATE_CBOR_H_
 /**
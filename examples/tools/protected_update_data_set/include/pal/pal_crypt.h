@@ -60,6 +60,15 @@ pal_status_t pal_crypt_hash(pal_crypt_t* p_pal_crypt,
                             uint32_t message_length,
                             uint8_t * p_digest);
 
+// Generates hash on a message which is provided in two parts, e.g. fragment payload and digest of the next fragment
+pal_status_t pal_crypt_hash_parts(  pal_crypt_t* p_pal_crypt,
+                                    uint8_t hash_algorithm,
+                                    const uint8_t * p_message,
+                                    uint32_t message_length,
+                                    const uint8_t * p_message_tail,
+                                    uint32_t message_tail_length,
+                                    uint8_t * p_digest);
+
 // Calculates signature
 pal_status_t pal_crypt_sign(pal_crypt_t* p_pal_crypt,
                             uint8_t * p_digest, 
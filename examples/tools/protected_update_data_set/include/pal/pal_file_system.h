@@ -53,6 +53,15 @@ int32_t pal_file_system_read_file_to_array_in_hex(  const int8_t * file_name,
 int32_t pal_file_system_write_to_file( const int8_t * file_name, 
                                                 int8_t * byte_array, 
                                                 uint16_t byte_array_length);
+
+// Maps the file to memory for read access, the content is not copied
+int32_t pal_file_system_map_file(   const int8_t * file_name,
+                                    const uint8_t ** byte_array,
+                                    uint32_t * byte_array_length,
+                                    void ** mapping);
+
+// Unmaps the file mapped by pal_file_system_map_file
+void pal_file_system_unmap_file(void * mapping);
 #endif //_PROTECTED_UPDATE_PAL_FILE_SYSTEM_
 
 /**
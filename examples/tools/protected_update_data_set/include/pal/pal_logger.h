@@ -56,6 +56,9 @@ void pal_logger_print_variable_name(uint8_t * var_name, uint8_t value);
 // Prints data in file
 void pal_logger_print_to_file(int8_t * byte_array, uint16_t size);
 
+// Enables or disables the console output, the output to file is not affected
+void pal_logger_enable_console(uint8_t enable);
+
 #endif //_PROTECTED_UPDATE_PAL_LOGGER_H_
 
 /**
@@ -0,0 +1,62 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file protected_update_batch.h
+*
+* \brief   This file defines APIs used for the batch creation of protected update data sets.
+*
+* \ingroup  grProtectedUpdateTool
+*
+* @{
+*/
+
+#ifndef _PROTECTED_UPDATE_BATCH_H_
+#define _PROTECTED_UPDATE_BATCH_H_
+
+#include <stdint.h>
+
+#define BATCH_OPTION_FILE                       "batch"
+#define BATCH_OPTION_BUNDLE                     "bundle"
+#define BATCH_OPTION_SHARD                      "shard"
+
+// Maximum length of a line in the batch file
+#define BATCH_MAX_LINE_LENGTH                   (2048U)
+// Maximum number of options of a device, including the common options of the command line
+#define BATCH_MAX_OPTIONS                       (64U)
+
+//  Checks if the command line requests the batch mode (batch=<file>)
+int32_t protected_update_batch_requested(int32_t argc, int8_t *argv[]);
+
+//  Creates the data sets of all the devices in the batch file and writes them to the bundle
+int32_t protected_update_batch_run(int32_t argc, int8_t *argv[]);
+
+#endif //_PROTECTED_UPDATE_BATCH_H_
+
+/**
+* @}
+*/
@@ -140,8 +140,10 @@ typedef struct data_payload
 {
     uint32_t offset_in_oid;
     uint8_t * data;
-    uint16_t data_length;
+    uint32_t data_length;
     uint8_t write_type;
+    // Mapping of the binary data file, the data is not copied to memory
+    void * data_mapping;
 }data_payload_t;
 
 typedef struct ecc_key
@@ -228,17 +230,22 @@ typedef struct manifest
     // payload metadata
     metadata_payload_t * p_metadata_payload;
 
+    // Fragments are streamed to this file instead of being created in memory
+    const int8_t * fragments_file_path;
+
 } manifest_t;
 
 // Structure to store protect update data set
 typedef struct protected_update_data_set
 {
     uint8_t * data;
-    uint16_t data_length;
+    uint32_t data_length;
 
     uint8_t * fragments;
-    uint16_t fragments_length;
-    uint16_t actual_memory_allocated;
+    uint32_t fragments_length;
+    uint32_t actual_memory_allocated;
+    // Digest of the first fragment, which is part of the manifest
+    uint8_t first_fragment_digest[FRAGMENT_DIGEST_LENGTH];
 
 }protected_update_data_set_d;
 
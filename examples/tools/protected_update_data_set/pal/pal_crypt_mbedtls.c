@@ -52,7 +52,9 @@
 #include "pal\pal_logger.h"
 
 static uint16_t pal_crypt_calculate_sha256_hash(    const uint8_t * message,
-                                            uint16_t message_len,
+                                            uint32_t message_len,
+                                            const uint8_t * message_tail,
+                                            uint32_t message_tail_len,
                                             uint8_t * digest)
 {
     uint16_t status = 1;
@@ -71,6 +73,11 @@ static uint16_t pal_crypt_calculate_sha256_hash(    const uint8_t * message,
             pal_logger_print_message(" Error : Failed in mbedtls_sha256_update_ret\n");
             break;
         }
+        if ((0 != message_tail_len) && (0 != mbedtls_sha256_update_ret(&sha256_ctx, message_tail, message_tail_len)))
+        {
+            pal_logger_print_message(" Error : Failed in mbedtls_sha256_update_ret\n");
+            break;
+        }
 
         if (0 != mbedtls_sha256_finish_ret(&sha256_ctx, digest))
         {
@@ -94,7 +101,26 @@ pal_status_t pal_crypt_hash( pal_crypt_t* p_pal_crypt,
 
     if((uint8_t)eSHA_256 == hash_algorithm) // SHA-256
     {
-        status = pal_crypt_calculate_sha256_hash(p_message, (uint16_t)message_length, p_digest);
+        status = pal_crypt_calculate_sha256_hash(p_message, message_length, NULL, 0, p_digest);
+    }
+
+    return status;
+}
+
+//lint --e{715} suppress "argument "p_pal_crypt" is not used in the implementation but kept for future use"
+pal_status_t pal_crypt_hash_parts(  pal_crypt_t* p_pal_crypt,
+                                    uint8_t hash_algorithm,
+                                    const uint8_t * p_message,
+                                    uint32_t message_length,
+                                    const uint8_t * p_message_tail,
+                                    uint32_t message_tail_length,
+                                    uint8_t * p_digest)
+{
+    pal_status_t status = 1;
+
+    if((uint8_t)eSHA_256 == hash_algorithm) // SHA-256
+    {
+        status = pal_crypt_calculate_sha256_hash(p_message, message_length, p_message_tail, message_tail_length, p_digest);
     }
 
     return status;
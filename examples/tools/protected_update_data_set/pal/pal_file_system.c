@@ -36,9 +36,29 @@
 */
 #include <stdio.h>
 #include <stdlib.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "pal\pal_file_system.h"
 #include "pal\pal_logger.h"
 #include "pal\pal_os_memory.h"
 
+// Mapping of a file, returned by pal_file_system_map_file
+typedef struct pal_file_system_mapping
+{
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE file_mapping;
+#endif
+    void * view;
+    uint32_t length;
+}pal_file_system_mapping_t;
+
 int32_t pal_file_system_read_file_to_array( const int8_t * file_name, 
                                         uint8_t ** byte_array, 
                                         uint16_t * byte_array_length)
@@ -190,6 +210,131 @@ int32_t pal_file_system_write_to_file( const int8_t * file_name,
     return status;
 }
 
+int32_t pal_file_system_map_file(   const int8_t * file_name,
+                                    const uint8_t ** byte_array,
+                                    uint32_t * byte_array_length,
+                                    void ** mapping)
+{
+    int32_t status = -1;
+    pal_file_system_mapping_t * p_mapping = NULL;
+#ifdef _WIN32
+    LARGE_INTEGER file_size;
+#else
+    int32_t fd = -1;
+    struct stat file_stat;
+#endif
+
+    do
+    {
+        if (NULL == file_name)
+        {
+            pal_logger_print_message(" Error : File name is NULL\n");
+            break;
+        }
+        p_mapping = (pal_file_system_mapping_t *)pal_os_calloc(1, sizeof(pal_file_system_mapping_t));
+        if (NULL == p_mapping)
+        {
+            break;
+        }
+#ifdef _WIN32
+        p_mapping->file = CreateFileA(file_name, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (INVALID_HANDLE_VALUE == p_mapping->file)
+        {
+            p_mapping->file = NULL;
+            pal_logger_print_message(" Error : Failed in CreateFile\n");
+            break;
+        }
+        // Empty files cannot be mapped, files larger than 4GB are not supported
+        if ((0 == GetFileSizeEx(p_mapping->file, &file_size)) || (0 == file_size.QuadPart) || (0 != file_size.HighPart))
+        {
+            pal_logger_print_message(" Error : File size is not supported\n");
+            break;
+        }
+        p_mapping->length = file_size.LowPart;
+        p_mapping->file_mapping = CreateFileMappingA(p_mapping->file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (NULL == p_mapping->file_mapping)
+        {
+            pal_logger_print_message(" Error : Failed in CreateFileMapping\n");
+            break;
+        }
+        p_mapping->view = MapViewOfFile(p_mapping->file_mapping, FILE_MAP_READ, 0, 0, 0);
+        if (NULL == p_mapping->view)
+        {
+            pal_logger_print_message(" Error : Failed in MapViewOfFile\n");
+            break;
+        }
+#else
+        fd = open(file_name, O_RDONLY);
+        if (-1 == fd)
+        {
+            pal_logger_print_message(" Error : Failed in open\n");
+            break;
+        }
+        // Empty files cannot be mapped, files larger than 4GB are not supported
+        if ((0 != fstat(fd, &file_stat)) || (0 == file_stat.st_size) || (0xFFFFFFFF < (uint64_t)file_stat.st_size))
+        {
+            pal_logger_print_message(" Error : File size is not supported\n");
+            break;
+        }
+        p_mapping->length = (uint32_t)file_stat.st_size;
+        p_mapping->view = mmap(NULL, p_mapping->length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (MAP_FAILED == p_mapping->view)
+        {
+            p_mapping->view = NULL;
+            pal_logger_print_message(" Error : Failed in mmap\n");
+            break;
+        }
+#endif
+        *byte_array = (const uint8_t *)p_mapping->view;
+        *byte_array_length = p_mapping->length;
+        *mapping = p_mapping;
+        p_mapping = NULL;
+        status = 0;
+    } while (0);
+
+#ifndef _WIN32
+    // The mapping remains valid after the file is closed
+    if (-1 != fd)
+    {
+        (void)close(fd);
+    }
+#endif
+    if (NULL != p_mapping)
+    {
+        pal_file_system_unmap_file(p_mapping);
+    }
+    return status;
+}
+
+void pal_file_system_unmap_file(void * mapping)
+{
+    pal_file_system_mapping_t * p_mapping = (pal_file_system_mapping_t *)mapping;
+
+    if (NULL != p_mapping)
+    {
+#ifdef _WIN32
+        if (NULL != p_mapping->view)
+        {
+            (void)UnmapViewOfFile(p_mapping->view);
+        }
+        if (NULL != p_mapping->file_mapping)
+        {
+            (void)CloseHandle(p_mapping->file_mapping);
+        }
+        if (NULL != p_mapping->file)
+        {
+            (void)CloseHandle(p_mapping->file);
+        }
+#else
+        if (NULL != p_mapping->view)
+        {
+            (void)munmap(p_mapping->view, p_mapping->length);
+        }
+#endif
+        pal_os_free(p_mapping);
+    }
+}
+
 /**
 * @}
 */
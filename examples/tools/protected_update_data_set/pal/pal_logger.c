@@ -42,8 +42,14 @@
 
 const uint8_t * dataset_file_path = NULL;
 
+static uint8_t pal_logger_console_enabled = 1;
+
 void pal_logger_print_byte(uint8_t datam)
 {
+    if (0 == pal_logger_console_enabled)
+    {
+        return;
+    }
 #if PRINT_C_CODE_FORMAT_ENABLED
     printf("0x%02X, ", datam);
 #else
@@ -55,6 +61,10 @@ void pal_logger_print_byte(uint8_t datam)
 
 void pal_logger_print_message(const int8_t * str)
 {
+    if (0 == pal_logger_console_enabled)
+    {
+        return;
+    }
     printf("%s", str);
 }
 
@@ -68,6 +78,10 @@ void pal_logger_print_hex_data( const uint8_t * data,
 {
     uint32_t  count = data_len;
     uint32_t  index;
+    if (0 == pal_logger_console_enabled)
+    {
+        return;
+    }
     for (index = 0; index < count; index++)
     {
         pal_logger_print_byte(data[index]);
@@ -82,6 +96,10 @@ void pal_logger_print_hex_data( const uint8_t * data,
 void pal_logger_print_variable_name(uint8_t * var_name, 
                                     uint8_t value)
 {
+    if (0 == pal_logger_console_enabled)
+    {
+        return;
+    }
 #if PRINT_C_CODE_FORMAT_ENABLED
     if (NULL != var_name)
     {
@@ -113,6 +131,11 @@ void pal_logger_print_to_file(int8_t * byte_array, uint16_t size)
     } 
 }
 
+void pal_logger_enable_console(uint8_t enable)
+{
+    pal_logger_console_enabled = enable;
+}
+
 /**
 * @}
 */
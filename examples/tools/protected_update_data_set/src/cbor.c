@@ -35,8 +35,8 @@
 * @{
 */
 
+#include <string.h>
 #include "cbor.h"
-#include "common_utilites.h" 
 
 #define CBOR_MAJOR_TYPE_0                   (0x00)
 #define CBOR_MAJOR_TYPE_1                   (0x20)
@@ -52,105 +52,133 @@
 #define CBOR_ADDITIONAL_TYPE_0x19           (0x19)
 #define CBOR_ADDITIONAL_TYPE_0x1A           (0x1A)
 
-static int32_t cbor_encode_data(uint8_t * buffer, uint32_t value, uint16_t * offset, uint8_t major_type)
+// Writes the byte, if the writer has a buffer. Else only the size is counted
+static void cbor_write_byte(cbor_writer_t * p_writer, uint8_t value)
 {
-    int32_t status = 0;
-    if (CBOR_ADDITIONAL_TYPE_0x17 >= value)
+    if (NULL != p_writer->buffer)
     {
-        buffer[*offset] = (uint8_t)(major_type | value);
-        (*offset)++;
+        p_writer->buffer[p_writer->offset] = value;
     }
-    else if ((CBOR_ADDITIONAL_TYPE_0x17 < value) && (0xFF >= value))
+    p_writer->offset++;
+}
+
+static void cbor_encode_data(cbor_writer_t * p_writer, uint32_t value, uint8_t major_type)
+{
+    uint8_t count;
+    uint8_t index;
+
+    if (CBOR_ADDITIONAL_TYPE_0x17 >= value)
     {
-        buffer[*offset] = (major_type | CBOR_ADDITIONAL_TYPE_0x18);
-        (*offset)++;
-        buffer[*offset] = (uint8_t)value;
-        (*offset)++;
+        cbor_write_byte(p_writer, (uint8_t)(major_type | value));
+        return;
     }
-    else if ((0xFF < value) && (0xFFFF >= value))
+    if (0xFF >= value)
     {
-        buffer[*offset] = (major_type | CBOR_ADDITIONAL_TYPE_0x19);
-        (*offset)++;
-        protected_tool_common_set_uint16(&buffer[*offset], offset, (uint16_t)value);
+        cbor_write_byte(p_writer, (major_type | CBOR_ADDITIONAL_TYPE_0x18));
+        count = 1;
     }
-    else if (0xFFFF < value)
+    else if (0xFFFF >= value)
     {
-        buffer[*offset] = (major_type | CBOR_ADDITIONAL_TYPE_0x1A);
-        (*offset)++;
-        protected_tool_common_set_uint32(&buffer[*offset], offset, value);
+        cbor_write_byte(p_writer, (major_type | CBOR_ADDITIONAL_TYPE_0x19));
+        count = 2;
     }
     else
     {
-        status = -1;
+        cbor_write_byte(p_writer, (major_type | CBOR_ADDITIONAL_TYPE_0x1A));
+        count = 4;
     }
-    return status;
+    for (index = count; index > 0; index--)
+    {
+        cbor_write_byte(p_writer, (uint8_t)(value >> ((index - 1) * 8)));
+    }
+}
+
+void cbor_writer_init(cbor_writer_t * p_writer, uint8_t * buffer, uint32_t offset)
+{
+    p_writer->buffer = buffer;
+    p_writer->offset = offset;
+}
+
+uint32_t cbor_get_head_size(uint32_t value)
+{
+    cbor_writer_t size_writer;
 
+    cbor_writer_init(&size_writer, NULL, 0);
+    cbor_encode_data(&size_writer, value, CBOR_MAJOR_TYPE_0);
+    return size_writer.offset;
 }
 
-int32_t cbor_set_null(uint8_t * buffer, uint16_t * offset)
+void cbor_set_null(cbor_writer_t * p_writer)
 {
-    buffer[*offset] = CBOR_MAJOR_TYPE_7;
-    *offset += 1;
-    return 1;
+    cbor_write_byte(p_writer, CBOR_MAJOR_TYPE_7);
 }
 
-int32_t cbor_set_array_of_data(uint8_t * buffer,uint32_t value ,uint16_t * offset)
+void cbor_set_array_of_data(cbor_writer_t * p_writer, uint32_t value)
 {
-    buffer[*offset] = (CBOR_MAJOR_TYPE_4 | (uint8_t)value);
-    *offset += 1;
-    return 1;
+    cbor_encode_data(p_writer, value, CBOR_MAJOR_TYPE_4);
 }
 
-int32_t cbor_set_unsigned_integer(uint8_t * buffer, uint32_t value, uint16_t * offset)
+void cbor_set_unsigned_integer(cbor_writer_t * p_writer, uint32_t value)
 {
-    return (cbor_encode_data(buffer, value, offset, CBOR_MAJOR_TYPE_0));
+    cbor_encode_data(p_writer, value, CBOR_MAJOR_TYPE_0);
 }
 
 //lint --e{702, 737} suppress "Shifting an int value"
-int32_t cbor_set_signed_integer(uint8_t * buffer, int32_t value, uint16_t * offset)
+void cbor_set_signed_integer(cbor_writer_t * p_writer, int32_t value)
 {
     /* adapted from code in RFC 7049 appendix C (pseudocode) */
     uint32_t temp_value = (value >> 31);              /* extend sign to whole length */
     temp_value ^= value;                            /* complement negatives */
-    return (cbor_encode_data(buffer, temp_value, offset, CBOR_MAJOR_TYPE_1));
+    cbor_encode_data(p_writer, temp_value, (value < 0) ? CBOR_MAJOR_TYPE_1 : CBOR_MAJOR_TYPE_0);
+}
+
+void cbor_set_byte_string(cbor_writer_t * p_writer, uint32_t value)
+{
+    cbor_encode_data(p_writer, value, CBOR_MAJOR_TYPE_2);
+}
+
+void cbor_set_data(cbor_writer_t * p_writer, const uint8_t * data, uint32_t data_length)
+{
+    if ((NULL != p_writer->buffer) && (0 != data_length))
+    {
+        memcpy(&p_writer->buffer[p_writer->offset], data, data_length);
+    }
+    p_writer->offset += data_length;
 }
 
-int32_t cbor_set_byte_string(uint8_t * buffer, uint32_t value, uint16_t * offset)
+void cbor_set_byte_string_data(cbor_writer_t * p_writer, const uint8_t * data, uint32_t data_length)
 {
-    return (cbor_encode_data(buffer, value, offset, CBOR_MAJOR_TYPE_2));
+    cbor_set_byte_string(p_writer, data_length);
+    cbor_set_data(p_writer, data, data_length);
 }
 
-void cbor_set_map_tag(uint8_t * buffer, uint8_t map_number, uint16_t * offset)
+void cbor_set_map_tag(cbor_writer_t * p_writer, uint8_t map_number)
 {
-    (void)cbor_encode_data(buffer, map_number, offset, CBOR_MAJOR_TYPE_5);
+    cbor_encode_data(p_writer, map_number, CBOR_MAJOR_TYPE_5);
 }
 
-int32_t cbor_set_map_unsigned_type(uint8_t * buffer, uint32_t key_data_item, uint32_t value_data_item, uint16_t * offset)
+void cbor_set_map_unsigned_type(cbor_writer_t * p_writer, uint32_t key_data_item, uint32_t value_data_item)
 {
-    (void)cbor_set_unsigned_integer(buffer, key_data_item, offset);
-    (void)cbor_set_unsigned_integer(buffer, value_data_item, offset);
-    return 1;
+    cbor_set_unsigned_integer(p_writer, key_data_item);
+    cbor_set_unsigned_integer(p_writer, value_data_item);
 }
 
-int32_t cbor_set_map_signed_type(uint8_t * buffer, uint32_t key_data_item, int32_t value_data_item, uint16_t * offset)
+void cbor_set_map_signed_type(cbor_writer_t * p_writer, uint32_t key_data_item, int32_t value_data_item)
 {
-    (void)cbor_set_unsigned_integer(buffer, key_data_item, offset);
-    (void)cbor_set_signed_integer(buffer, value_data_item, offset);
-    return 1;
+    cbor_set_unsigned_integer(p_writer, key_data_item);
+    cbor_set_signed_integer(p_writer, value_data_item);
 }
 
-int32_t cbor_set_map_byte_string_type(uint8_t * buffer, uint32_t key_data_item, const uint8_t * value_data_item, uint16_t value_data_item_len, uint16_t * offset)
+void cbor_set_map_byte_string_type(cbor_writer_t * p_writer, uint32_t key_data_item, const uint8_t * value_data_item, uint16_t value_data_item_len)
 {
     uint16_t index;
 
-    (void)cbor_set_unsigned_integer(buffer, key_data_item, offset);
-    (void)cbor_set_byte_string(buffer, value_data_item_len, offset);
+    cbor_set_unsigned_integer(p_writer, key_data_item);
+    cbor_set_byte_string(p_writer, value_data_item_len);
     for(index = 0; index < value_data_item_len; index++)
     {
-        buffer[*offset] = *(((uint8_t *)value_data_item) + ((value_data_item_len - index) - 1));
-        (*offset)++;
+        cbor_write_byte(p_writer, *(value_data_item + ((value_data_item_len - index) - 1)));
     }
-    return 1;
 }
 
 /**
@@ -0,0 +1,403 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file protected_update_batch.c
+*
+* \brief   This file implements the batch creation of protected update data sets, one data set per device of the batch file.
+*
+* \details
+* Each line of the batch file provides the options of one device (e.g. payload_version, target_oid, secret, data),
+* in the same option=value format as the command line, separated by spaces, tabs or commas. Empty lines and lines
+* starting with '#' are skipped. The options of the command line (except batch, bundle and shard) are common to all
+* the devices and are overridden by the options of the line.
+*
+* The data sets are written to the bundle file as records, all the fields are big endian:
+*   line number (4 bytes) | target oid (2 bytes) | manifest length (2 bytes) | manifest |
+*   fragments length (4 bytes) | fragments (MAX_PAYLOAD_SIZE bytes each, except the last one)
+*
+* To use all the cores of the host, the batch file is shared by several instances of the tool using shard=<index>/<count>,
+* each instance creates the devices with (device number % count) == index. The bundle files of the instances
+* are concatenated (e.g. copy /b bundle_0.bin + bundle_1.bin bundle.bin), since the records are self contained.
+*
+* \ingroup  grProtectedUpdateTool
+*
+* @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "protected_update_data_set.h"
+#include "protected_update_batch.h"
+#include "user_input_parser.h"
+#include "pal\pal_logger.h"
+#include "pal\pal_os_memory.h"
+
+#define BATCH_OPTION_SEPARATORS                 " \t,"
+
+// Batch options of the command line
+typedef struct batch_config
+{
+    const int8_t * batch_file_path;
+    const int8_t * bundle_file_path;
+    uint32_t shard_index;
+    uint32_t shard_count;
+}batch_config_t;
+
+// Options of the command line, which are common to all the devices
+static int8_t batch_common_options[BATCH_MAX_LINE_LENGTH];
+static int8_t batch_line[BATCH_MAX_LINE_LENGTH];
+// Options of the device, the parser terminates the option names in place and keeps pointers to the values
+static int8_t batch_device_options[2 * BATCH_MAX_LINE_LENGTH];
+static int8_t * batch_argv[BATCH_MAX_OPTIONS + 1];
+static int8_t buffer[200];
+
+// Returns the value, if the argument is the given option
+_STATIC_H int8_t * batch_get_option_value(int8_t * p_argument, const int8_t * p_option)
+{
+    int8_t * p_value = NULL;
+    size_t option_length = strlen(p_option);
+
+    if ((0 == strncmp(p_argument, p_option, option_length)) && ('=' == p_argument[option_length]))
+    {
+        p_value = &p_argument[option_length + 1];
+    }
+    return p_value;
+}
+
+// Prints the message on console, which is disabled while the data sets are created
+_STATIC_H void batch_print_message(const int8_t * p_message)
+{
+    pal_logger_enable_console(1);
+    pal_logger_print_message(p_message);
+    pal_logger_enable_console(0);
+}
+
+_STATIC_H int32_t batch_get_config(int32_t argc, int8_t *argv[], batch_config_t * p_config)
+{
+    int32_t status = -1;
+    int32_t i;
+    int8_t * p_value;
+    int8_t * p_count;
+    size_t length = 0;
+
+    p_config->batch_file_path = NULL;
+    p_config->bundle_file_path = NULL;
+    p_config->shard_index = 0;
+    p_config->shard_count = 1;
+    batch_common_options[0] = '\0';
+
+    do
+    {
+        for (i = 1; i < argc; i++)
+        {
+            if (NULL != (p_value = batch_get_option_value(argv[i], BATCH_OPTION_FILE)))
+            {
+                p_config->batch_file_path = p_value;
+            }
+            else if (NULL != (p_value = batch_get_option_value(argv[i], BATCH_OPTION_BUNDLE)))
+            {
+                p_config->bundle_file_path = p_value;
+            }
+            else if (NULL != (p_value = batch_get_option_value(argv[i], BATCH_OPTION_SHARD)))
+            {
+                p_count = strchr(p_value, '/');
+                if (NULL == p_count)
+                {
+                    break;
+                }
+                p_config->shard_index = (uint32_t)strtoul(p_value, NULL, 10);
+                p_config->shard_count = (uint32_t)strtoul(p_count + 1, NULL, 10);
+            }
+            else
+            {
+                length += strlen(argv[i]) + 1;
+                if (sizeof(batch_common_options) <= length)
+                {
+                    break;
+                }
+                strcat(batch_common_options, argv[i]);
+                strcat(batch_common_options, " ");
+            }
+        }
+        if (i != argc)
+        {
+            pal_logger_print_message("Error : Invalid batch option or too many common options provided\n");
+            break;
+        }
+        if ((NULL == p_config->batch_file_path) || (NULL == p_config->bundle_file_path))
+        {
+            pal_logger_print_message("Error : Batch mode requires batch=<batch file> and bundle=<bundle file>\n");
+            break;
+        }
+        if ((0 == p_config->shard_count) || (p_config->shard_index >= p_config->shard_count))
+        {
+            pal_logger_print_message("Error : Invalid shard provided, expected shard=<index>/<count>\n");
+            break;
+        }
+        status = 0;
+    } while (0);
+    return status;
+}
+
+// Splits the common options and the options of the device into the arguments of the parser
+_STATIC_H int32_t batch_get_device_arguments(const int8_t * p_line, int32_t * p_argc)
+{
+    int32_t status = -1;
+    int32_t argc = 0;
+    int8_t * p_token;
+
+    do
+    {
+        if (sizeof(batch_device_options) <= (strlen(batch_common_options) + strlen(p_line)))
+        {
+            break;
+        }
+        strcpy(batch_device_options, batch_common_options);
+        strcat(batch_device_options, p_line);
+
+        batch_argv[argc++] = "batch";
+        for (p_token = strtok(batch_device_options, BATCH_OPTION_SEPARATORS);
+             NULL != p_token;
+             p_token = strtok(NULL, BATCH_OPTION_SEPARATORS))
+        {
+            if (BATCH_MAX_OPTIONS < argc)
+            {
+                break;
+            }
+            batch_argv[argc++] = p_token;
+        }
+        if (NULL != p_token)
+        {
+            break;
+        }
+        *p_argc = argc;
+        status = 0;
+    } while (0);
+    return status;
+}
+
+_STATIC_H void batch_write_u16(FILE * p_bundle, uint16_t value)
+{
+    (void)fputc((value >> 8) & 0xFF, p_bundle);
+    (void)fputc(value & 0xFF, p_bundle);
+}
+
+_STATIC_H void batch_write_u32(FILE * p_bundle, uint32_t value)
+{
+    batch_write_u16(p_bundle, (uint16_t)(value >> 16));
+    batch_write_u16(p_bundle, (uint16_t)value);
+}
+
+// Writes the data set of the device as a record to the bundle
+_STATIC_H int32_t batch_write_record(FILE * p_bundle,
+                                     uint32_t line_number,
+                                     const manifest_t * p_manifest,
+                                     const protected_update_data_set_d * p_data_set)
+{
+    int32_t status = -1;
+    // Fragments streamed to a fragments file (fragments_to_file) are not part of the bundle
+    uint32_t fragments_length = (NULL != p_data_set->fragments) ? p_data_set->fragments_length : 0;
+
+    batch_write_u32(p_bundle, line_number);
+    batch_write_u16(p_bundle, p_manifest->target_oid);
+    batch_write_u16(p_bundle, (uint16_t)p_data_set->data_length);
+    if (p_data_set->data_length == fwrite(p_data_set->data, 1, p_data_set->data_length, p_bundle))
+    {
+        batch_write_u32(p_bundle, fragments_length);
+        if (fragments_length == fwrite(p_data_set->fragments, 1, fragments_length, p_bundle))
+        {
+            status = (0 == ferror(p_bundle)) ? 0 : -1;
+        }
+    }
+    return status;
+}
+
+// Creates the data set of a device, same as a single invocation of the tool
+_STATIC_H int32_t batch_create_data_set(int32_t argc,
+                                        manifest_t * p_manifest,
+                                        protected_update_data_set_d * p_data_set)
+{
+    int32_t status = -1;
+
+    do
+    {
+        if (0 != tool_get_user_inputs(argc, batch_argv))
+        {
+            break;
+        }
+        if (0 != tool_set_user_inputs(p_manifest))
+        {
+            break;
+        }
+        if (0 != protected_update_create_fragments(p_manifest, p_data_set))
+        {
+            break;
+        }
+        if (0 != protected_update_create_manifest(p_manifest, p_data_set))
+        {
+            break;
+        }
+        status = 0;
+    } while (0);
+    return status;
+}
+
+int32_t protected_update_batch_requested(int32_t argc, int8_t *argv[])
+{
+    int32_t requested = 0;
+    int32_t i;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (NULL != batch_get_option_value(argv[i], BATCH_OPTION_FILE))
+        {
+            requested = 1;
+            break;
+        }
+    }
+    return requested;
+}
+
+int32_t protected_update_batch_run(int32_t argc, int8_t *argv[])
+{
+    int32_t status = -1;
+    batch_config_t config;
+    FILE * p_batch = NULL;
+    FILE * p_bundle = NULL;
+    manifest_t * p_manifest = NULL;
+    protected_update_data_set_d data_set = { 0 };
+    uint32_t line_number = 0;
+    uint32_t device_number = 0;
+    uint32_t created_count = 0;
+    uint32_t failed_count = 0;
+    int32_t device_argc;
+    size_t length;
+
+    do
+    {
+        if (0 != batch_get_config(argc, argv, &config))
+        {
+            break;
+        }
+        p_manifest = (manifest_t *)pal_os_calloc(1, sizeof(manifest_t));
+        if (NULL == p_manifest)
+        {
+            break;
+        }
+        p_batch = fopen(config.batch_file_path, "r");
+        if (NULL == p_batch)
+        {
+            pal_logger_print_message("Error : Unable to open the batch file\n");
+            break;
+        }
+        p_bundle = fopen(config.bundle_file_path, "wb");
+        if (NULL == p_bundle)
+        {
+            pal_logger_print_message("Error : Unable to open the bundle file\n");
+            break;
+        }
+
+        // The output of the single data set is not printed per device
+        pal_logger_enable_console(0);
+        while (NULL != fgets(batch_line, sizeof(batch_line), p_batch))
+        {
+            line_number++;
+            length = strlen(batch_line);
+            while ((0 != length) && (('\n' == batch_line[length - 1]) || ('\r' == batch_line[length - 1])))
+            {
+                batch_line[--length] = '\0';
+            }
+            if ((0 == length) || ('#' == batch_line[0]))
+            {
+                continue;
+            }
+            if ((device_number++ % config.shard_count) != config.shard_index)
+            {
+                continue;
+            }
+
+            status = batch_get_device_arguments(batch_line, &device_argc);
+            if (0 == status)
+            {
+                status = batch_create_data_set(device_argc, p_manifest, &data_set);
+            }
+            if (0 == status)
+            {
+                status = batch_write_record(p_bundle, line_number, p_manifest, &data_set);
+            }
+            if (0 == status)
+            {
+                created_count++;
+            }
+            else
+            {
+                failed_count++;
+                sprintf(buffer, "Error : Unable to create the data set of line %u\n", line_number);
+                batch_print_message(buffer);
+            }
+
+            // The inputs and the data set are freed per device
+            (void)tool_clear_inputs(p_manifest);
+            pal_os_memset(p_manifest, 0, sizeof(manifest_t));
+            if (NULL != data_set.data)
+            {
+                pal_os_free(data_set.data);
+            }
+            if (NULL != data_set.fragments)
+            {
+                pal_os_free(data_set.fragments);
+            }
+            pal_os_memset(&data_set, 0, sizeof(data_set));
+        }
+        pal_logger_enable_console(1);
+
+        sprintf(buffer, "Info : Batch completed, data sets created : %u, failed : %u\n", created_count, failed_count);
+        pal_logger_print_message(buffer);
+        status = (0 == failed_count) ? 0 : -1;
+    } while (0);
+
+    pal_logger_enable_console(1);
+    if (NULL != p_bundle)
+    {
+        (void)fclose(p_bundle);
+    }
+    if (NULL != p_batch)
+    {
+        (void)fclose(p_batch);
+    }
+    if (NULL != p_manifest)
+    {
+        pal_os_free(p_manifest);
+    }
+    return status;
+}
+
+/**
+* @}
+*/
@@ -45,6 +45,7 @@
 #include "common_utilites.h" 
 
 #define PROTECT_UPDATE_MANIFEST_VERSION             (1U)
+#define COUID_SIZE                                  (25U)
 
 #define TAG_SIZE                                    (1U)
 #define LENGTH_SIZE                                 (2U)
@@ -78,18 +79,15 @@
 
 // This will be replaced by code
 const int8_t signature_string[] = "Signature1";
-uint8_t  signature_header[25];
-
-uint8_t  local_manifest_buffer[550];
 extern uint8_t * dataset_file_path;
 
 // Prints protected update manifest and fragment to console
 static void protected_update_print_output_to_console(const protected_update_data_set_d * p_cbor_manifest)
 {
-    uint16_t  count = p_cbor_manifest->data_length;
-    uint16_t  index;
-    uint16_t  fragment_length;
-    uint8_t fragment_number;
+    uint32_t  count = p_cbor_manifest->data_length;
+    uint32_t  index;
+    uint32_t  fragment_length;
+    uint32_t fragment_number;
     int8_t buffer[100] = {0};
 
     // Print manifest
@@ -110,8 +108,8 @@ static void protected_update_print_output_to_console(const protected_update_data
     pal_logger_print_variable_name(NULL,0);
     pal_logger_print_message("");
 
-    // Print fragment
-    count = p_cbor_manifest->fragments_length;
+    // Print fragment, unless streamed to the fragments file
+    count = (NULL != p_cbor_manifest->fragments) ? p_cbor_manifest->fragments_length : 0;
     memset(buffer, 0x00, sizeof(buffer));
 
     for (index = 0; index < count; index++)
@@ -125,10 +123,10 @@ static void protected_update_print_output_to_console(const protected_update_data
             { 
                 pal_logger_print_variable_name(NULL, 0);
             }
-            sprintf(buffer, "\n\nFragment number:[%02d], size:[%03d]\n\t", ((uint8_t)(index / MAX_PAYLOAD_SIZE)+1), fragment_length);
+            sprintf(buffer, "\n\nFragment number:[%02d], size:[%03d]\n\t", ((index / MAX_PAYLOAD_SIZE)+1), fragment_length);
             pal_logger_print_message(buffer);
             pal_logger_print_variable_name((uint8_t  *)"fragment", (uint8_t )(index / MAX_PAYLOAD_SIZE) + 1);
-            fragment_number = (uint8_t )(index / MAX_PAYLOAD_SIZE) + 1;  
+            fragment_number = (index / MAX_PAYLOAD_SIZE) + 1;  
             sprintf(buffer, "uint8_t fragment_%02d[] = \n\t{\n\t", fragment_number);
         }
         pal_logger_print_byte(p_cbor_manifest->fragments[index]);
@@ -148,10 +146,10 @@ static void protected_update_print_output_to_console(const protected_update_data
 // Prints protected update manifest and fragment to file
 static void protected_update_print_output_to_file(const protected_update_data_set_d * p_cbor_manifest)
 {
-    uint16_t  count = p_cbor_manifest->data_length;
-    uint16_t  index;
-    uint16_t  fragment_length = 0;
-    uint8_t fragment_number = 0;
+    uint32_t  count = p_cbor_manifest->data_length;
+    uint32_t  index;
+    uint32_t  fragment_length = 0;
+    uint32_t fragment_number = 0;
     int8_t buffer[100] = {0};  
 
     // print manifest to file
@@ -169,8 +167,8 @@ static void protected_update_print_output_to_file(const protected_update_data_se
     }
     pal_logger_print_to_file("\n\t};\n", 0);
 
-    // print fragment to file
-    count = p_cbor_manifest->fragments_length;
+    // print fragment to file, unless streamed to the fragments file
+    count = (NULL != p_cbor_manifest->fragments) ? p_cbor_manifest->fragments_length : 0;
     memset(buffer, 0x00, sizeof(buffer));
     for (index = 0; index < count; index++)
     {
@@ -184,7 +182,7 @@ static void protected_update_print_output_to_file(const protected_update_data_se
                 pal_logger_print_to_file("};\n", 0);
             }
             pal_logger_print_to_file("\n", 0);
-            fragment_number = (uint8_t )(index / MAX_PAYLOAD_SIZE) + 1;  
+            fragment_number = (index / MAX_PAYLOAD_SIZE) + 1;  
             sprintf(buffer, "\tuint8_t fragment_%02d[] = \n\t{\n\t\t", fragment_number);
             pal_logger_print_to_file(buffer, 0);
         }
@@ -680,6 +678,7 @@ _STATIC_H void protected_update_prepare_associated_data(manifest_t * manifest_da
 }
 
 _STATIC_H int32_t protected_update_encrypt_fragment(   manifest_t * manifest_data,
+                                                const uint8_t  * p_plain_text,
                                                 uint8_t  * p_current_fragment,
                                                 uint16_t  fragment_length,
                                                 uint32_t current_fragment_offset,
@@ -698,7 +697,7 @@ _STATIC_H int32_t protected_update_encrypt_fragment(   manifest_t * manifest_dat
         protected_tool_common_set_uint16_without_offset(&nonce[manifest_data->p_confidentiality->enc_params.nonce_length],fragment_number);
         protected_update_prepare_associated_data(manifest_data, associated_data, current_fragment_offset);
         if (0 != (pal_crypt_encrypt_aes128_ccm(NULL,
-                                                p_current_fragment,
+                                                p_plain_text,
                                                fragment_length,
                                                (const uint8_t  *)manifest_data->p_confidentiality->enc_params.session_key,
                                                (const uint8_t  *)nonce,
@@ -726,279 +725,293 @@ _STATIC_H uint16_t  protected_update_get_fragment_size(manifest_t * manifest_dat
 
 }
 
-//lint --e{534, 818} suppress "return value of cbor functions is not considered"
-int32_t protected_update_create_manifest(   manifest_t * manifest_data,
-                                        protected_update_data_set_d * p_cbor_manifest)
+// Encodes the entries of a cbor item, which is embedded as byte string (bstr .cbor)
+typedef void (* protected_update_encoder_t)(cbor_writer_t * p_writer, const manifest_t * manifest_data, const uint8_t * digest);
+
+// Encodes the item as byte string. The size pass of the item provides the length of the byte string
+_STATIC_H void protected_update_set_embedded_item(cbor_writer_t * p_writer,
+                                                  protected_update_encoder_t encoder,
+                                                  const manifest_t * manifest_data,
+                                                  const uint8_t * digest)
 {
-    int32_t status = -1;
-    uint8_t  digest[FRAGMENT_DIGEST_LENGTH];
+    cbor_writer_t size_writer;
 
-    uint8_t signature[256];
-    uint16_t signature_length;
+    cbor_writer_init(&size_writer, NULL, 0);
+    encoder(&size_writer, manifest_data, digest);
+    cbor_set_byte_string(p_writer, size_writer.offset);
+    encoder(p_writer, manifest_data, digest);
+}
 
-    uint8_t data_to_sign[300];
-    uint16_t data_to_sign_length;
+// protected-signed-header-Trust
+//lint --e{715} suppress "digest is not used by this item"
+_STATIC_H void protected_update_encode_sign_header(cbor_writer_t * p_writer, const manifest_t * manifest_data, const uint8_t * digest)
+{
+    cbor_set_map_tag(p_writer, 0x01);
+    cbor_set_map_signed_type(p_writer, 0x01, (int32_t)manifest_data->signature_algo);
+}
 
-    uint8_t extracted_signature[256];
-    uint16_t payload_length_for_digest;
+// Trust_processors.ProcessingStep_integrity.digestAlgorithm : DigestAlgorithms
+_STATIC_H void protected_update_encode_digest(cbor_writer_t * p_writer, const manifest_t * manifest_data, const uint8_t * digest)
+{
+    cbor_set_array_of_data(p_writer, 2);
+    cbor_set_unsigned_integer(p_writer, (uint32_t)manifest_data->digest_algo);
+    //Trust_processors.ProcessingStep_integrity.digest: IFX_DigestSize
+    cbor_set_byte_string_data(p_writer, digest, FRAGMENT_DIGEST_LENGTH);
+}
 
-    uint16_t sign_algo_length;
-    uint8_t * sign_header_ptr = NULL;
-    uint16_t sign_header_length = 0;
-    uint16_t offset = 0;
-    uint16_t length_marker = 0;
-    uint16_t byte_string_len_marker = 0;
+// Trust_processors.ProcessingStep_decrypt.protected: bstr .cbor protected-encrypt-header-Trust
+//lint --e{715} suppress "digest is not used by this item"
+_STATIC_H void protected_update_encode_encrypt_header(cbor_writer_t * p_writer, const manifest_t * manifest_data, const uint8_t * digest)
+{
+    cbor_set_map_tag(p_writer, 0x01);
+    cbor_set_map_unsigned_type(p_writer, 0x01, (uint32_t)manifest_data->p_confidentiality->enc_params.encrypt_algo);
+}
 
-    do
-    {
+// protected-recipient-header-Trust
+//lint --e{715} suppress "digest is not used by this item"
+_STATIC_H void protected_update_encode_recipient_header(cbor_writer_t * p_writer, const manifest_t * manifest_data, const uint8_t * digest)
+{
+    const kdf_t * p_kdf_data = &manifest_data->p_confidentiality->kdf_data;
+
+    cbor_set_map_tag(p_writer, 0x03);
+    cbor_set_map_byte_string_type(p_writer, 0x04, (const uint8_t  *)&p_kdf_data->shared_secret_oid, 0x02);
+    cbor_set_map_signed_type(p_writer, 0x01, (int32_t)p_kdf_data->key_derivation_algo);
+    // Key(05)
+    cbor_set_unsigned_integer(p_writer, 0x05);
+    // Trust_Key_derivation_IV : label and seed
+    cbor_set_array_of_data(p_writer, 2);
+    cbor_set_byte_string_data(p_writer, p_kdf_data->label, p_kdf_data->label_length);
+    cbor_set_byte_string_data(p_writer, p_kdf_data->seed, p_kdf_data->seed_length);
+}
 
-        cbor_set_array_of_data(signature_header, 4, &sign_header_length);
-        cbor_set_byte_string(signature_header, strlen(signature_string), &sign_header_length);
-        memcpy(signature_header+sign_header_length, signature_string, strlen(signature_string));
-        sign_header_length = sign_header_length + (uint16_t )strlen(signature_string);
-
-        sign_header_length++;
-        sign_algo_length = sign_header_length;
-        cbor_set_map_tag(signature_header, 0x01, &sign_header_length);
-        cbor_set_map_signed_type(signature_header, 0x01, (int32_t )manifest_data->signature_algo, &sign_header_length);
-        sign_algo_length = (sign_header_length - sign_algo_length);
-        sign_header_length = (sign_header_length - sign_algo_length) - 1;
-        cbor_set_byte_string(signature_header, sign_algo_length, &sign_header_length);
-        sign_header_length = sign_header_length + sign_algo_length;
-        cbor_set_byte_string(signature_header, 0x00, &sign_header_length);
-        sign_header_ptr = (uint8_t  *)signature_header;
-
-
-        // 1.COSE
-        cbor_set_array_of_data(local_manifest_buffer, 4, &offset);
-
-        // 2.protected signed header trust
-        cbor_set_byte_string(local_manifest_buffer, (sign_algo_length), &offset);
-        cbor_set_map_tag(local_manifest_buffer, 0x01, &offset);
-        cbor_set_map_signed_type(local_manifest_buffer, 0x01, (int32_t) manifest_data->signature_algo, &offset);
-        // 3.unprotected -signed header Trust
-        cbor_set_map_tag(local_manifest_buffer, 0x01, &offset);
-        cbor_set_map_byte_string_type(local_manifest_buffer, 0x04, (uint8_t  *)&manifest_data->trust_anchor_oid, 0x02, &offset);
-
-
-        // 4.Payload
-        length_marker = (uint8_t )offset;
-        //  Dummy length added to be improved
-        cbor_set_byte_string(local_manifest_buffer, 0xa5, &offset);
-
-        // 4.1 Trust_manifest
-        cbor_set_array_of_data(local_manifest_buffer, 0x06, &offset);
-
-        // manifestVersion
-        cbor_set_unsigned_integer(local_manifest_buffer, PROTECT_UPDATE_MANIFEST_VERSION, &offset);
-        cbor_set_null(local_manifest_buffer, &offset);
-        cbor_set_null(local_manifest_buffer, &offset);
-        cbor_set_array_of_data(local_manifest_buffer, 4, &offset);
-
-        // Trust_resource
-        // Trust_PayloadType
-        cbor_set_signed_integer(local_manifest_buffer, (int32_t)(manifest_data->payload_type), &offset);
-
-        if (0 != cbor_set_unsigned_integer(local_manifest_buffer, manifest_data->payload_length, &offset))
-        {
-            pal_logger_print_message(" Error : Assignment in cbor for payload_length\n");
-            break;
-        }
-        // Trust_PayloadVersion
-        if (0 != cbor_set_unsigned_integer(local_manifest_buffer, manifest_data->payload_version, &offset))
+// Component identifier
+_STATIC_H void protected_update_encode_component_id(cbor_writer_t * p_writer, const manifest_t * manifest_data)
+{
+    uint8_t couid[COUID_SIZE];
+    uint8_t target_oid[2];
+    const int8_t * pos = (const int8_t *)manifest_data->couid;
+    uint32_t value;
+    size_t count;
+
+    cbor_set_array_of_data(p_writer, 2);
+    if (NULL != manifest_data->couid)
+    {
+        for (count = 0; count < COUID_SIZE; count++)
         {
-            pal_logger_print_message(" Error : Assignment in cbor for payload_version\n");
-            break;
+            (void)sscanf(pos, "%2x", &value);
+            couid[count] = (uint8_t)value;
+            pos += 2;
         }
+        cbor_set_byte_string_data(p_writer, couid, COUID_SIZE);
+    }
+    else
+    {
+        cbor_set_byte_string(p_writer, 0);
+    }
+    //target oid
+    protected_tool_common_set_uint16_without_offset(target_oid, manifest_data->target_oid);
+    cbor_set_byte_string_data(p_writer, target_oid, sizeof(target_oid));
+}
 
-        cbor_set_array_of_data(local_manifest_buffer, 2, &offset);
-        // AdditionalInfo
-        // Trust_AddInfo_Data
-        if(ePAYLOAD_DATA == manifest_data->payload_type)
-        {
-            // Trust_AddInfo_Data : offset
-            if (0 != cbor_set_unsigned_integer(local_manifest_buffer, manifest_data->p_data_payload->offset_in_oid, &offset))
-            {
-                pal_logger_print_message(" Error : Assignment in cbor for offset_in_oid\n");
-                break;
-            }
-            // Trust_AddInfo_Data : Trust_AddInfo_WriteType
-            cbor_set_unsigned_integer(local_manifest_buffer, (uint8_t )manifest_data->p_data_payload->write_type, &offset);
-        }
-        // Trust_AddInfo_Key
-        else if(ePAYLOAD_KEY == manifest_data->payload_type) 
-        {
-            // Trust_AddInfo_Key.key_algo
-            cbor_set_unsigned_integer(local_manifest_buffer, (uint8_t )manifest_data->p_key_payload->key_algorithm, &offset);
-            // Trust_AddInfo_Key.key_usage
-            cbor_set_unsigned_integer(local_manifest_buffer, (uint8_t )manifest_data->p_key_payload->key_usage, &offset);
-        }
-        // Trust_AddInfo_Metadata
-        else if(ePAYLOAD_METADATA == manifest_data->payload_type)
-        {
-            // Trust_AddInfo_Metadata.content_reset
-            cbor_set_unsigned_integer(local_manifest_buffer, (uint8_t )manifest_data->p_metadata_payload->content_reset, &offset);
-            // Trust_AddInfo_Metadata.additional_flag
-            cbor_set_unsigned_integer(local_manifest_buffer, (uint8_t )manifest_data->p_metadata_payload->additional_flag, &offset);
-        }
-        else
-        {
-            pal_logger_print_message(" Error : Payload type mismatch for additional data\n");
-            break;
-        }
-        // Trust_processors
-        cbor_set_array_of_data(local_manifest_buffer, 2, &offset);
-        cbor_set_array_of_data(local_manifest_buffer, 2, &offset);
-
-        // Trust_processors.ProcessingStep_integrity.process
-        cbor_set_signed_integer(local_manifest_buffer, -1, &offset);
-        cbor_set_byte_string(local_manifest_buffer, FRAGMENT_DIGEST_LENGTH + 5, &offset);
-
-        //Trust_processors.ProcessingStep_integrity.digestAlgorithm : DigestAlgorithms
-        cbor_set_array_of_data(local_manifest_buffer, 2, &offset);
-        cbor_set_unsigned_integer(local_manifest_buffer, (uint32_t)manifest_data->digest_algo, &offset);
-
-        //creating digest
-        payload_length_for_digest = (p_cbor_manifest->fragments_length > MAX_PAYLOAD_SIZE) ? MAX_PAYLOAD_SIZE : p_cbor_manifest->fragments_length;
-        if (0 != pal_crypt_hash(    NULL,
-                                    (uint8_t)eSHA_256,
-                                    (uint8_t *)p_cbor_manifest->fragments,
-                                    (uint16_t)payload_length_for_digest,
-                                    (uint8_t * )digest))
-        {
-            pal_logger_print_message(" Error : Failed in pal_crypt_hash");
-            break;
-        }
+// Trust_manifest, the payload of COSE_Sign1
+_STATIC_H void protected_update_encode_trust_manifest(cbor_writer_t * p_writer, const manifest_t * manifest_data, const uint8_t * digest)
+{
+    // 4.1 Trust_manifest
+    cbor_set_array_of_data(p_writer, 0x06);
+
+    // manifestVersion
+    cbor_set_unsigned_integer(p_writer, PROTECT_UPDATE_MANIFEST_VERSION);
+    cbor_set_null(p_writer);
+    cbor_set_null(p_writer);
+    cbor_set_array_of_data(p_writer, 4);
+
+    // Trust_resource
+    // Trust_PayloadType
+    cbor_set_signed_integer(p_writer, (int32_t)(manifest_data->payload_type));
+    cbor_set_unsigned_integer(p_writer, manifest_data->payload_length);
+    // Trust_PayloadVersion
+    cbor_set_unsigned_integer(p_writer, manifest_data->payload_version);
+
+    cbor_set_array_of_data(p_writer, 2);
+    // AdditionalInfo
+    // Trust_AddInfo_Data
+    if (ePAYLOAD_DATA == manifest_data->payload_type)
+    {
+        // Trust_AddInfo_Data : offset
+        cbor_set_unsigned_integer(p_writer, manifest_data->p_data_payload->offset_in_oid);
+        // Trust_AddInfo_Data : Trust_AddInfo_WriteType
+        cbor_set_unsigned_integer(p_writer, (uint8_t )manifest_data->p_data_payload->write_type);
+    }
+    // Trust_AddInfo_Key
+    else if (ePAYLOAD_KEY == manifest_data->payload_type)
+    {
+        // Trust_AddInfo_Key.key_algo
+        cbor_set_unsigned_integer(p_writer, (uint8_t )manifest_data->p_key_payload->key_algorithm);
+        // Trust_AddInfo_Key.key_usage
+        cbor_set_unsigned_integer(p_writer, (uint8_t )manifest_data->p_key_payload->key_usage);
+    }
+    // Trust_AddInfo_Metadata
+    else
+    {
+        // Trust_AddInfo_Metadata.content_reset
+        cbor_set_unsigned_integer(p_writer, (uint8_t )manifest_data->p_metadata_payload->content_reset);
+        // Trust_AddInfo_Metadata.additional_flag
+        cbor_set_unsigned_integer(p_writer, (uint8_t )manifest_data->p_metadata_payload->additional_flag);
+    }
+    // Trust_processors
+    cbor_set_array_of_data(p_writer, 2);
+    cbor_set_array_of_data(p_writer, 2);
 
-        cbor_set_byte_string(local_manifest_buffer, sizeof(digest), &offset);
-        //Trust_processors.ProcessingStep_integrity.digest: IFX_DigestSize  
-        memcpy((local_manifest_buffer+offset), digest, sizeof(digest));
-        offset += sizeof(digest);
+    // Trust_processors.ProcessingStep_integrity.process
+    cbor_set_signed_integer(p_writer, -1);
+    protected_update_set_embedded_item(p_writer, protected_update_encode_digest, manifest_data, digest);
 
-        // Trust_processors.ProcessingStep2 : ProcessingStep_decrypt
-        if(NULL != manifest_data->p_confidentiality)
-        {
-            cbor_set_array_of_data(local_manifest_buffer, 2, &offset);
+    // Trust_processors.ProcessingStep2 : ProcessingStep_decrypt
+    if (NULL != manifest_data->p_confidentiality)
+    {
+        cbor_set_array_of_data(p_writer, 2);
+
+        // Trust_processors.ProcessingStep_decrypt.process
+        cbor_set_unsigned_integer(p_writer, 0x01);
 
-            // Trust_processors.ProcessingStep_decrypt.process
-            cbor_set_unsigned_integer(local_manifest_buffer, 0x01, &offset);
+        // Trust_processors.ProcessingStep_decrypt.COSE_Encrypt_Trust
+        cbor_set_array_of_data(p_writer, 3);
+        protected_update_set_embedded_item(p_writer, protected_update_encode_encrypt_header, manifest_data, digest);
 
-            // Trust_processors.ProcessingStep_decrypt.COSE_Encrypt_Trust
-            cbor_set_array_of_data(local_manifest_buffer, 3, &offset);
+        // Trust_processors.ProcessingStep_decrypt.recipients
+        cbor_set_array_of_data(p_writer, 1);
 
-            // Trust_processors.ProcessingStep_decrypt.protected: bstr .cbor protected-encrypt-header-Trust
-            byte_string_len_marker = offset;
-            // Dummy length of less than 0x17
-            cbor_set_byte_string(local_manifest_buffer, 0x03, &offset);
+        // Trust_processors.ProcessingStep_decrypt.COSE_Recipient_Trust
+        cbor_set_array_of_data(p_writer, 2);
+        protected_update_set_embedded_item(p_writer, protected_update_encode_recipient_header, manifest_data, digest);
+
+        // Nil
+        cbor_set_null(p_writer);
+        // Nil
+        cbor_set_null(p_writer);
+    }
+    else
+    {
+        // Trust_processors.ProcessingStep2 : NULL
+        cbor_set_null(p_writer);
+    }
 
-            cbor_set_map_tag(local_manifest_buffer, 0x01, &offset);
-            cbor_set_map_unsigned_type(local_manifest_buffer, 0x01, (uint32_t)manifest_data->p_confidentiality->enc_params.encrypt_algo, &offset);
-            // Write the actual protected-encrypt-header-Trust length
-            cbor_set_byte_string(local_manifest_buffer, ((offset - byte_string_len_marker) - 1 ), &byte_string_len_marker);
+    protected_update_encode_component_id(p_writer, manifest_data);
+}
 
-            // Trust_processors.ProcessingStep_decrypt.recipients
-            cbor_set_array_of_data(local_manifest_buffer, 1, &offset);
+// Encodes the head of COSE_Sign1 (protected and unprotected headers), followed by the payload
+_STATIC_H void protected_update_encode_cose_head(cbor_writer_t * p_writer, const manifest_t * manifest_data, uint32_t payload_length)
+{
+    // 1.COSE
+    cbor_set_array_of_data(p_writer, 4);
+    // 2.protected signed header trust
+    protected_update_set_embedded_item(p_writer, protected_update_encode_sign_header, manifest_data, NULL);
+    // 3.unprotected -signed header Trust
+    cbor_set_map_tag(p_writer, 0x01);
+    cbor_set_map_byte_string_type(p_writer, 0x04, (const uint8_t  *)&manifest_data->trust_anchor_oid, 0x02);
+    // 4.Payload
+    cbor_set_byte_string(p_writer, payload_length);
+}
 
-            // Trust_processors.ProcessingStep_decrypt.COSE_Recipient_Trust
-            cbor_set_array_of_data(local_manifest_buffer, 2, &offset);
+// Encodes the head of Sig_structure (context, protected header and external aad), followed by the payload
+_STATIC_H void protected_update_encode_sig_structure_head(cbor_writer_t * p_writer, const manifest_t * manifest_data, uint32_t payload_length)
+{
+    cbor_set_array_of_data(p_writer, 4);
+    cbor_set_byte_string_data(p_writer, (const uint8_t *)signature_string, (uint32_t)strlen(signature_string));
+    protected_update_set_embedded_item(p_writer, protected_update_encode_sign_header, manifest_data, NULL);
+    cbor_set_byte_string(p_writer, 0x00);
+    cbor_set_byte_string(p_writer, payload_length);
+}
 
-            // protected-recipient-header-Trust length dummy value(make sure add dummy value greater tan 0x17)
-            byte_string_len_marker = offset;
-            cbor_set_byte_string(local_manifest_buffer, 0x53, &offset);
+int32_t protected_update_create_manifest(   manifest_t * manifest_data,
+                                        protected_update_data_set_d * p_cbor_manifest)
+{
+    int32_t status = -1;
+    uint8_t  digest[FRAGMENT_DIGEST_LENGTH];
 
-            cbor_set_map_tag(local_manifest_buffer, 0x03, &offset);
-            cbor_set_map_byte_string_type(local_manifest_buffer, 0x04, (uint8_t  *)&manifest_data->p_confidentiality->kdf_data.shared_secret_oid, 0x02, &offset);
+    uint8_t signature[256];
+    uint16_t signature_length;
 
-            cbor_set_map_signed_type(local_manifest_buffer, 0x01, (int32_t)manifest_data->p_confidentiality->kdf_data.key_derivation_algo, &offset);
+    uint8_t extracted_signature[256];
 
-            // Key(05)
-            cbor_set_unsigned_integer(local_manifest_buffer, 0x05, &offset);
+    cbor_writer_t writer;
+    uint8_t * manifest_buffer = NULL;
+    uint32_t payload_length;
+    uint32_t cose_head_length;
+    uint32_t sig_structure_head_length;
+    uint32_t payload_offset;
+    uint32_t manifest_length;
 
-            // Trust_Key_derivation_IV
-            cbor_set_array_of_data(local_manifest_buffer, 2, &offset);
-            // label
-            if((manifest_data->p_confidentiality->kdf_data.label_length > 0) && (manifest_data->p_confidentiality->kdf_data.label_length <= 32))
-            {
-                cbor_set_byte_string(local_manifest_buffer, manifest_data->p_confidentiality->kdf_data.label_length, &offset);
-                memcpy((local_manifest_buffer+offset), manifest_data->p_confidentiality->kdf_data.label, manifest_data->p_confidentiality->kdf_data.label_length);
-                offset += manifest_data->p_confidentiality->kdf_data.label_length;
-            }
-            else
+    do
+    {
+        if ((ePAYLOAD_DATA != manifest_data->payload_type) &&
+            (ePAYLOAD_KEY != manifest_data->payload_type) &&
+            (ePAYLOAD_METADATA != manifest_data->payload_type))
+        {
+            pal_logger_print_message(" Error : Payload type mismatch for additional data\n");
+            break;
+        }
+        if (NULL != manifest_data->p_confidentiality)
+        {
+            if ((manifest_data->p_confidentiality->kdf_data.label_length == 0) || (manifest_data->p_confidentiality->kdf_data.label_length > 32))
             {
                 pal_logger_print_message(" Error : Label length is not in range");
                 break;
             }
-
-            if(manifest_data->p_confidentiality->kdf_data.seed_length >= 16 && manifest_data->p_confidentiality->kdf_data.seed_length <= 64)
-            {
-                cbor_set_byte_string(local_manifest_buffer, manifest_data->p_confidentiality->kdf_data.seed_length, &offset);
-                memcpy((local_manifest_buffer+offset), manifest_data->p_confidentiality->kdf_data.seed, manifest_data->p_confidentiality->kdf_data.seed_length);
-                offset += manifest_data->p_confidentiality->kdf_data.seed_length;
-            }
-            else
+            if ((manifest_data->p_confidentiality->kdf_data.seed_length < 16) || (manifest_data->p_confidentiality->kdf_data.seed_length > 64))
             {
                 pal_logger_print_message(" Error : Seed length is not in range");
                 break;
             }
-            // Write the actual protected-recipient-header-Trust length
-            cbor_set_byte_string(local_manifest_buffer, (uint32_t)((offset - byte_string_len_marker) - 2 ), &byte_string_len_marker);
-
-            // Nil
-            cbor_set_null(local_manifest_buffer, &offset);
-            // Nil
-            cbor_set_null(local_manifest_buffer, &offset);
-
         }
-        else
+        if ((NULL != manifest_data->couid) && ((2 * COUID_SIZE) > strlen((const int8_t *)manifest_data->couid)))
         {
-            // Trust_processors.ProcessingStep2 : NULL
-            cbor_set_null(local_manifest_buffer, &offset);
+            pal_logger_print_message(" Error : Co-Processor OID length is not correct");
+            break;
         }
 
-        // Component identifier
-        cbor_set_array_of_data(local_manifest_buffer, 2, &offset);
-        if(NULL != manifest_data->couid)
+        // Digest of the first fragment is calculated with the fragments
+        memcpy(digest, p_cbor_manifest->first_fragment_digest, sizeof(digest));
+
+        // Size pass : the lengths of the payload and of the heads, which precede the payload
+        cbor_writer_init(&writer, NULL, 0);
+        protected_update_encode_trust_manifest(&writer, manifest_data, digest);
+        payload_length = writer.offset;
+
+        cbor_writer_init(&writer, NULL, 0);
+        protected_update_encode_cose_head(&writer, manifest_data, payload_length);
+        cose_head_length = writer.offset;
+
+        cbor_writer_init(&writer, NULL, 0);
+        protected_update_encode_sig_structure_head(&writer, manifest_data, payload_length);
+        sig_structure_head_length = writer.offset;
+
+        if (0xFFFF < (sig_structure_head_length + payload_length))
         {
-			#define COUID_SIZE 25
-			uint8_t* couid = NULL;
-			const uint8_t *pos = manifest_data->couid;
-			couid = malloc(COUID_SIZE * sizeof(uint8_t));
-			if (couid == NULL)
-				break;
-			for (size_t count = 0; count < COUID_SIZE; count++) {
-				sscanf(pos, "%2hhx", &couid[count]);
-				pos += 2;
-			}
-            cbor_set_byte_string(local_manifest_buffer, COUID_SIZE, &offset);
-            memcpy((local_manifest_buffer+offset), couid, COUID_SIZE);
-            offset += COUID_SIZE;
-			//pal_logger_print_message("Used CO-UID:");
-			//pal_logger_print_hex_data(couid, COUID_SIZE);
-			//pal_logger_print_message("\r\n");
-			free(couid);
+            pal_logger_print_message(" Error : Manifest length is not in range");
+            break;
         }
-        else
+
+        // Write pass : the payload is written once, both heads are written in front of it
+        payload_offset = (sig_structure_head_length > cose_head_length) ? sig_structure_head_length : cose_head_length;
+        manifest_buffer = (uint8_t  * )pal_os_malloc(payload_offset + payload_length +
+                                                     cbor_get_head_size(sizeof(signature)) + sizeof(signature));
+        if (NULL == manifest_buffer)
         {
-            cbor_set_byte_string(local_manifest_buffer, 0, &offset);
+            pal_logger_print_message(" Error : Manifest memory allocation");
+            break;
         }
-        //target oid
-        cbor_set_byte_string(local_manifest_buffer, 2, &offset);
-        protected_tool_common_set_uint16(&local_manifest_buffer[offset], &offset, manifest_data->target_oid);
+        cbor_writer_init(&writer, manifest_buffer, payload_offset);
+        protected_update_encode_trust_manifest(&writer, manifest_data, digest);
 
-        //Updating length filed of payload
-        data_to_sign_length = ((offset - length_marker) - 1);
-        local_manifest_buffer[length_marker + 1] = (uint8_t )(data_to_sign_length - 1);
-
-        //Generate signature
-        memcpy(data_to_sign, sign_header_ptr, sign_header_length);
-        data_to_sign_length += 1;
-        memcpy(data_to_sign + sign_header_length, local_manifest_buffer + length_marker, data_to_sign_length);
-        data_to_sign_length += sign_header_length;
+        //Generate signature on Sig_structure
+        cbor_writer_init(&writer, manifest_buffer, payload_offset - sig_structure_head_length);
+        protected_update_encode_sig_structure_head(&writer, manifest_data, payload_length);
 
         signature_length = sizeof(signature);
         if(0 != pal_crypt_sign( NULL,
-                                (uint8_t * )data_to_sign,
-                                (uint16_t)data_to_sign_length,
+                                (uint8_t * )&manifest_buffer[payload_offset - sig_structure_head_length],
+                                (uint16_t)(sig_structure_head_length + payload_length),
                                 (uint8_t * )signature,
                                 (uint16_t * )&signature_length,
                                 (const uint8_t *)manifest_data->private_key,
@@ -1008,6 +1021,11 @@ int32_t protected_update_create_manifest(   manifest_t * manifest_data,
             break;
         }
 
+        // COSE_Sign1 head replaces the Sig_structure head
+        cbor_writer_init(&writer, manifest_buffer, payload_offset - cose_head_length);
+        protected_update_encode_cose_head(&writer, manifest_data, payload_length);
+        writer.offset += payload_length;
+
         // do only for EC_256
         if ((int16_t)eES_SHA == (int16_t)manifest_data->signature_algo)
         {
@@ -1025,8 +1043,7 @@ int32_t protected_update_create_manifest(   manifest_t * manifest_data,
                 pal_logger_print_message(" Error : Decode ecc signature");
                 break;
             }
-            cbor_set_byte_string(local_manifest_buffer, signature_length, &offset);
-            memcpy(&local_manifest_buffer[offset], extracted_signature, signature_length);
+            cbor_set_byte_string_data(&writer, extracted_signature, signature_length);
         }
         else if ((int16_t)eRSA_SSA_PKCS1_V1_5_SHA_256 == (int16_t)manifest_data->signature_algo)
         {
@@ -1036,30 +1053,139 @@ int32_t protected_update_create_manifest(   manifest_t * manifest_data,
                 pal_logger_print_message(" Error : Getting signature length\n");
                 break;
             }
-            cbor_set_byte_string(local_manifest_buffer, signature_length, &offset);
-            memcpy(&local_manifest_buffer[offset], signature, signature_length);
+            cbor_set_byte_string_data(&writer, signature, signature_length);
         }
 
-        offset += signature_length;
-        p_cbor_manifest->data_length = offset;
-        p_cbor_manifest->data = (uint8_t  * )pal_os_malloc(offset);
-        memcpy(p_cbor_manifest->data, local_manifest_buffer, offset);
+        manifest_length = writer.offset - (payload_offset - cose_head_length);
+        memmove(manifest_buffer, &manifest_buffer[payload_offset - cose_head_length], manifest_length);
+        p_cbor_manifest->data_length = manifest_length;
+        p_cbor_manifest->data = manifest_buffer;
+        manifest_buffer = NULL;
 
         status = 0;
     } while (0);
+
+    if (NULL != manifest_buffer)
+    {
+        pal_os_free(manifest_buffer);
+    }
     return status;
 
 }
 
+// Streams the fragments to the file, from the last fragment to the first. The payload is hashed and written in place
+// (or encrypted into one fragment buffer), hence only one fragment is kept in memory.
+_STATIC_H int32_t protected_update_stream_fragments(manifest_t * manifest_data,
+                                                    protected_update_data_set_d * p_cbor_manifest)
+{
+    int32_t status = -1;
+    FILE * fp = NULL;
+    uint8_t cipher_text[MAX_PAYLOAD_SIZE];
+    uint8_t digest[FRAGMENT_DIGEST_LENGTH];
+    uint32_t digest_length = 0;
+    const uint8_t * p_current_fragment;
+    uint16_t fragment_length;
+    uint16_t max_payload_fragment_size = protected_update_get_fragment_size(manifest_data);
+    uint32_t count_of_fragments;
+    uint32_t fragment_index;
+    uint32_t payload_offset;
+
+    do
+    {
+        if (0 == manifest_data->payload_length)
+        {
+            pal_logger_print_message("Error : Payload is empty\n");
+            break;
+        }
+        count_of_fragments = ((manifest_data->payload_length - 1) / max_payload_fragment_size) + 1;
+        // Fragment number (nonce) and payload length (associated data) are limited to 16 and 24 bit
+        if ((NULL != manifest_data->p_confidentiality) &&
+            ((0xFFFF < count_of_fragments) || (0xFFFFFF < manifest_data->payload_length)))
+        {
+            pal_logger_print_message("Error : Payload length is not supported with confidentiality\n");
+            break;
+        }
+        fp = fopen(manifest_data->fragments_file_path, "wb");
+        if (NULL == fp)
+        {
+            pal_logger_print_message("Error : Unable to open the fragments file\n");
+            break;
+        }
+
+        fragment_index = count_of_fragments;
+        while (0 != fragment_index)
+        {
+            fragment_index--;
+            payload_offset = fragment_index * max_payload_fragment_size;
+            fragment_length = (uint16_t)(((manifest_data->payload_length - payload_offset) > max_payload_fragment_size) ?
+                                         max_payload_fragment_size : (manifest_data->payload_length - payload_offset));
+            p_current_fragment = manifest_data->payload + payload_offset;
+
+            if (NULL != manifest_data->p_confidentiality)
+            {
+                if (0 != protected_update_encrypt_fragment(manifest_data,
+                                                           p_current_fragment,
+                                                           cipher_text,
+                                                           fragment_length,
+                                                           payload_offset,
+                                                           (uint16_t)(fragment_index + 1)))
+                {
+                    pal_logger_print_message("Error : Encrypt fragment ");
+                    break;
+                }
+                p_current_fragment = cipher_text;
+                fragment_length += manifest_data->p_confidentiality->enc_params.mac_size;
+            }
+
+            // The digest of the next fragment follows the payload
+            if ((0 != fseek(fp, (long)(fragment_index * MAX_PAYLOAD_SIZE), SEEK_SET)) ||
+                (fragment_length != fwrite(p_current_fragment, 1, fragment_length, fp)) ||
+                (digest_length != fwrite(digest, 1, digest_length, fp)))
+            {
+                pal_logger_print_message("Error : Unable to write to the fragments file\n");
+                break;
+            }
+            if (0 != pal_crypt_hash_parts(NULL,
+                                          (uint8_t)eSHA_256,
+                                          p_current_fragment,
+                                          fragment_length,
+                                          digest,
+                                          digest_length,
+                                          digest))
+            {
+                pal_logger_print_message(" Error : Failed in pal_crypt_hash");
+                break;
+            }
+            p_cbor_manifest->fragments_length += fragment_length + digest_length;
+            digest_length = FRAGMENT_DIGEST_LENGTH;
+        }
+        if (0 != fragment_index)
+        {
+            break;
+        }
+        memcpy(p_cbor_manifest->first_fragment_digest, digest, sizeof(digest));
+        status = 0;
+    } while (0);
+
+    if (NULL != fp)
+    {
+        if (0 != fclose(fp))
+        {
+            status = -1;
+        }
+    }
+    return status;
+}
+
 int32_t protected_update_create_fragments(manifest_t * manifest_data,
                                       protected_update_data_set_d * p_cbor_manifest)
 {
     int32_t status = -1;
     uint8_t digest[FRAGMENT_DIGEST_LENGTH];
-    uint16_t remaining_payload_length = 0;
-    uint16_t max_memory_required;
+    uint32_t remaining_payload_length = 0;
+    uint32_t max_memory_required;
     uint8_t * fragments = NULL;
-    uint8_t count_of_fragments = 0, index_for_hashing = 0;
+    uint32_t count_of_fragments = 0, index_for_hashing = 0;
     uint8_t * p_current_fragment = NULL;
     uint16_t length_to_digest;
     uint16_t payload_len_to_copy = 0;
@@ -1074,10 +1200,15 @@ int32_t protected_update_create_fragments(manifest_t * manifest_data,
             pal_logger_print_message(" Error : Failed in protected_update_form_payload");
             break;
         }
-        remaining_payload_length = (uint16_t )manifest_data->payload_length;
+        if (NULL != manifest_data->fragments_file_path)
+        {
+            status = protected_update_stream_fragments(manifest_data, p_cbor_manifest);
+            break;
+        }
+        remaining_payload_length = manifest_data->payload_length;
         max_payload_fragment_size = protected_update_get_fragment_size(manifest_data);
-        max_memory_required = (uint16_t )((remaining_payload_length / max_payload_fragment_size) * MAX_PAYLOAD_SIZE);
-        max_memory_required += (uint16_t )(remaining_payload_length % max_payload_fragment_size);
+        max_memory_required = (remaining_payload_length / max_payload_fragment_size) * MAX_PAYLOAD_SIZE;
+        max_memory_required += (remaining_payload_length % max_payload_fragment_size);
 
         if(NULL != manifest_data->p_confidentiality)
             max_memory_required += manifest_data->p_confidentiality->enc_params.mac_size;
@@ -1094,12 +1225,13 @@ int32_t protected_update_create_fragments(manifest_t * manifest_data,
             p_current_fragment = fragments + (count_of_fragments * MAX_PAYLOAD_SIZE);
 
             //payload_len_to_copy = (remaining_payload_length > (MAX_PAYLOAD_SIZE - ((NULL != manifest_data->p_confidentiality) ? manifest_data->p_confidentiality->enc_params.mac_size : 0))) ? max_payload_fragment_size : remaining_payload_length;
-            payload_len_to_copy = (remaining_payload_length > max_payload_fragment_size) ? max_payload_fragment_size : remaining_payload_length;
+            payload_len_to_copy = (remaining_payload_length > max_payload_fragment_size) ? max_payload_fragment_size : (uint16_t)remaining_payload_length;
             memcpy(p_current_fragment, manifest_data->payload + (max_payload_fragment_size * count_of_fragments), payload_len_to_copy);
 
             if (NULL != manifest_data->p_confidentiality)
             {
                 if (0 != protected_update_encrypt_fragment(manifest_data,
+                                                           p_current_fragment,
                                                            p_current_fragment,
                                                            payload_len_to_copy,
                                                            (count_of_fragments * max_payload_fragment_size),
@@ -1153,6 +1285,17 @@ int32_t protected_update_create_fragments(manifest_t * manifest_data,
         p_cbor_manifest->fragments = fragments;
         // Below variable can be deleted
         p_cbor_manifest->actual_memory_allocated = max_memory_required;
+
+        length_to_digest = (p_cbor_manifest->fragments_length > MAX_PAYLOAD_SIZE) ? MAX_PAYLOAD_SIZE : (uint16_t)p_cbor_manifest->fragments_length;
+        if (0 != pal_crypt_hash(NULL,
+                                (uint8_t)eSHA_256,
+                                (const uint8_t  *)fragments,
+                                (uint32_t)length_to_digest,
+                                p_cbor_manifest->first_fragment_digest))
+        {
+            pal_logger_print_message(" Error : Failed in pal_crypt_hash");
+            break;
+        }
         status = 0;
     } while (0);
     return status;
@@ -154,6 +154,11 @@
 #define SHORT_NAME_DATASET_OUTPUT_FILE      "dataset_to_file"TOOL_ASSIGN
 #define DEFAULT_DATASET_OUTPUT_FILE         NULL
 
+// Fragments output to binary file
+#define DESC_FRAGMENTS_OUTPUT_FILE          "Fragments output to binary file"
+#define SHORT_NAME_FRAGMENTS_OUTPUT_FILE    "fragments_to_file"TOOL_ASSIGN
+#define DEFAULT_FRAGMENTS_OUTPUT_FILE       NULL
+
 // Details
 #define DETAIL_MANIFEST                     "(1) : To create manifest , provide the following details"
 #define DETAIL_CONFIDENTIALITY              "(2) : To enable confidentiality,\"secret\" must be provided (All other options are ignored if there is no confidentiality)"
@@ -161,6 +166,7 @@
 #define DETAIL_KEY_OBJ                      "(3.2) : To update key object, \"payload_type\" should be \"key\" and provide the following details:"
 #define DETAIL_METADATA_OBJ                 "(3.3) : To update metadata object, \"payload_type\" should be \"metadata\" and provide the following details:"
 #define DETAIL_DATASET_TO_FILE              "(4) : To write dataset to file, \"dataset_to_file\" should be the file path "
+#define DETAIL_FRAGMENTS_TO_FILE            "(5) : To stream large payloads, \"fragments_to_file\" should be the file path (fragments are not kept in memory)"
 
 #define _NEXT_		"\n\t\t\t\t      :  "
 
@@ -202,6 +208,7 @@ static struct options
 
     // FILEPATH NAME
     uint8_t *dataset_to_file_path;
+    uint8_t *fragments_to_file_path;
 } opt;
 
 typedef struct option_property
@@ -243,7 +250,7 @@ opt_prop_t option_table[] =
     { DESC_OFFSET_IN_OID,SHORT_NAME_OFFSET_IN_OID, &opt.offset_in_oid, DEFAULT_OFFSET_IN_OID, 0, "","" },
     { DESC_WRITE_TYPE, SHORT_NAME_WRITE_TYPE, &opt.write_type, DEFAULT_WRITE_TYPE, 0, "Write (1), EraseAndWrite (2)", "" },
     { DESC_PAYLOAD_DATA, SHORT_NAME_PAYLOAD_DATA, &opt.data, DEFAULT_PAYLOAD_DATA, 0, "","Input is a text file with hexadecimal or ascii string content" },
-    { DESC_INPUT_DATA_FORMAT, SHORT_NAME_INPUT_DATA_FORMAT, &opt.input_data_format, DEFAULT_INPUT_DATA_FORMAT, 0, "hex , ascii", "Refer : samples/payload/data/ascii_data.txt for input_data_format=ascii"_NEXT_"Refer : samples/payload/data/hex_data.txt for input_data_format=hex"},
+    { DESC_INPUT_DATA_FORMAT, SHORT_NAME_INPUT_DATA_FORMAT, &opt.input_data_format, DEFAULT_INPUT_DATA_FORMAT, 0, "hex , ascii , binary", "Refer : samples/payload/data/ascii_data.txt for input_data_format=ascii"_NEXT_"Refer : samples/payload/data/hex_data.txt for input_data_format=hex"_NEXT_"binary : the data file is mapped to memory, use with fragments_to_file for large payloads"},
     
     // PAYLOAD : KEYS
     { "Details", DETAIL_KEY_OBJ, NULL, "", 0, "", "" },
@@ -259,6 +266,10 @@ opt_prop_t option_table[] =
     // Dataset to output file
     { "Details", DETAIL_DATASET_TO_FILE, NULL, "", 0, "", "" },
     { DESC_DATASET_OUTPUT_FILE, SHORT_NAME_DATASET_OUTPUT_FILE, &opt.dataset_to_file_path, DEFAULT_DATASET_OUTPUT_FILE, 0, "Provide the filename for output dataset to be stored", ""},
+
+    // Fragments to output file
+    { "Details", DETAIL_FRAGMENTS_TO_FILE, NULL, "", 0, "", "" },
+    { DESC_FRAGMENTS_OUTPUT_FILE, SHORT_NAME_FRAGMENTS_OUTPUT_FILE, &opt.fragments_to_file_path, DEFAULT_FRAGMENTS_OUTPUT_FILE, 0, "Provide the filename for output fragments to be stored", "Fragments are written in sequence, each of 640 bytes except the last one"},
 };
 
 extern uint8_t * dataset_file_path;
@@ -632,6 +643,7 @@ _STATIC_H int32_t _tool_set_confidentiality_info(confidentiality_t * p_confident
 _STATIC_H int32_t _tool_set_object_data_info(data_payload_t * p_data_payload)
 {
     int32_t status = 1;
+    uint16_t data_length = 0;
 
     do
     {
@@ -655,11 +667,19 @@ _STATIC_H int32_t _tool_set_object_data_info(data_payload_t * p_data_payload)
         pal_logger_print_message(buffer);
         if(!strcmp("ascii", (const int8_t *)opt.input_data_format))
         {
-            status = pal_file_system_read_file_to_array((const int8_t *)opt.data, &(p_data_payload->data), &(p_data_payload->data_length));
+            status = pal_file_system_read_file_to_array((const int8_t *)opt.data, &(p_data_payload->data), &data_length);
+            p_data_payload->data_length = data_length;
         }
         else if(!strcmp("hex", (const int8_t *)opt.input_data_format))
         {
-            status = pal_file_system_read_file_to_array_in_hex((const int8_t *)opt.data, &(p_data_payload->data), &(p_data_payload->data_length));
+            status = pal_file_system_read_file_to_array_in_hex((const int8_t *)opt.data, &(p_data_payload->data), &data_length);
+            p_data_payload->data_length = data_length;
+        }
+        else if(!strcmp("binary", (const int8_t *)opt.input_data_format))
+        {
+            // The data is accessed in the mapped file, it is not limited by the size of the memory
+            status = pal_file_system_map_file((const int8_t *)opt.data, (const uint8_t **)&(p_data_payload->data),
+                                              &(p_data_payload->data_length), &(p_data_payload->data_mapping));
         }
         else
         {
@@ -833,7 +853,7 @@ int32_t tool_set_user_inputs(manifest_t* p_manifest_data)
         if (NULL != opt.shared_secret)
         {
             // create structure and assign to your pointer
-            p_manifest_data->p_confidentiality = (confidentiality_t *)pal_os_malloc(sizeof(confidentiality_t));
+            p_manifest_data->p_confidentiality = (confidentiality_t *)pal_os_calloc(1, sizeof(confidentiality_t));
             if (0 != _tool_set_confidentiality_info(p_manifest_data->p_confidentiality))
             {
                 break;
@@ -843,7 +863,7 @@ int32_t tool_set_user_inputs(manifest_t* p_manifest_data)
         //PAYLOAD : Data
         if (NULL != opt.data)
         {
-            p_manifest_data->p_data_payload = (data_payload_t *)pal_os_malloc(sizeof(data_payload_t));
+            p_manifest_data->p_data_payload = (data_payload_t *)pal_os_calloc(1, sizeof(data_payload_t));
             if (0 != _tool_set_object_data_info(p_manifest_data->p_data_payload))
             {
                 break;
@@ -852,7 +872,7 @@ int32_t tool_set_user_inputs(manifest_t* p_manifest_data)
         //PAYLOAD : Key
         else if (NULL != opt.key_data)
         {
-            p_manifest_data->p_key_payload = (key_payload_t *)pal_os_malloc(sizeof(key_payload_t));
+            p_manifest_data->p_key_payload = (key_payload_t *)pal_os_calloc(1, sizeof(key_payload_t));
             if (0 != _tool_set_key_data_info(p_manifest_data->p_key_payload))
             {
                 break;
@@ -868,7 +888,7 @@ int32_t tool_set_user_inputs(manifest_t* p_manifest_data)
         //PAYLOAD : Metadata
         else if (NULL != opt.metadata)
         {
-            p_manifest_data->p_metadata_payload = (metadata_payload_t *)pal_os_malloc(sizeof(metadata_payload_t));
+            p_manifest_data->p_metadata_payload = (metadata_payload_t *)pal_os_calloc(1, sizeof(metadata_payload_t));
             if (0 != _tool_set_meta_data_info(p_manifest_data->p_metadata_payload))
             {
                 break;
@@ -885,6 +905,7 @@ int32_t tool_set_user_inputs(manifest_t* p_manifest_data)
         {
               dataset_file_path = opt.dataset_to_file_path;
         }
+        p_manifest_data->fragments_file_path = opt.fragments_to_file_path;
         status = 0;
     } while (0);
 
@@ -901,24 +922,56 @@ int32_t tool_clear_inputs(manifest_t* p_manifest_data)
 {
     int32_t status = -1;
 
+    // The buffers read from the input files are freed as well, since the batch mode sets the inputs per device
     if (NULL != p_manifest_data->p_confidentiality)
     {
+        pal_os_free(p_manifest_data->p_confidentiality->kdf_data.shared_secret);
+        pal_os_free(p_manifest_data->p_confidentiality->kdf_data.seed);
         if (NULL != p_manifest_data->p_confidentiality->kdf_data.label)
         {
             pal_os_free(p_manifest_data->p_confidentiality);
         }
+        p_manifest_data->p_confidentiality = NULL;
     }
     if (NULL != p_manifest_data->p_data_payload)
     {
+        if (NULL != p_manifest_data->p_data_payload->data_mapping)
+        {
+            pal_file_system_unmap_file(p_manifest_data->p_data_payload->data_mapping);
+        }
+        else
+        {
+            pal_os_free(p_manifest_data->p_data_payload->data);
+        }
         pal_os_free(p_manifest_data->p_data_payload);
+        p_manifest_data->p_data_payload = NULL;
     }
     if (NULL != p_manifest_data->p_key_payload)
     {
+        if (eRSA == p_manifest_data->p_key_payload->key_type)
+        {
+            pal_os_free(p_manifest_data->p_key_payload->key_params.rsa_key.N);
+            pal_os_free(p_manifest_data->p_key_payload->key_params.rsa_key.E);
+            pal_os_free(p_manifest_data->p_key_payload->key_params.rsa_key.D);
+        }
+        else if (eECC == p_manifest_data->p_key_payload->key_type)
+        {
+            pal_os_free(p_manifest_data->p_key_payload->key_params.ecc_key.D);
+            pal_os_free(p_manifest_data->p_key_payload->key_params.ecc_key.X);
+            pal_os_free(p_manifest_data->p_key_payload->key_params.ecc_key.Y);
+        }
+        else if (eAES == p_manifest_data->p_key_payload->key_type)
+        {
+            pal_os_free(p_manifest_data->p_key_payload->key_params.aes_key.key);
+        }
         pal_os_free(p_manifest_data->p_key_payload);
+        p_manifest_data->p_key_payload = NULL;
     }
     if (NULL != p_manifest_data->p_metadata_payload)
     {
+        pal_os_free(p_manifest_data->p_metadata_payload->metadata);
         pal_os_free(p_manifest_data->p_metadata_payload);
+        p_manifest_data->p_metadata_payload = NULL;
     }
     return status;
 }
@@ -41,6 +41,7 @@
 #include "protected_update_data_set.h"
 #include "protected_update_data_set_version.h"
 #include "user_input_parser.h"
+#include "protected_update_batch.h"
 #include "pal\pal_os_memory.h"
 
 int32_t main(int32_t argc, int8_t *argv[])
@@ -63,6 +64,13 @@ int32_t main(int32_t argc, int8_t *argv[])
         sprintf(buffer, "Tool Version : %s\n", PROTECTED_UPDATE_VERSION );
         pal_logger_print_message(buffer);
 
+        // Creates the data sets of all the devices in the batch file
+        if (0 != protected_update_batch_requested(argc, argv))
+        {
+            exit_status = (0 == protected_update_batch_run(argc, argv)) ? 0 : 1;
+            break;
+        }
+
         if (0 != tool_get_user_inputs(argc, argv))
         {
             break;
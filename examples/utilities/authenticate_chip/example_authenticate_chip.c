@@ -208,6 +208,9 @@ extern optiga_lib_status_t open_app_status;
 
 static optiga_crypt_t * me_crypt;
 
+// The CA certificate is parsed once, the CA cache is kept for the subsequent authentications
+static uint8_t ca_cache_ready = FALSE;
+
 //Use the print sparsely
 #define PRINT_RANDOM_CHALLENGE   0
 #define PRINT_PUBLICKEY          0
@@ -247,6 +250,11 @@ optiga_lib_status_t read_chip_cert(uint16_t cert_oid,
 		                                   uint8_t* p_cert, uint16_t* p_cert_size)
 {
 	int32_t status  = (int32_t)OPTIGA_DEVICE_ERROR;
+	uint32_t cert_length;
+	uint32_t offset;
+	uint16_t ca_offset[PAL_CRYPT_CA_CACHE_MAX_INTERMEDIATES];
+	uint16_t ca_length[PAL_CRYPT_CA_CACHE_MAX_INTERMEDIATES];
+	uint8_t ca_count = 0;
 
 	configPRINTF((">read_chip_cert()\r\n"));
 
@@ -288,12 +296,47 @@ optiga_lib_status_t read_chip_cert(uint16_t cert_oid,
 		 * Format of a "Certificate Structure Message" used in TLS Handshake
 		 */
 		case 0xC0:
-			/* There might be a certificate chain encoded.
-			 * For this example we will consider only one certificate in the chain
+			/* The first certificate of the chain is the end device certificate, each certificate is
+			 * preceded by its length (3 Bytes). The further certificates are the intermediate CAs.
+			 */
+			if (9 > *p_cert_size)
+			{
+				break;
+			}
+			cert_length = ((uint32_t)p_cert[6] << 16) | ((uint32_t)p_cert[7] << 8) | p_cert[8];
+			if ((9 + cert_length) > *p_cert_size)
+			{
+				break;
+			}
+
+			/* The intermediate CAs are verified once and kept in the CA cache of pal crypt, hence the
+			 * subsequent chips with the same intermediate CA only require the end device certificate to be verified
 			 */
-			
-			*p_cert_size = *p_cert_size - 9;
-			memcpy(p_cert, p_cert + 9, *p_cert_size);
+			offset = 9 + cert_length;
+			while (((offset + 3) <= *p_cert_size) && (PAL_CRYPT_CA_CACHE_MAX_INTERMEDIATES > ca_count))
+			{
+				ca_length[ca_count] = (uint16_t)(((uint32_t)p_cert[offset] << 16) |
+				                                 ((uint32_t)p_cert[offset + 1] << 8) | p_cert[offset + 2]);
+				if ((0 == ca_length[ca_count]) || ((offset + 3 + ca_length[ca_count]) > *p_cert_size))
+				{
+					break;
+				}
+				ca_offset[ca_count] = (uint16_t)(offset + 3);
+				offset += 3 + ca_length[ca_count];
+				ca_count++;
+			}
+			// The chain is ordered from the end device to the root, hence the CAs are added from the root side
+			while (0 != ca_count)
+			{
+				ca_count--;
+				if (CRYPTO_LIB_OK != pal_crypt_ca_cache_add(p_cert + ca_offset[ca_count], ca_length[ca_count]))
+				{
+					configPRINTF(("Error: intermediate CA isn't added to the cache\r\n"));
+				}
+			}
+
+			*p_cert_size = (uint16_t)cert_length;
+			memmove(p_cert, p_cert + 9, *p_cert_size);
 			status = OPTIGA_LIB_SUCCESS;
 			break;
 		/* USB Type-C identity
@@ -547,6 +590,17 @@ optiga_lib_status_t example_authenticate_chip(void)
 			break;
 		}
 
+		if (FALSE == ca_cache_ready)
+		{
+			status = pal_crypt_ca_cache_init(optiga_ca_certificate, sizeof(optiga_ca_certificate));
+			if(CRYPTO_LIB_OK != status)
+			{
+				configPRINTF(("Error: CA cache init failed (status=0x%x).\r\n", status));
+				break;
+			}
+			ca_cache_ready = TRUE;
+		}
+
 		configPRINTF(("Read default cert and verify it\r\n"));
 
 		// Read security chip certificate
@@ -557,24 +611,14 @@ optiga_lib_status_t example_authenticate_chip(void)
 			break;
 		}
 
-		// Verify the end device certificate against the CA certificate
-		status = pal_crypt_verify_certificate(optiga_ca_certificate, sizeof(optiga_ca_certificate), chip_cert, chip_cert_size);
+		// Verify the end device certificate against the cached CA certificates and extract the Public Key
+		status = pal_crypt_verify_certificate_cached(chip_cert, chip_cert_size, chip_pubkey, &chip_pubkey_size);
 		if(CRYPTO_LIB_OK != status)
 		{
 			configPRINTF(("Error: verify cert failed. (status=0x%x)\r\n", status));
 			break;
 		}
 
-		configPRINTF(("Extract Public key from cert.\r\n"));
-
-		// Extract Public Key from the certificate
-		status = pal_crypt_get_public_key(chip_cert, chip_cert_size, chip_pubkey, &chip_pubkey_size);
-		if(CRYPTO_LIB_OK != status)
-		{
-			configPRINTF(("Error: extract public key failed. (status=0x%x)\r\n", status));
-			break;
-		}
-
 		configPRINTF(("Generate a Challenge using Private key and verify Response using Public Key.\r\n"));
     	status = Send_Challenge_Get_Response(chip_pubkey, chip_pubkey_size, chip_privkey_oid);
 		if(OPTIGA_LIB_SUCCESS != status)
@@ -189,6 +189,64 @@ optiga_lib_status_t pal_crypt_init(optiga_crypt_t * me);
 */
 optiga_lib_status_t  pal_crypt_random(uint16_t random_size, uint8_t* p_random);
 
+/// Maximum number of intermediate CA certificates, which are kept in the verified CA cache
+#ifndef PAL_CRYPT_CA_CACHE_MAX_INTERMEDIATES
+#define PAL_CRYPT_CA_CACHE_MAX_INTERMEDIATES        4
+#endif
+
+/**
+* Initialises the verified CA cache with the trusted root CA certificate. <br>
+* - The root CA certificate is parsed once and kept parsed, for all the subsequent certificate verifications. <br>
+* - The intermediate CA certificates in the cache are discarded. <br>
+*
+*\param[in] p_cacert               Pointer to the root CA certificate buffer. Should be DER encoded binary certificate.
+*\param[in] cacert_size            Root CA certificate buffer size
+*
+*\retval  #CRYPTO_LIB_OK
+*\retval  #CRYPTO_LIB_CERT_PARSE_FAIL
+*\retval  #CRYPTO_LIB_NULL_PARAM
+*\retval  #CRYPTO_LIB_LENZERO_ERROR
+*/
+optiga_lib_status_t pal_crypt_ca_cache_init(const uint8_t* p_cacert, uint16_t cacert_size);
+
+/**
+* Verifies an intermediate CA certificate against the verified CA cache and adds it to the cache. <br>
+* - An intermediate CA certificate is verified only once, the same certificate is found in the cache afterwards. <br>
+* - The intermediate CA certificate is trusted as issuer of the subsequent certificates, once it is in the cache. <br>
+*
+*\param[in] p_cert                 Pointer to the intermediate CA certificate buffer. Should be DER encoded binary certificate.
+*\param[in] cert_size              Intermediate CA certificate buffer size
+*
+*\retval  #CRYPTO_LIB_OK
+*\retval  #CRYPTO_LIB_ERROR                  The cache is not initialised
+*\retval  #CRYPTO_LIB_CERT_PARSE_FAIL
+*\retval  #CRYPTO_LIB_VERIFY_SIGN_FAIL
+*\retval  #CRYPTO_LIB_INSUFFICIENT_MEMORY    The cache is full (PAL_CRYPT_CA_CACHE_MAX_INTERMEDIATES)
+*\retval  #CRYPTO_LIB_NULL_PARAM
+*\retval  #CRYPTO_LIB_LENZERO_ERROR
+*/
+optiga_lib_status_t pal_crypt_ca_cache_add(const uint8_t* p_cert, uint16_t cert_size);
+
+/**
+* Verifies the certificate against the verified CA cache and extracts the public key of it. <br>
+* - The certificate is parsed once for the verification and for the extraction of public key. <br>
+* - Only the signature of the certificate itself is verified, the issuers in the cache are already verified. <br>
+*
+*\param[in] p_cert                 Pointer to the certificate buffer. Should be DER encoded binary certificate.
+*\param[in] cert_size              Certificate buffer size
+*\param[in] p_pubkey               Pointer to the buffer where to store a public key
+*\param[in][out] p_pubkey_size     Variable where to store Public Key
+*
+*\retval  #CRYPTO_LIB_OK
+*\retval  #CRYPTO_LIB_ERROR                  The cache is not initialised
+*\retval  #CRYPTO_LIB_CERT_PARSE_FAIL
+*\retval  #CRYPTO_LIB_VERIFY_SIGN_FAIL
+*\retval  #CRYPTO_LIB_NULL_PARAM
+*\retval  #CRYPTO_LIB_LENZERO_ERROR
+*/
+optiga_lib_status_t pal_crypt_verify_certificate_cached(const uint8_t* p_cert, uint16_t cert_size,
+                                                        uint8_t* p_pubkey, uint16_t* p_pubkey_size);
+
 
 #endif //PAL_CRYPT
 
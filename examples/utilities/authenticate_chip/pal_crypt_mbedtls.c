@@ -31,6 +31,7 @@
 * @{
 */
 
+#include <string.h>
 #include "optiga/pal/pal_os_timer.h"
 #include "optiga/pal/pal_os_memory.h"
 #include "optiga/optiga_crypt.h"
@@ -55,6 +56,15 @@
 mbedtls_entropy_context 					entropy;
 mbedtls_ctr_drbg_context 					ctr_drbg;
 
+// NIST P-256 group, loaded once for all the signature verifications
+static mbedtls_ecp_group p256_group;
+static uint8_t p256_group_loaded = FALSE;
+
+// Verified CA cache, the root CA followed by the verified intermediate CAs
+static mbedtls_x509_crt trusted_ca_chain;
+static uint8_t trusted_ca_chain_ready = FALSE;
+static uint8_t trusted_intermediate_count = 0;
+
 #define PRINT_RANDOM    0
 
 /*-----------------------------------------------------------*/
@@ -160,7 +170,6 @@ static int32_t __verify_ecc_signature(const uint8_t* p_pubkey, uint16_t pubkey_s
     size_t    signature_rs_size = LENGTH_MAX_SIGNATURE;
     const uint8_t* p_pk = p_pubkey;
 
-    mbedtls_ecp_group grp;
     // Public Key
     mbedtls_ecp_point Q;
     mbedtls_mpi r;
@@ -169,9 +178,6 @@ static int32_t __verify_ecc_signature(const uint8_t* p_pubkey, uint16_t pubkey_s
     mbedtls_ecp_point_init( &Q );
     mbedtls_mpi_init( &r );
     mbedtls_mpi_init( &s );
-    mbedtls_ecp_group_init( &grp );
-
-    mbedtls_ecp_group_load(&grp, MBEDTLS_ECP_DP_SECP256R1);
 
     do
     {
@@ -181,8 +187,23 @@ static int32_t __verify_ecc_signature(const uint8_t* p_pubkey, uint16_t pubkey_s
             break;
         }
 
+        // The curve parameters are loaded only once, enable MBEDTLS_ECP_NIST_OPTIM for the fast P-256 reduction
+        if (FALSE == p256_group_loaded)
+        {
+            mbedtls_ecp_group_init( &p256_group );
+            if (0 != mbedtls_ecp_group_load(&p256_group, MBEDTLS_ECP_DP_SECP256R1))
+            {
+                status = (int32_t)CRYPTO_LIB_ERROR;
+                break;
+            }
+            p256_group_loaded = TRUE;
+        }
+
         //Import the public key
-        mbedtls_ecp_point_read_binary(&grp, &Q, p_pk, pubkey_size);
+        if (0 != mbedtls_ecp_point_read_binary(&p256_group, &Q, p_pk, pubkey_size))
+        {
+            break;
+        }
 
         //Import the signature
         asn1_to_ecdsa_rs(p_signature, signature_size, signature_rs, signature_rs_size);
@@ -190,9 +211,7 @@ static int32_t __verify_ecc_signature(const uint8_t* p_pubkey, uint16_t pubkey_s
         mbedtls_mpi_read_binary(&s, signature_rs + LENGTH_MAX_SIGNATURE/2, LENGTH_MAX_SIGNATURE/2);
 
         //Verify generated hash with given public key
-        status = mbedtls_ecdsa_verify(&grp, p_digest, digest_size, &Q, &r, &s);
-
-        if ( MBEDTLS_ERR_ECP_VERIFY_FAILED == status)
+        if (0 != mbedtls_ecdsa_verify(&p256_group, p_digest, digest_size, &Q, &r, &s))
         {
             status = (int32_t)CRYPTO_LIB_VERIFY_SIGN_FAIL;
             break;
@@ -201,6 +220,10 @@ static int32_t __verify_ecc_signature(const uint8_t* p_pubkey, uint16_t pubkey_s
         status = CRYPTO_LIB_OK;
     }while(FALSE);
 
+    mbedtls_ecp_point_free( &Q );
+    mbedtls_mpi_free( &r );
+    mbedtls_mpi_free( &s );
+
     return status;
 }
 
@@ -460,12 +483,200 @@ optiga_lib_status_t  pal_crypt_random(uint16_t random_size, uint8_t* p_random)
             break;
         }
 
-    	mbedtls_ctr_drbg_reseed( &ctr_drbg , p_random, random_size);
+        // Feed back the random without a reseed from the entropy source, the DRBG reseeds at its reseed interval
+        mbedtls_ctr_drbg_update_ret( &ctr_drbg , p_random, random_size);
+
+        status = CRYPTO_LIB_OK;
+    }while(FALSE);
+    return status;
+}
+
+optiga_lib_status_t pal_crypt_ca_cache_init(const uint8_t* p_cacert, uint16_t cacert_size)
+{
+    int32_t status  = (int32_t)CRYPTO_LIB_ERROR;
+
+    do
+    {
+        if (NULL == p_cacert)
+        {
+            status = (int32_t)CRYPTO_LIB_NULL_PARAM;
+            break;
+        }
+        if (0 == cacert_size)
+        {
+            status = (int32_t)CRYPTO_LIB_LENZERO_ERROR;
+            break;
+        }
+
+        // Discard the root and intermediate CAs of the previous initialisation
+        if (TRUE == trusted_ca_chain_ready)
+        {
+            mbedtls_x509_crt_free(&trusted_ca_chain);
+            trusted_ca_chain_ready = FALSE;
+        }
+        trusted_intermediate_count = 0;
+        mbedtls_x509_crt_init(&trusted_ca_chain);
+
+        if (0 != mbedtls_x509_crt_parse_der(&trusted_ca_chain, p_cacert, cacert_size))
+        {
+            mbedtls_x509_crt_free(&trusted_ca_chain);
+            status = (int32_t)CRYPTO_LIB_CERT_PARSE_FAIL;
+            break;
+        }
+        trusted_ca_chain_ready = TRUE;
+
+        status = CRYPTO_LIB_OK;
+    }while(FALSE);
+
+    return status;
+}
+
+optiga_lib_status_t pal_crypt_ca_cache_add(const uint8_t* p_cert, uint16_t cert_size)
+{
+    int32_t status  = (int32_t)CRYPTO_LIB_ERROR;
+    int32_t ret;
+    mbedtls_x509_crt mbedtls_cert;
+    const mbedtls_x509_crt * p_trusted;
+    uint32_t mbedtls_flags;
+
+    do
+    {
+        if (NULL == p_cert)
+        {
+            status = (int32_t)CRYPTO_LIB_NULL_PARAM;
+            break;
+        }
+        if (0 == cert_size)
+        {
+            status = (int32_t)CRYPTO_LIB_LENZERO_ERROR;
+            break;
+        }
+        if (FALSE == trusted_ca_chain_ready)
+        {
+            break;
+        }
+
+        // The same intermediate CA of the subsequent chips is found in the cache, without verification
+        for (p_trusted = &trusted_ca_chain; NULL != p_trusted; p_trusted = p_trusted->next)
+        {
+            if ((p_trusted->raw.len == cert_size) && (0 == memcmp(p_trusted->raw.p, p_cert, cert_size)))
+            {
+                break;
+            }
+        }
+        if (NULL != p_trusted)
+        {
+            status = CRYPTO_LIB_OK;
+            break;
+        }
+
+        if (PAL_CRYPT_CA_CACHE_MAX_INTERMEDIATES <= trusted_intermediate_count)
+        {
+            status = (int32_t)CRYPTO_LIB_INSUFFICIENT_MEMORY;
+            break;
+        }
+
+        mbedtls_x509_crt_init(&mbedtls_cert);
+        if (0 != mbedtls_x509_crt_parse_der(&mbedtls_cert, p_cert, cert_size))
+        {
+            mbedtls_x509_crt_free(&mbedtls_cert);
+            status = (int32_t)CRYPTO_LIB_CERT_PARSE_FAIL;
+            break;
+        }
+        // Only a CA certificate is accepted as the issuer of the subsequent certificates
+        if (0 == mbedtls_cert.ca_istrue)
+        {
+            mbedtls_x509_crt_free(&mbedtls_cert);
+            status = (int32_t)CRYPTO_LIB_CERT_PARSE_FAIL;
+            break;
+        }
+        ret = mbedtls_x509_crt_verify(&mbedtls_cert, &trusted_ca_chain, NULL, NULL, &mbedtls_flags, NULL, NULL);
+        mbedtls_x509_crt_free(&mbedtls_cert);
+        if (0 != ret)
+        {
+            configPRINTF(("mbedtls_x509_crt_verify intermediate ca cert failed (status=%x)\r\n",ret));
+            status = (int32_t)CRYPTO_LIB_VERIFY_SIGN_FAIL;
+            break;
+        }
+
+        // Verified intermediate CA is appended to the trusted CAs, hence it is not verified again
+        if (0 != mbedtls_x509_crt_parse_der(&trusted_ca_chain, p_cert, cert_size))
+        {
+            status = (int32_t)CRYPTO_LIB_CERT_PARSE_FAIL;
+            break;
+        }
+        trusted_intermediate_count++;
 
         status = CRYPTO_LIB_OK;
     }while(FALSE);
+
     return status;
 }
 
+optiga_lib_status_t pal_crypt_verify_certificate_cached(const uint8_t* p_cert, uint16_t cert_size,
+                                                        uint8_t* p_pubkey, uint16_t* p_pubkey_size)
+{
+    int32_t status  = (int32_t)CRYPTO_LIB_ERROR;
+    int32_t ret;
+    mbedtls_x509_crt mbedtls_cert;
+    uint32_t mbedtls_flags;
+    size_t pubkey_size = 0;
+    mbedtls_ecp_keypair * mbedtls_keypair = NULL;
 
+    do
+    {
+        if ((NULL == p_cert) || (NULL == p_pubkey) || (NULL == p_pubkey_size))
+        {
+            status = (int32_t)CRYPTO_LIB_NULL_PARAM;
+            break;
+        }
+        if ((0 == cert_size) || (0 == *p_pubkey_size))
+        {
+            status = (int32_t)CRYPTO_LIB_LENZERO_ERROR;
+            break;
+        }
+        if (FALSE == trusted_ca_chain_ready)
+        {
+            break;
+        }
 
+        mbedtls_x509_crt_init(&mbedtls_cert);
+        do
+        {
+            if (0 != mbedtls_x509_crt_parse_der(&mbedtls_cert, p_cert, cert_size))
+            {
+                status = (int32_t)CRYPTO_LIB_CERT_PARSE_FAIL;
+                break;
+            }
+
+            // The issuer is found in the cache, only the signature of the certificate itself is verified
+            if ((ret = mbedtls_x509_crt_verify(&mbedtls_cert, &trusted_ca_chain, NULL, NULL, &mbedtls_flags, NULL, NULL)) != 0)
+            {
+                configPRINTF(("mbedtls_x509_crt_verify failed (status=%x)\r\n",ret));
+                status = (int32_t)CRYPTO_LIB_VERIFY_SIGN_FAIL;
+                break;
+            }
+
+            // Public key is extracted from the same parsed certificate
+            if (MBEDTLS_PK_ECKEY != mbedtls_pk_get_type(&mbedtls_cert.pk))
+            {
+                status = (int32_t)CRYPTO_LIB_CERT_PARSE_FAIL;
+                break;
+            }
+            mbedtls_keypair = mbedtls_pk_ec(mbedtls_cert.pk);
+            if (0 != mbedtls_ecp_point_write_binary(&mbedtls_keypair->grp, &mbedtls_keypair->Q,
+                                                    MBEDTLS_ECP_PF_UNCOMPRESSED, &pubkey_size,
+                                                    p_pubkey, *p_pubkey_size))
+            {
+                status = (int32_t)CRYPTO_LIB_CERT_PARSE_FAIL;
+                break;
+            }
+            *p_pubkey_size = (uint16_t)pubkey_size;
+
+            status = CRYPTO_LIB_OK;
+        }while(FALSE);
+        mbedtls_x509_crt_free(&mbedtls_cert);
+    }while(FALSE);
+
+    return status;
+}
@@ -0,0 +1,255 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_provisioning.h
+*
+* \brief   This file defines the provisioning engine, which applies a provisioning profile to several OPTIGA devices.
+*
+* \details
+* The provisioning engine is intended for the programming fixtures, which drive several OPTIGA devices on
+* separate buses (OPTIGA instances 0 to device count - 1).
+* - A provisioning profile declares the data objects, the metadata and the keys to be generated, in the
+*   order of the steps. The same profile is applied to all the devices.
+* - The application is opened on each device and the steps of the devices are executed concurrently.
+*   Each step is issued from the completion of the previous step in the event context of the device,
+*   hence the devices are not waiting for each other and the host does not poll in between.
+* - The completion time of each step, the total time of each device and the public keys of the generated
+*   keys are provided per device.
+*
+* \ingroup  grOptigaExample
+*
+* @{
+*/
+
+#ifndef _OPTIGA_PROVISIONING_H_
+#define _OPTIGA_PROVISIONING_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "optiga/optiga_util.h"
+#include "optiga/optiga_crypt.h"
+
+/// Maximum number of steps of a provisioning profile
+#ifndef OPTIGA_PROVISIONING_MAX_STEPS
+#define OPTIGA_PROVISIONING_MAX_STEPS               (0x10)
+#endif
+/// Maximum number of keys generated by a provisioning profile
+#ifndef OPTIGA_PROVISIONING_MAX_KEYS
+#define OPTIGA_PROVISIONING_MAX_KEYS                (0x04)
+#endif
+/// Maximum size of a public key, the DER BIT STRING of a NIST P-384 public key
+#ifndef OPTIGA_PROVISIONING_MAX_PUBLIC_KEY_SIZE
+#define OPTIGA_PROVISIONING_MAX_PUBLIC_KEY_SIZE     (0x68)
+#endif
+
+/** \brief Type of a provisioning step */
+typedef enum optiga_provisioning_step_type
+{
+    /// Writes the data object (erase and write)
+    OPTIGA_PROVISIONING_WRITE_DATA = 0x01,
+    /// Writes the metadata of the data object or key object
+    OPTIGA_PROVISIONING_WRITE_METADATA,
+    /// Generates an ECC key pair in the key object, the public key is provided in the device results
+    OPTIGA_PROVISIONING_GENERATE_ECC_KEYPAIR,
+}optiga_provisioning_step_type_t;
+
+/** \brief Step of a provisioning profile */
+typedef struct optiga_provisioning_step
+{
+    /// Type of the step
+    optiga_provisioning_step_type_t type;
+    /// Data object or key object
+    uint16_t oid;
+    /// Data or metadata to be written, not used for the key generation
+    const uint8_t * p_data;
+    /// Length of the data or metadata
+    uint16_t length;
+    /// Curve of the key (#optiga_ecc_curve_t), only used for the key generation
+    uint8_t key_type;
+    /// Key usage (#optiga_key_usage_t), only used for the key generation
+    uint8_t key_usage;
+}optiga_provisioning_step_t;
+
+/** \brief Provisioning profile, the steps applied to each device in the given order */
+typedef struct optiga_provisioning_profile
+{
+    /// Steps of the profile
+    const optiga_provisioning_step_t * p_steps;
+    /// Number of steps, up to #OPTIGA_PROVISIONING_MAX_STEPS
+    uint8_t step_count;
+}optiga_provisioning_profile_t;
+
+/** \brief Provisioning state and results of a device */
+typedef struct optiga_provisioning_device
+{
+    /// Util instance of the device
+    optiga_util_t * p_util;
+#ifdef OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED
+    /// Crypt instance of the device
+    optiga_crypt_t * p_crypt;
+#endif
+    /// Engine which owns the device
+    void * p_engine;
+    /// Start time of the provisioning (in microseconds)
+    uint32_t start_time;
+    /// Time from the start until the application was opened (in microseconds)
+    uint32_t open_time_us;
+    /// Time from the start until each step was completed (in microseconds)
+    uint32_t step_time_us[OPTIGA_PROVISIONING_MAX_STEPS];
+    /// Time from the start until the last step was completed or the provisioning failed (in microseconds)
+    uint32_t total_time_us;
+    /// Public keys of the generated keys, in the order of the key generation steps
+    uint8_t public_key[OPTIGA_PROVISIONING_MAX_KEYS][OPTIGA_PROVISIONING_MAX_PUBLIC_KEY_SIZE];
+    /// Length of the public keys
+    uint16_t public_key_length[OPTIGA_PROVISIONING_MAX_KEYS];
+    /// Key object of the key generation in progress
+    uint16_t key_oid;
+    /// Result of the provisioning, OPTIGA_LIB_BUSY while in progress
+    volatile optiga_lib_status_t status;
+    /// Number of completed steps, the step in progress or the failed step if the application is opened
+    uint8_t step;
+    /// Number of generated keys
+    uint8_t key_count;
+    /// Indicates the application is opened
+    uint8_t opened;
+    /// OPTIGA instance of the device
+    uint8_t optiga_instance_id;
+}optiga_provisioning_device_t;
+
+/**
+ * \brief Callback of the provisioning engine, invoked once all the devices completed or failed.
+ *
+ * \param[in]  p_context    Caller context provided to #optiga_provisioning_start.
+ * \param[in]  failed_count Number of devices, which failed.
+ */
+typedef void (*optiga_provisioning_callback_t)(void * p_context, uint8_t failed_count);
+
+/** \brief Provisioning engine structure */
+typedef struct optiga_provisioning_engine
+{
+    /// Devices, one per OPTIGA instance
+    optiga_provisioning_device_t devices[OPTIGA_MAX_NUMBER_OF_INSTANCES];
+    /// Profile in progress
+    const optiga_provisioning_profile_t * p_profile;
+    /// Callback of the caller
+    optiga_provisioning_callback_t handler;
+    /// Caller context
+    void * caller_context;
+    /// Start time of the provisioning (in microseconds)
+    uint32_t start_time;
+    /// Time from the start until all the devices completed (in microseconds)
+    uint32_t total_time_us;
+    /// Number of devices
+    uint8_t device_count;
+    /// Number of devices in progress
+    uint8_t pending_count;
+    /// Number of devices, which failed
+    uint8_t failed_count;
+}optiga_provisioning_engine_t;
+
+/**
+ * \brief Initializes the provisioning engine.
+ *
+ * \details
+ * Creates the util instance (and the crypt instance, if the key generation is enabled) of each device.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ * - Each device uses the OPTIGA instance of its index, up to OPTIGA_MAX_NUMBER_OF_INSTANCES.
+ *
+ * \param[in,out]  me                                       Pointer to engine, must not be NULL.
+ * \param[in]      device_count                             Number of devices.
+ *
+ * \retval         #OPTIGA_UTIL_SUCCESS                     Successful invocation.
+ * \retval         #OPTIGA_UTIL_ERROR_INVALID_INPUT         Wrong Input arguments provided.
+ * \retval         #OPTIGA_UTIL_ERROR                       Creation of an instance failed.
+ */
+optiga_lib_status_t optiga_provisioning_init(optiga_provisioning_engine_t * me, uint8_t device_count);
+
+/**
+ * \brief Applies the provisioning profile to all the devices.
+ *
+ * \details
+ * Opens the application on each device and executes the steps of the profile, concurrently on all the devices.
+ * - Each step of a device is issued from the completion of the previous step.
+ * - A device stops at the first failed step, the further devices continue.
+ * - The callback is invoked from the event context of the last device, which completed.
+ *
+ * \pre
+ * - #optiga_provisioning_init is invoked.
+ *
+ * \note
+ * - The profile and the data of the steps must be valid until the callback is invoked.
+ * - The results of each device are valid after the callback is invoked.
+ *
+ * \param[in,out]  me                                       Pointer to engine, must not be NULL.
+ * \param[in]      p_profile                                Provisioning profile, must not be NULL.
+ * \param[in]      handler                                  Callback, invoked once all the devices completed.
+ * \param[in]      caller_context                           Caller context provided to the callback.
+ *
+ * \retval         #OPTIGA_UTIL_SUCCESS                     Successful invocation, the provisioning is started.
+ * \retval         #OPTIGA_UTIL_ERROR_INVALID_INPUT         Wrong Input arguments provided.
+ * \retval         #OPTIGA_UTIL_ERROR_INSTANCE_IN_USE       The provisioning is in progress.
+ */
+optiga_lib_status_t optiga_provisioning_start(optiga_provisioning_engine_t * me,
+                                              const optiga_provisioning_profile_t * p_profile,
+                                              optiga_provisioning_callback_t handler,
+                                              void * caller_context);
+
+/**
+ * \brief Prints the result and the timing of each device.
+ *
+ * \param[in]      me                                       Pointer to engine, must not be NULL.
+ */
+void optiga_provisioning_print_report(const optiga_provisioning_engine_t * me);
+
+/**
+ * \brief De-initializes the provisioning engine and destroys the instances.
+ *
+ * \param[in,out]  me                                       Pointer to engine, must not be NULL.
+ *
+ * \retval         #OPTIGA_UTIL_SUCCESS                     Successful invocation.
+ * \retval         #OPTIGA_UTIL_ERROR_INVALID_INPUT         Wrong Input arguments provided.
+ * \retval         #OPTIGA_UTIL_ERROR_INSTANCE_IN_USE       The provisioning is in progress.
+ */
+optiga_lib_status_t optiga_provisioning_deinit(optiga_provisioning_engine_t * me);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_OPTIGA_PROVISIONING_H_*/
+
+/**
+* @}
+*/
@@ -42,11 +42,56 @@
 extern "C" {
 #endif
 
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include <stdint.h>
+
 /**
  *
  */
 void optiga_trust_init(void);
 
+#ifdef MBEDTLS_X509_CRT_PARSE_C
+#include "mbedtls/x509_crt.h"
+
+/// Number of data objects, of which the certificate chains are cached
+#ifndef OPTIGA_TRUST_CERT_CACHE_SIZE
+#define OPTIGA_TRUST_CERT_CACHE_SIZE    (2)
+#endif
+/// Maximum size of a certificate data object
+#ifndef OPTIGA_TRUST_CERT_MAX_SIZE
+#define OPTIGA_TRUST_CERT_MAX_SIZE      (1728)
+#endif
+
+/**
+ * \brief Provides the certificate chain stored in a data object of OPTIGA, e.g. the device certificate in 0xE0E0.
+ *
+ * \details
+ * The data object is read only on the first call, the DER (single certificate or TLS identity format) is parsed
+ * without conversion to PEM and the parsed chain is cached for the lifetime of the process.
+ * The chain can be provided to mbedtls_ssl_conf_own_cert or mbedtls_ssl_conf_ca_chain.
+ *
+ * \note
+ * - The chain is released by #optiga_trust_invalidate_certificate_chain, which is invoked by write_data_object.
+ *
+ * \param[in]  oid     Data object, which holds the certificate.
+ *
+ * \retval     Parsed certificate chain, NULL if the data object could not be read or parsed.
+ */
+mbedtls_x509_crt * optiga_trust_get_certificate_chain(uint16_t oid);
+
+/**
+ * \brief Releases the cached certificate chain of a data object, which is read again on the next request.
+ *
+ * \param[in]  oid     Data object, which has been written.
+ */
+void optiga_trust_invalidate_certificate_chain(uint16_t oid);
+#endif //MBEDTLS_X509_CRT_PARSE_C
+
 #ifdef __cplusplus
 }
 #endif
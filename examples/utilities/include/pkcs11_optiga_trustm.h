@@ -65,9 +65,53 @@
 
 /**
  * @brief Maximum number of token objects that can be stored
- * by the PKCS #11 module.
+ * by the PKCS #11 module, including the objects indexed at C_Initialize.
  */
-#define MAX_NUM_OBJECTS      6
+#define MAX_NUM_OBJECTS      16
+
+/**
+ * @brief Set to 1 if C_Digest* is calculated on host using the pal crypt library.
+ *
+ * If set to 0, the digest is calculated by OPTIGA(TM) Trust M and all the data is sent over the interface.
+ * Digests of public data are much faster on host.
+ */
+#ifndef PKCS11_DIGEST_ON_HOST
+#define PKCS11_DIGEST_ON_HOST                  1
+#endif
+
+/**
+ * @brief Set to 1 to hibernate the application on OPTIGA(TM) Trust M at C_Finalize and restore it at C_Initialize.
+ *
+ * The next process, which loads the module, continues the application context instead of initializing OPTIGA again.
+ * The hibernate context must persist across processes in the datastore (e.g. PAL_OS_DATASTORE_DIR on linux).
+ * If no hibernated context is available, e.g. after a power on, the application is opened with a clean context.
+ */
+#ifndef PKCS11_HIBERNATE_ON_FINALIZE
+#define PKCS11_HIBERNATE_ON_FINALIZE           0
+#endif
+
+/**
+ * @brief Set to 1 to serve C_GenerateRandom from the random pool of the host library (OPTIGA_CRYPT_RANDOM_POOL_ENABLED).
+ *
+ * Requests up to the pool size are served from random bytes prefetched into host memory, without any command to
+ * OPTIGA(TM) Trust M. The pooled bytes are readable in host memory until served, hence this is disabled by default.
+ */
+#ifndef PKCS11_RANDOM_FROM_POOL
+#define PKCS11_RANDOM_FROM_POOL                0
+#endif
+
+/**
+ * @brief Write back of the public key returned by C_GenerateKeyPair to its data object.
+ *
+ * The public key is served from the object cache in any case.
+ * - 0: The public key is not written to the data object, hence it is available until C_Finalize only.
+ * - 1: The public key is written, before C_GenerateKeyPair returns.
+ * - 2: The public key is written asynchronously. C_Finalize and the next C_GenerateKeyPair wait for the completion
+ *      and fail with CKR_DEVICE_ERROR, if the write failed.
+ */
+#ifndef PKCS11_PUBLIC_KEY_WRITE_BACK
+#define PKCS11_PUBLIC_KEY_WRITE_BACK           1
+#endif
 
 /**
  * @brief Set to 1 if a PAL destroy object is implemented.
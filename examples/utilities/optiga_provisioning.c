@@ -0,0 +1,359 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_provisioning.c
+*
+* \brief   This file implements the provisioning engine, which applies a provisioning profile to several OPTIGA devices.
+*
+* \ingroup  grOptigaExample
+*
+* @{
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "optiga/pal/pal_os_lock.h"
+#include "optiga/pal/pal_os_timer.h"
+#include "optiga_provisioning.h"
+
+/*
+* Completes the provisioning of a device, the callback is invoked once the last device completed
+*/
+static void optiga_provisioning_device_done(optiga_provisioning_device_t * p_device, optiga_lib_status_t status)
+{
+    optiga_provisioning_engine_t * me = (optiga_provisioning_engine_t *)p_device->p_engine;
+    uint8_t pending_count;
+
+    p_device->total_time_us = pal_os_timer_get_time_in_microseconds() - p_device->start_time;
+    p_device->status = status;
+
+    pal_os_lock_enter_critical_section();
+    if (OPTIGA_LIB_SUCCESS != status)
+    {
+        me->failed_count++;
+    }
+    me->pending_count--;
+    pending_count = me->pending_count;
+    pal_os_lock_exit_critical_section();
+
+    if (0U == pending_count)
+    {
+        me->total_time_us = pal_os_timer_get_time_in_microseconds() - me->start_time;
+        me->p_profile = NULL;
+        if (NULL != me->handler)
+        {
+            me->handler(me->caller_context, me->failed_count);
+        }
+    }
+}
+
+/*
+* Issues the next step of a device, or completes the device after the last step
+*/
+static void optiga_provisioning_execute_step(optiga_provisioning_device_t * p_device)
+{
+    const optiga_provisioning_profile_t * p_profile = ((optiga_provisioning_engine_t *)p_device->p_engine)->p_profile;
+    const optiga_provisioning_step_t * p_step;
+    optiga_lib_status_t return_status = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    if (p_device->step >= p_profile->step_count)
+    {
+        optiga_provisioning_device_done(p_device, OPTIGA_LIB_SUCCESS);
+        return;
+    }
+
+    p_step = &p_profile->p_steps[p_device->step];
+    switch (p_step->type)
+    {
+        case OPTIGA_PROVISIONING_WRITE_DATA:
+        {
+            return_status = optiga_util_write_data(p_device->p_util,
+                                                   p_step->oid,
+                                                   OPTIGA_UTIL_ERASE_AND_WRITE,
+                                                   0,
+                                                   p_step->p_data,
+                                                   p_step->length);
+        }
+        break;
+        case OPTIGA_PROVISIONING_WRITE_METADATA:
+        {
+            return_status = optiga_util_write_metadata(p_device->p_util,
+                                                       p_step->oid,
+                                                       p_step->p_data,
+                                                       (uint8_t)p_step->length);
+        }
+        break;
+#ifdef OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED
+        case OPTIGA_PROVISIONING_GENERATE_ECC_KEYPAIR:
+        {
+            p_device->key_oid = p_step->oid;
+            p_device->public_key_length[p_device->key_count] = OPTIGA_PROVISIONING_MAX_PUBLIC_KEY_SIZE;
+            return_status = optiga_crypt_ecc_generate_keypair(p_device->p_crypt,
+                                                              (optiga_ecc_curve_t)p_step->key_type,
+                                                              p_step->key_usage,
+                                                              FALSE,
+                                                              &p_device->key_oid,
+                                                              p_device->public_key[p_device->key_count],
+                                                              &p_device->public_key_length[p_device->key_count]);
+        }
+        break;
+#endif
+        default:
+        break;
+    }
+
+    if (OPTIGA_LIB_SUCCESS != return_status)
+    {
+        optiga_provisioning_device_done(p_device, return_status);
+    }
+}
+
+/*
+* Event handler of the util and crypt instances of a device, records the step and issues the next step
+*/
+static void optiga_provisioning_event_handler(void * p_ctx, optiga_lib_status_t event)
+{
+    optiga_provisioning_device_t * p_device = (optiga_provisioning_device_t *)p_ctx;
+    const optiga_provisioning_profile_t * p_profile = ((optiga_provisioning_engine_t *)p_device->p_engine)->p_profile;
+    uint32_t elapsed_time_us = pal_os_timer_get_time_in_microseconds() - p_device->start_time;
+
+    if (FALSE == p_device->opened)
+    {
+        p_device->open_time_us = elapsed_time_us;
+        p_device->opened = TRUE;
+    }
+    else
+    {
+        p_device->step_time_us[p_device->step] = elapsed_time_us;
+        if (OPTIGA_LIB_SUCCESS == event)
+        {
+            if (OPTIGA_PROVISIONING_GENERATE_ECC_KEYPAIR == p_profile->p_steps[p_device->step].type)
+            {
+                p_device->key_count++;
+            }
+            p_device->step++;
+        }
+    }
+
+    if (OPTIGA_LIB_SUCCESS != event)
+    {
+        optiga_provisioning_device_done(p_device, event);
+        return;
+    }
+    optiga_provisioning_execute_step(p_device);
+}
+
+optiga_lib_status_t optiga_provisioning_init(optiga_provisioning_engine_t * me, uint8_t device_count)
+{
+    optiga_lib_status_t return_status = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+    optiga_provisioning_device_t * p_device;
+    uint8_t index;
+
+    do
+    {
+        if ((NULL == me) || (0U == device_count) || (OPTIGA_MAX_NUMBER_OF_INSTANCES < device_count))
+        {
+            break;
+        }
+        memset(me, 0x00, sizeof(optiga_provisioning_engine_t));
+        me->device_count = device_count;
+
+        return_status = OPTIGA_UTIL_SUCCESS;
+        for (index = 0; index < device_count; index++)
+        {
+            p_device = &me->devices[index];
+            p_device->p_engine = me;
+            p_device->optiga_instance_id = index;
+            p_device->status = OPTIGA_UTIL_ERROR;
+
+            p_device->p_util = optiga_util_create(index, optiga_provisioning_event_handler, p_device);
+#ifdef OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED
+            p_device->p_crypt = optiga_crypt_create(index, optiga_provisioning_event_handler, p_device);
+            if (NULL == p_device->p_crypt)
+            {
+                return_status = OPTIGA_UTIL_ERROR;
+            }
+#endif
+            if (NULL == p_device->p_util)
+            {
+                return_status = OPTIGA_UTIL_ERROR;
+            }
+        }
+
+        if (OPTIGA_UTIL_SUCCESS != return_status)
+        {
+            //lint --e{534} suppress "The instances are not in use, the creation error is returned"
+            optiga_provisioning_deinit(me);
+        }
+    } while (FALSE);
+
+    return (return_status);
+}
+
+optiga_lib_status_t optiga_provisioning_start(optiga_provisioning_engine_t * me,
+                                              const optiga_provisioning_profile_t * p_profile,
+                                              optiga_provisioning_callback_t handler,
+                                              void * caller_context)
+{
+    optiga_lib_status_t return_status = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+    optiga_provisioning_device_t * p_device;
+    uint8_t key_count = 0;
+    uint8_t index;
+
+    do
+    {
+        if ((NULL == me) || (NULL == p_profile) || (0U == me->device_count) ||
+            ((NULL == p_profile->p_steps) && (0U != p_profile->step_count)) ||
+            (OPTIGA_PROVISIONING_MAX_STEPS < p_profile->step_count))
+        {
+            break;
+        }
+        if (NULL != me->p_profile)
+        {
+            return_status = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+
+        // The profile is checked once, not per device
+        for (index = 0; index < p_profile->step_count; index++)
+        {
+            if (OPTIGA_PROVISIONING_GENERATE_ECC_KEYPAIR == p_profile->p_steps[index].type)
+            {
+                key_count++;
+            }
+            else if ((NULL == p_profile->p_steps[index].p_data) ||
+                     ((OPTIGA_PROVISIONING_WRITE_METADATA == p_profile->p_steps[index].type) &&
+                      (0xFFU < p_profile->p_steps[index].length)))
+            {
+                break;
+            }
+        }
+        if ((index < p_profile->step_count) || (OPTIGA_PROVISIONING_MAX_KEYS < key_count))
+        {
+            break;
+        }
+
+        me->p_profile = p_profile;
+        me->handler = handler;
+        me->caller_context = caller_context;
+        me->failed_count = 0;
+        me->total_time_us = 0;
+        // All the devices are pending, before the first device can complete
+        me->pending_count = me->device_count;
+        me->start_time = pal_os_timer_get_time_in_microseconds();
+
+        for (index = 0; index < me->device_count; index++)
+        {
+            p_device = &me->devices[index];
+            memset(p_device->step_time_us, 0x00, sizeof(p_device->step_time_us));
+            p_device->open_time_us = 0;
+            p_device->total_time_us = 0;
+            p_device->step = 0;
+            p_device->key_count = 0;
+            p_device->opened = FALSE;
+            p_device->status = OPTIGA_LIB_BUSY;
+            p_device->start_time = me->start_time;
+
+            return_status = optiga_util_open_application(p_device->p_util, 0);
+            if (OPTIGA_LIB_SUCCESS != return_status)
+            {
+                optiga_provisioning_device_done(p_device, return_status);
+            }
+        }
+        return_status = OPTIGA_UTIL_SUCCESS;
+    } while (FALSE);
+
+    return (return_status);
+}
+
+void optiga_provisioning_print_report(const optiga_provisioning_engine_t * me)
+{
+    const optiga_provisioning_device_t * p_device;
+    uint8_t index;
+    uint8_t step;
+
+    printf("Provisioning of %d devices: %d failed, %lu us\r\n",
+           me->device_count, me->failed_count, (unsigned long)me->total_time_us);
+    for (index = 0; index < me->device_count; index++)
+    {
+        p_device = &me->devices[index];
+        printf("Device %d: status 0x%04X, %lu us, open %lu us",
+               p_device->optiga_instance_id, p_device->status,
+               (unsigned long)p_device->total_time_us, (unsigned long)p_device->open_time_us);
+        // The step time is recorded until the failed step
+        for (step = 0; (step < OPTIGA_PROVISIONING_MAX_STEPS) && (0U != p_device->step_time_us[step]); step++)
+        {
+            printf(", step %d %lu us", step, (unsigned long)p_device->step_time_us[step]);
+        }
+        printf("\r\n");
+    }
+}
+
+optiga_lib_status_t optiga_provisioning_deinit(optiga_provisioning_engine_t * me)
+{
+    optiga_lib_status_t return_status = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+    uint8_t index;
+
+    do
+    {
+        if (NULL == me)
+        {
+            break;
+        }
+        if (NULL != me->p_profile)
+        {
+            return_status = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        for (index = 0; index < me->device_count; index++)
+        {
+            if (NULL != me->devices[index].p_util)
+            {
+                //lint --e{534} suppress "The instance is not in use, return value is not required to be checked"
+                optiga_util_destroy(me->devices[index].p_util);
+                me->devices[index].p_util = NULL;
+            }
+#ifdef OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED
+            if (NULL != me->devices[index].p_crypt)
+            {
+                //lint --e{534} suppress "The instance is not in use, return value is not required to be checked"
+                optiga_crypt_destroy(me->devices[index].p_crypt);
+                me->devices[index].p_crypt = NULL;
+            }
+#endif
+        }
+        me->device_count = 0;
+        return_status = OPTIGA_UTIL_SUCCESS;
+    } while (FALSE);
+
+    return (return_status);
+}
+
+/**
+* @}
+*/
@@ -44,6 +44,7 @@
 #include "optiga/ifx_i2c/ifx_i2c_config.h"
 #include "optiga/pal/pal_ifx_i2c_config.h"
 #include "mbedtls/base64.h"
+#include "optiga_trust.h"
 
 #ifndef CONFIG_OPTIGA_TRUST_M_CERT_SLOT
 #define CONFIG_OPTIGA_TRUST_M_CERT_SLOT 0xE0E0
@@ -234,6 +235,148 @@ void read_trust_anchor_from_optiga(uint16_t oid, char * cert_pem, uint16_t * cer
     }
 }
 
+#ifdef MBEDTLS_X509_CRT_PARSE_C
+/**
+ * Certificate chains parsed from OPTIGA, kept for the lifetime of the process
+ */
+typedef struct optiga_trust_cert_cache_entry
+{
+    uint16_t oid;
+    uint8_t valid;
+    mbedtls_x509_crt chain;
+} optiga_trust_cert_cache_entry_t;
+
+static optiga_trust_cert_cache_entry_t optiga_trust_cert_cache[OPTIGA_TRUST_CERT_CACHE_SIZE];
+// Data objects of certificates are read only once, hence a single buffer is shared
+static uint8_t optiga_trust_cert_der[OPTIGA_TRUST_CERT_MAX_SIZE];
+
+static uint32_t optiga_trust_read_length(const uint8_t * p_data)
+{
+    return (((uint32_t)p_data[0] << 16) | ((uint32_t)p_data[1] << 8) | p_data[2]);
+}
+
+/**
+ * Parses a plain DER certificate or the TLS identity format
+ * (0xC0, length, chain length, {certificate length, certificate})
+ */
+static int optiga_trust_parse_chain(mbedtls_x509_crt * chain, const uint8_t * p_der, uint16_t der_length)
+{
+    uint32_t offset;
+    uint32_t cert_length;
+    uint32_t chain_end;
+    int ret = MBEDTLS_ERR_X509_INVALID_FORMAT;
+
+    if ((der_length > 0) && (0x30 == p_der[0]))
+    {
+        return (mbedtls_x509_crt_parse_der(chain, p_der, der_length));
+    }
+    if ((der_length < 6) || (0xC0 != p_der[0]))
+    {
+        return (ret);
+    }
+    chain_end = 6 + optiga_trust_read_length(&p_der[3]);
+    if (chain_end > der_length)
+    {
+        return (ret);
+    }
+    for (offset = 6; (offset + 3) <= chain_end; offset += cert_length)
+    {
+        cert_length = optiga_trust_read_length(&p_der[offset]);
+        offset += 3;
+        if ((offset + cert_length) > chain_end)
+        {
+            return (MBEDTLS_ERR_X509_INVALID_FORMAT);
+        }
+        ret = mbedtls_x509_crt_parse_der(chain, &p_der[offset], cert_length);
+        if (0 != ret)
+        {
+            break;
+        }
+    }
+    return (ret);
+}
+
+mbedtls_x509_crt * optiga_trust_get_certificate_chain(uint16_t oid)
+{
+    optiga_trust_cert_cache_entry_t * p_entry = NULL;
+    optiga_util_t * me_util = NULL;
+    optiga_lib_status_t return_status;
+    uint16_t der_length = sizeof(optiga_trust_cert_der);
+    uint8_t index;
+
+    for (index = 0; index < OPTIGA_TRUST_CERT_CACHE_SIZE; index++)
+    {
+        if ((optiga_trust_cert_cache[index].valid) && (oid == optiga_trust_cert_cache[index].oid))
+        {
+            return (&optiga_trust_cert_cache[index].chain);
+        }
+        if ((NULL == p_entry) && (!optiga_trust_cert_cache[index].valid))
+        {
+            p_entry = &optiga_trust_cert_cache[index];
+        }
+    }
+    if (NULL == p_entry)
+    {
+        optiga_lib_print_message("certificate cache is full",OPTIGA_UTIL_SERVICE,OPTIGA_UTIL_SERVICE_COLOR);
+        return (NULL);
+    }
+
+    do
+    {
+        me_util = optiga_util_create(0, optiga_util_callback, NULL);
+        if(!me_util)
+        {
+            optiga_lib_print_message("optiga_util_create failed !!!",OPTIGA_UTIL_SERVICE,OPTIGA_UTIL_SERVICE_COLOR);
+            break;
+        }
+        optiga_lib_status = OPTIGA_LIB_BUSY;
+        return_status = optiga_util_read_data(me_util, oid, 0, optiga_trust_cert_der, &der_length);
+        if (OPTIGA_LIB_SUCCESS != return_status)
+        {
+            optiga_lib_print_message("optiga_util_read_data api returns error !!!",OPTIGA_UTIL_SERVICE,OPTIGA_UTIL_SERVICE_COLOR);
+            break;
+        }
+        while (optiga_lib_status == OPTIGA_LIB_BUSY);
+        if (OPTIGA_LIB_SUCCESS != optiga_lib_status)
+        {
+            optiga_lib_print_message("optiga_util_read_data failed",OPTIGA_UTIL_SERVICE,OPTIGA_UTIL_SERVICE_COLOR);
+            break;
+        }
+
+        // The DER is parsed as is, no PEM conversion is required
+        mbedtls_x509_crt_init(&p_entry->chain);
+        if (0 != optiga_trust_parse_chain(&p_entry->chain, optiga_trust_cert_der, der_length))
+        {
+            mbedtls_x509_crt_free(&p_entry->chain);
+            optiga_lib_print_message("certificate parsing failed",OPTIGA_UTIL_SERVICE,OPTIGA_UTIL_SERVICE_COLOR);
+            break;
+        }
+        p_entry->oid = oid;
+        p_entry->valid = 1;
+    } while(0);
+
+    if (me_util)
+    {
+        optiga_util_destroy(me_util);
+    }
+    return ((p_entry->valid) ? &p_entry->chain : NULL);
+}
+
+void optiga_trust_invalidate_certificate_chain(uint16_t oid)
+{
+    uint8_t index;
+
+    for (index = 0; index < OPTIGA_TRUST_CERT_CACHE_SIZE; index++)
+    {
+        if ((optiga_trust_cert_cache[index].valid) && (oid == optiga_trust_cert_cache[index].oid))
+        {
+            mbedtls_x509_crt_free(&optiga_trust_cert_cache[index].chain);
+            optiga_trust_cert_cache[index].valid = 0;
+        }
+    }
+}
+#endif //MBEDTLS_X509_CRT_PARSE_C
+
 void write_data_object (uint16_t oid, const uint8_t * p_data, uint16_t length)
 {
     optiga_util_t * me_util = NULL;
@@ -281,6 +424,11 @@ void write_data_object (uint16_t oid, const uint8_t * p_data, uint16_t length)
         }
     } while (0);
 
+#ifdef MBEDTLS_X509_CRT_PARSE_C
+    // The cached chain would be stale, even if the write failed in between
+    optiga_trust_invalidate_certificate_chain(oid);
+#endif
+
     //me_util instance can be destroyed 
     //if no close_application w.r.t hibernate is required to be performed
     if (me_util)
@@ -40,9 +40,14 @@
 /* OPTIGA(TM) Trust M Includes */
 #include "optiga/optiga_crypt.h"
 #include "optiga/optiga_util.h"
+#include "optiga/common/optiga_lib_metadata.h"
+#include "optiga/optiga_crypt_random_pool.h"
 #include "ecdsa_utils.h"
 #include "optiga/pal/pal_os_lock.h"
+#include "optiga/pal/pal_crypt.h"
+#include "optiga/pal/pal_os_wait.h"
 #include "optiga/pal/pal_os_event.h"
+#include "optiga/pal/pal_os_timer.h"
 #include "optiga/pal/pal_i2c.h"
 #include "optiga/ifx_i2c/ifx_i2c_config.h"
 #include "optiga/pal/pal_ifx_i2c_config.h"
@@ -52,6 +57,7 @@
 
 #ifdef __linux__
 #include <semaphore.h>
+#include <time.h>
 #else
 //Platgorm specific header file
 #endif
@@ -68,6 +74,9 @@
 #define MAX_PUBLIC_KEY_SIZE           100
 
 #define MAX_DELAY                       50
+/* Length of random data generated by OPTIGA(TM) Trust M with one command */
+#define PKCS11_RANDOM_LENGTH_MIN        8
+#define PKCS11_RANDOM_LENGTH_MAX        0x100
 // Value of Operational state
 #define LCSO_STATE_CREATION           (0x01)
 // Value of Operational state
@@ -84,12 +93,24 @@
 //Currently set to Creation state(defualt value). At the real time/customer side this needs to be LCSO_STATE_OPERATIONAL (0x07)
 #define FINAL_LCSO_STATE          (LCSO_STATE_CREATION)
 
+// A valid platform binding is only verified at startup. Define this to generate a new secret at every startup.
+//#define PLATFORM_BINDING_SECRET_ROTATE_ON_STARTUP
+
 typedef struct pkcs11_object_t
 {
     CK_OBJECT_HANDLE object_handle;
     // If Label is associated with a private key slot.
     // This flag is used to mark it active/non-active, as we can't remove the private key
     CK_BYTE status_lable[ MAX_LABEL_LENGTH + 1 ]; /* Plus 1 for the null terminator. */
+    uint16_t optiga_oid;
+    CK_OBJECT_CLASS object_class;
+    CK_KEY_TYPE key_type;
+    // Curve of an EC key, derived from the metadata or the public key. 0 if not known.
+    optiga_ecc_curve_t ec_curve;
+    // Value of the object, read from OPTIGA on the first access and kept until the object is written or deleted
+    uint8_t * value;
+    uint32_t value_length;
+    CK_BBOOL value_cached;
 } pkcs11_object_t;
 
 
@@ -100,10 +121,11 @@ typedef struct pkcs11_object_list
 #else
     //Platform specific semaphore vriables 
 #endif
-    struct timespec timeout;
+    struct timespec timeout; /* Time out to acquire the semaphore, relative to the time of the request. */
     optiga_crypt_t* optiga_crypt_instance;
     optiga_util_t* optiga_util_instance;
     optiga_lib_status_t optiga_lib_status;
+    pal_os_wait_t optiga_wait; /* Signaled on completion of the operations of the shared instances. */
     pkcs11_object_t objects[ MAX_NUM_OBJECTS ];
 } pkcs11_object_list;
 
@@ -114,6 +136,16 @@ typedef struct pkcs11_context_struct
     pkcs11_object_list object_list;
     uint16_t certificate_oid;
     uint16_t private_key_oid;
+#if defined(OPTIGA_CRYPT_RANDOM_POOL_ENABLED) && (PKCS11_RANDOM_FROM_POOL == 1)
+    optiga_crypt_random_pool_t random_pool;
+    CK_BBOOL random_pool_initialized;
+#endif
+#if (PKCS11_PUBLIC_KEY_WRITE_BACK == 2)
+    optiga_util_t * write_back_instance; /* Writes the generated public keys, while the other instances are used. */
+    volatile optiga_lib_status_t write_back_status;
+    pal_os_wait_t write_back_wait;
+    uint8_t * write_back_buffer; /* Data of the pending write back, NULL if none is pending. */
+#endif
 } pkcs11_context_struct;
 
 static pkcs11_context_struct pkcs11_context;
@@ -133,15 +165,23 @@ typedef struct pkcs11_session
     CK_BBOOL opened;
     CK_MECHANISM_TYPE operation_in_progress;
     CK_BBOOL find_object_init;
-    CK_BBOOL find_object_complete;
+    CK_ULONG find_object_index; /* Position of the search in progress in the object list. */
     CK_BYTE * find_object_lable; /* Pointer to the label for the search in progress. Should be NULL if no search in progress. */
     uint8_t find_object_lable_length;
+    CK_OBJECT_CLASS find_object_class; /* CK_UNAVAILABLE_INFORMATION if the search is not restricted to a class. */
+    CK_KEY_TYPE find_object_key_type; /* CK_UNAVAILABLE_INFORMATION if the search is not restricted to a key type. */
     CK_MECHANISM_TYPE verify_mechanism;
     uint16_t verify_key_oid;
     CK_MECHANISM_TYPE sign_mechanism;      /* Mechanism of the sign operation in progress. Set during C_SignInit. */
     uint16_t sign_key_oid;
     CK_BBOOL sign_init_done;
     CK_BBOOL verify_init_done;
+    CK_BBOOL sign_hash_on_host;   /* Data of C_Sign is hashed on host before signing (CKM_ECDSA_SHA256). */
+    CK_BBOOL sign_digest_started; /* Digest of C_SignUpdate is calculated on host in sign_digest_ctx. */
+    uint8_t sign_digest_ctx[ OPTIGA_HASH_CONTEXT_LENGTH_SHA_256 ];
+    CK_BBOOL verify_hash_on_host;
+    CK_BBOOL verify_digest_started;
+    uint8_t verify_digest_ctx[ OPTIGA_HASH_CONTEXT_LENGTH_SHA_256 ];
     CK_BBOOL encrypt_init_done;
     CK_BBOOL decrypt_init_done;
     optiga_sha256_ctx_t sha256_ctx;
@@ -151,6 +191,9 @@ typedef struct pkcs11_session
     uint16_t encryption_key_oid;
     uint16_t decryption_key_oid;
     uint8_t key_template_enabled;
+    optiga_crypt_t * optiga_crypt_instance; /* Crypt instance of the session. NULL if the shared instance of the module is used. */
+    optiga_lib_status_t optiga_lib_status;
+    pal_os_wait_t optiga_wait; /* Signaled on completion of the operations of the crypt instance of the session. */
 } pkcs11_session_t, * p_pkcs11_session_t;
 
 pal_os_lock_t optiga_mutex;
@@ -197,58 +240,292 @@ static void optiga_callback(void * pvContext, optiga_lib_status_t xReturnStatus)
     {
         *xInstanceStatus = xReturnStatus;
     }
+    pal_os_wait_signal(&pkcs11_context.object_list.optiga_wait);
 }
 
+static void optiga_session_callback(void * pvContext, optiga_lib_status_t xReturnStatus)
+{
+    p_pkcs11_session_t pxSession = (p_pkcs11_session_t)pvContext;
+
+    if (NULL != pxSession)
+    {
+        pxSession->optiga_lib_status = xReturnStatus;
+        pal_os_wait_signal(&pxSession->optiga_wait);
+    }
+}
 
 /**
- * @brief Translates a PKCS #11 label into an object handle.
+ * @brief Blocks until the operation on OPTIGA(TM) Trust M is completed.
  *
- * Port-specific object handle retrieval.
+ * The caller sleeps on the wait object signaled by the callback of the instance, instead of spinning on the status.
+ * Signals of the completed operations, which are left over, only cause the status to be checked again.
+ */
+static void pkcs11_wait_for_completion( volatile optiga_lib_status_t * pxStatus, pal_os_wait_t * pxWait )
+{
+    while (OPTIGA_LIB_BUSY == *pxStatus)
+    {
+        pal_os_wait_for_signal(pxWait);
+    }
+}
+
+/**
+ * @brief Acquires the semaphore of the object list, waiting for the time out of the object list at most.
+ */
+static int32_t pkcs11_object_list_lock( void )
+{
+    int32_t get_semaphore = 0;
+#ifdef __linux__
+    struct timespec xDeadline;
+
+    clock_gettime( CLOCK_REALTIME, &xDeadline );
+    xDeadline.tv_sec += pkcs11_context.object_list.timeout.tv_sec;
+    xDeadline.tv_nsec += pkcs11_context.object_list.timeout.tv_nsec;
+    if( xDeadline.tv_nsec >= 1000000000L )
+    {
+        xDeadline.tv_sec++;
+        xDeadline.tv_nsec -= 1000000000L;
+    }
+    get_semaphore = sem_timedwait( &pkcs11_context.object_list.semaphore, &xDeadline );
+#endif
+    return get_semaphore;
+}
+
+#if (PKCS11_PUBLIC_KEY_WRITE_BACK == 2)
+static void pkcs11_write_back_callback(void * pvContext, optiga_lib_status_t xReturnStatus)
+{
+    ( void ) pvContext;
+
+    pkcs11_context.write_back_status = xReturnStatus;
+    pal_os_wait_signal(&pkcs11_context.write_back_wait);
+}
+
+/**
+ * @brief Waits for the completion of the pending write back and frees its data.
  *
+ * Must be invoked with optiga_mutex acquired.
  *
- * @param[in] pxLabel         Pointer to the label of the object
- *                           who's handle should be found.
- * @param[in] usLength       The length of the label, in bytes.
+ * @return CKR_OK if no write back is pending or it is successful, CKR_DEVICE_ERROR otherwise.
+ */
+static CK_RV pkcs11_write_back_complete( void )
+{
+    CK_RV xResult = CKR_OK;
+
+    if( NULL != pkcs11_context.write_back_buffer )
+    {
+        pkcs11_wait_for_completion(&pkcs11_context.write_back_status, &pkcs11_context.write_back_wait);
+        if (OPTIGA_LIB_SUCCESS != pkcs11_context.write_back_status)
+        {
+            PKCS11_PRINT( ( "ERROR: Failed to write back a public key \r\n" ) );
+            xResult = CKR_DEVICE_ERROR;
+        }
+        free( pkcs11_context.write_back_buffer );
+        pkcs11_context.write_back_buffer = NULL;
+    }
+
+    return xResult;
+}
+#endif
+
+
+/**
+ * @brief Objects of OPTIGA(TM) Trust M, which are indexed as token objects at C_Initialize.
+ */
+typedef struct pkcs11_object_index_entry
+{
+    uint16_t optiga_oid;
+    CK_OBJECT_HANDLE object_handle;
+} pkcs11_object_index_entry_t;
+
+static const pkcs11_object_index_entry_t pkcs11_object_index_entries[] =
+{
+    { 0xE0E0, DeviceCertificate },
+    { 0xE0E1, DeviceCertificate },
+    { 0xE0E2, DeviceCertificate },
+    { 0xE0E3, DeviceCertificate },
+    { 0xE0E8, DeviceCertificate },
+    { 0xE0E9, DeviceCertificate },
+    { 0xE0EF, CodeSigningKey },
+    { 0xE0F0, DevicePrivateKey },
+    { 0xE0F1, DevicePrivateKey },
+    { 0xE0F2, DevicePrivateKey },
+    { 0xE0F3, DevicePrivateKey },
+    { 0xE0FC, DevicePrivateKey },
+    { 0xE0FD, DevicePrivateKey },
+    { 0xF1D2, DevicePublicKey },
+    { 0xF1E0, DevicePublicKey }
+};
+
+/**
+ * @brief Provides the PKCS #11 class of an object, by handle used by the PAL.
+ */
+static CK_OBJECT_CLASS pkcs11_object_class( CK_OBJECT_HANDLE xPalHandle )
+{
+    CK_OBJECT_CLASS xClass;
+
+    switch( xPalHandle )
+    {
+        case DevicePrivateKey:
+            xClass = CKO_PRIVATE_KEY;
+            break;
+        case DevicePublicKey:
+            xClass = CKO_PUBLIC_KEY;
+            break;
+        default:
+            // Certificates and the code verification key/certificate in the trust anchor
+            xClass = CKO_CERTIFICATE;
+            break;
+    }
+    return xClass;
+}
+
+/**
+ * @brief Provides the PKCS #11 key type of an object, by OID.
  *
- * @return The object handle if operation was successful.
- * Returns eInvalidHandle if unsuccessful.
+ * RSA keys are stored in the RSA key objects and the public key object of LABEL_DEVICE_RSA_PUBLIC_KEY_FOR_TLS,
+ * all the other keys are EC keys.
  */
-CK_OBJECT_HANDLE find_object( uint8_t * pLabel,
-                                        uint8_t usLength )
+static CK_KEY_TYPE pkcs11_object_key_type( uint16_t usOptigaOid )
 {
-    CK_OBJECT_HANDLE object_handle = eInvalidHandle;
+    CK_KEY_TYPE xKeyType = CKK_EC;
 
-    /* Translate from the PKCS#11 label to local storage file name. */
-    if( 0 == memcmp( pLabel,
-                     &LABEL_DEVICE_CERTIFICATE_FOR_TLS,
-                     sizeof( LABEL_DEVICE_CERTIFICATE_FOR_TLS ) ) )
+    if( ( 0xE0FC == usOptigaOid ) || ( 0xE0FD == usOptigaOid ) || ( 0xF1E0 == usOptigaOid ) )
     {
-        object_handle = DeviceCertificate;
+        xKeyType = CKK_RSA;
     }
-    else if( 0 == memcmp( pLabel,
-                          &LABEL_DEVICE_PRIVATE_KEY_FOR_TLS,
-                          sizeof( LABEL_DEVICE_PRIVATE_KEY_FOR_TLS ) ) )
+    return xKeyType;
+}
+
+/**
+ * @brief Drops the cached value of an object, e.g. after the object is written.
+ */
+static void pkcs11_object_value_drop( pkcs11_object_t * pxObject )
+{
+    if( NULL != pxObject->value )
     {
-        /* This operation isn't supported for the OPTIGA(TM) Trust M due to a security considerations
-         * You can only generate a keypair and export a private component if you like */
-        /* We do assign a handle though, as the AWS can#t handle the lables without having a handle*/
-        object_handle = DevicePrivateKey;
+        free( pxObject->value );
     }
+    pxObject->value = NULL;
+    pxObject->value_length = 0;
+    pxObject->value_cached = CK_FALSE;
+}
 
-    else if( 0 == memcmp( pLabel,
-                          &LABEL_DEVICE_PUBLIC_KEY_FOR_TLS,
-                          sizeof( LABEL_DEVICE_PUBLIC_KEY_FOR_TLS ) ) )
+/**
+ * @brief Sets the cached value of an object, which takes the ownership of the buffer.
+ */
+static void pkcs11_object_value_set( CK_OBJECT_HANDLE xAppHandle, uint8_t * pucValue, CK_ULONG ulValueLength )
+{
+    int lIndex = ( int ) xAppHandle - 1;
+
+    if( ( 0 <= lIndex ) && ( MAX_NUM_OBJECTS > lIndex ) )
     {
-        object_handle = DevicePublicKey;
+        pal_os_lock_acquire(&optiga_mutex);
+        pkcs11_object_value_drop( &pkcs11_context.object_list.objects[ lIndex ] );
+        pkcs11_context.object_list.objects[ lIndex ].value = pucValue;
+        pkcs11_context.object_list.objects[ lIndex ].value_length = ulValueLength;
+        pkcs11_context.object_list.objects[ lIndex ].value_cached = CK_TRUE;
+        pal_os_lock_release(&optiga_mutex);
     }
-    else if( 0 == memcmp( pLabel,
-                          &LABEL_CODE_VERIFICATION_KEY,
-                          sizeof( LABEL_CODE_VERIFICATION_KEY ) ) )
+    else
     {
-        object_handle = CodeSigningKey;
+        free( pucValue );
     }
+}
 
-    return object_handle;
+/**
+ * @brief Reads the value of an object from OPTIGA(TM) Trust M into the cache, if not cached already.
+ *
+ * Certificates stored with the TLS identity tags (0xC0, and 3 bytes each for the length, the length of the chain
+ * and the length of the certificate) are cached without the tags.
+ *
+ * @return CKR_OK if the value is cached. CKR_HOST_MEMORY if the buffer could not be allocated,
+ * CKR_KEY_HANDLE_INVALID if the object could not be read.
+ */
+static CK_RV pkcs11_object_value_load( pkcs11_object_t * pxObject )
+{
+    CK_RV                xResult = CKR_OK;
+    optiga_lib_status_t  xReturn;
+    uint8_t *            pucValue = NULL;
+    uint16_t             usLength = pkcs11OBJECT_CERTIFICATE_MAX_SIZE;
+    uint16_t             usOffset = 0;
+
+    pal_os_lock_acquire(&optiga_mutex);
+    do
+    {
+        if( CK_TRUE == pxObject->value_cached )
+        {
+            break;
+        }
+
+        pucValue = malloc( pkcs11OBJECT_CERTIFICATE_MAX_SIZE );
+        if( NULL == pucValue )
+        {
+            xResult = CKR_HOST_MEMORY;
+            break;
+        }
+
+        pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
+        xReturn = optiga_util_read_data(pkcs11_context.object_list.optiga_util_instance,
+                                        pxObject->optiga_oid,
+                                        0,
+                                        pucValue,
+                                        &usLength);
+        if (OPTIGA_LIB_SUCCESS != xReturn)
+        {
+            xResult = CKR_KEY_HANDLE_INVALID;
+            break;
+        }
+
+        pkcs11_wait_for_completion(&pkcs11_context.object_list.optiga_lib_status, &pkcs11_context.object_list.optiga_wait);
+
+        // In case the read was ok, but no data inside
+        if (0x8008 == pkcs11_context.object_list.optiga_lib_status)
+        {
+            usLength = 0;
+        }
+        else if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
+        {
+            xResult = CKR_KEY_HANDLE_INVALID;
+            break;
+        }
+
+        if( ( CKO_CERTIFICATE == pxObject->object_class ) && ( 9 < usLength ) && ( 0xC0 == pucValue[ 0 ] ) )
+        {
+            usOffset = 9;
+            memmove( pucValue, pucValue + usOffset, usLength - usOffset );
+        }
+
+        pxObject->value = pucValue;
+        pxObject->value_length = usLength - usOffset;
+        pxObject->value_cached = CK_TRUE;
+        pucValue = NULL;
+
+        // The curve of an EC public key follows from the length of the BIT STRING encoded point
+        if( ( CKO_PUBLIC_KEY == pxObject->object_class ) && ( CKK_EC == pxObject->key_type ) )
+        {
+            switch( pxObject->value_length )
+            {
+                case 68:
+                    pxObject->ec_curve = OPTIGA_ECC_CURVE_NIST_P_256;
+                    break;
+                case 100:
+                    pxObject->ec_curve = OPTIGA_ECC_CURVE_NIST_P_384;
+                    break;
+                case 137:
+                    pxObject->ec_curve = OPTIGA_ECC_CURVE_NIST_P_521;
+                    break;
+                default:
+                    break;
+            }
+        }
+    } while(0);
+    pal_os_lock_release(&optiga_mutex);
+
+    if( NULL != pucValue )
+    {
+        free( pucValue );
+    }
+
+    return xResult;
 }
 
 /*-----------------------------------------------------------*/
@@ -256,103 +533,58 @@ CK_OBJECT_HANDLE find_object( uint8_t * pLabel,
 /**
  * @brief Gets the value of an object in storage, by handle.
  *
- * Port-specific file access for cryptographic information.
- *
- * This call dynamically allocates the buffer which object value
- * data is copied into.  get_object_value_cleanup()
- * should be called after each use to free the dynamically allocated
- * buffer.
- *
- * @sa get_object_value_cleanup
+ * The value is read from OPTIGA(TM) Trust M on the first access only and served from the
+ * cache of the object list afterwards. The buffer is owned by the object list
+ * and must not be freed by the caller.
  *
- * @param[in] pcFileName    The name of the file to be read.s
+ * @param[in] xAppHandle    The handle of the object, used by the application.
  * @param[out] ppucData     Pointer to buffer for file data.
  * @param[out] pulDataSize  Size (in bytes) of data located in file.
  * @param[out] pIsPrivate   Boolean indicating if value is private (CK_TRUE)
  *                          or exportable (CK_FALSE)
  *
  * @return CKR_OK if operation was successful.  CKR_KEY_HANDLE_INVALID if
- * no such object handle was found, CKR_DEVICE_MEMORY if memory for
- * buffer could not be allocated, CKR_FUNCTION_FAILED for device driver
- * error.
+ * no such object handle was found, CKR_HOST_MEMORY if memory for
+ * buffer could not be allocated.
  */
-long get_object_value( CK_OBJECT_HANDLE object_handle,
+long get_object_value( CK_OBJECT_HANDLE xAppHandle,
                                  uint8_t ** ppucData,
                                  uint32_t * pulDataSize,
                                  CK_BBOOL * pIsPrivate )
 {
-    long                 ulReturn = CKR_OK;
-    optiga_lib_status_t  xReturn;
-    long                 lOptigaOid = 0;
-    char*                xEnd = NULL;
-    uint8_t              xOffset = 0;
+    long                 ulReturn = CKR_KEY_HANDLE_INVALID;
+    int                  lIndex = ( int ) xAppHandle - 1;
+    pkcs11_object_t *    pxObject;
 
+    *ppucData = NULL;
+    *pulDataSize = 0;
     *pIsPrivate = CK_FALSE;
 
-    // We need to allocate a buffer for a certificate/certificate chain
-    // This data is later should be freed with get_object_value_cleanup
-    *ppucData = malloc( pkcs11OBJECT_CERTIFICATE_MAX_SIZE );
-    if (NULL != *ppucData)
+    if( ( 0 <= lIndex ) && ( MAX_NUM_OBJECTS > lIndex ) &&
+        ( CK_INVALID_HANDLE != pkcs11_context.object_list.objects[ lIndex ].object_handle ) )
     {
-        *pulDataSize = pkcs11OBJECT_CERTIFICATE_MAX_SIZE;
-        *pIsPrivate = CK_FALSE;
-    
-        switch (object_handle) 
-        {
-            case DeviceCertificate:
-                lOptigaOid = strtol(LABEL_DEVICE_CERTIFICATE_FOR_TLS, &xEnd, 16);
-                xOffset = 9;
-                break;
-            case DevicePublicKey:
-                lOptigaOid = strtol(LABEL_DEVICE_PUBLIC_KEY_FOR_TLS, &xEnd, 16);
-                break;
+        pxObject = &pkcs11_context.object_list.objects[ lIndex ];
 
-            case CodeSigningKey:
-                lOptigaOid = strtol(LABEL_CODE_VERIFICATION_KEY, &xEnd, 16);
-                break;
-            case DevicePrivateKey:
-                /*
-                 * This operation isn't supported for the OPTIGA(TM) Trust M due to a security considerations
-                 * You can only generate a keypair and export a private component if you like
-                 */
-            default:
-                ulReturn = CKR_KEY_HANDLE_INVALID;
-                break;
+        if( CKO_PRIVATE_KEY == pxObject->object_class )
+        {
+            /*
+             * This operation isn't supported for the OPTIGA(TM) Trust M due to a security considerations
+             * You can only generate a keypair and export a private component if you like
+             */
+            *pIsPrivate = CK_TRUE;
+            ulReturn = CKR_OK;
         }
-
-        if ( (0 != lOptigaOid) && (USHRT_MAX > lOptigaOid) && (NULL != pulDataSize))
+        else
         {
-            pal_os_lock_acquire(&optiga_mutex);
-
-            pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
-            xReturn = optiga_util_read_data(pkcs11_context.object_list.optiga_util_instance, lOptigaOid, xOffset, *ppucData, (uint16_t*)pulDataSize);
-
-            if (OPTIGA_LIB_SUCCESS == xReturn)
+            ulReturn = pkcs11_object_value_load( pxObject );
+            if( CKR_OK == ulReturn )
             {
-                while (OPTIGA_LIB_BUSY == pkcs11_context.object_list.optiga_lib_status)
-                {
-                
-                }
-
-                // In case the read was ok, but no data inside
-                if (0x8008 == pkcs11_context.object_list.optiga_lib_status)
-                {
-                    *ppucData = NULL;
-                    *pulDataSize = 0;
-                }
-                else if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
-                {
-                    *ppucData = NULL;
-                    *pulDataSize = 0;
-                    ulReturn = CKR_KEY_HANDLE_INVALID;
-                }
+                *ppucData = pxObject->value;
+                *pulDataSize = pxObject->value_length;
             }
-
-            pal_os_lock_release(&optiga_mutex);
         }
     }
 
-
     return ulReturn;
 }
 
@@ -360,12 +592,12 @@ long get_object_value( CK_OBJECT_HANDLE object_handle,
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Cleanup after get_object_value().
+ * @brief Frees an object buffer allocated by the caller.
+ *
+ * The buffers provided by get_object_value() are owned by the object list and must not be freed.
  *
  * @param[in] pucData       The buffer to free.
- *                          (*ppucData from get_object_value())
  * @param[in] ulDataSize    The length of the buffer to free.
- *                          (*pulDataSize from get_object_value())
  */
 void get_object_value_cleanup( uint8_t * pucData,
                                        uint32_t ulDataSize )
@@ -386,6 +618,51 @@ p_pkcs11_session_t get_session_pointer( CK_SESSION_HANDLE xSession )
     return ( p_pkcs11_session_t ) xSession; /*lint !e923 Allow casting integer type to pointer for handle. */
 }
 
+/**
+ * @brief Provides the crypt instance for an operation of the session.
+ *
+ * The own instance of the session is used without the lock, the scheduler of the host library
+ * serializes the commands of all the instances. Sessions without an own instance (more sessions
+ * than the registrations of the host library) share the instance of the module under optiga_mutex.
+ */
+static optiga_crypt_t * pkcs11_crypt_acquire( p_pkcs11_session_t pxSession, volatile optiga_lib_status_t ** ppxStatus )
+{
+    optiga_crypt_t * pxCrypt = pxSession->optiga_crypt_instance;
+
+    if ( NULL != pxCrypt )
+    {
+        *ppxStatus = &pxSession->optiga_lib_status;
+    }
+    else
+    {
+        pal_os_lock_acquire(&optiga_mutex);
+        pxCrypt = pkcs11_context.object_list.optiga_crypt_instance;
+        *ppxStatus = &pkcs11_context.object_list.optiga_lib_status;
+    }
+    return pxCrypt;
+}
+
+/**
+ * @brief Releases the crypt instance provided by pkcs11_crypt_acquire. Does nothing if pxCrypt is NULL.
+ */
+static void pkcs11_crypt_release( p_pkcs11_session_t pxSession, optiga_crypt_t * pxCrypt )
+{
+    if ( ( NULL != pxCrypt ) && ( pxCrypt != pxSession->optiga_crypt_instance ) )
+    {
+        pal_os_lock_release(&optiga_mutex);
+    }
+}
+
+/**
+ * @brief Blocks until the operation on the crypt instance provided by pkcs11_crypt_acquire is completed.
+ */
+static void pkcs11_crypt_wait( p_pkcs11_session_t pxSession, volatile optiga_lib_status_t * pxStatus )
+{
+    pkcs11_wait_for_completion( pxStatus,
+                                ( pxStatus == &pxSession->optiga_lib_status ) ? &pxSession->optiga_wait :
+                                                                               &pkcs11_context.object_list.optiga_wait );
+}
+
 
 /*
  * PKCS#11 module implementation.
@@ -462,9 +739,9 @@ static CK_FUNCTION_LIST prvP11FunctionList =
     NULL, /*C_DeriveKey*/
     NULL, /*C_SeedRandom*/
     C_GenerateRandom,
-    NULL, /*C_GetFunctionStatus*/
-    NULL, /*C_CancelFunction*/
-    NULL  /*C_WaitForSlotEvent*/
+    C_GetFunctionStatus,
+    C_CancelFunction,
+    C_WaitForSlotEvent
 };
 
 CK_RV pair_host_and_optiga_using_pre_shared_secret(void)
@@ -474,34 +751,24 @@ CK_RV pair_host_and_optiga_using_pre_shared_secret(void)
     uint8_t platform_binding_secret_metadata[44];
     optiga_lib_status_t return_status = !OPTIGA_LIB_SUCCESS;
     pal_status_t pal_return_status;
+    uint8_t binding_valid = FALSE;
 
     
     /* Platform Binding Shared Secret (0xE140) Metadata to be updated */
     
-    const uint8_t platform_binding_shared_secret_metadata_final [] = {
-        //Metadata to be updated
-        0x20, 0x17,
-            // LcsO
-            0xC0, 0x01,
-                        FINAL_LCSO_STATE,        // Refer Macro to see the value or some more notes
-            // Change/Write Access tag
-            0xD0, 0x07,
-                        // This allows updating the binding secret during the runtime using shielded connection
-                        // If not required to update the secret over the runtime, set this to NEV and
-                        // update Metadata length accordingly
-                        0xE1, 0xFC, LCSO_STATE_OPERATIONAL,   // LcsO < Operational state
-                        0xFE,
-                        0x20, 0xE1, 0x40,
-            // Read Access tag
-            0xD1, 0x03,
-                        0xE1, 0xFC, LCSO_STATE_OPERATIONAL,   // LcsO < Operational state
-            // Execute Access tag
-            0xD3, 0x01,
-                        0x00,    // Always
-            // Data object Type
-            0xE8, 0x01,
-                        0x22,    // Platform binding secret type
-    };
+    OPTIGA_METADATA_DEFINE(platform_binding_shared_secret_metadata_final,
+        // LcsO, refer Macro to see the value or some more notes
+        OPTIGA_METADATA_LCSO(FINAL_LCSO_STATE),
+        // Change/Write Access: LcsO < Operational state or shielded connection with the binding secret.
+        // This allows updating the binding secret during the runtime using shielded connection
+        // If not required to update the secret over the runtime, set this to OPTIGA_AC_NEV
+        OPTIGA_METADATA_CHANGE_AC(OPTIGA_AC_LCSO_LT(LCSO_STATE_OPERATIONAL), OPTIGA_AC_OR, OPTIGA_AC_CONF(0xE140)),
+        // Read Access: LcsO < Operational state
+        OPTIGA_METADATA_READ_AC(OPTIGA_AC_LCSO_LT(LCSO_STATE_OPERATIONAL)),
+        // Execute Access: Always
+        OPTIGA_METADATA_EXECUTE_AC(OPTIGA_AC_ALW),
+        // Platform binding secret type
+        OPTIGA_METADATA_DATA_OBJECT_TYPE(0x22));
 
     do
     {
@@ -517,40 +784,69 @@ CK_RV pair_host_and_optiga_using_pre_shared_secret(void)
         OPTIGA_CRYPT_SET_COMMS_PROTOCOL_VERSION(pkcs11_context.object_list.optiga_crypt_instance,OPTIGA_COMMS_PROTOCOL_VERSION_PRE_SHARED_SECRET);
 
         /**
-         * 2. Read Platform Binding Shared secret (0xE140) data object metadata from OPTIGA
-         *    using optiga_util_read_metadata.
+         * 2. Verify the existing binding by reading the Platform Binding Shared secret (0xE140) data object
+         *    metadata over the shielded connection. This succeeds only if the secret in pal_os_datastore
+         *    matches the secret of OPTIGA, and nothing needs to be written then.
          */
         bytes_to_read = sizeof(platform_binding_secret_metadata);
         pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
-        return_status = optiga_util_read_metadata(pkcs11_context.object_list.optiga_util_instance,
-                                                  0xE140,
-                                                  platform_binding_secret_metadata,
-                                                  &bytes_to_read);
-
-        if (OPTIGA_LIB_SUCCESS != return_status)
-        {
-            return_status = CKR_FUNCTION_FAILED;
-            break;
-        }
-        while (pkcs11_context.object_list.optiga_lib_status == OPTIGA_LIB_BUSY)
+        OPTIGA_UTIL_SET_COMMS_PROTECTION_LEVEL(pkcs11_context.object_list.optiga_util_instance,OPTIGA_COMMS_FULL_PROTECTION);
+        if (OPTIGA_LIB_SUCCESS == optiga_util_read_metadata(pkcs11_context.object_list.optiga_util_instance,
+                                                            0xE140,
+                                                            platform_binding_secret_metadata,
+                                                            &bytes_to_read))
         {
-            
+            pkcs11_wait_for_completion(&pkcs11_context.object_list.optiga_lib_status, &pkcs11_context.object_list.optiga_wait);
+            if (OPTIGA_LIB_SUCCESS == pkcs11_context.object_list.optiga_lib_status)
+            {
+                binding_valid = TRUE;
+            }
         }
-        if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
+
+#ifndef PLATFORM_BINDING_SECRET_ROTATE_ON_STARTUP
+        if (TRUE == binding_valid)
         {
-            return_status = CKR_FUNCTION_FAILED;
+            // The Host and OPTIGA are already paired
+            return_status = OPTIGA_LIB_SUCCESS;
             break;
         }
+#endif
 
-
-        /**
-         * 3. Validate LcsO in the metadata.
-         *    Skip the rest of the procedure if LcsO is greater than or equal to operational state(0x07)
-         */
-        if (platform_binding_secret_metadata[4] >= LCSO_STATE_OPERATIONAL)
+        if (FALSE == binding_valid)
         {
-            // The LcsO is already greater than or equal to operational state
-            break;
+            /**
+             * Read Platform Binding Shared secret (0xE140) data object metadata from OPTIGA
+             * using optiga_util_read_metadata, without protection.
+             */
+            bytes_to_read = sizeof(platform_binding_secret_metadata);
+            pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
+            return_status = optiga_util_read_metadata(pkcs11_context.object_list.optiga_util_instance,
+                                                      0xE140,
+                                                      platform_binding_secret_metadata,
+                                                      &bytes_to_read);
+
+            if (OPTIGA_LIB_SUCCESS != return_status)
+            {
+                return_status = CKR_FUNCTION_FAILED;
+                break;
+            }
+            pkcs11_wait_for_completion(&pkcs11_context.object_list.optiga_lib_status, &pkcs11_context.object_list.optiga_wait);
+            if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
+            {
+                return_status = CKR_FUNCTION_FAILED;
+                break;
+            }
+
+
+            /**
+             * 3. Validate LcsO in the metadata.
+             *    Skip the rest of the procedure if LcsO is greater than or equal to operational state(0x07)
+             */
+            if (platform_binding_secret_metadata[4] >= LCSO_STATE_OPERATIONAL)
+            {
+                // The LcsO is already greater than or equal to operational state
+                break;
+            }
         }
 
         /**
@@ -573,10 +869,7 @@ CK_RV pair_host_and_optiga_using_pre_shared_secret(void)
             return_status = CKR_FUNCTION_FAILED;
             break;
         }
-        while (pkcs11_context.object_list.optiga_lib_status == OPTIGA_LIB_BUSY)
-        {
-            
-        }
+        pkcs11_wait_for_completion(&pkcs11_context.object_list.optiga_lib_status, &pkcs11_context.object_list.optiga_wait);
         if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
         {
             return_status = CKR_FUNCTION_FAILED;
@@ -594,7 +887,9 @@ CK_RV pair_host_and_optiga_using_pre_shared_secret(void)
          * 6. Write random(secret) to OPTIGA platform Binding shared secret data object (0xE140)
          */
         pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
-        OPTIGA_UTIL_SET_COMMS_PROTECTION_LEVEL(pkcs11_context.object_list.optiga_util_instance,OPTIGA_COMMS_NO_PROTECTION);
+        OPTIGA_UTIL_SET_COMMS_PROTECTION_LEVEL(pkcs11_context.object_list.optiga_util_instance,
+                                               (TRUE == binding_valid) ? OPTIGA_COMMS_FULL_PROTECTION :
+                                                                         OPTIGA_COMMS_NO_PROTECTION);
         return_status = optiga_util_write_data(pkcs11_context.object_list.optiga_util_instance,
                                                0xE140,
                                                OPTIGA_UTIL_ERASE_AND_WRITE,
@@ -606,10 +901,7 @@ CK_RV pair_host_and_optiga_using_pre_shared_secret(void)
             return_status = CKR_FUNCTION_FAILED;
             break;
         }
-        while (pkcs11_context.object_list.optiga_lib_status == OPTIGA_LIB_BUSY)
-        {
-            
-        }
+        pkcs11_wait_for_completion(&pkcs11_context.object_list.optiga_lib_status, &pkcs11_context.object_list.optiga_wait);
         if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
         {
             return_status = CKR_FUNCTION_FAILED;
@@ -633,7 +925,13 @@ CK_RV pair_host_and_optiga_using_pre_shared_secret(void)
 
         /**
          * 8. Update metadata of OPTIGA Platform Binding shared secret data object (0xE140)
+         *    The metadata of a valid binding is already final.
          */
+        if (TRUE == binding_valid)
+        {
+            return_status = OPTIGA_LIB_SUCCESS;
+            break;
+        }
         pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
         OPTIGA_UTIL_SET_COMMS_PROTECTION_LEVEL(pkcs11_context.object_list.optiga_util_instance,OPTIGA_COMMS_NO_PROTECTION);
         return_status = optiga_util_write_metadata(pkcs11_context.object_list.optiga_util_instance,
@@ -646,10 +944,7 @@ CK_RV pair_host_and_optiga_using_pre_shared_secret(void)
             return_status = CKR_FUNCTION_FAILED;
             break;
         }
-        while (pkcs11_context.object_list.optiga_lib_status == OPTIGA_LIB_BUSY)
-        {
-            
-        };
+        pkcs11_wait_for_completion(&pkcs11_context.object_list.optiga_lib_status, &pkcs11_context.object_list.optiga_wait);;
         if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
         {
             return_status = CKR_FUNCTION_FAILED;
@@ -663,10 +958,51 @@ CK_RV pair_host_and_optiga_using_pre_shared_secret(void)
     return (CK_RV)return_status;
 }
 
+/**
+ * @brief Opens the application on OPTIGA(TM) Trust M with the shared util instance.
+ */
+static CK_RV pkcs11_application_open( bool_t perform_restore )
+{
+    CK_RV xResult = CKR_FUNCTION_FAILED;
+
+    pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
+    if (OPTIGA_LIB_SUCCESS == optiga_util_open_application(pkcs11_context.object_list.optiga_util_instance, perform_restore))
+    {
+        pkcs11_wait_for_completion(&pkcs11_context.object_list.optiga_lib_status, &pkcs11_context.object_list.optiga_wait);
+        if (OPTIGA_LIB_SUCCESS == pkcs11_context.object_list.optiga_lib_status)
+        {
+            xResult = CKR_OK;
+        }
+    }
+
+    return xResult;
+}
+
+/**
+ * @brief Closes the application on OPTIGA(TM) Trust M with the shared util instance.
+ */
+static CK_RV pkcs11_application_close( bool_t perform_hibernate )
+{
+    CK_RV xResult = CKR_FUNCTION_FAILED;
+
+    pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
+    if (OPTIGA_LIB_SUCCESS == optiga_util_close_application(pkcs11_context.object_list.optiga_util_instance, perform_hibernate))
+    {
+        pkcs11_wait_for_completion(&pkcs11_context.object_list.optiga_lib_status, &pkcs11_context.object_list.optiga_wait);
+        if (OPTIGA_LIB_SUCCESS == pkcs11_context.object_list.optiga_lib_status)
+        {
+            xResult = CKR_OK;
+        }
+    }
+
+    return xResult;
+}
+
 CK_RV optiga_trustm_initialize( void )
 {
     CK_RV xResult = CKR_OK;
     uint16_t dOptigaOID;
+    uint16_t usLength;
     static uint8_t host_pair_done = 1;
     do
     {
@@ -689,7 +1025,12 @@ CK_RV optiga_trustm_initialize( void )
             pal_gpio_init(&optiga_reset_0);
             pal_gpio_init(&optiga_vdd_0);
             pkcs11_context.object_list.timeout.tv_sec = 0;
-            pkcs11_context.object_list.timeout.tv_nsec = 0xffff;
+            pkcs11_context.object_list.timeout.tv_nsec = MAX_DELAY * 1000000L;
+            if (PAL_STATUS_SUCCESS != pal_os_wait_create(&pkcs11_context.object_list.optiga_wait))
+            {
+                xResult = CKR_FUNCTION_FAILED;
+                break;
+            }
 
             pkcs11_context.object_list.optiga_crypt_instance =
                     optiga_crypt_create(0, optiga_callback, &pkcs11_context.object_list.optiga_lib_status);
@@ -697,23 +1038,35 @@ CK_RV optiga_trustm_initialize( void )
             pkcs11_context.object_list.optiga_util_instance =
                     optiga_util_create(0, optiga_callback, &pkcs11_context.object_list.optiga_lib_status);
 
-            pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
-            xResult = optiga_util_open_application(pkcs11_context.object_list.optiga_util_instance, 0);
+            #if (PKCS11_PUBLIC_KEY_WRITE_BACK == 2)
+            // Public keys are written synchronously, if the write back instance is not available
+            if (PAL_STATUS_SUCCESS == pal_os_wait_create(&pkcs11_context.write_back_wait))
+            {
+                pkcs11_context.write_back_instance = optiga_util_create(0, pkcs11_write_back_callback, NULL);
+                if (NULL == pkcs11_context.write_back_instance)
+                {
+                    pal_os_wait_destroy(&pkcs11_context.write_back_wait);
+                }
+            }
+            #endif
 
-            if (OPTIGA_LIB_SUCCESS != xResult)
+            if ((NULL == pkcs11_context.object_list.optiga_crypt_instance) ||
+                (NULL == pkcs11_context.object_list.optiga_util_instance))
             {
                 xResult = CKR_FUNCTION_FAILED;
                 break;
             }
-            while (pkcs11_context.object_list.optiga_lib_status == OPTIGA_LIB_BUSY)
+
+            #if (PKCS11_HIBERNATE_ON_FINALIZE == 1)
+            // Continue the application hibernated by C_Finalize of the previous process
+            xResult = pkcs11_application_open(TRUE);
+            if (CKR_OK != xResult)
+            #endif
             {
-                
+                xResult = pkcs11_application_open(FALSE);
             }
 
-            if ((NULL == pkcs11_context.object_list.optiga_crypt_instance) ||
-                (NULL == pkcs11_context.object_list.optiga_util_instance) ||
-                (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status) ||
-                (CKR_FUNCTION_FAILED == xResult))
+            if (CKR_OK != xResult)
             {
                 xResult = CKR_FUNCTION_FAILED;
                 break;
@@ -724,29 +1077,40 @@ CK_RV optiga_trustm_initialize( void )
                 dOptigaOID = 0xE0C4;
                 // Maximum Power, Minimum Current limitation
                 uint8_t cCurrentLimit = 15;
-                pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
-                xResult = optiga_util_write_data(pkcs11_context.object_list.optiga_util_instance,
-                                                dOptigaOID, OPTIGA_UTIL_WRITE_ONLY,
-                                                0, //offset
-                                                &cCurrentLimit,
-                                                1);
+                uint8_t cCurrentLimitRead = 0;
 
-                if (OPTIGA_LIB_SUCCESS != xResult)
+                // The limit is kept in NVM, hence it is written only if not configured yet
+                usLength = sizeof(cCurrentLimitRead);
+                pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
+                if (OPTIGA_LIB_SUCCESS == optiga_util_read_data(pkcs11_context.object_list.optiga_util_instance,
+                                                                dOptigaOID, 0, &cCurrentLimitRead, &usLength))
                 {
-                    xResult = CKR_FUNCTION_FAILED;
-                    break;
+                    pkcs11_wait_for_completion(&pkcs11_context.object_list.optiga_lib_status, &pkcs11_context.object_list.optiga_wait);
                 }
-
-                while (OPTIGA_LIB_BUSY == pkcs11_context.object_list.optiga_lib_status)
+                if ((OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status) ||
+                    (sizeof(cCurrentLimitRead) != usLength) || (cCurrentLimit != cCurrentLimitRead))
                 {
+                    pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
+                    xResult = optiga_util_write_data(pkcs11_context.object_list.optiga_util_instance,
+                                                    dOptigaOID, OPTIGA_UTIL_WRITE_ONLY,
+                                                    0, //offset
+                                                    &cCurrentLimit,
+                                                    1);
 
-                }
+                    if (OPTIGA_LIB_SUCCESS != xResult)
+                    {
+                        xResult = CKR_FUNCTION_FAILED;
+                        break;
+                    }
 
-                // Either by timout or because of success it should end up here
-                if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
-                {
-                    xResult = CKR_FUNCTION_FAILED;
-                    break;
+                    pkcs11_wait_for_completion(&pkcs11_context.object_list.optiga_lib_status, &pkcs11_context.object_list.optiga_wait);
+
+                    // Either by timout or because of success it should end up here
+                    if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
+                    {
+                        xResult = CKR_FUNCTION_FAILED;
+                        break;
+                    }
                 }
                 #ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
                 if(host_pair_done)
@@ -760,6 +1124,15 @@ CK_RV optiga_trustm_initialize( void )
                     host_pair_done = 0;
                 }
                 #endif
+                #if defined(OPTIGA_CRYPT_RANDOM_POOL_ENABLED) && (PKCS11_RANDOM_FROM_POOL == 1)
+                // Random data is generated by C_GenerateRandom directly, if the pool is not available
+                if (OPTIGA_LIB_SUCCESS == optiga_crypt_random_pool_init(&pkcs11_context.random_pool, 0,
+                                                                        OPTIGA_RNG_TYPE_TRNG,
+                                                                        OPTIGA_CRYPT_RANDOM_POOL_SIZE))
+                {
+                    pkcs11_context.random_pool_initialized = CK_TRUE;
+                }
+                #endif
             }
 
         }
@@ -773,6 +1146,10 @@ CK_RV optiga_trustm_initialize( void )
 CK_RV optiga_trustm_deinitialize( void )
 {
     CK_RV xResult = CKR_OK;
+    uint8_t ucIndex;
+#if (PKCS11_PUBLIC_KEY_WRITE_BACK == 2)
+    CK_RV xWriteBackResult = CKR_OK;
+#endif
 
     if( pkcs11_context.is_initialized == CK_TRUE )
     {
@@ -780,31 +1157,63 @@ CK_RV optiga_trustm_deinitialize( void )
         {
             if( xResult == CKR_OK )
             {
-                pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
-                xResult = optiga_util_close_application(pkcs11_context.object_list.optiga_util_instance, 0);
-
-                if (OPTIGA_LIB_SUCCESS != xResult)
+                #if defined(OPTIGA_CRYPT_RANDOM_POOL_ENABLED) && (PKCS11_RANDOM_FROM_POOL == 1)
+                // The pool is de-initialized, once the ongoing refill is completed
+                while ((CK_TRUE == pkcs11_context.random_pool_initialized) &&
+                       (OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE == optiga_crypt_random_pool_deinit(&pkcs11_context.random_pool)))
                 {
-                    xResult = CKR_FUNCTION_FAILED;
-                    break;
+                    pal_os_timer_delay_in_milliseconds(1);
                 }
-                while (pkcs11_context.object_list.optiga_lib_status == OPTIGA_LIB_BUSY)
+                pkcs11_context.random_pool_initialized = CK_FALSE;
+                #endif
+                #if (PKCS11_PUBLIC_KEY_WRITE_BACK == 2)
+                // A failed write back is reported, once the application is closed
+                pal_os_lock_acquire(&optiga_mutex);
+                xWriteBackResult = pkcs11_write_back_complete();
+                pal_os_lock_release(&optiga_mutex);
+                #endif
+                #if (PKCS11_HIBERNATE_ON_FINALIZE == 1)
+                // Hibernate fails, if the SEC is greater than zero, then the application is closed without context
+                xResult = pkcs11_application_close(TRUE);
+                if (CKR_OK != xResult)
+                #endif
                 {
-                    
+                    xResult = pkcs11_application_close(FALSE);
                 }
-                if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
+
+                if (CKR_OK != xResult)
                 {
                     xResult = CKR_FUNCTION_FAILED;
                     break;
                 }
+                for( ucIndex = 0; ucIndex < MAX_NUM_OBJECTS; ucIndex++ )
+                {
+                    pkcs11_object_value_drop( &pkcs11_context.object_list.objects[ ucIndex ] );
+                }
+
                 //Destroy the instances after the completion of usecase            
                 xResult = optiga_crypt_destroy(pkcs11_context.object_list.optiga_crypt_instance);
                 xResult |= optiga_util_destroy(pkcs11_context.object_list.optiga_util_instance);
+                pal_os_wait_destroy(&pkcs11_context.object_list.optiga_wait);
+                #if (PKCS11_PUBLIC_KEY_WRITE_BACK == 2)
+                if (NULL != pkcs11_context.write_back_instance)
+                {
+                    xResult |= optiga_util_destroy(pkcs11_context.write_back_instance);
+                    pkcs11_context.write_back_instance = NULL;
+                    pal_os_wait_destroy(&pkcs11_context.write_back_wait);
+                }
+                #endif
 
                 if(OPTIGA_LIB_SUCCESS != xResult)
                 {
                     xResult = CKR_FUNCTION_FAILED;
                 }
+                #if (PKCS11_PUBLIC_KEY_WRITE_BACK == 2)
+                else if (CKR_OK != xWriteBackResult)
+                {
+                    xResult = CKR_DEVICE_ERROR;
+                }
+                #endif
             }
         }while(0);
     }
@@ -834,7 +1243,10 @@ void find_object_in_list_by_label( uint8_t * pcLabel,
 
     for( ucIndex = 0; ucIndex < MAX_NUM_OBJECTS; ucIndex++ )
     {
-        if( 0 == memcmp( pcLabel, pkcs11_context.object_list.objects[ ucIndex ].status_lable, xLabelLength ) )
+        if( ( pkcs11_context.object_list.objects[ ucIndex ].object_handle != CK_INVALID_HANDLE ) &&
+            ( xLabelLength <= MAX_LABEL_LENGTH ) &&
+            ( 0 == memcmp( pcLabel, pkcs11_context.object_list.objects[ ucIndex ].status_lable, xLabelLength ) ) &&
+            ( '\0' == pkcs11_context.object_list.objects[ ucIndex ].status_lable[ xLabelLength ] ) )
         {
             *pxPalHandle = pkcs11_context.object_list.objects[ ucIndex ].object_handle;
             *pxAppHandle = ucIndex + 1; /* Zero is not a valid handle, so let's offset by 1. */
@@ -863,7 +1275,7 @@ void find_object_in_list_by_handle( CK_OBJECT_HANDLE xAppHandle,
     *ppcLabel = NULL;
     *pxLabelLength = 0;
 
-    if (MAX_NUM_OBJECTS >= lIndex)
+    if ((0 <= lIndex) && (MAX_NUM_OBJECTS > lIndex))
     {
         if( pkcs11_context.object_list.objects[ lIndex ].object_handle != CK_INVALID_HANDLE )
         {
@@ -884,13 +1296,12 @@ CK_RV delete_object_from_list( CK_OBJECT_HANDLE xAppHandle )
     CK_RV xResult = CKR_OK;
     int32_t get_semaphore;
     int lIndex = xAppHandle - 1;
-#ifdef __linux__    
-    get_semaphore = sem_timedwait( &pkcs11_context.object_list.semaphore, &pkcs11_context.object_list.timeout );
-#endif
+    get_semaphore = pkcs11_object_list_lock();
     if( get_semaphore == 0 )
     {
         if( pkcs11_context.object_list.objects[ lIndex ].object_handle != CK_INVALID_HANDLE )
         {
+            pkcs11_object_value_drop( &pkcs11_context.object_list.objects[ lIndex ] );
             memset( &pkcs11_context.object_list.objects[ lIndex ], 0, sizeof( pkcs11_object_t ) );
         }
         else
@@ -920,17 +1331,27 @@ CK_RV add_object_to_list( CK_OBJECT_HANDLE xPalHandle,
     CK_BBOOL xObjectFound = CK_FALSE;
     int lInsertIndex = -1;
     int lSearchIndex = MAX_NUM_OBJECTS - 1;
-#ifdef __linux__
-    get_semaphore = sem_timedwait( &pkcs11_context.object_list.semaphore, &pkcs11_context.object_list.timeout);
-#endif
+    char * xEnd = NULL;
+
+    /* Labels from templates might include the null terminator. */
+    while( ( 0 < xLabelLength ) && ( '\0' == pcLabel[ xLabelLength - 1 ] ) )
+    {
+        xLabelLength--;
+    }
+    get_semaphore = pkcs11_object_list_lock();
     if( get_semaphore == 0 )
     {
         for( lSearchIndex = MAX_NUM_OBJECTS - 1; lSearchIndex >= 0; lSearchIndex-- )
         {
-            if( pkcs11_context.object_list.objects[ lSearchIndex ].object_handle == xPalHandle )
+            if( ( pkcs11_context.object_list.objects[ lSearchIndex ].object_handle != CK_INVALID_HANDLE ) &&
+                ( xLabelLength < MAX_LABEL_LENGTH ) &&
+                ( 0 == memcmp( pkcs11_context.object_list.objects[ lSearchIndex ].status_lable, pcLabel, xLabelLength ) ) &&
+                ( '\0' == pkcs11_context.object_list.objects[ lSearchIndex ].status_lable[ xLabelLength ] ) )
             {
-                /* Object already exists in list. */
+                /* Object already exists in list. It has just been written, hence the cached value is stale. */
                 xObjectFound = CK_TRUE;
+                pkcs11_object_value_drop( &pkcs11_context.object_list.objects[ lSearchIndex ] );
+                *pxAppHandle = lSearchIndex + 1;
                 break;
             }
             else if( pkcs11_context.object_list.objects[ lSearchIndex ].object_handle == CK_INVALID_HANDLE )
@@ -948,6 +1369,11 @@ CK_RV add_object_to_list( CK_OBJECT_HANDLE xPalHandle,
                 {
                     pkcs11_context.object_list.objects[ lInsertIndex ].object_handle = xPalHandle;
                     memcpy( pkcs11_context.object_list.objects[ lInsertIndex ].status_lable, pcLabel, xLabelLength );
+                    pkcs11_context.object_list.objects[ lInsertIndex ].optiga_oid =
+                        ( uint16_t ) strtol( ( const char * ) pkcs11_context.object_list.objects[ lInsertIndex ].status_lable, &xEnd, 16 );
+                    pkcs11_context.object_list.objects[ lInsertIndex ].object_class = pkcs11_object_class( xPalHandle );
+                    pkcs11_context.object_list.objects[ lInsertIndex ].key_type =
+                        pkcs11_object_key_type( pkcs11_context.object_list.objects[ lInsertIndex ].optiga_oid );
                     *pxAppHandle = lInsertIndex + 1;
                 }
                 else
@@ -969,6 +1395,94 @@ CK_RV add_object_to_list( CK_OBJECT_HANDLE xPalHandle,
 }
 
 
+/**
+ * @brief Builds the object list from the metadata of the objects of OPTIGA(TM) Trust M.
+ *
+ * Adds the objects of pkcs11_object_index_entries holding a value (used size of more than one byte, since
+ * deleted objects are overwritten with a single zero byte) or a key (algorithm is set), labelled by OID.
+ * C_FindObjects is served from the list, the values are read on the first access only.
+ */
+static void pkcs11_object_index_build( void )
+{
+    uint8_t pucMetadata[ 44 ];
+    uint16_t usMetadataLength;
+    uint16_t usUsedSize;
+    uint16_t usOffset;
+    uint8_t ucAlgorithm;
+    uint8_t ucTagLength;
+    uint8_t ucIndex;
+    char pcLabel[ MAX_LABEL_LENGTH ];
+    CK_OBJECT_HANDLE xAppHandle;
+
+    for( ucIndex = 0; ucIndex < sizeof( pkcs11_object_index_entries ) / sizeof( pkcs11_object_index_entries[ 0 ] ); ucIndex++ )
+    {
+        usMetadataLength = sizeof( pucMetadata );
+        pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
+        if( OPTIGA_LIB_SUCCESS != optiga_util_read_metadata(pkcs11_context.object_list.optiga_util_instance,
+                                                            pkcs11_object_index_entries[ ucIndex ].optiga_oid,
+                                                            pucMetadata,
+                                                            &usMetadataLength) )
+        {
+            continue;
+        }
+        pkcs11_wait_for_completion(&pkcs11_context.object_list.optiga_lib_status, &pkcs11_context.object_list.optiga_wait);
+        if( OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status )
+        {
+            continue;
+        }
+
+        // Metadata: 0x20, length, followed by tag, length, value of each entry
+        usUsedSize = 0;
+        ucAlgorithm = 0;
+        for( usOffset = 2; ( usOffset + 2 ) <= usMetadataLength; usOffset += 2 + ucTagLength )
+        {
+            ucTagLength = pucMetadata[ usOffset + 1 ];
+            if( ( usOffset + 2 + ucTagLength ) > usMetadataLength )
+            {
+                break;
+            }
+            if( ( 0xC5 == pucMetadata[ usOffset ] ) && ( 2 >= ucTagLength ) )
+            {
+                // Used size
+                usUsedSize = ( 2 == ucTagLength ) ? ( ( pucMetadata[ usOffset + 2 ] << 8 ) | pucMetadata[ usOffset + 3 ] ) :
+                                                    pucMetadata[ usOffset + 2 ];
+            }
+            else if( ( 0xE0 == pucMetadata[ usOffset ] ) && ( 1 == ucTagLength ) )
+            {
+                // Algorithm
+                ucAlgorithm = pucMetadata[ usOffset + 2 ];
+            }
+        }
+
+        if( ( ( DevicePrivateKey == pkcs11_object_index_entries[ ucIndex ].object_handle ) && ( 0 == ucAlgorithm ) ) ||
+            ( ( DevicePrivateKey != pkcs11_object_index_entries[ ucIndex ].object_handle ) && ( 1 >= usUsedSize ) ) )
+        {
+            continue;
+        }
+
+        sprintf( pcLabel, "0x%04X", pkcs11_object_index_entries[ ucIndex ].optiga_oid );
+        xAppHandle = CK_INVALID_HANDLE;
+        if( ( CKR_OK == add_object_to_list( pkcs11_object_index_entries[ ucIndex ].object_handle,
+                                            &xAppHandle,
+                                            ( uint8_t * ) pcLabel,
+                                            strlen( pcLabel ) ) ) &&
+            ( CK_INVALID_HANDLE != xAppHandle ) && ( 0 != ucAlgorithm ) )
+        {
+            if( ( OPTIGA_RSA_KEY_1024_BIT_EXPONENTIAL == ucAlgorithm ) ||
+                ( OPTIGA_RSA_KEY_2048_BIT_EXPONENTIAL == ucAlgorithm ) )
+            {
+                pkcs11_context.object_list.objects[ xAppHandle - 1 ].key_type = CKK_RSA;
+            }
+            else
+            {
+                // The algorithm of EC key objects is the curve
+                pkcs11_context.object_list.objects[ xAppHandle - 1 ].key_type = CKK_EC;
+                pkcs11_context.object_list.objects[ xAppHandle - 1 ].ec_curve = ( optiga_ecc_curve_t ) ucAlgorithm;
+            }
+        }
+    }
+}
+
 static uint8_t append_optiga_certificate_tags (uint16_t xCertWithoutTagsLength, 
                                         uint8_t* pxCertTags, uint16_t xCertTagsLength)
 {
@@ -1085,10 +1599,7 @@ static int32_t upload_certificate(char * pucLabel, uint8_t * pucData, uint32_t u
 
             if (OPTIGA_LIB_SUCCESS == xReturn)
             {
-                while (OPTIGA_LIB_BUSY == pkcs11_context.object_list.optiga_lib_status)
-                {
-                    
-                }
+                pkcs11_wait_for_completion(&pkcs11_context.object_list.optiga_lib_status, &pkcs11_context.object_list.optiga_wait);
 
                 if (OPTIGA_LIB_SUCCESS == pkcs11_context.object_list.optiga_lib_status)
                 {
@@ -1102,10 +1613,7 @@ static int32_t upload_certificate(char * pucLabel, uint8_t * pucData, uint32_t u
 
                     if (OPTIGA_LIB_SUCCESS == xReturn)
                     {
-                        while (OPTIGA_LIB_BUSY == pkcs11_context.object_list.optiga_lib_status)
-                        {
-                            
-                        }
+                        pkcs11_wait_for_completion(&pkcs11_context.object_list.optiga_lib_status, &pkcs11_context.object_list.optiga_wait);
 
                         if (OPTIGA_LIB_SUCCESS == pkcs11_context.object_list.optiga_lib_status)
                         {
@@ -1148,26 +1656,75 @@ static int32_t upload_public_key(char * pucLabel, uint8_t * pucData, uint32_t ul
                                          pucData,
                                          ulDataSize);
 
-        if (OPTIGA_LIB_SUCCESS == xReturn)
-        {
-            while (OPTIGA_LIB_BUSY == pkcs11_context.object_list.optiga_lib_status)
-            {
-                
-            }
+        if (OPTIGA_LIB_SUCCESS == xReturn)
+        {
+            pkcs11_wait_for_completion(&pkcs11_context.object_list.optiga_lib_status, &pkcs11_context.object_list.optiga_wait);
+
+            if (OPTIGA_LIB_SUCCESS == pkcs11_context.object_list.optiga_lib_status)
+            {
+                xReturn = OPTIGA_LIB_SUCCESS;
+            }
+        }
+
+        pal_os_lock_release(&optiga_mutex);
+
+    }
+
+    return xReturn;
+}
+
+#if (PKCS11_PUBLIC_KEY_WRITE_BACK == 2)
+/**
+ * @brief Starts the write of a public key to an arbitrary data object, without waiting for the completion.
+ *
+ * The data is copied, hence the caller may release it right away. Without the write back instance,
+ * the public key is written synchronously.
+ */
+static int32_t upload_public_key_async(char * pucLabel, const uint8_t * pucData, uint32_t ulDataSize)
+{
+    long     lOptigaOid = 0;
+    optiga_lib_status_t xReturn = OPTIGA_UTIL_ERROR;
+    char*     xEnd = NULL;
+
+    if (NULL == pkcs11_context.write_back_instance)
+    {
+        return upload_public_key(pucLabel, ( uint8_t * ) pucData, ulDataSize);
+    }
+
+    lOptigaOid = strtol(pucLabel, &xEnd, 16);
 
-            if (OPTIGA_LIB_SUCCESS == pkcs11_context.object_list.optiga_lib_status)
+    if ( (0 != lOptigaOid) && (USHRT_MAX >= lOptigaOid) && (USHRT_MAX >= ulDataSize))
+    {
+        pal_os_lock_acquire(&optiga_mutex);
+
+        // Only one write back is pending at a time, a failed write back fails this one as well
+        if (CKR_OK == pkcs11_write_back_complete())
+        {
+            pkcs11_context.write_back_buffer = malloc( ulDataSize );
+        }
+        if (NULL != pkcs11_context.write_back_buffer)
+        {
+            memcpy( pkcs11_context.write_back_buffer, pucData, ulDataSize );
+            pkcs11_context.write_back_status = OPTIGA_LIB_BUSY;
+            xReturn = optiga_util_write_data(pkcs11_context.write_back_instance,
+                                             (uint16_t)lOptigaOid,
+                                             OPTIGA_UTIL_ERASE_AND_WRITE,
+                                             0,
+                                             pkcs11_context.write_back_buffer,
+                                             ulDataSize);
+            if (OPTIGA_LIB_SUCCESS != xReturn)
             {
-                xReturn = OPTIGA_LIB_SUCCESS;
+                free( pkcs11_context.write_back_buffer );
+                pkcs11_context.write_back_buffer = NULL;
             }
         }
 
         pal_os_lock_release(&optiga_mutex);
-
     }
 
     return xReturn;
 }
-    
+#endif
 
 /**
  * @brief Saves an object in non-volatile storage.
@@ -1264,10 +1821,7 @@ CK_OBJECT_HANDLE save_object( CK_ATTRIBUTE_PTR pxLabel,
 
                 if (OPTIGA_LIB_SUCCESS == xReturn)
                 {
-                    while (OPTIGA_LIB_BUSY == pkcs11_context.object_list.optiga_lib_status)
-                    {
-                        
-                    }
+                    pkcs11_wait_for_completion(&pkcs11_context.object_list.optiga_lib_status, &pkcs11_context.object_list.optiga_wait);
 
                     if (OPTIGA_LIB_SUCCESS == pkcs11_context.object_list.optiga_lib_status)
                     {
@@ -1285,6 +1839,43 @@ CK_OBJECT_HANDLE save_object( CK_ATTRIBUTE_PTR pxLabel,
     return object_handle;
 }
 
+/**
+ * @brief Provides the handle of a public key returned by C_GenerateKeyPair.
+ *
+ * The public key is written to its data object as configured by PKCS11_PUBLIC_KEY_WRITE_BACK.
+ *
+ * @return The object handle if successful.
+ * eInvalidHandle = 0 if unsuccessful.
+ */
+static CK_OBJECT_HANDLE save_generated_public_key( CK_ATTRIBUTE_PTR pxLabel,
+                                                   uint8_t * pucData,
+                                                   uint32_t ulDataSize )
+{
+    CK_OBJECT_HANDLE object_handle = eInvalidHandle;
+
+#if (PKCS11_PUBLIC_KEY_WRITE_BACK == 1)
+    object_handle = save_object( pxLabel, pucData, ulDataSize );
+#else
+    if( ( 0 == memcmp( pxLabel->pValue,
+                       &LABEL_DEVICE_PUBLIC_KEY_FOR_TLS,
+                       sizeof( LABEL_DEVICE_PUBLIC_KEY_FOR_TLS ) ) ) ||
+        ( 0 == memcmp( pxLabel->pValue,
+                       &LABEL_DEVICE_RSA_PUBLIC_KEY_FOR_TLS,
+                       sizeof( LABEL_DEVICE_RSA_PUBLIC_KEY_FOR_TLS ) ) ) )
+    {
+        object_handle = DevicePublicKey;
+    #if (PKCS11_PUBLIC_KEY_WRITE_BACK == 2)
+        if( OPTIGA_LIB_SUCCESS != upload_public_key_async( ( char * ) pxLabel->pValue, pucData, ulDataSize ) )
+        {
+            object_handle = eInvalidHandle;
+        }
+    #endif
+    }
+#endif
+
+    return object_handle;
+}
+
     
 CK_RV destroy_object( CK_OBJECT_HANDLE xAppHandle )
 {
@@ -1336,10 +1927,7 @@ CK_RV destroy_object( CK_OBJECT_HANDLE xAppHandle )
 
             if (OPTIGA_LIB_SUCCESS == xResult)
             {
-                while (OPTIGA_LIB_BUSY == pkcs11_context.object_list.optiga_lib_status)
-                {
-                    
-                }
+                pkcs11_wait_for_completion(&pkcs11_context.object_list.optiga_lib_status, &pkcs11_context.object_list.optiga_wait);
 
                 // Either by timout or because of success it should end up here
                 if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
@@ -1394,10 +1982,7 @@ CK_RV destroy_object( CK_OBJECT_HANDLE xAppHandle )
 
                     if (OPTIGA_LIB_SUCCESS == xResult)
                     {
-                        while (OPTIGA_LIB_BUSY == pkcs11_context.object_list.optiga_lib_status)
-                        {
-                            
-                        }
+                        pkcs11_wait_for_completion(&pkcs11_context.object_list.optiga_lib_status, &pkcs11_context.object_list.optiga_wait);
 
                         // Either by timout or because of success it should end up here
                         if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
@@ -1816,6 +2401,7 @@ CK_DEFINE_FUNCTION( CK_RV, C_Initialize )( CK_VOID_PTR pvInitArgs )
 
         if (xResult == CKR_OK)
         {
+            pkcs11_object_index_build();
             pkcs11_context.is_initialized = CK_TRUE;
         }
 
@@ -1856,7 +2442,8 @@ CK_DEFINE_FUNCTION( CK_RV, C_Finalize )( CK_VOID_PTR pvReserved )
             xResult = optiga_trustm_deinitialize();
         }
 
-        if( xResult == CKR_OK )
+        // A failed write back of a public key is reported, the module is finalized nevertheless
+        if( ( xResult == CKR_OK ) || ( xResult == CKR_DEVICE_ERROR ) )
         {
 #ifdef __linux__
             sem_destroy( &pkcs11_context.object_list.semaphore );
@@ -1996,6 +2583,8 @@ CK_DEFINE_FUNCTION( CK_RV, C_GetMechanismInfo )( CK_SLOT_ID slotID,
     pxSupportedMechanisms[] =
     {
         { CKM_ECDSA,                    { 256,  521,  CKF_SIGN | CKF_VERIFY                              } },
+        { CKM_ECDSA_SHA256,             { 256,  521,  CKF_SIGN | CKF_VERIFY                              } },
+        { CKM_SHA256_RSA_PKCS,       { 1024, 2048, CKF_SIGN | CKF_VERIFY                              } },
         { CKM_RSA_PKCS,              { 1024, 2048, CKF_SIGN | CKF_VERIFY | CKA_ENCRYPT | CKA_DECRYPT } },
         { CKM_RSA_PKCS_KEY_PAIR_GEN, { 1024, 2048, CKF_GENERATE_KEY_PAIR                              } },
         { CKM_EC_KEY_PAIR_GEN,          { 256,  521,  CKF_GENERATE_KEY_PAIR                              } },
@@ -2108,6 +2697,20 @@ CK_DEFINE_FUNCTION( CK_RV, C_OpenSession )( CK_SLOT_ID xSlotID,
             0u != ( xFlags & CKF_RW_SESSION ) ? CKS_RW_PUBLIC_SESSION : CKS_RO_PUBLIC_SESSION;
         pxSessionObj->opened = CK_TRUE;
 
+        /*
+         * Crypt operations of the session run on its own instance, as long as the host library has
+         * registrations left. Otherwise the session falls back to the shared instance of the module.
+         */
+        if (PAL_STATUS_SUCCESS == pal_os_wait_create(&pxSessionObj->optiga_wait))
+        {
+            pxSessionObj->optiga_crypt_instance =
+                optiga_crypt_create(0, optiga_session_callback, pxSessionObj);
+            if (NULL == pxSessionObj->optiga_crypt_instance)
+            {
+                pal_os_wait_destroy(&pxSessionObj->optiga_wait);
+            }
+        }
+
         /*
          * Return the session.
          */
@@ -2142,6 +2745,11 @@ CK_DEFINE_FUNCTION( CK_RV, C_CloseSession )( CK_SESSION_HANDLE xSession )
 
     if( (xResult == CKR_OK) && (NULL != pxSession) )
     {
+        if ( NULL != pxSession->optiga_crypt_instance )
+        {
+            ( void ) optiga_crypt_destroy( pxSession->optiga_crypt_instance );
+            pal_os_wait_destroy( &pxSession->optiga_wait );
+        }
         free( pxSession );
     }
     else
@@ -2187,6 +2795,7 @@ CK_DEFINE_FUNCTION( CK_RV, C_GetAttributeValue )( CK_SESSION_HANDLE xSession,
     uint8_t ucP521Oid[] = pkcs11DER_ENCODED_OID_P521;
     uint8_t temp_ec_value[11] = {0};
     uint8_t temp_ec_length = 0;
+    optiga_ecc_curve_t xCurve;
     CK_OBJECT_HANDLE xPalHandle = CK_INVALID_HANDLE;
     size_t xSize;
     uint8_t * pcLabel = NULL;
@@ -2204,13 +2813,13 @@ CK_DEFINE_FUNCTION( CK_RV, C_GetAttributeValue )( CK_SESSION_HANDLE xSession,
         /*
          * Copy the object into a buffer.
          */
-        find_object_in_list_by_handle( xObject, &xPalHandle, &pcLabel, &xSize ); /*pcLabel and xSize are ignored. */
+        find_object_in_list_by_handle( xObject, &xPalHandle, &pcLabel, &xSize );
 
-        if( xPalHandle != CK_INVALID_HANDLE && xPalHandle != DevicePrivateKey )
+        if( xPalHandle != CK_INVALID_HANDLE )
         {
-            xResult = get_object_value( xPalHandle, &pxObjectValue, &ulLength, &xIsPrivate );
+            xResult = get_object_value( xObject, &pxObjectValue, &ulLength, &xIsPrivate );
         }
-        else if (xPalHandle == CK_INVALID_HANDLE)
+        else
         {
             xResult = CKR_DATA_INVALID;
         }
@@ -2220,21 +2829,10 @@ CK_DEFINE_FUNCTION( CK_RV, C_GetAttributeValue )( CK_SESSION_HANDLE xSession,
     {
         xResult = CKR_DATA_INVALID;
     }
-    else {
-        switch (xPalHandle) {
-        case DevicePrivateKey:
-            xClass = CKO_PRIVATE_KEY;
-            break;
-        case DevicePublicKey:
-            xClass = CKO_PUBLIC_KEY;
-            break;
-        case DeviceCertificate:
-            xClass = CKO_CERTIFICATE;
-            break;
-        default:
-            xResult = CKR_DATA_INVALID;
-            break;
-        }
+    else
+    {
+        xClass = pkcs11_context.object_list.objects[ xObject - 1 ].object_class;
+        xPkcsKeyType = pkcs11_context.object_list.objects[ xObject - 1 ].key_type;
     }
 
     if( xResult == CKR_OK )
@@ -2263,6 +2861,24 @@ CK_DEFINE_FUNCTION( CK_RV, C_GetAttributeValue )( CK_SESSION_HANDLE xSession,
 
                     break;
 
+                case CKA_LABEL:
+
+                    if( pxTemplate[ iAttrib ].pValue == NULL )
+                    {
+                        pxTemplate[ iAttrib ].ulValueLen = xSize - 1;
+                    }
+                    else if( pxTemplate[ iAttrib ].ulValueLen < ( xSize - 1 ) )
+                    {
+                        xResult = CKR_BUFFER_TOO_SMALL;
+                    }
+                    else
+                    {
+                        memcpy( pxTemplate[ iAttrib ].pValue, pcLabel, xSize - 1 );
+                        pxTemplate[ iAttrib ].ulValueLen = xSize - 1;
+                    }
+
+                    break;
+
                 case CKA_VALUE:
 
                     if( xIsPrivate == CK_TRUE )
@@ -2298,37 +2914,36 @@ CK_DEFINE_FUNCTION( CK_RV, C_GetAttributeValue )( CK_SESSION_HANDLE xSession,
                     {
                         xResult = CKR_BUFFER_TOO_SMALL;
                     }
+                    else if( CKO_CERTIFICATE == xClass )
+                    {
+                        xResult = CKR_ATTRIBUTE_TYPE_INVALID;
+                    }
                     else
                     {
-                        if( 0 != xResult )
-                        {
-                            xResult = CKR_FUNCTION_FAILED;
-                        }
-                        else
-                        {
-                            /* Elliptic-curve is the only asymmetric cryptosystem
-                             * supported by this implementation. */
-                            xPkcsKeyType = CKK_EC;
-
-                            memcpy( pxTemplate[ iAttrib ].pValue, &xPkcsKeyType, sizeof( CK_KEY_TYPE ) );
-                        }
+                        memcpy( pxTemplate[ iAttrib ].pValue, &xPkcsKeyType, sizeof( CK_KEY_TYPE ) );
                     }
 
                     break;
 
                 case CKA_EC_PARAMS:
 
-                    if ( session->ec_key_type == OPTIGA_ECC_CURVE_NIST_P_256)
+                    xCurve = pkcs11_context.object_list.objects[ xObject - 1 ].ec_curve;
+                    if ( 0 == xCurve )
+                    {
+                        xCurve = session->ec_key_type;
+                    }
+
+                    if ( xCurve == OPTIGA_ECC_CURVE_NIST_P_256)
                     {
                         temp_ec_length = sizeof(ucP256Oid);
                         memcpy(temp_ec_value,ucP256Oid,temp_ec_length);
                     }
-                    else if ( session->ec_key_type == OPTIGA_ECC_CURVE_NIST_P_384)
+                    else if ( xCurve == OPTIGA_ECC_CURVE_NIST_P_384)
                     {
                         temp_ec_length = sizeof(ucP384Oid);
                         memcpy(temp_ec_value,ucP384Oid,temp_ec_length);
                     }
-                    else if ( session->ec_key_type == OPTIGA_ECC_CURVE_NIST_P_521)
+                    else if ( xCurve == OPTIGA_ECC_CURVE_NIST_P_521)
                     {
                         temp_ec_length = sizeof(ucP521Oid);
                         memcpy(temp_ec_value,ucP521Oid,temp_ec_length);
@@ -2354,7 +2969,7 @@ CK_DEFINE_FUNCTION( CK_RV, C_GetAttributeValue )( CK_SESSION_HANDLE xSession,
 
                     if( pxTemplate[ iAttrib ].pValue == NULL )
                     {
-                        pxTemplate[ iAttrib ].ulValueLen = 67; /* TODO: Is this large enough?*/
+                        pxTemplate[ iAttrib ].ulValueLen = ulLength;
                     }
                     else
                     {
@@ -2375,9 +2990,6 @@ CK_DEFINE_FUNCTION( CK_RV, C_GetAttributeValue )( CK_SESSION_HANDLE xSession,
                     xResult = CKR_ATTRIBUTE_TYPE_INVALID;
             }
         }
-
-        /* Free the buffer where object was stored. */
-        get_object_value_cleanup( pxObjectValue, ulLength );
     }
 
     return xResult;
@@ -2396,6 +3008,7 @@ CK_DEFINE_FUNCTION( CK_RV, C_FindObjectsInit )( CK_SESSION_HANDLE xSession,
     CK_RV xResult = PKCS11_SESSION_VALID_AND_MODULE_INITIALIZED(xSession);
     CK_BYTE * find_object_lable = NULL;
     uint32_t ulIndex;
+    CK_ULONG xLabelLength = 0;
     CK_ATTRIBUTE xAttribute;
 
     /* Check inputs. */
@@ -2409,25 +3022,28 @@ CK_DEFINE_FUNCTION( CK_RV, C_FindObjectsInit )( CK_SESSION_HANDLE xSession,
         xResult = CKR_OPERATION_ACTIVE;
         PKCS11_PRINT( ( "ERROR: Find object operation already in progress. \r\n" ) );
     }
-    else if( NULL == pxTemplate )
+    else if( ( NULL == pxTemplate ) && ( 0 != ulCount ) )
     {
         xResult = CKR_ARGUMENTS_BAD;
     }
-    else if( ( ulCount != 1 ) && ( ulCount != 2 ) )
-    {
-        xResult = CKR_ARGUMENTS_BAD;
-        PKCS11_PRINT( ( "ERROR: Find objects does not support searching by %d attributes. \r\n", ulCount ) );
-    }
 
     /* Malloc space to save template information. */
     if( xResult == CKR_OK )
     {
-        find_object_lable = malloc( pxTemplate->ulValueLen + 1 ); /* Add 1 to guarantee null termination for PAL. */
+        for( ulIndex = 0; ulIndex < ulCount; ulIndex++ )
+        {
+            if( pxTemplate[ ulIndex ].type == CKA_LABEL )
+            {
+                xLabelLength = pxTemplate[ ulIndex ].ulValueLen;
+            }
+        }
+
+        find_object_lable = malloc( xLabelLength + 1 ); /* Add 1 to guarantee null termination for PAL. */
         pxSession->find_object_lable = find_object_lable;
 
         if( find_object_lable != NULL )
         {
-            memset( find_object_lable, 0, pxTemplate->ulValueLen + 1 );
+            memset( find_object_lable, 0, xLabelLength + 1 );
         }
         else
         {
@@ -2435,44 +3051,44 @@ CK_DEFINE_FUNCTION( CK_RV, C_FindObjectsInit )( CK_SESSION_HANDLE xSession,
         }
     }
 
-    /* Search template for label.
-     * NOTE: This port only supports looking up objects by CKA_LABEL and all
-     * other search attributes are ignored. */
+    /* Search template for label, class and key type.
+     * NOTE: All other search attributes are ignored. An empty template finds all the objects. */
     if( xResult == CKR_OK )
     {
-        xResult = CKR_TEMPLATE_INCOMPLETE;
+        pxSession->find_object_index = 0;
+        pxSession->find_object_class = CK_UNAVAILABLE_INFORMATION;
+        pxSession->find_object_key_type = CK_UNAVAILABLE_INFORMATION;
 
-        for( ulIndex = 0; ulIndex < ulCount; ulIndex++ ) /* TODO: Re-evaluate the need for this for loop... we are making bad assumptions if 2 objects have the same label anyhow! */
+        for( ulIndex = 0; ulIndex < ulCount; ulIndex++ )
         {
             xAttribute = pxTemplate[ ulIndex ];
 
             if( xAttribute.type == CKA_LABEL )
             {
                 memcpy( pxSession->find_object_lable, xAttribute.pValue, xAttribute.ulValueLen );
-                xResult = CKR_OK;
+            }
+            else if( ( xAttribute.type == CKA_CLASS ) && ( xAttribute.ulValueLen == sizeof( CK_OBJECT_CLASS ) ) )
+            {
+                memcpy( &pxSession->find_object_class, xAttribute.pValue, sizeof( CK_OBJECT_CLASS ) );
+            }
+            else if( ( xAttribute.type == CKA_KEY_TYPE ) && ( xAttribute.ulValueLen == sizeof( CK_KEY_TYPE ) ) )
+            {
+                memcpy( &pxSession->find_object_key_type, xAttribute.pValue, sizeof( CK_KEY_TYPE ) );
             }
             else
             {
-                PKCS11_WARNING_PRINT( ( "WARNING: Search parameters other than label are ignored.\r\n" ) );
+                PKCS11_WARNING_PRINT( ( "WARNING: Search parameters other than label, class and key type are ignored.\r\n" ) );
             }
         }
     }
 
-    /* Clean up memory if there was an error parsing the template. */
-    if( xResult != CKR_OK )
-    {
-        if( find_object_lable != NULL )
-        {
-            free( find_object_lable );
-            pxSession->find_object_lable = NULL;
-        }
-    }
-
     return xResult;
 }
 
 /**
  * @brief Query the objects of the requested type.
+ *
+ * The objects are served from the object list, which is built at C_Initialize.
  */
 CK_DEFINE_FUNCTION( CK_RV, C_FindObjects )( CK_SESSION_HANDLE xSession,
                                             CK_OBJECT_HANDLE_PTR pxObject,
@@ -2484,13 +3100,7 @@ CK_DEFINE_FUNCTION( CK_RV, C_FindObjects )( CK_SESSION_HANDLE xSession,
     CK_RV xResult = PKCS11_SESSION_VALID_AND_MODULE_INITIALIZED(xSession);
     long xDone = 0;
     p_pkcs11_session_t pxSession = get_session_pointer( xSession );
-
-    CK_BYTE_PTR pcObjectValue = NULL;
-    uint32_t xObjectLength = 0;
-    CK_BBOOL xIsPrivate = CK_TRUE;
-    CK_BYTE xByte = 0;
-    CK_OBJECT_HANDLE xPalHandle = CK_INVALID_HANDLE;
-    uint32_t ulIndex;
+    pkcs11_object_t * pxListObject;
 
     /*
      * Check parameters.
@@ -2515,69 +3125,39 @@ CK_DEFINE_FUNCTION( CK_RV, C_FindObjects )( CK_SESSION_HANDLE xSession,
         xDone = 1;
     }
 
-    if( 1u != ulMaxObjectCount )
-    {
-        PKCS11_WARNING_PRINT( ( "WARN: Searching for more than 1 object not supported. \r\n" ) );
-    }
-
-    if( ( 0 == xDone ) && ( ( CK_BBOOL ) CK_TRUE == pxSession->find_object_complete ) )
-    {
-        *pulObjectCount = 0;
-        xResult = CKR_OK;
-        xDone = 1;
-    }
-
     if( ( 0 == xDone ) )
     {
-        /* Try to find the object in module's list first. */
-        find_object_in_list_by_label( pxSession->find_object_lable, strlen( ( const char * ) pxSession->find_object_lable ), &xPalHandle, pxObject );
-
-        /* Check with the PAL if the object was previously stored. */
-        if( *pxObject == CK_INVALID_HANDLE )
-        {
-            xPalHandle = find_object( pxSession->find_object_lable, ( uint8_t ) strlen( ( const char * ) pxSession->find_object_lable ) );
-        }
+        *pulObjectCount = 0;
 
-        if( xPalHandle != CK_INVALID_HANDLE && xPalHandle != DevicePrivateKey)
+        while( ( pxSession->find_object_index < MAX_NUM_OBJECTS ) && ( *pulObjectCount < ulMaxObjectCount ) )
         {
-            xResult = get_object_value( xPalHandle, &pcObjectValue, &xObjectLength, &xIsPrivate );
+            pxListObject = &pkcs11_context.object_list.objects[ pxSession->find_object_index ];
+            pxSession->find_object_index++;
 
-            if( ( xResult == CKR_OK ) && ( xObjectLength == 0 ) )
+            if( pxListObject->object_handle == CK_INVALID_HANDLE )
             {
-                *pulObjectCount = 0;
-                xResult = CKR_OK;
-                xDone = 1;
+                continue;
             }
-            else if ( xResult == CKR_OK )
+            if( ( '\0' != pxSession->find_object_lable[ 0 ] ) &&
+                ( 0 != strcmp( ( const char * ) pxSession->find_object_lable, ( const char * ) pxListObject->status_lable ) ) )
             {
-                for( ulIndex = 0; ulIndex < xObjectLength; ulIndex++ )
-                {
-                    xByte |= pcObjectValue[ ulIndex ];
-                }
-
-                if( xObjectLength == 1 ) /* Deleted objects are overwritten completely w/ zero. */
-                {
-                    *pxObject = CK_INVALID_HANDLE;
-                }
-                else
-                {
-                    xResult = add_object_to_list( xPalHandle, pxObject, pxSession->find_object_lable, strlen( ( const char * ) pxSession->find_object_lable ) );
-                    *pulObjectCount = 1;
-                }
-
-                get_object_value_cleanup( pcObjectValue, xObjectLength );
+                continue;
             }
-        }
-        else if (xPalHandle == DevicePrivateKey)
-        {
-            *pulObjectCount = 1;
-            xResult = CKR_OK;
-        }
-        else
-        {
-            /*xIsObjectWithNoNvmStorage(pxSession->find_object_lable, strlen(pxSession->find_object_lable), ) */
-            PKCS11_PRINT( ( "ERROR: Object with label '%s' not found. \r\n", ( char * ) pxSession->find_object_lable ) );
-            xResult = CKR_FUNCTION_FAILED;
+            if( ( CK_UNAVAILABLE_INFORMATION != pxSession->find_object_class ) &&
+                ( pxSession->find_object_class != pxListObject->object_class ) )
+            {
+                continue;
+            }
+            if( ( CK_UNAVAILABLE_INFORMATION != pxSession->find_object_key_type ) &&
+                ( ( CKO_CERTIFICATE == pxListObject->object_class ) ||
+                  ( pxSession->find_object_key_type != pxListObject->key_type ) ) )
+            {
+                continue;
+            }
+
+            /* Zero is not a valid handle, the handle is the index offset by 1. */
+            pxObject[ *pulObjectCount ] = pxSession->find_object_index;
+            ( *pulObjectCount )++;
         }
     }
 
@@ -2977,6 +3557,32 @@ CK_RV verify_public_key_template( CK_SESSION_HANDLE xSession,
 
 
 
+/**
+ * @brief Updates the derived attributes of a generated key in the object list.
+ *
+ * The key type and the curve are known from the mechanism of the generation, without reading the key back.
+ */
+static void set_generated_key_attributes( CK_OBJECT_HANDLE xAppHandle,
+                                          CK_MECHANISM_TYPE xMechanism,
+                                          optiga_ecc_curve_t xCurve )
+{
+    int lIndex = ( int ) xAppHandle - 1;
+
+    if( ( 0 <= lIndex ) && ( MAX_NUM_OBJECTS > lIndex ) )
+    {
+        if( CKM_EC_KEY_PAIR_GEN == xMechanism )
+        {
+            pkcs11_context.object_list.objects[ lIndex ].key_type = CKK_EC;
+            pkcs11_context.object_list.objects[ lIndex ].ec_curve = xCurve;
+        }
+        else
+        {
+            pkcs11_context.object_list.objects[ lIndex ].key_type = CKK_RSA;
+            pkcs11_context.object_list.objects[ lIndex ].ec_curve = ( optiga_ecc_curve_t ) 0;
+        }
+    }
+}
+
 /**
  * @brief Generate a new public-private key pair.
  */
@@ -2989,8 +3595,11 @@ CK_DEFINE_FUNCTION( CK_RV, C_GenerateKeyPair )( CK_SESSION_HANDLE xSession,
                                                 CK_OBJECT_HANDLE_PTR pxPublicKey,
                                                 CK_OBJECT_HANDLE_PTR pxPrivateKey )
 {
+    optiga_crypt_t * pxCrypt = NULL;
+    volatile optiga_lib_status_t * pxStatus = NULL;
 
     CK_RV xResult = PKCS11_SESSION_VALID_AND_MODULE_INITIALIZED( xSession );
+    p_pkcs11_session_t session = get_session_pointer( xSession );
     uint8_t * pucPublicKeyDer = NULL;
     uint16_t ucPublicKeyDerLength = 0;
     CK_ATTRIBUTE_PTR pxPrivateLabel = NULL;
@@ -3004,7 +3613,6 @@ CK_DEFINE_FUNCTION( CK_RV, C_GenerateKeyPair )( CK_SESSION_HANDLE xSession,
     
     do
     {
-        p_pkcs11_session_t session = get_session_pointer( xSession );
         if( (CKM_EC_KEY_PAIR_GEN != pxMechanism->mechanism) && (CKM_RSA_PKCS_KEY_PAIR_GEN != pxMechanism->mechanism) )
         {
             xResult = CKR_MECHANISM_PARAM_INVALID;
@@ -3031,16 +3639,27 @@ CK_DEFINE_FUNCTION( CK_RV, C_GenerateKeyPair )( CK_SESSION_HANDLE xSession,
             break;
         }
 
+        #if (PKCS11_PUBLIC_KEY_WRITE_BACK == 2)
+        // The failed write back of the previous public key is reported, before another key pair is generated
+        pal_os_lock_acquire(&optiga_mutex);
+        xResult = pkcs11_write_back_complete();
+        pal_os_lock_release(&optiga_mutex);
+        if( xResult != CKR_OK )
+        {
+            break;
+        }
+        #endif
+
         lOptigaOid = strtol((char*)pxPrivateLabel->pValue, &xEnd, 16);
 
         if ( 0 != lOptigaOid)
         {
-            pal_os_lock_acquire(&optiga_mutex);
+            pxCrypt = pkcs11_crypt_acquire( session, &pxStatus );
 
             /* For the public key, the OPTIGA library will return the standard 65 
                       bytes of uncompressed curve points plus a 3-byte tag. The latter will 
                        be intentionally overwritten below. */
-            pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
+            *pxStatus = OPTIGA_LIB_BUSY;
             if ( pxMechanism->mechanism == CKM_EC_KEY_PAIR_GEN )
             {
                 ucPublicKeyDerLength = session->ec_key_size;
@@ -3051,7 +3670,7 @@ CK_DEFINE_FUNCTION( CK_RV, C_GenerateKeyPair )( CK_SESSION_HANDLE xSession,
                     xResult = CKR_HOST_MEMORY;
                     break;
                 }
-                xResult = optiga_crypt_ecc_generate_keypair(pkcs11_context.object_list.optiga_crypt_instance,
+                xResult = optiga_crypt_ecc_generate_keypair(pxCrypt,
                                                             session->ec_key_type,
                                                             (uint8_t)OPTIGA_KEY_USAGE_SIGN,
                                                             FALSE,
@@ -3084,7 +3703,7 @@ CK_DEFINE_FUNCTION( CK_RV, C_GenerateKeyPair )( CK_SESSION_HANDLE xSession,
                 rsa_key_type = (session->rsa_key_size == pkcs11RSA_2048_MODULUS_BITS ? 
                                                          OPTIGA_RSA_KEY_2048_BIT_EXPONENTIAL: 
                                                          OPTIGA_RSA_KEY_1024_BIT_EXPONENTIAL);
-                xResult = optiga_crypt_rsa_generate_keypair(pkcs11_context.object_list.optiga_crypt_instance,
+                xResult = optiga_crypt_rsa_generate_keypair(pxCrypt,
                                                             rsa_key_type,
                                                             key_usage,
                                                             FALSE,
@@ -3105,19 +3724,17 @@ CK_DEFINE_FUNCTION( CK_RV, C_GenerateKeyPair )( CK_SESSION_HANDLE xSession,
                 break;
             }
 
-            while (OPTIGA_LIB_BUSY == pkcs11_context.object_list.optiga_lib_status)
-            {
-            
-            }
+            pkcs11_crypt_wait( session, pxStatus );
 
             // Either by timout or because of success it should end up here
-            if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
+            if (OPTIGA_LIB_SUCCESS != *pxStatus)
             {
                 PKCS11_PRINT( ( "ERROR: Failed to generate a keypair \r\n" ) );
                 xResult = CKR_FUNCTION_FAILED;
                 break;
             }
-            pal_os_lock_release(&optiga_mutex);
+            pkcs11_crypt_release( session, pxCrypt );
+            pxCrypt = NULL;
         }
         else
         {
@@ -3128,9 +3745,9 @@ CK_DEFINE_FUNCTION( CK_RV, C_GenerateKeyPair )( CK_SESSION_HANDLE xSession,
         if( xResult == CKR_OK)
         {
           
-           xPalPublic = save_object(pxPublicLabel,
-                                     (unsigned char *)pucPublicKeyDer,
-                                     ucPublicKeyDerLength);   
+           xPalPublic = save_generated_public_key(pxPublicLabel,
+                                                  (unsigned char *)pucPublicKeyDer,
+                                                  ucPublicKeyDerLength);
 
         }
         else
@@ -3153,15 +3770,21 @@ CK_DEFINE_FUNCTION( CK_RV, C_GenerateKeyPair )( CK_SESSION_HANDLE xSession,
                     destroy_object( *pxPrivateKey );
                     break;
                 }
+                set_generated_key_attributes( *pxPrivateKey, pxMechanism->mechanism, session->ec_key_type );
+                set_generated_key_attributes( *pxPublicKey, pxMechanism->mechanism, session->ec_key_type );
+                // The returned public key is the value of the object, hence it is not read back
+                pkcs11_object_value_set( *pxPublicKey, pucPublicKeyDer, ucPublicKeyDerLength );
+                pucPublicKeyDer = NULL;
             }
             
         }
         else
         {
-            xResult = CK_INVALID_HANDLE;
+            xResult = CKR_DEVICE_ERROR;
             break;            
         }
     } while(0);
+    pkcs11_crypt_release( session, pxCrypt );
     /* Clean up. */
     if( NULL != pucPublicKeyDer )
     {
@@ -3190,6 +3813,27 @@ CK_RV check_valid_rsa_signature_scheme(CK_MECHANISM_TYPE mechanism_type)
     return return_status;
 }
 
+/**
+ * @brief Calculates the SHA256 digest of the data on host.
+ */
+static CK_RV pkcs11_sha256_on_host( const uint8_t * pucData,
+                                    CK_ULONG ulDataLen,
+                                    uint8_t * pucDigest )
+{
+    CK_RV xResult = CKR_FUNCTION_FAILED;
+    uint8_t pucContext[ OPTIGA_HASH_CONTEXT_LENGTH_SHA_256 ];
+
+    if( ( PAL_STATUS_SUCCESS == pal_crypt_sha256_start( NULL, pucContext, sizeof( pucContext ) ) ) &&
+        ( PAL_STATUS_SUCCESS == pal_crypt_sha256_update( NULL, pucContext, sizeof( pucContext ), pucData, ( uint32_t ) ulDataLen ) ) &&
+        ( PAL_STATUS_SUCCESS == pal_crypt_sha256_finalize( NULL, pucContext, sizeof( pucContext ), pucDigest ) ) )
+    {
+        xResult = CKR_OK;
+    }
+    memset( pucContext, 0, sizeof( pucContext ) );
+
+    return xResult;
+}
+
 CK_RV set_valid_rsa_signature_scheme(CK_MECHANISM_TYPE mechanism_type,
                                            optiga_rsa_signature_scheme_t* rsa_signature_scheme)
  {
@@ -3283,7 +3927,8 @@ CK_DEFINE_FUNCTION( CK_RV, C_SignInit )( CK_SESSION_HANDLE xSession,
         
 
         /* Check that the mechanism and key type are compatible, supported. */
-        if( (pxMechanism->mechanism != CKM_ECDSA) && (check_valid_rsa_signature_scheme(pxMechanism->mechanism)) )
+        if( (pxMechanism->mechanism != CKM_ECDSA) && (pxMechanism->mechanism != CKM_ECDSA_SHA256) &&
+            (check_valid_rsa_signature_scheme(pxMechanism->mechanism)) )
         {
             PKCS11_PRINT( ("ERROR: Unsupported mechanism type %d \r\n", pxMechanism->mechanism) );
             xResult = CKR_MECHANISM_INVALID;
@@ -3291,7 +3936,21 @@ CK_DEFINE_FUNCTION( CK_RV, C_SignInit )( CK_SESSION_HANDLE xSession,
         }
         else
         {
-            pxSession->sign_mechanism = pxMechanism->mechanism;
+            /* CKM_ECDSA_SHA256 signs the SHA256 digest of the data, which is calculated on host */
+            pxSession->sign_hash_on_host = (pxMechanism->mechanism == CKM_ECDSA_SHA256) ? CK_TRUE : CK_FALSE;
+            pxSession->sign_mechanism = (CK_TRUE == pxSession->sign_hash_on_host) ? CKM_ECDSA : pxMechanism->mechanism;
+        }
+
+        /* Multi-part signing hashes on host, only the final digest is sent to OPTIGA */
+        pxSession->sign_digest_started = CK_FALSE;
+        if( (pxMechanism->mechanism == CKM_ECDSA_SHA256) || (pxMechanism->mechanism == CKM_SHA256_RSA_PKCS) )
+        {
+            if( PAL_STATUS_SUCCESS != pal_crypt_sha256_start( NULL, pxSession->sign_digest_ctx, sizeof( pxSession->sign_digest_ctx ) ) )
+            {
+                xResult = CKR_FUNCTION_FAILED;
+                break;
+            }
+            pxSession->sign_digest_started = CK_TRUE;
         }
 
         session->sign_init_done = TRUE;
@@ -3317,6 +3976,9 @@ CK_DEFINE_FUNCTION( CK_RV, C_Sign )( CK_SESSION_HANDLE xSession,
     uint8_t ecSignature[ pkcs11ECDSA_P521_SIGNATURE_LENGTH + 3 + 3 ];
     uint16_t ecSignatureLength = sizeof(ecSignature);
     optiga_rsa_signature_scheme_t rsa_signature_scheme = 0;
+    optiga_crypt_t * pxCrypt = NULL;
+    volatile optiga_lib_status_t * pxStatus = NULL;
+    uint8_t pucDigest[ pkcs11SHA256_DIGEST_LENGTH ];
 
     do
     {
@@ -3331,6 +3993,17 @@ CK_DEFINE_FUNCTION( CK_RV, C_Sign )( CK_SESSION_HANDLE xSession,
             xResult = CKR_ARGUMENTS_BAD;
             break;
         }
+
+        if( CK_TRUE == session->sign_hash_on_host )
+        {
+            xResult = pkcs11_sha256_on_host( pucData, ulDataLen, pucDigest );
+            if( CKR_OK != xResult )
+            {
+                break;
+            }
+            pucData = pucDigest;
+            ulDataLen = sizeof( pucDigest );
+        }
         /* Update the signature length. */
         if (session->sign_mechanism == CKM_ECDSA)
         {
@@ -3373,7 +4046,7 @@ CK_DEFINE_FUNCTION( CK_RV, C_Sign )( CK_SESSION_HANDLE xSession,
 
         if (0 != session->sign_key_oid)
         {
-            pal_os_lock_acquire(&optiga_mutex);
+            pxCrypt = pkcs11_crypt_acquire( session, &pxStatus );
 
             /*
                      * An example of a returned signature
@@ -3383,19 +4056,31 @@ CK_DEFINE_FUNCTION( CK_RV, C_Sign )( CK_SESSION_HANDLE xSession,
                      * 0x000030: 0d 7d 46 5b 44 72 40 06 a5 7b 06 84 0f d7 6e 0f .}F[Dr@..{....n.
                      * 0x000040: 4b 45 7f 50                                     KE.P
                      */
-            pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
+            *pxStatus = OPTIGA_LIB_BUSY;
             if (session->sign_mechanism == CKM_ECDSA)
             {
-                xResult = optiga_crypt_ecdsa_sign(pkcs11_context.object_list.optiga_crypt_instance,
+#ifdef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+                /* R & S components are returned straight from the response */
+                ecSignatureLength = (uint16_t)xSignatureLength;
+                xResult = optiga_crypt_ecdsa_sign_format(pxCrypt,
+                                                         pucData,
+                                                         ulDataLen,
+                                                         session->sign_key_oid,
+                                                         OPTIGA_ECDSA_SIGNATURE_FORMAT_RAW,
+                                                         pucSignature,
+                                                         &ecSignatureLength);
+#else
+                xResult = optiga_crypt_ecdsa_sign(pxCrypt,
                                                   pucData,
                                                   ulDataLen,
                                                   session->sign_key_oid,
                                                   ecSignature,
                                                   &ecSignatureLength);
+#endif
             }
             else if ( CKR_OK == set_valid_rsa_signature_scheme(session->sign_mechanism, &rsa_signature_scheme) )
             {
-                xResult = optiga_crypt_rsa_sign(pkcs11_context.object_list.optiga_crypt_instance,
+                xResult = optiga_crypt_rsa_sign(pxCrypt,
                                                 rsa_signature_scheme,
                                                 pucData,
                                                 ulDataLen,
@@ -3416,48 +4101,134 @@ CK_DEFINE_FUNCTION( CK_RV, C_Sign )( CK_SESSION_HANDLE xSession,
                 break;
             }
 
-            while (OPTIGA_LIB_BUSY == pkcs11_context.object_list.optiga_lib_status)
-            {
-
-            }
+            pkcs11_crypt_wait( session, pxStatus );
 
             // Either by timout or because of success it should end up here
-            if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
+            if (OPTIGA_LIB_SUCCESS != *pxStatus)
             {
                 xResult = CKR_FUNCTION_FAILED;
                 break;
             }
 
-            pal_os_lock_release(&optiga_mutex);
+            pkcs11_crypt_release( session, pxCrypt );
+            pxCrypt = NULL;
         }
         if (session->sign_mechanism == CKM_ECDSA)
         {
+#ifndef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
             /* Reformat from DER encoded to 64-byte R & S components */
             asn1_to_ecdsa_rs(ecSignature, ecSignatureLength, pucSignature, xSignatureLength);
+#endif
             *pulSignatureLen = xSignatureLength;
         }
-        /* Complete the operation in the context. */
-        if( xResult != CKR_BUFFER_TOO_SMALL )
+        /* Complete the operation in the context. */
+        if( xResult != CKR_BUFFER_TOO_SMALL )
+        {
+            session->sign_mechanism = pkcs11NO_OPERATION;
+        }
+    }while(0);
+    pkcs11_crypt_release( session, pxCrypt );
+    return xResult;
+}
+
+
+/**
+ * @brief Continues a multi-part signature operation.
+ *
+ * The data is hashed on host, supported for CKM_ECDSA_SHA256 and CKM_SHA256_RSA_PKCS.
+ */
+CK_DEFINE_FUNCTION(CK_RV, C_SignUpdate)( CK_SESSION_HANDLE xSession, 
+                                          CK_BYTE_PTR part, 
+                                          CK_ULONG part_len) 
+{
+    CK_RV xResult = PKCS11_SESSION_VALID_AND_MODULE_INITIALIZED(xSession);
+    p_pkcs11_session_t session = get_session_pointer( xSession );
+
+    do
+    {
+        if( CKR_OK != xResult )
+        {
+            break;
+        }
+        if( (TRUE != session->sign_init_done) || (pkcs11NO_OPERATION == session->sign_mechanism) )
+        {
+            xResult = CKR_OPERATION_NOT_INITIALIZED;
+            break;
+        }
+        if( CK_TRUE != session->sign_digest_started )
+        {
+            xResult = CKR_MECHANISM_INVALID;
+            break;
+        }
+        if( (NULL == part) && (0 != part_len) )
+        {
+            xResult = CKR_ARGUMENTS_BAD;
+            break;
+        }
+        if( PAL_STATUS_SUCCESS != pal_crypt_sha256_update( NULL,
+                                                           session->sign_digest_ctx,
+                                                           sizeof( session->sign_digest_ctx ),
+                                                           part,
+                                                           ( uint32_t ) part_len ) )
         {
-            session->sign_mechanism = pkcs11NO_OPERATION;
+            xResult = CKR_FUNCTION_FAILED;
+            break;
         }
     }while(0);
     return xResult;
 }
 
-
-CK_DEFINE_FUNCTION(CK_RV, C_SignUpdate)( CK_SESSION_HANDLE xSession, 
-                                          CK_BYTE_PTR part, 
-                                          CK_ULONG part_len) 
-{
-    return CKR_OK;
-}
-
+/**
+ * @brief Finishes a multi-part signature operation, signing the digest calculated on host with OPTIGA.
+ */
 CK_DEFINE_FUNCTION(CK_RV, C_SignFinal)( CK_SESSION_HANDLE xSession, 
                                         CK_BYTE_PTR signature, 
                                         CK_ULONG_PTR signature_len) 
 {
-    return CKR_OK;
+    CK_RV xResult = PKCS11_SESSION_VALID_AND_MODULE_INITIALIZED(xSession);
+    p_pkcs11_session_t session = get_session_pointer( xSession );
+    uint8_t pucContext[ OPTIGA_HASH_CONTEXT_LENGTH_SHA_256 ];
+    uint8_t pucDigest[ pkcs11SHA256_DIGEST_LENGTH ];
+    CK_BBOOL xHashOnHost;
+
+    do
+    {
+        if( CKR_OK != xResult )
+        {
+            break;
+        }
+        if( (TRUE != session->sign_init_done) || (pkcs11NO_OPERATION == session->sign_mechanism) )
+        {
+            xResult = CKR_OPERATION_NOT_INITIALIZED;
+            break;
+        }
+        if( CK_TRUE != session->sign_digest_started )
+        {
+            xResult = CKR_MECHANISM_INVALID;
+            break;
+        }
+
+        /* Finalize a copy, the operation continues if the signature buffer is too small */
+        memcpy( pucContext, session->sign_digest_ctx, sizeof( pucContext ) );
+        if( PAL_STATUS_SUCCESS != pal_crypt_sha256_finalize( NULL, pucContext, sizeof( pucContext ), pucDigest ) )
+        {
+            xResult = CKR_FUNCTION_FAILED;
+            break;
+        }
+
+        xHashOnHost = session->sign_hash_on_host;
+        session->sign_hash_on_host = CK_FALSE;
+        xResult = C_Sign( xSession, pucDigest, sizeof( pucDigest ), signature, signature_len );
+        session->sign_hash_on_host = xHashOnHost;
+
+        if( CKR_BUFFER_TOO_SMALL != xResult )
+        {
+            session->sign_digest_started = CK_FALSE;
+            memset( session->sign_digest_ctx, 0, sizeof( session->sign_digest_ctx ) );
+        }
+    }while(0);
+    memset( pucContext, 0, sizeof( pucContext ) );
+    return xResult;
 }
 
 
@@ -3514,15 +4285,30 @@ CK_DEFINE_FUNCTION( CK_RV, C_VerifyInit )( CK_SESSION_HANDLE xSession,
         }
     
         /* Check for a supported crypto algorithm. */
-        if( (pxMechanism->mechanism == CKM_ECDSA) || !(check_valid_rsa_signature_scheme(pxMechanism->mechanism)) )
+        if( (pxMechanism->mechanism == CKM_ECDSA) || (pxMechanism->mechanism == CKM_ECDSA_SHA256) ||
+            !(check_valid_rsa_signature_scheme(pxMechanism->mechanism)) )
         {
-            session->verify_mechanism = pxMechanism->mechanism;
+            /* CKM_ECDSA_SHA256 verifies the SHA256 digest of the data, which is calculated on host */
+            session->verify_hash_on_host = (pxMechanism->mechanism == CKM_ECDSA_SHA256) ? CK_TRUE : CK_FALSE;
+            session->verify_mechanism = (CK_TRUE == session->verify_hash_on_host) ? CKM_ECDSA : pxMechanism->mechanism;
         }
         else
         {
             xResult = CKR_MECHANISM_INVALID;
             break;
         }
+
+        /* Multi-part verification hashes on host, only the final digest is sent to OPTIGA */
+        session->verify_digest_started = CK_FALSE;
+        if( (pxMechanism->mechanism == CKM_ECDSA_SHA256) || (pxMechanism->mechanism == CKM_SHA256_RSA_PKCS) )
+        {
+            if( PAL_STATUS_SUCCESS != pal_crypt_sha256_start( NULL, session->verify_digest_ctx, sizeof( session->verify_digest_ctx ) ) )
+            {
+                xResult = CKR_FUNCTION_FAILED;
+                break;
+            }
+            session->verify_digest_started = CK_TRUE;
+        }
         session->verify_init_done = TRUE;
     } while (0);
     return xResult;
@@ -3538,6 +4324,8 @@ CK_DEFINE_FUNCTION( CK_RV, C_Verify )( CK_SESSION_HANDLE xSession,
                                        CK_BYTE_PTR pucSignature,
                                        CK_ULONG ulSignatureLen )
 {
+    optiga_crypt_t * pxCrypt = NULL;
+    volatile optiga_lib_status_t * pxStatus = NULL;
 
     CK_RV xResult = CKR_OK;
     p_pkcs11_session_t session;
@@ -3547,8 +4335,11 @@ CK_DEFINE_FUNCTION( CK_RV, C_Verify )( CK_SESSION_HANDLE xSession,
     optiga_rsa_signature_scheme_t rsa_signature_scheme = 0;
     CK_ULONG xSignatureLength = 0;
      /* (R component ) + (S component ) + DER tags 3 bytes max each*/
+#ifndef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
     CK_BYTE pubASN1Signature[pkcs11ECDSA_P521_SIGNATURE_LENGTH + 0x03 + 0x03];
     CK_ULONG pubASN1SignatureLength = sizeof(pubASN1Signature);   
+#endif
+    uint8_t pucDigest[ pkcs11SHA256_DIGEST_LENGTH ];
     do
     {
         session = get_session_pointer( xSession );
@@ -3564,6 +4355,17 @@ CK_DEFINE_FUNCTION( CK_RV, C_Verify )( CK_SESSION_HANDLE xSession,
             xResult = CKR_ARGUMENTS_BAD;
             break;
         }
+
+        if( CK_TRUE == session->verify_hash_on_host )
+        {
+            xResult = pkcs11_sha256_on_host( pucData, ulDataLen, pucDigest );
+            if( CKR_OK != xResult )
+            {
+                break;
+            }
+            pucData = pucDigest;
+            ulDataLen = sizeof( pucDigest );
+        }
         /* Check that the signature and data are the expected length.
          * These PKCS #11 mechanism expect data to be pre-hashed/formatted. */
         if( session->verify_mechanism == CKM_ECDSA )
@@ -3605,6 +4407,7 @@ CK_DEFINE_FUNCTION( CK_RV, C_Verify )( CK_SESSION_HANDLE xSession,
                 xResult = CKR_ARGUMENTS_BAD;
                 break;                
             }
+#ifndef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
             /* Perform an ECDSA verification. */
             if ( !ecdsa_rs_to_asn1_integers(&pucSignature[ 0 ], &pucSignature[ xSignatureLength/2 ], xSignatureLength/2,
                                             pubASN1Signature, (size_t*)&pubASN1SignatureLength))
@@ -3612,6 +4415,7 @@ CK_DEFINE_FUNCTION( CK_RV, C_Verify )( CK_SESSION_HANDLE xSession,
                 xResult = CKR_SIGNATURE_INVALID;
                 PKCS11_PRINT( ( "Failed to parse EC signature \r\n" ) );
             }
+#endif
         }
         else if ( CKR_OK == check_valid_rsa_signature_scheme(session->verify_mechanism))
         {
@@ -3647,10 +4451,7 @@ CK_DEFINE_FUNCTION( CK_RV, C_Verify )( CK_SESSION_HANDLE xSession,
             xResult = CKR_SIGNATURE_INVALID;
             break;
         }
-        while (OPTIGA_LIB_BUSY == pkcs11_context.object_list.optiga_lib_status)
-        {
-        
-        }
+        pkcs11_wait_for_completion(&pkcs11_context.object_list.optiga_lib_status, &pkcs11_context.object_list.optiga_wait);
 
         // Either by timout or because of success it should end up here
         if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
@@ -3662,22 +4463,34 @@ CK_DEFINE_FUNCTION( CK_RV, C_Verify )( CK_SESSION_HANDLE xSession,
 
         pal_os_lock_release(&optiga_mutex);
         
-        pal_os_lock_acquire(&optiga_mutex);
+        pxCrypt = pkcs11_crypt_acquire( session, &pxStatus );
         
-        pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
+        *pxStatus = OPTIGA_LIB_BUSY;
         if (session->verify_mechanism == CKM_ECDSA)
         {
             xPublicKeyDetails.public_key = temp;
             xPublicKeyDetails.length = tempLen;
             xPublicKeyDetails.key_type = session->ec_key_type;
 
-            xResult = optiga_crypt_ecdsa_verify (pkcs11_context.object_list.optiga_crypt_instance,
+#ifdef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+            /* R & S components are converted straight into the command */
+            xResult = optiga_crypt_ecdsa_verify_format (pxCrypt,
+                                                        pucData,
+                                                        ulDataLen,
+                                                        OPTIGA_ECDSA_SIGNATURE_FORMAT_RAW,
+                                                        pucSignature,
+                                                        (uint16_t)xSignatureLength,
+                                                        OPTIGA_CRYPT_HOST_DATA,
+                                                        &xPublicKeyDetails );
+#else
+            xResult = optiga_crypt_ecdsa_verify (pxCrypt,
                                                  pucData, 
                                                  ulDataLen,
                                                  pubASN1Signature,
                                                  pubASN1SignatureLength,
                                                  OPTIGA_CRYPT_HOST_DATA, 
                                                  &xPublicKeyDetails );
+#endif
         }
         else if ( CKR_OK == set_valid_rsa_signature_scheme(session->verify_mechanism, &rsa_signature_scheme)) 
         {
@@ -3687,7 +4500,7 @@ CK_DEFINE_FUNCTION( CK_RV, C_Verify )( CK_SESSION_HANDLE xSession,
                                                                    OPTIGA_RSA_KEY_2048_BIT_EXPONENTIAL :
                                                                    OPTIGA_RSA_KEY_1024_BIT_EXPONENTIAL);
                     
-            xResult = optiga_crypt_rsa_verify (pkcs11_context.object_list.optiga_crypt_instance,
+            xResult = optiga_crypt_rsa_verify (pxCrypt,
                                                rsa_signature_scheme,
                                                pucData,
                                                ulDataLen,
@@ -3708,37 +4521,117 @@ CK_DEFINE_FUNCTION( CK_RV, C_Verify )( CK_SESSION_HANDLE xSession,
             xResult = CKR_SIGNATURE_INVALID;
             break;
         }
-        while (OPTIGA_LIB_BUSY == pkcs11_context.object_list.optiga_lib_status)
-        {
-        
-        }
+        pkcs11_crypt_wait( session, pxStatus );
 
         // Either by timout or because of success it should end up here
-        if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
+        if (OPTIGA_LIB_SUCCESS != *pxStatus)
         {
             PKCS11_PRINT( "Failed to verify the signature\r\n" );
             xResult = CKR_SIGNATURE_INVALID;
             break;
         }
-        pal_os_lock_release(&optiga_mutex);
+        pkcs11_crypt_release( session, pxCrypt );
+        pxCrypt = NULL;
     
     }while (0);
+
+    pkcs11_crypt_release( session, pxCrypt );
     /* Return the signature verification result. */
     return xResult;
 }
 
+/**
+ * @brief Continues a multi-part verification operation.
+ *
+ * The data is hashed on host, supported for CKM_ECDSA_SHA256 and CKM_SHA256_RSA_PKCS.
+ */
 CK_DEFINE_FUNCTION( CK_RV, C_VerifyUpdate)( CK_SESSION_HANDLE xSession, 
                                            CK_BYTE_PTR part, 
                                            CK_ULONG part_len) 
 {
-    return CKR_OK;
+    CK_RV xResult = PKCS11_SESSION_VALID_AND_MODULE_INITIALIZED(xSession);
+    p_pkcs11_session_t session = get_session_pointer( xSession );
+
+    do
+    {
+        if( CKR_OK != xResult )
+        {
+            break;
+        }
+        if( TRUE != session->verify_init_done )
+        {
+            xResult = CKR_OPERATION_NOT_INITIALIZED;
+            break;
+        }
+        if( CK_TRUE != session->verify_digest_started )
+        {
+            xResult = CKR_MECHANISM_INVALID;
+            break;
+        }
+        if( (NULL == part) && (0 != part_len) )
+        {
+            xResult = CKR_ARGUMENTS_BAD;
+            break;
+        }
+        if( PAL_STATUS_SUCCESS != pal_crypt_sha256_update( NULL,
+                                                           session->verify_digest_ctx,
+                                                           sizeof( session->verify_digest_ctx ),
+                                                           part,
+                                                           ( uint32_t ) part_len ) )
+        {
+            xResult = CKR_FUNCTION_FAILED;
+            break;
+        }
+    } while (0);
+    return xResult;
 }
 
+/**
+ * @brief Finishes a multi-part verification operation, verifying the digest calculated on host with OPTIGA.
+ */
 CK_DEFINE_FUNCTION( CK_RV, C_VerifyFinal)( CK_SESSION_HANDLE xSession,
                                           CK_BYTE_PTR signature, 
                                           CK_ULONG signature_len) 
 {
-    return CKR_OK;
+    CK_RV xResult = PKCS11_SESSION_VALID_AND_MODULE_INITIALIZED(xSession);
+    p_pkcs11_session_t session = get_session_pointer( xSession );
+    uint8_t pucDigest[ pkcs11SHA256_DIGEST_LENGTH ];
+    CK_BBOOL xHashOnHost;
+
+    do
+    {
+        if( CKR_OK != xResult )
+        {
+            break;
+        }
+        if( TRUE != session->verify_init_done )
+        {
+            xResult = CKR_OPERATION_NOT_INITIALIZED;
+            break;
+        }
+        if( CK_TRUE != session->verify_digest_started )
+        {
+            xResult = CKR_MECHANISM_INVALID;
+            break;
+        }
+
+        session->verify_digest_started = CK_FALSE;
+        if( PAL_STATUS_SUCCESS != pal_crypt_sha256_finalize( NULL,
+                                                             session->verify_digest_ctx,
+                                                             sizeof( session->verify_digest_ctx ),
+                                                             pucDigest ) )
+        {
+            xResult = CKR_FUNCTION_FAILED;
+            break;
+        }
+        memset( session->verify_digest_ctx, 0, sizeof( session->verify_digest_ctx ) );
+
+        xHashOnHost = session->verify_hash_on_host;
+        session->verify_hash_on_host = CK_FALSE;
+        xResult = C_Verify( xSession, pucDigest, sizeof( pucDigest ), signature, signature_len );
+        session->verify_hash_on_host = xHashOnHost;
+    } while (0);
+    return xResult;
 }
 
 
@@ -3749,14 +4642,18 @@ CK_DEFINE_FUNCTION( CK_RV, C_GenerateRandom )( CK_SESSION_HANDLE xSession,
                                                CK_BYTE_PTR pucRandomData,
                                                CK_ULONG ulRandomLen )
 {
+    p_pkcs11_session_t session = get_session_pointer( xSession );
+    optiga_crypt_t * pxCrypt = NULL;
+    volatile optiga_lib_status_t * pxStatus = NULL;
 
     CK_RV xResult = CKR_OK;
     // this is to truncate random numbers to the required length, as OPTIGA(TM) Trust can generate
     // values starting from 8 bytes
-    CK_BYTE xRandomBuf4SmallLengths[8];
-    CK_ULONG xBuferSwitcherLength = ulRandomLen;
-    CK_BYTE_PTR pxBufferSwitcher = pucRandomData;
-    
+    CK_BYTE xRandomBuf4SmallLengths[PKCS11_RANDOM_LENGTH_MIN];
+    CK_BYTE_PTR pxBufferSwitcher;
+    CK_ULONG xBuferSwitcherLength;
+    CK_ULONG ulGenerated = 0;
+
     do
     {
         xResult = PKCS11_SESSION_VALID_AND_MODULE_INITIALIZED( xSession );
@@ -3769,46 +4666,74 @@ CK_DEFINE_FUNCTION( CK_RV, C_GenerateRandom )( CK_SESSION_HANDLE xSession,
             xResult = CKR_ARGUMENTS_BAD;
             break;
         }
-        if (xBuferSwitcherLength < 8) 
+#if defined(OPTIGA_CRYPT_RANDOM_POOL_ENABLED) && (PKCS11_RANDOM_FROM_POOL == 1)
+        if ( ( CK_TRUE == pkcs11_context.random_pool_initialized ) && ( ulRandomLen <= OPTIGA_CRYPT_RANDOM_POOL_SIZE ) &&
+             ( OPTIGA_LIB_SUCCESS == optiga_crypt_random_pool_get( &pkcs11_context.random_pool,
+                                                                   pucRandomData,
+                                                                   ( uint16_t ) ulRandomLen ) ) )
         {
-            pxBufferSwitcher = xRandomBuf4SmallLengths;
-            xBuferSwitcherLength = 8;
+            break;
         }
+#endif
 
-        pal_os_lock_acquire(&optiga_mutex);
-
-        pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
-        xResult = optiga_crypt_random(pkcs11_context.object_list.optiga_crypt_instance,
-                                      OPTIGA_RNG_TYPE_TRNG,
-                                      pxBufferSwitcher,
-                                      xBuferSwitcherLength);
+        pxCrypt = pkcs11_crypt_acquire( session, &pxStatus );
 
-        if (OPTIGA_LIB_SUCCESS != xResult)
-        {
-            PKCS11_PRINT( ( "ERROR: Failed to generate a random value \r\n" ) );
-            xResult = CKR_SIGNATURE_INVALID;
-            break;
-        }
-        while (OPTIGA_LIB_BUSY == pkcs11_context.object_list.optiga_lib_status)
+        // Requests of any length are split into commands of the maximum length, which are executed back to back
+        // with the acquired instance and store the random data directly in the buffer of the caller
+        while ( ulGenerated < ulRandomLen )
         {
-        
-        }
+            pxBufferSwitcher = &pucRandomData[ ulGenerated ];
+            xBuferSwitcherLength = ulRandomLen - ulGenerated;
+            if ( xBuferSwitcherLength > PKCS11_RANDOM_LENGTH_MAX )
+            {
+                xBuferSwitcherLength = PKCS11_RANDOM_LENGTH_MAX;
+            }
+            else if ( xBuferSwitcherLength < PKCS11_RANDOM_LENGTH_MIN )
+            {
+                // The remaining bytes are generated together with the last bytes generated already,
+                // only requests less than the minimum length are truncated from a local buffer
+                pxBufferSwitcher = ( ulRandomLen < PKCS11_RANDOM_LENGTH_MIN ) ? xRandomBuf4SmallLengths :
+                                                                                &pucRandomData[ ulRandomLen - PKCS11_RANDOM_LENGTH_MIN ];
+                xBuferSwitcherLength = PKCS11_RANDOM_LENGTH_MIN;
+            }
 
-        // Either by timout or because of success it should end up here
-        if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
+            *pxStatus = OPTIGA_LIB_BUSY;
+            xResult = optiga_crypt_random(pxCrypt,
+                                          OPTIGA_RNG_TYPE_TRNG,
+                                          pxBufferSwitcher,
+                                          ( uint16_t ) xBuferSwitcherLength);
+
+            if (OPTIGA_LIB_SUCCESS != xResult)
+            {
+                PKCS11_PRINT( ( "ERROR: Failed to generate a random value \r\n" ) );
+                xResult = CKR_SIGNATURE_INVALID;
+                break;
+            }
+            pkcs11_crypt_wait( session, pxStatus );
+
+            // Either by timout or because of success it should end up here
+            if (OPTIGA_LIB_SUCCESS != *pxStatus)
+            {
+                PKCS11_PRINT( ( "ERROR: Failed to generate a random value \r\n" ) );
+                xResult = CKR_FUNCTION_FAILED;
+                break;
+            }
+            ulGenerated += xBuferSwitcherLength;
+        }
+        if ( CKR_OK != xResult )
         {
-            PKCS11_PRINT( ( "ERROR: Failed to generate a random value \r\n" ) );
-            xResult = CKR_FUNCTION_FAILED;
             break;
         }
-        pal_os_lock_release(&optiga_mutex);
+        pkcs11_crypt_release( session, pxCrypt );
+        pxCrypt = NULL;
 
-        if (pxBufferSwitcher == xRandomBuf4SmallLengths)
+        if ( ulRandomLen < PKCS11_RANDOM_LENGTH_MIN )
         {
             memcpy(pucRandomData, xRandomBuf4SmallLengths, ulRandomLen);
         }
-            
     }while(0);
+
+    pkcs11_crypt_release( session, pxCrypt );
     return xResult;
 }
 
@@ -3876,6 +4801,8 @@ CK_DEFINE_FUNCTION(CK_RV, C_Encrypt) ( CK_SESSION_HANDLE xSession,
                                        CK_BYTE_PTR pxEncryptedData,
                                        CK_ULONG_PTR pxulEncryptedDataLen ) 
 {
+    optiga_crypt_t * pxCrypt = NULL;
+    volatile optiga_lib_status_t * pxStatus = NULL;
 
     CK_RV xResult = CKR_OK;
     p_pkcs11_session_t session;
@@ -3929,10 +4856,7 @@ CK_DEFINE_FUNCTION(CK_RV, C_Encrypt) ( CK_SESSION_HANDLE xSession,
             break;
         }
         
-        while (OPTIGA_LIB_BUSY == pkcs11_context.object_list.optiga_lib_status)
-        {
-        
-        }
+        pkcs11_wait_for_completion(&pkcs11_context.object_list.optiga_lib_status, &pkcs11_context.object_list.optiga_wait);
     
         // Either by timout or because of success it should end up here
         if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
@@ -3943,13 +4867,13 @@ CK_DEFINE_FUNCTION(CK_RV, C_Encrypt) ( CK_SESSION_HANDLE xSession,
         }
         pal_os_lock_release(&optiga_mutex);
         
-        pal_os_lock_acquire(&optiga_mutex);
+        pxCrypt = pkcs11_crypt_acquire( session, &pxStatus );
         xPublicKeyDetails.public_key = temp;
         xPublicKeyDetails.length = tempLen;
         xPublicKeyDetails.key_type = key_type;
         
-        pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
-        xResult = optiga_crypt_rsa_encrypt_message(pkcs11_context.object_list.optiga_crypt_instance,
+        *pxStatus = OPTIGA_LIB_BUSY;
+        xResult = optiga_crypt_rsa_encrypt_message(pxCrypt,
                                                    OPTIGA_RSAES_PKCS1_V15,
                                                    pxData,
                                                    ulDataLen,
@@ -3967,21 +4891,21 @@ CK_DEFINE_FUNCTION(CK_RV, C_Encrypt) ( CK_SESSION_HANDLE xSession,
             break;
         }
         
-        while (OPTIGA_LIB_BUSY == pkcs11_context.object_list.optiga_lib_status)
-        {
-        
-        }
+        pkcs11_crypt_wait( session, pxStatus );
     
         // Either by timout or because of success it should end up here
-        if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
+        if (OPTIGA_LIB_SUCCESS != *pxStatus)
         {
             PKCS11_PRINT( ( "ERROR: Failed to encrypt value \r\n" ) );
             xResult = CKR_FUNCTION_FAILED;
             break;
         }
-        pal_os_lock_release(&optiga_mutex);
+        pkcs11_crypt_release( session, pxCrypt );
+        pxCrypt = NULL;
 
     } while (0);
+
+    pkcs11_crypt_release( session, pxCrypt );
     
     return xResult;
 
@@ -4067,6 +4991,8 @@ CK_DEFINE_FUNCTION(CK_RV, C_Decrypt) ( CK_SESSION_HANDLE xSession,
                                        CK_BYTE_PTR data, 
                                        CK_ULONG_PTR data_len) 
 {
+    optiga_crypt_t * pxCrypt = NULL;
+    volatile optiga_lib_status_t * pxStatus = NULL;
 
     CK_RV xResult = CKR_OK;
     p_pkcs11_session_t session;    
@@ -4096,10 +5022,10 @@ CK_DEFINE_FUNCTION(CK_RV, C_Decrypt) ( CK_SESSION_HANDLE xSession,
             break;
         }
 
-        pal_os_lock_acquire(&optiga_mutex);;
+        pxCrypt = pkcs11_crypt_acquire( session, &pxStatus );
         
-        pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
-        xResult = optiga_crypt_rsa_decrypt_and_export(pkcs11_context.object_list.optiga_crypt_instance,
+        *pxStatus = OPTIGA_LIB_BUSY;
+        xResult = optiga_crypt_rsa_decrypt_and_export(pxCrypt,
                                                       OPTIGA_RSAES_PKCS1_V15,
                                                       encrypted_data,
                                                       encrypted_data_len,
@@ -4116,21 +5042,21 @@ CK_DEFINE_FUNCTION(CK_RV, C_Decrypt) ( CK_SESSION_HANDLE xSession,
             break;
         }
         
-        while (OPTIGA_LIB_BUSY == pkcs11_context.object_list.optiga_lib_status)
-        {
-        
-        }
+        pkcs11_crypt_wait( session, pxStatus );
     
         // Either by timout or because of success it should end up here
-        if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
+        if (OPTIGA_LIB_SUCCESS != *pxStatus)
         {
             PKCS11_PRINT( ( "ERROR: Failed to decrypt value \r\n" ) );
             xResult = CKR_FUNCTION_FAILED;
             break;
         }
-        pal_os_lock_release(&optiga_mutex);
+        pkcs11_crypt_release( session, pxCrypt );
+        pxCrypt = NULL;
 
     } while (0);
+
+    pkcs11_crypt_release( session, pxCrypt );
     
     return xResult;    
 }
@@ -4154,6 +5080,10 @@ CK_DEFINE_FUNCTION(CK_RV, C_DecryptFinal) ( CK_SESSION_HANDLE xSession,
 CK_DEFINE_FUNCTION( CK_RV, C_DigestInit )( CK_SESSION_HANDLE xSession,
                                            CK_MECHANISM_PTR pMechanism )
 {
+#if (PKCS11_DIGEST_ON_HOST != 1)
+    optiga_crypt_t * pxCrypt = NULL;
+    volatile optiga_lib_status_t * pxStatus = NULL;
+#endif
     CK_RV xResult = PKCS11_SESSION_VALID_AND_MODULE_INITIALIZED(xSession);
     p_pkcs11_session_t session;
     
@@ -4177,11 +5107,20 @@ CK_DEFINE_FUNCTION( CK_RV, C_DigestInit )( CK_SESSION_HANDLE xSession,
         session->sha256_ctx.hash_ctx.context_buffer_length = sizeof(session->sha256_ctx.hash_ctx_buff);
         session->sha256_ctx.hash_ctx.hash_algo = OPTIGA_HASH_TYPE_SHA_256;
 
-        pal_os_lock_acquire(&optiga_mutex);
+#if (PKCS11_DIGEST_ON_HOST == 1)
+        if( PAL_STATUS_SUCCESS != pal_crypt_sha256_start( NULL,
+                                                          session->sha256_ctx.hash_ctx_buff,
+                                                          sizeof( session->sha256_ctx.hash_ctx_buff ) ) )
+        {
+            xResult = CKR_FUNCTION_FAILED;
+            break;
+        }
+#else
+        pxCrypt = pkcs11_crypt_acquire( session, &pxStatus );
 
         //Hash start
-        pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
-        xResult = optiga_crypt_hash_start( pkcs11_context.object_list.optiga_crypt_instance, 
+        *pxStatus = OPTIGA_LIB_BUSY;
+        xResult = optiga_crypt_hash_start( pxCrypt, 
                                            &session->sha256_ctx.hash_ctx);
 
         if (OPTIGA_LIB_SUCCESS != xResult)
@@ -4190,21 +5129,25 @@ CK_DEFINE_FUNCTION( CK_RV, C_DigestInit )( CK_SESSION_HANDLE xSession,
             break;
         }
 
-        while (OPTIGA_LIB_BUSY == pkcs11_context.object_list.optiga_lib_status)
-        {
-        }
+        pkcs11_crypt_wait( session, pxStatus );
 
         // Either by timout or because of success it should end up here
-        if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
+        if (OPTIGA_LIB_SUCCESS != *pxStatus)
         {
             xResult = CKR_FUNCTION_FAILED;
             break;
         }
-        session->operation_in_progress = pMechanism->mechanism;
 
-        pal_os_lock_release(&optiga_mutex);
+        pkcs11_crypt_release( session, pxCrypt );
+        pxCrypt = NULL;
+#endif
+        session->operation_in_progress = pMechanism->mechanism;
         
     }while(0);
+
+#if (PKCS11_DIGEST_ON_HOST != 1)
+    pkcs11_crypt_release( session, pxCrypt );
+#endif
     return xResult;
 }
 
@@ -4212,9 +5155,15 @@ CK_DEFINE_FUNCTION( CK_RV, C_DigestUpdate )( CK_SESSION_HANDLE xSession,
                                              CK_BYTE_PTR pPart,
                                              CK_ULONG ulPartLen )
 {
+#if (PKCS11_DIGEST_ON_HOST != 1)
+    optiga_crypt_t * pxCrypt = NULL;
+    volatile optiga_lib_status_t * pxStatus = NULL;
+#endif
     CK_RV xResult = PKCS11_SESSION_VALID_AND_MODULE_INITIALIZED(xSession);
     p_pkcs11_session_t session;
+#if (PKCS11_DIGEST_ON_HOST != 1)
     hash_data_from_host_t hash_data_host;
+#endif
     do
     {
         session = get_session_pointer( xSession );
@@ -4229,13 +5178,25 @@ CK_DEFINE_FUNCTION( CK_RV, C_DigestUpdate )( CK_SESSION_HANDLE xSession,
             break;
         }
 
+#if (PKCS11_DIGEST_ON_HOST == 1)
+        if( PAL_STATUS_SUCCESS != pal_crypt_sha256_update( NULL,
+                                                           session->sha256_ctx.hash_ctx_buff,
+                                                           sizeof( session->sha256_ctx.hash_ctx_buff ),
+                                                           pPart,
+                                                           ( uint32_t ) ulPartLen ) )
+        {
+            xResult = CKR_FUNCTION_FAILED;
+            session->operation_in_progress = pkcs11NO_OPERATION;
+            break;
+        }
+#else
         hash_data_host.buffer = pPart;
         hash_data_host.length = ulPartLen;
 
-        pal_os_lock_acquire(&optiga_mutex);
+        pxCrypt = pkcs11_crypt_acquire( session, &pxStatus );
 
-        pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
-        xResult = optiga_crypt_hash_update(pkcs11_context.object_list.optiga_crypt_instance,
+        *pxStatus = OPTIGA_LIB_BUSY;
+        xResult = optiga_crypt_hash_update(pxCrypt,
                                            &session->sha256_ctx.hash_ctx,
                                            OPTIGA_CRYPT_HOST_DATA,
                                            &hash_data_host);
@@ -4246,20 +5207,23 @@ CK_DEFINE_FUNCTION( CK_RV, C_DigestUpdate )( CK_SESSION_HANDLE xSession,
             break;
         }
 
-        while (OPTIGA_LIB_BUSY == pkcs11_context.object_list.optiga_lib_status)
-        {
-        }
+        pkcs11_crypt_wait( session, pxStatus );
 
         // Either by timout or because of success it should end up here
-        if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
+        if (OPTIGA_LIB_SUCCESS != *pxStatus)
         {
             xResult = CKR_FUNCTION_FAILED;
             session->operation_in_progress = pkcs11NO_OPERATION;
             break;
         }
 
-        pal_os_lock_release(&optiga_mutex);
+        pkcs11_crypt_release( session, pxCrypt );
+        pxCrypt = NULL;
+#endif
     }while(0);
+#if (PKCS11_DIGEST_ON_HOST != 1)
+    pkcs11_crypt_release( session, pxCrypt );
+#endif
     return xResult;
 }
 
@@ -4267,6 +5231,10 @@ CK_DEFINE_FUNCTION( CK_RV, C_DigestFinal )( CK_SESSION_HANDLE xSession,
                                             CK_BYTE_PTR pDigest,
                                             CK_ULONG_PTR pulDigestLen )
 {
+#if (PKCS11_DIGEST_ON_HOST != 1)
+    optiga_crypt_t * pxCrypt = NULL;
+    volatile optiga_lib_status_t * pxStatus = NULL;
+#endif
     CK_RV xResult = PKCS11_SESSION_VALID_AND_MODULE_INITIALIZED(xSession);
     p_pkcs11_session_t session;
 
@@ -4298,11 +5266,21 @@ CK_DEFINE_FUNCTION( CK_RV, C_DigestFinal )( CK_SESSION_HANDLE xSession,
                 xResult = CKR_BUFFER_TOO_SMALL;
                 break;
             }
-            pal_os_lock_acquire(&optiga_mutex);
+#if (PKCS11_DIGEST_ON_HOST == 1)
+            if( PAL_STATUS_SUCCESS != pal_crypt_sha256_finalize( NULL,
+                                                                 session->sha256_ctx.hash_ctx_buff,
+                                                                 sizeof( session->sha256_ctx.hash_ctx_buff ),
+                                                                 pDigest ) )
+            {
+                xResult = CKR_FUNCTION_FAILED;
+                break;
+            }
+#else
+            pxCrypt = pkcs11_crypt_acquire( session, &pxStatus );
 
             // hash finalize
-            pkcs11_context.object_list.optiga_lib_status = OPTIGA_LIB_BUSY;
-            xResult = optiga_crypt_hash_finalize( pkcs11_context.object_list.optiga_crypt_instance,
+            *pxStatus = OPTIGA_LIB_BUSY;
+            xResult = optiga_crypt_hash_finalize( pxCrypt,
                                                   &session->sha256_ctx.hash_ctx,
                                                   pDigest);
 
@@ -4312,24 +5290,66 @@ CK_DEFINE_FUNCTION( CK_RV, C_DigestFinal )( CK_SESSION_HANDLE xSession,
                 break;
             }
 
-            while (OPTIGA_LIB_BUSY == pkcs11_context.object_list.optiga_lib_status)
-            {
-            }
+            pkcs11_crypt_wait( session, pxStatus );
 
             // Either by timout or because of success it should end up here
-            if (OPTIGA_LIB_SUCCESS != pkcs11_context.object_list.optiga_lib_status)
+            if (OPTIGA_LIB_SUCCESS != *pxStatus)
             {
                 xResult = CKR_FUNCTION_FAILED;
                 break;
             }
 
-            pal_os_lock_release(&optiga_mutex);
+            pkcs11_crypt_release( session, pxCrypt );
+            pxCrypt = NULL;
+#endif
 
             session->operation_in_progress = pkcs11NO_OPERATION;
             
         }
     }while(0);
+#if (PKCS11_DIGEST_ON_HOST != 1)
+    pkcs11_crypt_release( session, pxCrypt );
+#endif
     return xResult;
 }
 
+/**
+ * @brief Legacy function for parallel execution. Operations of different sessions are executed concurrently,
+ * each C_* call of a session returns on completion.
+ */
+CK_DEFINE_FUNCTION( CK_RV, C_GetFunctionStatus )( CK_SESSION_HANDLE xSession )
+{
+    ( void ) xSession;
+
+    return CKR_FUNCTION_NOT_PARALLEL;
+}
+
+/**
+ * @brief Legacy function for parallel execution. See C_GetFunctionStatus.
+ */
+CK_DEFINE_FUNCTION( CK_RV, C_CancelFunction )( CK_SESSION_HANDLE xSession )
+{
+    ( void ) xSession;
+
+    return CKR_FUNCTION_NOT_PARALLEL;
+}
+
+/**
+ * @brief The slot of OPTIGA(TM) Trust M is fixed, there are no slot events.
+ */
+CK_DEFINE_FUNCTION( CK_RV, C_WaitForSlotEvent )( CK_FLAGS flags,
+                                                 CK_SLOT_ID_PTR pSlot,
+                                                 CK_VOID_PTR pReserved )
+{
+    CK_RV xResult = CKR_FUNCTION_NOT_SUPPORTED;
+
+    ( void ) pSlot;
+    ( void ) pReserved;
+
+    if( 0 != ( flags & CKF_DONT_BLOCK ) )
+    {
+        xResult = CKR_NO_EVENT;
+    }
 
+    return xResult;
+}
@@ -40,6 +40,8 @@
 #include "optiga/cmd/optiga_cmd.h"
 #include "optiga/common/optiga_lib_common_internal.h"
 #include "optiga/common/optiga_lib_logger.h"
+#include "optiga/common/optiga_lib_trace.h"
+#include "optiga/common/optiga_lib_profile.h"
 #include "optiga/comms/optiga_comms.h"
 #include "optiga/pal/pal_os_event.h"
 #include "optiga/pal/pal_os_lock.h"
@@ -95,11 +97,40 @@
 // Considering the size w.r.t maximum APDU size + shielded connection if enabled.
 #define OPTIGA_CMD_TOTAL_COMMS_BUFFER_SIZE               (OPTIGA_MAX_COMMS_BUFFER_SIZE + OPTIGA_COMMS_PRL_OVERHEAD)
 
+// Smallest communication buffer, which takes a hash chunk with the exported SHA256 context (209 bytes) in and out
+#define OPTIGA_CMD_MIN_COMMS_BUFFER_SIZE                 (0x00F0)
+#if (OPTIGA_MAX_COMMS_BUFFER_SIZE < OPTIGA_CMD_MIN_COMMS_BUFFER_SIZE)
+    #error "Unsupported value for OPTIGA_MAX_COMMS_BUFFER_SIZE"
+#endif
+
+#ifdef OPTIGA_CMD_DOUBLE_BUFFERED_APDU
+// One buffer is on the wire, while the next APDU is prepared in the other
+#define OPTIGA_CMD_NUMBER_OF_COMMS_BUFFERS               (0x02)
+#else
+#define OPTIGA_CMD_NUMBER_OF_COMMS_BUFFERS               (0x01)
+#endif //OPTIGA_CMD_DOUBLE_BUFFERED_APDU
+
+// Communication buffer including the room reserved for comms to frame the APDU in place
+#define OPTIGA_CMD_COMMS_BUFFER_STORAGE_SIZE             (OPTIGA_COMMS_TX_HEADROOM + OPTIGA_CMD_TOTAL_COMMS_BUFFER_SIZE + \
+                                                          OPTIGA_COMMS_TX_TAILROOM)
+
 #define OPTIGA_CMD_APDU_HEADER_SIZE                      (0x04)
 
 #define OPTIGA_CMD_LAST_ERROR_CODE                       (0xF1C2)
 
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+// Expected execution time in microseconds of a command, which is not listed in the default execution times
+#define OPTIGA_CMD_DEFAULT_EXECUTION_TIME_US             (5000U)
+// Weight of a longer measured execution time in the estimate, as right shift (1/8)
+#define OPTIGA_CMD_EXECUTION_TIME_INCREASE_SHIFT         (3U)
+// Weight of a shorter measured execution time in the estimate, as right shift (1/2)
+#define OPTIGA_CMD_EXECUTION_TIME_DECREASE_SHIFT         (1U)
+#endif
+
 #define OPTIGA_CMD_APDU_INDATA_OFFSET                    (OPTIGA_CMD_APDU_HEADER_SIZE + OPTIGA_COMMS_DATA_OFFSET)
+// Maximum data written in one set data command (oid 2 bytes + offset 2 bytes precede the data)
+#define OPTIGA_CMD_SET_DATA_MAX_CHUNK_SIZE               (OPTIGA_MAX_COMMS_BUFFER_SIZE + OPTIGA_COMMS_DATA_OFFSET - \
+                                                          OPTIGA_CMD_APDU_INDATA_OFFSET - (2 * OPTIGA_CMD_UINT16_SIZE_IN_BYTES))
 // Hash header size(hash_input_header_size + context_header_size)
 #define OPTIGA_CMD_HASH_HEADER_SIZE                      (0x06)
 // Intermediate context header size
@@ -209,7 +240,17 @@
 #define OPTIGA_CMD_ENC_DEC_SYM_OUT_DATA_TAG                     (0x61)
 
 #define OPTIGA_CMD_RESET_SEQUENCE                               (0xFF)
-#define OPTIGA_CMD_SYM_MAX_INDATA_LENGTH                        (640U)
+// Maximum in data of a symmetric command supported by OPTIGA
+#define OPTIGA_CMD_SYM_OPTIGA_MAX_INDATA_LENGTH                 (640U)
+// Maximum in data of a symmetric command, which fits in the communication buffer. The room for the MAC is kept, since
+// the response of the final sequence carries the MAC in addition to the out data
+#define OPTIGA_CMD_SYM_COMMS_MAX_INDATA_LENGTH                  (OPTIGA_MAX_COMMS_BUFFER_SIZE - \
+                                                                 OPTIGA_CMD_APDU_HEADER_SIZE - 0x10)
+#if (OPTIGA_CMD_SYM_COMMS_MAX_INDATA_LENGTH < OPTIGA_CMD_SYM_OPTIGA_MAX_INDATA_LENGTH)
+#define OPTIGA_CMD_SYM_MAX_INDATA_LENGTH                        (OPTIGA_CMD_SYM_COMMS_MAX_INDATA_LENGTH)
+#else
+#define OPTIGA_CMD_SYM_MAX_INDATA_LENGTH                        (OPTIGA_CMD_SYM_OPTIGA_MAX_INDATA_LENGTH)
+#endif
 
 // Session OID length in case of HMAC verify
 #define OPTIGA_CMD_DECRYPT_SYM_SESSION_OID_LENGTH               (0x0002)
@@ -224,7 +265,7 @@
 #define OPTIGA_CMD_SET_OBJECT_PROTECTED_TAG                     (0x30)
 
 /// Supported instance number 
-#define OPTIGA_CMD_MAX_INSTANCE_ID                              (0x00)
+#define OPTIGA_CMD_MAX_INSTANCE_ID                              (OPTIGA_MAX_NUMBER_OF_INSTANCES - 1)
 
 #define OPTIGA_CMD_TAG_LENGTH_SIZE                              (0x03)
 #define OPTIGA_CMD_PARAM_INITIALIZE_APP_CONTEXT                 (0x00)
@@ -313,6 +354,38 @@
 
 // Get APDU info value from apdu_data
 #define OPTIGA_CMD_GET_APDU_INFO(apdu_data) ((uint8_t)(apdu_data >> OPTIGA_CMD_NO_OF_BITS_IN_BYTE))
+
+#ifdef OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+// Status of a continue or final invoked without the strict lock, which tells a revoked strict lock apart
+#define OPTIGA_CMD_STRICT_LOCK_LOST_STATUS(me) \
+    ((TRUE == (me)->strict_lock_revoked) ? OPTIGA_CMD_ERROR_STRICT_LOCK_REVOKED : OPTIGA_CMD_ERROR_INVALID_INPUT)
+#else
+// Status of a continue or final invoked without the strict lock
+#define OPTIGA_CMD_STRICT_LOCK_LOST_STATUS(me) (OPTIGA_CMD_ERROR_INVALID_INPUT)
+#endif //OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+
+#ifdef OPTIGA_CMD_FAIR_SHARE_ENABLED
+// Scale of the virtual time of the tenants (OPTIGA time in microseconds shifted left), to keep the precision of large weights
+#define OPTIGA_CMD_FAIR_SHARE_VIRTUAL_TIME_SHIFT        (4U)
+// Maximum OPTIGA time in microseconds charged for an APDU, which keeps the virtual times comparable as difference
+#define OPTIGA_CMD_FAIR_SHARE_MAX_CHARGE_US             (0x00FFFFFFU)
+// Weight of a tenant, with the default weight if none is set
+#define OPTIGA_CMD_FAIR_SHARE_WEIGHT(p_optiga, tenant) \
+    ((0 == (p_optiga)->tenant_stats[(tenant)].weight) ? OPTIGA_CMD_FAIR_SHARE_DEFAULT_WEIGHT : (p_optiga)->tenant_stats[(tenant)].weight)
+#endif //OPTIGA_CMD_FAIR_SHARE_ENABLED
+
+#ifdef OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+// Service time in microseconds of a request, which is assumed till the first request is measured
+#define OPTIGA_CMD_ADMISSION_DEFAULT_SERVICE_TIME_US    (10000U)
+// Weight of a measured service time in the average, as right shift (1/8)
+#define OPTIGA_CMD_ADMISSION_SERVICE_TIME_SHIFT         (3U)
+#endif //OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+
+#ifdef OPTIGA_CMD_HEALTH_MONITOR_ENABLED
+// Reset types of optiga_comms_reset, which are used to recover OPTIGA
+#define OPTIGA_CMD_RECOVERY_SOFT_RESET      (0x01)
+#define OPTIGA_CMD_RECOVERY_WARM_RESET      (0x02)
+#endif //OPTIGA_CMD_HEALTH_MONITOR_ENABLED
 #if defined (OPTIGA_CRYPT_SYM_ENCRYPT_ENABLED) || defined (OPTIGA_CRYPT_SYM_DECRYPT_ENABLED) || \
 defined (OPTIGA_CRYPT_HMAC_ENABLED) || defined (OPTIGA_CRYPT_HMAC_VERIFY_ENABLED) || defined (OPTIGA_CRYPT_CLEAR_AUTO_STATE_ENABLED)
 // Check if mode is MAC based
@@ -342,6 +415,10 @@ defined (OPTIGA_CRYPT_HMAC_ENABLED) || defined (OPTIGA_CRYPT_HMAC_VERIFY_ENABLED
 //Session not assigned to optiga cmd instance
 #define     OPTIGA_CMD_NO_SESSION_OID               (0x0000)
 #define     OPTIGA_CMD_ALL_SESSION_ASSIGNED         (0x10101010)
+#ifdef OPTIGA_CMD_SESSION_POOL_ENABLED
+//No lease of a session is pending expiry
+#define     OPTIGA_CMD_SESSION_NO_LEASE             (0xFFFFFFFFU)
+#endif //OPTIGA_CMD_SESSION_POOL_ENABLED
 
 // Optiga slot request types
 #define     OPTIGA_CMD_QUEUE_REQUEST_LOCK           (0x21)
@@ -353,10 +430,121 @@ defined (OPTIGA_CRYPT_HMAC_ENABLED) || defined (OPTIGA_CRYPT_HMAC_VERIFY_ENABLED
 #define     OPTIGA_CMD_QUEUE_SLOT_STATE             (0x09)
 // Type of lock, Do not change the values
 #define     OPTIGA_CMD_QUEUE_SLOT_LOCK_TYPE         (0x08)
+// Number of slot states and request types tracked by the queue counters
+#define     OPTIGA_CMD_QUEUE_NUMBER_OF_STATES       (0x05)
+#define     OPTIGA_CMD_QUEUE_NUMBER_OF_REQUESTS     (0x04)
+// Invalid slot index, marks end of a ready list
+#define     OPTIGA_CMD_QUEUE_INVALID_INDEX          (0xFF)
+
+#if (OPTIGA_CMD_MAX_REGISTRATIONS >= OPTIGA_CMD_QUEUE_INVALID_INDEX)
+#error "OPTIGA_CMD_MAX_REGISTRATIONS must be less than 255"
+#endif
+// Maximum number of slots in a caller supplied registry
+#define     OPTIGA_CMD_QUEUE_MAX_REGISTRY_SIZE      (OPTIGA_CMD_QUEUE_INVALID_INDEX - 1)
 // Frequency of scheduler polling when no asynchronous requests are pending
 #define     OPTIGA_CMD_SCHEDULER_IDLING_TIME_MS     (1000U)
 // Frequency of scheduler polling when asynchronous requests is being processed
 #define     OPTIGA_CMD_SCHEDULER_RUNNING_TIME_MS    (50U)
+#ifdef OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+// Delay of scheduler wakeup when a request is posted or a lock is released
+#define     OPTIGA_CMD_SCHEDULER_WAKEUP_TIME_MS     (1U)
+// Delay of dispatching the selected optiga cmd instance
+#define     OPTIGA_CMD_SCHEDULER_DISPATCH_TIME_MS   (OPTIGA_CMD_SCHEDULER_WAKEUP_TIME_MS)
+#else
+// Delay of dispatching the selected optiga cmd instance
+#define     OPTIGA_CMD_SCHEDULER_DISPATCH_TIME_MS   (OPTIGA_CMD_SCHEDULER_RUNNING_TIME_MS)
+#endif //OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+
+#ifdef OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+// Application on OPTIGA is not opened or closed
+#define     OPTIGA_CMD_APP_STATE_CLOSED             (0x00)
+// Application on OPTIGA is opened
+#define     OPTIGA_CMD_APP_STATE_OPEN               (0x01)
+// Application on OPTIGA is hibernated by the scheduler
+#define     OPTIGA_CMD_APP_STATE_HIBERNATED         (0x02)
+
+// No auto hibernate operation is ongoing
+#define     OPTIGA_CMD_AUTO_HIBERNATE_IDLE          (0x00)
+// Application is being hibernated
+#define     OPTIGA_CMD_AUTO_HIBERNATE_HIBERNATING   (0x01)
+// Application is being restored
+#define     OPTIGA_CMD_AUTO_HIBERNATE_RESTORING     (0x02)
+// Clean application context is being opened, after the restore failed
+#define     OPTIGA_CMD_AUTO_HIBERNATE_REOPENING     (0x03)
+#ifdef OPTIGA_CMD_LAZY_OPEN_ENABLED
+// Application is being opened on demand, for a request of the caller or the pre-open
+#define     OPTIGA_CMD_AUTO_HIBERNATE_OPENING       (0x04)
+#endif //OPTIGA_CMD_LAZY_OPEN_ENABLED
+#ifdef OPTIGA_CMD_PERFORMANCE_GOVERNOR_ENABLED
+// Current limitation is being written by the performance governor
+#define     OPTIGA_CMD_AUTO_HIBERNATE_SETTING_CURRENT   (0x05)
+// Current limitation data object
+#define     OPTIGA_CMD_CURRENT_LIMITATION_OID       (0xE0C4)
+// Param of the set data object command to erase and write the data object
+#define     OPTIGA_CMD_SET_DATA_ERASE_AND_WRITE     (0x40)
+#endif //OPTIGA_CMD_PERFORMANCE_GOVERNOR_ENABLED
+#ifdef OPTIGA_CMD_SEC_PACING_ENABLED
+// Security event counter is being read for the SEC pacing
+#define     OPTIGA_CMD_AUTO_HIBERNATE_READING_SEC   (0x06)
+// Security event counter data object
+#define     OPTIGA_CMD_SECURITY_EVENT_COUNTER_OID   (0xE0C5)
+// Maximum value of the security event counter
+#define     OPTIGA_CMD_SECURITY_EVENT_COUNTER_MAX   (0xFF)
+#endif //OPTIGA_CMD_SEC_PACING_ENABLED
+#endif //OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+// OPTIGA is powered off or its state is unknown
+#define     OPTIGA_CMD_ENERGY_STATE_OFF             (0x00)
+// OPTIGA is reset and the application is open
+#define     OPTIGA_CMD_ENERGY_STATE_AWAKE           (0x01)
+// Application context of OPTIGA is saved and OPTIGA is powered off
+#define     OPTIGA_CMD_ENERGY_STATE_HIBERNATED      (0x02)
+#endif //OPTIGA_LIB_STATISTICS_ENABLED
+
+#ifdef OPTIGA_UTIL_READ_CACHE_ENABLED
+// Entry of the read cache is not used
+#define     OPTIGA_CMD_READ_CACHE_FREE              (0x00)
+// Data object is registered, but its data is not cached
+#define     OPTIGA_CMD_READ_CACHE_REGISTERED        (0x01)
+// Data of the data object is cached
+#define     OPTIGA_CMD_READ_CACHE_VALID             (0x02)
+// Invalidates all the entries of the read cache
+#define     OPTIGA_CMD_READ_CACHE_ALL_OIDS          (0x0000)
+#endif //OPTIGA_UTIL_READ_CACHE_ENABLED
+
+#ifdef OPTIGA_UTIL_METADATA_CACHE_ENABLED
+// Metadata is read using GetDataObject with this param
+#define     OPTIGA_CMD_READ_METADATA                (0x01)
+// Metadata constructed tag
+#define     OPTIGA_CMD_METADATA_TAG                 (0x20)
+// Life cycle state tag
+#define     OPTIGA_CMD_METADATA_TAG_LCSO            (0xC0)
+// Maximum size tag
+#define     OPTIGA_CMD_METADATA_TAG_MAX_SIZE        (0xC4)
+// Used size tag
+#define     OPTIGA_CMD_METADATA_TAG_USED_SIZE       (0xC5)
+// Change access condition tag
+#define     OPTIGA_CMD_METADATA_TAG_CHANGE_AC       (0xD0)
+// Read access condition tag
+#define     OPTIGA_CMD_METADATA_TAG_READ_AC         (0xD1)
+// Execute access condition tag
+#define     OPTIGA_CMD_METADATA_TAG_EXECUTE_AC      (0xD3)
+// Data object type tag
+#define     OPTIGA_CMD_METADATA_TAG_DATA_TYPE       (0xE8)
+// Invalidates all the entries of the metadata cache
+#define     OPTIGA_CMD_METADATA_CACHE_ALL_OIDS      (0x0000)
+#endif //OPTIGA_UTIL_METADATA_CACHE_ENABLED
+
+#ifdef OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+// Drops all the entries of the verification cache
+#define     OPTIGA_CMD_VERIFY_CACHE_ALL_OIDS        (0x0000)
+#endif //OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+
+#ifdef OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
+// Weight of a measured time in the average cost, as right shift (1/8)
+#define     OPTIGA_CMD_OFFLOAD_COST_SHIFT           (3U)
+#endif //OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
 
 /** \brief The enum represents diffrent main state of command handler */
 typedef enum optiga_cmd_state
@@ -365,7 +553,8 @@ typedef enum optiga_cmd_state
     OPTIGA_CMD_EXEC_COMMS_CLOSE,
     OPTIGA_CMD_EXEC_PREPARE_COMMAND,
     OPTIGA_CMD_EXEC_PROCESS_RESPONSE,
-    OPTIGA_CMD_EXEC_ERROR_HANDLER
+    OPTIGA_CMD_EXEC_ERROR_HANDLER,
+    OPTIGA_CMD_EXEC_RECOVERY
 } optiga_cmd_state_t;
 
 /** \brief The enum represents diffrent sub state of command handler */
@@ -388,25 +577,185 @@ typedef enum optiga_cmd_sub_state
     OPTIGA_CMD_EXEC_GET_DEVICE_ERROR,
     OPTIGA_CMD_EXEC_RELEASE_LOCK,
     OPTIGA_CMD_EXEC_RELEASE_SESSION,
-    OPTIGA_CMD_STATE_EXIT
+    OPTIGA_CMD_STATE_EXIT,
+
+    OPTIGA_CMD_EXEC_RECOVERY_START,
+    OPTIGA_CMD_EXEC_RECOVERY_SOFT_RESET,
+    OPTIGA_CMD_EXEC_RECOVERY_SOFT_RESET_DONE,
+    OPTIGA_CMD_EXEC_RECOVERY_WARM_RESET,
+    OPTIGA_CMD_EXEC_RECOVERY_WARM_RESET_DONE,
+    OPTIGA_CMD_EXEC_RECOVERY_OPEN_APPLICATION,
+    OPTIGA_CMD_EXEC_RECOVERY_OPEN_APPLICATION_DONE,
+    OPTIGA_CMD_EXEC_RECOVERY_FAILED
 
 } optiga_cmd_sub_state_t;
 
 typedef optiga_lib_status_t (*optiga_cmd_handler_t)(optiga_cmd_t * me);
 
-/** \brief The structure represents the slot in the execution queue */
-typedef struct optiga_cmd_queue_slot
+#if defined (OPTIGA_CRYPT_ECDSA_SIGN_ENABLED) || defined (OPTIGA_CRYPT_RSA_SIGN_ENABLED) || \
+    defined (OPTIGA_CRYPT_ECDH_ENABLED) || defined (OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED) || \
+    defined (OPTIGA_CRYPT_RSA_GENERATE_KEYPAIR_ENABLED) || defined (OPTIGA_CRYPT_SYM_GENERATE_KEY_ENABLED)
+#define OPTIGA_CMD_DESCRIPTOR_ENCODING
+/// Value of the field is copied from a buffer, the length of the buffer is the length of the field
+#define OPTIGA_CMD_FIELD_BUFFER                                  (0x00)
+/// Value of the field is a 2 byte big endian value (e.g. OID)
+#define OPTIGA_CMD_FIELD_UINT16                                  (0x01)
+/// Value of the field is a single byte (e.g. key usage, algorithm identifier)
+#define OPTIGA_CMD_FIELD_UINT8                                   (0x02)
+/// Field has no value, only the tag and a zero length are sent (e.g. export request)
+#define OPTIGA_CMD_FIELD_EMPTY                                   (0x03)
+
+/** \brief Layout of a TLV field of the command data */
+typedef struct optiga_cmd_field_descriptor
 {
-    /// Registered context
-    void * registered_ctx;
-    /// Arrival time of the optiga cmd instance in the execution queue
-    uint32_t arrival_time;
-    /// Request for command lock or session
-    uint8_t request_type;
-    /// state of the slot
-    uint8_t state_of_entry;
-}optiga_cmd_queue_slot_t;
+    /// Tag of the field
+    uint8_t tag;
+    /// Type of the field value, one of OPTIGA_CMD_FIELD_*
+    uint8_t type;
+} optiga_cmd_field_descriptor_t;
+
+/** \brief Constant layout of a command, interpreted by the shared APDU encoder */
+typedef struct optiga_cmd_descriptor
+{
+    /// Command code
+    uint8_t command_code;
+    /// Number of the TLV fields of the command data
+    uint8_t field_count;
+    /// Fields of the command data, in the order sent to OPTIGA
+    const optiga_cmd_field_descriptor_t * p_fields;
+} optiga_cmd_descriptor_t;
+
+/** \brief Runtime value of a field, one per field of the descriptor */
+typedef struct optiga_cmd_field_value
+{
+    /// Buffer of an #OPTIGA_CMD_FIELD_BUFFER field
+    const uint8_t * p_buffer;
+    /// Length of an #OPTIGA_CMD_FIELD_BUFFER field, otherwise the value of the field
+    uint16_t value;
+} optiga_cmd_field_value_t;
+#endif //OPTIGA_CMD_DESCRIPTOR_ENCODING
+
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+/** \brief Execution time of a command on OPTIGA */
+typedef struct optiga_cmd_execution_time
+{
+    /// Command code, without #OPTIGA_CMD_CLEAR_LAST_ERROR
+    uint8_t cmd;
+    /// Command parameter (e.g. algorithm or signature scheme), which influences the execution time
+    uint8_t param;
+    /// Execution time in microseconds, 0 if the entry is not used
+    uint32_t time_us;
+} optiga_cmd_execution_time_t;
+
+/*
+* Default execution times of the commands, which are refined at runtime with the measured execution times
+*/
+_STATIC_H const optiga_cmd_execution_time_t optiga_cmd_default_execution_time[] =
+{
+    {0x01, 0x00, 2000U},       // GetDataObject
+    {0x02, 0x00, 15000U},      // SetDataObject
+    {0x03, 0x00, 25000U},      // SetObjectProtected
+    {0x0C, 0x00, 3000U},       // GetRandom
+    {0x14, 0x00, 5000U},       // EncryptSym
+    {0x15, 0x00, 5000U},       // DecryptSym
+    {0x1E, 0x00, 40000U},      // EncryptAsym
+    {0x1F, 0x00, 200000U},     // DecryptAsym
+    {0x30, 0x00, 2000U},       // CalcHash
+    {0x31, 0x00, 60000U},      // CalcSign
+    {0x32, 0x00, 80000U},      // VerifySign
+    {0x33, 0x00, 60000U},      // CalcSSec
+    {0x34, 0x00, 10000U},      // DeriveKey
+    {0x38, 0x00, 60000U},      // GenKeyPair
+    {0x39, 0x00, 5000U},       // GenSymKey
+    {0x70, 0x00, 10000U},      // OpenApplication
+    {0x71, 0x00, 10000U}       // CloseApplication
+};
+#endif
+
+#ifdef OPTIGA_UTIL_READ_CACHE_ENABLED
+/** \brief Entry of the read cache, which holds the data of one data object */
+typedef struct optiga_cmd_read_cache_entry
+{
+    /// Data of the data object, from offset 0
+    uint8_t data[OPTIGA_UTIL_READ_CACHE_MAX_OBJECT_SIZE];
+    /// Data object identifier
+    uint16_t oid;
+    /// Number of bytes cached
+    uint16_t length;
+    /// State of the entry (free, registered or valid)
+    uint8_t state;
+    /// Indicates the complete data object is cached, otherwise only the first length bytes are cached
+    uint8_t complete;
+    /// Indicates the data object is read, once the application is opened
+    uint8_t preload;
+#ifdef OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+    /// Generation of the shared segment, when the data object was read (Refer optiga_cmd_read_cache_shared_t)
+    uint32_t generation;
+#endif //OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+} optiga_cmd_read_cache_entry_t;
+
+#ifdef OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+/** \brief Entry of the shared segment of the read cache */
+typedef struct optiga_cmd_read_cache_shared_entry
+{
+    /// Data of the data object, from offset 0
+    uint8_t data[OPTIGA_UTIL_READ_CACHE_MAX_OBJECT_SIZE];
+    /// Generation of the segment, when the data object was read. The data is valid only in the same generation
+    uint32_t generation;
+    /// Data object identifier
+    uint16_t oid;
+    /// Number of bytes cached
+    uint16_t length;
+    /// OPTIGA instance, the data object is read from
+    uint8_t instance;
+    /// Indicates the complete data object is cached, otherwise only the first length bytes are cached
+    uint8_t complete;
+    /// Indicates the entry is used
+    uint8_t used;
+} optiga_cmd_read_cache_shared_entry_t;
+
+/** \brief Segment of the read cache, which is shared by the processes using the same OPTIGA (zero filled on creation) */
+typedef struct optiga_cmd_read_cache_shared
+{
+    /// Generation, incremented by every write to a data object of any process
+    uint32_t generation;
+    /// Entry to be replaced next, once all the entries hold valid data
+    uint8_t next_index;
+    /// Data objects cached by all the processes
+    optiga_cmd_read_cache_shared_entry_t entries[OPTIGA_UTIL_READ_CACHE_SHARED_SIZE];
+} optiga_cmd_read_cache_shared_t;
+#endif //OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+#endif
+
+#ifdef OPTIGA_UTIL_METADATA_CACHE_ENABLED
+/** \brief Entry of the metadata cache, which holds the parsed metadata of one object */
+typedef struct optiga_cmd_metadata_cache_entry
+{
+    /// Parsed metadata
+    optiga_lib_metadata_info_t info;
+    /// Object identifier
+    uint16_t oid;
+    /// Indicates the entry holds the metadata of the object
+    uint8_t valid;
+} optiga_cmd_metadata_cache_entry_t;
+#endif
 
+#ifdef OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+/** \brief Entry of the verification cache, which holds the digest of one successful verification */
+typedef struct optiga_cmd_verify_cache_entry
+{
+    /// Digest of the public key, digest and signature of the verification
+    uint8_t key[OPTIGA_CMD_VERIFY_CACHE_KEY_LENGTH];
+    /// Time in milliseconds, at which the entry is added
+    uint32_t insert_time;
+    /// Time in milliseconds, for which the entry is valid
+    uint32_t ttl;
+    /// Certificate object holding the public key, 0x0000 if the public key is from host
+    uint16_t oid;
+    /// Indicates the entry holds a verification
+    uint8_t valid;
+} optiga_cmd_verify_cache_entry_t;
+#endif
 
 /**
 * \brief OPTIGA Context which holds the communication buffer, comms instance and other required.
@@ -424,32 +773,368 @@ struct optiga_context
     uint8_t sessions[OPTIGA_CMD_MAX_NUMBER_OF_SESSIONS];
     /// Indicates if instance is initialized
     uint8_t instance_init_state;
-    /// Communication buffer to send/receive APDUs.
-    uint8_t optiga_comms_buffer[OPTIGA_CMD_TOTAL_COMMS_BUFFER_SIZE];
-    /// optiga execution queue
-    optiga_cmd_queue_slot_t optiga_cmd_execution_queue[OPTIGA_CMD_MAX_REGISTRATIONS];
+    /// Communication buffers to send/receive APDUs, with the room reserved for comms
+    uint8_t optiga_comms_buffer_list[OPTIGA_CMD_NUMBER_OF_COMMS_BUFFERS][OPTIGA_CMD_COMMS_BUFFER_STORAGE_SIZE];
+    /// Communication buffer of the command being executed
+    uint8_t * optiga_comms_buffer;
+#ifdef OPTIGA_CMD_DOUBLE_BUFFERED_APDU
+    /// Instance, whose APDU is already prepared in the other communication buffer
+    optiga_cmd_t * p_prepared_ctx;
+    /// Communication buffer holding the prepared APDU
+    uint8_t * p_prepared_buffer;
+    /// Size of the prepared APDU
+    uint16_t prepared_tx_size;
+    /// Chaining status of the prepared APDU
+    uint8_t prepared_chaining_ongoing;
+#endif //OPTIGA_CMD_DOUBLE_BUFFERED_APDU
+    /// optiga execution queue (instance registry)
+    optiga_cmd_queue_slot_t * optiga_cmd_execution_queue;
+    /// Number of slots in the execution queue
+    uint8_t queue_size;
+    /// Number of slots in each state
+    uint8_t queue_state_count[OPTIGA_CMD_QUEUE_NUMBER_OF_STATES];
+    /// Number of slots with each request type
+    uint8_t queue_request_type_count[OPTIGA_CMD_QUEUE_NUMBER_OF_REQUESTS];
+    /// First slot (earliest arrival) in requested state of each priority class
+    uint8_t queue_ready_head[OPTIGA_LIB_NUMBER_OF_PRIORITIES];
+    /// Last slot (latest arrival) in requested state of each priority class
+    uint8_t queue_ready_tail[OPTIGA_LIB_NUMBER_OF_PRIORITIES];
+    /// Slot in resume state (strict lock)
+    uint8_t queue_resume_index;
+#ifdef OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+    /// Maximum time in microseconds between two steps of a strict lock holder, while requests wait (0 if not bounded)
+    uint32_t strict_lock_max_hold_us;
+    /// Time in microseconds, at which the strict lock holder has completed its last step
+    uint32_t strict_lock_step_time;
+    /// Remaining time in microseconds till the strict lock is revoked, 0 if none is pending
+    uint32_t strict_lock_time_left_us;
+#endif //OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+#ifdef OPTIGA_CMD_FAIR_SHARE_ENABLED
+    /// Weight and consumed OPTIGA time of each tenant, the weight is 0 if not set
+    optiga_lib_tenant_stats_t tenant_stats[OPTIGA_CMD_FAIR_SHARE_MAX_TENANTS];
+    /// Virtual time of each tenant, the consumed OPTIGA time relative to its weight
+    uint32_t tenant_virtual_time[OPTIGA_CMD_FAIR_SHARE_MAX_TENANTS];
+    /// Number of requests of each tenant waiting in requested state
+    uint8_t tenant_waiting_count[OPTIGA_CMD_FAIR_SHARE_MAX_TENANTS];
+    /// Virtual time of the last dispatched request, from which a tenant is accounted once it is idle
+    uint32_t fair_share_virtual_time;
+    /// Time in microseconds, at which the command in execution is passed to comms
+    uint32_t fair_share_start_time;
+#endif //OPTIGA_CMD_FAIR_SHARE_ENABLED
+#ifdef OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+    /// Average time in microseconds a request is served, 0 till the first request is measured
+    uint32_t service_time_us;
+    /// Number of operations, which were not admitted
+    uint32_t admission_rejected_requests;
+    /// Callback, which is invoked on crossing of the watermarks, NULL if none is set
+    optiga_lib_queue_watermark_callback_t watermark_callback;
+    /// Context of the watermark callback
+    void * watermark_context;
+    /// Number of waiting requests, on which the watermark callback reports the high load
+    uint8_t watermark_high;
+    /// Number of waiting requests, on which the watermark callback reports the normal load again
+    uint8_t watermark_low;
+    /// Indicates the high watermark is reached and the low watermark is not reached since
+    bool_t watermark_reached;
+#endif //OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+    /// Latest submitted slot of the submission queue, updated by the requesters
+    optiga_cmd_queue_slot_t * volatile submission_tail;
+    /// Oldest submitted slot of the submission queue, consumed by the scheduler only
+    optiga_cmd_queue_slot_t * submission_head;
+    /// Placeholder slot, which keeps the submission queue linked when it is empty
+    optiga_cmd_queue_slot_t submission_stub;
     /// pal os event instance/context
     pal_os_event_t * p_pal_os_event_ctx;
-    /// Last processed cmd time stamp
-    uint32_t last_time_stamp;
+    /// Waiting time statistics of each priority class in the execution queue
+    optiga_lib_queue_wait_stats_t queue_wait_stats[OPTIGA_LIB_NUMBER_OF_PRIORITIES];
     /// optiga context handle buffer
     uint8_t optiga_context_handle_buffer[APP_CONTEXT_SIZE];
 #ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
     /// Protection level status flag
     uint8_t protection_level_state;
+#ifdef OPTIGA_COMMS_PROTECTION_POLICY_ENABLED
+    /// Protection policy table supplied by the caller
+    const optiga_protection_policy_t * p_protection_policy;
+    /// Number of entries in the protection policy table
+    uint8_t protection_policy_count;
+#endif //OPTIGA_COMMS_PROTECTION_POLICY_ENABLED
+#ifdef OPTIGA_COMMS_KEY_ROLLOVER_ENABLED
+    /// Indicates a session key rollover is ongoing, the scheduler is resumed on its completion
+    uint8_t key_rollover_ongoing;
+#endif //OPTIGA_COMMS_KEY_ROLLOVER_ENABLED
 #endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+#ifdef OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+    /// Indicates scheduler is idle and waits for a wakeup
+    volatile uint8_t scheduler_parked;
+#endif //OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+    /// Estimated execution times of the recently executed commands of this OPTIGA instance
+    optiga_cmd_execution_time_t execution_time_cache[OPTIGA_CMD_EXECUTION_TIME_CACHE_SIZE];
+    /// Entry of the execution time cache, which is replaced next
+    uint8_t execution_time_replace_index;
+    /// Entry of the execution time cache of the command in execution
+    uint8_t execution_time_index;
+    /// Indicates the execution time of the command in execution is awaited from comms
+    uint8_t execution_time_pending;
+#endif //OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+#ifdef OPTIGA_LIB_FAST_RESUME_ENABLED
+    /// Latency statistics of the application restore
+    optiga_lib_resume_stats_t resume_stats;
+    /// Time in microseconds, at which the communication is started for the ongoing restore
+    uint32_t resume_start_time;
+    /// Time in microseconds, which is spent in the communication open of the ongoing restore
+    uint32_t resume_comms_open_time;
+    /// Indicates a restore of the application is ongoing
+    uint8_t resume_ongoing;
+#endif //OPTIGA_LIB_FAST_RESUME_ENABLED
+#ifdef OPTIGA_CMD_HEALTH_MONITOR_ENABLED
+    /// Statistics of the recovery from communication failures
+    optiga_lib_health_stats_t health_stats;
+    /// Time in microseconds, at which the ongoing recovery is started
+    uint32_t recovery_start_time;
+#endif //OPTIGA_CMD_HEALTH_MONITOR_ENABLED
+#ifdef OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+    /// Internal instance, which hibernates and restores the application
+    optiga_cmd_t * p_auto_hibernate_cmd;
+    /// Statistics of the auto hibernate, which also holds the idle time
+    optiga_lib_auto_hibernate_stats_t auto_hibernate_stats;
+    /// Time in microseconds, at which the last request released the lock
+    uint32_t last_activity_time;
+    /// Time in microseconds, at which the ongoing restore is started
+    uint32_t auto_restore_start_time;
+    /// Remaining time in microseconds till the hibernate or the next decision of the performance governor, 0 if none is pending
+    uint32_t auto_hibernate_time_left_us;
+    /// State of the application on OPTIGA
+    uint8_t app_state;
+    /// Auto hibernate operation, which is ongoing
+    uint8_t auto_hibernate_state;
+#ifdef OPTIGA_CMD_LAZY_OPEN_ENABLED
+    /// TRUE, if the closed application is opened on the first request
+    bool_t lazy_open_enabled;
+    /// TRUE, if the application is to be opened without waiting for a request
+    bool_t lazy_pre_open;
+    /// TRUE, if the last lazy open failed. The open is tried again, once the queued requests are served.
+    bool_t lazy_open_failed;
+#endif //OPTIGA_CMD_LAZY_OPEN_ENABLED
+#ifdef OPTIGA_CMD_PERFORMANCE_GOVERNOR_ENABLED
+    /// Policy of the performance governor, burst_current_limit is 0 if the governor is disabled
+    optiga_lib_performance_policy_t performance_policy;
+    /// State and statistics of the performance governor, which also holds the power budget
+    optiga_lib_performance_stats_t performance_stats;
+    /// Parameters of the write of the current limitation
+    optiga_set_data_object_params_t current_limit_params;
+    /// Time in microseconds, at which the current limitation was written last
+    uint32_t current_limit_write_time;
+    /// Current limitation, which is being written
+    uint8_t current_limit_pending;
+    /// Current limitation, whose write failed. It is not written again, until another current limitation is written
+    uint8_t current_limit_failed;
+#endif //OPTIGA_CMD_PERFORMANCE_GOVERNOR_ENABLED
+#ifdef OPTIGA_CMD_SEC_PACING_ENABLED
+    /// Policy of the SEC pacing, pacing_threshold is 0 if the pacing is disabled
+    optiga_lib_sec_policy_t sec_policy;
+    /// State and statistics of the SEC pacing
+    optiga_lib_sec_stats_t sec_stats;
+    /// Parameters of the read of the security event counter
+    optiga_get_data_object_params_t sec_read_params;
+    /// Time in microseconds, from which the SEC held in sec_value decays
+    uint32_t sec_time;
+    /// Time in microseconds, at which the SEC was read last
+    uint32_t sec_read_time;
+    /// Length of the read SEC
+    uint16_t sec_read_length;
+    /// SEC at sec_time, as read or raised by a failed SEC raising command
+    uint8_t sec_value;
+    /// Buffer of the read SEC
+    uint8_t sec_read_buffer;
+    /// TRUE, if the SEC is to be read, once the policy is set or a SEC raising command failed
+    bool_t sec_refresh_required;
+    /// TRUE, if a SEC raising request waited in the last scheduler run
+    bool_t sec_request_paced;
+#endif //OPTIGA_CMD_SEC_PACING_ENABLED
+#endif //OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+#ifdef OPTIGA_UTIL_READ_CACHE_ENABLED
+    /// Data objects cached on host, shared by all the instances
+    optiga_cmd_read_cache_entry_t read_cache[OPTIGA_UTIL_READ_CACHE_SIZE];
+#endif //OPTIGA_UTIL_READ_CACHE_ENABLED
+#ifdef OPTIGA_UTIL_METADATA_CACHE_ENABLED
+    /// Parsed metadata of the objects, shared by all the instances
+    optiga_cmd_metadata_cache_entry_t metadata_cache[OPTIGA_UTIL_METADATA_CACHE_SIZE];
+    /// Entry of the metadata cache, which is replaced next if no entry is free
+    uint8_t metadata_cache_next;
+#endif //OPTIGA_UTIL_METADATA_CACHE_ENABLED
+#ifdef OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+    /// Successful verifications, shared by all the instances
+    optiga_cmd_verify_cache_entry_t verify_cache[OPTIGA_CRYPT_VERIFY_CACHE_SIZE];
+    /// Entry of the verification cache, which is replaced next if no entry is free
+    uint8_t verify_cache_next;
+    /// Incremented on each write to OPTIGA, a verification started before the write is not cached
+    uint32_t verify_cache_generation;
+    /// Statistics of the verification cache
+    optiga_lib_verify_cache_stats_t verify_cache_stats;
+#endif //OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+#ifdef OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
+    /// Offload policy, shared by all the instances
+    optiga_lib_offload_policy_t offload_policy;
+    /// Indicates the offload policy is set, else the offload settings of the instances apply
+    bool_t offload_policy_set;
+    /// Cost model and decisions of each operation
+    optiga_lib_offload_stats_t offload_stats[OPTIGA_LIB_OFFLOAD_OPERATION_COUNT];
+    /// Number of automatic decisions of each operation since the last probe
+    uint16_t offload_decisions_since_probe[OPTIGA_LIB_OFFLOAD_OPERATION_COUNT];
+#endif //OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+    /// Runtime statistics of the commands and the execution queue, the link statistics are held by comms
+    optiga_lib_statistics_t statistics;
+    /// Time in microseconds, at which the command in execution is passed to comms
+    uint32_t command_start_time;
+    /// Time in milliseconds, at which OPTIGA entered the energy state
+    uint32_t energy_state_start_time;
+    /// Energy state of OPTIGA (awake, hibernated or off)
+    uint8_t energy_state;
+#endif //OPTIGA_LIB_STATISTICS_ENABLED
+#ifdef OPTIGA_CMD_SESSION_POOL_ENABLED
+    /// Instance, to which each session is assigned
+    optiga_cmd_t * session_holder[OPTIGA_CMD_MAX_NUMBER_OF_SESSIONS];
+    /// Time in microseconds, at which the lease of each session is started
+    uint32_t session_lease_start[OPTIGA_CMD_MAX_NUMBER_OF_SESSIONS];
+    /// Number of session requests, which failed since no session was free
+    uint32_t session_rejected_requests;
+    /// Number of sessions, which are freed on expiry of the lease
+    uint32_t session_expired_leases;
+#endif //OPTIGA_CMD_SESSION_POOL_ENABLED
+#ifdef OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+    /// Capabilities of OPTIGA along with #OPTIGA_LIB_CAPABILITY_PROBED, 0 till they are probed
+    uint32_t capabilities;
+#endif //OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+#ifdef OPTIGA_UTIL_COUNT_COALESCING_ENABLED
+    /// Increments of the counter data objects, which are not yet written to OPTIGA, shared by all the instances
+    uint16_t pending_count[OPTIGA_CMD_PENDING_COUNT_SIZE];
+    /// Increments of the counter data objects, which are being written by an instance
+    uint16_t pending_count_reserved[OPTIGA_CMD_PENDING_COUNT_SIZE];
+    /// Time of the first pending increment of the counter data objects in milliseconds
+    uint32_t pending_count_time[OPTIGA_CMD_PENDING_COUNT_SIZE];
+    /// Number of increments, which are not yet stored to the datastore
+    uint8_t pending_count_unsaved;
+    /// TRUE, once the pending increments are restored from the datastore
+    bool_t pending_count_restored;
+#endif //OPTIGA_UTIL_COUNT_COALESCING_ENABLED
 };
 
-// static instance of optiga
-_STATIC_H optiga_context_t g_optiga = {0};
+/*
+* Atomic operations used by the execution queue, which is updated by requesters of other threads and by the scheduler.
+* Without compiler support, the event is expected to be preempting the requesters (e.g. interrupt) and the critical
+* section provides the atomicity.
+*/
+_STATIC_H optiga_cmd_queue_slot_t * optiga_cmd_atomic_exchange_slot(optiga_cmd_queue_slot_t * volatile * pp_target,
+                                                                    optiga_cmd_queue_slot_t * p_value)
+{
+#if defined (__GNUC__)
+    return (__atomic_exchange_n(pp_target, p_value, __ATOMIC_SEQ_CST));
+#else
+    optiga_cmd_queue_slot_t * p_previous;
+
+    pal_os_lock_enter_critical_section();
+    p_previous = *pp_target;
+    *pp_target = p_value;
+    pal_os_lock_exit_critical_section();
+    return (p_previous);
+#endif
+}
+
+_STATIC_H optiga_cmd_queue_slot_t * optiga_cmd_atomic_load_slot(optiga_cmd_queue_slot_t * volatile const * pp_source)
+{
+#if defined (__GNUC__)
+    return (__atomic_load_n(pp_source, __ATOMIC_SEQ_CST));
+#else
+    return (*pp_source);
+#endif
+}
+
+_STATIC_H void optiga_cmd_atomic_store_slot(optiga_cmd_queue_slot_t * volatile * pp_target,
+                                            optiga_cmd_queue_slot_t * p_value)
+{
+#if defined (__GNUC__)
+    __atomic_store_n(pp_target, p_value, __ATOMIC_SEQ_CST);
+#else
+    *pp_target = p_value;
+#endif
+}
+
+#ifdef OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+_STATIC_H uint8_t optiga_cmd_atomic_exchange_byte(volatile uint8_t * p_target, uint8_t value)
+{
+#if defined (__GNUC__)
+    return (__atomic_exchange_n(p_target, value, __ATOMIC_SEQ_CST));
+#else
+    uint8_t previous;
+
+    pal_os_lock_enter_critical_section();
+    previous = *p_target;
+    *p_target = value;
+    pal_os_lock_exit_critical_section();
+    return (previous);
+#endif
+}
+#endif //OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+
+_STATIC_H bool_t optiga_cmd_atomic_compare_exchange_byte(volatile uint8_t * p_target, uint8_t expected, uint8_t desired)
+{
+#if defined (__GNUC__)
+    return ((__atomic_compare_exchange_n(p_target, &expected, desired, FALSE, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) ? TRUE : FALSE);
+#else
+    bool_t exchanged = FALSE;
+
+    pal_os_lock_enter_critical_section();
+    if (expected == *p_target)
+    {
+        *p_target = desired;
+        exchanged = TRUE;
+    }
+    pal_os_lock_exit_critical_section();
+    return (exchanged);
+#endif
+}
+
+_STATIC_H void optiga_cmd_atomic_increment_byte(volatile uint8_t * p_target)
+{
+#if defined (__GNUC__)
+    (void)__atomic_add_fetch(p_target, 1, __ATOMIC_SEQ_CST);
+#else
+    pal_os_lock_enter_critical_section();
+    (*p_target)++;
+    pal_os_lock_exit_critical_section();
+#endif
+}
+
+_STATIC_H void optiga_cmd_atomic_decrement_byte(volatile uint8_t * p_target)
+{
+#if defined (__GNUC__)
+    (void)__atomic_sub_fetch(p_target, 1, __ATOMIC_SEQ_CST);
+#else
+    pal_os_lock_enter_critical_section();
+    (*p_target)--;
+    pal_os_lock_exit_critical_section();
+#endif
+}
+
+// static instances of optiga
+_STATIC_H optiga_context_t g_optiga_list[OPTIGA_MAX_NUMBER_OF_INSTANCES] = {0};
 
-// List of optiga instances
-//lint --e{843} suppress "Not changing to const as this gets assigned to another context variable which is not const"
-_STATIC_H optiga_context_t * g_optiga_list[] = {&g_optiga};
+// default execution queue of each instance of optiga, used if no registry is supplied by the caller
+_STATIC_H optiga_cmd_queue_slot_t g_optiga_cmd_execution_queue_list[OPTIGA_MAX_NUMBER_OF_INSTANCES][OPTIGA_CMD_MAX_REGISTRATIONS] = {0};
 
 // hibernate data store for each instance of optiga
+// Hibernate is supported only for first instance, others are OPTIGA_LIB_PAL_DATA_STORE_NOT_CONFIGURED
+//lint --e{843} suppress "Not changing to const as this is used for unit testing as well"
+_STATIC_H uint16_t g_hibernate_datastore_id_list[OPTIGA_MAX_NUMBER_OF_INSTANCES] = {OPTIGA_HIBERNATE_CONTEXT_ID};
+
+#ifdef OPTIGA_UTIL_COUNT_COALESCING_ENABLED
+// pending increments data store for each instance of optiga
+// The pending increments persist only for first instance, others are OPTIGA_LIB_PAL_DATA_STORE_NOT_CONFIGURED
 //lint --e{843} suppress "Not changing to const as this is used for unit testing as well"
-_STATIC_H uint16_t g_hibernate_datastore_id_list[] = {OPTIGA_HIBERNATE_CONTEXT_ID};
+_STATIC_H uint16_t g_pending_count_datastore_id_list[OPTIGA_MAX_NUMBER_OF_INSTANCES] = {OPTIGA_UTIL_PENDING_COUNT_ID};
+#endif //OPTIGA_UTIL_COUNT_COALESCING_ENABLED
 
 const uint8_t g_optiga_unique_application_identifier[] =
 {
@@ -482,6 +1167,10 @@ struct optiga_cmd
     uint8_t chaining_ongoing;
     /// Param value for the respective command to be processed
     uint8_t cmd_param;
+#if defined (OPTIGA_LIB_TRACE_ENABLED) || defined (OPTIGA_LIB_STATISTICS_ENABLED)
+    /// Command code of the APDU in execution, recorded with the trace events and the statistics
+    uint8_t command_code;
+#endif
 #ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
     /// To provide the encryption and decryption need for command and response
     uint8_t protection_level;
@@ -494,12 +1183,58 @@ struct optiga_cmd
     uint8_t device_error_status;
     /// Assigned slot from execution queue
     uint8_t queue_id;
+    /// Priority class of the instance in execution queue
+    uint8_t priority;
+#ifdef OPTIGA_CMD_FAIR_SHARE_ENABLED
+    /// Tenant, to which the requests of the instance are accounted
+    uint8_t tenant;
+#endif //OPTIGA_CMD_FAIR_SHARE_ENABLED
+#ifdef OPTIGA_CMD_DEADLINE_ENABLED
+    /// Deadline of the requests in microseconds after the arrival, 0 if the requests do not expire
+    uint32_t deadline_us;
+#endif //OPTIGA_CMD_DEADLINE_ENABLED
+#ifdef OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+    /// Maximum delay in microseconds, for which the requests wait for a restore of the hibernated application, 0 if not deferrable
+    uint32_t defer_delay_us;
+#endif //OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+#ifdef OPTIGA_CMD_CANCEL_ENABLED
+    /// Indicates the ongoing request is cancelled, set by any thread and cleared with the start of the next request
+    volatile uint8_t cancel_requested;
+#endif //OPTIGA_CMD_CANCEL_ENABLED
+#ifdef OPTIGA_CMD_HEALTH_MONITOR_ENABLED
+    /// Number of recoveries of OPTIGA done for the ongoing request
+    uint8_t recovery_attempts;
+    /// Communication failure, which is reported if the recovery fails
+    optiga_lib_status_t recovery_status;
+#endif //OPTIGA_CMD_HEALTH_MONITOR_ENABLED
+#ifdef OPTIGA_CMD_SEC_PACING_ENABLED
+    /// Indicates the ongoing request waited for the decay of the SEC, hence it is counted once
+    bool_t sec_paced;
+#endif //OPTIGA_CMD_SEC_PACING_ENABLED
+#ifdef OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+    /// Indicates the strict lock of the instance was revoked, since the next step was not sent within the hold time
+    bool_t strict_lock_revoked;
+#endif //OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
     /// Exit status value
     optiga_lib_status_t exit_status;
     /// Datastore ID for optiga context
     uint16_t optiga_context_datastore_id;
     /// To Store APDU command information which is last processed
     uint16_t apdu_data;
+    /// Items of the ongoing command batch, NULL if no batch is ongoing
+    optiga_cmd_batch_item_t * p_batch_items;
+    /// Number of items in the ongoing command batch
+    uint8_t batch_item_count;
+    /// Index of the item being executed in the ongoing command batch
+    uint8_t batch_index;
+    /// Indicates the ongoing command batch is a chain, which stops at the first failed item
+    uint8_t batch_is_chain;
+#ifdef OPTIGA_CMD_SESSION_POOL_ENABLED
+    /// Lease time of the assigned session in microseconds, 0 if the session is kept till it is released
+    uint32_t session_lease_time_us;
+    /// Acquisition policy of the session, value of #optiga_lib_session_policy_t
+    uint8_t session_policy;
+#endif //OPTIGA_CMD_SESSION_POOL_ENABLED
 };
 
 _STATIC_H optiga_lib_status_t optiga_cmd_get_error_code_handler(optiga_cmd_t * me);
@@ -683,6 +1418,47 @@ _STATIC_H uint8_t optiga_cmd_sym_get_current_enc_dec_sequence(optiga_encrypt_sym
 }
 #endif //(OPTIGA_CRYPT_SYM_ENCRYPT_ENABLED) || (OPTIGA_CRYPT_SYM_DECRYPT_ENABLED) || (OPTIGA_CRYPT_HMAC_ENABLED)
 #ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+#ifdef OPTIGA_COMMS_PROTECTION_POLICY_ENABLED
+/*
+* Provides the protection level of the prepared APDU, from the first matching entry of the protection policy table.
+* The table applies only, if the requesting instance is at the default protection level.
+*/
+_STATIC_H uint8_t optiga_cmd_get_protection_level(const optiga_cmd_t * me)
+{
+    const optiga_context_t * p_optiga = me->p_optiga;
+    const uint8_t * p_apdu = &p_optiga->optiga_comms_buffer[OPTIGA_COMMS_DATA_OFFSET];
+    uint8_t protection_level = me->protection_level;
+    uint8_t command;
+    uint16_t oid = OPTIGA_PROTECTION_POLICY_ANY_OID;
+    uint8_t index;
+
+    command = (uint8_t)(p_apdu[0] & (uint8_t)(~OPTIGA_CMD_CLEAR_LAST_ERROR));
+    // Only data object commands start with the OID
+    if (((OPTIGA_PROTECTION_POLICY_GET_DATA_OBJECT == command) ||
+         (OPTIGA_PROTECTION_POLICY_SET_DATA_OBJECT == command) ||
+         (OPTIGA_PROTECTION_POLICY_SET_OBJECT_PROTECTED == command)) &&
+        (p_optiga->comms_tx_size >= (OPTIGA_CMD_APDU_HEADER_SIZE + 2)))
+    {
+        optiga_common_get_uint16(&p_apdu[OPTIGA_CMD_APDU_HEADER_SIZE], &oid);
+    }
+    // A protection level set for the call is not overridden by the table
+    for (index = 0; (OPTIGA_COMMS_DEFAULT_PROTECTION_LEVEL == (me->protection_level & OPTIGA_PROTECTION_LEVEL_MASK)) &&
+                    (index < p_optiga->protection_policy_count); index++)
+    {
+        if ((command == p_optiga->p_protection_policy[index].command) &&
+            ((OPTIGA_PROTECTION_POLICY_ANY_OID == p_optiga->p_protection_policy[index].oid) ||
+             (oid == p_optiga->p_protection_policy[index].oid)))
+        {
+            // Re-establish requested for the call is kept
+            protection_level = (uint8_t)((me->protection_level & (uint8_t)(~OPTIGA_PROTECTION_LEVEL_MASK)) |
+                                         p_optiga->p_protection_policy[index].protection_level);
+            break;
+        }
+    }
+    return (protection_level);
+}
+#endif //OPTIGA_COMMS_PROTECTION_POLICY_ENABLED
+
 //lint --e{714} suppress "This function is defined here but referred from other modules"
 void optiga_cmd_set_shielded_connection_option(optiga_cmd_t * me,
                                                uint8_t value,
@@ -728,6 +1504,12 @@ _STATIC_H void optiga_cmd_execute(optiga_cmd_t * me,
 _STATIC_H void optiga_cmd_execute_handler(void * p_ctx,
                                           optiga_lib_status_t event);
 
+// Loads the current item of the command batch
+_STATIC_H void optiga_cmd_batch_load_item(optiga_cmd_t * me);
+
+// Ends the command batch with the failure status
+_STATIC_H void optiga_cmd_batch_abort(optiga_cmd_t * me);
+
 //
 _STATIC_H void optiga_cmd_prepare_apdu_header(uint8_t cmd, uint8_t param,
                                               uint16_t in_data_length,
@@ -754,6 +1536,128 @@ _STATIC_H void optiga_cmd_prepare_tag_header(uint8_t tag,
     *position = start_position;
 }
 
+#ifdef OPTIGA_CMD_DESCRIPTOR_ENCODING
+_STATIC_H uint16_t optiga_cmd_field_length(uint8_t type, uint16_t value)
+{
+    uint16_t field_length = value;
+
+    if (OPTIGA_CMD_FIELD_UINT16 == type)
+    {
+        field_length = OPTIGA_CMD_UINT16_SIZE_IN_BYTES;
+    }
+    else if (OPTIGA_CMD_FIELD_UINT8 == type)
+    {
+        field_length = OPTIGA_CMD_NO_OF_BYTES_IN_TAG;
+    }
+    else if (OPTIGA_CMD_FIELD_EMPTY == type)
+    {
+        field_length = 0;
+    }
+    return (field_length);
+}
+
+// Forms the APDU in the comms buffer from the descriptor of the command and the values of its fields
+_STATIC_H optiga_lib_status_t optiga_cmd_encode_apdu(optiga_cmd_t * me,
+                                                     const optiga_cmd_descriptor_t * p_descriptor,
+                                                     const optiga_cmd_field_value_t * p_values)
+{
+    const optiga_cmd_field_descriptor_t * p_field;
+    uint32_t total_apdu_length = OPTIGA_CMD_APDU_HEADER_SIZE;
+    uint16_t index_for_data = OPTIGA_CMD_APDU_INDATA_OFFSET;
+    uint16_t field_length;
+    uint8_t field_index;
+
+    for (field_index = 0; field_index < p_descriptor->field_count; field_index++)
+    {
+        p_field = &p_descriptor->p_fields[field_index];
+        total_apdu_length += OPTIGA_CMD_TAG_LENGTH_SIZE + optiga_cmd_field_length(p_field->type,
+                                                                                  p_values[field_index].value);
+    }
+    if (OPTIGA_MAX_COMMS_BUFFER_SIZE < total_apdu_length)
+    {
+        return (OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT);
+    }
+
+    for (field_index = 0; field_index < p_descriptor->field_count; field_index++)
+    {
+        p_field = &p_descriptor->p_fields[field_index];
+        field_length = optiga_cmd_field_length(p_field->type, p_values[field_index].value);
+        optiga_cmd_prepare_tag_header(p_field->tag,
+                                      field_length,
+                                      me->p_optiga->optiga_comms_buffer,
+                                      &index_for_data);
+        if (OPTIGA_CMD_FIELD_BUFFER == p_field->type)
+        {
+            pal_os_memcpy(me->p_optiga->optiga_comms_buffer + index_for_data,
+                          p_values[field_index].p_buffer,
+                          field_length);
+        }
+        else if (OPTIGA_CMD_FIELD_UINT16 == p_field->type)
+        {
+            optiga_common_set_uint16(me->p_optiga->optiga_comms_buffer + index_for_data,
+                                     p_values[field_index].value);
+        }
+        else if (OPTIGA_CMD_FIELD_UINT8 == p_field->type)
+        {
+            me->p_optiga->optiga_comms_buffer[index_for_data] = (uint8_t)p_values[field_index].value;
+        }
+        else
+        {
+            // Only the tag and length are sent
+        }
+        index_for_data += field_length;
+    }
+
+    optiga_cmd_prepare_apdu_header(p_descriptor->command_code,
+                                   me->cmd_param,
+                                   (uint16_t)(index_for_data - OPTIGA_CMD_APDU_INDATA_OFFSET),
+                                   me->p_optiga->optiga_comms_buffer + OPTIGA_COMMS_DATA_OFFSET);
+
+    me->p_optiga->comms_tx_size = (uint16_t)(index_for_data - OPTIGA_COMMS_DATA_OFFSET);
+    return (OPTIGA_LIB_SUCCESS);
+}
+
+#if defined (OPTIGA_CRYPT_ECDSA_SIGN_ENABLED) || defined (OPTIGA_CRYPT_RSA_SIGN_ENABLED) || \
+    defined (OPTIGA_CRYPT_ECDH_ENABLED)
+// Checks the response status and copies the response data to the user buffer.
+// If p_out is NULL, only the status is checked. If p_out_length is NULL, the buffer is expected to
+// hold the complete response data.
+_STATIC_H optiga_lib_status_t optiga_cmd_decode_response(optiga_cmd_t * me,
+                                                         uint8_t * p_out,
+                                                         uint16_t * p_out_length)
+{
+    uint16_t response_length = me->p_optiga->comms_rx_size - OPTIGA_CMD_APDU_HEADER_SIZE;
+
+    if (OPTIGA_CMD_APDU_SUCCESS != me->p_optiga->optiga_comms_buffer[OPTIGA_COMMS_DATA_OFFSET])
+    {
+        //lint --e{835} suppress "SET_DEV_ERROR_NOTIFICATION is generically written for any unsigned interger value"
+        //lint --e{845} suppress "SET_DEV_ERROR_NOTIFICATION is generically written for any unsigned interger value"
+        SET_DEV_ERROR_NOTIFICATION(OPTIGA_CMD_EXIT_HANDLER_CALL);
+        if (NULL != p_out_length)
+        {
+            *p_out_length = 0;
+        }
+        return (OPTIGA_CMD_ERROR);
+    }
+    if (NULL != p_out_length)
+    {
+        // if the received data is greater than the user provided buffer
+        if (*p_out_length < response_length)
+        {
+            *p_out_length = 0;
+            return (OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT);
+        }
+        *p_out_length = response_length;
+    }
+    if (NULL != p_out)
+    {
+        pal_os_memcpy(p_out, me->p_optiga->optiga_comms_buffer + OPTIGA_CMD_APDU_INDATA_OFFSET, response_length);
+    }
+    return (OPTIGA_LIB_SUCCESS);
+}
+#endif //(OPTIGA_CRYPT_ECDSA_SIGN_ENABLED) || (OPTIGA_CRYPT_RSA_SIGN_ENABLED) || (OPTIGA_CRYPT_ECDH_ENABLED)
+#endif //OPTIGA_CMD_DESCRIPTOR_ENCODING
+
 
 _STATIC_H void optiga_cmd_event_trigger_execute(void * p_ctx)
 {
@@ -769,15 +1673,121 @@ _STATIC_H void optiga_cmd_execute(optiga_cmd_t * me,
                                   uint16_t apdu_data)
 {
     me->p_input = input;
+#ifdef OPTIGA_CMD_CANCEL_ENABLED
+    // A cancellation of the previous request does not apply to this one
+    (void)optiga_cmd_atomic_exchange_byte(&me->cancel_requested, FALSE);
+#endif //OPTIGA_CMD_CANCEL_ENABLED
+#ifdef OPTIGA_CMD_HEALTH_MONITOR_ENABLED
+    me->recovery_attempts = 0;
+#endif //OPTIGA_CMD_HEALTH_MONITOR_ENABLED
+#ifdef OPTIGA_CMD_SEC_PACING_ENABLED
+    me->sec_paced = FALSE;
+#endif //OPTIGA_CMD_SEC_PACING_ENABLED
     me->cmd_next_execution_state = start_state;
     me->cmd_sub_execution_state = sub_state;
     me->cmd_hdlrs = cmd_hdlrs;
     me->chaining_ongoing = FALSE;
     me->cmd_param = cmd_param;
     me->apdu_data = apdu_data;
+    OPTIGA_LIB_TRACE_BEGIN(OPTIGA_LIB_TRACE_LAYER_API,
+                           OPTIGA_LIB_TRACE_INSTANCE_CODE(me->queue_id, OPTIGA_CMD_GET_APDU_CMD(apdu_data)));
     optiga_cmd_execute_handler(me, OPTIGA_LIB_SUCCESS);
 }
 
+/*
+* Updates the status of current batch item and schedules the next item
+* Returns TRUE, if next item is scheduled with the lock retained
+* Returns FALSE, if no batch is ongoing or the batch is completed
+*/
+_STATIC_H bool_t optiga_cmd_batch_next_item(optiga_cmd_t * me)
+{
+    bool_t next_item_scheduled = FALSE;
+    const optiga_cmd_batch_host_params_t * p_host_params;
+    uint8_t index;
+
+    do
+    {
+        if (NULL == me->p_batch_items)
+        {
+            break;
+        }
+        me->p_batch_items[me->batch_index].status = me->exit_status;
+        me->batch_index++;
+
+        // An item of a chain depends on the result of the previous item
+        if ((TRUE == me->batch_is_chain) && (OPTIGA_LIB_SUCCESS != me->exit_status))
+        {
+            optiga_cmd_batch_abort(me);
+            break;
+        }
+
+        // The host items are executed in place, without releasing the lock
+        while ((me->batch_index < me->batch_item_count) &&
+               (OPTIGA_CMD_BATCH_ITEM_HOST == me->p_batch_items[me->batch_index].cmd_type))
+        {
+            p_host_params = (const optiga_cmd_batch_host_params_t *)me->p_batch_items[me->batch_index].params;
+            me->exit_status = p_host_params->callback(p_host_params->p_context);
+            if ((TRUE == me->batch_is_chain) && (OPTIGA_LIB_SUCCESS != me->exit_status))
+            {
+                break;
+            }
+            me->p_batch_items[me->batch_index].status = me->exit_status;
+            me->batch_index++;
+        }
+        if ((TRUE == me->batch_is_chain) && (OPTIGA_LIB_SUCCESS != me->exit_status))
+        {
+            optiga_cmd_batch_abort(me);
+            break;
+        }
+
+        if (me->batch_index < me->batch_item_count)
+        {
+            optiga_cmd_batch_load_item(me);
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+            me->protection_level &= OPTIGA_PROTECTION_LEVEL_MASK;
+#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+            me->cmd_next_execution_state = OPTIGA_CMD_EXEC_PREPARE_COMMAND;
+            me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_PREPARE_APDU;
+            PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(me->p_optiga->p_pal_os_event_ctx,
+                                                   (register_callback)optiga_cmd_event_trigger_execute,
+                                                   (void*)me,
+                                                   OPTIGA_CMD_SCHEDULER_IDLING_TIME_MS);
+            next_item_scheduled = TRUE;
+            break;
+        }
+
+        // Batch is completed, report the status of first failed item
+        me->exit_status = OPTIGA_LIB_SUCCESS;
+        for (index = 0; index < me->batch_item_count; index++)
+        {
+            if (OPTIGA_LIB_SUCCESS != me->p_batch_items[index].status)
+            {
+                me->exit_status = me->p_batch_items[index].status;
+                break;
+            }
+        }
+        me->p_batch_items = NULL;
+    } while (FALSE);
+    return (next_item_scheduled);
+}
+
+/*
+* Updates the current and remaining batch items with the failure status and ends the batch
+*/
+_STATIC_H void optiga_cmd_batch_abort(optiga_cmd_t * me)
+{
+    uint8_t index;
+
+    if (NULL != me->p_batch_items)
+    {
+        for (index = me->batch_index; index < me->batch_item_count; index++)
+        {
+            me->p_batch_items[index].status = me->exit_status;
+        }
+        me->p_batch_items = NULL;
+    }
+}
+
 /*
 * Checks if optiga session is available or not
 * Returns TRUE, if slot is available
@@ -807,6 +1817,10 @@ _STATIC_H void optiga_cmd_session_assign(optiga_cmd_t * me)
             {
                 me->session_oid = (OPTIGA_CMD_START_SESSION_OID | count);
                 p_optiga_sessions[count] = OPTIGA_CMD_SESSION_ASSIGNED;
+#ifdef OPTIGA_CMD_SESSION_POOL_ENABLED
+                me->p_optiga->session_holder[count] = me;
+                me->p_optiga->session_lease_start[count] = pal_os_timer_get_time_in_microseconds();
+#endif //OPTIGA_CMD_SESSION_POOL_ENABLED
                 break;
             }
         }
@@ -825,6 +1839,9 @@ _STATIC_H void optiga_cmd_session_free(optiga_cmd_t * me)
         count = me->session_oid & 0x0F;
         me->session_oid = OPTIGA_CMD_NO_SESSION_OID;
         p_optiga_sessions[count] = OPTIGA_CMD_SESSION_NOT_ASSIGNED;
+#ifdef OPTIGA_CMD_SESSION_POOL_ENABLED
+        me->p_optiga->session_holder[count] = NULL;
+#endif //OPTIGA_CMD_SESSION_POOL_ENABLED
     }
 }
 
@@ -852,859 +1869,4574 @@ _STATIC_H  uint8_t optiga_cmd_queue_get_state_of(const optiga_cmd_t * me, uint8_
     return (state);
 }
 
+#ifdef OPTIGA_CMD_SESSION_POOL_ENABLED
 /*
-* Returns the count of number of slots with requested state
+* Checks if the lease of the session is expired and the holder has no request in the execution queue.
+* Otherwise, updates the time left till the next lease expires.
 */
-_STATIC_H  uint8_t optiga_cmd_queue_get_count_of(const optiga_context_t * p_optiga,
-                                                 uint8_t slot_member,
-                                                 uint8_t state_to_check)
+_STATIC_H bool_t optiga_cmd_session_expired(const optiga_context_t * p_optiga,
+                                            uint8_t count,
+                                            uint32_t * p_time_left)
 {
-    uint8_t index;
-    uint8_t count = 0;
-    uint8_t slot_value = 0;
-    for (index = 0; index < OPTIGA_CMD_MAX_REGISTRATIONS ; index++)
+    const optiga_cmd_t * p_holder = p_optiga->session_holder[count];
+    uint32_t elapsed_time;
+    bool_t is_expired = FALSE;
+
+    do
     {
-        switch (slot_member)
+        if ((NULL == p_holder) || (0U == p_holder->session_lease_time_us))
         {
-            case OPTIGA_CMD_QUEUE_SLOT_LOCK_TYPE:
-            {
-                slot_value = p_optiga->optiga_cmd_execution_queue[index].request_type;
-            }
             break;
-            case OPTIGA_CMD_QUEUE_SLOT_STATE:
+        }
+        elapsed_time = pal_os_timer_get_time_in_microseconds() - p_optiga->session_lease_start[count];
+        if (elapsed_time < p_holder->session_lease_time_us)
+        {
+            if ((p_holder->session_lease_time_us - elapsed_time) < *p_time_left)
             {
-                slot_value = p_optiga->optiga_cmd_execution_queue[index].state_of_entry;
+                *p_time_left = p_holder->session_lease_time_us - elapsed_time;
             }
             break;
-            default:
-                break;
         }
-        if (state_to_check == slot_value)
+        // A session in use by an ongoing request is reclaimed, once the request is completed
+        is_expired = (OPTIGA_CMD_QUEUE_ASSIGNED == optiga_cmd_queue_get_state_of(p_holder, OPTIGA_CMD_QUEUE_SLOT_STATE)) ?
+                     TRUE : FALSE;
+    } while (FALSE);
+    return (is_expired);
+}
+
+/*
+* Frees the sessions, whose lease is expired.
+* Returns the time in microseconds till the next lease expires, OPTIGA_CMD_SESSION_NO_LEASE if no lease is pending.
+*/
+_STATIC_H uint32_t optiga_cmd_session_reclaim(optiga_context_t * p_optiga)
+{
+    uint32_t next_expiry = OPTIGA_CMD_SESSION_NO_LEASE;
+    uint8_t count;
+
+    for (count = 0; count < OPTIGA_CMD_MAX_NUMBER_OF_SESSIONS; count++)
+    {
+        if (TRUE == optiga_cmd_session_expired(p_optiga, count, &next_expiry))
         {
-            count++;
+            optiga_cmd_session_free(p_optiga->session_holder[count]);
+            p_optiga->session_expired_leases++;
         }
     }
-    return (count);
+    return (next_expiry);
 }
 
 /*
-* Assigns an available slot to a optiga cmd instance and marks the slot as not available for another optiga cmd instance
+* Checks if a session is free or expired, which is assigned by the scheduler
 */
-_STATIC_H void optiga_cmd_queue_assign_slot(const optiga_cmd_t * me, uint8_t * queue_index_store)
+_STATIC_H bool_t optiga_cmd_session_obtainable(const optiga_context_t * p_optiga)
 {
-    uint8_t index;
-    for (index = 0; index < OPTIGA_CMD_MAX_REGISTRATIONS ; index++)
+    uint32_t next_expiry = OPTIGA_CMD_SESSION_NO_LEASE;
+    bool_t is_obtainable = optiga_cmd_session_available(p_optiga);
+    uint8_t count;
+
+    for (count = 0; (FALSE == is_obtainable) && (count < OPTIGA_CMD_MAX_NUMBER_OF_SESSIONS); count++)
     {
-        if (OPTIGA_CMD_QUEUE_NOT_ASSIGNED == me->p_optiga->optiga_cmd_execution_queue[index].state_of_entry)
-        {
-            * queue_index_store =  index;
-            me->p_optiga->optiga_cmd_execution_queue[index].state_of_entry = OPTIGA_CMD_QUEUE_ASSIGNED;
-           break;
-        }
+        is_obtainable = optiga_cmd_session_expired(p_optiga, count, &next_expiry);
     }
+    return (is_obtainable);
 }
+#endif //OPTIGA_CMD_SESSION_POOL_ENABLED
 
 /*
-* De-assigns a slot from a optiga cmd instance and makes the slot available for next optiga cmd instance
+* Returns the counter index of a slot state
 */
-_STATIC_H void optiga_cmd_queue_deassign_slot(optiga_cmd_t * me)
+_STATIC_H uint8_t optiga_cmd_queue_get_state_index(uint8_t state_of_entry)
 {
-    me->p_optiga->optiga_cmd_execution_queue[me->queue_id].state_of_entry = OPTIGA_CMD_QUEUE_NOT_ASSIGNED;
-    me->p_optiga->optiga_cmd_execution_queue[me->queue_id].request_type = OPTIGA_CMD_QUEUE_NO_REQUEST;
-    me->queue_id = 0;
+    uint8_t state_index;
+    switch (state_of_entry)
+    {
+        case OPTIGA_CMD_QUEUE_ASSIGNED: state_index = 1; break;
+        case OPTIGA_CMD_QUEUE_REQUEST: state_index = 2; break;
+        case OPTIGA_CMD_QUEUE_PROCESSING: state_index = 3; break;
+        case OPTIGA_CMD_QUEUE_RESUME: state_index = 4; break;
+        default: state_index = 0; break;
+    }
+    return (state_index);
 }
 
 /*
-* Select next optiga cmd instance from the execution queue based on a rule
-* 1. A slot with OPTIGA_CMD_QUEUE_RESUME state should exist
-* 2. Pick the slot which has acquired the strict slot
-* 3. If no slot with OPTIGA_CMD_QUEUE_RESUME exists, slot must be in OPTIGA_CMD_QUEUE_REQUEST state
-* 4. The arrival time must be the earliest provided
-*     a. The request type is lock
-*     b. If request type is session, either session is already assigned or atleast session is available for assignment
+* Returns the counter index of a request type
 */
-_STATIC_H void optiga_cmd_queue_scheduler(void * p_optiga)
+_STATIC_H uint8_t optiga_cmd_queue_get_request_type_index(uint8_t request_type)
 {
-    uint32_t reference_time_stamp = 0xFFFFFFFF;
-    optiga_cmd_queue_slot_t * p_queue_entry;
-    uint8_t index;
-    uint8_t prefered_index = 0xFF;
-    uint8_t overflow_detected = FALSE;
+    uint8_t request_type_index;
+    switch (request_type)
+    {
+        case OPTIGA_CMD_QUEUE_REQUEST_LOCK: request_type_index = 1; break;
+        case OPTIGA_CMD_QUEUE_REQUEST_SESSION: request_type_index = 2; break;
+        case OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK: request_type_index = 3; break;
+        default: request_type_index = 0; break;
+    }
+    return (request_type_index);
+}
 
-    optiga_context_t * p_optiga_ctx = (optiga_context_t * )p_optiga;
+/*
+* Initializes the slots, counters and ready lists of the execution queue, when no slot is assigned
+*/
+_STATIC_H void optiga_cmd_queue_init(optiga_context_t * p_optiga, uint8_t optiga_instance_id)
+{
+    uint8_t index;
 
-    pal_os_event_t * my_os_event = p_optiga_ctx->p_pal_os_event_ctx;
+    if (NULL == p_optiga->optiga_cmd_execution_queue)
+    {
+        p_optiga->optiga_cmd_execution_queue = g_optiga_cmd_execution_queue_list[optiga_instance_id];
+        p_optiga->queue_size = OPTIGA_CMD_MAX_REGISTRATIONS;
+    }
+    pal_os_memset(p_optiga->optiga_cmd_execution_queue, 0, (uint32_t)p_optiga->queue_size * sizeof(optiga_cmd_queue_slot_t));
+    pal_os_memset(p_optiga->queue_state_count, 0, sizeof(p_optiga->queue_state_count));
+    pal_os_memset(p_optiga->queue_request_type_count, 0, sizeof(p_optiga->queue_request_type_count));
+    p_optiga->queue_state_count[optiga_cmd_queue_get_state_index(OPTIGA_CMD_QUEUE_NOT_ASSIGNED)] = p_optiga->queue_size;
+    p_optiga->queue_request_type_count[optiga_cmd_queue_get_request_type_index(OPTIGA_CMD_QUEUE_NO_REQUEST)] = p_optiga->queue_size;
+    for (index = 0; index < OPTIGA_LIB_NUMBER_OF_PRIORITIES; index++)
+    {
+        p_optiga->queue_ready_head[index] = OPTIGA_CMD_QUEUE_INVALID_INDEX;
+        p_optiga->queue_ready_tail[index] = OPTIGA_CMD_QUEUE_INVALID_INDEX;
+    }
+    p_optiga->queue_resume_index = OPTIGA_CMD_QUEUE_INVALID_INDEX;
+    pal_os_memset(&p_optiga->submission_stub, 0, sizeof(p_optiga->submission_stub));
+    p_optiga->submission_head = &p_optiga->submission_stub;
+    p_optiga->submission_tail = &p_optiga->submission_stub;
+}
 
+/*
+* Appends a slot at the end of ready list of its priority class
+*/
+_STATIC_H void optiga_cmd_queue_ready_list_append(optiga_context_t * p_optiga, uint8_t index)
+{
+    optiga_cmd_queue_slot_t * p_queue_entry = &p_optiga->optiga_cmd_execution_queue[index];
+    uint8_t tail = p_optiga->queue_ready_tail[p_queue_entry->priority];
 
-    if (((0 == optiga_cmd_queue_get_count_of(p_optiga_ctx, OPTIGA_CMD_QUEUE_SLOT_STATE, OPTIGA_CMD_QUEUE_REQUEST)) &&
-         (0 == optiga_cmd_queue_get_count_of(p_optiga_ctx, OPTIGA_CMD_QUEUE_SLOT_STATE, OPTIGA_CMD_QUEUE_RESUME))) ||
-         ((1 == optiga_cmd_queue_get_count_of(p_optiga_ctx, OPTIGA_CMD_QUEUE_SLOT_STATE , OPTIGA_CMD_QUEUE_PROCESSING)) &&
-         (0 < optiga_cmd_queue_get_count_of(p_optiga_ctx, OPTIGA_CMD_QUEUE_SLOT_LOCK_TYPE, OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK))))
+    p_queue_entry->next_index = OPTIGA_CMD_QUEUE_INVALID_INDEX;
+    p_queue_entry->previous_index = tail;
+    if (OPTIGA_CMD_QUEUE_INVALID_INDEX == tail)
     {
-        // call self
-        pal_os_event_register_callback_oneshot(my_os_event, optiga_cmd_queue_scheduler,
-                                               p_optiga_ctx,OPTIGA_CMD_SCHEDULER_IDLING_TIME_MS);
+        p_optiga->queue_ready_head[p_queue_entry->priority] = index;
     }
     else
     {
-        pal_os_event_stop(my_os_event);
-        // continue checking if no context selected and overflow detected
-        do
-        {
-            //reset overflow detected flag and the last_time stamp
-            if(overflow_detected == TRUE)
-            {
-                p_optiga_ctx->last_time_stamp = 0;
-                overflow_detected = FALSE;
-            }
-
-            // Select optiga command based on rule
-            for (index = 0; index < OPTIGA_CMD_MAX_REGISTRATIONS; index++)
-            {
-                p_queue_entry = &(p_optiga_ctx->optiga_cmd_execution_queue[index]);
+        p_optiga->optiga_cmd_execution_queue[tail].next_index = index;
+    }
+    p_optiga->queue_ready_tail[p_queue_entry->priority] = index;
+}
 
-                // if any slot has acquired strict lock, highest priority is given to it
-                if (1 == optiga_cmd_queue_get_count_of(p_optiga_ctx, OPTIGA_CMD_QUEUE_SLOT_STATE , OPTIGA_CMD_QUEUE_RESUME))
-                {
-                    // Select the slot which has acquired strict lock
-                    if ((OPTIGA_CMD_QUEUE_RESUME == p_queue_entry->state_of_entry) &&
-                        (OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK == p_queue_entry->request_type))
-                    {
-                        reference_time_stamp = p_queue_entry->arrival_time;
-                        prefered_index = index;
-                    }
+/*
+* Removes a slot from the ready list of its priority class
+*/
+_STATIC_H void optiga_cmd_queue_ready_list_remove(optiga_context_t * p_optiga, uint8_t index)
+{
+    optiga_cmd_queue_slot_t * p_queue_entry = &p_optiga->optiga_cmd_execution_queue[index];
 
-                }
-                else
-                {
-                    // pick only requested queue slot and earliest arrival time
-                    if (p_queue_entry->state_of_entry == OPTIGA_CMD_QUEUE_REQUEST)
-                    {
-                        // remember that overflow has occurred in one of the entry
-                        if (p_queue_entry->arrival_time < p_optiga_ctx->last_time_stamp)
-                        {
-                            overflow_detected = TRUE;
-                        }
+    if (OPTIGA_CMD_QUEUE_INVALID_INDEX == p_queue_entry->previous_index)
+    {
+        p_optiga->queue_ready_head[p_queue_entry->priority] = p_queue_entry->next_index;
+    }
+    else
+    {
+        p_optiga->optiga_cmd_execution_queue[p_queue_entry->previous_index].next_index = p_queue_entry->next_index;
+    }
+    if (OPTIGA_CMD_QUEUE_INVALID_INDEX == p_queue_entry->next_index)
+    {
+        p_optiga->queue_ready_tail[p_queue_entry->priority] = p_queue_entry->previous_index;
+    }
+    else
+    {
+        p_optiga->optiga_cmd_execution_queue[p_queue_entry->next_index].previous_index = p_queue_entry->previous_index;
+    }
+    p_queue_entry->next_index = OPTIGA_CMD_QUEUE_INVALID_INDEX;
+    p_queue_entry->previous_index = OPTIGA_CMD_QUEUE_INVALID_INDEX;
+}
 
-                        // if lock request or session request and session available(either already assigned or available)
-                        if (((p_queue_entry->arrival_time <= reference_time_stamp) && (p_queue_entry->arrival_time >= p_optiga_ctx->last_time_stamp)) &&
-                            (((OPTIGA_CMD_QUEUE_REQUEST_SESSION == p_queue_entry->request_type) && (TRUE == optiga_cmd_session_available(p_optiga_ctx))) ||
-                            ((OPTIGA_CMD_QUEUE_REQUEST_SESSION == p_queue_entry->request_type) && (OPTIGA_CMD_NO_SESSION_OID != ((optiga_cmd_t *)p_queue_entry->registered_ctx)->session_oid)) ||
-                            (OPTIGA_CMD_QUEUE_REQUEST_LOCK == p_queue_entry->request_type) ||
-                            (OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK == p_queue_entry->request_type)))
-                        {
-                            reference_time_stamp = p_queue_entry->arrival_time;
-                            prefered_index = index;
-                        }
-                    }
-                }
-            }
-        } while((0xFF == prefered_index) && (TRUE == overflow_detected));
+#ifdef OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+/*
+* Invokes the watermark callback, once the number of waiting requests reaches the high watermark and once it falls
+* back to the low watermark. The hysteresis between the watermarks avoids a callback for each queued request.
+*/
+_STATIC_H void optiga_cmd_admission_check_watermark(optiga_context_t * p_optiga)
+{
+    uint8_t waiting_requests = p_optiga->queue_state_count[optiga_cmd_queue_get_state_index(OPTIGA_CMD_QUEUE_REQUEST)];
 
-        // Improve : check the index and max queue size check
-        // If slot is identified then go further
-        if (0xFF != prefered_index)
+    if (NULL != p_optiga->watermark_callback)
+    {
+        if ((FALSE == p_optiga->watermark_reached) && (waiting_requests >= p_optiga->watermark_high))
         {
-            p_queue_entry = &(p_optiga_ctx->optiga_cmd_execution_queue[prefered_index]);
-            // assign session
-            if ((OPTIGA_CMD_QUEUE_REQUEST_SESSION == p_optiga_ctx->optiga_cmd_execution_queue[prefered_index].request_type) &&
-                (OPTIGA_CMD_NO_SESSION_OID == ((optiga_cmd_t *)p_queue_entry->registered_ctx)->session_oid))
-            {
-                optiga_cmd_session_assign((optiga_cmd_t *)(p_optiga_ctx->optiga_cmd_execution_queue[prefered_index].registered_ctx));
-                // Improve : Change the state of the type here. This will reduce 0x0000 check
-            }
-
-            // schedule with selected context
-            my_os_event = ((optiga_cmd_t *)(p_optiga_ctx->optiga_cmd_execution_queue[prefered_index].registered_ctx))->p_optiga->p_pal_os_event_ctx;
-            pal_os_event_register_callback_oneshot(my_os_event,
-                                                   optiga_cmd_event_trigger_execute,
-                                                   ((optiga_cmd_t *)(p_optiga_ctx->optiga_cmd_execution_queue[prefered_index].registered_ctx)),
-                                                   OPTIGA_CMD_SCHEDULER_RUNNING_TIME_MS);
-            p_optiga_ctx->optiga_cmd_execution_queue[prefered_index].state_of_entry = OPTIGA_CMD_QUEUE_PROCESSING;
-            p_optiga_ctx->last_time_stamp = reference_time_stamp;
+            p_optiga->watermark_reached = TRUE;
+            p_optiga->watermark_callback(p_optiga->watermark_context, waiting_requests, TRUE);
+        }
+        else if ((TRUE == p_optiga->watermark_reached) && (waiting_requests <= p_optiga->watermark_low))
+        {
+            p_optiga->watermark_reached = FALSE;
+            p_optiga->watermark_callback(p_optiga->watermark_context, waiting_requests, FALSE);
         }
         else
         {
-            pal_os_event_register_callback_oneshot( my_os_event, optiga_cmd_queue_scheduler,
-                                                    p_optiga_ctx,OPTIGA_CMD_SCHEDULER_IDLING_TIME_MS);
+            //watermark is not crossed
         }
     }
 }
+#endif //OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
 
 /*
-* Updates a execution queue slot
+* Changes the state and request type of a slot.
+* All slot transitions must use this, to keep the counters and ready lists consistent.
+* The ready lists are changed by the scheduler context only, the counters are also changed by assign and de-assign.
 */
-_STATIC_H void optiga_cmd_queue_update_slot(optiga_cmd_t * me, uint8_t request_type)
+_STATIC_H void optiga_cmd_queue_set_slot(optiga_context_t * p_optiga,
+                                         uint8_t index,
+                                         uint8_t state_of_entry,
+                                         uint8_t request_type)
 {
-    if ((OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK != me->p_optiga->optiga_cmd_execution_queue[me->queue_id].request_type) ||
-       ((OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK == me->p_optiga->optiga_cmd_execution_queue[me->queue_id].request_type) &&
-       (OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK != request_type)))
+    optiga_cmd_queue_slot_t * p_queue_entry = &p_optiga->optiga_cmd_execution_queue[index];
+
+    // leave the current state
+    optiga_cmd_atomic_decrement_byte(&p_optiga->queue_state_count[optiga_cmd_queue_get_state_index(p_queue_entry->state_of_entry)]);
+    optiga_cmd_atomic_decrement_byte(&p_optiga->queue_request_type_count[optiga_cmd_queue_get_request_type_index(p_queue_entry->request_type)]);
+    if (OPTIGA_CMD_QUEUE_REQUEST == p_queue_entry->state_of_entry)
     {
-        //add time stamp
-        me->p_optiga->optiga_cmd_execution_queue[me->queue_id].arrival_time = pal_os_timer_get_time_in_microseconds();
+        optiga_cmd_queue_ready_list_remove(p_optiga, index);
+    }
+    else if (OPTIGA_CMD_QUEUE_RESUME == p_queue_entry->state_of_entry)
+    {
+        p_optiga->queue_resume_index = OPTIGA_CMD_QUEUE_INVALID_INDEX;
+    }
+    else
+    {
+        //nothing to be done for other states
     }
 
-    //add optiga_cmd ctx
-    me->p_optiga->optiga_cmd_execution_queue[me->queue_id].registered_ctx = (void * )me;
-    // set the state of slot to Requested state
-    if ((OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK == me->p_optiga->optiga_cmd_execution_queue[me->queue_id].request_type) &&
-        (OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK == request_type))
+    // enter the new state
+    p_queue_entry->state_of_entry = state_of_entry;
+    p_queue_entry->request_type = request_type;
+    optiga_cmd_atomic_increment_byte(&p_optiga->queue_state_count[optiga_cmd_queue_get_state_index(state_of_entry)]);
+    optiga_cmd_atomic_increment_byte(&p_optiga->queue_request_type_count[optiga_cmd_queue_get_request_type_index(request_type)]);
+    if (OPTIGA_CMD_QUEUE_REQUEST == state_of_entry)
+    {
+        optiga_cmd_queue_ready_list_append(p_optiga, index);
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+        if (p_optiga->queue_state_count[optiga_cmd_queue_get_state_index(OPTIGA_CMD_QUEUE_REQUEST)] >
+            p_optiga->statistics.max_queue_depth)
+        {
+            p_optiga->statistics.max_queue_depth =
+                p_optiga->queue_state_count[optiga_cmd_queue_get_state_index(OPTIGA_CMD_QUEUE_REQUEST)];
+        }
+#endif //OPTIGA_LIB_STATISTICS_ENABLED
+    }
+    else if (OPTIGA_CMD_QUEUE_RESUME == state_of_entry)
     {
-        me->p_optiga->optiga_cmd_execution_queue[me->queue_id].state_of_entry = OPTIGA_CMD_QUEUE_RESUME;
+        p_optiga->queue_resume_index = index;
     }
     else
     {
-        me->p_optiga->optiga_cmd_execution_queue[me->queue_id].state_of_entry = OPTIGA_CMD_QUEUE_REQUEST;
+        //nothing to be done for other states
     }
-    //add request type
-    me->p_optiga->optiga_cmd_execution_queue[me->queue_id].request_type = request_type;
+#ifdef OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+    optiga_cmd_admission_check_watermark(p_optiga);
+#endif //OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
 }
 
 /*
-* Resets a execution slot
+* Returns the count of number of slots with requested state
 */
-_STATIC_H void optiga_cmd_queue_reset_slot(const optiga_cmd_t * me)
+_STATIC_H  uint8_t optiga_cmd_queue_get_count_of(const optiga_context_t * p_optiga,
+                                                 uint8_t slot_member,
+                                                 uint8_t state_to_check)
 {
-    // Reset the arrival time
-    me->p_optiga->optiga_cmd_execution_queue[me->queue_id].arrival_time = 0xFFFFFFFF;
-    //add optiga_cmd ctx
-    me->p_optiga->optiga_cmd_execution_queue[me->queue_id].registered_ctx = NULL;
-    //add request type
-    me->p_optiga->optiga_cmd_execution_queue[me->queue_id].request_type = 0;
-    // set the slot state to assigned
-    me->p_optiga->optiga_cmd_execution_queue[me->queue_id].state_of_entry = OPTIGA_CMD_QUEUE_ASSIGNED;
-    // start the event scheduler
-    pal_os_event_start(me->p_optiga->p_pal_os_event_ctx, optiga_cmd_queue_scheduler, me->p_optiga);
+    uint8_t count = 0;
+    switch (slot_member)
+    {
+        case OPTIGA_CMD_QUEUE_SLOT_LOCK_TYPE:
+        {
+            count = p_optiga->queue_request_type_count[optiga_cmd_queue_get_request_type_index(state_to_check)];
+        }
+        break;
+        case OPTIGA_CMD_QUEUE_SLOT_STATE:
+        {
+            count = p_optiga->queue_state_count[optiga_cmd_queue_get_state_index(state_to_check)];
+        }
+        break;
+        default:
+            break;
+    }
+    return (count);
 }
 
-
 /*
-* Release the strict lock associated with instance
+* Assigns an available slot to a optiga cmd instance and marks the slot as not available for another optiga cmd instance.
+* The slot is claimed atomically, since instances can be created concurrently from several threads
 */
-_STATIC_H void optiga_cmd_release_strict_lock(const optiga_cmd_t * me)
+_STATIC_H void optiga_cmd_queue_assign_slot(const optiga_cmd_t * me, uint8_t * queue_index_store)
 {
-    me->p_optiga->optiga_cmd_execution_queue[me->queue_id].state_of_entry = OPTIGA_CMD_QUEUE_ASSIGNED;
-    me->p_optiga->optiga_cmd_execution_queue[me->queue_id].request_type = OPTIGA_CMD_QUEUE_NO_REQUEST;
+    optiga_cmd_queue_slot_t * p_queue_entry;
+    uint8_t index;
+    for (index = 0; index < me->p_optiga->queue_size ; index++)
+    {
+        p_queue_entry = &me->p_optiga->optiga_cmd_execution_queue[index];
+        if (TRUE == optiga_cmd_atomic_compare_exchange_byte(&p_queue_entry->state_of_entry,
+                                                            OPTIGA_CMD_QUEUE_NOT_ASSIGNED,
+                                                            OPTIGA_CMD_QUEUE_ASSIGNED))
+        {
+            * queue_index_store =  index;
+            // the slot is claimed, account the transition from not assigned
+            optiga_cmd_atomic_decrement_byte(&me->p_optiga->queue_state_count[optiga_cmd_queue_get_state_index(OPTIGA_CMD_QUEUE_NOT_ASSIGNED)]);
+            optiga_cmd_atomic_increment_byte(&me->p_optiga->queue_state_count[optiga_cmd_queue_get_state_index(OPTIGA_CMD_QUEUE_ASSIGNED)]);
+           break;
+        }
+    }
 }
 
-optiga_lib_status_t optiga_cmd_request_session(optiga_cmd_t * me)
+/*
+* De-assigns a slot from a optiga cmd instance and makes the slot available for next optiga cmd instance
+*/
+_STATIC_H void optiga_cmd_queue_deassign_slot(optiga_cmd_t * me)
 {
-    optiga_cmd_queue_update_slot(me , OPTIGA_CMD_QUEUE_REQUEST_SESSION);
-    return (OPTIGA_CMD_SUCCESS);
+    optiga_cmd_queue_set_slot(me->p_optiga, me->queue_id, OPTIGA_CMD_QUEUE_NOT_ASSIGNED, OPTIGA_CMD_QUEUE_NO_REQUEST);
+    me->queue_id = 0;
 }
 
-optiga_lib_status_t optiga_cmd_release_session(optiga_cmd_t * me)
-{
-    optiga_cmd_session_free(me);
-    return (OPTIGA_CMD_SUCCESS);
-}
+#ifdef OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+_STATIC_H void optiga_cmd_queue_scheduler(void * p_optiga);
 
-optiga_lib_status_t optiga_cmd_request_lock(optiga_cmd_t * me, uint8_t lock_type)
+/*
+* Wakes up the scheduler, if it is parked
+* The os event is not owned by any other optiga cmd instance while scheduler is parked.
+* Only one of the concurrent wakeups registers the scheduler.
+*/
+_STATIC_H void optiga_cmd_queue_scheduler_wakeup(optiga_context_t * p_optiga)
 {
-    optiga_cmd_queue_update_slot(me , lock_type);
-    return (OPTIGA_CMD_SUCCESS);
+    if (TRUE == optiga_cmd_atomic_exchange_byte(&p_optiga->scheduler_parked, FALSE))
+    {
+        PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(p_optiga->p_pal_os_event_ctx,
+                                               optiga_cmd_queue_scheduler,
+                                               p_optiga,
+                                               OPTIGA_CMD_SCHEDULER_WAKEUP_TIME_MS);
+    }
 }
+#endif //OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
 
-optiga_lib_status_t optiga_cmd_release_lock(const optiga_cmd_t * me)
+/*
+* Appends a slot to the submission queue. This is safe to be called concurrently by several requesters,
+* the scheduler waits on a link which is not completed yet.
+*/
+_STATIC_H void optiga_cmd_queue_push_submission(optiga_context_t * p_optiga, optiga_cmd_queue_slot_t * p_queue_entry)
 {
-    optiga_cmd_queue_reset_slot(me);
-    return (OPTIGA_CMD_SUCCESS);
+    optiga_cmd_queue_slot_t * p_previous;
+
+    optiga_cmd_atomic_store_slot(&p_queue_entry->p_next_submission, NULL);
+    p_previous = optiga_cmd_atomic_exchange_slot(&p_optiga->submission_tail, p_queue_entry);
+    optiga_cmd_atomic_store_slot(&p_previous->p_next_submission, p_queue_entry);
 }
 
-_STATIC_H optiga_lib_status_t optiga_cmd_restore_context(const optiga_cmd_t * me)
+/*
+* Removes the oldest slot from the submission queue. Called by the scheduler only.
+* Returns NULL, if the queue is empty or the oldest submission is not completely linked yet
+*/
+_STATIC_H optiga_cmd_queue_slot_t * optiga_cmd_queue_pop_submission(optiga_context_t * p_optiga)
 {
-#define OPTIGA_CMD_OF_CONTEXT_HANDLE_4TH_BYTE         (0x04)
-    uint16_t context_handle_length;
-    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR;
+    optiga_cmd_queue_slot_t * p_head = p_optiga->submission_head;
+    optiga_cmd_queue_slot_t * p_next = optiga_cmd_atomic_load_slot(&p_head->p_next_submission);
+    optiga_cmd_queue_slot_t * p_submission = NULL;
+
     do
     {
-        if (OPTIGA_LIB_PAL_DATA_STORE_NOT_CONFIGURED != me->optiga_context_datastore_id)
+        if (&p_optiga->submission_stub == p_head)
         {
-            context_handle_length = sizeof(me->p_optiga->optiga_context_handle_buffer);
-            //Reading context handle secret from datastore
-            return_status = pal_os_datastore_read(me->optiga_context_datastore_id,
-                                                  me->p_optiga->optiga_context_handle_buffer,
-                                                  &context_handle_length);
-            if (PAL_STATUS_SUCCESS != return_status)
+            if (NULL == p_next)
             {
                 break;
             }
+            // skip the placeholder
+            p_optiga->submission_head = p_next;
+            p_head = p_next;
+            p_next = optiga_cmd_atomic_load_slot(&p_head->p_next_submission);
         }
-        // Check for valid context value
-        if (0 == optiga_common_get_uint32(me->p_optiga->optiga_context_handle_buffer) &&
-            0 == optiga_common_get_uint32(&me->p_optiga->optiga_context_handle_buffer[OPTIGA_CMD_OF_CONTEXT_HANDLE_4TH_BYTE]))
-        {
-            return_status = OPTIGA_CMD_ERROR;
-            break;
-        }
-
-        return_status = OPTIGA_LIB_SUCCESS;
-    } while (FALSE);
-#undef OPTIGA_CMD_OFFSET_OF_NEXT_BYTE
-    return (return_status);
-}
-_STATIC_H optiga_lib_status_t optiga_cmd_store_context(const optiga_cmd_t * me)
-{
-    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR;
-    do
-    {
-        if (OPTIGA_LIB_PAL_DATA_STORE_NOT_CONFIGURED != me->optiga_context_datastore_id)
+        if (NULL == p_next)
         {
-            //Reading context handle secret from datastore
-            return_status = pal_os_datastore_write(me->optiga_context_datastore_id,
-                                                   me->p_optiga->optiga_context_handle_buffer,
-                                                   sizeof(me->p_optiga->optiga_context_handle_buffer));
-            if (PAL_STATUS_SUCCESS != return_status)
+            if (p_head != optiga_cmd_atomic_load_slot(&p_optiga->submission_tail))
+            {
+                // a requester is linking the next submission, it is picked in next scheduler run
+                break;
+            }
+            // last submission, the placeholder is appended to keep the queue linked
+            optiga_cmd_queue_push_submission(p_optiga, &p_optiga->submission_stub);
+            p_next = optiga_cmd_atomic_load_slot(&p_head->p_next_submission);
+            if (NULL == p_next)
             {
                 break;
             }
         }
-
-        return_status = OPTIGA_LIB_SUCCESS;
+        p_optiga->submission_head = p_next;
+        p_submission = p_head;
     } while (FALSE);
-    return (return_status);
+
+    return (p_submission);
 }
 
-#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
-_STATIC_H void optiga_cmd_clear_app_ctx(void * p_ctx)
+/*
+* Moves the pending submissions to the execution queue. Called by the scheduler only, which is the only context
+* changing the ready lists.
+*/
+_STATIC_H void optiga_cmd_queue_apply_submissions(optiga_context_t * p_optiga)
 {
-    optiga_cmd_t * me = (optiga_cmd_t *)p_ctx;
-    /*In the case of hibernate if any low level error occurs while performing
-      close application this section clears the saved application context.*/
-    if ((OPTIGA_CMD_PARAM_INITIALIZE_APP_CONTEXT != me->cmd_param) &&
-        (OPTIGA_COMMS_SESSION_CONTEXT_SAVE == me->manage_context_operation))
+    optiga_cmd_queue_slot_t * p_queue_entry = optiga_cmd_queue_pop_submission(p_optiga);
+    uint8_t request_type;
+    uint8_t index;
+
+    while (NULL != p_queue_entry)
     {
-        pal_os_memset(me->p_optiga->optiga_context_handle_buffer,0,
-                        sizeof(me->p_optiga->optiga_context_handle_buffer));
-        if ((OPTIGA_HIBERNATE_CONTEXT_ID == me->optiga_context_datastore_id) &&
-            (OPTIGA_LIB_PAL_DATA_STORE_NOT_CONFIGURED != me->optiga_context_datastore_id))
+        index = (uint8_t)(p_queue_entry - p_optiga->optiga_cmd_execution_queue);
+        request_type = p_queue_entry->submitted_request_type;
+
+        // strict lock holder keeps its arrival time and resumes
+        if ((OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK != p_queue_entry->request_type) ||
+            (OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK != request_type))
         {
-            //Clearing context handle secret from datastore
-            me->exit_status = pal_os_datastore_write(me->optiga_context_datastore_id,
-                                                     me->p_optiga->optiga_context_handle_buffer,
-                                                     sizeof(me->p_optiga->optiga_context_handle_buffer));
-            if (PAL_STATUS_SUCCESS != me->exit_status)
-            {
-                me->cmd_next_execution_state = OPTIGA_CMD_EXEC_ERROR_HANDLER;
-            }
+            //add time stamp
+            p_queue_entry->arrival_time = p_queue_entry->submitted_time;
+        }
+        //add optiga_cmd ctx
+        p_queue_entry->registered_ctx = p_queue_entry->submitted_ctx;
+        //add priority class
+        p_queue_entry->priority = ((optiga_cmd_t *)p_queue_entry->submitted_ctx)->priority;
+#ifdef OPTIGA_CMD_FAIR_SHARE_ENABLED
+        //add tenant
+        p_queue_entry->tenant = ((optiga_cmd_t *)p_queue_entry->submitted_ctx)->tenant;
+#endif //OPTIGA_CMD_FAIR_SHARE_ENABLED
+#ifdef OPTIGA_CMD_DEADLINE_ENABLED
+        //add deadline, relative to the arrival time
+        p_queue_entry->deadline = ((optiga_cmd_t *)p_queue_entry->submitted_ctx)->deadline_us;
+#endif //OPTIGA_CMD_DEADLINE_ENABLED
+#ifdef OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+        //add maximum delay of a deferrable request, relative to the arrival time
+        p_queue_entry->defer_delay = ((optiga_cmd_t *)p_queue_entry->submitted_ctx)->defer_delay_us;
+#endif //OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+        // set the state of slot to Requested state and add request type
+        if ((OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK == p_queue_entry->request_type) &&
+            (OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK == request_type))
+        {
+            optiga_cmd_queue_set_slot(p_optiga, index, OPTIGA_CMD_QUEUE_RESUME, request_type);
+        }
+        else
+        {
+            optiga_cmd_queue_set_slot(p_optiga, index, OPTIGA_CMD_QUEUE_REQUEST, request_type);
+#ifdef OPTIGA_CMD_FAIR_SHARE_ENABLED
+            p_optiga->tenant_waiting_count[p_queue_entry->tenant]++;
+#endif //OPTIGA_CMD_FAIR_SHARE_ENABLED
         }
+        p_queue_entry = optiga_cmd_queue_pop_submission(p_optiga);
     }
 }
-#endif
 
-_STATIC_H void optiga_cmd_execute_comms_open(optiga_cmd_t * me, uint8_t * exit_loop)
+#ifdef OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+/*
+* Returns TRUE, if a submission is pending in the submission queue
+*/
+_STATIC_H bool_t optiga_cmd_queue_has_submission(optiga_context_t * p_optiga)
 {
-    do
+    return (((&p_optiga->submission_stub != p_optiga->submission_head) ||
+             (&p_optiga->submission_stub != optiga_cmd_atomic_load_slot(&p_optiga->submission_tail))) ? TRUE : FALSE);
+}
+
+/*
+* Parks the scheduler. No callback is registered until the scheduler is woken up again.
+* A request submitted while parking wakes up the scheduler again.
+*/
+_STATIC_H void optiga_cmd_queue_scheduler_park(optiga_context_t * p_optiga)
+{
+    uint32_t time_left_us = 0;
+
+    PAL_OS_EVENT_STOP(p_optiga->p_pal_os_event_ctx);
+#ifdef OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+    // scheduler is run again at the end of the idle time, to hibernate the application
+    time_left_us = p_optiga->auto_hibernate_time_left_us;
+#endif //OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+#ifdef OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+    // scheduler is run again at the end of the hold time, to revoke the strict lock
+    if ((0 != p_optiga->strict_lock_time_left_us) &&
+        ((0 == time_left_us) || (p_optiga->strict_lock_time_left_us < time_left_us)))
     {
-        *exit_loop = TRUE;
-        switch (me->cmd_sub_execution_state)
-        {
-            case OPTIGA_CMD_EXEC_COMMS_OPEN_ACQUIRE_LOCK:
-            {
+        time_left_us = p_optiga->strict_lock_time_left_us;
+    }
+#endif //OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+    if (0 != time_left_us)
+    {
+        PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(p_optiga->p_pal_os_event_ctx,
+                                               optiga_cmd_queue_scheduler,
+                                               p_optiga,
+                                               time_left_us);
+    }
+    (void)optiga_cmd_atomic_exchange_byte(&p_optiga->scheduler_parked, TRUE);
+    if (TRUE == optiga_cmd_queue_has_submission(p_optiga))
+    {
+        optiga_cmd_queue_scheduler_wakeup(p_optiga);
+    }
+}
+#endif //OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
 
-                // add to queue and exit
-                me->exit_status = optiga_cmd_request_lock(me, OPTIGA_CMD_QUEUE_REQUEST_LOCK);
-                if (OPTIGA_LIB_SUCCESS != me->exit_status)
-                {
-                    EXIT_STATE_WITH_ERROR(me,*exit_loop);
-                    break;
-                }
-                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_COMMS_OPEN_START;
-                break;
-            }
-            case OPTIGA_CMD_EXEC_COMMS_OPEN_START:
-            {
-#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
-                me->p_optiga->p_optiga_comms->protection_level =  me->protection_level;
-                me->p_optiga->p_optiga_comms->protocol_version = me->protocol_version;
-                me->p_optiga->p_optiga_comms->manage_context_operation = me->manage_context_operation;
-                me->p_optiga->p_optiga_comms->p_pal_os_event_ctx = me->p_optiga->p_pal_os_event_ctx;
-#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+/*
+* Returns the priority class of a queued request after aging.
+* The request is promoted by one class for every OPTIGA_CMD_PRIORITY_AGING_TIME_US it has waited
+*/
+_STATIC_H uint8_t optiga_cmd_queue_get_effective_priority(const optiga_cmd_queue_slot_t * p_queue_entry,
+                                                          uint32_t wait_time)
+{
+    uint32_t promotion = wait_time / OPTIGA_CMD_PRIORITY_AGING_TIME_US;
 
-                (void)optiga_comms_set_callback_context(me->p_optiga->p_optiga_comms, me);
-                me->exit_status = optiga_comms_open(me->p_optiga->p_optiga_comms);
+    return ((promotion >= p_queue_entry->priority) ? (uint8_t)OPTIGA_LIB_PRIORITY_HIGH :
+                                                     (uint8_t)(p_queue_entry->priority - promotion));
+}
 
-                if (OPTIGA_LIB_SUCCESS != me->exit_status)
-                {
-                    EXIT_STATE_WITH_ERROR(me,*exit_loop);
-                    break;
-                }
-                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_COMMS_OPEN_DONE;
+/*
+* Records the waiting time of a dispatched request for its priority class
+*/
+_STATIC_H void optiga_cmd_queue_update_wait_stats(optiga_context_t * p_optiga,
+                                                  const optiga_cmd_queue_slot_t * p_queue_entry,
+                                                  uint32_t wait_time)
+{
+    optiga_lib_queue_wait_stats_t * p_stats = &p_optiga->queue_wait_stats[p_queue_entry->priority];
+
+    p_stats->served_requests++;
+    p_stats->total_wait_time_us += wait_time;
+    if (wait_time > p_stats->max_wait_time_us)
+    {
+        p_stats->max_wait_time_us = wait_time;
+    }
+}
+
+#ifdef OPTIGA_CMD_FAIR_SHARE_ENABLED
+/*
+* Returns TRUE, if the tenant of the request has consumed less OPTIGA time relative to its weight than the tenant of
+* the other request. The virtual times are compared as difference, which also holds if they have overflowed
+*/
+_STATIC_H bool_t optiga_cmd_fair_share_precedes(const optiga_context_t * p_optiga,
+                                                const optiga_cmd_queue_slot_t * p_queue_entry,
+                                                const optiga_cmd_queue_slot_t * p_other_entry)
+{
+    return ((0 > (int32_t)(p_optiga->tenant_virtual_time[p_queue_entry->tenant] -
+                           p_optiga->tenant_virtual_time[p_other_entry->tenant])) ? TRUE : FALSE);
+}
+
+/*
+* Advances the virtual time to the tenant of the dispatched request. The idle tenants are brought to the virtual time,
+* hence a tenant does not gain a credit for the time it had no request waiting.
+*/
+_STATIC_H void optiga_cmd_fair_share_dispatch(optiga_context_t * p_optiga, const optiga_cmd_queue_slot_t * p_queue_entry)
+{
+    uint8_t tenant = p_queue_entry->tenant;
+
+    p_optiga->tenant_waiting_count[tenant]--;
+    p_optiga->tenant_stats[tenant].served_requests++;
+    if (0 < (int32_t)(p_optiga->tenant_virtual_time[tenant] - p_optiga->fair_share_virtual_time))
+    {
+        p_optiga->fair_share_virtual_time = p_optiga->tenant_virtual_time[tenant];
+    }
+    for (tenant = 0; tenant < OPTIGA_CMD_FAIR_SHARE_MAX_TENANTS; tenant++)
+    {
+        if ((0 == p_optiga->tenant_waiting_count[tenant]) &&
+            (0 > (int32_t)(p_optiga->tenant_virtual_time[tenant] - p_optiga->fair_share_virtual_time)))
+        {
+            p_optiga->tenant_virtual_time[tenant] = p_optiga->fair_share_virtual_time;
+        }
+    }
+}
+
+/*
+* Charges the OPTIGA time of the exchanged APDU to the tenant of the instance, on reception of the response from comms
+*/
+_STATIC_H void optiga_cmd_fair_share_update(const optiga_cmd_t * me)
+{
+    optiga_context_t * p_optiga = me->p_optiga;
+    uint32_t device_time_us = pal_os_timer_get_time_in_microseconds() - p_optiga->fair_share_start_time;
+
+    p_optiga->tenant_stats[me->tenant].commands++;
+    p_optiga->tenant_stats[me->tenant].device_time_us += device_time_us;
+    if (OPTIGA_CMD_FAIR_SHARE_MAX_CHARGE_US < device_time_us)
+    {
+        device_time_us = OPTIGA_CMD_FAIR_SHARE_MAX_CHARGE_US;
+    }
+    p_optiga->tenant_virtual_time[me->tenant] += (device_time_us << OPTIGA_CMD_FAIR_SHARE_VIRTUAL_TIME_SHIFT) /
+                                                 OPTIGA_CMD_FAIR_SHARE_WEIGHT(p_optiga, me->tenant);
+}
+#endif //OPTIGA_CMD_FAIR_SHARE_ENABLED
+
+#ifdef OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+/*
+* Records the time a request is served, from its dispatch till the release of its slot, in the average service time
+*/
+_STATIC_H void optiga_cmd_admission_update_service_time(optiga_context_t * p_optiga, optiga_cmd_queue_slot_t * p_queue_entry)
+{
+    uint32_t service_time_us;
+
+    if (0U != p_queue_entry->dispatch_time)
+    {
+        service_time_us = pal_os_timer_get_time_in_microseconds() - p_queue_entry->dispatch_time;
+        p_queue_entry->dispatch_time = 0;
+        if (0U == p_optiga->service_time_us)
+        {
+            p_optiga->service_time_us = service_time_us;
+        }
+        else if (service_time_us > p_optiga->service_time_us)
+        {
+            p_optiga->service_time_us += ((service_time_us - p_optiga->service_time_us) >> OPTIGA_CMD_ADMISSION_SERVICE_TIME_SHIFT);
+        }
+        else
+        {
+            p_optiga->service_time_us -= ((p_optiga->service_time_us - service_time_us) >> OPTIGA_CMD_ADMISSION_SERVICE_TIME_SHIFT);
+        }
+    }
+}
+
+/*
+* Returns the estimated waiting time in microseconds of a request, which is queued now.
+* The request waits for the waiting requests and the request in service, each served with the average service time.
+*/
+_STATIC_H uint32_t optiga_cmd_admission_estimate_wait(const optiga_context_t * p_optiga)
+{
+    uint32_t service_time_us = p_optiga->service_time_us;
+    uint32_t requests_ahead = (uint32_t)p_optiga->queue_state_count[optiga_cmd_queue_get_state_index(OPTIGA_CMD_QUEUE_REQUEST)] +
+                              p_optiga->queue_state_count[optiga_cmd_queue_get_state_index(OPTIGA_CMD_QUEUE_RESUME)] +
+                              p_optiga->queue_state_count[optiga_cmd_queue_get_state_index(OPTIGA_CMD_QUEUE_PROCESSING)];
+
+    if (0U == service_time_us)
+    {
+        service_time_us = OPTIGA_CMD_ADMISSION_DEFAULT_SERVICE_TIME_US;
+    }
+    return (((0U != requests_ahead) && ((0xFFFFFFFFU / requests_ahead) < service_time_us)) ?
+            0xFFFFFFFFU : (requests_ahead * service_time_us));
+}
+#endif //OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+
+#if defined (OPTIGA_CMD_DEADLINE_ENABLED) || defined (OPTIGA_CMD_CANCEL_ENABLED)
+/*
+* Returns a queued request, which is cancelled or whose deadline has elapsed while waiting,
+* OPTIGA_CMD_QUEUE_INVALID_INDEX if none. The status to complete the request with is returned in p_drop_status.
+* The expiry is calculated as difference to the arrival time, which also holds if the time stamp has overflowed
+*/
+//lint --e{715} suppress "The current_time_stamp is not referenced, if the deadline is disabled"
+_STATIC_H uint8_t optiga_cmd_queue_get_dropped(const optiga_context_t * p_optiga,
+                                               uint32_t current_time_stamp,
+                                               optiga_lib_status_t * p_drop_status)
+{
+    const optiga_cmd_queue_slot_t * p_queue_entry;
+    uint8_t dropped_index = OPTIGA_CMD_QUEUE_INVALID_INDEX;
+    uint8_t priority;
+    uint8_t index;
+
+    for (priority = 0; (OPTIGA_CMD_QUEUE_INVALID_INDEX == dropped_index) && (priority < OPTIGA_LIB_NUMBER_OF_PRIORITIES); priority++)
+    {
+        index = p_optiga->queue_ready_head[priority];
+        while (OPTIGA_CMD_QUEUE_INVALID_INDEX != index)
+        {
+            p_queue_entry = &(p_optiga->optiga_cmd_execution_queue[index]);
+#ifdef OPTIGA_CMD_CANCEL_ENABLED
+            if (TRUE == ((optiga_cmd_t *)p_queue_entry->registered_ctx)->cancel_requested)
+            {
+                *p_drop_status = OPTIGA_CMD_ERROR_CANCELLED;
+                dropped_index = index;
                 break;
             }
-            case OPTIGA_CMD_EXEC_COMMS_OPEN_DONE:
+#endif //OPTIGA_CMD_CANCEL_ENABLED
+#ifdef OPTIGA_CMD_DEADLINE_ENABLED
+            if ((0U != p_queue_entry->deadline) &&
+                ((current_time_stamp - p_queue_entry->arrival_time) >= p_queue_entry->deadline))
             {
-                pal_os_event_register_callback_oneshot(me->p_optiga->p_pal_os_event_ctx,
-                                                       (register_callback)optiga_cmd_event_trigger_execute,
-                                                       me, OPTIGA_CMD_SCHEDULER_RUNNING_TIME_MS);
-                me->cmd_next_execution_state = OPTIGA_CMD_EXEC_PREPARE_COMMAND;
-                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_PREPARE_APDU;
+                *p_drop_status = OPTIGA_CMD_ERROR_DEADLINE_EXPIRED;
+                dropped_index = index;
                 break;
             }
-            default:
-                EXIT_STATE_WITH_ERROR(me,*exit_loop);
-            break;
-            //lint --e{788} suppress "Not all states are used as same enum is used for both main and sub state machine."
+#endif //OPTIGA_CMD_DEADLINE_ENABLED
+            index = p_queue_entry->next_index;
         }
+    }
+    return (dropped_index);
+}
+#endif
 
-    } while ((FALSE == *exit_loop) && (OPTIGA_CMD_EXEC_COMMS_OPEN == me->cmd_next_execution_state));
+#if defined (OPTIGA_COMMS_SHIELDED_CONNECTION) && defined (OPTIGA_COMMS_KEY_ROLLOVER_ENABLED)
+_STATIC_H void optiga_cmd_queue_scheduler(void * p_optiga);
+
+/*
+* Completes the session key rollover and resumes the scheduler.
+* A failed rollover is not reported, the session is established again with the next protected command.
+*/
+_STATIC_H void optiga_cmd_key_rollover_handler(void * p_ctx, optiga_lib_status_t event)
+{
+    optiga_context_t * p_optiga = (optiga_context_t *)p_ctx;
+
+    // The event is not required, as a failed rollover is handled by the next protected command
+    (void)event;
+    (void)optiga_comms_set_callback_handler(p_optiga->p_optiga_comms, optiga_cmd_execute_handler);
+    p_optiga->key_rollover_ongoing = FALSE;
+#ifdef OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+    PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(p_optiga->p_pal_os_event_ctx,
+                                           optiga_cmd_queue_scheduler,
+                                           p_optiga,
+                                           OPTIGA_CMD_SCHEDULER_WAKEUP_TIME_MS);
+#else
+    PAL_OS_EVENT_START(p_optiga->p_pal_os_event_ctx, optiga_cmd_queue_scheduler, p_optiga);
+#endif //OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
 }
 
-_STATIC_H void optiga_cmd_execute_comms_close(optiga_cmd_t * me, uint8_t * exit_loop)
+/*
+* Starts the session key rollover, if it is due and comms is not used by any instance.
+* This is done in between the commands, hence no command waits for the handshake.
+* Returns TRUE, if the rollover is started. The scheduler is resumed on completion of the rollover.
+*/
+_STATIC_H bool_t optiga_cmd_key_rollover_start(optiga_context_t * p_optiga)
 {
+    bool_t rollover_started = FALSE;
+
     do
     {
-        *exit_loop = TRUE;
-        switch (me->cmd_sub_execution_state)
+        // a strict lock holder keeps the comms in between its commands
+        if ((0 != optiga_cmd_queue_get_count_of(p_optiga, OPTIGA_CMD_QUEUE_SLOT_STATE, OPTIGA_CMD_QUEUE_PROCESSING)) ||
+            (0 != optiga_cmd_queue_get_count_of(p_optiga, OPTIGA_CMD_QUEUE_SLOT_LOCK_TYPE, OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK)) ||
+            (FALSE == optiga_comms_rollover_due(p_optiga->p_optiga_comms)))
         {
-            case OPTIGA_CMD_EXEC_COMMS_CLOSE_START:
-            {
-#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
-                // In case PRL is enabled and save context is not invoked or is PRL is not enabled,
-                //change state to OPTIGA_CMD_EXEC_COMMS_CLOSE_DONE, since it synchronous in nature
-                if (OPTIGA_COMMS_SESSION_CONTEXT_SAVE != me->manage_context_operation)
-                {
-                    me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_COMMS_CLOSE_DONE;
-                }
-                me->p_optiga->p_optiga_comms->protection_level =  me->protection_level;
-                me->p_optiga->p_optiga_comms->protocol_version = me->protocol_version;
-                if (0 != me->p_optiga->protection_level_state)
-                {
-                    me->p_optiga->p_optiga_comms->manage_context_operation = me->manage_context_operation;
-                }
-                else
-                {
-                    me->p_optiga->p_optiga_comms->manage_context_operation = OPTIGA_COMMS_SESSION_CONTEXT_NONE;
-                }
-                me->p_optiga->protection_level_state = 0;
-#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
-                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_COMMS_CLOSE_DONE;
-
-                me->p_optiga->p_optiga_comms->p_pal_os_event_ctx = me->p_optiga->p_pal_os_event_ctx;
-
-                (void)optiga_comms_set_callback_context(me->p_optiga->p_optiga_comms, me);
-                me->exit_status = optiga_comms_close(me->p_optiga->p_optiga_comms);
+            break;
+        }
+        PAL_OS_EVENT_STOP(p_optiga->p_pal_os_event_ctx);
+        p_optiga->key_rollover_ongoing = TRUE;
+        (void)optiga_comms_set_callback_handler(p_optiga->p_optiga_comms, optiga_cmd_key_rollover_handler);
+        (void)optiga_comms_set_callback_context(p_optiga->p_optiga_comms, p_optiga);
+        p_optiga->p_optiga_comms->p_pal_os_event_ctx = p_optiga->p_pal_os_event_ctx;
+        if (OPTIGA_COMMS_SUCCESS != optiga_comms_rollover(p_optiga->p_optiga_comms))
+        {
+            (void)optiga_comms_set_callback_handler(p_optiga->p_optiga_comms, optiga_cmd_execute_handler);
+            p_optiga->key_rollover_ongoing = FALSE;
+            break;
+        }
+        rollover_started = TRUE;
+    } while (FALSE);
 
-                if (OPTIGA_LIB_SUCCESS != me->exit_status)
-                {
-                    EXIT_STATE_WITH_ERROR(me,*exit_loop);
-                    break;
-                }
+    return (rollover_started);
+}
+#endif
 
+#ifdef OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+/*
+* Opens the application with the internal instance, with or without restore of the hibernated application
+*/
+_STATIC_H void optiga_cmd_auto_hibernate_open(const optiga_context_t * p_optiga, uint8_t perform_restore)
+{
 #ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
-                // In case PRL is enabled and save context is requested,
-                //change state to OPTIGA_CMD_EXEC_COMMS_CLOSE_DONE, since it asynchronous in nature
-                if (OPTIGA_COMMS_SESSION_CONTEXT_SAVE == me->manage_context_operation)
-                {
-                    me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_COMMS_CLOSE_DONE;
-                    *exit_loop = TRUE;
-                }
-                // For synchronous behavior: After exit from optiga_comms_close, release lock
-                else
-                {
-                    me->exit_status = optiga_cmd_release_lock(me);
-                }
-#else
-                me->exit_status = optiga_cmd_release_lock(me);
+    optiga_cmd_set_shielded_connection_option(p_optiga->p_auto_hibernate_cmd,
+                                              OPTIGA_COMMS_DEFAULT_PROTECTION_LEVEL,
+                                              OPTIGA_SET_PROTECTION_LEVEL);
+    optiga_cmd_set_shielded_connection_option(p_optiga->p_auto_hibernate_cmd,
+                                              OPTIGA_COMMS_PROTOCOL_VERSION_PRE_SHARED_SECRET,
+                                              OPTIGA_SET_PROTECTION_VERSION);
+    optiga_cmd_set_shielded_connection_option(p_optiga->p_auto_hibernate_cmd,
+                                              ((TRUE == perform_restore) ? OPTIGA_COMMS_SESSION_CONTEXT_RESTORE :
+                                                                           OPTIGA_COMMS_SESSION_CONTEXT_NONE),
+                                              OPTIGA_SET_MANAGE_CONTEXT);
 #endif //OPTIGA_COMMS_SHIELDED_CONNECTION
-                break;
+    //lint --e{534} suppress "The status is reported to the handler of the internal instance"
+    optiga_cmd_open_application(p_optiga->p_auto_hibernate_cmd, perform_restore, NULL);
+}
+
+/*
+* Completes the hibernate or restore of the application, executed with the internal instance.
+* A failed restore is retried with a clean application context, hence the queued requests are served in any case.
+*/
+_STATIC_H void optiga_cmd_auto_hibernate_handler(void * p_ctx, optiga_lib_status_t event)
+{
+    optiga_context_t * p_optiga = (optiga_context_t *)p_ctx;
+    optiga_lib_auto_hibernate_stats_t * p_stats = &p_optiga->auto_hibernate_stats;
+    uint32_t restore_time_us;
+
+    switch (p_optiga->auto_hibernate_state)
+    {
+        case OPTIGA_CMD_AUTO_HIBERNATE_HIBERNATING:
+        {
+            p_optiga->auto_hibernate_state = OPTIGA_CMD_AUTO_HIBERNATE_IDLE;
+            // Once the close application is accepted, the context is saved on OPTIGA, even if the comms close fails
+            if ((OPTIGA_LIB_SUCCESS == event) || (OPTIGA_CMD_APP_STATE_CLOSED == p_optiga->app_state))
+            {
+                p_optiga->app_state = OPTIGA_CMD_APP_STATE_HIBERNATED;
+                p_stats->hibernates++;
             }
-            case OPTIGA_CMD_EXEC_COMMS_CLOSE_DONE:
+            else
             {
-                me->handler(me->caller_context, OPTIGA_LIB_SUCCESS);
-#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
-                // For asynchronous behavior, change state to release the lock
-                if (OPTIGA_COMMS_SESSION_CONTEXT_SAVE == me->manage_context_operation)
+                // Hibernate is tried again after the next idle time
+                p_stats->failed_hibernates++;
+            }
+            break;
+        }
+        case OPTIGA_CMD_AUTO_HIBERNATE_RESTORING:
+        {
+            if (OPTIGA_LIB_SUCCESS == event)
+            {
+                p_optiga->auto_hibernate_state = OPTIGA_CMD_AUTO_HIBERNATE_IDLE;
+                restore_time_us = pal_os_timer_get_time_in_microseconds() - p_optiga->auto_restore_start_time;
+                p_stats->restores++;
+                p_stats->last_restore_time_us = restore_time_us;
+                if (restore_time_us > p_stats->max_restore_time_us)
                 {
-                    me->exit_status = optiga_cmd_release_lock(me);
+                    p_stats->max_restore_time_us = restore_time_us;
                 }
-#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
-                break;
             }
-            default:
-                EXIT_STATE_WITH_ERROR(me,*exit_loop);
+            else
+            {
+                p_stats->failed_restores++;
+                p_optiga->auto_hibernate_state = OPTIGA_CMD_AUTO_HIBERNATE_REOPENING;
+                optiga_cmd_auto_hibernate_open(p_optiga, FALSE);
+            }
             break;
-            //lint --e{788} suppress "Not all states are used as same enum is used for both main and sub state machine."
         }
-    } while ((FALSE == *exit_loop) && (OPTIGA_CMD_EXEC_COMMS_CLOSE == me->cmd_next_execution_state));
-}
-
-_STATIC_H void optiga_cmd_execute_prepare_command(optiga_cmd_t * me, uint8_t * exit_loop)
-{
-    optiga_cmd_handler_t optiga_cmd_handler = me->cmd_hdlrs;
-    do
-    {
-        switch (me->cmd_sub_execution_state)
+        case OPTIGA_CMD_AUTO_HIBERNATE_REOPENING:
         {
-            case OPTIGA_CMD_EXEC_REQUEST_LOCK:
-            case OPTIGA_CMD_EXEC_REQUEST_SESSION:
+            p_optiga->auto_hibernate_state = OPTIGA_CMD_AUTO_HIBERNATE_IDLE;
+            if (OPTIGA_LIB_SUCCESS != event)
             {
-                *exit_loop = TRUE;
-                if (me->cmd_sub_execution_state == OPTIGA_CMD_EXEC_REQUEST_SESSION)
+                // The queued requests are served and fail, as the application is not opened
+                p_optiga->app_state = OPTIGA_CMD_APP_STATE_CLOSED;
+            }
+            break;
+        }
+#ifdef OPTIGA_CMD_LAZY_OPEN_ENABLED
+        case OPTIGA_CMD_AUTO_HIBERNATE_OPENING:
+        {
+            p_optiga->auto_hibernate_state = OPTIGA_CMD_AUTO_HIBERNATE_IDLE;
+            p_optiga->lazy_pre_open = FALSE;
+            if (OPTIGA_LIB_SUCCESS != event)
+            {
+                // The queued requests are served and fail, as the application is not opened
+                p_optiga->lazy_open_failed = TRUE;
+            }
+            break;
+        }
+#endif //OPTIGA_CMD_LAZY_OPEN_ENABLED
+#ifdef OPTIGA_CMD_PERFORMANCE_GOVERNOR_ENABLED
+        case OPTIGA_CMD_AUTO_HIBERNATE_SETTING_CURRENT:
+        {
+            p_optiga->auto_hibernate_state = OPTIGA_CMD_AUTO_HIBERNATE_IDLE;
+            p_optiga->current_limit_write_time = pal_os_timer_get_time_in_microseconds();
+            if (OPTIGA_LIB_SUCCESS == event)
+            {
+                if (p_optiga->current_limit_pending > p_optiga->performance_stats.current_limit)
                 {
-                    me->exit_status = optiga_cmd_request_session(me);
+                    p_optiga->performance_stats.raises++;
                 }
                 else
                 {
-                    me->exit_status = optiga_cmd_request_lock(me, OPTIGA_CMD_QUEUE_REQUEST_LOCK);
-                }
-                if (OPTIGA_LIB_SUCCESS != me->exit_status)
-                {
-                    EXIT_STATE_WITH_ERROR(me,*exit_loop);
-                    break;
+                    p_optiga->performance_stats.drops++;
                 }
-
-                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_PREPARE_APDU;
-                break;
+                p_optiga->performance_stats.current_limit = p_optiga->current_limit_pending;
+                p_optiga->current_limit_failed = 0;
             }
-            case OPTIGA_CMD_EXEC_RESET_STRICT_LOCK:
+            else
             {
-                optiga_cmd_release_strict_lock(me);
-                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_REQUEST_STRICT_LOCK;
-                *exit_loop = FALSE;
-                break;
+                // The same current limitation is not retried, hence a write protected 0xE0C4 is not written repeatedly
+                p_optiga->performance_stats.failed_writes++;
+                p_optiga->current_limit_failed = p_optiga->current_limit_pending;
             }
-            case OPTIGA_CMD_EXEC_REQUEST_STRICT_LOCK:
+            break;
+        }
+#endif //OPTIGA_CMD_PERFORMANCE_GOVERNOR_ENABLED
+#ifdef OPTIGA_CMD_SEC_PACING_ENABLED
+        case OPTIGA_CMD_AUTO_HIBERNATE_READING_SEC:
+        {
+            p_optiga->auto_hibernate_state = OPTIGA_CMD_AUTO_HIBERNATE_IDLE;
+            p_optiga->sec_read_time = pal_os_timer_get_time_in_microseconds();
+            // A failed read keeps the estimated SEC
+            if ((OPTIGA_LIB_SUCCESS == event) && (0 != p_optiga->sec_read_length))
             {
-                me->exit_status = optiga_cmd_request_lock(me, OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK);
-                if (OPTIGA_LIB_SUCCESS != me->exit_status)
-                {
-                    EXIT_STATE_WITH_ERROR(me,*exit_loop);
-                    break;
-                }
-                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_PREPARE_APDU;
-                *exit_loop = TRUE;
-                break;
+                p_optiga->sec_stats.reads++;
+                p_optiga->sec_stats.last_read_sec = p_optiga->sec_read_buffer;
+                p_optiga->sec_stats.current_sec = p_optiga->sec_read_buffer;
+                p_optiga->sec_value = p_optiga->sec_read_buffer;
+                p_optiga->sec_time = p_optiga->sec_read_time;
             }
-            case OPTIGA_CMD_EXEC_PREPARE_APDU:
-            {
-                *exit_loop = TRUE;
-                me->exit_status = optiga_cmd_handler(me);
-                if (OPTIGA_LIB_SUCCESS != me->exit_status)
-                {
-                    me->cmd_next_execution_state = OPTIGA_CMD_EXEC_ERROR_HANDLER;
-                    *exit_loop = FALSE;
-                    break;
-                }
-                me->p_optiga->comms_rx_size = OPTIGA_CMD_TOTAL_COMMS_BUFFER_SIZE;
+            break;
+        }
+#endif //OPTIGA_CMD_SEC_PACING_ENABLED
+        default:
+            break;
+    }
+}
+
+/*
+* Stores the time, after which the parked scheduler has to run again, if it is earlier than the stored time
+*/
+_STATIC_H void optiga_cmd_auto_hibernate_set_time_left(optiga_context_t * p_optiga, uint32_t time_left_us)
+{
+    if ((0 == p_optiga->auto_hibernate_time_left_us) || (time_left_us < p_optiga->auto_hibernate_time_left_us))
+    {
+        p_optiga->auto_hibernate_time_left_us = time_left_us;
+    }
+}
+
+/*
+* Starts the hibernate of the application, if it is enabled, the application is opened and the queue is idle
+* for the idle time. Otherwise, the remaining idle time is stored, after which the scheduler has to run again.
+* Returns TRUE, if the hibernate is started. The close application is queued like any other request.
+*/
+_STATIC_H bool_t optiga_cmd_auto_hibernate_start(optiga_context_t * p_optiga)
+{
+    bool_t hibernate_started = FALSE;
+    uint32_t idle_time_us;
+    uint32_t hibernate_idle_time_us = p_optiga->auto_hibernate_stats.idle_time_ms * 1000U;
+
+    do
+    {
+        if ((0 == hibernate_idle_time_us) ||
+            (OPTIGA_CMD_APP_STATE_OPEN != p_optiga->app_state) ||
+            (OPTIGA_CMD_AUTO_HIBERNATE_IDLE != p_optiga->auto_hibernate_state) ||
+            (0 != optiga_cmd_queue_get_count_of(p_optiga, OPTIGA_CMD_QUEUE_SLOT_STATE, OPTIGA_CMD_QUEUE_PROCESSING)) ||
+            (0 != optiga_cmd_queue_get_count_of(p_optiga, OPTIGA_CMD_QUEUE_SLOT_LOCK_TYPE, OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK)))
+        {
+            break;
+        }
+        idle_time_us = pal_os_timer_get_time_in_microseconds() - p_optiga->last_activity_time;
+        if (idle_time_us < hibernate_idle_time_us)
+        {
+            optiga_cmd_auto_hibernate_set_time_left(p_optiga, hibernate_idle_time_us - idle_time_us);
+            break;
+        }
+        p_optiga->auto_hibernate_state = OPTIGA_CMD_AUTO_HIBERNATE_HIBERNATING;
 #ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
-                me->p_optiga->p_optiga_comms->protection_level = me->protection_level;
-                me->p_optiga->p_optiga_comms->protocol_version = me->protocol_version;
-                me->p_optiga->protection_level_state |= me->protection_level;
+        optiga_cmd_set_shielded_connection_option(p_optiga->p_auto_hibernate_cmd,
+                                                  OPTIGA_COMMS_DEFAULT_PROTECTION_LEVEL,
+                                                  OPTIGA_SET_PROTECTION_LEVEL);
+        optiga_cmd_set_shielded_connection_option(p_optiga->p_auto_hibernate_cmd,
+                                                  OPTIGA_COMMS_PROTOCOL_VERSION_PRE_SHARED_SECRET,
+                                                  OPTIGA_SET_PROTECTION_VERSION);
+        optiga_cmd_set_shielded_connection_option(p_optiga->p_auto_hibernate_cmd,
+                                                  OPTIGA_COMMS_SESSION_CONTEXT_SAVE,
+                                                  OPTIGA_SET_MANAGE_CONTEXT);
 #endif //OPTIGA_COMMS_SHIELDED_CONNECTION
-                (void)optiga_comms_set_callback_context(me->p_optiga->p_optiga_comms, me);
-                me->exit_status = optiga_comms_transceive(me->p_optiga->p_optiga_comms,
-                                                          me->p_optiga->optiga_comms_buffer,
-                                                          me->p_optiga->comms_tx_size,
-                                                          me->p_optiga->optiga_comms_buffer,
-                                                          &(me->p_optiga->comms_rx_size));
+        //lint --e{534} suppress "The status is reported to the handler of the internal instance"
+        optiga_cmd_close_application(p_optiga->p_auto_hibernate_cmd, TRUE, NULL);
+        hibernate_started = TRUE;
+    } while (FALSE);
 
-                if (OPTIGA_LIB_SUCCESS != me->exit_status)
-                {
-                    EXIT_STATE_WITH_ERROR(me,*exit_loop);
-                    break;
-                }
+    return (hibernate_started);
+}
 
-                me->cmd_next_execution_state = OPTIGA_CMD_EXEC_PROCESS_RESPONSE;
-                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_PROCESS_OPTIGA_RESPONSE;
-                SET_DEV_ERROR_NOTIFICATION(OPTIGA_CMD_ENTER_HANDLER_CALL);
+#ifdef OPTIGA_CMD_LAZY_OPEN_ENABLED
+/*
+* Returns TRUE, if the closed application is to be opened on demand, for the pre-open or a queued request.
+* A queued open or close application of a caller is served as it is, hence no lazy open is done then.
+*/
+_STATIC_H bool_t optiga_cmd_lazy_open_required(const optiga_context_t * p_optiga)
+{
+    bool_t open_required = p_optiga->lazy_pre_open;
+    const optiga_cmd_queue_slot_t * p_queue_entry;
+    uint8_t apdu_cmd;
+    uint8_t index;
+
+    for (index = 0; index < p_optiga->queue_size; index++)
+    {
+        p_queue_entry = &p_optiga->optiga_cmd_execution_queue[index];
+        if ((OPTIGA_CMD_QUEUE_REQUEST != p_queue_entry->state_of_entry) ||
+            (p_optiga->p_auto_hibernate_cmd == p_queue_entry->registered_ctx))
+        {
+            continue;
+        }
+        apdu_cmd = OPTIGA_CMD_GET_APDU_CMD(((const optiga_cmd_t *)p_queue_entry->registered_ctx)->apdu_data);
+        if ((OPTIGA_CMD_OPEN_APPLICATION == apdu_cmd) || (OPTIGA_CMD_CLOSE_APPLICATION == apdu_cmd))
+        {
+            open_required = FALSE;
+            break;
+        }
+        open_required = TRUE;
+    }
+    return (open_required);
+}
+#endif //OPTIGA_CMD_LAZY_OPEN_ENABLED
+
+#ifdef OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+/*
+* Returns TRUE, if the hibernated application is to be restored for the queued requests. This is the case, once a request
+* is queued, which is not deferrable, or the maximum delay of a deferrable request has elapsed. The deferrable requests
+* are then served in the same batch. Otherwise, the time till the earliest maximum delay elapses is stored, after which
+* the scheduler has to run again.
+*/
+_STATIC_H bool_t optiga_cmd_deferral_restore_required(optiga_context_t * p_optiga)
+{
+    const optiga_cmd_queue_slot_t * p_queue_entry;
+    uint32_t current_time = pal_os_timer_get_time_in_microseconds();
+    uint32_t waiting_time_us;
+    uint32_t time_left_us = 0;
+    bool_t critical_request = FALSE;
+    bool_t delay_elapsed = FALSE;
+    uint8_t deferred_requests = 0;
+    uint8_t index;
+
+    for (index = 0; index < p_optiga->queue_size; index++)
+    {
+        p_queue_entry = &p_optiga->optiga_cmd_execution_queue[index];
+        if (OPTIGA_CMD_QUEUE_REQUEST != p_queue_entry->state_of_entry)
+        {
+            continue;
+        }
+        if (0U == p_queue_entry->defer_delay)
+        {
+            critical_request = TRUE;
+            continue;
+        }
+        deferred_requests++;
+        // Waiting time is calculated as difference, which also holds if the time stamp has overflowed
+        waiting_time_us = current_time - p_queue_entry->arrival_time;
+        if (waiting_time_us >= p_queue_entry->defer_delay)
+        {
+            delay_elapsed = TRUE;
+        }
+        else if ((0U == time_left_us) || ((p_queue_entry->defer_delay - waiting_time_us) < time_left_us))
+        {
+            time_left_us = p_queue_entry->defer_delay - waiting_time_us;
+        }
+        else
+        {
+            //an earlier maximum delay is pending
+        }
+    }
+
+    if ((TRUE == critical_request) || (TRUE == delay_elapsed))
+    {
+        p_optiga->auto_hibernate_stats.deferred_requests += deferred_requests;
+        if (FALSE == critical_request)
+        {
+            p_optiga->auto_hibernate_stats.deferral_expiries++;
+        }
+    }
+    else
+    {
+        optiga_cmd_auto_hibernate_set_time_left(p_optiga, time_left_us);
+    }
+    return (((TRUE == critical_request) || (TRUE == delay_elapsed)) ? TRUE : FALSE);
+}
+#endif //OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+
+/*
+* Starts the restore of the hibernated application, if a request is queued.
+* With the lazy open, the closed application is opened the same way.
+* Returns TRUE, if the restore is started. The queued requests are served, once the application is restored.
+*/
+_STATIC_H bool_t optiga_cmd_auto_hibernate_restore_start(optiga_context_t * p_optiga)
+{
+    bool_t restore_started = FALSE;
+
+    if ((OPTIGA_CMD_APP_STATE_HIBERNATED == p_optiga->app_state) &&
+        (OPTIGA_CMD_AUTO_HIBERNATE_IDLE == p_optiga->auto_hibernate_state) &&
+#ifdef OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+        // deferrable requests wait for the next restore, till their maximum delay
+        (0 != optiga_cmd_queue_get_count_of(p_optiga, OPTIGA_CMD_QUEUE_SLOT_STATE, OPTIGA_CMD_QUEUE_REQUEST)) &&
+        (TRUE == optiga_cmd_deferral_restore_required(p_optiga)))
+#else
+        (0 != optiga_cmd_queue_get_count_of(p_optiga, OPTIGA_CMD_QUEUE_SLOT_STATE, OPTIGA_CMD_QUEUE_REQUEST)))
+#endif //OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+    {
+        p_optiga->auto_hibernate_state = OPTIGA_CMD_AUTO_HIBERNATE_RESTORING;
+        p_optiga->auto_restore_start_time = pal_os_timer_get_time_in_microseconds();
+        optiga_cmd_auto_hibernate_open(p_optiga, TRUE);
+        restore_started = TRUE;
+    }
+#ifdef OPTIGA_CMD_LAZY_OPEN_ENABLED
+    else if ((TRUE == p_optiga->lazy_open_enabled) &&
+             (OPTIGA_CMD_APP_STATE_CLOSED == p_optiga->app_state) &&
+             (OPTIGA_CMD_AUTO_HIBERNATE_IDLE == p_optiga->auto_hibernate_state) &&
+             (FALSE == p_optiga->lazy_open_failed) &&
+             (TRUE == optiga_cmd_lazy_open_required(p_optiga)))
+    {
+        p_optiga->auto_hibernate_state = OPTIGA_CMD_AUTO_HIBERNATE_OPENING;
+        optiga_cmd_auto_hibernate_open(p_optiga, FALSE);
+        restore_started = TRUE;
+    }
+#endif //OPTIGA_CMD_LAZY_OPEN_ENABLED
+    return (restore_started);
+}
+
+/*
+* Returns FALSE, if the request must wait till the application is restored by the internal instance
+*/
+_STATIC_H bool_t optiga_cmd_auto_hibernate_admits(const optiga_context_t * p_optiga,
+                                                  const optiga_cmd_queue_slot_t * p_queue_entry)
+{
+    return ((((OPTIGA_CMD_AUTO_HIBERNATE_RESTORING != p_optiga->auto_hibernate_state) &&
+#ifdef OPTIGA_CMD_LAZY_OPEN_ENABLED
+              (OPTIGA_CMD_AUTO_HIBERNATE_OPENING != p_optiga->auto_hibernate_state) &&
+#endif //OPTIGA_CMD_LAZY_OPEN_ENABLED
+#ifdef OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+              // deferred requests wait in the hibernated application till the restore
+              (OPTIGA_CMD_APP_STATE_HIBERNATED != p_optiga->app_state) &&
+#endif //OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+              (OPTIGA_CMD_AUTO_HIBERNATE_REOPENING != p_optiga->auto_hibernate_state)) ||
+             (p_optiga->p_auto_hibernate_cmd == p_queue_entry->registered_ctx)) ? TRUE : FALSE);
+}
+
+#ifdef OPTIGA_CMD_PERFORMANCE_GOVERNOR_ENABLED
+/*
+* Starts the write of the current limitation (0xE0C4), if the policy of the performance governor asks for another one.
+* The burst current limitation applies, once the number of waiting requests reaches the burst queue depth, and the idle
+* current limitation, once the queue is idle for the idle time. Both are bounded by the power budget.
+* Returns TRUE, if the write is started. The set data object of the internal instance is queued like any other request.
+*/
+_STATIC_H bool_t optiga_cmd_performance_governor_start(optiga_context_t * p_optiga)
+{
+    const optiga_lib_performance_policy_t * p_policy = &p_optiga->performance_policy;
+    optiga_set_data_object_params_t * p_params = &p_optiga->current_limit_params;
+    uint8_t current_limit = p_optiga->performance_stats.current_limit;
+    uint8_t max_current_limit = p_optiga->performance_stats.max_current_limit;
+    uint8_t target_limit = current_limit;
+    uint32_t current_time = pal_os_timer_get_time_in_microseconds();
+    uint32_t elapsed_time_us;
+    uint32_t wait_time_us;
+    bool_t write_started = FALSE;
+
+    do
+    {
+        if ((0 == p_policy->burst_current_limit) ||
+            (OPTIGA_CMD_APP_STATE_OPEN != p_optiga->app_state) ||
+            (OPTIGA_CMD_AUTO_HIBERNATE_IDLE != p_optiga->auto_hibernate_state))
+        {
+            break;
+        }
+        if (p_policy->burst_queue_depth <=
+            optiga_cmd_queue_get_count_of(p_optiga, OPTIGA_CMD_QUEUE_SLOT_STATE, OPTIGA_CMD_QUEUE_REQUEST))
+        {
+            target_limit = p_policy->burst_current_limit;
+        }
+        else if ((0 == optiga_cmd_queue_get_count_of(p_optiga, OPTIGA_CMD_QUEUE_SLOT_STATE, OPTIGA_CMD_QUEUE_REQUEST)) &&
+                 (0 == optiga_cmd_queue_get_count_of(p_optiga, OPTIGA_CMD_QUEUE_SLOT_STATE, OPTIGA_CMD_QUEUE_PROCESSING)) &&
+                 (0 == optiga_cmd_queue_get_count_of(p_optiga, OPTIGA_CMD_QUEUE_SLOT_LOCK_TYPE, OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK)))
+        {
+            elapsed_time_us = current_time - p_optiga->last_activity_time;
+            wait_time_us = p_policy->idle_time_ms * 1000U;
+            if (elapsed_time_us >= wait_time_us)
+            {
+                target_limit = p_policy->idle_current_limit;
+            }
+            else if (p_policy->idle_current_limit != current_limit)
+            {
+                // scheduler is run again at the end of the idle time
+                optiga_cmd_auto_hibernate_set_time_left(p_optiga, wait_time_us - elapsed_time_us);
+            }
+            else
+            {
+                // idle current limitation is set already
+            }
+        }
+        else
+        {
+            // requests are served with the current limitation as it is
+        }
+        if ((0 != max_current_limit) && (target_limit > max_current_limit))
+        {
+            target_limit = max_current_limit;
+        }
+        if ((0 == target_limit) || (current_limit == target_limit) || (p_optiga->current_limit_failed == target_limit))
+        {
+            break;
+        }
+        // The current limitation is stored in NVM, hence the writes are limited by the hold time.
+        // A current limitation above the power budget is dropped right away.
+        elapsed_time_us = current_time - p_optiga->current_limit_write_time;
+        wait_time_us = p_policy->min_hold_time_ms * 1000U;
+        if ((0 != current_limit) && (elapsed_time_us < wait_time_us) &&
+            ((0 == max_current_limit) || (current_limit <= max_current_limit)))
+        {
+            // scheduler is run again at the end of the hold time
+            optiga_cmd_auto_hibernate_set_time_left(p_optiga, wait_time_us - elapsed_time_us);
+            break;
+        }
+        p_optiga->current_limit_pending = target_limit;
+        pal_os_memset(p_params, 0x00, sizeof(optiga_set_data_object_params_t));
+        p_params->oid = OPTIGA_CMD_CURRENT_LIMITATION_OID;
+        p_params->buffer = &p_optiga->current_limit_pending;
+        p_params->size = sizeof(p_optiga->current_limit_pending);
+        p_params->write_type = OPTIGA_CMD_SET_DATA_ERASE_AND_WRITE;
+        p_optiga->auto_hibernate_state = OPTIGA_CMD_AUTO_HIBERNATE_SETTING_CURRENT;
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+        optiga_cmd_set_shielded_connection_option(p_optiga->p_auto_hibernate_cmd,
+                                                  OPTIGA_COMMS_DEFAULT_PROTECTION_LEVEL,
+                                                  OPTIGA_SET_PROTECTION_LEVEL);
+        optiga_cmd_set_shielded_connection_option(p_optiga->p_auto_hibernate_cmd,
+                                                  OPTIGA_COMMS_SESSION_CONTEXT_NONE,
+                                                  OPTIGA_SET_MANAGE_CONTEXT);
+#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+        //lint --e{534} suppress "The status is reported to the handler of the internal instance"
+        optiga_cmd_set_data_object(p_optiga->p_auto_hibernate_cmd, OPTIGA_CMD_SET_DATA_ERASE_AND_WRITE, p_params);
+        write_started = TRUE;
+    } while (FALSE);
+
+    return (write_started);
+}
+#endif //OPTIGA_CMD_PERFORMANCE_GOVERNOR_ENABLED
+
+#ifdef OPTIGA_CMD_SEC_PACING_ENABLED
+/*
+* Returns the SEC estimated at the current time. The SEC held is lowered by one with each elapsed decay time.
+*/
+_STATIC_H uint8_t optiga_cmd_sec_estimate(const optiga_context_t * p_optiga, uint32_t current_time)
+{
+    uint32_t decrements = (current_time - p_optiga->sec_time) / (p_optiga->sec_policy.decay_time_ms * 1000U);
+
+    return ((decrements >= p_optiga->sec_value) ? 0 : (uint8_t)(p_optiga->sec_value - decrements));
+}
+
+/*
+* Returns TRUE, if the request is a command, which raises the SEC on a failure
+* (the HMAC verification with DecryptSym and SetObjectProtected)
+*/
+_STATIC_H bool_t optiga_cmd_sec_is_raising(const optiga_cmd_t * me)
+{
+    bool_t sec_raising = FALSE;
+
+    if (OPTIGA_CMD_SET_OBJECT_PROTECTED == OPTIGA_CMD_GET_APDU_CMD(me->apdu_data))
+    {
+        sec_raising = TRUE;
+    }
+#if defined (OPTIGA_CRYPT_SYM_ENCRYPT_ENABLED) && defined (OPTIGA_CRYPT_SYM_DECRYPT_ENABLED)
+    else if ((OPTIGA_CMD_DECRYPT_SYM == OPTIGA_CMD_GET_APDU_CMD(me->apdu_data)) &&
+             (OPTIGA_CMD_OPERATION_MODE_HMAC == ((const optiga_decrypt_sym_params_t *)me->p_input)->operation_mode))
+    {
+        sec_raising = TRUE;
+    }
+#endif
+    else
+    {
+        // further commands are not paced
+    }
+    return (sec_raising);
+}
+
+/*
+* Raises the estimated SEC on the failure of a SEC raising command, the SEC is read again with the next scheduler run
+*/
+_STATIC_H void optiga_cmd_sec_pacing_update(const optiga_cmd_t * me, optiga_lib_status_t event)
+{
+    optiga_context_t * p_optiga = me->p_optiga;
+    uint32_t current_time;
+
+    if ((0 != p_optiga->sec_policy.pacing_threshold) && (OPTIGA_LIB_SUCCESS == event) &&
+        (OPTIGA_CMD_APDU_SUCCESS != p_optiga->optiga_comms_buffer[OPTIGA_COMMS_DATA_OFFSET]) &&
+        (TRUE == optiga_cmd_sec_is_raising(me)))
+    {
+        current_time = pal_os_timer_get_time_in_microseconds();
+        p_optiga->sec_value = optiga_cmd_sec_estimate(p_optiga, current_time);
+        if (OPTIGA_CMD_SECURITY_EVENT_COUNTER_MAX > p_optiga->sec_value)
+        {
+            p_optiga->sec_value++;
+        }
+        p_optiga->sec_time = current_time;
+        p_optiga->sec_stats.current_sec = p_optiga->sec_value;
+        p_optiga->sec_stats.sec_raising_failures++;
+        p_optiga->sec_refresh_required = TRUE;
+    }
+}
+
+/*
+* Starts the read of the SEC (0xE0C5), once the policy is set or a SEC raising command failed, and after the refresh
+* time while a SEC raising request waits for the decay.
+* Returns TRUE, if the read is started. The get data object of the internal instance is queued like any other request.
+*/
+_STATIC_H bool_t optiga_cmd_sec_pacing_start(optiga_context_t * p_optiga)
+{
+    optiga_get_data_object_params_t * p_params = &p_optiga->sec_read_params;
+    uint32_t current_time = pal_os_timer_get_time_in_microseconds();
+    uint32_t decrements;
+    uint32_t elapsed_time_us;
+    uint32_t wait_time_us;
+    bool_t request_paced = p_optiga->sec_request_paced;
+    bool_t read_started = FALSE;
+
+    p_optiga->sec_request_paced = FALSE;
+    do
+    {
+        if ((0 == p_optiga->sec_policy.pacing_threshold) ||
+            (OPTIGA_CMD_APP_STATE_OPEN != p_optiga->app_state) ||
+            (OPTIGA_CMD_AUTO_HIBERNATE_IDLE != p_optiga->auto_hibernate_state))
+        {
+            break;
+        }
+        // The elapsed decay is applied to the SEC held, hence the time stamps are not compared across an overflow
+        decrements = p_optiga->sec_value - optiga_cmd_sec_estimate(p_optiga, current_time);
+        p_optiga->sec_value -= (uint8_t)decrements;
+        p_optiga->sec_time += decrements * p_optiga->sec_policy.decay_time_ms * 1000U;
+        if (0 == p_optiga->sec_value)
+        {
+            p_optiga->sec_time = current_time;
+        }
+        p_optiga->sec_stats.current_sec = p_optiga->sec_value;
+
+        if (FALSE == p_optiga->sec_refresh_required)
+        {
+            if ((FALSE == request_paced) || (0 == p_optiga->sec_policy.refresh_time_ms))
+            {
                 break;
             }
-            default:
-                EXIT_STATE_WITH_ERROR(me,*exit_loop);
+            elapsed_time_us = current_time - p_optiga->sec_read_time;
+            wait_time_us = p_optiga->sec_policy.refresh_time_ms * 1000U;
+            if (elapsed_time_us < wait_time_us)
+            {
+                // scheduler is run again at the end of the refresh time
+                optiga_cmd_auto_hibernate_set_time_left(p_optiga, wait_time_us - elapsed_time_us);
+                break;
+            }
+        }
+        p_optiga->sec_refresh_required = FALSE;
+        p_optiga->sec_read_length = sizeof(p_optiga->sec_read_buffer);
+        pal_os_memset(p_params, 0x00, sizeof(optiga_get_data_object_params_t));
+        p_params->oid = OPTIGA_CMD_SECURITY_EVENT_COUNTER_OID;
+        p_params->data_or_metadata = OPTIGA_CMD_READ_DATA;
+        p_params->buffer = &p_optiga->sec_read_buffer;
+        p_params->bytes_to_read = p_optiga->sec_read_length;
+        p_params->ref_bytes_to_read = &p_optiga->sec_read_length;
+        p_optiga->auto_hibernate_state = OPTIGA_CMD_AUTO_HIBERNATE_READING_SEC;
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+        optiga_cmd_set_shielded_connection_option(p_optiga->p_auto_hibernate_cmd,
+                                                  OPTIGA_COMMS_DEFAULT_PROTECTION_LEVEL,
+                                                  OPTIGA_SET_PROTECTION_LEVEL);
+        optiga_cmd_set_shielded_connection_option(p_optiga->p_auto_hibernate_cmd,
+                                                  OPTIGA_COMMS_SESSION_CONTEXT_NONE,
+                                                  OPTIGA_SET_MANAGE_CONTEXT);
+#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+        //lint --e{534} suppress "The status is reported to the handler of the internal instance"
+        optiga_cmd_get_data_object(p_optiga->p_auto_hibernate_cmd, OPTIGA_CMD_READ_DATA, p_params);
+        read_started = TRUE;
+    } while (FALSE);
+
+    return (read_started);
+}
+
+/*
+* Returns FALSE, if the request raises the SEC and must wait till the estimated SEC is decreased below the threshold
+*/
+_STATIC_H bool_t optiga_cmd_sec_pacing_admits(optiga_context_t * p_optiga, const optiga_cmd_queue_slot_t * p_queue_entry)
+{
+    optiga_cmd_t * p_cmd = (optiga_cmd_t *)p_queue_entry->registered_ctx;
+    uint32_t current_time;
+    uint32_t decay_time_us;
+    bool_t admitted = TRUE;
+
+    do
+    {
+        // a session request is not issued by a command in execution, hence it is not paced
+        if ((0 == p_optiga->sec_policy.pacing_threshold) ||
+            (OPTIGA_CMD_QUEUE_REQUEST_SESSION == p_queue_entry->request_type) ||
+            (FALSE == optiga_cmd_sec_is_raising(p_cmd)))
+        {
             break;
-            //lint --e{788} suppress "Not all states are used as same enum is used for both main and sub state machine."
         }
-    } while ((FALSE == *exit_loop) && (OPTIGA_CMD_EXEC_PREPARE_COMMAND == me->cmd_next_execution_state));
+        current_time = pal_os_timer_get_time_in_microseconds();
+        if (p_optiga->sec_policy.pacing_threshold > optiga_cmd_sec_estimate(p_optiga, current_time))
+        {
+            break;
+        }
+        admitted = FALSE;
+        p_optiga->sec_request_paced = TRUE;
+        if (FALSE == p_cmd->sec_paced)
+        {
+            p_cmd->sec_paced = TRUE;
+            p_optiga->sec_stats.paced_requests++;
+        }
+        // scheduler is run again with the next decrement of the SEC
+        decay_time_us = p_optiga->sec_policy.decay_time_ms * 1000U;
+        optiga_cmd_auto_hibernate_set_time_left(p_optiga,
+                                                decay_time_us - ((current_time - p_optiga->sec_time) % decay_time_us));
+    } while (FALSE);
+
+    return (admitted);
 }
+#endif //OPTIGA_CMD_SEC_PACING_ENABLED
+#endif //OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
 
-_STATIC_H void optiga_cmd_execute_get_device_error(optiga_cmd_t * me, uint8_t * exit_loop)
+#ifdef OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+/*
+* Revokes the strict lock, if the holder has not sent its next step within the hold time after the last step,
+* while further requests wait. Otherwise, updates the time left till the strict lock is revoked.
+* Returns TRUE, if the strict lock is revoked.
+*/
+_STATIC_H bool_t optiga_cmd_strict_lock_expire(optiga_context_t * p_optiga)
 {
+    optiga_cmd_t * p_holder = NULL;
+    uint32_t elapsed_time_us;
+    uint8_t index;
+    bool_t is_revoked = FALSE;
+
+    p_optiga->strict_lock_time_left_us = 0;
     do
     {
-        *exit_loop = TRUE;
-        me->exit_status = optiga_cmd_get_error_code_handler(me);
-        if (((OPTIGA_LIB_SUCCESS != me->exit_status) && !(OPTIGA_DEVICE_ERROR & me->exit_status)) ||
-            ((OPTIGA_DEVICE_ERROR == me->exit_status) &&
-            ((me->device_error_status & OPTIGA_CMD_ERROR_CODE_STATE_MASK) == OPTIGA_CMD_ERROR_CODE_RX)))
+        if ((0 == p_optiga->strict_lock_max_hold_us) ||
+            (0 == optiga_cmd_queue_get_count_of(p_optiga, OPTIGA_CMD_QUEUE_SLOT_STATE, OPTIGA_CMD_QUEUE_REQUEST)))
         {
-            me->cmd_next_execution_state = OPTIGA_CMD_EXEC_ERROR_HANDLER;
-            *exit_loop = FALSE;
             break;
         }
+        for (index = 0; index < p_optiga->queue_size; index++)
+        {
+            if ((OPTIGA_CMD_QUEUE_PROCESSING == p_optiga->optiga_cmd_execution_queue[index].state_of_entry) &&
+                (OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK == p_optiga->optiga_cmd_execution_queue[index].request_type))
+            {
+                p_holder = (optiga_cmd_t *)p_optiga->optiga_cmd_execution_queue[index].registered_ctx;
+                break;
+            }
+        }
+        // A step in execution is not interrupted
+        if ((NULL == p_holder) || (OPTIGA_CMD_STATE_EXIT != p_holder->cmd_sub_execution_state))
+        {
+            break;
+        }
+        elapsed_time_us = pal_os_timer_get_time_in_microseconds() - p_optiga->strict_lock_step_time;
+        if (elapsed_time_us < p_optiga->strict_lock_max_hold_us)
+        {
+            p_optiga->strict_lock_time_left_us = p_optiga->strict_lock_max_hold_us - elapsed_time_us;
+            break;
+        }
+        // The next step of the holder fails with OPTIGA_CMD_ERROR_STRICT_LOCK_REVOKED, the waiting requests are served
+        p_holder->strict_lock_revoked = TRUE;
+        optiga_cmd_queue_set_slot(p_optiga, index, OPTIGA_CMD_QUEUE_ASSIGNED, OPTIGA_CMD_QUEUE_NO_REQUEST);
+        OPTIGA_LIB_TRACE_ERROR(OPTIGA_LIB_TRACE_LAYER_SCHEDULER,
+                               OPTIGA_LIB_TRACE_INSTANCE_CODE(index, OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK));
+        is_revoked = TRUE;
     } while (FALSE);
+    return (is_revoked);
+}
+#endif //OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+
+/*
+* Select next optiga cmd instance from the execution queue based on a rule
+* 1. A slot with OPTIGA_CMD_QUEUE_RESUME state should exist
+* 2. Pick the slot which has acquired the strict slot
+* 3. If no slot with OPTIGA_CMD_QUEUE_RESUME exists, slot must be in OPTIGA_CMD_QUEUE_REQUEST state
+*     a. The request type is lock
+*     b. If request type is session, either session is already assigned or atleast session is available for assignment
+* 4. The priority class (after aging) must be the highest
+* 5. Within the same priority class, the arrival time must be the earliest
+* Requested slots are kept in arrival order in a ready list per priority class, hence only the
+* first ready slot of each class is to be compared. With the fair sharing, the first ready slot of the tenant with the
+* least virtual time is compared instead.
+*/
+_STATIC_H void optiga_cmd_queue_scheduler(void * p_optiga)
+{
+    uint32_t current_time_stamp;
+    uint32_t wait_time;
+    uint32_t prefered_wait_time = 0;
+    optiga_cmd_queue_slot_t * p_queue_entry;
+    uint8_t index;
+    uint8_t prefered_index = 0xFF;
+    uint8_t prefered_priority = OPTIGA_LIB_NUMBER_OF_PRIORITIES;
+    uint8_t effective_priority;
+    uint8_t priority;
+#ifdef OPTIGA_CMD_SESSION_POOL_ENABLED
+    uint32_t next_lease_expiry;
+#endif //OPTIGA_CMD_SESSION_POOL_ENABLED
+#if defined (OPTIGA_CMD_DEADLINE_ENABLED) || defined (OPTIGA_CMD_CANCEL_ENABLED)
+    uint8_t dropped_index;
+    optiga_lib_status_t drop_status = OPTIGA_CMD_ERROR;
+#endif
+#ifdef OPTIGA_CMD_FAIR_SHARE_ENABLED
+    uint8_t fair_index = OPTIGA_CMD_QUEUE_INVALID_INDEX;
+#endif //OPTIGA_CMD_FAIR_SHARE_ENABLED
+
+    optiga_context_t * p_optiga_ctx = (optiga_context_t * )p_optiga;
+
+    pal_os_event_t * my_os_event = p_optiga_ctx->p_pal_os_event_ctx;
+
+#ifdef OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+    (void)optiga_cmd_atomic_exchange_byte(&p_optiga_ctx->scheduler_parked, FALSE);
+#endif //OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+    // requests submitted since last run are queued
+    optiga_cmd_queue_apply_submissions(p_optiga_ctx);
+#ifdef OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+    p_optiga_ctx->auto_hibernate_time_left_us = 0;
+#endif //OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+
+#if defined (OPTIGA_COMMS_SHIELDED_CONNECTION) && defined (OPTIGA_COMMS_KEY_ROLLOVER_ENABLED)
+    if (TRUE == p_optiga_ctx->key_rollover_ongoing)
+    {
+        // the queued requests are served, once the scheduler is resumed on completion of the rollover
+    }
+    else
+#endif
+#ifdef OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+    if (TRUE == optiga_cmd_auto_hibernate_restore_start(p_optiga_ctx))
+    {
+        // the open application of the internal instance is queued, hence call self to serve it
+        PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(my_os_event, optiga_cmd_queue_scheduler,
+                                               p_optiga_ctx, OPTIGA_CMD_SCHEDULER_DISPATCH_TIME_MS);
+    }
+    else
+#endif //OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+#ifdef OPTIGA_CMD_PERFORMANCE_GOVERNOR_ENABLED
+    if (TRUE == optiga_cmd_performance_governor_start(p_optiga_ctx))
+    {
+        // the write of the current limitation of the internal instance is queued, hence call self to serve it
+        PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(my_os_event, optiga_cmd_queue_scheduler,
+                                               p_optiga_ctx, OPTIGA_CMD_SCHEDULER_DISPATCH_TIME_MS);
+    }
+    else
+#endif //OPTIGA_CMD_PERFORMANCE_GOVERNOR_ENABLED
+#ifdef OPTIGA_CMD_SEC_PACING_ENABLED
+    if (TRUE == optiga_cmd_sec_pacing_start(p_optiga_ctx))
+    {
+        // the read of the security event counter of the internal instance is queued, hence call self to serve it
+        PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(my_os_event, optiga_cmd_queue_scheduler,
+                                               p_optiga_ctx, OPTIGA_CMD_SCHEDULER_DISPATCH_TIME_MS);
+    }
+    else
+#endif //OPTIGA_CMD_SEC_PACING_ENABLED
+    if (((0 == optiga_cmd_queue_get_count_of(p_optiga_ctx, OPTIGA_CMD_QUEUE_SLOT_STATE, OPTIGA_CMD_QUEUE_REQUEST)) &&
+         (0 == optiga_cmd_queue_get_count_of(p_optiga_ctx, OPTIGA_CMD_QUEUE_SLOT_STATE, OPTIGA_CMD_QUEUE_RESUME))) ||
+         ((1 == optiga_cmd_queue_get_count_of(p_optiga_ctx, OPTIGA_CMD_QUEUE_SLOT_STATE , OPTIGA_CMD_QUEUE_PROCESSING)) &&
+         (0 < optiga_cmd_queue_get_count_of(p_optiga_ctx, OPTIGA_CMD_QUEUE_SLOT_LOCK_TYPE, OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK))))
+    {
+#ifdef OPTIGA_CMD_LAZY_OPEN_ENABLED
+        // the requests, which failed with the lazy open, are served, hence the next request opens again
+        p_optiga_ctx->lazy_open_failed = FALSE;
+#endif //OPTIGA_CMD_LAZY_OPEN_ENABLED
+#ifdef OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+        // strict lock holder, which is slow to send the next step, does not block the waiting requests
+        if (TRUE == optiga_cmd_strict_lock_expire(p_optiga_ctx))
+        {
+            // call self to serve the waiting requests
+            PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(my_os_event, optiga_cmd_queue_scheduler,
+                                                   p_optiga_ctx, OPTIGA_CMD_SCHEDULER_DISPATCH_TIME_MS);
+        }
+        else
+#endif //OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+#ifdef OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+        // queue is idle for the idle time, the application is hibernated
+        if (TRUE == optiga_cmd_auto_hibernate_start(p_optiga_ctx))
+        {
+            // the close application of the internal instance is queued, hence call self to serve it
+            PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(my_os_event, optiga_cmd_queue_scheduler,
+                                                   p_optiga_ctx, OPTIGA_CMD_SCHEDULER_DISPATCH_TIME_MS);
+        }
+        else
+#endif //OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+#if defined (OPTIGA_COMMS_SHIELDED_CONNECTION) && defined (OPTIGA_COMMS_KEY_ROLLOVER_ENABLED)
+        // queue is idle, the session key is renewed before it is exhausted in a command
+        if (FALSE == optiga_cmd_key_rollover_start(p_optiga_ctx))
+#endif
+        {
+#ifdef OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+            // wait till a request is posted or lock is released
+            optiga_cmd_queue_scheduler_park(p_optiga_ctx);
+#else
+            // call self
+            PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(my_os_event, optiga_cmd_queue_scheduler,
+                                                   p_optiga_ctx,OPTIGA_CMD_SCHEDULER_IDLING_TIME_MS);
+#endif //OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+        }
+    }
+    else
+    {
+        PAL_OS_EVENT_STOP(my_os_event);
+#ifdef OPTIGA_CMD_SESSION_POOL_ENABLED
+        // expired sessions are freed for the requests waiting for a session
+        next_lease_expiry = optiga_cmd_session_reclaim(p_optiga_ctx);
+#endif //OPTIGA_CMD_SESSION_POOL_ENABLED
+        // Waiting time is calculated as difference, which also holds if the time stamp has overflowed
+        current_time_stamp = pal_os_timer_get_time_in_microseconds();
+#if defined (OPTIGA_CMD_DEADLINE_ENABLED) || defined (OPTIGA_CMD_CANCEL_ENABLED)
+        dropped_index = optiga_cmd_queue_get_dropped(p_optiga_ctx, current_time_stamp, &drop_status);
+#endif
+
+        // if any slot has acquired strict lock, highest priority is given to it
+        if (1 == optiga_cmd_queue_get_count_of(p_optiga_ctx, OPTIGA_CMD_QUEUE_SLOT_STATE , OPTIGA_CMD_QUEUE_RESUME))
+        {
+            // Select the slot which has acquired strict lock
+            prefered_index = p_optiga_ctx->queue_resume_index;
+        }
+#if defined (OPTIGA_CMD_DEADLINE_ENABLED) || defined (OPTIGA_CMD_CANCEL_ENABLED)
+        else if (OPTIGA_CMD_QUEUE_INVALID_INDEX != dropped_index)
+        {
+            // Cancelled or expired request is dropped before any other request is dispatched, one per scheduler run
+            prefered_index = dropped_index;
+        }
+#endif
+        else
+        {
+            // Select optiga command based on rule
+            for (priority = 0; priority < OPTIGA_LIB_NUMBER_OF_PRIORITIES; priority++)
+            {
+                // pick the earliest ready request of the class
+                index = p_optiga_ctx->queue_ready_head[priority];
+                while (OPTIGA_CMD_QUEUE_INVALID_INDEX != index)
+                {
+                    p_queue_entry = &(p_optiga_ctx->optiga_cmd_execution_queue[index]);
+#ifdef OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+                    // requests wait till the application is restored
+                    if (FALSE == optiga_cmd_auto_hibernate_admits(p_optiga_ctx, p_queue_entry))
+                    {
+                        index = p_queue_entry->next_index;
+                        continue;
+                    }
+#endif //OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+#ifdef OPTIGA_CMD_SEC_PACING_ENABLED
+                    // SEC raising requests wait for the decay of the SEC, the further requests are served meanwhile
+                    if (FALSE == optiga_cmd_sec_pacing_admits(p_optiga_ctx, p_queue_entry))
+                    {
+                        index = p_queue_entry->next_index;
+                        continue;
+                    }
+#endif //OPTIGA_CMD_SEC_PACING_ENABLED
+                    // if lock request or session request and session available(either already assigned or available)
+                    if (((OPTIGA_CMD_QUEUE_REQUEST_SESSION == p_queue_entry->request_type) && (TRUE == optiga_cmd_session_available(p_optiga_ctx))) ||
+                        ((OPTIGA_CMD_QUEUE_REQUEST_SESSION == p_queue_entry->request_type) && (OPTIGA_CMD_NO_SESSION_OID != ((optiga_cmd_t *)p_queue_entry->registered_ctx)->session_oid)) ||
+                        (OPTIGA_CMD_QUEUE_REQUEST_LOCK == p_queue_entry->request_type) ||
+                        (OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK == p_queue_entry->request_type))
+                    {
+#ifdef OPTIGA_CMD_FAIR_SHARE_ENABLED
+                        // the earliest request of the tenant, which has consumed the least OPTIGA time relative to its weight
+                        if ((OPTIGA_CMD_QUEUE_INVALID_INDEX == fair_index) ||
+                            (TRUE == optiga_cmd_fair_share_precedes(p_optiga_ctx,
+                                                                    p_queue_entry,
+                                                                    &(p_optiga_ctx->optiga_cmd_execution_queue[fair_index]))))
+                        {
+                            fair_index = index;
+                        }
+#else
+                        break;
+#endif //OPTIGA_CMD_FAIR_SHARE_ENABLED
+                    }
+                    // session request waits for a free session, check next in the class
+                    index = p_queue_entry->next_index;
+                }
+#ifdef OPTIGA_CMD_FAIR_SHARE_ENABLED
+                index = fair_index;
+                fair_index = OPTIGA_CMD_QUEUE_INVALID_INDEX;
+#endif //OPTIGA_CMD_FAIR_SHARE_ENABLED
+                if (OPTIGA_CMD_QUEUE_INVALID_INDEX == index)
+                {
+                    continue;
+                }
+                p_queue_entry = &(p_optiga_ctx->optiga_cmd_execution_queue[index]);
+
+                wait_time = current_time_stamp - p_queue_entry->arrival_time;
+                effective_priority = optiga_cmd_queue_get_effective_priority(p_queue_entry, wait_time);
+
+                // highest priority class first and earliest arrival time (longest waiting) within the class
+                if ((effective_priority < prefered_priority) ||
+                    ((effective_priority == prefered_priority) && (wait_time >= prefered_wait_time)))
+                {
+                    prefered_priority = effective_priority;
+                    prefered_wait_time = wait_time;
+                    prefered_index = index;
+                }
+            }
+        }
+
+        // Improve : check the index and max queue size check
+        // If slot is identified then go further
+        if (0xFF != prefered_index)
+        {
+            p_queue_entry = &(p_optiga_ctx->optiga_cmd_execution_queue[prefered_index]);
+#if defined (OPTIGA_CMD_DEADLINE_ENABLED) || defined (OPTIGA_CMD_CANCEL_ENABLED)
+            if (dropped_index == prefered_index)
+            {
+                // the instance completes the request in its error handler, without sending it to OPTIGA
+                ((optiga_cmd_t *)p_queue_entry->registered_ctx)->exit_status = drop_status;
+                ((optiga_cmd_t *)p_queue_entry->registered_ctx)->cmd_next_execution_state = OPTIGA_CMD_EXEC_ERROR_HANDLER;
+            }
+            else
+#endif
+            // assign session
+            if ((OPTIGA_CMD_QUEUE_REQUEST_SESSION == p_optiga_ctx->optiga_cmd_execution_queue[prefered_index].request_type) &&
+                (OPTIGA_CMD_NO_SESSION_OID == ((optiga_cmd_t *)p_queue_entry->registered_ctx)->session_oid))
+            {
+                optiga_cmd_session_assign((optiga_cmd_t *)(p_optiga_ctx->optiga_cmd_execution_queue[prefered_index].registered_ctx));
+                // Improve : Change the state of the type here. This will reduce 0x0000 check
+            }
+
+#ifndef OPTIGA_CMD_RUN_TO_IO_ENABLED
+            // schedule with selected context
+            my_os_event = ((optiga_cmd_t *)(p_optiga_ctx->optiga_cmd_execution_queue[prefered_index].registered_ctx))->p_optiga->p_pal_os_event_ctx;
+            PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(my_os_event,
+                                                   optiga_cmd_event_trigger_execute,
+                                                   ((optiga_cmd_t *)(p_optiga_ctx->optiga_cmd_execution_queue[prefered_index].registered_ctx)),
+                                                   OPTIGA_CMD_SCHEDULER_DISPATCH_TIME_MS);
+#endif //OPTIGA_CMD_RUN_TO_IO_ENABLED
+            if (OPTIGA_CMD_QUEUE_REQUEST == p_queue_entry->state_of_entry)
+            {
+                optiga_cmd_queue_update_wait_stats(p_optiga_ctx, p_queue_entry, prefered_wait_time);
+#ifdef OPTIGA_CMD_FAIR_SHARE_ENABLED
+                optiga_cmd_fair_share_dispatch(p_optiga_ctx, p_queue_entry);
+#endif //OPTIGA_CMD_FAIR_SHARE_ENABLED
+#ifdef OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+                // a dropped request is not served, hence it is not measured
+                p_queue_entry->dispatch_time = (OPTIGA_CMD_EXEC_ERROR_HANDLER ==
+                                                ((optiga_cmd_t *)p_queue_entry->registered_ctx)->cmd_next_execution_state) ?
+                                               0U : current_time_stamp;
+#endif //OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+                OPTIGA_LIB_TRACE_END(OPTIGA_LIB_TRACE_LAYER_SCHEDULER,
+                                     OPTIGA_LIB_TRACE_INSTANCE_CODE(prefered_index, p_queue_entry->request_type));
+            }
+            optiga_cmd_queue_set_slot(p_optiga_ctx, prefered_index, OPTIGA_CMD_QUEUE_PROCESSING, p_queue_entry->request_type);
+#ifdef OPTIGA_CMD_RUN_TO_IO_ENABLED
+            // The scheduler runs in the pal os event context, hence the selected context is executed right away.
+            // This is done once the slot is in processing state, since the execution may release the slot already.
+            optiga_cmd_event_trigger_execute(p_queue_entry->registered_ctx);
+#endif //OPTIGA_CMD_RUN_TO_IO_ENABLED
+        }
+#ifdef OPTIGA_CMD_SESSION_POOL_ENABLED
+        else if (OPTIGA_CMD_SESSION_NO_LEASE != next_lease_expiry)
+        {
+            // all sessions are in use, the scheduler is run again once the next lease expires
+            PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(my_os_event, optiga_cmd_queue_scheduler,
+                                                   p_optiga_ctx, next_lease_expiry);
+        }
+#endif //OPTIGA_CMD_SESSION_POOL_ENABLED
+        else
+        {
+#ifdef OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+            // no request can be served now, e.g. all sessions are in use
+            optiga_cmd_queue_scheduler_park(p_optiga_ctx);
+#else
+            PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT( my_os_event, optiga_cmd_queue_scheduler,
+                                                    p_optiga_ctx,OPTIGA_CMD_SCHEDULER_IDLING_TIME_MS);
+#endif //OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+        }
+    }
+}
+
+/*
+* Updates a execution queue slot.
+* The request is submitted to the scheduler, which queues it in its own context. Hence this can be called from any thread.
+*/
+_STATIC_H void optiga_cmd_queue_update_slot(optiga_cmd_t * me, uint8_t request_type)
+{
+    optiga_cmd_queue_slot_t * p_queue_entry = &me->p_optiga->optiga_cmd_execution_queue[me->queue_id];
+
+    p_queue_entry->submitted_ctx = (void * )me;
+    p_queue_entry->submitted_time = pal_os_timer_get_time_in_microseconds();
+    p_queue_entry->submitted_request_type = request_type;
+    OPTIGA_LIB_TRACE_BEGIN(OPTIGA_LIB_TRACE_LAYER_SCHEDULER, OPTIGA_LIB_TRACE_INSTANCE_CODE(me->queue_id, request_type));
+    optiga_cmd_queue_push_submission(me->p_optiga, p_queue_entry);
+#ifdef OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+    optiga_cmd_queue_scheduler_wakeup(me->p_optiga);
+#endif //OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+}
+
+/*
+* Resets a execution slot
+*/
+_STATIC_H void optiga_cmd_queue_reset_slot(const optiga_cmd_t * me)
+{
+#ifdef OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+    optiga_cmd_admission_update_service_time(me->p_optiga, &me->p_optiga->optiga_cmd_execution_queue[me->queue_id]);
+#endif //OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+    // Reset the arrival time
+    me->p_optiga->optiga_cmd_execution_queue[me->queue_id].arrival_time = 0xFFFFFFFF;
+    //add optiga_cmd ctx
+    me->p_optiga->optiga_cmd_execution_queue[me->queue_id].registered_ctx = NULL;
+    // set the slot state to assigned and reset request type
+    optiga_cmd_queue_set_slot(me->p_optiga, me->queue_id, OPTIGA_CMD_QUEUE_ASSIGNED, OPTIGA_CMD_QUEUE_NO_REQUEST);
+#ifdef OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+    // idle time for the auto hibernate starts with the completion of the last command
+    me->p_optiga->last_activity_time = pal_os_timer_get_time_in_microseconds();
+#endif //OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+#ifdef OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+    // wakeup the event scheduler immediately
+    PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(me->p_optiga->p_pal_os_event_ctx,
+                                           optiga_cmd_queue_scheduler,
+                                           me->p_optiga,
+                                           OPTIGA_CMD_SCHEDULER_WAKEUP_TIME_MS);
+#else
+    // start the event scheduler
+    PAL_OS_EVENT_START(me->p_optiga->p_pal_os_event_ctx, optiga_cmd_queue_scheduler, me->p_optiga);
+#endif //OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+}
+
+
+/*
+* Release the strict lock associated with instance
+*/
+_STATIC_H void optiga_cmd_release_strict_lock(const optiga_cmd_t * me)
+{
+    optiga_cmd_queue_set_slot(me->p_optiga, me->queue_id, OPTIGA_CMD_QUEUE_ASSIGNED, OPTIGA_CMD_QUEUE_NO_REQUEST);
+}
+
+optiga_lib_status_t optiga_cmd_request_session(optiga_cmd_t * me)
+{
+#ifdef OPTIGA_CMD_SESSION_POOL_ENABLED
+    // Fails right away instead of waiting in execution queue, if no session is free
+    if ((OPTIGA_LIB_SESSION_FAIL_FAST == me->session_policy) && (OPTIGA_CMD_NO_SESSION_OID == me->session_oid))
+    {
+        if (FALSE == optiga_cmd_session_obtainable(me->p_optiga))
+        {
+            me->p_optiga->session_rejected_requests++;
+            return (OPTIGA_CMD_ERROR_SESSION_UNAVAILABLE);
+        }
+    }
+#endif //OPTIGA_CMD_SESSION_POOL_ENABLED
+    optiga_cmd_queue_update_slot(me , OPTIGA_CMD_QUEUE_REQUEST_SESSION);
+    return (OPTIGA_CMD_SUCCESS);
+}
+
+optiga_lib_status_t optiga_cmd_release_session(optiga_cmd_t * me)
+{
+    optiga_cmd_session_free(me);
+#ifdef OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+    // requests waiting for a session are served now
+    optiga_cmd_queue_scheduler_wakeup(me->p_optiga);
+#endif //OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+    return (OPTIGA_CMD_SUCCESS);
+}
+
+optiga_lib_status_t optiga_cmd_request_lock(optiga_cmd_t * me, uint8_t lock_type)
+{
+    optiga_cmd_queue_update_slot(me , lock_type);
+    return (OPTIGA_CMD_SUCCESS);
+}
+
+optiga_lib_status_t optiga_cmd_release_lock(const optiga_cmd_t * me)
+{
+#ifdef OPTIGA_CMD_DOUBLE_BUFFERED_APDU
+    // Discard the chunk prepared ahead, if the chained command ended early
+    if (me == me->p_optiga->p_prepared_ctx)
+    {
+        me->p_optiga->p_prepared_ctx = NULL;
+    }
+#endif //OPTIGA_CMD_DOUBLE_BUFFERED_APDU
+    optiga_cmd_queue_reset_slot(me);
+    return (OPTIGA_CMD_SUCCESS);
+}
+
+_STATIC_H optiga_lib_status_t optiga_cmd_restore_context(const optiga_cmd_t * me)
+{
+#define OPTIGA_CMD_OF_CONTEXT_HANDLE_4TH_BYTE         (0x04)
+    uint16_t context_handle_length;
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR;
+    do
+    {
+        if (OPTIGA_LIB_PAL_DATA_STORE_NOT_CONFIGURED != me->optiga_context_datastore_id)
+        {
+            context_handle_length = sizeof(me->p_optiga->optiga_context_handle_buffer);
+            //Reading context handle secret from datastore
+            return_status = PAL_OS_DATASTORE_READ(me->optiga_context_datastore_id,
+                                                  me->p_optiga->optiga_context_handle_buffer,
+                                                  &context_handle_length);
+            if (PAL_STATUS_SUCCESS != return_status)
+            {
+                break;
+            }
+        }
+        // Check for valid context value
+        if (0 == optiga_common_get_uint32(me->p_optiga->optiga_context_handle_buffer) &&
+            0 == optiga_common_get_uint32(&me->p_optiga->optiga_context_handle_buffer[OPTIGA_CMD_OF_CONTEXT_HANDLE_4TH_BYTE]))
+        {
+            return_status = OPTIGA_CMD_ERROR;
+            break;
+        }
+
+        return_status = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+#undef OPTIGA_CMD_OFFSET_OF_NEXT_BYTE
+    return (return_status);
+}
+_STATIC_H optiga_lib_status_t optiga_cmd_store_context(const optiga_cmd_t * me)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR;
+    do
+    {
+        if (OPTIGA_LIB_PAL_DATA_STORE_NOT_CONFIGURED != me->optiga_context_datastore_id)
+        {
+            //Reading context handle secret from datastore
+            return_status = PAL_OS_DATASTORE_WRITE(me->optiga_context_datastore_id,
+                                                   me->p_optiga->optiga_context_handle_buffer,
+                                                   sizeof(me->p_optiga->optiga_context_handle_buffer));
+            if (PAL_STATUS_SUCCESS != return_status)
+            {
+                break;
+            }
+        }
+        // The manage context and the context handle deferred by the datastore cache persist before the hibernate
+        if (PAL_STATUS_SUCCESS != PAL_OS_DATASTORE_FLUSH())
+        {
+            return_status = OPTIGA_CMD_ERROR;
+            break;
+        }
+
+        return_status = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_status);
+}
+
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+_STATIC_H void optiga_cmd_clear_app_ctx(void * p_ctx)
+{
+    optiga_cmd_t * me = (optiga_cmd_t *)p_ctx;
+    /*In the case of hibernate if any low level error occurs while performing
+      close application this section clears the saved application context.*/
+    if ((OPTIGA_CMD_PARAM_INITIALIZE_APP_CONTEXT != me->cmd_param) &&
+        (OPTIGA_COMMS_SESSION_CONTEXT_SAVE == me->manage_context_operation))
+    {
+        pal_os_memset(me->p_optiga->optiga_context_handle_buffer,0,
+                        sizeof(me->p_optiga->optiga_context_handle_buffer));
+        if ((OPTIGA_HIBERNATE_CONTEXT_ID == me->optiga_context_datastore_id) &&
+            (OPTIGA_LIB_PAL_DATA_STORE_NOT_CONFIGURED != me->optiga_context_datastore_id))
+        {
+            //Clearing context handle secret from datastore
+            me->exit_status = PAL_OS_DATASTORE_WRITE(me->optiga_context_datastore_id,
+                                                     me->p_optiga->optiga_context_handle_buffer,
+                                                     sizeof(me->p_optiga->optiga_context_handle_buffer));
+            if (PAL_STATUS_SUCCESS != me->exit_status)
+            {
+                me->cmd_next_execution_state = OPTIGA_CMD_EXEC_ERROR_HANDLER;
+            }
+        }
+    }
+}
+#endif
+
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+/*
+* Provides the expected execution time of the APDU in the communication buffer to comms
+*/
+_STATIC_H void optiga_cmd_execution_time_start(optiga_context_t * p_optiga)
+{
+    const uint8_t * p_apdu = p_optiga->optiga_comms_buffer + OPTIGA_COMMS_DATA_OFFSET;
+    uint8_t cmd = p_apdu[0] & (uint8_t)(~OPTIGA_CMD_CLEAR_LAST_ERROR);
+    uint8_t param = p_apdu[1];
+    optiga_cmd_execution_time_t * p_entry = NULL;
+    uint8_t index;
+    uint8_t count;
+
+    for (index = 0; index < OPTIGA_CMD_EXECUTION_TIME_CACHE_SIZE; index++)
+    {
+        if ((0 != p_optiga->execution_time_cache[index].time_us) &&
+            (cmd == p_optiga->execution_time_cache[index].cmd) &&
+            (param == p_optiga->execution_time_cache[index].param))
+        {
+            p_entry = &p_optiga->execution_time_cache[index];
+            break;
+        }
+    }
+    if (NULL == p_entry)
+    {
+        // Entries are replaced in round robin, the estimate starts with the default execution time of the command
+        index = p_optiga->execution_time_replace_index;
+        p_optiga->execution_time_replace_index = (uint8_t)((index + 1) % OPTIGA_CMD_EXECUTION_TIME_CACHE_SIZE);
+        p_entry = &p_optiga->execution_time_cache[index];
+        p_entry->cmd = cmd;
+        p_entry->param = param;
+        p_entry->time_us = OPTIGA_CMD_DEFAULT_EXECUTION_TIME_US;
+        for (count = 0; count < (sizeof(optiga_cmd_default_execution_time) /
+                                         sizeof(optiga_cmd_default_execution_time[0])); count++)
+        {
+            if (cmd == optiga_cmd_default_execution_time[count].cmd)
+            {
+                p_entry->time_us = optiga_cmd_default_execution_time[count].time_us;
+                break;
+            }
+        }
+    }
+    p_optiga->execution_time_index = index;
+    p_optiga->execution_time_pending = TRUE;
+    p_optiga->p_optiga_comms->response_time_hint_us = p_entry->time_us;
+}
+
+/*
+* Refines the expected execution time of the completed APDU with the execution time measured by comms
+*/
+_STATIC_H void optiga_cmd_execution_time_update(optiga_context_t * p_optiga, optiga_lib_status_t event)
+{
+    optiga_cmd_execution_time_t * p_entry;
+    uint32_t measured_time_us;
+
+    if (TRUE == p_optiga->execution_time_pending)
+    {
+        p_optiga->execution_time_pending = FALSE;
+        p_entry = &p_optiga->execution_time_cache[p_optiga->execution_time_index];
+        measured_time_us = p_optiga->p_optiga_comms->response_time_us;
+        if ((OPTIGA_LIB_SUCCESS == event) && (0 != measured_time_us))
+        {
+            // Polling too late adds latency, hence the estimate follows a shorter execution time faster than a longer one
+            if (measured_time_us < p_entry->time_us)
+            {
+                p_entry->time_us -= ((p_entry->time_us - measured_time_us) >> OPTIGA_CMD_EXECUTION_TIME_DECREASE_SHIFT);
+            }
+            else
+            {
+                p_entry->time_us += ((measured_time_us - p_entry->time_us) >> OPTIGA_CMD_EXECUTION_TIME_INCREASE_SHIFT);
+            }
+            if (0 == p_entry->time_us)
+            {
+                p_entry->time_us = 1;
+            }
+        }
+    }
+}
+#endif //OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+
+#ifdef OPTIGA_LIB_FAST_RESUME_ENABLED
+/*
+* Updates the resume statistics, on completion of the open application command which restores the application
+*/
+_STATIC_H void optiga_cmd_resume_stats_update(const optiga_cmd_t * me)
+{
+    optiga_lib_resume_stats_t * p_stats = &me->p_optiga->resume_stats;
+    uint32_t resume_time_us;
+
+    if ((TRUE == me->p_optiga->resume_ongoing) &&
+        (OPTIGA_CMD_OPEN_APPLICATION == OPTIGA_CMD_GET_APDU_CMD(me->apdu_data)))
+    {
+        me->p_optiga->resume_ongoing = FALSE;
+        if (OPTIGA_LIB_SUCCESS == me->exit_status)
+        {
+            resume_time_us = pal_os_timer_get_time_in_microseconds() - me->p_optiga->resume_start_time;
+            p_stats->resumes++;
+            p_stats->last_resume_time_us = resume_time_us;
+            p_stats->last_comms_open_time_us = me->p_optiga->resume_comms_open_time;
+            p_stats->total_resume_time_us += resume_time_us;
+            if (resume_time_us > p_stats->max_resume_time_us)
+            {
+                p_stats->max_resume_time_us = resume_time_us;
+            }
+        }
+        else
+        {
+            p_stats->failed_resumes++;
+        }
+    }
+}
+#endif //OPTIGA_LIB_FAST_RESUME_ENABLED
+
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+/*
+* Updates the statistics of the command, on reception of the response from comms
+*/
+_STATIC_H void optiga_cmd_statistics_update(const optiga_cmd_t * me, optiga_lib_status_t event)
+{
+    optiga_lib_statistics_t * p_stats = &me->p_optiga->statistics;
+    optiga_lib_command_stats_t * p_command = NULL;
+    uint32_t latency_us = pal_os_timer_get_time_in_microseconds() - me->p_optiga->command_start_time;
+    uint8_t index;
+
+    // Entries are assigned in the order of the first execution and are never replaced
+    for (index = 0; index < p_stats->command_count; index++)
+    {
+        if (me->command_code == p_stats->commands[index].command_code)
+        {
+            p_command = &p_stats->commands[index];
+            break;
+        }
+    }
+    if ((NULL == p_command) && (OPTIGA_LIB_STATISTICS_COMMAND_COUNT > p_stats->command_count))
+    {
+        p_command = &p_stats->commands[p_stats->command_count++];
+        p_command->command_code = me->command_code;
+        p_command->min_latency_us = latency_us;
+    }
+    if (NULL == p_command)
+    {
+        p_stats->other_commands++;
+    }
+    else
+    {
+        p_command->count++;
+        if ((OPTIGA_LIB_SUCCESS != event) ||
+            (OPTIGA_CMD_APDU_SUCCESS != me->p_optiga->optiga_comms_buffer[OPTIGA_COMMS_DATA_OFFSET]))
+        {
+            p_command->failed++;
+        }
+        p_command->total_latency_us += latency_us;
+        if (latency_us < p_command->min_latency_us)
+        {
+            p_command->min_latency_us = latency_us;
+        }
+        if (latency_us > p_command->max_latency_us)
+        {
+            p_command->max_latency_us = latency_us;
+        }
+    }
+}
+
+/*
+* Accounts the time in the current energy state and enters the given energy state.
+* The time is taken in milliseconds, since hibernates may last longer than the wrap around of the microseconds.
+*/
+_STATIC_H void optiga_cmd_statistics_energy_transition(optiga_context_t * p_optiga, uint8_t energy_state)
+{
+    optiga_lib_energy_stats_t * p_energy = &p_optiga->statistics.energy;
+    uint32_t current_time = pal_os_timer_get_time_in_milliseconds();
+
+    pal_os_lock_enter_critical_section();
+    if (OPTIGA_CMD_ENERGY_STATE_AWAKE == p_optiga->energy_state)
+    {
+        p_energy->awake_time_ms += current_time - p_optiga->energy_state_start_time;
+    }
+    else if (OPTIGA_CMD_ENERGY_STATE_HIBERNATED == p_optiga->energy_state)
+    {
+        p_energy->hibernated_time_ms += current_time - p_optiga->energy_state_start_time;
+    }
+    else
+    {
+        // Time powered off is not accounted
+    }
+    p_optiga->energy_state = energy_state;
+    p_optiga->energy_state_start_time = current_time;
+    pal_os_lock_exit_critical_section();
+}
+#endif //OPTIGA_LIB_STATISTICS_ENABLED
+
+#ifdef OPTIGA_CMD_HEALTH_MONITOR_ENABLED
+/*
+* Starts the recovery of OPTIGA, if the command on the wire failed since the communication is lost.
+* The recovery is started for a command, which is not chained and neither opens nor closes the application.
+* Returns TRUE, if the recovery is started.
+*/
+_STATIC_H uint8_t optiga_cmd_recovery_start(optiga_cmd_t * me, optiga_lib_status_t event)
+{
+    uint8_t is_started = FALSE;
+    uint8_t apdu_cmd = OPTIGA_CMD_GET_APDU_CMD(me->apdu_data);
+
+    do
+    {
+        if (((OPTIGA_COMMS_ERROR != event) && (OPTIGA_COMMS_ERROR_FATAL != event)) ||
+            (OPTIGA_CMD_EXEC_PROCESS_RESPONSE != me->cmd_next_execution_state) ||
+            (OPTIGA_CMD_EXEC_PROCESS_OPTIGA_RESPONSE != me->cmd_sub_execution_state) ||
+            (FALSE != me->chaining_ongoing) ||
+            (OPTIGA_CMD_RECOVERY_MAX_ATTEMPTS <= me->recovery_attempts))
+        {
+            break;
+        }
+        if ((OPTIGA_CMD_OPEN_APPLICATION == apdu_cmd) || (OPTIGA_CMD_CLOSE_APPLICATION == apdu_cmd))
+        {
+            break;
+        }
+#ifdef OPTIGA_CMD_CANCEL_ENABLED
+        if (TRUE == me->cancel_requested)
+        {
+            break;
+        }
+#endif //OPTIGA_CMD_CANCEL_ENABLED
+        me->recovery_attempts++;
+        me->recovery_status = event;
+        me->p_optiga->recovery_start_time = pal_os_timer_get_time_in_microseconds();
+        // The lock is retained, hence the queued requests wait for the recovery
+        me->cmd_next_execution_state = OPTIGA_CMD_EXEC_RECOVERY;
+        me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_RECOVERY_START;
+        is_started = TRUE;
+    } while (FALSE);
+    return (is_started);
+}
+
+/*
+* Continues the recovery in the given sub state from the pal os event, since comms is released on return of its callback
+*/
+_STATIC_H void optiga_cmd_recovery_continue(optiga_cmd_t * me, optiga_cmd_sub_state_t sub_state)
+{
+    me->cmd_sub_execution_state = sub_state;
+    PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(me->p_optiga->p_pal_os_event_ctx,
+                                           (register_callback)optiga_cmd_event_trigger_execute,
+                                           me, OPTIGA_CMD_SCHEDULER_RUNNING_TIME_MS);
+}
+
+_STATIC_H void optiga_cmd_execute_recovery(optiga_cmd_t * me, uint8_t * exit_loop)
+{
+    optiga_lib_health_stats_t * p_stats = &me->p_optiga->health_stats;
+    uint8_t apdu_cmd;
+
+    do
+    {
+        *exit_loop = TRUE;
+        switch (me->cmd_sub_execution_state)
+        {
+            case OPTIGA_CMD_EXEC_RECOVERY_START:
+            {
+                optiga_cmd_recovery_continue(me, OPTIGA_CMD_EXEC_RECOVERY_SOFT_RESET);
+                break;
+            }
+            case OPTIGA_CMD_EXEC_RECOVERY_SOFT_RESET:
+            {
+                // Soft reset probes the slave with the status register read, before it is reset
+                p_stats->soft_resets++;
+                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_RECOVERY_SOFT_RESET_DONE;
+                (void)optiga_comms_set_callback_context(me->p_optiga->p_optiga_comms, me);
+                if (OPTIGA_LIB_SUCCESS != optiga_comms_reset(me->p_optiga->p_optiga_comms, OPTIGA_CMD_RECOVERY_SOFT_RESET))
+                {
+                    me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_RECOVERY_FAILED;
+                    *exit_loop = FALSE;
+                }
+                break;
+            }
+            case OPTIGA_CMD_EXEC_RECOVERY_SOFT_RESET_DONE:
+            {
+                // Slave does not respond or does not support the soft reset, hence the reset pin is used
+                optiga_cmd_recovery_continue(me, (OPTIGA_LIB_SUCCESS == me->exit_status) ?
+                                                 OPTIGA_CMD_EXEC_RECOVERY_OPEN_APPLICATION :
+                                                 OPTIGA_CMD_EXEC_RECOVERY_WARM_RESET);
+                break;
+            }
+            case OPTIGA_CMD_EXEC_RECOVERY_WARM_RESET:
+            {
+                p_stats->warm_resets++;
+                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_RECOVERY_WARM_RESET_DONE;
+                (void)optiga_comms_set_callback_context(me->p_optiga->p_optiga_comms, me);
+                if (OPTIGA_LIB_SUCCESS != optiga_comms_reset(me->p_optiga->p_optiga_comms, OPTIGA_CMD_RECOVERY_WARM_RESET))
+                {
+                    me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_RECOVERY_FAILED;
+                    *exit_loop = FALSE;
+                }
+                break;
+            }
+            case OPTIGA_CMD_EXEC_RECOVERY_WARM_RESET_DONE:
+            {
+                if (OPTIGA_LIB_SUCCESS != me->exit_status)
+                {
+                    me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_RECOVERY_FAILED;
+                    *exit_loop = FALSE;
+                    break;
+                }
+                optiga_cmd_recovery_continue(me, OPTIGA_CMD_EXEC_RECOVERY_OPEN_APPLICATION);
+                break;
+            }
+            case OPTIGA_CMD_EXEC_RECOVERY_OPEN_APPLICATION:
+            {
+                // Application context is initialized, since the reset discards the application on OPTIGA
+                optiga_cmd_prepare_apdu_header(OPTIGA_CMD_OPEN_APPLICATION,
+                                               OPTIGA_CMD_PARAM_INITIALIZE_APP_CONTEXT,
+                                               sizeof(g_optiga_unique_application_identifier),
+                                               me->p_optiga->optiga_comms_buffer + OPTIGA_COMMS_DATA_OFFSET);
+                pal_os_memcpy(me->p_optiga->optiga_comms_buffer + OPTIGA_CMD_APDU_INDATA_OFFSET,
+                              g_optiga_unique_application_identifier,
+                              sizeof(g_optiga_unique_application_identifier));
+                me->p_optiga->comms_tx_size = OPTIGA_CMD_APDU_HEADER_SIZE + sizeof(g_optiga_unique_application_identifier);
+                me->p_optiga->comms_rx_size = OPTIGA_CMD_TOTAL_COMMS_BUFFER_SIZE;
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+                me->p_optiga->p_optiga_comms->protection_level = OPTIGA_COMMS_NO_PROTECTION;
+#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_RECOVERY_OPEN_APPLICATION_DONE;
+                (void)optiga_comms_set_callback_context(me->p_optiga->p_optiga_comms, me);
+                if (OPTIGA_LIB_SUCCESS != optiga_comms_transceive(me->p_optiga->p_optiga_comms,
+                                                                  me->p_optiga->optiga_comms_buffer,
+                                                                  me->p_optiga->comms_tx_size,
+                                                                  me->p_optiga->optiga_comms_buffer,
+                                                                  &(me->p_optiga->comms_rx_size)))
+                {
+                    me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_RECOVERY_FAILED;
+                    *exit_loop = FALSE;
+                }
+                break;
+            }
+            case OPTIGA_CMD_EXEC_RECOVERY_OPEN_APPLICATION_DONE:
+            {
+                if ((OPTIGA_LIB_SUCCESS != me->exit_status) ||
+                    (OPTIGA_CMD_APDU_SUCCESS != me->p_optiga->optiga_comms_buffer[OPTIGA_COMMS_DATA_OFFSET]))
+                {
+                    me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_RECOVERY_FAILED;
+                    *exit_loop = FALSE;
+                    break;
+                }
+                p_stats->recoveries++;
+                p_stats->last_recovery_time_us = pal_os_timer_get_time_in_microseconds() -
+                                                 me->p_optiga->recovery_start_time;
+                // OPTIGA might have executed the failed command, hence only the reads are sent again
+                apdu_cmd = OPTIGA_CMD_GET_APDU_CMD(me->apdu_data);
+                if ((OPTIGA_CMD_GET_DATA_OBJECT != apdu_cmd) && (OPTIGA_CMD_GET_RANDOM != apdu_cmd))
+                {
+                    // The communication failure of the command is reported, the queued requests continue
+                    me->exit_status = me->recovery_status;
+                    me->cmd_next_execution_state = OPTIGA_CMD_EXEC_ERROR_HANDLER;
+                    *exit_loop = FALSE;
+                    break;
+                }
+                // The failed command is prepared and sent again
+                me->cmd_next_execution_state = OPTIGA_CMD_EXEC_PREPARE_COMMAND;
+                optiga_cmd_recovery_continue(me, OPTIGA_CMD_EXEC_PREPARE_APDU);
+                break;
+            }
+            case OPTIGA_CMD_EXEC_RECOVERY_FAILED:
+            {
+                // The communication failure of the command is reported
+                p_stats->failed_recoveries++;
+                me->exit_status = me->recovery_status;
+                me->cmd_next_execution_state = OPTIGA_CMD_EXEC_ERROR_HANDLER;
+                *exit_loop = FALSE;
+                break;
+            }
+            default:
+                EXIT_STATE_WITH_ERROR(me,*exit_loop);
+            break;
+            //lint --e{788} suppress "Not all states are used as same enum is used for both main and sub state machine."
+        }
+    } while ((FALSE == *exit_loop) && (OPTIGA_CMD_EXEC_RECOVERY == me->cmd_next_execution_state));
+}
+#endif //OPTIGA_CMD_HEALTH_MONITOR_ENABLED
+
+_STATIC_H void optiga_cmd_execute_comms_open(optiga_cmd_t * me, uint8_t * exit_loop)
+{
+    do
+    {
+        *exit_loop = TRUE;
+        switch (me->cmd_sub_execution_state)
+        {
+            case OPTIGA_CMD_EXEC_COMMS_OPEN_ACQUIRE_LOCK:
+            {
+
+                // add to queue and exit
+                me->exit_status = optiga_cmd_request_lock(me, OPTIGA_CMD_QUEUE_REQUEST_LOCK);
+                if (OPTIGA_LIB_SUCCESS != me->exit_status)
+                {
+                    EXIT_STATE_WITH_ERROR(me,*exit_loop);
+                    break;
+                }
+                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_COMMS_OPEN_START;
+                break;
+            }
+            case OPTIGA_CMD_EXEC_COMMS_OPEN_START:
+            {
+#ifdef OPTIGA_LIB_FAST_RESUME_ENABLED
+                me->p_optiga->resume_ongoing = (OPTIGA_CMD_PARAM_INITIALIZE_APP_CONTEXT != me->cmd_param) ? TRUE : FALSE;
+                me->p_optiga->resume_start_time = pal_os_timer_get_time_in_microseconds();
+#endif //OPTIGA_LIB_FAST_RESUME_ENABLED
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+                me->p_optiga->p_optiga_comms->protection_level =  me->protection_level;
+                me->p_optiga->p_optiga_comms->protocol_version = me->protocol_version;
+                me->p_optiga->p_optiga_comms->manage_context_operation = me->manage_context_operation;
+                me->p_optiga->p_optiga_comms->p_pal_os_event_ctx = me->p_optiga->p_pal_os_event_ctx;
+#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+
+                (void)optiga_comms_set_callback_context(me->p_optiga->p_optiga_comms, me);
+                me->exit_status = optiga_comms_open(me->p_optiga->p_optiga_comms);
+
+                if (OPTIGA_LIB_SUCCESS != me->exit_status)
+                {
+                    EXIT_STATE_WITH_ERROR(me,*exit_loop);
+                    break;
+                }
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+                // OPTIGA is awake from the reset at the open of the communication
+                if (OPTIGA_CMD_PARAM_INITIALIZE_APP_CONTEXT != me->cmd_param)
+                {
+                    me->p_optiga->statistics.energy.restores++;
+                }
+                optiga_cmd_statistics_energy_transition(me->p_optiga, OPTIGA_CMD_ENERGY_STATE_AWAKE);
+#endif //OPTIGA_LIB_STATISTICS_ENABLED
+                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_COMMS_OPEN_DONE;
+                break;
+            }
+            case OPTIGA_CMD_EXEC_COMMS_OPEN_DONE:
+            {
+#ifdef OPTIGA_LIB_FAST_RESUME_ENABLED
+                me->p_optiga->resume_comms_open_time = pal_os_timer_get_time_in_microseconds() -
+                                                       me->p_optiga->resume_start_time;
+#endif //OPTIGA_LIB_FAST_RESUME_ENABLED
+                PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(me->p_optiga->p_pal_os_event_ctx,
+                                                       (register_callback)optiga_cmd_event_trigger_execute,
+                                                       me, OPTIGA_CMD_SCHEDULER_RUNNING_TIME_MS);
+                me->cmd_next_execution_state = OPTIGA_CMD_EXEC_PREPARE_COMMAND;
+                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_PREPARE_APDU;
+                break;
+            }
+            default:
+                EXIT_STATE_WITH_ERROR(me,*exit_loop);
+            break;
+            //lint --e{788} suppress "Not all states are used as same enum is used for both main and sub state machine."
+        }
+
+    } while ((FALSE == *exit_loop) && (OPTIGA_CMD_EXEC_COMMS_OPEN == me->cmd_next_execution_state));
+}
+
+_STATIC_H void optiga_cmd_execute_comms_close(optiga_cmd_t * me, uint8_t * exit_loop)
+{
+    do
+    {
+        *exit_loop = TRUE;
+        switch (me->cmd_sub_execution_state)
+        {
+            case OPTIGA_CMD_EXEC_COMMS_CLOSE_START:
+            {
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+                // In case PRL is enabled and save context is not invoked or is PRL is not enabled,
+                //change state to OPTIGA_CMD_EXEC_COMMS_CLOSE_DONE, since it synchronous in nature
+                if (OPTIGA_COMMS_SESSION_CONTEXT_SAVE != me->manage_context_operation)
+                {
+                    me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_COMMS_CLOSE_DONE;
+                }
+                me->p_optiga->p_optiga_comms->protection_level =  me->protection_level;
+                me->p_optiga->p_optiga_comms->protocol_version = me->protocol_version;
+                if (0 != me->p_optiga->protection_level_state)
+                {
+                    me->p_optiga->p_optiga_comms->manage_context_operation = me->manage_context_operation;
+                }
+                else
+                {
+                    me->p_optiga->p_optiga_comms->manage_context_operation = OPTIGA_COMMS_SESSION_CONTEXT_NONE;
+                }
+                me->p_optiga->protection_level_state = 0;
+#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_COMMS_CLOSE_DONE;
+
+                me->p_optiga->p_optiga_comms->p_pal_os_event_ctx = me->p_optiga->p_pal_os_event_ctx;
+
+                (void)optiga_comms_set_callback_context(me->p_optiga->p_optiga_comms, me);
+                me->exit_status = optiga_comms_close(me->p_optiga->p_optiga_comms);
+
+                if (OPTIGA_LIB_SUCCESS != me->exit_status)
+                {
+                    EXIT_STATE_WITH_ERROR(me,*exit_loop);
+                    break;
+                }
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+                if (OPTIGA_CMD_PARAM_INITIALIZE_APP_CONTEXT != me->cmd_param)
+                {
+                    me->p_optiga->statistics.energy.hibernates++;
+                    optiga_cmd_statistics_energy_transition(me->p_optiga, OPTIGA_CMD_ENERGY_STATE_HIBERNATED);
+                }
+                else
+                {
+                    optiga_cmd_statistics_energy_transition(me->p_optiga, OPTIGA_CMD_ENERGY_STATE_OFF);
+                }
+#endif //OPTIGA_LIB_STATISTICS_ENABLED
+
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+                // In case PRL is enabled and save context is requested,
+                //change state to OPTIGA_CMD_EXEC_COMMS_CLOSE_DONE, since it asynchronous in nature
+                if (OPTIGA_COMMS_SESSION_CONTEXT_SAVE == me->manage_context_operation)
+                {
+                    me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_COMMS_CLOSE_DONE;
+                    *exit_loop = TRUE;
+                }
+                // For synchronous behavior: After exit from optiga_comms_close, release lock
+                else
+                {
+                    me->exit_status = optiga_cmd_release_lock(me);
+                }
+#else
+                me->exit_status = optiga_cmd_release_lock(me);
+#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+                break;
+            }
+            case OPTIGA_CMD_EXEC_COMMS_CLOSE_DONE:
+            {
+                OPTIGA_LIB_TRACE_END(OPTIGA_LIB_TRACE_LAYER_API,
+                                     OPTIGA_LIB_TRACE_INSTANCE_CODE(me->queue_id, OPTIGA_CMD_GET_APDU_CMD(me->apdu_data)));
+                me->handler(me->caller_context, OPTIGA_LIB_SUCCESS);
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+                // For asynchronous behavior, change state to release the lock
+                if (OPTIGA_COMMS_SESSION_CONTEXT_SAVE == me->manage_context_operation)
+                {
+                    me->exit_status = optiga_cmd_release_lock(me);
+                }
+#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+                break;
+            }
+            default:
+                EXIT_STATE_WITH_ERROR(me,*exit_loop);
+            break;
+            //lint --e{788} suppress "Not all states are used as same enum is used for both main and sub state machine."
+        }
+    } while ((FALSE == *exit_loop) && (OPTIGA_CMD_EXEC_COMMS_CLOSE == me->cmd_next_execution_state));
+}
+
+#ifdef OPTIGA_CMD_DOUBLE_BUFFERED_APDU
+/*
+* Returns the communication buffer other than the given one
+*/
+_STATIC_H uint8_t * optiga_cmd_get_other_comms_buffer(optiga_context_t * p_optiga, const uint8_t * p_buffer)
+{
+    return (((p_optiga->optiga_comms_buffer_list[0] + OPTIGA_COMMS_TX_HEADROOM) == p_buffer) ?
+            (p_optiga->optiga_comms_buffer_list[1] + OPTIGA_COMMS_TX_HEADROOM) :
+            (p_optiga->optiga_comms_buffer_list[0] + OPTIGA_COMMS_TX_HEADROOM));
+}
+
+/*
+* Prepares the next chunk of a chained set data command, while the current chunk is on the wire.
+* The next chunk of set data does not depend on the response of the current chunk.
+* Returns TRUE, if the next chunk is prepared.
+*/
+_STATIC_H uint8_t optiga_cmd_prepare_next_chunk(optiga_cmd_t * me)
+{
+    optiga_context_t * p_optiga = me->p_optiga;
+    uint8_t * p_active_buffer = p_optiga->optiga_comms_buffer;
+    uint16_t active_tx_size = p_optiga->comms_tx_size;
+    uint8_t active_chaining_ongoing = me->chaining_ongoing;
+    optiga_cmd_state_t active_execution_state = me->cmd_next_execution_state;
+    uint8_t is_prepared = FALSE;
+
+    do
+    {
+        if ((FALSE == me->chaining_ongoing) ||
+            (OPTIGA_CMD_SET_DATA_OBJECT != OPTIGA_CMD_GET_APDU_CMD(me->apdu_data)))
+        {
+            break;
+        }
+
+        p_optiga->optiga_comms_buffer = optiga_cmd_get_other_comms_buffer(p_optiga, p_active_buffer);
+        me->cmd_next_execution_state = OPTIGA_CMD_EXEC_PREPARE_COMMAND;
+        if (OPTIGA_LIB_SUCCESS == me->cmd_hdlrs(me))
+        {
+            p_optiga->p_prepared_ctx = me;
+            p_optiga->p_prepared_buffer = p_optiga->optiga_comms_buffer;
+            p_optiga->prepared_tx_size = p_optiga->comms_tx_size;
+            p_optiga->prepared_chaining_ongoing = me->chaining_ongoing;
+            is_prepared = TRUE;
+        }
+        // continue with the chunk on the wire
+        me->cmd_next_execution_state = active_execution_state;
+        me->chaining_ongoing = active_chaining_ongoing;
+        p_optiga->optiga_comms_buffer = p_active_buffer;
+        p_optiga->comms_tx_size = active_tx_size;
+    } while (FALSE);
+    return (is_prepared);
+}
+
+/*
+* Prepares the APDU of the next requester in the other communication buffer, while the current command is on the wire.
+* The next chunk of the chained command on the wire takes precedence, since the lock is retained across the chunks.
+* Otherwise, only a lock request at the head of the highest ready priority class is prepared, since the session of a
+* session request and the strict lock are resolved at dispatch.
+*/
+_STATIC_H void optiga_cmd_prepare_next_apdu(optiga_cmd_t * me)
+{
+    optiga_context_t * p_optiga = me->p_optiga;
+    uint8_t * p_active_buffer = p_optiga->optiga_comms_buffer;
+    uint16_t active_tx_size = p_optiga->comms_tx_size;
+    optiga_cmd_queue_slot_t * p_queue_entry;
+    optiga_cmd_t * p_next;
+    uint8_t index = OPTIGA_CMD_QUEUE_INVALID_INDEX;
+    uint8_t priority;
+
+    do
+    {
+        if (NULL != p_optiga->p_prepared_ctx)
+        {
+            break;
+        }
+        if (TRUE == optiga_cmd_prepare_next_chunk(me))
+        {
+            break;
+        }
+        for (priority = 0; priority < OPTIGA_LIB_NUMBER_OF_PRIORITIES; priority++)
+        {
+            index = p_optiga->queue_ready_head[priority];
+            if (OPTIGA_CMD_QUEUE_INVALID_INDEX != index)
+            {
+                break;
+            }
+        }
+        if (OPTIGA_CMD_QUEUE_INVALID_INDEX == index)
+        {
+            break;
+        }
+        p_queue_entry = &p_optiga->optiga_cmd_execution_queue[index];
+        p_next = (optiga_cmd_t *)p_queue_entry->registered_ctx;
+        if ((OPTIGA_CMD_QUEUE_REQUEST_LOCK != p_queue_entry->request_type) ||
+            (OPTIGA_CMD_EXEC_PREPARE_COMMAND != p_next->cmd_next_execution_state) ||
+            (OPTIGA_CMD_EXEC_PREPARE_APDU != p_next->cmd_sub_execution_state))
+        {
+            break;
+        }
+
+        p_optiga->optiga_comms_buffer = optiga_cmd_get_other_comms_buffer(p_optiga, p_active_buffer);
+        // If preparing fails, the APDU is prepared again at dispatch, which reports the error
+        if (OPTIGA_LIB_SUCCESS == p_next->cmd_hdlrs(p_next))
+        {
+            p_optiga->p_prepared_ctx = p_next;
+            p_optiga->p_prepared_buffer = p_optiga->optiga_comms_buffer;
+            p_optiga->prepared_tx_size = p_optiga->comms_tx_size;
+            p_optiga->prepared_chaining_ongoing = p_next->chaining_ongoing;
+        }
+        // continue with the command on the wire
+        p_optiga->optiga_comms_buffer = p_active_buffer;
+        p_optiga->comms_tx_size = active_tx_size;
+    } while (FALSE);
+}
+#endif //OPTIGA_CMD_DOUBLE_BUFFERED_APDU
+
+#ifdef OPTIGA_COMMS_ZERO_COPY_RX
+/*
+* Registers the user provided buffer of a read data command as destination of the response data, which is then
+* stored there by the communication stack instead of the communication buffer
+*/
+_STATIC_H void optiga_cmd_set_rx_destination(const optiga_cmd_t * me)
+{
+    optiga_comms_t * p_optiga_comms = me->p_optiga->p_optiga_comms;
+    const optiga_get_data_object_params_t * p_optiga_read_data;
+
+    p_optiga_comms->p_rx_destination = NULL;
+    if (OPTIGA_CMD_GET_DATA_OBJECT == OPTIGA_CMD_GET_APDU_CMD(me->apdu_data))
+    {
+        p_optiga_read_data = (const optiga_get_data_object_params_t *)me->p_input;
+        // Metadata is not limited by the APDU, hence exceeding the user provided buffer is reported by the handler
+        if ((OPTIGA_CMD_READ_DATA == p_optiga_read_data->data_or_metadata) &&
+            (NULL != p_optiga_read_data->buffer) && (NULL == p_optiga_read_data->stream_callback))
+        {
+            p_optiga_comms->p_rx_destination = p_optiga_read_data->buffer + p_optiga_read_data->accumulated_size;
+            p_optiga_comms->rx_destination_offset = OPTIGA_CMD_APDU_INDATA_OFFSET;
+            p_optiga_comms->rx_destination_size = p_optiga_read_data->last_read_size;
+        }
+    }
+}
+#endif //OPTIGA_COMMS_ZERO_COPY_RX
+
+/*
+* Prepares the APDU of the instance in the communication buffer, unless it is already prepared
+*/
+_STATIC_H optiga_lib_status_t optiga_cmd_prepare_apdu(optiga_cmd_t * me)
+{
+    optiga_lib_status_t return_status = OPTIGA_LIB_SUCCESS;
+#ifdef OPTIGA_CMD_DOUBLE_BUFFERED_APDU
+    optiga_context_t * p_optiga = me->p_optiga;
+
+    if (me == p_optiga->p_prepared_ctx)
+    {
+        // APDU is prepared, while the previous command was on the wire
+        p_optiga->optiga_comms_buffer = p_optiga->p_prepared_buffer;
+        p_optiga->comms_tx_size = p_optiga->prepared_tx_size;
+        me->chaining_ongoing = p_optiga->prepared_chaining_ongoing;
+        p_optiga->p_prepared_ctx = NULL;
+    }
+    else
+    {
+        if (NULL != p_optiga->p_prepared_ctx)
+        {
+            // retain the APDU prepared for other instance
+            p_optiga->optiga_comms_buffer = optiga_cmd_get_other_comms_buffer(p_optiga, p_optiga->p_prepared_buffer);
+        }
+        return_status = me->cmd_hdlrs(me);
+    }
+#else
+    return_status = me->cmd_hdlrs(me);
+#endif //OPTIGA_CMD_DOUBLE_BUFFERED_APDU
+    return (return_status);
+}
+
+_STATIC_H void optiga_cmd_execute_prepare_command(optiga_cmd_t * me, uint8_t * exit_loop)
+{
+    OPTIGA_LIB_PROFILE_DECLARE(profile_start)
+    do
+    {
+        switch (me->cmd_sub_execution_state)
+        {
+            case OPTIGA_CMD_EXEC_REQUEST_LOCK:
+            case OPTIGA_CMD_EXEC_REQUEST_SESSION:
+            {
+                *exit_loop = TRUE;
+                if (me->cmd_sub_execution_state == OPTIGA_CMD_EXEC_REQUEST_SESSION)
+                {
+                    me->exit_status = optiga_cmd_request_session(me);
+                }
+                else
+                {
+                    me->exit_status = optiga_cmd_request_lock(me, OPTIGA_CMD_QUEUE_REQUEST_LOCK);
+                }
+#ifdef OPTIGA_CMD_SESSION_POOL_ENABLED
+                // The status is reported to the caller as it is
+                if (OPTIGA_CMD_ERROR_SESSION_UNAVAILABLE == me->exit_status)
+                {
+                    me->cmd_next_execution_state = OPTIGA_CMD_EXEC_ERROR_HANDLER;
+                    *exit_loop = FALSE;
+                    break;
+                }
+#endif //OPTIGA_CMD_SESSION_POOL_ENABLED
+                if (OPTIGA_LIB_SUCCESS != me->exit_status)
+                {
+                    EXIT_STATE_WITH_ERROR(me,*exit_loop);
+                    break;
+                }
+
+                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_PREPARE_APDU;
+                break;
+            }
+            case OPTIGA_CMD_EXEC_RESET_STRICT_LOCK:
+            {
+                optiga_cmd_release_strict_lock(me);
+                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_REQUEST_STRICT_LOCK;
+                *exit_loop = FALSE;
+                break;
+            }
+            case OPTIGA_CMD_EXEC_REQUEST_STRICT_LOCK:
+            {
+#ifdef OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+                me->strict_lock_revoked = FALSE;
+#endif //OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+                me->exit_status = optiga_cmd_request_lock(me, OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK);
+                if (OPTIGA_LIB_SUCCESS != me->exit_status)
+                {
+                    EXIT_STATE_WITH_ERROR(me,*exit_loop);
+                    break;
+                }
+                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_PREPARE_APDU;
+                *exit_loop = TRUE;
+                break;
+            }
+            case OPTIGA_CMD_EXEC_PREPARE_APDU:
+            {
+                *exit_loop = TRUE;
+                // The command code is known, once the APDU is encoded
+                OPTIGA_LIB_TRACE_BEGIN(OPTIGA_LIB_TRACE_LAYER_CMD, OPTIGA_LIB_TRACE_INSTANCE_CODE(me->queue_id, 0));
+                OPTIGA_LIB_PROFILE_BEGIN(profile_start);
+                me->exit_status = optiga_cmd_prepare_apdu(me);
+                OPTIGA_LIB_PROFILE_END(OPTIGA_LIB_PROFILE_CMD_PREPARE, profile_start, me->p_optiga->comms_tx_size);
+                if (OPTIGA_LIB_SUCCESS != me->exit_status)
+                {
+                    OPTIGA_LIB_TRACE_ERROR(OPTIGA_LIB_TRACE_LAYER_CMD, OPTIGA_LIB_TRACE_INSTANCE_CODE(me->queue_id, 0));
+                    me->cmd_next_execution_state = OPTIGA_CMD_EXEC_ERROR_HANDLER;
+                    *exit_loop = FALSE;
+                    break;
+                }
+#if defined (OPTIGA_LIB_TRACE_ENABLED) || defined (OPTIGA_LIB_STATISTICS_ENABLED)
+                me->command_code = me->p_optiga->optiga_comms_buffer[OPTIGA_COMMS_DATA_OFFSET] &
+                                   (uint8_t)(~OPTIGA_CMD_CLEAR_LAST_ERROR);
+#endif
+                OPTIGA_LIB_TRACE_END(OPTIGA_LIB_TRACE_LAYER_CMD, OPTIGA_LIB_TRACE_INSTANCE_CODE(me->queue_id, me->command_code));
+                me->p_optiga->comms_rx_size = OPTIGA_CMD_TOTAL_COMMS_BUFFER_SIZE;
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+#ifdef OPTIGA_COMMS_PROTECTION_POLICY_ENABLED
+                me->p_optiga->p_optiga_comms->protection_level = optiga_cmd_get_protection_level(me);
+#else
+                me->p_optiga->p_optiga_comms->protection_level = me->protection_level;
+#endif //OPTIGA_COMMS_PROTECTION_POLICY_ENABLED
+                me->p_optiga->p_optiga_comms->protocol_version = me->protocol_version;
+                me->p_optiga->protection_level_state |= me->p_optiga->p_optiga_comms->protection_level;
+#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+                (void)optiga_comms_set_callback_context(me->p_optiga->p_optiga_comms, me);
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+                optiga_cmd_execution_time_start(me->p_optiga);
+#endif //OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+                me->p_optiga->command_start_time = pal_os_timer_get_time_in_microseconds();
+#endif //OPTIGA_LIB_STATISTICS_ENABLED
+#ifdef OPTIGA_CMD_FAIR_SHARE_ENABLED
+                me->p_optiga->fair_share_start_time = pal_os_timer_get_time_in_microseconds();
+#endif //OPTIGA_CMD_FAIR_SHARE_ENABLED
+                OPTIGA_LIB_TRACE_BEGIN(OPTIGA_LIB_TRACE_LAYER_COMMS,
+                                       OPTIGA_LIB_TRACE_INSTANCE_CODE(me->queue_id, me->command_code));
+#ifdef OPTIGA_COMMS_ZERO_COPY_RX
+                optiga_cmd_set_rx_destination(me);
+#endif //OPTIGA_COMMS_ZERO_COPY_RX
+                me->exit_status = optiga_comms_transceive(me->p_optiga->p_optiga_comms,
+                                                          me->p_optiga->optiga_comms_buffer,
+                                                          me->p_optiga->comms_tx_size,
+                                                          me->p_optiga->optiga_comms_buffer,
+                                                          &(me->p_optiga->comms_rx_size));
+
+                if (OPTIGA_LIB_SUCCESS != me->exit_status)
+                {
+                    OPTIGA_LIB_TRACE_ERROR(OPTIGA_LIB_TRACE_LAYER_COMMS,
+                                           OPTIGA_LIB_TRACE_INSTANCE_CODE(me->queue_id, me->command_code));
+                    EXIT_STATE_WITH_ERROR(me,*exit_loop);
+                    break;
+                }
+
+                me->cmd_next_execution_state = OPTIGA_CMD_EXEC_PROCESS_RESPONSE;
+                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_PROCESS_OPTIGA_RESPONSE;
+                SET_DEV_ERROR_NOTIFICATION(OPTIGA_CMD_ENTER_HANDLER_CALL);
+#ifdef OPTIGA_CMD_DOUBLE_BUFFERED_APDU
+                optiga_cmd_prepare_next_apdu(me);
+#endif //OPTIGA_CMD_DOUBLE_BUFFERED_APDU
+                break;
+            }
+            default:
+                EXIT_STATE_WITH_ERROR(me,*exit_loop);
+            break;
+            //lint --e{788} suppress "Not all states are used as same enum is used for both main and sub state machine."
+        }
+    } while ((FALSE == *exit_loop) && (OPTIGA_CMD_EXEC_PREPARE_COMMAND == me->cmd_next_execution_state));
+}
+
+_STATIC_H void optiga_cmd_execute_get_device_error(optiga_cmd_t * me, uint8_t * exit_loop)
+{
+    do
+    {
+        *exit_loop = TRUE;
+        me->exit_status = optiga_cmd_get_error_code_handler(me);
+        if (((OPTIGA_LIB_SUCCESS != me->exit_status) && !(OPTIGA_DEVICE_ERROR & me->exit_status)) ||
+            ((OPTIGA_DEVICE_ERROR == me->exit_status) &&
+            ((me->device_error_status & OPTIGA_CMD_ERROR_CODE_STATE_MASK) == OPTIGA_CMD_ERROR_CODE_RX)))
+        {
+            me->cmd_next_execution_state = OPTIGA_CMD_EXEC_ERROR_HANDLER;
+            *exit_loop = FALSE;
+            break;
+        }
+#ifdef OPTIGA_CMD_RUN_TO_IO_ENABLED
+        // The error code is received, the response is processed right away as there is no I/O
+        if (OPTIGA_CMD_EXEC_PROCESS_OPTIGA_RESPONSE == me->cmd_sub_execution_state)
+        {
+            *exit_loop = FALSE;
+        }
+#endif //OPTIGA_CMD_RUN_TO_IO_ENABLED
+    } while (FALSE);
+}
+
+_STATIC_H void optiga_cmd_execute_process_optiga_response(optiga_cmd_t * me, uint8_t * exit_loop)
+{
+    optiga_cmd_handler_t optiga_cmd_handler = me->cmd_hdlrs;
+    OPTIGA_LIB_PROFILE_DECLARE(profile_start)
+    do
+    {
+        *exit_loop = TRUE;
+        if (OPTIGA_CMD_ZERO_LENGTH_OR_VALUE != (me->device_error_status & OPTIGA_CMD_ENTER_HANDLER_CALL_MASK))
+        {
+            OPTIGA_LIB_PROFILE_BEGIN(profile_start);
+            me->exit_status = optiga_cmd_handler(me);
+            OPTIGA_LIB_PROFILE_END(OPTIGA_LIB_PROFILE_CMD_PARSE, profile_start, me->p_optiga->comms_rx_size);
+        }
+        else
+        {
+            me->cmd_next_execution_state = OPTIGA_CMD_EXEC_ERROR_HANDLER;
+            *exit_loop = FALSE;
+            break;
+        }
+        if (OPTIGA_LIB_SUCCESS == me->exit_status)
+        {
+            // After successful Close Application, change state to invoke optiga_comms_close
+            if (OPTIGA_CMD_CLOSE_APPLICATION == OPTIGA_CMD_GET_APDU_CMD(me->apdu_data))
+            {
+                PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(me->p_optiga->p_pal_os_event_ctx,
+                                                       (register_callback)optiga_cmd_event_trigger_execute,
+                                                       me,
+                                                       OPTIGA_CMD_SCHEDULER_IDLING_TIME_MS);
+                *exit_loop = TRUE;
+                me->cmd_next_execution_state = OPTIGA_CMD_EXEC_COMMS_CLOSE;
+                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_COMMS_CLOSE_START;
+            }
+            else
+            {
+                if (FALSE == me->chaining_ongoing)
+                {
+                    if ((OPTIGA_CMD_STATE_EXIT != me->cmd_sub_execution_state) && (OPTIGA_CMD_EXEC_RELEASE_SESSION != me->cmd_sub_execution_state))
+                    {
+                        me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_RELEASE_LOCK;
+                    }
+                    *exit_loop = FALSE;
+                    break;
+                }
+                // for chaining, trigger preparing of next command
+                else
+                {
+                    // The comms stack is still in use while its callback is running, hence the next chunk
+                    // (prepared already with double buffered APDUs) is sent from the pal os event
+                    PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(me->p_optiga->p_pal_os_event_ctx,
+                                                           (register_callback)optiga_cmd_event_trigger_execute,
+                                                           (void*)me,
+                                                           OPTIGA_CMD_SCHEDULER_IDLING_TIME_MS);
+                    *exit_loop = TRUE;
+
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+                    me->protection_level &= OPTIGA_PROTECTION_LEVEL_MASK;
+#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+
+                    me->cmd_next_execution_state = OPTIGA_CMD_EXEC_PREPARE_COMMAND;
+                    me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_PREPARE_APDU;
+                }
+            }
+        }
+        else
+        {
+            // After OPTIGA error is analyzed, invoke upper layer handler and release lock
+            if (OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT == me->exit_status)
+            {
+                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_RELEASE_LOCK;
+                *exit_loop = FALSE;
+                break;
+            }
+            else if (OPTIGA_CMD_EXEC_RELEASE_SESSION == me->cmd_sub_execution_state)
+            {
+                *exit_loop = FALSE;
+            }
+#ifdef OPTIGA_CMD_LAZY_DEVICE_ERROR_ENABLED
+            // The error code is not analyzed by the handler, hence the failure is reported without reading it
+            else if (OPTIGA_CMD_ZERO_LENGTH_OR_VALUE == (me->device_error_status & OPTIGA_CMD_ENTER_HANDLER_CALL_MASK))
+            {
+                me->exit_status = OPTIGA_DEVICE_ERROR_CODE_NOT_READ;
+                me->cmd_next_execution_state = OPTIGA_CMD_EXEC_ERROR_HANDLER;
+                *exit_loop = FALSE;
+            }
+#endif //OPTIGA_CMD_LAZY_DEVICE_ERROR_ENABLED
+            // After OPTIGA responds with failure, invoke the next state to check which error occurred
+            else
+            {
+                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_GET_DEVICE_ERROR;
+                SET_DEV_ERROR_HANDLER_STATE(OPTIGA_CMD_ERROR_CODE_PREPARE);
+                *exit_loop = FALSE;
+            }
+        }
+    } while (FALSE);
+}
+
+_STATIC_H void optiga_cmd_execute_process_response(optiga_cmd_t * me, uint8_t * exit_loop)
+{
+    do
+    {
+        switch (me->cmd_sub_execution_state)
+        {
+            case OPTIGA_CMD_EXEC_PROCESS_OPTIGA_RESPONSE:
+            {
+                optiga_cmd_execute_process_optiga_response(me, exit_loop);
+                break;
+            }
+            case OPTIGA_CMD_EXEC_GET_DEVICE_ERROR:
+            {
+                optiga_cmd_execute_get_device_error(me, exit_loop);
+                break;
+            }
+            case OPTIGA_CMD_EXEC_RELEASE_SESSION:
+            {
+                //lint --e{534} suppress "The return code is not checked because this is exit state."
+                optiga_cmd_release_session(me);
+                if (OPTIGA_LIB_SUCCESS == me->exit_status)
+                {
+                    me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_RELEASE_LOCK;
+                }
+                else
+                {
+                    me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_GET_DEVICE_ERROR;
+                    SET_DEV_ERROR_HANDLER_STATE(OPTIGA_CMD_ERROR_CODE_PREPARE);
+                }
+                *exit_loop = FALSE;
+                break;
+            }
+            case OPTIGA_CMD_EXEC_RELEASE_LOCK:
+            {
+#ifdef OPTIGA_CMD_CANCEL_ENABLED
+                // Result of a cancelled request is discarded and the remaining items of the batch are not executed
+                if (TRUE == me->cancel_requested)
+                {
+                    me->exit_status = OPTIGA_CMD_ERROR_CANCELLED;
+                    optiga_cmd_batch_abort(me);
+                }
+#endif //OPTIGA_CMD_CANCEL_ENABLED
+                // Next item of the batch is executed without releasing the lock
+                if (TRUE == optiga_cmd_batch_next_item(me))
+                {
+                    *exit_loop = TRUE;
+                    break;
+                }
+                //lint --e{534} suppress "The return code is not checked because this is exit state."
+                optiga_cmd_release_lock(me);
+                me->cmd_sub_execution_state = OPTIGA_CMD_STATE_EXIT;
+                *exit_loop = FALSE;
+                break;
+            }
+            case OPTIGA_CMD_STATE_EXIT:
+            {
+#ifdef OPTIGA_LIB_FAST_RESUME_ENABLED
+                optiga_cmd_resume_stats_update(me);
+#endif //OPTIGA_LIB_FAST_RESUME_ENABLED
+#ifdef OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+                // hold time of a retained strict lock starts with the completion of the step
+                if (OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK == optiga_cmd_queue_get_state_of(me, OPTIGA_CMD_QUEUE_SLOT_LOCK_TYPE))
+                {
+                    me->p_optiga->strict_lock_step_time = pal_os_timer_get_time_in_microseconds();
+                }
+#endif //OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+                OPTIGA_LIB_TRACE_COMPLETE(OPTIGA_LIB_TRACE_LAYER_API,
+                                          OPTIGA_LIB_TRACE_INSTANCE_CODE(me->queue_id, OPTIGA_CMD_GET_APDU_CMD(me->apdu_data)),
+                                          (OPTIGA_LIB_SUCCESS == me->exit_status));
+                me->handler(me->caller_context, me->exit_status);
+                *exit_loop = TRUE;
+                break;
+            }
+            default:
+                EXIT_STATE_WITH_ERROR(me,*exit_loop);
+            break;
+            //lint --e{788} suppress "Not all states are used as same enum is used for both main and sub state machine."
+        }
+    } while ((FALSE == *exit_loop) && (OPTIGA_CMD_EXEC_PROCESS_RESPONSE == me->cmd_next_execution_state));
+}
+
+_STATIC_H void optiga_cmd_execute_error_handler(optiga_cmd_t * me, uint8_t * exit_loop)
+{
+    do
+    {
+#ifdef OPTIGA_CMD_CANCEL_ENABLED
+        if (TRUE == me->cancel_requested)
+        {
+            me->exit_status = OPTIGA_CMD_ERROR_CANCELLED;
+        }
+#endif //OPTIGA_CMD_CANCEL_ENABLED
+        // A failure reported by OPTIGA does not stop a batch, the next item is executed without releasing the lock
+        if ((OPTIGA_DEVICE_ERROR == (me->exit_status & OPTIGA_DEVICE_ERROR)) && (TRUE == optiga_cmd_batch_next_item(me)))
+        {
+            *exit_loop = TRUE;
+            break;
+        }
+        optiga_cmd_batch_abort(me);
+        //lint --e{534} suppress "The return code is not checked because this is exit state."
+        optiga_cmd_release_lock(me);
+#ifdef OPTIGA_LIB_FAST_RESUME_ENABLED
+        optiga_cmd_resume_stats_update(me);
+#endif //OPTIGA_LIB_FAST_RESUME_ENABLED
+        OPTIGA_LIB_TRACE_ERROR(OPTIGA_LIB_TRACE_LAYER_API,
+                               OPTIGA_LIB_TRACE_INSTANCE_CODE(me->queue_id, OPTIGA_CMD_GET_APDU_CMD(me->apdu_data)));
+        me->handler(me->caller_context, me->exit_status);
+        *exit_loop = TRUE;
+    } while (FALSE);
+}
+
+_STATIC_H void optiga_cmd_execute_handler(void * p_ctx, optiga_lib_status_t event)
+{
+    uint8_t exit_loop = TRUE;
+    optiga_cmd_t * me = (optiga_cmd_t *)p_ctx;
+
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+    optiga_cmd_execution_time_update(me->p_optiga, event);
+#endif //OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+#if defined (OPTIGA_LIB_TRACE_ENABLED) || defined (OPTIGA_LIB_STATISTICS_ENABLED)
+    // Response of the APDU exchanged through comms
+    if ((OPTIGA_CMD_EXEC_PROCESS_RESPONSE == me->cmd_next_execution_state) &&
+        (OPTIGA_CMD_EXEC_PROCESS_OPTIGA_RESPONSE == me->cmd_sub_execution_state))
+    {
+        OPTIGA_LIB_TRACE_COMPLETE(OPTIGA_LIB_TRACE_LAYER_COMMS,
+                                  OPTIGA_LIB_TRACE_INSTANCE_CODE(me->queue_id, me->command_code),
+                                  (OPTIGA_LIB_SUCCESS == event));
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+        optiga_cmd_statistics_update(me, event);
+#endif //OPTIGA_LIB_STATISTICS_ENABLED
+    }
+#endif
+#ifdef OPTIGA_CMD_SEC_PACING_ENABLED
+    if ((OPTIGA_CMD_EXEC_PROCESS_RESPONSE == me->cmd_next_execution_state) &&
+        (OPTIGA_CMD_EXEC_PROCESS_OPTIGA_RESPONSE == me->cmd_sub_execution_state))
+    {
+        optiga_cmd_sec_pacing_update(me, event);
+    }
+#endif //OPTIGA_CMD_SEC_PACING_ENABLED
+#ifdef OPTIGA_CMD_FAIR_SHARE_ENABLED
+    if ((OPTIGA_CMD_EXEC_PROCESS_RESPONSE == me->cmd_next_execution_state) &&
+        (OPTIGA_CMD_EXEC_PROCESS_OPTIGA_RESPONSE == me->cmd_sub_execution_state))
+    {
+        optiga_cmd_fair_share_update(me);
+    }
+#endif //OPTIGA_CMD_FAIR_SHARE_ENABLED
+#ifdef OPTIGA_CMD_HEALTH_MONITOR_ENABLED
+    if (OPTIGA_CMD_EXEC_RECOVERY == me->cmd_next_execution_state)
+    {
+        // Events of the reset and open application are evaluated by the recovery
+        me->exit_status = event;
+    }
+    else if ((OPTIGA_LIB_SUCCESS != event) && (TRUE == optiga_cmd_recovery_start(me, event)))
+    {
+        // The command is resent or its failure is reported after the recovery
+    }
+    else
+#endif //OPTIGA_CMD_HEALTH_MONITOR_ENABLED
+    // in event of no success, release lock and exit
+    if (OPTIGA_LIB_SUCCESS != event)
+    {
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+        optiga_cmd_clear_app_ctx(p_ctx);
+#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+        me->cmd_next_execution_state = OPTIGA_CMD_EXEC_ERROR_HANDLER;
+        me->exit_status = event;
+    }
+
+    do
+    {
+        switch (me->cmd_next_execution_state)
+        {
+            case OPTIGA_CMD_EXEC_COMMS_OPEN:
+            {
+                optiga_cmd_execute_comms_open(me, &exit_loop);
+                break;
+            }
+            case OPTIGA_CMD_EXEC_COMMS_CLOSE:
+            {
+                optiga_cmd_execute_comms_close(me, &exit_loop);
+                break;
+            }
+            case OPTIGA_CMD_EXEC_PREPARE_COMMAND:
+            {
+                optiga_cmd_execute_prepare_command(me, &exit_loop);
+                break;
+            }
+            case OPTIGA_CMD_EXEC_PROCESS_RESPONSE:
+            {
+                optiga_cmd_execute_process_response(me, &exit_loop);
+                break;
+            }
+            case OPTIGA_CMD_EXEC_ERROR_HANDLER:
+            {
+                optiga_cmd_execute_error_handler(me, &exit_loop);
+                break;
+            }
+#ifdef OPTIGA_CMD_HEALTH_MONITOR_ENABLED
+            case OPTIGA_CMD_EXEC_RECOVERY:
+            {
+                optiga_cmd_execute_recovery(me, &exit_loop);
+                break;
+            }
+#endif //OPTIGA_CMD_HEALTH_MONITOR_ENABLED
+            default :
+                break;
+            //lint --e{788} suppress "Not all states are used as same enum is used for both main and sub state machine."
+        }
+    } while (FALSE == exit_loop);
+}
+
+/*
+* Selects the OPTIGA instance with the most free slots in the execution queue (least loaded)
+*/
+_STATIC_H uint8_t optiga_cmd_select_instance(void)
+{
+    uint8_t index;
+    uint8_t free_slots;
+    uint8_t max_free_slots = 0;
+    uint8_t selected_instance = OPTIGA_INSTANCE_ID_0;
+
+    for (index = 0; index <= OPTIGA_CMD_MAX_INSTANCE_ID; index++)
+    {
+        if (FALSE == g_optiga_list[index].instance_init_state)
+        {
+            // Instance is not yet initialized, all slots of its registry are free
+            free_slots = (NULL == g_optiga_list[index].optiga_cmd_execution_queue) ?
+                         OPTIGA_CMD_MAX_REGISTRATIONS : g_optiga_list[index].queue_size;
+        }
+        else
+        {
+            free_slots = optiga_cmd_queue_get_count_of(&g_optiga_list[index],
+                                                       OPTIGA_CMD_QUEUE_SLOT_STATE,
+                                                       OPTIGA_CMD_QUEUE_NOT_ASSIGNED);
+        }
+        if (free_slots > max_free_slots)
+        {
+            max_free_slots = free_slots;
+            selected_instance = index;
+        }
+    }
+    return (selected_instance);
+}
+
+optiga_cmd_t * optiga_cmd_create(uint8_t optiga_instance_id, callback_handler_t handler, void * caller_context)
+{
+    optiga_cmd_t * me = NULL;
+
+    pal_os_lock_enter_critical_section();
+    do
+    {
+        if (OPTIGA_INSTANCE_ID_ANY == optiga_instance_id)
+        {
+            optiga_instance_id = optiga_cmd_select_instance();
+        }
+        if (OPTIGA_CMD_MAX_INSTANCE_ID < optiga_instance_id)
+        {
+            break;
+        }
+        // No slot is assigned till the instance is initialized
+        if (FALSE == g_optiga_list[optiga_instance_id].instance_init_state)
+        {
+            optiga_cmd_queue_init(&g_optiga_list[optiga_instance_id], optiga_instance_id);
+        }
+        // Get number of free slots
+        if (0 == optiga_cmd_queue_get_count_of(&g_optiga_list[optiga_instance_id],
+                                               OPTIGA_CMD_QUEUE_SLOT_STATE,
+                                               OPTIGA_CMD_QUEUE_NOT_ASSIGNED))
+        {
+            break;
+        }
+
+        me = (optiga_cmd_t *)pal_os_calloc(1, sizeof(optiga_cmd_t));
+        if (NULL == me)
+        {
+            break;
+        }
+
+        me->handler = handler;
+        me->caller_context = caller_context;
+        me->priority = (uint8_t)OPTIGA_LIB_PRIORITY_NORMAL;
+
+        me->p_optiga = &g_optiga_list[optiga_instance_id];
+        me->optiga_context_datastore_id = g_hibernate_datastore_id_list[optiga_instance_id];
+
+        if (FALSE == me->p_optiga->instance_init_state)
+        {
+            //create pal os event
+            me->p_optiga->p_pal_os_event_ctx = PAL_OS_EVENT_CREATE(optiga_cmd_queue_scheduler, me->p_optiga);
+            me->p_optiga->p_optiga_comms = optiga_comms_create_instance(optiga_instance_id, optiga_cmd_execute_handler, me);
+            if ((NULL == me->p_optiga->p_optiga_comms) || (NULL == me->p_optiga->p_pal_os_event_ctx))
+            {
+                if (NULL != me->p_optiga->p_pal_os_event_ctx)
+                {
+                    PAL_OS_EVENT_DESTROY(me->p_optiga->p_pal_os_event_ctx);
+                    me->p_optiga->p_pal_os_event_ctx = NULL;
+                }
+                pal_os_free(me);
+                me = NULL;
+                break;
+            }
+            me->p_optiga->instance_init_state = TRUE;
+            me->p_optiga->p_optiga_comms->p_pal_os_event_ctx = me->p_optiga->p_pal_os_event_ctx;
+            // headroom in front of the buffer is used by comms to frame the APDU in place
+            me->p_optiga->optiga_comms_buffer = me->p_optiga->optiga_comms_buffer_list[0] + OPTIGA_COMMS_TX_HEADROOM;
+#ifdef OPTIGA_CMD_DOUBLE_BUFFERED_APDU
+            me->p_optiga->p_prepared_ctx = NULL;
+#endif //OPTIGA_CMD_DOUBLE_BUFFERED_APDU
+        }
+        // attach optiga cmd queue entry
+        optiga_cmd_queue_assign_slot(me, &(me->queue_id));
+    } while (FALSE);
+
+    pal_os_lock_exit_critical_section();
+    return (me);
+}
+
+optiga_lib_status_t optiga_cmd_destroy(optiga_cmd_t * me)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR;
+    do
+    {
+        if (NULL != me)
+        {
+            return_status = optiga_cmd_release_session(me);
+            // attach optiga cmd queue entry
+            optiga_cmd_queue_deassign_slot(me);
+            pal_os_free(me);
+            //lint --e{838} suppress "Release session API returns success. Status is checked for future enhancements"
+            return_status = OPTIGA_LIB_SUCCESS;
+        }
+    } while (FALSE);
+    return (return_status);
+}
+
+
+optiga_lib_status_t optiga_cmd_set_priority(optiga_cmd_t * me, uint8_t priority)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+    do
+    {
+        if (OPTIGA_LIB_NUMBER_OF_PRIORITIES <= priority)
+        {
+            break;
+        }
+        // Takes effect from the next request of the instance
+        me->priority = priority;
+        return_status = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_status);
+}
+
+#ifdef OPTIGA_CMD_DEADLINE_ENABLED
+optiga_lib_status_t optiga_cmd_set_deadline(optiga_cmd_t * me, uint32_t deadline_us)
+{
+    // Takes effect from the next request of the instance
+    me->deadline_us = deadline_us;
+    return (OPTIGA_LIB_SUCCESS);
+}
+#endif //OPTIGA_CMD_DEADLINE_ENABLED
+
+#ifdef OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+optiga_lib_status_t optiga_cmd_set_deferrable(optiga_cmd_t * me, uint32_t max_delay_ms)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+
+    if (OPTIGA_CMD_AUTO_HIBERNATE_MAX_IDLE_TIME_MS >= max_delay_ms)
+    {
+        // Takes effect from the next request of the instance
+        me->defer_delay_us = max_delay_ms * 1000U;
+        return_status = OPTIGA_LIB_SUCCESS;
+    }
+    return (return_status);
+}
+#endif //OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+
+#ifdef OPTIGA_CMD_CANCEL_ENABLED
+optiga_lib_status_t optiga_cmd_cancel(optiga_cmd_t * me)
+{
+    // The scheduler drops the request if it is still queued, else the result is discarded on completion
+    (void)optiga_cmd_atomic_exchange_byte(&me->cancel_requested, TRUE);
+#ifdef OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+    optiga_cmd_queue_scheduler_wakeup(me->p_optiga);
+#endif //OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+    return (OPTIGA_LIB_SUCCESS);
+}
+#endif //OPTIGA_CMD_CANCEL_ENABLED
+
+#ifdef OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+optiga_lib_status_t optiga_cmd_set_strict_lock_timeout(optiga_cmd_t * me, uint32_t max_hold_time_ms)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+
+    if (OPTIGA_CMD_STRICT_LOCK_MAX_HOLD_TIME_MS >= max_hold_time_ms)
+    {
+        pal_os_lock_enter_critical_section();
+        me->p_optiga->strict_lock_max_hold_us = max_hold_time_ms * 1000U;
+        pal_os_lock_exit_critical_section();
+#ifdef OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+        // the parked scheduler applies the new hold time to a strict lock held already
+        optiga_cmd_queue_scheduler_wakeup(me->p_optiga);
+#endif //OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+        return_status = OPTIGA_LIB_SUCCESS;
+    }
+    return (return_status);
+}
+#endif //OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+
+#ifdef OPTIGA_CMD_FAIR_SHARE_ENABLED
+optiga_lib_status_t optiga_cmd_set_tenant(optiga_cmd_t * me, uint8_t tenant)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+
+    if (OPTIGA_CMD_FAIR_SHARE_MAX_TENANTS > tenant)
+    {
+        // Takes effect from the next request of the instance
+        me->tenant = tenant;
+        return_status = OPTIGA_LIB_SUCCESS;
+    }
+    return (return_status);
+}
+
+optiga_lib_status_t optiga_cmd_set_tenant_weight(optiga_cmd_t * me, uint8_t tenant, uint8_t weight)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+
+    if (OPTIGA_CMD_FAIR_SHARE_MAX_TENANTS > tenant)
+    {
+        pal_os_lock_enter_critical_section();
+        // the consumed OPTIGA time is charged with the new weight from the next response
+        me->p_optiga->tenant_stats[tenant].weight = weight;
+        pal_os_lock_exit_critical_section();
+        return_status = OPTIGA_LIB_SUCCESS;
+    }
+    return (return_status);
+}
+
+optiga_lib_status_t optiga_cmd_get_tenant_stats(const optiga_cmd_t * me,
+                                                uint8_t tenant,
+                                                optiga_lib_tenant_stats_t * p_stats)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+
+    if (OPTIGA_CMD_FAIR_SHARE_MAX_TENANTS > tenant)
+    {
+        pal_os_lock_enter_critical_section();
+        pal_os_memcpy(p_stats, &me->p_optiga->tenant_stats[tenant], sizeof(optiga_lib_tenant_stats_t));
+        p_stats->weight = OPTIGA_CMD_FAIR_SHARE_WEIGHT(me->p_optiga, tenant);
+        pal_os_lock_exit_critical_section();
+        return_status = OPTIGA_LIB_SUCCESS;
+    }
+    return (return_status);
+}
+#endif //OPTIGA_CMD_FAIR_SHARE_ENABLED
+
+#ifdef OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+optiga_lib_status_t optiga_cmd_try_admit(const optiga_cmd_t * me, uint32_t max_wait_us, uint32_t * p_estimated_wait_us)
+{
+    optiga_lib_status_t return_status = OPTIGA_LIB_SUCCESS;
+    uint32_t estimated_wait_us;
+
+    pal_os_lock_enter_critical_section();
+    estimated_wait_us = optiga_cmd_admission_estimate_wait(me->p_optiga);
+    if (estimated_wait_us > max_wait_us)
+    {
+        me->p_optiga->admission_rejected_requests++;
+        return_status = OPTIGA_CMD_ERROR_QUEUE_FULL;
+    }
+    pal_os_lock_exit_critical_section();
+    if (NULL != p_estimated_wait_us)
+    {
+        *p_estimated_wait_us = estimated_wait_us;
+    }
+    return (return_status);
+}
+
+optiga_lib_status_t optiga_cmd_set_queue_watermark(const optiga_cmd_t * me,
+                                                   uint8_t high_watermark,
+                                                   uint8_t low_watermark,
+                                                   optiga_lib_queue_watermark_callback_t callback,
+                                                   void * context)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+    optiga_context_t * p_optiga = me->p_optiga;
+
+    do
+    {
+        if ((NULL != callback) &&
+            ((low_watermark >= high_watermark) || (p_optiga->queue_size < high_watermark)))
+        {
+            break;
+        }
+        pal_os_lock_enter_critical_section();
+        p_optiga->watermark_callback = callback;
+        p_optiga->watermark_context = context;
+        p_optiga->watermark_high = high_watermark;
+        p_optiga->watermark_low = low_watermark;
+        // the current load is reported with the next change of the waiting requests
+        p_optiga->watermark_reached = FALSE;
+        pal_os_lock_exit_critical_section();
+        return_status = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_status);
+}
+
+void optiga_cmd_get_queue_load(const optiga_cmd_t * me, optiga_lib_queue_load_t * p_load)
+{
+    const optiga_context_t * p_optiga = me->p_optiga;
+
+    pal_os_lock_enter_critical_section();
+    p_load->waiting_requests = p_optiga->queue_state_count[optiga_cmd_queue_get_state_index(OPTIGA_CMD_QUEUE_REQUEST)];
+    p_load->free_slots = p_optiga->queue_state_count[optiga_cmd_queue_get_state_index(OPTIGA_CMD_QUEUE_NOT_ASSIGNED)];
+    p_load->service_time_us = p_optiga->service_time_us;
+    p_load->estimated_wait_us = optiga_cmd_admission_estimate_wait(p_optiga);
+    p_load->rejected_requests = p_optiga->admission_rejected_requests;
+    pal_os_lock_exit_critical_section();
+}
+#endif //OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+
+#ifdef OPTIGA_CMD_SESSION_POOL_ENABLED
+optiga_lib_status_t optiga_cmd_set_session_policy(optiga_cmd_t * me,
+                                                  uint8_t policy,
+                                                  uint32_t lease_time_us)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+    uint8_t count;
+    do
+    {
+        if ((OPTIGA_LIB_SESSION_WAIT != policy) && (OPTIGA_LIB_SESSION_FAIL_FAST != policy))
+        {
+            break;
+        }
+        pal_os_lock_enter_critical_section();
+        me->session_policy = policy;
+        me->session_lease_time_us = lease_time_us;
+        // The lease of an assigned session starts again with the new lease time
+        for (count = 0; count < OPTIGA_CMD_MAX_NUMBER_OF_SESSIONS; count++)
+        {
+            if (me == me->p_optiga->session_holder[count])
+            {
+                me->p_optiga->session_lease_start[count] = pal_os_timer_get_time_in_microseconds();
+            }
+        }
+        pal_os_lock_exit_critical_section();
+        return_status = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_status);
+}
+
+void optiga_cmd_get_session_pool_stats(const optiga_cmd_t * me,
+                                       optiga_lib_session_pool_stats_t * p_stats)
+{
+    const optiga_context_t * p_optiga = me->p_optiga;
+    const optiga_cmd_queue_slot_t * p_queue_entry;
+    uint8_t index;
+
+    pal_os_lock_enter_critical_section();
+    p_stats->total_sessions = OPTIGA_CMD_MAX_NUMBER_OF_SESSIONS;
+    p_stats->sessions_in_use = 0;
+    for (index = 0; index < OPTIGA_CMD_MAX_NUMBER_OF_SESSIONS; index++)
+    {
+        if (OPTIGA_CMD_SESSION_ASSIGNED == p_optiga->sessions[index])
+        {
+            p_stats->sessions_in_use++;
+        }
+    }
+    p_stats->waiting_requests = 0;
+    for (index = 0; index < p_optiga->queue_size; index++)
+    {
+        p_queue_entry = &p_optiga->optiga_cmd_execution_queue[index];
+        if ((OPTIGA_CMD_QUEUE_REQUEST == p_queue_entry->state_of_entry) &&
+            (OPTIGA_CMD_QUEUE_REQUEST_SESSION == p_queue_entry->request_type) &&
+            (OPTIGA_CMD_NO_SESSION_OID == ((const optiga_cmd_t *)p_queue_entry->registered_ctx)->session_oid))
+        {
+            p_stats->waiting_requests++;
+        }
+    }
+    p_stats->rejected_requests = p_optiga->session_rejected_requests;
+    p_stats->expired_leases = p_optiga->session_expired_leases;
+    pal_os_lock_exit_critical_section();
+}
+#endif //OPTIGA_CMD_SESSION_POOL_ENABLED
+
+optiga_lib_status_t optiga_cmd_get_queue_wait_stats(const optiga_cmd_t * me,
+                                                    uint8_t priority,
+                                                    optiga_lib_queue_wait_stats_t * p_stats)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+    do
+    {
+        if (OPTIGA_LIB_NUMBER_OF_PRIORITIES <= priority)
+        {
+            break;
+        }
+        pal_os_lock_enter_critical_section();
+        pal_os_memcpy(p_stats, &me->p_optiga->queue_wait_stats[priority], sizeof(optiga_lib_queue_wait_stats_t));
+        pal_os_lock_exit_critical_section();
+        return_status = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_status);
+}
+
+#ifdef OPTIGA_COMMS_DL_RESEND_BACKOFF_ENABLED
+optiga_lib_status_t optiga_cmd_get_comms_recovery_stats(const optiga_cmd_t * me,
+                                                        optiga_lib_comms_recovery_stats_t * p_stats)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR;
+    if (OPTIGA_COMMS_SUCCESS == optiga_comms_get_recovery_stats(me->p_optiga->p_optiga_comms, p_stats))
+    {
+        return_status = OPTIGA_LIB_SUCCESS;
+    }
+    return (return_status);
+}
+#endif
+
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+optiga_lib_status_t optiga_cmd_get_statistics(const optiga_cmd_t * me,
+                                              optiga_lib_statistics_t * p_stats)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR;
+    uint32_t busy_time_ms;
+    do
+    {
+        pal_os_lock_enter_critical_section();
+        pal_os_memcpy(p_stats, &me->p_optiga->statistics, sizeof(optiga_lib_statistics_t));
+        p_stats->queue_depth = me->p_optiga->queue_state_count[optiga_cmd_queue_get_state_index(OPTIGA_CMD_QUEUE_REQUEST)];
+        // The time in the current energy state is included
+        if (OPTIGA_CMD_ENERGY_STATE_AWAKE == me->p_optiga->energy_state)
+        {
+            p_stats->energy.awake_time_ms += pal_os_timer_get_time_in_milliseconds() -
+                                             me->p_optiga->energy_state_start_time;
+        }
+        else if (OPTIGA_CMD_ENERGY_STATE_HIBERNATED == me->p_optiga->energy_state)
+        {
+            p_stats->energy.hibernated_time_ms += pal_os_timer_get_time_in_milliseconds() -
+                                                  me->p_optiga->energy_state_start_time;
+        }
+        else
+        {
+            // Time powered off is not accounted
+        }
+        pal_os_lock_exit_critical_section();
+        if (OPTIGA_COMMS_SUCCESS != optiga_comms_get_statistics(me->p_optiga->p_optiga_comms, &p_stats->comms))
+        {
+            break;
+        }
+        busy_time_ms = p_stats->comms.execution_time_ms + p_stats->comms.i2c_time_ms;
+        p_stats->energy.idle_awake_time_ms = (p_stats->energy.awake_time_ms > busy_time_ms) ?
+                                             (p_stats->energy.awake_time_ms - busy_time_ms) : 0;
+        return_status = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_status);
+}
+#endif //OPTIGA_LIB_STATISTICS_ENABLED
+
+#ifdef OPTIGA_LIB_FAST_RESUME_ENABLED
+optiga_lib_status_t optiga_cmd_get_resume_stats(const optiga_cmd_t * me,
+                                                optiga_lib_resume_stats_t * p_stats)
+{
+    pal_os_lock_enter_critical_section();
+    pal_os_memcpy(p_stats, &me->p_optiga->resume_stats, sizeof(optiga_lib_resume_stats_t));
+    pal_os_lock_exit_critical_section();
+    return (OPTIGA_LIB_SUCCESS);
+}
+#endif
+
+#ifdef OPTIGA_CMD_HEALTH_MONITOR_ENABLED
+optiga_lib_status_t optiga_cmd_get_health_stats(const optiga_cmd_t * me,
+                                                optiga_lib_health_stats_t * p_stats)
+{
+    pal_os_lock_enter_critical_section();
+    pal_os_memcpy(p_stats, &me->p_optiga->health_stats, sizeof(optiga_lib_health_stats_t));
+    pal_os_lock_exit_critical_section();
+    return (OPTIGA_LIB_SUCCESS);
+}
+#endif //OPTIGA_CMD_HEALTH_MONITOR_ENABLED
+
+#ifdef OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+/*
+* Creates the internal instance, which hibernates, restores and opens the application.
+* The internal instance is created once and kept for the lifetime of the OPTIGA instance.
+*/
+_STATIC_H optiga_lib_status_t optiga_cmd_auto_hibernate_create(const optiga_cmd_t * me)
+{
+    optiga_lib_status_t return_status = OPTIGA_LIB_SUCCESS;
+    optiga_cmd_t * p_auto_hibernate_cmd;
+
+    if (NULL == me->p_optiga->p_auto_hibernate_cmd)
+    {
+        p_auto_hibernate_cmd = optiga_cmd_create((uint8_t)(me->p_optiga - g_optiga_list),
+                                                 optiga_cmd_auto_hibernate_handler,
+                                                 me->p_optiga);
+        if (NULL == p_auto_hibernate_cmd)
+        {
+            return_status = OPTIGA_CMD_ERROR;
+        }
+        else
+        {
+            // The hibernate and restore are served before any other waiting request
+            //lint --e{534} suppress "Instance is free, return value is not required to be checked"
+            optiga_cmd_set_priority(p_auto_hibernate_cmd, OPTIGA_LIB_PRIORITY_HIGH);
+            me->p_optiga->p_auto_hibernate_cmd = p_auto_hibernate_cmd;
+        }
+    }
+    return (return_status);
+}
+
+optiga_lib_status_t optiga_cmd_set_auto_hibernate(optiga_cmd_t * me, uint32_t idle_time_ms)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+
+    do
+    {
+        if (OPTIGA_CMD_AUTO_HIBERNATE_MAX_IDLE_TIME_MS < idle_time_ms)
+        {
+            break;
+        }
+        if ((0 != idle_time_ms) && (OPTIGA_LIB_SUCCESS != optiga_cmd_auto_hibernate_create(me)))
+        {
+            return_status = OPTIGA_CMD_ERROR;
+            break;
+        }
+        pal_os_lock_enter_critical_section();
+        me->p_optiga->auto_hibernate_stats.idle_time_ms = idle_time_ms;
+        me->p_optiga->last_activity_time = pal_os_timer_get_time_in_microseconds();
+        pal_os_lock_exit_critical_section();
+#ifdef OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+        // the parked scheduler arms the idle timer with the new idle time
+        optiga_cmd_queue_scheduler_wakeup(me->p_optiga);
+#endif //OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+        return_status = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_status);
+}
+
+optiga_lib_status_t optiga_cmd_get_auto_hibernate_stats(const optiga_cmd_t * me,
+                                                        optiga_lib_auto_hibernate_stats_t * p_stats)
+{
+    pal_os_lock_enter_critical_section();
+    pal_os_memcpy(p_stats, &me->p_optiga->auto_hibernate_stats, sizeof(optiga_lib_auto_hibernate_stats_t));
+    pal_os_lock_exit_critical_section();
+    return (OPTIGA_LIB_SUCCESS);
+}
+
+#ifdef OPTIGA_CMD_LAZY_OPEN_ENABLED
+optiga_lib_status_t optiga_cmd_set_lazy_open(optiga_cmd_t * me, bool_t enable, bool_t pre_open)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR;
+
+    do
+    {
+        if ((TRUE == enable) && (OPTIGA_LIB_SUCCESS != optiga_cmd_auto_hibernate_create(me)))
+        {
+            break;
+        }
+        pal_os_lock_enter_critical_section();
+        me->p_optiga->lazy_open_enabled = enable;
+        me->p_optiga->lazy_pre_open = ((TRUE == enable) && (TRUE == pre_open)) ? TRUE : FALSE;
+        me->p_optiga->lazy_open_failed = FALSE;
+        pal_os_lock_exit_critical_section();
+#ifdef OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+        // the parked scheduler starts the pre-open
+        optiga_cmd_queue_scheduler_wakeup(me->p_optiga);
+#endif //OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+        return_status = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_status);
+}
+#endif //OPTIGA_CMD_LAZY_OPEN_ENABLED
+
+#ifdef OPTIGA_CMD_PERFORMANCE_GOVERNOR_ENABLED
+optiga_lib_status_t optiga_cmd_set_performance_policy(optiga_cmd_t * me,
+                                                      const optiga_lib_performance_policy_t * p_policy)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+
+    do
+    {
+        if ((NULL != p_policy) &&
+            ((OPTIGA_CMD_CURRENT_LIMIT_MIN > p_policy->idle_current_limit) ||
+             (p_policy->idle_current_limit > p_policy->burst_current_limit) ||
+             (OPTIGA_CMD_CURRENT_LIMIT_MAX < p_policy->burst_current_limit) ||
+             (0 == p_policy->burst_queue_depth) ||
+             (OPTIGA_CMD_AUTO_HIBERNATE_MAX_IDLE_TIME_MS < p_policy->idle_time_ms) ||
+             (OPTIGA_CMD_AUTO_HIBERNATE_MAX_IDLE_TIME_MS < p_policy->min_hold_time_ms)))
+        {
+            break;
+        }
+        if ((NULL != p_policy) && (OPTIGA_LIB_SUCCESS != optiga_cmd_auto_hibernate_create(me)))
+        {
+            return_status = OPTIGA_CMD_ERROR;
+            break;
+        }
+        pal_os_lock_enter_critical_section();
+        if (NULL == p_policy)
+        {
+            pal_os_memset(&me->p_optiga->performance_policy, 0x00, sizeof(optiga_lib_performance_policy_t));
+        }
+        else
+        {
+            pal_os_memcpy(&me->p_optiga->performance_policy, p_policy, sizeof(optiga_lib_performance_policy_t));
+        }
+        me->p_optiga->current_limit_failed = 0;
+        pal_os_lock_exit_critical_section();
+#ifdef OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+        // the parked scheduler applies the new policy
+        optiga_cmd_queue_scheduler_wakeup(me->p_optiga);
+#endif //OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+        return_status = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_status);
+}
+
+optiga_lib_status_t optiga_cmd_set_power_budget(optiga_cmd_t * me, uint8_t max_current_limit)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+
+    do
+    {
+        if ((0 != max_current_limit) &&
+            ((OPTIGA_CMD_CURRENT_LIMIT_MIN > max_current_limit) || (OPTIGA_CMD_CURRENT_LIMIT_MAX < max_current_limit)))
+        {
+            break;
+        }
+        pal_os_lock_enter_critical_section();
+        me->p_optiga->performance_stats.max_current_limit = max_current_limit;
+        pal_os_lock_exit_critical_section();
+#ifdef OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+        // the parked scheduler drops a current limitation above the power budget
+        optiga_cmd_queue_scheduler_wakeup(me->p_optiga);
+#endif //OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+        return_status = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_status);
+}
+
+optiga_lib_status_t optiga_cmd_get_performance_stats(const optiga_cmd_t * me,
+                                                     optiga_lib_performance_stats_t * p_stats)
+{
+    pal_os_lock_enter_critical_section();
+    pal_os_memcpy(p_stats, &me->p_optiga->performance_stats, sizeof(optiga_lib_performance_stats_t));
+    pal_os_lock_exit_critical_section();
+    return (OPTIGA_LIB_SUCCESS);
+}
+#endif //OPTIGA_CMD_PERFORMANCE_GOVERNOR_ENABLED
+
+#ifdef OPTIGA_CMD_SEC_PACING_ENABLED
+optiga_lib_status_t optiga_cmd_set_sec_policy(optiga_cmd_t * me, const optiga_lib_sec_policy_t * p_policy)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+
+    do
+    {
+        if ((NULL != p_policy) && (0 != p_policy->pacing_threshold) &&
+            ((0 == p_policy->decay_time_ms) ||
+             (OPTIGA_CMD_AUTO_HIBERNATE_MAX_IDLE_TIME_MS < p_policy->decay_time_ms) ||
+             (OPTIGA_CMD_AUTO_HIBERNATE_MAX_IDLE_TIME_MS < p_policy->refresh_time_ms)))
+        {
+            break;
+        }
+        if ((NULL != p_policy) && (OPTIGA_LIB_SUCCESS != optiga_cmd_auto_hibernate_create(me)))
+        {
+            return_status = OPTIGA_CMD_ERROR;
+            break;
+        }
+        pal_os_lock_enter_critical_section();
+        if (NULL == p_policy)
+        {
+            pal_os_memset(&me->p_optiga->sec_policy, 0x00, sizeof(optiga_lib_sec_policy_t));
+        }
+        else
+        {
+            pal_os_memcpy(&me->p_optiga->sec_policy, p_policy, sizeof(optiga_lib_sec_policy_t));
+        }
+        // the SEC is read with the next scheduler run, the estimated SEC is valid from then on
+        me->p_optiga->sec_refresh_required = TRUE;
+        pal_os_lock_exit_critical_section();
+#ifdef OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+        // the parked scheduler reads the SEC
+        optiga_cmd_queue_scheduler_wakeup(me->p_optiga);
+#endif //OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+        return_status = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_status);
+}
+
+optiga_lib_status_t optiga_cmd_get_sec_stats(const optiga_cmd_t * me, optiga_lib_sec_stats_t * p_stats)
+{
+    pal_os_lock_enter_critical_section();
+    pal_os_memcpy(p_stats, &me->p_optiga->sec_stats, sizeof(optiga_lib_sec_stats_t));
+    pal_os_lock_exit_critical_section();
+    return (OPTIGA_LIB_SUCCESS);
+}
+#endif //OPTIGA_CMD_SEC_PACING_ENABLED
+#endif
+
+#ifdef OPTIGA_UTIL_READ_CACHE_ENABLED
+#ifdef OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+/*
+* Drops the cached data of another generation and loads the data of the current generation from the shared segment,
+* for the registered data object or for all the registered data objects.
+* The generation of the data objects, which are not cached, is recorded for the following read from OPTIGA.
+*/
+_STATIC_H void optiga_cmd_read_cache_shared_sync(optiga_context_t * p_optiga, uint16_t oid)
+{
+    optiga_cmd_read_cache_shared_t * p_shared;
+    const optiga_cmd_read_cache_shared_entry_t * p_shared_entry;
+    optiga_cmd_read_cache_entry_t * p_entry;
+    uint8_t instance = (uint8_t)(p_optiga - g_optiga_list);
+    bool_t is_registered = FALSE;
+    uint8_t index;
+    uint8_t shared_index;
+
+    // The segment is not acquired for the reads of the data objects, which are not registered
+    pal_os_lock_enter_critical_section();
+    for (index = 0; index < OPTIGA_UTIL_READ_CACHE_SIZE; index++)
+    {
+        if ((OPTIGA_CMD_READ_CACHE_FREE != p_optiga->read_cache[index].state) &&
+            ((OPTIGA_CMD_READ_CACHE_ALL_OIDS == oid) || (oid == p_optiga->read_cache[index].oid)))
+        {
+            is_registered = TRUE;
+        }
+    }
+    pal_os_lock_exit_critical_section();
+    if (FALSE == is_registered)
+    {
+        return;
+    }
+
+    p_shared = (optiga_cmd_read_cache_shared_t *)pal_os_memory_shared_acquire(sizeof(optiga_cmd_read_cache_shared_t));
+    if (NULL == p_shared)
+    {
+        return;
+    }
+    pal_os_lock_enter_critical_section();
+    for (index = 0; index < OPTIGA_UTIL_READ_CACHE_SIZE; index++)
+    {
+        p_entry = &p_optiga->read_cache[index];
+        if ((OPTIGA_CMD_READ_CACHE_FREE == p_entry->state) ||
+            ((OPTIGA_CMD_READ_CACHE_ALL_OIDS != oid) && (oid != p_entry->oid)))
+        {
+            continue;
+        }
+        if (p_shared->generation == p_entry->generation)
+        {
+            continue;
+        }
+        // Data object is written by a process meanwhile
+        p_entry->state = OPTIGA_CMD_READ_CACHE_REGISTERED;
+        p_entry->generation = p_shared->generation;
+        for (shared_index = 0; shared_index < OPTIGA_UTIL_READ_CACHE_SHARED_SIZE; shared_index++)
+        {
+            p_shared_entry = &p_shared->entries[shared_index];
+            if ((TRUE == p_shared_entry->used) && (p_shared->generation == p_shared_entry->generation) &&
+                (instance == p_shared_entry->instance) && (p_entry->oid == p_shared_entry->oid))
+            {
+                p_entry->length = MIN(p_shared_entry->length, OPTIGA_UTIL_READ_CACHE_MAX_OBJECT_SIZE);
+                p_entry->complete = p_shared_entry->complete;
+                pal_os_memcpy(p_entry->data, p_shared_entry->data, p_entry->length);
+                p_entry->state = OPTIGA_CMD_READ_CACHE_VALID;
+                break;
+            }
+        }
+    }
+    pal_os_lock_exit_critical_section();
+    pal_os_memory_shared_release();
+}
+
+/*
+* Stores the data of the entry into the shared segment for the other processes.
+* The data is dropped instead, if the data object is written by a process since the read was started.
+*/
+_STATIC_H void optiga_cmd_read_cache_shared_publish(optiga_context_t * p_optiga, optiga_cmd_read_cache_entry_t * p_entry)
+{
+    optiga_cmd_read_cache_shared_t * p_shared;
+    optiga_cmd_read_cache_shared_entry_t * p_shared_entry = NULL;
+    optiga_cmd_read_cache_shared_entry_t * p_unused_entry = NULL;
+    uint8_t instance = (uint8_t)(p_optiga - g_optiga_list);
+    uint8_t shared_index;
+
+    p_shared = (optiga_cmd_read_cache_shared_t *)pal_os_memory_shared_acquire(sizeof(optiga_cmd_read_cache_shared_t));
+    if (NULL == p_shared)
+    {
+        return;
+    }
+    pal_os_lock_enter_critical_section();
+    do
+    {
+        if (p_shared->generation != p_entry->generation)
+        {
+            p_entry->state = OPTIGA_CMD_READ_CACHE_REGISTERED;
+            break;
+        }
+        // The entry of the data object is updated, else an unused or outdated entry, else the entries in turn
+        for (shared_index = 0; shared_index < OPTIGA_UTIL_READ_CACHE_SHARED_SIZE; shared_index++)
+        {
+            if ((TRUE == p_shared->entries[shared_index].used) &&
+                (instance == p_shared->entries[shared_index].instance) &&
+                (p_entry->oid == p_shared->entries[shared_index].oid))
+            {
+                p_shared_entry = &p_shared->entries[shared_index];
+                break;
+            }
+            if ((NULL == p_unused_entry) && ((TRUE != p_shared->entries[shared_index].used) ||
+                (p_shared->generation != p_shared->entries[shared_index].generation)))
+            {
+                p_unused_entry = &p_shared->entries[shared_index];
+            }
+        }
+        if (NULL == p_shared_entry)
+        {
+            p_shared_entry = p_unused_entry;
+        }
+        if (NULL == p_shared_entry)
+        {
+            shared_index = p_shared->next_index % OPTIGA_UTIL_READ_CACHE_SHARED_SIZE;
+            p_shared->next_index = (shared_index + 1) % OPTIGA_UTIL_READ_CACHE_SHARED_SIZE;
+            p_shared_entry = &p_shared->entries[shared_index];
+        }
+        pal_os_memcpy(p_shared_entry->data, p_entry->data, p_entry->length);
+        p_shared_entry->length = p_entry->length;
+        p_shared_entry->complete = p_entry->complete;
+        p_shared_entry->generation = p_entry->generation;
+        p_shared_entry->instance = instance;
+        p_shared_entry->oid = p_entry->oid;
+        p_shared_entry->used = TRUE;
+    } while (FALSE);
+    pal_os_lock_exit_critical_section();
+    pal_os_memory_shared_release();
+}
+#endif //OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+
+optiga_lib_status_t optiga_cmd_read_cache_register(optiga_cmd_t * me, uint16_t oid, bool_t preload)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+    optiga_cmd_read_cache_entry_t * p_entry;
+    optiga_cmd_read_cache_entry_t * p_free_entry = NULL;
+    uint8_t index;
+
+    pal_os_lock_enter_critical_section();
+    do
+    {
+        if (OPTIGA_CMD_READ_CACHE_ALL_OIDS == oid)
+        {
+            break;
+        }
+        return_status = OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT;
+        for (index = 0; index < OPTIGA_UTIL_READ_CACHE_SIZE; index++)
+        {
+            p_entry = &me->p_optiga->read_cache[index];
+            if (OPTIGA_CMD_READ_CACHE_FREE == p_entry->state)
+            {
+                p_free_entry = (NULL == p_free_entry) ? p_entry : p_free_entry;
+            }
+            else if (oid == p_entry->oid)
+            {
+                // already registered, only the preload option is updated
+                p_entry->preload = preload;
+                return_status = OPTIGA_LIB_SUCCESS;
+                break;
+            }
+            else
+            {
+                // Entry is used by another data object
+            }
+        }
+        if ((OPTIGA_LIB_SUCCESS == return_status) || (NULL == p_free_entry))
+        {
+            break;
+        }
+        p_free_entry->oid = oid;
+        p_free_entry->length = 0;
+        p_free_entry->complete = FALSE;
+        p_free_entry->preload = preload;
+#ifdef OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+        // Differs from any generation of the segment, hence the data object is looked up on the next sync
+        p_free_entry->generation = 0xFFFFFFFFU;
+#endif //OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+        p_free_entry->state = OPTIGA_CMD_READ_CACHE_REGISTERED;
+        return_status = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    pal_os_lock_exit_critical_section();
+    return (return_status);
+}
+
+optiga_lib_status_t optiga_cmd_read_cache_unregister(optiga_cmd_t * me, uint16_t oid)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+    uint8_t index;
+
+    pal_os_lock_enter_critical_section();
+    for (index = 0; index < OPTIGA_UTIL_READ_CACHE_SIZE; index++)
+    {
+        if ((OPTIGA_CMD_READ_CACHE_FREE != me->p_optiga->read_cache[index].state) &&
+            ((OPTIGA_CMD_READ_CACHE_ALL_OIDS == oid) || (oid == me->p_optiga->read_cache[index].oid)))
+        {
+            me->p_optiga->read_cache[index].state = OPTIGA_CMD_READ_CACHE_FREE;
+            return_status = OPTIGA_LIB_SUCCESS;
+        }
+    }
+    pal_os_lock_exit_critical_section();
+    return (return_status);
+}
+
+optiga_lib_status_t optiga_cmd_read_cache_get(optiga_cmd_t * me,
+                                              uint16_t oid,
+                                              uint16_t offset,
+                                              uint8_t * p_buffer,
+                                              uint16_t * p_length)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR;
+    const optiga_cmd_read_cache_entry_t * p_entry;
+    uint16_t available_length;
+    uint8_t index;
+
+#ifdef OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+    // Data read by another process is served as well
+    optiga_cmd_read_cache_shared_sync(me->p_optiga, oid);
+#endif //OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+    pal_os_lock_enter_critical_section();
+    for (index = 0; index < OPTIGA_UTIL_READ_CACHE_SIZE; index++)
+    {
+        p_entry = &me->p_optiga->read_cache[index];
+        if ((OPTIGA_CMD_READ_CACHE_VALID != p_entry->state) || (oid != p_entry->oid))
+        {
+            continue;
+        }
+        // Reads beyond the end of data object are left to OPTIGA, which reports the error
+        if ((0 != *p_length) && (offset < p_entry->length))
+        {
+            available_length = p_entry->length - offset;
+            // Read beyond the cached part is served only, if the complete data object is cached
+            if ((*p_length <= available_length) || (TRUE == p_entry->complete))
+            {
+                *p_length = MIN(*p_length, available_length);
+                pal_os_memcpy(p_buffer, &p_entry->data[offset], *p_length);
+                return_status = OPTIGA_LIB_SUCCESS;
+            }
+        }
+        break;
+    }
+    pal_os_lock_exit_critical_section();
+    return (return_status);
+}
+
+uint8_t * optiga_cmd_read_cache_get_preload(optiga_cmd_t * me, uint8_t * p_index, uint16_t * p_oid)
+{
+    uint8_t * p_buffer = NULL;
+
+#ifdef OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+    // Data objects read by another process are not read from OPTIGA again
+    if (0 == *p_index)
+    {
+        optiga_cmd_read_cache_shared_sync(me->p_optiga, OPTIGA_CMD_READ_CACHE_ALL_OIDS);
+    }
+#endif //OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+    pal_os_lock_enter_critical_section();
+    while (*p_index < OPTIGA_UTIL_READ_CACHE_SIZE)
+    {
+        if ((OPTIGA_CMD_READ_CACHE_REGISTERED == me->p_optiga->read_cache[*p_index].state) &&
+            (TRUE == me->p_optiga->read_cache[*p_index].preload))
+        {
+            *p_oid = me->p_optiga->read_cache[*p_index].oid;
+            p_buffer = me->p_optiga->read_cache[*p_index].data;
+        }
+        (*p_index)++;
+        if (NULL != p_buffer)
+        {
+            break;
+        }
+    }
+    pal_os_lock_exit_critical_section();
+    return (p_buffer);
+}
+#endif
+
+#if defined (OPTIGA_UTIL_DIFFERENTIAL_WRITE_ENABLED) || defined (OPTIGA_UTIL_COUNT_COALESCING_ENABLED)
+optiga_lib_status_t optiga_cmd_complete_on_host(optiga_cmd_t * me, optiga_lib_status_t status)
+{
+    OPTIGA_CMD_LOG_MESSAGE(__FUNCTION__);
+#ifdef OPTIGA_CMD_CANCEL_ENABLED
+    // A cancellation of the previous request does not apply to this one
+    (void)optiga_cmd_atomic_exchange_byte(&me->cancel_requested, FALSE);
+#endif //OPTIGA_CMD_CANCEL_ENABLED
+    // No APDU is exchanged, the instance releases the lock and reports the status, once the scheduler grants it
+    me->p_input = NULL;
+    me->apdu_data = 0;
+    me->chaining_ongoing = FALSE;
+    me->exit_status = status;
+    me->cmd_next_execution_state = OPTIGA_CMD_EXEC_PROCESS_RESPONSE;
+    me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_RELEASE_LOCK;
+    return (optiga_cmd_request_lock(me, OPTIGA_CMD_QUEUE_REQUEST_LOCK));
+}
+#endif //OPTIGA_UTIL_DIFFERENTIAL_WRITE_ENABLED || OPTIGA_UTIL_COUNT_COALESCING_ENABLED
+
+#ifdef OPTIGA_UTIL_COUNT_COALESCING_ENABLED
+/*
+* Stores the pending increments to the datastore, two bytes per counter data object.
+* To be invoked within the critical section.
+*/
+_STATIC_H void optiga_cmd_pending_count_save(optiga_context_t * p_optiga)
+{
+    uint16_t datastore_id = g_pending_count_datastore_id_list[p_optiga - g_optiga_list];
+    uint8_t pending_count[OPTIGA_CMD_PENDING_COUNT_SIZE * 2];
+    uint8_t index;
+
+    if (OPTIGA_LIB_PAL_DATA_STORE_NOT_CONFIGURED != datastore_id)
+    {
+        for (index = 0; index < OPTIGA_CMD_PENDING_COUNT_SIZE; index++)
+        {
+            pending_count[index * 2] = (uint8_t)(p_optiga->pending_count[index] >> 8);
+            pending_count[(index * 2) + 1] = (uint8_t)(p_optiga->pending_count[index]);
+        }
+        // A failed write is retried with the next increment
+        if (PAL_STATUS_SUCCESS != pal_os_datastore_write(datastore_id, pending_count, sizeof(pending_count)))
+        {
+            return;
+        }
+    }
+    p_optiga->pending_count_unsaved = 0;
+}
+
+/*
+* Restores the pending increments stored to the datastore before the reset of the host, once per OPTIGA.
+* To be invoked within the critical section.
+*/
+_STATIC_H void optiga_cmd_pending_count_restore(optiga_context_t * p_optiga)
+{
+    uint16_t datastore_id = g_pending_count_datastore_id_list[p_optiga - g_optiga_list];
+    uint8_t pending_count[OPTIGA_CMD_PENDING_COUNT_SIZE * 2];
+    uint16_t length = sizeof(pending_count);
+    uint8_t index;
+
+    if (TRUE == p_optiga->pending_count_restored)
+    {
+        return;
+    }
+    p_optiga->pending_count_restored = TRUE;
+    if ((OPTIGA_LIB_PAL_DATA_STORE_NOT_CONFIGURED != datastore_id) &&
+        (PAL_STATUS_SUCCESS == pal_os_datastore_read(datastore_id, pending_count, &length)) &&
+        (sizeof(pending_count) == length))
+    {
+        for (index = 0; index < OPTIGA_CMD_PENDING_COUNT_SIZE; index++)
+        {
+            p_optiga->pending_count[index] = (uint16_t)(((uint16_t)pending_count[index * 2] << 8) |
+                                                        pending_count[(index * 2) + 1]);
+            p_optiga->pending_count_time[index] = pal_os_timer_get_time_in_milliseconds();
+        }
+    }
+}
+
+optiga_lib_status_t optiga_cmd_pending_count_add(const optiga_cmd_t * me,
+                                                 uint8_t index,
+                                                 uint8_t count,
+                                                 bool_t * p_flush_due)
+{
+    optiga_context_t * p_optiga = me->p_optiga;
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT;
+    uint32_t current_time = pal_os_timer_get_time_in_milliseconds();
+
+    *p_flush_due = FALSE;
+    pal_os_lock_enter_critical_section();
+    optiga_cmd_pending_count_restore(p_optiga);
+    // The pending increments are not lost, if the flushes keep failing
+    if (p_optiga->pending_count[index] <= (0xFFFFU - count))
+    {
+        if (0U == p_optiga->pending_count[index])
+        {
+            p_optiga->pending_count_time[index] = current_time;
+        }
+        p_optiga->pending_count[index] += count;
+        p_optiga->pending_count_unsaved++;
+        if (p_optiga->pending_count_unsaved >= OPTIGA_UTIL_COUNT_COALESCING_SAVE_INTERVAL)
+        {
+            optiga_cmd_pending_count_save(p_optiga);
+        }
+        if ((p_optiga->pending_count[index] >= OPTIGA_UTIL_COUNT_COALESCING_THRESHOLD) ||
+            ((current_time - p_optiga->pending_count_time[index]) >= OPTIGA_UTIL_COUNT_COALESCING_INTERVAL_MS))
+        {
+            *p_flush_due = TRUE;
+        }
+        return_status = OPTIGA_LIB_SUCCESS;
+    }
+    pal_os_lock_exit_critical_section();
+    return (return_status);
+}
+
+uint8_t optiga_cmd_pending_count_reserve(const optiga_cmd_t * me, uint8_t index)
+{
+    optiga_context_t * p_optiga = me->p_optiga;
+    uint8_t count;
+
+    pal_os_lock_enter_critical_section();
+    optiga_cmd_pending_count_restore(p_optiga);
+    count = (uint8_t)MIN((uint16_t)(p_optiga->pending_count[index] - p_optiga->pending_count_reserved[index]), 0xFFU);
+    p_optiga->pending_count_reserved[index] += count;
+    pal_os_lock_exit_critical_section();
+    return (count);
+}
+
+void optiga_cmd_pending_count_release(const optiga_cmd_t * me, uint8_t index, uint8_t count, bool_t is_written)
+{
+    optiga_context_t * p_optiga = me->p_optiga;
+
+    pal_os_lock_enter_critical_section();
+    p_optiga->pending_count_reserved[index] -= count;
+    if (TRUE == is_written)
+    {
+        p_optiga->pending_count[index] -= count;
+        // Stored right away, a reset of the host must not count the written increments again
+        optiga_cmd_pending_count_save(p_optiga);
+    }
+    pal_os_lock_exit_critical_section();
+}
+#endif //OPTIGA_UTIL_COUNT_COALESCING_ENABLED
+
+#ifdef OPTIGA_UTIL_METADATA_CACHE_ENABLED
+optiga_lib_status_t optiga_cmd_metadata_cache_get(const optiga_cmd_t * me,
+                                                  uint16_t oid,
+                                                  optiga_lib_metadata_info_t * p_info)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR;
+    uint8_t index;
+
+    pal_os_lock_enter_critical_section();
+    for (index = 0; index < OPTIGA_UTIL_METADATA_CACHE_SIZE; index++)
+    {
+        if ((TRUE == me->p_optiga->metadata_cache[index].valid) && (oid == me->p_optiga->metadata_cache[index].oid))
+        {
+            pal_os_memcpy(p_info, &me->p_optiga->metadata_cache[index].info, sizeof(optiga_lib_metadata_info_t));
+            return_status = OPTIGA_LIB_SUCCESS;
+            break;
+        }
+    }
+    pal_os_lock_exit_critical_section();
+    return (return_status);
 }
+#endif
 
-_STATIC_H void optiga_cmd_execute_process_optiga_response(optiga_cmd_t * me, uint8_t * exit_loop)
+#ifdef OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+/*
+* Compares the key of the entry with the given key
+*/
+_STATIC_H bool_t optiga_cmd_verify_cache_match(const optiga_cmd_verify_cache_entry_t * p_entry, const uint8_t * p_key)
 {
-    optiga_cmd_handler_t optiga_cmd_handler = me->cmd_hdlrs;
-    do
+    uint8_t difference = 0;
+    uint8_t index;
+
+    for (index = 0; index < OPTIGA_CMD_VERIFY_CACHE_KEY_LENGTH; index++)
     {
-        *exit_loop = TRUE;
-        if (OPTIGA_CMD_ZERO_LENGTH_OR_VALUE != (me->device_error_status & OPTIGA_CMD_ENTER_HANDLER_CALL_MASK))
-        {
-            me->exit_status = optiga_cmd_handler(me);
-        }
-        else
-        {
-            me->cmd_next_execution_state = OPTIGA_CMD_EXEC_ERROR_HANDLER;
-            *exit_loop = FALSE;
-            break;
-        }
-        if (OPTIGA_LIB_SUCCESS == me->exit_status)
-        {
-            // After successful Close Application, change state to invoke optiga_comms_close
-            if (OPTIGA_CMD_CLOSE_APPLICATION == OPTIGA_CMD_GET_APDU_CMD(me->apdu_data))
-            {
-                pal_os_event_register_callback_oneshot(me->p_optiga->p_pal_os_event_ctx,
-                                                       (register_callback)optiga_cmd_event_trigger_execute,
-                                                       me,
-                                                       OPTIGA_CMD_SCHEDULER_IDLING_TIME_MS);
-                *exit_loop = TRUE;
-                me->cmd_next_execution_state = OPTIGA_CMD_EXEC_COMMS_CLOSE;
-                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_COMMS_CLOSE_START;
-            }
-            else
-            {
-                if (FALSE == me->chaining_ongoing)
-                {
-                    if ((OPTIGA_CMD_STATE_EXIT != me->cmd_sub_execution_state) && (OPTIGA_CMD_EXEC_RELEASE_SESSION != me->cmd_sub_execution_state))
-                    {
-                        me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_RELEASE_LOCK;
-                    }
-                    *exit_loop = FALSE;
-                    break;
-                }
-                // for chaining, trigger preparing of next command
-                else
-                {
-                    pal_os_event_register_callback_oneshot(me->p_optiga->p_pal_os_event_ctx,
-                                                           (register_callback)optiga_cmd_event_trigger_execute,
-                                                           (void*)me,
-                                                           OPTIGA_CMD_SCHEDULER_IDLING_TIME_MS);
-                    *exit_loop = TRUE;
+        difference |= (uint8_t)(p_entry->key[index] ^ p_key[index]);
+    }
+    return ((0U == difference) ? TRUE : FALSE);
+}
 
-#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
-                    me->protection_level &= OPTIGA_PROTECTION_LEVEL_MASK;
-#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+optiga_lib_status_t optiga_cmd_verify_cache_lookup(const optiga_cmd_t * me,
+                                                   const uint8_t * p_key,
+                                                   uint32_t * p_generation)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR;
+    optiga_cmd_verify_cache_entry_t * p_entry;
+    uint32_t current_time = pal_os_timer_get_time_in_milliseconds();
+    uint8_t index;
 
-                    me->cmd_next_execution_state = OPTIGA_CMD_EXEC_PREPARE_COMMAND;
-                    me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_PREPARE_APDU;
-                }
-            }
-        }
-        else
+    pal_os_lock_enter_critical_section();
+    for (index = 0; index < OPTIGA_CRYPT_VERIFY_CACHE_SIZE; index++)
+    {
+        p_entry = &me->p_optiga->verify_cache[index];
+        if ((TRUE == p_entry->valid) && (TRUE == optiga_cmd_verify_cache_match(p_entry, p_key)))
         {
-            // After OPTIGA error is analyzed, invoke upper layer handler and release lock
-            if (OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT == me->exit_status)
-            {
-                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_RELEASE_LOCK;
-                *exit_loop = FALSE;
-                break;
-            }
-            else if (OPTIGA_CMD_EXEC_RELEASE_SESSION == me->cmd_sub_execution_state)
+            if ((uint32_t)(current_time - p_entry->insert_time) < p_entry->ttl)
             {
-                *exit_loop = FALSE;
+                return_status = OPTIGA_LIB_SUCCESS;
             }
-            // After OPTIGA responds with failure, invoke the next state to check which error occurred
             else
             {
-                me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_GET_DEVICE_ERROR;
-                SET_DEV_ERROR_HANDLER_STATE(OPTIGA_CMD_ERROR_CODE_PREPARE);
-                *exit_loop = FALSE;
+                p_entry->valid = FALSE;
             }
+            break;
         }
-    } while (FALSE);
+    }
+    if (OPTIGA_LIB_SUCCESS == return_status)
+    {
+        me->p_optiga->verify_cache_stats.hits++;
+    }
+    else
+    {
+        me->p_optiga->verify_cache_stats.misses++;
+    }
+    *p_generation = me->p_optiga->verify_cache_generation;
+    pal_os_lock_exit_critical_section();
+    return (return_status);
 }
 
-_STATIC_H void optiga_cmd_execute_process_response(optiga_cmd_t * me, uint8_t * exit_loop)
+void optiga_cmd_verify_cache_insert(const optiga_cmd_t * me,
+                                    uint16_t oid,
+                                    const uint8_t * p_key,
+                                    uint32_t generation,
+                                    uint32_t ttl_ms)
 {
-    do
+    optiga_cmd_verify_cache_entry_t * p_entry;
+    uint32_t current_time = pal_os_timer_get_time_in_milliseconds();
+    uint8_t index;
+    uint8_t selected_index = OPTIGA_CRYPT_VERIFY_CACHE_SIZE;
+
+    pal_os_lock_enter_critical_section();
+    // A write to OPTIGA while the verification was ongoing may have changed the public key or trust anchor
+    if ((generation == me->p_optiga->verify_cache_generation) && (0U != ttl_ms))
     {
-        switch (me->cmd_sub_execution_state)
+        for (index = 0; index < OPTIGA_CRYPT_VERIFY_CACHE_SIZE; index++)
         {
-            case OPTIGA_CMD_EXEC_PROCESS_OPTIGA_RESPONSE:
-            {
-                optiga_cmd_execute_process_optiga_response(me, exit_loop);
-                break;
-            }
-            case OPTIGA_CMD_EXEC_GET_DEVICE_ERROR:
-            {
-                optiga_cmd_execute_get_device_error(me, exit_loop);
-                break;
-            }
-            case OPTIGA_CMD_EXEC_RELEASE_SESSION:
+            p_entry = &me->p_optiga->verify_cache[index];
+            if ((TRUE == p_entry->valid) && (TRUE == optiga_cmd_verify_cache_match(p_entry, p_key)))
             {
-                //lint --e{534} suppress "The return code is not checked because this is exit state."
-                optiga_cmd_release_session(me);
-                if (OPTIGA_LIB_SUCCESS == me->exit_status)
-                {
-                    me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_RELEASE_LOCK;
-                }
-                else
-                {
-                    me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_GET_DEVICE_ERROR;
-                    SET_DEV_ERROR_HANDLER_STATE(OPTIGA_CMD_ERROR_CODE_PREPARE);
-                }
-                *exit_loop = FALSE;
+                selected_index = index;
                 break;
             }
-            case OPTIGA_CMD_EXEC_RELEASE_LOCK:
+            // An expired entry is free as well
+            if (((FALSE == p_entry->valid) || ((uint32_t)(current_time - p_entry->insert_time) >= p_entry->ttl)) &&
+                (OPTIGA_CRYPT_VERIFY_CACHE_SIZE == selected_index))
             {
-                //lint --e{534} suppress "The return code is not checked because this is exit state."
-                optiga_cmd_release_lock(me);
-                me->cmd_sub_execution_state = OPTIGA_CMD_STATE_EXIT;
-                *exit_loop = FALSE;
-                break;
+                selected_index = index;
             }
-            case OPTIGA_CMD_STATE_EXIT:
+        }
+        if (OPTIGA_CRYPT_VERIFY_CACHE_SIZE == selected_index)
+        {
+            selected_index = me->p_optiga->verify_cache_next;
+            me->p_optiga->verify_cache_next = (uint8_t)((selected_index + 1U) % OPTIGA_CRYPT_VERIFY_CACHE_SIZE);
+        }
+        p_entry = &me->p_optiga->verify_cache[selected_index];
+        pal_os_memcpy(p_entry->key, p_key, OPTIGA_CMD_VERIFY_CACHE_KEY_LENGTH);
+        p_entry->insert_time = current_time;
+        p_entry->ttl = ttl_ms;
+        p_entry->oid = oid;
+        p_entry->valid = TRUE;
+        me->p_optiga->verify_cache_stats.insertions++;
+    }
+    pal_os_lock_exit_critical_section();
+}
+
+void optiga_cmd_get_verify_cache_stats(const optiga_cmd_t * me, optiga_lib_verify_cache_stats_t * p_stats)
+{
+    pal_os_lock_enter_critical_section();
+    pal_os_memcpy(p_stats, &me->p_optiga->verify_cache_stats, sizeof(optiga_lib_verify_cache_stats_t));
+    pal_os_lock_exit_critical_section();
+}
+#endif //OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+
+#ifdef OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
+optiga_lib_status_t optiga_cmd_set_offload_policy(const optiga_cmd_t * me, const optiga_lib_offload_policy_t * p_policy)
+{
+    optiga_lib_status_t return_status = OPTIGA_LIB_SUCCESS;
+    uint8_t operation;
+
+    if (NULL != p_policy)
+    {
+        for (operation = 0; operation < OPTIGA_LIB_OFFLOAD_OPERATION_COUNT; operation++)
+        {
+            if ((uint8_t)OPTIGA_LIB_OFFLOAD_CHIP < p_policy->mode[operation])
             {
-                me->handler(me->caller_context, me->exit_status);
-                *exit_loop = TRUE;
+                return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
                 break;
             }
-            default:
-                EXIT_STATE_WITH_ERROR(me,*exit_loop);
-            break;
-            //lint --e{788} suppress "Not all states are used as same enum is used for both main and sub state machine."
         }
-    } while ((FALSE == *exit_loop) && (OPTIGA_CMD_EXEC_PROCESS_RESPONSE == me->cmd_next_execution_state));
+    }
+    if (OPTIGA_LIB_SUCCESS == return_status)
+    {
+        pal_os_lock_enter_critical_section();
+        if (NULL != p_policy)
+        {
+            pal_os_memcpy(&me->p_optiga->offload_policy, p_policy, sizeof(optiga_lib_offload_policy_t));
+        }
+        me->p_optiga->offload_policy_set = (NULL != p_policy) ? TRUE : FALSE;
+        pal_os_memset(me->p_optiga->offload_decisions_since_probe, 0x00, sizeof(me->p_optiga->offload_decisions_since_probe));
+        pal_os_lock_exit_critical_section();
+    }
+    return (return_status);
 }
 
-_STATIC_H void optiga_cmd_execute_error_handler(const optiga_cmd_t * me, uint8_t * exit_loop)
+bool_t optiga_cmd_offload_decide(const optiga_cmd_t * me,
+                                 uint8_t operation,
+                                 uint8_t security_class,
+                                 bool_t instance_setting)
 {
-    do
+    optiga_context_t * p_optiga = me->p_optiga;
+    optiga_lib_offload_stats_t * p_stats = &p_optiga->offload_stats[operation];
+    uint32_t chip_cost_us;
+    bool_t on_host;
+
+    pal_os_lock_enter_critical_section();
+    if ((uint8_t)OPTIGA_LIB_SECURITY_CLASS_CHIP_ONLY == security_class)
     {
-        //lint --e{534} suppress "The return code is not checked because this is exit state."
-        optiga_cmd_release_lock(me);
-        me->handler(me->caller_context, me->exit_status);
-        *exit_loop = TRUE;
-    } while (FALSE);
+        on_host = FALSE;
+        p_stats->forced_decisions++;
+    }
+    else if (FALSE == p_optiga->offload_policy_set)
+    {
+        on_host = instance_setting;
+        p_stats->forced_decisions++;
+    }
+    else if ((uint8_t)OPTIGA_LIB_OFFLOAD_AUTO != p_optiga->offload_policy.mode[operation])
+    {
+        on_host = ((uint8_t)OPTIGA_LIB_OFFLOAD_HOST == p_optiga->offload_policy.mode[operation]) ? TRUE : FALSE;
+        p_stats->forced_decisions++;
+    }
+    // A path not yet measured is taken first
+    else if (0U == p_stats->host_cost_us)
+    {
+        on_host = TRUE;
+    }
+    else if (0U == p_stats->chip_cost_us)
+    {
+        on_host = FALSE;
+    }
+    else
+    {
+        chip_cost_us = p_stats->chip_cost_us;
+#ifdef OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+        // The requests ahead in the execution queue delay the operation by OPTIGA
+        chip_cost_us += MIN(optiga_cmd_admission_estimate_wait(p_optiga), 0xFFFFFFFFU - chip_cost_us);
+#endif //OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+        on_host = (p_stats->host_cost_us <= chip_cost_us) ? TRUE : FALSE;
+        // The path not chosen is taken once in a while, since its cost may have changed in the meantime
+        p_optiga->offload_decisions_since_probe[operation]++;
+        if ((0U != p_optiga->offload_policy.probe_interval) &&
+            (p_optiga->offload_decisions_since_probe[operation] >= p_optiga->offload_policy.probe_interval))
+        {
+            p_optiga->offload_decisions_since_probe[operation] = 0;
+            on_host = (TRUE == on_host) ? FALSE : TRUE;
+            p_stats->probes++;
+        }
+    }
+    if (TRUE == on_host)
+    {
+        p_stats->host_decisions++;
+    }
+    else
+    {
+        p_stats->chip_decisions++;
+    }
+    pal_os_lock_exit_critical_section();
+    return (on_host);
 }
 
-_STATIC_H void optiga_cmd_execute_handler(void * p_ctx, optiga_lib_status_t event)
+void optiga_cmd_offload_record(const optiga_cmd_t * me,
+                               uint8_t operation,
+                               bool_t on_host,
+                               uint32_t elapsed_time_us)
 {
-    uint8_t exit_loop = TRUE;
-    optiga_cmd_t * me = (optiga_cmd_t *)p_ctx;
+    optiga_lib_offload_stats_t * p_stats = &me->p_optiga->offload_stats[operation];
+    uint32_t * p_cost_us = (TRUE == on_host) ? &p_stats->host_cost_us : &p_stats->chip_cost_us;
 
-    // in event of no success, release lock and exit
-    if (OPTIGA_LIB_SUCCESS != event)
+    // A cost of 0 indicates the path is not yet measured
+    if (0U == elapsed_time_us)
     {
-#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
-        optiga_cmd_clear_app_ctx(p_ctx);
-#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
-        me->cmd_next_execution_state = OPTIGA_CMD_EXEC_ERROR_HANDLER;
-        me->exit_status = event;
+        elapsed_time_us = 1;
+    }
+    pal_os_lock_enter_critical_section();
+    if (0U == *p_cost_us)
+    {
+        *p_cost_us = elapsed_time_us;
+    }
+    else if (elapsed_time_us > *p_cost_us)
+    {
+        *p_cost_us += ((elapsed_time_us - *p_cost_us) >> OPTIGA_CMD_OFFLOAD_COST_SHIFT);
     }
+    else
+    {
+        *p_cost_us -= ((*p_cost_us - elapsed_time_us) >> OPTIGA_CMD_OFFLOAD_COST_SHIFT);
+    }
+    pal_os_lock_exit_critical_section();
+}
 
-    do
+optiga_lib_status_t optiga_cmd_get_offload_stats(const optiga_cmd_t * me,
+                                                 uint8_t operation,
+                                                 optiga_lib_offload_stats_t * p_stats)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+
+    if (OPTIGA_LIB_OFFLOAD_OPERATION_COUNT > operation)
     {
-        switch (me->cmd_next_execution_state)
-        {
-            case OPTIGA_CMD_EXEC_COMMS_OPEN:
-            {
-                optiga_cmd_execute_comms_open(me, &exit_loop);
-                break;
-            }
-            case OPTIGA_CMD_EXEC_COMMS_CLOSE:
-            {
-                optiga_cmd_execute_comms_close(me, &exit_loop);
-                break;
-            }
-            case OPTIGA_CMD_EXEC_PREPARE_COMMAND:
-            {
-                optiga_cmd_execute_prepare_command(me, &exit_loop);
-                break;
-            }
-            case OPTIGA_CMD_EXEC_PROCESS_RESPONSE:
-            {
-                optiga_cmd_execute_process_response(me, &exit_loop);
-                break;
-            }
-            case OPTIGA_CMD_EXEC_ERROR_HANDLER:
-            {
-                optiga_cmd_execute_error_handler(me, &exit_loop);
-                break;
-            }
-            default :
-                break;
-            //lint --e{788} suppress "Not all states are used as same enum is used for both main and sub state machine."
-        }
-    } while (FALSE == exit_loop);
+        pal_os_lock_enter_critical_section();
+        pal_os_memcpy(p_stats, &me->p_optiga->offload_stats[operation], sizeof(optiga_lib_offload_stats_t));
+        pal_os_lock_exit_critical_section();
+        return_status = OPTIGA_LIB_SUCCESS;
+    }
+    return (return_status);
 }
+#endif //OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
 
-optiga_cmd_t * optiga_cmd_create(uint8_t optiga_instance_id, callback_handler_t handler, void * caller_context)
+#ifdef OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+void optiga_cmd_set_capabilities(optiga_cmd_t * me, uint32_t capabilities)
 {
-    optiga_cmd_t * me = NULL;
+    me->p_optiga->capabilities = capabilities | OPTIGA_LIB_CAPABILITY_PROBED;
+}
+
+uint32_t optiga_cmd_get_capabilities(const optiga_cmd_t * me)
+{
+    return (me->p_optiga->capabilities);
+}
+
+bool_t optiga_cmd_is_capable(const optiga_cmd_t * me, uint32_t capability)
+{
+    uint32_t capabilities = me->p_optiga->capabilities;
+
+    // Till OPTIGA is probed, all the features are attempted
+    return (((0 == (capabilities & OPTIGA_LIB_CAPABILITY_PROBED)) || (capability == (capabilities & capability))) ?
+            TRUE : FALSE);
+}
+#endif //OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+
+optiga_lib_status_t optiga_cmd_set_registry(uint8_t optiga_instance_id,
+                                            optiga_cmd_queue_slot_t * p_registry,
+                                            uint8_t registry_size)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+    optiga_context_t * p_optiga;
 
     pal_os_lock_enter_critical_section();
     do
     {
-        //lint --e{778} suppress "There is no chance of g_optiga_list become 0."
-        if ( optiga_instance_id > (uint8_t)((sizeof(g_optiga_list)/sizeof(optiga_context_t *)) - 1 ) )
-        {
-            break;
-        }
-        // Get number of free slots
-        if (0 == optiga_cmd_queue_get_count_of(g_optiga_list[optiga_instance_id],
-                                               OPTIGA_CMD_QUEUE_SLOT_STATE,
-                                               OPTIGA_CMD_QUEUE_NOT_ASSIGNED))
+        if ((OPTIGA_CMD_MAX_INSTANCE_ID < optiga_instance_id) ||
+            (NULL == p_registry) || (0 == registry_size) || (OPTIGA_CMD_QUEUE_MAX_REGISTRY_SIZE < registry_size))
         {
             break;
         }
+        p_optiga = &g_optiga_list[optiga_instance_id];
 
-        me = (optiga_cmd_t *)pal_os_calloc(1, sizeof(optiga_cmd_t));
-        if (NULL == me)
+        // registry can be changed only if no instance is registered
+        if ((TRUE == p_optiga->instance_init_state) &&
+            (p_optiga->queue_size != optiga_cmd_queue_get_count_of(p_optiga,
+                                                                   OPTIGA_CMD_QUEUE_SLOT_STATE,
+                                                                   OPTIGA_CMD_QUEUE_NOT_ASSIGNED)))
         {
+            return_status = OPTIGA_CMD_ERROR;
             break;
         }
+        p_optiga->optiga_cmd_execution_queue = p_registry;
+        p_optiga->queue_size = registry_size;
+        optiga_cmd_queue_init(p_optiga, optiga_instance_id);
+        return_status = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    pal_os_lock_exit_critical_section();
 
-        me->handler = handler;
-        me->caller_context = caller_context;
+    return (return_status);
+}
 
-        me->p_optiga = g_optiga_list[optiga_instance_id];
-        me->optiga_context_datastore_id = g_hibernate_datastore_id_list[optiga_instance_id];
+#if defined (OPTIGA_COMMS_SHIELDED_CONNECTION) && defined (OPTIGA_COMMS_PROTECTION_POLICY_ENABLED)
+optiga_lib_status_t optiga_cmd_set_protection_policy(uint8_t optiga_instance_id,
+                                                     const optiga_protection_policy_t * p_policy,
+                                                     uint8_t policy_count)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+    optiga_context_t * p_optiga;
+    uint8_t index;
 
-        if (FALSE == me->p_optiga->instance_init_state)
+    do
+    {
+        if ((OPTIGA_CMD_MAX_INSTANCE_ID < optiga_instance_id) || ((NULL == p_policy) && (0 != policy_count)))
         {
-            //create pal os event
-            me->p_optiga->p_pal_os_event_ctx = pal_os_event_create(optiga_cmd_queue_scheduler, me->p_optiga);
-            me->p_optiga->p_optiga_comms = optiga_comms_create(optiga_cmd_execute_handler, me);
-            if (NULL == me->p_optiga->p_optiga_comms)
+            break;
+        }
+        for (index = 0; index < policy_count; index++)
+        {
+            if (OPTIGA_PROTECTION_LEVEL_MASK < p_policy[index].protection_level)
             {
-                pal_os_free(me);
-                me = NULL;
                 break;
             }
-            me->p_optiga->instance_init_state = TRUE;
-            me->p_optiga->p_optiga_comms->p_pal_os_event_ctx = me->p_optiga->p_pal_os_event_ctx;
         }
-        // attach optiga cmd queue entry
-        optiga_cmd_queue_assign_slot(me, &(me->queue_id));
-    } while (FALSE);
-
-    pal_os_lock_exit_critical_section();
-    return (me);
-}
-
-optiga_lib_status_t optiga_cmd_destroy(optiga_cmd_t * me)
-{
-    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR;
-    do
-    {
-        if (NULL != me)
+        if (index < policy_count)
         {
-            return_status = optiga_cmd_release_session(me);
-            // attach optiga cmd queue entry
-            optiga_cmd_queue_deassign_slot(me);
-            pal_os_free(me);
-            //lint --e{838} suppress "Release session API returns success. Status is checked for future enhancements"
-            return_status = OPTIGA_LIB_SUCCESS;
+            break;
         }
+        p_optiga = &g_optiga_list[optiga_instance_id];
+
+        pal_os_lock_enter_critical_section();
+        p_optiga->p_protection_policy = p_policy;
+        p_optiga->protection_policy_count = policy_count;
+        pal_os_lock_exit_critical_section();
+        return_status = OPTIGA_LIB_SUCCESS;
     } while (FALSE);
+
     return (return_status);
 }
-
+#endif //(OPTIGA_COMMS_SHIELDED_CONNECTION) && (OPTIGA_COMMS_PROTECTION_POLICY_ENABLED)
 
 /*
 * Last error code handler
@@ -1740,7 +6472,7 @@ _STATIC_H optiga_lib_status_t optiga_cmd_get_error_code_handler(optiga_cmd_t * m
 
             me->p_optiga->comms_tx_size = (uint16_t)(index_for_data - OPTIGA_COMMS_DATA_OFFSET);
             SET_DEV_ERROR_HANDLER_STATE(OPTIGA_CMD_ERROR_CODE_TX);
-            pal_os_event_register_callback_oneshot(me->p_optiga->p_pal_os_event_ctx,
+            PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(me->p_optiga->p_pal_os_event_ctx,
                                                    (register_callback)optiga_cmd_event_trigger_execute,
                                                    me, OPTIGA_CMD_SCHEDULER_IDLING_TIME_MS);
         }
@@ -1778,9 +6510,11 @@ _STATIC_H optiga_lib_status_t optiga_cmd_get_error_code_handler(optiga_cmd_t * m
             return_status = return_status | OPTIGA_DEVICE_ERROR;
             me->cmd_next_execution_state = OPTIGA_CMD_EXEC_PROCESS_RESPONSE;
             me->cmd_sub_execution_state = OPTIGA_CMD_EXEC_PROCESS_OPTIGA_RESPONSE;
-            pal_os_event_register_callback_oneshot(me->p_optiga->p_pal_os_event_ctx,
+#ifndef OPTIGA_CMD_RUN_TO_IO_ENABLED
+            PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(me->p_optiga->p_pal_os_event_ctx,
                                                    (register_callback)optiga_cmd_event_trigger_execute,
                                                    me, OPTIGA_CMD_SCHEDULER_IDLING_TIME_MS);
+#endif //OPTIGA_CMD_RUN_TO_IO_ENABLED
         }
         break;
         default:
@@ -1857,7 +6591,7 @@ _STATIC_H optiga_lib_status_t optiga_cmd_open_application_handler(optiga_cmd_t *
             if (OPTIGA_LIB_PAL_DATA_STORE_NOT_CONFIGURED != me->optiga_context_datastore_id)
             {
                 //Clearing context handle secret from datastore
-                return_status = pal_os_datastore_write(me->optiga_context_datastore_id,
+                return_status = PAL_OS_DATASTORE_WRITE(me->optiga_context_datastore_id,
                                                        me->p_optiga->optiga_context_handle_buffer,
                                                        sizeof(me->p_optiga->optiga_context_handle_buffer));
                 if (PAL_STATUS_SUCCESS != return_status)
@@ -1884,6 +6618,9 @@ _STATIC_H optiga_lib_status_t optiga_cmd_open_application_handler(optiga_cmd_t *
 #ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
             me->p_optiga->p_optiga_comms->manage_context_operation = OPTIGA_COMMS_SESSION_CONTEXT_NONE;
 #endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+#ifdef OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+            me->p_optiga->app_state = OPTIGA_CMD_APP_STATE_OPEN;
+#endif //OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
             OPTIGA_CMD_LOG_MESSAGE("Response of open app command is processed...");
             return_status = OPTIGA_LIB_SUCCESS;
 
@@ -1896,104 +6633,385 @@ _STATIC_H optiga_lib_status_t optiga_cmd_open_application_handler(optiga_cmd_t *
     return (return_status);
 }
 
-
-optiga_lib_status_t optiga_cmd_open_application(optiga_cmd_t * me, uint8_t cmd_param, void * params)
+
+optiga_lib_status_t optiga_cmd_open_application(optiga_cmd_t * me, uint8_t cmd_param, void * params)
+{
+    OPTIGA_CMD_LOG_MESSAGE(__FUNCTION__);
+#ifdef OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+    // The context hibernated automatically is not restored, if the caller opens the application on its own
+    if ((me != me->p_optiga->p_auto_hibernate_cmd) && (OPTIGA_CMD_APP_STATE_HIBERNATED == me->p_optiga->app_state))
+    {
+        me->p_optiga->app_state = OPTIGA_CMD_APP_STATE_CLOSED;
+    }
+#ifdef OPTIGA_CMD_LAZY_OPEN_ENABLED
+    // The caller opens the application on its own, hence the pre-open is not required anymore
+    if (me != me->p_optiga->p_auto_hibernate_cmd)
+    {
+        me->p_optiga->lazy_pre_open = FALSE;
+    }
+#endif //OPTIGA_CMD_LAZY_OPEN_ENABLED
+#endif //OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+    optiga_cmd_execute(me,
+                       cmd_param,
+                       optiga_cmd_open_application_handler,
+                       OPTIGA_CMD_EXEC_COMMS_OPEN,
+                       OPTIGA_CMD_EXEC_COMMS_OPEN_ACQUIRE_LOCK,
+                       params,
+                       //lint --e{835} suppress "Upper 8 bits of apdu_data is kept as zero and is reserved for future enhancements"
+                       OPTIGA_CMD_SET_APDU_DATA(OPTIGA_CMD_OPEN_APPLICATION, OPTIGA_CMD_ZERO_LENGTH_OR_VALUE));
+
+    return (OPTIGA_LIB_SUCCESS);
+}
+
+/*
+* Close Application handler
+*/
+_STATIC_H optiga_lib_status_t optiga_cmd_close_application_handler(optiga_cmd_t * me)
+{
+    uint16_t total_apdu_length;
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR;
+
+    switch ((uint8_t)me->cmd_next_execution_state)
+    {
+        case OPTIGA_CMD_EXEC_PREPARE_COMMAND:
+        {
+
+            OPTIGA_CMD_LOG_MESSAGE("Sending close app command..");
+
+            total_apdu_length = OPTIGA_CMD_APDU_HEADER_SIZE;
+            //lint --e{774} suppress "If OPTIGA_MAX_COMMS_BUFFER_SIZE is set to lesser value it will fail"
+            if (OPTIGA_MAX_COMMS_BUFFER_SIZE < total_apdu_length)
+            {
+                return_status = OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT;
+                break;
+            }
+            optiga_cmd_prepare_apdu_header(OPTIGA_CMD_CLOSE_APPLICATION,
+                                           me->cmd_param,
+                                           OPTIGA_CMD_ZERO_LENGTH_OR_VALUE,
+                                           me->p_optiga->optiga_comms_buffer + OPTIGA_COMMS_DATA_OFFSET);
+
+            me->p_optiga->comms_tx_size = OPTIGA_CMD_APDU_HEADER_SIZE;
+            return_status = OPTIGA_LIB_SUCCESS;
+        }
+        break;
+        case OPTIGA_CMD_EXEC_PROCESS_RESPONSE:
+        {
+            OPTIGA_CMD_LOG_MESSAGE("Processing response for close app command...");
+            // check if the close app was successful
+            if (OPTIGA_CMD_APDU_SUCCESS != me->p_optiga->optiga_comms_buffer[OPTIGA_COMMS_DATA_OFFSET])
+            {
+                OPTIGA_CMD_LOG_MESSAGE("Error in processing close app response...");
+                //lint --e{835} suppress "SET_DEV_ERROR_NOTIFICATION is generically written for any unsigned interger value"
+                //lint --e{845} suppress "SET_DEV_ERROR_NOTIFICATION is generically written for any unsigned interger value"
+                SET_DEV_ERROR_NOTIFICATION(OPTIGA_CMD_EXIT_HANDLER_CALL);
+                break;
+            }
+            if (OPTIGA_CMD_PARAM_INITIALIZE_APP_CONTEXT != me->cmd_param)
+            {
+                pal_os_memcpy(me->p_optiga->optiga_context_handle_buffer,
+                              me->p_optiga->optiga_comms_buffer + OPTIGA_CMD_APDU_INDATA_OFFSET,
+                              sizeof(me->p_optiga->optiga_context_handle_buffer));
+                ///Optiga context store operation
+                if (OPTIGA_LIB_SUCCESS != optiga_cmd_store_context(me))
+                {
+                    pal_os_memset(me->p_optiga->optiga_context_handle_buffer,0,
+                                    sizeof(me->p_optiga->optiga_context_handle_buffer));
+                    break;
+                }
+            }
+#ifdef OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+            me->p_optiga->app_state = OPTIGA_CMD_APP_STATE_CLOSED;
+#endif //OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+            OPTIGA_CMD_LOG_MESSAGE("Response of close app command is processed...");
+            return_status = OPTIGA_LIB_SUCCESS;
+
+        }
+        break;
+        default:
+            break;
+    }
+
+    return (return_status);
+}
+
+optiga_lib_status_t optiga_cmd_close_application(optiga_cmd_t * me, uint8_t cmd_param, void * params)
+{
+    OPTIGA_CMD_LOG_MESSAGE(__FUNCTION__);
+    optiga_cmd_execute(me,
+                       cmd_param,
+                       optiga_cmd_close_application_handler,
+                       OPTIGA_CMD_EXEC_PREPARE_COMMAND,
+                       OPTIGA_CMD_EXEC_REQUEST_LOCK,
+                       params,
+                       //lint --e{835} suppress "Upper 8 bits of apdu_data is kept as zero and is reserved for future enhancements"
+                       OPTIGA_CMD_SET_APDU_DATA(OPTIGA_CMD_CLOSE_APPLICATION, OPTIGA_CMD_ZERO_LENGTH_OR_VALUE));
+
+    return (OPTIGA_LIB_SUCCESS);
+}
+
+#ifdef OPTIGA_UTIL_READ_CACHE_ENABLED
+/*
+* Drops the cached data of the data object or of all data objects, the data objects stay registered
+*/
+_STATIC_H void optiga_cmd_read_cache_invalidate(optiga_context_t * p_optiga, uint16_t oid)
+{
+    uint8_t index;
+#ifdef OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+    optiga_cmd_read_cache_shared_t * p_shared;
+
+    // Data cached by all the processes is dropped with the next generation
+    p_shared = (optiga_cmd_read_cache_shared_t *)pal_os_memory_shared_acquire(sizeof(optiga_cmd_read_cache_shared_t));
+    if (NULL != p_shared)
+    {
+        p_shared->generation++;
+        pal_os_memory_shared_release();
+    }
+#endif //OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+
+    pal_os_lock_enter_critical_section();
+    for (index = 0; index < OPTIGA_UTIL_READ_CACHE_SIZE; index++)
+    {
+        if ((OPTIGA_CMD_READ_CACHE_VALID == p_optiga->read_cache[index].state) &&
+            ((OPTIGA_CMD_READ_CACHE_ALL_OIDS == oid) || (oid == p_optiga->read_cache[index].oid)))
+        {
+            p_optiga->read_cache[index].state = OPTIGA_CMD_READ_CACHE_REGISTERED;
+        }
+    }
+    pal_os_lock_exit_critical_section();
+}
+
+/*
+* Caches the data read from offset 0 of a registered data object.
+* The data object is read completely, if less data than requested is returned by OPTIGA.
+*/
+_STATIC_H void optiga_cmd_read_cache_fill(optiga_context_t * p_optiga,
+                                          const optiga_get_data_object_params_t * p_params,
+                                          uint16_t length,
+                                          bool_t complete)
+{
+    optiga_cmd_read_cache_entry_t * p_entry;
+#ifdef OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+    optiga_cmd_read_cache_entry_t * p_filled_entry = NULL;
+#endif //OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+    uint8_t index;
+
+    if ((OPTIGA_CMD_READ_DATA == p_params->data_or_metadata) && (0 == p_params->offset) &&
+        (NULL != p_params->buffer))
+    {
+        pal_os_lock_enter_critical_section();
+        for (index = 0; index < OPTIGA_UTIL_READ_CACHE_SIZE; index++)
+        {
+            p_entry = &p_optiga->read_cache[index];
+            if ((OPTIGA_CMD_READ_CACHE_FREE != p_entry->state) && (p_params->oid == p_entry->oid))
+            {
+                p_entry->length = MIN(length, OPTIGA_UTIL_READ_CACHE_MAX_OBJECT_SIZE);
+                p_entry->complete = ((TRUE == complete) && (p_entry->length == length)) ? TRUE : FALSE;
+                // preload reads into the entry itself
+                if (p_entry->data != p_params->buffer)
+                {
+                    pal_os_memcpy(p_entry->data, p_params->buffer, p_entry->length);
+                }
+                p_entry->state = OPTIGA_CMD_READ_CACHE_VALID;
+#ifdef OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+                p_filled_entry = p_entry;
+#endif //OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+                break;
+            }
+        }
+        pal_os_lock_exit_critical_section();
+#ifdef OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+        if (NULL != p_filled_entry)
+        {
+            optiga_cmd_read_cache_shared_publish(p_optiga, p_filled_entry);
+        }
+#endif //OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+    }
+}
+#endif //OPTIGA_UTIL_READ_CACHE_ENABLED
+
+#ifdef OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+/*
+* Drops the verifications with the public key of the object or all verifications, ongoing verifications are not cached
+*/
+_STATIC_H void optiga_cmd_verify_cache_invalidate(optiga_context_t * p_optiga, uint16_t oid)
+{
+    uint8_t index;
+
+    pal_os_lock_enter_critical_section();
+    p_optiga->verify_cache_generation++;
+    for (index = 0; index < OPTIGA_CRYPT_VERIFY_CACHE_SIZE; index++)
+    {
+        if ((TRUE == p_optiga->verify_cache[index].valid) &&
+            ((OPTIGA_CMD_VERIFY_CACHE_ALL_OIDS == oid) || (oid == p_optiga->verify_cache[index].oid)))
+        {
+            p_optiga->verify_cache[index].valid = FALSE;
+            p_optiga->verify_cache_stats.invalidations++;
+        }
+    }
+    pal_os_lock_exit_critical_section();
+}
+#endif //OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+
+#ifdef OPTIGA_UTIL_METADATA_CACHE_ENABLED
+/*
+* Parses the metadata TLV (0x20, length, tags) into the metadata view. Tags, which are not part of the view, are skipped.
+*/
+_STATIC_H optiga_lib_status_t optiga_cmd_metadata_parse(const uint8_t * p_metadata,
+                                                        uint16_t length,
+                                                        optiga_lib_metadata_info_t * p_info)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR;
+    uint16_t index = OPTIGA_CMD_NO_OF_BYTES_IN_TAG + 1;
+    uint16_t end_of_metadata;
+    uint8_t tag;
+    uint8_t tag_length;
+
+    do
+    {
+        if ((index > length) || (OPTIGA_CMD_METADATA_TAG != p_metadata[0]) || (p_metadata[1] > (length - index)))
+        {
+            break;
+        }
+        end_of_metadata = index + p_metadata[1];
+        pal_os_memset(p_info, 0x00, sizeof(optiga_lib_metadata_info_t));
+
+        return_status = OPTIGA_LIB_SUCCESS;
+        while (index < end_of_metadata)
+        {
+            if (((index + 2U) > end_of_metadata) || ((index + 2U + p_metadata[index + 1]) > end_of_metadata))
+            {
+                return_status = OPTIGA_CMD_ERROR;
+                break;
+            }
+            tag = p_metadata[index];
+            tag_length = p_metadata[index + 1];
+            index += 2U;
+            // The sizes are encoded in 2 bytes, LcsO and data object type in 1 byte
+            if ((((OPTIGA_CMD_METADATA_TAG_MAX_SIZE == tag) || (OPTIGA_CMD_METADATA_TAG_USED_SIZE == tag)) &&
+                 (OPTIGA_CMD_UINT16_SIZE_IN_BYTES != tag_length)) ||
+                (((OPTIGA_CMD_METADATA_TAG_LCSO == tag) || (OPTIGA_CMD_METADATA_TAG_DATA_TYPE == tag)) &&
+                 (OPTIGA_CMD_NO_OF_BYTES_IN_TAG != tag_length)) ||
+                (((OPTIGA_CMD_METADATA_TAG_CHANGE_AC == tag) || (OPTIGA_CMD_METADATA_TAG_READ_AC == tag) ||
+                  (OPTIGA_CMD_METADATA_TAG_EXECUTE_AC == tag)) && (OPTIGA_LIB_METADATA_MAX_AC_LENGTH < tag_length)))
+            {
+                return_status = OPTIGA_CMD_ERROR;
+                break;
+            }
+            switch (tag)
+            {
+                case OPTIGA_CMD_METADATA_TAG_LCSO:
+                {
+                    p_info->lcso = p_metadata[index];
+                    p_info->present |= OPTIGA_LIB_METADATA_HAS_LCSO;
+                    break;
+                }
+                case OPTIGA_CMD_METADATA_TAG_MAX_SIZE:
+                {
+                    optiga_common_get_uint16(&p_metadata[index], &p_info->max_size);
+                    p_info->present |= OPTIGA_LIB_METADATA_HAS_MAX_SIZE;
+                    break;
+                }
+                case OPTIGA_CMD_METADATA_TAG_USED_SIZE:
+                {
+                    optiga_common_get_uint16(&p_metadata[index], &p_info->used_size);
+                    p_info->present |= OPTIGA_LIB_METADATA_HAS_USED_SIZE;
+                    break;
+                }
+                case OPTIGA_CMD_METADATA_TAG_CHANGE_AC:
+                {
+                    pal_os_memcpy(p_info->change_ac, &p_metadata[index], tag_length);
+                    p_info->change_ac_length = tag_length;
+                    p_info->present |= OPTIGA_LIB_METADATA_HAS_CHANGE_AC;
+                    break;
+                }
+                case OPTIGA_CMD_METADATA_TAG_READ_AC:
+                {
+                    pal_os_memcpy(p_info->read_ac, &p_metadata[index], tag_length);
+                    p_info->read_ac_length = tag_length;
+                    p_info->present |= OPTIGA_LIB_METADATA_HAS_READ_AC;
+                    break;
+                }
+                case OPTIGA_CMD_METADATA_TAG_EXECUTE_AC:
+                {
+                    pal_os_memcpy(p_info->execute_ac, &p_metadata[index], tag_length);
+                    p_info->execute_ac_length = tag_length;
+                    p_info->present |= OPTIGA_LIB_METADATA_HAS_EXECUTE_AC;
+                    break;
+                }
+                case OPTIGA_CMD_METADATA_TAG_DATA_TYPE:
+                {
+                    p_info->data_object_type = p_metadata[index];
+                    p_info->present |= OPTIGA_LIB_METADATA_HAS_DATA_OBJECT_TYPE;
+                    break;
+                }
+                default:
+                    // Tag is not part of the view
+                    break;
+            }
+            index += tag_length;
+        }
+    } while (FALSE);
+
+    return (return_status);
+}
+
+/*
+* Drops the parsed metadata of the object or of all objects
+*/
+_STATIC_H void optiga_cmd_metadata_cache_invalidate(optiga_context_t * p_optiga, uint16_t oid)
 {
-    OPTIGA_CMD_LOG_MESSAGE(__FUNCTION__);
-    optiga_cmd_execute(me,
-                       cmd_param,
-                       optiga_cmd_open_application_handler,
-                       OPTIGA_CMD_EXEC_COMMS_OPEN,
-                       OPTIGA_CMD_EXEC_COMMS_OPEN_ACQUIRE_LOCK,
-                       params,
-                       //lint --e{835} suppress "Upper 8 bits of apdu_data is kept as zero and is reserved for future enhancements"
-                       OPTIGA_CMD_SET_APDU_DATA(OPTIGA_CMD_OPEN_APPLICATION, OPTIGA_CMD_ZERO_LENGTH_OR_VALUE));
+    uint8_t index;
 
-    return (OPTIGA_LIB_SUCCESS);
+    pal_os_lock_enter_critical_section();
+    for (index = 0; index < OPTIGA_UTIL_METADATA_CACHE_SIZE; index++)
+    {
+        if ((OPTIGA_CMD_METADATA_CACHE_ALL_OIDS == oid) || (oid == p_optiga->metadata_cache[index].oid))
+        {
+            p_optiga->metadata_cache[index].valid = FALSE;
+        }
+    }
+    pal_os_lock_exit_critical_section();
 }
 
 /*
-* Close Application handler
+* Parses the metadata read and caches it in the entry of the object, a free entry or the next entry to be replaced
 */
-_STATIC_H optiga_lib_status_t optiga_cmd_close_application_handler(optiga_cmd_t * me)
+_STATIC_H void optiga_cmd_metadata_cache_fill(optiga_context_t * p_optiga,
+                                              const optiga_get_data_object_params_t * p_params,
+                                              uint16_t length)
 {
-    uint16_t total_apdu_length;
-    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR;
+    optiga_lib_metadata_info_t info;
+    uint8_t index;
+    uint8_t selected_index = OPTIGA_UTIL_METADATA_CACHE_SIZE;
 
-    switch ((uint8_t)me->cmd_next_execution_state)
+    if ((OPTIGA_CMD_READ_METADATA == p_params->data_or_metadata) && (NULL != p_params->buffer) &&
+        (OPTIGA_LIB_SUCCESS == optiga_cmd_metadata_parse(p_params->buffer, length, &info)))
     {
-        case OPTIGA_CMD_EXEC_PREPARE_COMMAND:
+        pal_os_lock_enter_critical_section();
+        for (index = 0; index < OPTIGA_UTIL_METADATA_CACHE_SIZE; index++)
         {
-
-            OPTIGA_CMD_LOG_MESSAGE("Sending close app command..");
-
-            total_apdu_length = OPTIGA_CMD_APDU_HEADER_SIZE;
-            //lint --e{774} suppress "If OPTIGA_MAX_COMMS_BUFFER_SIZE is set to lesser value it will fail"
-            if (OPTIGA_MAX_COMMS_BUFFER_SIZE < total_apdu_length)
-            {
-                return_status = OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT;
-                break;
-            }
-            optiga_cmd_prepare_apdu_header(OPTIGA_CMD_CLOSE_APPLICATION,
-                                           me->cmd_param,
-                                           OPTIGA_CMD_ZERO_LENGTH_OR_VALUE,
-                                           me->p_optiga->optiga_comms_buffer + OPTIGA_COMMS_DATA_OFFSET);
-
-            me->p_optiga->comms_tx_size = OPTIGA_CMD_APDU_HEADER_SIZE;
-            return_status = OPTIGA_LIB_SUCCESS;
-        }
-        break;
-        case OPTIGA_CMD_EXEC_PROCESS_RESPONSE:
-        {
-            OPTIGA_CMD_LOG_MESSAGE("Processing response for close app command...");
-            // check if the close app was successful
-            if (OPTIGA_CMD_APDU_SUCCESS != me->p_optiga->optiga_comms_buffer[OPTIGA_COMMS_DATA_OFFSET])
+            if ((TRUE == p_optiga->metadata_cache[index].valid) && (p_params->oid == p_optiga->metadata_cache[index].oid))
             {
-                OPTIGA_CMD_LOG_MESSAGE("Error in processing close app response...");
-                //lint --e{835} suppress "SET_DEV_ERROR_NOTIFICATION is generically written for any unsigned interger value"
-                //lint --e{845} suppress "SET_DEV_ERROR_NOTIFICATION is generically written for any unsigned interger value"
-                SET_DEV_ERROR_NOTIFICATION(OPTIGA_CMD_EXIT_HANDLER_CALL);
+                selected_index = index;
                 break;
             }
-            if (OPTIGA_CMD_PARAM_INITIALIZE_APP_CONTEXT != me->cmd_param)
+            if ((FALSE == p_optiga->metadata_cache[index].valid) && (OPTIGA_UTIL_METADATA_CACHE_SIZE == selected_index))
             {
-                pal_os_memcpy(me->p_optiga->optiga_context_handle_buffer,
-                              me->p_optiga->optiga_comms_buffer + OPTIGA_CMD_APDU_INDATA_OFFSET,
-                              sizeof(me->p_optiga->optiga_context_handle_buffer));
-                ///Optiga context store operation
-                if (OPTIGA_LIB_SUCCESS != optiga_cmd_store_context(me))
-                {
-                    pal_os_memset(me->p_optiga->optiga_context_handle_buffer,0,
-                                    sizeof(me->p_optiga->optiga_context_handle_buffer));
-                    break;
-                }
+                selected_index = index;
             }
-            OPTIGA_CMD_LOG_MESSAGE("Response of close app command is processed...");
-            return_status = OPTIGA_LIB_SUCCESS;
-
         }
-        break;
-        default:
-            break;
+        if (OPTIGA_UTIL_METADATA_CACHE_SIZE == selected_index)
+        {
+            selected_index = p_optiga->metadata_cache_next;
+            p_optiga->metadata_cache_next = (uint8_t)((selected_index + 1U) % OPTIGA_UTIL_METADATA_CACHE_SIZE);
+        }
+        pal_os_memcpy(&p_optiga->metadata_cache[selected_index].info, &info, sizeof(optiga_lib_metadata_info_t));
+        p_optiga->metadata_cache[selected_index].oid = p_params->oid;
+        p_optiga->metadata_cache[selected_index].valid = TRUE;
+        pal_os_lock_exit_critical_section();
     }
-
-    return (return_status);
-}
-
-optiga_lib_status_t optiga_cmd_close_application(optiga_cmd_t * me, uint8_t cmd_param, void * params)
-{
-    OPTIGA_CMD_LOG_MESSAGE(__FUNCTION__);
-    optiga_cmd_execute(me,
-                       cmd_param,
-                       optiga_cmd_close_application_handler,
-                       OPTIGA_CMD_EXEC_PREPARE_COMMAND,
-                       OPTIGA_CMD_EXEC_REQUEST_LOCK,
-                       params,
-                       //lint --e{835} suppress "Upper 8 bits of apdu_data is kept as zero and is reserved for future enhancements"
-                       OPTIGA_CMD_SET_APDU_DATA(OPTIGA_CMD_CLOSE_APPLICATION, OPTIGA_CMD_ZERO_LENGTH_OR_VALUE));
-
-    return (OPTIGA_LIB_SUCCESS);
 }
+#endif //OPTIGA_UTIL_METADATA_CACHE_ENABLED
 
 /*
 * Get Data Object handler
@@ -2083,6 +7101,13 @@ _STATIC_H optiga_lib_status_t optiga_cmd_get_data_object_handler(optiga_cmd_t *
             else if (me->exit_status == (optiga_lib_status_t)(OPTIGA_CMD_OUT_OF_BOUNDARY_ERROR | OPTIGA_DEVICE_ERROR))
             {
                 *(p_optiga_read_data->ref_bytes_to_read) = p_optiga_read_data->accumulated_size;
+#ifdef OPTIGA_UTIL_READ_CACHE_ENABLED
+                // end of the data object is reached
+                optiga_cmd_read_cache_fill(me->p_optiga, p_optiga_read_data, p_optiga_read_data->accumulated_size, TRUE);
+#endif //OPTIGA_UTIL_READ_CACHE_ENABLED
+#ifdef OPTIGA_UTIL_METADATA_CACHE_ENABLED
+                optiga_cmd_metadata_cache_fill(me->p_optiga, p_optiga_read_data, p_optiga_read_data->accumulated_size);
+#endif //OPTIGA_UTIL_METADATA_CACHE_ENABLED
                 return_status = OPTIGA_LIB_SUCCESS;
             }
             else
@@ -2099,10 +7124,30 @@ _STATIC_H optiga_lib_status_t optiga_cmd_get_data_object_handler(optiga_cmd_t *
                     break;
                 }
 
-                //copy data from optiga comms buffer to user provided buffer
-                pal_os_memcpy(p_optiga_read_data->buffer + p_optiga_read_data->accumulated_size,
-                              me->p_optiga->optiga_comms_buffer + OPTIGA_CMD_APDU_INDATA_OFFSET,
-                              data_read);
+                if (NULL != p_optiga_read_data->stream_callback)
+                {
+                    // deliver the chunk as it is received, instead of collecting it
+                    if (0 != data_read)
+                    {
+                        p_optiga_read_data->stream_callback(p_optiga_read_data->stream_context,
+                                                            me->p_optiga->optiga_comms_buffer + OPTIGA_CMD_APDU_INDATA_OFFSET,
+                                                            data_read,
+                                                            p_optiga_read_data->accumulated_size);
+                    }
+                }
+#ifdef OPTIGA_COMMS_ZERO_COPY_RX
+                else if (data_read == me->p_optiga->p_optiga_comms->rx_destination_length)
+                {
+                    // data is stored to the user provided buffer by the communication stack already
+                }
+#endif //OPTIGA_COMMS_ZERO_COPY_RX
+                else
+                {
+                    //copy data from optiga comms buffer to user provided buffer
+                    pal_os_memcpy(p_optiga_read_data->buffer + p_optiga_read_data->accumulated_size,
+                                  me->p_optiga->optiga_comms_buffer + OPTIGA_CMD_APDU_INDATA_OFFSET,
+                                  data_read);
+                }
 
                 p_optiga_read_data->accumulated_size += data_read;
 
@@ -2110,6 +7155,13 @@ _STATIC_H optiga_lib_status_t optiga_cmd_get_data_object_handler(optiga_cmd_t *
                     (p_optiga_read_data->accumulated_size == p_optiga_read_data->bytes_to_read))
                 {
                     *(p_optiga_read_data->ref_bytes_to_read) = p_optiga_read_data->accumulated_size;
+#ifdef OPTIGA_UTIL_READ_CACHE_ENABLED
+                    optiga_cmd_read_cache_fill(me->p_optiga, p_optiga_read_data, p_optiga_read_data->accumulated_size,
+                                               (p_optiga_read_data->last_read_size > data_read) ? TRUE : FALSE);
+#endif //OPTIGA_UTIL_READ_CACHE_ENABLED
+#ifdef OPTIGA_UTIL_METADATA_CACHE_ENABLED
+                    optiga_cmd_metadata_cache_fill(me->p_optiga, p_optiga_read_data, p_optiga_read_data->accumulated_size);
+#endif //OPTIGA_UTIL_METADATA_CACHE_ENABLED
                     p_optiga_read_data->accumulated_size = 0;
                     p_optiga_read_data->last_read_size = 0;
                 }
@@ -2163,6 +7215,18 @@ _STATIC_H optiga_lib_status_t optiga_cmd_set_data_object_handler(optiga_cmd_t *
 
             OPTIGA_CMD_LOG_MESSAGE("Sending set data command...");
             me->chaining_ongoing = FALSE;
+#ifdef OPTIGA_UTIL_READ_CACHE_ENABLED
+            // data or metadata (e.g. access conditions) changes with this command
+            optiga_cmd_read_cache_invalidate(me->p_optiga, p_optiga_write_data->oid);
+#endif //OPTIGA_UTIL_READ_CACHE_ENABLED
+#ifdef OPTIGA_UTIL_METADATA_CACHE_ENABLED
+            // used size changes with a data write
+            optiga_cmd_metadata_cache_invalidate(me->p_optiga, p_optiga_write_data->oid);
+#endif //OPTIGA_UTIL_METADATA_CACHE_ENABLED
+#ifdef OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+            // public key of the certificate (e.g. trust anchor) or its usage may change with this command
+            optiga_cmd_verify_cache_invalidate(me->p_optiga, p_optiga_write_data->oid);
+#endif //OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
             //oid
             optiga_common_set_uint16(&me->p_optiga->optiga_comms_buffer[index_for_data],
                                      p_optiga_write_data->oid);
@@ -2174,7 +7238,7 @@ _STATIC_H optiga_lib_status_t optiga_cmd_set_data_object_handler(optiga_cmd_t *
             index_for_data += OPTIGA_CMD_UINT16_SIZE_IN_BYTES;
 
             // Check maximum size that can be written, based on optiga comms buffer size
-            size_to_send = MIN((OPTIGA_MAX_COMMS_BUFFER_SIZE + OPTIGA_COMMS_DATA_OFFSET - index_for_data),
+            size_to_send = MIN(OPTIGA_CMD_SET_DATA_MAX_CHUNK_SIZE,
                                ((p_optiga_write_data->size) - p_optiga_write_data->written_size));
 
             // APDU header size + oid 2 bytes + offset 2 bytes + size of data to send
@@ -2219,6 +7283,10 @@ _STATIC_H optiga_lib_status_t optiga_cmd_set_data_object_handler(optiga_cmd_t *
         case OPTIGA_CMD_EXEC_PROCESS_RESPONSE:
         {
             OPTIGA_CMD_LOG_MESSAGE("Processing response for set data command...");
+#ifdef OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+            // Data read by the other processes during the write is dropped as well
+            optiga_cmd_read_cache_invalidate(me->p_optiga, p_optiga_write_data->oid);
+#endif //OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
             // check if the write was successful
             if (OPTIGA_CMD_APDU_SUCCESS != me->p_optiga->optiga_comms_buffer[OPTIGA_COMMS_DATA_OFFSET])
             {
@@ -2228,6 +7296,15 @@ _STATIC_H optiga_lib_status_t optiga_cmd_set_data_object_handler(optiga_cmd_t *
                 SET_DEV_ERROR_NOTIFICATION(OPTIGA_CMD_EXIT_HANDLER_CALL);
                 break;
             }
+            // The next chunk may be prepared already, hence the acknowledged chunk is derived from the chunk size
+            p_optiga_write_data->acknowledged_size += MIN(OPTIGA_CMD_SET_DATA_MAX_CHUNK_SIZE,
+                                                          (p_optiga_write_data->size - p_optiga_write_data->acknowledged_size));
+            if (NULL != p_optiga_write_data->progress_callback)
+            {
+                p_optiga_write_data->progress_callback(p_optiga_write_data->progress_context,
+                                                       p_optiga_write_data->acknowledged_size,
+                                                       p_optiga_write_data->size);
+            }
             OPTIGA_CMD_LOG_MESSAGE("Response of set data command is processed...");
             return_status = OPTIGA_LIB_SUCCESS;
         }
@@ -2372,102 +7449,80 @@ optiga_lib_status_t optiga_cmd_get_random(optiga_cmd_t * me, uint8_t cmd_param,
 #endif //OPTIGA_CRYPT_RANDOM_ENABLED
 
 #if defined (OPTIGA_CRYPT_ECDSA_SIGN_ENABLED) || defined (OPTIGA_CRYPT_RSA_SIGN_ENABLED)
+_STATIC_H const optiga_cmd_field_descriptor_t optiga_cmd_calc_sign_fields[] =
+{
+    {OPTIGA_CMD_SIGN_DIGEST_TAG, OPTIGA_CMD_FIELD_BUFFER},
+    {OPTIGA_CMD_SIGN_OID_TAG, OPTIGA_CMD_FIELD_UINT16}
+};
+
+_STATIC_H const optiga_cmd_descriptor_t optiga_cmd_calc_sign_descriptor =
+{
+    OPTIGA_CMD_CALC_SIGN,
+    (uint8_t)(sizeof(optiga_cmd_calc_sign_fields) / sizeof(optiga_cmd_calc_sign_fields[0])),
+    optiga_cmd_calc_sign_fields
+};
+
 /*
 * CalcSign handler
 */
 _STATIC_H optiga_lib_status_t optiga_cmd_calc_sign_handler(optiga_cmd_t * me)
 {
-    uint16_t total_apdu_length;
     optiga_calc_sign_params_t * p_optiga_calc_sign = (optiga_calc_sign_params_t *)me->p_input;
     optiga_lib_status_t return_status = OPTIGA_CMD_ERROR;
-    uint16_t private_key_oid;
-    uint16_t index_for_data = OPTIGA_CMD_APDU_INDATA_OFFSET;
+    optiga_cmd_field_value_t field_values[2] = {{NULL, 0}, {NULL, 0}};
 
     switch ((uint8_t)me->cmd_next_execution_state)
     {
         case OPTIGA_CMD_EXEC_PREPARE_COMMAND:
         {
-            // APDU headed length + TLV of Digest + TLV of signature key OID
+            // TLV of Digest + TLV of signature key OID
             OPTIGA_CMD_LOG_MESSAGE("Sending calculate sign command..");
-            total_apdu_length = OPTIGA_CMD_APDU_HEADER_SIZE + OPTIGA_CMD_TAG_LENGTH_SIZE + p_optiga_calc_sign->digest_length +
-                                    OPTIGA_CMD_TAG_LENGTH_SIZE + OPTIGA_CMD_UINT16_SIZE_IN_BYTES;
-            if (OPTIGA_MAX_COMMS_BUFFER_SIZE < total_apdu_length)
+            field_values[0].p_buffer = p_optiga_calc_sign->p_digest;
+            field_values[0].value = p_optiga_calc_sign->digest_length;
+            field_values[1].value = me->session_oid;
+            if (OPTIGA_KEY_ID_SESSION_BASED != p_optiga_calc_sign->private_key_oid)
             {
-                return_status = OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT;
-                *(p_optiga_calc_sign->p_signature_length) = 0x00;
-                break;
+                field_values[1].value = (uint16_t)p_optiga_calc_sign->private_key_oid;
             }
-            // Tag and length for digest
-            optiga_cmd_prepare_tag_header(OPTIGA_CMD_SIGN_DIGEST_TAG,
-                                          p_optiga_calc_sign->digest_length,
-                                          me->p_optiga->optiga_comms_buffer,
-                                          &index_for_data);
-            //Digest data
-            pal_os_memcpy(me->p_optiga->optiga_comms_buffer + index_for_data,
-                          p_optiga_calc_sign->p_digest,
-                          p_optiga_calc_sign->digest_length);
-
-            index_for_data += p_optiga_calc_sign->digest_length;
-
-            // Tag and length for OID of signature key
-            optiga_cmd_prepare_tag_header(OPTIGA_CMD_SIGN_OID_TAG,
-                                          OPTIGA_CMD_SIGN_OID_LEN,
-                                          me->p_optiga->optiga_comms_buffer,
-                                          &index_for_data);
-            //oid
-            private_key_oid = me->session_oid;
-            if (OPTIGA_KEY_ID_SESSION_BASED != p_optiga_calc_sign->private_key_oid)
+            return_status = optiga_cmd_encode_apdu(me, &optiga_cmd_calc_sign_descriptor, field_values);
+            if (OPTIGA_LIB_SUCCESS != return_status)
             {
-                private_key_oid = (uint16_t)p_optiga_calc_sign->private_key_oid;
+                *(p_optiga_calc_sign->p_signature_length) = 0x00;
             }
-            optiga_common_set_uint16(&me->p_optiga->optiga_comms_buffer[index_for_data],
-                                     private_key_oid);
-            index_for_data += OPTIGA_CMD_UINT16_SIZE_IN_BYTES;
-
-            // prepare apdu
-            optiga_cmd_prepare_apdu_header(OPTIGA_CMD_CALC_SIGN,
-                                           me->cmd_param,
-                                           (index_for_data - OPTIGA_CMD_APDU_INDATA_OFFSET),
-                                           me->p_optiga->optiga_comms_buffer + OPTIGA_COMMS_DATA_OFFSET);
-
-            me->p_optiga->comms_tx_size = (index_for_data - OPTIGA_COMMS_DATA_OFFSET);
-            return_status = OPTIGA_LIB_SUCCESS;
         }
         break;
         case OPTIGA_CMD_EXEC_PROCESS_RESPONSE:
         {
             OPTIGA_CMD_LOG_MESSAGE("Processing response for calculate sign command...");
-            // check if the calculate signature command was successful
-            if (OPTIGA_CMD_APDU_SUCCESS == me->p_optiga->optiga_comms_buffer[OPTIGA_COMMS_DATA_OFFSET])
-            {
-                // if the received signature length is greater than the user provided signature buffer length
-                if ((*(p_optiga_calc_sign->p_signature_length)) <
-                    (me->p_optiga->comms_rx_size - OPTIGA_CMD_APDU_HEADER_SIZE))
+#ifdef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+            // The DER INTEGERs are converted to the requested format straight from the response
+            if ((OPTIGA_CMD_APDU_SUCCESS == me->p_optiga->optiga_comms_buffer[OPTIGA_COMMS_DATA_OFFSET]) &&
+                ((uint8_t)OPTIGA_ECDSA_SIGNATURE_FORMAT_DER_INTEGERS != p_optiga_calc_sign->signature_format))
+            {
+                return_status = optiga_common_ecdsa_signature_from_der(me->p_optiga->optiga_comms_buffer +
+                                                                       OPTIGA_CMD_APDU_INDATA_OFFSET,
+                                                                       me->p_optiga->comms_rx_size - OPTIGA_CMD_APDU_HEADER_SIZE,
+                                                                       p_optiga_calc_sign->signature_format,
+                                                                       p_optiga_calc_sign->p_signature,
+                                                                       p_optiga_calc_sign->p_signature_length);
+                if (OPTIGA_LIB_SUCCESS != return_status)
                 {
                     OPTIGA_CMD_LOG_MESSAGE("Error in processing calculate sign response...");
                     *(p_optiga_calc_sign->p_signature_length) = 0x00;
-                    return_status = OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT;
-                }
-                else
-                {
-                    *(p_optiga_calc_sign->p_signature_length) = me->p_optiga->comms_rx_size - OPTIGA_CMD_APDU_HEADER_SIZE;
-                    //copy signed data from optiga comms buffer to user provided buffer
-
-                    pal_os_memcpy(p_optiga_calc_sign->p_signature,
-                                  me->p_optiga->optiga_comms_buffer + OPTIGA_CMD_APDU_INDATA_OFFSET,
-                                  *(p_optiga_calc_sign->p_signature_length));
-                    OPTIGA_CMD_LOG_MESSAGE("Response of calculate sign command is processed...");
-                    return_status = OPTIGA_LIB_SUCCESS;
                 }
+                break;
             }
-            else
+#endif //OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+            //copy signed data from optiga comms buffer to user provided buffer
+            return_status = optiga_cmd_decode_response(me,
+                                                       p_optiga_calc_sign->p_signature,
+                                                       p_optiga_calc_sign->p_signature_length);
+            if (OPTIGA_LIB_SUCCESS != return_status)
             {
                 OPTIGA_CMD_LOG_MESSAGE("Error in processing calculate sign response...");
-                //lint --e{835} suppress "SET_DEV_ERROR_NOTIFICATION is generically written for any unsigned interger value"
-                //lint --e{845} suppress "SET_DEV_ERROR_NOTIFICATION is generically written for any unsigned interger value"
-                SET_DEV_ERROR_NOTIFICATION(OPTIGA_CMD_EXIT_HANDLER_CALL);
-                *(p_optiga_calc_sign->p_signature_length) = 0x00;
+                break;
             }
+            OPTIGA_CMD_LOG_MESSAGE("Response of calculate sign command is processed...");
         }
         break;
         default:
@@ -2521,6 +7576,7 @@ _STATIC_H optiga_lib_status_t optiga_cmd_verify_sign_handler(optiga_cmd_t * me)
     optiga_verify_sign_params_t * p_optiga_verify_sign = (optiga_verify_sign_params_t *)me->p_input;
     uint16_t index_for_data = OPTIGA_CMD_APDU_INDATA_OFFSET;
     optiga_lib_status_t return_status = OPTIGA_CMD_ERROR;
+    uint16_t signature_length = p_optiga_verify_sign->signature_length;
 
     switch ((uint8_t)me->cmd_next_execution_state)
     {
@@ -2531,11 +7587,18 @@ _STATIC_H optiga_lib_status_t optiga_cmd_verify_sign_handler(optiga_cmd_t * me)
             // If public key from OID (TLV of public key OID)
             // If public key from host (TLV of algo ID + TLV of public key)
             total_apdu_length = OPTIGA_CMD_APDU_HEADER_SIZE + OPTIGA_CMD_TAG_LENGTH_SIZE + p_optiga_verify_sign->digest_length +
-                                    OPTIGA_CMD_TAG_LENGTH_SIZE + (p_optiga_verify_sign->signature_length) +
+                                    OPTIGA_CMD_TAG_LENGTH_SIZE + signature_length +
                                     (OPTIGA_CRYPT_OID_DATA == p_optiga_verify_sign->public_key_source_type ?
                                      (OPTIGA_CMD_TAG_LENGTH_SIZE + OPTIGA_CMD_UINT16_SIZE_IN_BYTES):
                                     (OPTIGA_CMD_TAG_LENGTH_SIZE + OPTIGA_CMD_UINT16_SIZE_IN_BYTES + OPTIGA_CMD_NO_OF_BYTES_IN_TAG + OPTIGA_CMD_TAG_LENGTH_SIZE +
                                      p_optiga_verify_sign->public_key->length));
+#ifdef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+            if ((uint8_t)OPTIGA_ECDSA_SIGNATURE_FORMAT_RAW == p_optiga_verify_sign->signature_format)
+            {
+                // DER INTEGERs are longer than r || s
+                total_apdu_length += OPTIGA_ECDSA_SIGNATURE_DER_OVERHEAD;
+            }
+#endif //OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
             if (OPTIGA_MAX_COMMS_BUFFER_SIZE < total_apdu_length)
             {
                 return_status = OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT;
@@ -2552,16 +7615,35 @@ _STATIC_H optiga_lib_status_t optiga_cmd_verify_sign_handler(optiga_cmd_t * me)
                           p_optiga_verify_sign->digest_length);
             index_for_data += p_optiga_verify_sign->digest_length;
 
+#ifdef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+            // The signature is converted to the DER INTEGERs straight into the APDU
+            if ((uint8_t)OPTIGA_ECDSA_SIGNATURE_FORMAT_DER_INTEGERS != p_optiga_verify_sign->signature_format)
+            {
+                signature_length = p_optiga_verify_sign->signature_length + OPTIGA_ECDSA_SIGNATURE_DER_OVERHEAD;
+                return_status = optiga_common_ecdsa_signature_to_der(p_optiga_verify_sign->p_signature,
+                                                                     p_optiga_verify_sign->signature_length,
+                                                                     p_optiga_verify_sign->signature_format,
+                                                                     me->p_optiga->optiga_comms_buffer + index_for_data +
+                                                                     OPTIGA_CMD_TAG_LENGTH_SIZE,
+                                                                     &signature_length);
+                if (OPTIGA_LIB_SUCCESS != return_status)
+                {
+                    break;
+                }
+            }
+            else
+#endif //OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+            {
+                pal_os_memcpy(me->p_optiga->optiga_comms_buffer + index_for_data + OPTIGA_CMD_TAG_LENGTH_SIZE,
+                              p_optiga_verify_sign->p_signature,
+                              signature_length);
+            }
             //TLV formation for signature
             optiga_cmd_prepare_tag_header(OPTIGA_CMD_VERIFY_SIGN_SIGNATURE_TAG,
-                                          p_optiga_verify_sign->signature_length,
+                                          signature_length,
                                           me->p_optiga->optiga_comms_buffer,
                                           &index_for_data);
-
-            pal_os_memcpy(me->p_optiga->optiga_comms_buffer + index_for_data,
-                          p_optiga_verify_sign->p_signature,
-                          p_optiga_verify_sign->signature_length);
-            index_for_data += p_optiga_verify_sign->signature_length;
+            index_for_data += signature_length;
 
             if (OPTIGA_CRYPT_OID_DATA == p_optiga_verify_sign->public_key_source_type)
             {
@@ -2648,123 +7730,76 @@ optiga_lib_status_t optiga_cmd_verify_sign(optiga_cmd_t * me,
 #endif //OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED
 
 #ifdef OPTIGA_CRYPT_ECDH_ENABLED
+// Shared secret is stored in the session OID
+_STATIC_H const optiga_cmd_field_descriptor_t optiga_cmd_calc_ssec_store_fields[] =
+{
+    {OPTIGA_CMD_SSEC_PRIVATE_KEY_TAG, OPTIGA_CMD_FIELD_UINT16},
+    {OPTIGA_CMD_SSEC_ALG_ID_TAG, OPTIGA_CMD_FIELD_UINT8},
+    {OPTIGA_CMD_SSEC_PUB_KEY_TAG, OPTIGA_CMD_FIELD_BUFFER},
+    {OPTIGA_CMD_SSEC_STORE_SESSION_TAG, OPTIGA_CMD_FIELD_UINT16}
+};
+
+// Shared secret is exported to the host
+_STATIC_H const optiga_cmd_field_descriptor_t optiga_cmd_calc_ssec_export_fields[] =
+{
+    {OPTIGA_CMD_SSEC_PRIVATE_KEY_TAG, OPTIGA_CMD_FIELD_UINT16},
+    {OPTIGA_CMD_SSEC_ALG_ID_TAG, OPTIGA_CMD_FIELD_UINT8},
+    {OPTIGA_CMD_SSEC_PUB_KEY_TAG, OPTIGA_CMD_FIELD_BUFFER},
+    {OPTIGA_CMD_SSEC_EXPORT_TAG, OPTIGA_CMD_FIELD_EMPTY}
+};
+
+_STATIC_H const optiga_cmd_descriptor_t optiga_cmd_calc_ssec_descriptor[] =
+{
+    {OPTIGA_CMD_CALC_SSEC, 4, optiga_cmd_calc_ssec_store_fields},
+    {OPTIGA_CMD_CALC_SSEC, 4, optiga_cmd_calc_ssec_export_fields}
+};
+
 /*
 * CalcSSec handler
 */
 _STATIC_H optiga_lib_status_t optiga_cmd_calc_ssec_handler(optiga_cmd_t * me)
 {
-    uint16_t total_apdu_length;
     optiga_lib_status_t return_status = OPTIGA_CMD_ERROR;
     optiga_calc_ssec_params_t * p_optiga_ecdh = (optiga_calc_ssec_params_t *)me->p_input;
-    uint16_t index_for_data = OPTIGA_CMD_APDU_INDATA_OFFSET;
-    uint16_t private_key_oid;
+    optiga_cmd_field_value_t field_values[4] = {{NULL, 0}, {NULL, 0}, {NULL, 0}, {NULL, 0}};
 
     switch ((uint8_t)me->cmd_next_execution_state)
     {
         case OPTIGA_CMD_EXEC_PREPARE_COMMAND:
         {
             OPTIGA_CMD_LOG_MESSAGE("Sending calculate shared secret command..");
-            // APDU header length + TLV of private key + TLV of algo id + TLV of public key
+            // TLV of private key + TLV of algo id + TLV of public key
             // If shared secret option to export (TLV of export shared secret)
             // If shared secret store in OID (TLV of shared secret OID)
-            total_apdu_length = OPTIGA_CMD_APDU_HEADER_SIZE + OPTIGA_CMD_TAG_LENGTH_SIZE + OPTIGA_CMD_UINT16_SIZE_IN_BYTES +
-                                    OPTIGA_CMD_TAG_LENGTH_SIZE + OPTIGA_CMD_NO_OF_BYTES_IN_TAG + OPTIGA_CMD_TAG_LENGTH_SIZE +
-                                    p_optiga_ecdh->public_key->length +
-                                    (TRUE == p_optiga_ecdh->export_to_host?(OPTIGA_CMD_TAG_LENGTH_SIZE):
-                                    (OPTIGA_CMD_TAG_LENGTH_SIZE + OPTIGA_CMD_UINT16_SIZE_IN_BYTES));
-            if (OPTIGA_MAX_COMMS_BUFFER_SIZE < total_apdu_length)
-            {
-                return_status = OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT;
-                break;
-            }
-            // Tag and length for private key OID
-            optiga_cmd_prepare_tag_header(OPTIGA_CMD_SSEC_PRIVATE_KEY_TAG,
-                                          OPTIGA_CMD_SSEC_PRIVATE_KEY_LEN,
-                                          me->p_optiga->optiga_comms_buffer,
-                                          &index_for_data);
-
-            private_key_oid = (uint16_t)p_optiga_ecdh->private_key;
+            field_values[0].value = (uint16_t)p_optiga_ecdh->private_key;
             if (OPTIGA_KEY_ID_SESSION_BASED == p_optiga_ecdh->private_key)
             {
-                private_key_oid = me->session_oid;
-            }
-
-            optiga_common_set_uint16(&me->p_optiga->optiga_comms_buffer[index_for_data], private_key_oid);
-            index_for_data += OPTIGA_CMD_UINT16_SIZE_IN_BYTES;
-
-            // Tag and length for algorithm ID
-            optiga_cmd_prepare_tag_header(OPTIGA_CMD_SSEC_ALG_ID_TAG,
-                                          OPTIGA_CMD_SSEC_ALG_ID_LEN,
-                                          me->p_optiga->optiga_comms_buffer,
-                                          &index_for_data);
-
-            me->p_optiga->optiga_comms_buffer[index_for_data++] = (uint8_t)p_optiga_ecdh->public_key->key_type;
-
-            // Tag and length for public key
-            optiga_cmd_prepare_tag_header(OPTIGA_CMD_SSEC_PUB_KEY_TAG,
-                                          p_optiga_ecdh->public_key->length,
-                                          me->p_optiga->optiga_comms_buffer,
-                                          &index_for_data);
-
-            //Copy the public key to APDU
-            pal_os_memcpy(&me->p_optiga->optiga_comms_buffer[index_for_data],
-                          p_optiga_ecdh->public_key->public_key,
-                          p_optiga_ecdh->public_key->length);
-
-            index_for_data += p_optiga_ecdh->public_key->length;
-
-            // check if shared secret needs to be exported or stored
-            if (FALSE == p_optiga_ecdh->export_to_host)
-            {
-                // Tag and length for storing shared secret in session OID
-                optiga_cmd_prepare_tag_header(OPTIGA_CMD_SSEC_STORE_SESSION_TAG,
-                                              OPTIGA_CMD_SSEC_STORE_SESSION_LEN,
-                                              me->p_optiga->optiga_comms_buffer,
-                                              &index_for_data);
-                // store session secret oid
-                optiga_common_set_uint16(&me->p_optiga->optiga_comms_buffer[index_for_data], me->session_oid);
-                index_for_data += OPTIGA_CMD_UINT16_SIZE_IN_BYTES;
-            }
-            else
-            {
-                // Tag and length for exporting shared secret
-                optiga_cmd_prepare_tag_header(OPTIGA_CMD_SSEC_EXPORT_TAG,
-                                              OPTIGA_CMD_SSEC_EXPORT_LEN,
-                                              me->p_optiga->optiga_comms_buffer,
-                                              &index_for_data);
+                field_values[0].value = me->session_oid;
             }
+            field_values[1].value = (uint8_t)p_optiga_ecdh->public_key->key_type;
+            field_values[2].p_buffer = p_optiga_ecdh->public_key->public_key;
+            field_values[2].value = p_optiga_ecdh->public_key->length;
+            field_values[3].value = me->session_oid;
 
-            // prepare apdu
-            optiga_cmd_prepare_apdu_header(OPTIGA_CMD_CALC_SSEC,
-                                           me->cmd_param,
-                                           (index_for_data - OPTIGA_CMD_APDU_INDATA_OFFSET),
-                                           me->p_optiga->optiga_comms_buffer + OPTIGA_COMMS_DATA_OFFSET);
-
-            me->p_optiga->comms_tx_size = (index_for_data - OPTIGA_COMMS_DATA_OFFSET);
-            return_status = OPTIGA_LIB_SUCCESS;
+            return_status = optiga_cmd_encode_apdu(me,
+                                                   &optiga_cmd_calc_ssec_descriptor[(FALSE == p_optiga_ecdh->export_to_host) ? 0 : 1],
+                                                   field_values);
         }
         break;
         case OPTIGA_CMD_EXEC_PROCESS_RESPONSE:
         {
             OPTIGA_CMD_LOG_MESSAGE("Processing response for calculate shared secret command...");
-            // check if the shared secret transceive was successful
-            if (OPTIGA_CMD_APDU_SUCCESS != me->p_optiga->optiga_comms_buffer[OPTIGA_COMMS_DATA_OFFSET])
+            //copy shared secret from optiga comms buffer to user provided buffer, if exported
+            return_status = optiga_cmd_decode_response(me,
+                                                       (FALSE != p_optiga_ecdh->export_to_host) ?
+                                                       p_optiga_ecdh->shared_secret : NULL,
+                                                       NULL);
+            if (OPTIGA_LIB_SUCCESS != return_status)
             {
                 OPTIGA_CMD_LOG_MESSAGE("Error in processing calculate shared secret response...");
-                //lint --e{835} suppress "SET_DEV_ERROR_NOTIFICATION is generically written for any unsigned interger value"
-                //lint --e{845} suppress "SET_DEV_ERROR_NOTIFICATION is generically written for any unsigned interger value"
-                SET_DEV_ERROR_NOTIFICATION(OPTIGA_CMD_EXIT_HANDLER_CALL);
                 break;
             }
-            if (FALSE != p_optiga_ecdh->export_to_host)
-            {
-                //copy shared secret from optiga comms buffer to user provided buffer
-                pal_os_memcpy(p_optiga_ecdh->shared_secret,
-                              me->p_optiga->optiga_comms_buffer + OPTIGA_CMD_APDU_INDATA_OFFSET,
-                              (me->p_optiga->comms_rx_size - OPTIGA_CMD_APDU_HEADER_SIZE));
-            }
             OPTIGA_CMD_LOG_MESSAGE("Response of calculate shared secret command is processed...");
-            return_status = OPTIGA_LIB_SUCCESS;
         }
         break;
         default:
@@ -3082,76 +8117,56 @@ _STATIC_H uint16_t optiga_cmd_check_private_key_length(uint8_t algorithm)
     return priv_key_len;
 }
 
+// Private key is stored in the key OID
+_STATIC_H const optiga_cmd_field_descriptor_t optiga_cmd_gen_keypair_store_fields[] =
+{
+    {OPTIGA_CMD_GEN_KEY_PAIR_PRIVATE_KEY_OID_TAG, OPTIGA_CMD_FIELD_UINT16},
+    {OPTIGA_CMD_GEN_KEY_PAIR_KEY_USAGE_TAG, OPTIGA_CMD_FIELD_UINT8}
+};
+
+// Private key is exported to the host
+_STATIC_H const optiga_cmd_field_descriptor_t optiga_cmd_gen_keypair_export_fields[] =
+{
+    {OPTIGA_CMD_GEN_KEY_PAIR_EXPORT_KEY_TAG, OPTIGA_CMD_FIELD_EMPTY}
+};
+
+_STATIC_H const optiga_cmd_descriptor_t optiga_cmd_gen_keypair_descriptor[] =
+{
+    {OPTIGA_CMD_GEN_KEYPAIR, 2, optiga_cmd_gen_keypair_store_fields},
+    {OPTIGA_CMD_GEN_KEYPAIR, 1, optiga_cmd_gen_keypair_export_fields}
+};
+
 /*
 * GenKeyPair handler
 */
 _STATIC_H optiga_lib_status_t optiga_cmd_gen_keypair_handler(optiga_cmd_t * me)
 {
-    uint16_t total_apdu_length;
     optiga_gen_keypair_params_t * p_optiga_gen_keypair = (optiga_gen_keypair_params_t *)me->p_input;
+    optiga_cmd_field_value_t field_values[2] = {{NULL, 0}, {NULL, 0}};
     uint16_t header_offset;
     uint16_t private_key_length;
-    uint16_t index_for_data = OPTIGA_CMD_APDU_INDATA_OFFSET;
     uint16_t out_data_size;
     uint16_t public_key_length;
     optiga_lib_status_t return_status = OPTIGA_CMD_ERROR;
 
     switch ((uint8_t)me->cmd_next_execution_state)
     {
-        case OPTIGA_CMD_EXEC_PREPARE_COMMAND:
-        {
-            OPTIGA_CMD_LOG_MESSAGE("Sending generate keypair command..");
-            // APDU header length +
-            // If private key option to store in OID (TLV of private key + TLV of key usages)
-            // If private key option to export (TLV of export key pair)
-            total_apdu_length = OPTIGA_CMD_APDU_HEADER_SIZE +
-                                    (FALSE == p_optiga_gen_keypair->export_private_key ?
-                                    (OPTIGA_CMD_TAG_LENGTH_SIZE + OPTIGA_CMD_UINT16_SIZE_IN_BYTES + OPTIGA_CMD_TAG_LENGTH_SIZE + OPTIGA_CMD_NO_OF_BYTES_IN_TAG):
-                                    (OPTIGA_CMD_TAG_LENGTH_SIZE ));
-            if (OPTIGA_MAX_COMMS_BUFFER_SIZE < total_apdu_length)
-            {
-                return_status = OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT;
-                *p_optiga_gen_keypair->public_key_length = 0;
-                break;
-            }
-            if (FALSE == p_optiga_gen_keypair->export_private_key)
-            {
-                ///TLV formation for private key OID
-                optiga_cmd_prepare_tag_header (OPTIGA_CMD_GEN_KEY_PAIR_PRIVATE_KEY_OID_TAG,
-                                               OPTIGA_CMD_GEN_KEY_PAIR_PRIVATE_KEY_OID_LENGTH,
-                                               me->p_optiga->optiga_comms_buffer,
-                                               &index_for_data);
-                ///Update OID based on input param
-                optiga_common_set_uint16((me->p_optiga->optiga_comms_buffer + index_for_data),
-                                         ((OPTIGA_KEY_ID_SESSION_BASED == p_optiga_gen_keypair->private_key_oid)?
-                                         me->session_oid:(uint16_t)p_optiga_gen_keypair->private_key_oid));
-
-                index_for_data += OPTIGA_CMD_UINT16_SIZE_IN_BYTES;
-                ///TLV formation for key usage
-                optiga_cmd_prepare_tag_header (OPTIGA_CMD_GEN_KEY_PAIR_KEY_USAGE_TAG,
-                                               OPTIGA_CMD_GEN_KEY_PAIR_KEY_USAGE_LENGTH,
-                                               me->p_optiga->optiga_comms_buffer,
-                                               &index_for_data);
+        case OPTIGA_CMD_EXEC_PREPARE_COMMAND:
+        {
+            OPTIGA_CMD_LOG_MESSAGE("Sending generate keypair command..");
+            // If private key option to store in OID (TLV of private key + TLV of key usages)
+            // If private key option to export (TLV of export key pair)
+            field_values[0].value = (OPTIGA_KEY_ID_SESSION_BASED == p_optiga_gen_keypair->private_key_oid) ?
+                                    me->session_oid : (uint16_t)p_optiga_gen_keypair->private_key_oid;
+            field_values[1].value = p_optiga_gen_keypair->key_usage;
 
-                *(me->p_optiga->optiga_comms_buffer + index_for_data++) = p_optiga_gen_keypair->key_usage;
-            }
-            else
+            return_status = optiga_cmd_encode_apdu(me,
+                                                   &optiga_cmd_gen_keypair_descriptor[(FALSE == p_optiga_gen_keypair->export_private_key) ? 0 : 1],
+                                                   field_values);
+            if (OPTIGA_LIB_SUCCESS != return_status)
             {
-                ///TLV formation for export key
-                optiga_cmd_prepare_tag_header (OPTIGA_CMD_GEN_KEY_PAIR_EXPORT_KEY_TAG,
-                                               OPTIGA_CMD_GEN_KEY_PAIR_EXPORT_KEY_LENGTH,
-                                               me->p_optiga->optiga_comms_buffer,
-                                               &index_for_data);
+                *p_optiga_gen_keypair->public_key_length = 0;
             }
-
-            //form apdu header
-            optiga_cmd_prepare_apdu_header(OPTIGA_CMD_GEN_KEYPAIR, me->cmd_param,
-                                            (uint16_t)(index_for_data - OPTIGA_CMD_APDU_INDATA_OFFSET),
-            me->p_optiga->optiga_comms_buffer + OPTIGA_COMMS_DATA_OFFSET);
-
-            me->p_optiga->comms_tx_size = (uint16_t)(index_for_data - OPTIGA_COMMS_DATA_OFFSET);
-
-            return_status = OPTIGA_LIB_SUCCESS;
         }
         break;
         case OPTIGA_CMD_EXEC_PROCESS_RESPONSE:
@@ -3597,6 +8612,11 @@ optiga_lib_status_t optiga_cmd_decrypt_asym(optiga_cmd_t * me, uint8_t cmd_param
 #endif // OPTIGA_CRYPT_RSA_DECRYPT_ENABLED
 
 #ifdef OPTIGA_CRYPT_HASH_ENABLED
+// Hash sequence, irrespective of the source of data
+#define OPTIGA_CMD_GET_HASH_SEQUENCE(p_params)      ((uint8_t)((p_params)->hash_sequence & (uint8_t)(~OPTIGA_CRYPT_HASH_FOR_OID)))
+// Hash context is resident in OPTIGA, if no context buffer is provided
+#define OPTIGA_CMD_IS_HASH_CONTEXT_RESIDENT(p_params) \
+    ((NULL != (p_params)->p_hash_context) && (NULL == (p_params)->p_hash_context->context_buffer))
 
 _STATIC_H void optiga_cmd_calc_hash_set_current_hash_sequence(const optiga_cmd_t * me)
 {
@@ -3814,6 +8834,14 @@ _STATIC_H optiga_lib_status_t optiga_cmd_calc_hash_handler(optiga_cmd_t * me)
                               OPTIGA_CMD_NO_OF_BYTES_IN_TAG], out_data_size);
                 p_optiga_calc_hash->p_hash_context->context_buffer_length = out_data_size;
             }
+            // Strict lock is retained to keep the context resident in OPTIGA, until the sequence is finalized
+            if ((FALSE == me->chaining_ongoing) && (OPTIGA_CMD_IS_HASH_CONTEXT_RESIDENT(p_optiga_calc_hash)) &&
+                ((OPTIGA_CRYPT_HASH_START == OPTIGA_CMD_GET_HASH_SEQUENCE(p_optiga_calc_hash)) ||
+                (OPTIGA_CRYPT_HASH_CONTINUE == OPTIGA_CMD_GET_HASH_SEQUENCE(p_optiga_calc_hash))))
+            {
+                me->cmd_sub_execution_state = OPTIGA_CMD_STATE_EXIT;
+                PAL_OS_EVENT_START(me->p_optiga->p_pal_os_event_ctx, optiga_cmd_queue_scheduler, me->p_optiga);
+            }
             OPTIGA_CMD_LOG_MESSAGE("Response of calculate hash command is processed...");
             return_status = OPTIGA_LIB_SUCCESS;
         }
@@ -3830,20 +8858,60 @@ optiga_lib_status_t optiga_cmd_calc_hash(optiga_cmd_t * me,
                                          optiga_calc_hash_params_t * params)
 {
     optiga_calc_hash_params_t * p_optiga_calc_hash = (optiga_calc_hash_params_t*)params;
+    optiga_cmd_sub_state_t next_execution_sub_state = OPTIGA_CMD_EXEC_REQUEST_LOCK;
+    uint8_t hash_sequence = OPTIGA_CMD_GET_HASH_SEQUENCE(p_optiga_calc_hash);
+    uint8_t is_strict_lock_acquired;
+    optiga_lib_status_t return_status = OPTIGA_LIB_SUCCESS;
     OPTIGA_CMD_LOG_MESSAGE(__FUNCTION__);
 
     p_optiga_calc_hash->data_sent = 0;
 
-    optiga_cmd_execute(me,
-                       cmd_param,
-                       optiga_cmd_calc_hash_handler,
-                       OPTIGA_CMD_EXEC_PREPARE_COMMAND,
-                       OPTIGA_CMD_EXEC_REQUEST_LOCK,
-                       params,
-                       //lint --e{835} suppress "Upper 8 bits of apdu_data is kept as zero and is reserved for future enhancements"
-                       OPTIGA_CMD_SET_APDU_DATA(OPTIGA_CMD_CALC_HASH, OPTIGA_CMD_ZERO_LENGTH_OR_VALUE));
+    do
+    {
+        if (!OPTIGA_CMD_IS_HASH_CONTEXT_RESIDENT(p_optiga_calc_hash))
+        {
+            break;
+        }
+        // For the context resident in OPTIGA, the sequence is executed under strict lock
+        next_execution_sub_state = OPTIGA_CMD_EXEC_REQUEST_STRICT_LOCK;
+        is_strict_lock_acquired = (uint8_t)((OPTIGA_CMD_QUEUE_REQUEST_STRICT_LOCK ==
+                                             optiga_cmd_queue_get_state_of(me, OPTIGA_CMD_QUEUE_SLOT_LOCK_TYPE)) &&
+                                            (OPTIGA_CMD_QUEUE_PROCESSING ==
+                                             optiga_cmd_queue_get_state_of(me, OPTIGA_CMD_QUEUE_SLOT_STATE)));
+        if (OPTIGA_CRYPT_HASH_START == hash_sequence)
+        {
+            // Reacquire the strict lock, if the previous sequence is not finalized
+            next_execution_sub_state = (TRUE == is_strict_lock_acquired) ? OPTIGA_CMD_EXEC_RESET_STRICT_LOCK :
+                                                                           OPTIGA_CMD_EXEC_REQUEST_STRICT_LOCK;
+            break;
+        }
+        // Continue or Final is invoked without the strict lock acquired by hash start
+        if (FALSE == is_strict_lock_acquired)
+        {
+            return_status = OPTIGA_CMD_STRICT_LOCK_LOST_STATUS(me);
+            break;
+        }
+        // Continue or Final is invoked while the strict lock is acquired by another command
+        if (OPTIGA_CMD_CALC_HASH != OPTIGA_CMD_GET_APDU_CMD(me->apdu_data))
+        {
+            return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+            break;
+        }
+    } while (FALSE);
 
-    return (OPTIGA_LIB_SUCCESS);
+    if (OPTIGA_LIB_SUCCESS == return_status)
+    {
+        optiga_cmd_execute(me,
+                           cmd_param,
+                           optiga_cmd_calc_hash_handler,
+                           OPTIGA_CMD_EXEC_PREPARE_COMMAND,
+                           next_execution_sub_state,
+                           params,
+                           //lint --e{835} suppress "Upper 8 bits of apdu_data is kept as zero and is reserved for future enhancements"
+                           OPTIGA_CMD_SET_APDU_DATA(OPTIGA_CMD_CALC_HASH, OPTIGA_CMD_ZERO_LENGTH_OR_VALUE));
+    }
+
+    return (return_status);
 }
 #endif //OPTIGA_CRYPT_HASH_ENABLED
 
@@ -4119,7 +9187,7 @@ _STATIC_H optiga_lib_status_t optiga_cmd_enc_dec_sym_handler(optiga_cmd_t * me)
                     else
                     {
                         me->cmd_sub_execution_state = OPTIGA_CMD_STATE_EXIT;
-                        pal_os_event_start(me->p_optiga->p_pal_os_event_ctx, optiga_cmd_queue_scheduler, me->p_optiga);
+                        PAL_OS_EVENT_START(me->p_optiga->p_pal_os_event_ctx, optiga_cmd_queue_scheduler, me->p_optiga);
                     }
                 }
             }
@@ -4169,7 +9237,7 @@ optiga_lib_status_t optiga_cmd_encrypt_sym(optiga_cmd_t * me,
         {
             *params->out_data_length = 0;
         }
-        return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+        return_status = OPTIGA_CMD_STRICT_LOCK_LOST_STATUS(me);
     }
     else
     {
@@ -4259,7 +9327,7 @@ optiga_lib_status_t optiga_cmd_decrypt_sym(optiga_cmd_t * me,
              (OPTIGA_CMD_QUEUE_PROCESSING != optiga_cmd_queue_get_state_of(me, OPTIGA_CMD_QUEUE_SLOT_STATE))))
     {
         *params->out_data_length = 0;
-        return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+        return_status = OPTIGA_CMD_STRICT_LOCK_LOST_STATUS(me);
     }
     else
     {
@@ -4318,6 +9386,16 @@ _STATIC_H optiga_lib_status_t optiga_cmd_set_object_protected_handler(optiga_cmd
         {
             OPTIGA_CMD_LOG_MESSAGE("Sending set data object command..");
             me->chaining_ongoing = FALSE;
+#ifdef OPTIGA_UTIL_READ_CACHE_ENABLED
+            // target data object is known only to OPTIGA (manifest), hence nothing cached is kept
+            optiga_cmd_read_cache_invalidate(me->p_optiga, OPTIGA_CMD_READ_CACHE_ALL_OIDS);
+#endif //OPTIGA_UTIL_READ_CACHE_ENABLED
+#ifdef OPTIGA_UTIL_METADATA_CACHE_ENABLED
+            optiga_cmd_metadata_cache_invalidate(me->p_optiga, OPTIGA_CMD_METADATA_CACHE_ALL_OIDS);
+#endif //OPTIGA_UTIL_METADATA_CACHE_ENABLED
+#ifdef OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+            optiga_cmd_verify_cache_invalidate(me->p_optiga, OPTIGA_CMD_VERIFY_CACHE_ALL_OIDS);
+#endif //OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
 
             // APDU header size + Set Object protected tag 1 bytes + length of buffer 2 bytes + size of data to send
             total_apdu_length = OPTIGA_CMD_APDU_HEADER_SIZE + OPTIGA_CMD_NO_OF_BYTES_IN_TAG + OPTIGA_CMD_UINT16_SIZE_IN_BYTES +
@@ -4371,7 +9449,7 @@ _STATIC_H optiga_lib_status_t optiga_cmd_set_object_protected_handler(optiga_cmd
             else
             {
                 me->cmd_sub_execution_state = OPTIGA_CMD_STATE_EXIT;
-                pal_os_event_start(me->p_optiga->p_pal_os_event_ctx, optiga_cmd_queue_scheduler, me->p_optiga);
+                PAL_OS_EVENT_START(me->p_optiga->p_pal_os_event_ctx, optiga_cmd_queue_scheduler, me->p_optiga);
             }
             OPTIGA_CMD_LOG_MESSAGE("Response of set data object command is processed...");
             return_status = OPTIGA_LIB_SUCCESS;
@@ -4398,7 +9476,7 @@ optiga_lib_status_t optiga_cmd_set_object_protected(optiga_cmd_t * me, uint8_t c
        (OPTIGA_CMD_QUEUE_PROCESSING != optiga_cmd_queue_get_state_of(me, OPTIGA_CMD_QUEUE_SLOT_STATE))))
 
     {
-        return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+        return_status = OPTIGA_CMD_STRICT_LOCK_LOST_STATUS(me);
     }
     else
     {
@@ -4448,14 +9526,32 @@ optiga_lib_status_t optiga_cmd_set_object_protected(optiga_cmd_t * me, uint8_t c
 }
 
 #ifdef OPTIGA_CRYPT_SYM_GENERATE_KEY_ENABLED
+// Symmetric key is stored in the key OID
+_STATIC_H const optiga_cmd_field_descriptor_t optiga_cmd_gen_symkey_store_fields[] =
+{
+    {OPTIGA_CMD_GEN_SYM_KEY_OID_TAG, OPTIGA_CMD_FIELD_UINT16},
+    {OPTIGA_CMD_GEN_SYM_KEY_USAGE_TAG, OPTIGA_CMD_FIELD_UINT8}
+};
+
+// Symmetric key is exported to the host
+_STATIC_H const optiga_cmd_field_descriptor_t optiga_cmd_gen_symkey_export_fields[] =
+{
+    {OPTIGA_CMD_GEN_SYM_KEY_EXPORT_TAG, OPTIGA_CMD_FIELD_EMPTY}
+};
+
+_STATIC_H const optiga_cmd_descriptor_t optiga_cmd_gen_symkey_descriptor[] =
+{
+    {OPTIGA_CMD_GEN_SYM_KEY, 2, optiga_cmd_gen_symkey_store_fields},
+    {OPTIGA_CMD_GEN_SYM_KEY, 1, optiga_cmd_gen_symkey_export_fields}
+};
+
 /*
 * Symmetric Generate Key handler
 */
 _STATIC_H optiga_lib_status_t optiga_cmd_gen_symkey_handler(optiga_cmd_t * me)
 {
-    uint16_t total_apdu_length;
     optiga_gen_symkey_params_t * p_optiga_gen_symkey = (optiga_gen_symkey_params_t *)me->p_input;
-    uint16_t index_for_data = OPTIGA_CMD_APDU_INDATA_OFFSET;
+    optiga_cmd_field_value_t field_values[2] = {{NULL, 0}, {NULL, 0}};
     uint16_t gen_sym_key_length;
     optiga_lib_status_t return_status = OPTIGA_CMD_ERROR;
 
@@ -4464,56 +9560,17 @@ _STATIC_H optiga_lib_status_t optiga_cmd_gen_symkey_handler(optiga_cmd_t * me)
         case OPTIGA_CMD_EXEC_PREPARE_COMMAND:
         {
             OPTIGA_CMD_LOG_MESSAGE("Sending generate symmetric key command..");
-            // APDU header length +
             // If symmetric key option to store in OID (TLV of symmetric key + TLV of key usages)
             // If symmetric key option to export (TLV of export key)
-            total_apdu_length = OPTIGA_CMD_APDU_HEADER_SIZE +
-                                (FALSE == p_optiga_gen_symkey->export_symmetric_key ?
-                                (OPTIGA_CMD_TAG_LENGTH_SIZE + OPTIGA_CMD_UINT16_SIZE_IN_BYTES +
-                                OPTIGA_CMD_TAG_LENGTH_SIZE + OPTIGA_CMD_NO_OF_BYTES_IN_TAG):
-                                (OPTIGA_CMD_TAG_LENGTH_SIZE ));
-            if (OPTIGA_MAX_COMMS_BUFFER_SIZE < total_apdu_length)
-            {
-                return_status = OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT;
-                break;
-            }
             if (FALSE == p_optiga_gen_symkey->export_symmetric_key)
             {
-                ///TLV formation for symmetric key OID
-                optiga_cmd_prepare_tag_header(OPTIGA_CMD_GEN_SYM_KEY_OID_TAG,
-                                              OPTIGA_CMD_GEN_SYM_KEY_OID_LENGTH,
-                                              me->p_optiga->optiga_comms_buffer,
-                                              &index_for_data);
-                ///Update OID based on input param
-                optiga_common_set_uint16((me->p_optiga->optiga_comms_buffer + index_for_data),
-                                         (uint16_t)*((optiga_key_id_t *)p_optiga_gen_symkey->symmetric_key));
-
-                index_for_data += OPTIGA_CMD_UINT16_SIZE_IN_BYTES;
-                ///TLV formation for key usage
-                optiga_cmd_prepare_tag_header(OPTIGA_CMD_GEN_SYM_KEY_USAGE_TAG,
-                                              OPTIGA_CMD_GEN_SYM_KEY_USAGE_LENGTH,
-                                              me->p_optiga->optiga_comms_buffer,
-                                              &index_for_data);
-
-                *(me->p_optiga->optiga_comms_buffer + index_for_data++) = p_optiga_gen_symkey->key_usage;
-            }
-            else
-            {
-                ///TLV formation for export key
-                optiga_cmd_prepare_tag_header(OPTIGA_CMD_GEN_SYM_KEY_EXPORT_TAG,
-                                              OPTIGA_CMD_GEN_SYM_KEY_EXPORT_LENGTH,
-                                              me->p_optiga->optiga_comms_buffer,
-                                              &index_for_data);
+                field_values[0].value = (uint16_t)*((optiga_key_id_t *)p_optiga_gen_symkey->symmetric_key);
+                field_values[1].value = p_optiga_gen_symkey->key_usage;
             }
 
-            //form apdu header
-            optiga_cmd_prepare_apdu_header(OPTIGA_CMD_GEN_SYM_KEY,
-                                           me->cmd_param,
-                                           (uint16_t)(index_for_data - OPTIGA_CMD_APDU_INDATA_OFFSET),
-                                           me->p_optiga->optiga_comms_buffer + OPTIGA_COMMS_DATA_OFFSET);
-
-            me->p_optiga->comms_tx_size = (uint16_t)(index_for_data - OPTIGA_COMMS_DATA_OFFSET);
-            return_status = OPTIGA_LIB_SUCCESS;
+            return_status = optiga_cmd_encode_apdu(me,
+                                                   &optiga_cmd_gen_symkey_descriptor[(FALSE == p_optiga_gen_symkey->export_symmetric_key) ? 0 : 1],
+                                                   field_values);
         }
         break;
         case OPTIGA_CMD_EXEC_PROCESS_RESPONSE:
@@ -4572,6 +9629,313 @@ optiga_lib_status_t optiga_cmd_gen_symkey(optiga_cmd_t * me, uint8_t cmd_param,
 }
 #endif //OPTIGA_CRYPT_SYM_GENERATE_KEY_ENABLED
 
+/*
+* Checks if the command batch item is supported
+*/
+_STATIC_H optiga_lib_status_t optiga_cmd_batch_check_item(const optiga_cmd_batch_item_t * p_item)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+    do
+    {
+        if (NULL == p_item->params)
+        {
+            break;
+        }
+        if (OPTIGA_CMD_BATCH_ITEM_GET_DATA_OBJECT == p_item->cmd_type)
+        {
+            return_status = OPTIGA_LIB_SUCCESS;
+        }
+#if defined (OPTIGA_CRYPT_ECDSA_SIGN_ENABLED) || defined (OPTIGA_CRYPT_RSA_SIGN_ENABLED)
+        // Session based key needs session acquisition, which is not part of batch
+        if ((OPTIGA_CMD_BATCH_ITEM_CALC_SIGN == p_item->cmd_type) &&
+            (OPTIGA_KEY_ID_SESSION_BASED != ((optiga_calc_sign_params_t *)p_item->params)->private_key_oid))
+        {
+            return_status = OPTIGA_LIB_SUCCESS;
+        }
+#endif //(OPTIGA_CRYPT_ECDSA_SIGN_ENABLED) ||(OPTIGA_CRYPT_RSA_SIGN_ENABLED)
+#if defined (OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED) || defined (OPTIGA_CRYPT_RSA_VERIFY_ENABLED)
+        if (OPTIGA_CMD_BATCH_ITEM_VERIFY_SIGN == p_item->cmd_type)
+        {
+            return_status = OPTIGA_LIB_SUCCESS;
+        }
+#endif //(OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED) || (OPTIGA_CRYPT_RSA_VERIFY_ENABLED)
+#if defined (OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED) || defined (OPTIGA_CRYPT_RSA_GENERATE_KEYPAIR_ENABLED)
+        if (OPTIGA_CMD_BATCH_ITEM_GEN_KEYPAIR == p_item->cmd_type)
+        {
+            return_status = OPTIGA_LIB_SUCCESS;
+        }
+#endif //(OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED) || (OPTIGA_CRYPT_RSA_GENERATE_KEYPAIR_ENABLED)
+#ifdef OPTIGA_CRYPT_ECDH_ENABLED
+        if (OPTIGA_CMD_BATCH_ITEM_CALC_SSEC == p_item->cmd_type)
+        {
+            return_status = OPTIGA_LIB_SUCCESS;
+        }
+#endif //OPTIGA_CRYPT_ECDH_ENABLED
+#if defined (OPTIGA_CRYPT_TLS_PRF_SHA256_ENABLED) || defined (OPTIGA_CRYPT_TLS_PRF_SHA384_ENABLED) || defined (OPTIGA_CRYPT_TLS_PRF_SHA512_ENABLED) || defined (OPTIGA_CRYPT_HKDF_ENABLED)
+        if (OPTIGA_CMD_BATCH_ITEM_DERIVE_KEY == p_item->cmd_type)
+        {
+            return_status = OPTIGA_LIB_SUCCESS;
+        }
+#endif //(OPTIGA_CRYPT_TLS_PRF_SHA256_ENABLED || OPTIGA_CRYPT_TLS_PRF_SHA384_ENABLED || OPTIGA_CRYPT_TLS_PRF_SHA512_ENABLED) || (OPTIGA_CRYPT_HKDF_ENABLED)
+#if defined (OPTIGA_CRYPT_RANDOM_ENABLED) || defined (OPTIGA_CRYPT_RSA_PRE_MASTER_SECRET_ENABLED) || defined (OPTIGA_CRYPT_GENERATE_AUTH_CODE_ENABLED)
+        if (OPTIGA_CMD_BATCH_ITEM_GET_RANDOM == p_item->cmd_type)
+        {
+            return_status = OPTIGA_LIB_SUCCESS;
+        }
+#endif //(OPTIGA_CRYPT_RANDOM_ENABLED) || (OPTIGA_CRYPT_RSA_PRE_MASTER_SECRET_ENABLED) || (OPTIGA_CRYPT_GENERATE_AUTH_CODE_ENABLED)
+#ifdef OPTIGA_CRYPT_SYM_DECRYPT_ENABLED
+        // Only HMAC verify and clear AUTO state are supported, which are completed with one command
+        if ((OPTIGA_CMD_BATCH_ITEM_DECRYPT_SYM == p_item->cmd_type) &&
+            (OPTIGA_CRYPT_SYM_START_FINAL == ((optiga_decrypt_sym_params_t *)p_item->params)->original_sequence) &&
+            ((OPTIGA_CMD_OPERATION_MODE_HMAC == ((optiga_decrypt_sym_params_t *)p_item->params)->operation_mode) ||
+             (OPTIGA_CMD_OPERATION_MODE_CLEAR_AUTO_STATE == ((optiga_decrypt_sym_params_t *)p_item->params)->operation_mode)))
+        {
+            return_status = OPTIGA_LIB_SUCCESS;
+        }
+#endif //OPTIGA_CRYPT_SYM_DECRYPT_ENABLED
+        if ((OPTIGA_CMD_BATCH_ITEM_HOST == p_item->cmd_type) &&
+            (NULL != ((optiga_cmd_batch_host_params_t *)p_item->params)->callback))
+        {
+            return_status = OPTIGA_LIB_SUCCESS;
+        }
+    } while (FALSE);
+    return (return_status);
+}
+
+/*
+* Checks if the command of the batch item uses the session of the instance
+*/
+_STATIC_H bool_t optiga_cmd_batch_uses_session(const optiga_cmd_batch_item_t * p_item)
+{
+    bool_t uses_session = FALSE;
+#if defined (OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED) || defined (OPTIGA_CRYPT_RSA_GENERATE_KEYPAIR_ENABLED)
+    const optiga_gen_keypair_params_t * p_gen_keypair;
+#endif
+#ifdef OPTIGA_CRYPT_ECDH_ENABLED
+    const optiga_calc_ssec_params_t * p_calc_ssec;
+#endif
+#if defined (OPTIGA_CRYPT_TLS_PRF_SHA256_ENABLED) || defined (OPTIGA_CRYPT_TLS_PRF_SHA384_ENABLED) || defined (OPTIGA_CRYPT_TLS_PRF_SHA512_ENABLED) || defined (OPTIGA_CRYPT_HKDF_ENABLED)
+    const optiga_derive_key_params_t * p_derive_key;
+#endif
+#ifdef OPTIGA_CRYPT_SYM_DECRYPT_ENABLED
+    const optiga_decrypt_sym_params_t * p_decrypt_sym;
+#endif
+
+    switch (p_item->cmd_type)
+    {
+#if defined (OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED) || defined (OPTIGA_CRYPT_RSA_GENERATE_KEYPAIR_ENABLED)
+        case OPTIGA_CMD_BATCH_ITEM_GEN_KEYPAIR:
+        {
+            p_gen_keypair = (const optiga_gen_keypair_params_t *)p_item->params;
+            uses_session = (bool_t)((OPTIGA_KEY_ID_SESSION_BASED == p_gen_keypair->private_key_oid) &&
+                                    (FALSE == p_gen_keypair->export_private_key));
+        }
+        break;
+#endif
+#ifdef OPTIGA_CRYPT_ECDH_ENABLED
+        case OPTIGA_CMD_BATCH_ITEM_CALC_SSEC:
+        {
+            p_calc_ssec = (const optiga_calc_ssec_params_t *)p_item->params;
+            uses_session = (bool_t)((OPTIGA_KEY_ID_SESSION_BASED == p_calc_ssec->private_key) ||
+                                    (FALSE == p_calc_ssec->export_to_host));
+        }
+        break;
+#endif
+#if defined (OPTIGA_CRYPT_TLS_PRF_SHA256_ENABLED) || defined (OPTIGA_CRYPT_TLS_PRF_SHA384_ENABLED) || defined (OPTIGA_CRYPT_TLS_PRF_SHA512_ENABLED) || defined (OPTIGA_CRYPT_HKDF_ENABLED)
+        case OPTIGA_CMD_BATCH_ITEM_DERIVE_KEY:
+        {
+            p_derive_key = (const optiga_derive_key_params_t *)p_item->params;
+            uses_session = (bool_t)((NULL == p_derive_key->derived_key) ||
+                                    (0x00 == p_derive_key->input_shared_secret_oid));
+        }
+        break;
+#endif
+#if defined (OPTIGA_CRYPT_RANDOM_ENABLED) || defined (OPTIGA_CRYPT_RSA_PRE_MASTER_SECRET_ENABLED) || defined (OPTIGA_CRYPT_GENERATE_AUTH_CODE_ENABLED)
+        case OPTIGA_CMD_BATCH_ITEM_GET_RANDOM:
+        {
+            // Auth code is stored in the session
+            uses_session = ((const optiga_get_random_params_t *)p_item->params)->store_in_session;
+        }
+        break;
+#endif
+#ifdef OPTIGA_CRYPT_SYM_DECRYPT_ENABLED
+        case OPTIGA_CMD_BATCH_ITEM_DECRYPT_SYM:
+        {
+            // HMAC verify uses the auth code in the session
+            p_decrypt_sym = (const optiga_decrypt_sym_params_t *)p_item->params;
+            uses_session = (bool_t)(OPTIGA_CMD_OPERATION_MODE_HMAC == p_decrypt_sym->operation_mode);
+        }
+        break;
+#endif
+        default:
+            break;
+    }
+    return (uses_session);
+}
+
+_STATIC_H void optiga_cmd_batch_load_item(optiga_cmd_t * me)
+{
+    const optiga_cmd_batch_item_t * p_item = &me->p_batch_items[me->batch_index];
+#ifdef OPTIGA_CRYPT_SYM_DECRYPT_ENABLED
+    optiga_decrypt_sym_params_t * p_decrypt_sym;
+#endif
+
+    me->p_input = p_item->params;
+    me->cmd_param = p_item->cmd_param;
+    me->chaining_ongoing = FALSE;
+#if defined (OPTIGA_CRYPT_ECDSA_SIGN_ENABLED) || defined (OPTIGA_CRYPT_RSA_SIGN_ENABLED)
+    if (OPTIGA_CMD_BATCH_ITEM_CALC_SIGN == p_item->cmd_type)
+    {
+        me->cmd_hdlrs = optiga_cmd_calc_sign_handler;
+        //lint --e{835} suppress "Upper 8 bits of apdu_data is kept as zero and is reserved for future enhancements"
+        me->apdu_data = OPTIGA_CMD_SET_APDU_DATA(OPTIGA_CMD_CALC_SIGN, OPTIGA_CMD_ZERO_LENGTH_OR_VALUE);
+        return;
+    }
+#endif //(OPTIGA_CRYPT_ECDSA_SIGN_ENABLED) ||(OPTIGA_CRYPT_RSA_SIGN_ENABLED)
+#if defined (OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED) || defined (OPTIGA_CRYPT_RSA_VERIFY_ENABLED)
+    if (OPTIGA_CMD_BATCH_ITEM_VERIFY_SIGN == p_item->cmd_type)
+    {
+        me->cmd_hdlrs = optiga_cmd_verify_sign_handler;
+        //lint --e{835} suppress "Upper 8 bits of apdu_data is kept as zero and is reserved for future enhancements"
+        me->apdu_data = OPTIGA_CMD_SET_APDU_DATA(OPTIGA_CMD_VERIFY_SIGN, OPTIGA_CMD_ZERO_LENGTH_OR_VALUE);
+        return;
+    }
+#endif //(OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED) || (OPTIGA_CRYPT_RSA_VERIFY_ENABLED)
+#if defined (OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED) || defined (OPTIGA_CRYPT_RSA_GENERATE_KEYPAIR_ENABLED)
+    if (OPTIGA_CMD_BATCH_ITEM_GEN_KEYPAIR == p_item->cmd_type)
+    {
+        me->cmd_hdlrs = optiga_cmd_gen_keypair_handler;
+        //lint --e{835} suppress "Upper 8 bits of apdu_data is kept as zero and is reserved for future enhancements"
+        me->apdu_data = OPTIGA_CMD_SET_APDU_DATA(OPTIGA_CMD_GEN_KEYPAIR, OPTIGA_CMD_ZERO_LENGTH_OR_VALUE);
+        return;
+    }
+#endif //(OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED) || (OPTIGA_CRYPT_RSA_GENERATE_KEYPAIR_ENABLED)
+#ifdef OPTIGA_CRYPT_ECDH_ENABLED
+    if (OPTIGA_CMD_BATCH_ITEM_CALC_SSEC == p_item->cmd_type)
+    {
+        me->cmd_hdlrs = optiga_cmd_calc_ssec_handler;
+        //lint --e{835} suppress "Upper 8 bits of apdu_data is kept as zero and is reserved for future enhancements"
+        me->apdu_data = OPTIGA_CMD_SET_APDU_DATA(OPTIGA_CMD_CALC_SSEC, OPTIGA_CMD_ZERO_LENGTH_OR_VALUE);
+        return;
+    }
+#endif //OPTIGA_CRYPT_ECDH_ENABLED
+#if defined (OPTIGA_CRYPT_TLS_PRF_SHA256_ENABLED) || defined (OPTIGA_CRYPT_TLS_PRF_SHA384_ENABLED) || defined (OPTIGA_CRYPT_TLS_PRF_SHA512_ENABLED) || defined (OPTIGA_CRYPT_HKDF_ENABLED)
+    if (OPTIGA_CMD_BATCH_ITEM_DERIVE_KEY == p_item->cmd_type)
+    {
+        me->cmd_hdlrs = optiga_cmd_derive_key_handler;
+        //lint --e{835} suppress "Upper 8 bits of apdu_data is kept as zero and is reserved for future enhancements"
+        me->apdu_data = OPTIGA_CMD_SET_APDU_DATA(OPTIGA_CMD_DERIVE_KEY, OPTIGA_CMD_ZERO_LENGTH_OR_VALUE);
+        return;
+    }
+#endif //(OPTIGA_CRYPT_TLS_PRF_SHA256_ENABLED || OPTIGA_CRYPT_TLS_PRF_SHA384_ENABLED || OPTIGA_CRYPT_TLS_PRF_SHA512_ENABLED) || (OPTIGA_CRYPT_HKDF_ENABLED)
+#if defined (OPTIGA_CRYPT_RANDOM_ENABLED) || defined (OPTIGA_CRYPT_RSA_PRE_MASTER_SECRET_ENABLED) || defined (OPTIGA_CRYPT_GENERATE_AUTH_CODE_ENABLED)
+    if (OPTIGA_CMD_BATCH_ITEM_GET_RANDOM == p_item->cmd_type)
+    {
+        me->cmd_hdlrs = optiga_cmd_get_random_handler;
+        //lint --e{835} suppress "Upper 8 bits of apdu_data is kept as zero and is reserved for future enhancements"
+        me->apdu_data = OPTIGA_CMD_SET_APDU_DATA(OPTIGA_CMD_GET_RANDOM, OPTIGA_CMD_ZERO_LENGTH_OR_VALUE);
+        return;
+    }
+#endif //(OPTIGA_CRYPT_RANDOM_ENABLED) || (OPTIGA_CRYPT_RSA_PRE_MASTER_SECRET_ENABLED) || (OPTIGA_CRYPT_GENERATE_AUTH_CODE_ENABLED)
+#ifdef OPTIGA_CRYPT_SYM_DECRYPT_ENABLED
+    if (OPTIGA_CMD_BATCH_ITEM_DECRYPT_SYM == p_item->cmd_type)
+    {
+        // Same as optiga_cmd_decrypt_sym, for the start and final sequence
+        p_decrypt_sym = (optiga_decrypt_sym_params_t *)p_item->params;
+        p_decrypt_sym->sent_data_length = 0;
+        p_decrypt_sym->current_sequence = OPTIGA_CMD_RESET_SEQUENCE;
+        p_decrypt_sym->received_data_length = 0;
+        me->cmd_hdlrs = optiga_cmd_enc_dec_sym_handler;
+        me->apdu_data = OPTIGA_CMD_SET_APDU_DATA(OPTIGA_CMD_DECRYPT_SYM, p_decrypt_sym->operation_mode);
+        return;
+    }
+#endif //OPTIGA_CRYPT_SYM_DECRYPT_ENABLED
+    me->cmd_hdlrs = optiga_cmd_get_data_object_handler;
+    //lint --e{835} suppress "Upper 8 bits of apdu_data is kept as zero and is reserved for future enhancements"
+    me->apdu_data = OPTIGA_CMD_SET_APDU_DATA(OPTIGA_CMD_GET_DATA_OBJECT, OPTIGA_CMD_ZERO_LENGTH_OR_VALUE);
+}
+
+/*
+* Checks the items and starts the command batch.
+* The session is requested along with the lock, if any of the items of the chain uses the session.
+*/
+_STATIC_H optiga_lib_status_t optiga_cmd_batch_start(optiga_cmd_t * me,
+                                                     optiga_cmd_batch_item_t * p_items,
+                                                     uint8_t item_count,
+                                                     uint8_t is_chain)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+    optiga_cmd_sub_state_t initial_state = OPTIGA_CMD_EXEC_REQUEST_LOCK;
+    uint8_t index;
+    do
+    {
+        if ((0U == item_count) || (OPTIGA_CMD_BATCH_MAX_ITEMS < item_count))
+        {
+            break;
+        }
+        // All the items are checked before the lock is requested
+        for (index = 0; index < item_count; index++)
+        {
+            if (OPTIGA_LIB_SUCCESS != optiga_cmd_batch_check_item(&p_items[index]))
+            {
+                break;
+            }
+            // A host item is executed after a command, the batch starts with a command
+            if ((0U == index) && (OPTIGA_CMD_BATCH_ITEM_HOST == p_items[index].cmd_type))
+            {
+                break;
+            }
+            if (TRUE == optiga_cmd_batch_uses_session(&p_items[index]))
+            {
+                // Only a chain ensures, the session is filled by a previous item before it is used
+                if (FALSE == is_chain)
+                {
+                    break;
+                }
+                initial_state = OPTIGA_CMD_EXEC_REQUEST_SESSION;
+            }
+            p_items[index].status = OPTIGA_LIB_BUSY;
+        }
+        if (index < item_count)
+        {
+            break;
+        }
+
+        me->p_batch_items = p_items;
+        me->batch_item_count = item_count;
+        me->batch_index = 0;
+        me->batch_is_chain = is_chain;
+        optiga_cmd_batch_load_item(me);
+
+        optiga_cmd_execute(me,
+                           me->cmd_param,
+                           me->cmd_hdlrs,
+                           OPTIGA_CMD_EXEC_PREPARE_COMMAND,
+                           initial_state,
+                           me->p_input,
+                           me->apdu_data);
+
+        return_status = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_status);
+}
+
+optiga_lib_status_t optiga_cmd_execute_batch(optiga_cmd_t * me,
+                                             optiga_cmd_batch_item_t * p_items,
+                                             uint8_t item_count)
+{
+    OPTIGA_CMD_LOG_MESSAGE(__FUNCTION__);
+    return (optiga_cmd_batch_start(me, p_items, item_count, FALSE));
+}
+
+optiga_lib_status_t optiga_cmd_execute_chain(optiga_cmd_t * me,
+                                             optiga_cmd_batch_item_t * p_items,
+                                             uint8_t item_count)
+{
+    OPTIGA_CMD_LOG_MESSAGE(__FUNCTION__);
+    return (optiga_cmd_batch_start(me, p_items, item_count, TRUE));
+}
+
 /**
 * @}
 */
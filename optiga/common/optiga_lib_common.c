@@ -37,6 +37,18 @@
 
 #include "optiga/common/optiga_lib_types.h"
 #include "optiga/common/optiga_lib_common.h"
+#include "optiga/pal/pal_os_memory.h"
+
+#ifdef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+/// DER tag of INTEGER
+#define OPTIGA_COMMON_DER_TAG_INTEGER               (0x02)
+/// DER tag of SEQUENCE
+#define OPTIGA_COMMON_DER_TAG_SEQUENCE              (0x30)
+/// DER length with one subsequent length byte
+#define OPTIGA_COMMON_DER_LENGTH_ONE_BYTE           (0x81)
+/// Maximum DER length, which is encoded in the length byte itself
+#define OPTIGA_COMMON_DER_LENGTH_SHORT_FORM_MAX     (0x7F)
+#endif //OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
 
 void optiga_common_set_uint16 (uint8_t * p_output_buffer,uint16_t two_byte_value)
 {
@@ -67,6 +79,219 @@ void optiga_common_get_uint16 (const uint8_t * p_input_buffer,uint16_t* p_two_by
     *p_two_byte_value |= (uint16_t)(*(p_input_buffer+1));
 }
 
+#ifdef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+/*
+* Parses the DER INTEGER at the offset and returns the value without the leading zeros.
+* Returns FALSE, if the DER INTEGER is invalid.
+*/
+_STATIC_H bool_t optiga_common_der_integer_parse(const uint8_t * p_der,
+                                                 uint16_t der_length,
+                                                 uint16_t * p_offset,
+                                                 const uint8_t ** pp_value,
+                                                 uint16_t * p_value_length)
+{
+    bool_t is_valid = FALSE;
+    uint16_t length;
+
+    do
+    {
+        if (((*p_offset + 2U) > der_length) || (OPTIGA_COMMON_DER_TAG_INTEGER != p_der[*p_offset]))
+        {
+            break;
+        }
+        length = p_der[*p_offset + 1U];
+        *p_offset += 2U;
+        if ((0U == length) || (OPTIGA_COMMON_DER_LENGTH_SHORT_FORM_MAX < length) || ((*p_offset + length) > der_length))
+        {
+            break;
+        }
+        *pp_value = &p_der[*p_offset];
+        *p_offset += length;
+        while ((length > 1U) && (0x00 == **pp_value))
+        {
+            (*pp_value)++;
+            length--;
+        }
+        *p_value_length = length;
+        is_valid = TRUE;
+    } while (FALSE);
+    return (is_valid);
+}
+
+/*
+* Encodes the unsigned big endian value as DER INTEGER. Returns the length of the DER INTEGER.
+*/
+_STATIC_H uint16_t optiga_common_der_integer_encode(const uint8_t * p_value,
+                                                    uint16_t value_length,
+                                                    uint8_t * p_der)
+{
+    uint16_t index = 2;
+
+    while ((value_length > 1U) && (0x00 == *p_value))
+    {
+        p_value++;
+        value_length--;
+    }
+    p_der[0] = OPTIGA_COMMON_DER_TAG_INTEGER;
+    // Positive INTEGER needs a leading zero, if the most significant bit is set
+    if (0U != (*p_value & 0x80U))
+    {
+        p_der[index++] = 0x00;
+    }
+    pal_os_memcpy(&p_der[index], p_value, value_length);
+    index += value_length;
+    p_der[1] = (uint8_t)(index - 2U);
+    return (index);
+}
+
+optiga_lib_status_t optiga_common_ecdsa_signature_from_der(const uint8_t * p_der_integers,
+                                                           uint16_t der_integers_length,
+                                                           uint8_t signature_format,
+                                                           uint8_t * p_signature,
+                                                           uint16_t * p_signature_length)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+    const uint8_t * p_r;
+    const uint8_t * p_s;
+    uint16_t r_length;
+    uint16_t s_length;
+    uint16_t component_length;
+    uint16_t offset = 0;
+    uint16_t header_length;
+
+    do
+    {
+        if ((FALSE == optiga_common_der_integer_parse(p_der_integers, der_integers_length, &offset, &p_r, &r_length)) ||
+            (FALSE == optiga_common_der_integer_parse(p_der_integers, der_integers_length, &offset, &p_s, &s_length)) ||
+            (der_integers_length != offset))
+        {
+            break;
+        }
+
+        if ((uint8_t)OPTIGA_ECDSA_SIGNATURE_FORMAT_RAW == signature_format)
+        {
+            component_length = *p_signature_length / 2U;
+            if ((r_length > component_length) || (s_length > component_length))
+            {
+                return_status = OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT;
+                break;
+            }
+            pal_os_memset(p_signature, 0x00, (uint32_t)component_length * 2U);
+            pal_os_memcpy(&p_signature[component_length - r_length], p_r, r_length);
+            pal_os_memcpy(&p_signature[(component_length * 2U) - s_length], p_s, s_length);
+            *p_signature_length = component_length * 2U;
+            return_status = OPTIGA_LIB_SUCCESS;
+            break;
+        }
+
+        header_length = 0;
+        if ((uint8_t)OPTIGA_ECDSA_SIGNATURE_FORMAT_DER_SEQUENCE == signature_format)
+        {
+            header_length = (OPTIGA_COMMON_DER_LENGTH_SHORT_FORM_MAX < der_integers_length) ? 3U : 2U;
+        }
+        else if ((uint8_t)OPTIGA_ECDSA_SIGNATURE_FORMAT_DER_INTEGERS != signature_format)
+        {
+            break;
+        }
+        else
+        {
+            // DER INTEGERs are returned as they are
+        }
+        if (*p_signature_length < (header_length + der_integers_length))
+        {
+            return_status = OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT;
+            break;
+        }
+        if (0U != header_length)
+        {
+            p_signature[0] = OPTIGA_COMMON_DER_TAG_SEQUENCE;
+            if (3U == header_length)
+            {
+                p_signature[1] = OPTIGA_COMMON_DER_LENGTH_ONE_BYTE;
+            }
+            p_signature[header_length - 1U] = (uint8_t)der_integers_length;
+        }
+        pal_os_memcpy(&p_signature[header_length], p_der_integers, der_integers_length);
+        *p_signature_length = header_length + der_integers_length;
+        return_status = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_status);
+}
+
+optiga_lib_status_t optiga_common_ecdsa_signature_to_der(const uint8_t * p_signature,
+                                                         uint16_t signature_length,
+                                                         uint8_t signature_format,
+                                                         uint8_t * p_der_integers,
+                                                         uint16_t * p_der_integers_length)
+{
+    optiga_lib_status_t return_status = OPTIGA_CMD_ERROR_INVALID_INPUT;
+    uint16_t component_length;
+    uint16_t header_length = 2;
+    uint16_t index;
+
+    do
+    {
+        if ((uint8_t)OPTIGA_ECDSA_SIGNATURE_FORMAT_RAW == signature_format)
+        {
+            component_length = signature_length / 2U;
+            if ((0U == component_length) || (0U != (signature_length % 2U)) ||
+                (OPTIGA_COMMON_DER_LENGTH_SHORT_FORM_MAX <= component_length))
+            {
+                break;
+            }
+            if (*p_der_integers_length < (signature_length + OPTIGA_ECDSA_SIGNATURE_DER_OVERHEAD))
+            {
+                return_status = OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT;
+                break;
+            }
+            index = optiga_common_der_integer_encode(p_signature, component_length, p_der_integers);
+            index += optiga_common_der_integer_encode(&p_signature[component_length],
+                                                      component_length,
+                                                      &p_der_integers[index]);
+            *p_der_integers_length = index;
+            return_status = OPTIGA_LIB_SUCCESS;
+            break;
+        }
+
+        if ((uint8_t)OPTIGA_ECDSA_SIGNATURE_FORMAT_DER_SEQUENCE == signature_format)
+        {
+            if ((signature_length < 2U) || (OPTIGA_COMMON_DER_TAG_SEQUENCE != p_signature[0]))
+            {
+                break;
+            }
+            if (OPTIGA_COMMON_DER_LENGTH_ONE_BYTE == p_signature[1])
+            {
+                header_length = 3;
+            }
+            if ((signature_length < header_length) ||
+                ((signature_length - header_length) != p_signature[header_length - 1U]))
+            {
+                break;
+            }
+            p_signature += header_length;
+            signature_length -= header_length;
+        }
+        else if ((uint8_t)OPTIGA_ECDSA_SIGNATURE_FORMAT_DER_INTEGERS != signature_format)
+        {
+            break;
+        }
+        else
+        {
+            // DER INTEGERs are passed as they are
+        }
+        if (*p_der_integers_length < signature_length)
+        {
+            return_status = OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT;
+            break;
+        }
+        pal_os_memcpy(p_der_integers, p_signature, signature_length);
+        *p_der_integers_length = signature_length;
+        return_status = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_status);
+}
+#endif //OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+
 /**
 * @}
 */
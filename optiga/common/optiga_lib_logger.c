@@ -37,8 +37,14 @@
 
 #include "optiga/common/optiga_lib_common.h"
 #include "optiga/common/optiga_lib_logger.h"
+#include "optiga/common/optiga_lib_profile.h"
 #include "optiga/pal/pal_logger.h"
 #include "optiga/pal/pal_os_memory.h"
+#ifdef OPTIGA_LIB_LOGGER_DEFERRED_ENABLED
+#include "optiga/pal/pal_os_lock.h"
+#include "optiga/pal/pal_os_timer.h"
+#include <stdarg.h>
+#endif
 
 
 #define OPTIGA_LOGGER_NEW_LINE_CHAR          0x0D, 0x0A
@@ -154,18 +160,14 @@ void optiga_lib_print_string_with_newline(const char_t * p_log_string)
 
 }
 
-void optiga_lib_print_message(const char_t * p_log_string,
-                              const char_t * p_log_layer,
-                              const char_t * p_log_color)                                  
+/* Formats a message with the layer information */
+_STATIC_H void optiga_lib_format_message(const char_t * p_log_string,
+                                         const char_t * p_log_layer,
+                                         const char_t * p_log_color)
 {
     uint8_t new_line_characters[2] = {OPTIGA_LOGGER_NEW_LINE_CHAR};
     char_t color_buffer[400];
 
-    if ((NULL == p_log_string) || (NULL == p_log_layer) || (NULL == p_log_color))
-    {
-        return;
-    }
-
     OPTIGA_LIB_LOGGER_PRINT_INFO(color_buffer, p_log_string, p_log_layer, p_log_color);
     //lint --e{534} The return value is not used hence not checked*/
     pal_logger_write(&logger_console, (const uint8_t *)color_buffer, strlen(color_buffer));
@@ -173,9 +175,10 @@ void optiga_lib_print_message(const char_t * p_log_string,
     pal_logger_write(&logger_console, new_line_characters, 2);
 }
 
-void optiga_lib_print_status(const char_t * p_log_layer,
-                             const char_t * p_log_color,
-                             uint16_t return_value)
+/* Formats a return value with the layer information */
+_STATIC_H void optiga_lib_format_status(const char_t * p_log_layer,
+                                        const char_t * p_log_color,
+                                        uint16_t return_value)
 {
     uint8_t new_line_characters[2] = {OPTIGA_LOGGER_NEW_LINE_CHAR};
     uint8_t uint16t_conv_buffer[10] = {0};
@@ -183,11 +186,6 @@ void optiga_lib_print_status(const char_t * p_log_layer,
     char_t string_buffer[100] = {0};
     char_t color_buffer[400];
 
-    if ((NULL == p_log_layer) || (NULL == p_log_color))
-    {
-        return;
-    }
-
     // if return value is successful, log SUCCESS
     if (OPTIGA_LIB_SUCCESS == return_value)
     {
@@ -213,9 +211,10 @@ void optiga_lib_print_status(const char_t * p_log_layer,
     pal_logger_write(&logger_console, new_line_characters, 2);
 }
 
-void optiga_lib_print_array_hex_format(const uint8_t * p_log_string,
-                                       uint16_t length,
-                                       const char_t * p_log_color)
+/* Formats a byte array in hex format */
+_STATIC_H void optiga_lib_format_array_hex(const uint8_t * p_log_string,
+                                           uint16_t length,
+                                           const char_t * p_log_color)
 {
     uint8_t temp_buffer[350];
     char_t output_buffer[400];
@@ -224,11 +223,6 @@ void optiga_lib_print_array_hex_format(const uint8_t * p_log_string,
     char_t new_line_characters[2] = {OPTIGA_LOGGER_NEW_LINE_CHAR};
     uint8_t buffer_window = 32; // Alignment of 16 bytes per line
 
-    if ((NULL == p_log_string) || (NULL == p_log_color))
-    {
-        return;
-    }
-    
     optiga_lib_print_length_of_data(length);
     
     //Logging the arrays in chunks of 16 bytes through chaining
@@ -255,6 +249,395 @@ void optiga_lib_print_array_hex_format(const uint8_t * p_log_string,
     }
 }
 
+#ifdef OPTIGA_LIB_LOGGER_DEFERRED_ENABLED
+
+#if (0 != (OPTIGA_LIB_LOGGER_DEFERRED_BUFFER_SIZE & (OPTIGA_LIB_LOGGER_DEFERRED_BUFFER_SIZE - 1)))
+#error "OPTIGA_LIB_LOGGER_DEFERRED_BUFFER_SIZE must be a power of 2"
+#endif
+
+// Size of the address of the format string in a format record
+#define OPTIGA_LOGGER_FORMAT_ADDRESS_SIZE    (8U)
+// Size of an argument in a format record
+#define OPTIGA_LOGGER_FORMAT_ARG_SIZE        (4U)
+
+_STATIC_H uint8_t optiga_lib_logger_buffer[OPTIGA_LIB_LOGGER_DEFERRED_BUFFER_SIZE];
+// Positions of the ring buffer, the difference is the number of bytes recorded and not yet read
+_STATIC_H volatile uint32_t optiga_lib_logger_write_position = 0;
+_STATIC_H volatile uint32_t optiga_lib_logger_read_position = 0;
+_STATIC_H uint32_t optiga_lib_logger_dropped_count = 0;
+
+/* Copies the data to the ring buffer at the position, wrapping at the end of the buffer */
+_STATIC_H void optiga_lib_logger_put(uint32_t position, const uint8_t * p_data, uint16_t length)
+{
+    uint32_t offset = position & (OPTIGA_LIB_LOGGER_DEFERRED_BUFFER_SIZE - 1);
+    uint32_t first_length = OPTIGA_LIB_LOGGER_DEFERRED_BUFFER_SIZE - offset;
+
+    if (first_length > length)
+    {
+        first_length = length;
+    }
+    pal_os_memcpy(&optiga_lib_logger_buffer[offset], p_data, first_length);
+    pal_os_memcpy(optiga_lib_logger_buffer, p_data + first_length, length - first_length);
+}
+
+/* Copies the data from the ring buffer at the position, wrapping at the end of the buffer */
+_STATIC_H void optiga_lib_logger_get(uint32_t position, uint8_t * p_data, uint16_t length)
+{
+    uint32_t offset = position & (OPTIGA_LIB_LOGGER_DEFERRED_BUFFER_SIZE - 1);
+    uint32_t first_length = OPTIGA_LIB_LOGGER_DEFERRED_BUFFER_SIZE - offset;
+
+    if (first_length > length)
+    {
+        first_length = length;
+    }
+    pal_os_memcpy(p_data, &optiga_lib_logger_buffer[offset], first_length);
+    pal_os_memcpy(p_data + first_length, optiga_lib_logger_buffer, length - first_length);
+}
+
+/*
+* Records the payload given in two parts, which are truncated to OPTIGA_LIB_LOGGER_DEFERRED_MAX_DATA.
+* The record is dropped, if the ring buffer has no space for it.
+*/
+_STATIC_H void optiga_lib_logger_record(uint8_t type,
+                                        uint8_t flags,
+                                        uint16_t value,
+                                        const uint8_t * p_first,
+                                        uint16_t first_length,
+                                        const uint8_t * p_second,
+                                        uint16_t second_length)
+{
+    uint8_t header[OPTIGA_LIB_LOGGER_RECORD_HEADER_SIZE];
+    uint32_t time_us = pal_os_timer_get_time_in_microseconds();
+    uint32_t write_position;
+    uint16_t payload_length;
+
+    if (first_length > OPTIGA_LIB_LOGGER_DEFERRED_MAX_DATA)
+    {
+        first_length = OPTIGA_LIB_LOGGER_DEFERRED_MAX_DATA;
+        flags |= OPTIGA_LIB_LOGGER_FLAG_TRUNCATED;
+    }
+    if (second_length > (OPTIGA_LIB_LOGGER_DEFERRED_MAX_DATA - first_length))
+    {
+        second_length = OPTIGA_LIB_LOGGER_DEFERRED_MAX_DATA - first_length;
+        flags |= OPTIGA_LIB_LOGGER_FLAG_TRUNCATED;
+    }
+    payload_length = first_length + second_length;
+
+    header[0] = type;
+    header[1] = flags;
+    header[2] = (uint8_t)payload_length;
+    header[3] = (uint8_t)(payload_length >> 8);
+    header[4] = (uint8_t)value;
+    header[5] = (uint8_t)(value >> 8);
+    header[6] = (uint8_t)time_us;
+    header[7] = (uint8_t)(time_us >> 8);
+    header[8] = (uint8_t)(time_us >> 16);
+    header[9] = (uint8_t)(time_us >> 24);
+
+    pal_os_lock_enter_critical_section();
+    write_position = optiga_lib_logger_write_position;
+    if ((OPTIGA_LIB_LOGGER_DEFERRED_BUFFER_SIZE - (write_position - optiga_lib_logger_read_position)) <
+        (uint32_t)(OPTIGA_LIB_LOGGER_RECORD_HEADER_SIZE + payload_length))
+    {
+        optiga_lib_logger_dropped_count++;
+    }
+    else
+    {
+        optiga_lib_logger_put(write_position, header, OPTIGA_LIB_LOGGER_RECORD_HEADER_SIZE);
+        write_position += OPTIGA_LIB_LOGGER_RECORD_HEADER_SIZE;
+        optiga_lib_logger_put(write_position, p_first, first_length);
+        write_position += first_length;
+        optiga_lib_logger_put(write_position, p_second, second_length);
+        optiga_lib_logger_write_position = write_position + second_length;
+    }
+    pal_os_lock_exit_critical_section();
+}
+
+void optiga_lib_logger_record_format(uint8_t arg_count, const char_t * p_format, ...)
+{
+    uint8_t payload[OPTIGA_LOGGER_FORMAT_ADDRESS_SIZE + (OPTIGA_LIB_LOGGER_MAX_FORMAT_ARGS *
+                                                        OPTIGA_LOGGER_FORMAT_ARG_SIZE)];
+    uint64_t address = (uint64_t)(uintptr_t)p_format;
+    uint32_t argument;
+    uint8_t index;
+    uint8_t byte_index;
+    va_list args;
+
+    if (arg_count > OPTIGA_LIB_LOGGER_MAX_FORMAT_ARGS)
+    {
+        arg_count = OPTIGA_LIB_LOGGER_MAX_FORMAT_ARGS;
+    }
+    for (byte_index = 0; byte_index < OPTIGA_LOGGER_FORMAT_ADDRESS_SIZE; byte_index++)
+    {
+        payload[byte_index] = (uint8_t)(address >> (8 * byte_index));
+    }
+    va_start(args, p_format);
+    for (index = 0; index < arg_count; index++)
+    {
+        // The integer arguments are promoted to int
+        argument = (uint32_t)va_arg(args, int);
+        for (byte_index = 0; byte_index < OPTIGA_LOGGER_FORMAT_ARG_SIZE; byte_index++)
+        {
+            payload[OPTIGA_LOGGER_FORMAT_ADDRESS_SIZE + (index * OPTIGA_LOGGER_FORMAT_ARG_SIZE) + byte_index] =
+                                                                            (uint8_t)(argument >> (8 * byte_index));
+        }
+    }
+    va_end(args);
+
+    optiga_lib_logger_record(OPTIGA_LIB_LOGGER_RECORD_FORMAT,
+                             0,
+                             arg_count,
+                             payload,
+                             (uint16_t)(OPTIGA_LOGGER_FORMAT_ADDRESS_SIZE + (arg_count * OPTIGA_LOGGER_FORMAT_ARG_SIZE)),
+                             NULL,
+                             0);
+}
+
+uint16_t optiga_lib_logger_read(uint8_t * p_buffer, uint16_t max_length)
+{
+    uint8_t header[OPTIGA_LIB_LOGGER_RECORD_HEADER_SIZE];
+    uint16_t record_length;
+    uint16_t copied = 0;
+    bool_t is_pending = TRUE;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == p_buffer)
+        {
+            break;
+        }
+#endif
+        // Each record is taken in a critical section, since the recording contexts may be interrupts
+        while (TRUE == is_pending)
+        {
+            is_pending = FALSE;
+            pal_os_lock_enter_critical_section();
+            if ((optiga_lib_logger_write_position - optiga_lib_logger_read_position) >=
+                OPTIGA_LIB_LOGGER_RECORD_HEADER_SIZE)
+            {
+                optiga_lib_logger_get(optiga_lib_logger_read_position, header, OPTIGA_LIB_LOGGER_RECORD_HEADER_SIZE);
+                record_length = OPTIGA_LIB_LOGGER_RECORD_HEADER_SIZE + (uint16_t)(header[2] | (header[3] << 8));
+                if ((max_length - copied) >= record_length)
+                {
+                    optiga_lib_logger_get(optiga_lib_logger_read_position, p_buffer + copied, record_length);
+                    optiga_lib_logger_read_position += record_length;
+                    copied += record_length;
+                    is_pending = TRUE;
+                }
+            }
+            pal_os_lock_exit_critical_section();
+        }
+    } while (FALSE);
+
+    return (copied);
+}
+
+void optiga_lib_logger_decode(const uint8_t * p_records, uint16_t length)
+{
+    // Layer and message of a record, each terminated
+    char_t strings[OPTIGA_LIB_LOGGER_DEFERRED_MAX_DATA + 2];
+    char_t format_buffer[200];
+    const uint8_t * p_record;
+    const uint8_t * p_payload;
+    uint32_t arguments[OPTIGA_LIB_LOGGER_MAX_FORMAT_ARGS] = {0};
+    uint64_t address;
+    uint16_t offset = 0;
+    uint16_t payload_length;
+    uint16_t value;
+    uint8_t index;
+    uint8_t byte_index;
+
+    while ((NULL != p_records) && ((offset + OPTIGA_LIB_LOGGER_RECORD_HEADER_SIZE) <= length))
+    {
+        p_record = p_records + offset;
+        p_payload = p_record + OPTIGA_LIB_LOGGER_RECORD_HEADER_SIZE;
+        payload_length = (uint16_t)(p_record[2] | (p_record[3] << 8));
+        value = (uint16_t)(p_record[4] | (p_record[5] << 8));
+        if (((uint32_t)offset + OPTIGA_LIB_LOGGER_RECORD_HEADER_SIZE + payload_length) > length)
+        {
+            break;
+        }
+        offset += OPTIGA_LIB_LOGGER_RECORD_HEADER_SIZE + payload_length;
+
+        switch (p_record[0])
+        {
+            case OPTIGA_LIB_LOGGER_RECORD_MESSAGE:
+            {
+                if ((value > payload_length) || (payload_length > OPTIGA_LIB_LOGGER_DEFERRED_MAX_DATA))
+                {
+                    break;
+                }
+                pal_os_memcpy(strings, p_payload, value);
+                strings[value] = 0x00;
+                pal_os_memcpy(&strings[value + 1], p_payload + value, payload_length - value);
+                strings[payload_length + 1] = 0x00;
+                optiga_lib_format_message(&strings[value + 1], strings, OPTIGA_LIB_LOGGER_COLOR_DEFAULT);
+                break;
+            }
+            case OPTIGA_LIB_LOGGER_RECORD_STATUS:
+            {
+                if (payload_length > OPTIGA_LIB_LOGGER_DEFERRED_MAX_DATA)
+                {
+                    break;
+                }
+                pal_os_memcpy(strings, p_payload, payload_length);
+                strings[payload_length] = 0x00;
+                optiga_lib_format_status(strings,
+                                         (OPTIGA_LIB_SUCCESS == value) ? OPTIGA_LIB_LOGGER_COLOR_DEFAULT :
+                                                                         OPTIGA_ERROR_COLOR,
+                                         value);
+                break;
+            }
+            case OPTIGA_LIB_LOGGER_RECORD_ARRAY:
+            {
+                optiga_lib_format_array_hex(p_payload,
+                                            payload_length,
+                                            (0 != (p_record[1] & OPTIGA_LIB_LOGGER_FLAG_PROTECTED)) ?
+                                            OPTIGA_PROTECTED_DATA_COLOR : OPTIGA_UNPROTECTED_DATA_COLOR);
+                break;
+            }
+            case OPTIGA_LIB_LOGGER_RECORD_FORMAT:
+            {
+                if ((value > OPTIGA_LIB_LOGGER_MAX_FORMAT_ARGS) ||
+                    (payload_length != (OPTIGA_LOGGER_FORMAT_ADDRESS_SIZE + (value * OPTIGA_LOGGER_FORMAT_ARG_SIZE))))
+                {
+                    break;
+                }
+                address = 0;
+                for (byte_index = 0; byte_index < OPTIGA_LOGGER_FORMAT_ADDRESS_SIZE; byte_index++)
+                {
+                    address |= ((uint64_t)p_payload[byte_index]) << (8 * byte_index);
+                }
+                for (index = 0; index < value; index++)
+                {
+                    arguments[index] = 0;
+                    for (byte_index = 0; byte_index < OPTIGA_LOGGER_FORMAT_ARG_SIZE; byte_index++)
+                    {
+                        arguments[index] |= ((uint32_t)p_payload[OPTIGA_LOGGER_FORMAT_ADDRESS_SIZE +
+                                            (index * OPTIGA_LOGGER_FORMAT_ARG_SIZE) + byte_index]) << (8 * byte_index);
+                    }
+                }
+                // The format string is a literal of this image, the unused arguments are ignored
+                //lint --e{592} suppress "The format string is recorded by the log site"
+                snprintf(format_buffer, sizeof(format_buffer), (const char_t *)(uintptr_t)address,
+                         arguments[0], arguments[1], arguments[2], arguments[3]);
+                optiga_lib_print_string(format_buffer);
+                break;
+            }
+            default:
+            {
+                // Unknown records are skipped
+                break;
+            }
+        }
+    }
+}
+
+void optiga_lib_logger_flush(void)
+{
+    uint8_t records[OPTIGA_LIB_LOGGER_RECORD_HEADER_SIZE + OPTIGA_LIB_LOGGER_DEFERRED_MAX_DATA];
+    uint16_t length;
+
+    do
+    {
+        length = optiga_lib_logger_read(records, sizeof(records));
+        optiga_lib_logger_decode(records, length);
+    } while (0 != length);
+}
+
+uint32_t optiga_lib_logger_get_dropped_count(void)
+{
+    return (optiga_lib_logger_dropped_count);
+}
+
+#endif //OPTIGA_LIB_LOGGER_DEFERRED_ENABLED
+
+void optiga_lib_print_message(const char_t * p_log_string,
+                              const char_t * p_log_layer,
+                              const char_t * p_log_color)
+{
+#ifdef OPTIGA_LIB_LOGGER_DEFERRED_ENABLED
+    uint16_t layer_length;
+#endif
+    OPTIGA_LIB_PROFILE_DECLARE(profile_start)
+
+    if ((NULL == p_log_string) || (NULL == p_log_layer) || (NULL == p_log_color))
+    {
+        return;
+    }
+
+    OPTIGA_LIB_PROFILE_BEGIN(profile_start);
+#ifdef OPTIGA_LIB_LOGGER_DEFERRED_ENABLED
+    // The color of the layers is the default color, hence it is not recorded
+    layer_length = (uint16_t)strlen(p_log_layer);
+    if (layer_length > OPTIGA_LIB_LOGGER_DEFERRED_MAX_DATA)
+    {
+        layer_length = OPTIGA_LIB_LOGGER_DEFERRED_MAX_DATA;
+    }
+    optiga_lib_logger_record(OPTIGA_LIB_LOGGER_RECORD_MESSAGE,
+                             0,
+                             layer_length,
+                             (const uint8_t *)p_log_layer,
+                             layer_length,
+                             (const uint8_t *)p_log_string,
+                             (uint16_t)strlen(p_log_string));
+#else
+    optiga_lib_format_message(p_log_string, p_log_layer, p_log_color);
+#endif
+    OPTIGA_LIB_PROFILE_END(OPTIGA_LIB_PROFILE_LOGGER, profile_start, strlen(p_log_string));
+}
+
+void optiga_lib_print_status(const char_t * p_log_layer,
+                             const char_t * p_log_color,
+                             uint16_t return_value)
+{
+    if ((NULL == p_log_layer) || (NULL == p_log_color))
+    {
+        return;
+    }
+
+#ifdef OPTIGA_LIB_LOGGER_DEFERRED_ENABLED
+    // The color is derived from the return value, when the record is formatted
+    optiga_lib_logger_record(OPTIGA_LIB_LOGGER_RECORD_STATUS,
+                             0,
+                             return_value,
+                             (const uint8_t *)p_log_layer,
+                             (uint16_t)strlen(p_log_layer),
+                             NULL,
+                             0);
+#else
+    optiga_lib_format_status(p_log_layer, p_log_color, return_value);
+#endif
+}
+
+void optiga_lib_print_array_hex_format(const uint8_t * p_log_string,
+                                       uint16_t length,
+                                       const char_t * p_log_color)
+{
+    OPTIGA_LIB_PROFILE_DECLARE(profile_start)
+
+    if ((NULL == p_log_string) || (NULL == p_log_color))
+    {
+        return;
+    }
+
+    OPTIGA_LIB_PROFILE_BEGIN(profile_start);
+#ifdef OPTIGA_LIB_LOGGER_DEFERRED_ENABLED
+    optiga_lib_logger_record(OPTIGA_LIB_LOGGER_RECORD_ARRAY,
+                             (0 == strcmp(p_log_color, OPTIGA_PROTECTED_DATA_COLOR)) ?
+                             OPTIGA_LIB_LOGGER_FLAG_PROTECTED : 0,
+                             length,
+                             p_log_string,
+                             length,
+                             NULL,
+                             0);
+#else
+    optiga_lib_format_array_hex(p_log_string, length, p_log_color);
+#endif
+    OPTIGA_LIB_PROFILE_END(OPTIGA_LIB_PROFILE_LOGGER, profile_start, length);
+}
+
 /**
 * @}
 */
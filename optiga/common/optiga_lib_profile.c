@@ -0,0 +1,94 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_lib_profile.c
+*
+* \brief   This file implements the accumulation of the host CPU cost of the profiling points.
+*
+* \ingroup  grOptigaLibCommon
+*
+* @{
+*/
+
+#include "optiga/common/optiga_lib_profile.h"
+#include "optiga/pal/pal_os_lock.h"
+#include "optiga/pal/pal_os_memory.h"
+
+#ifdef OPTIGA_LIB_PROFILE_ENABLED
+
+_STATIC_H optiga_lib_profile_stats_t optiga_lib_profile_stats[OPTIGA_LIB_PROFILE_POINT_COUNT];
+
+void optiga_lib_profile_record(uint8_t point, uint32_t start_cycles, uint32_t bytes)
+{
+    // The cycles are taken before the critical section, hence the accumulation is not part of the cost
+    uint32_t cycles = pal_os_timer_get_cycle_count() - start_cycles;
+    optiga_lib_profile_stats_t * p_stats;
+
+    if (OPTIGA_LIB_PROFILE_POINT_COUNT > point)
+    {
+        p_stats = &optiga_lib_profile_stats[point];
+        pal_os_lock_enter_critical_section();
+        if ((0 == p_stats->calls) || (cycles < p_stats->min_cycles))
+        {
+            p_stats->min_cycles = cycles;
+        }
+        if (cycles > p_stats->max_cycles)
+        {
+            p_stats->max_cycles = cycles;
+        }
+        p_stats->calls++;
+        p_stats->bytes += bytes;
+        p_stats->cycles += cycles;
+        pal_os_lock_exit_critical_section();
+    }
+}
+
+void optiga_lib_profile_get(optiga_lib_profile_stats_t * p_stats)
+{
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+    if (NULL != p_stats)
+#endif
+    {
+        pal_os_lock_enter_critical_section();
+        pal_os_memcpy(p_stats, optiga_lib_profile_stats, sizeof(optiga_lib_profile_stats));
+        pal_os_lock_exit_critical_section();
+    }
+}
+
+void optiga_lib_profile_reset(void)
+{
+    pal_os_lock_enter_critical_section();
+    pal_os_memset(optiga_lib_profile_stats, 0x00, sizeof(optiga_lib_profile_stats));
+    pal_os_lock_exit_critical_section();
+}
+
+#endif //OPTIGA_LIB_PROFILE_ENABLED
+
+/**
+* @}
+*/
@@ -0,0 +1,200 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_lib_trace.c
+*
+* \brief   This file implements the ring buffer and the callback of the latency tracing.
+*
+* \ingroup  grOptigaLibCommon
+*
+* @{
+*/
+
+#include "optiga/common/optiga_lib_trace.h"
+#include "optiga/pal/pal_os_timer.h"
+#include "optiga/pal/pal_os_lock.h"
+#include "optiga/pal/pal_os_memory.h"
+
+#ifdef OPTIGA_LIB_TRACE_ENABLED
+
+#if (0 != (OPTIGA_LIB_TRACE_BUFFER_SIZE & (OPTIGA_LIB_TRACE_BUFFER_SIZE - 1)))
+#error "OPTIGA_LIB_TRACE_BUFFER_SIZE must be a power of 2"
+#endif
+
+/** \brief Slot of the ring buffer */
+typedef struct optiga_lib_trace_slot
+{
+    /// Recorded event
+    optiga_lib_trace_event_t event;
+    /// Position of the event plus one, once the event is completely written, 0 while it is written
+    volatile uint32_t sequence;
+}optiga_lib_trace_slot_t;
+
+_STATIC_H optiga_lib_trace_slot_t optiga_lib_trace_buffer[OPTIGA_LIB_TRACE_BUFFER_SIZE];
+// Position of the next event to be recorded, reserved by the recording contexts
+_STATIC_H volatile uint32_t optiga_lib_trace_write_position = 0;
+// Position of the next event to be read, owned by the reading context
+_STATIC_H uint32_t optiga_lib_trace_read_position = 0;
+_STATIC_H uint32_t optiga_lib_trace_dropped_count = 0;
+_STATIC_H optiga_lib_trace_callback_t optiga_lib_trace_callback = NULL;
+_STATIC_H void * optiga_lib_trace_callback_ctx = NULL;
+
+/*
+* Atomic operations of the ring buffer. Without compiler support, the critical section provides the atomicity.
+*/
+_STATIC_H uint32_t optiga_lib_trace_reserve_position(void)
+{
+#if defined (__GNUC__)
+    return (__atomic_fetch_add(&optiga_lib_trace_write_position, 1, __ATOMIC_SEQ_CST));
+#else
+    uint32_t position;
+
+    pal_os_lock_enter_critical_section();
+    position = optiga_lib_trace_write_position++;
+    pal_os_lock_exit_critical_section();
+    return (position);
+#endif
+}
+
+_STATIC_H uint32_t optiga_lib_trace_load(volatile const uint32_t * p_source)
+{
+#if defined (__GNUC__)
+    return (__atomic_load_n(p_source, __ATOMIC_ACQUIRE));
+#else
+    return (*p_source);
+#endif
+}
+
+_STATIC_H void optiga_lib_trace_store(volatile uint32_t * p_target, uint32_t value)
+{
+#if defined (__GNUC__)
+    __atomic_store_n(p_target, value, __ATOMIC_RELEASE);
+#else
+    *p_target = value;
+#endif
+}
+
+void optiga_lib_trace_set_callback(optiga_lib_trace_callback_t callback, void * p_ctx)
+{
+    optiga_lib_trace_callback = NULL;
+    optiga_lib_trace_callback_ctx = p_ctx;
+    optiga_lib_trace_callback = callback;
+}
+
+void optiga_lib_trace_record(uint8_t layer, uint8_t type, uint16_t code)
+{
+    optiga_lib_trace_slot_t * p_slot;
+    optiga_lib_trace_callback_t callback = optiga_lib_trace_callback;
+    uint32_t position;
+
+    position = optiga_lib_trace_reserve_position();
+    p_slot = &optiga_lib_trace_buffer[position & (OPTIGA_LIB_TRACE_BUFFER_SIZE - 1)];
+
+    // The slot is marked as being written, hence a reader does not take a partly overwritten event
+    optiga_lib_trace_store(&p_slot->sequence, 0);
+    p_slot->event.time_us = pal_os_timer_get_time_in_microseconds();
+    p_slot->event.code = code;
+    p_slot->event.layer = layer;
+    p_slot->event.type = type;
+    optiga_lib_trace_store(&p_slot->sequence, position + 1);
+
+    if (NULL != callback)
+    {
+        callback(optiga_lib_trace_callback_ctx, &p_slot->event);
+    }
+}
+
+uint16_t optiga_lib_trace_read(optiga_lib_trace_event_t * p_events, uint16_t max_count)
+{
+    const optiga_lib_trace_slot_t * p_slot;
+    uint32_t write_position;
+    uint32_t sequence;
+    uint16_t count = 0;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == p_events)
+        {
+            break;
+        }
+#endif
+        while (count < max_count)
+        {
+            write_position = optiga_lib_trace_load(&optiga_lib_trace_write_position);
+            if (write_position == optiga_lib_trace_read_position)
+            {
+                break;
+            }
+            if ((write_position - optiga_lib_trace_read_position) > OPTIGA_LIB_TRACE_BUFFER_SIZE)
+            {
+                // The unread events are overwritten by the newer ones
+                optiga_lib_trace_dropped_count += ((write_position - optiga_lib_trace_read_position) -
+                                                   OPTIGA_LIB_TRACE_BUFFER_SIZE);
+                optiga_lib_trace_read_position = write_position - OPTIGA_LIB_TRACE_BUFFER_SIZE;
+            }
+            p_slot = &optiga_lib_trace_buffer[optiga_lib_trace_read_position & (OPTIGA_LIB_TRACE_BUFFER_SIZE - 1)];
+            sequence = optiga_lib_trace_load(&p_slot->sequence);
+            if ((optiga_lib_trace_read_position + 1) != sequence)
+            {
+                if ((0 == sequence) || (0 > (int32_t)(sequence - (optiga_lib_trace_read_position + 1))))
+                {
+                    // The event is still being written, the slot holds no or the previous event
+                    break;
+                }
+                // The slot is reused by a newer event, so the read position is updated on the next iteration
+                optiga_lib_trace_dropped_count++;
+                optiga_lib_trace_read_position++;
+                continue;
+            }
+            pal_os_memcpy(&p_events[count], &p_slot->event, sizeof(optiga_lib_trace_event_t));
+            // The event is valid, if the slot is not overwritten during the copy
+            if (sequence != optiga_lib_trace_load(&p_slot->sequence))
+            {
+                optiga_lib_trace_dropped_count++;
+                optiga_lib_trace_read_position++;
+                continue;
+            }
+            optiga_lib_trace_read_position++;
+            count++;
+        }
+    } while (FALSE);
+
+    return (count);
+}
+
+uint32_t optiga_lib_trace_get_dropped_count(void)
+{
+    return (optiga_lib_trace_dropped_count);
+}
+
+#endif //OPTIGA_LIB_TRACE_ENABLED
+
+/**
+* @}
+*/
@@ -37,6 +37,12 @@
 
 #include "optiga/ifx_i2c/ifx_i2c.h"
 #include "optiga/pal/pal_os_event.h"
+#if defined (OPTIGA_COMMS_WARM_REATTACH_ENABLED) || defined (OPTIGA_COMMS_SHARED_LINK_ENABLED)
+#include "optiga/pal/pal_os_memory.h"
+#endif
+#ifdef OPTIGA_COMMS_SHARED_LINK_ENABLED
+#include "optiga/pal/pal_os_lock.h"
+#endif
 
 #ifndef OPTIGA_COMMS_SHIELDED_CONNECTION
 #include "optiga/ifx_i2c/ifx_i2c_transport_layer.h"
@@ -57,6 +63,15 @@
 #define IFX_I2C_STATE_RESET_PIN_HIGH       (0xB2)
 #define IFX_I2C_STATE_RESET_INIT           (0xB3)
 
+#ifdef OPTIGA_COMMS_BUS_ENUMERATION_ENABLED
+/// Size of the bus map (first instance id, device count and first slave address)
+#define IFX_I2C_BUS_MAP_SIZE               (0x03)
+/// Persistent mode of the slave address write
+#define IFX_I2C_SLAVE_ADDRESS_PERSISTENT   (0x80)
+/// Highest 7 bit slave address
+#define IFX_I2C_SLAVE_ADDRESS_MAX          (0x7F)
+#endif
+
 void ifx_i2c_tl_event_handler(ifx_i2c_context_t * p_ctx,
                               optiga_lib_status_t event,
                               const uint8_t * p_data,
@@ -69,6 +84,22 @@ _STATIC_H void ifx_i2c_prl_close_event_handler(ifx_i2c_context_t * p_ctx,
                                                uint16_t data_len);
 #endif
 _STATIC_H optiga_lib_status_t ifx_i2c_init(ifx_i2c_context_t * p_ifx_i2c_context);
+_STATIC_H void ifx_i2c_power_off(ifx_i2c_context_t * p_ctx);
+#ifdef OPTIGA_COMMS_WARM_REATTACH_ENABLED
+_STATIC_H void ifx_i2c_link_state_save(ifx_i2c_context_t * p_ctx);
+_STATIC_H void ifx_i2c_link_state_restore(ifx_i2c_context_t * p_ctx);
+#endif
+#if defined (OPTIGA_COMMS_WARM_REATTACH_ENABLED) || defined (OPTIGA_COMMS_SHARED_LINK_ENABLED)
+_STATIC_H void ifx_i2c_link_state_capture(const ifx_i2c_context_t * p_ctx, ifx_i2c_link_state_t * p_link_state);
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+_STATIC_H void ifx_i2c_link_state_restore_session(ifx_i2c_context_t * p_ctx, const ifx_i2c_link_state_t * p_link_state);
+#endif
+#endif
+#ifdef OPTIGA_COMMS_SHARED_LINK_ENABLED
+_STATIC_H optiga_lib_status_t ifx_i2c_shared_link_acquire(ifx_i2c_context_t * p_ctx, uint8_t continue_link_state);
+_STATIC_H void ifx_i2c_shared_link_release(ifx_i2c_context_t * p_ctx);
+_STATIC_H void ifx_i2c_shared_link_complete(ifx_i2c_context_t * p_ctx, optiga_lib_status_t event);
+#endif
 
 //lint --e{526} suppress "This API is defined in ifx_i2c_physical_layer.c file. As it is a low level API, it is not exposed in header file"
 extern optiga_lib_status_t ifx_i2c_pl_write_slave_address(ifx_i2c_context_t * p_ctx,
@@ -87,19 +118,32 @@ optiga_lib_status_t ifx_i2c_open(ifx_i2c_context_t * p_ctx)
         {
             p_ctx->p_pal_i2c_ctx->p_upper_layer_ctx = p_ctx;
             p_ctx->reset_type = OPTIGA_COMMS_DEFAULT_RESET_TYPE;
-            if(p_ctx->reset_type > (uint8_t)IFX_I2C_WARM_RESET)
+            if(p_ctx->reset_type > (uint8_t)IFX_I2C_WARM_ATTACH)
             {
                 break;
             }
             p_ctx->reset_state = IFX_I2C_STATE_RESET_PIN_LOW;
             p_ctx->do_pal_init = TRUE;
             p_ctx->state = IFX_I2C_STATE_UNINIT;
+#ifdef OPTIGA_COMMS_SHARED_LINK_ENABLED
+            // Negotiation must not interrupt the transaction of another process
+            if (IFX_I2C_STACK_SUCCESS != ifx_i2c_shared_link_acquire(p_ctx, FALSE))
+            {
+                break;
+            }
+#endif
 
             api_status = ifx_i2c_init(p_ctx);
             if (IFX_I2C_STACK_SUCCESS == api_status)
             {
                 p_ctx->status = IFX_I2C_STATUS_BUSY;
             }
+#ifdef OPTIGA_COMMS_SHARED_LINK_ENABLED
+            else
+            {
+                ifx_i2c_shared_link_release(p_ctx);
+            }
+#endif
         }while(FALSE);
     }
     return (api_status);
@@ -117,11 +161,26 @@ optiga_lib_status_t ifx_i2c_reset(ifx_i2c_context_t * p_ctx,
         p_ctx->reset_type = (uint8_t)reset_type;
         p_ctx->reset_state = IFX_I2C_STATE_RESET_PIN_LOW;
         p_ctx->do_pal_init = FALSE;
-
-        api_status = ifx_i2c_init(p_ctx);
-        if (IFX_I2C_STACK_SUCCESS == api_status)
+#ifdef OPTIGA_LIB_FAST_RESUME_ENABLED
+        // Device is powered, hence the full reset low time is waited
+        p_ctx->powered_off = FALSE;
+#endif
+#ifdef OPTIGA_COMMS_SHARED_LINK_ENABLED
+        // Reset must not interrupt the transaction of another process
+        if (IFX_I2C_STACK_SUCCESS == ifx_i2c_shared_link_acquire(p_ctx, FALSE))
+#endif
         {
-            p_ctx->status = IFX_I2C_STATUS_BUSY;
+            api_status = ifx_i2c_init(p_ctx);
+            if (IFX_I2C_STACK_SUCCESS == api_status)
+            {
+                p_ctx->status = IFX_I2C_STATUS_BUSY;
+            }
+#ifdef OPTIGA_COMMS_SHARED_LINK_ENABLED
+            else
+            {
+                ifx_i2c_shared_link_release(p_ctx);
+            }
+#endif
         }
     }
     return (api_status);
@@ -140,6 +199,17 @@ optiga_lib_status_t ifx_i2c_transceive(ifx_i2c_context_t * p_ctx,
     {
         p_ctx->p_upper_layer_rx_buffer = p_rx_buffer;
         p_ctx->p_upper_layer_rx_buffer_len = p_rx_buffer_len;
+#if defined (OPTIGA_COMMS_ZERO_COPY_TX) || defined (OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED)
+        p_ctx->p_upper_layer_tx_data = p_tx_data;
+        p_ctx->p_upper_layer_tx_data_end = p_tx_data + tx_data_length + IFX_I2C_PRL_OVERHEAD_SIZE;
+#endif
+#ifdef OPTIGA_COMMS_SHARED_LINK_ENABLED
+        // Frame counters and session are continued from the last owner of the link
+        if (IFX_I2C_STACK_SUCCESS != ifx_i2c_shared_link_acquire(p_ctx, TRUE))
+        {
+            return (api_status);
+        }
+#endif
 #ifndef OPTIGA_COMMS_SHIELDED_CONNECTION
         api_status = ifx_i2c_tl_transceive(p_ctx,
                                            (uint8_t * )p_tx_data,
@@ -161,6 +231,12 @@ optiga_lib_status_t ifx_i2c_transceive(ifx_i2c_context_t * p_ctx,
         {
             p_ctx->status = IFX_I2C_STATUS_BUSY;
         }
+#ifdef OPTIGA_COMMS_SHARED_LINK_ENABLED
+        if (IFX_I2C_STACK_SUCCESS != api_status)
+        {
+            ifx_i2c_shared_link_release(p_ctx);
+        }
+#endif
     }
     return (api_status);
 }
@@ -174,6 +250,9 @@ optiga_lib_status_t ifx_i2c_close(ifx_i2c_context_t * p_ctx)
     {
         api_status = IFX_I2C_STACK_SUCCESS;
 
+#ifdef OPTIGA_COMMS_WARM_REATTACH_ENABLED
+        ifx_i2c_link_state_save(p_ctx);
+#endif
 #ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
         p_ctx->close_state = IFX_I2C_STACK_ERROR;
         p_ctx->state = IFX_I2C_STATE_UNINIT;
@@ -183,9 +262,14 @@ optiga_lib_status_t ifx_i2c_close(ifx_i2c_context_t * p_ctx)
         {
             //lint --e{534} suppress "Error handling is not required so return value is not checked"
             pal_i2c_deinit(p_ctx->p_pal_i2c_ctx);
-            // Also power off the device
-            pal_gpio_set_low(p_ctx->p_slave_vdd_pin);
-            pal_gpio_set_low(p_ctx->p_slave_reset_pin);
+#ifdef OPTIGA_COMMS_WARM_REATTACH_ENABLED
+            // Device is kept powered, if the link state is saved for the warm reattach
+            if (FALSE == p_ctx->link_state.stored_link_state_flag)
+#endif
+            {
+                // Also power off the device
+                ifx_i2c_power_off(p_ctx);
+            }
             p_ctx->status = IFX_I2C_STATUS_NOT_BUSY;
         }
 #else
@@ -193,9 +277,14 @@ optiga_lib_status_t ifx_i2c_close(ifx_i2c_context_t * p_ctx)
         //lint --e{534} suppress "Error handling is not required so return value is not checked"
         // Close I2C master
         pal_i2c_deinit(p_ctx->p_pal_i2c_ctx);
-        // Also power off the device
-        pal_gpio_set_low(p_ctx->p_slave_vdd_pin);
-        pal_gpio_set_low(p_ctx->p_slave_reset_pin);
+#ifdef OPTIGA_COMMS_WARM_REATTACH_ENABLED
+        // Device is kept powered, if the link state is saved for the warm reattach
+        if (FALSE == p_ctx->link_state.stored_link_state_flag)
+#endif
+        {
+            // Also power off the device
+            ifx_i2c_power_off(p_ctx);
+        }
         p_ctx->state = IFX_I2C_STATE_UNINIT;
         p_ctx->status = IFX_I2C_STATUS_NOT_BUSY;
 #endif
@@ -204,6 +293,48 @@ optiga_lib_status_t ifx_i2c_close(ifx_i2c_context_t * p_ctx)
     return (api_status);
 }
 
+#if defined (OPTIGA_COMMS_SHIELDED_CONNECTION) && defined (OPTIGA_COMMS_KEY_ROLLOVER_ENABLED)
+optiga_lib_status_t ifx_i2c_rollover(ifx_i2c_context_t * p_ctx)
+{
+    optiga_lib_status_t api_status = (int32_t)IFX_I2C_STACK_ERROR;
+    // Proceed, if not busy and in idle state
+    if ((IFX_I2C_STATE_IDLE == p_ctx->state) && (IFX_I2C_STATUS_BUSY != p_ctx->status))
+    {
+        // No upper layer buffers are involved in the handshake
+        p_ctx->p_upper_layer_rx_buffer = NULL;
+        p_ctx->p_upper_layer_rx_buffer_len = NULL;
+#if defined (OPTIGA_COMMS_ZERO_COPY_TX) || defined (OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED)
+        p_ctx->p_upper_layer_tx_data = NULL;
+        p_ctx->p_upper_layer_tx_data_end = NULL;
+#endif
+#ifdef OPTIGA_COMMS_SHARED_LINK_ENABLED
+        // The new session is handed over to the next owner of the link
+        if (IFX_I2C_STACK_SUCCESS != ifx_i2c_shared_link_acquire(p_ctx, TRUE))
+        {
+            return (api_status);
+        }
+#endif
+        api_status = ifx_i2c_prl_rollover(p_ctx);
+        if ((IFX_I2C_STACK_SUCCESS == api_status) && (IFX_I2C_STACK_SUCCESS == p_ctx->close_state))
+        {
+            p_ctx->status = IFX_I2C_STATUS_BUSY;
+        }
+#ifdef OPTIGA_COMMS_SHARED_LINK_ENABLED
+        if (IFX_I2C_STACK_SUCCESS != api_status)
+        {
+            ifx_i2c_shared_link_release(p_ctx);
+        }
+#endif
+    }
+    return (api_status);
+}
+
+bool_t ifx_i2c_rollover_due(const ifx_i2c_context_t * p_ctx)
+{
+    return (((IFX_I2C_STATE_IDLE == p_ctx->state) && (IFX_I2C_STATUS_BUSY != p_ctx->status)) ?
+            ifx_i2c_prl_rollover_due(p_ctx) : FALSE);
+}
+#endif
 
 optiga_lib_status_t ifx_i2c_set_slave_address(ifx_i2c_context_t * p_ctx,
                                               uint8_t slave_address,
@@ -221,6 +352,109 @@ optiga_lib_status_t ifx_i2c_set_slave_address(ifx_i2c_context_t * p_ctx,
     return (api_status);
 }
 
+#ifdef OPTIGA_COMMS_BUS_ENUMERATION_ENABLED
+optiga_lib_status_t ifx_i2c_enumerate_bus(uint8_t first_instance_id,
+                                          uint8_t device_count,
+                                          uint8_t first_slave_address)
+{
+    optiga_lib_status_t api_status = (int32_t)IFX_I2C_STACK_ERROR;
+    uint8_t bus_map[IFX_I2C_BUS_MAP_SIZE];
+    uint16_t bus_map_length = sizeof(bus_map);
+    ifx_i2c_context_t * p_ctx;
+    uint8_t index;
+
+    do
+    {
+        if ((0 == device_count) ||
+            (OPTIGA_MAX_NUMBER_OF_INSTANCES < ((uint16_t)first_instance_id + device_count)) ||
+            (IFX_I2C_SLAVE_ADDRESS_MAX < ((uint16_t)first_slave_address + device_count - 1U)) ||
+            ((IFX_I2C_BASE_ADDR >= first_slave_address) && (IFX_I2C_BASE_ADDR < (first_slave_address + device_count))))
+        {
+            break;
+        }
+        for (index = 0; index < device_count; index++)
+        {
+            if ((NULL == ifx_i2c_context_list[first_instance_id + index]) ||
+                (NULL == ifx_i2c_context_list[first_instance_id + index]->p_slave_reset_pin))
+            {
+                break;
+            }
+        }
+        if (device_count != index)
+        {
+            break;
+        }
+
+        // The devices are already moved, if the stored map matches
+        if ((PAL_STATUS_SUCCESS == pal_os_datastore_read(OPTIGA_COMMS_BUS_MAP_ID, bus_map, &bus_map_length)) &&
+            (IFX_I2C_BUS_MAP_SIZE == bus_map_length) && (first_instance_id == bus_map[0]) &&
+            (device_count == bus_map[1]) && (first_slave_address == bus_map[2]))
+        {
+            for (index = 0; index < device_count; index++)
+            {
+                p_ctx = ifx_i2c_context_list[first_instance_id + index];
+                p_ctx->slave_address = first_slave_address + index;
+                p_ctx->p_pal_i2c_ctx->slave_address = p_ctx->slave_address;
+            }
+            api_status = IFX_I2C_STACK_SUCCESS;
+            break;
+        }
+
+        // All the devices are held in reset, none responds at the default address
+        for (index = 0; index < device_count; index++)
+        {
+            p_ctx = ifx_i2c_context_list[first_instance_id + index];
+            pal_gpio_set_high(p_ctx->p_slave_vdd_pin);
+            pal_gpio_set_low(p_ctx->p_slave_reset_pin);
+        }
+        // The reset and startup times are given in microseconds
+        pal_os_timer_delay_in_milliseconds((uint16_t)((RESET_LOW_TIME_MSEC / 1000U) + 1U));
+
+        for (index = 0; index < device_count; index++)
+        {
+            p_ctx = ifx_i2c_context_list[first_instance_id + index];
+            pal_gpio_set_high(p_ctx->p_slave_reset_pin);
+            pal_os_timer_delay_in_milliseconds((uint16_t)((STARTUP_WAIT_TIME_USEC / 1000U) + 1U));
+
+            if (PAL_STATUS_SUCCESS != pal_i2c_init(p_ctx->p_pal_i2c_ctx))
+            {
+                break;
+            }
+            p_ctx->p_pal_i2c_ctx->p_upper_layer_ctx = p_ctx;
+            p_ctx->p_pal_i2c_ctx->slave_address = IFX_I2C_BASE_ADDR;
+            api_status = ifx_i2c_pl_write_slave_address(p_ctx, first_slave_address + index,
+                                                        IFX_I2C_SLAVE_ADDRESS_PERSISTENT);
+            if (IFX_I2C_STACK_SUCCESS != api_status)
+            {
+                // The device was moved before, the address is written there again
+                p_ctx->p_pal_i2c_ctx->slave_address = first_slave_address + index;
+                api_status = ifx_i2c_pl_write_slave_address(p_ctx, first_slave_address + index,
+                                                            IFX_I2C_SLAVE_ADDRESS_PERSISTENT);
+            }
+            //lint --e{534} suppress "The slave address is assigned, the pal is initialized again on open"
+            pal_i2c_deinit(p_ctx->p_pal_i2c_ctx);
+            if (IFX_I2C_STACK_SUCCESS != api_status)
+            {
+                break;
+            }
+        }
+        if (device_count != index)
+        {
+            api_status = (int32_t)IFX_I2C_STACK_ERROR;
+            break;
+        }
+
+        bus_map[0] = first_instance_id;
+        bus_map[1] = device_count;
+        bus_map[2] = first_slave_address;
+        //lint --e{534} suppress "The devices are moved, a failed store enumerates again on the next boot"
+        pal_os_datastore_write(OPTIGA_COMMS_BUS_MAP_ID, bus_map, sizeof(bus_map));
+    } while (FALSE);
+
+    return (api_status);
+}
+#endif
+
 /// @cond hidden
 //lint --e{715} suppress "The arguments p_data and data_len is not used in this function 
 //                        but as per the function signature those 2 parameter should be passed"
@@ -229,6 +463,25 @@ void ifx_i2c_tl_event_handler(ifx_i2c_context_t * p_ctx,
                               const uint8_t * p_data,
                               uint16_t data_len)
 {
+#ifdef OPTIGA_COMMS_SHARED_LINK_ENABLED
+    if (TRUE == p_ctx->shared_link_owned)
+    {
+        ifx_i2c_shared_link_complete(p_ctx, event);
+    }
+#endif
+#ifdef OPTIGA_COMMS_WARM_REATTACH_ENABLED
+    if (IFX_I2C_STATE_UNINIT == p_ctx->state)
+    {
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+        if (IFX_I2C_STACK_SUCCESS == event)
+        {
+            ifx_i2c_link_state_restore_session(p_ctx, &p_ctx->link_state);
+        }
+#endif
+        // Restored link state is used only once, this also erases the session key
+        pal_os_memset(&p_ctx->link_state, 0, sizeof(ifx_i2c_link_state_t));
+    }
+#endif
     // If there is no upper layer handler, don't do anything and return
     if (NULL != p_ctx->upper_layer_event_handler)
     {
@@ -266,9 +519,14 @@ _STATIC_H void ifx_i2c_prl_close_event_handler(ifx_i2c_context_t * p_ctx,
         {
             //lint --e{534} suppress "Error handling is not required so return value is not checked"
             pal_i2c_deinit(p_ctx->p_pal_i2c_ctx);
-            // Also power off the device
-            pal_gpio_set_low(p_ctx->p_slave_vdd_pin);
-            pal_gpio_set_low(p_ctx->p_slave_reset_pin);
+#ifdef OPTIGA_COMMS_WARM_REATTACH_ENABLED
+            // Device is kept powered, if the link state is saved for the warm reattach
+            if (FALSE == p_ctx->link_state.stored_link_state_flag)
+#endif
+            {
+                // Also power off the device
+                ifx_i2c_power_off(p_ctx);
+            }
             break;
         }
         default:
@@ -281,9 +539,23 @@ _STATIC_H void ifx_i2c_prl_close_event_handler(ifx_i2c_context_t * p_ctx,
     }
 }
 #endif
+_STATIC_H void ifx_i2c_power_off(ifx_i2c_context_t * p_ctx)
+{
+    pal_gpio_set_low(p_ctx->p_slave_vdd_pin);
+    pal_gpio_set_low(p_ctx->p_slave_reset_pin);
+#ifdef OPTIGA_LIB_FAST_RESUME_ENABLED
+    p_ctx->powered_off = TRUE;
+    p_ctx->power_off_time = pal_os_timer_get_time_in_microseconds();
+#endif
+}
+
 _STATIC_H optiga_lib_status_t ifx_i2c_init(ifx_i2c_context_t * p_ifx_i2c_context)
 {
     optiga_lib_status_t api_status = IFX_I2C_STACK_ERROR;
+    uint32_t reset_low_time = RESET_LOW_TIME_MSEC;
+#ifdef OPTIGA_LIB_FAST_RESUME_ENABLED
+    uint32_t powered_off_time;
+#endif
 
     if (((uint8_t)IFX_I2C_WARM_RESET == p_ifx_i2c_context->reset_type) ||
         ((uint8_t)IFX_I2C_COLD_RESET == p_ifx_i2c_context->reset_type))
@@ -292,17 +564,29 @@ _STATIC_H optiga_lib_status_t ifx_i2c_init(ifx_i2c_context_t * p_ifx_i2c_context
         {
             case IFX_I2C_STATE_RESET_PIN_LOW:
             {
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+                p_ifx_i2c_context->statistics.resets++;
+#endif
                 // Setting the Vdd & Reset pin to low
                 if ((uint8_t)IFX_I2C_COLD_RESET == p_ifx_i2c_context->reset_type)
                 {
                     pal_gpio_set_low(p_ifx_i2c_context->p_slave_vdd_pin);
                 }
                 pal_gpio_set_low(p_ifx_i2c_context->p_slave_reset_pin);
+#ifdef OPTIGA_LIB_FAST_RESUME_ENABLED
+                // Device is powered off since the close (e.g. hibernate), hence only the remainder of the reset low time is waited
+                if (TRUE == p_ifx_i2c_context->powered_off)
+                {
+                    powered_off_time = pal_os_timer_get_time_in_microseconds() - p_ifx_i2c_context->power_off_time;
+                    reset_low_time = (powered_off_time < RESET_LOW_TIME_MSEC) ? (RESET_LOW_TIME_MSEC - powered_off_time) : 1U;
+                }
+                p_ifx_i2c_context->powered_off = FALSE;
+#endif
                 p_ifx_i2c_context->reset_state = IFX_I2C_STATE_RESET_PIN_HIGH;
-                pal_os_event_register_callback_oneshot(p_ifx_i2c_context->pal_os_event_ctx,
+                PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(p_ifx_i2c_context->pal_os_event_ctx,
                                                        (register_callback)ifx_i2c_init,
                                                        (void * )p_ifx_i2c_context,
-                                                       RESET_LOW_TIME_MSEC);
+                                                       reset_low_time);
                 api_status = IFX_I2C_STACK_SUCCESS;
                 break;
             }
@@ -315,10 +599,10 @@ _STATIC_H optiga_lib_status_t ifx_i2c_init(ifx_i2c_context_t * p_ifx_i2c_context
                 }
                 pal_gpio_set_high(p_ifx_i2c_context->p_slave_reset_pin);
                 p_ifx_i2c_context->reset_state = IFX_I2C_STATE_RESET_INIT;
-                pal_os_event_register_callback_oneshot(p_ifx_i2c_context->pal_os_event_ctx,
+                PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(p_ifx_i2c_context->pal_os_event_ctx,
                                                        (register_callback)ifx_i2c_init,
                                                        (void * )p_ifx_i2c_context,
-                                                       STARTUP_TIME_MSEC);
+                                                       STARTUP_WAIT_TIME_USEC);
                 api_status = IFX_I2C_STACK_SUCCESS;
                 break;
             }
@@ -336,6 +620,19 @@ _STATIC_H optiga_lib_status_t ifx_i2c_init(ifx_i2c_context_t * p_ifx_i2c_context
                 break;
         }
     }
+    else if ((uint8_t)IFX_I2C_WARM_ATTACH == p_ifx_i2c_context->reset_type)
+    {
+        // Slave is not reset, hence it is ready for the negotiation right away
+        p_ifx_i2c_context->pl.request_soft_reset = (uint8_t)FALSE;
+#ifdef OPTIGA_COMMS_WARM_REATTACH_ENABLED
+        ifx_i2c_link_state_restore(p_ifx_i2c_context);
+#endif
+#ifndef OPTIGA_COMMS_SHIELDED_CONNECTION
+        api_status = ifx_i2c_tl_init(p_ifx_i2c_context, ifx_i2c_tl_event_handler);
+#else
+        api_status = ifx_i2c_prl_init(p_ifx_i2c_context, ifx_i2c_tl_event_handler);
+#endif
+    }
     //soft reset
     else
     {
@@ -349,6 +646,253 @@ _STATIC_H optiga_lib_status_t ifx_i2c_init(ifx_i2c_context_t * p_ifx_i2c_context
 
     return (api_status);
 }
+
+#ifdef OPTIGA_COMMS_WARM_REATTACH_ENABLED
+_STATIC_H void ifx_i2c_link_state_save(ifx_i2c_context_t * p_ctx)
+{
+    ifx_i2c_link_state_t * p_link_state = &p_ctx->link_state;
+
+    pal_os_memset(p_link_state, 0, sizeof(ifx_i2c_link_state_t));
+    do
+    {
+        // Link state is saved only, if it is established and restored with warm attach
+        if (((uint8_t)IFX_I2C_WARM_ATTACH != p_ctx->reset_type) || (IFX_I2C_STATE_IDLE != p_ctx->state))
+        {
+            break;
+        }
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+        // Session is saved on OPTIGA with the manage context (hibernate) instead
+        if (IFX_I2C_SESSION_CONTEXT_NONE != p_ctx->manage_context_operation)
+        {
+            break;
+        }
+#endif
+        ifx_i2c_link_state_capture(p_ctx, p_link_state);
+        if (PAL_STATUS_SUCCESS != pal_os_datastore_write(OPTIGA_COMMS_LINK_STATE_ID,
+                                                         (uint8_t * )p_link_state,
+                                                         sizeof(ifx_i2c_link_state_t)))
+        {
+            p_link_state->stored_link_state_flag = FALSE;
+        }
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+        // Only the flag is kept, which indicates to keep the device powered
+        pal_os_memset(&p_link_state->prl_ctx, 0, sizeof(p_link_state->prl_ctx));
+#endif
+    } while (FALSE);
+}
+
+_STATIC_H void ifx_i2c_link_state_restore(ifx_i2c_context_t * p_ctx)
+{
+    ifx_i2c_link_state_t * p_link_state = &p_ctx->link_state;
+    ifx_i2c_link_state_t cleared_link_state;
+    uint16_t length = sizeof(ifx_i2c_link_state_t);
+
+    if ((PAL_STATUS_SUCCESS != pal_os_datastore_read(OPTIGA_COMMS_LINK_STATE_ID, (uint8_t * )p_link_state, &length)) ||
+        (sizeof(ifx_i2c_link_state_t) != length) ||
+        (TRUE != p_link_state->stored_link_state_flag) ||
+        (p_ctx->frequency != p_link_state->frequency) ||
+        (IFX_I2C_FRAME_SIZE_MIN > p_link_state->negotiated_frame_size) ||
+        (p_ctx->frame_size < p_link_state->negotiated_frame_size))
+    {
+        pal_os_memset(p_link_state, 0, sizeof(ifx_i2c_link_state_t));
+    }
+    // Saved link state is used only once, hence an outdated state is never restored after an unexpected restart
+    pal_os_memset(&cleared_link_state, 0, sizeof(cleared_link_state));
+    //lint --e{534} suppress "The stored link state flag is cleared anyway, return value is not required to be checked"
+    pal_os_datastore_write(OPTIGA_COMMS_LINK_STATE_ID, (uint8_t * )&cleared_link_state, sizeof(cleared_link_state));
+}
+
+#endif //OPTIGA_COMMS_WARM_REATTACH_ENABLED
+
+#if defined (OPTIGA_COMMS_WARM_REATTACH_ENABLED) || defined (OPTIGA_COMMS_SHARED_LINK_ENABLED)
+_STATIC_H void ifx_i2c_link_state_capture(const ifx_i2c_context_t * p_ctx, ifx_i2c_link_state_t * p_link_state)
+{
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+    pal_os_memcpy(p_link_state->prl_ctx.session_key, p_ctx->prl.session_key, sizeof(p_ctx->prl.session_key));
+    p_link_state->prl_ctx.master_sequence_number = p_ctx->prl.master_sequence_number;
+    p_link_state->prl_ctx.save_slave_sequence_number = p_ctx->prl.save_slave_sequence_number;
+    p_link_state->prl_ctx.decryption_failure_counter = p_ctx->prl.decryption_failure_counter;
+    p_link_state->prl_ctx.data_retransmit_counter = p_ctx->prl.data_retransmit_counter;
+    p_link_state->prl_ctx.negotiation_state = p_ctx->prl.negotiation_state;
+    p_link_state->prl_ctx.stored_context_flag = TRUE;
+#endif
+    p_link_state->stored_link_state_flag = TRUE;
+    p_link_state->tx_seq_nr = p_ctx->dl.tx_seq_nr;
+    p_link_state->rx_seq_nr = p_ctx->dl.rx_seq_nr;
+    p_link_state->frequency = p_ctx->frequency;
+    p_link_state->negotiated_frame_size = p_ctx->negotiated_frame_size;
+}
+
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+_STATIC_H void ifx_i2c_link_state_restore_session(ifx_i2c_context_t * p_ctx, const ifx_i2c_link_state_t * p_link_state)
+{
+    const ifx_i2c_prl_manage_context_t * p_prl_ctx = &p_link_state->prl_ctx;
+
+    // Session of the shielded connection is continued, hence no handshake is required
+    if ((TRUE == p_link_state->stored_link_state_flag) && (TRUE == p_prl_ctx->stored_context_flag))
+    {
+        pal_os_memcpy(p_ctx->prl.session_key, p_prl_ctx->session_key, sizeof(p_ctx->prl.session_key));
+        p_ctx->prl.master_sequence_number = p_prl_ctx->master_sequence_number;
+        p_ctx->prl.save_slave_sequence_number = p_prl_ctx->save_slave_sequence_number;
+        p_ctx->prl.decryption_failure_counter = p_prl_ctx->decryption_failure_counter;
+        p_ctx->prl.data_retransmit_counter = p_prl_ctx->data_retransmit_counter;
+        p_ctx->prl.negotiation_state = p_prl_ctx->negotiation_state;
+        p_ctx->prl.frame_templates_valid = FALSE;
+#ifdef OPTIGA_COMMS_KEY_ROLLOVER_ENABLED
+        // Age of the continued session is counted from the reattach
+        p_ctx->prl.session_start_time = pal_os_timer_get_time_in_milliseconds();
+#endif
+    }
+}
+#endif
+#endif
+
+#ifdef OPTIGA_COMMS_SHARED_LINK_ENABLED
+_STATIC_H optiga_lib_status_t ifx_i2c_shared_link_acquire(ifx_i2c_context_t * p_ctx, uint8_t continue_link_state)
+{
+    const ifx_i2c_link_state_t * p_link_state = &p_ctx->shared_link_state;
+    optiga_lib_status_t api_status = (int32_t)IFX_I2C_STACK_ERROR;
+
+    do
+    {
+        // Blocks, until the ongoing transaction of the other process is completed
+        if (PAL_STATUS_SUCCESS != pal_os_lock_acquire_shared_link((uint8_t * )&p_ctx->shared_link_state,
+                                                                  sizeof(ifx_i2c_link_state_t)))
+        {
+            break;
+        }
+        p_ctx->shared_link_owned = TRUE;
+        api_status = IFX_I2C_STACK_SUCCESS;
+        // Link state of a failed owner or of another configuration is not continued, the data link layer resyncs
+        if ((FALSE == continue_link_state) ||
+            (TRUE != p_link_state->stored_link_state_flag) ||
+            (p_ctx->frequency != p_link_state->frequency) ||
+            (p_ctx->negotiated_frame_size != p_link_state->negotiated_frame_size))
+        {
+            break;
+        }
+        p_ctx->dl.tx_seq_nr = p_link_state->tx_seq_nr;
+        p_ctx->dl.rx_seq_nr = p_link_state->rx_seq_nr;
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+        ifx_i2c_link_state_restore_session(p_ctx, p_link_state);
+#endif
+    } while (FALSE);
+    return (api_status);
+}
+
+/*
+* Hands the link state over to the next owner, it is kept unchanged if no transaction is started
+*/
+_STATIC_H void ifx_i2c_shared_link_release(ifx_i2c_context_t * p_ctx)
+{
+    if (TRUE == p_ctx->shared_link_owned)
+    {
+        pal_os_lock_release_shared_link((const uint8_t * )&p_ctx->shared_link_state, sizeof(ifx_i2c_link_state_t));
+        // The session key is kept in the lock file only
+        pal_os_memset(&p_ctx->shared_link_state, 0, sizeof(ifx_i2c_link_state_t));
+        p_ctx->shared_link_owned = FALSE;
+    }
+}
+
+/*
+* Releases the shared link on completion of the transaction, with the link state after the transaction
+*/
+_STATIC_H void ifx_i2c_shared_link_complete(ifx_i2c_context_t * p_ctx, optiga_lib_status_t event)
+{
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+    // The frame counters are resynced by the open, whereas the session of the last owner is continued
+    if ((IFX_I2C_STATE_UNINIT == p_ctx->state) && (IFX_I2C_STACK_SUCCESS == event) &&
+        (p_ctx->frequency == p_ctx->shared_link_state.frequency) &&
+        (p_ctx->negotiated_frame_size == p_ctx->shared_link_state.negotiated_frame_size))
+    {
+        ifx_i2c_link_state_restore_session(p_ctx, &p_ctx->shared_link_state);
+    }
+#endif
+    if ((IFX_I2C_STATE_IDLE == p_ctx->state) || (IFX_I2C_STACK_SUCCESS == event))
+    {
+        ifx_i2c_link_state_capture(p_ctx, &p_ctx->shared_link_state);
+    }
+    else
+    {
+        // A failed open leaves the link in an unknown state, hence it is not continued by the next owner
+        pal_os_memset(&p_ctx->shared_link_state, 0, sizeof(ifx_i2c_link_state_t));
+    }
+    ifx_i2c_shared_link_release(p_ctx);
+}
+#endif //OPTIGA_COMMS_SHARED_LINK_ENABLED
+
+#if defined (OPTIGA_COMMS_EVENT_TRAMPOLINE_ENABLED) || defined (OPTIGA_COMMS_STACK_USAGE_ENABLED)
+void ifx_i2c_dispatch_event(ifx_i2c_context_t * p_ctx,
+                            ifx_i2c_event_handler_t handler,
+                            optiga_lib_status_t event,
+                            const uint8_t * p_data,
+                            uint16_t data_len)
+{
+#ifdef OPTIGA_COMMS_EVENT_TRAMPOLINE_ENABLED
+    ifx_i2c_event_t * p_event;
+    ifx_i2c_event_t next_event;
+#endif
+#ifdef OPTIGA_COMMS_STACK_USAGE_ENABLED
+    volatile uint8_t stack_marker = 0;
+#endif
+
+    do
+    {
+#ifdef OPTIGA_COMMS_EVENT_TRAMPOLINE_ENABLED
+        // Event is reported by a handler in dispatch, hence it is dispatched by the outermost dispatch
+        if ((0 != p_ctx->event_dispatch_depth) && (IFX_I2C_EVENT_QUEUE_SIZE > p_ctx->event_queue_count))
+        {
+            p_event = &p_ctx->event_queue[(p_ctx->event_queue_head + p_ctx->event_queue_count) %
+                                          IFX_I2C_EVENT_QUEUE_SIZE];
+            p_event->handler = handler;
+            p_event->event = event;
+            p_event->p_data = p_data;
+            p_event->data_len = data_len;
+            p_ctx->event_queue_count++;
+            break;
+        }
+#endif
+#ifdef OPTIGA_COMMS_STACK_USAGE_ENABLED
+        if (0 == p_ctx->event_dispatch_depth)
+        {
+            p_ctx->stack_base = (uintptr_t)&stack_marker;
+        }
+#endif
+        p_ctx->event_dispatch_depth++;
+        handler(p_ctx, event, p_data, data_len);
+#ifdef OPTIGA_COMMS_EVENT_TRAMPOLINE_ENABLED
+        // Only the outermost dispatch empties the queue, a nested dispatch happens only if the queue is full
+        while ((1 == p_ctx->event_dispatch_depth) && (0 != p_ctx->event_queue_count))
+        {
+            // The event is copied, since the handler may queue the next event in the same entry
+            next_event = p_ctx->event_queue[p_ctx->event_queue_head];
+            p_ctx->event_queue_head = (p_ctx->event_queue_head + 1) % IFX_I2C_EVENT_QUEUE_SIZE;
+            p_ctx->event_queue_count--;
+            next_event.handler(p_ctx, next_event.event, next_event.p_data, next_event.data_len);
+        }
+#endif
+        p_ctx->event_dispatch_depth--;
+    } while (FALSE);
+}
+#endif
+
+#ifdef OPTIGA_COMMS_STACK_USAGE_ENABLED
+void ifx_i2c_stack_probe(ifx_i2c_context_t * p_ctx)
+{
+    volatile uint8_t stack_marker = 0;
+    uint32_t stack_usage;
+
+    if (0 != p_ctx->event_dispatch_depth)
+    {
+        // The stack grows downwards on the supported platforms
+        stack_usage = (uint32_t)(p_ctx->stack_base - (uintptr_t)&stack_marker);
+        if (stack_usage > p_ctx->stack_high_water)
+        {
+            p_ctx->stack_high_water = stack_usage;
+        }
+    }
+}
+#endif
 /// @endcond
 /**
 * @}
@@ -67,9 +67,12 @@ ifx_i2c_datastore_config_t ifx_i2c_datastore_config =
  *   - <b>slave address</b> : Address of I2C slave
  *   - <b>frame_size</b> : Frame size in bytes. Minimum supported value is 16 bytes.<br> 
  *              - It is recommended not to use a value greater than the slave's frame size.
+ *              - It must not be greater than #IFX_I2C_FRAME_SIZE, which sizes the frame buffers.
  *              - The user specified frame size is written to I2C slave's frame size register.
  *                The frame size register is read back from I2C slave.
  *                This frame value is used by the ifx-i2c protocol even if it is not equal to the user specified value.
+ *              - The user specified frame size is not modified by the negotiation, hence it can be changed
+ *                at runtime (e.g. lowered on a noisy bus) and is negotiated again with the next #ifx_i2c_open.
  *
  *   - <b>frequency</b> : Frequency/speed of I2C master in KHz.
  *              - This must be lowest of the maximum frequency supported by the devices (master/slave) connected on the 
@@ -86,6 +89,8 @@ ifx_i2c_datastore_config_t ifx_i2c_datastore_config =
  *   - <b>p_slave_vdd_pin</b> : GPIO pin for VDD. If not set, cold reset is not done. 
  *   - <b>p_slave_reset_pin</b> : GPIO pin for Reset. If not set, warm reset is not done.
  *   - <b>ifx_i2c_datastore_config</b> : Data store configuration instance
+ *   - <b>p_slave_irq_pin</b> : GPIO pin for the data ready interrupt (OPTIGA_COMMS_DATA_READY_IRQ_ENABLED).
+ *                              If not set, the status register is polled.
  * - The other fields must be initialized by the user of the structure.
  */
 //lint --e{785} suppress "Only required fields are initialized by default, the rest are handled by user of this structure"
@@ -105,8 +110,25 @@ ifx_i2c_context_t ifx_i2c_context_0 =
     &optiga_pal_i2c_context_0,
 #ifdef OPTIGA_COMMS_SHIELDED_CONNECTION            
     /// Data store context
-    &ifx_i2c_datastore_config
+    &ifx_i2c_datastore_config,
 #endif    
+#ifdef OPTIGA_COMMS_DATA_READY_IRQ_ENABLED
+    /// Data ready interrupt pin
+    &optiga_irq_0,
+#endif
+};
+
+/** @brief This is the list of IFX I2C contexts, one for each OPTIGA instance.
+ *
+ * - To drive more than one OPTIGA (on a different I2C bus or slave address), define an additional IFX I2C context
+ *   with its own pal i2c context, vdd and reset pin, and add it here at the index of its optiga instance id.
+ * - The number of entries is configured with OPTIGA_MAX_NUMBER_OF_INSTANCES. A NULL entry is not available.
+ * - Devices on the same bus may all be configured with IFX_I2C_BASE_ADDR and a reset pin each, if they are moved
+ *   to their addresses at boot with ifx_i2c_enumerate_bus (OPTIGA_COMMS_BUS_ENUMERATION_ENABLED).
+ */
+ifx_i2c_context_t * const ifx_i2c_context_list[OPTIGA_MAX_NUMBER_OF_INSTANCES] =
+{
+    &ifx_i2c_context_0
 };
 
 /**
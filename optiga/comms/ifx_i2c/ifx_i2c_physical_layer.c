@@ -36,7 +36,12 @@
 */
 
 #include "optiga/ifx_i2c/ifx_i2c_physical_layer.h"
+#include "optiga/ifx_i2c/ifx_i2c.h"
 #include "optiga/pal/pal_os_event.h"
+#include "optiga/common/optiga_lib_trace.h"
+#ifdef OPTIGA_COMMS_DATA_READY_IRQ_ENABLED
+#include "optiga/pal/pal_os_lock.h"
+#endif
 
 /// @cond hidden
 
@@ -76,6 +81,7 @@
 #define PL_STATE_DATA_AVAILABLE         (0x03)
 #define PL_STATE_RXTX                   (0x04)
 #define PL_STATE_SOFT_RESET             (0x05)
+#define PL_STATE_SPECULATIVE_RX         (0x06)
 
 //Physical Layer negotiation constants
 #define PL_INIT_SET_DATA_REG_LEN        (0x11)
@@ -89,6 +95,10 @@
 #define PL_INIT_GET_STATUS_REG          (0x99)
 #define PL_INIT_DONE                    (0xAA)
 #define PL_INIT_SET_FREQ_DEFAULT        (0xBB)
+#define PL_INIT_ATTACH                  (0xCC)
+#define PL_INIT_VERIFY_ATTACH           (0xDD)
+#define PL_INIT_CACHED                  (0xEE)
+#define PL_INIT_CACHED_DONE             (0xEF)
 
 //Physical layer soft reset states
 #define PL_RESET_INIT                   (0xA1)
@@ -113,6 +123,13 @@
 #define LOG_PL(...) //printf(__VA_ARGS__)
 #endif
 
+// Marks the start of an I2C transfer for the accounting of the I2C time
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+#define PL_I2C_TRANSFER_START(p_ctx)    ((p_ctx)->i2c_transfer_start_us = pal_os_timer_get_time_in_microseconds())
+#else
+#define PL_I2C_TRANSFER_START(p_ctx)
+#endif
+
 _STATIC_H optiga_lib_status_t g_pal_event_status;
 
 
@@ -125,14 +142,28 @@ _STATIC_H void ifx_i2c_pl_write_register(ifx_i2c_context_t * p_ctx,
                                          const uint8_t * p_content);
 /// Physical Layer high level interface timer callback (Status register polling)
 _STATIC_H void ifx_i2c_pl_status_poll_callback(void * p_ctx);
+/// Physical Layer high level interface (Schedules the next status register read, while waiting for the response)
+_STATIC_H void ifx_i2c_pl_schedule_status_poll(ifx_i2c_context_t * p_ctx, uint32_t poll_interval_us);
+/// Physical Layer high level interface (Interval of the next status register read, while waiting for the response)
+_STATIC_H uint32_t ifx_i2c_pl_next_poll_interval(ifx_i2c_context_t * p_ctx);
+#ifdef OPTIGA_COMMS_DATA_READY_IRQ_ENABLED
+/// Physical Layer high level interface interrupt handler (Data ready edge of the slave)
+_STATIC_H void ifx_i2c_pl_data_ready_irq_handler(void * p_ctx);
+#endif
 /// Physical Layer intermediate state machine (Negotiation with slave)
 _STATIC_H void ifx_i2c_pl_negotiation_event_handler(void * p_input_ctx);
 /// Physical Layer intermediate state machine(Set bit rate)
 _STATIC_H optiga_lib_status_t ifx_i2c_pl_set_bit_rate(ifx_i2c_context_t * p_ctx, uint16_t bitrate);
+/// Physical Layer set bit rate of the I2C master without retry
+_STATIC_H optiga_lib_status_t ifx_i2c_pl_apply_bit_rate(ifx_i2c_context_t * p_ctx, uint16_t bitrate);
 /// Physical Layer intermediate state machine (soft reset)
 _STATIC_H void ifx_i2c_pl_soft_reset(ifx_i2c_context_t * p_ctx);
 /// Physical Layer high level interface state machine (read/write frames)
 _STATIC_H void ifx_i2c_pl_frame_event_handler(ifx_i2c_context_t * p_ctx, optiga_lib_status_t event);
+#ifdef OPTIGA_COMMS_SPECULATIVE_READ_ENABLED
+/// Physical Layer high level interface timer callback (Status register polling after a NACKed speculative read)
+_STATIC_H void ifx_i2c_pl_speculative_read_fallback_callback(void * p_ctx);
+#endif
 /// Physical Layer low level interface timer callback (I2C Nack/Busy polling)
 _STATIC_H void ifx_i2c_pal_poll_callback(void * p_ctx);
 /// Physical Layer low level guard time callback
@@ -141,6 +172,10 @@ _STATIC_H void ifx_i2c_pl_guard_time_callback(void * p_ctx);
 _STATIC_H void ifx_i2c_pl_pal_event_handler(void * p_ctx, optiga_lib_status_t event);
 /// Physical layer low level event handler for set slave address
 _STATIC_H void ifx_i2c_pl_pal_slave_addr_event_handler(void * p_input_ctx, optiga_lib_status_t event);
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+/// Physical Layer accounting of a time in milliseconds
+_STATIC_H void ifx_i2c_pl_account_time(uint32_t * p_time_ms, uint32_t * p_remainder_us, uint32_t time_us);
+#endif
 
 /// @endcond
 
@@ -154,6 +189,20 @@ optiga_lib_status_t ifx_i2c_pl_init(ifx_i2c_context_t * p_ctx, ifx_i2c_event_han
     p_ctx->p_pal_i2c_ctx->slave_address = p_ctx->slave_address;
     p_ctx->p_pal_i2c_ctx->upper_layer_event_handler = ifx_i2c_pl_pal_event_handler;
     p_ctx->pl.retry_counter = PL_POLLING_MAX_CNT;
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+    p_ctx->pl.response_wait_state = PL_RESPONSE_WAIT_IDLE;
+#endif
+#ifdef OPTIGA_COMMS_ADAPTIVE_BITRATE_ENABLED
+    p_ctx->pl.bit_rate = 0;
+#endif
+#ifdef OPTIGA_COMMS_SPECULATIVE_READ_ENABLED
+    p_ctx->pl.speculative_read_len = 0;
+#endif
+    // Requested frame size must fit into the frame buffers
+    if ((IFX_I2C_FRAME_SIZE < p_ctx->frame_size) || (IFX_I2C_FRAME_SIZE_MIN > p_ctx->frame_size))
+    {
+        return (IFX_I2C_STACK_ERROR);
+    }
     if (TRUE == p_ctx->do_pal_init)
     {
         // Initialize I2C driver
@@ -162,6 +211,18 @@ optiga_lib_status_t ifx_i2c_pl_init(ifx_i2c_context_t * p_ctx, ifx_i2c_event_han
             return (IFX_I2C_STACK_ERROR);
         }
     }
+#ifdef OPTIGA_COMMS_DATA_READY_IRQ_ENABLED
+    p_ctx->pl.data_ready_irq_armed = FALSE;
+    p_ctx->pl.data_ready_irq_registered = FALSE;
+    // Without data ready interrupt, the status register is polled with PL_DATA_POLLING_INVERVAL_US
+    if ((NULL != p_ctx->p_slave_irq_pin) &&
+        (PAL_STATUS_SUCCESS == pal_gpio_register_irq(p_ctx->p_slave_irq_pin,
+                                                     ifx_i2c_pl_data_ready_irq_handler,
+                                                     (void * )p_ctx)))
+    {
+        p_ctx->pl.data_ready_irq_registered = TRUE;
+    }
+#endif
     // Set Physical Layer internal state
     if ((uint8_t)TRUE == p_ctx->pl.request_soft_reset)
     {
@@ -173,6 +234,26 @@ optiga_lib_status_t ifx_i2c_pl_init(ifx_i2c_context_t * p_ctx, ifx_i2c_event_han
     {
         p_ctx->pl.frame_state = PL_STATE_INIT;
     }
+#ifdef OPTIGA_COMMS_WARM_REATTACH_ENABLED
+    // Negotiated parameters of the restored link state are verified only
+    if (((uint8_t)IFX_I2C_WARM_ATTACH == p_ctx->reset_type) && (TRUE == p_ctx->link_state.stored_link_state_flag))
+    {
+        p_ctx->pl.negotiate_state = PL_INIT_ATTACH;
+    }
+#endif
+#ifdef OPTIGA_COMMS_PL_NEGOTIATION_CACHE_ENABLED
+    // Cached negotiation applies, if the slave and the requested parameters are the same
+    p_ctx->pl.negotiation_unverified = FALSE;
+    p_ctx->pl.renegotiation_error = FALSE;
+    if ((PL_INIT_SET_FREQ_DEFAULT == p_ctx->pl.negotiate_state) &&
+        (TRUE == p_ctx->pl.negotiation_cached) &&
+        (p_ctx->slave_address == p_ctx->pl.cached_slave_address) &&
+        (p_ctx->frequency == p_ctx->pl.cached_frequency) &&
+        (p_ctx->frame_size == p_ctx->pl.cached_frame_size))
+    {
+        p_ctx->pl.negotiate_state = PL_INIT_CACHED;
+    }
+#endif
 
     ifx_i2c_pl_frame_event_handler(p_ctx, IFX_I2C_STACK_SUCCESS);
 
@@ -192,6 +273,7 @@ optiga_lib_status_t ifx_i2c_pl_send_frame(ifx_i2c_context_t * p_ctx, uint8_t * p
     p_ctx->pl.p_tx_frame   = p_frame;
     p_ctx->pl.tx_frame_len = frame_len;
 
+    OPTIGA_LIB_TRACE_BEGIN(OPTIGA_LIB_TRACE_LAYER_PL, PL_ACTION_WRITE_FRAME);
     ifx_i2c_pl_frame_event_handler(p_ctx, IFX_I2C_STACK_SUCCESS);
     return (IFX_I2C_STACK_SUCCESS);
 }
@@ -205,6 +287,7 @@ optiga_lib_status_t ifx_i2c_pl_receive_frame(ifx_i2c_context_t * p_ctx)
     }
     p_ctx->pl.frame_action = PL_ACTION_READ_FRAME;
 
+    OPTIGA_LIB_TRACE_BEGIN(OPTIGA_LIB_TRACE_LAYER_PL, PL_ACTION_READ_FRAME);
     ifx_i2c_pl_frame_event_handler(p_ctx, IFX_I2C_STACK_SUCCESS);
     return (IFX_I2C_STACK_SUCCESS);
 }
@@ -282,6 +365,56 @@ optiga_lib_status_t ifx_i2c_pl_write_slave_address(ifx_i2c_context_t * p_ctx, ui
     return (status);
 }
 
+#ifdef OPTIGA_COMMS_ADAPTIVE_BITRATE_ENABLED
+void ifx_i2c_pl_adapt_bit_rate(ifx_i2c_context_t * p_ctx, uint8_t frame_error)
+{
+    uint16_t bit_rate = p_ctx->pl.bit_rate;
+
+    do
+    {
+        // Bitrate is not adapted before the negotiation is complete
+        if (0 == bit_rate)
+        {
+            break;
+        }
+        if (FALSE != frame_error)
+        {
+            p_ctx->pl.bit_rate_frame_count = 0;
+            if ((PL_BIT_RATE_ERROR_THRESHOLD > (++p_ctx->pl.bit_rate_error_count)) || (PL_DEFAULT_FREQUENCY >= bit_rate))
+            {
+                break;
+            }
+            bit_rate >>= 1;
+            if (PL_DEFAULT_FREQUENCY > bit_rate)
+            {
+                bit_rate = PL_DEFAULT_FREQUENCY;
+            }
+        }
+        else
+        {
+            p_ctx->pl.bit_rate_error_count = 0;
+            if ((PL_BIT_RATE_PROBE_FRAMES > (++p_ctx->pl.bit_rate_frame_count)) || (p_ctx->frequency <= bit_rate))
+            {
+                break;
+            }
+            bit_rate <<= 1;
+            if (p_ctx->frequency < bit_rate)
+            {
+                bit_rate = p_ctx->frequency;
+            }
+        }
+        LOG_PL("[IFX-PL]: Adapt bit rate to %d KHz\n", bit_rate);
+        p_ctx->pl.bit_rate_error_count = 0;
+        p_ctx->pl.bit_rate_frame_count = 0;
+        // Current bitrate is kept, if the I2C master rejects the new one
+        if (PAL_I2C_EVENT_SUCCESS == ifx_i2c_pl_apply_bit_rate(p_ctx, bit_rate))
+        {
+            p_ctx->pl.bit_rate = bit_rate;
+        }
+    } while (FALSE);
+}
+#endif
+
 _STATIC_H void ifx_i2c_pl_read_register(ifx_i2c_context_t * p_ctx, uint8_t reg_addr, uint16_t reg_len)
 {
     LOG_PL("[IFX-PL]: Read register %x len %d\n", reg_addr, reg_len);
@@ -295,6 +428,8 @@ _STATIC_H void ifx_i2c_pl_read_register(ifx_i2c_context_t * p_ctx, uint8_t reg_a
     p_ctx->pl.register_action = PL_ACTION_READ_REGISTER;
     p_ctx->pl.retry_counter   = PL_POLLING_MAX_CNT;
     p_ctx->pl.i2c_cmd         = PL_I2C_CMD_WRITE;
+    IFX_I2C_STACK_PROBE(p_ctx);
+    PL_I2C_TRANSFER_START(p_ctx);
 
     //lint --e{534} suppress "This is the last statement of asynchronous function hence return value is not checked"
     pal_i2c_write(p_ctx->p_pal_i2c_ctx, p_ctx->pl.buffer, p_ctx->pl.buffer_tx_len);
@@ -317,6 +452,8 @@ _STATIC_H void ifx_i2c_pl_write_register(ifx_i2c_context_t * p_ctx,
     p_ctx->pl.register_action = PL_ACTION_WRITE_REGISTER;
     p_ctx->pl.retry_counter   = PL_POLLING_MAX_CNT;
     p_ctx->pl.i2c_cmd         = PL_I2C_CMD_WRITE;
+    IFX_I2C_STACK_PROBE(p_ctx);
+    PL_I2C_TRANSFER_START(p_ctx);
     //lint --e{534} suppress "This is the last statement of asynchronous function hence return value is not checked"
     pal_i2c_write(p_ctx->p_pal_i2c_ctx, p_ctx->pl.buffer, p_ctx->pl.buffer_tx_len);
 }
@@ -324,11 +461,73 @@ _STATIC_H void ifx_i2c_pl_write_register(ifx_i2c_context_t * p_ctx,
 
 _STATIC_H void ifx_i2c_pl_status_poll_callback(void * p_ctx)
 {
-    LOG_PL("[IFX-PL]: Status poll Timer elapsed  -> Read STATUS register\n");
-    ifx_i2c_pl_read_register((ifx_i2c_context_t * )p_ctx, PL_REG_I2C_STATE, PL_REG_LEN_I2C_STATE);
+#ifdef OPTIGA_COMMS_DATA_READY_IRQ_ENABLED
+    ifx_i2c_context_t * p_local_ctx = (ifx_i2c_context_t * )p_ctx;
+    uint8_t poll_armed;
+
+    // Either the data ready interrupt or the fallback timer reads the STATUS register, whichever is first
+    pal_os_lock_enter_critical_section();
+    poll_armed = p_local_ctx->pl.data_ready_irq_armed;
+    p_local_ctx->pl.data_ready_irq_armed = FALSE;
+    pal_os_lock_exit_critical_section();
+    if (TRUE == poll_armed)
+#endif
+    {
+        LOG_PL("[IFX-PL]: Status poll Timer elapsed  -> Read STATUS register\n");
+        ifx_i2c_pl_read_register((ifx_i2c_context_t * )p_ctx, PL_REG_I2C_STATE, PL_REG_LEN_I2C_STATE);
+    }
+}
+
+_STATIC_H uint32_t ifx_i2c_pl_next_poll_interval(ifx_i2c_context_t * p_ctx)
+{
+    uint32_t poll_interval_us = PL_DATA_POLLING_INVERVAL_US;
+
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+    // Tight backoff, the interval doubles with each poll up to PL_DATA_POLLING_INVERVAL_US
+    poll_interval_us = p_ctx->pl.poll_interval_us;
+    p_ctx->pl.poll_interval_us = (poll_interval_us < (PL_DATA_POLLING_INVERVAL_US >> 1)) ?
+                                 (poll_interval_us << 1) : PL_DATA_POLLING_INVERVAL_US;
+#endif
+    return (poll_interval_us);
 }
 
-_STATIC_H optiga_lib_status_t ifx_i2c_pl_set_bit_rate(ifx_i2c_context_t * p_ctx, uint16_t bitrate)
+_STATIC_H void ifx_i2c_pl_schedule_status_poll(ifx_i2c_context_t * p_ctx, uint32_t poll_interval_us)
+{
+#ifdef OPTIGA_COMMS_DATA_READY_IRQ_ENABLED
+    if (TRUE == p_ctx->pl.data_ready_irq_registered)
+    {
+        // Data ready interrupt wakes the STATUS register read, the timer is only a fallback for a missed edge
+        poll_interval_us = PL_DATA_IRQ_POLLING_INVERVAL_US;
+    }
+#endif
+    PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(p_ctx->pal_os_event_ctx,
+                                           ifx_i2c_pl_status_poll_callback,
+                                           (void * )p_ctx,
+                                           poll_interval_us);
+#ifdef OPTIGA_COMMS_DATA_READY_IRQ_ENABLED
+    // Armed after the timer is registered, hence the interrupt never overrides any other pending event
+    p_ctx->pl.data_ready_irq_armed = TRUE;
+#endif
+}
+
+#ifdef OPTIGA_COMMS_DATA_READY_IRQ_ENABLED
+_STATIC_H void ifx_i2c_pl_data_ready_irq_handler(void * p_ctx)
+{
+    ifx_i2c_context_t * p_local_ctx = (ifx_i2c_context_t * )p_ctx;
+
+    // Invoked in interrupt context. Edges are ignored, unless the physical layer waits for the response
+    if (TRUE == p_local_ctx->pl.data_ready_irq_armed)
+    {
+        // Replaces the pending fallback timer, the STATUS register is read in the context of the pal os event
+        PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(p_local_ctx->pal_os_event_ctx,
+                                               ifx_i2c_pl_status_poll_callback,
+                                               p_ctx,
+                                               PL_GUARD_TIME_INTERVAL_US);
+    }
+}
+#endif
+
+_STATIC_H optiga_lib_status_t ifx_i2c_pl_apply_bit_rate(ifx_i2c_context_t * p_ctx, uint16_t bitrate)
 {
     optiga_lib_status_t status;
     void* p_pal_ctx_upper_layer_handler;
@@ -339,12 +538,21 @@ _STATIC_H optiga_lib_status_t ifx_i2c_pl_set_bit_rate(ifx_i2c_context_t * p_ctx,
     status = pal_i2c_set_bitrate(p_ctx->p_pal_i2c_ctx , bitrate);
     // Restore callback
     p_ctx->p_pal_i2c_ctx->upper_layer_event_handler  = p_pal_ctx_upper_layer_handler;
+
+    return (status);
+}
+
+_STATIC_H optiga_lib_status_t ifx_i2c_pl_set_bit_rate(ifx_i2c_context_t * p_ctx, uint16_t bitrate)
+{
+    optiga_lib_status_t status;
+
+    status = ifx_i2c_pl_apply_bit_rate(p_ctx, bitrate);
     if (PAL_I2C_EVENT_SUCCESS != status)
     {
         if (0 != (p_ctx->pl.retry_counter--))
         {
             LOG_PL("[IFX-PL]: Set bit rate failed, Retry setting.\n");
-            pal_os_event_register_callback_oneshot( p_ctx->pal_os_event_ctx,
+            PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT( p_ctx->pal_os_event_ctx,
                                                     ifx_i2c_pl_negotiation_event_handler,
                                                    ((void * )p_ctx),
                                                    PL_POLLING_INVERVAL_US);
@@ -396,7 +604,7 @@ _STATIC_H void ifx_i2c_pl_negotiation_event_handler(void * p_input_ctx)
                     p_ctx->pl.negotiate_state = PL_INIT_DONE;
                     p_buffer = NULL;
                     buffer_len = 0;
-                    pal_os_event_register_callback_oneshot(p_ctx->pal_os_event_ctx,(register_callback)ifx_i2c_pl_negotiation_event_handler,
+                    PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(p_ctx->pal_os_event_ctx,(register_callback)ifx_i2c_pl_negotiation_event_handler,
                                                            (void * )p_ctx,
                                                            STARTUP_TIME_MSEC);
                 }
@@ -468,6 +676,12 @@ _STATIC_H void ifx_i2c_pl_negotiation_event_handler(void * p_input_ctx)
                 event = ifx_i2c_pl_set_bit_rate(p_input_ctx, p_ctx->frequency);
                 if (IFX_I2C_STACK_SUCCESS == event)
                 {
+#ifdef OPTIGA_COMMS_ADAPTIVE_BITRATE_ENABLED
+                    // Adaptive bitrate starts with the negotiated frequency
+                    p_ctx->pl.bit_rate = p_ctx->frequency;
+                    p_ctx->pl.bit_rate_error_count = 0;
+                    p_ctx->pl.bit_rate_frame_count = 0;
+#endif
                     p_ctx->pl.negotiate_state = PL_INIT_SET_DATA_REG_LEN;
                     continue_negotiation = TRUE;
                 }
@@ -499,16 +713,110 @@ _STATIC_H void ifx_i2c_pl_negotiation_event_handler(void * p_input_ctx)
                 p_ctx->pl.negotiate_state = PL_INIT_DONE;
                 slave_frame_len = (p_ctx->pl.buffer[0] << 8) | p_ctx->pl.buffer[1];
                 // Error if slave's frame length is more than requested frame length
-                if (p_ctx->frame_size >= slave_frame_len)
+                if ((p_ctx->frame_size >= slave_frame_len) && (IFX_I2C_FRAME_SIZE_MIN <= slave_frame_len))
                 {
-                    p_ctx->frame_size = slave_frame_len;
+                    // Requested frame size is kept, hence the next negotiation starts again from the configured max
+                    p_ctx->negotiated_frame_size = slave_frame_len;
                     event = IFX_I2C_STACK_SUCCESS;
+#ifdef OPTIGA_COMMS_PL_NEGOTIATION_CACHE_ENABLED
+                    p_ctx->pl.cached_slave_address = p_ctx->slave_address;
+                    p_ctx->pl.cached_frequency = p_ctx->frequency;
+                    p_ctx->pl.cached_frame_size = p_ctx->frame_size;
+                    p_ctx->pl.cached_negotiated_frame_size = slave_frame_len;
+                    p_ctx->pl.negotiation_cached = TRUE;
+#endif
                 }
                 p_buffer = NULL;
                 buffer_len = 0;
                 continue_negotiation = TRUE;
             }
             break;
+#ifdef OPTIGA_COMMS_WARM_REATTACH_ENABLED
+            // Set the frequency of the restored link state, the slave keeps its I2C mode persistently
+            case PL_INIT_ATTACH:
+            {
+                event = ifx_i2c_pl_set_bit_rate(p_input_ctx, p_ctx->frequency);
+                if (IFX_I2C_STACK_SUCCESS == event)
+                {
+#ifdef OPTIGA_COMMS_ADAPTIVE_BITRATE_ENABLED
+                    p_ctx->pl.bit_rate = p_ctx->frequency;
+                    p_ctx->pl.bit_rate_error_count = 0;
+                    p_ctx->pl.bit_rate_frame_count = 0;
+#endif
+                    // Frame size is kept by the slave until reset, hence reading it verifies the link state
+                    p_ctx->pl.negotiate_state = PL_INIT_VERIFY_ATTACH;
+                    ifx_i2c_pl_read_register(p_ctx, PL_REG_DATA_REG_LEN, PL_REG_LEN_DATA_REG_LEN);
+                }
+                else if (IFX_I2C_STACK_ERROR == event)
+                {
+                    p_ctx->pl.negotiate_state = PL_INIT_DONE;
+                    p_buffer = NULL;
+                    buffer_len = 0;
+                    continue_negotiation = TRUE;
+                }
+            }
+            break;
+            // Check the slave still uses the frame size of the restored link state
+            case PL_INIT_VERIFY_ATTACH:
+            {
+                slave_frame_len = (p_ctx->pl.buffer[0] << 8) | p_ctx->pl.buffer[1];
+                if (p_ctx->link_state.negotiated_frame_size == slave_frame_len)
+                {
+                    p_ctx->negotiated_frame_size = slave_frame_len;
+                    p_ctx->pl.negotiate_state = PL_INIT_DONE;
+                    event = IFX_I2C_STACK_SUCCESS;
+                    p_buffer = NULL;
+                    buffer_len = 0;
+                }
+                else
+                {
+                    // Slave was reset in between, hence the link state is discarded and negotiated again
+                    LOG_PL("[IFX-PL]: Link state outdated, negotiate\n");
+                    p_ctx->link_state.stored_link_state_flag = FALSE;
+                    p_ctx->pl.negotiate_state = PL_INIT_SET_FREQ_DEFAULT;
+                }
+                continue_negotiation = TRUE;
+            }
+            break;
+#endif
+#ifdef OPTIGA_COMMS_PL_NEGOTIATION_CACHE_ENABLED
+            // Set the cached frequency, the slave keeps its I2C mode persistently
+            case PL_INIT_CACHED:
+            {
+                event = ifx_i2c_pl_set_bit_rate(p_input_ctx, p_ctx->frequency);
+                if (IFX_I2C_STACK_SUCCESS == event)
+                {
+#ifdef OPTIGA_COMMS_ADAPTIVE_BITRATE_ENABLED
+                    p_ctx->pl.bit_rate = p_ctx->frequency;
+                    p_ctx->pl.bit_rate_error_count = 0;
+                    p_ctx->pl.bit_rate_frame_count = 0;
+#endif
+                    // Frame size is reset with the slave, hence it is written again. It is verified with the first frame
+                    p_ctx->pl.negotiation_unverified = TRUE;
+                    p_ctx->pl.negotiate_state = PL_INIT_CACHED_DONE;
+                    max_frame_size[0] = (uint8_t)(p_ctx->pl.cached_negotiated_frame_size >> 8);
+                    max_frame_size[1] = (uint8_t)(p_ctx->pl.cached_negotiated_frame_size);
+                    ifx_i2c_pl_write_register(p_ctx, PL_REG_DATA_REG_LEN, sizeof(max_frame_size), max_frame_size);
+                }
+                else if (IFX_I2C_STACK_ERROR == event)
+                {
+                    p_ctx->pl.negotiate_state = PL_INIT_SET_FREQ_DEFAULT;
+                    continue_negotiation = TRUE;
+                }
+            }
+            break;
+            // Cached frame size is written
+            case PL_INIT_CACHED_DONE:
+            {
+                p_ctx->negotiated_frame_size = p_ctx->pl.cached_negotiated_frame_size;
+                p_ctx->pl.negotiate_state = PL_INIT_DONE;
+                event = IFX_I2C_STACK_SUCCESS;
+                p_buffer = NULL;
+                buffer_len = 0;
+                continue_negotiation = TRUE;
+            }
+            break;
+#endif
             case PL_INIT_DONE:
             {
                 if (IFX_I2C_STACK_SUCCESS == event)
@@ -519,8 +827,16 @@ _STATIC_H void ifx_i2c_pl_negotiation_event_handler(void * p_input_ctx)
                 {
                     p_ctx->pl.frame_state = PL_STATE_UNINIT;
                 }
+#ifdef OPTIGA_COMMS_PL_NEGOTIATION_CACHE_ENABLED
+                if (TRUE == p_ctx->pl.renegotiation_error)
+                {
+                    // Frame exchange, which failed with the cached negotiation, is repeated by the upper layer
+                    p_ctx->pl.renegotiation_error = FALSE;
+                    event = IFX_I2C_STACK_ERROR;
+                }
+#endif
                 // Negotiation between master and slave is complete
-                p_ctx->pl.upper_layer_event_handler(p_ctx,event, p_buffer, buffer_len);
+                IFX_I2C_DISPATCH_EVENT(p_ctx, p_ctx->pl.upper_layer_event_handler, event, p_buffer, buffer_len);
             }
             break;
             default:
@@ -534,12 +850,33 @@ _STATIC_H void ifx_i2c_pl_frame_event_handler(ifx_i2c_context_t * p_ctx, optiga_
 {
     uint32_t time_stamp_diff;
     uint32_t current_time;
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+    uint32_t execution_time_us;
+#endif
     uint16_t frame_size;
     if (IFX_I2C_STACK_SUCCESS != event)
     {
-        p_ctx->pl.frame_state = PL_STATE_READY;
-        // I2C read or write failed, report to upper layer
-        p_ctx->pl.upper_layer_event_handler(p_ctx, event, 0, 0);
+#ifdef OPTIGA_COMMS_PL_NEGOTIATION_CACHE_ENABLED
+        if (TRUE == p_ctx->pl.negotiation_unverified)
+        {
+            // First error with the cached negotiation, hence the cache is dropped and negotiated again
+            LOG_PL("[IFX-PL]: Cached negotiation failed, negotiate\n");
+            p_ctx->pl.negotiation_cached = FALSE;
+            p_ctx->pl.negotiation_unverified = FALSE;
+            p_ctx->pl.renegotiation_error = (PL_STATE_INIT != p_ctx->pl.frame_state) ? TRUE : FALSE;
+            p_ctx->pl.frame_state = PL_STATE_INIT;
+            p_ctx->pl.negotiate_state = PL_INIT_SET_FREQ_DEFAULT;
+            p_ctx->pl.retry_counter = PL_POLLING_MAX_CNT;
+            ifx_i2c_pl_negotiation_event_handler(p_ctx);
+        }
+        else
+#endif
+        {
+            p_ctx->pl.frame_state = PL_STATE_READY;
+            OPTIGA_LIB_TRACE_ERROR(OPTIGA_LIB_TRACE_LAYER_PL, p_ctx->pl.frame_action);
+            // I2C read or write failed, report to upper layer
+            IFX_I2C_DISPATCH_EVENT(p_ctx, p_ctx->pl.upper_layer_event_handler, event, 0, 0);
+        }
     }
     else
     {
@@ -564,6 +901,36 @@ _STATIC_H void ifx_i2c_pl_frame_event_handler(ifx_i2c_context_t * p_ctx, optiga_
                 p_ctx->pl.frame_state            = PL_STATE_DATA_AVAILABLE;
                 if (PL_ACTION_READ_FRAME == p_ctx->pl.frame_action)
                 {
+#ifdef OPTIGA_COMMS_SPECULATIVE_READ_ENABLED
+                    if (0 != p_ctx->pl.speculative_read_len)
+                    {
+                        // Length of the frame is known, hence the DATA register is read without the STATUS register.
+                        // The data link layer validates the frame (CRC and length) as any other frame
+                        frame_size = p_ctx->pl.speculative_read_len;
+                        p_ctx->pl.speculative_read_len = 0;
+                        p_ctx->pl.frame_state = PL_STATE_SPECULATIVE_RX;
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+                        p_ctx->statistics.speculative_reads++;
+#endif
+                        ifx_i2c_pl_read_register(p_ctx, PL_REG_DATA, frame_size);
+                        break;
+                    }
+#endif
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+                    p_ctx->pl.poll_interval_us = PL_ADAPTIVE_POLLING_MIN_INTERVAL_US;
+                    if (PL_RESPONSE_WAIT_ARMED == p_ctx->pl.response_wait_state)
+                    {
+                        // The response is not ready before the expected execution time. The first poll is scheduled
+                        // with a margin of a quarter, since the expected time includes the transfers of the frames
+                        p_ctx->pl.response_wait_state = PL_RESPONSE_WAIT_POLLING;
+                        if (0 != p_ctx->response_time_hint_us)
+                        {
+                            ifx_i2c_pl_schedule_status_poll(p_ctx, p_ctx->response_time_hint_us -
+                                                                   (p_ctx->response_time_hint_us >> 2));
+                            break;
+                        }
+                    }
+#endif
                     ifx_i2c_pl_read_register(p_ctx, PL_REG_I2C_STATE, PL_REG_LEN_I2C_STATE);
                     break;
                 }
@@ -577,8 +944,30 @@ _STATIC_H void ifx_i2c_pl_frame_event_handler(ifx_i2c_context_t * p_ctx, optiga_
                 && (0 != (p_ctx->pl.buffer[0] & PL_REG_I2C_STATE_RESPONSE_READY)))
                 {
                     frame_size = (p_ctx->pl.buffer[2] << 8) | p_ctx->pl.buffer[3];
-                    if ((frame_size > 0) && (frame_size <= p_ctx->frame_size))
+                    if ((frame_size > 0) && (frame_size <= p_ctx->negotiated_frame_size))
                     {
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+                        if (PL_RESPONSE_WAIT_POLLING == p_ctx->pl.response_wait_state)
+                        {
+                            // Measured execution time refines the expected execution time in the upper layer
+                            p_ctx->response_time_us = pal_os_timer_get_time_in_microseconds() -
+                                                      p_ctx->pl.response_wait_start_us;
+                            p_ctx->pl.response_wait_state = PL_RESPONSE_WAIT_IDLE;
+                        }
+#endif
+#if defined (OPTIGA_LIB_TRACE_ENABLED) || defined (OPTIGA_LIB_STATISTICS_ENABLED)
+                        if (TRUE == p_ctx->execution_pending)
+                        {
+                            p_ctx->execution_pending = FALSE;
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+                            execution_time_us = pal_os_timer_get_time_in_microseconds() - p_ctx->execution_start_us;
+                            p_ctx->statistics.busy_time_us += execution_time_us;
+                            ifx_i2c_pl_account_time(&p_ctx->statistics.execution_time_ms,
+                                                    &p_ctx->execution_time_remainder_us, execution_time_us);
+#endif
+                            OPTIGA_LIB_TRACE_END(OPTIGA_LIB_TRACE_LAYER_CHIP, frame_size);
+                        }
+#endif
                         p_ctx->pl.frame_state = PL_STATE_RXTX;
                         ifx_i2c_pl_read_register(p_ctx,PL_REG_DATA, frame_size);
                     }
@@ -594,15 +983,13 @@ _STATIC_H void ifx_i2c_pl_frame_event_handler(ifx_i2c_context_t * p_ctx, optiga_
                         // Continue polling STATUS register if retry limit is not reached
                         if (time_stamp_diff < p_ctx->dl.data_poll_timeout)
                         {
-                            pal_os_event_register_callback_oneshot(p_ctx->pal_os_event_ctx,
-                                                                    ifx_i2c_pl_status_poll_callback,
-                                                                   (void * )p_ctx,
-                                                                   PL_DATA_POLLING_INVERVAL_US);
+                            ifx_i2c_pl_schedule_status_poll(p_ctx, ifx_i2c_pl_next_poll_interval(p_ctx));
                         }
                         else
                         {
                             p_ctx->pl.frame_state = PL_STATE_READY;
-                            p_ctx->pl.upper_layer_event_handler(p_ctx, IFX_I2C_STACK_ERROR, 0, 0);
+                            OPTIGA_LIB_TRACE_ERROR(OPTIGA_LIB_TRACE_LAYER_PL, p_ctx->pl.frame_action);
+                            IFX_I2C_DISPATCH_EVENT(p_ctx, p_ctx->pl.upper_layer_event_handler, IFX_I2C_STACK_ERROR, 0, 0);
                         }
                     }
                 }
@@ -629,52 +1016,69 @@ _STATIC_H void ifx_i2c_pl_frame_event_handler(ifx_i2c_context_t * p_ctx, optiga_
                     // Continue polling STATUS register if retry limit is not reached
                     if (time_stamp_diff < p_ctx->dl.data_poll_timeout)
                     {
-                        pal_os_event_register_callback_oneshot(p_ctx->pal_os_event_ctx,
-                                                               ifx_i2c_pl_status_poll_callback,
-                                                               (void * )p_ctx,
-                                                               PL_DATA_POLLING_INVERVAL_US);
+                        ifx_i2c_pl_schedule_status_poll(p_ctx, ifx_i2c_pl_next_poll_interval(p_ctx));
                     }
                     else
                     {
                         p_ctx->pl.frame_state = PL_STATE_READY;
-                        p_ctx->pl.upper_layer_event_handler(p_ctx, IFX_I2C_STACK_ERROR, 0, 0);
+                        OPTIGA_LIB_TRACE_ERROR(OPTIGA_LIB_TRACE_LAYER_PL, p_ctx->pl.frame_action);
+                        IFX_I2C_DISPATCH_EVENT(p_ctx, p_ctx->pl.upper_layer_event_handler, IFX_I2C_STACK_ERROR, 0, 0);
                     }
                 }
             }
             break;
+#ifdef OPTIGA_COMMS_SPECULATIVE_READ_ENABLED
+            // Speculatively read frame is reported as any other frame
+            case PL_STATE_SPECULATIVE_RX:
+#endif
             // Frame reading is complete
             case PL_STATE_RXTX:
             {
                 // Writing/reading of frame to/from DATA register complete
                 p_ctx->pl.frame_state = PL_STATE_READY;
-                p_ctx->pl.upper_layer_event_handler(p_ctx,IFX_I2C_STACK_SUCCESS,
-                                                    p_ctx->pl.buffer,
-                                                    p_ctx->pl.buffer_rx_len);
+#ifdef OPTIGA_COMMS_PL_NEGOTIATION_CACHE_ENABLED
+                // Cached negotiation is verified by the frame exchange
+                p_ctx->pl.negotiation_unverified = FALSE;
+#endif
+                OPTIGA_LIB_TRACE_END(OPTIGA_LIB_TRACE_LAYER_PL, p_ctx->pl.frame_action);
+                IFX_I2C_DISPATCH_EVENT(p_ctx, p_ctx->pl.upper_layer_event_handler, IFX_I2C_STACK_SUCCESS,
+                                       p_ctx->pl.buffer,
+                                       p_ctx->pl.buffer_rx_len);
             }
             break;
             default:
             {
                 // Default condition occurred
                 p_ctx->pl.frame_state = PL_STATE_INIT;
-                p_ctx->pl.upper_layer_event_handler(p_ctx, IFX_I2C_STACK_ERROR, 0, 0);
+                IFX_I2C_DISPATCH_EVENT(p_ctx, p_ctx->pl.upper_layer_event_handler, IFX_I2C_STACK_ERROR, 0, 0);
             }
             break;
         }
     }
 }
 
+#ifdef OPTIGA_COMMS_SPECULATIVE_READ_ENABLED
+_STATIC_H void ifx_i2c_pl_speculative_read_fallback_callback(void * p_ctx)
+{
+    // Frame length is not known anymore, hence the frame is read after polling the STATUS register
+    ifx_i2c_pl_frame_event_handler((ifx_i2c_context_t * )p_ctx, IFX_I2C_STACK_SUCCESS);
+}
+#endif
+
 _STATIC_H void ifx_i2c_pal_poll_callback(void * p_ctx)
 {
     ifx_i2c_context_t * p_local_ctx = (ifx_i2c_context_t * )p_ctx;
     if (PL_I2C_CMD_WRITE == p_local_ctx->pl.i2c_cmd)
     {
         LOG_PL("[IFX-PL]: Poll Timer elapsed -> Restart TX\n");
+        PL_I2C_TRANSFER_START(p_local_ctx);
         //lint --e{534} suppress "This is the last statement of asynchronous function hence return value is not checked"
         pal_i2c_write(p_local_ctx->p_pal_i2c_ctx, p_local_ctx->pl.buffer, p_local_ctx->pl.buffer_tx_len);
     }
     else if (PL_I2C_CMD_READ == p_local_ctx->pl.i2c_cmd)
     {
         LOG_PL("[IFX-PL]: Poll Timer elapsed  -> Restart Read Register -> Start TX\n");
+        PL_I2C_TRANSFER_START(p_local_ctx);
         //lint --e{534} suppress "This is the last statement of asynchronous function hence return value is not checked"
         pal_i2c_read(p_local_ctx->p_pal_i2c_ctx, p_local_ctx->pl.buffer, p_local_ctx->pl.buffer_rx_len);
     }
@@ -690,6 +1094,7 @@ _STATIC_H void ifx_i2c_pl_guard_time_callback(void * p_ctx)
         {
             LOG_PL("[IFX-PL]: GT done-> Start RX\n");
             p_local_ctx->pl.i2c_cmd = PL_I2C_CMD_READ;
+            PL_I2C_TRANSFER_START(p_local_ctx);
             //lint --e{534} suppress "This is the last statement of asynchronous function hence return value is not checked"
             pal_i2c_read(p_local_ctx->p_pal_i2c_ctx, p_local_ctx->pl.buffer, p_local_ctx->pl.buffer_rx_len);
         }
@@ -706,18 +1111,68 @@ _STATIC_H void ifx_i2c_pl_guard_time_callback(void * p_ctx)
     }
 }
 
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+_STATIC_H void ifx_i2c_pl_account_time(uint32_t * p_time_ms, uint32_t * p_remainder_us, uint32_t time_us)
+{
+    // The remainder is carried, hence the short intervals add up without loss
+    *p_remainder_us += time_us;
+    *p_time_ms += *p_remainder_us / 1000U;
+    *p_remainder_us %= 1000U;
+}
+#endif
+
 _STATIC_H void ifx_i2c_pl_pal_event_handler(void * p_ctx, optiga_lib_status_t event)
 {
     ifx_i2c_context_t * p_local_ctx = (ifx_i2c_context_t * )p_ctx;
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+    // Transfers while OPTIGA executes (status polling) are accounted by the execution time
+    if (FALSE == p_local_ctx->execution_pending)
+    {
+        ifx_i2c_pl_account_time(&p_local_ctx->statistics.i2c_time_ms, &p_local_ctx->i2c_time_remainder_us,
+                                pal_os_timer_get_time_in_microseconds() - p_local_ctx->i2c_transfer_start_us);
+    }
+#endif
     switch (event)
     {
         case PAL_I2C_EVENT_ERROR:
         case PAL_I2C_EVENT_BUSY:
+#ifdef OPTIGA_COMMS_SPECULATIVE_READ_ENABLED
+            if (PL_STATE_SPECULATIVE_RX == p_local_ctx->pl.frame_state)
+            {
+                // Slave has no frame ready yet, the read is not retried but continued with the STATUS register polling
+                LOG_PL("[IFX-PL]: Speculative read NACKed -> Poll STATUS register\n");
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+                p_local_ctx->statistics.speculative_read_fallbacks++;
+#endif
+                p_local_ctx->pl.frame_state = PL_STATE_READY;
+                PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(p_local_ctx->pal_os_event_ctx,
+                                                       ifx_i2c_pl_speculative_read_fallback_callback,
+                                                       p_local_ctx, PL_POLLING_INVERVAL_US);
+                break;
+            }
+#endif
             // Error event usually occurs when the device is in sleep mode and needs time to wake up
+#ifdef OPTIGA_CMD_HEALTH_MONITOR_ENABLED
+            // Retries are stopped, once the slave does not respond for the unresponsive time
+            if (PL_POLLING_MAX_CNT == p_local_ctx->pl.retry_counter)
+            {
+                p_local_ctx->pl.unresponsive_start_time = pal_os_timer_get_time_in_microseconds();
+            }
+            else if ((pal_os_timer_get_time_in_microseconds() - p_local_ctx->pl.unresponsive_start_time) >=
+                     (OPTIGA_COMMS_UNRESPONSIVE_TIME_MS * 1000U))
+            {
+                LOG_PL("[IFX-PL]: Slave unresponsive\n");
+                p_local_ctx->pl.retry_counter = 0;
+            }
+            else
+            {
+                // Slave is retried
+            }
+#endif
             if (p_local_ctx->pl.retry_counter--)
             {
                 LOG_PL("[IFX-PL]: PAL Error -> Continue polling\n");
-                pal_os_event_register_callback_oneshot(p_local_ctx->pal_os_event_ctx,
+                PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(p_local_ctx->pal_os_event_ctx,
                                                         ifx_i2c_pal_poll_callback, p_local_ctx, PL_POLLING_INVERVAL_US);
             }
             else
@@ -729,7 +1184,11 @@ _STATIC_H void ifx_i2c_pl_pal_event_handler(void * p_ctx, optiga_lib_status_t ev
 
         case PAL_I2C_EVENT_SUCCESS:
             LOG_PL("[IFX-PL]: PAL Success -> Wait Guard Time\n");
-            pal_os_event_register_callback_oneshot(p_local_ctx->pal_os_event_ctx, ifx_i2c_pl_guard_time_callback,
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+            p_local_ctx->statistics.bus_bytes += (PL_I2C_CMD_WRITE == p_local_ctx->pl.i2c_cmd) ?
+                                                  p_local_ctx->pl.buffer_tx_len : p_local_ctx->pl.buffer_rx_len;
+#endif
+            PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(p_local_ctx->pal_os_event_ctx, ifx_i2c_pl_guard_time_callback,
                                                     p_local_ctx,PL_GUARD_TIME_INTERVAL_US);
             break;
         default:
@@ -771,9 +1230,9 @@ _STATIC_H void ifx_i2c_pl_soft_reset(ifx_i2c_context_t * p_ctx)
         case PL_RESET_STARTUP:
         {
             p_ctx->pl.request_soft_reset= PL_RESET_INIT;
-            pal_os_event_register_callback_oneshot(p_ctx->pal_os_event_ctx,(register_callback)ifx_i2c_pl_soft_reset,
+            PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT(p_ctx->pal_os_event_ctx,(register_callback)ifx_i2c_pl_soft_reset,
                                                    (void * )p_ctx,
-                                                   STARTUP_TIME_MSEC);
+                                                   STARTUP_WAIT_TIME_USEC);
             break;
         }
         case PL_RESET_INIT:
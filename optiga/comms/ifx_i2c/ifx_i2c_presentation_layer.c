@@ -35,10 +35,13 @@
 * @{
 */
 
+#include "optiga/ifx_i2c/ifx_i2c.h"
 #include "optiga/ifx_i2c/ifx_i2c_presentation_layer.h"
 #include "optiga/ifx_i2c/ifx_i2c_transport_layer.h"
 #include "optiga/pal/pal_crypt.h"
 #include "optiga/common/optiga_lib_common.h"
+#include "optiga/common/optiga_lib_trace.h"
+#include "optiga/common/optiga_lib_profile.h"
 #include "optiga/pal/pal_ifx_i2c_config.h"
 // include lower layer header
 /// @cond hidden
@@ -114,6 +117,16 @@
 #define PRL_SLAVE_HELLO_LENGTH               (0x26)
 #define PRL_NONCE_LENGTH                     (0x08)
 
+///Direction of the record, index of the nonce and associated data templates
+#define PRL_DIRECTION_MASTER                 (0x00)
+#define PRL_DIRECTION_SLAVE                  (0x01)
+
+///Associated data offsets
+#define PRL_AD_SCTR_OFFSET                   (0x00)
+#define PRL_AD_SEQ_NUMBER_OFFSET             (0x01)
+#define PRL_AD_PROTOCOL_VERSION_OFFSET       (0x05)
+#define PRL_AD_LENGTH_OFFSET                 (0x06)
+
 ///Manage context message type
 #define PRL_SAVE_CONTEXT_MSG                 (0x60)
 #define PRL_CONTEXT_SAVED_MSG                (0x64)
@@ -146,6 +159,9 @@
 
 #define CLEAR_SESSION_CONTEXT(ctx){\
                               memset(ctx->prl.session_key,0,sizeof(ctx->prl.session_key));\
+                              memset(ctx->prl.nonce_template,0,sizeof(ctx->prl.nonce_template));\
+                              ctx->prl.frame_templates_valid = FALSE;\
+                              pal_crypt_release_keys(&ctx->prl.pal_crypt);\
                               ctx->prl.master_sequence_number = 0;\
                               ctx->prl.slave_sequence_number = 0;\
                               ctx->prl.save_slave_sequence_number = 0;\
@@ -219,6 +235,10 @@ optiga_lib_status_t ifx_i2c_prl_init(ifx_i2c_context_t * p_ctx,
         p_ctx->prl.return_status = IFX_I2C_STACK_SUCCESS;
         p_ctx->prl.hs_state = PRL_HS_SEND_HELLO;
         p_ctx->prl.alert_type = PRL_DEFAULT_ALERT;
+        p_ctx->prl.frame_templates_valid = FALSE;
+#ifdef OPTIGA_COMMS_KEY_ROLLOVER_ENABLED
+        p_ctx->prl.key_rollover_flag = FALSE;
+#endif
         return_status = IFX_I2C_STACK_SUCCESS;
     } while (FALSE);
     
@@ -239,7 +259,9 @@ optiga_lib_status_t ifx_i2c_prl_close(ifx_i2c_context_t * p_ctx, ifx_i2c_event_h
         p_ctx->prl.upper_layer_event_handler = handler;
         if (IFX_I2C_SESSION_CONTEXT_NONE == p_ctx->manage_context_operation)
         {
-            p_ctx->prl.upper_layer_event_handler(p_ctx, IFX_I2C_STACK_SUCCESS, 0, 0);
+            //lint --e{534} suppress "Crypt context is not NULL, hence return value is not required to be checked"
+            pal_crypt_release_keys(&p_ctx->prl.pal_crypt);
+            IFX_I2C_DISPATCH_EVENT(p_ctx, p_ctx->prl.upper_layer_event_handler, IFX_I2C_STACK_SUCCESS, 0, 0);
             return_status = IFX_I2C_STACK_SUCCESS;
             break;
         }
@@ -291,6 +313,10 @@ optiga_lib_status_t ifx_i2c_prl_transceive(ifx_i2c_context_t * p_ctx,
             (FULL_PROTECTION == (p_ctx->protection_level & PRL_PROTECTION_MASK)))
         {
             p_ctx->prl.p_recv_payload_buffer = p_rx_data;
+#ifdef OPTIGA_COMMS_ZERO_COPY_RX
+            // The protected response is decrypted in place, hence it is received completely in the rx buffer
+            p_ctx->p_rx_destination = NULL;
+#endif
         }
         else
         {
@@ -302,6 +328,9 @@ optiga_lib_status_t ifx_i2c_prl_transceive(ifx_i2c_context_t * p_ctx,
         p_ctx->prl.decryption_failure_counter = 0;
         p_ctx->prl.return_status = IFX_I2C_STACK_SUCCESS;
         p_ctx->prl.alert_type = PRL_DEFAULT_ALERT;
+#ifdef OPTIGA_COMMS_KEY_ROLLOVER_ENABLED
+        p_ctx->prl.key_rollover_flag = FALSE;
+#endif
 
         ifx_i2c_prl_event_handler(p_ctx,
                                   IFX_I2C_STACK_SUCCESS,
@@ -312,12 +341,68 @@ optiga_lib_status_t ifx_i2c_prl_transceive(ifx_i2c_context_t * p_ctx,
     return (return_status);
 }
 
+#ifdef OPTIGA_COMMS_KEY_ROLLOVER_ENABLED
+optiga_lib_status_t ifx_i2c_prl_rollover(ifx_i2c_context_t * p_ctx)
+{
+    optiga_lib_status_t return_status = IFX_I2C_STACK_ERROR;
+    LOG_PRL("[IFX-PRL]: Rollover\n");
+
+    do
+    {
+        // Presentation Layer must be idle and the secure channel must be established
+        if ((PRL_STATE_IDLE != p_ctx->prl.state) ||
+            (PRL_NEGOTIATION_DONE != p_ctx->prl.negotiation_state) ||
+            (PRL_RESTORE_NOT_DONE == p_ctx->prl.restore_context_flag))
+        {
+            break;
+        }
+        p_ctx->prl.data_retransmit_counter = 0;
+        p_ctx->prl.trans_repeat_status = FALSE;
+        p_ctx->prl.decryption_failure_counter = 0;
+        p_ctx->prl.return_status = IFX_I2C_STACK_SUCCESS;
+        p_ctx->prl.alert_type = PRL_DEFAULT_ALERT;
+        // Handshake is done as in the transceive, but the completion is reported without exchanging any data
+        p_ctx->prl.key_rollover_flag = TRUE;
+        p_ctx->prl.negotiation_state = PRL_NEGOTIATION_NOT_DONE;
+        p_ctx->prl.hs_state = PRL_HS_SEND_HELLO;
+        p_ctx->prl.state = PRL_STATE_HANDSHAKE;
+
+        ifx_i2c_prl_event_handler(p_ctx, IFX_I2C_STACK_SUCCESS, p_ctx->prl.prl_txrx_buffer, 0);
+        return_status = IFX_I2C_STACK_SUCCESS;
+    } while (FALSE);
+    return (return_status);
+}
+
+bool_t ifx_i2c_prl_rollover_due(const ifx_i2c_context_t * p_ctx)
+{
+    bool_t rollover_due = FALSE;
+
+    if ((PRL_STATE_IDLE == p_ctx->prl.state) && (PRL_NEGOTIATION_DONE == p_ctx->prl.negotiation_state))
+    {
+        if ((OPTIGA_COMMS_KEY_ROLLOVER_SEQUENCE_NUMBER <= p_ctx->prl.master_sequence_number) ||
+            (OPTIGA_COMMS_KEY_ROLLOVER_SEQUENCE_NUMBER <= p_ctx->prl.save_slave_sequence_number))
+        {
+            rollover_due = TRUE;
+        }
+#if (0U != OPTIGA_COMMS_KEY_ROLLOVER_AGE_MS)
+        if ((uint32_t)OPTIGA_COMMS_KEY_ROLLOVER_AGE_MS <=
+            (pal_os_timer_get_time_in_milliseconds() - p_ctx->prl.session_start_time))
+        {
+            // Age is calculated as difference, which also holds if the time stamp has overflowed
+            rollover_due = TRUE;
+        }
+#endif
+    }
+    return (rollover_due);
+}
+#endif
+
 _STATIC_H optiga_lib_status_t ifx_i2c_prl_prf(ifx_i2c_context_t * p_ctx)
 {
     optiga_lib_status_t return_status = IFX_I2C_HANDSHAKE_ERROR;
     uint8_t label_input[] = PRL_LABEL;
     uint8_t secret_input[OPTIGA_SHARED_SECRET_MAX_LENGTH];
-    uint16_t shared_secret_length;
+    uint16_t shared_secret_length = sizeof(secret_input);
     do
     {
         //Reading pre-shared secret from datastore
@@ -329,6 +414,10 @@ _STATIC_H optiga_lib_status_t ifx_i2c_prl_prf(ifx_i2c_context_t * p_ctx)
             return_status = IFX_I2C_HANDSHAKE_ERROR;
             break;
         }
+        // Key schedules of the previous session keys are not used anymore
+        //lint --e{534} suppress "Crypt context is not NULL, hence return value is not required to be checked"
+        pal_crypt_release_keys(&p_ctx->prl.pal_crypt);
+        p_ctx->prl.frame_templates_valid = FALSE;
         if (PAL_STATUS_SUCCESS != pal_crypt_tls_prf_sha256(NULL, secret_input,
                                                            shared_secret_length,
                                                            label_input,
@@ -346,15 +435,43 @@ _STATIC_H optiga_lib_status_t ifx_i2c_prl_prf(ifx_i2c_context_t * p_ctx)
     return (return_status);
 }
 
+/*
+* Prepares the nonce and associated data templates of both directions from the current session key.
+* Only the per record fields are patched in the templates afterwards.
+*/
+_STATIC_H void ifx_i2c_prl_prepare_frame_templates(ifx_i2c_context_t * p_ctx)
+{
+    memcpy(p_ctx->prl.nonce_template[PRL_DIRECTION_MASTER],
+           &p_ctx->prl.session_key[PRL_MASTER_ENCRYPTION_NONCE_OFFSET],
+           PRL_MASTER_NONCE_LENGTH);
+    memcpy(p_ctx->prl.nonce_template[PRL_DIRECTION_SLAVE],
+           &p_ctx->prl.session_key[PRL_MASTER_DECRYPTION_NONCE_OFFSET],
+           PRL_MASTER_NONCE_LENGTH);
+    p_ctx->prl.associate_data[PRL_DIRECTION_MASTER][PRL_AD_PROTOCOL_VERSION_OFFSET] = p_ctx->protocol_version;
+    p_ctx->prl.associate_data[PRL_DIRECTION_SLAVE][PRL_AD_PROTOCOL_VERSION_OFFSET] = p_ctx->protocol_version;
+    p_ctx->prl.frame_templates_valid = TRUE;
+}
+
+/*
+* Patches the nonce and associated data templates of the direction with the fields of the record
+*/
 _STATIC_H void ifx_i2c_prl_form_associated_data(ifx_i2c_context_t * p_ctx,
+                                                uint8_t direction,
                                                 uint16_t data_len,
                                                 uint32_t seq_number,
                                                 uint8_t sctr)
 {
-    p_ctx->prl.associate_data[0] = sctr;
-    optiga_common_set_uint32(&p_ctx->prl.associate_data[1], seq_number);
-    p_ctx->prl.associate_data[5] = p_ctx->protocol_version;
-    optiga_common_set_uint16(&p_ctx->prl.associate_data[6], data_len);
+    uint8_t * p_associate_data = p_ctx->prl.associate_data[direction];
+
+    if ((FALSE == p_ctx->prl.frame_templates_valid) ||
+        (p_ctx->protocol_version != p_associate_data[PRL_AD_PROTOCOL_VERSION_OFFSET]))
+    {
+        ifx_i2c_prl_prepare_frame_templates(p_ctx);
+    }
+    p_associate_data[PRL_AD_SCTR_OFFSET] = sctr;
+    optiga_common_set_uint32(&p_associate_data[PRL_AD_SEQ_NUMBER_OFFSET], seq_number);
+    optiga_common_set_uint16(&p_associate_data[PRL_AD_LENGTH_OFFSET], data_len);
+    optiga_common_set_uint32(&p_ctx->prl.nonce_template[direction][PRL_MASTER_NONCE_LENGTH], seq_number);
 }
 
 _STATIC_H optiga_lib_status_t ifx_i2c_prl_encrypt_msg(ifx_i2c_context_t * p_ctx,
@@ -364,24 +481,23 @@ _STATIC_H optiga_lib_status_t ifx_i2c_prl_encrypt_msg(ifx_i2c_context_t * p_ctx,
                                                       uint8_t sctr)
 {
     optiga_lib_status_t return_status = IFX_I2C_STACK_ERROR;
-    uint8_t nonce_data[PRL_NONCE_LENGTH];
+    OPTIGA_LIB_PROFILE_DECLARE(profile_start)
+    OPTIGA_LIB_TRACE_BEGIN(OPTIGA_LIB_TRACE_LAYER_PRL, OPTIGA_LIB_TRACE_PRL_ENCRYPT);
+    OPTIGA_LIB_PROFILE_BEGIN(profile_start);
     do
     {
-        //Form associated data
-        ifx_i2c_prl_form_associated_data(p_ctx, data_len,seq_number,sctr);
-        //Prepare nonce data
-        memcpy(nonce_data, &p_ctx->prl.session_key[PRL_MASTER_ENCRYPTION_NONCE_OFFSET], PRL_MASTER_NONCE_LENGTH);
-        optiga_common_set_uint32(&nonce_data[PRL_MASTER_NONCE_LENGTH], seq_number);
+        //Form associated data and nonce data
+        ifx_i2c_prl_form_associated_data(p_ctx, PRL_DIRECTION_MASTER, data_len, seq_number, sctr);
 
-        if (PAL_STATUS_SUCCESS != (pal_crypt_encrypt_aes128_ccm(NULL,
+        if (PAL_STATUS_SUCCESS != (pal_crypt_encrypt_aes128_ccm(&p_ctx->prl.pal_crypt,
                                                                 p_data,
                                                                 data_len,
                                                                 &p_ctx->prl.
                                                                 session_key[PRL_MASTER_ENCRYPTION_KEY_OFFSET],
-                                                                nonce_data, PRL_MASTER_NONCE_LENGTH + 
-                                                                PRL_SEQ_NUMBER_LENGTH,
-                                                                p_ctx->prl.associate_data,
-                                                                sizeof(p_ctx->prl.associate_data),
+                                                                p_ctx->prl.nonce_template[PRL_DIRECTION_MASTER],
+                                                                PRL_NONCE_LENGTH,
+                                                                p_ctx->prl.associate_data[PRL_DIRECTION_MASTER],
+                                                                sizeof(p_ctx->prl.associate_data[PRL_DIRECTION_MASTER]),
                                                                 IFX_I2C_PRL_MAC_SIZE,
                                                                 p_data)))
         {
@@ -389,6 +505,9 @@ _STATIC_H optiga_lib_status_t ifx_i2c_prl_encrypt_msg(ifx_i2c_context_t * p_ctx,
         }
         return_status = IFX_I2C_STACK_SUCCESS;
     } while (FALSE);
+    OPTIGA_LIB_PROFILE_END(OPTIGA_LIB_PROFILE_PRL_ENCRYPT, profile_start, data_len);
+    OPTIGA_LIB_TRACE_COMPLETE(OPTIGA_LIB_TRACE_LAYER_PRL, OPTIGA_LIB_TRACE_PRL_ENCRYPT,
+                              (IFX_I2C_STACK_SUCCESS == return_status));
     return (return_status);
 }
 
@@ -397,28 +516,28 @@ _STATIC_H optiga_lib_status_t ifx_i2c_prl_decrypt_msg(ifx_i2c_context_t * p_ctx,
                                                       uint16_t data_len,
                                                       uint32_t seq_number,
                                                       uint8_t * out_data,
-                                                      uint8_t decrypt_key_offset,
-                                                      uint8_t decrypt_nonce_offset,
+                                                      uint8_t direction,
                                                       uint8_t sctr)
 {
     optiga_lib_status_t return_status = IFX_I2C_STACK_ERROR;
-    uint8_t nonce_data[PRL_NONCE_LENGTH];
+    OPTIGA_LIB_PROFILE_DECLARE(profile_start)
+    OPTIGA_LIB_TRACE_BEGIN(OPTIGA_LIB_TRACE_LAYER_PRL, OPTIGA_LIB_TRACE_PRL_DECRYPT);
+    OPTIGA_LIB_PROFILE_BEGIN(profile_start);
     do
     {
-        //Form associated data
-        ifx_i2c_prl_form_associated_data(p_ctx, data_len, seq_number, sctr);
-        //Prepare nonce data
-        memcpy(nonce_data, &p_ctx->prl.session_key[decrypt_nonce_offset], PRL_MASTER_NONCE_LENGTH);
-        optiga_common_set_uint32(&nonce_data[PRL_MASTER_NONCE_LENGTH], seq_number);
+        //Form associated data and nonce data
+        ifx_i2c_prl_form_associated_data(p_ctx, direction, data_len, seq_number, sctr);
 
-        if (PAL_STATUS_SUCCESS != (pal_crypt_decrypt_aes128_ccm(NULL,
+        if (PAL_STATUS_SUCCESS != (pal_crypt_decrypt_aes128_ccm(&p_ctx->prl.pal_crypt,
                                                                 p_data,
                                                                 (data_len + IFX_I2C_PRL_MAC_SIZE),
-                                                                &p_ctx->prl.session_key[decrypt_key_offset],
-                                                                nonce_data,
-                                                                PRL_MASTER_NONCE_LENGTH + PRL_SEQ_NUMBER_LENGTH,
-                                                                p_ctx->prl.associate_data,
-                                                                sizeof(p_ctx->prl.associate_data),
+                                                                &p_ctx->prl.session_key[(PRL_DIRECTION_MASTER == direction) ?
+                                                                                        PRL_MASTER_ENCRYPTION_KEY_OFFSET :
+                                                                                        PRL_MASTER_DECRYPTION_KEY_OFFSET],
+                                                                p_ctx->prl.nonce_template[direction],
+                                                                PRL_NONCE_LENGTH,
+                                                                p_ctx->prl.associate_data[direction],
+                                                                sizeof(p_ctx->prl.associate_data[direction]),
                                                                 IFX_I2C_PRL_MAC_SIZE,
                                                                 out_data)))
         {
@@ -426,6 +545,9 @@ _STATIC_H optiga_lib_status_t ifx_i2c_prl_decrypt_msg(ifx_i2c_context_t * p_ctx,
         }
         return_status = IFX_I2C_STACK_SUCCESS;
     } while (FALSE);
+    OPTIGA_LIB_PROFILE_END(OPTIGA_LIB_PROFILE_PRL_DECRYPT, profile_start, data_len);
+    OPTIGA_LIB_TRACE_COMPLETE(OPTIGA_LIB_TRACE_LAYER_PRL, OPTIGA_LIB_TRACE_PRL_DECRYPT,
+                              (IFX_I2C_STACK_SUCCESS == return_status));
     return (return_status);
 }
 
@@ -438,6 +560,9 @@ _STATIC_H optiga_lib_status_t ifx_i2c_prl_send_alert(ifx_i2c_context_t * p_ctx)
         if (PRL_INTEGRITY_VIOLATED_ALERT_MSG == p_ctx->prl.alert_type)
         {
             p_ctx->prl.decryption_failure_counter++;
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+            p_ctx->statistics.decryption_failures++;
+#endif
             p_ctx->prl.state = PRL_STATE_VERIFY;
             p_ctx->prl.return_status = IFX_I2C_STACK_SUCCESS;
             //lint --e{835} suppress "Protection bits in SCTR is set to 0 for alert message"
@@ -589,8 +714,7 @@ _STATIC_H optiga_lib_status_t ifx_i2c_prl_do_handshake(ifx_i2c_context_t * p_ctx
                                                         PRL_RANDOM_DATA_LENGTH + PRL_SEQ_NUMBER_LENGTH,
                                                         p_ctx->prl.master_sequence_number,
                                                         p_ctx->prl.prl_txrx_buffer,
-                                                        PRL_MASTER_DECRYPTION_KEY_OFFSET,
-                                                        PRL_MASTER_DECRYPTION_NONCE_OFFSET,
+                                                        PRL_DIRECTION_SLAVE,
                                                         p_ctx->prl.sctr);
                 if (IFX_I2C_STACK_ERROR == return_status)
                 {
@@ -667,7 +791,7 @@ _STATIC_H optiga_lib_status_t ifx_i2c_prl_do_manage_context(ifx_i2c_context_t *
                 if (OPTIGA_LIB_PAL_DATA_STORE_NOT_CONFIGURED != p_ctx->ifx_i2c_datastore_config->datastore_manage_context_id)
                 {
                     p_ctx->prl.prl_receive_length = sizeof(p_ctx->prl.prl_saved_ctx);
-                    return_status = pal_os_datastore_read(p_ctx->ifx_i2c_datastore_config->datastore_manage_context_id,
+                    return_status = PAL_OS_DATASTORE_READ(p_ctx->ifx_i2c_datastore_config->datastore_manage_context_id,
                                                           (uint8_t * )&p_ctx->prl.prl_saved_ctx,
                                                           &p_ctx->prl.prl_receive_length);
                     if (PAL_STATUS_FAILURE == return_status)
@@ -713,7 +837,7 @@ _STATIC_H optiga_lib_status_t ifx_i2c_prl_do_manage_context(ifx_i2c_context_t *
                 if (OPTIGA_LIB_PAL_DATA_STORE_NOT_CONFIGURED != p_ctx->ifx_i2c_datastore_config->datastore_manage_context_id)
                 {
                     memset((uint8_t * )&prl_saved_ctx,0,sizeof(prl_saved_ctx));
-                    return_status = pal_os_datastore_write(p_ctx->ifx_i2c_datastore_config->datastore_manage_context_id,
+                    return_status = PAL_OS_DATASTORE_WRITE(p_ctx->ifx_i2c_datastore_config->datastore_manage_context_id,
                                                            (uint8_t * )&prl_saved_ctx,
                                                            sizeof(prl_saved_ctx));
                     if (PAL_STATUS_FAILURE == return_status)
@@ -753,6 +877,11 @@ _STATIC_H optiga_lib_status_t ifx_i2c_prl_do_manage_context(ifx_i2c_context_t *
             {
                 ///Restore the saved context to active context structure
                 COPY_MANAGE_CONTEXT_DATA(p_ctx->prl.prl_saved_ctx,p_ctx->prl);
+                p_ctx->prl.frame_templates_valid = FALSE;
+#ifdef OPTIGA_COMMS_KEY_ROLLOVER_ENABLED
+                // Age of the restored session is counted from the restore
+                p_ctx->prl.session_start_time = pal_os_timer_get_time_in_milliseconds();
+#endif
                 p_ctx->prl.restore_context_flag = PRL_RESTORE_DONE;
                 p_ctx->prl.state = PRL_STATE_TXRX;
             }
@@ -766,7 +895,7 @@ _STATIC_H optiga_lib_status_t ifx_i2c_prl_do_manage_context(ifx_i2c_context_t *
                 {
                     ///Store active session to data store
                     p_ctx->prl.prl_receive_length = sizeof(p_ctx->prl.prl_saved_ctx);
-                    return_status = pal_os_datastore_write(p_ctx->ifx_i2c_datastore_config->datastore_manage_context_id,
+                    return_status = PAL_OS_DATASTORE_WRITE(p_ctx->ifx_i2c_datastore_config->datastore_manage_context_id,
                                                            (uint8_t * )&p_ctx->prl.prl_saved_ctx,
                                                            p_ctx->prl.prl_receive_length);
                     if (PAL_STATUS_SUCCESS != return_status)
@@ -784,7 +913,7 @@ _STATIC_H optiga_lib_status_t ifx_i2c_prl_do_manage_context(ifx_i2c_context_t *
                 memset((uint8_t * )&p_ctx->prl.prl_saved_ctx,0,sizeof(p_ctx->prl.prl_saved_ctx));
                 if (OPTIGA_LIB_PAL_DATA_STORE_NOT_CONFIGURED != p_ctx->ifx_i2c_datastore_config->datastore_manage_context_id)
                 {
-                    return_status = pal_os_datastore_write(p_ctx->ifx_i2c_datastore_config->datastore_manage_context_id,
+                    return_status = PAL_OS_DATASTORE_WRITE(p_ctx->ifx_i2c_datastore_config->datastore_manage_context_id,
                                                            (uint8_t * )&p_ctx->prl.prl_saved_ctx,
                                                            sizeof(p_ctx->prl.prl_saved_ctx));
                 }
@@ -843,7 +972,7 @@ _STATIC_H void ifx_i2c_prl_event_handler(ifx_i2c_context_t * p_ctx,
             case PRL_STATE_IDLE:
             {
                 LOG_PRL("[IFX-PRL]: PRL_STATE_IDLE %d\n", p_ctx->prl.return_status);
-                p_ctx->prl.upper_layer_event_handler(p_ctx, p_ctx->prl.return_status, 0, 0);
+                IFX_I2C_DISPATCH_EVENT(p_ctx, p_ctx->prl.upper_layer_event_handler, p_ctx->prl.return_status, 0, 0);
                 exit_machine = FALSE;
             }
             break;
@@ -880,7 +1009,7 @@ _STATIC_H void ifx_i2c_prl_event_handler(ifx_i2c_context_t * p_ctx,
                 memset((uint8_t * )&prl_saved_ctx,0,sizeof(prl_saved_ctx));
                 if (OPTIGA_LIB_PAL_DATA_STORE_NOT_CONFIGURED != p_ctx->ifx_i2c_datastore_config->datastore_manage_context_id)
                 {
-                    return_status = pal_os_datastore_write(p_ctx->ifx_i2c_datastore_config->datastore_manage_context_id,
+                    return_status = PAL_OS_DATASTORE_WRITE(p_ctx->ifx_i2c_datastore_config->datastore_manage_context_id,
                                                            (uint8_t * )&prl_saved_ctx,
                                                            sizeof(prl_saved_ctx));
                     if (PAL_STATUS_SUCCESS != return_status)
@@ -900,7 +1029,19 @@ _STATIC_H void ifx_i2c_prl_event_handler(ifx_i2c_context_t * p_ctx,
 
                 if (PRL_NEGOTIATION_DONE == p_ctx->prl.negotiation_state)
                 {
-                    p_ctx->prl.state = PRL_STATE_TXRX;
+#ifdef OPTIGA_COMMS_KEY_ROLLOVER_ENABLED
+                    p_ctx->prl.session_start_time = pal_os_timer_get_time_in_milliseconds();
+                    if (TRUE == p_ctx->prl.key_rollover_flag)
+                    {
+                        // No data to be exchanged, the completion is reported in idle state
+                        p_ctx->prl.key_rollover_flag = FALSE;
+                        p_ctx->prl.state = PRL_STATE_IDLE;
+                    }
+                    else
+#endif
+                    {
+                        p_ctx->prl.state = PRL_STATE_TXRX;
+                    }
                 }
                 else
                 {
@@ -946,8 +1087,7 @@ _STATIC_H void ifx_i2c_prl_event_handler(ifx_i2c_context_t * p_ctx,
                                                                 p_ctx->prl.actual_payload_length,
                                                                 p_ctx->prl.master_sequence_number,
                                                                 &p_ctx->prl.p_actual_payload[IFX_I2C_PRL_HEADER_SIZE],
-                                                                PRL_MASTER_ENCRYPTION_KEY_OFFSET,
-                                                                PRL_MASTER_ENCRYPTION_NONCE_OFFSET,
+                                                                PRL_DIRECTION_MASTER,
                                                                 p_ctx->prl.saved_sctr);
                         if (IFX_I2C_STACK_ERROR == return_status)
                         {
@@ -1067,8 +1207,7 @@ _STATIC_H void ifx_i2c_prl_event_handler(ifx_i2c_context_t * p_ctx,
                                                             (*p_ctx->prl.p_recv_payload_buffer_length),
                                                             p_ctx->prl.slave_sequence_number,
                                                             &p_ctx->prl.p_recv_payload_buffer[IFX_I2C_PRL_HEADER_SIZE],
-                                                            PRL_MASTER_DECRYPTION_KEY_OFFSET,
-                                                            PRL_MASTER_DECRYPTION_NONCE_OFFSET,
+                                                            PRL_DIRECTION_SLAVE,
                                                             p_ctx->prl.saved_sctr);
                     if (IFX_I2C_STACK_ERROR == return_status)
                     {
@@ -1159,7 +1298,7 @@ _STATIC_H void ifx_i2c_prl_event_handler(ifx_i2c_context_t * p_ctx,
             default:
             {
                 p_ctx->prl.state = PRL_STATE_IDLE;
-                p_ctx->prl.upper_layer_event_handler(p_ctx, IFX_I2C_STACK_ERROR, 0, 0);
+                IFX_I2C_DISPATCH_EVENT(p_ctx, p_ctx->prl.upper_layer_event_handler, IFX_I2C_STACK_ERROR, 0, 0);
                 exit_machine = FALSE;
             }
             break;
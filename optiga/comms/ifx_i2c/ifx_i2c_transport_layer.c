@@ -35,8 +35,11 @@
 * @{
 */
 
+#include "optiga/ifx_i2c/ifx_i2c.h"
 #include "optiga/ifx_i2c/ifx_i2c_transport_layer.h"
 #include "optiga/ifx_i2c/ifx_i2c_data_link_layer.h" // include lower layer header
+#include "optiga/common/optiga_lib_trace.h"
+#include "optiga/common/optiga_lib_profile.h"
 
 /// @cond hidden
 
@@ -63,6 +66,7 @@
 #define TL_PCTR_INVALID                     (0xFF)
 #define TL_PREVIOUS_CHAINING_STATUS         (0x02)
 #define TL_CURRENT_CHAINING_STATUS          (0x08)
+#define IFX_I2C_TL_NO_RX_DESTINATION        (0xFFFF)
 // Setup debug log statements
 #if IFX_I2C_LOG_TL == 1
 #define LOG_TL IFX_I2C_LOG
@@ -90,6 +94,8 @@ _STATIC_H optiga_lib_status_t ifx_i2c_tl_resend_packets(ifx_i2c_context_t * p_ct
 _STATIC_H optiga_lib_status_t ifx_i2c_tl_send_chaining_error(ifx_i2c_context_t * p_ctx);
 _STATIC_H uint8_t ifx_i2c_tl_calculate_pctr(const ifx_i2c_context_t * p_ctx);
 _STATIC_H optiga_lib_status_t ifx_i2c_tl_check_chaining_error(uint8_t current_chaning, uint8_t previous_chaining);
+_STATIC_H uint8_t ifx_i2c_tl_is_rx_overflow(const ifx_i2c_context_t * p_ctx, uint16_t payload_len);
+_STATIC_H void ifx_i2c_tl_store_payload(ifx_i2c_context_t * p_ctx, const uint8_t * p_payload, uint16_t payload_len);
 /// @endcond
 
 optiga_lib_status_t ifx_i2c_tl_init(ifx_i2c_context_t * p_ctx, ifx_i2c_event_handler_t handler)
@@ -106,7 +112,6 @@ optiga_lib_status_t ifx_i2c_tl_init(ifx_i2c_context_t * p_ctx, ifx_i2c_event_han
     p_ctx->tl.initialization_state = TRUE;
     p_ctx->tl.upper_layer_event_handler = handler;
     p_ctx->tl.state = TL_STATE_IDLE;
-    p_ctx->tl.max_packet_length = p_ctx->frame_size - (DL_HEADER_SIZE + TL_HEADER_SIZE);
 
     return (IFX_I2C_STACK_SUCCESS);
 }
@@ -141,16 +146,31 @@ optiga_lib_status_t ifx_i2c_tl_transceive(ifx_i2c_context_t * p_ctx,
         p_ctx->tl.p_recv_packet_buffer = p_recv_packet;
         p_ctx->tl.p_recv_packet_buffer_length = p_recv_packet_len;
         p_ctx->tl.total_recv_length = 0;
+#ifdef OPTIGA_COMMS_ZERO_COPY_RX
+        // The packet is received in the upper layer rx buffer in plain, if the destination is within the packet
+        p_ctx->tl.rx_destination_offset = IFX_I2C_TL_NO_RX_DESTINATION;
+        p_ctx->rx_destination_length = 0;
+        if ((NULL != p_ctx->p_rx_destination) && (NULL != p_ctx->p_upper_layer_rx_buffer) &&
+            (p_recv_packet >= p_ctx->p_upper_layer_rx_buffer) &&
+            (p_recv_packet <= p_ctx->p_rx_destination_start))
+        {
+            p_ctx->tl.rx_destination_offset = (uint16_t)(p_ctx->p_rx_destination_start - p_recv_packet);
+        }
+#endif
         p_ctx->tl.chaining_error_count = 0;
         p_ctx->tl.master_chaining_error_count = 0;
         p_ctx->tl.transmission_completed = 0;
         p_ctx->tl.error_event = IFX_I2C_STACK_ERROR;
+        OPTIGA_LIB_TRACE_BEGIN(OPTIGA_LIB_TRACE_LAYER_TL, packet_len);
         status = ifx_i2c_tl_send_next_fragment(p_ctx);
     } while (FALSE);
     return (status);
 }
 
 
+// Resends the packet after a chaining error reported by OPTIGA. A lost or corrupted fragment is already resent
+// alone by the data link layer (frame retransmission and resynchronization keep the packet offset). A chaining
+// error means OPTIGA has discarded the fragments received so far, hence the packet is sent from the first fragment.
 _STATIC_H optiga_lib_status_t ifx_i2c_tl_resend_packets(ifx_i2c_context_t * p_ctx)
 {
     // Transport Layer must be idle
@@ -159,6 +179,9 @@ _STATIC_H optiga_lib_status_t ifx_i2c_tl_resend_packets(ifx_i2c_context_t * p_ct
         return (IFX_I2C_STACK_ERROR);
     }
 
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+    p_ctx->statistics.chaining_resent_bytes += p_ctx->tl.packet_offset;
+#endif
     p_ctx->tl.packet_offset = 0;
     p_ctx->tl.total_recv_length = 0;
     p_ctx->tl.state = TL_STATE_TX;
@@ -193,25 +216,103 @@ _STATIC_H uint8_t ifx_i2c_tl_calculate_pctr(const ifx_i2c_context_t * p_ctx)
 
     return (pctr);
 }
+#ifdef OPTIGA_COMMS_ZERO_COPY_TX
+// Returns the frame buffer for the fragment. A packet sent in one fragment is framed in place, if it is within
+// the upper layer tx data, which has room reserved for the headers and checksum
+_STATIC_H uint8_t * ifx_i2c_tl_get_tx_frame(const ifx_i2c_context_t * p_ctx, uint16_t tl_fragment_size)
+{
+    uint8_t * p_frame = (uint8_t * )p_ctx->tx_frame_buffer;
+
+    if ((0 == p_ctx->tl.packet_offset) && (p_ctx->tl.actual_packet_length == tl_fragment_size) &&
+        (NULL != p_ctx->p_upper_layer_tx_data) &&
+        (p_ctx->tl.p_actual_packet >= p_ctx->p_upper_layer_tx_data) &&
+        ((p_ctx->tl.p_actual_packet + tl_fragment_size) <= p_ctx->p_upper_layer_tx_data_end))
+    {
+        p_frame = p_ctx->tl.p_actual_packet - IFX_I2C_TX_HEADROOM;
+    }
+    return (p_frame);
+}
+#endif
+
+// Checks, if the payload of the received fragment exceeds the receive buffer or the rx destination
+_STATIC_H uint8_t ifx_i2c_tl_is_rx_overflow(const ifx_i2c_context_t * p_ctx, uint16_t payload_len)
+{
+    uint8_t is_overflow = FALSE;
+    uint32_t end_of_payload = (uint32_t)p_ctx->tl.total_recv_length + payload_len;
+
+    if (end_of_payload > (*p_ctx->tl.p_recv_packet_buffer_length))
+    {
+        is_overflow = TRUE;
+    }
+#ifdef OPTIGA_COMMS_ZERO_COPY_RX
+    else if ((end_of_payload > p_ctx->tl.rx_destination_offset) &&
+             ((end_of_payload - p_ctx->tl.rx_destination_offset) > p_ctx->rx_destination_size))
+    {
+        is_overflow = TRUE;
+    }
+#endif
+    else
+    {
+        // payload fits
+    }
+    return (is_overflow);
+}
+
+// Stores the payload of the received fragment at the current position of the packet, the bytes from the
+// rx destination offset onwards are stored to the rx destination instead of the receive buffer
+_STATIC_H void ifx_i2c_tl_store_payload(ifx_i2c_context_t * p_ctx, const uint8_t * p_payload, uint16_t payload_len)
+{
+    uint16_t buffer_len = payload_len;
+#ifdef OPTIGA_COMMS_ZERO_COPY_RX
+    uint16_t destination_offset;
+
+    if (((uint32_t)p_ctx->tl.total_recv_length + payload_len) > p_ctx->tl.rx_destination_offset)
+    {
+        buffer_len = 0;
+        if (p_ctx->tl.total_recv_length < p_ctx->tl.rx_destination_offset)
+        {
+            buffer_len = p_ctx->tl.rx_destination_offset - p_ctx->tl.total_recv_length;
+        }
+        destination_offset = (p_ctx->tl.total_recv_length + buffer_len) - p_ctx->tl.rx_destination_offset;
+        memcpy(p_ctx->p_rx_destination + destination_offset, p_payload + buffer_len, payload_len - buffer_len);
+        p_ctx->rx_destination_length = destination_offset + (payload_len - buffer_len);
+    }
+#endif
+    memcpy(p_ctx->tl.p_recv_packet_buffer + p_ctx->tl.total_recv_length, p_payload, buffer_len);
+    p_ctx->tl.total_recv_length += payload_len;
+}
+
 _STATIC_H optiga_lib_status_t ifx_i2c_tl_send_next_fragment(ifx_i2c_context_t * p_ctx)
 {
     uint8_t pctr;
+    uint8_t * p_frame = p_ctx->tx_frame_buffer;
     // Calculate size of fragment (last one might be shorter)
     uint16_t tl_fragment_size = p_ctx->tl.max_packet_length;
+    OPTIGA_LIB_PROFILE_DECLARE(profile_start)
+    OPTIGA_LIB_PROFILE_BEGIN(profile_start);
     pctr = ifx_i2c_tl_calculate_pctr(p_ctx);
     if ((p_ctx->tl.actual_packet_length - p_ctx->tl.packet_offset) < tl_fragment_size)
     {
         tl_fragment_size = p_ctx->tl.actual_packet_length - p_ctx->tl.packet_offset;
     }
+#ifdef OPTIGA_COMMS_ZERO_COPY_TX
+    p_frame = ifx_i2c_tl_get_tx_frame(p_ctx, tl_fragment_size);
+    p_ctx->dl.p_tx_frame_buffer = p_frame;
+#endif
     // Assign the pctr
     //lint --e{835} suppress "IFX_I2C_DL_HEADER_OFFSET macro is defined as 0x00 and is kept for future enhancements"
-    p_ctx->tx_frame_buffer[IFX_I2C_TL_HEADER_OFFSET] = (pctr | IFX_I2C_PRESENCE_BIT);
-    //copy the data
-    //lint --e{835} suppress "IFX_I2C_DL_HEADER_OFFSET macro is defined as 0x00 and is kept for future enhancements"
-    memcpy(p_ctx->tx_frame_buffer+IFX_I2C_TL_HEADER_OFFSET + 1,
-           p_ctx->tl.p_actual_packet + p_ctx->tl.packet_offset,
-           tl_fragment_size);
+    p_frame[IFX_I2C_TL_HEADER_OFFSET] = (pctr | IFX_I2C_PRESENCE_BIT);
+    //copy the data, unless framed in place
+    if (p_frame == p_ctx->tx_frame_buffer)
+    {
+        //lint --e{835} suppress "IFX_I2C_DL_HEADER_OFFSET macro is defined as 0x00 and is kept for future enhancements"
+        memcpy(p_ctx->tx_frame_buffer+IFX_I2C_TL_HEADER_OFFSET + 1,
+               p_ctx->tl.p_actual_packet + p_ctx->tl.packet_offset,
+               tl_fragment_size);
+    }
     p_ctx->tl.packet_offset += tl_fragment_size;
+    // Exclusive of the data link layer
+    OPTIGA_LIB_PROFILE_END(OPTIGA_LIB_PROFILE_TL_FRAGMENT, profile_start, tl_fragment_size);
     //send the fragment to dl layer
     return (ifx_i2c_dl_send_frame(p_ctx,tl_fragment_size + 1));
 }
@@ -219,6 +320,9 @@ _STATIC_H optiga_lib_status_t ifx_i2c_tl_send_next_fragment(ifx_i2c_context_t *
 _STATIC_H optiga_lib_status_t ifx_i2c_tl_send_chaining_error(ifx_i2c_context_t * p_ctx)
 {
     uint16_t tl_fragment_size = 1;
+#ifdef OPTIGA_COMMS_ZERO_COPY_TX
+    p_ctx->dl.p_tx_frame_buffer = p_ctx->tx_frame_buffer;
+#endif
     //lint --e{835} suppress "IFX_I2C_DL_HEADER_OFFSET macro is defined as 0x00 and is kept for future enhancements"
     p_ctx->tx_frame_buffer[IFX_I2C_TL_HEADER_OFFSET] = 0x07;
     p_ctx->tl.total_recv_length = 0;
@@ -290,6 +394,13 @@ _STATIC_H void ifx_i2c_dl_event_handler(ifx_i2c_context_t * p_ctx,
             pctr = p_data[0];
             chaining = pctr & TL_PCTR_CHAIN_MASK;
         }
+#ifdef OPTIGA_COMMS_ZERO_COPY_TX
+        // Frame is acknowledged or failed, so it is not sent again from upper layer data
+        if (0 != (event & (IFX_I2C_DL_EVENT_TX_SUCCESS | IFX_I2C_DL_EVENT_ERROR)))
+        {
+            p_ctx->dl.p_tx_frame_buffer = p_ctx->tx_frame_buffer;
+        }
+#endif
         // Propagate errors to upper layer
         if (0 != (event & IFX_I2C_DL_EVENT_ERROR))
         {
@@ -304,13 +415,18 @@ _STATIC_H void ifx_i2c_dl_event_handler(ifx_i2c_context_t * p_ctx,
                 p_ctx->tl.error_event = IFX_I2C_STACK_ERROR;
             }
         }
+        if (TRUE == p_ctx->tl.initialization_state)
+        {
+            // Frame size is negotiated by the physical layer during the initialization
+            p_ctx->tl.max_packet_length = p_ctx->negotiated_frame_size - (DL_HEADER_SIZE + TL_HEADER_SIZE);
+        }
         p_ctx->tl.initialization_state = FALSE;
         switch (p_ctx->tl.state)
         {
             case TL_STATE_IDLE:
             {
                 exit_machine = FALSE;
-                p_ctx->tl.upper_layer_event_handler(p_ctx, IFX_I2C_STACK_SUCCESS, 0, 0);
+                IFX_I2C_DISPATCH_EVENT(p_ctx, p_ctx->tl.upper_layer_event_handler, IFX_I2C_STACK_SUCCESS, 0, 0);
             }
             break;
             case TL_STATE_TX:
@@ -352,6 +468,24 @@ _STATIC_H void ifx_i2c_dl_event_handler(ifx_i2c_context_t * p_ctx,
                         if (!(event & IFX_I2C_DL_EVENT_RX_SUCCESS))
                         {
                             LOG_TL("[IFX-TL]: Tx:Data already received after Tx\n");
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+                            // Response to the command of upper layer is awaited (not to a presentation layer handshake)
+                            if ((NULL != p_ctx->p_upper_layer_tx_data) &&
+                                (p_ctx->tl.p_actual_packet >= p_ctx->p_upper_layer_tx_data) &&
+                                ((p_ctx->tl.p_actual_packet + p_ctx->tl.actual_packet_length) <= p_ctx->p_upper_layer_tx_data_end))
+                            {
+                                p_ctx->pl.response_wait_state = PL_RESPONSE_WAIT_ARMED;
+                                p_ctx->pl.response_wait_start_us = pal_os_timer_get_time_in_microseconds();
+                            }
+#endif
+#if defined (OPTIGA_LIB_TRACE_ENABLED) || defined (OPTIGA_LIB_STATISTICS_ENABLED)
+                            // Ends, once the physical layer finds the response ready
+                            p_ctx->execution_pending = TRUE;
+#endif
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+                            p_ctx->execution_start_us = pal_os_timer_get_time_in_microseconds();
+#endif
+                            OPTIGA_LIB_TRACE_BEGIN(OPTIGA_LIB_TRACE_LAYER_CHIP, p_ctx->tl.actual_packet_length);
                             // Received CTRL frame, trigger reception in Data Link layer
                             if (0 != ifx_i2c_dl_receive_frame(p_ctx))
                             {
@@ -415,7 +549,7 @@ _STATIC_H void ifx_i2c_dl_event_handler(ifx_i2c_context_t * p_ctx,
                     {
                         LOG_TL("[IFX-TL]: Rx : No chain/Last chain received, Inform UL\n");
                         // Check for possible receive buffer overflow
-                        if ((p_ctx->tl.total_recv_length + data_len - 1) > (*p_ctx->tl.p_recv_packet_buffer_length))
+                        if (TRUE == ifx_i2c_tl_is_rx_overflow(p_ctx, data_len - 1))
                         {
                             LOG_TL("[IFX-TL]: Chain : Buffer overflow\n");
                             p_ctx->tl.error_event = IFX_I2C_STACK_MEM_ERROR;
@@ -424,14 +558,14 @@ _STATIC_H void ifx_i2c_dl_event_handler(ifx_i2c_context_t * p_ctx,
                         }
                         exit_machine = FALSE;
                         // Copy frame payload to transport layer receive buffer
-                        memcpy(p_ctx->tl.p_recv_packet_buffer + p_ctx->tl.total_recv_length, p_data + 1, data_len - 1);
-                        p_ctx->tl.total_recv_length += (data_len - 1);
+                        ifx_i2c_tl_store_payload(p_ctx, p_data + 1, data_len - 1);
                         // Inform upper layer that a packet has arrived
                         p_ctx->tl.state = TL_STATE_IDLE;
                         *p_ctx->tl.p_recv_packet_buffer_length = p_ctx->tl.total_recv_length;
-                        p_ctx->tl.upper_layer_event_handler(p_ctx,IFX_I2C_STACK_SUCCESS,
-                                                            p_ctx->tl.p_recv_packet_buffer,
-                                                            *p_ctx->tl.p_recv_packet_buffer_length);
+                        OPTIGA_LIB_TRACE_END(OPTIGA_LIB_TRACE_LAYER_TL, p_ctx->tl.total_recv_length);
+                        IFX_I2C_DISPATCH_EVENT(p_ctx, p_ctx->tl.upper_layer_event_handler, IFX_I2C_STACK_SUCCESS,
+                                               p_ctx->tl.p_recv_packet_buffer,
+                                               *p_ctx->tl.p_recv_packet_buffer_length);
                     }
                     else
                     {
@@ -458,7 +592,7 @@ _STATIC_H void ifx_i2c_dl_event_handler(ifx_i2c_context_t * p_ctx,
                     break;
                 }
                 // Check for possible receive buffer overflow
-                if ((p_ctx->tl.total_recv_length + data_len - 1) > (*p_ctx->tl.p_recv_packet_buffer_length))
+                if (TRUE == ifx_i2c_tl_is_rx_overflow(p_ctx, data_len - 1))
                 {
                     LOG_TL("[IFX-TL]: Chain : Buffer overflow\n");
                     p_ctx->tl.error_event = IFX_I2C_STACK_MEM_ERROR;
@@ -471,8 +605,7 @@ _STATIC_H void ifx_i2c_dl_event_handler(ifx_i2c_context_t * p_ctx,
                     break;
                 }
                 // Copy frame payload to transport layer receive buffer
-                memcpy(p_ctx->tl.p_recv_packet_buffer + p_ctx->tl.total_recv_length, p_data + 1, data_len - 1);
-                p_ctx->tl.total_recv_length += (data_len - 1);
+                ifx_i2c_tl_store_payload(p_ctx, p_data + 1, data_len - 1);
 
                 p_ctx->tl.previous_chaining = pctr & 0x07;
                 LOG_TL("[IFX-TL]: Chain : Continue  in receive mode\n");
@@ -495,6 +628,9 @@ _STATIC_H void ifx_i2c_dl_event_handler(ifx_i2c_context_t * p_ctx,
                     p_ctx->tl.state = TL_STATE_CHAINING_ERROR;
                     break;
                 }
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+                p_ctx->statistics.chaining_errors++;
+#endif
                 // Master Resend the packets,Resend only once, otherwise exit with error
                 if (0 == (p_ctx->tl.chaining_error_count++))
                 {
@@ -520,6 +656,9 @@ _STATIC_H void ifx_i2c_dl_event_handler(ifx_i2c_context_t * p_ctx,
             {
                 // Send chaining error to slave
                 p_ctx->tl.state = TL_STATE_TX;
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+                p_ctx->statistics.chaining_errors++;
+#endif
                 if (0 == (p_ctx->tl.master_chaining_error_count++))
                 {
                     LOG_TL("[IFX-TL]: Chain error : Sending chain error\n");
@@ -544,11 +683,19 @@ _STATIC_H void ifx_i2c_dl_event_handler(ifx_i2c_context_t * p_ctx,
             {
                 LOG_TL("[IFX-TL]: Error\n");
                 exit_machine = FALSE;
+#if defined (OPTIGA_LIB_TRACE_ENABLED) || defined (OPTIGA_LIB_STATISTICS_ENABLED)
+                if (TRUE == p_ctx->execution_pending)
+                {
+                    p_ctx->execution_pending = FALSE;
+                    OPTIGA_LIB_TRACE_ERROR(OPTIGA_LIB_TRACE_LAYER_CHIP, p_ctx->tl.actual_packet_length);
+                }
+#endif
+                OPTIGA_LIB_TRACE_ERROR(OPTIGA_LIB_TRACE_LAYER_TL, p_ctx->tl.actual_packet_length);
                 if ((0 != (event & IFX_I2C_DL_EVENT_ERROR)) || (0 != data_len))
                 {
                     p_ctx->tl.state = TL_STATE_IDLE;
                 }
-                p_ctx->tl.upper_layer_event_handler(p_ctx, p_ctx->tl.error_event, 0u, 0u);
+                IFX_I2C_DISPATCH_EVENT(p_ctx, p_ctx->tl.upper_layer_event_handler, p_ctx->tl.error_event, 0u, 0u);
             }
             break;
             default:
@@ -556,7 +703,7 @@ _STATIC_H void ifx_i2c_dl_event_handler(ifx_i2c_context_t * p_ctx,
                 LOG_TL("[IFX-TL]: Exit from default case\n");
                 p_ctx->tl.state = TL_STATE_IDLE;
                 exit_machine = FALSE;
-                p_ctx->tl.upper_layer_event_handler(p_ctx, p_ctx->tl.error_event, 0u, 0u);
+                IFX_I2C_DISPATCH_EVENT(p_ctx, p_ctx->tl.upper_layer_event_handler, p_ctx->tl.error_event, 0u, 0u);
             }
             break;
         }
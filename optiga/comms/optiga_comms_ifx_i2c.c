@@ -39,6 +39,10 @@
 #include "optiga/common/optiga_lib_logger.h"
 #include "optiga/ifx_i2c/ifx_i2c.h"
 #include "optiga/pal/pal_os_event.h"
+#ifdef OPTIGA_COMMS_DL_RESEND_BACKOFF_ENABLED
+#include "optiga/pal/pal_os_lock.h"
+#include "optiga/pal/pal_os_memory.h"
+#endif
 
 /// @cond hidden
 
@@ -60,24 +64,56 @@ optiga_comms_t optiga_comms = {
 #endif
                                NULL};
 
+#if (OPTIGA_MAX_NUMBER_OF_INSTANCES > 1)
+// optiga comms of additional OPTIGA instances, comms context is assigned from ifx_i2c_context_list
+//lint --e{785} suppress "Only required fields are initialized by default, the rest are assigned on create"
+_STATIC_H optiga_comms_t optiga_comms_list[OPTIGA_MAX_NUMBER_OF_INSTANCES - 1] = {0};
+#endif
+
+#ifdef OPTIGA_PAL_INIT_ENABLED
+// pal is initialized once for all OPTIGA instances
+_STATIC_H uint8_t pal_init_state = FALSE;
+#endif
+
 _STATIC_H optiga_lib_status_t check_optiga_comms_state(optiga_comms_t *p_ctx);
 _STATIC_H void ifx_i2c_event_handler(void* p_ctx, optiga_lib_status_t event);
 
 optiga_comms_t * optiga_comms_create(callback_handler_t callback, void * context)
+{
+    return (optiga_comms_create_instance(OPTIGA_INSTANCE_ID_0, callback, context));
+}
+
+optiga_comms_t * optiga_comms_create_instance(uint8_t optiga_instance_id, callback_handler_t callback, void * context)
 {
     optiga_comms_t * p_optiga_comms = NULL;
 
     do
     {
+        if ((OPTIGA_MAX_NUMBER_OF_INSTANCES <= optiga_instance_id) ||
+            (NULL == ifx_i2c_context_list[optiga_instance_id]))
+        {
+            break;
+        }
         p_optiga_comms = &optiga_comms;
+#if (OPTIGA_MAX_NUMBER_OF_INSTANCES > 1)
+        if (OPTIGA_INSTANCE_ID_0 != optiga_instance_id)
+        {
+            p_optiga_comms = &optiga_comms_list[optiga_instance_id - 1];
+            p_optiga_comms->p_comms_ctx = (void *)ifx_i2c_context_list[optiga_instance_id];
+        }
+#endif
 
         if (FALSE == p_optiga_comms->instance_init_state)
         {
 #ifdef OPTIGA_PAL_INIT_ENABLED
-            if (PAL_STATUS_SUCCESS != pal_init())
+            if (FALSE == pal_init_state)
             {
-                p_optiga_comms = NULL;
-                break;
+                if (PAL_STATUS_SUCCESS != pal_init())
+                {
+                    p_optiga_comms = NULL;
+                    break;
+                }
+                pal_init_state = TRUE;
             }
 #endif
             p_optiga_comms->upper_layer_handler = callback;
@@ -119,7 +155,17 @@ optiga_lib_status_t optiga_comms_open(optiga_comms_t * p_ctx)
 #ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
         ((ifx_i2c_context_t * )(p_ctx->p_comms_ctx))->manage_context_operation = p_ctx->manage_context_operation;
 #endif
-        ((ifx_i2c_context_t * )(p_ctx->p_comms_ctx))->pal_os_event_ctx = p_ctx->p_pal_os_event_ctx;
+#ifdef OPTIGA_LIB_EVENT_QUEUE_ENABLED
+        // ifx i2c schedules its timeouts on its own event, in parallel to the scheduler of optiga cmd
+        if (NULL == ((ifx_i2c_context_t * )(p_ctx->p_comms_ctx))->pal_os_event_ctx)
+        {
+            ((ifx_i2c_context_t * )(p_ctx->p_comms_ctx))->pal_os_event_ctx = PAL_OS_EVENT_CREATE(NULL, NULL);
+        }
+        if (NULL == ((ifx_i2c_context_t * )(p_ctx->p_comms_ctx))->pal_os_event_ctx)
+#endif //OPTIGA_LIB_EVENT_QUEUE_ENABLED
+        {
+            ((ifx_i2c_context_t * )(p_ctx->p_comms_ctx))->pal_os_event_ctx = p_ctx->p_pal_os_event_ctx;
+        }
 
         status = ifx_i2c_open((ifx_i2c_context_t * )(p_ctx->p_comms_ctx));
         if (IFX_I2C_STACK_SUCCESS != status)
@@ -162,6 +208,20 @@ optiga_lib_status_t optiga_comms_transceive(optiga_comms_t * p_ctx,
         ((ifx_i2c_context_t * )(p_ctx->p_comms_ctx))->protection_level = p_ctx->protection_level;
         ((ifx_i2c_context_t * )(p_ctx->p_comms_ctx))->protocol_version = p_ctx->protocol_version;
         ((ifx_i2c_context_t * )(p_ctx->p_comms_ctx))->manage_context_operation = p_ctx->manage_context_operation;
+#endif
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+        ((ifx_i2c_context_t * )(p_ctx->p_comms_ctx))->response_time_hint_us = p_ctx->response_time_hint_us;
+        ((ifx_i2c_context_t * )(p_ctx->p_comms_ctx))->response_time_us = 0;
+        p_ctx->response_time_hint_us = 0;
+        p_ctx->response_time_us = 0;
+#endif
+#ifdef OPTIGA_COMMS_ZERO_COPY_RX
+        ((ifx_i2c_context_t * )(p_ctx->p_comms_ctx))->p_rx_destination = p_ctx->p_rx_destination;
+        ((ifx_i2c_context_t * )(p_ctx->p_comms_ctx))->p_rx_destination_start = p_rx_data + p_ctx->rx_destination_offset;
+        ((ifx_i2c_context_t * )(p_ctx->p_comms_ctx))->rx_destination_size = p_ctx->rx_destination_size;
+        ((ifx_i2c_context_t * )(p_ctx->p_comms_ctx))->rx_destination_length = 0;
+        p_ctx->p_rx_destination = NULL;
+        p_ctx->rx_destination_length = 0;
 #endif
         status = (ifx_i2c_transceive((ifx_i2c_context_t * )(p_ctx->p_comms_ctx),
                                      p_tx_data,
@@ -196,6 +256,94 @@ optiga_lib_status_t optiga_comms_close(optiga_comms_t * p_ctx)
     return (status);
 }
 
+#ifdef OPTIGA_COMMS_DL_RESEND_BACKOFF_ENABLED
+optiga_lib_status_t optiga_comms_get_recovery_stats(const optiga_comms_t * p_ctx,
+                                                    optiga_lib_comms_recovery_stats_t * p_stats)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_ERROR;
+    if ((NULL != p_ctx) && (NULL != p_ctx->p_comms_ctx) && (NULL != p_stats))
+    {
+        // Statistics are updated from the event context of the protocol stack
+        pal_os_lock_enter_critical_section();
+        pal_os_memcpy(p_stats,
+                      &((ifx_i2c_context_t * )(p_ctx->p_comms_ctx))->dl.recovery_stats,
+                      sizeof(optiga_lib_comms_recovery_stats_t));
+        pal_os_lock_exit_critical_section();
+        status = OPTIGA_COMMS_SUCCESS;
+    }
+    return (status);
+}
+#endif
+
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+optiga_lib_status_t optiga_comms_get_statistics(const optiga_comms_t * p_ctx,
+                                                optiga_lib_comms_stats_t * p_stats)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_ERROR;
+    if ((NULL != p_ctx) && (NULL != p_ctx->p_comms_ctx) && (NULL != p_stats))
+    {
+        // Statistics are updated from the event context of the protocol stack
+        pal_os_lock_enter_critical_section();
+        pal_os_memcpy(p_stats,
+                      &((ifx_i2c_context_t * )(p_ctx->p_comms_ctx))->statistics,
+                      sizeof(optiga_lib_comms_stats_t));
+        pal_os_lock_exit_critical_section();
+        status = OPTIGA_COMMS_SUCCESS;
+    }
+    return (status);
+}
+#endif
+
+#ifdef OPTIGA_COMMS_STACK_USAGE_ENABLED
+optiga_lib_status_t optiga_comms_get_stack_usage(const optiga_comms_t * p_ctx,
+                                                 uint32_t * p_stack_high_water)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_ERROR;
+    if ((NULL != p_ctx) && (NULL != p_ctx->p_comms_ctx) && (NULL != p_stack_high_water))
+    {
+        // High water mark is updated from the event context of the protocol stack
+        pal_os_lock_enter_critical_section();
+        *p_stack_high_water = ((ifx_i2c_context_t * )(p_ctx->p_comms_ctx))->stack_high_water;
+        pal_os_lock_exit_critical_section();
+        status = OPTIGA_COMMS_SUCCESS;
+    }
+    return (status);
+}
+#endif
+
+#if defined (OPTIGA_COMMS_SHIELDED_CONNECTION) && defined (OPTIGA_COMMS_KEY_ROLLOVER_ENABLED)
+optiga_lib_status_t optiga_comms_rollover(optiga_comms_t * p_ctx)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_ERROR;
+    if (OPTIGA_COMMS_SUCCESS == check_optiga_comms_state(p_ctx))
+    {
+        ((ifx_i2c_context_t * )(p_ctx->p_comms_ctx))->p_upper_layer_ctx = (void * )p_ctx;
+        ((ifx_i2c_context_t * )(p_ctx->p_comms_ctx))->upper_layer_event_handler = ifx_i2c_event_handler;
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+        ((ifx_i2c_context_t * )(p_ctx->p_comms_ctx))->response_time_hint_us = 0;
+        ((ifx_i2c_context_t * )(p_ctx->p_comms_ctx))->response_time_us = 0;
+        p_ctx->response_time_us = 0;
+#endif
+        status = ifx_i2c_rollover((ifx_i2c_context_t * )(p_ctx->p_comms_ctx));
+        if (IFX_I2C_STACK_SUCCESS != status)
+        {
+            p_ctx->state = OPTIGA_COMMS_FREE;
+        }
+    }
+    return (status);
+}
+
+bool_t optiga_comms_rollover_due(const optiga_comms_t * p_ctx)
+{
+    bool_t rollover_due = FALSE;
+    if ((NULL != p_ctx) && (NULL != p_ctx->p_comms_ctx) && (OPTIGA_COMMS_INUSE != p_ctx->state))
+    {
+        rollover_due = ifx_i2c_rollover_due((const ifx_i2c_context_t * )(p_ctx->p_comms_ctx));
+    }
+    return (rollover_due);
+}
+#endif
+
 /// @cond hidden
 _STATIC_H optiga_lib_status_t check_optiga_comms_state(optiga_comms_t * p_ctx)
 {
@@ -212,6 +360,14 @@ _STATIC_H optiga_lib_status_t check_optiga_comms_state(optiga_comms_t * p_ctx)
 _STATIC_H void ifx_i2c_event_handler(void * p_upper_layer_ctx, optiga_lib_status_t event)
 {
     void * ctx = ((optiga_comms_t * )p_upper_layer_ctx)->p_upper_layer_ctx;
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+    ((optiga_comms_t * )p_upper_layer_ctx)->response_time_us =
+        ((ifx_i2c_context_t * )(((optiga_comms_t * )p_upper_layer_ctx)->p_comms_ctx))->response_time_us;
+#endif
+#ifdef OPTIGA_COMMS_ZERO_COPY_RX
+    ((optiga_comms_t * )p_upper_layer_ctx)->rx_destination_length =
+        ((ifx_i2c_context_t * )(((optiga_comms_t * )p_upper_layer_ctx)->p_comms_ctx))->rx_destination_length;
+#endif
     ((optiga_comms_t * )p_upper_layer_ctx)->upper_layer_handler(ctx, event);
     ((optiga_comms_t * )p_upper_layer_ctx)->state = OPTIGA_COMMS_FREE;
 }
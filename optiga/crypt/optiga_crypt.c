@@ -40,6 +40,14 @@
 #include "optiga/common/optiga_lib_logger.h"
 #include "optiga/common/optiga_lib_common_internal.h"
 #include "optiga/pal/pal_os_memory.h"
+#include "optiga/pal/pal_os_lock.h"
+#if defined (OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED) || defined (OPTIGA_CRYPT_ECDSA_VERIFY_OFFLOAD_ENABLED) || \
+    defined (OPTIGA_CRYPT_VERIFY_CACHE_ENABLED)
+#include "optiga/pal/pal_crypt.h"
+#endif //(OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED) || (OPTIGA_CRYPT_ECDSA_VERIFY_OFFLOAD_ENABLED) || (OPTIGA_CRYPT_VERIFY_CACHE_ENABLED)
+#ifdef OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
+#include "optiga/pal/pal_os_timer.h"
+#endif //OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
 
 /// ECDSA FIPS 186-3 without hash
 #define OPTIGA_CRYPT_ECDSA_FIPS_186_3_WITHOUT_HASH                  (0x11)
@@ -66,6 +74,25 @@
 /// Clearing AUTOREF state using clear auto ref operation
 #define OPTIGA_CRYPT_CLEAR_AUTO_STATE                               (0x03)
 #endif
+#ifdef OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+/// No data is coalesced
+#define OPTIGA_CRYPT_COALESCING_NONE                                (0x00)
+/// Data of hash updates is coalesced
+#define OPTIGA_CRYPT_COALESCING_HASH                                (0x01)
+/// Data of hmac updates is coalesced
+#define OPTIGA_CRYPT_COALESCING_HMAC                                (0x02)
+/// No step is pending, once the ongoing command is completed
+#define OPTIGA_CRYPT_COALESCING_STEP_NONE                           (0x00)
+/// Remaining data of the caller is taken, once the ongoing command is completed
+#define OPTIGA_CRYPT_COALESCING_STEP_REMAINING                      (0x01)
+/// Sequence is finalized, once the ongoing command is completed
+#define OPTIGA_CRYPT_COALESCING_STEP_FINALIZE                       (0x02)
+#endif //OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+
+#ifdef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+/// Maximum length of the DER INTEGERs of a signature, raw r || s of ECC NIST P521 with the DER overhead
+#define OPTIGA_CRYPT_ECDSA_MAX_DER_SIGNATURE_LENGTH                 (0x84 + OPTIGA_ECDSA_SIGNATURE_DER_OVERHEAD)
+#endif //OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
 
 #if defined (OPTIGA_LIB_ENABLE_LOGGING) && defined (OPTIGA_LIB_ENABLE_CRYPT_LOGGING)
 
@@ -105,14 +132,205 @@
 
 #endif
 
+#ifdef OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+_STATIC_H uint8_t optiga_crypt_coalescing_resume(optiga_crypt_t * me,
+                                                 optiga_lib_status_t * p_event);
+#endif //OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+#ifdef OPTIGA_CRYPT_ECDSA_SIGN_BATCH_ENABLED
+_STATIC_H uint8_t optiga_crypt_sign_batch_resume(optiga_crypt_t * me,
+                                                 optiga_lib_status_t * p_event);
+#endif //OPTIGA_CRYPT_ECDSA_SIGN_BATCH_ENABLED
+#ifdef OPTIGA_CRYPT_VERIFY_BATCH_ENABLED
+_STATIC_H uint8_t optiga_crypt_verify_batch_resume(optiga_crypt_t * me,
+                                                   optiga_lib_status_t * p_event);
+#endif //OPTIGA_CRYPT_VERIFY_BATCH_ENABLED
+#if defined (OPTIGA_CRYPT_HMAC_AUTHORIZE_ENABLED) && defined (OPTIGA_CRYPT_SYM_DECRYPT_ENABLED)
+_STATIC_H uint8_t optiga_crypt_hmac_authorize_resume(optiga_crypt_t * me,
+                                                     optiga_lib_status_t * p_event);
+#endif //(OPTIGA_CRYPT_HMAC_AUTHORIZE_ENABLED) && (OPTIGA_CRYPT_SYM_DECRYPT_ENABLED)
+
+#ifdef OPTIGA_CRYPT_OPERATION_QUEUE_ENABLED
+/// Types of the operation handles
+#define OPTIGA_CRYPT_OPERATION_RANDOM               (0x01)
+#define OPTIGA_CRYPT_OPERATION_HASH                 (0x02)
+#define OPTIGA_CRYPT_OPERATION_ECDSA_SIGN           (0x03)
+#define OPTIGA_CRYPT_OPERATION_ECDSA_VERIFY         (0x04)
+#define OPTIGA_CRYPT_OPERATION_ECDH                 (0x05)
+
+_STATIC_H void optiga_crypt_operation_complete(optiga_crypt_t * me, optiga_lib_status_t event);
+_STATIC_H void optiga_crypt_operation_dequeue(optiga_crypt_t * me);
+#endif //OPTIGA_CRYPT_OPERATION_QUEUE_ENABLED
+
 _STATIC_H void optiga_crypt_generic_event_handler(void * p_ctx,
                                                   optiga_lib_status_t event)
 {
     optiga_crypt_t * me = (optiga_crypt_t *)p_ctx;
 
     me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
-    me->handler(me->caller_context, event);
+    do
+    {
+#ifdef OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+        if (TRUE == me->verify_cache_pending)
+        {
+            me->verify_cache_pending = FALSE;
+            if (OPTIGA_LIB_SUCCESS == event)
+            {
+                optiga_cmd_verify_cache_insert(me->my_cmd,
+                                               me->verify_cache_oid,
+                                               me->verify_cache_key,
+                                               me->verify_cache_generation,
+                                               me->verify_cache_ttl_ms);
+            }
+        }
+#endif //OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+#ifdef OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
+        // Recorded before the callback, since the time of the callback is not part of the cost
+        if (TRUE == me->offload_pending)
+        {
+            me->offload_pending = FALSE;
+            if (OPTIGA_LIB_SUCCESS == event)
+            {
+                optiga_cmd_offload_record(me->my_cmd,
+                                          me->offload_operation,
+                                          me->offload_on_host,
+                                          pal_os_timer_get_time_in_microseconds() - me->offload_start_time);
+            }
+        }
+#endif //OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
+#ifdef OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+        // The operation of the caller is completed, once the pending step of coalescing is completed
+        if (TRUE == optiga_crypt_coalescing_resume(me, &event))
+        {
+            break;
+        }
+#endif //OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+#ifdef OPTIGA_CRYPT_ECDSA_SIGN_BATCH_ENABLED
+        // The operation of the caller is completed, once all the chunks of the signing batch are completed
+        if (TRUE == optiga_crypt_sign_batch_resume(me, &event))
+        {
+            break;
+        }
+#endif //OPTIGA_CRYPT_ECDSA_SIGN_BATCH_ENABLED
+#ifdef OPTIGA_CRYPT_VERIFY_BATCH_ENABLED
+        // The operation of the caller is completed, once all the chunks of the verify batch are completed
+        if (TRUE == optiga_crypt_verify_batch_resume(me, &event))
+        {
+            break;
+        }
+#endif //OPTIGA_CRYPT_VERIFY_BATCH_ENABLED
+#if defined (OPTIGA_CRYPT_HMAC_AUTHORIZE_ENABLED) && defined (OPTIGA_CRYPT_SYM_DECRYPT_ENABLED)
+        // The operation of the caller is completed, once the AUTO state is cleared after a failed chain
+        if (TRUE == optiga_crypt_hmac_authorize_resume(me, &event))
+        {
+            break;
+        }
+#endif //(OPTIGA_CRYPT_HMAC_AUTHORIZE_ENABLED) && (OPTIGA_CRYPT_SYM_DECRYPT_ENABLED)
+#ifdef OPTIGA_CRYPT_OPERATION_QUEUE_ENABLED
+        if (NULL != me->p_current_operation)
+        {
+            optiga_crypt_operation_complete(me, event);
+        }
+        else
+#endif //OPTIGA_CRYPT_OPERATION_QUEUE_ENABLED
+#ifdef OPTIGA_LIB_SYNC_API_ENABLED
+        if (TRUE == me->sync_ongoing)
+        {
+            // Wake up the caller of synchronous API instead of invoking the callback handler
+            me->sync_status = event;
+            pal_os_wait_signal(&me->sync_wait);
+        }
+        else
+#endif //OPTIGA_LIB_SYNC_API_ENABLED
+        {
+            me->handler(me->caller_context, event);
+        }
+#ifdef OPTIGA_CRYPT_OPERATION_QUEUE_ENABLED
+        // The queued operations are started once the instance is free
+        optiga_crypt_operation_dequeue(me);
+#endif //OPTIGA_CRYPT_OPERATION_QUEUE_ENABLED
+    } while (FALSE);
+}
+
+#ifdef OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
+/*
+* Decides by the offload policy whether the operation is executed on host and starts the measurement of its time
+*/
+_STATIC_H bool_t optiga_crypt_offload_decide(optiga_crypt_t * me, uint8_t operation, bool_t instance_setting)
+{
+    bool_t on_host = instance_setting;
+
+    // The ongoing operation of a busy instance is left as it is, the instance in use is reported by the operation
+    if (OPTIGA_LIB_INSTANCE_BUSY != me->instance_state)
+    {
+        on_host = optiga_cmd_offload_decide(me->my_cmd, operation, me->security_class, instance_setting);
+        me->offload_operation = operation;
+        me->offload_on_host = on_host;
+        me->offload_pending = TRUE;
+        me->offload_start_time = pal_os_timer_get_time_in_microseconds();
+    }
+    return (on_host);
+}
+
+/*
+* Stops the measurement, if the decided operation is not started
+*/
+_STATIC_H void optiga_crypt_offload_abort(optiga_crypt_t * me, optiga_lib_status_t return_value)
+{
+    // A busy instance keeps the measurement of its ongoing operation
+    if ((OPTIGA_LIB_SUCCESS != return_value) && (OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE != return_value))
+    {
+        me->offload_pending = FALSE;
+    }
+}
+
+#define OPTIGA_CRYPT_OFFLOAD_TO_HOST(me, operation, instance_setting) \
+    optiga_crypt_offload_decide((me), (uint8_t)(operation), (instance_setting))
+#else
+#define OPTIGA_CRYPT_OFFLOAD_TO_HOST(me, operation, instance_setting) (instance_setting)
+#endif //OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
+
+#ifdef OPTIGA_LIB_SYNC_API_ENABLED
+/*
+* Marks the instance for synchronous completion of the next operation
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_sync_begin(optiga_crypt_t * me)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        // Completion of an ongoing asynchronous operation must not be taken as synchronous completion
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        me->sync_ongoing = TRUE;
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+
+/*
+* Blocks until the operation started with the return_value is completed
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_sync_end(optiga_crypt_t * me, optiga_lib_status_t return_value)
+{
+    if (OPTIGA_LIB_SUCCESS == return_value)
+    {
+        pal_os_wait_for_signal(&me->sync_wait);
+        return_value = me->sync_status;
+    }
+    me->sync_ongoing = FALSE;
+    return (return_value);
 }
+#endif //OPTIGA_LIB_SYNC_API_ENABLED
 
 _STATIC_H void optiga_crypt_reset_protection_level(optiga_crypt_t * me)
 {
@@ -155,10 +373,19 @@ _STATIC_H optiga_lib_status_t optiga_crypt_generate_keypair(optiga_crypt_t * me,
             return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
             break;
         }
+#ifdef OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+        // The curves after NIST P-384 (NIST P-521 and Brainpool) precede the RSA key types
+        if ((OPTIGA_ECC_CURVE_NIST_P_384 < cmd_param) && ((uint8_t)OPTIGA_RSA_KEY_1024_BIT_EXPONENTIAL > cmd_param) &&
+            (FALSE == optiga_cmd_is_capable(me->my_cmd, OPTIGA_LIB_CAPABILITY_EXTENDED_ALGORITHMS)))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_UNSUPPORTED;
+            break;
+        }
+#endif //OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
 
         me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
-        p_params = (optiga_gen_keypair_params_t *)&(me->params.optiga_gen_keypair_params);
-        pal_os_memset(&me->params,0x00,sizeof(optiga_crypt_params_t));
+        p_params = (optiga_gen_keypair_params_t *)&(me->p_params->optiga_gen_keypair_params);
+        pal_os_memset(p_params,0x00,sizeof(optiga_gen_keypair_params_t));
 
         p_params->key_usage = key_usage;
         p_params->export_private_key = export_private_key;
@@ -190,6 +417,7 @@ _STATIC_H optiga_lib_status_t optiga_crypt_generate_keypair(optiga_crypt_t * me,
 
 #if defined (OPTIGA_CRYPT_ECDSA_SIGN_ENABLED) || defined (OPTIGA_CRYPT_RSA_SIGN_ENABLED)
 //lint --e{715} suppress "The salt_length argument is kept for future use"
+//lint --e{715} suppress "The signature_format argument is used only with OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED"
 _STATIC_H optiga_lib_status_t optiga_crypt_sign(optiga_crypt_t * me,
                                                 uint8_t signature_scheme,
                                                 const uint8_t * p_digest,
@@ -197,7 +425,8 @@ _STATIC_H optiga_lib_status_t optiga_crypt_sign(optiga_crypt_t * me,
                                                 optiga_key_id_t private_key,
                                                 uint8_t * p_signature,
                                                 uint16_t * p_signature_length,
-                                                uint16_t salt_length)
+                                                uint16_t salt_length,
+                                                uint8_t signature_format)
 {
     optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
     optiga_calc_sign_params_t * p_params;
@@ -218,17 +447,28 @@ _STATIC_H optiga_lib_status_t optiga_crypt_sign(optiga_crypt_t * me,
             return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
             break;
         }
+#if defined (OPTIGA_LIB_CAPABILITY_PROBE_ENABLED) && defined (OPTIGA_CRYPT_RSA_SSA_SHA512_ENABLED)
+        if (((uint8_t)OPTIGA_RSASSA_PKCS1_V15_SHA512 == signature_scheme) &&
+            (FALSE == optiga_cmd_is_capable(me->my_cmd, OPTIGA_LIB_CAPABILITY_EXTENDED_ALGORITHMS)))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_UNSUPPORTED;
+            break;
+        }
+#endif
 
         me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
 
-        p_params = (optiga_calc_sign_params_t *)&(me->params.optiga_calc_sign_params);
-        pal_os_memset(&me->params,0x00,sizeof(optiga_crypt_params_t));
+        p_params = (optiga_calc_sign_params_t *)&(me->p_params->optiga_calc_sign_params);
+        pal_os_memset(p_params,0x00,sizeof(optiga_calc_sign_params_t));
 
         p_params->p_digest = p_digest;
         p_params->digest_length = digest_length;
         p_params->private_key_oid = private_key;
         p_params->p_signature = p_signature;
         p_params->p_signature_length = p_signature_length;
+#ifdef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+        p_params->signature_format = signature_format;
+#endif
         OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
         OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
 
@@ -248,6 +488,7 @@ _STATIC_H optiga_lib_status_t optiga_crypt_sign(optiga_crypt_t * me,
 
 #if defined (OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED) || defined (OPTIGA_CRYPT_RSA_VERIFY_ENABLED)
 //lint --e{715} suppress "The salt_length argument is kept for future use"
+//lint --e{715} suppress "The signature_format argument is used only with OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED"
 _STATIC_H optiga_lib_status_t optiga_crypt_verify(optiga_crypt_t * me,
                                                   uint8_t cmd_param,
                                                   const uint8_t * p_digest,
@@ -256,7 +497,8 @@ _STATIC_H optiga_lib_status_t optiga_crypt_verify(optiga_crypt_t * me,
                                                   uint16_t signature_length,
                                                   uint8_t public_key_source_type,
                                                   const void * p_public_key,
-                                                  uint16_t salt_length)
+                                                  uint16_t salt_length,
+                                                  uint8_t signature_format)
 {
     optiga_verify_sign_params_t * p_params;
     optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
@@ -277,10 +519,18 @@ _STATIC_H optiga_lib_status_t optiga_crypt_verify(optiga_crypt_t * me,
             return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
             break;
         }
+#if defined (OPTIGA_LIB_CAPABILITY_PROBE_ENABLED) && defined (OPTIGA_CRYPT_RSA_SSA_SHA512_ENABLED)
+        if (((uint8_t)OPTIGA_RSASSA_PKCS1_V15_SHA512 == cmd_param) &&
+            (FALSE == optiga_cmd_is_capable(me->my_cmd, OPTIGA_LIB_CAPABILITY_EXTENDED_ALGORITHMS)))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_UNSUPPORTED;
+            break;
+        }
+#endif
 
         me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
-        p_params = (optiga_verify_sign_params_t *)&(me->params.optiga_verify_sign_params);
-        pal_os_memset(&me->params,0x00,sizeof(optiga_crypt_params_t));
+        p_params = (optiga_verify_sign_params_t *)&(me->p_params->optiga_verify_sign_params);
+        pal_os_memset(p_params,0x00,sizeof(optiga_verify_sign_params_t));
 
         OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
         OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
@@ -289,6 +539,9 @@ _STATIC_H optiga_lib_status_t optiga_crypt_verify(optiga_crypt_t * me,
         p_params->p_signature = p_signature;
         p_params->signature_length = signature_length;
         p_params->public_key_source_type = public_key_source_type;
+#ifdef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+        p_params->signature_format = signature_format;
+#endif
 
         if (OPTIGA_CRYPT_OID_DATA == public_key_source_type)
         {
@@ -339,8 +592,8 @@ _STATIC_H optiga_lib_status_t optiga_crypt_rsa_enc_dec(optiga_crypt_t * me,
         }
         me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;;
 
-        p_params = (optiga_encrypt_asym_params_t *)&(me->params.optiga_encrypt_asym_params);
-        pal_os_memset(&me->params,0x00,sizeof(optiga_crypt_params_t));
+        p_params = (optiga_encrypt_asym_params_t *)&(me->p_params->optiga_encrypt_asym_params);
+        pal_os_memset(p_params,0x00,sizeof(optiga_encrypt_asym_params_t));
 
         p_params->message = p_message;
         p_params->message_length = message_length;
@@ -400,8 +653,8 @@ _STATIC_H optiga_lib_status_t optiga_crypt_get_random(optiga_crypt_t * me,
         }
 
         me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
-        p_params = (optiga_get_random_params_t *)&(me->params.optiga_get_random_params);
-        pal_os_memset(&me->params,0x00,sizeof(optiga_crypt_params_t));
+        p_params = (optiga_get_random_params_t *)&(me->p_params->optiga_get_random_params);
+        pal_os_memset(p_params,0x00,sizeof(optiga_get_random_params_t));
 
         p_params->optional_data = p_optional_data;
         p_params->optional_data_length = optional_data_length;
@@ -456,13 +709,20 @@ _STATIC_H optiga_lib_status_t optiga_crypt_symmetric_mode_generic(optiga_crypt_t
             return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
             break;
         }
+#ifdef OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+        if (FALSE == optiga_cmd_is_capable(me->my_cmd, OPTIGA_LIB_CAPABILITY_SYMMETRIC))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_UNSUPPORTED;
+            break;
+        }
+#endif //OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
         me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
 
-        p_params = (optiga_encrypt_sym_params_t *)&(me->params.optiga_symmetric_enc_dec_params);
+        p_params = (optiga_encrypt_sym_params_t *)&(me->p_params->optiga_symmetric_enc_dec_params);
         if ((OPTIGA_CRYPT_SYM_START_FINAL == enc_dec_sequence) || \
             (OPTIGA_CRYPT_SYM_START == enc_dec_sequence))
         {
-            pal_os_memset(&me->params,0x00,sizeof(optiga_crypt_params_t));
+            pal_os_memset(p_params,0x00,sizeof(optiga_encrypt_sym_params_t));
 
             p_params->mode = mode;
             p_params->symmetric_key_oid = symmetric_key_oid;
@@ -566,11 +826,20 @@ _STATIC_H optiga_lib_status_t optiga_crypt_derive_key_generic(optiga_crypt_t * m
             return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
             break;
         }
+#ifdef OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+        // TLS PRF SHA256 is supported by all the OPTIGA versions
+        if (((uint8_t)OPTIGA_TLS12_PRF_SHA_256 != type) &&
+            (FALSE == optiga_cmd_is_capable(me->my_cmd, OPTIGA_LIB_CAPABILITY_KEY_DERIVATION)))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_UNSUPPORTED;
+            break;
+        }
+#endif //OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
 
         me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
 
-        p_params = (optiga_derive_key_params_t *)&(me->params.optiga_derive_key_params);
-        pal_os_memset(&me->params,0x00,sizeof(optiga_crypt_params_t));
+        p_params = (optiga_derive_key_params_t *)&(me->p_params->optiga_derive_key_params);
+        pal_os_memset(p_params,0x00,sizeof(optiga_derive_key_params_t));
         
         p_params->input_shared_secret_oid = secret;
         p_params->random_data = random_data;
@@ -631,8 +900,8 @@ _STATIC_H optiga_lib_status_t optiga_crypt_hash_generic(optiga_crypt_t * me,
         }
 
         me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
-        p_params = (optiga_calc_hash_params_t *)&(me->params.optiga_calc_hash_params);
-        pal_os_memset(&me->params,0x00,sizeof(optiga_crypt_params_t));
+        p_params = (optiga_calc_hash_params_t *)&(me->p_params->optiga_calc_hash_params);
+        pal_os_memset(p_params,0x00,sizeof(optiga_calc_hash_params_t));
 
         OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
         OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
@@ -643,6 +912,12 @@ _STATIC_H optiga_lib_status_t optiga_crypt_hash_generic(optiga_crypt_t * me,
         p_params->p_hash_oid = NULL;
         p_params->p_out_digest = hash_output;
         p_params->export_hash_ctx = export_intermediate_ctx;
+        // Context resident in OPTIGA is neither provided nor exported
+        if ((NULL != hash_ctx) && (NULL == hash_ctx->context_buffer))
+        {
+            p_params->apparent_context_size = 0;
+            p_params->export_hash_ctx = FALSE;
+        }
         
         if ((OPTIGA_CRYPT_HASH_CONTINUE == hash_sequence) || (OPTIGA_CRYPT_HASH_START_FINAL == hash_sequence))
         {
@@ -669,1350 +944,1317 @@ _STATIC_H optiga_lib_status_t optiga_crypt_hash_generic(optiga_crypt_t * me,
 
     return (return_value);
 }
-#endif //(OPTIGA_CRYPT_HASH_ENABLED)
 
-#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
-void optiga_crypt_set_comms_params(optiga_crypt_t * me,
-                                   uint8_t parameter_type,
-                                   uint8_t value)
+#ifdef OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED
+/*
+* Calculates the hash of the data from host using the crypto library on host.
+* On success, the operation is completed before returning.
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_hash_offload(optiga_crypt_t * me,
+                                                        uint8_t hash_algorithm,
+                                                        uint8_t hash_sequence,
+                                                        optiga_hash_context_t * hash_ctx,
+                                                        const hash_data_from_host_t * data_to_hash,
+                                                        uint8_t * hash_output)
 {
-    switch (parameter_type)
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    pal_status_t pal_return_value = PAL_STATUS_FAILURE;
+    uint8_t hash_context[OPTIGA_HASH_CONTEXT_LENGTH_SHA_256];
+    uint8_t * p_context = hash_context;
+    uint16_t context_length = sizeof(hash_context);
+    do
     {
-        case OPTIGA_COMMS_PROTECTION_LEVEL:
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
         {
-            me->protection_level = value;
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
             break;
         }
-        case OPTIGA_COMMS_PROTOCOL_VERSION:
+        if ((uint8_t)OPTIGA_HASH_TYPE_SHA_256 != hash_algorithm)
         {
-            me->protocol_version = value;
             break;
         }
-        default:
+        // The state of the sequence is kept on host, hence the context buffer is mandatory
+        if (OPTIGA_CRYPT_HASH_START_FINAL != hash_sequence)
+        {
+            if (NULL == hash_ctx->context_buffer)
+            {
+                break;
+            }
+            p_context = hash_ctx->context_buffer;
+            context_length = hash_ctx->context_buffer_length;
+        }
+
+        return_value = OPTIGA_CRYPT_ERROR;
+        switch (hash_sequence)
+        {
+            case OPTIGA_CRYPT_HASH_START:
+            {
+                pal_return_value = pal_crypt_sha256_start(NULL, p_context, context_length);
+            }
+            break;
+            case OPTIGA_CRYPT_HASH_CONTINUE:
+            {
+                pal_return_value = pal_crypt_sha256_update(NULL,
+                                                           p_context,
+                                                           context_length,
+                                                           data_to_hash->buffer,
+                                                           data_to_hash->length);
+            }
+            break;
+            case OPTIGA_CRYPT_HASH_FINAL:
+            {
+                pal_return_value = pal_crypt_sha256_finalize(NULL, p_context, context_length, hash_output);
+            }
+            break;
+            case OPTIGA_CRYPT_HASH_START_FINAL:
+            {
+                pal_return_value = pal_crypt_sha256_start(NULL, p_context, context_length);
+                if (PAL_STATUS_SUCCESS == pal_return_value)
+                {
+                    pal_return_value = pal_crypt_sha256_update(NULL,
+                                                               p_context,
+                                                               context_length,
+                                                               data_to_hash->buffer,
+                                                               data_to_hash->length);
+                }
+                if (PAL_STATUS_SUCCESS == pal_return_value)
+                {
+                    pal_return_value = pal_crypt_sha256_finalize(NULL, p_context, context_length, hash_output);
+                }
+                pal_os_memset(hash_context, 0x00, sizeof(hash_context));
+            }
+            break;
+            default:
+            break;
+        }
+        if (PAL_STATUS_SUCCESS != pal_return_value)
         {
             break;
         }
-    }
+
+        // Operation is completed on host, hence the callback is invoked right away
+        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+        return_value = OPTIGA_LIB_SUCCESS;
+        optiga_crypt_generic_event_handler(me, OPTIGA_LIB_SUCCESS);
+    } while (FALSE);
+    optiga_crypt_reset_protection_level(me);
+
+    return (return_value);
 }
-#endif
+#endif //OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED
+#endif //(OPTIGA_CRYPT_HASH_ENABLED)
 
-optiga_crypt_t * optiga_crypt_create(uint8_t optiga_instance_id,
-                                     callback_handler_t handler,
-                                     void * caller_context)
+#ifdef OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+/*
+* Sends the data as an update of the coalesced sequence
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_coalescing_send(optiga_crypt_t * me,
+                                                          const uint8_t * p_data,
+                                                          uint32_t length)
 {
-    optiga_crypt_t * me = NULL;
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
 
-    do
+    switch (me->coalesced_sequence)
     {
-#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if (NULL == handler)
+#ifdef OPTIGA_CRYPT_HASH_ENABLED
+        case OPTIGA_CRYPT_COALESCING_HASH:
         {
+            me->coalesced_hash_data.buffer = p_data;
+            me->coalesced_hash_data.length = length;
+            return_value = optiga_crypt_hash_generic(me,
+                                                     me->p_coalesced_hash_ctx->hash_algo,
+                                                     OPTIGA_CRYPT_HASH_CONTINUE,
+                                                     OPTIGA_CRYPT_HOST_DATA,
+                                                     me->p_coalesced_hash_ctx,
+                                                     me->p_coalesced_hash_ctx->context_buffer_length,
+                                                     &me->coalesced_hash_data,
+                                                     TRUE,
+                                                     NULL);
             break;
         }
-#endif
-        me = (optiga_crypt_t *)pal_os_calloc(1, sizeof(optiga_crypt_t));
-        if (NULL == me)
+#endif //OPTIGA_CRYPT_HASH_ENABLED
+#ifdef OPTIGA_CRYPT_HMAC_ENABLED
+        case OPTIGA_CRYPT_COALESCING_HMAC:
         {
+            // A deferred start is sent along with the first data
+            uint8_t is_start = me->coalesced_hmac_start_pending;
+
+            return_value = optiga_crypt_symmetric_mode_generic(me,
+                                                               (TRUE == is_start) ? me->coalesced_hmac_type : 0,
+                                                               (TRUE == is_start) ? me->coalesced_hmac_secret : 0,
+                                                               p_data,
+                                                               length,
+                                                               NULL,
+                                                               0,
+                                                               NULL,
+                                                               0,
+                                                               0,
+                                                               NULL,
+                                                               NULL,
+                                                               NULL,
+                                                               0,
+                                                               (TRUE == is_start) ? OPTIGA_CRYPT_SYM_START :
+                                                                                    OPTIGA_CRYPT_SYM_CONTINUE,
+                                                               OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION,
+                                                               OPTIGA_CRYPT_HMAC);
+            if (OPTIGA_LIB_SUCCESS == return_value)
+            {
+                me->coalesced_hmac_start_pending = FALSE;
+            }
             break;
         }
-
-        me->handler = handler;
-        me->caller_context = caller_context;
-        me->instance_state = OPTIGA_LIB_SUCCESS;
-#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
-        me->protocol_version = OPTIGA_COMMS_PROTOCOL_VERSION_PRE_SHARED_SECRET;
-        me->protection_level = OPTIGA_COMMS_DEFAULT_PROTECTION_LEVEL;
-#endif
-        me->my_cmd = optiga_cmd_create(optiga_instance_id,
-                                       optiga_crypt_generic_event_handler,
-                                       me);
-        if (NULL == me->my_cmd)
-        {
-            pal_os_free(me);
-            me = NULL;
-        }
-
-    } while (FALSE);
-
-    return (me);
+#endif //OPTIGA_CRYPT_HMAC_ENABLED
+        default:
+            break;
+    }
+    return (return_value);
 }
 
-optiga_lib_status_t optiga_crypt_destroy(optiga_crypt_t * me)
+/*
+* Coalesces the data in the buffer. If the data does not fit, the filled buffer is sent and
+* the remaining data is taken, once the buffer is sent. Data larger than the buffer is sent as it is.
+* p_is_coalesced is set to TRUE, if the data is coalesced without sending any command.
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_coalescing_update(optiga_crypt_t * me,
+                                                            const uint8_t * p_data,
+                                                            uint32_t length,
+                                                            uint8_t * p_is_coalesced)
 {
-    optiga_lib_status_t return_value;
+    optiga_lib_status_t return_value = OPTIGA_LIB_SUCCESS;
+    uint16_t free_length = OPTIGA_CRYPT_COALESCING_BUFFER_SIZE - me->coalesced_length;
 
+    *p_is_coalesced = FALSE;
     do
     {
-#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if (NULL == me)
+        if (length <= free_length)
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            pal_os_memcpy(me->coalescing_buffer + me->coalesced_length, p_data, length);
+            me->coalesced_length += (uint16_t)length;
+            *p_is_coalesced = TRUE;
             break;
         }
-#endif
-        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        if (0 == me->coalesced_length)
         {
-            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            return_value = optiga_crypt_coalescing_send(me, p_data, length);
             break;
         }
-        return_value = optiga_cmd_destroy(me->my_cmd);
-        pal_os_free(me);
 
+        pal_os_memcpy(me->coalescing_buffer + me->coalesced_length, p_data, free_length);
+        me->p_remaining_data = p_data + free_length;
+        me->remaining_length = length - free_length;
+        // The buffer is not modified, until the instance is free again
+        me->coalesced_length = 0;
+        me->coalescing_next_step = OPTIGA_CRYPT_COALESCING_STEP_REMAINING;
+        return_value = optiga_crypt_coalescing_send(me, me->coalescing_buffer, OPTIGA_CRYPT_COALESCING_BUFFER_SIZE);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            me->coalescing_next_step = OPTIGA_CRYPT_COALESCING_STEP_NONE;
+            me->coalesced_length = OPTIGA_CRYPT_COALESCING_BUFFER_SIZE - free_length;
+        }
     } while (FALSE);
     return (return_value);
 }
 
-#ifdef OPTIGA_CRYPT_RANDOM_ENABLED
-optiga_lib_status_t optiga_crypt_random(optiga_crypt_t * me,
-                                        optiga_rng_type_t rng_type,
-                                        uint8_t * random_data,
-                                        uint16_t random_data_length)
+/*
+* Finalizes the coalesced sequence, once all the coalesced data is sent
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_coalescing_finalize(optiga_crypt_t * me)
 {
     optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
-    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
-    do
+    uint8_t coalesced_sequence = me->coalesced_sequence;
+
+    me->coalesced_sequence = OPTIGA_CRYPT_COALESCING_NONE;
+    switch (coalesced_sequence)
     {
-#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == random_data))
+#ifdef OPTIGA_CRYPT_HASH_ENABLED
+        case OPTIGA_CRYPT_COALESCING_HASH:
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            return_value = optiga_crypt_hash_generic(me,
+                                                     me->p_coalesced_hash_ctx->hash_algo,
+                                                     OPTIGA_CRYPT_HASH_FINAL,
+                                                     0,
+                                                     me->p_coalesced_hash_ctx,
+                                                     me->p_coalesced_hash_ctx->context_buffer_length,
+                                                     NULL,
+                                                     FALSE,
+                                                     me->p_final_output);
             break;
         }
-#endif
-        return_value = optiga_crypt_get_random(me,
-                                               (uint8_t)rng_type,
-                                               random_data,
-                                               random_data_length,
-                                               NULL,
-                                               0x00,
-                                               FALSE);
-    } while (FALSE);
-
+#endif //OPTIGA_CRYPT_HASH_ENABLED
+#ifdef OPTIGA_CRYPT_HMAC_ENABLED
+        case OPTIGA_CRYPT_COALESCING_HMAC:
+        {
+            // A short mac, which is coalesced without sending any command, costs a single start final
+            uint8_t is_start = me->coalesced_hmac_start_pending;
+
+            me->coalesced_hmac_start_pending = FALSE;
+            return_value = optiga_crypt_symmetric_mode_generic(me,
+                                                               (TRUE == is_start) ? me->coalesced_hmac_type : 0,
+                                                               (TRUE == is_start) ? me->coalesced_hmac_secret : 0,
+                                                               me->p_remaining_data,
+                                                               me->remaining_length,
+                                                               NULL,
+                                                               0,
+                                                               NULL,
+                                                               0,
+                                                               0,
+                                                               me->p_final_output,
+                                                               me->p_final_output_length,
+                                                               NULL,
+                                                               0,
+                                                               (TRUE == is_start) ? OPTIGA_CRYPT_SYM_START_FINAL :
+                                                                                    OPTIGA_CRYPT_SYM_FINAL,
+                                                               OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION,
+                                                               OPTIGA_CRYPT_HMAC);
+            break;
+        }
+#endif //OPTIGA_CRYPT_HMAC_ENABLED
+        default:
+            break;
+    }
     return (return_value);
 }
-#endif //OPTIGA_CRYPT_RANDOM_ENABLED
 
-#ifdef OPTIGA_CRYPT_HASH_ENABLED
-optiga_lib_status_t optiga_crypt_hash_start(optiga_crypt_t * me,
-                                            optiga_hash_context_t * hash_ctx)
+/*
+* Takes the pending step of coalescing, once the ongoing command is completed.
+* Returns TRUE, if the operation of the caller is continued with the next command.
+*/
+_STATIC_H uint8_t optiga_crypt_coalescing_resume(optiga_crypt_t * me,
+                                                 optiga_lib_status_t * p_event)
 {
-    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
-    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
-    do  
+    uint8_t is_resumed = FALSE;
+    uint8_t is_coalesced;
+    uint8_t next_step = me->coalescing_next_step;
+
+    me->coalescing_next_step = OPTIGA_CRYPT_COALESCING_STEP_NONE;
+    do
     {
-#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == hash_ctx))
+        if (OPTIGA_CRYPT_COALESCING_STEP_NONE == next_step)
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
-#endif
-        return_value = optiga_crypt_hash_generic(me,
-                                                 hash_ctx->hash_algo,
-                                                 OPTIGA_CRYPT_HASH_START,
-                                                 0,
-                                                 hash_ctx,
-                                                 0,
-                                                 NULL,
-                                                 TRUE,
-                                                 NULL);
+        if (OPTIGA_LIB_SUCCESS == *p_event)
+        {
+            if (OPTIGA_CRYPT_COALESCING_STEP_REMAINING == next_step)
+            {
+                *p_event = optiga_crypt_coalescing_update(me, me->p_remaining_data, me->remaining_length, &is_coalesced);
+                is_resumed = (uint8_t)((OPTIGA_LIB_SUCCESS == *p_event) && (FALSE == is_coalesced));
+            }
+            else
+            {
+                *p_event = optiga_crypt_coalescing_finalize(me);
+                is_resumed = (uint8_t)(OPTIGA_LIB_SUCCESS == *p_event);
+            }
+        }
+        // Coalesced data is discarded, since the sequence can not be continued
+        if (OPTIGA_LIB_SUCCESS != *p_event)
+        {
+            me->coalesced_length = 0;
+            me->coalesced_sequence = OPTIGA_CRYPT_COALESCING_NONE;
+            me->coalesced_hmac_start_pending = FALSE;
+        }
     } while (FALSE);
-
-    return (return_value);
+    return (is_resumed);
 }
 
-optiga_lib_status_t optiga_crypt_hash_update(optiga_crypt_t * me,
-                                             optiga_hash_context_t * hash_ctx,
-                                             uint8_t source_of_data_to_hash,
-                                             const void * data_to_hash)
+/*
+* Assigns the coalescing buffer to the sequence. Data coalesced for another sequence must be flushed before.
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_coalescing_begin(optiga_crypt_t * me,
+                                                           uint8_t coalesced_sequence,
+                                                           optiga_hash_context_t * p_hash_ctx)
 {
-    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
-    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
     do
     {
-#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) ||
-            (NULL == hash_ctx) || (NULL == data_to_hash))
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
             break;
         }
-#endif
-        return_value = optiga_crypt_hash_generic(me,
-                                                 hash_ctx->hash_algo,
-                                                 OPTIGA_CRYPT_HASH_CONTINUE,
-                                                 source_of_data_to_hash,
-                                                 hash_ctx,
-                                                 hash_ctx->context_buffer_length,
-                                                 data_to_hash,
-                                                 TRUE,
-                                                 NULL);
+        if ((0 != me->coalesced_length) &&
+            ((coalesced_sequence != me->coalesced_sequence) || (p_hash_ctx != me->p_coalesced_hash_ctx)))
+        {
+            break;
+        }
+        me->coalesced_sequence = coalesced_sequence;
+        me->p_coalesced_hash_ctx = p_hash_ctx;
+        return_value = OPTIGA_LIB_SUCCESS;
     } while (FALSE);
+    return (return_value);
+}
+
+/*
+* Updates the coalesced sequence with the data of the caller
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_coalescing_add(optiga_crypt_t * me,
+                                                         const uint8_t * p_data,
+                                                         uint32_t length)
+{
+    uint8_t is_coalesced;
+    optiga_lib_status_t return_value = optiga_crypt_coalescing_update(me, p_data, length, &is_coalesced);
 
+    if ((OPTIGA_LIB_SUCCESS == return_value) && (TRUE == is_coalesced))
+    {
+        // No command is sent, hence the operation is completed right away
+        optiga_crypt_generic_event_handler(me, OPTIGA_LIB_SUCCESS);
+    }
     return (return_value);
 }
 
-optiga_lib_status_t optiga_crypt_hash_finalize(optiga_crypt_t * me,
-                                               optiga_hash_context_t * hash_ctx,
-                                               uint8_t * hash_output)
+/*
+* Sends the coalesced data and finalizes the sequence.
+* For hmac, the data of the caller is appended to the coalesced data, if it fits.
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_coalescing_flush_and_finalize(optiga_crypt_t * me,
+                                                                        const uint8_t * p_data,
+                                                                        uint32_t length,
+                                                                        uint8_t * p_output,
+                                                                        uint32_t * p_output_length)
 {
-    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
-    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+    uint16_t coalesced_length = me->coalesced_length;
+
     do
     {
-#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) ||
-            (NULL == hash_ctx) || (NULL == hash_output))
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
-#endif
-        return_value = optiga_crypt_hash_generic(me,
-                                                 hash_ctx->hash_algo,
-                                                 OPTIGA_CRYPT_HASH_FINAL,
-                                                 0,
-                                                 hash_ctx,
-                                                 hash_ctx->context_buffer_length,
-                                                 NULL,
-                                                 FALSE,
-                                                 hash_output);
-    } while (FALSE);
+        me->p_remaining_data = p_data;
+        me->remaining_length = length;
+        me->p_final_output = p_output;
+        me->p_final_output_length = p_output_length;
+        if ((OPTIGA_CRYPT_COALESCING_HMAC == me->coalesced_sequence) && (0 != coalesced_length) &&
+            (length <= (uint32_t)(OPTIGA_CRYPT_COALESCING_BUFFER_SIZE - coalesced_length)))
+        {
+            // Final data is sent along with the coalesced data
+            pal_os_memcpy(me->coalescing_buffer + coalesced_length, p_data, length);
+            me->p_remaining_data = me->coalescing_buffer;
+            me->remaining_length = coalesced_length + length;
+            coalesced_length = 0;
+        }
+        me->coalesced_length = 0;
+        if (0 == coalesced_length)
+        {
+            return_value = optiga_crypt_coalescing_finalize(me);
+            break;
+        }
 
+        me->coalescing_next_step = OPTIGA_CRYPT_COALESCING_STEP_FINALIZE;
+        return_value = optiga_crypt_coalescing_send(me, me->coalescing_buffer, coalesced_length);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            me->coalescing_next_step = OPTIGA_CRYPT_COALESCING_STEP_NONE;
+            me->coalesced_length = coalesced_length;
+        }
+    } while (FALSE);
     return (return_value);
 }
 
-optiga_lib_status_t optiga_crypt_hash(optiga_crypt_t * me,
-                                      optiga_hash_type_t hash_algorithm,
-                                      uint8_t source_of_data_to_hash,
-                                      const void * data_to_hash, 
-                                      uint8_t * hash_output)
+optiga_lib_status_t optiga_crypt_set_update_coalescing(optiga_crypt_t * me,
+                                                       bool_t enable)
 {
-    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
     OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == data_to_hash) || (NULL == hash_output))
+        if (NULL == me)
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
 #endif
-        return_value = optiga_crypt_hash_generic(me,
-                                                 (uint8_t)hash_algorithm,
-                                                 OPTIGA_CRYPT_HASH_START_FINAL,
-                                                 source_of_data_to_hash,
-                                                 NULL,
-                                                 0,
-                                                 data_to_hash,
-                                                 FALSE,
-                                                 hash_output);
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        // Coalesced data and a deferred hmac start must be flushed, before disabling
+        if ((FALSE == enable) && ((0 != me->coalesced_length) || (TRUE == me->coalesced_hmac_start_pending)))
+        {
+            break;
+        }
+        me->coalescing_enabled = enable;
+        return_value = OPTIGA_LIB_SUCCESS;
     } while (FALSE);
-
     return (return_value);
 }
-#endif //OPTIGA_CRYPT_HASH_ENABLED
-
-#ifdef OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED
-optiga_lib_status_t optiga_crypt_ecc_generate_keypair(optiga_crypt_t * me,
-                                                      optiga_ecc_curve_t curve_id,
-                                                      uint8_t key_usage,
-                                                      bool_t export_private_key,
-                                                      void * private_key,
-                                                      uint8_t * public_key,
-                                                      uint16_t * public_key_length)
-{
-    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
-    return (optiga_crypt_generate_keypair(me,
-                                         (uint8_t)curve_id,
-                                         key_usage,
-                                         export_private_key,
-                                         private_key,
-                                         public_key,
-                                         public_key_length));
-}
-#endif //OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED
-
-#ifdef OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
-optiga_lib_status_t optiga_crypt_ecdsa_sign(optiga_crypt_t * me,
-                                            const uint8_t * digest,
-                                            uint8_t digest_length,
-                                            optiga_key_id_t private_key,
-                                            uint8_t * signature,
-                                            uint16_t * signature_length)
-{
-    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
-    return (optiga_crypt_sign(me,
-                              OPTIGA_CRYPT_ECDSA_FIPS_186_3_WITHOUT_HASH,
-                              digest,
-                              digest_length,
-                              private_key,
-                              signature,
-                              signature_length,
-                              0x0000));
-}
-#endif //OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
-
-#ifdef OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED
-optiga_lib_status_t optiga_crypt_ecdsa_verify(optiga_crypt_t * me,
-                                              const uint8_t * digest,
-                                              uint8_t digest_length,
-                                              const uint8_t * signature,
-                                              uint16_t signature_length,
-                                              uint8_t public_key_source_type,
-                                              const void * public_key)
-{
-    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
-    return (optiga_crypt_verify(me,
-                                OPTIGA_CRYPT_ECDSA_FIPS_186_3_WITHOUT_HASH,
-                                digest,
-                                digest_length,
-                                signature,
-                                signature_length,
-                                public_key_source_type,
-                                public_key,
-                                0x0000));
-}
-#endif //OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED
-
 
-#ifdef OPTIGA_CRYPT_ECDH_ENABLED
-optiga_lib_status_t optiga_crypt_ecdh(optiga_crypt_t * me,
-                                      optiga_key_id_t private_key,
-                                      public_key_from_host_t * public_key,
-                                      bool_t export_to_host,
-                                      uint8_t * shared_secret)
+optiga_lib_status_t optiga_crypt_update_flush(optiga_crypt_t * me)
 {
-    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
-    optiga_calc_ssec_params_t * p_params;
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    uint16_t coalesced_length;
     OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
-
     do
     {
-
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == public_key) ||
-            (NULL == public_key->public_key) ||
-            ((TRUE == export_to_host) && (NULL == shared_secret)))
+        if (NULL == me)
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
 #endif
-
         if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
         {
             return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
             break;
         }
-
-        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
-
-        p_params = (optiga_calc_ssec_params_t *)&(me->params.optiga_calc_ssec_params);
-        pal_os_memset(&me->params,0x00,sizeof(optiga_crypt_params_t));
-
-        p_params->private_key = private_key;
-        p_params->public_key = public_key;
-        p_params->export_to_host = export_to_host;
-        p_params->shared_secret = shared_secret;
-        OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
-        OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
-
-        return_value = optiga_cmd_calc_ssec(me->my_cmd, OPTIGA_CRYPT_ECDH_KEY_AGREEMENT_ALGORITHM,
-                                            (optiga_calc_ssec_params_t *)p_params);
+        coalesced_length = me->coalesced_length;
+        if ((0 == coalesced_length) && (FALSE == me->coalesced_hmac_start_pending))
+        {
+            // Nothing to be sent, hence the operation is completed right away
+            return_value = OPTIGA_LIB_SUCCESS;
+            optiga_crypt_generic_event_handler(me, OPTIGA_LIB_SUCCESS);
+            break;
+        }
+        me->coalesced_length = 0;
+        return_value = optiga_crypt_coalescing_send(me, me->coalescing_buffer, coalesced_length);
         if (OPTIGA_LIB_SUCCESS != return_value)
         {
-            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+            me->coalesced_length = coalesced_length;
         }
     } while (FALSE);
-    optiga_crypt_reset_protection_level(me);
-    
     return (return_value);
 }
-#endif  //OPTIGA_CRYPT_ECDH_ENABLED
+#endif //OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
 
-#if defined (OPTIGA_CRYPT_TLS_PRF_SHA256_ENABLED) || defined (OPTIGA_CRYPT_TLS_PRF_SHA384_ENABLED) || defined (OPTIGA_CRYPT_TLS_PRF_SHA512_ENABLED)
-optiga_lib_status_t optiga_crypt_tls_prf(optiga_crypt_t * me,
-                                         optiga_tls_prf_type_t type,
-                                         uint16_t secret,
-                                         const uint8_t * label,
-                                         uint16_t label_length,
-                                         const uint8_t * seed,
-                                         uint16_t seed_length,
-                                         uint16_t derived_key_length,
-                                         bool_t export_to_host,
-                                         uint8_t * derived_key)
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+void optiga_crypt_set_comms_params(optiga_crypt_t * me,
+                                   uint8_t parameter_type,
+                                   uint8_t value)
 {
-    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
-    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    switch (parameter_type)
+    {
+        case OPTIGA_COMMS_PROTECTION_LEVEL:
+        {
+            me->protection_level = value;
+            break;
+        }
+        case OPTIGA_COMMS_PROTOCOL_VERSION:
+        {
+            me->protocol_version = value;
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+}
+#endif
+
+optiga_crypt_t * optiga_crypt_create(uint8_t optiga_instance_id,
+                                     callback_handler_t handler,
+                                     void * caller_context)
+{
+    optiga_crypt_t * me = NULL;
 
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == seed) ||
-           ((TRUE == export_to_host) && (NULL == derived_key)))
+        if (NULL == handler)
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
 #endif
+        me = (optiga_crypt_t *)pal_os_calloc(1, sizeof(optiga_crypt_t));
+        if (NULL == me)
+        {
+            break;
+        }
 
-        return_value = optiga_crypt_derive_key_generic(me,
-                                                       (uint8_t)type,
-                                                       secret,
-                                                       seed,
-                                                       seed_length,
-                                                       label,
-                                                       label_length,
-                                                       NULL,
-                                                       0,
-                                                       derived_key_length,
-                                                       export_to_host,
-                                                       derived_key);
-        
-    } while (FALSE);
-
-    return (return_value);
-}
-#endif //OPTIGA_CRYPT_TLS_PRF_SHA256_ENABLED || OPTIGA_CRYPT_TLS_PRF_SHA384_ENABLED || OPTIGA_CRYPT_TLS_PRF_SHA512_ENABLED
-
-
-#ifdef OPTIGA_CRYPT_RSA_GENERATE_KEYPAIR_ENABLED
-optiga_lib_status_t optiga_crypt_rsa_generate_keypair(optiga_crypt_t * me,
-                                                      optiga_rsa_key_type_t key_type,
-                                                      uint8_t key_usage,
-                                                      bool_t export_private_key,
-                                                      void * private_key,
-                                                      uint8_t * public_key,
-                                                      uint16_t * public_key_length)
-{
-    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
-    return (optiga_crypt_generate_keypair(me,
-                                         (uint8_t)key_type,
-                                         key_usage,
-                                         export_private_key,
-                                         private_key,
-                                         public_key,
-                                         public_key_length));
-}
-#endif //OPTIGA_CRYPT_RSA_GENERATE_KEYPAIR_ENABLED
-
+        me->handler = handler;
+        me->caller_context = caller_context;
+        me->instance_state = OPTIGA_LIB_SUCCESS;
+        me->p_params = &me->params;
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+        me->protocol_version = OPTIGA_COMMS_PROTOCOL_VERSION_PRE_SHARED_SECRET;
+        me->protection_level = OPTIGA_COMMS_DEFAULT_PROTECTION_LEVEL;
+#endif
+        me->my_cmd = optiga_cmd_create(optiga_instance_id,
+                                       optiga_crypt_generic_event_handler,
+                                       me);
+        if (NULL == me->my_cmd)
+        {
+            pal_os_free(me);
+            me = NULL;
+            break;
+        }
+#ifdef OPTIGA_LIB_SYNC_API_ENABLED
+        if (PAL_STATUS_SUCCESS != pal_os_wait_create(&me->sync_wait))
+        {
+            (void)optiga_cmd_destroy(me->my_cmd);
+            pal_os_free(me);
+            me = NULL;
+        }
+#endif //OPTIGA_LIB_SYNC_API_ENABLED
 
-#ifdef OPTIGA_CRYPT_RSA_SIGN_ENABLED
-optiga_lib_status_t optiga_crypt_rsa_sign(optiga_crypt_t * me,
-                                          optiga_rsa_signature_scheme_t signature_scheme,
-                                          const uint8_t * digest,
-                                          uint8_t digest_length,
-                                          optiga_key_id_t private_key,
-                                          uint8_t * signature,
-                                          uint16_t * signature_length,
-                                          uint16_t salt_length)
-{
-    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
-    return (optiga_crypt_sign(me,
-                             (uint8_t)signature_scheme,
-                             digest,
-                             digest_length,
-                             private_key,
-                             signature,
-                             signature_length,
-                             salt_length));
-}
+    } while (FALSE);
 
-#endif //OPTIGA_CRYPT_RSA_SIGN_ENABLED
-#ifdef OPTIGA_CRYPT_RSA_VERIFY_ENABLED
-optiga_lib_status_t optiga_crypt_rsa_verify(optiga_crypt_t * me,
-                                            optiga_rsa_signature_scheme_t signature_scheme,
-                                            const uint8_t * digest,
-                                            uint8_t digest_length,
-                                            const uint8_t * signature,
-                                            uint16_t signature_length,
-                                            uint8_t public_key_source_type,
-                                            const void * public_key,
-                                            uint16_t salt_length)
-{
-    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
-    return (optiga_crypt_verify(me,
-                                (uint8_t)signature_scheme,
-                                digest,
-                                digest_length,
-                                signature,
-                                signature_length,
-                                public_key_source_type,
-                                public_key,
-                                salt_length));
+    return (me);
 }
-#endif //OPTIGA_CRYPT_RSA_VERIFY_ENABLED
 
-#ifdef OPTIGA_CRYPT_RSA_ENCRYPT_ENABLED
-optiga_lib_status_t optiga_crypt_rsa_encrypt_message(optiga_crypt_t * me,
-                                                     optiga_rsa_encryption_scheme_t encryption_scheme,
-                                                     const uint8_t * message,
-                                                     uint16_t message_length,
-                                                     const uint8_t * label,
-                                                     uint16_t label_length,
-                                                     uint8_t public_key_source_type,
-                                                     const void * public_key,
-                                                     uint8_t * encrypted_message,
-                                                     uint16_t * encrypted_message_length)
+optiga_lib_status_t optiga_crypt_destroy(optiga_crypt_t * me)
 {
+    optiga_lib_status_t return_value;
 
-    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
-    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == message)||
-            (NULL == public_key) || (NULL == encrypted_message) || (NULL == encrypted_message_length))
+        if (NULL == me)
         {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
 #endif
-        return_value =  optiga_crypt_rsa_enc_dec(me,
-                                                 encryption_scheme,
-                                                 message,
-                                                 message_length,
-                                                 label,
-                                                 label_length,
-                                                 public_key_source_type,
-                                                 public_key,
-                                                 encrypted_message,
-                                                 encrypted_message_length,
-                                                 TRUE);
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        return_value = optiga_cmd_destroy(me->my_cmd);
+#ifdef OPTIGA_LIB_SYNC_API_ENABLED
+        pal_os_wait_destroy(&me->sync_wait);
+#endif //OPTIGA_LIB_SYNC_API_ENABLED
+        pal_os_free(me);
+
     } while (FALSE);
     return (return_value);
 }
 
-optiga_lib_status_t optiga_crypt_rsa_encrypt_session(optiga_crypt_t * me,
-                                                     optiga_rsa_encryption_scheme_t encryption_scheme,
-                                                     const uint8_t * label,
-                                                     uint16_t label_length,
-                                                     uint8_t public_key_source_type,
-                                                     const void * public_key,
-                                                     uint8_t * encrypted_message,
-                                                     uint16_t * encrypted_message_length)
+optiga_lib_status_t optiga_crypt_set_priority(optiga_crypt_t * me,
+                                              optiga_lib_priority_t priority)
 {
     optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
-    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == encrypted_message)|| (NULL == encrypted_message_length) ||
-            (NULL == public_key))
+        if ((NULL == me) || (NULL == me->my_cmd))
         {
             break;
         }
 #endif
-#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
-        me->protection_level |= OPTIGA_COMMS_COMMAND_PROTECTION;
-#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
-        return_value =  optiga_crypt_rsa_enc_dec(me,
-                                                 encryption_scheme,
-                                                 NULL,
-                                                 0,
-                                                 label,
-                                                 label_length,
-                                                 public_key_source_type,
-                                                 public_key,
-                                                 encrypted_message,
-                                                 encrypted_message_length,
-                                                 TRUE);
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_set_priority(me->my_cmd, (uint8_t)priority))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
     } while (FALSE);
     return (return_value);
 }
 
-#endif //OPTIGA_CRYPT_RSA_ENCRYPT_ENABLED
-#ifdef OPTIGA_CRYPT_RSA_DECRYPT_ENABLED
-optiga_lib_status_t optiga_crypt_rsa_decrypt_and_export(optiga_crypt_t * me,
-                                                        optiga_rsa_encryption_scheme_t encryption_scheme,
-                                                        const uint8_t * encrypted_message,
-                                                        uint16_t encrypted_message_length,
-                                                        const uint8_t * label,
-                                                        uint16_t label_length,
-                                                        optiga_key_id_t private_key,
-                                                        uint8_t * message,
-                                                        uint16_t * message_length)
+#ifdef OPTIGA_CMD_DEADLINE_ENABLED
+optiga_lib_status_t optiga_crypt_set_deadline(optiga_crypt_t * me,
+                                              uint32_t deadline_us)
 {
     optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
-    optiga_key_id_t private_key_id;
-    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == message) || (NULL == message_length)||
-            (NULL == encrypted_message))
+        if ((NULL == me) || (NULL == me->my_cmd))
         {
             break;
         }
 #endif
-#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
-        me->protection_level |= OPTIGA_COMMS_RESPONSE_PROTECTION;
-#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
-        private_key_id = private_key;
-        return_value = optiga_crypt_rsa_enc_dec(me,
-                                                encryption_scheme,
-                                                encrypted_message,
-                                                encrypted_message_length,
-                                                label,
-                                                label_length,
-                                                0,
-                                                (void *)&private_key_id,
-                                                message,
-                                                message_length,
-                                                FALSE);
+        return_value = optiga_cmd_set_deadline(me->my_cmd, deadline_us);
     } while (FALSE);
-
     return (return_value);
 }
+#endif //OPTIGA_CMD_DEADLINE_ENABLED
 
-optiga_lib_status_t optiga_crypt_rsa_decrypt_and_store(optiga_crypt_t * me,
-                                                       optiga_rsa_encryption_scheme_t encryption_scheme,
-                                                       const uint8_t * encrypted_message,
-                                                       uint16_t encrypted_message_length,
-                                                       const uint8_t * label,
-                                                       uint16_t label_length,
-                                                       optiga_key_id_t private_key)
+#ifdef OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+optiga_lib_status_t optiga_crypt_set_deferrable(optiga_crypt_t * me,
+                                                uint32_t max_delay_ms)
 {
     optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
-    optiga_key_id_t private_key_id;
-    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
 
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == encrypted_message))
+        if ((NULL == me) || (NULL == me->my_cmd))
         {
-           break;
+            break;
         }
 #endif
-        private_key_id = private_key;
-        return_value = optiga_crypt_rsa_enc_dec(me,
-                                                encryption_scheme,
-                                                encrypted_message,
-                                                encrypted_message_length,
-                                                label,
-                                                label_length,
-                                                0,
-                                                (void *)&private_key_id,
-                                                NULL,
-                                                NULL,
-                                                FALSE);
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_set_deferrable(me->my_cmd, max_delay_ms))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
     } while (FALSE);
-
     return (return_value);
 }
-#endif //OPTIGA_CRYPT_RSA_DECRYPT_ENABLED
-#ifdef OPTIGA_CRYPT_RSA_PRE_MASTER_SECRET_ENABLED
-optiga_lib_status_t optiga_crypt_rsa_generate_pre_master_secret(optiga_crypt_t * me,
-                                                                const uint8_t * optional_data,
-                                                                uint16_t optional_data_length,
-                                                                uint16_t pre_master_secret_length)
+#endif //OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+
+#ifdef OPTIGA_CMD_CANCEL_ENABLED
+optiga_lib_status_t optiga_crypt_cancel(optiga_crypt_t * me)
 {
-    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
-    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
 
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        /// Maximum length of shared secret supported by OPTIGA is 48 bytes, minimum is 8 bytes.
         if ((NULL == me) || (NULL == me->my_cmd))
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
 #endif
-
-        /// The minimum difference between shared secret length and optional data length should be 8 bytes,
-        /// since the minimum random length OPTIGA expects is 8 bytes (optional_data_length <= shared_length - 8 bytes).
-        if (((optional_data_length + OPTIGA_CRYPT_MINIMUM_RANDOM_DATA_LENGTH) > pre_master_secret_length) ||
-            (optional_data_length > OPTIGA_CRYPT_MINIMUM_OPTIONAL_DATA_LENGTH))
+        return_value = OPTIGA_LIB_SUCCESS;
+        // Nothing to be cancelled, if no operation is ongoing
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
-            break;
+            return_value = optiga_cmd_cancel(me->my_cmd);
         }
-
-        return_value = optiga_crypt_get_random(me,
-                                               OPTIGA_CRYTP_RANDOM_PARAM_PRE_MASTER_SECRET,
-                                               NULL,
-                                               (pre_master_secret_length - optional_data_length),
-                                               optional_data,
-                                               optional_data_length,
-                                               TRUE);
     } while (FALSE);
-
     return (return_value);
 }
-#endif //OPTIGA_CRYPT_RSA_PRE_MASTER_SECRET_ENABLED
-
-#ifdef OPTIGA_CRYPT_SYM_ENCRYPT_ENABLED
+#endif //OPTIGA_CMD_CANCEL_ENABLED
 
-optiga_lib_status_t optiga_crypt_symmetric_encrypt(optiga_crypt_t * me,
-                                                   optiga_symmetric_encryption_mode_t encryption_mode,
-                                                   optiga_key_id_t symmetric_key_oid,
-                                                   const uint8_t * plain_data,
-                                                   uint32_t plain_data_length,
-                                                   const uint8_t * iv,
-                                                   uint16_t iv_length,
-                                                   const uint8_t * associated_data,
-                                                   uint16_t associated_data_length,
-                                                   uint8_t * encrypted_data,
-                                                   uint32_t * encrypted_data_length)
+#ifdef OPTIGA_CMD_FAIR_SHARE_ENABLED
+optiga_lib_status_t optiga_crypt_set_tenant(optiga_crypt_t * me,
+                                            uint8_t tenant)
 {
-    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
-    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == plain_data) || 
-            (NULL == encrypted_data) || (NULL == encrypted_data_length))
+        if ((NULL == me) || (NULL == me->my_cmd))
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
 #endif
-        return_value =  optiga_crypt_symmetric_mode_generic(me,
-                                                            (uint8_t)encryption_mode,
-                                                            (uint16_t)symmetric_key_oid,
-                                                            plain_data,
-                                                            plain_data_length,
-                                                            iv,
-                                                            iv_length,
-                                                            associated_data,
-                                                            associated_data_length,
-                                                            0,
-                                                            encrypted_data,
-                                                            encrypted_data_length,
-                                                            NULL,
-                                                            0,
-                                                            OPTIGA_CRYPT_SYM_START_FINAL,
-                                                            OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION,
-                                                            OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION);
-    } while(FALSE);
-    optiga_crypt_reset_protection_level(me);
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_set_tenant(me->my_cmd, tenant))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
     return (return_value);
 }
+#endif //OPTIGA_CMD_FAIR_SHARE_ENABLED
 
-optiga_lib_status_t optiga_crypt_symmetric_encrypt_start(optiga_crypt_t * me,
-                                                         optiga_symmetric_encryption_mode_t encryption_mode,
-                                                         optiga_key_id_t symmetric_key_oid,
-                                                         const uint8_t * plain_data,
-                                                         uint32_t plain_data_length,
-                                                         const uint8_t * iv,
-                                                         uint16_t iv_length,
-                                                         const uint8_t * associated_data,
-                                                         uint16_t associated_data_length,
-                                                         uint16_t total_plain_data_length,
-                                                         uint8_t * encrypted_data,
-                                                         uint32_t * encrypted_data_length)
+#ifdef OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+optiga_lib_status_t optiga_crypt_try_admit(const optiga_crypt_t * me,
+                                           uint32_t max_wait_us,
+                                           uint32_t * p_estimated_wait_us)
 {
-    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
-    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == plain_data) ||
-           (((NULL == encrypted_data) || (NULL == encrypted_data_length)) && \
-           (OPTIGA_SYMMETRIC_CBC_MAC != encryption_mode)))
+        if ((NULL == me) || (NULL == me->my_cmd))
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
 #endif
-        return_value =  optiga_crypt_symmetric_mode_generic(me,
-                                                            (uint8_t)encryption_mode,
-                                                            (uint16_t)symmetric_key_oid,
-                                                            plain_data,
-                                                            plain_data_length,
-                                                            iv,
-                                                            iv_length,
-                                                            associated_data,
-                                                            associated_data_length,
-                                                            total_plain_data_length,
-                                                            encrypted_data,
-                                                            encrypted_data_length,
-                                                            NULL,
-                                                            0,        
-                                                            OPTIGA_CRYPT_SYM_START,
-                                                            OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION,
-                                                            OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION);
-    } while(FALSE);
-    optiga_crypt_reset_protection_level(me);
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_try_admit(me->my_cmd, max_wait_us, p_estimated_wait_us))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_QUEUE_FULL;
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
     return (return_value);
 }
+#endif //OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
 
-
-optiga_lib_status_t optiga_crypt_symmetric_encrypt_continue(optiga_crypt_t * me,
-                                                            const uint8_t * plain_data,
-                                                            uint32_t plain_data_length,
-                                                            uint8_t * encrypted_data,
-                                                            uint32_t * encrypted_data_length)
+#ifdef OPTIGA_CMD_SESSION_POOL_ENABLED
+optiga_lib_status_t optiga_crypt_set_session_policy(optiga_crypt_t * me,
+                                                    optiga_lib_session_policy_t policy,
+                                                    uint32_t lease_time_us)
 {
-    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
-    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
 
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == plain_data) ||
-           (((NULL == encrypted_data) || (NULL == encrypted_data_length)) && (OPTIGA_SYMMETRIC_CBC_MAC != \
-           ((optiga_symmetric_encryption_mode_t)\
-           ((optiga_encrypt_sym_params_t *)&(me->params.optiga_symmetric_enc_dec_params))->mode))))
+        if ((NULL == me) || (NULL == me->my_cmd))
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
 #endif
-        return_value =  optiga_crypt_symmetric_mode_generic(me,
-                                                            0,
-                                                            0,
-                                                            plain_data,
-                                                            plain_data_length,
-                                                            NULL,
-                                                            0,
-                                                            NULL,
-                                                            0,
-                                                            0,
-                                                            encrypted_data,
-                                                            encrypted_data_length,
-                                                            NULL,
-                                                            0,        
-                                                            OPTIGA_CRYPT_SYM_CONTINUE,
-                                                            OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION,
-                                                            OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION);
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_set_session_policy(me->my_cmd, (uint8_t)policy, lease_time_us))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
     } while (FALSE);
-    optiga_crypt_reset_protection_level(me);
     return (return_value);
 }
 
-optiga_lib_status_t optiga_crypt_symmetric_encrypt_final(optiga_crypt_t * me,
-                                                         const uint8_t * plain_data,
-                                                         uint32_t plain_data_length,
-                                                         uint8_t * encrypted_data,
-                                                         uint32_t * encrypted_data_length)
+optiga_lib_status_t optiga_crypt_get_session_pool_stats(const optiga_crypt_t * me,
+                                                        optiga_lib_session_pool_stats_t * p_stats)
 {
-    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
-    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) ||
-           (NULL == plain_data) || (NULL == encrypted_data) || (NULL == encrypted_data_length))
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == p_stats))
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
 #endif
-        return_value = optiga_crypt_symmetric_mode_generic(me,
-                                                           0,
-                                                           0,
-                                                           plain_data,
-                                                           plain_data_length,
-                                                           NULL,
-                                                           0,
-                                                           NULL,
-                                                           0,
-                                                           0,
-                                                           encrypted_data,
-                                                           encrypted_data_length,
-                                                           NULL,
-                                                           0,        
-                                                           OPTIGA_CRYPT_SYM_FINAL,
-                                                           OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION,
-                                                           OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION);
+        optiga_cmd_get_session_pool_stats(me->my_cmd, p_stats);
+        return_value = OPTIGA_LIB_SUCCESS;
     } while (FALSE);
-    optiga_crypt_reset_protection_level(me);
     return (return_value);
 }
 
+optiga_lib_status_t optiga_crypt_release_session(optiga_crypt_t * me)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
 
-optiga_lib_status_t optiga_crypt_symmetric_encrypt_ecb(optiga_crypt_t * me,
-                                                       optiga_key_id_t symmetric_key_oid,
-                                                       const uint8_t * plain_data,
-                                                       uint32_t plain_data_length,
-                                                       uint8_t * encrypted_data,
-                                                       uint32_t * encrypted_data_length)
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        if (OPTIGA_CMD_SUCCESS != optiga_cmd_release_session(me->my_cmd))
+        {
+            return_value = OPTIGA_CRYPT_ERROR;
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+#endif //OPTIGA_CMD_SESSION_POOL_ENABLED
+
+#ifdef OPTIGA_CRYPT_RANDOM_ENABLED
+optiga_lib_status_t optiga_crypt_random(optiga_crypt_t * me,
+                                        optiga_rng_type_t rng_type,
+                                        uint8_t * random_data,
+                                        uint16_t random_data_length)
 {
     optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
     OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) ||
-           (NULL == plain_data) || (NULL == encrypted_data) || (NULL == encrypted_data_length))
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == random_data))
         {
             return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
 #endif
-        return_value = optiga_crypt_symmetric_mode_generic(me,
-                                                           (uint8_t)OPTIGA_SYMMETRIC_ECB,
-                                                           (uint16_t)symmetric_key_oid,
-                                                           plain_data,
-                                                           plain_data_length,
-                                                           NULL,
-                                                           0,
-                                                           NULL,
-                                                           0,
-                                                           0,
-                                                           encrypted_data,
-                                                           encrypted_data_length,
-                                                           NULL,
-                                                           0,        
-                                                           OPTIGA_CRYPT_SYM_START_FINAL,
-                                                           OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION,
-                                                           OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION);
+        return_value = optiga_crypt_get_random(me,
+                                               (uint8_t)rng_type,
+                                               random_data,
+                                               random_data_length,
+                                               NULL,
+                                               0x00,
+                                               FALSE);
     } while (FALSE);
-    optiga_crypt_reset_protection_level(me);
+
     return (return_value);
 }
+#endif //OPTIGA_CRYPT_RANDOM_ENABLED
 
-#endif //OPTIGA_CRYPT_SYM_ENCRYPT_ENABLED
-
-#ifdef OPTIGA_CRYPT_SYM_DECRYPT_ENABLED
-
-optiga_lib_status_t optiga_crypt_symmetric_decrypt(optiga_crypt_t * me,
-                                                   optiga_symmetric_encryption_mode_t encryption_mode,
-                                                   optiga_key_id_t symmetric_key_oid,
-                                                   const uint8_t * encrypted_data,
-                                                   uint32_t encrypted_data_length,
-                                                   const uint8_t * iv,
-                                                   uint16_t iv_length,
-                                                   const uint8_t * associated_data,
-                                                   uint16_t associated_data_length,
-                                                   uint8_t * plain_data,
-                                                   uint32_t * plain_data_length)
+#ifdef OPTIGA_CRYPT_HASH_ENABLED
+optiga_lib_status_t optiga_crypt_hash_start(optiga_crypt_t * me,
+                                            optiga_hash_context_t * hash_ctx)
 {
     optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
     OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
-    do
+    do  
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == encrypted_data) || 
-            (NULL == plain_data) || (NULL == plain_data_length))
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == hash_ctx))
         {
             return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
 #endif
-        return_value =  optiga_crypt_symmetric_mode_generic(me,
-                                                            (uint8_t)encryption_mode,
-                                                            (uint16_t)symmetric_key_oid,
-                                                            encrypted_data,
-                                                            encrypted_data_length,
-                                                            iv,
-                                                            iv_length,
-                                                            associated_data,
-                                                            associated_data_length,
-                                                            0,
-                                                            plain_data,
-                                                            plain_data_length,
-                                                            NULL,
-                                                            0,        
-                                                            OPTIGA_CRYPT_SYM_START_FINAL,
-                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION,
-                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION);
-    } while(FALSE);
-    optiga_crypt_reset_protection_level(me);
+#ifdef OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED
+        if (TRUE == me->hash_offload_enabled)
+        {
+            return_value = optiga_crypt_hash_offload(me, hash_ctx->hash_algo, OPTIGA_CRYPT_HASH_START, hash_ctx, NULL, NULL);
+            break;
+        }
+#endif //OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED
+        return_value = optiga_crypt_hash_generic(me,
+                                                 hash_ctx->hash_algo,
+                                                 OPTIGA_CRYPT_HASH_START,
+                                                 0,
+                                                 hash_ctx,
+                                                 0,
+                                                 NULL,
+                                                 TRUE,
+                                                 NULL);
+    } while (FALSE);
+
     return (return_value);
 }
 
-optiga_lib_status_t optiga_crypt_symmetric_decrypt_ecb(optiga_crypt_t * me,
-                                                       optiga_key_id_t symmetric_key_oid,
-                                                       const uint8_t * encrypted_data,
-                                                       uint32_t encrypted_data_length,
-                                                       uint8_t * plain_data,
-                                                       uint32_t * plain_data_length)
+optiga_lib_status_t optiga_crypt_hash_update(optiga_crypt_t * me,
+                                             optiga_hash_context_t * hash_ctx,
+                                             uint8_t source_of_data_to_hash,
+                                             const void * data_to_hash)
 {
     optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
     OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
-
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == plain_data) ||
-            (NULL == encrypted_data) || (NULL == plain_data_length))
+        if ((NULL == me) || (NULL == me->my_cmd) ||
+            (NULL == hash_ctx) || (NULL == data_to_hash))
         {
             return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
 #endif
-        return_value =  optiga_crypt_symmetric_mode_generic(me,
-                                                            (uint8_t)OPTIGA_SYMMETRIC_ECB,
-                                                            (uint16_t)symmetric_key_oid,
-                                                            encrypted_data,
-                                                            encrypted_data_length,
-                                                            NULL,
-                                                            0,
-                                                            NULL,
-                                                            0,
-                                                            0,
-                                                            plain_data,
-                                                            plain_data_length,
-                                                            NULL,
-                                                            0,        
-                                                            OPTIGA_CRYPT_SYM_START_FINAL,
-                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION,
-                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION);
+#ifdef OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED
+        if (TRUE == me->hash_offload_enabled)
+        {
+            // The state of the sequence is on host, hence data in OPTIGA can't be hashed in the same sequence
+            if (OPTIGA_CRYPT_HOST_DATA != source_of_data_to_hash)
+            {
+                return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+                break;
+            }
+            return_value = optiga_crypt_hash_offload(me,
+                                                     hash_ctx->hash_algo,
+                                                     OPTIGA_CRYPT_HASH_CONTINUE,
+                                                     hash_ctx,
+                                                     (const hash_data_from_host_t *)data_to_hash,
+                                                     NULL);
+            break;
+        }
+#endif //OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED
+#ifdef OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+        if (TRUE == me->coalescing_enabled)
+        {
+            return_value = optiga_crypt_coalescing_begin(me, OPTIGA_CRYPT_COALESCING_HASH, hash_ctx);
+            if (OPTIGA_LIB_SUCCESS != return_value)
+            {
+                break;
+            }
+            if (OPTIGA_CRYPT_OID_DATA != source_of_data_to_hash)
+            {
+                return_value = optiga_crypt_coalescing_add(me,
+                                                           ((const hash_data_from_host_t *)data_to_hash)->buffer,
+                                                           ((const hash_data_from_host_t *)data_to_hash)->length);
+                break;
+            }
+            // Data in OPTIGA is hashed in order, only if the coalesced data is flushed
+            if (0 != me->coalesced_length)
+            {
+                return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+                break;
+            }
+        }
+#endif //OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+        return_value = optiga_crypt_hash_generic(me,
+                                                 hash_ctx->hash_algo,
+                                                 OPTIGA_CRYPT_HASH_CONTINUE,
+                                                 source_of_data_to_hash,
+                                                 hash_ctx,
+                                                 hash_ctx->context_buffer_length,
+                                                 data_to_hash,
+                                                 TRUE,
+                                                 NULL);
     } while (FALSE);
-    optiga_crypt_reset_protection_level(me);
+
     return (return_value);
 }
 
-optiga_lib_status_t optiga_crypt_symmetric_decrypt_start(optiga_crypt_t * me,
-                                                         optiga_symmetric_encryption_mode_t encryption_mode,
-                                                         optiga_key_id_t symmetric_key_oid,
-                                                         const uint8_t * encrypted_data,
-                                                         uint32_t encrypted_data_length,
-                                                         const uint8_t * iv,
-                                                         uint16_t iv_length,
-                                                         const uint8_t * associated_data,
-                                                         uint16_t associated_data_length,
-                                                         uint16_t total_encrypted_data_length,
-                                                         uint8_t * plain_data,
-                                                         uint32_t * plain_data_length)
+optiga_lib_status_t optiga_crypt_hash_finalize(optiga_crypt_t * me,
+                                               optiga_hash_context_t * hash_ctx,
+                                               uint8_t * hash_output)
 {
     optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
     OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == encrypted_data) || 
-            (NULL == plain_data) || (NULL == plain_data_length))
+        if ((NULL == me) || (NULL == me->my_cmd) ||
+            (NULL == hash_ctx) || (NULL == hash_output))
         {
             return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
 #endif
-        return_value =  optiga_crypt_symmetric_mode_generic(me,
-                                                            (uint8_t)encryption_mode,
-                                                            (uint16_t)symmetric_key_oid,
-                                                            encrypted_data,
-                                                            encrypted_data_length,
-                                                            iv,
-                                                            iv_length,
-                                                            associated_data,
-                                                            associated_data_length,
-                                                            total_encrypted_data_length,
-                                                            plain_data,
-                                                            plain_data_length,
-                                                            NULL,
-                                                            0,        
-                                                            OPTIGA_CRYPT_SYM_START,
-                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION,
-                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION);
-    } while(FALSE);
-    optiga_crypt_reset_protection_level(me);
+#ifdef OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED
+        if (TRUE == me->hash_offload_enabled)
+        {
+            return_value = optiga_crypt_hash_offload(me, hash_ctx->hash_algo, OPTIGA_CRYPT_HASH_FINAL, hash_ctx, NULL, hash_output);
+            break;
+        }
+#endif //OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED
+#ifdef OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+        if ((OPTIGA_CRYPT_COALESCING_HASH == me->coalesced_sequence) && (hash_ctx == me->p_coalesced_hash_ctx))
+        {
+            return_value = optiga_crypt_coalescing_flush_and_finalize(me, NULL, 0, hash_output, NULL);
+            break;
+        }
+#endif //OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+        return_value = optiga_crypt_hash_generic(me,
+                                                 hash_ctx->hash_algo,
+                                                 OPTIGA_CRYPT_HASH_FINAL,
+                                                 0,
+                                                 hash_ctx,
+                                                 hash_ctx->context_buffer_length,
+                                                 NULL,
+                                                 FALSE,
+                                                 hash_output);
+    } while (FALSE);
+
     return (return_value);
 }
 
-optiga_lib_status_t optiga_crypt_symmetric_decrypt_continue(optiga_crypt_t * me,
-                                                            const uint8_t * encrypted_data,
-                                                            uint32_t encrypted_data_length,
-                                                            uint8_t * plain_data,
-                                                            uint32_t * plain_data_length)
+optiga_lib_status_t optiga_crypt_hash(optiga_crypt_t * me,
+                                      optiga_hash_type_t hash_algorithm,
+                                      uint8_t source_of_data_to_hash,
+                                      const void * data_to_hash, 
+                                      uint8_t * hash_output)
 {
     optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
     OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == encrypted_data) ||
-            (NULL == plain_data) || (NULL == plain_data_length))
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == data_to_hash) || (NULL == hash_output))
         {
             return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
 #endif
-        return_value =  optiga_crypt_symmetric_mode_generic(me,
-                                                            0,
-                                                            0,
-                                                            encrypted_data,
-                                                            encrypted_data_length,
-                                                            NULL,
-                                                            0,
-                                                            NULL,
-                                                            0,
-                                                            0,
-                                                            plain_data,
-                                                            plain_data_length,
-                                                            NULL,
-                                                            0,        
-                                                            OPTIGA_CRYPT_SYM_CONTINUE,
-                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION,
-                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION);
-    } while(FALSE);
-    optiga_crypt_reset_protection_level(me);
+#ifdef OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED
+        // Data in OPTIGA is always hashed by OPTIGA
+        if ((OPTIGA_CRYPT_HOST_DATA == source_of_data_to_hash) &&
+            (TRUE == OPTIGA_CRYPT_OFFLOAD_TO_HOST(me, OPTIGA_LIB_OFFLOAD_HASH, me->hash_offload_enabled)))
+        {
+            return_value = optiga_crypt_hash_offload(me,
+                                                     (uint8_t)hash_algorithm,
+                                                     OPTIGA_CRYPT_HASH_START_FINAL,
+                                                     NULL,
+                                                     (const hash_data_from_host_t *)data_to_hash,
+                                                     hash_output);
+            break;
+        }
+#endif //OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED
+        return_value = optiga_crypt_hash_generic(me,
+                                                 (uint8_t)hash_algorithm,
+                                                 OPTIGA_CRYPT_HASH_START_FINAL,
+                                                 source_of_data_to_hash,
+                                                 NULL,
+                                                 0,
+                                                 data_to_hash,
+                                                 FALSE,
+                                                 hash_output);
+    } while (FALSE);
+#if defined (OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED) && defined (OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED)
+    if (NULL != me)
+    {
+        optiga_crypt_offload_abort(me, return_value);
+    }
+#endif //(OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED) && (OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED)
+
     return (return_value);
 }
 
-optiga_lib_status_t optiga_crypt_symmetric_decrypt_final(optiga_crypt_t * me,
-                                                         const uint8_t * encrypted_data,
-                                                         uint32_t encrypted_data_length,
-                                                         uint8_t * plain_data,
-                                                         uint32_t * plain_data_length)
+#ifdef OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED
+optiga_lib_status_t optiga_crypt_set_hash_offload(optiga_crypt_t * me,
+                                                  bool_t enable)
 {
-    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
     OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == encrypted_data) ||
-            (NULL == plain_data) || (NULL == plain_data_length))
+        if (NULL == me)
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
 #endif
-        return_value =  optiga_crypt_symmetric_mode_generic(me,
-                                                            0,
-                                                            0,
-                                                            encrypted_data,
-                                                            encrypted_data_length,
-                                                            NULL,
-                                                            0,
-                                                            NULL,
-                                                            0,
-                                                            0,
-                                                            plain_data,
-                                                            plain_data_length,
-                                                            NULL,
-                                                            0,        
-                                                            OPTIGA_CRYPT_SYM_FINAL,
-                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION,
-                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION);
-    } while(FALSE);
-    optiga_crypt_reset_protection_level(me);
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        me->hash_offload_enabled = enable;
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
     return (return_value);
 }
+#endif //OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED
+#endif //OPTIGA_CRYPT_HASH_ENABLED
 
-#endif //OPTIGA_CRYPT_SYM_DECRYPT_ENABLED
-
-#ifdef OPTIGA_CRYPT_HMAC_ENABLED
-
-optiga_lib_status_t optiga_crypt_hmac(optiga_crypt_t * me, 
-                                      optiga_hmac_type_t type, 
-                                      uint16_t secret, 
-                                      const uint8_t * input_data, 
-                                      uint32_t input_data_length, 
-                                      uint8_t * mac, 
-                                      uint32_t * mac_length)
+#ifdef OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
+optiga_lib_status_t optiga_crypt_set_offload_policy(optiga_crypt_t * me,
+                                                    const optiga_lib_offload_policy_t * p_policy)
 {
-    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
     OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == input_data) || 
-            (NULL == mac) || (NULL == mac_length))
+        if ((NULL == me) || (NULL == me->my_cmd))
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
 #endif
-        return_value =  optiga_crypt_symmetric_mode_generic(me,
-                                                            (uint8_t)type,
-                                                            secret,
-                                                            input_data,
-                                                            input_data_length,
-                                                            NULL,
-                                                            0,
-                                                            NULL,
-                                                            0,
-                                                            0,
-                                                            mac,
-                                                            mac_length,
-                                                            NULL,
-                                                            0,        
-                                                            OPTIGA_CRYPT_SYM_START_FINAL,
-                                                            OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION,
-                                                            OPTIGA_CRYPT_HMAC);
-    } while(FALSE);
-    optiga_crypt_reset_protection_level(me);
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_set_offload_policy(me->my_cmd, p_policy))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
     return (return_value);
 }
 
-optiga_lib_status_t optiga_crypt_hmac_start(optiga_crypt_t * me, 
-                                            optiga_hmac_type_t type, 
-                                            uint16_t secret, 
-                                            const uint8_t * input_data, 
-                                            uint32_t input_data_length)
+optiga_lib_status_t optiga_crypt_set_security_class(optiga_crypt_t * me,
+                                                    optiga_lib_security_class_t security_class)
 {
-    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
     OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == input_data))
+        if (NULL == me)
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
 #endif
-        return_value =  optiga_crypt_symmetric_mode_generic(me,
-                                                            (uint8_t)type,
-                                                            secret,
-                                                            input_data,
-                                                            input_data_length,
-                                                            NULL,
-                                                            0,
-                                                            NULL,
-                                                            0,
-                                                            0,
-                                                            NULL,
-                                                            NULL,
-                                                            NULL,
-                                                            0,        
-                                                            OPTIGA_CRYPT_SYM_START,
-                                                            OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION,
-                                                            OPTIGA_CRYPT_HMAC);
-    } while(FALSE);
-    optiga_crypt_reset_protection_level(me);
+        if ((OPTIGA_LIB_SECURITY_CLASS_PUBLIC != security_class) &&
+            (OPTIGA_LIB_SECURITY_CLASS_CHIP_ONLY != security_class))
+        {
+            break;
+        }
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        me->security_class = (uint8_t)security_class;
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
     return (return_value);
 }
 
-optiga_lib_status_t optiga_crypt_hmac_update(optiga_crypt_t * me,
-                                             const uint8_t * input_data,
-                                             uint32_t input_data_length)
+optiga_lib_status_t optiga_crypt_get_offload_stats(const optiga_crypt_t * me,
+                                                   optiga_lib_offload_operation_t operation,
+                                                   optiga_lib_offload_stats_t * p_stats)
 {
-    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
     OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == input_data))
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == p_stats))
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
 #endif
-        return_value =  optiga_crypt_symmetric_mode_generic(me,
-                                                            0,
-                                                            0,
-                                                            input_data,
-                                                            input_data_length,
-                                                            NULL,
-                                                            0,
-                                                            NULL,
-                                                            0,
-                                                            0,
-                                                            NULL,
-                                                            NULL,
-                                                            NULL,
-                                                            0,        
-                                                            OPTIGA_CRYPT_SYM_CONTINUE,
-                                                            OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION,
-                                                            OPTIGA_CRYPT_HMAC);
-    } while(FALSE);
-    optiga_crypt_reset_protection_level(me);
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_get_offload_stats(me->my_cmd, (uint8_t)operation, p_stats))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
     return (return_value);
 }
+#endif //OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
 
-optiga_lib_status_t optiga_crypt_hmac_finalize(optiga_crypt_t * me,
-                                               const uint8_t * input_data,
-                                               uint32_t input_data_length,
-                                               uint8_t * mac, 
-                                               uint32_t * mac_length)
+#ifdef OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED
+optiga_lib_status_t optiga_crypt_ecc_generate_keypair(optiga_crypt_t * me,
+                                                      optiga_ecc_curve_t curve_id,
+                                                      uint8_t key_usage,
+                                                      bool_t export_private_key,
+                                                      void * private_key,
+                                                      uint8_t * public_key,
+                                                      uint16_t * public_key_length)
 {
-    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
     OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
-    do
-    {
-#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == input_data) || 
-            (NULL == mac) || (NULL == mac_length))
-        {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
-            break;
-        }
-#endif
-        return_value =  optiga_crypt_symmetric_mode_generic(me,
-                                                            0,
-                                                            0,
-                                                            input_data,
-                                                            input_data_length,
-                                                            NULL,
-                                                            0,
-                                                            NULL,
-                                                            0,
-                                                            0,
-                                                            mac,
-                                                            mac_length,
-                                                            NULL,
-                                                            0,        
-                                                            OPTIGA_CRYPT_SYM_FINAL,
-                                                            OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION,
-                                                            OPTIGA_CRYPT_HMAC);
-    } while(FALSE);
-    optiga_crypt_reset_protection_level(me);
-    return (return_value);
+    return (optiga_crypt_generate_keypair(me,
+                                         (uint8_t)curve_id,
+                                         key_usage,
+                                         export_private_key,
+                                         private_key,
+                                         public_key,
+                                         public_key_length));
 }
+#endif //OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED
 
-#endif //OPTIGA_CRYPT_HMAC_ENABLED
+#ifdef OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
+optiga_lib_status_t optiga_crypt_ecdsa_sign(optiga_crypt_t * me,
+                                            const uint8_t * digest,
+                                            uint8_t digest_length,
+                                            optiga_key_id_t private_key,
+                                            uint8_t * signature,
+                                            uint16_t * signature_length)
+{
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    return (optiga_crypt_sign(me,
+                              OPTIGA_CRYPT_ECDSA_FIPS_186_3_WITHOUT_HASH,
+                              digest,
+                              digest_length,
+                              private_key,
+                              signature,
+                              signature_length,
+                              0x0000,
+                              (uint8_t)OPTIGA_ECDSA_SIGNATURE_FORMAT_DER_INTEGERS));
+}
 
-#ifdef OPTIGA_CRYPT_HKDF_ENABLED
-optiga_lib_status_t optiga_crypt_hkdf(optiga_crypt_t * me,
-                                      optiga_hkdf_type_t type,
-                                      uint16_t secret,
-                                      const uint8_t * salt,
-                                      uint16_t salt_length,
-                                      const uint8_t * info,
-                                      uint16_t info_length,
-                                      uint16_t derived_key_length,
-                                      bool_t export_to_host,
-                                      uint8_t * derived_key)
+#ifdef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+optiga_lib_status_t optiga_crypt_ecdsa_sign_format(optiga_crypt_t * me,
+                                                   const uint8_t * digest,
+                                                   uint8_t digest_length,
+                                                   optiga_key_id_t private_key,
+                                                   optiga_ecdsa_signature_format_t signature_format,
+                                                   uint8_t * signature,
+                                                   uint16_t * signature_length)
 {
-    
-    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
     OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    return (optiga_crypt_sign(me,
+                              OPTIGA_CRYPT_ECDSA_FIPS_186_3_WITHOUT_HASH,
+                              digest,
+                              digest_length,
+                              private_key,
+                              signature,
+                              signature_length,
+                              0x0000,
+                              (uint8_t)signature_format));
+}
+#endif //OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+
+#ifdef OPTIGA_CRYPT_ECDSA_SIGN_BATCH_ENABLED
+/*
+* Issues the sign commands of the next chunk of the signing batch, under one acquisition of the lock
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_sign_batch_next_chunk(optiga_crypt_t * me)
+{
+    optiga_calc_sign_params_t * p_params;
+    uint16_t digest_index;
+    uint16_t remaining_count = me->sign_batch_count - me->sign_batch_index;
+    uint8_t index;
+
+    me->sign_batch_chunk_count = (uint8_t)((OPTIGA_CRYPT_ECDSA_SIGN_BATCH_CHUNK_SIZE < remaining_count) ?
+                                           OPTIGA_CRYPT_ECDSA_SIGN_BATCH_CHUNK_SIZE : remaining_count);
+    for (index = 0; index < me->sign_batch_chunk_count; index++)
+    {
+        digest_index = me->sign_batch_index + index;
+        p_params = &me->sign_batch_params[index];
+        pal_os_memset(p_params, 0x00, sizeof(optiga_calc_sign_params_t));
+
+        p_params->p_digest = me->p_sign_batch_digests + ((uint32_t)digest_index * me->sign_batch_digest_length);
+        p_params->digest_length = me->sign_batch_digest_length;
+        p_params->private_key_oid = me->sign_batch_private_key;
+        p_params->p_signature = me->p_sign_batch_signatures + ((uint32_t)digest_index * me->sign_batch_signature_size);
+        me->p_sign_batch_signature_lengths[digest_index] = me->sign_batch_signature_size;
+        p_params->p_signature_length = &me->p_sign_batch_signature_lengths[digest_index];
+
+        me->sign_batch_items[index].cmd_type = OPTIGA_CMD_BATCH_ITEM_CALC_SIGN;
+        me->sign_batch_items[index].cmd_param = OPTIGA_CRYPT_ECDSA_FIPS_186_3_WITHOUT_HASH;
+        me->sign_batch_items[index].params = p_params;
+    }
+    OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
+    OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
+
+    return (optiga_cmd_execute_batch(me->my_cmd, me->sign_batch_items, me->sign_batch_chunk_count));
+}
+
+/*
+* Takes the results of the completed chunk and issues the next chunk of the signing batch.
+* Returns TRUE, if the signing batch is continued with the next chunk.
+*/
+_STATIC_H uint8_t optiga_crypt_sign_batch_resume(optiga_crypt_t * me,
+                                                 optiga_lib_status_t * p_event)
+{
+    uint8_t is_resumed = FALSE;
+    uint16_t digest_index;
+    uint8_t index;
+
     do
     {
-#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || \
-           ((TRUE == export_to_host) && (NULL == derived_key)))
+        if (0U == me->sign_batch_count)
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
-#endif
-        return_value =  optiga_crypt_derive_key_generic(me,
-                                                        (uint8_t)type,
-                                                        secret,
-                                                        salt,
-                                                        salt_length,
-                                                        NULL,
-                                                        0,
-                                                        info,
-                                                        info_length,
-                                                        derived_key_length,
-                                                        export_to_host,
-                                                        derived_key);
-    } while(FALSE);
-    return (return_value);
+        for (index = 0; index < me->sign_batch_chunk_count; index++)
+        {
+            if (OPTIGA_LIB_SUCCESS != me->sign_batch_items[index].status)
+            {
+                me->p_sign_batch_signature_lengths[me->sign_batch_index + index] = 0;
+                if (OPTIGA_LIB_SUCCESS == me->sign_batch_status)
+                {
+                    me->sign_batch_status = me->sign_batch_items[index].status;
+                }
+            }
+        }
+        me->sign_batch_index += me->sign_batch_chunk_count;
+
+        // A failure reported by OPTIGA does not stop the batch, a failure of the communication does
+        if ((me->sign_batch_index < me->sign_batch_count) &&
+            ((OPTIGA_LIB_SUCCESS == *p_event) || (OPTIGA_DEVICE_ERROR == (*p_event & OPTIGA_DEVICE_ERROR))))
+        {
+            me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+            *p_event = optiga_crypt_sign_batch_next_chunk(me);
+            if (OPTIGA_LIB_SUCCESS == *p_event)
+            {
+                is_resumed = TRUE;
+                break;
+            }
+            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+            if (OPTIGA_LIB_SUCCESS == me->sign_batch_status)
+            {
+                me->sign_batch_status = *p_event;
+            }
+        }
+
+        // The digests, which are not signed due to the abort of the batch
+        for (digest_index = me->sign_batch_index; digest_index < me->sign_batch_count; digest_index++)
+        {
+            me->p_sign_batch_signature_lengths[digest_index] = 0;
+        }
+        *p_event = me->sign_batch_status;
+        me->sign_batch_count = 0;
+        optiga_crypt_reset_protection_level(me);
+    } while (FALSE);
+    return (is_resumed);
 }
 
-#endif //OPTIGA_CRYPT_HKDF_ENABLED
-#ifdef OPTIGA_CRYPT_SYM_GENERATE_KEY_ENABLED
-optiga_lib_status_t optiga_crypt_symmetric_generate_key(optiga_crypt_t * me,
-                                                        optiga_symmetric_key_type_t key_type,
-                                                        uint8_t key_usage,
-                                                        bool_t export_symmetric_key,
-                                                        void * symmetric_key)
+optiga_lib_status_t optiga_crypt_ecdsa_sign_batch(optiga_crypt_t * me,
+                                                  const uint8_t * digests,
+                                                  uint8_t digest_length,
+                                                  uint16_t digest_count,
+                                                  optiga_key_id_t private_key,
+                                                  uint8_t * signatures,
+                                                  uint16_t signature_size,
+                                                  uint16_t * signature_lengths)
 {
-    
-    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
-    optiga_gen_symkey_params_t * p_params;    
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
     OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == symmetric_key))
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == digests) ||
+            (NULL == signatures) || (NULL == signature_lengths))
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
 #endif
-        
+        // Session based key needs session acquisition, which is not part of command batch
+        if ((0U == digest_count) || (OPTIGA_KEY_ID_SESSION_BASED == private_key))
+        {
+            break;
+        }
+
         if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
         {
             return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
@@ -2020,162 +2262,2955 @@ optiga_lib_status_t optiga_crypt_symmetric_generate_key(optiga_crypt_t * me,
         }
 
         me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
-        
-        p_params = (optiga_gen_symkey_params_t *)&(me->params.optiga_gen_sym_key_params);
-        pal_os_memset(&me->params,0x00,sizeof(optiga_crypt_params_t));
-        
-        p_params->key_usage = key_usage;
-        p_params->export_symmetric_key = export_symmetric_key;
-        p_params->symmetric_key = symmetric_key;
-        
-        OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
-        OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
-        
-        return_value = optiga_cmd_gen_symkey(me->my_cmd,
-                                             (uint8_t)key_type,
-                                             p_params);
+
+        me->p_sign_batch_digests = digests;
+        me->sign_batch_digest_length = digest_length;
+        me->sign_batch_private_key = private_key;
+        me->p_sign_batch_signatures = signatures;
+        me->sign_batch_signature_size = signature_size;
+        me->p_sign_batch_signature_lengths = signature_lengths;
+        me->sign_batch_count = digest_count;
+        me->sign_batch_index = 0;
+        me->sign_batch_status = OPTIGA_LIB_SUCCESS;
+
+        // The protection level is kept for the sign commands of all the chunks
+        return_value = optiga_crypt_sign_batch_next_chunk(me);
         if (OPTIGA_LIB_SUCCESS != return_value)
         {
+            me->sign_batch_count = 0;
             me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
         }
-        
-    } while(FALSE);
-    optiga_crypt_reset_protection_level(me);
-    
-    return (return_value);
-}
+    } while (FALSE);
+    if (OPTIGA_LIB_SUCCESS != return_value)
+    {
+        optiga_crypt_reset_protection_level(me);
+    }
 
-#endif //OPTIGA_CRYPT_SYM_GENERATE_KEY_ENABLED
+    return (return_value);
+}
+#endif //OPTIGA_CRYPT_ECDSA_SIGN_BATCH_ENABLED
+#endif //OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
 
-#ifdef OPTIGA_CRYPT_GENERATE_AUTH_CODE_ENABLED
-optiga_lib_status_t optiga_crypt_generate_auth_code(optiga_crypt_t * me, 
-                                                    optiga_rng_type_t rng_type, 
-                                                    const uint8_t * optional_data, 
-                                                    uint16_t optional_data_length, 
-                                                    uint8_t * random_data, 
-                                                    uint16_t random_data_length)
+#ifdef OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED
+#ifdef OPTIGA_CRYPT_ECDSA_VERIFY_OFFLOAD_ENABLED
+/*
+* Verifies the signature with the public key from host using the crypto library on host.
+* On success, the operation is completed before returning.
+* OPTIGA_CRYPT_ERROR_INVALID_INPUT is returned, if the signature must be verified by OPTIGA instead.
+*/
+//lint --e{715} suppress "The signature_format argument is used only with OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED"
+_STATIC_H optiga_lib_status_t optiga_crypt_ecdsa_verify_offload(optiga_crypt_t * me,
+                                                                const uint8_t * digest,
+                                                                uint8_t digest_length,
+                                                                const uint8_t * signature,
+                                                                uint16_t signature_length,
+                                                                const public_key_from_host_t * public_key,
+                                                                uint8_t signature_format)
 {
-    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    pal_status_t pal_return_value;
+#ifdef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+    uint8_t der_signature[OPTIGA_CRYPT_ECDSA_MAX_DER_SIGNATURE_LENGTH];
+    uint16_t der_signature_length = sizeof(der_signature);
+#endif
+    do
+    {
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        if ((NULL == digest) || (NULL == signature) || (NULL == public_key) || (NULL == public_key->public_key))
+        {
+            break;
+        }
+#ifdef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+        // pal crypt expects the DER INTEGERs same as OPTIGA, an invalid signature is reported by OPTIGA
+        if ((uint8_t)OPTIGA_ECDSA_SIGNATURE_FORMAT_DER_INTEGERS != signature_format)
+        {
+            if (OPTIGA_LIB_SUCCESS != optiga_common_ecdsa_signature_to_der(signature,
+                                                                           signature_length,
+                                                                           signature_format,
+                                                                           der_signature,
+                                                                           &der_signature_length))
+            {
+                break;
+            }
+            signature = der_signature;
+            signature_length = der_signature_length;
+        }
+#endif //OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+        pal_return_value = pal_crypt_ecdsa_verify(NULL,
+                                                  public_key->key_type,
+                                                  digest,
+                                                  digest_length,
+                                                  signature,
+                                                  signature_length,
+                                                  public_key->public_key,
+                                                  public_key->length);
+        // Curve is not supported by the crypto library on host
+        if (PAL_STATUS_INVALID_INPUT == pal_return_value)
+        {
+            break;
+        }
+
+        // Operation is completed on host, hence the callback is invoked right away
+        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+        return_value = OPTIGA_LIB_SUCCESS;
+        optiga_crypt_reset_protection_level(me);
+        optiga_crypt_generic_event_handler(me, (PAL_STATUS_SUCCESS == pal_return_value) ?
+                                               OPTIGA_LIB_SUCCESS : OPTIGA_CRYPT_SIGNATURE_VERIFICATION_FAILURE);
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_set_verify_offload(optiga_crypt_t * me,
+                                                    bool_t enable)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
     OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
-#define OPTIGA_CRYPT_MAX_AUTH_CODE_LENGTH   (0x42)
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == random_data))
+        if (NULL == me)
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
 #endif
-
-        ///The minimum size of random stream is 8 bytes 
-        ///and the maximum size of (optional_data + random data) is 48 bytes.
-        if (( OPTIGA_CRYPT_MINIMUM_RANDOM_DATA_LENGTH > random_data_length) ||
-            ((optional_data_length + random_data_length) > OPTIGA_CRYPT_MAX_AUTH_CODE_LENGTH))
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
             break;
         }
-
-        return_value = optiga_crypt_get_random(me,
-                                               (uint8_t)rng_type,
-                                               random_data,
-                                               random_data_length,
-                                               optional_data,
-                                               optional_data_length,
-                                               TRUE);
+        me->verify_offload_enabled = enable;
+        return_value = OPTIGA_LIB_SUCCESS;
     } while (FALSE);
-#undef OPTIGA_CRYPT_MAX_AUTH_CODE_LENGTH
     return (return_value);
 }
+#endif //OPTIGA_CRYPT_ECDSA_VERIFY_OFFLOAD_ENABLED
 
-#endif //OPTIGA_CRYPT_SYM_GENERATE_KEY_ENABLED
+#ifdef OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+/*
+* Calculates the key of the verification in the verification cache, the SHA-256 digest of
+* source type || format || public key (OID or key type || length || key) || digest length || digest || signature length || signature
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_verify_cache_key(optiga_crypt_t * me,
+                                                            const uint8_t * digest,
+                                                            uint8_t digest_length,
+                                                            uint8_t signature_format,
+                                                            const uint8_t * signature,
+                                                            uint16_t signature_length,
+                                                            uint8_t public_key_source_type,
+                                                            const void * public_key)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    pal_status_t pal_return_value;
+    uint8_t hash_context[OPTIGA_HASH_CONTEXT_LENGTH_SHA_256];
+    uint8_t header[5];
+    const public_key_from_host_t * p_public_key = (const public_key_from_host_t *)public_key;
 
-#ifdef OPTIGA_CRYPT_HMAC_VERIFY_ENABLED
-optiga_lib_status_t optiga_crypt_hmac_verify(optiga_crypt_t * me,
-                                             optiga_hmac_type_t type,
-                                             uint16_t secret,
-                                             const uint8_t * input_data,
-                                             uint32_t input_data_length,
-                                             const uint8_t * hmac,
-                                             uint32_t hmac_length)
+    do
+    {
+        if ((NULL == digest) || (NULL == signature) || (NULL == public_key))
+        {
+            break;
+        }
+        header[0] = (OPTIGA_CRYPT_OID_DATA == public_key_source_type) ? OPTIGA_CRYPT_OID_DATA : OPTIGA_CRYPT_HOST_DATA;
+        header[1] = signature_format;
+        pal_return_value = pal_crypt_sha256_start(NULL, hash_context, sizeof(hash_context));
+        if (PAL_STATUS_SUCCESS == pal_return_value)
+        {
+            pal_return_value = pal_crypt_sha256_update(NULL, hash_context, sizeof(hash_context), header, 2);
+        }
+        if (OPTIGA_CRYPT_OID_DATA == public_key_source_type)
+        {
+            me->verify_cache_oid = *((const uint16_t *)public_key);
+            optiga_common_set_uint16(header, me->verify_cache_oid);
+            if (PAL_STATUS_SUCCESS == pal_return_value)
+            {
+                pal_return_value = pal_crypt_sha256_update(NULL, hash_context, sizeof(hash_context), header, 2);
+            }
+        }
+        else
+        {
+            if (NULL == p_public_key->public_key)
+            {
+                break;
+            }
+            me->verify_cache_oid = 0x0000;
+            header[0] = p_public_key->key_type;
+            optiga_common_set_uint16(&header[1], p_public_key->length);
+            if (PAL_STATUS_SUCCESS == pal_return_value)
+            {
+                pal_return_value = pal_crypt_sha256_update(NULL, hash_context, sizeof(hash_context), header, 3);
+            }
+            if (PAL_STATUS_SUCCESS == pal_return_value)
+            {
+                pal_return_value = pal_crypt_sha256_update(NULL,
+                                                           hash_context,
+                                                           sizeof(hash_context),
+                                                           p_public_key->public_key,
+                                                           p_public_key->length);
+            }
+        }
+        header[0] = digest_length;
+        if (PAL_STATUS_SUCCESS == pal_return_value)
+        {
+            pal_return_value = pal_crypt_sha256_update(NULL, hash_context, sizeof(hash_context), header, 1);
+        }
+        if (PAL_STATUS_SUCCESS == pal_return_value)
+        {
+            pal_return_value = pal_crypt_sha256_update(NULL, hash_context, sizeof(hash_context), digest, digest_length);
+        }
+        optiga_common_set_uint16(header, signature_length);
+        if (PAL_STATUS_SUCCESS == pal_return_value)
+        {
+            pal_return_value = pal_crypt_sha256_update(NULL, hash_context, sizeof(hash_context), header, 2);
+        }
+        if (PAL_STATUS_SUCCESS == pal_return_value)
+        {
+            pal_return_value = pal_crypt_sha256_update(NULL, hash_context, sizeof(hash_context), signature, signature_length);
+        }
+        if (PAL_STATUS_SUCCESS == pal_return_value)
+        {
+            pal_return_value = pal_crypt_sha256_finalize(NULL, hash_context, sizeof(hash_context), me->verify_cache_key);
+        }
+        pal_os_memset(hash_context, 0x00, sizeof(hash_context));
+        if (PAL_STATUS_SUCCESS != pal_return_value)
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_set_verify_cache(optiga_crypt_t * me,
+                                                  uint32_t ttl_ms)
 {
-    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
     OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        me->verify_cache_ttl_ms = ttl_ms;
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
 
+optiga_lib_status_t optiga_crypt_get_verify_cache_stats(const optiga_crypt_t * me,
+                                                        optiga_lib_verify_cache_stats_t * p_stats)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == input_data) || (NULL == hmac))
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == p_stats))
         {
-            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
 #endif
+        optiga_cmd_get_verify_cache_stats(me->my_cmd, p_stats);
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+#endif //OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
 
-        return_value =  optiga_crypt_symmetric_mode_generic(me,
-                                                            (uint8_t)type,
-                                                            secret,
-                                                            input_data,
-                                                            input_data_length,
-                                                            NULL,
-                                                            0,
-                                                            NULL,
-                                                            0,
-                                                            0,
-                                                            NULL,
-                                                            NULL,
-                                                            hmac,
-                                                            hmac_length,
-                                                            OPTIGA_CRYPT_SYM_START_FINAL,
-                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION,
-                                                            OPTIGA_CRYPT_HMAC);
+/*
+* Verifies the ECDSA signature in the given format, on host if offloaded and else by OPTIGA
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_ecdsa_verify_generic(optiga_crypt_t * me,
+                                                                const uint8_t * digest,
+                                                                uint8_t digest_length,
+                                                                uint8_t signature_format,
+                                                                const uint8_t * signature,
+                                                                uint16_t signature_length,
+                                                                uint8_t public_key_source_type,
+                                                                const void * public_key)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    do
+    {
+#ifdef OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+        // The ongoing operation of a busy instance is left as it is, the instance in use is reported below
+        if ((NULL != me) && (NULL != me->my_cmd) && (0U != me->verify_cache_ttl_ms) &&
+            (OPTIGA_LIB_INSTANCE_BUSY != me->instance_state) &&
+            (OPTIGA_LIB_SUCCESS == optiga_crypt_verify_cache_key(me,
+                                                                 digest,
+                                                                 digest_length,
+                                                                 signature_format,
+                                                                 signature,
+                                                                 signature_length,
+                                                                 public_key_source_type,
+                                                                 public_key)))
+        {
+            if (OPTIGA_LIB_SUCCESS == optiga_cmd_verify_cache_lookup(me->my_cmd,
+                                                                     me->verify_cache_key,
+                                                                     &me->verify_cache_generation))
+            {
+                // Operation is completed on host, hence the callback is invoked right away
+                me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+                return_value = OPTIGA_LIB_SUCCESS;
+                optiga_crypt_reset_protection_level(me);
+                optiga_crypt_generic_event_handler(me, OPTIGA_LIB_SUCCESS);
+                break;
+            }
+            // Set before the verification, since the verification on host completes before returning
+            me->verify_cache_pending = TRUE;
+        }
+#endif //OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+#ifdef OPTIGA_CRYPT_ECDSA_VERIFY_OFFLOAD_ENABLED
+        // Public key from host is verified on host, public key of certificate OID is verified by OPTIGA
+        if ((NULL != me) && (OPTIGA_CRYPT_OID_DATA != public_key_source_type) &&
+            (TRUE == OPTIGA_CRYPT_OFFLOAD_TO_HOST(me, OPTIGA_LIB_OFFLOAD_ECDSA_VERIFY, me->verify_offload_enabled)))
+        {
+            return_value = optiga_crypt_ecdsa_verify_offload(me,
+                                                             digest,
+                                                             digest_length,
+                                                             signature,
+                                                             signature_length,
+                                                             (const public_key_from_host_t *)public_key,
+                                                             signature_format);
+            if (OPTIGA_CRYPT_ERROR_INVALID_INPUT != return_value)
+            {
+                break;
+            }
+#ifdef OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
+            // The curve is not supported on host, hence the time is recorded for OPTIGA
+            me->offload_on_host = FALSE;
+#endif //OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
+        }
+#endif //OPTIGA_CRYPT_ECDSA_VERIFY_OFFLOAD_ENABLED
+        return_value = optiga_crypt_verify(me,
+                                           OPTIGA_CRYPT_ECDSA_FIPS_186_3_WITHOUT_HASH,
+                                           digest,
+                                           digest_length,
+                                           signature,
+                                           signature_length,
+                                           public_key_source_type,
+                                           public_key,
+                                           0x0000,
+                                           signature_format);
     } while (FALSE);
-    optiga_crypt_reset_protection_level(me);
-    
+#ifdef OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+    // Verification is not started, a busy instance keeps the pending state of its ongoing verification
+    if ((NULL != me) && (OPTIGA_LIB_SUCCESS != return_value) && (OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE != return_value))
+    {
+        me->verify_cache_pending = FALSE;
+    }
+#endif //OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+#if defined (OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED) && defined (OPTIGA_CRYPT_ECDSA_VERIFY_OFFLOAD_ENABLED)
+    if (NULL != me)
+    {
+        optiga_crypt_offload_abort(me, return_value);
+    }
+#endif //(OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED) && (OPTIGA_CRYPT_ECDSA_VERIFY_OFFLOAD_ENABLED)
     return (return_value);
 }
-#endif // OPTIGA_CRYPT_HMAC_VERIFY_ENABLED
-#ifdef OPTIGA_CRYPT_CLEAR_AUTO_STATE_ENABLED
-optiga_lib_status_t optiga_crypt_clear_auto_state(optiga_crypt_t * me,
-                                                  uint16_t secret)
+
+optiga_lib_status_t optiga_crypt_ecdsa_verify(optiga_crypt_t * me,
+                                              const uint8_t * digest,
+                                              uint8_t digest_length,
+                                              const uint8_t * signature,
+                                              uint16_t signature_length,
+                                              uint8_t public_key_source_type,
+                                              const void * public_key)
+{
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    return (optiga_crypt_ecdsa_verify_generic(me,
+                                              digest,
+                                              digest_length,
+                                              (uint8_t)OPTIGA_ECDSA_SIGNATURE_FORMAT_DER_INTEGERS,
+                                              signature,
+                                              signature_length,
+                                              public_key_source_type,
+                                              public_key));
+}
+
+#ifdef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+optiga_lib_status_t optiga_crypt_ecdsa_verify_format(optiga_crypt_t * me,
+                                                     const uint8_t * digest,
+                                                     uint8_t digest_length,
+                                                     optiga_ecdsa_signature_format_t signature_format,
+                                                     const uint8_t * signature,
+                                                     uint16_t signature_length,
+                                                     uint8_t public_key_source_type,
+                                                     const void * public_key)
+{
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    return (optiga_crypt_ecdsa_verify_generic(me,
+                                              digest,
+                                              digest_length,
+                                              (uint8_t)signature_format,
+                                              signature,
+                                              signature_length,
+                                              public_key_source_type,
+                                              public_key));
+}
+#endif //OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+#endif //OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED
+
+
+#ifdef OPTIGA_CRYPT_ECDH_ENABLED
+optiga_lib_status_t optiga_crypt_ecdh(optiga_crypt_t * me,
+                                      optiga_key_id_t private_key,
+                                      public_key_from_host_t * public_key,
+                                      bool_t export_to_host,
+                                      uint8_t * shared_secret)
 {
     optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    optiga_calc_ssec_params_t * p_params;
     OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
 
     do
     {
+
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd))
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == public_key) ||
+            (NULL == public_key->public_key) ||
+            ((TRUE == export_to_host) && (NULL == shared_secret)))
         {
             return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
             break;
         }
 #endif
 
-        return_value =  optiga_crypt_symmetric_mode_generic(me,
-                                                            (uint8_t)OPTIGA_HMAC_SHA_256,
-                                                            secret,
-                                                            NULL,
-                                                            0,
-                                                            NULL,
-                                                            0,
-                                                            NULL,
-                                                            0,
-                                                            0,
-                                                            NULL,
-                                                            NULL,
-                                                            NULL,
-                                                            0,
-                                                            OPTIGA_CRYPT_SYM_START_FINAL,
-                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION,
-                                                            OPTIGA_CRYPT_CLEAR_AUTO_STATE);
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+
+        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+
+        p_params = (optiga_calc_ssec_params_t *)&(me->p_params->optiga_calc_ssec_params);
+        pal_os_memset(p_params,0x00,sizeof(optiga_calc_ssec_params_t));
+
+        p_params->private_key = private_key;
+        p_params->public_key = public_key;
+        p_params->export_to_host = export_to_host;
+        p_params->shared_secret = shared_secret;
+        OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
+        OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
+
+        return_value = optiga_cmd_calc_ssec(me->my_cmd, OPTIGA_CRYPT_ECDH_KEY_AGREEMENT_ALGORITHM,
+                                            (optiga_calc_ssec_params_t *)p_params);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+        }
     } while (FALSE);
     optiga_crypt_reset_protection_level(me);
     
     return (return_value);
 }
-#endif // OPTIGA_CRYPT_CLEAR_AUTO_STATE_ENABLED
+#endif  //OPTIGA_CRYPT_ECDH_ENABLED
+
+#if defined (OPTIGA_CRYPT_TLS_PRF_SHA256_ENABLED) || defined (OPTIGA_CRYPT_TLS_PRF_SHA384_ENABLED) || defined (OPTIGA_CRYPT_TLS_PRF_SHA512_ENABLED)
+optiga_lib_status_t optiga_crypt_tls_prf(optiga_crypt_t * me,
+                                         optiga_tls_prf_type_t type,
+                                         uint16_t secret,
+                                         const uint8_t * label,
+                                         uint16_t label_length,
+                                         const uint8_t * seed,
+                                         uint16_t seed_length,
+                                         uint16_t derived_key_length,
+                                         bool_t export_to_host,
+                                         uint8_t * derived_key)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == seed) ||
+           ((TRUE == export_to_host) && (NULL == derived_key)))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+
+        return_value = optiga_crypt_derive_key_generic(me,
+                                                       (uint8_t)type,
+                                                       secret,
+                                                       seed,
+                                                       seed_length,
+                                                       label,
+                                                       label_length,
+                                                       NULL,
+                                                       0,
+                                                       derived_key_length,
+                                                       export_to_host,
+                                                       derived_key);
+        
+    } while (FALSE);
+
+    return (return_value);
+}
+
+#if defined (OPTIGA_CRYPT_TLS_HANDSHAKE_ENABLED) && defined (OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED) && defined (OPTIGA_CRYPT_ECDH_ENABLED)
+/// Label of the master secret derivation (RFC 5246)
+_STATIC_H const uint8_t optiga_crypt_tls_master_secret_label[] = "master secret";
+/// Label of the key block derivation (RFC 5246)
+_STATIC_H const uint8_t optiga_crypt_tls_key_expansion_label[] = "key expansion";
+
+optiga_lib_status_t optiga_crypt_tls_handshake_key_block(optiga_crypt_t * me,
+                                                         optiga_ecc_curve_t curve_id,
+                                                         public_key_from_host_t * peer_public_key,
+                                                         uint8_t * public_key,
+                                                         uint16_t * public_key_length,
+                                                         optiga_tls_prf_type_t type,
+                                                         const uint8_t * client_random,
+                                                         const uint8_t * server_random,
+                                                         uint16_t key_block_length,
+                                                         uint8_t * key_block)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    optiga_gen_keypair_params_t * p_keypair_params;
+    optiga_calc_ssec_params_t * p_ssec_params;
+    optiga_derive_key_params_t * p_prf_params;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == peer_public_key) ||
+            (NULL == peer_public_key->public_key) || (NULL == public_key) || (NULL == public_key_length) ||
+            (NULL == client_random) || (NULL == server_random) || (NULL == key_block))
+        {
+            break;
+        }
+#endif
+        if (0U == key_block_length)
+        {
+            break;
+        }
+
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+
+        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+
+        pal_os_memcpy(me->handshake_seeds[0], client_random, OPTIGA_CRYPT_TLS_RANDOM_LENGTH);
+        pal_os_memcpy(&me->handshake_seeds[0][OPTIGA_CRYPT_TLS_RANDOM_LENGTH], server_random, OPTIGA_CRYPT_TLS_RANDOM_LENGTH);
+        pal_os_memcpy(me->handshake_seeds[1], server_random, OPTIGA_CRYPT_TLS_RANDOM_LENGTH);
+        pal_os_memcpy(&me->handshake_seeds[1][OPTIGA_CRYPT_TLS_RANDOM_LENGTH], client_random, OPTIGA_CRYPT_TLS_RANDOM_LENGTH);
+
+        // Ephemeral key pair into the session
+        p_keypair_params = &me->handshake_keypair_params;
+        pal_os_memset(p_keypair_params, 0x00, sizeof(optiga_gen_keypair_params_t));
+        p_keypair_params->key_usage = (uint8_t)OPTIGA_KEY_USAGE_KEY_AGREEMENT;
+        p_keypair_params->export_private_key = FALSE;
+        p_keypair_params->private_key_oid = OPTIGA_KEY_ID_SESSION_BASED;
+        p_keypair_params->public_key = public_key;
+        p_keypair_params->public_key_length = public_key_length;
+        me->handshake_items[0].cmd_type = OPTIGA_CMD_BATCH_ITEM_GEN_KEYPAIR;
+        me->handshake_items[0].cmd_param = (uint8_t)curve_id;
+        me->handshake_items[0].params = p_keypair_params;
+
+        // Pre-master secret into the session
+        p_ssec_params = &me->handshake_ssec_params;
+        pal_os_memset(p_ssec_params, 0x00, sizeof(optiga_calc_ssec_params_t));
+        p_ssec_params->private_key = OPTIGA_KEY_ID_SESSION_BASED;
+        p_ssec_params->public_key = peer_public_key;
+        p_ssec_params->export_to_host = FALSE;
+        me->handshake_items[1].cmd_type = OPTIGA_CMD_BATCH_ITEM_CALC_SSEC;
+        me->handshake_items[1].cmd_param = OPTIGA_CRYPT_ECDH_KEY_AGREEMENT_ALGORITHM;
+        me->handshake_items[1].params = p_ssec_params;
+
+        // Master secret into the session
+        p_prf_params = &me->handshake_prf_params[0];
+        pal_os_memset(p_prf_params, 0x00, sizeof(optiga_derive_key_params_t));
+        p_prf_params->input_shared_secret_oid = (uint16_t)OPTIGA_KEY_ID_SESSION_BASED;
+        p_prf_params->label = optiga_crypt_tls_master_secret_label;
+        p_prf_params->label_length = (uint16_t)(sizeof(optiga_crypt_tls_master_secret_label) - 1U);
+        p_prf_params->random_data = me->handshake_seeds[0];
+        p_prf_params->random_data_length = sizeof(me->handshake_seeds[0]);
+        p_prf_params->derived_key_length = OPTIGA_CRYPT_TLS_MASTER_SECRET_LENGTH;
+        me->handshake_items[2].cmd_type = OPTIGA_CMD_BATCH_ITEM_DERIVE_KEY;
+        me->handshake_items[2].cmd_param = (uint8_t)type;
+        me->handshake_items[2].params = p_prf_params;
+
+        // Key block to host
+        p_prf_params = &me->handshake_prf_params[1];
+        pal_os_memset(p_prf_params, 0x00, sizeof(optiga_derive_key_params_t));
+        p_prf_params->input_shared_secret_oid = (uint16_t)OPTIGA_KEY_ID_SESSION_BASED;
+        p_prf_params->label = optiga_crypt_tls_key_expansion_label;
+        p_prf_params->label_length = (uint16_t)(sizeof(optiga_crypt_tls_key_expansion_label) - 1U);
+        p_prf_params->random_data = me->handshake_seeds[1];
+        p_prf_params->random_data_length = sizeof(me->handshake_seeds[1]);
+        p_prf_params->derived_key_length = key_block_length;
+        p_prf_params->derived_key = key_block;
+        me->handshake_items[3].cmd_type = OPTIGA_CMD_BATCH_ITEM_DERIVE_KEY;
+        me->handshake_items[3].cmd_param = (uint8_t)type;
+        me->handshake_items[3].params = p_prf_params;
+
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+        // The secrets in the session are used
+        me->protection_level |= OPTIGA_COMMS_COMMAND_PROTECTION;
+#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+        OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
+        OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
+
+        return_value = optiga_cmd_execute_chain(me->my_cmd, me->handshake_items, OPTIGA_CRYPT_TLS_HANDSHAKE_STEPS);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+        }
+    } while (FALSE);
+    optiga_crypt_reset_protection_level(me);
+
+    return (return_value);
+}
+#endif //(OPTIGA_CRYPT_TLS_HANDSHAKE_ENABLED) && (OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED) && (OPTIGA_CRYPT_ECDH_ENABLED)
+#endif //OPTIGA_CRYPT_TLS_PRF_SHA256_ENABLED || OPTIGA_CRYPT_TLS_PRF_SHA384_ENABLED || OPTIGA_CRYPT_TLS_PRF_SHA512_ENABLED
+
+
+#ifdef OPTIGA_CRYPT_RSA_GENERATE_KEYPAIR_ENABLED
+optiga_lib_status_t optiga_crypt_rsa_generate_keypair(optiga_crypt_t * me,
+                                                      optiga_rsa_key_type_t key_type,
+                                                      uint8_t key_usage,
+                                                      bool_t export_private_key,
+                                                      void * private_key,
+                                                      uint8_t * public_key,
+                                                      uint16_t * public_key_length)
+{
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    return (optiga_crypt_generate_keypair(me,
+                                         (uint8_t)key_type,
+                                         key_usage,
+                                         export_private_key,
+                                         private_key,
+                                         public_key,
+                                         public_key_length));
+}
+#endif //OPTIGA_CRYPT_RSA_GENERATE_KEYPAIR_ENABLED
+
+
+#ifdef OPTIGA_CRYPT_RSA_SIGN_ENABLED
+optiga_lib_status_t optiga_crypt_rsa_sign(optiga_crypt_t * me,
+                                          optiga_rsa_signature_scheme_t signature_scheme,
+                                          const uint8_t * digest,
+                                          uint8_t digest_length,
+                                          optiga_key_id_t private_key,
+                                          uint8_t * signature,
+                                          uint16_t * signature_length,
+                                          uint16_t salt_length)
+{
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    return (optiga_crypt_sign(me,
+                             (uint8_t)signature_scheme,
+                             digest,
+                             digest_length,
+                             private_key,
+                             signature,
+                             signature_length,
+                             salt_length,
+                             // RSA signature is returned as it is
+                             (uint8_t)OPTIGA_ECDSA_SIGNATURE_FORMAT_DER_INTEGERS));
+}
+
+#endif //OPTIGA_CRYPT_RSA_SIGN_ENABLED
+#ifdef OPTIGA_CRYPT_RSA_VERIFY_ENABLED
+optiga_lib_status_t optiga_crypt_rsa_verify(optiga_crypt_t * me,
+                                            optiga_rsa_signature_scheme_t signature_scheme,
+                                            const uint8_t * digest,
+                                            uint8_t digest_length,
+                                            const uint8_t * signature,
+                                            uint16_t signature_length,
+                                            uint8_t public_key_source_type,
+                                            const void * public_key,
+                                            uint16_t salt_length)
+{
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    return (optiga_crypt_verify(me,
+                                (uint8_t)signature_scheme,
+                                digest,
+                                digest_length,
+                                signature,
+                                signature_length,
+                                public_key_source_type,
+                                public_key,
+                                salt_length,
+                                (uint8_t)OPTIGA_ECDSA_SIGNATURE_FORMAT_DER_INTEGERS));
+}
+#endif //OPTIGA_CRYPT_RSA_VERIFY_ENABLED
+
+#ifdef OPTIGA_CRYPT_VERIFY_BATCH_ENABLED
+/*
+* Issues the verify commands of the next chunk of the verify batch, under one acquisition of the lock.
+* The items verified on host are skipped.
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_verify_batch_next_chunk(optiga_crypt_t * me)
+{
+    optiga_crypt_verify_item_t * p_item;
+    optiga_verify_sign_params_t * p_params;
+    uint8_t index = 0;
+
+    for (; (me->verify_batch_index < me->verify_batch_count) && (index < OPTIGA_CRYPT_VERIFY_BATCH_CHUNK_SIZE);
+         me->verify_batch_index++)
+    {
+        p_item = &me->p_verify_batch_items[me->verify_batch_index];
+        if (OPTIGA_LIB_BUSY != p_item->status)
+        {
+            continue;
+        }
+        p_params = &me->verify_batch_params[index];
+        pal_os_memset(p_params, 0x00, sizeof(optiga_verify_sign_params_t));
+
+        p_params->p_digest = p_item->digest;
+        p_params->digest_length = p_item->digest_length;
+        p_params->p_signature = p_item->signature;
+        p_params->signature_length = p_item->signature_length;
+        p_params->public_key_source_type = p_item->public_key_source_type;
+        if (OPTIGA_CRYPT_OID_DATA == p_item->public_key_source_type)
+        {
+            p_params->certificate_oid = *((const uint16_t *)p_item->public_key);
+        }
+        else
+        {
+            p_params->public_key = (public_key_from_host_t *)p_item->public_key;
+        }
+
+        me->verify_batch_items[index].cmd_type = OPTIGA_CMD_BATCH_ITEM_VERIFY_SIGN;
+        me->verify_batch_items[index].cmd_param = (uint8_t)((OPTIGA_CRYPT_VERIFY_BATCH_ECDSA == p_item->signature_scheme) ?
+                                                            OPTIGA_CRYPT_ECDSA_FIPS_186_3_WITHOUT_HASH : p_item->signature_scheme);
+        me->verify_batch_items[index].params = p_params;
+        me->verify_batch_map[index] = me->verify_batch_index;
+        index++;
+    }
+    me->verify_batch_chunk_count = index;
+    if (0U == index)
+    {
+        return (OPTIGA_CRYPT_ERROR_INVALID_INPUT);
+    }
+    OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
+    OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
+
+    return (optiga_cmd_execute_batch(me->my_cmd, me->verify_batch_items, index));
+}
+
+/*
+* Ends the verify batch, the items which are not verified get the status provided.
+* Returns the status of the first failed item.
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_verify_batch_end(optiga_crypt_t * me,
+                                                            optiga_lib_status_t abort_status)
+{
+    optiga_lib_status_t return_value = OPTIGA_LIB_SUCCESS;
+    uint16_t index;
+
+    for (index = 0; index < me->verify_batch_count; index++)
+    {
+        if (OPTIGA_LIB_BUSY == me->p_verify_batch_items[index].status)
+        {
+            me->p_verify_batch_items[index].status = abort_status;
+        }
+        if ((OPTIGA_LIB_SUCCESS == return_value) && (OPTIGA_LIB_SUCCESS != me->p_verify_batch_items[index].status))
+        {
+            return_value = me->p_verify_batch_items[index].status;
+        }
+    }
+    me->verify_batch_count = 0;
+    optiga_crypt_reset_protection_level(me);
+    return (return_value);
+}
+
+/*
+* Takes the results of the completed chunk and issues the next chunk of the verify batch.
+* Returns TRUE, if the verify batch is continued with the next chunk.
+*/
+_STATIC_H uint8_t optiga_crypt_verify_batch_resume(optiga_crypt_t * me,
+                                                   optiga_lib_status_t * p_event)
+{
+    uint8_t is_resumed = FALSE;
+    uint8_t index;
+
+    do
+    {
+        if (0U == me->verify_batch_count)
+        {
+            break;
+        }
+        for (index = 0; index < me->verify_batch_chunk_count; index++)
+        {
+            me->p_verify_batch_items[me->verify_batch_map[index]].status = me->verify_batch_items[index].status;
+        }
+
+        // A failed verification reported by OPTIGA does not stop the batch, a failure of the communication does
+        if ((OPTIGA_LIB_SUCCESS == *p_event) || (OPTIGA_DEVICE_ERROR == (*p_event & OPTIGA_DEVICE_ERROR)))
+        {
+            me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+            if (OPTIGA_LIB_SUCCESS == optiga_crypt_verify_batch_next_chunk(me))
+            {
+                is_resumed = TRUE;
+                break;
+            }
+            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+        }
+        *p_event = optiga_crypt_verify_batch_end(me, *p_event);
+    } while (FALSE);
+    return (is_resumed);
+}
+
+optiga_lib_status_t optiga_crypt_verify_batch(optiga_crypt_t * me,
+                                              optiga_crypt_verify_item_t * items,
+                                              uint16_t item_count)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    optiga_crypt_verify_item_t * p_item;
+    uint16_t index;
+#ifdef OPTIGA_CRYPT_ECDSA_VERIFY_OFFLOAD_ENABLED
+    const public_key_from_host_t * p_public_key;
+    pal_status_t pal_return_value;
+#endif //OPTIGA_CRYPT_ECDSA_VERIFY_OFFLOAD_ENABLED
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == items))
+        {
+            break;
+        }
+#endif
+        if (0U == item_count)
+        {
+            break;
+        }
+        for (index = 0; index < item_count; index++)
+        {
+            if ((NULL == items[index].digest) || (NULL == items[index].signature) || (NULL == items[index].public_key))
+            {
+                break;
+            }
+        }
+        if (index < item_count)
+        {
+            break;
+        }
+
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+
+        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+        me->p_verify_batch_items = items;
+        me->verify_batch_count = item_count;
+        me->verify_batch_index = 0;
+
+        // Prefiltering, the ECDSA signatures with public key from host are verified on host
+        for (index = 0; index < item_count; index++)
+        {
+            p_item = &items[index];
+            p_item->status = OPTIGA_LIB_BUSY;
+#ifdef OPTIGA_CRYPT_ECDSA_VERIFY_OFFLOAD_ENABLED
+            if ((TRUE != me->verify_offload_enabled) || (OPTIGA_CRYPT_OID_DATA == p_item->public_key_source_type) ||
+                (OPTIGA_CRYPT_VERIFY_BATCH_ECDSA != p_item->signature_scheme))
+            {
+                continue;
+            }
+            p_public_key = (const public_key_from_host_t *)p_item->public_key;
+            if (NULL == p_public_key->public_key)
+            {
+                continue;
+            }
+            pal_return_value = pal_crypt_ecdsa_verify(NULL,
+                                                      p_public_key->key_type,
+                                                      p_item->digest,
+                                                      p_item->digest_length,
+                                                      p_item->signature,
+                                                      p_item->signature_length,
+                                                      p_public_key->public_key,
+                                                      p_public_key->length);
+            // Curve is not supported by the crypto library on host, the signature is verified by OPTIGA
+            if (PAL_STATUS_INVALID_INPUT != pal_return_value)
+            {
+                p_item->status = (PAL_STATUS_SUCCESS == pal_return_value) ?
+                                 OPTIGA_LIB_SUCCESS : OPTIGA_CRYPT_SIGNATURE_VERIFICATION_FAILURE;
+            }
+#endif //OPTIGA_CRYPT_ECDSA_VERIFY_OFFLOAD_ENABLED
+        }
+
+        // The protection level is kept for the verify commands of all the chunks
+        return_value = optiga_crypt_verify_batch_next_chunk(me);
+        if (0U == me->verify_batch_chunk_count)
+        {
+            // All the items are verified on host, hence the callback is invoked right away
+            return_value = OPTIGA_LIB_SUCCESS;
+            optiga_crypt_generic_event_handler(me, optiga_crypt_verify_batch_end(me, OPTIGA_LIB_SUCCESS));
+            break;
+        }
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            me->verify_batch_count = 0;
+            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+        }
+    } while (FALSE);
+    if (OPTIGA_LIB_SUCCESS != return_value)
+    {
+        optiga_crypt_reset_protection_level(me);
+    }
+
+    return (return_value);
+}
+#endif //OPTIGA_CRYPT_VERIFY_BATCH_ENABLED
+
+#ifdef OPTIGA_CRYPT_RSA_ENCRYPT_ENABLED
+optiga_lib_status_t optiga_crypt_rsa_encrypt_message(optiga_crypt_t * me,
+                                                     optiga_rsa_encryption_scheme_t encryption_scheme,
+                                                     const uint8_t * message,
+                                                     uint16_t message_length,
+                                                     const uint8_t * label,
+                                                     uint16_t label_length,
+                                                     uint8_t public_key_source_type,
+                                                     const void * public_key,
+                                                     uint8_t * encrypted_message,
+                                                     uint16_t * encrypted_message_length)
+{
+
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == message)||
+            (NULL == public_key) || (NULL == encrypted_message) || (NULL == encrypted_message_length))
+        {
+            break;
+        }
+#endif
+        return_value =  optiga_crypt_rsa_enc_dec(me,
+                                                 encryption_scheme,
+                                                 message,
+                                                 message_length,
+                                                 label,
+                                                 label_length,
+                                                 public_key_source_type,
+                                                 public_key,
+                                                 encrypted_message,
+                                                 encrypted_message_length,
+                                                 TRUE);
+    } while (FALSE);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_rsa_encrypt_session(optiga_crypt_t * me,
+                                                     optiga_rsa_encryption_scheme_t encryption_scheme,
+                                                     const uint8_t * label,
+                                                     uint16_t label_length,
+                                                     uint8_t public_key_source_type,
+                                                     const void * public_key,
+                                                     uint8_t * encrypted_message,
+                                                     uint16_t * encrypted_message_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == encrypted_message)|| (NULL == encrypted_message_length) ||
+            (NULL == public_key))
+        {
+            break;
+        }
+#endif
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+        me->protection_level |= OPTIGA_COMMS_COMMAND_PROTECTION;
+#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+        return_value =  optiga_crypt_rsa_enc_dec(me,
+                                                 encryption_scheme,
+                                                 NULL,
+                                                 0,
+                                                 label,
+                                                 label_length,
+                                                 public_key_source_type,
+                                                 public_key,
+                                                 encrypted_message,
+                                                 encrypted_message_length,
+                                                 TRUE);
+    } while (FALSE);
+    return (return_value);
+}
+
+#endif //OPTIGA_CRYPT_RSA_ENCRYPT_ENABLED
+#ifdef OPTIGA_CRYPT_RSA_DECRYPT_ENABLED
+optiga_lib_status_t optiga_crypt_rsa_decrypt_and_export(optiga_crypt_t * me,
+                                                        optiga_rsa_encryption_scheme_t encryption_scheme,
+                                                        const uint8_t * encrypted_message,
+                                                        uint16_t encrypted_message_length,
+                                                        const uint8_t * label,
+                                                        uint16_t label_length,
+                                                        optiga_key_id_t private_key,
+                                                        uint8_t * message,
+                                                        uint16_t * message_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    optiga_key_id_t private_key_id;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == message) || (NULL == message_length)||
+            (NULL == encrypted_message))
+        {
+            break;
+        }
+#endif
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+        me->protection_level |= OPTIGA_COMMS_RESPONSE_PROTECTION;
+#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+        private_key_id = private_key;
+        return_value = optiga_crypt_rsa_enc_dec(me,
+                                                encryption_scheme,
+                                                encrypted_message,
+                                                encrypted_message_length,
+                                                label,
+                                                label_length,
+                                                0,
+                                                (void *)&private_key_id,
+                                                message,
+                                                message_length,
+                                                FALSE);
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_rsa_decrypt_and_store(optiga_crypt_t * me,
+                                                       optiga_rsa_encryption_scheme_t encryption_scheme,
+                                                       const uint8_t * encrypted_message,
+                                                       uint16_t encrypted_message_length,
+                                                       const uint8_t * label,
+                                                       uint16_t label_length,
+                                                       optiga_key_id_t private_key)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    optiga_key_id_t private_key_id;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == encrypted_message))
+        {
+           break;
+        }
+#endif
+        private_key_id = private_key;
+        return_value = optiga_crypt_rsa_enc_dec(me,
+                                                encryption_scheme,
+                                                encrypted_message,
+                                                encrypted_message_length,
+                                                label,
+                                                label_length,
+                                                0,
+                                                (void *)&private_key_id,
+                                                NULL,
+                                                NULL,
+                                                FALSE);
+    } while (FALSE);
+
+    return (return_value);
+}
+#endif //OPTIGA_CRYPT_RSA_DECRYPT_ENABLED
+#ifdef OPTIGA_CRYPT_RSA_PRE_MASTER_SECRET_ENABLED
+optiga_lib_status_t optiga_crypt_rsa_generate_pre_master_secret(optiga_crypt_t * me,
+                                                                const uint8_t * optional_data,
+                                                                uint16_t optional_data_length,
+                                                                uint16_t pre_master_secret_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        /// Maximum length of shared secret supported by OPTIGA is 48 bytes, minimum is 8 bytes.
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+
+        /// The minimum difference between shared secret length and optional data length should be 8 bytes,
+        /// since the minimum random length OPTIGA expects is 8 bytes (optional_data_length <= shared_length - 8 bytes).
+        if (((optional_data_length + OPTIGA_CRYPT_MINIMUM_RANDOM_DATA_LENGTH) > pre_master_secret_length) ||
+            (optional_data_length > OPTIGA_CRYPT_MINIMUM_OPTIONAL_DATA_LENGTH))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+
+        return_value = optiga_crypt_get_random(me,
+                                               OPTIGA_CRYTP_RANDOM_PARAM_PRE_MASTER_SECRET,
+                                               NULL,
+                                               (pre_master_secret_length - optional_data_length),
+                                               optional_data,
+                                               optional_data_length,
+                                               TRUE);
+    } while (FALSE);
+
+    return (return_value);
+}
+#endif //OPTIGA_CRYPT_RSA_PRE_MASTER_SECRET_ENABLED
+
+#ifdef OPTIGA_CRYPT_SYM_ENCRYPT_ENABLED
+
+optiga_lib_status_t optiga_crypt_symmetric_encrypt(optiga_crypt_t * me,
+                                                   optiga_symmetric_encryption_mode_t encryption_mode,
+                                                   optiga_key_id_t symmetric_key_oid,
+                                                   const uint8_t * plain_data,
+                                                   uint32_t plain_data_length,
+                                                   const uint8_t * iv,
+                                                   uint16_t iv_length,
+                                                   const uint8_t * associated_data,
+                                                   uint16_t associated_data_length,
+                                                   uint8_t * encrypted_data,
+                                                   uint32_t * encrypted_data_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == plain_data) || 
+            (NULL == encrypted_data) || (NULL == encrypted_data_length))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+        return_value =  optiga_crypt_symmetric_mode_generic(me,
+                                                            (uint8_t)encryption_mode,
+                                                            (uint16_t)symmetric_key_oid,
+                                                            plain_data,
+                                                            plain_data_length,
+                                                            iv,
+                                                            iv_length,
+                                                            associated_data,
+                                                            associated_data_length,
+                                                            0,
+                                                            encrypted_data,
+                                                            encrypted_data_length,
+                                                            NULL,
+                                                            0,
+                                                            OPTIGA_CRYPT_SYM_START_FINAL,
+                                                            OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION,
+                                                            OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION);
+    } while(FALSE);
+    optiga_crypt_reset_protection_level(me);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_symmetric_encrypt_start(optiga_crypt_t * me,
+                                                         optiga_symmetric_encryption_mode_t encryption_mode,
+                                                         optiga_key_id_t symmetric_key_oid,
+                                                         const uint8_t * plain_data,
+                                                         uint32_t plain_data_length,
+                                                         const uint8_t * iv,
+                                                         uint16_t iv_length,
+                                                         const uint8_t * associated_data,
+                                                         uint16_t associated_data_length,
+                                                         uint16_t total_plain_data_length,
+                                                         uint8_t * encrypted_data,
+                                                         uint32_t * encrypted_data_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == plain_data) ||
+           (((NULL == encrypted_data) || (NULL == encrypted_data_length)) && \
+           (OPTIGA_SYMMETRIC_CBC_MAC != encryption_mode)))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+        return_value =  optiga_crypt_symmetric_mode_generic(me,
+                                                            (uint8_t)encryption_mode,
+                                                            (uint16_t)symmetric_key_oid,
+                                                            plain_data,
+                                                            plain_data_length,
+                                                            iv,
+                                                            iv_length,
+                                                            associated_data,
+                                                            associated_data_length,
+                                                            total_plain_data_length,
+                                                            encrypted_data,
+                                                            encrypted_data_length,
+                                                            NULL,
+                                                            0,        
+                                                            OPTIGA_CRYPT_SYM_START,
+                                                            OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION,
+                                                            OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION);
+    } while(FALSE);
+    optiga_crypt_reset_protection_level(me);
+    return (return_value);
+}
+
+
+optiga_lib_status_t optiga_crypt_symmetric_encrypt_continue(optiga_crypt_t * me,
+                                                            const uint8_t * plain_data,
+                                                            uint32_t plain_data_length,
+                                                            uint8_t * encrypted_data,
+                                                            uint32_t * encrypted_data_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == plain_data) ||
+           (((NULL == encrypted_data) || (NULL == encrypted_data_length)) && (OPTIGA_SYMMETRIC_CBC_MAC != \
+           ((optiga_symmetric_encryption_mode_t)\
+           ((optiga_encrypt_sym_params_t *)&(me->p_params->optiga_symmetric_enc_dec_params))->mode))))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+        return_value =  optiga_crypt_symmetric_mode_generic(me,
+                                                            0,
+                                                            0,
+                                                            plain_data,
+                                                            plain_data_length,
+                                                            NULL,
+                                                            0,
+                                                            NULL,
+                                                            0,
+                                                            0,
+                                                            encrypted_data,
+                                                            encrypted_data_length,
+                                                            NULL,
+                                                            0,        
+                                                            OPTIGA_CRYPT_SYM_CONTINUE,
+                                                            OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION,
+                                                            OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION);
+    } while (FALSE);
+    optiga_crypt_reset_protection_level(me);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_symmetric_encrypt_final(optiga_crypt_t * me,
+                                                         const uint8_t * plain_data,
+                                                         uint32_t plain_data_length,
+                                                         uint8_t * encrypted_data,
+                                                         uint32_t * encrypted_data_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) ||
+           (NULL == plain_data) || (NULL == encrypted_data) || (NULL == encrypted_data_length))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+        return_value = optiga_crypt_symmetric_mode_generic(me,
+                                                           0,
+                                                           0,
+                                                           plain_data,
+                                                           plain_data_length,
+                                                           NULL,
+                                                           0,
+                                                           NULL,
+                                                           0,
+                                                           0,
+                                                           encrypted_data,
+                                                           encrypted_data_length,
+                                                           NULL,
+                                                           0,        
+                                                           OPTIGA_CRYPT_SYM_FINAL,
+                                                           OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION,
+                                                           OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION);
+    } while (FALSE);
+    optiga_crypt_reset_protection_level(me);
+    return (return_value);
+}
+
+
+optiga_lib_status_t optiga_crypt_symmetric_encrypt_ecb(optiga_crypt_t * me,
+                                                       optiga_key_id_t symmetric_key_oid,
+                                                       const uint8_t * plain_data,
+                                                       uint32_t plain_data_length,
+                                                       uint8_t * encrypted_data,
+                                                       uint32_t * encrypted_data_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) ||
+           (NULL == plain_data) || (NULL == encrypted_data) || (NULL == encrypted_data_length))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+        return_value = optiga_crypt_symmetric_mode_generic(me,
+                                                           (uint8_t)OPTIGA_SYMMETRIC_ECB,
+                                                           (uint16_t)symmetric_key_oid,
+                                                           plain_data,
+                                                           plain_data_length,
+                                                           NULL,
+                                                           0,
+                                                           NULL,
+                                                           0,
+                                                           0,
+                                                           encrypted_data,
+                                                           encrypted_data_length,
+                                                           NULL,
+                                                           0,        
+                                                           OPTIGA_CRYPT_SYM_START_FINAL,
+                                                           OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION,
+                                                           OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION);
+    } while (FALSE);
+    optiga_crypt_reset_protection_level(me);
+    return (return_value);
+}
+
+#endif //OPTIGA_CRYPT_SYM_ENCRYPT_ENABLED
+
+#ifdef OPTIGA_CRYPT_SYM_DECRYPT_ENABLED
+
+optiga_lib_status_t optiga_crypt_symmetric_decrypt(optiga_crypt_t * me,
+                                                   optiga_symmetric_encryption_mode_t encryption_mode,
+                                                   optiga_key_id_t symmetric_key_oid,
+                                                   const uint8_t * encrypted_data,
+                                                   uint32_t encrypted_data_length,
+                                                   const uint8_t * iv,
+                                                   uint16_t iv_length,
+                                                   const uint8_t * associated_data,
+                                                   uint16_t associated_data_length,
+                                                   uint8_t * plain_data,
+                                                   uint32_t * plain_data_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == encrypted_data) || 
+            (NULL == plain_data) || (NULL == plain_data_length))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+        return_value =  optiga_crypt_symmetric_mode_generic(me,
+                                                            (uint8_t)encryption_mode,
+                                                            (uint16_t)symmetric_key_oid,
+                                                            encrypted_data,
+                                                            encrypted_data_length,
+                                                            iv,
+                                                            iv_length,
+                                                            associated_data,
+                                                            associated_data_length,
+                                                            0,
+                                                            plain_data,
+                                                            plain_data_length,
+                                                            NULL,
+                                                            0,        
+                                                            OPTIGA_CRYPT_SYM_START_FINAL,
+                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION,
+                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION);
+    } while(FALSE);
+    optiga_crypt_reset_protection_level(me);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_symmetric_decrypt_ecb(optiga_crypt_t * me,
+                                                       optiga_key_id_t symmetric_key_oid,
+                                                       const uint8_t * encrypted_data,
+                                                       uint32_t encrypted_data_length,
+                                                       uint8_t * plain_data,
+                                                       uint32_t * plain_data_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == plain_data) ||
+            (NULL == encrypted_data) || (NULL == plain_data_length))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+        return_value =  optiga_crypt_symmetric_mode_generic(me,
+                                                            (uint8_t)OPTIGA_SYMMETRIC_ECB,
+                                                            (uint16_t)symmetric_key_oid,
+                                                            encrypted_data,
+                                                            encrypted_data_length,
+                                                            NULL,
+                                                            0,
+                                                            NULL,
+                                                            0,
+                                                            0,
+                                                            plain_data,
+                                                            plain_data_length,
+                                                            NULL,
+                                                            0,        
+                                                            OPTIGA_CRYPT_SYM_START_FINAL,
+                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION,
+                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION);
+    } while (FALSE);
+    optiga_crypt_reset_protection_level(me);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_symmetric_decrypt_start(optiga_crypt_t * me,
+                                                         optiga_symmetric_encryption_mode_t encryption_mode,
+                                                         optiga_key_id_t symmetric_key_oid,
+                                                         const uint8_t * encrypted_data,
+                                                         uint32_t encrypted_data_length,
+                                                         const uint8_t * iv,
+                                                         uint16_t iv_length,
+                                                         const uint8_t * associated_data,
+                                                         uint16_t associated_data_length,
+                                                         uint16_t total_encrypted_data_length,
+                                                         uint8_t * plain_data,
+                                                         uint32_t * plain_data_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == encrypted_data) || 
+            (NULL == plain_data) || (NULL == plain_data_length))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+        return_value =  optiga_crypt_symmetric_mode_generic(me,
+                                                            (uint8_t)encryption_mode,
+                                                            (uint16_t)symmetric_key_oid,
+                                                            encrypted_data,
+                                                            encrypted_data_length,
+                                                            iv,
+                                                            iv_length,
+                                                            associated_data,
+                                                            associated_data_length,
+                                                            total_encrypted_data_length,
+                                                            plain_data,
+                                                            plain_data_length,
+                                                            NULL,
+                                                            0,        
+                                                            OPTIGA_CRYPT_SYM_START,
+                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION,
+                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION);
+    } while(FALSE);
+    optiga_crypt_reset_protection_level(me);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_symmetric_decrypt_continue(optiga_crypt_t * me,
+                                                            const uint8_t * encrypted_data,
+                                                            uint32_t encrypted_data_length,
+                                                            uint8_t * plain_data,
+                                                            uint32_t * plain_data_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == encrypted_data) ||
+            (NULL == plain_data) || (NULL == plain_data_length))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+        return_value =  optiga_crypt_symmetric_mode_generic(me,
+                                                            0,
+                                                            0,
+                                                            encrypted_data,
+                                                            encrypted_data_length,
+                                                            NULL,
+                                                            0,
+                                                            NULL,
+                                                            0,
+                                                            0,
+                                                            plain_data,
+                                                            plain_data_length,
+                                                            NULL,
+                                                            0,        
+                                                            OPTIGA_CRYPT_SYM_CONTINUE,
+                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION,
+                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION);
+    } while(FALSE);
+    optiga_crypt_reset_protection_level(me);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_symmetric_decrypt_final(optiga_crypt_t * me,
+                                                         const uint8_t * encrypted_data,
+                                                         uint32_t encrypted_data_length,
+                                                         uint8_t * plain_data,
+                                                         uint32_t * plain_data_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == encrypted_data) ||
+            (NULL == plain_data) || (NULL == plain_data_length))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+        return_value =  optiga_crypt_symmetric_mode_generic(me,
+                                                            0,
+                                                            0,
+                                                            encrypted_data,
+                                                            encrypted_data_length,
+                                                            NULL,
+                                                            0,
+                                                            NULL,
+                                                            0,
+                                                            0,
+                                                            plain_data,
+                                                            plain_data_length,
+                                                            NULL,
+                                                            0,        
+                                                            OPTIGA_CRYPT_SYM_FINAL,
+                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION,
+                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION);
+    } while(FALSE);
+    optiga_crypt_reset_protection_level(me);
+    return (return_value);
+}
+
+#endif //OPTIGA_CRYPT_SYM_DECRYPT_ENABLED
+
+#ifdef OPTIGA_CRYPT_HMAC_ENABLED
+
+optiga_lib_status_t optiga_crypt_hmac(optiga_crypt_t * me, 
+                                      optiga_hmac_type_t type, 
+                                      uint16_t secret, 
+                                      const uint8_t * input_data, 
+                                      uint32_t input_data_length, 
+                                      uint8_t * mac, 
+                                      uint32_t * mac_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == input_data) || 
+            (NULL == mac) || (NULL == mac_length))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+        return_value =  optiga_crypt_symmetric_mode_generic(me,
+                                                            (uint8_t)type,
+                                                            secret,
+                                                            input_data,
+                                                            input_data_length,
+                                                            NULL,
+                                                            0,
+                                                            NULL,
+                                                            0,
+                                                            0,
+                                                            mac,
+                                                            mac_length,
+                                                            NULL,
+                                                            0,        
+                                                            OPTIGA_CRYPT_SYM_START_FINAL,
+                                                            OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION,
+                                                            OPTIGA_CRYPT_HMAC);
+    } while(FALSE);
+    optiga_crypt_reset_protection_level(me);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_hmac_start(optiga_crypt_t * me, 
+                                            optiga_hmac_type_t type, 
+                                            uint16_t secret, 
+                                            const uint8_t * input_data, 
+                                            uint32_t input_data_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == input_data))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+#ifdef OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+        // Data coalesced for the previous hmac sequence is discarded, since OPTIGA starts a new sequence
+        if ((OPTIGA_LIB_INSTANCE_BUSY != me->instance_state) && (OPTIGA_CRYPT_COALESCING_HMAC == me->coalesced_sequence))
+        {
+            me->coalesced_length = 0;
+            me->coalesced_sequence = OPTIGA_CRYPT_COALESCING_NONE;
+            me->coalesced_hmac_start_pending = FALSE;
+        }
+        // The start is deferred and sent along with the coalesced data
+        if ((TRUE == me->coalescing_enabled) && (OPTIGA_LIB_INSTANCE_BUSY != me->instance_state) &&
+            (0 == me->coalesced_length))
+        {
+            me->coalesced_sequence = OPTIGA_CRYPT_COALESCING_HMAC;
+            me->p_coalesced_hash_ctx = NULL;
+            me->coalesced_hmac_type = (uint8_t)type;
+            me->coalesced_hmac_secret = secret;
+            me->coalesced_hmac_start_pending = TRUE;
+            return_value = optiga_crypt_coalescing_add(me, input_data, input_data_length);
+            if (OPTIGA_LIB_SUCCESS != return_value)
+            {
+                me->coalesced_sequence = OPTIGA_CRYPT_COALESCING_NONE;
+                me->coalesced_hmac_start_pending = FALSE;
+            }
+            break;
+        }
+#endif //OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+        return_value =  optiga_crypt_symmetric_mode_generic(me,
+                                                            (uint8_t)type,
+                                                            secret,
+                                                            input_data,
+                                                            input_data_length,
+                                                            NULL,
+                                                            0,
+                                                            NULL,
+                                                            0,
+                                                            0,
+                                                            NULL,
+                                                            NULL,
+                                                            NULL,
+                                                            0,        
+                                                            OPTIGA_CRYPT_SYM_START,
+                                                            OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION,
+                                                            OPTIGA_CRYPT_HMAC);
+    } while(FALSE);
+    optiga_crypt_reset_protection_level(me);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_hmac_update(optiga_crypt_t * me,
+                                             const uint8_t * input_data,
+                                             uint32_t input_data_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == input_data))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+#ifdef OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+        // Only the sequence started with coalescing is coalesced, else OPTIGA enforces the sequence
+        if ((TRUE == me->coalescing_enabled) && (OPTIGA_CRYPT_COALESCING_HMAC == me->coalesced_sequence))
+        {
+            return_value = optiga_crypt_coalescing_begin(me, OPTIGA_CRYPT_COALESCING_HMAC, NULL);
+            if (OPTIGA_LIB_SUCCESS == return_value)
+            {
+                return_value = optiga_crypt_coalescing_add(me, input_data, input_data_length);
+            }
+            break;
+        }
+#endif //OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+        return_value =  optiga_crypt_symmetric_mode_generic(me,
+                                                            0,
+                                                            0,
+                                                            input_data,
+                                                            input_data_length,
+                                                            NULL,
+                                                            0,
+                                                            NULL,
+                                                            0,
+                                                            0,
+                                                            NULL,
+                                                            NULL,
+                                                            NULL,
+                                                            0,        
+                                                            OPTIGA_CRYPT_SYM_CONTINUE,
+                                                            OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION,
+                                                            OPTIGA_CRYPT_HMAC);
+    } while(FALSE);
+    optiga_crypt_reset_protection_level(me);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_hmac_finalize(optiga_crypt_t * me,
+                                               const uint8_t * input_data,
+                                               uint32_t input_data_length,
+                                               uint8_t * mac, 
+                                               uint32_t * mac_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == input_data) || 
+            (NULL == mac) || (NULL == mac_length))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+#ifdef OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+        if (OPTIGA_CRYPT_COALESCING_HMAC == me->coalesced_sequence)
+        {
+            return_value = optiga_crypt_coalescing_flush_and_finalize(me, input_data, input_data_length, mac, mac_length);
+            break;
+        }
+#endif //OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+        return_value =  optiga_crypt_symmetric_mode_generic(me,
+                                                            0,
+                                                            0,
+                                                            input_data,
+                                                            input_data_length,
+                                                            NULL,
+                                                            0,
+                                                            NULL,
+                                                            0,
+                                                            0,
+                                                            mac,
+                                                            mac_length,
+                                                            NULL,
+                                                            0,        
+                                                            OPTIGA_CRYPT_SYM_FINAL,
+                                                            OPTIGA_CRYPT_SYMMETRIC_ENCRYPTION,
+                                                            OPTIGA_CRYPT_HMAC);
+    } while(FALSE);
+    optiga_crypt_reset_protection_level(me);
+    return (return_value);
+}
+
+#endif //OPTIGA_CRYPT_HMAC_ENABLED
+
+#ifdef OPTIGA_CRYPT_HKDF_ENABLED
+optiga_lib_status_t optiga_crypt_hkdf(optiga_crypt_t * me,
+                                      optiga_hkdf_type_t type,
+                                      uint16_t secret,
+                                      const uint8_t * salt,
+                                      uint16_t salt_length,
+                                      const uint8_t * info,
+                                      uint16_t info_length,
+                                      uint16_t derived_key_length,
+                                      bool_t export_to_host,
+                                      uint8_t * derived_key)
+{
+    
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || \
+           ((TRUE == export_to_host) && (NULL == derived_key)))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+        return_value =  optiga_crypt_derive_key_generic(me,
+                                                        (uint8_t)type,
+                                                        secret,
+                                                        salt,
+                                                        salt_length,
+                                                        NULL,
+                                                        0,
+                                                        info,
+                                                        info_length,
+                                                        derived_key_length,
+                                                        export_to_host,
+                                                        derived_key);
+    } while(FALSE);
+    return (return_value);
+}
+
+#if defined (OPTIGA_CRYPT_TLS13_KEY_SCHEDULE_ENABLED) && defined (OPTIGA_CRYPT_ECDH_ENABLED)
+/// Hash of the empty string, used as the context of the "derived" label
+_STATIC_H const uint8_t optiga_crypt_tls13_empty_hash_sha256[] =
+{
+    0xE3, 0xB0, 0xC4, 0x42, 0x98, 0xFC, 0x1C, 0x14, 0x9A, 0xFB, 0xF4, 0xC8, 0x99, 0x6F, 0xB9, 0x24,
+    0x27, 0xAE, 0x41, 0xE4, 0x64, 0x9B, 0x93, 0x4C, 0xA4, 0x95, 0x99, 0x1B, 0x78, 0x52, 0xB8, 0x55
+};
+_STATIC_H const uint8_t optiga_crypt_tls13_empty_hash_sha384[] =
+{
+    0x38, 0xB0, 0x60, 0xA7, 0x51, 0xAC, 0x96, 0x38, 0x4C, 0xD9, 0x32, 0x7E, 0xB1, 0xB1, 0xE3, 0x6A,
+    0x21, 0xFD, 0xB7, 0x11, 0x14, 0xBE, 0x07, 0x43, 0x4C, 0x0C, 0xC7, 0xBF, 0x63, 0xF6, 0xE1, 0xDA,
+    0x27, 0x4E, 0xDE, 0xBF, 0xE7, 0x6F, 0x65, 0xFB, 0xD5, 0x1A, 0xD2, 0xF1, 0x48, 0x98, 0xB9, 0x5B
+};
+_STATIC_H const uint8_t optiga_crypt_tls13_empty_hash_sha512[] =
+{
+    0xCF, 0x83, 0xE1, 0x35, 0x7E, 0xEF, 0xB8, 0xBD, 0xF1, 0x54, 0x28, 0x50, 0xD6, 0x6D, 0x80, 0x07,
+    0xD6, 0x20, 0xE4, 0x05, 0x0B, 0x57, 0x15, 0xDC, 0x83, 0xF4, 0xA9, 0x21, 0xD3, 0x6C, 0xE9, 0xCE,
+    0x47, 0xD0, 0xD1, 0x3C, 0x5D, 0x85, 0xF2, 0xB0, 0xFF, 0x83, 0x18, 0xD2, 0x87, 0x7E, 0xEC, 0x2F,
+    0x63, 0xB9, 0x31, 0xBD, 0x47, 0x41, 0x7A, 0x81, 0xA5, 0x38, 0x32, 0x7A, 0xF9, 0x27, 0xDA, 0x3E
+};
+
+/// Labels of the derivations of the key schedule, along with the "tls13 " prefix
+_STATIC_H const uint8_t optiga_crypt_tls13_label_c_hs_traffic[] = "tls13 c hs traffic";
+_STATIC_H const uint8_t optiga_crypt_tls13_label_s_hs_traffic[] = "tls13 s hs traffic";
+_STATIC_H const uint8_t optiga_crypt_tls13_label_derived[] = "tls13 derived";
+
+/*
+* Prepares the HkdfLabel of HKDF-Expand-Label (RFC 8446, section 7.1) and returns the length of it
+*/
+_STATIC_H uint16_t optiga_crypt_tls13_hkdf_label(uint8_t * p_hkdf_label,
+                                                 uint16_t length,
+                                                 const uint8_t * label,
+                                                 uint8_t label_length,
+                                                 const uint8_t * context,
+                                                 uint8_t context_length)
+{
+    uint16_t index = 0;
+
+    optiga_common_set_uint16(p_hkdf_label, length);
+    index += 2;
+    p_hkdf_label[index++] = label_length;
+    pal_os_memcpy(&p_hkdf_label[index], label, label_length);
+    index += label_length;
+    p_hkdf_label[index++] = context_length;
+    pal_os_memcpy(&p_hkdf_label[index], context, context_length);
+    index += context_length;
+
+    return (index);
+}
+
+optiga_lib_status_t optiga_crypt_tls13_handshake_secrets(optiga_crypt_t * me,
+                                                         optiga_hkdf_type_t type,
+                                                         public_key_from_host_t * peer_public_key,
+                                                         const uint8_t * salt,
+                                                         const uint8_t * transcript_hash,
+                                                         uint8_t * client_handshake_secret,
+                                                         uint8_t * server_handshake_secret,
+                                                         uint8_t * master_secret_salt)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    optiga_calc_ssec_params_t * p_ssec_params;
+    optiga_derive_key_params_t * p_hkdf_params;
+    const uint8_t * labels[OPTIGA_CRYPT_TLS13_KEY_SCHEDULE_STEPS - 1];
+    uint8_t label_lengths[OPTIGA_CRYPT_TLS13_KEY_SCHEDULE_STEPS - 1];
+    uint8_t * outputs[OPTIGA_CRYPT_TLS13_KEY_SCHEDULE_STEPS - 1];
+    const uint8_t * p_empty_hash;
+    uint8_t hash_length;
+    uint8_t index;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == peer_public_key) ||
+            (NULL == peer_public_key->public_key) || (NULL == salt) || (NULL == transcript_hash) ||
+            (NULL == client_handshake_secret) || (NULL == server_handshake_secret) || (NULL == master_secret_salt))
+        {
+            break;
+        }
+#endif
+        switch (type)
+        {
+            case OPTIGA_HKDF_SHA_256:
+                p_empty_hash = optiga_crypt_tls13_empty_hash_sha256;
+                hash_length = (uint8_t)sizeof(optiga_crypt_tls13_empty_hash_sha256);
+                break;
+            case OPTIGA_HKDF_SHA_384:
+                p_empty_hash = optiga_crypt_tls13_empty_hash_sha384;
+                hash_length = (uint8_t)sizeof(optiga_crypt_tls13_empty_hash_sha384);
+                break;
+            case OPTIGA_HKDF_SHA_512:
+                p_empty_hash = optiga_crypt_tls13_empty_hash_sha512;
+                hash_length = (uint8_t)sizeof(optiga_crypt_tls13_empty_hash_sha512);
+                break;
+            default:
+                p_empty_hash = NULL;
+                hash_length = 0;
+                break;
+        }
+        if (NULL == p_empty_hash)
+        {
+            break;
+        }
+
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+
+        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+
+        // (EC)DHE shared secret into the session, which is the input keying material of the handshake secret
+        p_ssec_params = &me->key_schedule_ssec_params;
+        pal_os_memset(p_ssec_params, 0x00, sizeof(optiga_calc_ssec_params_t));
+        p_ssec_params->private_key = OPTIGA_KEY_ID_SESSION_BASED;
+        p_ssec_params->public_key = peer_public_key;
+        p_ssec_params->export_to_host = FALSE;
+        me->key_schedule_items[0].cmd_type = OPTIGA_CMD_BATCH_ITEM_CALC_SSEC;
+        me->key_schedule_items[0].cmd_param = OPTIGA_CRYPT_ECDH_KEY_AGREEMENT_ALGORITHM;
+        me->key_schedule_items[0].params = p_ssec_params;
+
+        // Derive-Secret(Handshake Secret, label, context) = HKDF(salt, shared secret, HkdfLabel)
+        labels[0] = optiga_crypt_tls13_label_c_hs_traffic;
+        label_lengths[0] = (uint8_t)(sizeof(optiga_crypt_tls13_label_c_hs_traffic) - 1U);
+        outputs[0] = client_handshake_secret;
+        labels[1] = optiga_crypt_tls13_label_s_hs_traffic;
+        label_lengths[1] = (uint8_t)(sizeof(optiga_crypt_tls13_label_s_hs_traffic) - 1U);
+        outputs[1] = server_handshake_secret;
+        labels[2] = optiga_crypt_tls13_label_derived;
+        label_lengths[2] = (uint8_t)(sizeof(optiga_crypt_tls13_label_derived) - 1U);
+        outputs[2] = master_secret_salt;
+        for (index = 0; index < (OPTIGA_CRYPT_TLS13_KEY_SCHEDULE_STEPS - 1); index++)
+        {
+            p_hkdf_params = &me->key_schedule_hkdf_params[index];
+            pal_os_memset(p_hkdf_params, 0x00, sizeof(optiga_derive_key_params_t));
+            p_hkdf_params->input_shared_secret_oid = (uint16_t)OPTIGA_KEY_ID_SESSION_BASED;
+            p_hkdf_params->random_data = salt;
+            p_hkdf_params->random_data_length = hash_length;
+            p_hkdf_params->info = me->key_schedule_labels[index];
+            p_hkdf_params->info_length = optiga_crypt_tls13_hkdf_label(me->key_schedule_labels[index],
+                                                                       hash_length,
+                                                                       labels[index],
+                                                                       label_lengths[index],
+                                                                       (2U == index) ? p_empty_hash : transcript_hash,
+                                                                       hash_length);
+            p_hkdf_params->derived_key_length = hash_length;
+            p_hkdf_params->derived_key = outputs[index];
+            me->key_schedule_items[index + 1].cmd_type = OPTIGA_CMD_BATCH_ITEM_DERIVE_KEY;
+            me->key_schedule_items[index + 1].cmd_param = (uint8_t)type;
+            me->key_schedule_items[index + 1].params = p_hkdf_params;
+        }
+
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+        // The secret in the session is used
+        me->protection_level |= OPTIGA_COMMS_COMMAND_PROTECTION;
+#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+        OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
+        OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
+
+        return_value = optiga_cmd_execute_chain(me->my_cmd, me->key_schedule_items, OPTIGA_CRYPT_TLS13_KEY_SCHEDULE_STEPS);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+        }
+    } while (FALSE);
+    optiga_crypt_reset_protection_level(me);
+
+    return (return_value);
+}
+#endif //(OPTIGA_CRYPT_TLS13_KEY_SCHEDULE_ENABLED) && (OPTIGA_CRYPT_ECDH_ENABLED)
+
+#endif //OPTIGA_CRYPT_HKDF_ENABLED
+#ifdef OPTIGA_CRYPT_SYM_GENERATE_KEY_ENABLED
+optiga_lib_status_t optiga_crypt_symmetric_generate_key(optiga_crypt_t * me,
+                                                        optiga_symmetric_key_type_t key_type,
+                                                        uint8_t key_usage,
+                                                        bool_t export_symmetric_key,
+                                                        void * symmetric_key)
+{
+    
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    optiga_gen_symkey_params_t * p_params;    
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == symmetric_key))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+        
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+#ifdef OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+        if (FALSE == optiga_cmd_is_capable(me->my_cmd, OPTIGA_LIB_CAPABILITY_SYMMETRIC))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_UNSUPPORTED;
+            break;
+        }
+#endif //OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+
+        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+        
+        p_params = (optiga_gen_symkey_params_t *)&(me->p_params->optiga_gen_sym_key_params);
+        pal_os_memset(p_params,0x00,sizeof(optiga_gen_symkey_params_t));
+        
+        p_params->key_usage = key_usage;
+        p_params->export_symmetric_key = export_symmetric_key;
+        p_params->symmetric_key = symmetric_key;
+        
+        OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
+        OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
+        
+        return_value = optiga_cmd_gen_symkey(me->my_cmd,
+                                             (uint8_t)key_type,
+                                             p_params);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+        }
+        
+    } while(FALSE);
+    optiga_crypt_reset_protection_level(me);
+    
+    return (return_value);
+}
+
+#endif //OPTIGA_CRYPT_SYM_GENERATE_KEY_ENABLED
+
+#ifdef OPTIGA_CRYPT_GENERATE_AUTH_CODE_ENABLED
+optiga_lib_status_t optiga_crypt_generate_auth_code(optiga_crypt_t * me, 
+                                                    optiga_rng_type_t rng_type, 
+                                                    const uint8_t * optional_data, 
+                                                    uint16_t optional_data_length, 
+                                                    uint8_t * random_data, 
+                                                    uint16_t random_data_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+#define OPTIGA_CRYPT_MAX_AUTH_CODE_LENGTH   (0x42)
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == random_data))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+
+        ///The minimum size of random stream is 8 bytes 
+        ///and the maximum size of (optional_data + random data) is 48 bytes.
+        if (( OPTIGA_CRYPT_MINIMUM_RANDOM_DATA_LENGTH > random_data_length) ||
+            ((optional_data_length + random_data_length) > OPTIGA_CRYPT_MAX_AUTH_CODE_LENGTH))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+#ifdef OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+        if (FALSE == optiga_cmd_is_capable(me->my_cmd, OPTIGA_LIB_CAPABILITY_SYMMETRIC))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_UNSUPPORTED;
+            break;
+        }
+#endif //OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+
+        return_value = optiga_crypt_get_random(me,
+                                               (uint8_t)rng_type,
+                                               random_data,
+                                               random_data_length,
+                                               optional_data,
+                                               optional_data_length,
+                                               TRUE);
+    } while (FALSE);
+#undef OPTIGA_CRYPT_MAX_AUTH_CODE_LENGTH
+    return (return_value);
+}
+
+#endif //OPTIGA_CRYPT_SYM_GENERATE_KEY_ENABLED
+
+#ifdef OPTIGA_CRYPT_HMAC_VERIFY_ENABLED
+optiga_lib_status_t optiga_crypt_hmac_verify(optiga_crypt_t * me,
+                                             optiga_hmac_type_t type,
+                                             uint16_t secret,
+                                             const uint8_t * input_data,
+                                             uint32_t input_data_length,
+                                             const uint8_t * hmac,
+                                             uint32_t hmac_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == input_data) || (NULL == hmac))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+
+        return_value =  optiga_crypt_symmetric_mode_generic(me,
+                                                            (uint8_t)type,
+                                                            secret,
+                                                            input_data,
+                                                            input_data_length,
+                                                            NULL,
+                                                            0,
+                                                            NULL,
+                                                            0,
+                                                            0,
+                                                            NULL,
+                                                            NULL,
+                                                            hmac,
+                                                            hmac_length,
+                                                            OPTIGA_CRYPT_SYM_START_FINAL,
+                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION,
+                                                            OPTIGA_CRYPT_HMAC);
+    } while (FALSE);
+    optiga_crypt_reset_protection_level(me);
+    
+    return (return_value);
+}
+#endif // OPTIGA_CRYPT_HMAC_VERIFY_ENABLED
+#ifdef OPTIGA_CRYPT_CLEAR_AUTO_STATE_ENABLED
+optiga_lib_status_t optiga_crypt_clear_auto_state(optiga_crypt_t * me,
+                                                  uint16_t secret)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+
+        return_value =  optiga_crypt_symmetric_mode_generic(me,
+                                                            (uint8_t)OPTIGA_HMAC_SHA_256,
+                                                            secret,
+                                                            NULL,
+                                                            0,
+                                                            NULL,
+                                                            0,
+                                                            NULL,
+                                                            0,
+                                                            0,
+                                                            NULL,
+                                                            NULL,
+                                                            NULL,
+                                                            0,
+                                                            OPTIGA_CRYPT_SYM_START_FINAL,
+                                                            OPTIGA_CRYPT_SYMMETRIC_DECRYPTION,
+                                                            OPTIGA_CRYPT_CLEAR_AUTO_STATE);
+    } while (FALSE);
+    optiga_crypt_reset_protection_level(me);
+    
+    return (return_value);
+}
+#endif // OPTIGA_CRYPT_CLEAR_AUTO_STATE_ENABLED
+
+#if defined (OPTIGA_CRYPT_HMAC_AUTHORIZE_ENABLED) && defined (OPTIGA_CRYPT_SYM_DECRYPT_ENABLED)
+/// Index of the HMAC verification in the chain of the authorization
+#define OPTIGA_CRYPT_HMAC_AUTHORIZE_VERIFY_INDEX    (2)
+
+/*
+* Host item of the authorization, calculates the HMAC of the auth code using the callback of the caller
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_hmac_authorize_host(void * p_context)
+{
+    optiga_crypt_t * me = (optiga_crypt_t *)p_context;
+    uint16_t hmac_length = (uint16_t)sizeof(me->authorize_hmac);
+    optiga_lib_status_t return_value;
+
+    return_value = me->authorize_hmac_callback(me->authorize_hmac_context,
+                                               me->authorize_input,
+                                               me->authorize_input_length,
+                                               me->authorize_hmac,
+                                               &hmac_length);
+    if ((OPTIGA_LIB_SUCCESS == return_value) && ((0U == hmac_length) || (sizeof(me->authorize_hmac) < hmac_length)))
+    {
+        return_value = OPTIGA_CRYPT_ERROR_MEMORY_INSUFFICIENT;
+    }
+    me->authorize_sym_params[0].generated_hmac_length = hmac_length;
+    return (return_value);
+}
+
+/*
+* Updates the status of the protected items and clears the AUTO state, if the chain failed after the HMAC verification
+*/
+_STATIC_H uint8_t optiga_crypt_hmac_authorize_resume(optiga_crypt_t * me,
+                                                     optiga_lib_status_t * p_event)
+{
+    uint8_t is_resumed = FALSE;
+    uint8_t index;
+
+    do
+    {
+        if (TRUE == me->authorize_clear_ongoing)
+        {
+            // The status of the failed chain is reported, clearing the AUTO state is best effort
+            me->authorize_clear_ongoing = FALSE;
+            *p_event = me->authorize_status;
+            break;
+        }
+        if (NULL == me->p_authorize_protected_items)
+        {
+            break;
+        }
+        for (index = 0; index < me->authorize_protected_item_count; index++)
+        {
+            me->p_authorize_protected_items[index].status =
+                                    me->authorize_items[OPTIGA_CRYPT_HMAC_AUTHORIZE_STEPS + index].status;
+        }
+        me->p_authorize_protected_items = NULL;
+
+        // AUTO state of the secret is set, but the clear AUTO state of the chain is not executed
+        if ((TRUE == me->authorize_clear_auto_state) && (OPTIGA_LIB_SUCCESS != *p_event) &&
+            (OPTIGA_LIB_SUCCESS == me->authorize_items[OPTIGA_CRYPT_HMAC_AUTHORIZE_VERIFY_INDEX].status))
+        {
+            me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+            me->protection_level |= OPTIGA_COMMS_RESPONSE_PROTECTION;
+#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+            OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
+            OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
+            if (OPTIGA_LIB_SUCCESS == optiga_cmd_decrypt_sym(me->my_cmd,
+                                                             (uint8_t)OPTIGA_HMAC_SHA_256,
+                                                             &me->authorize_sym_params[1]))
+            {
+                me->authorize_status = *p_event;
+                me->authorize_clear_ongoing = TRUE;
+                is_resumed = TRUE;
+            }
+            else
+            {
+                me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+            }
+            optiga_crypt_reset_protection_level(me);
+        }
+    } while (FALSE);
+    return (is_resumed);
+}
+
+optiga_lib_status_t optiga_crypt_hmac_authorize(optiga_crypt_t * me,
+                                                optiga_rng_type_t rng_type,
+                                                optiga_hmac_type_t type,
+                                                uint16_t secret,
+                                                const uint8_t * optional_data,
+                                                uint16_t optional_data_length,
+                                                uint16_t random_data_length,
+                                                optiga_crypt_hmac_callback_t hmac_callback,
+                                                void * hmac_context,
+                                                optiga_cmd_batch_item_t * protected_items,
+                                                uint8_t protected_item_count,
+                                                bool_t clear_auto_state)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    optiga_decrypt_sym_params_t * p_sym_params;
+    uint8_t item_count;
+    uint8_t index;
+    OPTIGA_CRYPT_LOG_MESSAGE(__FUNCTION__);
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == hmac_callback) ||
+            ((NULL == protected_items) && (0U != protected_item_count)))
+        {
+            break;
+        }
+#endif
+        if (NULL == optional_data)
+        {
+            optional_data_length = 0;
+        }
+        if ((OPTIGA_CRYPT_MINIMUM_RANDOM_DATA_LENGTH > random_data_length) ||
+            ((optional_data_length + random_data_length) > OPTIGA_CRYPT_HMAC_AUTHORIZE_MAX_INPUT_LENGTH))
+        {
+            break;
+        }
+        item_count = OPTIGA_CRYPT_HMAC_AUTHORIZE_STEPS + ((TRUE == clear_auto_state) ? 1U : 0U);
+        if ((OPTIGA_CMD_BATCH_MAX_ITEMS - item_count) < protected_item_count)
+        {
+            break;
+        }
+        item_count += protected_item_count;
+
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+
+        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+
+        // Auth code (optional data | random) is generated into the session and returned into the input of HMAC
+        if (0U != optional_data_length)
+        {
+            pal_os_memcpy(me->authorize_input, optional_data, optional_data_length);
+        }
+        me->authorize_input_length = optional_data_length + random_data_length;
+        me->authorize_random_params.random_data_length = random_data_length;
+        me->authorize_random_params.random_data = &me->authorize_input[optional_data_length];
+        me->authorize_random_params.optional_data = (0U != optional_data_length) ? me->authorize_input : NULL;
+        me->authorize_random_params.optional_data_length = optional_data_length;
+        me->authorize_random_params.store_in_session = TRUE;
+        me->authorize_items[0].cmd_type = OPTIGA_CMD_BATCH_ITEM_GET_RANDOM;
+        me->authorize_items[0].cmd_param = (uint8_t)rng_type;
+        me->authorize_items[0].params = &me->authorize_random_params;
+
+        // HMAC of the auth code is calculated on host, while the lock and the session are retained
+        me->authorize_hmac_callback = hmac_callback;
+        me->authorize_hmac_context = hmac_context;
+        me->authorize_host_params.callback = optiga_crypt_hmac_authorize_host;
+        me->authorize_host_params.p_context = me;
+        me->authorize_items[1].cmd_type = OPTIGA_CMD_BATCH_ITEM_HOST;
+        me->authorize_items[1].cmd_param = 0;
+        me->authorize_items[1].params = &me->authorize_host_params;
+
+        // HMAC verification and clear AUTO state, same as optiga_crypt_hmac_verify and optiga_crypt_clear_auto_state
+        for (index = 0; index < 2U; index++)
+        {
+            p_sym_params = &me->authorize_sym_params[index];
+            pal_os_memset(p_sym_params, 0x00, sizeof(optiga_decrypt_sym_params_t));
+            p_sym_params->symmetric_key_oid = secret;
+            p_sym_params->original_sequence = OPTIGA_CRYPT_SYM_START_FINAL;
+        }
+        p_sym_params = &me->authorize_sym_params[0];
+        p_sym_params->mode = (uint8_t)type;
+        p_sym_params->in_data = me->authorize_input;
+        p_sym_params->in_data_length = me->authorize_input_length;
+        p_sym_params->generated_hmac = me->authorize_hmac;
+        p_sym_params->operation_mode = OPTIGA_CRYPT_HMAC;
+        me->authorize_items[OPTIGA_CRYPT_HMAC_AUTHORIZE_VERIFY_INDEX].cmd_type = OPTIGA_CMD_BATCH_ITEM_DECRYPT_SYM;
+        me->authorize_items[OPTIGA_CRYPT_HMAC_AUTHORIZE_VERIFY_INDEX].cmd_param = (uint8_t)type;
+        me->authorize_items[OPTIGA_CRYPT_HMAC_AUTHORIZE_VERIFY_INDEX].params = p_sym_params;
+
+        for (index = 0; index < protected_item_count; index++)
+        {
+            me->authorize_items[OPTIGA_CRYPT_HMAC_AUTHORIZE_STEPS + index] = protected_items[index];
+        }
+
+        p_sym_params = &me->authorize_sym_params[1];
+        p_sym_params->mode = (uint8_t)OPTIGA_HMAC_SHA_256;
+        p_sym_params->operation_mode = OPTIGA_CRYPT_CLEAR_AUTO_STATE;
+        if (TRUE == clear_auto_state)
+        {
+            me->authorize_items[item_count - 1U].cmd_type = OPTIGA_CMD_BATCH_ITEM_DECRYPT_SYM;
+            me->authorize_items[item_count - 1U].cmd_param = (uint8_t)OPTIGA_HMAC_SHA_256;
+            me->authorize_items[item_count - 1U].params = p_sym_params;
+        }
+        me->p_authorize_protected_items = protected_items;
+        me->authorize_protected_item_count = protected_item_count;
+        me->authorize_clear_auto_state = clear_auto_state;
+        me->authorize_clear_ongoing = FALSE;
+
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+        me->protection_level |= OPTIGA_COMMS_RESPONSE_PROTECTION;
+#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+        OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
+        OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
+
+        return_value = optiga_cmd_execute_chain(me->my_cmd, me->authorize_items, item_count);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            me->p_authorize_protected_items = NULL;
+            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+        }
+    } while (FALSE);
+    optiga_crypt_reset_protection_level(me);
+
+    return (return_value);
+}
+#endif //(OPTIGA_CRYPT_HMAC_AUTHORIZE_ENABLED) && (OPTIGA_CRYPT_SYM_DECRYPT_ENABLED)
+#ifdef OPTIGA_LIB_SYNC_API_ENABLED
+#ifdef OPTIGA_CRYPT_RANDOM_ENABLED
+optiga_lib_status_t optiga_crypt_random_sync(optiga_crypt_t * me,
+                                             optiga_rng_type_t rng_type,
+                                             uint8_t * random_data,
+                                             uint16_t random_data_length)
+{
+    optiga_lib_status_t return_value = optiga_crypt_sync_begin(me);
+
+    if (OPTIGA_LIB_SUCCESS == return_value)
+    {
+        return_value = optiga_crypt_sync_end(me, optiga_crypt_random(me,
+                                                                     rng_type,
+                                                                     random_data,
+                                                                     random_data_length));
+    }
+    return (return_value);
+}
+#endif //OPTIGA_CRYPT_RANDOM_ENABLED
+
+#ifdef OPTIGA_CRYPT_HASH_ENABLED
+optiga_lib_status_t optiga_crypt_hash_sync(optiga_crypt_t * me,
+                                           optiga_hash_type_t hash_algorithm,
+                                           uint8_t source_of_data_to_hash,
+                                           const void * data_to_hash,
+                                           uint8_t * hash_output)
+{
+    optiga_lib_status_t return_value = optiga_crypt_sync_begin(me);
+
+    if (OPTIGA_LIB_SUCCESS == return_value)
+    {
+        return_value = optiga_crypt_sync_end(me, optiga_crypt_hash(me,
+                                                                   hash_algorithm,
+                                                                   source_of_data_to_hash,
+                                                                   data_to_hash,
+                                                                   hash_output));
+    }
+    return (return_value);
+}
+#endif //OPTIGA_CRYPT_HASH_ENABLED
+
+#ifdef OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED
+optiga_lib_status_t optiga_crypt_ecc_generate_keypair_sync(optiga_crypt_t * me,
+                                                           optiga_ecc_curve_t curve_id,
+                                                           uint8_t key_usage,
+                                                           bool_t export_private_key,
+                                                           void * private_key,
+                                                           uint8_t * public_key,
+                                                           uint16_t * public_key_length)
+{
+    optiga_lib_status_t return_value = optiga_crypt_sync_begin(me);
+
+    if (OPTIGA_LIB_SUCCESS == return_value)
+    {
+        return_value = optiga_crypt_sync_end(me, optiga_crypt_ecc_generate_keypair(me,
+                                                                                   curve_id,
+                                                                                   key_usage,
+                                                                                   export_private_key,
+                                                                                   private_key,
+                                                                                   public_key,
+                                                                                   public_key_length));
+    }
+    return (return_value);
+}
+#endif //OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED
+
+#ifdef OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
+optiga_lib_status_t optiga_crypt_ecdsa_sign_sync(optiga_crypt_t * me,
+                                                 const uint8_t * digest,
+                                                 uint8_t digest_length,
+                                                 optiga_key_id_t private_key,
+                                                 uint8_t * signature,
+                                                 uint16_t * signature_length)
+{
+    optiga_lib_status_t return_value = optiga_crypt_sync_begin(me);
+
+    if (OPTIGA_LIB_SUCCESS == return_value)
+    {
+        return_value = optiga_crypt_sync_end(me, optiga_crypt_ecdsa_sign(me,
+                                                                         digest,
+                                                                         digest_length,
+                                                                         private_key,
+                                                                         signature,
+                                                                         signature_length));
+    }
+    return (return_value);
+}
+#endif //OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
+
+#ifdef OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED
+optiga_lib_status_t optiga_crypt_ecdsa_verify_sync(optiga_crypt_t * me,
+                                                   const uint8_t * digest,
+                                                   uint8_t digest_length,
+                                                   const uint8_t * signature,
+                                                   uint16_t signature_length,
+                                                   uint8_t public_key_source_type,
+                                                   const void * public_key)
+{
+    optiga_lib_status_t return_value = optiga_crypt_sync_begin(me);
+
+    if (OPTIGA_LIB_SUCCESS == return_value)
+    {
+        return_value = optiga_crypt_sync_end(me, optiga_crypt_ecdsa_verify(me,
+                                                                           digest,
+                                                                           digest_length,
+                                                                           signature,
+                                                                           signature_length,
+                                                                           public_key_source_type,
+                                                                           public_key));
+    }
+    return (return_value);
+}
+#endif //OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED
+
+#ifdef OPTIGA_CRYPT_ECDH_ENABLED
+optiga_lib_status_t optiga_crypt_ecdh_sync(optiga_crypt_t * me,
+                                           optiga_key_id_t private_key,
+                                           public_key_from_host_t * public_key,
+                                           bool_t export_to_host,
+                                           uint8_t * shared_secret)
+{
+    optiga_lib_status_t return_value = optiga_crypt_sync_begin(me);
+
+    if (OPTIGA_LIB_SUCCESS == return_value)
+    {
+        return_value = optiga_crypt_sync_end(me, optiga_crypt_ecdh(me,
+                                                                   private_key,
+                                                                   public_key,
+                                                                   export_to_host,
+                                                                   shared_secret));
+    }
+    return (return_value);
+}
+#endif //OPTIGA_CRYPT_ECDH_ENABLED
+
+#ifdef OPTIGA_CRYPT_RSA_SIGN_ENABLED
+optiga_lib_status_t optiga_crypt_rsa_sign_sync(optiga_crypt_t * me,
+                                               optiga_rsa_signature_scheme_t signature_scheme,
+                                               const uint8_t * digest,
+                                               uint8_t digest_length,
+                                               optiga_key_id_t private_key,
+                                               uint8_t * signature,
+                                               uint16_t * signature_length,
+                                               uint16_t salt_length)
+{
+    optiga_lib_status_t return_value = optiga_crypt_sync_begin(me);
+
+    if (OPTIGA_LIB_SUCCESS == return_value)
+    {
+        return_value = optiga_crypt_sync_end(me, optiga_crypt_rsa_sign(me,
+                                                                       signature_scheme,
+                                                                       digest,
+                                                                       digest_length,
+                                                                       private_key,
+                                                                       signature,
+                                                                       signature_length,
+                                                                       salt_length));
+    }
+    return (return_value);
+}
+#endif //OPTIGA_CRYPT_RSA_SIGN_ENABLED
+
+#ifdef OPTIGA_CRYPT_RSA_VERIFY_ENABLED
+optiga_lib_status_t optiga_crypt_rsa_verify_sync(optiga_crypt_t * me,
+                                                 optiga_rsa_signature_scheme_t signature_scheme,
+                                                 const uint8_t * digest,
+                                                 uint8_t digest_length,
+                                                 const uint8_t * signature,
+                                                 uint16_t signature_length,
+                                                 uint8_t public_key_source_type,
+                                                 const void * public_key,
+                                                 uint16_t salt_length)
+{
+    optiga_lib_status_t return_value = optiga_crypt_sync_begin(me);
+
+    if (OPTIGA_LIB_SUCCESS == return_value)
+    {
+        return_value = optiga_crypt_sync_end(me, optiga_crypt_rsa_verify(me,
+                                                                         signature_scheme,
+                                                                         digest,
+                                                                         digest_length,
+                                                                         signature,
+                                                                         signature_length,
+                                                                         public_key_source_type,
+                                                                         public_key,
+                                                                         salt_length));
+    }
+    return (return_value);
+}
+#endif //OPTIGA_CRYPT_RSA_VERIFY_ENABLED
+
+#ifdef OPTIGA_CRYPT_HKDF_ENABLED
+optiga_lib_status_t optiga_crypt_hkdf_sync(optiga_crypt_t * me,
+                                           optiga_hkdf_type_t type,
+                                           uint16_t secret,
+                                           const uint8_t * salt,
+                                           uint16_t salt_length,
+                                           const uint8_t * info,
+                                           uint16_t info_length,
+                                           uint16_t derived_key_length,
+                                           bool_t export_to_host,
+                                           uint8_t * derived_key)
+{
+    optiga_lib_status_t return_value = optiga_crypt_sync_begin(me);
+
+    if (OPTIGA_LIB_SUCCESS == return_value)
+    {
+        return_value = optiga_crypt_sync_end(me, optiga_crypt_hkdf(me,
+                                                                   type,
+                                                                   secret,
+                                                                   salt,
+                                                                   salt_length,
+                                                                   info,
+                                                                   info_length,
+                                                                   derived_key_length,
+                                                                   export_to_host,
+                                                                   derived_key));
+    }
+    return (return_value);
+}
+#endif //OPTIGA_CRYPT_HKDF_ENABLED
+#endif //OPTIGA_LIB_SYNC_API_ENABLED
+
+#ifdef OPTIGA_CRYPT_OPERATION_QUEUE_ENABLED
+/*
+* Starts the operation of the handle using the service layer API, with the parameters held in the handle
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_operation_start(optiga_crypt_t * me,
+                                                           optiga_crypt_operation_t * p_operation)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+    me->p_params = &p_operation->params;
+    me->p_current_operation = p_operation;
+    switch (p_operation->type)
+    {
+#ifdef OPTIGA_CRYPT_RANDOM_ENABLED
+        case OPTIGA_CRYPT_OPERATION_RANDOM:
+        {
+            return_value = optiga_crypt_random(me,
+                                               p_operation->args.random.rng_type,
+                                               p_operation->args.random.random_data,
+                                               p_operation->args.random.random_data_length);
+        }
+        break;
+#endif //OPTIGA_CRYPT_RANDOM_ENABLED
+#ifdef OPTIGA_CRYPT_HASH_ENABLED
+        case OPTIGA_CRYPT_OPERATION_HASH:
+        {
+            return_value = optiga_crypt_hash(me,
+                                             p_operation->args.hash.hash_algorithm,
+                                             p_operation->args.hash.source_of_data_to_hash,
+                                             p_operation->args.hash.data_to_hash,
+                                             p_operation->args.hash.hash_output);
+        }
+        break;
+#endif //OPTIGA_CRYPT_HASH_ENABLED
+#ifdef OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
+        case OPTIGA_CRYPT_OPERATION_ECDSA_SIGN:
+        {
+            return_value = optiga_crypt_ecdsa_sign(me,
+                                                   p_operation->args.ecdsa_sign.digest,
+                                                   p_operation->args.ecdsa_sign.digest_length,
+                                                   p_operation->args.ecdsa_sign.private_key,
+                                                   p_operation->args.ecdsa_sign.signature,
+                                                   p_operation->args.ecdsa_sign.signature_length);
+        }
+        break;
+#endif //OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
+#ifdef OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED
+        case OPTIGA_CRYPT_OPERATION_ECDSA_VERIFY:
+        {
+            return_value = optiga_crypt_ecdsa_verify(me,
+                                                     p_operation->args.ecdsa_verify.digest,
+                                                     p_operation->args.ecdsa_verify.digest_length,
+                                                     p_operation->args.ecdsa_verify.signature,
+                                                     p_operation->args.ecdsa_verify.signature_length,
+                                                     p_operation->args.ecdsa_verify.public_key_source_type,
+                                                     p_operation->args.ecdsa_verify.public_key);
+        }
+        break;
+#endif //OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED
+#ifdef OPTIGA_CRYPT_ECDH_ENABLED
+        case OPTIGA_CRYPT_OPERATION_ECDH:
+        {
+            return_value = optiga_crypt_ecdh(me,
+                                             p_operation->args.ecdh.private_key,
+                                             p_operation->args.ecdh.public_key,
+                                             p_operation->args.ecdh.export_to_host,
+                                             p_operation->args.ecdh.shared_secret);
+        }
+        break;
+#endif //OPTIGA_CRYPT_ECDH_ENABLED
+        default:
+        break;
+    }
+    if (OPTIGA_LIB_SUCCESS != return_value)
+    {
+        pal_os_lock_enter_critical_section();
+        // Operation completed synchronously (offloaded to host) has already released the instance
+        if (p_operation == me->p_current_operation)
+        {
+            me->p_params = &me->params;
+            me->p_current_operation = NULL;
+        }
+        pal_os_lock_exit_critical_section();
+    }
+    return (return_value);
+}
+
+/*
+* Completes the ongoing operation of the handle and invokes the handler of the operation
+*/
+_STATIC_H void optiga_crypt_operation_complete(optiga_crypt_t * me, optiga_lib_status_t event)
+{
+    optiga_crypt_operation_t * p_operation = me->p_current_operation;
+
+    me->p_params = &me->params;
+    me->p_current_operation = NULL;
+    p_operation->handler(p_operation->caller_context, event);
+}
+
+/*
+* Starts the queued operations, until one is ongoing or the queue is empty
+*/
+_STATIC_H void optiga_crypt_operation_dequeue(optiga_crypt_t * me)
+{
+    optiga_crypt_operation_t * p_operation;
+    optiga_lib_status_t return_value;
+
+    do
+    {
+        pal_os_lock_enter_critical_section();
+        p_operation = me->p_queue_head;
+        // The handler might have started the next operation of the instance already
+        if ((NULL != p_operation) && (OPTIGA_LIB_INSTANCE_FREE == me->instance_state) &&
+            (NULL == me->p_current_operation))
+        {
+            me->p_queue_head = p_operation->p_next;
+            if (NULL == me->p_queue_head)
+            {
+                me->p_queue_tail = NULL;
+            }
+            me->queued_operations--;
+            me->p_current_operation = p_operation;
+        }
+        else
+        {
+            p_operation = NULL;
+        }
+        pal_os_lock_exit_critical_section();
+
+        if (NULL == p_operation)
+        {
+            break;
+        }
+        return_value = optiga_crypt_operation_start(me, p_operation);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            // The operation is completed with the error, the next queued operation is started
+            p_operation->handler(p_operation->caller_context, return_value);
+        }
+    } while (OPTIGA_LIB_SUCCESS != return_value);
+}
+
+/*
+* Starts the operation right away if the instance is free, else queues it
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_operation_submit(optiga_crypt_t * me,
+                                                            optiga_crypt_operation_t * p_operation,
+                                                            uint8_t type,
+                                                            callback_handler_t handler,
+                                                            void * caller_context)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    uint8_t start_now = FALSE;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == p_operation) || (NULL == handler))
+        {
+            break;
+        }
+#endif
+        p_operation->type = type;
+        p_operation->handler = handler;
+        p_operation->caller_context = caller_context;
+        p_operation->p_next = NULL;
+
+        return_value = OPTIGA_LIB_SUCCESS;
+        pal_os_lock_enter_critical_section();
+        if ((NULL == me->p_queue_head) && (OPTIGA_LIB_INSTANCE_FREE == me->instance_state) &&
+            (NULL == me->p_current_operation))
+        {
+            me->p_current_operation = p_operation;
+            start_now = TRUE;
+        }
+        else if (OPTIGA_CRYPT_OPERATION_QUEUE_SIZE <= me->queued_operations)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_MEMORY_INSUFFICIENT;
+        }
+        else
+        {
+            if (NULL == me->p_queue_tail)
+            {
+                me->p_queue_head = p_operation;
+            }
+            else
+            {
+                me->p_queue_tail->p_next = p_operation;
+            }
+            me->p_queue_tail = p_operation;
+            me->queued_operations++;
+        }
+        pal_os_lock_exit_critical_section();
+
+        if (TRUE == start_now)
+        {
+            return_value = optiga_crypt_operation_start(me, p_operation);
+        }
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_operation_random(optiga_crypt_t * me,
+                                                  optiga_crypt_operation_t * p_operation,
+                                                  optiga_rng_type_t rng_type,
+                                                  uint8_t * random_data,
+                                                  uint16_t random_data_length,
+                                                  callback_handler_t handler,
+                                                  void * caller_context)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+    if (NULL != p_operation)
+#endif
+    {
+        p_operation->args.random.rng_type = rng_type;
+        p_operation->args.random.random_data = random_data;
+        p_operation->args.random.random_data_length = random_data_length;
+        return_value = optiga_crypt_operation_submit(me, p_operation, OPTIGA_CRYPT_OPERATION_RANDOM,
+                                                     handler, caller_context);
+    }
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_operation_hash(optiga_crypt_t * me,
+                                                optiga_crypt_operation_t * p_operation,
+                                                optiga_hash_type_t hash_algorithm,
+                                                uint8_t source_of_data_to_hash,
+                                                const void * data_to_hash,
+                                                uint8_t * hash_output,
+                                                callback_handler_t handler,
+                                                void * caller_context)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+    if (NULL != p_operation)
+#endif
+    {
+        p_operation->args.hash.hash_algorithm = hash_algorithm;
+        p_operation->args.hash.source_of_data_to_hash = source_of_data_to_hash;
+        p_operation->args.hash.data_to_hash = data_to_hash;
+        p_operation->args.hash.hash_output = hash_output;
+        return_value = optiga_crypt_operation_submit(me, p_operation, OPTIGA_CRYPT_OPERATION_HASH,
+                                                     handler, caller_context);
+    }
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_operation_ecdsa_sign(optiga_crypt_t * me,
+                                                      optiga_crypt_operation_t * p_operation,
+                                                      const uint8_t * digest,
+                                                      uint8_t digest_length,
+                                                      optiga_key_id_t private_key,
+                                                      uint8_t * signature,
+                                                      uint16_t * signature_length,
+                                                      callback_handler_t handler,
+                                                      void * caller_context)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+    if (NULL != p_operation)
+#endif
+    {
+        p_operation->args.ecdsa_sign.digest = digest;
+        p_operation->args.ecdsa_sign.digest_length = digest_length;
+        p_operation->args.ecdsa_sign.private_key = private_key;
+        p_operation->args.ecdsa_sign.signature = signature;
+        p_operation->args.ecdsa_sign.signature_length = signature_length;
+        return_value = optiga_crypt_operation_submit(me, p_operation, OPTIGA_CRYPT_OPERATION_ECDSA_SIGN,
+                                                     handler, caller_context);
+    }
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_operation_ecdsa_verify(optiga_crypt_t * me,
+                                                        optiga_crypt_operation_t * p_operation,
+                                                        const uint8_t * digest,
+                                                        uint8_t digest_length,
+                                                        const uint8_t * signature,
+                                                        uint16_t signature_length,
+                                                        uint8_t public_key_source_type,
+                                                        const void * public_key,
+                                                        callback_handler_t handler,
+                                                        void * caller_context)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+    if (NULL != p_operation)
+#endif
+    {
+        p_operation->args.ecdsa_verify.digest = digest;
+        p_operation->args.ecdsa_verify.digest_length = digest_length;
+        p_operation->args.ecdsa_verify.signature = signature;
+        p_operation->args.ecdsa_verify.signature_length = signature_length;
+        p_operation->args.ecdsa_verify.public_key_source_type = public_key_source_type;
+        p_operation->args.ecdsa_verify.public_key = public_key;
+        return_value = optiga_crypt_operation_submit(me, p_operation, OPTIGA_CRYPT_OPERATION_ECDSA_VERIFY,
+                                                     handler, caller_context);
+    }
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_operation_ecdh(optiga_crypt_t * me,
+                                                optiga_crypt_operation_t * p_operation,
+                                                optiga_key_id_t private_key,
+                                                public_key_from_host_t * public_key,
+                                                bool_t export_to_host,
+                                                uint8_t * shared_secret,
+                                                callback_handler_t handler,
+                                                void * caller_context)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+    if (NULL != p_operation)
+#endif
+    {
+        p_operation->args.ecdh.private_key = private_key;
+        p_operation->args.ecdh.public_key = public_key;
+        p_operation->args.ecdh.export_to_host = export_to_host;
+        p_operation->args.ecdh.shared_secret = shared_secret;
+        return_value = optiga_crypt_operation_submit(me, p_operation, OPTIGA_CRYPT_OPERATION_ECDH,
+                                                     handler, caller_context);
+    }
+    return (return_value);
+}
+#endif //OPTIGA_CRYPT_OPERATION_QUEUE_ENABLED
+
 /**
 * @}
 */
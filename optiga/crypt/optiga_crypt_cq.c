@@ -0,0 +1,292 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_crypt_cq.c
+*
+* \brief   This file implements the OPTIGA Crypt completion queue, which reports the completion of crypt operations to an event loop.
+*
+* \ingroup  grOptigaCrypt
+*
+* @{
+*/
+
+#include "optiga/optiga_crypt_cq.h"
+#include "optiga/pal/pal_os_lock.h"
+#include "optiga/pal/pal_os_memory.h"
+
+#ifdef OPTIGA_CRYPT_CQ_ENABLED
+
+/// Invalid slot index, marks the end of the free list and the completed list
+#define OPTIGA_CRYPT_CQ_INVALID_INDEX                               (0xFF)
+
+/*
+* Event handler of the slots, queues the completion and signals the wait object
+*/
+_STATIC_H void optiga_crypt_cq_event_handler(void * p_ctx, optiga_lib_status_t event)
+{
+    optiga_crypt_cq_slot_t * p_slot = (optiga_crypt_cq_slot_t *)p_ctx;
+    optiga_crypt_cq_t * p_cq = (optiga_crypt_cq_t *)p_slot->p_cq;
+    uint8_t index = (uint8_t)(p_slot - p_cq->p_slots);
+
+    pal_os_lock_enter_critical_section();
+    p_slot->status = event;
+    p_slot->next_index = OPTIGA_CRYPT_CQ_INVALID_INDEX;
+    if (OPTIGA_CRYPT_CQ_INVALID_INDEX == p_cq->completed_tail)
+    {
+        p_cq->completed_head = index;
+    }
+    else
+    {
+        p_cq->p_slots[p_cq->completed_tail].next_index = index;
+    }
+    p_cq->completed_tail = index;
+    pal_os_lock_exit_critical_section();
+
+    pal_os_wait_signal(&p_cq->completion_wait);
+}
+
+/*
+* Returns the slot to free list, must be invoked in critical section
+*/
+_STATIC_H void optiga_crypt_cq_free_slot(optiga_crypt_cq_t * me, uint8_t index)
+{
+    me->p_slots[index].next_index = me->free_head;
+    me->free_head = index;
+    me->in_flight--;
+}
+
+optiga_lib_status_t optiga_crypt_cq_init(optiga_crypt_cq_t * me,
+                                         uint8_t optiga_instance_id,
+                                         optiga_crypt_cq_slot_t * p_slots,
+                                         uint8_t depth)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    uint8_t index;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == p_slots))
+        {
+            break;
+        }
+#endif
+        if ((0 == depth) || (OPTIGA_CRYPT_CQ_INVALID_INDEX == depth))
+        {
+            break;
+        }
+        pal_os_memset(me, 0, sizeof(optiga_crypt_cq_t));
+        pal_os_memset(p_slots, 0, (uint32_t)depth * sizeof(optiga_crypt_cq_slot_t));
+        me->p_slots = p_slots;
+        me->depth = depth;
+        me->free_head = 0;
+        me->completed_head = OPTIGA_CRYPT_CQ_INVALID_INDEX;
+        me->completed_tail = OPTIGA_CRYPT_CQ_INVALID_INDEX;
+
+        return_value = OPTIGA_CRYPT_ERROR;
+        if (PAL_STATUS_SUCCESS != pal_os_wait_create(&me->completion_wait))
+        {
+            break;
+        }
+
+        return_value = OPTIGA_CRYPT_SUCCESS;
+        for (index = 0; index < depth; index++)
+        {
+            p_slots[index].p_cq = me;
+            p_slots[index].next_index = ((depth - 1) == index) ? OPTIGA_CRYPT_CQ_INVALID_INDEX : (index + 1);
+            p_slots[index].p_crypt = optiga_crypt_create(optiga_instance_id,
+                                                         optiga_crypt_cq_event_handler,
+                                                         &p_slots[index]);
+            if (NULL == p_slots[index].p_crypt)
+            {
+                return_value = OPTIGA_CRYPT_ERROR;
+                break;
+            }
+        }
+        if (OPTIGA_CRYPT_SUCCESS != return_value)
+        {
+            //lint --e{534} suppress "No operation is in flight, return value is not required to be checked"
+            optiga_crypt_cq_deinit(me);
+        }
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_cq_deinit(optiga_crypt_cq_t * me)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    uint8_t index;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        if (0 != me->in_flight)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        for (index = 0; index < me->depth; index++)
+        {
+            if (NULL != me->p_slots[index].p_crypt)
+            {
+                //lint --e{534} suppress "Instance is free, return value is not required to be checked"
+                optiga_crypt_destroy(me->p_slots[index].p_crypt);
+                me->p_slots[index].p_crypt = NULL;
+            }
+        }
+        pal_os_wait_destroy(&me->completion_wait);
+        me->depth = 0;
+        return_value = OPTIGA_CRYPT_SUCCESS;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_crypt_t * optiga_crypt_cq_acquire(optiga_crypt_cq_t * me,
+                                         void * user_tag)
+{
+    optiga_crypt_t * p_crypt = NULL;
+    optiga_crypt_cq_slot_t * p_slot;
+
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+    if (NULL != me)
+#endif
+    {
+        pal_os_lock_enter_critical_section();
+        if (OPTIGA_CRYPT_CQ_INVALID_INDEX != me->free_head)
+        {
+            p_slot = &me->p_slots[me->free_head];
+            me->free_head = p_slot->next_index;
+            me->in_flight++;
+            p_slot->user_tag = user_tag;
+            p_crypt = p_slot->p_crypt;
+        }
+        pal_os_lock_exit_critical_section();
+    }
+    return (p_crypt);
+}
+
+void optiga_crypt_cq_cancel(optiga_crypt_cq_t * me,
+                            const optiga_crypt_t * p_crypt)
+{
+    const optiga_crypt_cq_slot_t * p_slot;
+
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+    if ((NULL != me) && (NULL != p_crypt))
+#endif
+    {
+        p_slot = (const optiga_crypt_cq_slot_t *)p_crypt->caller_context;
+        // Only the instances of this completion queue are accepted
+        if (me == p_slot->p_cq)
+        {
+            pal_os_lock_enter_critical_section();
+            optiga_crypt_cq_free_slot(me, (uint8_t)(p_slot - me->p_slots));
+            pal_os_lock_exit_critical_section();
+        }
+    }
+}
+
+int32_t optiga_crypt_cq_get_descriptor(const optiga_crypt_cq_t * me)
+{
+    return (pal_os_wait_get_descriptor(&me->completion_wait));
+}
+
+void optiga_crypt_cq_wait(optiga_crypt_cq_t * me)
+{
+    uint8_t completed_head;
+
+    pal_os_lock_enter_critical_section();
+    completed_head = me->completed_head;
+    pal_os_lock_exit_critical_section();
+
+    // Completions which are left after reaping, are available without waiting
+    if (OPTIGA_CRYPT_CQ_INVALID_INDEX == completed_head)
+    {
+        pal_os_wait_for_signal(&me->completion_wait);
+    }
+}
+
+uint8_t optiga_crypt_cq_reap(optiga_crypt_cq_t * me,
+                             optiga_crypt_cq_completion_t * p_completions,
+                             uint8_t max_completions)
+{
+    uint8_t count = 0;
+    uint8_t index;
+    bool_t completions_left = FALSE;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == p_completions))
+        {
+            break;
+        }
+#endif
+        // Cleared before the list is read, so that a later completion signals again
+        (void)pal_os_wait_clear_signal(&me->completion_wait);
+
+        pal_os_lock_enter_critical_section();
+        while ((count < max_completions) && (OPTIGA_CRYPT_CQ_INVALID_INDEX != me->completed_head))
+        {
+            index = me->completed_head;
+            me->completed_head = me->p_slots[index].next_index;
+            p_completions[count].user_tag = me->p_slots[index].user_tag;
+            p_completions[count].status = me->p_slots[index].status;
+            count++;
+            optiga_crypt_cq_free_slot(me, index);
+        }
+        if (OPTIGA_CRYPT_CQ_INVALID_INDEX == me->completed_head)
+        {
+            me->completed_tail = OPTIGA_CRYPT_CQ_INVALID_INDEX;
+        }
+        else
+        {
+            completions_left = TRUE;
+        }
+        pal_os_lock_exit_critical_section();
+
+        if (TRUE == completions_left)
+        {
+            pal_os_wait_signal(&me->completion_wait);
+        }
+    } while (FALSE);
+
+    return (count);
+}
+
+#endif //OPTIGA_CRYPT_CQ_ENABLED
+
+/**
+* @}
+*/
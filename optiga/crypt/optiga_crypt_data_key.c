@@ -0,0 +1,343 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_crypt_data_key.c
+*
+* \brief   This file implements the OPTIGA Crypt data keys, which are derived by OPTIGA once per object and cached on host for the bulk encryption.
+*
+* \ingroup  grOptigaCrypt
+*
+* @{
+*/
+
+#include "optiga/optiga_crypt_data_key.h"
+#include "optiga/common/optiga_lib_common_internal.h"
+#include "optiga/pal/pal_os_lock.h"
+#include "optiga/pal/pal_os_memory.h"
+#include "optiga/pal/pal_os_timer.h"
+
+#ifdef OPTIGA_CRYPT_DATA_KEY_ENABLED
+
+/// Label of the HKDF info, followed by the identifier of the object
+#define OPTIGA_CRYPT_DATA_KEY_LABEL             "OPTIGA data key"
+/// Length of the label, without the terminating zero
+#define OPTIGA_CRYPT_DATA_KEY_LABEL_LENGTH      (sizeof(OPTIGA_CRYPT_DATA_KEY_LABEL) - 1U)
+/// Length of the nonce of AES CCM
+#define OPTIGA_CRYPT_DATA_KEY_MIN_NONCE_LENGTH  (7)
+#define OPTIGA_CRYPT_DATA_KEY_MAX_NONCE_LENGTH  (13)
+
+/*
+* Event handler of the crypt instance, not invoked since the data keys are derived using the synchronous API
+*/
+//lint --e{715} suppress "The parameters are not used"
+_STATIC_H void optiga_crypt_data_key_event_handler(void * p_ctx, optiga_lib_status_t event)
+{
+    (void)p_ctx;
+    (void)event;
+}
+
+/*
+* Provides the data key of the object from the cache or derives it by OPTIGA
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_data_key_get(optiga_crypt_data_key_t * me,
+                                                        const uint8_t * object_id,
+                                                        uint8_t object_id_length,
+                                                        uint8_t * key)
+{
+    optiga_lib_status_t return_value = OPTIGA_LIB_SUCCESS;
+    optiga_crypt_data_key_entry_t * p_entry;
+    optiga_crypt_data_key_entry_t * p_victim = NULL;
+    uint8_t info[OPTIGA_CRYPT_DATA_KEY_LABEL_LENGTH + OPTIGA_CRYPT_DATA_KEY_MAX_ID_LENGTH];
+    uint32_t now = pal_os_timer_get_time_in_milliseconds();
+    uint8_t found = FALSE;
+    uint8_t index;
+
+    do
+    {
+        pal_os_lock_enter_critical_section();
+        for (index = 0; index < OPTIGA_CRYPT_DATA_KEY_CACHE_SIZE; index++)
+        {
+            p_entry = &me->cache[index];
+            // Expired keys are erased, not only ignored
+            if ((TRUE == p_entry->valid) && ((now - p_entry->derivation_time) >= OPTIGA_CRYPT_DATA_KEY_TTL))
+            {
+                pal_os_memset(p_entry, 0, sizeof(optiga_crypt_data_key_entry_t));
+            }
+            if ((TRUE == p_entry->valid) && (object_id_length == p_entry->object_id_length) &&
+                (0 == memcmp(object_id, p_entry->object_id, object_id_length)))
+            {
+                pal_os_memcpy(key, p_entry->key, PAL_CRYPT_AES128_KEY_LENGTH);
+                me->hits++;
+                found = TRUE;
+                break;
+            }
+            // A free entry, otherwise the key derived first is replaced
+            if ((NULL == p_victim) || ((TRUE == p_victim->valid) && ((FALSE == p_entry->valid) ||
+                ((now - p_entry->derivation_time) > (now - p_victim->derivation_time)))))
+            {
+                p_victim = p_entry;
+            }
+        }
+        if ((FALSE == found) && (TRUE == me->deriving))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+        }
+        else if (FALSE == found)
+        {
+            me->deriving = TRUE;
+        }
+        else
+        {
+            // Served from the cache
+        }
+        pal_os_lock_exit_critical_section();
+
+        if ((TRUE == found) || (OPTIGA_LIB_SUCCESS != return_value))
+        {
+            break;
+        }
+
+        pal_os_memcpy(info, OPTIGA_CRYPT_DATA_KEY_LABEL, OPTIGA_CRYPT_DATA_KEY_LABEL_LENGTH);
+        pal_os_memcpy(&info[OPTIGA_CRYPT_DATA_KEY_LABEL_LENGTH], object_id, object_id_length);
+        return_value = optiga_crypt_hkdf_sync(me->p_crypt,
+                                              OPTIGA_HKDF_SHA_256,
+                                              me->secret_oid,
+                                              NULL,
+                                              0,
+                                              info,
+                                              (uint16_t)(OPTIGA_CRYPT_DATA_KEY_LABEL_LENGTH + object_id_length),
+                                              PAL_CRYPT_AES128_KEY_LENGTH,
+                                              TRUE,
+                                              key);
+
+        // Only one key is derived at a time, hence the victim is not taken by another caller
+        pal_os_lock_enter_critical_section();
+        if (OPTIGA_LIB_SUCCESS == return_value)
+        {
+            pal_os_memcpy(p_victim->object_id, object_id, object_id_length);
+            pal_os_memcpy(p_victim->key, key, PAL_CRYPT_AES128_KEY_LENGTH);
+            p_victim->object_id_length = object_id_length;
+            p_victim->derivation_time = now;
+            p_victim->valid = TRUE;
+            me->derivations++;
+        }
+        me->deriving = FALSE;
+        pal_os_lock_exit_critical_section();
+    } while (FALSE);
+
+    return (return_value);
+}
+
+/*
+* Encrypts or decrypts the data on host with the data key of the object
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_data_key_crypt(optiga_crypt_data_key_t * me,
+                                                          uint8_t decrypt,
+                                                          const uint8_t * object_id,
+                                                          uint8_t object_id_length,
+                                                          const uint8_t * nonce,
+                                                          uint8_t nonce_length,
+                                                          const uint8_t * associated_data,
+                                                          uint16_t associated_data_length,
+                                                          const uint8_t * p_input,
+                                                          uint16_t input_length,
+                                                          uint8_t * p_output)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    pal_status_t pal_return_value;
+    uint8_t key[PAL_CRYPT_AES128_KEY_LENGTH];
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->p_crypt))
+        {
+            break;
+        }
+#endif
+        if ((NULL == object_id) || (0 == object_id_length) || (object_id_length > OPTIGA_CRYPT_DATA_KEY_MAX_ID_LENGTH) ||
+            (NULL == nonce) || (nonce_length < OPTIGA_CRYPT_DATA_KEY_MIN_NONCE_LENGTH) ||
+            (nonce_length > OPTIGA_CRYPT_DATA_KEY_MAX_NONCE_LENGTH) ||
+            ((NULL == associated_data) && (0 != associated_data_length)) ||
+            (NULL == p_input) || (NULL == p_output) ||
+            ((TRUE == decrypt) && (input_length < OPTIGA_CRYPT_DATA_KEY_TAG_LENGTH)))
+        {
+            break;
+        }
+
+        return_value = optiga_crypt_data_key_get(me, object_id, object_id_length, key);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            break;
+        }
+        // The pal crypt library expects a valid pointer, even without associated data
+        if (NULL == associated_data)
+        {
+            associated_data = nonce;
+        }
+        if (FALSE == decrypt)
+        {
+            pal_return_value = pal_crypt_encrypt_aes128_ccm(NULL, p_input, input_length, key,
+                                                            nonce, nonce_length,
+                                                            associated_data, associated_data_length,
+                                                            OPTIGA_CRYPT_DATA_KEY_TAG_LENGTH, p_output);
+        }
+        else
+        {
+            pal_return_value = pal_crypt_decrypt_aes128_ccm(NULL, p_input, input_length, key,
+                                                            nonce, nonce_length,
+                                                            associated_data, associated_data_length,
+                                                            OPTIGA_CRYPT_DATA_KEY_TAG_LENGTH, p_output);
+        }
+        return_value = (PAL_STATUS_SUCCESS == pal_return_value) ? OPTIGA_LIB_SUCCESS : OPTIGA_CRYPT_ERROR;
+    } while (FALSE);
+
+    pal_os_memset(key, 0, sizeof(key));
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_data_key_init(optiga_crypt_data_key_t * me,
+                                               uint8_t optiga_instance_id,
+                                               uint16_t secret_oid)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        pal_os_memset(me, 0, sizeof(optiga_crypt_data_key_t));
+        me->secret_oid = secret_oid;
+
+        return_value = OPTIGA_CRYPT_ERROR;
+#ifdef OPTIGA_CRYPT_DATA_KEY_LOCKED_MEMORY_ENABLED
+        if (PAL_STATUS_SUCCESS != pal_os_memory_lock(me->cache, sizeof(me->cache)))
+        {
+            break;
+        }
+#endif
+        me->p_crypt = optiga_crypt_create(optiga_instance_id, optiga_crypt_data_key_event_handler, me);
+        if (NULL == me->p_crypt)
+        {
+#ifdef OPTIGA_CRYPT_DATA_KEY_LOCKED_MEMORY_ENABLED
+            pal_os_memory_unlock(me->cache, sizeof(me->cache));
+#endif
+            break;
+        }
+        return_value = OPTIGA_CRYPT_SUCCESS;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_data_key_deinit(optiga_crypt_data_key_t * me)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        if (TRUE == me->deriving)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        if (NULL != me->p_crypt)
+        {
+            //lint --e{534} suppress "Instance is free, return value is not required to be checked"
+            optiga_crypt_destroy(me->p_crypt);
+        }
+        // The keys are erased before the memory is unlocked
+        pal_os_memset(me, 0, sizeof(optiga_crypt_data_key_t));
+#ifdef OPTIGA_CRYPT_DATA_KEY_LOCKED_MEMORY_ENABLED
+        pal_os_memory_unlock(me->cache, sizeof(me->cache));
+#endif
+        return_value = OPTIGA_CRYPT_SUCCESS;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+void optiga_crypt_data_key_flush(optiga_crypt_data_key_t * me)
+{
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+    if (NULL != me)
+#endif
+    {
+        pal_os_lock_enter_critical_section();
+        pal_os_memset(me->cache, 0, sizeof(me->cache));
+        pal_os_lock_exit_critical_section();
+    }
+}
+
+optiga_lib_status_t optiga_crypt_data_key_encrypt(optiga_crypt_data_key_t * me,
+                                                  const uint8_t * object_id,
+                                                  uint8_t object_id_length,
+                                                  const uint8_t * nonce,
+                                                  uint8_t nonce_length,
+                                                  const uint8_t * associated_data,
+                                                  uint16_t associated_data_length,
+                                                  const uint8_t * plain_data,
+                                                  uint16_t plain_data_length,
+                                                  uint8_t * encrypted_data)
+{
+    return (optiga_crypt_data_key_crypt(me, FALSE, object_id, object_id_length, nonce, nonce_length,
+                                        associated_data, associated_data_length,
+                                        plain_data, plain_data_length, encrypted_data));
+}
+
+optiga_lib_status_t optiga_crypt_data_key_decrypt(optiga_crypt_data_key_t * me,
+                                                  const uint8_t * object_id,
+                                                  uint8_t object_id_length,
+                                                  const uint8_t * nonce,
+                                                  uint8_t nonce_length,
+                                                  const uint8_t * associated_data,
+                                                  uint16_t associated_data_length,
+                                                  const uint8_t * encrypted_data,
+                                                  uint16_t encrypted_data_length,
+                                                  uint8_t * plain_data)
+{
+    return (optiga_crypt_data_key_crypt(me, TRUE, object_id, object_id_length, nonce, nonce_length,
+                                        associated_data, associated_data_length,
+                                        encrypted_data, encrypted_data_length, plain_data));
+}
+
+#endif //OPTIGA_CRYPT_DATA_KEY_ENABLED
+
+/**
+* @}
+*/
@@ -0,0 +1,483 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_crypt_dispatcher.c
+*
+* \brief   This file implements the OPTIGA Crypt dispatcher, which spreads crypt operations across OPTIGA instances.
+*
+* \ingroup  grOptigaCrypt
+*
+* @{
+*/
+
+#include "optiga/optiga_crypt_dispatcher.h"
+#include "optiga/pal/pal_os_lock.h"
+#include "optiga/pal/pal_os_timer.h"
+#include "optiga/pal/pal_os_memory.h"
+
+#ifdef OPTIGA_CRYPT_DISPATCHER_ENABLED
+
+/// OPTIGA instance is not bound for a key
+#define OPTIGA_CRYPT_DISPATCHER_NO_AFFINITY                         (0xFF)
+/// Key OID is not applicable for the operation
+#define OPTIGA_CRYPT_DISPATCHER_NO_KEY                              (0x0000)
+
+/*
+* Event handler of the lanes, updates the utilisation counters and notifies the caller
+*/
+_STATIC_H void optiga_crypt_dispatcher_event_handler(void * p_ctx, optiga_lib_status_t event)
+{
+    optiga_crypt_dispatcher_lane_t * p_lane = (optiga_crypt_dispatcher_lane_t *)p_ctx;
+    optiga_crypt_dispatcher_stats_t * p_stats;
+    callback_handler_t handler;
+    void * caller_context;
+
+    pal_os_lock_enter_critical_section();
+    p_stats = &((optiga_crypt_dispatcher_t *)p_lane->p_dispatcher)->stats[p_lane->optiga_instance_id];
+    p_stats->busy_time_us += (pal_os_timer_get_time_in_microseconds() - p_lane->start_time);
+    p_stats->completed_operations++;
+    if (OPTIGA_LIB_SUCCESS != event)
+    {
+        p_stats->failed_operations++;
+    }
+    p_stats->in_flight--;
+    handler = p_lane->handler;
+    caller_context = p_lane->caller_context;
+    p_lane->in_flight = FALSE;
+    pal_os_lock_exit_critical_section();
+
+    handler(caller_context, event);
+}
+
+/*
+* Returns the OPTIGA instance bound to the key, OPTIGA_CRYPT_DISPATCHER_NO_AFFINITY if not bound
+*/
+_STATIC_H uint8_t optiga_crypt_dispatcher_get_key_affinity(const optiga_crypt_dispatcher_t * me, uint16_t key_oid)
+{
+    uint8_t index;
+    uint8_t optiga_instance_id = OPTIGA_CRYPT_DISPATCHER_NO_AFFINITY;
+
+    for (index = 0; index < me->key_affinity_count; index++)
+    {
+        if (key_oid == me->key_affinity[index].key_oid)
+        {
+            optiga_instance_id = me->key_affinity[index].optiga_instance_id;
+            break;
+        }
+    }
+    return (optiga_instance_id);
+}
+
+/*
+* Returns the estimated time (in microseconds) till the operations in flight of an OPTIGA instance are completed.
+* Estimation is based on the average time of completed operations and the time elapsed for the operations in flight.
+*/
+_STATIC_H uint32_t optiga_crypt_dispatcher_get_pending_time(const optiga_crypt_dispatcher_t * me,
+                                                            uint8_t optiga_instance_id,
+                                                            uint32_t current_time)
+{
+    const optiga_crypt_dispatcher_stats_t * p_stats = &me->stats[optiga_instance_id];
+    uint32_t average_time = 0;
+    uint32_t expected_time;
+    uint32_t elapsed_time = 0;
+    uint8_t index;
+
+    if (0 != p_stats->completed_operations)
+    {
+        average_time = p_stats->busy_time_us / p_stats->completed_operations;
+    }
+    expected_time = average_time * p_stats->in_flight;
+
+    for (index = 0; index < OPTIGA_CRYPT_DISPATCHER_MAX_LANES; index++)
+    {
+        if ((TRUE == me->lanes[index].in_flight) && (optiga_instance_id == me->lanes[index].optiga_instance_id))
+        {
+            elapsed_time += (current_time - me->lanes[index].start_time);
+        }
+    }
+    return ((expected_time > elapsed_time) ? (expected_time - elapsed_time) : 0);
+}
+
+/*
+* Selects a free lane of the least busy OPTIGA instance (which holds the key) and marks it as in flight.
+* Least busy is the OPTIGA instance with the lowest estimated pending time, and then the lowest queue depth.
+*/
+_STATIC_H optiga_crypt_dispatcher_lane_t * optiga_crypt_dispatcher_acquire_lane(optiga_crypt_dispatcher_t * me,
+                                                                                uint16_t key_oid,
+                                                                                callback_handler_t handler,
+                                                                                void * caller_context)
+{
+    optiga_crypt_dispatcher_lane_t * p_lane = NULL;
+    optiga_crypt_dispatcher_lane_t * p_instance_lane;
+    uint32_t current_time = pal_os_timer_get_time_in_microseconds();
+    uint32_t pending_time;
+    uint32_t prefered_pending_time = 0;
+    uint8_t affinity;
+    uint8_t instance_index;
+    uint8_t lane_index;
+
+    pal_os_lock_enter_critical_section();
+    affinity = optiga_crypt_dispatcher_get_key_affinity(me, key_oid);
+    for (instance_index = 0; instance_index < OPTIGA_MAX_NUMBER_OF_INSTANCES; instance_index++)
+    {
+        if ((OPTIGA_CRYPT_DISPATCHER_NO_AFFINITY != affinity) && (affinity != instance_index))
+        {
+            continue;
+        }
+        // Look for a free lane of the OPTIGA instance
+        p_instance_lane = NULL;
+        for (lane_index = 0; lane_index < OPTIGA_CRYPT_DISPATCHER_LANES_PER_INSTANCE; lane_index++)
+        {
+            if (FALSE == me->lanes[(instance_index * OPTIGA_CRYPT_DISPATCHER_LANES_PER_INSTANCE) + lane_index].in_flight)
+            {
+                p_instance_lane = &me->lanes[(instance_index * OPTIGA_CRYPT_DISPATCHER_LANES_PER_INSTANCE) + lane_index];
+                break;
+            }
+        }
+        if (NULL == p_instance_lane)
+        {
+            continue;
+        }
+        pending_time = optiga_crypt_dispatcher_get_pending_time(me, instance_index, current_time);
+        if ((NULL == p_lane) ||
+            (pending_time < prefered_pending_time) ||
+            ((pending_time == prefered_pending_time) &&
+             (me->stats[instance_index].in_flight < me->stats[p_lane->optiga_instance_id].in_flight)))
+        {
+            p_lane = p_instance_lane;
+            prefered_pending_time = pending_time;
+        }
+    }
+
+    if (NULL != p_lane)
+    {
+        p_lane->in_flight = TRUE;
+        p_lane->start_time = current_time;
+        p_lane->handler = handler;
+        p_lane->caller_context = caller_context;
+        me->stats[p_lane->optiga_instance_id].in_flight++;
+    }
+    pal_os_lock_exit_critical_section();
+    return (p_lane);
+}
+
+/*
+* Updates the lane based on status of the dispatched operation
+*/
+_STATIC_H void optiga_crypt_dispatcher_update_lane(optiga_crypt_dispatcher_t * me,
+                                                   optiga_crypt_dispatcher_lane_t * p_lane,
+                                                   optiga_lib_status_t return_value)
+{
+    pal_os_lock_enter_critical_section();
+    if (OPTIGA_LIB_SUCCESS == return_value)
+    {
+        me->stats[p_lane->optiga_instance_id].dispatched_operations++;
+    }
+    else if (TRUE == p_lane->in_flight)
+    {
+        // Operation is not started, lane is free again
+        me->stats[p_lane->optiga_instance_id].in_flight--;
+        p_lane->in_flight = FALSE;
+    }
+    else
+    {
+        //nothing to be done, if operation is already completed
+    }
+    pal_os_lock_exit_critical_section();
+}
+
+optiga_lib_status_t optiga_crypt_dispatcher_init(optiga_crypt_dispatcher_t * me)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    uint8_t index;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        pal_os_memset(me, 0, sizeof(optiga_crypt_dispatcher_t));
+        return_value = OPTIGA_CRYPT_SUCCESS;
+        for (index = 0; index < OPTIGA_CRYPT_DISPATCHER_MAX_LANES; index++)
+        {
+            me->lanes[index].p_dispatcher = me;
+            me->lanes[index].optiga_instance_id = index / OPTIGA_CRYPT_DISPATCHER_LANES_PER_INSTANCE;
+            me->lanes[index].p_crypt = optiga_crypt_create(me->lanes[index].optiga_instance_id,
+                                                           optiga_crypt_dispatcher_event_handler,
+                                                           &me->lanes[index]);
+            if (NULL == me->lanes[index].p_crypt)
+            {
+                return_value = OPTIGA_CRYPT_ERROR;
+                break;
+            }
+        }
+        if (OPTIGA_CRYPT_SUCCESS != return_value)
+        {
+            //lint --e{534} suppress "No operation is in flight, return value is not required to be checked"
+            optiga_crypt_dispatcher_deinit(me);
+        }
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_dispatcher_deinit(optiga_crypt_dispatcher_t * me)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    uint8_t index;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        for (index = 0; index < OPTIGA_MAX_NUMBER_OF_INSTANCES; index++)
+        {
+            if (0 != me->stats[index].in_flight)
+            {
+                break;
+            }
+        }
+        if (OPTIGA_MAX_NUMBER_OF_INSTANCES != index)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        for (index = 0; index < OPTIGA_CRYPT_DISPATCHER_MAX_LANES; index++)
+        {
+            if (NULL != me->lanes[index].p_crypt)
+            {
+                //lint --e{534} suppress "Instance is free, return value is not required to be checked"
+                optiga_crypt_destroy(me->lanes[index].p_crypt);
+                me->lanes[index].p_crypt = NULL;
+            }
+        }
+        return_value = OPTIGA_CRYPT_SUCCESS;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_dispatcher_set_key_affinity(optiga_crypt_dispatcher_t * me,
+                                                             uint16_t key_oid,
+                                                             uint8_t optiga_instance_id)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    uint8_t index;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_MAX_NUMBER_OF_INSTANCES <= optiga_instance_id)
+        {
+            break;
+        }
+        pal_os_lock_enter_critical_section();
+        for (index = 0; index < me->key_affinity_count; index++)
+        {
+            if (key_oid == me->key_affinity[index].key_oid)
+            {
+                break;
+            }
+        }
+        if (OPTIGA_CRYPT_DISPATCHER_MAX_KEY_AFFINITY == index)
+        {
+            return_value = OPTIGA_CRYPT_ERROR;
+        }
+        else
+        {
+            me->key_affinity[index].key_oid = key_oid;
+            me->key_affinity[index].optiga_instance_id = optiga_instance_id;
+            if (me->key_affinity_count == index)
+            {
+                me->key_affinity_count++;
+            }
+            return_value = OPTIGA_CRYPT_SUCCESS;
+        }
+        pal_os_lock_exit_critical_section();
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_dispatcher_get_stats(const optiga_crypt_dispatcher_t * me,
+                                                      uint8_t optiga_instance_id,
+                                                      optiga_crypt_dispatcher_stats_t * p_stats)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == p_stats))
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_MAX_NUMBER_OF_INSTANCES <= optiga_instance_id)
+        {
+            break;
+        }
+        pal_os_lock_enter_critical_section();
+        pal_os_memcpy(p_stats, &me->stats[optiga_instance_id], sizeof(optiga_crypt_dispatcher_stats_t));
+        pal_os_lock_exit_critical_section();
+        return_value = OPTIGA_CRYPT_SUCCESS;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+#ifdef OPTIGA_CRYPT_RANDOM_ENABLED
+optiga_lib_status_t optiga_crypt_dispatcher_random(optiga_crypt_dispatcher_t * me,
+                                                   optiga_rng_type_t rng_type,
+                                                   uint8_t * random_data,
+                                                   uint16_t random_data_length,
+                                                   callback_handler_t handler,
+                                                   void * caller_context)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    optiga_crypt_dispatcher_lane_t * p_lane;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == handler))
+        {
+            break;
+        }
+#endif
+        p_lane = optiga_crypt_dispatcher_acquire_lane(me, OPTIGA_CRYPT_DISPATCHER_NO_KEY, handler, caller_context);
+        if (NULL == p_lane)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        return_value = optiga_crypt_random(p_lane->p_crypt, rng_type, random_data, random_data_length);
+        optiga_crypt_dispatcher_update_lane(me, p_lane, return_value);
+    } while (FALSE);
+
+    return (return_value);
+}
+#endif //OPTIGA_CRYPT_RANDOM_ENABLED
+
+#ifdef OPTIGA_CRYPT_HASH_ENABLED
+optiga_lib_status_t optiga_crypt_dispatcher_hash(optiga_crypt_dispatcher_t * me,
+                                                 optiga_hash_type_t hash_algorithm,
+                                                 uint8_t source_of_data_to_hash,
+                                                 const void * data_to_hash,
+                                                 uint8_t * hash_output,
+                                                 callback_handler_t handler,
+                                                 void * caller_context)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    optiga_crypt_dispatcher_lane_t * p_lane;
+    uint16_t key_oid = OPTIGA_CRYPT_DISPATCHER_NO_KEY;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == handler) || (NULL == data_to_hash))
+        {
+            break;
+        }
+#endif
+        // Data in OPTIGA is available only in the OPTIGA instance bound to the OID
+        if (OPTIGA_CRYPT_OID_DATA == source_of_data_to_hash)
+        {
+            key_oid = ((const hash_data_in_optiga_t *)data_to_hash)->oid;
+        }
+        p_lane = optiga_crypt_dispatcher_acquire_lane(me, key_oid, handler, caller_context);
+        if (NULL == p_lane)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        return_value = optiga_crypt_hash(p_lane->p_crypt, hash_algorithm, source_of_data_to_hash, data_to_hash, hash_output);
+        optiga_crypt_dispatcher_update_lane(me, p_lane, return_value);
+    } while (FALSE);
+
+    return (return_value);
+}
+#endif //OPTIGA_CRYPT_HASH_ENABLED
+
+#ifdef OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
+optiga_lib_status_t optiga_crypt_dispatcher_ecdsa_sign(optiga_crypt_dispatcher_t * me,
+                                                       const uint8_t * digest,
+                                                       uint8_t digest_length,
+                                                       optiga_key_id_t private_key,
+                                                       uint8_t * signature,
+                                                       uint16_t * signature_length,
+                                                       callback_handler_t handler,
+                                                       void * caller_context)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    optiga_crypt_dispatcher_lane_t * p_lane;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == handler))
+        {
+            break;
+        }
+#endif
+        // Session of a crypt instance is not visible to the caller
+        if (OPTIGA_KEY_ID_SESSION_BASED == private_key)
+        {
+            break;
+        }
+        p_lane = optiga_crypt_dispatcher_acquire_lane(me, (uint16_t)private_key, handler, caller_context);
+        if (NULL == p_lane)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        return_value = optiga_crypt_ecdsa_sign(p_lane->p_crypt, digest, digest_length, private_key, signature, signature_length);
+        optiga_crypt_dispatcher_update_lane(me, p_lane, return_value);
+    } while (FALSE);
+
+    return (return_value);
+}
+#endif //OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
+
+#endif //OPTIGA_CRYPT_DISPATCHER_ENABLED
+
+/**
+* @}
+*/
@@ -0,0 +1,458 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_crypt_hash_mux.c
+*
+* \brief   This file implements the OPTIGA Crypt hash multiplexer, which runs several hash sequences over one crypt instance.
+*
+* \ingroup  grOptigaCrypt
+*
+* @{
+*/
+
+#include "optiga/optiga_crypt_hash_mux.h"
+#include "optiga/pal/pal_os_lock.h"
+#include "optiga/pal/pal_os_memory.h"
+
+#ifdef OPTIGA_CRYPT_HASH_MUX_ENABLED
+
+/// No step is pending, once the ongoing command is completed
+#define OPTIGA_CRYPT_HASH_MUX_STEP_NONE             (0x00)
+/// Remaining data of the caller is taken, once the ongoing command is completed
+#define OPTIGA_CRYPT_HASH_MUX_STEP_REMAINING        (0x01)
+/// Sequence is finalized, once the ongoing command is completed
+#define OPTIGA_CRYPT_HASH_MUX_STEP_FINALIZE         (0x02)
+
+/*
+* Completes the operation, releases the sequence if required and invokes the callback of the caller
+*/
+_STATIC_H void optiga_crypt_hash_mux_complete(optiga_crypt_hash_mux_t * me, optiga_lib_status_t status)
+{
+    // The context of a failed sequence is not known anymore, hence the sequence can't be continued
+    if ((OPTIGA_LIB_SUCCESS != status) || (TRUE == me->finalizing))
+    {
+        pal_os_memset(&me->sequence[me->current], 0, sizeof(optiga_crypt_hash_mux_sequence_t));
+    }
+    me->next_step = OPTIGA_CRYPT_HASH_MUX_STEP_NONE;
+    me->finalizing = FALSE;
+    me->ongoing = FALSE;
+    if (NULL != me->caller_handler)
+    {
+        me->caller_handler(me->caller_context, status);
+    }
+}
+
+/*
+* Selects the crypt library on host or OPTIGA for the operation of the sequence
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_hash_mux_select(const optiga_crypt_hash_mux_t * me,
+                                                           const optiga_crypt_hash_mux_sequence_t * p_sequence)
+{
+#ifdef OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED
+    return (optiga_crypt_set_hash_offload(me->p_crypt, (bool_t)p_sequence->on_host));
+#else
+    (void)me;
+    return ((TRUE == p_sequence->on_host) ? OPTIGA_CRYPT_ERROR_INVALID_INPUT : OPTIGA_LIB_SUCCESS);
+#endif //OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED
+}
+
+/*
+* Sends the data as an update of the sequence
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_hash_mux_send(optiga_crypt_hash_mux_t * me,
+                                                         const optiga_crypt_hash_mux_sequence_t * p_sequence,
+                                                         const uint8_t * p_data,
+                                                         uint32_t length)
+{
+    me->update_data.buffer = p_data;
+    me->update_data.length = length;
+    return (optiga_crypt_hash_update(me->p_crypt, p_sequence->p_hash_ctx, OPTIGA_CRYPT_HOST_DATA, &me->update_data));
+}
+
+/*
+* Buffers the data in the sequence. If the data does not fit, the filled buffer is sent and
+* the remaining data is taken, once the buffer is sent. Data larger than the buffer is sent as it is.
+* p_is_sent is set to TRUE, if a command is sent.
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_hash_mux_buffer(optiga_crypt_hash_mux_t * me,
+                                                           optiga_crypt_hash_mux_sequence_t * p_sequence,
+                                                           const uint8_t * p_data,
+                                                           uint32_t length,
+                                                           uint8_t * p_is_sent)
+{
+    optiga_lib_status_t return_value = OPTIGA_LIB_SUCCESS;
+    uint16_t free_length = OPTIGA_CRYPT_HASH_MUX_BUFFER_SIZE - p_sequence->buffered_length;
+
+    *p_is_sent = FALSE;
+    do
+    {
+        if (length <= free_length)
+        {
+            pal_os_memcpy(p_sequence->buffer + p_sequence->buffered_length, p_data, length);
+            p_sequence->buffered_length += (uint16_t)length;
+            break;
+        }
+        *p_is_sent = TRUE;
+        if (0 == p_sequence->buffered_length)
+        {
+            return_value = optiga_crypt_hash_mux_send(me, p_sequence, p_data, length);
+            break;
+        }
+
+        pal_os_memcpy(p_sequence->buffer + p_sequence->buffered_length, p_data, free_length);
+        me->p_remaining_data = p_data + free_length;
+        me->remaining_length = length - free_length;
+        // The buffer is not modified, until the command is completed
+        p_sequence->buffered_length = 0;
+        me->next_step = OPTIGA_CRYPT_HASH_MUX_STEP_REMAINING;
+        return_value = optiga_crypt_hash_mux_send(me, p_sequence, p_sequence->buffer, OPTIGA_CRYPT_HASH_MUX_BUFFER_SIZE);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            me->next_step = OPTIGA_CRYPT_HASH_MUX_STEP_NONE;
+            p_sequence->buffered_length = OPTIGA_CRYPT_HASH_MUX_BUFFER_SIZE - free_length;
+        }
+    } while (FALSE);
+    return (return_value);
+}
+
+/*
+* Event handler of the hash multiplexer instance, takes the pending step of the operation
+*/
+_STATIC_H void optiga_crypt_hash_mux_event_handler(void * p_ctx, optiga_lib_status_t event)
+{
+    optiga_crypt_hash_mux_t * me = (optiga_crypt_hash_mux_t *)p_ctx;
+    optiga_crypt_hash_mux_sequence_t * p_sequence = &me->sequence[me->current];
+    optiga_lib_status_t status = event;
+    uint8_t next_step = me->next_step;
+    uint8_t is_sent = FALSE;
+
+    me->next_step = OPTIGA_CRYPT_HASH_MUX_STEP_NONE;
+    do
+    {
+        if ((OPTIGA_LIB_SUCCESS != status) || (OPTIGA_CRYPT_HASH_MUX_STEP_NONE == next_step))
+        {
+            break;
+        }
+        if (OPTIGA_CRYPT_HASH_MUX_STEP_REMAINING == next_step)
+        {
+            status = optiga_crypt_hash_mux_buffer(me, p_sequence, me->p_remaining_data, me->remaining_length, &is_sent);
+        }
+        else
+        {
+            is_sent = TRUE;
+            status = optiga_crypt_hash_finalize(me->p_crypt, p_sequence->p_hash_ctx, me->p_hash_output);
+        }
+    } while (FALSE);
+
+    // The operation is completed, once no further command is sent
+    if ((OPTIGA_LIB_SUCCESS != status) || (FALSE == is_sent))
+    {
+        optiga_crypt_hash_mux_complete(me, status);
+    }
+}
+
+/*
+* Marks the operation of the sequence as ongoing
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_hash_mux_begin(optiga_crypt_hash_mux_t * me, uint8_t sequence_id)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+    do
+    {
+        if ((OPTIGA_CRYPT_HASH_MUX_MAX_SEQUENCES <= sequence_id) || (FALSE == me->sequence[sequence_id].in_use))
+        {
+            break;
+        }
+        pal_os_lock_enter_critical_section();
+        return_value = (TRUE == me->ongoing) ? OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE : OPTIGA_LIB_SUCCESS;
+        me->ongoing = TRUE;
+        pal_os_lock_exit_critical_section();
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            break;
+        }
+        me->current = sequence_id;
+        me->next_step = OPTIGA_CRYPT_HASH_MUX_STEP_NONE;
+        me->finalizing = FALSE;
+        return_value = optiga_crypt_hash_mux_select(me, &me->sequence[sequence_id]);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            me->ongoing = FALSE;
+        }
+    } while (FALSE);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_hash_mux_init(optiga_crypt_hash_mux_t * me,
+                                               uint8_t optiga_instance_id,
+                                               callback_handler_t handler,
+                                               void * caller_context)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        pal_os_memset(me, 0, sizeof(optiga_crypt_hash_mux_t));
+        me->caller_handler = handler;
+        me->caller_context = caller_context;
+
+        return_value = OPTIGA_CRYPT_ERROR;
+        me->p_crypt = optiga_crypt_create(optiga_instance_id, optiga_crypt_hash_mux_event_handler, me);
+        if (NULL == me->p_crypt)
+        {
+            break;
+        }
+        return_value = OPTIGA_CRYPT_SUCCESS;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_hash_mux_deinit(optiga_crypt_hash_mux_t * me)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        if (TRUE == me->ongoing)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        if (NULL != me->p_crypt)
+        {
+            //lint --e{534} suppress "Instance is free, return value is not required to be checked"
+            optiga_crypt_destroy(me->p_crypt);
+        }
+        pal_os_memset(me, 0, sizeof(optiga_crypt_hash_mux_t));
+        return_value = OPTIGA_CRYPT_SUCCESS;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_hash_mux_start(optiga_crypt_hash_mux_t * me,
+                                                optiga_hash_context_t * hash_ctx,
+                                                bool_t on_host,
+                                                uint8_t * p_sequence_id)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    uint8_t index;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->p_crypt) || (NULL == hash_ctx) || (NULL == p_sequence_id))
+        {
+            break;
+        }
+#endif
+        // Only one context can be resident in OPTIGA, hence the context of each sequence is exported
+        if (NULL == hash_ctx->context_buffer)
+        {
+            break;
+        }
+        if (TRUE == me->ongoing)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        for (index = 0; index < OPTIGA_CRYPT_HASH_MUX_MAX_SEQUENCES; index++)
+        {
+            if (FALSE == me->sequence[index].in_use)
+            {
+                break;
+            }
+        }
+        if (OPTIGA_CRYPT_HASH_MUX_MAX_SEQUENCES == index)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_MEMORY_INSUFFICIENT;
+            break;
+        }
+
+        me->sequence[index].p_hash_ctx = hash_ctx;
+        me->sequence[index].buffered_length = 0;
+        me->sequence[index].on_host = (TRUE == on_host) ? TRUE : FALSE;
+        me->sequence[index].in_use = TRUE;
+        return_value = optiga_crypt_hash_mux_begin(me, index);
+        if (OPTIGA_LIB_SUCCESS == return_value)
+        {
+            *p_sequence_id = index;
+            return_value = optiga_crypt_hash_start(me->p_crypt, hash_ctx);
+            if (OPTIGA_LIB_SUCCESS != return_value)
+            {
+                me->ongoing = FALSE;
+            }
+        }
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            pal_os_memset(&me->sequence[index], 0, sizeof(optiga_crypt_hash_mux_sequence_t));
+        }
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_hash_mux_update(optiga_crypt_hash_mux_t * me,
+                                                 uint8_t sequence_id,
+                                                 const uint8_t * data,
+                                                 uint32_t data_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    optiga_crypt_hash_mux_sequence_t * p_sequence;
+    uint8_t is_sent;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->p_crypt) || (NULL == data))
+        {
+            break;
+        }
+#endif
+        return_value = optiga_crypt_hash_mux_begin(me, sequence_id);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            break;
+        }
+        p_sequence = &me->sequence[sequence_id];
+        if (TRUE == p_sequence->on_host)
+        {
+            // No data is transferred to OPTIGA, hence nothing is buffered
+            return_value = optiga_crypt_hash_mux_send(me, p_sequence, data, data_length);
+            is_sent = TRUE;
+        }
+        else
+        {
+            return_value = optiga_crypt_hash_mux_buffer(me, p_sequence, data, data_length, &is_sent);
+        }
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            me->ongoing = FALSE;
+            break;
+        }
+        if (FALSE == is_sent)
+        {
+            // No command is sent, hence the operation is completed right away
+            optiga_crypt_hash_mux_complete(me, OPTIGA_LIB_SUCCESS);
+        }
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_hash_mux_finalize(optiga_crypt_hash_mux_t * me,
+                                                   uint8_t sequence_id,
+                                                   uint8_t * hash_output)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    optiga_crypt_hash_mux_sequence_t * p_sequence;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->p_crypt) || (NULL == hash_output))
+        {
+            break;
+        }
+#endif
+        return_value = optiga_crypt_hash_mux_begin(me, sequence_id);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            break;
+        }
+        p_sequence = &me->sequence[sequence_id];
+        me->finalizing = TRUE;
+        me->p_hash_output = hash_output;
+        if (0 == p_sequence->buffered_length)
+        {
+            return_value = optiga_crypt_hash_finalize(me->p_crypt, p_sequence->p_hash_ctx, hash_output);
+        }
+        else
+        {
+            me->next_step = OPTIGA_CRYPT_HASH_MUX_STEP_FINALIZE;
+            return_value = optiga_crypt_hash_mux_send(me, p_sequence, p_sequence->buffer, p_sequence->buffered_length);
+        }
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            me->next_step = OPTIGA_CRYPT_HASH_MUX_STEP_NONE;
+            me->finalizing = FALSE;
+            me->ongoing = FALSE;
+        }
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_hash_mux_close(optiga_crypt_hash_mux_t * me,
+                                                uint8_t sequence_id)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_CRYPT_HASH_MUX_MAX_SEQUENCES <= sequence_id)
+        {
+            break;
+        }
+        if ((TRUE == me->ongoing) && (sequence_id == me->current))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        pal_os_memset(&me->sequence[sequence_id], 0, sizeof(optiga_crypt_hash_mux_sequence_t));
+        return_value = OPTIGA_CRYPT_SUCCESS;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+#endif //OPTIGA_CRYPT_HASH_MUX_ENABLED
+
+/**
+* @}
+*/
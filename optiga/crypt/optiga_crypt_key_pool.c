@@ -0,0 +1,336 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_crypt_key_pool.c
+*
+* \brief   This file implements the OPTIGA Crypt key pool, which pregenerates persistent keypairs in reserved key OIDs.
+*
+* \ingroup  grOptigaCrypt
+*
+* @{
+*/
+
+#include "optiga/optiga_crypt_key_pool.h"
+#include "optiga/pal/pal_os_lock.h"
+#include "optiga/pal/pal_os_memory.h"
+
+#ifdef OPTIGA_CRYPT_KEY_POOL_ENABLED
+
+/// Key OID holds no keypair to be handed out
+#define OPTIGA_CRYPT_KEY_POOL_EMPTY                                 (0x00)
+/// Keypair of the key OID is being generated
+#define OPTIGA_CRYPT_KEY_POOL_GENERATING                            (0x01)
+/// Keypair of the key OID is ready to be handed out
+#define OPTIGA_CRYPT_KEY_POOL_READY                                 (0x02)
+/// Key OID is assigned to the caller
+#define OPTIGA_CRYPT_KEY_POOL_ASSIGNED                              (0x03)
+
+/// RSA key types are 0x4X, ECC curves are below
+#define OPTIGA_CRYPT_KEY_POOL_IS_RSA(key_type)                      (0x40U == ((key_type) & 0xF0U))
+
+/*
+* Returns the number of entries in the state
+*/
+_STATIC_H uint8_t optiga_crypt_key_pool_count(const optiga_crypt_key_pool_t * me, uint8_t state)
+{
+    uint8_t count = 0;
+    uint8_t index;
+
+    for (index = 0; index < me->entry_count; index++)
+    {
+        if (state == me->entries[index].state)
+        {
+            count++;
+        }
+    }
+    return (count);
+}
+
+/*
+* Starts the generation of a keypair into the next empty key OID, if less than the ready count keypairs are ready.
+* The keypairs are generated one after the other with the crypt instance of the pool.
+*/
+_STATIC_H void optiga_crypt_key_pool_refill(optiga_crypt_key_pool_t * me)
+{
+    optiga_crypt_key_pool_entry_t * p_entry = NULL;
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    uint8_t index;
+
+    pal_os_lock_enter_critical_section();
+    if ((FALSE == me->refill_failed) &&
+        (0U == optiga_crypt_key_pool_count(me, OPTIGA_CRYPT_KEY_POOL_GENERATING)) &&
+        (optiga_crypt_key_pool_count(me, OPTIGA_CRYPT_KEY_POOL_READY) < me->ready_count))
+    {
+        for (index = 0; index < me->entry_count; index++)
+        {
+            if (OPTIGA_CRYPT_KEY_POOL_EMPTY == me->entries[index].state)
+            {
+                p_entry = &me->entries[index];
+                p_entry->state = OPTIGA_CRYPT_KEY_POOL_GENERATING;
+                break;
+            }
+        }
+    }
+    pal_os_lock_exit_critical_section();
+
+    if (NULL != p_entry)
+    {
+        p_entry->public_key_length = sizeof(p_entry->public_key);
+#ifdef OPTIGA_CRYPT_RSA_GENERATE_KEYPAIR_ENABLED
+        if (OPTIGA_CRYPT_KEY_POOL_IS_RSA(me->key_type))
+        {
+            return_value = optiga_crypt_rsa_generate_keypair(me->p_crypt,
+                                                             (optiga_rsa_key_type_t)me->key_type,
+                                                             me->key_usage,
+                                                             FALSE,
+                                                             &p_entry->key_oid,
+                                                             p_entry->public_key,
+                                                             &p_entry->public_key_length);
+        }
+        else
+#endif //OPTIGA_CRYPT_RSA_GENERATE_KEYPAIR_ENABLED
+        {
+#ifdef OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED
+            return_value = optiga_crypt_ecc_generate_keypair(me->p_crypt,
+                                                             (optiga_ecc_curve_t)me->key_type,
+                                                             me->key_usage,
+                                                             FALSE,
+                                                             &p_entry->key_oid,
+                                                             p_entry->public_key,
+                                                             &p_entry->public_key_length);
+#endif //OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED
+        }
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            // Generation is retried with the next acquire or release
+            p_entry->state = OPTIGA_CRYPT_KEY_POOL_EMPTY;
+            me->refill_failed = TRUE;
+        }
+    }
+}
+
+/*
+* Event handler of the crypt instance, completes the generation and continues the refill
+*/
+_STATIC_H void optiga_crypt_key_pool_event_handler(void * p_ctx, optiga_lib_status_t event)
+{
+    optiga_crypt_key_pool_t * me = (optiga_crypt_key_pool_t *)p_ctx;
+    uint8_t index;
+
+    pal_os_lock_enter_critical_section();
+    for (index = 0; index < me->entry_count; index++)
+    {
+        if (OPTIGA_CRYPT_KEY_POOL_GENERATING == me->entries[index].state)
+        {
+            me->entries[index].state = (OPTIGA_LIB_SUCCESS == event) ? OPTIGA_CRYPT_KEY_POOL_READY :
+                                                                       OPTIGA_CRYPT_KEY_POOL_EMPTY;
+        }
+    }
+    if (OPTIGA_LIB_SUCCESS != event)
+    {
+        me->refill_failed = TRUE;
+    }
+    pal_os_lock_exit_critical_section();
+
+    optiga_crypt_key_pool_refill(me);
+}
+
+optiga_lib_status_t optiga_crypt_key_pool_init(optiga_crypt_key_pool_t * me,
+                                               uint8_t optiga_instance_id,
+                                               uint8_t key_type,
+                                               uint8_t key_usage,
+                                               const uint16_t * p_key_oids,
+                                               uint8_t key_oid_count,
+                                               uint8_t ready_count)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    uint8_t index;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == p_key_oids))
+        {
+            break;
+        }
+#endif
+        if ((0U == key_oid_count) || (OPTIGA_CRYPT_KEY_POOL_SIZE < key_oid_count) || (key_oid_count < ready_count))
+        {
+            break;
+        }
+        pal_os_memset(me, 0, sizeof(optiga_crypt_key_pool_t));
+        me->key_type = key_type;
+        me->key_usage = key_usage;
+        me->ready_count = ready_count;
+        me->entry_count = key_oid_count;
+        for (index = 0; index < key_oid_count; index++)
+        {
+            me->entries[index].key_oid = p_key_oids[index];
+            me->entries[index].state = OPTIGA_CRYPT_KEY_POOL_EMPTY;
+        }
+
+        me->p_crypt = optiga_crypt_create(optiga_instance_id, optiga_crypt_key_pool_event_handler, me);
+        if (NULL == me->p_crypt)
+        {
+            return_value = OPTIGA_CRYPT_ERROR;
+            break;
+        }
+        // Keypairs are generated, when no other request is waiting
+        //lint --e{534} suppress "Instance is free, return value is not required to be checked"
+        optiga_crypt_set_priority(me->p_crypt, OPTIGA_LIB_PRIORITY_LOW);
+
+        optiga_crypt_key_pool_refill(me);
+        return_value = OPTIGA_CRYPT_SUCCESS;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_key_pool_deinit(optiga_crypt_key_pool_t * me)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        if ((NULL != me->p_crypt) && (OPTIGA_LIB_INSTANCE_BUSY == me->p_crypt->instance_state))
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        if (NULL != me->p_crypt)
+        {
+            //lint --e{534} suppress "Instance is free, return value is not required to be checked"
+            optiga_crypt_destroy(me->p_crypt);
+            me->p_crypt = NULL;
+        }
+        me->entry_count = 0;
+        return_value = OPTIGA_CRYPT_SUCCESS;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_key_pool_acquire(optiga_crypt_key_pool_t * me,
+                                                  uint16_t * p_key_oid,
+                                                  uint8_t * p_public_key,
+                                                  uint16_t * p_public_key_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    optiga_crypt_key_pool_entry_t * p_entry = NULL;
+    uint8_t index;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == p_key_oid) || (NULL == p_public_key) || (NULL == p_public_key_length))
+        {
+            break;
+        }
+#endif
+        return_value = OPTIGA_CRYPT_ERROR;
+        pal_os_lock_enter_critical_section();
+        for (index = 0; index < me->entry_count; index++)
+        {
+            if (OPTIGA_CRYPT_KEY_POOL_READY == me->entries[index].state)
+            {
+                if (*p_public_key_length < me->entries[index].public_key_length)
+                {
+                    return_value = OPTIGA_CRYPT_ERROR_MEMORY_INSUFFICIENT;
+                    break;
+                }
+                p_entry = &me->entries[index];
+                p_entry->state = OPTIGA_CRYPT_KEY_POOL_ASSIGNED;
+                break;
+            }
+        }
+        me->refill_failed = FALSE;
+        pal_os_lock_exit_critical_section();
+
+        if (NULL != p_entry)
+        {
+            *p_key_oid = p_entry->key_oid;
+            pal_os_memcpy(p_public_key, p_entry->public_key, p_entry->public_key_length);
+            *p_public_key_length = p_entry->public_key_length;
+            return_value = OPTIGA_CRYPT_SUCCESS;
+        }
+        // The assigned keypair is replaced by a keypair in the next empty key OID
+        optiga_crypt_key_pool_refill(me);
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_key_pool_release(optiga_crypt_key_pool_t * me,
+                                                  uint16_t key_oid)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    uint8_t index;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        pal_os_lock_enter_critical_section();
+        for (index = 0; index < me->entry_count; index++)
+        {
+            if ((key_oid == me->entries[index].key_oid) &&
+                (OPTIGA_CRYPT_KEY_POOL_ASSIGNED == me->entries[index].state))
+            {
+                // The keypair is overwritten by a fresh one, hence never handed out again
+                me->entries[index].state = OPTIGA_CRYPT_KEY_POOL_EMPTY;
+                me->refill_failed = FALSE;
+                return_value = OPTIGA_CRYPT_SUCCESS;
+                break;
+            }
+        }
+        pal_os_lock_exit_critical_section();
+
+        if (OPTIGA_CRYPT_SUCCESS == return_value)
+        {
+            optiga_crypt_key_pool_refill(me);
+        }
+    } while (FALSE);
+
+    return (return_value);
+}
+
+#endif //OPTIGA_CRYPT_KEY_POOL_ENABLED
+
+/**
+* @}
+*/
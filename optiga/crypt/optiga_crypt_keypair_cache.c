@@ -0,0 +1,288 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_crypt_keypair_cache.c
+*
+* \brief   This file implements the OPTIGA Crypt keypair cache, which pregenerates ephemeral ECC keypairs in session contexts.
+*
+* \ingroup  grOptigaCrypt
+*
+* @{
+*/
+
+#include "optiga/optiga_crypt_keypair_cache.h"
+#include "optiga/pal/pal_os_lock.h"
+#include "optiga/pal/pal_os_memory.h"
+
+#ifdef OPTIGA_CRYPT_KEYPAIR_CACHE_ENABLED
+
+/// Entry holds no keypair
+#define OPTIGA_CRYPT_KEYPAIR_CACHE_EMPTY                            (0x00)
+/// Keypair of the entry is being generated
+#define OPTIGA_CRYPT_KEYPAIR_CACHE_GENERATING                       (0x01)
+/// Keypair of the entry is ready to be handed out
+#define OPTIGA_CRYPT_KEYPAIR_CACHE_READY                            (0x02)
+/// Keypair of the entry is handed out
+#define OPTIGA_CRYPT_KEYPAIR_CACHE_IN_USE                           (0x03)
+
+/*
+* Starts the generation of a fresh keypair into the session context of the entry
+*/
+_STATIC_H void optiga_crypt_keypair_cache_generate(optiga_crypt_keypair_cache_t * me,
+                                                   optiga_crypt_keypair_cache_entry_t * p_entry)
+{
+    optiga_key_id_t session_key_id = OPTIGA_KEY_ID_SESSION_BASED;
+
+    p_entry->state = OPTIGA_CRYPT_KEYPAIR_CACHE_GENERATING;
+    p_entry->public_key_length = sizeof(p_entry->public_key);
+    if (OPTIGA_LIB_SUCCESS != optiga_crypt_ecc_generate_keypair(p_entry->p_crypt,
+                                                                me->curve_id,
+                                                                me->key_usage,
+                                                                FALSE,
+                                                                &session_key_id,
+                                                                p_entry->public_key,
+                                                                &p_entry->public_key_length))
+    {
+        // Generation is retried with the next acquire
+        p_entry->state = OPTIGA_CRYPT_KEYPAIR_CACHE_EMPTY;
+    }
+}
+
+/*
+* Event handler of the entries, completes the generation or forwards the event to the caller
+*/
+_STATIC_H void optiga_crypt_keypair_cache_event_handler(void * p_ctx, optiga_lib_status_t event)
+{
+    optiga_crypt_keypair_cache_entry_t * p_entry = (optiga_crypt_keypair_cache_entry_t *)p_ctx;
+
+    if (OPTIGA_CRYPT_KEYPAIR_CACHE_GENERATING == p_entry->state)
+    {
+        pal_os_lock_enter_critical_section();
+        p_entry->state = (OPTIGA_LIB_SUCCESS == event) ? OPTIGA_CRYPT_KEYPAIR_CACHE_READY :
+                                                         OPTIGA_CRYPT_KEYPAIR_CACHE_EMPTY;
+        pal_os_lock_exit_critical_section();
+    }
+    else if (NULL != p_entry->caller_handler)
+    {
+        p_entry->caller_handler(p_entry->caller_context, event);
+    }
+    else
+    {
+        // Nothing to be done
+    }
+}
+
+optiga_lib_status_t optiga_crypt_keypair_cache_init(optiga_crypt_keypair_cache_t * me,
+                                                    uint8_t optiga_instance_id,
+                                                    optiga_ecc_curve_t curve_id,
+                                                    uint8_t key_usage)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    uint8_t index;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        pal_os_memset(me, 0, sizeof(optiga_crypt_keypair_cache_t));
+        me->curve_id = curve_id;
+        me->key_usage = key_usage;
+
+        return_value = OPTIGA_CRYPT_SUCCESS;
+        for (index = 0; index < OPTIGA_CRYPT_KEYPAIR_CACHE_SIZE; index++)
+        {
+            me->entries[index].p_cache = me;
+            me->entries[index].p_crypt = optiga_crypt_create(optiga_instance_id,
+                                                             optiga_crypt_keypair_cache_event_handler,
+                                                             &me->entries[index]);
+            if (NULL == me->entries[index].p_crypt)
+            {
+                return_value = OPTIGA_CRYPT_ERROR;
+                break;
+            }
+            // Keypairs are generated, when no other request is waiting
+            //lint --e{534} suppress "Instance is free, return value is not required to be checked"
+            optiga_crypt_set_priority(me->entries[index].p_crypt, OPTIGA_LIB_PRIORITY_LOW);
+        }
+        if (OPTIGA_CRYPT_SUCCESS != return_value)
+        {
+            //lint --e{534} suppress "No keypair is being generated, return value is not required to be checked"
+            optiga_crypt_keypair_cache_deinit(me);
+            break;
+        }
+
+        for (index = 0; index < OPTIGA_CRYPT_KEYPAIR_CACHE_SIZE; index++)
+        {
+            optiga_crypt_keypair_cache_generate(me, &me->entries[index]);
+        }
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_keypair_cache_deinit(optiga_crypt_keypair_cache_t * me)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    uint8_t index;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        return_value = OPTIGA_CRYPT_SUCCESS;
+        for (index = 0; index < OPTIGA_CRYPT_KEYPAIR_CACHE_SIZE; index++)
+        {
+            if ((OPTIGA_CRYPT_KEYPAIR_CACHE_GENERATING == me->entries[index].state) ||
+                (OPTIGA_CRYPT_KEYPAIR_CACHE_IN_USE == me->entries[index].state))
+            {
+                return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+                break;
+            }
+        }
+        if (OPTIGA_CRYPT_SUCCESS != return_value)
+        {
+            break;
+        }
+        for (index = 0; index < OPTIGA_CRYPT_KEYPAIR_CACHE_SIZE; index++)
+        {
+            if (NULL != me->entries[index].p_crypt)
+            {
+                // Destroying the instance releases the session context, hence the private key
+                //lint --e{534} suppress "Instance is free, return value is not required to be checked"
+                optiga_crypt_destroy(me->entries[index].p_crypt);
+                me->entries[index].p_crypt = NULL;
+            }
+            me->entries[index].state = OPTIGA_CRYPT_KEYPAIR_CACHE_EMPTY;
+        }
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_crypt_t * optiga_crypt_keypair_cache_acquire(optiga_crypt_keypair_cache_t * me,
+                                                    callback_handler_t handler,
+                                                    void * caller_context,
+                                                    const uint8_t ** pp_public_key,
+                                                    uint16_t * p_public_key_length)
+{
+    optiga_crypt_t * p_crypt = NULL;
+    uint8_t index;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == pp_public_key) || (NULL == p_public_key_length))
+        {
+            break;
+        }
+#endif
+        pal_os_lock_enter_critical_section();
+        for (index = 0; index < OPTIGA_CRYPT_KEYPAIR_CACHE_SIZE; index++)
+        {
+            if (OPTIGA_CRYPT_KEYPAIR_CACHE_READY == me->entries[index].state)
+            {
+                me->entries[index].state = OPTIGA_CRYPT_KEYPAIR_CACHE_IN_USE;
+                me->entries[index].caller_handler = handler;
+                me->entries[index].caller_context = caller_context;
+                p_crypt = me->entries[index].p_crypt;
+                *pp_public_key = me->entries[index].public_key;
+                *p_public_key_length = me->entries[index].public_key_length;
+                break;
+            }
+        }
+        pal_os_lock_exit_critical_section();
+
+        for (index = 0; index < OPTIGA_CRYPT_KEYPAIR_CACHE_SIZE; index++)
+        {
+            if ((OPTIGA_CRYPT_KEYPAIR_CACHE_EMPTY == me->entries[index].state) && (NULL != me->entries[index].p_crypt))
+            {
+                optiga_crypt_keypair_cache_generate(me, &me->entries[index]);
+            }
+        }
+    } while (FALSE);
+
+    return (p_crypt);
+}
+
+optiga_lib_status_t optiga_crypt_keypair_cache_release(optiga_crypt_keypair_cache_t * me,
+                                                       optiga_crypt_t * p_crypt)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    optiga_crypt_keypair_cache_entry_t * p_entry = NULL;
+    uint8_t index;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == p_crypt))
+        {
+            break;
+        }
+#endif
+        for (index = 0; index < OPTIGA_CRYPT_KEYPAIR_CACHE_SIZE; index++)
+        {
+            if ((p_crypt == me->entries[index].p_crypt) &&
+                (OPTIGA_CRYPT_KEYPAIR_CACHE_IN_USE == me->entries[index].state))
+            {
+                p_entry = &me->entries[index];
+                break;
+            }
+        }
+        if (NULL == p_entry)
+        {
+            break;
+        }
+        if (OPTIGA_LIB_INSTANCE_BUSY == p_crypt->instance_state)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+
+        // The used keypair is overwritten by a fresh one, hence never handed out again
+        p_entry->caller_handler = NULL;
+        p_entry->caller_context = NULL;
+        optiga_crypt_keypair_cache_generate(me, p_entry);
+        return_value = OPTIGA_CRYPT_SUCCESS;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+#endif //OPTIGA_CRYPT_KEYPAIR_CACHE_ENABLED
+
+/**
+* @}
+*/
@@ -0,0 +1,237 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_crypt_random_pool.c
+*
+* \brief   This file implements the OPTIGA Crypt random pool, which serves random bytes prefetched from OPTIGA.
+*
+* \ingroup  grOptigaCrypt
+*
+* @{
+*/
+
+#include "optiga/optiga_crypt_random_pool.h"
+#include "optiga/pal/pal_os_lock.h"
+#include "optiga/pal/pal_os_memory.h"
+
+#ifdef OPTIGA_CRYPT_RANDOM_POOL_ENABLED
+
+/*
+* Starts a refill, if none is ongoing and the pool has room for it
+*/
+_STATIC_H void optiga_crypt_random_pool_refill(optiga_crypt_random_pool_t * me)
+{
+    uint8_t start_refill = FALSE;
+
+    pal_os_lock_enter_critical_section();
+    if ((FALSE == me->refill_ongoing) &&
+        ((OPTIGA_CRYPT_RANDOM_POOL_SIZE - me->available) >= OPTIGA_CRYPT_RANDOM_POOL_REFILL_SIZE))
+    {
+        me->refill_ongoing = TRUE;
+        start_refill = TRUE;
+    }
+    pal_os_lock_exit_critical_section();
+
+    if (TRUE == start_refill)
+    {
+        if (OPTIGA_LIB_SUCCESS != optiga_crypt_random(me->p_crypt,
+                                                      me->rng_type,
+                                                      me->refill_buffer,
+                                                      OPTIGA_CRYPT_RANDOM_POOL_REFILL_SIZE))
+        {
+            // Refill is retried with the next request served from the pool
+            me->refill_ongoing = FALSE;
+        }
+    }
+}
+
+/*
+* Event handler of the pool instance, appends the random bytes of the refill to the pool
+*/
+_STATIC_H void optiga_crypt_random_pool_event_handler(void * p_ctx, optiga_lib_status_t event)
+{
+    optiga_crypt_random_pool_t * me = (optiga_crypt_random_pool_t *)p_ctx;
+
+    pal_os_lock_enter_critical_section();
+    if ((OPTIGA_LIB_SUCCESS == event) && (FALSE == me->refill_discarded))
+    {
+        pal_os_memcpy(&me->pool[me->available], me->refill_buffer, OPTIGA_CRYPT_RANDOM_POOL_REFILL_SIZE);
+        me->available += OPTIGA_CRYPT_RANDOM_POOL_REFILL_SIZE;
+    }
+    pal_os_memset(me->refill_buffer, 0, sizeof(me->refill_buffer));
+    me->refill_discarded = FALSE;
+    me->refill_ongoing = FALSE;
+    pal_os_lock_exit_critical_section();
+
+    // Pool is filled up completely, a failed refill is retried only at the low water mark
+    if (OPTIGA_LIB_SUCCESS == event)
+    {
+        optiga_crypt_random_pool_refill(me);
+    }
+}
+
+optiga_lib_status_t optiga_crypt_random_pool_init(optiga_crypt_random_pool_t * me,
+                                                  uint8_t optiga_instance_id,
+                                                  optiga_rng_type_t rng_type,
+                                                  uint16_t low_water_mark)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_CRYPT_RANDOM_POOL_SIZE < low_water_mark)
+        {
+            break;
+        }
+        pal_os_memset(me, 0, sizeof(optiga_crypt_random_pool_t));
+        me->rng_type = rng_type;
+        me->low_water_mark = low_water_mark;
+
+        return_value = OPTIGA_CRYPT_ERROR;
+        me->p_crypt = optiga_crypt_create(optiga_instance_id, optiga_crypt_random_pool_event_handler, me);
+        if (NULL == me->p_crypt)
+        {
+            break;
+        }
+        // Refills are served, when no other request is waiting
+        //lint --e{534} suppress "Instance is free, return value is not required to be checked"
+        optiga_crypt_set_priority(me->p_crypt, OPTIGA_LIB_PRIORITY_LOW);
+
+        optiga_crypt_random_pool_refill(me);
+        return_value = OPTIGA_CRYPT_SUCCESS;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_random_pool_deinit(optiga_crypt_random_pool_t * me)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        if (TRUE == me->refill_ongoing)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        if (NULL != me->p_crypt)
+        {
+            //lint --e{534} suppress "Instance is free, return value is not required to be checked"
+            optiga_crypt_destroy(me->p_crypt);
+        }
+        pal_os_memset(me, 0, sizeof(optiga_crypt_random_pool_t));
+        return_value = OPTIGA_CRYPT_SUCCESS;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_random_pool_get(optiga_crypt_random_pool_t * me,
+                                                 uint8_t * p_random,
+                                                 uint16_t length)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    uint8_t below_low_water_mark;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->p_crypt) || (NULL == p_random))
+        {
+            break;
+        }
+#endif
+        if (0 == length)
+        {
+            break;
+        }
+
+        return_value = OPTIGA_CRYPT_ERROR_MEMORY_INSUFFICIENT;
+        pal_os_lock_enter_critical_section();
+        if (me->available >= length)
+        {
+            me->available -= length;
+            pal_os_memcpy(p_random, &me->pool[me->available], length);
+            // Served bytes are erased, hence they are neither served again nor recoverable from the pool
+            pal_os_memset(&me->pool[me->available], 0, length);
+            return_value = OPTIGA_CRYPT_SUCCESS;
+        }
+        below_low_water_mark = (me->available < me->low_water_mark) ? TRUE : FALSE;
+        pal_os_lock_exit_critical_section();
+
+        if (TRUE == below_low_water_mark)
+        {
+            optiga_crypt_random_pool_refill(me);
+        }
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_random_pool_flush(optiga_crypt_random_pool_t * me)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        pal_os_lock_enter_critical_section();
+        pal_os_memset(me->pool, 0, sizeof(me->pool));
+        me->available = 0;
+        // Bytes of the ongoing refill are generated before the flush, hence discarded as well
+        me->refill_discarded = me->refill_ongoing;
+        pal_os_lock_exit_critical_section();
+        return_value = OPTIGA_CRYPT_SUCCESS;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+#endif //OPTIGA_CRYPT_RANDOM_POOL_ENABLED
+
+/**
+* @}
+*/
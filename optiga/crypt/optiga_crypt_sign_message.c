@@ -0,0 +1,379 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_crypt_sign_message.c
+*
+* \brief   This file implements the OPTIGA Crypt sign message, which hashes messages on host while OPTIGA signs the previous digest.
+*
+* \ingroup  grOptigaCrypt
+*
+* @{
+*/
+
+#include "optiga/optiga_crypt_sign_message.h"
+#include "optiga/common/optiga_lib_common_internal.h"
+#include "optiga/pal/pal_crypt.h"
+#include "optiga/pal/pal_os_lock.h"
+#include "optiga/pal/pal_os_memory.h"
+
+#ifdef OPTIGA_CRYPT_SIGN_MESSAGE_ENABLED
+
+/*
+* Calculates the SHA256 digest of the message from the buffer or the reader
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_sign_message_hash(const uint8_t * message,
+                                                             uint32_t message_length,
+                                                             optiga_crypt_sign_message_reader_t reader,
+                                                             void * p_io_ctx,
+                                                             uint8_t * digest)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR;
+    pal_status_t pal_return_value;
+    // Kept on the stack, since several callers may hash their messages at the same time
+    uint8_t hash_context[OPTIGA_HASH_CONTEXT_LENGTH_SHA_256];
+    uint8_t chunk[OPTIGA_CRYPT_SIGN_MESSAGE_CHUNK_SIZE];
+    uint16_t read_length = 0;
+
+    do
+    {
+        pal_return_value = pal_crypt_sha256_start(NULL, hash_context, sizeof(hash_context));
+        if (PAL_STATUS_SUCCESS != pal_return_value)
+        {
+            break;
+        }
+        if (NULL != message)
+        {
+            pal_return_value = pal_crypt_sha256_update(NULL, hash_context, sizeof(hash_context),
+                                                       message, message_length);
+        }
+        else
+        {
+            do
+            {
+                if ((OPTIGA_LIB_SUCCESS != reader(p_io_ctx, chunk, sizeof(chunk), &read_length)) ||
+                    (read_length > sizeof(chunk)))
+                {
+                    pal_return_value = PAL_STATUS_FAILURE;
+                    break;
+                }
+                if (0 != read_length)
+                {
+                    pal_return_value = pal_crypt_sha256_update(NULL, hash_context, sizeof(hash_context),
+                                                               chunk, read_length);
+                }
+            } while ((0 != read_length) && (PAL_STATUS_SUCCESS == pal_return_value));
+            pal_os_memset(chunk, 0, sizeof(chunk));
+        }
+        if (PAL_STATUS_SUCCESS != pal_return_value)
+        {
+            break;
+        }
+        pal_return_value = pal_crypt_sha256_finalize(NULL, hash_context, sizeof(hash_context), digest);
+        if (PAL_STATUS_SUCCESS != pal_return_value)
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+/*
+* Starts the signature of the digest by OPTIGA
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_sign_message_start(optiga_crypt_sign_message_t * me,
+                                                              optiga_crypt_sign_message_request_t * p_request)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+    if (FALSE == p_request->rsa)
+    {
+#ifdef OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
+        return_value = optiga_crypt_ecdsa_sign(me->p_crypt,
+                                               p_request->digest,
+                                               OPTIGA_CRYPT_SIGN_MESSAGE_DIGEST_LENGTH,
+                                               p_request->private_key,
+                                               p_request->signature,
+                                               p_request->signature_length);
+#endif
+    }
+    else
+    {
+#ifdef OPTIGA_CRYPT_RSA_SIGN_ENABLED
+        return_value = optiga_crypt_rsa_sign(me->p_crypt,
+                                             p_request->rsa_signature_scheme,
+                                             p_request->digest,
+                                             OPTIGA_CRYPT_SIGN_MESSAGE_DIGEST_LENGTH,
+                                             p_request->private_key,
+                                             p_request->signature,
+                                             p_request->signature_length,
+                                             0);
+#endif
+    }
+    return (return_value);
+}
+
+/*
+* Starts the first queued message, a message which cannot be started is reported to its caller
+*/
+_STATIC_H void optiga_crypt_sign_message_next(optiga_crypt_sign_message_t * me)
+{
+    optiga_crypt_sign_message_request_t * p_request;
+    optiga_lib_status_t status;
+
+    do
+    {
+        pal_os_lock_enter_critical_section();
+        p_request = me->p_queue_head;
+        if (NULL != p_request)
+        {
+            me->p_queue_head = p_request->p_next;
+            if (NULL == me->p_queue_head)
+            {
+                me->p_queue_tail = NULL;
+            }
+        }
+        me->p_current = p_request;
+        pal_os_lock_exit_critical_section();
+
+        if (NULL == p_request)
+        {
+            break;
+        }
+        status = optiga_crypt_sign_message_start(me, p_request);
+        if (OPTIGA_LIB_SUCCESS == status)
+        {
+            break;
+        }
+        p_request->handler(p_request->caller_context, status);
+    } while (TRUE);
+}
+
+/*
+* Event handler of the crypt instance, starts the next message before the signed one is reported
+*/
+_STATIC_H void optiga_crypt_sign_message_event_handler(void * p_ctx, optiga_lib_status_t event)
+{
+    optiga_crypt_sign_message_t * me = (optiga_crypt_sign_message_t *)p_ctx;
+    optiga_crypt_sign_message_request_t * p_completed = me->p_current;
+
+    // OPTIGA signs the next digest, while the caller handles the signature
+    optiga_crypt_sign_message_next(me);
+    if (NULL != p_completed)
+    {
+        p_completed->handler(p_completed->caller_context, event);
+    }
+}
+
+/*
+* Hashes the message and starts or queues the signature of the digest
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_sign_message_submit(optiga_crypt_sign_message_t * me,
+                                                               optiga_crypt_sign_message_request_t * p_request,
+                                                               uint8_t rsa,
+                                                               optiga_rsa_signature_scheme_t signature_scheme,
+                                                               const uint8_t * message,
+                                                               uint32_t message_length,
+                                                               optiga_crypt_sign_message_reader_t reader,
+                                                               void * p_io_ctx,
+                                                               optiga_key_id_t private_key,
+                                                               uint8_t * signature,
+                                                               uint16_t * signature_length,
+                                                               callback_handler_t handler,
+                                                               void * caller_context)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    uint8_t start_now = FALSE;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->p_crypt) || (NULL == p_request))
+        {
+            break;
+        }
+#endif
+        if (((NULL == message) && (NULL == reader)) || (NULL == signature) ||
+            (NULL == signature_length) || (NULL == handler))
+        {
+            break;
+        }
+
+        // The digest is calculated without waiting for OPTIGA, which may sign another message meanwhile
+        return_value = optiga_crypt_sign_message_hash(message, message_length, reader, p_io_ctx, p_request->digest);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            break;
+        }
+        p_request->private_key = private_key;
+        p_request->signature = signature;
+        p_request->signature_length = signature_length;
+        p_request->handler = handler;
+        p_request->caller_context = caller_context;
+        p_request->rsa_signature_scheme = signature_scheme;
+        p_request->rsa = rsa;
+        p_request->p_next = NULL;
+
+        pal_os_lock_enter_critical_section();
+        if (NULL == me->p_current)
+        {
+            me->p_current = p_request;
+            start_now = TRUE;
+        }
+        else if (NULL == me->p_queue_tail)
+        {
+            me->p_queue_head = p_request;
+            me->p_queue_tail = p_request;
+        }
+        else
+        {
+            me->p_queue_tail->p_next = p_request;
+            me->p_queue_tail = p_request;
+        }
+        pal_os_lock_exit_critical_section();
+
+        if (TRUE == start_now)
+        {
+            return_value = optiga_crypt_sign_message_start(me, p_request);
+            if (OPTIGA_LIB_SUCCESS != return_value)
+            {
+                // Messages queued in the meantime are started instead
+                optiga_crypt_sign_message_next(me);
+            }
+        }
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_sign_message_init(optiga_crypt_sign_message_t * me,
+                                                   uint8_t optiga_instance_id)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        pal_os_memset(me, 0, sizeof(optiga_crypt_sign_message_t));
+
+        return_value = OPTIGA_CRYPT_ERROR;
+        me->p_crypt = optiga_crypt_create(optiga_instance_id, optiga_crypt_sign_message_event_handler, me);
+        if (NULL == me->p_crypt)
+        {
+            break;
+        }
+        return_value = OPTIGA_CRYPT_SUCCESS;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_sign_message_deinit(optiga_crypt_sign_message_t * me)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        if (NULL != me->p_current)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        if (NULL != me->p_crypt)
+        {
+            //lint --e{534} suppress "Instance is free, return value is not required to be checked"
+            optiga_crypt_destroy(me->p_crypt);
+        }
+        pal_os_memset(me, 0, sizeof(optiga_crypt_sign_message_t));
+        return_value = OPTIGA_CRYPT_SUCCESS;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+#ifdef OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
+optiga_lib_status_t optiga_crypt_sign_message_ecdsa(optiga_crypt_sign_message_t * me,
+                                                    optiga_crypt_sign_message_request_t * p_request,
+                                                    const uint8_t * message,
+                                                    uint32_t message_length,
+                                                    optiga_crypt_sign_message_reader_t reader,
+                                                    void * p_io_ctx,
+                                                    optiga_key_id_t private_key,
+                                                    uint8_t * signature,
+                                                    uint16_t * signature_length,
+                                                    callback_handler_t handler,
+                                                    void * caller_context)
+{
+    return (optiga_crypt_sign_message_submit(me, p_request, FALSE, OPTIGA_RSASSA_PKCS1_V15_SHA256,
+                                             message, message_length, reader, p_io_ctx, private_key,
+                                             signature, signature_length, handler, caller_context));
+}
+#endif //OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
+
+#ifdef OPTIGA_CRYPT_RSA_SIGN_ENABLED
+optiga_lib_status_t optiga_crypt_sign_message_rsa(optiga_crypt_sign_message_t * me,
+                                                  optiga_crypt_sign_message_request_t * p_request,
+                                                  optiga_rsa_signature_scheme_t signature_scheme,
+                                                  const uint8_t * message,
+                                                  uint32_t message_length,
+                                                  optiga_crypt_sign_message_reader_t reader,
+                                                  void * p_io_ctx,
+                                                  optiga_key_id_t private_key,
+                                                  uint8_t * signature,
+                                                  uint16_t * signature_length,
+                                                  callback_handler_t handler,
+                                                  void * caller_context)
+{
+    // The digest is calculated with SHA256 on host
+    if (OPTIGA_RSASSA_PKCS1_V15_SHA256 != signature_scheme)
+    {
+        return (OPTIGA_CRYPT_ERROR_INVALID_INPUT);
+    }
+    return (optiga_crypt_sign_message_submit(me, p_request, TRUE, signature_scheme,
+                                             message, message_length, reader, p_io_ctx, private_key,
+                                             signature, signature_length, handler, caller_context));
+}
+#endif //OPTIGA_CRYPT_RSA_SIGN_ENABLED
+
+#endif //OPTIGA_CRYPT_SIGN_MESSAGE_ENABLED
+
+/**
+* @}
+*/
@@ -0,0 +1,479 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_crypt_stream.c
+*
+* \brief   This file implements the OPTIGA Crypt stream, which encrypts and decrypts data of arbitrary length in pipelined chunks.
+*
+* \ingroup  grOptigaCrypt
+*
+* @{
+*/
+
+#include "optiga/optiga_crypt_stream.h"
+#include "optiga/common/optiga_lib_common_internal.h"
+#include "optiga/pal/pal_os_lock.h"
+#include "optiga/pal/pal_os_memory.h"
+
+#ifdef OPTIGA_CRYPT_STREAM_ENABLED
+
+/// Block size of AES
+#define OPTIGA_CRYPT_STREAM_BLOCK_SIZE      (0x10)
+
+#if (0 != (OPTIGA_CRYPT_STREAM_CHUNK_SIZE % OPTIGA_CRYPT_STREAM_BLOCK_SIZE))
+#error "OPTIGA_CRYPT_STREAM_CHUNK_SIZE must be block aligned"
+#endif
+
+/*
+* Completes the stream and invokes the callback of the caller
+*/
+_STATIC_H void optiga_crypt_stream_complete(optiga_crypt_stream_t * me, optiga_lib_status_t status)
+{
+    // Chunks of the caller data are not kept once the stream is completed
+    pal_os_memset(me->in_buffer, 0, sizeof(me->in_buffer));
+    pal_os_memset(me->out_buffer, 0, sizeof(me->out_buffer));
+    me->ongoing = FALSE;
+    if (NULL != me->caller_handler)
+    {
+        me->caller_handler(me->caller_context, status);
+    }
+}
+
+/*
+* Submits the next chunk to OPTIGA, as single operation or as part of the start, continue and final sequence
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_stream_submit(optiga_crypt_stream_t * me)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+    uint8_t index = me->submit_index;
+    uint16_t length = (uint16_t)MIN(OPTIGA_CRYPT_STREAM_CHUNK_SIZE, (me->total_length - me->submit_offset));
+    const uint8_t * p_in = (NULL != me->reader) ? me->in_buffer[index] : (me->p_input + me->submit_offset);
+    uint8_t * p_out = (NULL != me->writer) ? me->out_buffer[index] : (me->p_output + me->submit_offset);
+    uint8_t first = (0 == me->submit_offset) ? TRUE : FALSE;
+    uint8_t last = ((me->submit_offset + length) == me->total_length) ? TRUE : FALSE;
+
+    me->current_offset = me->submit_offset;
+    me->current_length = length;
+    me->out_length[index] = length;
+    me->submit_offset += length;
+    me->submit_index ^= 1U;
+
+    if (FALSE == me->decrypt)
+    {
+#ifdef OPTIGA_CRYPT_SYM_ENCRYPT_ENABLED
+        if ((TRUE == first) && (TRUE == last))
+        {
+            return_value = optiga_crypt_symmetric_encrypt(me->p_crypt, me->encryption_mode, me->symmetric_key_oid,
+                                                          p_in, length, me->p_iv, me->iv_length, NULL, 0,
+                                                          p_out, &me->out_length[index]);
+        }
+        else if (TRUE == first)
+        {
+            return_value = optiga_crypt_symmetric_encrypt_start(me->p_crypt, me->encryption_mode,
+                                                                me->symmetric_key_oid, p_in, length,
+                                                                me->p_iv, me->iv_length, NULL, 0, 0,
+                                                                p_out, &me->out_length[index]);
+        }
+        else if (TRUE == last)
+        {
+            return_value = optiga_crypt_symmetric_encrypt_final(me->p_crypt, p_in, length,
+                                                                p_out, &me->out_length[index]);
+        }
+        else
+        {
+            return_value = optiga_crypt_symmetric_encrypt_continue(me->p_crypt, p_in, length,
+                                                                   p_out, &me->out_length[index]);
+        }
+#endif
+    }
+    else
+    {
+#ifdef OPTIGA_CRYPT_SYM_DECRYPT_ENABLED
+        if ((TRUE == first) && (TRUE == last))
+        {
+            return_value = optiga_crypt_symmetric_decrypt(me->p_crypt, me->encryption_mode, me->symmetric_key_oid,
+                                                          p_in, length, me->p_iv, me->iv_length, NULL, 0,
+                                                          p_out, &me->out_length[index]);
+        }
+        else if (TRUE == first)
+        {
+            return_value = optiga_crypt_symmetric_decrypt_start(me->p_crypt, me->encryption_mode,
+                                                                me->symmetric_key_oid, p_in, length,
+                                                                me->p_iv, me->iv_length, NULL, 0, 0,
+                                                                p_out, &me->out_length[index]);
+        }
+        else if (TRUE == last)
+        {
+            return_value = optiga_crypt_symmetric_decrypt_final(me->p_crypt, p_in, length,
+                                                                p_out, &me->out_length[index]);
+        }
+        else
+        {
+            return_value = optiga_crypt_symmetric_decrypt_continue(me->p_crypt, p_in, length,
+                                                                   p_out, &me->out_length[index]);
+        }
+#endif
+    }
+    return (return_value);
+}
+
+/*
+* Reads the next chunk into the free buffer and submits it, if the current chunk is already completed
+*/
+_STATIC_H void optiga_crypt_stream_prepare(optiga_crypt_stream_t * me)
+{
+    optiga_lib_status_t status = OPTIGA_LIB_SUCCESS;
+    uint8_t submit_now = FALSE;
+    uint8_t abort_now = FALSE;
+
+    if ((NULL != me->reader) && (me->submit_offset < me->total_length))
+    {
+        status = me->reader(me->p_io_ctx,
+                            me->submit_offset,
+                            me->in_buffer[me->submit_index],
+                            (uint16_t)MIN(OPTIGA_CRYPT_STREAM_CHUNK_SIZE, (me->total_length - me->submit_offset)));
+    }
+
+    pal_os_lock_enter_critical_section();
+    if (OPTIGA_LIB_SUCCESS != status)
+    {
+        // The stream is aborted once no chunk is executed by OPTIGA anymore
+        me->abort_status = status;
+        abort_now = me->waiting;
+    }
+    else if (TRUE == me->waiting)
+    {
+        submit_now = TRUE;
+    }
+    else
+    {
+        me->next_prepared = TRUE;
+    }
+    me->waiting = FALSE;
+    pal_os_lock_exit_critical_section();
+
+    if (TRUE == abort_now)
+    {
+        optiga_crypt_stream_complete(me, status);
+    }
+    else if (TRUE == submit_now)
+    {
+        status = optiga_crypt_stream_submit(me);
+        if (OPTIGA_LIB_SUCCESS != status)
+        {
+            optiga_crypt_stream_complete(me, status);
+        }
+    }
+    else
+    {
+        // Chunk is submitted on completion of the current one
+    }
+}
+
+/*
+* Event handler of the stream instance, submits the next chunk and writes the output of the completed one
+*/
+_STATIC_H void optiga_crypt_stream_event_handler(void * p_ctx, optiga_lib_status_t event)
+{
+    optiga_crypt_stream_t * me = (optiga_crypt_stream_t *)p_ctx;
+    optiga_lib_status_t status = event;
+    uint8_t completed_index = me->submit_index ^ 1U;
+    uint32_t completed_offset = me->current_offset;
+    uint8_t submit_now = FALSE;
+
+    do
+    {
+        if (OPTIGA_LIB_SUCCESS != status)
+        {
+            break;
+        }
+        if (me->out_length[completed_index] != me->current_length)
+        {
+            status = OPTIGA_CRYPT_ERROR;
+            break;
+        }
+        status = me->abort_status;
+        if (OPTIGA_LIB_SUCCESS != status)
+        {
+            break;
+        }
+
+        // The next chunk is executed by OPTIGA, while the output of this chunk is written
+        pal_os_lock_enter_critical_section();
+        submit_now = me->next_prepared;
+        me->next_prepared = FALSE;
+        pal_os_lock_exit_critical_section();
+        if ((TRUE == submit_now) && (me->submit_offset < me->total_length))
+        {
+            status = optiga_crypt_stream_submit(me);
+            if (OPTIGA_LIB_SUCCESS != status)
+            {
+                break;
+            }
+        }
+
+        if (NULL != me->writer)
+        {
+            status = me->writer(me->p_io_ctx,
+                                completed_offset,
+                                me->out_buffer[completed_index],
+                                (uint16_t)me->out_length[completed_index]);
+            if ((OPTIGA_LIB_SUCCESS != status) && (TRUE == submit_now))
+            {
+                // Aborted on completion of the submitted chunk
+                me->abort_status = status;
+                status = OPTIGA_LIB_SUCCESS;
+                break;
+            }
+            if (OPTIGA_LIB_SUCCESS != status)
+            {
+                break;
+            }
+        }
+
+        if ((completed_offset + me->out_length[completed_index]) == me->total_length)
+        {
+            optiga_crypt_stream_complete(me, OPTIGA_LIB_SUCCESS);
+        }
+        else if (TRUE == submit_now)
+        {
+            // Buffer of the completed chunk receives the chunk after the submitted one
+            optiga_crypt_stream_prepare(me);
+        }
+        else
+        {
+            // The output is written before the reader may submit the next chunk, hence it is written in order
+            pal_os_lock_enter_critical_section();
+            submit_now = me->next_prepared;
+            me->next_prepared = FALSE;
+            // A failed read is reported either here or by the reader, once waiting is set
+            status = me->abort_status;
+            me->waiting = ((FALSE == submit_now) && (OPTIGA_LIB_SUCCESS == status)) ? TRUE : FALSE;
+            pal_os_lock_exit_critical_section();
+            if ((TRUE == submit_now) && (OPTIGA_LIB_SUCCESS == status))
+            {
+                status = optiga_crypt_stream_submit(me);
+                if (OPTIGA_LIB_SUCCESS != status)
+                {
+                    break;
+                }
+                optiga_crypt_stream_prepare(me);
+            }
+        }
+    } while (FALSE);
+
+    if (OPTIGA_LIB_SUCCESS != status)
+    {
+        optiga_crypt_stream_complete(me, status);
+    }
+}
+
+/*
+* Starts the stream with the first chunk and reads the second one, while the first is executed by OPTIGA
+*/
+_STATIC_H optiga_lib_status_t optiga_crypt_stream_start(optiga_crypt_stream_t * me,
+                                                        uint8_t decrypt,
+                                                        optiga_symmetric_encryption_mode_t encryption_mode,
+                                                        optiga_key_id_t symmetric_key_oid,
+                                                        const uint8_t * iv,
+                                                        uint16_t iv_length,
+                                                        const uint8_t * p_input,
+                                                        optiga_crypt_stream_reader_t reader,
+                                                        uint32_t length,
+                                                        uint8_t * p_output,
+                                                        optiga_crypt_stream_writer_t writer,
+                                                        void * p_io_ctx)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->p_crypt))
+        {
+            break;
+        }
+#endif
+        if (((NULL == p_input) && (NULL == reader)) || ((NULL == p_output) && (NULL == writer)) ||
+            (0 == length) || (0 != (length % OPTIGA_CRYPT_STREAM_BLOCK_SIZE)) ||
+            ((OPTIGA_SYMMETRIC_ECB != encryption_mode) && (OPTIGA_SYMMETRIC_CBC != encryption_mode)))
+        {
+            break;
+        }
+
+        pal_os_lock_enter_critical_section();
+        if (TRUE == me->ongoing)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+        }
+        me->ongoing = TRUE;
+        pal_os_lock_exit_critical_section();
+        if (OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE == return_value)
+        {
+            break;
+        }
+
+        me->decrypt = decrypt;
+        me->encryption_mode = encryption_mode;
+        me->symmetric_key_oid = symmetric_key_oid;
+        me->p_iv = iv;
+        me->iv_length = iv_length;
+        me->p_input = p_input;
+        me->reader = (NULL == p_input) ? reader : NULL;
+        me->p_output = p_output;
+        me->writer = (NULL == p_output) ? writer : NULL;
+        me->p_io_ctx = p_io_ctx;
+        me->total_length = length;
+        me->submit_offset = 0;
+        me->submit_index = 0;
+        me->abort_status = OPTIGA_LIB_SUCCESS;
+        me->next_prepared = FALSE;
+        me->waiting = FALSE;
+
+        return_value = OPTIGA_LIB_SUCCESS;
+        if (NULL != me->reader)
+        {
+            return_value = me->reader(me->p_io_ctx, 0, me->in_buffer[0],
+                                      (uint16_t)MIN(OPTIGA_CRYPT_STREAM_CHUNK_SIZE, length));
+        }
+        if (OPTIGA_LIB_SUCCESS == return_value)
+        {
+            return_value = optiga_crypt_stream_submit(me);
+        }
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            me->ongoing = FALSE;
+            break;
+        }
+        optiga_crypt_stream_prepare(me);
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_stream_init(optiga_crypt_stream_t * me,
+                                             uint8_t optiga_instance_id,
+                                             callback_handler_t handler,
+                                             void * caller_context)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        pal_os_memset(me, 0, sizeof(optiga_crypt_stream_t));
+        me->caller_handler = handler;
+        me->caller_context = caller_context;
+
+        return_value = OPTIGA_CRYPT_ERROR;
+        me->p_crypt = optiga_crypt_create(optiga_instance_id, optiga_crypt_stream_event_handler, me);
+        if (NULL == me->p_crypt)
+        {
+            break;
+        }
+        return_value = OPTIGA_CRYPT_SUCCESS;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_crypt_stream_deinit(optiga_crypt_stream_t * me)
+{
+    optiga_lib_status_t return_value = OPTIGA_CRYPT_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        if (TRUE == me->ongoing)
+        {
+            return_value = OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        if (NULL != me->p_crypt)
+        {
+            //lint --e{534} suppress "Instance is free, return value is not required to be checked"
+            optiga_crypt_destroy(me->p_crypt);
+        }
+        pal_os_memset(me, 0, sizeof(optiga_crypt_stream_t));
+        return_value = OPTIGA_CRYPT_SUCCESS;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+#ifdef OPTIGA_CRYPT_SYM_ENCRYPT_ENABLED
+optiga_lib_status_t optiga_crypt_stream_encrypt(optiga_crypt_stream_t * me,
+                                                optiga_symmetric_encryption_mode_t encryption_mode,
+                                                optiga_key_id_t symmetric_key_oid,
+                                                const uint8_t * iv,
+                                                uint16_t iv_length,
+                                                const uint8_t * plain_data,
+                                                optiga_crypt_stream_reader_t reader,
+                                                uint32_t plain_data_length,
+                                                uint8_t * encrypted_data,
+                                                optiga_crypt_stream_writer_t writer,
+                                                void * p_io_ctx)
+{
+    return (optiga_crypt_stream_start(me, FALSE, encryption_mode, symmetric_key_oid, iv, iv_length,
+                                      plain_data, reader, plain_data_length, encrypted_data, writer, p_io_ctx));
+}
+#endif //OPTIGA_CRYPT_SYM_ENCRYPT_ENABLED
+
+#ifdef OPTIGA_CRYPT_SYM_DECRYPT_ENABLED
+optiga_lib_status_t optiga_crypt_stream_decrypt(optiga_crypt_stream_t * me,
+                                                optiga_symmetric_encryption_mode_t encryption_mode,
+                                                optiga_key_id_t symmetric_key_oid,
+                                                const uint8_t * iv,
+                                                uint16_t iv_length,
+                                                const uint8_t * encrypted_data,
+                                                optiga_crypt_stream_reader_t reader,
+                                                uint32_t encrypted_data_length,
+                                                uint8_t * plain_data,
+                                                optiga_crypt_stream_writer_t writer,
+                                                void * p_io_ctx)
+{
+    return (optiga_crypt_stream_start(me, TRUE, encryption_mode, symmetric_key_oid, iv, iv_length,
+                                      encrypted_data, reader, encrypted_data_length, plain_data, writer, p_io_ctx));
+}
+#endif //OPTIGA_CRYPT_SYM_DECRYPT_ENABLED
+
+#endif //OPTIGA_CRYPT_STREAM_ENABLED
+
+/**
+* @}
+*/
@@ -50,6 +50,165 @@ typedef struct optiga_cmd optiga_cmd_t;
 /** \brief OPTIGA comms instance structure type*/
 typedef struct optiga_context optiga_context_t;
 
+/**
+ * \brief The structure represents the slot in the execution queue (instance registry).
+ *
+ * \details
+ * The members are maintained by OPTIGA cmd only. The type is exposed to allocate a registry using #optiga_cmd_set_registry.
+ */
+typedef struct optiga_cmd_queue_slot
+{
+    /// Registered context
+    void * registered_ctx;
+    /// Arrival time of the optiga cmd instance in the execution queue
+    uint32_t arrival_time;
+#ifdef OPTIGA_CMD_DEADLINE_ENABLED
+    /// Time in microseconds after the arrival time, at which the request expires, 0 if the request does not expire
+    uint32_t deadline;
+#endif //OPTIGA_CMD_DEADLINE_ENABLED
+#ifdef OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+    /// Time in microseconds after the arrival time, till which the request waits for a restore, 0 if not deferrable
+    uint32_t defer_delay;
+#endif //OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+#ifdef OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+    /// Dispatch time of the request in service, 0 if the request is not measured
+    uint32_t dispatch_time;
+#endif //OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+    /// Request for command lock or session
+    uint8_t request_type;
+    /// state of the slot
+    uint8_t state_of_entry;
+    /// Priority class of the request
+    uint8_t priority;
+#ifdef OPTIGA_CMD_FAIR_SHARE_ENABLED
+    /// Tenant of the request
+    uint8_t tenant;
+#endif //OPTIGA_CMD_FAIR_SHARE_ENABLED
+    /// Next slot in the ready list of the priority class
+    uint8_t next_index;
+    /// Previous slot in the ready list of the priority class
+    uint8_t previous_index;
+    /// Next slot in the submission queue
+    struct optiga_cmd_queue_slot * volatile p_next_submission;
+    /// Context which has submitted the pending request
+    void * submitted_ctx;
+    /// Submission time of the pending request
+    uint32_t submitted_time;
+    /// Request type of the pending request
+    uint8_t submitted_request_type;
+}optiga_cmd_queue_slot_t;
+
+/**
+ * \brief Assigns a caller supplied registry to the execution queue of an OPTIGA instance.
+ *
+ * \details
+ * Assigns a caller supplied registry to the execution queue of an OPTIGA instance.
+ * - Each slot of the registry holds one #optiga_cmd_t instance, which limits the number of instances to registry_size.<br>
+ * - The default registry supports OPTIGA_CMD_MAX_REGISTRATIONS number of instances.<br>
+ *
+ * \pre
+ * - No #optiga_cmd_t instance is created for the OPTIGA instance, or all are destroyed.
+ *
+ * \note
+ * - The registry must be valid until all the instances of the OPTIGA instance are destroyed.
+ * - The content of the registry is initialized by this API.
+ *
+ * \param[in] optiga_instance_id              Indicates the OPTIGA configuration to associate with registry.
+ * \param[in] p_registry                      Pointer to array of slots, must not be NULL.
+ * \param[in] registry_size                   Number of slots in registry, must be in the range 1 to 254.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS              Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR_INVALID_INPUT  Invalid OPTIGA instance, registry or registry size.
+ * \retval    #OPTIGA_CMD_ERROR                Instances are registered with OPTIGA instance.
+ */
+optiga_lib_status_t optiga_cmd_set_registry(uint8_t optiga_instance_id,
+                                            optiga_cmd_queue_slot_t * p_registry,
+                                            uint8_t registry_size);
+
+#if defined (OPTIGA_COMMS_SHIELDED_CONNECTION) && defined (OPTIGA_COMMS_PROTECTION_POLICY_ENABLED)
+/// Command code of GetDataObject for #optiga_protection_policy_t
+#define OPTIGA_PROTECTION_POLICY_GET_DATA_OBJECT        (0x01)
+/// Command code of SetDataObject for #optiga_protection_policy_t
+#define OPTIGA_PROTECTION_POLICY_SET_DATA_OBJECT        (0x02)
+/// Command code of SetObjectProtected for #optiga_protection_policy_t
+#define OPTIGA_PROTECTION_POLICY_SET_OBJECT_PROTECTED   (0x03)
+/// Command code of GetRandom for #optiga_protection_policy_t
+#define OPTIGA_PROTECTION_POLICY_GET_RANDOM             (0x0C)
+/// Command code of EncryptSym for #optiga_protection_policy_t
+#define OPTIGA_PROTECTION_POLICY_ENCRYPT_SYM            (0x14)
+/// Command code of DecryptSym for #optiga_protection_policy_t
+#define OPTIGA_PROTECTION_POLICY_DECRYPT_SYM            (0x15)
+/// Command code of EncryptAsym for #optiga_protection_policy_t
+#define OPTIGA_PROTECTION_POLICY_ENCRYPT_ASYM           (0x1E)
+/// Command code of DecryptAsym for #optiga_protection_policy_t
+#define OPTIGA_PROTECTION_POLICY_DECRYPT_ASYM           (0x1F)
+/// Command code of CalcHash for #optiga_protection_policy_t
+#define OPTIGA_PROTECTION_POLICY_CALC_HASH              (0x30)
+/// Command code of CalcSign for #optiga_protection_policy_t
+#define OPTIGA_PROTECTION_POLICY_CALC_SIGN              (0x31)
+/// Command code of VerifySign for #optiga_protection_policy_t
+#define OPTIGA_PROTECTION_POLICY_VERIFY_SIGN            (0x32)
+/// Command code of CalcSSec for #optiga_protection_policy_t
+#define OPTIGA_PROTECTION_POLICY_CALC_SSEC              (0x33)
+/// Command code of DeriveKey for #optiga_protection_policy_t
+#define OPTIGA_PROTECTION_POLICY_DERIVE_KEY             (0x34)
+/// Command code of GenKeyPair for #optiga_protection_policy_t
+#define OPTIGA_PROTECTION_POLICY_GEN_KEYPAIR            (0x38)
+/// Command code of GenSymKey for #optiga_protection_policy_t
+#define OPTIGA_PROTECTION_POLICY_GEN_SYM_KEY            (0x39)
+/// Entry of #optiga_protection_policy_t applies to all the OIDs of the command
+#define OPTIGA_PROTECTION_POLICY_ANY_OID                (0xFFFF)
+
+/**
+ * \brief The structure represents an entry of the protection policy table of an OPTIGA instance.
+ *
+ * \details
+ * The protection level of the entry is applied to each APDU of the command, instead of the default protection level
+ * of the requesting instance. The OID is compared for GetDataObject, SetDataObject and SetObjectProtected only,
+ * other commands must use #OPTIGA_PROTECTION_POLICY_ANY_OID.
+ */
+typedef struct optiga_protection_policy
+{
+    /// Command code, value of OPTIGA_PROTECTION_POLICY_* command codes
+    uint8_t command;
+    /// Object ID accessed by the command or #OPTIGA_PROTECTION_POLICY_ANY_OID
+    uint16_t oid;
+    /// Protection level of the command (#OPTIGA_COMMS_NO_PROTECTION to #OPTIGA_COMMS_FULL_PROTECTION)
+    uint8_t protection_level;
+}optiga_protection_policy_t;
+
+/**
+ * \brief Assigns a caller supplied protection policy table to an OPTIGA instance.
+ *
+ * \details
+ * Assigns a caller supplied protection policy table to an OPTIGA instance.
+ * - The first entry matching the command (and OID) of an APDU provides the protection level of the APDU.<br>
+ * - Sensitive commands (e.g. export of keys, writes of the shared secret) are shielded always,
+ *   commands on public data (e.g. reads of certificates, verifications) skip the shielding.<br>
+ * - The table applies only to the requests at #OPTIGA_COMMS_DEFAULT_PROTECTION_LEVEL. A protection level set for the
+ *   call is kept, hence the table never lowers it.<br>
+ * - APDUs without matching entry use the protection level of the requesting instance.<br>
+ * - A re-establish of the shielded connection requested for the call (#OPTIGA_COMMS_RE_ESTABLISH) is kept.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The table must be valid, until it is replaced. NULL removes the table.
+ * - To be invoked once at initialization, before the requests are started.
+ *
+ * \param[in] optiga_instance_id              Indicates the OPTIGA configuration to associate with protection policy.
+ * \param[in] p_policy                        Pointer to array of entries, NULL if policy_count is 0.
+ * \param[in] policy_count                    Number of entries in the table.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS              Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR_INVALID_INPUT  Invalid OPTIGA instance, table or entry.
+ */
+optiga_lib_status_t optiga_cmd_set_protection_policy(uint8_t optiga_instance_id,
+                                                     const optiga_protection_policy_t * p_policy,
+                                                     uint8_t policy_count);
+#endif //(OPTIGA_COMMS_SHIELDED_CONNECTION) && (OPTIGA_COMMS_PROTECTION_POLICY_ENABLED)
+
 /**
  * \brief Creates an instance of #optiga_cmd_t.
  *
@@ -66,12 +225,14 @@ typedef struct optiga_context optiga_context_t;
  * - None
  *
  * \param[in] optiga_instance_id  Indicates the OPTIGA configuration to associate with instance.
+ *                                Use #OPTIGA_INSTANCE_ID_ANY to associate with the least loaded OPTIGA instance.
  * \param[in] handler             Pointer to callback function, must not be NULL.
  * \param[in] caller_context      Pointer to upper layer context.
  *
  * \retval    #optiga_cmd_t *     On successful instance creation.
  * \retval    NULL                Memory allocation failure.
- *                                Already, OPTIGA_CMD_MAX_REGISTRATIONS number of instances is created.
+ *                                Already, all slots of the registry (OPTIGA_CMD_MAX_REGISTRATIONS by default)
+ *                                are assigned to instances. Refer #optiga_cmd_set_registry.
  */
 optiga_cmd_t * optiga_cmd_create(uint8_t optiga_instance_id,
                                  callback_handler_t handler,
@@ -119,6 +280,1230 @@ optiga_lib_status_t optiga_cmd_destroy(optiga_cmd_t * me);
  */
 optiga_lib_status_t optiga_cmd_release_lock(const optiga_cmd_t * me);
 
+/**
+ * \brief Sets the priority class of the instance in execution queue.
+ *
+ * \details
+ * Sets the priority class of the instance in execution queue.
+ * - Requests of higher priority class are dispatched first.<br>
+ * - Requests of same priority class are dispatched in order of arrival.<br>
+ * - A waiting request is promoted by one class for every <b>OPTIGA_CMD_PRIORITY_AGING_TIME_US</b>.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The priority is applied from the next request of the instance.
+ *
+ * \param[in] me                                Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in] priority                          Priority class as defined in #optiga_lib_priority_t.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR_INVALID_INPUT    Invalid priority class.
+ */
+optiga_lib_status_t optiga_cmd_set_priority(optiga_cmd_t * me,
+                                            uint8_t priority);
+
+#ifdef OPTIGA_CMD_DEADLINE_ENABLED
+/**
+ * \brief Sets the deadline of the requests of the instance in execution queue.
+ *
+ * \details
+ * Sets the deadline of the requests of the instance in execution queue.
+ * - A request, which is not dispatched within deadline_us after its arrival, is dropped by the scheduler.<br>
+ * - The dropped request completes with #OPTIGA_CMD_ERROR_DEADLINE_EXPIRED, without being sent to OPTIGA.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The deadline is applied from the next request of the instance.
+ * - A request, which is dispatched already, is not affected by the deadline.
+ * - A deadline of 0 lets the requests wait till they are dispatched.
+ *
+ * \param[in] me                                Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in] deadline_us                       Deadline in microseconds after the arrival, 0 for no deadline.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ */
+optiga_lib_status_t optiga_cmd_set_deadline(optiga_cmd_t * me,
+                                            uint32_t deadline_us);
+#endif //OPTIGA_CMD_DEADLINE_ENABLED
+
+#ifdef OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+/**
+ * \brief Marks the requests of the instance as deferrable, while the application is hibernated.
+ *
+ * \details
+ * Sets the maximum delay, for which the requests of the instance wait for a restore of the hibernated application.
+ * - A deferrable request does not restore the application, it is served once a request which is not deferrable
+ *   restores the application, or once its maximum delay after the arrival elapses.<br>
+ * - All the deferrable requests waiting are served after the same restore.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The maximum delay is applied from the next request of the instance.
+ * - While the application is open, the deferrable requests are served without delay.
+ *
+ * \param[in] me                                Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in] max_delay_ms                      Maximum delay in milliseconds, 0 if the requests are not deferrable.
+ *                                              - Must not be greater than #OPTIGA_CMD_AUTO_HIBERNATE_MAX_IDLE_TIME_MS.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR_INVALID_INPUT    Invalid maximum delay.
+ */
+optiga_lib_status_t optiga_cmd_set_deferrable(optiga_cmd_t * me,
+                                              uint32_t max_delay_ms);
+#endif //OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+
+#ifdef OPTIGA_CMD_CANCEL_ENABLED
+/**
+ * \brief Cancels the ongoing request of the instance.
+ *
+ * \details
+ * Cancels the ongoing request of the instance.
+ * - A request, which is waiting in the execution queue, is dropped by the scheduler without being sent to OPTIGA.<br>
+ * - The result of a request, which is dispatched already, is discarded once OPTIGA responds.<br>
+ * - The remaining items of an ongoing batch are not executed.<br>
+ * - The handler of the instance is invoked with #OPTIGA_CMD_ERROR_CANCELLED in both cases.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This can be called from any thread. The cancellation applies till the next request of the instance is started.
+ *
+ * \param[in] me                                Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ */
+optiga_lib_status_t optiga_cmd_cancel(optiga_cmd_t * me);
+#endif //OPTIGA_CMD_CANCEL_ENABLED
+
+#ifdef OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+/// Maximum hold time of a strict lock between two steps in milliseconds
+#define OPTIGA_CMD_STRICT_LOCK_MAX_HOLD_TIME_MS                 (3600000U)
+
+/**
+ * \brief Sets the maximum time, for which a strict lock is held between two steps of a sequence.
+ *
+ * \details
+ * Sets the hold time of the strict locks of the OPTIGA associated with the instance.
+ * - Once a step of a sequence under strict lock is completed, the next step must be sent within the hold time,
+ *   if further requests wait in the execution queue. Otherwise the scheduler revokes the strict lock and serves
+ *   the waiting requests.<br>
+ * - The next continue or final of the revoked sequence completes with #OPTIGA_CMD_ERROR_STRICT_LOCK_REVOKED and
+ *   the sequence is to be started again.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - A step in execution is not interrupted and the strict lock is not revoked, while no other request waits.
+ * - Sequences with the context exported to host (e.g. hash with the context in host memory) release the lock
+ *   after each step, hence they are not affected.
+ *
+ * \param[in] me                               Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in] max_hold_time_ms                 Hold time in milliseconds, 0 holds the strict lock till the sequence is finalized.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR_INVALID_INPUT    Hold time is above #OPTIGA_CMD_STRICT_LOCK_MAX_HOLD_TIME_MS.
+ */
+optiga_lib_status_t optiga_cmd_set_strict_lock_timeout(optiga_cmd_t * me, uint32_t max_hold_time_ms);
+#endif //OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+
+#ifdef OPTIGA_CMD_FAIR_SHARE_ENABLED
+/// Weight of a tenant, whose weight is not set
+#define OPTIGA_CMD_FAIR_SHARE_DEFAULT_WEIGHT                    (0x01)
+
+/**
+ * \brief Sets the tenant of the instance, among which OPTIGA is shared.
+ *
+ * \details
+ * Sets the tenant, to which the requests of the instance are accounted.
+ * - Within a priority class, the requests of the tenant are served first, which has consumed the least OPTIGA
+ *   time relative to its weight. The requests of a tenant are served in order of arrival.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The tenant is applied from the next request of the instance.
+ * - The instances without a tenant and the internal requests of OPTIGA cmd are accounted to tenant 0.
+ *
+ * \param[in] me                                Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in] tenant                            Tenant, less than OPTIGA_CMD_FAIR_SHARE_MAX_TENANTS.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR_INVALID_INPUT    Invalid tenant.
+ */
+optiga_lib_status_t optiga_cmd_set_tenant(optiga_cmd_t * me, uint8_t tenant);
+
+/**
+ * \brief Sets the weight of a tenant of the OPTIGA associated with the instance.
+ *
+ * \details
+ * Sets the weight of a tenant, which applies to all the instances of the tenant.
+ * - While several tenants wait in a priority class, each tenant is served with the share of the OPTIGA time
+ *   weight / sum of the weights of the waiting tenants.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Default weight of each tenant is #OPTIGA_CMD_FAIR_SHARE_DEFAULT_WEIGHT, a weight of 0 sets the default weight.
+ *
+ * \param[in] me                                Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in] tenant                            Tenant, less than OPTIGA_CMD_FAIR_SHARE_MAX_TENANTS.
+ * \param[in] weight                            Weight of the tenant.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR_INVALID_INPUT    Invalid tenant.
+ */
+optiga_lib_status_t optiga_cmd_set_tenant_weight(optiga_cmd_t * me, uint8_t tenant, uint8_t weight);
+
+/**
+ * \brief Retrieves the weight and the consumed OPTIGA time of a tenant.
+ *
+ * \details
+ * Retrieves the weight, the served requests and the consumed OPTIGA time of a tenant of the OPTIGA associated with the instance.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]  me                               Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in]  tenant                           Tenant, less than OPTIGA_CMD_FAIR_SHARE_MAX_TENANTS.
+ * \param[out] p_stats                          Valid pointer to store the statistics.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR_INVALID_INPUT    Invalid tenant.
+ */
+optiga_lib_status_t optiga_cmd_get_tenant_stats(const optiga_cmd_t * me,
+                                                uint8_t tenant,
+                                                optiga_lib_tenant_stats_t * p_stats);
+#endif //OPTIGA_CMD_FAIR_SHARE_ENABLED
+
+#ifdef OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+/**
+ * \brief Checks, whether a request of the instance is served within the maximum waiting time.
+ *
+ * \details
+ * Estimates the waiting time of a request, which is queued now, and compares it against the maximum waiting time.
+ * - The request waits for each request in the execution queue and the request in service, which take the average
+ *   service time measured from dispatch till the release of the slot.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The request is not queued, the caller invokes the operation if admitted.
+ * - A rejection is counted in the rejected requests of #optiga_cmd_get_queue_load.
+ *
+ * \param[in]  me                               Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in]  max_wait_us                      Maximum waiting time in microseconds.
+ * \param[out] p_estimated_wait_us              Pointer to store the estimated waiting time, can be NULL.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Estimated waiting time is within the maximum waiting time.
+ * \retval    #OPTIGA_CMD_ERROR_QUEUE_FULL       Estimated waiting time exceeds the maximum waiting time.
+ */
+optiga_lib_status_t optiga_cmd_try_admit(const optiga_cmd_t * me, uint32_t max_wait_us, uint32_t * p_estimated_wait_us);
+
+/**
+ * \brief Sets the watermarks of the waiting requests and the callback, which reports their crossing.
+ *
+ * \details
+ * Sets the watermarks of the execution queue of the OPTIGA associated with the instance.
+ * - The callback is invoked with is_high TRUE, once the number of waiting requests reaches the high watermark.<br>
+ * - The callback is invoked with is_high FALSE, once the number of waiting requests falls to the low watermark.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The callback is invoked in the context of the command scheduler, hence must not wait for OPTIGA.
+ * - A NULL callback disables the watermarks.
+ *
+ * \param[in] me                                Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in] high_watermark                    Number of waiting requests reporting the high load, at most the registry size.
+ * \param[in] low_watermark                     Number of waiting requests reporting the normal load, less than high_watermark.
+ * \param[in] callback                          Watermark callback, NULL to disable.
+ * \param[in] context                           Context passed to the callback.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR_INVALID_INPUT    Invalid watermarks.
+ */
+optiga_lib_status_t optiga_cmd_set_queue_watermark(const optiga_cmd_t * me,
+                                                   uint8_t high_watermark,
+                                                   uint8_t low_watermark,
+                                                   optiga_lib_queue_watermark_callback_t callback,
+                                                   void * context);
+
+/**
+ * \brief Retrieves the load of the execution queue.
+ *
+ * \details
+ * Retrieves the waiting requests, the free slots, the average service time and the estimated waiting time of the
+ * execution queue of the OPTIGA associated with the instance.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]  me                               Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[out] p_load                           Pointer to the load, must not be NULL.
+ */
+void optiga_cmd_get_queue_load(const optiga_cmd_t * me, optiga_lib_queue_load_t * p_load);
+#endif //OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+
+/**
+ * \brief Retrieves the waiting time statistics of a priority class in execution queue.
+ *
+ * \details
+ * Retrieves the waiting time statistics of a priority class in execution queue of the OPTIGA associated with the instance.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]  me                               Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in]  priority                         Priority class as defined in #optiga_lib_priority_t.
+ * \param[out] p_stats                          Pointer to statistics, must not be NULL.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR_INVALID_INPUT    Invalid priority class.
+ */
+optiga_lib_status_t optiga_cmd_get_queue_wait_stats(const optiga_cmd_t * me,
+                                                    uint8_t priority,
+                                                    optiga_lib_queue_wait_stats_t * p_stats);
+
+#ifdef OPTIGA_CMD_SESSION_POOL_ENABLED
+/**
+ * \brief Sets the acquisition policy and the lease time of the session of the instance.
+ *
+ * \details
+ * Sets the acquisition policy and the lease time of the session of the instance.
+ * - With #OPTIGA_LIB_SESSION_FAIL_FAST, a request which needs a session fails with #OPTIGA_CMD_ERROR_SESSION_UNAVAILABLE,
+ *   if no session is free or expired.<br>
+ * - The session assigned to the instance is freed by the scheduler, once the lease time is elapsed and the instance
+ *   has no request in the execution queue.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The lease of an already assigned session starts again with the new lease time.
+ * - A lease time of 0 keeps the session till it is released.
+ *
+ * \param[in] me                                Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in] policy                            Acquisition policy as defined in #optiga_lib_session_policy_t.
+ * \param[in] lease_time_us                     Lease time of the session in microseconds.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR_INVALID_INPUT    Invalid policy.
+ */
+optiga_lib_status_t optiga_cmd_set_session_policy(optiga_cmd_t * me,
+                                                  uint8_t policy,
+                                                  uint32_t lease_time_us);
+
+/**
+ * \brief Retrieves the usage of the session contexts.
+ *
+ * \details
+ * Retrieves the usage of the session contexts of the OPTIGA associated with the instance.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]  me                               Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[out] p_stats                          Pointer to statistics, must not be NULL.
+ */
+void optiga_cmd_get_session_pool_stats(const optiga_cmd_t * me,
+                                       optiga_lib_session_pool_stats_t * p_stats);
+
+/**
+ * \brief Releases the session assigned to the instance.
+ *
+ * \details
+ * Releases the session assigned to the instance and wakes up the requests waiting for a session.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The key stored in the session context is lost.
+ *
+ * \param[in] me                                Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ *
+ * \retval    #OPTIGA_CMD_SUCCESS                Successful invocation.
+ */
+optiga_lib_status_t optiga_cmd_release_session(optiga_cmd_t * me);
+#endif //OPTIGA_CMD_SESSION_POOL_ENABLED
+
+#ifdef OPTIGA_COMMS_DL_RESEND_BACKOFF_ENABLED
+/**
+ * \brief Retrieves the error recovery statistics of the communication.
+ *
+ * \details
+ * Retrieves the error recovery statistics of the communication with the OPTIGA associated with the instance.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]  me                               Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[out] p_stats                          Pointer to statistics, must not be NULL.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR                  Statistics are not available.
+ */
+optiga_lib_status_t optiga_cmd_get_comms_recovery_stats(const optiga_cmd_t * me,
+                                                        optiga_lib_comms_recovery_stats_t * p_stats);
+#endif
+
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+/**
+ * \brief Retrieves the runtime statistics.
+ *
+ * \details
+ * Retrieves the statistics of the commands and the execution queue of the OPTIGA associated with the instance,
+ * along with the link statistics of the communication.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]  me                               Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[out] p_stats                          Pointer to statistics, must not be NULL.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR                  Statistics are not available.
+ */
+optiga_lib_status_t optiga_cmd_get_statistics(const optiga_cmd_t * me,
+                                              optiga_lib_statistics_t * p_stats);
+#endif
+
+#ifdef OPTIGA_LIB_FAST_RESUME_ENABLED
+/**
+ * \brief Retrieves the latency statistics of the application restore.
+ *
+ * \details
+ * Retrieves the latency statistics of the application restore from hibernate of the OPTIGA associated with the instance.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]  me                               Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[out] p_stats                          Pointer to statistics, must not be NULL.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ */
+optiga_lib_status_t optiga_cmd_get_resume_stats(const optiga_cmd_t * me,
+                                                optiga_lib_resume_stats_t * p_stats);
+#endif
+
+#ifdef OPTIGA_CMD_HEALTH_MONITOR_ENABLED
+/**
+ * \brief Retrieves the statistics of the recovery from communication failures.
+ *
+ * \details
+ * Retrieves the statistics of the resets and recoveries of the OPTIGA associated with the instance.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]  me                               Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[out] p_stats                          Pointer to statistics, must not be NULL.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ */
+optiga_lib_status_t optiga_cmd_get_health_stats(const optiga_cmd_t * me,
+                                                optiga_lib_health_stats_t * p_stats);
+#endif //OPTIGA_CMD_HEALTH_MONITOR_ENABLED
+
+#ifdef OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+/// Maximum idle time of the command queue in milliseconds, after which the application is hibernated
+#define OPTIGA_CMD_AUTO_HIBERNATE_MAX_IDLE_TIME_MS              (3600000U)
+
+/**
+ * \brief Sets the idle time, after which the application on OPTIGA is hibernated.
+ *
+ * \details
+ * Sets the idle time of the execution queue of the OPTIGA associated with the instance, after which the application is hibernated.
+ * - The scheduler hibernates the application, once no request is queued or executed for the idle time.<br>
+ * - The application is restored on the next request, before the request is served.<br>
+ * - The hibernate and restore are executed with an internal instance, which is created on first use and occupies one registration.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The hibernate is applied only, if the application is opened using #optiga_cmd_open_application.
+ * - A hibernated application is restored on the next request, even if the auto hibernate is disabled meanwhile.
+ *
+ * \param[in] me                               Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in] idle_time_ms                     Idle time in milliseconds, 0 disables the auto hibernate.
+ *                                             - Must not be greater than #OPTIGA_CMD_AUTO_HIBERNATE_MAX_IDLE_TIME_MS.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR_INVALID_INPUT    Invalid idle time.
+ * \retval    #OPTIGA_CMD_ERROR                  Creation of the internal instance failed.
+ */
+optiga_lib_status_t optiga_cmd_set_auto_hibernate(optiga_cmd_t * me, uint32_t idle_time_ms);
+
+/**
+ * \brief Retrieves the statistics of the auto hibernate.
+ *
+ * \details
+ * Retrieves the idle time, the hibernate and restore counters and the restore latency of the OPTIGA associated with the instance.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]  me                               Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[out] p_stats                          Pointer to statistics, must not be NULL.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ */
+optiga_lib_status_t optiga_cmd_get_auto_hibernate_stats(const optiga_cmd_t * me,
+                                                        optiga_lib_auto_hibernate_stats_t * p_stats);
+
+#ifdef OPTIGA_CMD_LAZY_OPEN_ENABLED
+/**
+ * \brief Enables the open of the application on the first request.
+ *
+ * \details
+ * Enables the lazy open of the OPTIGA associated with the instance.
+ * - While the application is closed, the scheduler opens the communication and the application with the internal
+ *   instance of the auto hibernate, once a request is queued. The request is served after the open.<br>
+ * - With pre-open, the scheduler opens the application right away in the background.<br>
+ * - A queued open or close application is served as it is, without the lazy open.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - If the lazy open fails, the queued requests are served and fail. The open is tried again for the requests
+ *   queued after that.
+ *
+ * \param[in] me                               Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in] enable                           TRUE to enable, FALSE to disable the lazy open.
+ * \param[in] pre_open                         TRUE to open the application without waiting for a request.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR                  Creation of the internal instance failed.
+ */
+optiga_lib_status_t optiga_cmd_set_lazy_open(optiga_cmd_t * me, bool_t enable, bool_t pre_open);
+#endif //OPTIGA_CMD_LAZY_OPEN_ENABLED
+
+#ifdef OPTIGA_CMD_PERFORMANCE_GOVERNOR_ENABLED
+/// Minimum current limitation of OPTIGA in mA
+#define OPTIGA_CMD_CURRENT_LIMIT_MIN                            (0x06)
+/// Maximum current limitation of OPTIGA in mA
+#define OPTIGA_CMD_CURRENT_LIMIT_MAX                            (0x0F)
+
+/**
+ * \brief Sets the policy of the performance governor.
+ *
+ * \details
+ * Sets the policy, with which the scheduler writes the current limitation (0xE0C4) of the OPTIGA associated with the instance.
+ * - The burst current limitation is written, once the number of waiting requests reaches the burst queue depth.<br>
+ * - The idle current limitation is written, once no request is queued or executed for the idle time.<br>
+ * - Both are bounded by the power budget. Further writes are done not earlier than the hold time after the last
+ *   write, except for a current limitation above a lowered power budget.<br>
+ * - The writes are executed with the internal instance of the auto hibernate, which is created on first use.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The current limitation is written only, while the application is opened using #optiga_cmd_open_application.
+ *
+ * \param[in] me                               Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in] p_policy                         Policy, NULL disables the governor. The current limitation is kept as it is.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR_INVALID_INPUT    Invalid policy.
+ * \retval    #OPTIGA_CMD_ERROR                  Creation of the internal instance failed.
+ */
+optiga_lib_status_t optiga_cmd_set_performance_policy(optiga_cmd_t * me,
+                                                      const optiga_lib_performance_policy_t * p_policy);
+
+/**
+ * \brief Sets the power budget of the performance governor.
+ *
+ * \details
+ * Sets the maximum current limitation, which the governor writes for the OPTIGA associated with the instance.
+ * - A current limitation above the new power budget is dropped with the next scheduler run.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in] me                               Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in] max_current_limit                Maximum current limitation in mA (6 - 15), 0 removes the power budget.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR_INVALID_INPUT    Invalid current limitation.
+ */
+optiga_lib_status_t optiga_cmd_set_power_budget(optiga_cmd_t * me, uint8_t max_current_limit);
+
+/**
+ * \brief Retrieves the state and statistics of the performance governor.
+ *
+ * \details
+ * Retrieves the current limitation set by the governor, the power budget and the write counters of the OPTIGA
+ * associated with the instance.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]  me                               Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[out] p_stats                          Pointer to statistics, must not be NULL.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ */
+optiga_lib_status_t optiga_cmd_get_performance_stats(const optiga_cmd_t * me,
+                                                     optiga_lib_performance_stats_t * p_stats);
+#endif //OPTIGA_CMD_PERFORMANCE_GOVERNOR_ENABLED
+
+#ifdef OPTIGA_CMD_SEC_PACING_ENABLED
+/**
+ * \brief Sets the policy of the pacing of the requests, which raise the security event counter (SEC).
+ *
+ * \details
+ * Sets the policy, with which the scheduler paces the SEC raising requests of the OPTIGA associated with the instance.
+ * - The SEC (0xE0C5) is read once the policy is set and after each failed SEC raising command. In between, the SEC
+ *   is estimated from the last read SEC and the decay time.<br>
+ * - The SEC raising requests (DecryptSym for the HMAC verification, SetObjectProtected) wait, while the estimated SEC
+ *   is at or above the threshold. Further requests are served meanwhile.<br>
+ * - While a SEC raising request waits, the SEC is read again after the refresh time, if set.<br>
+ * - The reads are executed with the internal instance of the auto hibernate, which is created on first use.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The SEC is read only, while the application is opened using #optiga_cmd_open_application.
+ * - A sequence, which holds the strict lock (e.g. the continue of a protected update), is not paced.
+ *
+ * \param[in] me                               Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in] p_policy                         Policy, NULL disables the pacing.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR_INVALID_INPUT    Invalid policy.
+ * \retval    #OPTIGA_CMD_ERROR                  Creation of the internal instance failed.
+ */
+optiga_lib_status_t optiga_cmd_set_sec_policy(optiga_cmd_t * me, const optiga_lib_sec_policy_t * p_policy);
+
+/**
+ * \brief Retrieves the state and statistics of the SEC pacing.
+ *
+ * \details
+ * Retrieves the estimated and the last read security event counter, the reads and the paced requests of the
+ * OPTIGA associated with the instance.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]  me                               Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[out] p_stats                          Pointer to statistics, must not be NULL.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ */
+optiga_lib_status_t optiga_cmd_get_sec_stats(const optiga_cmd_t * me, optiga_lib_sec_stats_t * p_stats);
+#endif //OPTIGA_CMD_SEC_PACING_ENABLED
+#endif
+
+#ifdef OPTIGA_UTIL_READ_CACHE_ENABLED
+/**
+ * \brief Registers a data object in the read cache.
+ *
+ * \details
+ * Registers a data object in the read cache of the OPTIGA associated with the instance.
+ * - The data read from offset 0 of the data object using #optiga_cmd_get_data_object is cached.<br>
+ * - The cached data is dropped, when the data object or its metadata is written using #optiga_cmd_set_data_object.<br>
+ * - All cached data is dropped with #optiga_cmd_set_object_protected.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Register only data objects, which are not updated by OPTIGA itself (e.g. counters, security event counter).
+ * - If the data object is already registered, only the preload option is updated.
+ *
+ * \param[in] me                                          Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in] oid                                         Data object identifier.
+ * \param[in] preload                                     TRUE, if the data object is read once the application is opened.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                          Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR_INVALID_INPUT              Invalid data object identifier.
+ * \retval    #OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT        No free entry in the read cache (#OPTIGA_UTIL_READ_CACHE_SIZE).
+ */
+optiga_lib_status_t optiga_cmd_read_cache_register(optiga_cmd_t * me, uint16_t oid, bool_t preload);
+
+/**
+ * \brief Unregisters a data object from the read cache.
+ *
+ * \details
+ * Unregisters a data object from the read cache and drops its cached data.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in] me                                          Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in] oid                                         Data object identifier, 0x0000 unregisters all the data objects.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                          Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR_INVALID_INPUT              Data object is not registered.
+ */
+optiga_lib_status_t optiga_cmd_read_cache_unregister(optiga_cmd_t * me, uint16_t oid);
+
+/**
+ * \brief Reads data of a data object from the read cache.
+ *
+ * \details
+ * Reads data of a data object from the read cache, without any command to OPTIGA.
+ * - The read is served, if the requested part is cached, or the complete data object is cached.
+ *   In the latter case, p_length is updated with the number of bytes till the end of data object.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Reads beyond the end of data object are not served, hence OPTIGA reports the error.
+ *
+ * \param[in]     me                                      Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in]     oid                                     Data object identifier.
+ * \param[in]     offset                                  Offset from which the data is read.
+ * \param[out]    p_buffer                                Pointer to the buffer to store the data.
+ * \param[in,out] p_length                                Number of bytes to read, updated with the number of bytes read.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                          Read is served from the read cache.
+ * \retval    #OPTIGA_CMD_ERROR                            Requested data is not cached.
+ */
+optiga_lib_status_t optiga_cmd_read_cache_get(optiga_cmd_t * me,
+                                              uint16_t oid,
+                                              uint16_t offset,
+                                              uint8_t * p_buffer,
+                                              uint16_t * p_length);
+
+/**
+ * \brief Provides the next registered data object, which is to be preloaded.
+ *
+ * \details
+ * Provides the next data object registered with preload, whose data is not cached yet, starting from the entry index.
+ * - The data object is to be read from offset 0 using #optiga_cmd_get_data_object into the returned buffer,
+ *   with the length #OPTIGA_UTIL_READ_CACHE_MAX_OBJECT_SIZE.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]     me                                      Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in,out] p_index                                 Entry index to start from, 0 for the first call. Updated for the next call.
+ * \param[out]    p_oid                                   Data object identifier to be read.
+ *
+ * \retval    #uint8_t *                                   Buffer to read the data object into.
+ * \retval    NULL                                        No more data objects to be preloaded.
+ */
+uint8_t * optiga_cmd_read_cache_get_preload(optiga_cmd_t * me, uint8_t * p_index, uint16_t * p_oid);
+#endif
+
+#if defined (OPTIGA_UTIL_DIFFERENTIAL_WRITE_ENABLED) || defined (OPTIGA_UTIL_COUNT_COALESCING_ENABLED)
+/**
+ * \brief Reports the completion of a request, which is served on host, through the scheduler.
+ *
+ * \details
+ * Reports the completion of a request, which is served on host without any command to OPTIGA.
+ * - The request is queued like a command and the callback handler of the instance is invoked with the status,
+ *   once the scheduler grants the lock. Hence the callback is never invoked before this function returns.<br>
+ *
+ * \pre
+ * - No request of the instance is ongoing.
+ *
+ * \note
+ * - None
+ *
+ * \param[in]     me                                      Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in]     status                                  Status to be reported to the callback handler.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                          Completion is queued.
+ */
+optiga_lib_status_t optiga_cmd_complete_on_host(optiga_cmd_t * me, optiga_lib_status_t status);
+#endif //OPTIGA_UTIL_DIFFERENTIAL_WRITE_ENABLED || OPTIGA_UTIL_COUNT_COALESCING_ENABLED
+
+#ifdef OPTIGA_UTIL_COUNT_COALESCING_ENABLED
+/// Number of counter data objects, whose pending increments are held by OPTIGA context
+#define OPTIGA_CMD_PENDING_COUNT_SIZE                           (0x04)
+
+/**
+ * \brief Adds an increment to the pending increments of a counter data object.
+ *
+ * \details
+ * Adds an increment to the pending increments, which are shared by all the instances of the OPTIGA.
+ * - The pending increments stored to the datastore are restored once, with the first access to the pending increments.<br>
+ * - The pending increments are stored to the datastore every #OPTIGA_UTIL_COUNT_COALESCING_SAVE_INTERVAL increments.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]     me                                      Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in]     index                                   Index of the counter data object, less than #OPTIGA_CMD_PENDING_COUNT_SIZE.
+ * \param[in]     count                                   Increment to be added.
+ * \param[out]    p_flush_due                             TRUE, if the pending increments are to be flushed.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                          Increment is added.
+ * \retval    #OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT        Increment exceeds the pending increments, which can be held.
+ */
+optiga_lib_status_t optiga_cmd_pending_count_add(const optiga_cmd_t * me,
+                                                 uint8_t index,
+                                                 uint8_t count,
+                                                 bool_t * p_flush_due);
+
+/**
+ * \brief Reserves the pending increments of a counter data object to be written with update count.
+ *
+ * \details
+ * Reserves up to 255 pending increments, which are not reserved by another instance.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The reserved increments are to be released with #optiga_cmd_pending_count_release.
+ *
+ * \param[in]     me                                      Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in]     index                                   Index of the counter data object, less than #OPTIGA_CMD_PENDING_COUNT_SIZE.
+ *
+ * \retval    #uint8_t                                     Reserved increments, 0 if no increment is to be written.
+ */
+uint8_t optiga_cmd_pending_count_reserve(const optiga_cmd_t * me, uint8_t index);
+
+/**
+ * \brief Releases the reserved increments of a counter data object.
+ *
+ * \details
+ * Releases the increments reserved by #optiga_cmd_pending_count_reserve.
+ * - If the increments are written, they are removed from the pending increments, which are stored to the datastore.<br>
+ * - Else they remain pending.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]     me                                      Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in]     index                                   Index of the counter data object, less than #OPTIGA_CMD_PENDING_COUNT_SIZE.
+ * \param[in]     count                                   Reserved increments.
+ * \param[in]     is_written                              TRUE, if the update count is successful.
+ */
+void optiga_cmd_pending_count_release(const optiga_cmd_t * me, uint8_t index, uint8_t count, bool_t is_written);
+#endif //OPTIGA_UTIL_COUNT_COALESCING_ENABLED
+
+#ifdef OPTIGA_UTIL_METADATA_CACHE_ENABLED
+/**
+ * \brief Retrieves the parsed metadata of an object from the metadata cache.
+ *
+ * \details
+ * Retrieves the parsed metadata of an object from the metadata cache, without any command to OPTIGA.
+ * - The metadata read using #optiga_cmd_get_data_object is parsed and cached, up to #OPTIGA_UTIL_METADATA_CACHE_SIZE objects.<br>
+ * - The metadata is dropped, when the object or its metadata is written using #optiga_cmd_set_data_object.<br>
+ * - All metadata is dropped with #optiga_cmd_set_object_protected.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]  me                                         Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in]  oid                                        Object identifier.
+ * \param[out] p_info                                     Pointer to store the parsed metadata.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                          Metadata is cached.
+ * \retval    #OPTIGA_CMD_ERROR                            Metadata is not cached.
+ */
+optiga_lib_status_t optiga_cmd_metadata_cache_get(const optiga_cmd_t * me,
+                                                  uint16_t oid,
+                                                  optiga_lib_metadata_info_t * p_info);
+#endif
+
+#ifdef OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+/// Length of the key of an entry of the verification cache (SHA-256 digest)
+#define OPTIGA_CMD_VERIFY_CACHE_KEY_LENGTH                      (0x20)
+
+/**
+ * \brief Looks up a successful verification in the verification cache.
+ *
+ * \details
+ * Looks up the key of a verification in the verification cache, without any command to OPTIGA.
+ * - The key is the digest of the public key (or its certificate OID), the digest and the signature of the verification.<br>
+ * - An entry, whose time to live is elapsed, is dropped.<br>
+ * - The generation returned must be passed to #optiga_cmd_verify_cache_insert, once the verification is successful.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]  me                                         Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in]  p_key                                      Key of #OPTIGA_CMD_VERIFY_CACHE_KEY_LENGTH bytes.
+ * \param[out] p_generation                               Pointer to store the generation of the cache.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                          Verification is cached and successful.
+ * \retval    #OPTIGA_CMD_ERROR                            Verification is not cached.
+ */
+optiga_lib_status_t optiga_cmd_verify_cache_lookup(const optiga_cmd_t * me,
+                                                   const uint8_t * p_key,
+                                                   uint32_t * p_generation);
+
+/**
+ * \brief Adds a successful verification to the verification cache.
+ *
+ * \details
+ * Adds the key of a successful verification to the verification cache.
+ * - The verification is not added, if an object was written since #optiga_cmd_verify_cache_lookup returned the generation.<br>
+ * - The verifications with the public key of a certificate object are dropped, when the object is written using #optiga_cmd_set_data_object.<br>
+ * - All verifications are dropped with #optiga_cmd_set_object_protected.<br>
+ * - If the cache is full, an expired entry or else the oldest added entry is replaced.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]  me                                         Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in]  oid                                        Certificate object holding the public key, 0x0000 if the public key is from host.
+ * \param[in]  p_key                                      Key of #OPTIGA_CMD_VERIFY_CACHE_KEY_LENGTH bytes.
+ * \param[in]  generation                                 Generation returned by #optiga_cmd_verify_cache_lookup.
+ * \param[in]  ttl_ms                                     Time in milliseconds, for which the entry is valid.
+ */
+void optiga_cmd_verify_cache_insert(const optiga_cmd_t * me,
+                                    uint16_t oid,
+                                    const uint8_t * p_key,
+                                    uint32_t generation,
+                                    uint32_t ttl_ms);
+
+/**
+ * \brief Retrieves the statistics of the verification cache.
+ *
+ * \details
+ * Retrieves the hits, misses, insertions and invalidations of the verification cache of the OPTIGA associated with the instance.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]  me                                         Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[out] p_stats                                    Pointer to statistics, must not be NULL.
+ */
+void optiga_cmd_get_verify_cache_stats(const optiga_cmd_t * me, optiga_lib_verify_cache_stats_t * p_stats);
+#endif //OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+
+#ifdef OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
+/**
+ * \brief Sets the offload policy of the OPTIGA associated with the instance.
+ *
+ * \details
+ * Sets the policy, by which the operations of all the instances are executed on host or by OPTIGA.
+ * - Once a policy is set, it replaces the offload settings of the instances.<br>
+ * - With NULL, the policy is removed and the offload settings of the instances apply again.<br>
+ * - The measured costs and the statistics are retained.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]  me                                         Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in]  p_policy                                   Policy as defined in #optiga_lib_offload_policy_t, NULL to remove the policy.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                          Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR_INVALID_INPUT              Invalid mode in the policy.
+ */
+optiga_lib_status_t optiga_cmd_set_offload_policy(const optiga_cmd_t * me, const optiga_lib_offload_policy_t * p_policy);
+
+/**
+ * \brief Decides whether an operation is executed on host or by OPTIGA.
+ *
+ * \details
+ * Decides whether an operation is executed on host or by OPTIGA and counts the decision in the statistics.
+ * - An operation of the security class #OPTIGA_LIB_SECURITY_CLASS_CHIP_ONLY is executed by OPTIGA.<br>
+ * - Without a policy, the offload setting of the instance decides.<br>
+ * - With #OPTIGA_LIB_OFFLOAD_AUTO, a path not yet measured is taken first. Later, the path with the lower cost is taken.
+ *   The cost by OPTIGA is raised by the estimated waiting time of the execution queue, if the admission control is enabled.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The time of the decided path must be recorded using #optiga_cmd_offload_record.
+ *
+ * \param[in]  me                                         Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in]  operation                                  Operation as defined in #optiga_lib_offload_operation_t.
+ * \param[in]  security_class                             Security class as defined in #optiga_lib_security_class_t.
+ * \param[in]  instance_setting                           TRUE, if the offload setting of the instance executes the operation on host.
+ *
+ * \retval    TRUE                                         The operation is executed on host.
+ * \retval    FALSE                                        The operation is executed by OPTIGA.
+ */
+bool_t optiga_cmd_offload_decide(const optiga_cmd_t * me,
+                                 uint8_t operation,
+                                 uint8_t security_class,
+                                 bool_t instance_setting);
+
+/**
+ * \brief Records the time an operation took on host or by OPTIGA in the cost model.
+ *
+ * \details
+ * Records the time an operation took on host or by OPTIGA in the average cost of the path.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]  me                                         Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in]  operation                                  Operation as defined in #optiga_lib_offload_operation_t.
+ * \param[in]  on_host                                    TRUE, if the operation was executed on host.
+ * \param[in]  elapsed_time_us                            Time in microseconds, from the invocation till the completion of the operation.
+ */
+void optiga_cmd_offload_record(const optiga_cmd_t * me,
+                               uint8_t operation,
+                               bool_t on_host,
+                               uint32_t elapsed_time_us);
+
+/**
+ * \brief Retrieves the cost model and the decisions of the offload policy for an operation.
+ *
+ * \details
+ * Retrieves the measured costs and the decisions for an operation of the OPTIGA associated with the instance.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]  me                                         Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in]  operation                                  Operation as defined in #optiga_lib_offload_operation_t.
+ * \param[out] p_stats                                    Pointer to statistics, must not be NULL.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                          Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR_INVALID_INPUT              Invalid operation.
+ */
+optiga_lib_status_t optiga_cmd_get_offload_stats(const optiga_cmd_t * me,
+                                                 uint8_t operation,
+                                                 optiga_lib_offload_stats_t * p_stats);
+#endif //OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
+
+#ifdef OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+/**
+ * \brief Sets the capabilities of the OPTIGA associated with the instance.
+ *
+ * \details
+ * Sets the capabilities (#OPTIGA_LIB_CAPABILITY_SYMMETRIC etc.), which are probed from the coprocessor UID of OPTIGA.
+ * - The capabilities are shared by all the instances of the OPTIGA and are marked with #OPTIGA_LIB_CAPABILITY_PROBED.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Invoked by optiga util, once the application is opened.
+ *
+ * \param[in] me                               Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in] capabilities                     Capabilities of OPTIGA.
+ */
+void optiga_cmd_set_capabilities(optiga_cmd_t * me, uint32_t capabilities);
+
+/**
+ * \brief Returns the capabilities of the OPTIGA associated with the instance.
+ *
+ * \param[in] me                               Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ *
+ * \retval    Capabilities along with #OPTIGA_LIB_CAPABILITY_PROBED, 0 if OPTIGA is not yet probed.
+ */
+uint32_t optiga_cmd_get_capabilities(const optiga_cmd_t * me);
+
+/**
+ * \brief Checks the OPTIGA associated with the instance supports the capabilities.
+ *
+ * \param[in] me                               Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in] capability                       Capabilities required by the operation.
+ *
+ * \retval    TRUE                             All the capabilities are supported or OPTIGA is not yet probed.
+ * \retval    FALSE                            Any of the capabilities is not supported.
+ */
+bool_t optiga_cmd_is_capable(const optiga_cmd_t * me, uint32_t capability);
+#endif //OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+
+/// Command batch item to read data object, using #optiga_get_data_object_params_t
+#define OPTIGA_CMD_BATCH_ITEM_GET_DATA_OBJECT                   (0x01)
+/// Command batch item to calculate signature, using #optiga_calc_sign_params_t
+#define OPTIGA_CMD_BATCH_ITEM_CALC_SIGN                         (0x02)
+/// Command batch item to verify signature, using #optiga_verify_sign_params_t
+#define OPTIGA_CMD_BATCH_ITEM_VERIFY_SIGN                       (0x03)
+/// Command batch item to generate key pair, using #optiga_gen_keypair_params_t
+#define OPTIGA_CMD_BATCH_ITEM_GEN_KEYPAIR                       (0x04)
+/// Command batch item to calculate shared secret, using #optiga_calc_ssec_params_t
+#define OPTIGA_CMD_BATCH_ITEM_CALC_SSEC                         (0x05)
+/// Command batch item to derive key, using #optiga_derive_key_params_t
+#define OPTIGA_CMD_BATCH_ITEM_DERIVE_KEY                        (0x06)
+/// Command batch item to generate random or auth code, using #optiga_get_random_params_t
+#define OPTIGA_CMD_BATCH_ITEM_GET_RANDOM                        (0x07)
+/// Command batch item to verify HMAC or to clear AUTO state (start and final only), using #optiga_decrypt_sym_params_t
+#define OPTIGA_CMD_BATCH_ITEM_DECRYPT_SYM                       (0x08)
+/// Batch item executed on host in between the commands, using #optiga_cmd_batch_host_params_t
+#define OPTIGA_CMD_BATCH_ITEM_HOST                              (0x09)
+
+/**
+ * \brief Callback of the host batch item, invoked from the context of the command scheduler.
+ *
+ * \details
+ * Returns #OPTIGA_LIB_SUCCESS, if the host step is successful.
+ * - The callback is invoked while the OPTIGA lock is held, hence it must not invoke any OPTIGA API.
+ */
+typedef optiga_lib_status_t (*optiga_cmd_batch_host_callback_t)(void * p_context);
+
+/**
+ * \brief Specifies the data structure of the host batch item
+ */
+typedef struct optiga_cmd_batch_host_params
+{
+    /// Callback of the host step, must not be NULL
+    optiga_cmd_batch_host_callback_t callback;
+    /// Context of the callback
+    void * p_context;
+}optiga_cmd_batch_host_params_t;
+
+/**
+ * \brief The structure represents a command of a command batch.
+ */
+typedef struct optiga_cmd_batch_item
+{
+    /// Command type (OPTIGA_CMD_BATCH_ITEM_xxx)
+    uint8_t cmd_type;
+    /// Param value of the command
+    uint8_t cmd_param;
+    /// Command parameters, prepared as for the corresponding optiga_cmd API
+    void * params;
+    /// Status of the command, updated by #optiga_cmd_execute_batch
+    optiga_lib_status_t status;
+}optiga_cmd_batch_item_t;
+
+/**
+ * \brief Executes several commands under one acquisition of the OPTIGA cmd lock.
+ *
+ * \details
+ * Executes several commands under one acquisition of the OPTIGA cmd lock.
+ * - Acquires the OPTIGA lock once for the whole batch.<br>
+ * - Issues the commands back to back in the order of items, without releasing the lock in between.<br>
+ * - Updates the status of each item, once the respective command is completed.<br>
+ * - A failure of a command reported by OPTIGA does not stop the batch.<br>
+ * - Releases the OPTIGA lock and invokes the callback handler once, after the last item is completed.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The items and the parameters referred by the items must be valid until the callback handler is invoked.
+ * - Calculate signature with session based key (#OPTIGA_KEY_ID_SESSION_BASED) is not supported.
+ * - The items using the session (generate key pair, calculate shared secret, derive key, auth code and
+ *   HMAC verify) are only supported by #optiga_cmd_execute_chain.
+ * - A host item (#OPTIGA_CMD_BATCH_ITEM_HOST) is executed in place, once the previous item is completed.
+ *   It is not supported as the first item.
+ * - The callback handler is invoked with #OPTIGA_LIB_SUCCESS, if all the items are successful.
+ *   Otherwise it is invoked with the status of the first failed item.
+ * - If the batch is aborted due to a communication failure, the remaining items are updated with the failure status.
+ *
+ * \param[in] me                                Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in,out] p_items                       Pointer to array of items, must not be NULL.
+ * \param[in] item_count                        Number of items, must be in the range 1 to OPTIGA_CMD_BATCH_MAX_ITEMS.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR_INVALID_INPUT    Invalid item count or invalid item.
+ */
+optiga_lib_status_t optiga_cmd_execute_batch(optiga_cmd_t * me,
+                                             optiga_cmd_batch_item_t * p_items,
+                                             uint8_t item_count);
+
+/**
+ * \brief Executes several dependent commands under one acquisition of the OPTIGA cmd lock.
+ *
+ * \details
+ * Executes several dependent commands under one acquisition of the OPTIGA cmd lock, same as #optiga_cmd_execute_batch.
+ * - Acquires the session along with the lock, if any of the items uses the session.<br>
+ * - Stops at the first failed item, since each item depends on the result of the previous one.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The items and the parameters referred by the items must be valid until the callback handler is invoked.
+ * - The items, which are not executed due to a failure, are updated with the failure status.
+ * - The session is retained after the chain, the content of the session is the result of the last successful item.
+ * - The HMAC verify and clear AUTO state items (#OPTIGA_CMD_BATCH_ITEM_DECRYPT_SYM) release the session, hence the later
+ *   items must not use the session.
+ *
+ * \param[in] me                                Valid instance of #optiga_cmd_t created using #optiga_cmd_create.
+ * \param[in,out] p_items                       Pointer to array of items, must not be NULL.
+ * \param[in] item_count                        Number of items, must be in the range 1 to OPTIGA_CMD_BATCH_MAX_ITEMS.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                Successful invocation.
+ * \retval    #OPTIGA_CMD_ERROR_INVALID_INPUT    Invalid item count or invalid item.
+ */
+optiga_lib_status_t optiga_cmd_execute_chain(optiga_cmd_t * me,
+                                             optiga_cmd_batch_item_t * p_items,
+                                             uint8_t item_count);
+
 
 /**
  * \brief Opens the OPTIGA Application
@@ -48,6 +48,10 @@ extern "C" {
 
 ///Instance id of OPTIGA slave
 #define OPTIGA_INSTANCE_ID_0                              (0x00)
+///Instance id of second OPTIGA slave
+#define OPTIGA_INSTANCE_ID_1                              (0x01)
+///Instance id to let the library assign the least loaded OPTIGA slave
+#define OPTIGA_INSTANCE_ID_ANY                            (0xFF)
 
 /** @brief When command data and response data is unprotected */
 #define OPTIGA_COMMS_NO_PROTECTION                        (0x00)
@@ -72,6 +76,9 @@ extern "C" {
 /** @brief OPTIGA instance is free */
 #define OPTIGA_LIB_INSTANCE_FREE                          (0x0000)
 
+/** @brief Number of priority classes in OPTIGA command execution queue */
+#define OPTIGA_LIB_NUMBER_OF_PRIORITIES                   (0x03)
+
 #ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
 /** @brief Configure shielded connection protection level for instance */
 #define OPTIGA_COMMS_PROTECTION_LEVEL                     (0x01)
@@ -79,6 +86,481 @@ extern "C" {
 #define OPTIGA_COMMS_PROTOCOL_VERSION                     (0x02)
 #endif
 
+/**
+ * \brief Specifies the priority class of an instance in OPTIGA command execution queue.
+ */
+typedef enum optiga_lib_priority
+{
+    /// Latency critical requests (e.g. TLS handshake), served first
+    OPTIGA_LIB_PRIORITY_HIGH = 0x00,
+    /// Default priority of an instance
+    OPTIGA_LIB_PRIORITY_NORMAL = 0x01,
+    /// Background requests (e.g. bulk data object read, counter update)
+    OPTIGA_LIB_PRIORITY_LOW = 0x02
+} optiga_lib_priority_t;
+
+/**
+ * \brief Specifies the waiting time statistics of a priority class in OPTIGA command execution queue.
+ */
+typedef struct optiga_lib_queue_wait_stats
+{
+    /// Number of requests dispatched from execution queue
+    uint32_t served_requests;
+    /// Accumulated waiting time of the dispatched requests in microseconds
+    uint32_t total_wait_time_us;
+    /// Maximum waiting time of a dispatched request in microseconds
+    uint32_t max_wait_time_us;
+} optiga_lib_queue_wait_stats_t;
+
+/**
+ * \brief Specifies the weight and the consumed OPTIGA time of a tenant, which shares OPTIGA with further tenants.
+ */
+typedef struct optiga_lib_tenant_stats
+{
+    /// Weight of the tenant, relative to the weights of the further tenants
+    uint8_t weight;
+    /// Number of requests of the tenant dispatched from execution queue
+    uint32_t served_requests;
+    /// Number of APDUs of the tenant exchanged with OPTIGA
+    uint32_t commands;
+    /// Accumulated OPTIGA time consumed by the tenant in microseconds, from sending of the APDU till the response
+    uint32_t device_time_us;
+} optiga_lib_tenant_stats_t;
+
+/**
+ * \brief Specifies the load of the execution queue and the estimated waiting time of a new request.
+ */
+typedef struct optiga_lib_queue_load
+{
+    /// Number of requests, which currently wait in the execution queue
+    uint8_t waiting_requests;
+    /// Number of free slots, hence the number of further instances which can be created
+    uint8_t free_slots;
+    /// Average time in microseconds a request is served, from its dispatch till the release of its slot
+    uint32_t service_time_us;
+    /// Estimated waiting time in microseconds of a request, which is invoked now
+    uint32_t estimated_wait_us;
+    /// Number of operations, which were not admitted since their estimated waiting time exceeded the maximum
+    uint32_t rejected_requests;
+} optiga_lib_queue_load_t;
+
+/**
+ * \brief Callback which reports the crossing of a watermark by the number of requests waiting in the execution queue.
+ *
+ * \param[in] context          Context provided with the watermarks
+ * \param[in] waiting_requests Number of requests waiting in the execution queue
+ * \param[in] is_high          TRUE, if the high watermark is reached. FALSE, if the low watermark is reached again
+ */
+typedef void (*optiga_lib_queue_watermark_callback_t)(void * context,
+                                                      uint8_t waiting_requests,
+                                                      bool_t is_high);
+
+/**
+ * \brief Specifies how a request of an instance acquires a session context of OPTIGA.
+ */
+typedef enum optiga_lib_session_policy
+{
+    /// The request waits in the execution queue, till a session context is free (default)
+    OPTIGA_LIB_SESSION_WAIT = 0x00,
+    /// The request fails with #OPTIGA_CMD_ERROR_SESSION_UNAVAILABLE, if no session context is free
+    OPTIGA_LIB_SESSION_FAIL_FAST = 0x01
+} optiga_lib_session_policy_t;
+
+/**
+ * \brief Specifies the usage of the session contexts of OPTIGA.
+ */
+typedef struct optiga_lib_session_pool_stats
+{
+    /// Number of session contexts of OPTIGA
+    uint8_t total_sessions;
+    /// Number of session contexts assigned to instances
+    uint8_t sessions_in_use;
+    /// Number of requests waiting in the execution queue for a session context
+    uint8_t waiting_requests;
+    /// Number of requests, which failed since no session context was free
+    uint32_t rejected_requests;
+    /// Number of session contexts, which are freed on expiry of the lease
+    uint32_t expired_leases;
+} optiga_lib_session_pool_stats_t;
+
+/**
+ * \brief Specifies the error recovery statistics of the communication with OPTIGA.
+ */
+typedef struct optiga_lib_comms_recovery_stats
+{
+    /// Number of received frames, which were corrupted (CRC or format error)
+    uint32_t corrupted_frames;
+    /// Number of transmitted frames, which were not acknowledged (NACK) by OPTIGA
+    uint32_t nacked_frames;
+    /// Number of frames, which were not received or could not be transmitted in time
+    uint32_t timeouts;
+    /// Number of resynchronizations of the frame counters
+    uint32_t resyncs;
+    /// Accumulated time from the first error until the frame is exchanged successfully, in microseconds
+    uint32_t recovery_time_us;
+} optiga_lib_comms_recovery_stats_t;
+
+/**
+ * \brief Specifies the latency statistics of the application restore from hibernate.
+ */
+typedef struct optiga_lib_resume_stats
+{
+    /// Number of successful restores of the application
+    uint32_t resumes;
+    /// Number of failed restores of the application
+    uint32_t failed_resumes;
+    /// Time from the start of the communication until the application is restored, of the last restore in microseconds
+    uint32_t last_resume_time_us;
+    /// Part of the last restore time, which is spent in the power up and negotiation of the communication, in microseconds
+    uint32_t last_comms_open_time_us;
+    /// Accumulated time of the successful restores in microseconds
+    uint32_t total_resume_time_us;
+    /// Maximum time of a successful restore in microseconds
+    uint32_t max_resume_time_us;
+} optiga_lib_resume_stats_t;
+
+/**
+ * \brief Specifies the statistics of the recovery of OPTIGA from communication failures.
+ */
+typedef struct optiga_lib_health_stats
+{
+    /// Number of successful recoveries, after which the failed command is resent
+    uint32_t recoveries;
+    /// Number of failed recoveries, which are reported with the failure of the command
+    uint32_t failed_recoveries;
+    /// Number of soft resets
+    uint32_t soft_resets;
+    /// Number of warm resets, done if the soft reset fails
+    uint32_t warm_resets;
+    /// Time from the communication failure until the application is opened again, of the last recovery in microseconds
+    uint32_t last_recovery_time_us;
+} optiga_lib_health_stats_t;
+
+/**
+ * \brief Specifies the statistics of the automatic hibernate of the application on idle command queue.
+ */
+typedef struct optiga_lib_auto_hibernate_stats
+{
+    /// Idle time of the command queue in milliseconds, after which the application is hibernated (0 if disabled)
+    uint32_t idle_time_ms;
+    /// Number of hibernates of the application
+    uint32_t hibernates;
+    /// Number of hibernates, which were not accepted (e.g. security event counter is not zero)
+    uint32_t failed_hibernates;
+    /// Number of restores of the application on a request
+    uint32_t restores;
+    /// Number of restores, which failed and a clean application context is opened instead
+    uint32_t failed_restores;
+    /// Time from the request until the application is restored, of the last restore in microseconds
+    uint32_t last_restore_time_us;
+    /// Maximum time of a restore in microseconds
+    uint32_t max_restore_time_us;
+    /// Number of deferrable requests, which waited for a restore and were served in the batch after it
+    uint32_t deferred_requests;
+    /// Number of restores, which were started since the maximum delay of a deferrable request elapsed
+    uint32_t deferral_expiries;
+} optiga_lib_auto_hibernate_stats_t;
+
+/**
+ * \brief Specifies the policy of the performance governor, which sets the current limitation of OPTIGA (0xE0C4).
+ */
+typedef struct optiga_lib_performance_policy
+{
+    /// Current limitation in mA, which is set once the command queue is idle for the idle time (6 - 15)
+    uint8_t idle_current_limit;
+    /// Current limitation in mA, which is set on a burst of requests (6 - 15, not less than the idle current limitation)
+    uint8_t burst_current_limit;
+    /// Number of requests waiting in the command queue, from which the burst current limitation is set
+    uint8_t burst_queue_depth;
+    /// Idle time of the command queue in milliseconds, after which the idle current limitation is set
+    uint32_t idle_time_ms;
+    /// Minimum time in milliseconds between two writes of the current limitation, which limits the writes to NVM
+    uint32_t min_hold_time_ms;
+} optiga_lib_performance_policy_t;
+
+/**
+ * \brief Specifies the state and statistics of the performance governor.
+ */
+typedef struct optiga_lib_performance_stats
+{
+    /// Current limitation in mA, which is set by the governor (0 if not yet written)
+    uint8_t current_limit;
+    /// Maximum current limitation in mA, set by the power budget of the host (0 if no budget is set)
+    uint8_t max_current_limit;
+    /// Number of writes, which raised the current limitation
+    uint32_t raises;
+    /// Number of writes, which dropped the current limitation
+    uint32_t drops;
+    /// Number of writes of the current limitation, which failed (e.g. access condition of 0xE0C4 not satisfied)
+    uint32_t failed_writes;
+} optiga_lib_performance_stats_t;
+
+/**
+ * \brief Specifies the policy of the pacing of the operations, which raise the security event counter (SEC, 0xE0C5).
+ */
+typedef struct optiga_lib_sec_policy
+{
+    /// Estimated SEC, from which the SEC raising requests wait till the SEC is decreased below (0 if the pacing is disabled)
+    uint8_t pacing_threshold;
+    /// Time in milliseconds, in which OPTIGA decreases the SEC by one (refer to the datasheet of OPTIGA)
+    uint32_t decay_time_ms;
+    /// Minimum time in milliseconds between two reads of the SEC, while SEC raising requests wait (0 to read only after a failure)
+    uint32_t refresh_time_ms;
+} optiga_lib_sec_policy_t;
+
+/**
+ * \brief Specifies the state and statistics of the pacing of the SEC raising operations.
+ */
+typedef struct optiga_lib_sec_stats
+{
+    /// Estimated SEC, the last read SEC lowered by the decay since the read
+    uint8_t current_sec;
+    /// SEC, which was read last from OPTIGA
+    uint8_t last_read_sec;
+    /// Number of reads of the SEC
+    uint32_t reads;
+    /// Number of failed SEC raising operations (e.g. failed HMAC verification or protected update)
+    uint32_t sec_raising_failures;
+    /// Number of SEC raising requests, which waited for the decay of the SEC while further requests were served
+    uint32_t paced_requests;
+} optiga_lib_sec_stats_t;
+
+/**
+ * \brief Specifies the statistics of the cache of successful ECDSA verifications.
+ */
+typedef struct optiga_lib_verify_cache_stats
+{
+    /// Number of verifications, which were served from the cache without OPTIGA
+    uint32_t hits;
+    /// Number of verifications, which were not cached or whose entry was expired
+    uint32_t misses;
+    /// Number of successful verifications added to the cache
+    uint32_t insertions;
+    /// Number of entries dropped, on a write to the certificate object (e.g. trust anchor) of the entry or a protected update
+    uint32_t invalidations;
+} optiga_lib_verify_cache_stats_t;
+
+/**
+ * \brief Specifies the operations, which are executed either on host or by OPTIGA as decided by the offload policy.
+ */
+typedef enum optiga_lib_offload_operation
+{
+    /// Hash of data from host in one step
+    OPTIGA_LIB_OFFLOAD_HASH = 0x00,
+    /// ECDSA verification with public key from host
+    OPTIGA_LIB_OFFLOAD_ECDSA_VERIFY = 0x01
+} optiga_lib_offload_operation_t;
+
+/// Number of operations in #optiga_lib_offload_operation_t
+#define OPTIGA_LIB_OFFLOAD_OPERATION_COUNT              (0x02)
+
+/**
+ * \brief Specifies where an operation is executed, as set by the offload policy.
+ */
+typedef enum optiga_lib_offload_mode
+{
+    /// The path with the lower cost is chosen, based on the measured costs on host and by OPTIGA (default)
+    OPTIGA_LIB_OFFLOAD_AUTO = 0x00,
+    /// The operation is always executed on host
+    OPTIGA_LIB_OFFLOAD_HOST = 0x01,
+    /// The operation is always executed by OPTIGA
+    OPTIGA_LIB_OFFLOAD_CHIP = 0x02
+} optiga_lib_offload_mode_t;
+
+/**
+ * \brief Specifies the security class of the operations of an instance, as considered by the offload policy.
+ */
+typedef enum optiga_lib_security_class
+{
+    /// Operations on public data, which may be executed on host (default)
+    OPTIGA_LIB_SECURITY_CLASS_PUBLIC = 0x00,
+    /// Operations, which are always executed by OPTIGA irrespective of the cost and the mode of the policy
+    OPTIGA_LIB_SECURITY_CLASS_CHIP_ONLY = 0x01
+} optiga_lib_security_class_t;
+
+/**
+ * \brief Specifies the policy, by which the operations are executed on host or by OPTIGA.
+ */
+typedef struct optiga_lib_offload_policy
+{
+    /// Mode of each operation as defined in #optiga_lib_offload_mode_t, indexed by #optiga_lib_offload_operation_t
+    uint8_t mode[OPTIGA_LIB_OFFLOAD_OPERATION_COUNT];
+    /// Number of automatic decisions, after which the path not chosen is taken once to refresh its cost (0 to never probe)
+    uint16_t probe_interval;
+} optiga_lib_offload_policy_t;
+
+/**
+ * \brief Specifies the cost model and the decisions of the offload policy for an operation.
+ */
+typedef struct optiga_lib_offload_stats
+{
+    /// Average time in microseconds, the operation takes on host (0 if not yet measured)
+    uint32_t host_cost_us;
+    /// Average time in microseconds, the operation takes by OPTIGA including the waiting in the queue (0 if not yet measured)
+    uint32_t chip_cost_us;
+    /// Number of executions decided for host
+    uint32_t host_decisions;
+    /// Number of executions decided for OPTIGA
+    uint32_t chip_decisions;
+    /// Number of decisions, which are forced by the mode of the policy, the security class or the setting of the instance
+    uint32_t forced_decisions;
+    /// Number of decisions, which took the path not chosen by the cost model to refresh its cost
+    uint32_t probes;
+} optiga_lib_offload_stats_t;
+
+#ifdef OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+/// Symmetric encryption and decryption, HMAC, HMAC verify, symmetric key generation, auth code and clear AUTO state
+#define OPTIGA_LIB_CAPABILITY_SYMMETRIC                 (0x00000001UL)
+/// HKDF and TLS PRF with SHA384 and SHA512
+#define OPTIGA_LIB_CAPABILITY_KEY_DERIVATION            (0x00000002UL)
+/// ECC NIST P-521 and Brainpool curves and RSA SSA with SHA512
+#define OPTIGA_LIB_CAPABILITY_EXTENDED_ALGORITHMS       (0x00000004UL)
+/// The capabilities are probed from OPTIGA
+#define OPTIGA_LIB_CAPABILITY_PROBED                    (0x80000000UL)
+/// Capabilities of OPTIGA Trust M V1
+#define OPTIGA_LIB_CAPABILITIES_M_V1                    (0x00000000UL)
+/// Capabilities of OPTIGA Trust M V3
+#define OPTIGA_LIB_CAPABILITIES_M_V3                    (OPTIGA_LIB_CAPABILITY_SYMMETRIC | \
+                                                         OPTIGA_LIB_CAPABILITY_KEY_DERIVATION | \
+                                                         OPTIGA_LIB_CAPABILITY_EXTENDED_ALGORITHMS)
+#endif //OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+/**
+ * \brief Specifies the execution statistics of a command.
+ */
+typedef struct optiga_lib_command_stats
+{
+    /// Command code of the APDU (without the clear last error flag)
+    uint8_t command_code;
+    /// Number of executions of the command
+    uint32_t count;
+    /// Number of executions, which failed in the communication or were responded with an error by OPTIGA
+    uint32_t failed;
+    /// Minimum time from the transmission of the command until the response is received, in microseconds
+    uint32_t min_latency_us;
+    /// Maximum time from the transmission of the command until the response is received, in microseconds
+    uint32_t max_latency_us;
+    /// Accumulated latency in microseconds, the average latency is total_latency_us / count
+    uint32_t total_latency_us;
+} optiga_lib_command_stats_t;
+
+/**
+ * \brief Specifies the link statistics of the communication with OPTIGA.
+ */
+typedef struct optiga_lib_comms_stats
+{
+    /// Number of frames, which were retransmitted by the data link layer
+    uint32_t dl_retransmits;
+    /// Number of resynchronizations of the frame counters (sent or received)
+    uint32_t resyncs;
+    /// Number of chaining errors of the transport layer (reported by OPTIGA or detected by the host)
+    uint32_t chaining_errors;
+    /// Number of packet bytes, which were sent again from the first fragment after a chaining error
+    uint32_t chaining_resent_bytes;
+    /// Number of responses of a shielded connection, which failed the decryption or integrity check
+    uint32_t decryption_failures;
+    /// Accumulated time from the transmission of a packet until OPTIGA has the response ready, in microseconds
+    uint32_t busy_time_us;
+    /// Number of bytes transferred on the I2C bus (register addresses, frames and status reads)
+    uint32_t bus_bytes;
+    /// Number of frames, which were read without the STATUS register read (OPTIGA_COMMS_SPECULATIVE_READ_ENABLED)
+    uint32_t speculative_reads;
+    /// Number of speculative reads, which were NACKed by the slave and continued with the STATUS register polling
+    uint32_t speculative_read_fallbacks;
+    /// Accumulated execution time of OPTIGA as busy_time_us, in milliseconds
+    uint32_t execution_time_ms;
+    /// Accumulated time of the I2C transfers outside of the execution on OPTIGA, in milliseconds
+    uint32_t i2c_time_ms;
+    /// Number of resets of OPTIGA (warm or cold) at the open of the communication
+    uint32_t resets;
+} optiga_lib_comms_stats_t;
+
+/**
+ * \brief Specifies the duty cycle of OPTIGA for the accounting of the energy.
+ */
+typedef struct optiga_lib_energy_stats
+{
+    /// Time from the reset at the open of the application until the close, in milliseconds
+    uint32_t awake_time_ms;
+    /// Awake time, in which OPTIGA neither executes a command nor transfers on the I2C bus, in milliseconds
+    uint32_t idle_awake_time_ms;
+    /// Time from the close of the application with context save (hibernate) until the next open, in milliseconds
+    uint32_t hibernated_time_ms;
+    /// Number of closes of the application with context save
+    uint32_t hibernates;
+    /// Number of opens of the application with context restore
+    uint32_t restores;
+} optiga_lib_energy_stats_t;
+
+/**
+ * \brief Specifies the runtime statistics of an OPTIGA instance.
+ */
+typedef struct optiga_lib_statistics
+{
+    /// Statistics of the executed commands, in the order of the first execution
+    optiga_lib_command_stats_t commands[OPTIGA_LIB_STATISTICS_COMMAND_COUNT];
+    /// Number of valid entries in commands
+    uint8_t command_count;
+    /// Number of executions of further command codes, once all the entries are in use
+    uint32_t other_commands;
+    /// Number of requests, which currently wait in the execution queue
+    uint8_t queue_depth;
+    /// Maximum number of requests, which waited in the execution queue at the same time
+    uint8_t max_queue_depth;
+    /// Link statistics of the communication
+    optiga_lib_comms_stats_t comms;
+    /// Duty cycle of OPTIGA, the execution and I2C times are given in comms
+    optiga_lib_energy_stats_t energy;
+} optiga_lib_statistics_t;
+#endif //OPTIGA_LIB_STATISTICS_ENABLED
+
+/// Maximum length of an access condition held in #optiga_lib_metadata_info_t
+#define OPTIGA_LIB_METADATA_MAX_AC_LENGTH               (0x10)
+/// Life cycle state of the object (tag 0xC0) is present in the metadata
+#define OPTIGA_LIB_METADATA_HAS_LCSO                    (0x01)
+/// Maximum size of the object (tag 0xC4) is present in the metadata
+#define OPTIGA_LIB_METADATA_HAS_MAX_SIZE                (0x02)
+/// Used size of the object (tag 0xC5) is present in the metadata
+#define OPTIGA_LIB_METADATA_HAS_USED_SIZE               (0x04)
+/// Change access condition (tag 0xD0) is present in the metadata
+#define OPTIGA_LIB_METADATA_HAS_CHANGE_AC               (0x08)
+/// Read access condition (tag 0xD1) is present in the metadata
+#define OPTIGA_LIB_METADATA_HAS_READ_AC                 (0x10)
+/// Execute access condition (tag 0xD3) is present in the metadata
+#define OPTIGA_LIB_METADATA_HAS_EXECUTE_AC              (0x20)
+/// Data object type (tag 0xE8) is present in the metadata
+#define OPTIGA_LIB_METADATA_HAS_DATA_OBJECT_TYPE        (0x40)
+
+/**
+ * \brief Specifies the parsed view of the metadata of an object in OPTIGA.
+ */
+typedef struct optiga_lib_metadata_info
+{
+    /// Change access condition as in the metadata (e.g. 0x00 for always)
+    uint8_t change_ac[OPTIGA_LIB_METADATA_MAX_AC_LENGTH];
+    /// Read access condition as in the metadata
+    uint8_t read_ac[OPTIGA_LIB_METADATA_MAX_AC_LENGTH];
+    /// Execute access condition as in the metadata
+    uint8_t execute_ac[OPTIGA_LIB_METADATA_MAX_AC_LENGTH];
+    /// Maximum size of the object
+    uint16_t max_size;
+    /// Used size of the object
+    uint16_t used_size;
+    /// Length of the change access condition
+    uint8_t change_ac_length;
+    /// Length of the read access condition
+    uint8_t read_ac_length;
+    /// Length of the execute access condition
+    uint8_t execute_ac_length;
+    /// Life cycle state of the object
+    uint8_t lcso;
+    /// Data object type
+    uint8_t data_object_type;
+    /// Tags present in the metadata, combination of OPTIGA_LIB_METADATA_HAS_xxx
+    uint8_t present;
+} optiga_lib_metadata_info_t;
+
 /**
  * \brief Specifies the key location in OPTIGA.
  */
@@ -155,6 +637,22 @@ typedef enum optiga_ecc_curve
 #endif    
 } optiga_ecc_curve_t;
 
+/**
+ * \brief Specifies the format of the ECDSA signature exchanged with host.
+ */
+typedef enum optiga_ecdsa_signature_format
+{
+    /// Two DER encoded INTEGERs r and s, as generated and expected by OPTIGA
+    OPTIGA_ECDSA_SIGNATURE_FORMAT_DER_INTEGERS = 0x00,
+    /// DER SEQUENCE of the INTEGERs r and s (e.g. X.509, mbed TLS)
+    OPTIGA_ECDSA_SIGNATURE_FORMAT_DER_SEQUENCE = 0x01,
+    /// r || s, each left padded with zeros to the size of the curve (e.g. PKCS#11 CKM_ECDSA, COSE, JWS)
+    OPTIGA_ECDSA_SIGNATURE_FORMAT_RAW = 0x02
+} optiga_ecdsa_signature_format_t;
+
+/// Maximum number of bytes, which the DER INTEGERs of a signature add to the raw r || s (tag, length and sign byte of r and s)
+#define OPTIGA_ECDSA_SIGNATURE_DER_OVERHEAD         (0x06)
+
 /**
  * \brief Specifies the RSA encryption schemes.
  */
@@ -349,6 +847,30 @@ typedef struct public_key_from_host
     uint8_t key_type;
 } public_key_from_host_t;
 
+/**
+ * \brief Callback which receives a chunk of data read from OPTIGA, as soon as it is received.
+ *
+ * \param[in] context          Context provided by the caller of the read
+ * \param[in] p_chunk          Pointer to the chunk. Valid only during the callback
+ * \param[in] chunk_length     Length of the chunk
+ * \param[in] chunk_offset     Offset of the chunk from the start of the read
+ */
+typedef void (*optiga_lib_stream_callback_t)(void * context,
+                                             const uint8_t * p_chunk,
+                                             uint16_t chunk_length,
+                                             uint16_t chunk_offset);
+
+/**
+ * \brief Callback which reports the progress of an operation split into multiple chunks.
+ *
+ * \param[in] context          Context provided by the caller of the operation
+ * \param[in] completed_length Length completed so far
+ * \param[in] total_length     Total length of the operation
+ */
+typedef void (*optiga_lib_progress_callback_t)(void * context,
+                                               uint16_t completed_length,
+                                               uint16_t total_length);
+
 /**
  * \brief Specifies the data structure for data to be read from OPTIGA
  */
@@ -370,6 +892,10 @@ typedef struct optiga_get_data_object
     uint16_t * ref_bytes_to_read;
     /// Read data buffer pointer
     uint8_t * buffer;
+    /// Callback which receives the read data chunk wise instead of buffer, if not NULL
+    optiga_lib_stream_callback_t stream_callback;
+    /// Context for stream callback
+    void * stream_context;
 } optiga_get_data_object_params_t;
 
 /**
@@ -393,6 +919,12 @@ typedef struct optiga_set_data_object
     uint8_t write_type;
     ///Count value
     uint8_t count;
+    /// Length of data acknowledged by OPTIGA
+    uint16_t acknowledged_size;
+    /// Callback which is invoked after each chunk is written, if not NULL
+    optiga_lib_progress_callback_t progress_callback;
+    /// Context for progress callback
+    void * progress_context;
 } optiga_set_data_object_params_t;
 
 /**
@@ -475,6 +1007,10 @@ typedef struct optiga_calc_sign
     optiga_key_id_t private_key_oid;
     /// Digest data length
     uint8_t digest_length;
+#ifdef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+    /// Format of the signature returned to host, refer #optiga_ecdsa_signature_format_t
+    uint8_t signature_format;
+#endif
 } optiga_calc_sign_params_t;
 
 /**
@@ -496,6 +1032,10 @@ typedef struct optiga_verify_sign
     public_key_from_host_t * public_key;
     /// Public key certificate OID
     uint16_t certificate_oid;
+#ifdef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+    /// Format of the signature provided by host, refer #optiga_ecdsa_signature_format_t
+    uint8_t signature_format;
+#endif
 } optiga_verify_sign_params_t;
 
 /**
@@ -714,6 +1254,70 @@ void optiga_common_set_uint32(uint8_t* p_output_buffer,
 void optiga_common_get_uint16(const uint8_t * p_input_buffer,
                               uint16_t* p_two_byte_value);
 
+#ifdef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+/**
+ * \brief Converts the ECDSA signature generated by OPTIGA to the requested format
+ *
+ * \details
+ * Converts the two DER INTEGERs r and s generated by OPTIGA to the requested format.
+ * - For #OPTIGA_ECDSA_SIGNATURE_FORMAT_RAW, the leading zeros of r and s are stripped and r and s are left padded to
+ *   half of the initial signature length.<br>
+ * - For #OPTIGA_ECDSA_SIGNATURE_FORMAT_DER_SEQUENCE, the SEQUENCE header is added.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - For #OPTIGA_ECDSA_SIGNATURE_FORMAT_RAW, the initial signature length must be twice the size of the curve
+ *   (e.g. 0x40 for NIST P256, 0x84 for NIST P521).
+ *
+ * \param[in]      p_der_integers          DER INTEGERs r and s
+ * \param[in]      der_integers_length     Length of the DER INTEGERs
+ * \param[in]      signature_format        Requested format, refer #optiga_ecdsa_signature_format_t
+ * \param[in,out]  p_signature             Buffer to store the signature
+ * \param[in,out]  p_signature_length      Initially the length of the buffer, updated with the length of the signature
+ *
+ * \retval         #OPTIGA_LIB_SUCCESS                   Successful conversion
+ * \retval         #OPTIGA_CMD_ERROR_INVALID_INPUT       Invalid DER INTEGERs or format
+ * \retval         #OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT Buffer is too small
+ */
+optiga_lib_status_t optiga_common_ecdsa_signature_from_der(const uint8_t * p_der_integers,
+                                                           uint16_t der_integers_length,
+                                                           uint8_t signature_format,
+                                                           uint8_t * p_signature,
+                                                           uint16_t * p_signature_length);
+
+/**
+ * \brief Converts the ECDSA signature provided by host to the DER INTEGERs expected by OPTIGA
+ *
+ * \details
+ * Converts the signature in the given format to the two DER INTEGERs r and s expected by OPTIGA.
+ * - For #OPTIGA_ECDSA_SIGNATURE_FORMAT_RAW, the first half of the signature is r and the second half is s.<br>
+ * - For #OPTIGA_ECDSA_SIGNATURE_FORMAT_DER_SEQUENCE, the SEQUENCE header is removed.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The DER INTEGERs of a raw signature are up to #OPTIGA_ECDSA_SIGNATURE_DER_OVERHEAD bytes longer than the signature.
+ *
+ * \param[in]      p_signature             Signature in the given format
+ * \param[in]      signature_length        Length of the signature
+ * \param[in]      signature_format        Format of the signature, refer #optiga_ecdsa_signature_format_t
+ * \param[in,out]  p_der_integers          Buffer to store the DER INTEGERs r and s
+ * \param[in,out]  p_der_integers_length   Initially the length of the buffer, updated with the length of the DER INTEGERs
+ *
+ * \retval         #OPTIGA_LIB_SUCCESS                   Successful conversion
+ * \retval         #OPTIGA_CMD_ERROR_INVALID_INPUT       Invalid signature or format
+ * \retval         #OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT Buffer is too small
+ */
+optiga_lib_status_t optiga_common_ecdsa_signature_to_der(const uint8_t * p_signature,
+                                                         uint16_t signature_length,
+                                                         uint8_t signature_format,
+                                                         uint8_t * p_der_integers,
+                                                         uint16_t * p_der_integers_length);
+#endif //OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+
 #ifdef __cplusplus
 }
 #endif
@@ -42,6 +42,7 @@
 extern "C" {
 #endif
 
+#include "optiga/optiga_lib_config.h"
 #include "optiga/common/optiga_lib_types.h"
 
 //Logger levels
@@ -178,6 +179,123 @@ void optiga_lib_print_array_hex_format(const uint8_t * p_log_string,
                                        uint16_t length,
                                        const char_t * p_log_color);
 
+#ifdef OPTIGA_LIB_LOGGER_DEFERRED_ENABLED
+/// Record of #optiga_lib_print_message, payload is the layer followed by the message, value is the layer length
+#define OPTIGA_LIB_LOGGER_RECORD_MESSAGE            (0x01)
+/// Record of #optiga_lib_print_status, payload is the layer, value is the return value
+#define OPTIGA_LIB_LOGGER_RECORD_STATUS             (0x02)
+/// Record of #optiga_lib_print_array_hex_format, payload is the array, value is the original length
+#define OPTIGA_LIB_LOGGER_RECORD_ARRAY              (0x03)
+/// Record of #optiga_lib_logger_record_format, payload is the address of the format string (8 bytes) followed by
+/// the arguments (4 bytes each), value is the number of arguments
+#define OPTIGA_LIB_LOGGER_RECORD_FORMAT             (0x04)
+
+/// Flag of an array record, the array is protected by the shielded connection
+#define OPTIGA_LIB_LOGGER_FLAG_PROTECTED            (0x01)
+/// Flag of a record, of which the payload is truncated to #OPTIGA_LIB_LOGGER_DEFERRED_MAX_DATA
+#define OPTIGA_LIB_LOGGER_FLAG_TRUNCATED            (0x02)
+
+/// Size of the record header: type (1), flags (1), payload length (2), value (2), time in microseconds (4).
+/// The multi byte fields are little endian.
+#define OPTIGA_LIB_LOGGER_RECORD_HEADER_SIZE        (10U)
+/// Maximum number of arguments of a format record
+#define OPTIGA_LIB_LOGGER_MAX_FORMAT_ARGS           (4U)
+
+/**
+ * \brief Records a debug statement with the format string and its integer arguments, without formatting.
+ *
+ * \details
+ * Records the address of the format string and the arguments. Invoked by #OPTIGA_LIB_LOGGER_DEFERRED_FORMAT, which
+ * serves as IFX_I2C_LOG of the protocol stack layers.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The format string must be a string literal, since only its address is recorded.
+ * - Only the integer conversions (e.g. %d, %x, %u) are supported as arguments.
+ *
+ * \param[in] arg_count           Number of arguments, up to #OPTIGA_LIB_LOGGER_MAX_FORMAT_ARGS
+ * \param[in] p_format            Format string
+ *
+ */
+void optiga_lib_logger_record_format(uint8_t arg_count, const char_t * p_format, ...);
+
+/**
+ * \brief Reads the records of the deferred logger.
+ *
+ * \details
+ * Copies the complete records, which fit in the buffer, in the order they are recorded and removes them from
+ * the ring buffer. The records are formatted using #optiga_lib_logger_decode, e.g. by a host-side decoder.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Records, which do not fit in the ring buffer, are dropped (see #optiga_lib_logger_get_dropped_count).
+ *
+ * \param[out] p_buffer           Buffer for the records
+ * \param[in]  max_length         Size of the buffer, at least #OPTIGA_LIB_LOGGER_RECORD_HEADER_SIZE +
+ *                                #OPTIGA_LIB_LOGGER_DEFERRED_MAX_DATA to read any record
+ *
+ * \retval     Number of bytes copied to the buffer
+ */
+uint16_t optiga_lib_logger_read(uint8_t * p_buffer, uint16_t max_length);
+
+/**
+ * \brief Formats records of the deferred logger to the console.
+ *
+ * \details
+ * Formats the records in the same way as the logger does without deferral.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The format records are formatted only by the image, which recorded them. An offline decoder resolves the
+ *   address of the format string using the symbols of the image.
+ *
+ * \param[in] p_records           Records read using #optiga_lib_logger_read
+ * \param[in] length              Number of bytes of the records
+ *
+ */
+void optiga_lib_logger_decode(const uint8_t * p_records, uint16_t length);
+
+/**
+ * \brief Formats all the pending records of the deferred logger to the console.
+ *
+ * \details
+ * Reads and decodes the records, e.g. invoked by the application when it is idle.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ */
+void optiga_lib_logger_flush(void);
+
+/**
+ * \brief Provides the number of records, which were dropped since the ring buffer was full.
+ *
+ * \retval     Number of dropped records
+ */
+uint32_t optiga_lib_logger_get_dropped_count(void);
+
+/// @cond
+#define OPTIGA_LIB_LOGGER_ARG_COUNT_SELECT(format, arg1, arg2, arg3, arg4, count, ...)  count
+#define OPTIGA_LIB_LOGGER_ARG_COUNT(...)  OPTIGA_LIB_LOGGER_ARG_COUNT_SELECT(__VA_ARGS__, 4, 3, 2, 1, 0, 0)
+/// @endcond
+
+/**
+ * \brief Records a debug statement of the format string and its arguments, the number of arguments is counted at
+ *        compile time
+ */
+#define OPTIGA_LIB_LOGGER_DEFERRED_FORMAT(...) \
+    optiga_lib_logger_record_format((uint8_t)OPTIGA_LIB_LOGGER_ARG_COUNT(__VA_ARGS__), __VA_ARGS__)
+#endif //OPTIGA_LIB_LOGGER_DEFERRED_ENABLED
+
 /**
  * \brief Converts the input array buffer to encode the color specified
  *
@@ -0,0 +1,364 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_lib_metadata.h
+*
+* \brief   This file provides the macros to build the metadata of an object at compile time, e.g. for #optiga_util_write_metadata.
+*
+* \details
+* The metadata is written as constant initializer, the lengths are computed and checked by the compiler:
+* \code
+* const uint8_t e0f1_metadata[] = {
+*     OPTIGA_METADATA(OPTIGA_METADATA_CHANGE_AC(OPTIGA_AC_LCSO_LT(OPTIGA_LCS_OPERATIONAL), OPTIGA_AC_OR, OPTIGA_AC_CONF(0xE140)),
+*                     OPTIGA_METADATA_EXECUTE_AC(OPTIGA_AC_ALW))
+* };
+* \endcode
+* - A length beyond the limits or an invalid life cycle state fails the compilation.
+* - In C++, #OPTIGA_METADATA_DEFINE additionally validates the tags and the access conditions using a static_assert.
+*
+* \ingroup  grOptigaLibCommon
+*
+* @{
+*/
+
+#ifndef _OPTIGA_LIB_METADATA_H_
+#define _OPTIGA_LIB_METADATA_H_
+
+#include "optiga/common/optiga_lib_types.h"
+
+#ifdef __cplusplus
+#include <cstddef>
+#include <initializer_list>
+#endif
+
+#ifndef OPTIGA_METADATA_MAX_LENGTH
+/// Maximum length of the metadata of an object, including the metadata tag and length
+#define OPTIGA_METADATA_MAX_LENGTH                      (0x2C)
+#endif
+/// Maximum length of an access condition
+#define OPTIGA_METADATA_MAX_AC_LENGTH                   (0x10)
+
+/// Metadata constructed tag
+#define OPTIGA_METADATA_TAG                             (0x20)
+/// Life cycle state of the object
+#define OPTIGA_METADATA_TAG_LCSO                        (0xC0)
+/// Version information of the object
+#define OPTIGA_METADATA_TAG_VERSION                     (0xC1)
+/// Maximum size of the object
+#define OPTIGA_METADATA_TAG_MAX_SIZE                    (0xC4)
+/// Used size of the object
+#define OPTIGA_METADATA_TAG_USED_SIZE                   (0xC5)
+/// Change access condition
+#define OPTIGA_METADATA_TAG_CHANGE_AC                   (0xD0)
+/// Read access condition
+#define OPTIGA_METADATA_TAG_READ_AC                     (0xD1)
+/// Execute access condition
+#define OPTIGA_METADATA_TAG_EXECUTE_AC                  (0xD3)
+/// Algorithm associated with the key
+#define OPTIGA_METADATA_TAG_ALGORITHM                   (0xE0)
+/// Key usage
+#define OPTIGA_METADATA_TAG_KEY_USAGE                   (0xE1)
+/// Data object type
+#define OPTIGA_METADATA_TAG_DATA_OBJECT_TYPE            (0xE8)
+/// Reset type
+#define OPTIGA_METADATA_TAG_RESET_TYPE                  (0xF0)
+
+/// Life cycle state creation
+#define OPTIGA_LCS_CREATION                             (0x01)
+/// Life cycle state initialization
+#define OPTIGA_LCS_INITIALIZATION                       (0x03)
+/// Life cycle state operational
+#define OPTIGA_LCS_OPERATIONAL                          (0x07)
+/// Life cycle state termination
+#define OPTIGA_LCS_TERMINATION                          (0x0F)
+
+/// Access condition identifier always
+#define OPTIGA_AC_ID_ALW                                (0x00)
+/// Access condition identifier shielded connection with the key (e.g. 0xE140)
+#define OPTIGA_AC_ID_CONF                               (0x20)
+/// Access condition identifier integrity protected by the trust anchor
+#define OPTIGA_AC_ID_INT                                (0x21)
+/// Access condition identifier authorization reference
+#define OPTIGA_AC_ID_AUTO                               (0x23)
+/// Access condition identifier limited use counter
+#define OPTIGA_AC_ID_LUC                                (0x40)
+/// Access condition identifier global life cycle state
+#define OPTIGA_AC_ID_LCSG                               (0x70)
+/// Access condition identifier application life cycle state
+#define OPTIGA_AC_ID_LCSA                               (0xE0)
+/// Access condition identifier object life cycle state
+#define OPTIGA_AC_ID_LCSO                               (0xE1)
+/// Access condition identifier never
+#define OPTIGA_AC_ID_NEV                                (0xFF)
+/// Comparison equal
+#define OPTIGA_AC_OP_EQ                                 (0xFA)
+/// Comparison greater than
+#define OPTIGA_AC_OP_GT                                 (0xFB)
+/// Comparison less than
+#define OPTIGA_AC_OP_LT                                 (0xFC)
+/// Combines two access conditions, both are to be satisfied
+#define OPTIGA_AC_AND                                   (0xFD)
+/// Combines two access conditions, one is to be satisfied
+#define OPTIGA_AC_OR                                    (0xFE)
+
+#ifdef __cplusplus
+/// Number of bytes of the initializer list, as constant expression
+#define OPTIGA_METADATA_COUNT(...)                      (std::initializer_list<uint8_t>{__VA_ARGS__}.size())
+#else
+/// Number of bytes of the initializer list, as constant expression
+#define OPTIGA_METADATA_COUNT(...)                      (sizeof((const uint8_t[]){__VA_ARGS__}))
+#endif
+
+/// Evaluates to 0, the compilation fails if the condition is not satisfied
+#define OPTIGA_METADATA_ASSERT(condition)               (0 * sizeof(char[(condition) ? 1 : -1]))
+
+/// Length of the bytes, the compilation fails if it is 0 or more than max_length
+#define OPTIGA_METADATA_LENGTH(max_length, ...) \
+    ((uint8_t)(OPTIGA_METADATA_COUNT(__VA_ARGS__) + \
+               OPTIGA_METADATA_ASSERT((0 < OPTIGA_METADATA_COUNT(__VA_ARGS__)) && \
+                                      ((max_length) >= OPTIGA_METADATA_COUNT(__VA_ARGS__)))))
+
+/// Life cycle state, the compilation fails if it is not one of OPTIGA_LCS_xxx
+#define OPTIGA_METADATA_LCS(lcs) \
+    ((uint8_t)((lcs) + OPTIGA_METADATA_ASSERT((OPTIGA_LCS_CREATION == (lcs)) || \
+                                              (OPTIGA_LCS_INITIALIZATION == (lcs)) || \
+                                              (OPTIGA_LCS_OPERATIONAL == (lcs)) || \
+                                              (OPTIGA_LCS_TERMINATION == (lcs)))))
+
+/// Two bytes of the value in big endian format
+#define OPTIGA_METADATA_UINT16(value)                   (uint8_t)(((value) >> 8) & 0xFF), (uint8_t)((value) & 0xFF)
+
+/// Metadata of an object, composed of the OPTIGA_METADATA_xxx items
+#define OPTIGA_METADATA(...) \
+    OPTIGA_METADATA_TAG, OPTIGA_METADATA_LENGTH(OPTIGA_METADATA_MAX_LENGTH - 2, __VA_ARGS__), __VA_ARGS__
+
+/// Life cycle state of the object
+#define OPTIGA_METADATA_LCSO(lcs)                       OPTIGA_METADATA_TAG_LCSO, 0x01, OPTIGA_METADATA_LCS(lcs)
+/// Version information of the object
+#define OPTIGA_METADATA_VERSION(version)                OPTIGA_METADATA_TAG_VERSION, 0x02, OPTIGA_METADATA_UINT16(version)
+/// Maximum size of the object
+#define OPTIGA_METADATA_MAX_SIZE(size)                  OPTIGA_METADATA_TAG_MAX_SIZE, 0x02, OPTIGA_METADATA_UINT16(size)
+/// Algorithm associated with the key (e.g. #OPTIGA_ECC_CURVE_NIST_P_256)
+#define OPTIGA_METADATA_ALGORITHM(algorithm)            OPTIGA_METADATA_TAG_ALGORITHM, 0x01, (uint8_t)(algorithm)
+/// Key usage (combination of #optiga_key_usage_t)
+#define OPTIGA_METADATA_KEY_USAGE(key_usage)            OPTIGA_METADATA_TAG_KEY_USAGE, 0x01, (uint8_t)(key_usage)
+/// Data object type (e.g. 0x22 for the platform binding secret)
+#define OPTIGA_METADATA_DATA_OBJECT_TYPE(type)          OPTIGA_METADATA_TAG_DATA_OBJECT_TYPE, 0x01, (uint8_t)(type)
+/// Reset type of the object
+#define OPTIGA_METADATA_RESET_TYPE(reset_type)          OPTIGA_METADATA_TAG_RESET_TYPE, 0x01, (uint8_t)(reset_type)
+/// Change access condition, composed of the OPTIGA_AC_xxx conditions and operators
+#define OPTIGA_METADATA_CHANGE_AC(...) \
+    OPTIGA_METADATA_TAG_CHANGE_AC, OPTIGA_METADATA_LENGTH(OPTIGA_METADATA_MAX_AC_LENGTH, __VA_ARGS__), __VA_ARGS__
+/// Read access condition, composed of the OPTIGA_AC_xxx conditions and operators
+#define OPTIGA_METADATA_READ_AC(...) \
+    OPTIGA_METADATA_TAG_READ_AC, OPTIGA_METADATA_LENGTH(OPTIGA_METADATA_MAX_AC_LENGTH, __VA_ARGS__), __VA_ARGS__
+/// Execute access condition, composed of the OPTIGA_AC_xxx conditions and operators
+#define OPTIGA_METADATA_EXECUTE_AC(...) \
+    OPTIGA_METADATA_TAG_EXECUTE_AC, OPTIGA_METADATA_LENGTH(OPTIGA_METADATA_MAX_AC_LENGTH, __VA_ARGS__), __VA_ARGS__
+
+/// Access condition always
+#define OPTIGA_AC_ALW                                   OPTIGA_AC_ID_ALW
+/// Access condition never
+#define OPTIGA_AC_NEV                                   OPTIGA_AC_ID_NEV
+/// Access condition shielded connection, with the pre-shared secret in the OID
+#define OPTIGA_AC_CONF(oid)                             OPTIGA_AC_ID_CONF, OPTIGA_METADATA_UINT16(oid)
+/// Access condition integrity protected, with the trust anchor in the OID
+#define OPTIGA_AC_INT(oid)                              OPTIGA_AC_ID_INT, OPTIGA_METADATA_UINT16(oid)
+/// Access condition authorization reference, with the authorization reference in the OID
+#define OPTIGA_AC_AUTO(oid)                             OPTIGA_AC_ID_AUTO, OPTIGA_METADATA_UINT16(oid)
+/// Access condition limited use counter, with the counter in the OID
+#define OPTIGA_AC_LUC(oid)                              OPTIGA_AC_ID_LUC, OPTIGA_METADATA_UINT16(oid)
+/// Access condition object life cycle state equal to lcs
+#define OPTIGA_AC_LCSO_EQ(lcs)                          OPTIGA_AC_ID_LCSO, OPTIGA_AC_OP_EQ, OPTIGA_METADATA_LCS(lcs)
+/// Access condition object life cycle state greater than lcs
+#define OPTIGA_AC_LCSO_GT(lcs)                          OPTIGA_AC_ID_LCSO, OPTIGA_AC_OP_GT, OPTIGA_METADATA_LCS(lcs)
+/// Access condition object life cycle state less than lcs
+#define OPTIGA_AC_LCSO_LT(lcs)                          OPTIGA_AC_ID_LCSO, OPTIGA_AC_OP_LT, OPTIGA_METADATA_LCS(lcs)
+/// Access condition application life cycle state equal to lcs
+#define OPTIGA_AC_LCSA_EQ(lcs)                          OPTIGA_AC_ID_LCSA, OPTIGA_AC_OP_EQ, OPTIGA_METADATA_LCS(lcs)
+/// Access condition application life cycle state greater than lcs
+#define OPTIGA_AC_LCSA_GT(lcs)                          OPTIGA_AC_ID_LCSA, OPTIGA_AC_OP_GT, OPTIGA_METADATA_LCS(lcs)
+/// Access condition application life cycle state less than lcs
+#define OPTIGA_AC_LCSA_LT(lcs)                          OPTIGA_AC_ID_LCSA, OPTIGA_AC_OP_LT, OPTIGA_METADATA_LCS(lcs)
+/// Access condition global life cycle state equal to lcs
+#define OPTIGA_AC_LCSG_EQ(lcs)                          OPTIGA_AC_ID_LCSG, OPTIGA_AC_OP_EQ, OPTIGA_METADATA_LCS(lcs)
+/// Access condition global life cycle state greater than lcs
+#define OPTIGA_AC_LCSG_GT(lcs)                          OPTIGA_AC_ID_LCSG, OPTIGA_AC_OP_GT, OPTIGA_METADATA_LCS(lcs)
+/// Access condition global life cycle state less than lcs
+#define OPTIGA_AC_LCSG_LT(lcs)                          OPTIGA_AC_ID_LCSG, OPTIGA_AC_OP_LT, OPTIGA_METADATA_LCS(lcs)
+
+#if defined (__cplusplus) && (__cplusplus >= 201402L)
+/**
+ * \brief Validates the access condition, as constant expression.
+ *
+ * \details
+ * Validates the sequence of conditions combined with #OPTIGA_AC_AND or #OPTIGA_AC_OR.
+ * ALW and NEV are valid only as the sole condition.
+ */
+constexpr bool optiga_metadata_is_valid_ac(const uint8_t * p_ac, std::size_t length)
+{
+    std::size_t index = 0;
+    bool expect_condition = true;
+
+    if ((1 == length) && ((OPTIGA_AC_ID_ALW == p_ac[0]) || (OPTIGA_AC_ID_NEV == p_ac[0])))
+    {
+        return (true);
+    }
+    while (index < length)
+    {
+        if (!expect_condition)
+        {
+            if ((OPTIGA_AC_AND != p_ac[index]) && (OPTIGA_AC_OR != p_ac[index]))
+            {
+                return (false);
+            }
+            index += 1;
+        }
+        else if ((OPTIGA_AC_ID_CONF == p_ac[index]) || (OPTIGA_AC_ID_INT == p_ac[index]) ||
+                 (OPTIGA_AC_ID_AUTO == p_ac[index]) || (OPTIGA_AC_ID_LUC == p_ac[index]))
+        {
+            index += 3;
+        }
+        else if ((OPTIGA_AC_ID_LCSO == p_ac[index]) || (OPTIGA_AC_ID_LCSA == p_ac[index]) ||
+                 (OPTIGA_AC_ID_LCSG == p_ac[index]))
+        {
+            if ((index + 1 >= length) ||
+                ((OPTIGA_AC_OP_EQ != p_ac[index + 1]) && (OPTIGA_AC_OP_GT != p_ac[index + 1]) &&
+                 (OPTIGA_AC_OP_LT != p_ac[index + 1])))
+            {
+                return (false);
+            }
+            index += 3;
+        }
+        else
+        {
+            return (false);
+        }
+        expect_condition = !expect_condition;
+    }
+    // The access condition must end with a condition, exactly at its length
+    return ((index == length) && !expect_condition);
+}
+
+/**
+ * \brief Validates the metadata, as constant expression.
+ *
+ * \details
+ * Validates the metadata tag and length, the tags of the items, their lengths and the access conditions.
+ */
+constexpr bool optiga_metadata_is_valid(const uint8_t * p_metadata, std::size_t length)
+{
+    std::size_t index = 2;
+    std::size_t item_length = 0;
+    uint8_t tag = 0;
+
+    if ((length < 2) || (length > OPTIGA_METADATA_MAX_LENGTH) ||
+        (OPTIGA_METADATA_TAG != p_metadata[0]) || (length - 2 != p_metadata[1]))
+    {
+        return (false);
+    }
+    while (index < length)
+    {
+        if (index + 2 > length)
+        {
+            return (false);
+        }
+        tag = p_metadata[index];
+        item_length = p_metadata[index + 1];
+        index += 2;
+        if (index + item_length > length)
+        {
+            return (false);
+        }
+        switch (tag)
+        {
+            case OPTIGA_METADATA_TAG_LCSO:
+            {
+                if ((1 != item_length) ||
+                    ((OPTIGA_LCS_CREATION != p_metadata[index]) && (OPTIGA_LCS_INITIALIZATION != p_metadata[index]) &&
+                     (OPTIGA_LCS_OPERATIONAL != p_metadata[index]) && (OPTIGA_LCS_TERMINATION != p_metadata[index])))
+                {
+                    return (false);
+                }
+            }
+            break;
+            case OPTIGA_METADATA_TAG_VERSION:
+            case OPTIGA_METADATA_TAG_MAX_SIZE:
+            case OPTIGA_METADATA_TAG_USED_SIZE:
+            {
+                if (2 != item_length)
+                {
+                    return (false);
+                }
+            }
+            break;
+            case OPTIGA_METADATA_TAG_ALGORITHM:
+            case OPTIGA_METADATA_TAG_KEY_USAGE:
+            case OPTIGA_METADATA_TAG_DATA_OBJECT_TYPE:
+            case OPTIGA_METADATA_TAG_RESET_TYPE:
+            {
+                if (1 != item_length)
+                {
+                    return (false);
+                }
+            }
+            break;
+            case OPTIGA_METADATA_TAG_CHANGE_AC:
+            case OPTIGA_METADATA_TAG_READ_AC:
+            case OPTIGA_METADATA_TAG_EXECUTE_AC:
+            {
+                if ((item_length > OPTIGA_METADATA_MAX_AC_LENGTH) ||
+                    !optiga_metadata_is_valid_ac(p_metadata + index, item_length))
+                {
+                    return (false);
+                }
+            }
+            break;
+            default:
+                return (false);
+        }
+        index += item_length;
+    }
+    return (true);
+}
+
+/// Defines the constant metadata and validates it at compile time
+#define OPTIGA_METADATA_DEFINE(name, ...) \
+    constexpr uint8_t name[] = { OPTIGA_METADATA(__VA_ARGS__) }; \
+    static_assert(optiga_metadata_is_valid(name, sizeof(name)), "Invalid metadata " #name)
+#elif !defined (__cplusplus)
+/// Defines the constant metadata, the lengths and life cycle states are checked at compile time
+#define OPTIGA_METADATA_DEFINE(name, ...) \
+    const uint8_t name[] = { OPTIGA_METADATA(__VA_ARGS__) }
+#endif
+
+#endif /*_OPTIGA_LIB_METADATA_H_*/
+
+/**
+* @}
+*/
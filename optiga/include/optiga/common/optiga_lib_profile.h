@@ -0,0 +1,152 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file    optiga_lib_profile.h
+*
+* \brief   This file provides the prototypes for the host CPU cost profiling of the comms and command code paths.
+*
+* \details
+* The profiling points measure the host cycles spent in a code path with #pal_os_timer_get_cycle_count, along with
+* the number of calls and the bytes processed, independent of the latency of OPTIGA:
+* - #OPTIGA_LIB_PROFILE_DL_CRC       : CRC calculation of a data link frame, sent or received.
+* - #OPTIGA_LIB_PROFILE_TL_FRAGMENT  : Fragmentation of a packet into a data link frame, without the data link layer.
+* - #OPTIGA_LIB_PROFILE_PRL_ENCRYPT  : Encryption of a packet of the shielded connection.
+* - #OPTIGA_LIB_PROFILE_PRL_DECRYPT  : Decryption of a packet of the shielded connection.
+* - #OPTIGA_LIB_PROFILE_CMD_PREPARE  : Encoding of an APDU by the command layer.
+* - #OPTIGA_LIB_PROFILE_CMD_PARSE    : Processing of a response by the command layer.
+* - #OPTIGA_LIB_PROFILE_LOGGER       : Formatting and writing of a log message or an array.
+*
+* The cost is exclusive of the OPTIGA waiting time, hence the profiling is run on hardware as well as on the replay
+* PAL of Linux (PAL_I2C_REPLAY), which completes the transfers of a recording without delay. If the macro
+* OPTIGA_LIB_PROFILE_ENABLED is undefined, the profiling points are compiled out.
+*
+* \ingroup grOptigaLibCommon
+*
+* @{
+*/
+
+#ifndef _OPTIGA_LIB_PROFILE_H_
+#define _OPTIGA_LIB_PROFILE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "optiga/common/optiga_lib_common.h"
+#include "optiga/pal/pal_os_timer.h"
+
+/** \brief Profiling points */
+typedef enum optiga_lib_profile_point
+{
+    /// CRC calculation of a data link frame
+    OPTIGA_LIB_PROFILE_DL_CRC = 0x00,
+    /// Fragmentation of a packet by the transport layer
+    OPTIGA_LIB_PROFILE_TL_FRAGMENT,
+    /// Encryption of the presentation layer
+    OPTIGA_LIB_PROFILE_PRL_ENCRYPT,
+    /// Decryption of the presentation layer
+    OPTIGA_LIB_PROFILE_PRL_DECRYPT,
+    /// APDU encoding of the command layer
+    OPTIGA_LIB_PROFILE_CMD_PREPARE,
+    /// Response processing of the command layer
+    OPTIGA_LIB_PROFILE_CMD_PARSE,
+    /// Logger
+    OPTIGA_LIB_PROFILE_LOGGER,
+    /// Number of profiling points
+    OPTIGA_LIB_PROFILE_POINT_COUNT
+}optiga_lib_profile_point_t;
+
+/** \brief Accumulated cost of a profiling point */
+typedef struct optiga_lib_profile_stats
+{
+    /// Number of calls (e.g. frames, fragments or APDUs)
+    uint32_t calls;
+    /// Number of bytes processed
+    uint32_t bytes;
+    /// Sum of the cycles of all the calls
+    uint64_t cycles;
+    /// Minimum cycles of a call
+    uint32_t min_cycles;
+    /// Maximum cycles of a call
+    uint32_t max_cycles;
+}optiga_lib_profile_stats_t;
+
+#ifdef OPTIGA_LIB_PROFILE_ENABLED
+/**
+ * \brief Records a call of a profiling point.
+ *
+ * \details
+ * Accumulates the cycles elapsed since start_cycles and the number of bytes to the profiling point.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Invoked by the code paths using OPTIGA_LIB_PROFILE_BEGIN and OPTIGA_LIB_PROFILE_END.
+ *
+ * \param[in]  point          Profiling point, value of #optiga_lib_profile_point_t
+ * \param[in]  start_cycles   Cycle count at the begin of the call
+ * \param[in]  bytes          Number of bytes processed by the call
+ */
+void optiga_lib_profile_record(uint8_t point, uint32_t start_cycles, uint32_t bytes);
+
+/**
+ * \brief Provides the accumulated cost of the profiling points.
+ *
+ * \param[out] p_stats        Array of #OPTIGA_LIB_PROFILE_POINT_COUNT entries, indexed by #optiga_lib_profile_point_t
+ */
+LIBRARY_EXPORTS void optiga_lib_profile_get(optiga_lib_profile_stats_t * p_stats);
+
+/**
+ * \brief Clears the accumulated cost of the profiling points, e.g. at the start of a measurement.
+ */
+LIBRARY_EXPORTS void optiga_lib_profile_reset(void);
+
+/// @cond
+#define OPTIGA_LIB_PROFILE_DECLARE(start)              uint32_t start = 0;
+#define OPTIGA_LIB_PROFILE_BEGIN(start)                ((start) = pal_os_timer_get_cycle_count())
+#define OPTIGA_LIB_PROFILE_END(point, start, bytes)    optiga_lib_profile_record((uint8_t)(point), (start), \
+                                                                                 (uint32_t)(bytes))
+/// @endcond
+#else
+/// @cond
+#define OPTIGA_LIB_PROFILE_DECLARE(start)
+#define OPTIGA_LIB_PROFILE_BEGIN(start)                {}
+#define OPTIGA_LIB_PROFILE_END(point, start, bytes)    {}
+/// @endcond
+#endif //OPTIGA_LIB_PROFILE_ENABLED
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_OPTIGA_LIB_PROFILE_H_*/
+
+/**
+* @}
+*/
@@ -60,6 +60,8 @@ extern "C" {
  */
 ///OPTIGA Device Error to return OPTIGA security chip specific error codes (Refer Solution reference manual for details)
 #define OPTIGA_DEVICE_ERROR                         (0x8000)
+///OPTIGA Device Error, whose error code is not read from OPTIGA (refer OPTIGA_CMD_LAZY_DEVICE_ERROR_ENABLED)
+#define OPTIGA_DEVICE_ERROR_CODE_NOT_READ           (OPTIGA_DEVICE_ERROR)
 
 /**
  * OPTIGA comms module return values
@@ -96,6 +98,16 @@ extern "C" {
 #define OPTIGA_CMD_ERROR_INVALID_INPUT              (0x0203)
 ///OPTIGA command API called with insufficient memory buffer
 #define OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT        (0x0204)
+///OPTIGA command needs a session, and no session is free for an instance with fail fast session policy
+#define OPTIGA_CMD_ERROR_SESSION_UNAVAILABLE        (0x0205)
+///OPTIGA command is dropped from the execution queue, since its deadline has elapsed before it was dispatched
+#define OPTIGA_CMD_ERROR_DEADLINE_EXPIRED           (0x0206)
+///OPTIGA command is cancelled, it is dropped from the execution queue or its result is discarded
+#define OPTIGA_CMD_ERROR_CANCELLED                  (0x0207)
+///OPTIGA command sequence lost its strict lock, since its next step was not sent within the hold time
+#define OPTIGA_CMD_ERROR_STRICT_LOCK_REVOKED        (0x0208)
+///OPTIGA command is not admitted, since the estimated waiting time in the execution queue exceeds the maximum
+#define OPTIGA_CMD_ERROR_QUEUE_FULL                 (0x0209)
 
 /**
  * OPTIGA util module return values
@@ -112,6 +124,10 @@ extern "C" {
 #define OPTIGA_UTIL_ERROR_MEMORY_INSUFFICIENT       (0x0304)
 ///OPTIGA util API called when, a request of same instance is already in service
 #define OPTIGA_UTIL_ERROR_INSTANCE_IN_USE           (0x0305)
+///OPTIGA util operation is not admitted, since the estimated waiting time in the execution queue exceeds the maximum
+#define OPTIGA_UTIL_ERROR_QUEUE_FULL                (0x0306)
+///OPTIGA util protected update is rejected on host, since the manifest or the fragment is not valid
+#define OPTIGA_UTIL_ERROR_PROTECTED_UPDATE_INVALID  (0x0307)
 
 /**
  * OPTIGA crypt module return values
@@ -128,6 +144,10 @@ extern "C" {
 #define OPTIGA_CRYPT_ERROR_MEMORY_INSUFFICIENT      (0x0404)
 ///OPTIGA crypt API called when, a request of same instance is already in service
 #define OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE          (0x0405)
+///OPTIGA crypt operation is not admitted, since the estimated waiting time in the execution queue exceeds the maximum
+#define OPTIGA_CRYPT_ERROR_QUEUE_FULL               (0x0406)
+///OPTIGA crypt API is not supported by the OPTIGA of the instance, as probed on open application
+#define OPTIGA_CRYPT_ERROR_UNSUPPORTED              (0x0407)
 
 #ifdef __cplusplus
 }
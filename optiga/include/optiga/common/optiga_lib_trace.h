@@ -0,0 +1,243 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file    optiga_lib_trace.h
+*
+* \brief   This file provides the prototypes for the latency tracing of the OPTIGA library layers.
+*
+* \details
+* Each layer records a begin event when it starts its part of an operation and an end event (error event on failure)
+* when it completes, time stamped with #pal_os_timer_get_time_in_microseconds. The spans of the layers nest:
+* - #OPTIGA_LIB_TRACE_LAYER_API       : Operation of an instance, from the invocation of the command until the
+*                                       callback of the caller, code is the command code.
+* - #OPTIGA_LIB_TRACE_LAYER_SCHEDULER : Waiting of a lock or session request in the execution queue,
+*                                       code is the request type.
+* - #OPTIGA_LIB_TRACE_LAYER_CMD       : Encoding of the APDU, the end event carries the command code.
+* - #OPTIGA_LIB_TRACE_LAYER_COMMS     : Exchange of the APDU with OPTIGA till the response is received, code is the
+*                                       command code.
+* - #OPTIGA_LIB_TRACE_LAYER_PRL       : Encryption or decryption of the shielded connection,
+*                                       code is #OPTIGA_LIB_TRACE_PRL_ENCRYPT or #OPTIGA_LIB_TRACE_PRL_DECRYPT.
+* - #OPTIGA_LIB_TRACE_LAYER_TL        : Exchange of a packet, from the first fragment till the response packet is
+*                                       assembled, code is the packet length.
+* - #OPTIGA_LIB_TRACE_LAYER_DL        : Transmission of a data frame till it is acknowledged, the end event carries
+*                                       the number of resends.
+* - #OPTIGA_LIB_TRACE_LAYER_PL        : Write or read of a frame including the polling of the status register,
+*                                       code is the frame action of the physical layer.
+* - #OPTIGA_LIB_TRACE_LAYER_CHIP      : Execution on OPTIGA, from the last fragment of a packet till the response is
+*                                       signalled ready in the status register.
+*
+* The events of the API, scheduler, cmd and comms layers carry the execution queue slot of the instance in the upper
+* byte of the code (#OPTIGA_LIB_TRACE_GET_INSTANCE). The events of the lower layers belong to the instance, which
+* started the last exchange through comms.
+*
+* The events are written to a lock-free ring buffer, which is read using #optiga_lib_trace_read, and are passed to the
+* callback set using #optiga_lib_trace_set_callback. If the macro OPTIGA_LIB_TRACE_ENABLED is undefined, the trace
+* points are compiled out.
+*
+* \ingroup grOptigaLibCommon
+*
+* @{
+*/
+
+#ifndef _OPTIGA_LIB_TRACE_H_
+#define _OPTIGA_LIB_TRACE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "optiga/common/optiga_lib_common.h"
+
+/// Code of the presentation layer span, encryption of a packet
+#define OPTIGA_LIB_TRACE_PRL_ENCRYPT                (0x01)
+/// Code of the presentation layer span, decryption of a packet
+#define OPTIGA_LIB_TRACE_PRL_DECRYPT                (0x02)
+
+/// Code of an event of an instance, made of the execution queue slot of the instance and the value of the layer
+#define OPTIGA_LIB_TRACE_INSTANCE_CODE(instance, value) ((uint16_t)((((uint16_t)(instance)) << 8) | (uint8_t)(value)))
+/// Execution queue slot of the instance, which recorded the event of API, scheduler, cmd or comms layer
+#define OPTIGA_LIB_TRACE_GET_INSTANCE(code)         ((uint8_t)((code) >> 8))
+/// Value of the event of API, scheduler, cmd or comms layer (command code or request type)
+#define OPTIGA_LIB_TRACE_GET_VALUE(code)            ((uint8_t)(code))
+
+/** \brief Layers, which record trace events */
+typedef enum optiga_lib_trace_layer
+{
+    /// Command queue scheduler
+    OPTIGA_LIB_TRACE_LAYER_SCHEDULER = 0x00,
+    /// Command layer, APDU encoding
+    OPTIGA_LIB_TRACE_LAYER_CMD,
+    /// Command layer, APDU exchange through comms
+    OPTIGA_LIB_TRACE_LAYER_COMMS,
+    /// Presentation layer
+    OPTIGA_LIB_TRACE_LAYER_PRL,
+    /// Transport layer
+    OPTIGA_LIB_TRACE_LAYER_TL,
+    /// Data link layer
+    OPTIGA_LIB_TRACE_LAYER_DL,
+    /// Physical layer
+    OPTIGA_LIB_TRACE_LAYER_PL,
+    /// Command execution on OPTIGA
+    OPTIGA_LIB_TRACE_LAYER_CHIP,
+    /// Operation of an instance, as invoked by the optiga_util and optiga_crypt APIs
+    OPTIGA_LIB_TRACE_LAYER_API
+}optiga_lib_trace_layer_t;
+
+/** \brief Types of the trace events */
+typedef enum optiga_lib_trace_event_type
+{
+    /// Layer started its part of the operation
+    OPTIGA_LIB_TRACE_EVENT_BEGIN = 0x00,
+    /// Layer completed its part of the operation
+    OPTIGA_LIB_TRACE_EVENT_END,
+    /// Layer failed its part of the operation
+    OPTIGA_LIB_TRACE_EVENT_ERROR
+}optiga_lib_trace_event_type_t;
+
+/** \brief Trace event */
+typedef struct optiga_lib_trace_event
+{
+    /// Time stamp in microseconds
+    uint32_t time_us;
+    /// Code of the event, refer the layers for the meaning
+    uint16_t code;
+    /// Layer, value of #optiga_lib_trace_layer_t
+    uint8_t layer;
+    /// Type, value of #optiga_lib_trace_event_type_t
+    uint8_t type;
+}optiga_lib_trace_event_t;
+
+/**
+ * \brief Callback, invoked for each recorded event in the context of the layer.
+ *
+ * \param[in]  p_ctx      Context provided using #optiga_lib_trace_set_callback
+ * \param[in]  p_event    Recorded event, valid only during the callback
+ */
+typedef void (*optiga_lib_trace_callback_t)(void * p_ctx, const optiga_lib_trace_event_t * p_event);
+
+#ifdef OPTIGA_LIB_TRACE_ENABLED
+/**
+ * \brief Sets the callback of the trace events.
+ *
+ * \details
+ * Sets the callback, which is invoked for each recorded event in addition to the ring buffer.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The callback is invoked from the context of the layers (including the timer and interrupt contexts of the pal),
+ *   hence it must return quickly and must not invoke the OPTIGA APIs.
+ *
+ * \param[in]  callback   Callback, NULL to record to the ring buffer only
+ * \param[in]  p_ctx      Context provided to the callback
+ */
+void optiga_lib_trace_set_callback(optiga_lib_trace_callback_t callback, void * p_ctx);
+
+/**
+ * \brief Records a trace event.
+ *
+ * \details
+ * Records the event with the current time stamp to the ring buffer and passes it to the callback.
+ * - The ring buffer slot is reserved atomically, hence events are recorded from any context without a lock.
+ * - If the ring buffer is full, the oldest events are overwritten and counted as dropped.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Invoked by the layers using OPTIGA_LIB_TRACE_BEGIN, OPTIGA_LIB_TRACE_END, OPTIGA_LIB_TRACE_ERROR and
+ *   OPTIGA_LIB_TRACE_COMPLETE.
+ *
+ * \param[in]  layer      Layer, value of #optiga_lib_trace_layer_t
+ * \param[in]  type       Type, value of #optiga_lib_trace_event_type_t
+ * \param[in]  code       Code of the event
+ */
+void optiga_lib_trace_record(uint8_t layer, uint8_t type, uint16_t code);
+
+/**
+ * \brief Reads the recorded events from the ring buffer.
+ *
+ * \details
+ * Copies the oldest recorded events in the order of recording and removes them from the ring buffer.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Only one context may read the ring buffer.
+ *
+ * \param[out] p_events   Buffer of the events
+ * \param[in]  max_count  Maximum number of events to be read
+ *
+ * \retval     Number of the events read
+ */
+uint16_t optiga_lib_trace_read(optiga_lib_trace_event_t * p_events, uint16_t max_count);
+
+/**
+ * \brief Provides the number of events, which are overwritten before they are read.
+ *
+ * \retval     Number of the dropped events
+ */
+uint32_t optiga_lib_trace_get_dropped_count(void);
+
+/// @cond
+#define OPTIGA_LIB_TRACE_BEGIN(layer, code)    optiga_lib_trace_record((uint8_t)(layer), \
+                                                                        (uint8_t)OPTIGA_LIB_TRACE_EVENT_BEGIN, \
+                                                                        (uint16_t)(code))
+#define OPTIGA_LIB_TRACE_END(layer, code)      optiga_lib_trace_record((uint8_t)(layer), \
+                                                                        (uint8_t)OPTIGA_LIB_TRACE_EVENT_END, \
+                                                                        (uint16_t)(code))
+#define OPTIGA_LIB_TRACE_ERROR(layer, code)    optiga_lib_trace_record((uint8_t)(layer), \
+                                                                        (uint8_t)OPTIGA_LIB_TRACE_EVENT_ERROR, \
+                                                                        (uint16_t)(code))
+#define OPTIGA_LIB_TRACE_COMPLETE(layer, code, is_success) \
+                                               optiga_lib_trace_record((uint8_t)(layer), \
+                                                                       (uint8_t)((is_success) ? \
+                                                                       OPTIGA_LIB_TRACE_EVENT_END : \
+                                                                       OPTIGA_LIB_TRACE_EVENT_ERROR), \
+                                                                       (uint16_t)(code))
+/// @endcond
+#else
+/// @cond
+#define OPTIGA_LIB_TRACE_BEGIN(layer, code)    {}
+#define OPTIGA_LIB_TRACE_END(layer, code)      {}
+#define OPTIGA_LIB_TRACE_ERROR(layer, code)    {}
+#define OPTIGA_LIB_TRACE_COMPLETE(layer, code, is_success) {}
+/// @endcond
+#endif //OPTIGA_LIB_TRACE_ENABLED
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_OPTIGA_LIB_TRACE_H_*/
+
+/**
+* @}
+*/
@@ -57,6 +57,16 @@ extern "C" {
 #define OPTIGA_COMMS_PRL_OVERHEAD        (0x00)
 #endif
 
+#ifdef OPTIGA_COMMS_ZERO_COPY_TX
+// Room to be reserved in front of the transmit data, for the frame headers (data link and transport layer)
+#define OPTIGA_COMMS_TX_HEADROOM         (0x04)
+// Room to be reserved after the transmit data and presentation layer overhead, for the frame checksum
+#define OPTIGA_COMMS_TX_TAILROOM         (0x02)
+#else
+#define OPTIGA_COMMS_TX_HEADROOM         (0x00)
+#define OPTIGA_COMMS_TX_TAILROOM         (0x00)
+#endif
+
 /** @brief Optiga comms structure */
 typedef struct optiga_comms
 {
@@ -80,6 +90,23 @@ typedef struct optiga_comms
 #endif
     /// Pointer to the pal os event instance/context
     void * p_pal_os_event_ctx;
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+    /// Expected execution time of the next command in microseconds (0 if unknown), consumed by optiga_comms_transceive
+    uint32_t response_time_hint_us;
+    /// Measured time until the response of the last command was ready in microseconds, 0 if not measured
+    uint32_t response_time_us;
+#endif
+#ifdef OPTIGA_COMMS_ZERO_COPY_RX
+    /// Buffer, to which the received data from rx_destination_offset onwards is stored instead of the rx buffer,
+    /// NULL if not used. It is consumed by optiga_comms_transceive
+    uint8_t * p_rx_destination;
+    /// Offset in the rx buffer of the first byte, which is stored to p_rx_destination
+    uint16_t rx_destination_offset;
+    /// Size of p_rx_destination
+    uint16_t rx_destination_size;
+    /// Number of bytes of the last response stored to p_rx_destination, 0 if the rx buffer is used
+    uint16_t rx_destination_length;
+#endif
 } optiga_comms_t;
 
 /** @brief optiga communication structure */
@@ -109,6 +136,30 @@ extern optiga_comms_t optiga_comms;
 optiga_comms_t * optiga_comms_create(callback_handler_t callback,
                                      void * context);
 
+/**
+ * \brief Creates the communication instance of an OPTIGA instance.
+ *
+ * \details
+ * Creates the communication instance of an OPTIGA instance.
+ * - Assigns the comms structure based on the Optiga instance id.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - #optiga_comms_create is same as this API with #OPTIGA_INSTANCE_ID_0.
+ *
+ * \param[in] optiga_instance_id  Indicates the OPTIGA instance.
+ * \param[in] callback            Pointer to callback function, must not be NULL
+ * \param[in] context             Pointer to upper layer context.
+ *
+ * \retval    #optiga_comms_t *   On successful instance creation
+ * \retval    NULL                Invalid or not configured OPTIGA instance
+ */
+optiga_comms_t * optiga_comms_create_instance(uint8_t optiga_instance_id,
+                                              callback_handler_t callback,
+                                              void * context);
+
 /**
  * \brief Deinitializes the OPTIGA comms instance
  *
@@ -257,6 +308,9 @@ LIBRARY_EXPORTS optiga_lib_status_t optiga_comms_reset(optiga_comms_t * p_ctx, u
  *          This is invoked when optiga_comms_transceive is asynchronously completed.<br>
  *      - The <b>upper_layer_ctx</b> must be properly initialized,
  *          if it is different from that in #optiga_comms_open().
+ *      - <b>response_time_hint_us</b> : Expected execution time of the command (OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED).
+ *          The first poll for the response is scheduled near this time. It is reset to 0 by this API.
+ *          On completion, <b>response_time_us</b> holds the measured time until the response was ready (0 if not measured).
  *      - <b>protection_level</b> : Used for secure communication.The value of the parameter is not modified by the IFX-I2C protocol stack.
  *      - The values for <b>protection_level</b> must be one of the below
  *        - #OPTIGA_COMMS_NO_PROTECTION : Command and response is unprotected
@@ -328,6 +382,128 @@ LIBRARY_EXPORTS optiga_lib_status_t optiga_comms_transceive(optiga_comms_t * p_c
  */
 LIBRARY_EXPORTS optiga_lib_status_t optiga_comms_close(optiga_comms_t * p_ctx);
 
+#ifdef OPTIGA_COMMS_DL_RESEND_BACKOFF_ENABLED
+/**
+ * \brief Retrieves the error recovery statistics of the communication with OPTIGA.
+ *
+ * \details
+ * Retrieves the number of corrupted, not acknowledged and timed out frames, the number of resynchronizations
+ * and the time spent in error recovery.
+ * - The statistics are accumulated since the start of the host application.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in]     p_ctx                   Valid instance of #optiga_comms_t created using #optiga_comms_create
+ * \param[out]    p_stats                 Pointer to store the statistics, must not be NULL.
+ *
+ * \retval        #OPTIGA_COMMS_SUCCESS
+ * \retval        #OPTIGA_COMMS_ERROR
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_comms_get_recovery_stats(const optiga_comms_t * p_ctx,
+                                                                    optiga_lib_comms_recovery_stats_t * p_stats);
+#endif
+
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+/**
+ * \brief Retrieves the link statistics of the communication with OPTIGA.
+ *
+ * \details
+ * Retrieves the number of retransmitted frames, resynchronizations, chaining errors and decryption failures,
+ * and the time OPTIGA was busy executing the transmitted packets.
+ * - The statistics are accumulated since the start of the host application.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in]     p_ctx                   Valid instance of #optiga_comms_t created using #optiga_comms_create
+ * \param[out]    p_stats                 Pointer to store the statistics, must not be NULL.
+ *
+ * \retval        #OPTIGA_COMMS_SUCCESS
+ * \retval        #OPTIGA_COMMS_ERROR
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_comms_get_statistics(const optiga_comms_t * p_ctx,
+                                                                optiga_lib_comms_stats_t * p_stats);
+#endif
+
+#ifdef OPTIGA_COMMS_STACK_USAGE_ENABLED
+/**
+ * \brief Retrieves the maximum stack usage of the communication with OPTIGA.
+ *
+ * \details
+ * Retrieves the high water mark of the stack used by the IFX I2C protocol stack, in bytes.
+ * - The usage is measured from the dispatch of the first layer event till the i2c transfers, in the context of the
+ *   pal os event. It includes the upper layer handlers (OPTIGA cmd and the application callback) which start the
+ *   next transfer, but not the pal os event and the pal i2c implementation.
+ * - The high water mark is kept since the start of the host application.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ * - Add the stack usage of the pal os event, pal i2c and a margin, to size the stack of the task running the pal os event.
+ *
+ * \param[in]     p_ctx                   Valid instance of #optiga_comms_t created using #optiga_comms_create
+ * \param[out]    p_stack_high_water      Pointer to store the maximum stack usage in bytes, must not be NULL.
+ *
+ * \retval        #OPTIGA_COMMS_SUCCESS
+ * \retval        #OPTIGA_COMMS_ERROR
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_comms_get_stack_usage(const optiga_comms_t * p_ctx,
+                                                                 uint32_t * p_stack_high_water);
+#endif
+
+#if defined (OPTIGA_COMMS_SHIELDED_CONNECTION) && defined (OPTIGA_COMMS_KEY_ROLLOVER_ENABLED)
+/**
+ * \brief Renegotiates the session key of the shielded connection with OPTIGA.
+ *
+ * \details
+ * Renegotiates the session key of the established shielded connection, without any command to be exchanged.
+ * - The completion is propagated to the upper layer event handler, as for #optiga_comms_transceive.
+ *
+ * \pre
+ * - Communication channel and the shielded connection must be established with OPTIGA.
+ *
+ * \note
+ * - This is invoked by OPTIGA cmd, when the command queue is idle and #optiga_comms_rollover_due returns TRUE.
+ *   Hence the renegotiation is not done inline with the next command.
+ * - If the renegotiation fails, the shielded connection is established again with the next protected command.
+ *
+ * \param[in,out] p_ctx                   Valid instance of #optiga_comms_t created using #optiga_comms_create
+ *
+ * \retval        #OPTIGA_COMMS_SUCCESS
+ * \retval        #OPTIGA_COMMS_ERROR
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_comms_rollover(optiga_comms_t * p_ctx);
+
+/**
+ * \brief Checks if the session key rollover of the shielded connection is due.
+ *
+ * \details
+ * Checks if the communication is idle and the sequence numbers or the age of the session reached
+ * #OPTIGA_COMMS_KEY_ROLLOVER_SEQUENCE_NUMBER or #OPTIGA_COMMS_KEY_ROLLOVER_AGE_MS.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in]     p_ctx                   Valid instance of #optiga_comms_t created using #optiga_comms_create
+ *
+ * \retval        TRUE                    Rollover is due
+ * \retval        FALSE                   Rollover is not due or the communication is in use
+ */
+LIBRARY_EXPORTS bool_t optiga_comms_rollover_due(const optiga_comms_t * p_ctx);
+#endif
+
 
 
 #ifdef __cplusplus
@@ -54,7 +54,9 @@ typedef enum ifx_i2c_reset_type
     /// Soft reset. 0x0000 is written to IFX-I2C Soft reset register
     IFX_I2C_SOFT_RESET = 1U,
     /// Warm reset. Only reset pin is toggled low and then high
-    IFX_I2C_WARM_RESET = 2U
+    IFX_I2C_WARM_RESET = 2U,
+    /// Warm attach. No reset, the negotiation is done and the frame counters are resynchronized
+    IFX_I2C_WARM_ATTACH = 3U
 } ifx_i2c_reset_type_t;
 
 /**
@@ -229,6 +231,49 @@ optiga_lib_status_t ifx_i2c_transceive(ifx_i2c_context_t * p_ctx,
  */
 optiga_lib_status_t ifx_i2c_close(ifx_i2c_context_t * p_ctx);
 
+#if defined (OPTIGA_COMMS_SHIELDED_CONNECTION) && defined (OPTIGA_COMMS_KEY_ROLLOVER_ENABLED)
+/**
+ * \brief   Renegotiates the session key of the shielded connection for a given context.
+ *
+ * \details
+ * Renegotiates the session key of the shielded connection, without any data to be exchanged.
+ * - This API is implemented in asynchronous mode, the completion is propagated to the upper layer event handler.
+ * - Unlike the renegotiation in #ifx_i2c_transceive, no payload is waiting for the handshake.
+ *
+ * \pre
+ * - IFX I2C protocol stack must be initialized and the secure channel must be established.
+ *
+ * \note
+ * - If the renegotiation fails, the secure channel is established again with the next #ifx_i2c_transceive.
+ *
+ * \param[in,out] p_ctx                Pointer to #ifx_i2c_context_t, must not be NULL
+ *
+ * \retval        #IFX_I2C_STACK_SUCCESS
+ * \retval        #IFX_I2C_STACK_ERROR
+ */
+optiga_lib_status_t ifx_i2c_rollover(ifx_i2c_context_t * p_ctx);
+
+/**
+ * \brief   Checks if the session key rollover is due for a given context.
+ *
+ * \details
+ * Checks if the IFX I2C protocol stack is idle and the sequence numbers or the age of the session reached
+ * #OPTIGA_COMMS_KEY_ROLLOVER_SEQUENCE_NUMBER or #OPTIGA_COMMS_KEY_ROLLOVER_AGE_MS.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in]     p_ctx                Pointer to #ifx_i2c_context_t, must not be NULL
+ *
+ * \retval        TRUE                 Rollover is due
+ * \retval        FALSE                Rollover is not due
+ */
+bool_t ifx_i2c_rollover_due(const ifx_i2c_context_t * p_ctx);
+#endif
+
 /**
  * \brief   Sets the slave address of the target device.
  *
@@ -264,6 +309,107 @@ optiga_lib_status_t ifx_i2c_set_slave_address(ifx_i2c_context_t * p_ctx,
                                               uint8_t slave_address,
                                               uint8_t persistent);
 
+#ifdef OPTIGA_COMMS_BUS_ENUMERATION_ENABLED
+/**
+ * \brief   Assigns sequential slave addresses to the devices sharing one I2C bus.
+ *
+ * \details
+ * Moves the devices of the IFX I2C contexts ifx_i2c_context_list[first_instance_id] to
+ * ifx_i2c_context_list[first_instance_id + device_count - 1] from the default address #IFX_I2C_BASE_ADDR to the
+ * persistent addresses first_slave_address to first_slave_address + device_count - 1.
+ *  - This API is implemented in synchronous mode and is invoked once at boot, before #ifx_i2c_open of the devices.
+ *  - All the devices are held in reset using p_slave_reset_pin. They are released one at a time, hence only the
+ *    released device responds at the default address, while the others are in reset or already moved.
+ *  - A device, which does not respond at the default address, is expected at its assigned address
+ *    (e.g. the map was lost) and the address is written there again.
+ *  - The map (instances and assigned addresses) is stored using pal_os_datastore with
+ *    #OPTIGA_COMMS_BUS_MAP_ID. If the stored map matches the requested one, the addresses are applied to the
+ *    contexts without the reset sequence, hence the persistent address of a device is written only once.
+ *    To enumerate again (e.g. a device is replaced), clear the map by writing it with length 0.
+ *  - On success, the slave address of each IFX I2C context and its pal i2c context is the assigned address.
+ *
+ * \pre
+ * - The vdd and reset pins (pal_gpio_init) and the pal of the contexts are initialized.
+ * - IFX I2C protocol stack of the devices must not be opened.
+ *
+ * \note
+ * - The reset pin of each device must be separate, else the devices cannot be released one at a time.
+ * - The assigned addresses must not include #IFX_I2C_BASE_ADDR or the address of another slave on the bus.
+ *
+ * \param[in]     first_instance_id        Index of the first IFX I2C context in ifx_i2c_context_list
+ * \param[in]     device_count             Number of the devices
+ * \param[in]     first_slave_address      Address assigned to the first device, the next ones are incremented by one
+ *
+ * \retval        #IFX_I2C_STACK_SUCCESS
+ * \retval        #IFX_I2C_STACK_ERROR     Invalid parameters, missing reset pin or a device did not respond
+ */
+optiga_lib_status_t ifx_i2c_enumerate_bus(uint8_t first_instance_id,
+                                          uint8_t device_count,
+                                          uint8_t first_slave_address);
+#endif
+
+#if defined (OPTIGA_COMMS_EVENT_TRAMPOLINE_ENABLED) || defined (OPTIGA_COMMS_STACK_USAGE_ENABLED)
+/**
+ * \brief   Dispatches the event of a layer to the upper layer handler.
+ *
+ * \details
+ * Invokes the upper layer handler with the event.
+ * - With #OPTIGA_COMMS_EVENT_TRAMPOLINE_ENABLED, an event reported while another event is dispatched is queued and
+ *   the handler is invoked by the outermost dispatch, once the current handler returns.
+ *   Hence the layers are invoked one after the other instead of nested.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The event must be the last action of the layer, since the handler may be invoked after the layer returns.
+ *
+ * \param[in,out] p_ctx                Pointer to #ifx_i2c_context_t, must not be NULL
+ * \param[in]     handler              Upper layer event handler
+ * \param[in]     event                Event
+ * \param[in]     p_data               Data of the event, which must be held in the context
+ * \param[in]     data_len             Length of the data
+ */
+void ifx_i2c_dispatch_event(ifx_i2c_context_t * p_ctx,
+                            ifx_i2c_event_handler_t handler,
+                            optiga_lib_status_t event,
+                            const uint8_t * p_data,
+                            uint16_t data_len);
+
+/// Reports the event of a layer to the upper layer handler
+#define IFX_I2C_DISPATCH_EVENT(p_ctx, handler, event, p_data, data_len) \
+    ifx_i2c_dispatch_event((p_ctx), (handler), (event), (p_data), (data_len))
+#else
+/// Reports the event of a layer to the upper layer handler
+#define IFX_I2C_DISPATCH_EVENT(p_ctx, handler, event, p_data, data_len) \
+    (handler)((p_ctx), (event), (p_data), (data_len))
+#endif
+
+#ifdef OPTIGA_COMMS_STACK_USAGE_ENABLED
+/**
+ * \brief   Records the stack usage of the caller for a given context.
+ *
+ * \details
+ * Updates the stack high water mark with the stack usage at this call, relative to the dispatch of the first layer event.
+ * - This is invoked by the layers before the i2c transfers, which are the deepest calls of the protocol stack.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The usage is recorded only while a layer event is dispatched, i.e. in the context of the pal os event.
+ *
+ * \param[in,out] p_ctx                Pointer to #ifx_i2c_context_t, must not be NULL
+ */
+void ifx_i2c_stack_probe(ifx_i2c_context_t * p_ctx);
+
+/// Records the stack usage of the caller
+#define IFX_I2C_STACK_PROBE(p_ctx)          ifx_i2c_stack_probe(p_ctx)
+#else
+/// Records the stack usage of the caller
+#define IFX_I2C_STACK_PROBE(p_ctx)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -50,7 +50,9 @@ extern "C" {
 #include "optiga/pal/pal_gpio.h"
 #include "optiga/pal/pal_os_timer.h"
 #include "optiga/pal/pal_os_datastore.h"
+#include "optiga/pal/pal_crypt.h"
 #include "optiga/optiga_lib_config.h"
+#include "optiga/common/optiga_lib_common.h"
 #include "optiga/common/optiga_lib_logger.h"
 
 /** @brief I2C slave address of the Infineon device */
@@ -62,14 +64,34 @@ extern "C" {
 #define PL_POLLING_MAX_CNT          (200U)
 /** @brief Physical Layer: data register polling interval in microseconds */
 #define PL_DATA_POLLING_INVERVAL_US (5000U)
+/** @brief Physical Layer: data register polling interval in microseconds, if the data ready interrupt is used.
+*          The status register is read on the interrupt, this poll is only a fallback for a missed edge */
+#define PL_DATA_IRQ_POLLING_INVERVAL_US (50000U)
+/** @brief Physical Layer: first data register polling interval in microseconds after the expected execution time,
+*          if adaptive polling is used. It doubles with each poll up to PL_DATA_POLLING_INVERVAL_US */
+#define PL_ADAPTIVE_POLLING_MIN_INTERVAL_US (500U)
+/** @brief Physical Layer: no response is awaited with adaptive polling */
+#define PL_RESPONSE_WAIT_IDLE       (0x00)
+/** @brief Physical Layer: command is sent, the first poll for the response is scheduled with the expected execution time */
+#define PL_RESPONSE_WAIT_ARMED      (0x01)
+/** @brief Physical Layer: response is being polled, the time until it is ready is measured */
+#define PL_RESPONSE_WAIT_POLLING    (0x02)
 /** @brief Physical Layer: guard time interval in microseconds */
 #define PL_GUARD_TIME_INTERVAL_US   (50U)
+/** @brief Physical Layer: consecutive frame errors, after which the bitrate is halved with adaptive bitrate */
+#define PL_BIT_RATE_ERROR_THRESHOLD (2U)
+/** @brief Physical Layer: error free frames, after which the bitrate is doubled again with adaptive bitrate */
+#define PL_BIT_RATE_PROBE_FRAMES    (64U)
 
-/** @brief Data link layer: frame size (max supported is 277 in OPTIGA ).
+/** @brief Data link layer: minimum frame size */
+#define IFX_I2C_FRAME_SIZE_MIN          (16U)
+
+/** @brief Data link layer: max frame size (max supported is 277 in OPTIGA ), which sizes the frame buffers.
 *          - Note: This can be configured externally to a lesser value due to platform restrictions.<br>
-*            Externally means through command line argument or project configuration or optiga_lib_config.h*/
+*            Externally means through command line argument or project configuration or optiga_lib_config.h
+*          - The frame size used at runtime is negotiated with the slave, up to #ifx_i2c_context_t.frame_size*/
 #ifdef IFX_I2C_FRAME_SIZE
-    #if (IFX_I2C_FRAME_SIZE > 277) || (IFX_I2C_FRAME_SIZE < 16)
+    #if (IFX_I2C_FRAME_SIZE > 277) || (IFX_I2C_FRAME_SIZE < IFX_I2C_FRAME_SIZE_MIN)
         #error "Unsupported value for IFX_I2C_FRAME_SIZE"
     #endif
 #else
@@ -77,12 +99,53 @@ extern "C" {
     #define IFX_I2C_FRAME_SIZE          (277U)
 #endif
 
+/** @brief Data link layer: CRC16 calculated bit serial, smallest code size */
+#define IFX_I2C_DL_CRC_BIT_SERIAL   (0x00)
+/** @brief Data link layer: CRC16 calculated with a table of 256 entries (512 bytes) */
+#define IFX_I2C_DL_CRC_TABLE        (0x01)
+/** @brief Data link layer: CRC16 calculated four bytes per step with 4 tables of 256 entries (2 KB) */
+#define IFX_I2C_DL_CRC_SLICE_BY_4   (0x02)
+/** @brief Data link layer: CRC16 calculated by the CRC unit of the platform (refer pal_crc16_calculate) */
+#define IFX_I2C_DL_CRC_HARDWARE     (0x03)
+
+/** @brief Data link layer: implementation of the frame CRC16, one of the IFX_I2C_DL_CRC_* values.
+*          - Note: This can be configured externally, e.g. to IFX_I2C_DL_CRC_BIT_SERIAL for the smallest flash size.<br>
+*            Externally means through command line argument or project configuration or optiga_lib_config.h*/
+#ifndef IFX_I2C_DL_CRC_IMPLEMENTATION
+    #define IFX_I2C_DL_CRC_IMPLEMENTATION   (IFX_I2C_DL_CRC_TABLE)
+#endif
+
 /** @brief Transport Layer: header size */
 #define TL_HEADER_SIZE              (1U)
 /** @brief Data link layer: header size */
 #define DL_HEADER_SIZE              (5U)
 /** @brief Data link layer: maximum number of retries in case of transmission error */
-#define DL_TRANS_REPEAT             (3U)
+#ifndef DL_TRANS_REPEAT
+    #define DL_TRANS_REPEAT         (3U)
+#endif
+/** @brief Data link layer: resend backoff in microseconds after a corrupted frame is received (bus noise) */
+#ifndef DL_RESEND_BACKOFF_CRC_US
+    #define DL_RESEND_BACKOFF_CRC_US        (200U)
+#endif
+/** @brief Data link layer: resend backoff in microseconds after the slave did not acknowledge (NACK) a frame */
+#ifndef DL_RESEND_BACKOFF_NACK_US
+    #define DL_RESEND_BACKOFF_NACK_US       (500U)
+#endif
+/** @brief Data link layer: resend backoff in microseconds after no frame is received or a write failed */
+#ifndef DL_RESEND_BACKOFF_TIMEOUT_US
+    #define DL_RESEND_BACKOFF_TIMEOUT_US    (2000U)
+#endif
+/** @brief Data link layer: maximum resend backoff in microseconds, the backoff doubles with each retry */
+#ifndef DL_RESEND_BACKOFF_MAX_US
+    #define DL_RESEND_BACKOFF_MAX_US        (50000U)
+#endif
+/** @brief Data link layer: mask of the random jitter in microseconds, which is added to the resend backoff */
+#define DL_RESEND_BACKOFF_JITTER_MASK_US    (0xFFU)
+/** @brief Number of layer events queued by the trampoline. A layer reports one event at a time, hence one per layer
+*          is sufficient. If the queue is full, the event is dispatched nested */
+#ifndef IFX_I2C_EVENT_QUEUE_SIZE
+    #define IFX_I2C_EVENT_QUEUE_SIZE        (4U)
+#endif
 /** @brief Data link layer: Trans timeout in milliseconds*/
 #define PL_TRANS_TIMEOUT_MS         (10U)
 
@@ -93,6 +156,14 @@ extern "C" {
 #define RESET_LOW_TIME_MSEC         (2000U)
 /** @brief Start up time */
 #define STARTUP_TIME_MSEC           (12000U)
+/** @brief Minimum start up time with fast startup, after which the slave is polled until it acknowledges its address */
+#define STARTUP_MIN_TIME_USEC       (1000U)
+/** @brief Start up time, which is waited after a reset before the negotiation starts */
+#ifdef OPTIGA_COMMS_FAST_STARTUP_ENABLED
+    #define STARTUP_WAIT_TIME_USEC  (STARTUP_MIN_TIME_USEC)
+#else
+    #define STARTUP_WAIT_TIME_USEC  (STARTUP_TIME_MSEC)
+#endif
 
 /** @brief Protocol Stack: Status codes for success */
 #define IFX_I2C_STACK_SUCCESS       (0x0000)
@@ -113,6 +184,10 @@ extern "C" {
 #define IFX_I2C_DL_HEADER_OFFSET    (0U)
 /** @brief Offset of Transport header in tx_frame_buffer */
 #define IFX_I2C_TL_HEADER_OFFSET    (IFX_I2C_DL_HEADER_OFFSET + 3)
+/** @brief Room in front of the packet, which is used for the headers, if a frame is formed in place */
+#define IFX_I2C_TX_HEADROOM         (IFX_I2C_TL_HEADER_OFFSET + TL_HEADER_SIZE)
+/** @brief Room after the packet, which is used for the checksum, if a frame is formed in place */
+#define IFX_I2C_TX_TAILROOM         (DL_HEADER_SIZE - IFX_I2C_TL_HEADER_OFFSET)
 /** @brief Protocol Stack debug switch for physical layer (set to 0 or 1) */
 #define IFX_I2C_LOG_PL              (0U)
 /** @brief Protocol Stack debug switch for data link layer (set to 0 or 1) */
@@ -121,6 +196,10 @@ extern "C" {
 #define IFX_I2C_LOG_TL              (0U)
 /** @brief Protocol Stack debug switch for presentation layer (set to 0 or 1) */
 #define IFX_I2C_LOG_PRL             (0U)
+#if defined (OPTIGA_LIB_LOGGER_DEFERRED_ENABLED) && !defined (IFX_I2C_LOG)
+/** @brief Protocol Stack debug statements are recorded by the deferred logger, without formatting */
+#define IFX_I2C_LOG                 OPTIGA_LIB_LOGGER_DEFERRED_FORMAT
+#endif
 
 /** @brief Log ID number for physical layer */
 #define IFX_I2C_LOG_ID_PL           (0x00)
@@ -188,6 +267,21 @@ typedef void ( * ifx_i2c_event_handler_t)(struct ifx_i2c_context * p_ctx,
                                           const uint8_t * data,
                                           uint16_t data_len);
 
+#ifdef OPTIGA_COMMS_EVENT_TRAMPOLINE_ENABLED
+/** @brief Event of a layer to its upper layer, queued by the trampoline */
+typedef struct ifx_i2c_event
+{
+    /// Event handler of the upper layer
+    ifx_i2c_event_handler_t handler;
+    /// Data of the event, which is held in the context of the layer
+    const uint8_t * p_data;
+    /// Event
+    optiga_lib_status_t event;
+    /// Length of the data
+    uint16_t data_len;
+}ifx_i2c_event_t;
+#endif
+
 /** @brief Physical layer structure */
 typedef struct ifx_i2c_pl
 {
@@ -205,6 +299,10 @@ typedef struct ifx_i2c_pl
     uint8_t  i2c_cmd;
     /// Retry counter
     uint16_t retry_counter;
+#ifdef OPTIGA_CMD_HEALTH_MONITOR_ENABLED
+    /// Time of the first PAL error of the ongoing retries, in microseconds
+    uint32_t unresponsive_start_time;
+#endif
 
     // Physical Layer high level interface variables
 
@@ -223,6 +321,48 @@ typedef struct ifx_i2c_pl
 
     /// Negotiation state
     uint8_t   negotiate_state;
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+    /// Interval of the next data register poll in microseconds
+    uint32_t  poll_interval_us;
+    /// Start time of the wait for the response in microseconds
+    uint32_t  response_wait_start_us;
+    /// State of the wait for the response (idle, armed by transport layer or polling)
+    uint8_t   response_wait_state;
+#endif
+#ifdef OPTIGA_COMMS_ADAPTIVE_BITRATE_ENABLED
+    /// Current bitrate of the I2C master in KHz, not greater than the negotiated frequency
+    uint16_t  bit_rate;
+    /// Consecutive frame errors at the current bitrate
+    uint8_t   bit_rate_error_count;
+    /// Error free frames at the current bitrate
+    uint16_t  bit_rate_frame_count;
+#endif
+#ifdef OPTIGA_COMMS_DATA_READY_IRQ_ENABLED
+    /// Data ready interrupt is registered with the pal gpio
+    uint8_t   data_ready_irq_registered;
+    /// Physical layer waits for the response, the data ready interrupt triggers the STATUS register read
+    volatile uint8_t data_ready_irq_armed;
+#endif
+#ifdef OPTIGA_COMMS_PL_NEGOTIATION_CACHE_ENABLED
+    /// Negotiation result is cached
+    uint8_t   negotiation_cached;
+    /// Cached negotiation is applied and not yet verified by a frame exchange
+    uint8_t   negotiation_unverified;
+    /// Error is reported to the upper layer, once the negotiation is repeated
+    uint8_t   renegotiation_error;
+    /// Slave address of the cached negotiation
+    uint8_t   cached_slave_address;
+    /// Requested frequency of the cached negotiation
+    uint16_t  cached_frequency;
+    /// Requested frame size of the cached negotiation
+    uint16_t  cached_frame_size;
+    /// Frame size negotiated with the slave
+    uint16_t  cached_negotiated_frame_size;
+#endif
+#ifdef OPTIGA_COMMS_SPECULATIVE_READ_ENABLED
+    /// Length of the next received frame, if it is known by the data link layer (0 otherwise)
+    uint16_t  speculative_read_len;
+#endif
     /// Soft reset requested
     uint8_t   request_soft_reset;
 } ifx_i2c_pl_t;
@@ -246,6 +386,22 @@ typedef struct ifx_i2c_dl
     uint8_t error;
     /// Resynced
     uint8_t resynced;
+#ifdef OPTIGA_COMMS_ACK_PIGGYBACK_ENABLED
+    /// ACK of the last received frame is not yet sent, it is carried by the next data frame
+    uint8_t ack_pending;
+#endif
+    /// Frame counters are resynchronized, once the initialization is complete (no reset of the slave)
+    uint8_t resync_on_init;
+#ifdef OPTIGA_COMMS_DL_RESEND_BACKOFF_ENABLED
+    /// Class of the last error (corrupted frame, NACK or timeout), which selects the resend backoff
+    uint8_t error_class;
+    /// Indicates an error occured, which is not yet recovered
+    uint8_t recovering;
+    /// Time of the first error, which is not yet recovered, in microseconds
+    uint32_t recovery_start_time;
+    /// Error recovery statistics
+    optiga_lib_comms_recovery_stats_t recovery_stats;
+#endif
     /// Timeout value
     uint32_t data_poll_timeout;
     /// Transmit buffer size
@@ -301,6 +457,10 @@ typedef struct ifx_i2c_tl
     uint8_t tx_payload_offset;
     ///Initial state check
     uint8_t initialization_state;
+#ifdef OPTIGA_COMMS_ZERO_COPY_RX
+    /// Offset in the received packet of the first byte stored to the rx destination, IFX_I2C_TL_NO_RX_DESTINATION if not used
+    uint16_t rx_destination_offset;
+#endif
 
     /// Upper layer event handler
     ifx_i2c_event_handler_t upper_layer_event_handler;
@@ -382,8 +542,12 @@ typedef struct ifx_i2c_prl
     uint8_t prl_txrx_buffer[58];
     /// Receive txrx buffer length
     uint16_t prl_txrx_receive_length;
-    /// Associate data buffer
-    uint8_t associate_data[8];
+    /// Associated data templates of the master and slave direction, patched with the header of each record
+    uint8_t associate_data[2][8];
+    /// Nonce templates (implicit nonce from the session key) of the master and slave direction, patched with the sequence number
+    uint8_t nonce_template[2][8];
+    /// Indicates the templates are prepared from the current session key
+    uint8_t frame_templates_valid;
     /// Receive buffer length
     uint16_t prl_receive_length;
     /// Master retransmit counter
@@ -400,9 +564,38 @@ typedef struct ifx_i2c_prl
     ifx_i2c_event_handler_t upper_layer_event_handler;
     // Trans repeat status
     uint8_t trans_repeat_status;
+    /// Crypt context, which keeps the key schedules of the session keys
+    pal_crypt_t pal_crypt;
+#ifdef OPTIGA_COMMS_KEY_ROLLOVER_ENABLED
+    /// Indicates the ongoing handshake is a session key rollover, without any data to be exchanged
+    uint8_t key_rollover_flag;
+    /// Time stamp in milliseconds, at which the session was negotiated
+    uint32_t session_start_time;
+#endif
 }ifx_i2c_prl_t;
 #endif
 
+#if defined (OPTIGA_COMMS_WARM_REATTACH_ENABLED) || defined (OPTIGA_COMMS_SHARED_LINK_ENABLED)
+/** @brief Link state, which is saved on close and restored on open with warm attach, or handed over between processes */
+typedef struct ifx_i2c_link_state
+{
+    /// Indicates the link state is saved (close) or restored (open)
+    uint8_t stored_link_state_flag;
+    /// Sequence number of the last transmitted data link layer frame
+    uint8_t tx_seq_nr;
+    /// Sequence number of the last received data link layer frame
+    uint8_t rx_seq_nr;
+    /// Frequency of i2c master
+    uint16_t frequency;
+    /// Data link layer frame size negotiated with the slave
+    uint16_t negotiated_frame_size;
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+    /// Session of the shielded connection
+    ifx_i2c_prl_manage_context_t prl_ctx;
+#endif
+}ifx_i2c_link_state_t;
+#endif
+
 /** @brief IFX I2C context structure */
 typedef struct ifx_i2c_context
 {
@@ -410,7 +603,7 @@ typedef struct ifx_i2c_context
     uint8_t slave_address;
     /// Frequency of i2c master
     uint16_t frequency;
-    /// Data link layer frame size
+    /// Largest data link layer frame size requested during negotiation, must not be greater than IFX_I2C_FRAME_SIZE
     uint16_t frame_size;
     /// Pointer to pal gpio context for vdd
     pal_gpio_t * p_slave_vdd_pin;
@@ -421,6 +614,10 @@ typedef struct ifx_i2c_context
 #if defined OPTIGA_COMMS_SHIELDED_CONNECTION
     /// Datastore configuration instance for prl
     ifx_i2c_datastore_config_t * ifx_i2c_datastore_config;
+#endif
+#ifdef OPTIGA_COMMS_DATA_READY_IRQ_ENABLED
+    /// Pointer to pal gpio context for the data ready interrupt
+    pal_gpio_t * p_slave_irq_pin;
 #endif
     /// Upper layer event handler
     upper_layer_callback_t upper_layer_event_handler;
@@ -430,6 +627,43 @@ typedef struct ifx_i2c_context
     uint8_t * p_upper_layer_rx_buffer;
     /// Pointer to length of upper layer rx buffer
     uint16_t * p_upper_layer_rx_buffer_len;
+#if defined (OPTIGA_COMMS_ZERO_COPY_TX) || defined (OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED)
+    /// Start of upper layer tx data, which has IFX_I2C_TX_HEADROOM reserved in front
+    const uint8_t * p_upper_layer_tx_data;
+    /// End of upper layer tx data including presentation layer overhead, which has IFX_I2C_TX_TAILROOM reserved after
+    const uint8_t * p_upper_layer_tx_data_end;
+#endif
+#ifdef OPTIGA_COMMS_ZERO_COPY_RX
+    /// Buffer, to which the upper layer rx data from p_rx_destination_start onwards is stored, NULL if not used
+    uint8_t * p_rx_destination;
+    /// Position in the upper layer rx buffer of the first byte, which is stored to p_rx_destination
+    const uint8_t * p_rx_destination_start;
+    /// Size of p_rx_destination
+    uint16_t rx_destination_size;
+    /// Number of bytes of the received packet stored to p_rx_destination
+    uint16_t rx_destination_length;
+#endif
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+    /// Expected execution time of the upper layer tx data (command) in microseconds, 0 if unknown
+    uint32_t response_time_hint_us;
+    /// Measured time from the transmission of the command until the response is ready in microseconds, 0 if unknown
+    uint32_t response_time_us;
+#endif
+#if defined (OPTIGA_LIB_TRACE_ENABLED) || defined (OPTIGA_LIB_STATISTICS_ENABLED)
+    /// Indicates the execution on OPTIGA is measured, from the last fragment of a packet till the response is ready
+    uint8_t execution_pending;
+#endif
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+    /// Time in microseconds, at which the last fragment of the packet in execution is sent
+    uint32_t execution_start_us;
+    /// Time in microseconds, at which the I2C transfer in progress is started
+    uint32_t i2c_transfer_start_us;
+    /// Remainders of the execution and I2C times in microseconds, which are accounted in milliseconds
+    uint32_t execution_time_remainder_us;
+    uint32_t i2c_time_remainder_us;
+    /// Link statistics of the communication
+    optiga_lib_comms_stats_t statistics;
+#endif
 
     /// Protocol variables
     /// ifx i2c wrapper apis state
@@ -444,6 +678,14 @@ typedef struct ifx_i2c_context
     uint8_t reset_type;
     /// init pal
     uint8_t do_pal_init;
+    /// Data link layer frame size negotiated with the slave
+    uint16_t negotiated_frame_size;
+#ifdef OPTIGA_LIB_FAST_RESUME_ENABLED
+    /// Indicates the device is powered off by the close, since power_off_time
+    uint8_t powered_off;
+    /// Time in microseconds, at which the device is powered off
+    uint32_t power_off_time;
+#endif
 #ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
     // protection level:
     //0(master unprotected and slave unprotected),1(master protected and slave unprotected),
@@ -464,18 +706,49 @@ typedef struct ifx_i2c_context
 #ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
     /// Presentation layer context
     ifx_i2c_prl_t prl;
+#endif
+#ifdef OPTIGA_COMMS_WARM_REATTACH_ENABLED
+    /// Link state for the warm reattach
+    ifx_i2c_link_state_t link_state;
+#endif
+#ifdef OPTIGA_COMMS_SHARED_LINK_ENABLED
+    /// Link state of the last owner of the link shared with other processes
+    ifx_i2c_link_state_t shared_link_state;
+    /// Indicates the shared link is owned by this process for the ongoing transaction
+    uint8_t shared_link_owned;
 #endif
     /// IFX I2C tx frame of max length
     uint8_t tx_frame_buffer[IFX_I2C_FRAME_SIZE+1];
     /// IFX I2C rx frame of max length
     uint8_t rx_frame_buffer[IFX_I2C_FRAME_SIZE+1];
     void * pal_os_event_ctx;
+#if defined (OPTIGA_COMMS_EVENT_TRAMPOLINE_ENABLED) || defined (OPTIGA_COMMS_STACK_USAGE_ENABLED)
+    /// Number of layer events in dispatch, 0 if no layer event is dispatched
+    uint8_t event_dispatch_depth;
+#endif
+#ifdef OPTIGA_COMMS_EVENT_TRAMPOLINE_ENABLED
+    /// Index of the oldest queued layer event
+    uint8_t event_queue_head;
+    /// Number of queued layer events
+    uint8_t event_queue_count;
+    /// Layer events, which are queued while a layer event is dispatched
+    ifx_i2c_event_t event_queue[IFX_I2C_EVENT_QUEUE_SIZE];
+#endif
+#ifdef OPTIGA_COMMS_STACK_USAGE_ENABLED
+    /// Stack address at the dispatch of the first layer event
+    uintptr_t stack_base;
+    /// Maximum stack usage in bytes below the stack base
+    uint32_t stack_high_water;
+#endif
 
 } ifx_i2c_context_t;
 
 /** @brief IFX I2C Instance */
 extern ifx_i2c_context_t ifx_i2c_context_0;
 
+/** @brief IFX I2C Instance of each OPTIGA instance, indexed by the optiga instance id */
+extern ifx_i2c_context_t * const ifx_i2c_context_list[OPTIGA_MAX_NUMBER_OF_INSTANCES];
+
 #endif
 
 #ifdef __cplusplus
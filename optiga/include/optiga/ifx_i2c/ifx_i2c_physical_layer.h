@@ -136,6 +136,30 @@ optiga_lib_status_t ifx_i2c_pl_receive_frame(ifx_i2c_context_t * p_ctx);
 optiga_lib_status_t ifx_i2c_pl_write_slave_address(ifx_i2c_context_t * p_ctx,
                                                    uint8_t slave_address,
                                                    uint8_t storage_type);
+
+#ifdef OPTIGA_COMMS_ADAPTIVE_BITRATE_ENABLED
+/**
+ * \brief Function for adapting the bitrate to the frame errors.
+ *
+ * \details
+ * Synchronous function to adapt the bitrate of the I2C master to the frame errors reported by the upper layer.
+ * - After #PL_BIT_RATE_ERROR_THRESHOLD consecutive frame errors, the bitrate is halved, down to 100 KHz.
+ * - After #PL_BIT_RATE_PROBE_FRAMES error free frames, the bitrate is doubled, up to the negotiated frequency.
+ *
+ * \pre
+ * - The negotiation must be completed.
+ *
+ * \note
+ * - This function must be invoked only between frames, when the physical layer is idle.
+ * - The frequency of the slave is not changed, the slave accepts any bitrate below the negotiated frequency.
+ *
+ * \param[in,out] p_ctx                   Pointer to IFX I2C context.
+ * \param[in]     frame_error             TRUE, if the frame was lost or corrupted (NACK, CRC error or timeout).<br>
+ *                                        FALSE, if the frame was exchanged successfully.
+ */
+void ifx_i2c_pl_adapt_bit_rate(ifx_i2c_context_t * p_ctx,
+                               uint8_t frame_error);
+#endif
 /**
  * @}
  **/
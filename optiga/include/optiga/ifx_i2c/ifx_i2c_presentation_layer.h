@@ -121,6 +121,49 @@ optiga_lib_status_t ifx_i2c_prl_transceive(ifx_i2c_context_t * p_ctx,
  */
 optiga_lib_status_t ifx_i2c_prl_close(ifx_i2c_context_t * p_ctx,
                                       ifx_i2c_event_handler_t handler);
+
+#ifdef OPTIGA_COMMS_KEY_ROLLOVER_ENABLED
+/**
+ * \brief Function to renegotiate the session key.
+ *
+ * \details
+ * Asynchronous function to renegotiate the session key of the established shielded connection, without any data to be exchanged.
+ * - The function returns immediately.
+ * - The completion is propagated to the event handler registered with #ifx_i2c_prl_init, without any data.
+ *
+ * \pre
+ * - The secure channel must be established.
+ *
+ * \note
+ * - If the renegotiation fails, the secure channel is established again with the next transceive.
+ *
+ * \param[in,out] p_ctx                      Pointer to ifx i2c context.
+ *
+ * \retval        IFX_I2C_STACK_SUCCESS      If function was successful.
+ * \retval        IFX_I2C_STACK_ERROR        If the module is busy or the secure channel is not established.
+ */
+optiga_lib_status_t ifx_i2c_prl_rollover(ifx_i2c_context_t * p_ctx);
+
+/**
+ * \brief Function to check if the session key rollover is due.
+ *
+ * \details
+ * Checks the sequence numbers against #OPTIGA_COMMS_KEY_ROLLOVER_SEQUENCE_NUMBER and the age of the session
+ * against #OPTIGA_COMMS_KEY_ROLLOVER_AGE_MS.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]     p_ctx                      Pointer to ifx i2c context.
+ *
+ * \retval        TRUE                       If the secure channel is established and the rollover is due.
+ * \retval        FALSE                      Otherwise.
+ */
+bool_t ifx_i2c_prl_rollover_due(const ifx_i2c_context_t * p_ctx);
+#endif
  
 #ifdef __cplusplus
 }
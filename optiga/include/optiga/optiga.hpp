@@ -0,0 +1,517 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga.hpp
+*
+* \brief   This file implements the header only C++20 binding of OPTIGA Util and OPTIGA Crypt, with RAII instances and
+*          operations awaitable from coroutines.
+*
+* \ingroup  grOptigaCrypt
+*
+* @{
+*/
+
+#ifndef _OPTIGA_HPP_
+#define _OPTIGA_HPP_
+
+#if defined (__cplusplus) && (__cplusplus >= 202002L)
+
+#include <coroutine>
+#include <cstddef>
+#include <span>
+
+#include "optiga/optiga_util.h"
+#include "optiga/optiga_crypt.h"
+#include "optiga/optiga_crypt_cq.h"
+
+namespace optiga
+{
+
+/**
+ * \brief Operation of an OPTIGA util instance, awaitable from a coroutine.
+ *
+ * \details
+ * - The operation is started when awaited. The result of co_await is the status of the operation.
+ * - The awaiter lives in the coroutine frame, no memory is allocated per operation.
+ * - The coroutine is resumed from the callback of the util instance, i.e. in the context which executes the
+ *   OPTIGA events (Refer pal_os_event.h).
+ */
+template <typename start_t>
+class util_operation;
+
+/**
+ * \brief RAII handle of an OPTIGA util instance.
+ *
+ * \details
+ * - Creates the util instance on construction and destroys it on destruction.
+ * - Only one operation can be awaited at a time, as with the C API.
+ * - The handle is neither copyable nor movable, since the instance reports its completions to the handle.
+ */
+class util
+{
+public:
+    /// Creates the util instance associated with the OPTIGA instance
+    explicit util(uint8_t optiga_instance_id = 0)
+        : p_util_(optiga_util_create(optiga_instance_id, &util::handler, this))
+    {
+    }
+
+    ~util()
+    {
+        if (nullptr != p_util_)
+        {
+            (void)optiga_util_destroy(p_util_);
+        }
+    }
+
+    util(const util &) = delete;
+    util & operator=(const util &) = delete;
+
+    /// TRUE, if the util instance is created
+    explicit operator bool() const
+    {
+        return (nullptr != p_util_);
+    }
+
+    /// Util instance, to invoke the C API which is not covered by the binding
+    optiga_util_t * get() const
+    {
+        return (p_util_);
+    }
+
+    /// Awaits the operation started by start(), which invokes an asynchronous optiga_util API
+    template <typename start_t>
+    util_operation<start_t> submit(start_t start);
+
+    /// Refer #optiga_util_open_application
+    auto open_application(bool_t perform_restore = FALSE);
+
+    /// Refer #optiga_util_close_application
+    auto close_application(bool_t perform_hibernate = FALSE);
+
+    /// Refer #optiga_util_read_data, length is updated with the length of the data read on completion
+    auto read_data(uint16_t optiga_oid, uint16_t offset, std::span<uint8_t> buffer, uint16_t & length);
+
+    /// Refer #optiga_util_write_data
+    auto write_data(uint16_t optiga_oid, uint8_t write_type, uint16_t offset, std::span<const uint8_t> buffer);
+
+private:
+    template <typename start_t>
+    friend class util_operation;
+
+    /// Awaiter of the operation in progress
+    struct waiter
+    {
+        std::coroutine_handle<> handle;
+        optiga_lib_status_t status;
+    };
+
+    static void handler(void * p_context, optiga_lib_status_t return_status)
+    {
+        util * me = static_cast<util *>(p_context);
+        waiter * p_waiter = me->p_waiter_;
+
+        me->p_waiter_ = nullptr;
+        if (nullptr != p_waiter)
+        {
+            p_waiter->status = return_status;
+            p_waiter->handle.resume();
+        }
+    }
+
+    optiga_util_t * p_util_;
+    waiter * p_waiter_ = nullptr;
+};
+
+template <typename start_t>
+class util_operation
+{
+public:
+    util_operation(util & owner, start_t start)
+        : owner_(owner), start_(start)
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return (false);
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        optiga_lib_status_t return_status;
+
+        waiter_.handle = handle;
+        waiter_.status = OPTIGA_UTIL_ERROR;
+        owner_.p_waiter_ = &waiter_;
+        // The completion may resume the coroutine before start_ returns, the awaiter is not accessed afterwards
+        return_status = start_(owner_.p_util_);
+        if (OPTIGA_LIB_SUCCESS != return_status)
+        {
+            owner_.p_waiter_ = nullptr;
+            waiter_.status = return_status;
+            return (false);
+        }
+        return (true);
+    }
+
+    optiga_lib_status_t await_resume() const noexcept
+    {
+        return (waiter_.status);
+    }
+
+private:
+    util & owner_;
+    start_t start_;
+    util::waiter waiter_;
+};
+
+template <typename start_t>
+util_operation<start_t> util::submit(start_t start)
+{
+    return (util_operation<start_t>(*this, start));
+}
+
+inline auto util::open_application(bool_t perform_restore)
+{
+    return (submit([=](optiga_util_t * p_util)
+                   { return (optiga_util_open_application(p_util, perform_restore)); }));
+}
+
+inline auto util::close_application(bool_t perform_hibernate)
+{
+    return (submit([=](optiga_util_t * p_util)
+                   { return (optiga_util_close_application(p_util, perform_hibernate)); }));
+}
+
+inline auto util::read_data(uint16_t optiga_oid, uint16_t offset, std::span<uint8_t> buffer, uint16_t & length)
+{
+    length = static_cast<uint16_t>(buffer.size());
+    return (submit([=, &length](optiga_util_t * p_util)
+                   { return (optiga_util_read_data(p_util, optiga_oid, offset, buffer.data(), &length)); }));
+}
+
+inline auto util::write_data(uint16_t optiga_oid, uint8_t write_type, uint16_t offset, std::span<const uint8_t> buffer)
+{
+    return (submit([=](optiga_util_t * p_util)
+                   {
+                       return (optiga_util_write_data(p_util, optiga_oid, write_type, offset,
+                                                      buffer.data(), static_cast<uint16_t>(buffer.size())));
+                   }));
+}
+
+#ifdef OPTIGA_CRYPT_CQ_ENABLED
+/**
+ * \brief Base of the crypt operations, linked in the executor while waiting for a crypt instance.
+ */
+class crypt_operation_base
+{
+protected:
+    template <uint8_t depth>
+    friend class crypt_executor;
+
+    /// Starts the operation with the crypt instance acquired from the completion queue
+    virtual optiga_lib_status_t start(optiga_crypt_t * p_crypt) = 0;
+
+    std::coroutine_handle<> handle_;
+    optiga_lib_status_t status_ = OPTIGA_CRYPT_ERROR;
+    /// Next operation waiting for a crypt instance
+    crypt_operation_base * p_next_ = nullptr;
+};
+
+/**
+ * \brief Executor of crypt operations, built on the crypt completion queue (Refer optiga_crypt_cq.h).
+ *
+ * \details
+ * - Holds depth crypt instances, which are pooled among the awaited operations.
+ * - Operations awaited while all the crypt instances are in use wait in the executor, without any allocation,
+ *   and are started once an instance is returned. Hence any number of operations can be awaited concurrently.
+ * - The coroutines are resumed by #poll, in the thread of the executor. The operations must be awaited in the
+ *   same thread.
+ * - The event loop either polls the descriptor (#descriptor) and invokes #poll when it is readable,
+ *   or invokes #run_one.
+ *
+ * \note
+ * - The executor is neither copyable nor movable, since the completion queue refers to the slots of the executor.
+ */
+template <uint8_t depth>
+class crypt_executor
+{
+    static_assert((depth > 0) && (depth < 0xFF), "depth must be in the range 1 to 254");
+
+public:
+    /// Initializes the completion queue with depth crypt instances, associated with the OPTIGA instance
+    explicit crypt_executor(uint8_t optiga_instance_id = 0)
+    {
+        init_status_ = optiga_crypt_cq_init(&cq_, optiga_instance_id, slots_, depth);
+    }
+
+    ~crypt_executor()
+    {
+        if (OPTIGA_LIB_SUCCESS == init_status_)
+        {
+            (void)optiga_crypt_cq_deinit(&cq_);
+        }
+    }
+
+    crypt_executor(const crypt_executor &) = delete;
+    crypt_executor & operator=(const crypt_executor &) = delete;
+
+    /// Status of the initialization of the completion queue
+    optiga_lib_status_t init_status() const
+    {
+        return (init_status_);
+    }
+
+    /// Pollable descriptor, readable when completions are available. -1, if the platform does not provide one.
+    int32_t descriptor() const
+    {
+        return (optiga_crypt_cq_get_descriptor(&cq_));
+    }
+
+    /**
+     * \brief Resumes the coroutines of the completed operations and starts the waiting operations.
+     *
+     * \retval Number of completed operations.
+     */
+    std::size_t poll()
+    {
+        optiga_crypt_cq_completion_t completions[depth];
+        uint8_t count;
+        uint8_t index;
+
+        count = optiga_crypt_cq_reap(&cq_, completions, depth);
+        // The crypt instances of the reaped operations are returned already
+        start_waiting();
+        for (index = 0; index < count; index++)
+        {
+            crypt_operation_base * p_operation = static_cast<crypt_operation_base *>(completions[index].user_tag);
+            p_operation->status_ = completions[index].status;
+            p_operation->handle_.resume();
+        }
+        return (count);
+    }
+
+    /// Blocks until an operation completes, and resumes the coroutines of the completed operations
+    std::size_t run_one()
+    {
+        optiga_crypt_cq_wait(&cq_);
+        return (poll());
+    }
+
+    /// Awaits the operation started by start(), which invokes an asynchronous optiga_crypt API once
+    template <typename start_t>
+    auto submit(start_t start);
+
+#ifdef OPTIGA_CRYPT_RANDOM_ENABLED
+    /// Refer #optiga_crypt_random
+    auto random(optiga_rng_type_t rng_type, std::span<uint8_t> random_data)
+    {
+        return (submit([=](optiga_crypt_t * p_crypt)
+                       {
+                           return (optiga_crypt_random(p_crypt, rng_type, random_data.data(),
+                                                       static_cast<uint16_t>(random_data.size())));
+                       }));
+    }
+#endif //OPTIGA_CRYPT_RANDOM_ENABLED
+
+#ifdef OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
+    /// Refer #optiga_crypt_ecdsa_sign, signature_length is updated with the length of the signature on completion
+    auto ecdsa_sign(std::span<const uint8_t> digest, optiga_key_id_t private_key,
+                    std::span<uint8_t> signature, uint16_t & signature_length)
+    {
+        signature_length = static_cast<uint16_t>(signature.size());
+        return (submit([=, &signature_length](optiga_crypt_t * p_crypt)
+                       {
+                           return (optiga_crypt_ecdsa_sign(p_crypt, digest.data(), static_cast<uint8_t>(digest.size()),
+                                                           private_key, signature.data(), &signature_length));
+                       }));
+    }
+#endif //OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
+
+#ifdef OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED
+    /// Refer #optiga_crypt_ecdsa_verify
+    auto ecdsa_verify(std::span<const uint8_t> digest, std::span<const uint8_t> signature,
+                      uint8_t public_key_source_type, const void * public_key)
+    {
+        return (submit([=](optiga_crypt_t * p_crypt)
+                       {
+                           return (optiga_crypt_ecdsa_verify(p_crypt, digest.data(), static_cast<uint8_t>(digest.size()),
+                                                             signature.data(), static_cast<uint16_t>(signature.size()),
+                                                             public_key_source_type, public_key));
+                       }));
+    }
+#endif //OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED
+
+private:
+    template <uint8_t, typename>
+    friend class crypt_operation;
+
+    /// Result of starting an operation
+    enum class start_result
+    {
+        started,
+        failed,
+        no_instance
+    };
+
+    // Starts the operation, or links it to wait for a crypt instance. Returns FALSE, if the operation failed to start.
+    bool enqueue(crypt_operation_base * p_operation)
+    {
+        start_result result = start_result::no_instance;
+
+        if (nullptr == p_waiting_head_)
+        {
+            result = try_start(p_operation);
+        }
+        if (start_result::no_instance != result)
+        {
+            return (start_result::started == result);
+        }
+
+        p_operation->p_next_ = nullptr;
+        if (nullptr == p_waiting_head_)
+        {
+            p_waiting_head_ = p_operation;
+        }
+        else
+        {
+            p_waiting_tail_->p_next_ = p_operation;
+        }
+        p_waiting_tail_ = p_operation;
+        return (true);
+    }
+
+    start_result try_start(crypt_operation_base * p_operation)
+    {
+        optiga_crypt_t * p_crypt = optiga_crypt_cq_acquire(&cq_, p_operation);
+
+        if (nullptr == p_crypt)
+        {
+            return (start_result::no_instance);
+        }
+        p_operation->status_ = p_operation->start(p_crypt);
+        if (OPTIGA_LIB_SUCCESS != p_operation->status_)
+        {
+            optiga_crypt_cq_cancel(&cq_, p_crypt);
+            return (start_result::failed);
+        }
+        return (start_result::started);
+    }
+
+    // Starts the waiting operations in order of submission, as long as crypt instances are available
+    void start_waiting()
+    {
+        crypt_operation_base * p_operation;
+        start_result result;
+
+        while (nullptr != p_waiting_head_)
+        {
+            p_operation = p_waiting_head_;
+            result = try_start(p_operation);
+            if (start_result::no_instance == result)
+            {
+                break;
+            }
+            p_waiting_head_ = p_operation->p_next_;
+            if (start_result::failed == result)
+            {
+                // The coroutine is resumed with the status of the failed start
+                p_operation->handle_.resume();
+            }
+        }
+    }
+
+    optiga_crypt_cq_t cq_;
+    optiga_crypt_cq_slot_t slots_[depth];
+    optiga_lib_status_t init_status_;
+    /// Operations waiting for a crypt instance, in order of submission
+    crypt_operation_base * p_waiting_head_ = nullptr;
+    crypt_operation_base * p_waiting_tail_ = nullptr;
+};
+
+/**
+ * \brief Operation of the crypt executor, awaitable from a coroutine.
+ *
+ * \details
+ * - The operation is started when awaited. The result of co_await is the status of the operation.
+ * - The awaiter lives in the coroutine frame, no memory is allocated per operation.
+ */
+template <uint8_t depth, typename start_t>
+class crypt_operation : public crypt_operation_base
+{
+public:
+    crypt_operation(crypt_executor<depth> & executor, start_t start)
+        : executor_(executor), start_fn_(start)
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return (false);
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        handle_ = handle;
+        return (executor_.enqueue(this));
+    }
+
+    optiga_lib_status_t await_resume() const noexcept
+    {
+        return (status_);
+    }
+
+protected:
+    optiga_lib_status_t start(optiga_crypt_t * p_crypt) override
+    {
+        return (start_fn_(p_crypt));
+    }
+
+private:
+    crypt_executor<depth> & executor_;
+    start_t start_fn_;
+};
+
+template <uint8_t depth>
+template <typename start_t>
+auto crypt_executor<depth>::submit(start_t start)
+{
+    return (crypt_operation<depth, start_t>(*this, start));
+}
+#endif //OPTIGA_CRYPT_CQ_ENABLED
+
+} // namespace optiga
+
+#endif //(__cplusplus) && (__cplusplus >= 202002L)
+
+#endif /*_OPTIGA_HPP_*/
+
+/**
+* @}
+*/
@@ -43,43 +43,211 @@ extern "C" {
 #endif
 
 #include "optiga/cmd/optiga_cmd.h"
+#ifdef OPTIGA_LIB_SYNC_API_ENABLED
+#include "optiga/pal/pal_os_wait.h"
+#endif //OPTIGA_LIB_SYNC_API_ENABLED
 
-/** \brief union for OPTIGA crypt parameters */
+#ifdef OPTIGA_CRYPT_ECDSA_VERIFY_OFFLOAD_ENABLED
+/// Error reported for a failed signature verification on host, which is same as the device error from OPTIGA
+#define OPTIGA_CRYPT_SIGNATURE_VERIFICATION_FAILURE (OPTIGA_DEVICE_ERROR | 0x002C)
+#endif //OPTIGA_CRYPT_ECDSA_VERIFY_OFFLOAD_ENABLED
+
+#ifdef OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+/// Size of the buffer to coalesce the data of small updates, which fits the payload of a single command
+#define OPTIGA_CRYPT_COALESCING_BUFFER_SIZE         (OPTIGA_MAX_COMMS_BUFFER_SIZE - 0x0A)
+#endif //OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+
+/**
+ * \brief union for OPTIGA crypt parameters
+ *
+ * \details
+ * Only the parameters of the enabled operations are members, hence the union (and each instance) is sized for the
+ * largest enabled operation.
+ */
 typedef union optiga_crypt_params
 {
+#if defined (OPTIGA_CRYPT_RANDOM_ENABLED) || defined (OPTIGA_CRYPT_RSA_PRE_MASTER_SECRET_ENABLED) ||\
+    defined (OPTIGA_CRYPT_GENERATE_AUTH_CODE_ENABLED)
     /// get random params
     optiga_get_random_params_t optiga_get_random_params;
+#endif
+#if defined (OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED) || defined (OPTIGA_CRYPT_RSA_GENERATE_KEYPAIR_ENABLED)
     /// get key pair params
     optiga_gen_keypair_params_t optiga_gen_keypair_params;
+#endif
+#if defined (OPTIGA_CRYPT_ECDSA_SIGN_ENABLED) || defined (OPTIGA_CRYPT_RSA_SIGN_ENABLED)
     /// calc sign params
     optiga_calc_sign_params_t optiga_calc_sign_params;
+#endif
+#if defined (OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED) || defined (OPTIGA_CRYPT_RSA_VERIFY_ENABLED)
     /// verify sign params
     optiga_verify_sign_params_t optiga_verify_sign_params;
-#if defined (OPTIGA_CRYPT_RSA_ENCRYPT_ENABLED) || defined (OPTIGA_CRYPT_RSA_DECRYPT_ENABLED)    
+#endif
+#if defined (OPTIGA_CRYPT_RSA_ENCRYPT_ENABLED) || defined (OPTIGA_CRYPT_RSA_DECRYPT_ENABLED)
     /// asymmetric encryption params
     optiga_encrypt_asym_params_t optiga_encrypt_asym_params;
-#endif    
+#endif
+#ifdef OPTIGA_CRYPT_HASH_ENABLED
     /// calc hash params
     optiga_calc_hash_params_t optiga_calc_hash_params;
+#endif
+#ifdef OPTIGA_CRYPT_ECDH_ENABLED
     /// calc ssec params
     optiga_calc_ssec_params_t optiga_calc_ssec_params;
+#endif
+#if defined (OPTIGA_CRYPT_TLS_PRF_SHA256_ENABLED) || defined (OPTIGA_CRYPT_TLS_PRF_SHA384_ENABLED) ||\
+    defined (OPTIGA_CRYPT_TLS_PRF_SHA512_ENABLED) || defined (OPTIGA_CRYPT_HKDF_ENABLED)
     /// derive key params
     optiga_derive_key_params_t optiga_derive_key_params;
-#if defined (OPTIGA_CRYPT_SYM_ENCRYPT_ENABLED) && defined (OPTIGA_CRYPT_SYM_DECRYPT_ENABLED)
-    /// derive key params
+#endif
+#if defined (OPTIGA_CRYPT_SYM_ENCRYPT_ENABLED) || defined (OPTIGA_CRYPT_SYM_DECRYPT_ENABLED) ||\
+    defined (OPTIGA_CRYPT_HMAC_ENABLED) || defined (OPTIGA_CRYPT_HMAC_VERIFY_ENABLED) ||\
+    defined (OPTIGA_CRYPT_CLEAR_AUTO_STATE_ENABLED)
+    /// symmetric encryption, decryption and hmac params
     optiga_encrypt_sym_params_t optiga_symmetric_enc_dec_params;
-#endif    
-#ifdef OPTIGA_CRYPT_SYM_GENERATE_KEY_ENABLED    
+#endif
+#ifdef OPTIGA_CRYPT_SYM_GENERATE_KEY_ENABLED
     /// generate symmetric key params
-    optiga_gen_symkey_params_t optiga_gen_sym_key_params;   
-#endif    
+    optiga_gen_symkey_params_t optiga_gen_sym_key_params;
+#endif
 }optiga_crypt_params_t;
 
+#ifdef OPTIGA_CRYPT_OPERATION_QUEUE_ENABLED
+/** \brief Operation handle, which holds the parameters of one operation queued on a crypt instance */
+typedef struct optiga_crypt_operation
+{
+    /// Details/references (pointers) to the Application Inputs of the operation
+    optiga_crypt_params_t params;
+    /// Arguments of the operation, taken once the operation is started
+    union
+    {
+        /// Arguments of #optiga_crypt_random
+        struct
+        {
+            optiga_rng_type_t rng_type;
+            uint8_t * random_data;
+            uint16_t random_data_length;
+        }random;
+        /// Arguments of #optiga_crypt_hash
+        struct
+        {
+            optiga_hash_type_t hash_algorithm;
+            uint8_t source_of_data_to_hash;
+            const void * data_to_hash;
+            uint8_t * hash_output;
+        }hash;
+        /// Arguments of #optiga_crypt_ecdsa_sign
+        struct
+        {
+            const uint8_t * digest;
+            uint8_t digest_length;
+            optiga_key_id_t private_key;
+            uint8_t * signature;
+            uint16_t * signature_length;
+        }ecdsa_sign;
+        /// Arguments of #optiga_crypt_ecdsa_verify
+        struct
+        {
+            const uint8_t * digest;
+            uint8_t digest_length;
+            const uint8_t * signature;
+            uint16_t signature_length;
+            uint8_t public_key_source_type;
+            const void * public_key;
+        }ecdsa_verify;
+        /// Arguments of #optiga_crypt_ecdh
+        struct
+        {
+            optiga_key_id_t private_key;
+            public_key_from_host_t * public_key;
+            bool_t export_to_host;
+            uint8_t * shared_secret;
+        }ecdh;
+    }args;
+    /// Callback handler of the operation
+    callback_handler_t handler;
+    /// Caller context of the operation
+    void * caller_context;
+    /// Next queued operation
+    struct optiga_crypt_operation * p_next;
+    /// Type of the operation
+    uint8_t type;
+}optiga_crypt_operation_t;
+#endif //OPTIGA_CRYPT_OPERATION_QUEUE_ENABLED
+
+#ifdef OPTIGA_CRYPT_TLS_HANDSHAKE_ENABLED
+/// Length of the client random and the server random of TLS 1.2
+#define OPTIGA_CRYPT_TLS_RANDOM_LENGTH              (32)
+/// Length of the master secret of TLS 1.2
+#define OPTIGA_CRYPT_TLS_MASTER_SECRET_LENGTH       (48)
+/// Number of commands chained by #optiga_crypt_tls_handshake_key_block
+#define OPTIGA_CRYPT_TLS_HANDSHAKE_STEPS            (4)
+#endif //OPTIGA_CRYPT_TLS_HANDSHAKE_ENABLED
+
+#ifdef OPTIGA_CRYPT_TLS13_KEY_SCHEDULE_ENABLED
+/// Number of commands chained by #optiga_crypt_tls13_handshake_secrets
+#define OPTIGA_CRYPT_TLS13_KEY_SCHEDULE_STEPS       (4)
+/// Maximum length of HkdfLabel (length, "tls13 " label of upto 12 bytes and a context of upto 64 bytes)
+#define OPTIGA_CRYPT_TLS13_HKDF_LABEL_MAX_LENGTH    (2 + 1 + 18 + 1 + 64)
+#endif //OPTIGA_CRYPT_TLS13_KEY_SCHEDULE_ENABLED
+
+#if defined (OPTIGA_CRYPT_HMAC_AUTHORIZE_ENABLED) && defined (OPTIGA_CRYPT_SYM_DECRYPT_ENABLED)
+/// Number of items chained by #optiga_crypt_hmac_authorize ahead of the protected items (auth code, HMAC, HMAC verify)
+#define OPTIGA_CRYPT_HMAC_AUTHORIZE_STEPS               (3)
+/// Maximum length of the auth code (optional data and random), which is the input of HMAC
+#define OPTIGA_CRYPT_HMAC_AUTHORIZE_MAX_INPUT_LENGTH    (0x42)
+/// Maximum length of HMAC (HMAC SHA512)
+#define OPTIGA_CRYPT_HMAC_AUTHORIZE_MAX_HMAC_LENGTH     (0x40)
+
+/**
+ * \brief Callback to calculate the HMAC of the auth code on host, with the secret shared with OPTIGA.
+ *
+ * \details
+ * Returns #OPTIGA_LIB_SUCCESS, if the HMAC is calculated.
+ * - The callback is invoked from the context of the command scheduler while the OPTIGA lock is held,
+ *   hence it must not invoke any OPTIGA API.
+ * - hmac_length is the size of the hmac buffer on input and must be updated with the length of the HMAC.
+ */
+typedef optiga_lib_status_t (*optiga_crypt_hmac_callback_t)(void * p_context,
+                                                            const uint8_t * input_data,
+                                                            uint16_t input_data_length,
+                                                            uint8_t * hmac,
+                                                            uint16_t * hmac_length);
+#endif //(OPTIGA_CRYPT_HMAC_AUTHORIZE_ENABLED) && (OPTIGA_CRYPT_SYM_DECRYPT_ENABLED)
+
+#ifdef OPTIGA_CRYPT_VERIFY_BATCH_ENABLED
+/// Signature scheme of a verify batch item, for the ECDSA signature over the digest
+#define OPTIGA_CRYPT_VERIFY_BATCH_ECDSA             (0x00)
+
+/** \brief Signature verified by #optiga_crypt_verify_batch */
+typedef struct optiga_crypt_verify_item
+{
+    /// #OPTIGA_CRYPT_VERIFY_BATCH_ECDSA or the RSA signature scheme (#optiga_rsa_signature_scheme_t)
+    uint8_t signature_scheme;
+    /// Length of the digest
+    uint8_t digest_length;
+    /// Source of the public key, #OPTIGA_CRYPT_OID_DATA or #OPTIGA_CRYPT_HOST_DATA
+    uint8_t public_key_source_type;
+    /// Length of the signature
+    uint16_t signature_length;
+    /// Digest over which the signature is verified
+    const uint8_t * digest;
+    /// Signature to be verified
+    const uint8_t * signature;
+    /// Certificate OID (uint16_t) or public key from host (#public_key_from_host_t)
+    const void * public_key;
+    /// Result of the verification, updated on completion of the batch
+    optiga_lib_status_t status;
+}optiga_crypt_verify_item_t;
+#endif //OPTIGA_CRYPT_VERIFY_BATCH_ENABLED
+
 /** \brief OPTIGA crypt instance structure */
 struct optiga_crypt
 {
     /// Details/references (pointers) to the Application Inputs
     optiga_crypt_params_t params;
+    /// Parameters of the ongoing operation, the params of the instance or of the operation handle
+    optiga_crypt_params_t * p_params;
     /// Command module instance
     optiga_cmd_t * my_cmd;
     /// Caller context
@@ -94,7 +262,180 @@ struct optiga_crypt
     /// To provide the presentation layer protocol version to be used
     uint8_t protocol_version;
 #endif //OPTIGA_COMMS_SHIELDED_CONNECTION
-
+#ifdef OPTIGA_LIB_SYNC_API_ENABLED
+    /// Wait object on which the caller of synchronous API is blocked
+    pal_os_wait_t sync_wait;
+    /// Status of the operation invoked using synchronous API
+    optiga_lib_status_t sync_status;
+    /// Indicates the ongoing operation is invoked using synchronous API
+    uint8_t sync_ongoing;
+#endif //OPTIGA_LIB_SYNC_API_ENABLED
+#ifdef OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+    /// Buffer to coalesce the data of small updates
+    uint8_t coalescing_buffer[OPTIGA_CRYPT_COALESCING_BUFFER_SIZE];
+    /// Length of the data coalesced in the buffer
+    uint16_t coalesced_length;
+    /// Indicates if the updates are coalesced
+    uint8_t coalescing_enabled;
+    /// Sequence (hash or hmac), to which the coalesced data belongs
+    uint8_t coalesced_sequence;
+    /// Step to be taken, once the ongoing command is completed
+    uint8_t coalescing_next_step;
+    /// Hash context, to which the coalesced data belongs
+    optiga_hash_context_t * p_coalesced_hash_ctx;
+    /// Data from host, which is sent for the hash update
+    hash_data_from_host_t coalesced_hash_data;
+    /// Data of the caller, which is taken once the ongoing command is completed
+    const uint8_t * p_remaining_data;
+    /// Length of the data of the caller, which is taken once the ongoing command is completed
+    uint32_t remaining_length;
+    /// Output buffer of the finalize, which is invoked once the ongoing command is completed
+    uint8_t * p_final_output;
+    /// Output length of the finalize, which is invoked once the ongoing command is completed
+    uint32_t * p_final_output_length;
+    /// Secret of the hmac sequence, whose start is sent along with the coalesced data
+    uint16_t coalesced_hmac_secret;
+    /// Type of the hmac sequence, whose start is sent along with the coalesced data
+    uint8_t coalesced_hmac_type;
+    /// Indicates the start of the hmac sequence is not yet sent to OPTIGA
+    uint8_t coalesced_hmac_start_pending;
+#endif //OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+#ifdef OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED
+    /// Indicates if the hashing of data from host is offloaded to host
+    uint8_t hash_offload_enabled;
+#endif //OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED
+#ifdef OPTIGA_CRYPT_ECDSA_VERIFY_OFFLOAD_ENABLED
+    /// Indicates if the verification with public key from host is offloaded to host
+    uint8_t verify_offload_enabled;
+#endif //OPTIGA_CRYPT_ECDSA_VERIFY_OFFLOAD_ENABLED
+#ifdef OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+    /// Time in milliseconds, for which a successful verification is cached (0 if the cache is not used)
+    uint32_t verify_cache_ttl_ms;
+    /// Generation of the verification cache, at which the ongoing verification is looked up
+    uint32_t verify_cache_generation;
+    /// Key of the ongoing verification in the verification cache
+    uint8_t verify_cache_key[OPTIGA_CMD_VERIFY_CACHE_KEY_LENGTH];
+    /// Certificate object holding the public key of the ongoing verification, 0x0000 if the public key is from host
+    uint16_t verify_cache_oid;
+    /// Indicates the ongoing verification is added to the verification cache on success
+    uint8_t verify_cache_pending;
+#endif //OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+#ifdef OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
+    /// Time in microseconds, at which the ongoing operation decided by the offload policy is invoked
+    uint32_t offload_start_time;
+    /// Security class of the operations of the instance, as defined in #optiga_lib_security_class_t
+    uint8_t security_class;
+    /// Ongoing operation decided by the offload policy, as defined in #optiga_lib_offload_operation_t
+    uint8_t offload_operation;
+    /// Indicates the ongoing operation is executed on host
+    uint8_t offload_on_host;
+    /// Indicates the time of the ongoing operation is recorded in the cost model on completion
+    uint8_t offload_pending;
+#endif //OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
+#ifdef OPTIGA_CRYPT_OPERATION_QUEUE_ENABLED
+    /// Operation handle of the ongoing operation, NULL if the operation is invoked by the service layer API
+    optiga_crypt_operation_t * p_current_operation;
+    /// First queued operation handle
+    optiga_crypt_operation_t * p_queue_head;
+    /// Last queued operation handle
+    optiga_crypt_operation_t * p_queue_tail;
+    /// Number of queued operation handles
+    uint8_t queued_operations;
+#endif //OPTIGA_CRYPT_OPERATION_QUEUE_ENABLED
+#ifdef OPTIGA_CRYPT_ECDSA_SIGN_BATCH_ENABLED
+    /// Command batch items of the ongoing chunk of the signing batch
+    optiga_cmd_batch_item_t sign_batch_items[OPTIGA_CRYPT_ECDSA_SIGN_BATCH_CHUNK_SIZE];
+    /// Parameters of the commands of the ongoing chunk of the signing batch
+    optiga_calc_sign_params_t sign_batch_params[OPTIGA_CRYPT_ECDSA_SIGN_BATCH_CHUNK_SIZE];
+    /// Digests of the signing batch
+    const uint8_t * p_sign_batch_digests;
+    /// Signatures of the signing batch
+    uint8_t * p_sign_batch_signatures;
+    /// Signature lengths of the signing batch
+    uint16_t * p_sign_batch_signature_lengths;
+    /// Number of digests of the signing batch, zero if no signing batch is ongoing
+    uint16_t sign_batch_count;
+    /// Index of the first digest of the ongoing chunk
+    uint16_t sign_batch_index;
+    /// Size of the buffer of each signature
+    uint16_t sign_batch_signature_size;
+    /// Private key of the signing batch
+    optiga_key_id_t sign_batch_private_key;
+    /// Status of the first failed signature of the signing batch
+    optiga_lib_status_t sign_batch_status;
+    /// Length of each digest
+    uint8_t sign_batch_digest_length;
+    /// Number of digests of the ongoing chunk
+    uint8_t sign_batch_chunk_count;
+#endif //OPTIGA_CRYPT_ECDSA_SIGN_BATCH_ENABLED
+#ifdef OPTIGA_CRYPT_VERIFY_BATCH_ENABLED
+    /// Command batch items of the ongoing chunk of the verify batch
+    optiga_cmd_batch_item_t verify_batch_items[OPTIGA_CRYPT_VERIFY_BATCH_CHUNK_SIZE];
+    /// Parameters of the commands of the ongoing chunk of the verify batch
+    optiga_verify_sign_params_t verify_batch_params[OPTIGA_CRYPT_VERIFY_BATCH_CHUNK_SIZE];
+    /// Index of the verify item of each command of the ongoing chunk
+    uint16_t verify_batch_map[OPTIGA_CRYPT_VERIFY_BATCH_CHUNK_SIZE];
+    /// Items of the verify batch
+    optiga_crypt_verify_item_t * p_verify_batch_items;
+    /// Number of items of the verify batch, zero if no verify batch is ongoing
+    uint16_t verify_batch_count;
+    /// Index of the item, from which the next chunk is collected
+    uint16_t verify_batch_index;
+    /// Number of commands of the ongoing chunk
+    uint8_t verify_batch_chunk_count;
+#endif //OPTIGA_CRYPT_VERIFY_BATCH_ENABLED
+#ifdef OPTIGA_CRYPT_TLS_HANDSHAKE_ENABLED
+    /// Command chain items of the handshake (key pair, shared secret, master secret, key block)
+    optiga_cmd_batch_item_t handshake_items[OPTIGA_CRYPT_TLS_HANDSHAKE_STEPS];
+    /// Parameters of the key pair generation of the handshake
+    optiga_gen_keypair_params_t handshake_keypair_params;
+    /// Parameters of the shared secret calculation of the handshake
+    optiga_calc_ssec_params_t handshake_ssec_params;
+    /// Parameters of the master secret and key block derivation of the handshake
+    optiga_derive_key_params_t handshake_prf_params[2];
+    /// Seeds of the master secret (client random | server random) and key block (server random | client random)
+    uint8_t handshake_seeds[2][2 * OPTIGA_CRYPT_TLS_RANDOM_LENGTH];
+#endif //OPTIGA_CRYPT_TLS_HANDSHAKE_ENABLED
+#ifdef OPTIGA_CRYPT_TLS13_KEY_SCHEDULE_ENABLED
+    /// Command chain items of the key schedule (shared secret and the derived secrets)
+    optiga_cmd_batch_item_t key_schedule_items[OPTIGA_CRYPT_TLS13_KEY_SCHEDULE_STEPS];
+    /// Parameters of the shared secret calculation of the key schedule
+    optiga_calc_ssec_params_t key_schedule_ssec_params;
+    /// Parameters of the derivations of the key schedule
+    optiga_derive_key_params_t key_schedule_hkdf_params[OPTIGA_CRYPT_TLS13_KEY_SCHEDULE_STEPS - 1];
+    /// HkdfLabel of the derivations of the key schedule
+    uint8_t key_schedule_labels[OPTIGA_CRYPT_TLS13_KEY_SCHEDULE_STEPS - 1][OPTIGA_CRYPT_TLS13_HKDF_LABEL_MAX_LENGTH];
+#endif //OPTIGA_CRYPT_TLS13_KEY_SCHEDULE_ENABLED
+#if defined (OPTIGA_CRYPT_HMAC_AUTHORIZE_ENABLED) && defined (OPTIGA_CRYPT_SYM_DECRYPT_ENABLED)
+    /// Command chain items of the authorization (auth code, HMAC, HMAC verify, protected items, clear AUTO state)
+    optiga_cmd_batch_item_t authorize_items[OPTIGA_CMD_BATCH_MAX_ITEMS];
+    /// Parameters of the auth code generation
+    optiga_get_random_params_t authorize_random_params;
+    /// Parameters of the HMAC calculation on host
+    optiga_cmd_batch_host_params_t authorize_host_params;
+    /// Parameters of the HMAC verification and of the clear AUTO state
+    optiga_decrypt_sym_params_t authorize_sym_params[2];
+    /// Auth code (optional data | random), which is the input of HMAC
+    uint8_t authorize_input[OPTIGA_CRYPT_HMAC_AUTHORIZE_MAX_INPUT_LENGTH];
+    /// HMAC calculated on host
+    uint8_t authorize_hmac[OPTIGA_CRYPT_HMAC_AUTHORIZE_MAX_HMAC_LENGTH];
+    /// HMAC callback of the authorization
+    optiga_crypt_hmac_callback_t authorize_hmac_callback;
+    /// Context of the HMAC callback
+    void * authorize_hmac_context;
+    /// Protected items of the caller, NULL if no authorization is ongoing
+    optiga_cmd_batch_item_t * p_authorize_protected_items;
+    /// Status of the failed chain, reported once the AUTO state is cleared
+    optiga_lib_status_t authorize_status;
+    /// Length of the auth code
+    uint16_t authorize_input_length;
+    /// Number of protected items of the caller
+    uint8_t authorize_protected_item_count;
+    /// Indicates the AUTO state is cleared at the end of the authorization
+    uint8_t authorize_clear_auto_state;
+    /// Indicates the AUTO state is being cleared after a failed chain
+    uint8_t authorize_clear_ongoing;
+#endif //(OPTIGA_CRYPT_HMAC_AUTHORIZE_ENABLED) && (OPTIGA_CRYPT_SYM_DECRYPT_ENABLED)
 };
 
 /** \brief OPTIGA crypt instance structure type*/
@@ -150,7 +491,8 @@ void optiga_crypt_set_comms_params(optiga_crypt_t * me,
  *      - Default protocol version for this API is #OPTIGA_COMMS_PROTOCOL_VERSION_PRE_SHARED_SECRET.
  *
  * \param[in]   optiga_instance_id  Indicates the OPTIGA instance to be associated with #optiga_crypt_t. Should be defined as below:
- *                                  Use #OPTIGA_INSTANCE_ID_0.
+ *                                  Use #OPTIGA_INSTANCE_ID_0, #OPTIGA_INSTANCE_ID_1 (if configured)
+ *                                  or #OPTIGA_INSTANCE_ID_ANY for the least loaded OPTIGA.
  * \param[in]   handler             Pointer to callback function, must not be NULL.
  * \param[in]   caller_context      Pointer to upper layer context. Contains user context data.
  *
@@ -186,6 +528,243 @@ LIBRARY_EXPORTS optiga_crypt_t * optiga_crypt_create(uint8_t optiga_instance_id,
  */
 LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_destroy(optiga_crypt_t * me);
 
+/**
+ * \brief Sets the priority class of the #optiga_crypt_t instance in command execution queue.
+ *
+ * \details
+ * Sets the priority class of the #optiga_crypt_t instance in command execution queue.
+ * - Requests of higher priority class are served first, requests of same class in order of arrival.<br>
+ * - A waiting request is promoted by one class for every <b>OPTIGA_CMD_PRIORITY_AGING_TIME_US</b>, to avoid starvation.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ * - Default priority of an instance is #OPTIGA_LIB_PRIORITY_NORMAL.
+ * - The priority is applied from the next API invocation and remains until changed.
+ *
+ * \param[in] me                                      Valid instance of #optiga_crypt_t.
+ * \param[in] priority                                Priority class as defined in #optiga_lib_priority_t.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful invocation.
+ * \retval    #OPTIGA_CRYPT_ERROR_INVALID_INPUT       Wrong Input arguments provided.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_set_priority(optiga_crypt_t * me,
+                                                              optiga_lib_priority_t priority);
+
+#ifdef OPTIGA_CMD_DEADLINE_ENABLED
+/**
+ * \brief Sets the deadline of the operations of the #optiga_crypt_t instance in command execution queue.
+ *
+ * \details
+ * Sets the deadline of the operations of the #optiga_crypt_t instance in command execution queue.
+ * - An operation, which is still waiting in the queue deadline_us after its invocation, is dropped without being
+ *   sent to OPTIGA.<br>
+ * - The callback of the dropped operation is invoked with #OPTIGA_CMD_ERROR_DEADLINE_EXPIRED.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ * - Default is no deadline (0), the operations wait till they are served.
+ * - The deadline is applied from the next API invocation and remains until changed.
+ * - An operation, which is sent to OPTIGA already, completes regardless of the deadline.
+ *
+ * \param[in] me                                      Valid instance of #optiga_crypt_t.
+ * \param[in] deadline_us                             Deadline in microseconds after the invocation, 0 for no deadline.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful invocation.
+ * \retval    #OPTIGA_CRYPT_ERROR_INVALID_INPUT       Wrong Input arguments provided.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_set_deadline(optiga_crypt_t * me,
+                                                              uint32_t deadline_us);
+#endif //OPTIGA_CMD_DEADLINE_ENABLED
+
+#ifdef OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+/**
+ * \brief Marks the operations of the #optiga_crypt_t instance as deferrable, while the application is hibernated.
+ *
+ * \details
+ * Sets the maximum delay, for which the operations of the #optiga_crypt_t instance wait for a restore of the
+ * hibernated application. Refer #optiga_util_set_deferrable.
+ * - A deferrable operation (e.g. a telemetry signature) does not wake OPTIGA. It is served once an operation, which is
+ *   not deferrable, restores the application, or once its maximum delay elapses.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ * - Default is 0, the operations are not deferrable.
+ * - The maximum delay is applied from the next API invocation and remains until changed.
+ *
+ * \param[in] me                                      Valid instance of #optiga_crypt_t.
+ * \param[in] max_delay_ms                            Maximum delay in milliseconds, 0 if not deferrable.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful invocation.
+ * \retval    #OPTIGA_CRYPT_ERROR_INVALID_INPUT       Wrong Input arguments provided.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_set_deferrable(optiga_crypt_t * me,
+                                                                uint32_t max_delay_ms);
+#endif //OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+
+#ifdef OPTIGA_CMD_CANCEL_ENABLED
+/**
+ * \brief Cancels the ongoing operation of the #optiga_crypt_t instance.
+ *
+ * \details
+ * Cancels the ongoing operation of the #optiga_crypt_t instance.
+ * - An operation, which is waiting in the command execution queue, is dropped without being sent to OPTIGA.<br>
+ * - The result of an operation, which is sent to OPTIGA already, is discarded once OPTIGA responds.<br>
+ * - The callback of the cancelled operation is invoked with #OPTIGA_CMD_ERROR_CANCELLED.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode, the operation is completed later through the callback.
+ * - The instance can be destroyed using #optiga_crypt_destroy once the callback is invoked.
+ * - The output buffers of an operation, which is sent to OPTIGA already, may still be updated.
+ * - The API has no effect, if no operation is ongoing.
+ *
+ * \param[in] me                                      Valid instance of #optiga_crypt_t.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful invocation.
+ * \retval    #OPTIGA_CRYPT_ERROR_INVALID_INPUT       Wrong Input arguments provided.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_cancel(optiga_crypt_t * me);
+#endif //OPTIGA_CMD_CANCEL_ENABLED
+
+#ifdef OPTIGA_CMD_FAIR_SHARE_ENABLED
+/**
+ * \brief Sets the tenant of the #optiga_crypt_t instance, among which OPTIGA is shared.
+ *
+ * \details
+ * Sets the tenant, to which the operations of the #optiga_crypt_t instance are accounted.
+ * - Within a priority class, the requests of the tenant are served first, which has consumed the least OPTIGA time
+ *   relative to its weight. Refer #optiga_util_set_tenant_weight.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ * - Default tenant of an instance is 0.
+ * - The tenant is applied from the next API invocation and remains until changed.
+ *
+ * \param[in] me                                      Valid instance of #optiga_crypt_t.
+ * \param[in] tenant                                  Tenant, less than OPTIGA_CMD_FAIR_SHARE_MAX_TENANTS.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful invocation.
+ * \retval    #OPTIGA_CRYPT_ERROR_INVALID_INPUT       Wrong Input arguments provided.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_set_tenant(optiga_crypt_t * me,
+                                                            uint8_t tenant);
+#endif //OPTIGA_CMD_FAIR_SHARE_ENABLED
+
+#ifdef OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+/**
+ * \brief Checks, whether an operation of the #optiga_crypt_t instance is served within the maximum waiting time.
+ *
+ * \details
+ * Estimates the waiting time in the command execution queue of an operation, which is invoked now.
+ * - The estimate is based on the requests in the queue and the measured average service time of a request.
+ *   Refer #optiga_util_try_admit.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ * - No operation is queued, the caller invokes the operation if admitted or sheds the load otherwise.
+ *
+ * \param[in]  me                                     Valid instance of #optiga_crypt_t.
+ * \param[in]  max_wait_us                            Maximum waiting time of the operation in microseconds.
+ * \param[out] p_estimated_wait_us                    Pointer to store the estimated waiting time, can be NULL.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Estimated waiting time is within the maximum waiting time.
+ * \retval    #OPTIGA_CRYPT_ERROR_QUEUE_FULL          Estimated waiting time exceeds the maximum waiting time.
+ * \retval    #OPTIGA_CRYPT_ERROR_INVALID_INPUT       Wrong Input arguments provided.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_try_admit(const optiga_crypt_t * me,
+                                                           uint32_t max_wait_us,
+                                                           uint32_t * p_estimated_wait_us);
+#endif //OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+
+#ifdef OPTIGA_CMD_SESSION_POOL_ENABLED
+/**
+ * \brief Sets the session acquisition policy and the lease time of the #optiga_crypt_t instance.
+ *
+ * \details
+ * Sets the session acquisition policy and the lease time of the #optiga_crypt_t instance.
+ * - With #OPTIGA_LIB_SESSION_FAIL_FAST, an API which needs a session (e.g. key generation into a session OID)
+ *   fails with #OPTIGA_CMD_ERROR_SESSION_UNAVAILABLE instead of waiting, if all the sessions are in use.<br>
+ * - Once the lease time is elapsed, the session is freed when the instance is idle, to serve the waiting requests.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ * - Default is #OPTIGA_LIB_SESSION_WAIT with no lease time (0), the session is kept till released.
+ * - The key in a session is lost with the expiry of the lease, use a lease time longer than the usage of the key.
+ *
+ * \param[in] me                                      Valid instance of #optiga_crypt_t.
+ * \param[in] policy                                  Acquisition policy as defined in #optiga_lib_session_policy_t.
+ * \param[in] lease_time_us                           Lease time of the session in microseconds, 0 for no lease time.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful invocation.
+ * \retval    #OPTIGA_CRYPT_ERROR_INVALID_INPUT       Wrong Input arguments provided.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_set_session_policy(optiga_crypt_t * me,
+                                                                    optiga_lib_session_policy_t policy,
+                                                                    uint32_t lease_time_us);
+
+/**
+ * \brief Retrieves the usage of the session contexts of OPTIGA.
+ *
+ * \details
+ * Retrieves the number of sessions in use, requests waiting for a session, requests rejected and leases expired.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in]  me                                     Valid instance of #optiga_crypt_t.
+ * \param[out] p_stats                                Pointer to the statistics.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful invocation.
+ * \retval    #OPTIGA_CRYPT_ERROR_INVALID_INPUT       Wrong Input arguments provided.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_get_session_pool_stats(const optiga_crypt_t * me,
+                                                                        optiga_lib_session_pool_stats_t * p_stats);
+
+/**
+ * \brief Releases the session assigned to the #optiga_crypt_t instance.
+ *
+ * \details
+ * Releases the session assigned to the #optiga_crypt_t instance, e.g. once the ephemeral key is no more required.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ * - The key stored in the session is lost.
+ *
+ * \param[in] me                                      Valid instance of #optiga_crypt_t.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful invocation.
+ * \retval    #OPTIGA_CRYPT_ERROR_INVALID_INPUT       Wrong Input arguments provided.
+ * \retval    #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE     The previous operation with the same instance is not complete.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_release_session(optiga_crypt_t * me);
+#endif //OPTIGA_CMD_SESSION_POOL_ENABLED
+
 #ifdef OPTIGA_CRYPT_RANDOM_ENABLED
 /**
  * \brief Generates a random number.
@@ -286,6 +865,9 @@ LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_hash(optiga_crypt_t * me,
  * - For <b>protected I2C communication</b>, Refer #OPTIGA_CRYPT_SET_COMMS_PROTECTION_LEVEL.
  * - Error codes from lower layer will be returned as it is.<br>
  * - User must save the output hash context for further usage because OPTIGA does not store it internally.<br>
+ * - If <b>context_buffer</b> in <b>hash_ctx</b> is NULL, the hash context is kept in OPTIGA and not exported.
+ *   The instance acquires the strict lock, which is retained until #optiga_crypt_hash_finalize.
+ *   Hence no other instance is served by OPTIGA, until the sequence is finalized.<br>
  *
  *<br>
  * \param[in]      me                                        Valid instance of #optiga_crypt_t created using #optiga_crypt_create.
@@ -325,6 +907,8 @@ LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_hash_start(optiga_crypt_t * me,
  * - For <b>protected I2C communication</b>, Refer #OPTIGA_CRYPT_SET_COMMS_PROTECTION_LEVEL
  * - Error codes from lower layer will be returned as it is.<br>
  * - User must save the output hash context for further usage as OPTIGA does not store it internally.
+ * - If the hash context is kept in OPTIGA (Refer #optiga_crypt_hash_start), only the payload is sent and no context is exported.
+ * - If coalescing is enabled (Refer #optiga_crypt_set_update_coalescing), the data from host is sent along with the data of further updates.
  *
  * \param[in]   me                                      Valid instance of #optiga_crypt_t created using #optiga_crypt_create.
  * \param[in]   hash_ctx                                Pointer to #optiga_hash_context_t containing hash context from OPTIGA, must not be NULL
@@ -369,6 +953,7 @@ LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_hash_update(optiga_crypt_t * me
  * - Error codes from lower layer will be returned as it is.
  * - hash context is not updated by this API. This can be used later to fulfill intermediate hash use-cases.
  * - User must save the output hash context for further usage as OPTIGA does not store it internally.
+ * - If the hash context is kept in OPTIGA (Refer #optiga_crypt_hash_start), the strict lock is released after the hash is finalized.
  *
  * \param[in]      me                                      Valid instance of #optiga_crypt_t created using #optiga_crypt_create.
  * \param[in]      hash_ctx                                Pointer to #optiga_hash_context_t containing hash context from OPTIGA, must not be NULL.
@@ -389,6 +974,39 @@ LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_hash_finalize(optiga_crypt_t *
                                                                optiga_hash_context_t * hash_ctx,
                                                                uint8_t * hash_output);
 
+#ifdef OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED
+/**
+ * \brief Enables or disables the hashing of data from host using the crypto library on host.
+ *
+ * \details
+ * Enables or disables the offloading of hash calculation to host in the instance.<br>
+ * - With offloading, #optiga_crypt_hash_start, #optiga_crypt_hash_update and #optiga_crypt_hash_finalize
+ *   are calculated using the pal crypt library (mbedTLS, OpenSSL or wolfSSL) instead of OPTIGA.
+ * - #optiga_crypt_hash with #OPTIGA_CRYPT_HOST_DATA is calculated on host, with #OPTIGA_CRYPT_OID_DATA by OPTIGA.
+ * - Offloading is meant for data which needs no secure handling, as public data is hashed much faster on host than over the interface.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - If the operation is calculated on host, the callback registered with instance is invoked before the API returns.
+ * - The state of the sequence is kept in the <b>context_buffer</b> of #optiga_hash_context_t, which must not be NULL.
+ * - #optiga_crypt_hash_update with #OPTIGA_CRYPT_OID_DATA returns #OPTIGA_CRYPT_ERROR_INVALID_INPUT, when offloading is enabled.
+ * - Offloading must not be changed in between the start and finalize of a hash sequence.
+ * - If a policy is set using #optiga_crypt_set_offload_policy, the policy decides for #optiga_crypt_hash instead.
+ * - Only #OPTIGA_HASH_TYPE_SHA_256 is supported.
+ *
+ * \param[in]      me                                    Valid instance of #optiga_crypt_t created using #optiga_crypt_create.
+ * \param[in]      enable                                TRUE to enable, FALSE to disable the offloading.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                 Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT     Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE   The previous operation with the same instance is not complete.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_set_hash_offload(optiga_crypt_t * me,
+                                                                  bool_t enable);
+#endif //OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED
+
 #endif //OPTIGA_CRYPT_HASH_ENABLED
 
 
@@ -489,6 +1107,95 @@ LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_ecdsa_sign(optiga_crypt_t * me,
                                                             optiga_key_id_t private_key,
                                                             uint8_t * signature,
                                                             uint16_t * signature_length);
+
+#ifdef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+/**
+ * \brief Generates a signature for the given digest in the requested format.
+ *
+ * \details
+ * Generates a signature for the given digest using private key stored in OPTIGA, same as #optiga_crypt_ecdsa_sign.
+ * - The DER INTEGERs r and s generated by OPTIGA are converted to the requested format, while the response is processed.<br>
+ * - #OPTIGA_ECDSA_SIGNATURE_FORMAT_RAW returns r || s, each left padded to the size of the curve (e.g. PKCS#11 CKM_ECDSA).<br>
+ * - #OPTIGA_ECDSA_SIGNATURE_FORMAT_DER_SEQUENCE returns the DER SEQUENCE of r and s (e.g. X.509, mbed TLS).<br>
+ * - #OPTIGA_ECDSA_SIGNATURE_FORMAT_DER_INTEGERS returns the signature same as #optiga_crypt_ecdsa_sign.
+ *
+ * \pre
+ * - Same as #optiga_crypt_ecdsa_sign.
+ *
+ * \note
+ * - For #OPTIGA_ECDSA_SIGNATURE_FORMAT_RAW, the initial signature length must be twice the size of the curve
+ *   (e.g. 0x40 for NIST P256 and Brainpool 256R1, 0x60 for NIST P384, 0x84 for NIST P521).
+ * - If the signature can not be converted, the callback is invoked with #OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT
+ *   or #OPTIGA_CMD_ERROR_INVALID_INPUT and the signature length is set to zero.
+ *
+ * \param[in]      me                                       Valid instance of #optiga_crypt_t created using #optiga_crypt_create.
+ * \param[in]      digest                                   Digest on which signature is generated.
+ * \param[in]      digest_length                            Length of the input digest.
+ * \param[in]      private_key                              Private key OID to generate signature.
+ * \param[in]      signature_format                         Format of the signature, refer #optiga_ecdsa_signature_format_t.
+ * \param[in,out]  signature                                Pointer to store generated signature, must not be NULL.
+ * \param[in,out]  signature_length                         Length of signature. Initial value set as length of buffer, later updated as the actual length of generated signature.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      The previous operation with the same instance is not complete.
+ * \retval         #OPTIGA_DEVICE_ERROR                     Command execution failure in OPTIGA and the LSB indicates the error code.
+ *                                                          (Refer Solution Reference Manual)
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_ecdsa_sign_format(optiga_crypt_t * me,
+                                                                   const uint8_t * digest,
+                                                                   uint8_t digest_length,
+                                                                   optiga_key_id_t private_key,
+                                                                   optiga_ecdsa_signature_format_t signature_format,
+                                                                   uint8_t * signature,
+                                                                   uint16_t * signature_length);
+#endif //OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+
+#ifdef OPTIGA_CRYPT_ECDSA_SIGN_BATCH_ENABLED
+/**
+ * \brief Generates the signatures for several digests with the same private key.
+ *
+ * \details
+ * Generates the signatures for several digests with the same private key stored in OPTIGA.
+ * - Signs the digests in chunks of OPTIGA_CRYPT_ECDSA_SIGN_BATCH_CHUNK_SIZE, using #optiga_cmd_execute_batch.<br>
+ * - The sign commands of a chunk are issued back to back under one acquisition of the OPTIGA lock.<br>
+ * - A failure of a signature reported by OPTIGA does not stop the batch, the respective signature length is set to zero.<br>
+ * - The callback registered with instance (#optiga_crypt_create) gets invoked once, when all the digests are signed
+ *   or the batch is aborted due to a failure of the communication.
+ *
+ * \pre
+ * - The application on OPTIGA must be opened using #optiga_util_open_application before using this API.<br>
+ *
+ * \note
+ * - For <b>protected I2C communication</b>, Refer #OPTIGA_CRYPT_SET_COMMS_PROTECTION_LEVEL. The protection level applies to each sign command.
+ * - The digests, signatures and signature lengths must be valid until the callback is invoked.
+ * - The callback is invoked with #OPTIGA_LIB_SUCCESS, if all the signatures are generated. Otherwise it is invoked with the error
+ *   of the first failed signature.
+ * - The lock is released in between the chunks, hence the other instances are served in between.
+ *
+ * \param[in]      me                                       Valid instance of #optiga_crypt_t created using #optiga_crypt_create.
+ * \param[in]      digests                                  Digests on which signatures are generated, stored back to back.
+ * \param[in]      digest_length                            Length of each digest.
+ * \param[in]      digest_count                             Number of digests, must not be zero.
+ * \param[in]      private_key                              Private key OID to generate signatures, other than #OPTIGA_KEY_ID_SESSION_BASED.
+ * \param[in,out]  signatures                               Buffer to store the generated DER encoded signatures, must not be NULL.
+ *                                                          - The signature of the digest at index i is stored at offset i * signature_size.
+ * \param[in]      signature_size                           Size of the buffer of each signature.
+ * \param[out]     signature_lengths                        Lengths of the generated signatures, one per digest, must not be NULL.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      The previous operation with the same instance is not complete.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_ecdsa_sign_batch(optiga_crypt_t * me,
+                                                                  const uint8_t * digests,
+                                                                  uint8_t digest_length,
+                                                                  uint16_t digest_count,
+                                                                  optiga_key_id_t private_key,
+                                                                  uint8_t * signatures,
+                                                                  uint16_t signature_size,
+                                                                  uint16_t * signature_lengths);
+#endif //OPTIGA_CRYPT_ECDSA_SIGN_BATCH_ENABLED
 #endif //OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
 
 #ifdef OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED
@@ -508,6 +1215,8 @@ LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_ecdsa_sign(optiga_crypt_t * me,
  * \note
  * - For <b>protected I2C communication</b>, Refer #OPTIGA_CRYPT_SET_COMMS_PROTECTION_LEVEL.
  * - Error codes from lower layers is returned as it is to the application.<br>
+ * - If offloading is enabled using #optiga_crypt_set_verify_offload, the signature with public key from host is verified on host.
+ * - If caching is enabled using #optiga_crypt_set_verify_cache, a cached successful verification is completed on host.
  *
  * \param[in]   me                                        Valid instance of #optiga_crypt_t created using #optiga_crypt_create.
  * \param[in]   digest                                    Pointer to a given digest buffer, must not be NULL.
@@ -538,8 +1247,218 @@ LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_ecdsa_verify(optiga_crypt_t * m
                                                               uint16_t signature_length,
                                                               uint8_t public_key_source_type,
                                                               const void * public_key);
+
+#ifdef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+/**
+ * \brief Verifies the signature in the given format over the given digest.
+ *
+ * \details
+ * Verifies the signature over a given digest, same as #optiga_crypt_ecdsa_verify.
+ * - The signature is converted to the DER INTEGERs expected by OPTIGA, while the command is prepared.<br>
+ * - #OPTIGA_ECDSA_SIGNATURE_FORMAT_RAW expects r || s of equal length (e.g. PKCS#11 CKM_ECDSA).<br>
+ * - #OPTIGA_ECDSA_SIGNATURE_FORMAT_DER_SEQUENCE expects the DER SEQUENCE of r and s (e.g. X.509, mbed TLS).<br>
+ * - #OPTIGA_ECDSA_SIGNATURE_FORMAT_DER_INTEGERS expects the signature same as #optiga_crypt_ecdsa_verify.
+ *
+ * \pre
+ * - Same as #optiga_crypt_ecdsa_verify.
+ *
+ * \note
+ * - If offloading is enabled using #optiga_crypt_set_verify_offload, the converted signature is verified on host.
+ * - If the signature can not be converted, the callback is invoked with #OPTIGA_CMD_ERROR_INVALID_INPUT.
+ *
+ * \param[in]   me                                        Valid instance of #optiga_crypt_t created using #optiga_crypt_create.
+ * \param[in]   digest                                    Pointer to a given digest buffer, must not be NULL.
+ * \param[in]   digest_length                             Length of digest.
+ * \param[in]   signature_format                          Format of the signature, refer #optiga_ecdsa_signature_format_t.
+ * \param[in]   signature                                 Pointer to a given signature buffer, must not be NULL.
+ * \param[in]   signature_length                          Length of signature.
+ * \param[in]   public_key_source_type                    Refer #optiga_crypt_ecdsa_verify.
+ * \param[in]   public_key                                Refer #optiga_crypt_ecdsa_verify.
+ *
+ * \retval      #OPTIGA_CRYPT_SUCCESS                     Successful invocation
+ * \retval      #OPTIGA_CRYPT_ERROR_INVALID_INPUT         Wrong Input arguments provided
+ * \retval      #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE       The previous operation with the same instance is not complete
+ * \retval      #OPTIGA_DEVICE_ERROR                      Command execution failure in OPTIGA and the LSB indicates the error code.
+ *                                                        (Refer Solution Reference Manual)
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_ecdsa_verify_format(optiga_crypt_t * me,
+                                                                     const uint8_t * digest,
+                                                                     uint8_t digest_length,
+                                                                     optiga_ecdsa_signature_format_t signature_format,
+                                                                     const uint8_t * signature,
+                                                                     uint16_t signature_length,
+                                                                     uint8_t public_key_source_type,
+                                                                     const void * public_key);
+#endif //OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+
+#ifdef OPTIGA_CRYPT_ECDSA_VERIFY_OFFLOAD_ENABLED
+/**
+ * \brief Enables or disables the verification of ECDSA signatures with public key from host using the crypto library on host.
+ *
+ * \details
+ * Enables or disables the offloading of #optiga_crypt_ecdsa_verify to host in the instance.<br>
+ * - With offloading, the signature with public key from host (#OPTIGA_CRYPT_HOST_DATA) is verified using the pal crypt library
+ *   (mbedTLS, OpenSSL or wolfSSL) instead of OPTIGA.
+ * - The signature with public key of certificate OID (#OPTIGA_CRYPT_OID_DATA, e.g. trust anchors) is always verified by OPTIGA.
+ * - If the curve of the public key is not supported by the crypto library on host, the signature is verified by OPTIGA.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - If the signature is verified on host, the callback registered with instance is invoked before the API returns.
+ * - A failed verification on host is reported to the callback as #OPTIGA_CRYPT_SIGNATURE_VERIFICATION_FAILURE,
+ *   which is same as the error from OPTIGA.
+ * - If a policy is set using #optiga_crypt_set_offload_policy, the policy decides instead.
+ *
+ * \param[in]      me                                    Valid instance of #optiga_crypt_t created using #optiga_crypt_create.
+ * \param[in]      enable                                TRUE to enable, FALSE to disable the offloading.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                 Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT     Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE   The previous operation with the same instance is not complete.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_set_verify_offload(optiga_crypt_t * me,
+                                                                    bool_t enable);
+#endif //OPTIGA_CRYPT_ECDSA_VERIFY_OFFLOAD_ENABLED
+
+#ifdef OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+/**
+ * \brief Sets the time for which the successful ECDSA verifications of the instance are cached.
+ *
+ * \details
+ * Sets the time to live of the successful verifications of #optiga_crypt_ecdsa_verify and #optiga_crypt_ecdsa_verify_format
+ * in the verification cache, which is shared by all the instances.<br>
+ * - A verification is looked up by the SHA-256 digest (calculated on host) of the public key or the certificate OID,
+ *   the digest and the signature. A cached verification completes on host, without any command to OPTIGA.
+ * - Only the successful verifications are cached, a failed verification is always repeated.
+ * - The verifications with the public key of a certificate object (e.g. trust anchor 0xE0E8 - 0xE0EF) are dropped,
+ *   once the object or its metadata is written. All verifications are dropped with a protected update.
+ * - Up to #OPTIGA_CRYPT_VERIFY_CACHE_SIZE verifications are cached, an expired or else the oldest entry is replaced.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - If the verification is cached, the callback registered with instance is invoked before the API returns.
+ * - A cached verification does not repeat the checks of OPTIGA (e.g. execute access condition of the certificate object).
+ *   Enable the cache only for repeated validation of the same chains.
+ *
+ * \param[in]      me                                    Valid instance of #optiga_crypt_t created using #optiga_crypt_create.
+ * \param[in]      ttl_ms                                Time in milliseconds, for which a verification is cached (0 to disable).
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                 Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT     Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE   The previous operation with the same instance is not complete.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_set_verify_cache(optiga_crypt_t * me,
+                                                                  uint32_t ttl_ms);
+
+/**
+ * \brief Retrieves the statistics of the verification cache.
+ *
+ * \details
+ * Retrieves the hits, misses, insertions and invalidations of the verification cache, shared by all the instances.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]      me                                    Valid instance of #optiga_crypt_t created using #optiga_crypt_create.
+ * \param[out]     p_stats                               Pointer to statistics, must not be NULL.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                 Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT     Wrong Input arguments provided.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_get_verify_cache_stats(const optiga_crypt_t * me,
+                                                                        optiga_lib_verify_cache_stats_t * p_stats);
+#endif //OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
 #endif //OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED
 
+#ifdef OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
+/**
+ * \brief Sets the policy, by which the operations are executed on host or by OPTIGA.
+ *
+ * \details
+ * Sets the offload policy, which is shared by all the instances of the OPTIGA.
+ * - The policy decides for the operations in #optiga_lib_offload_operation_t, which are
+ *   #optiga_crypt_hash with #OPTIGA_CRYPT_HOST_DATA and #optiga_crypt_ecdsa_verify (or #optiga_crypt_ecdsa_verify_format)
+ *   with public key from host.<br>
+ * - Once a policy is set, it replaces the settings of the instances (#optiga_crypt_set_hash_offload and
+ *   #optiga_crypt_set_verify_offload) for these operations. With NULL, the settings of the instances apply again.<br>
+ * - With #OPTIGA_LIB_OFFLOAD_AUTO, each path is measured once and the path with the lower average cost is taken.
+ *   The cost by OPTIGA is the time from the invocation till the callback, raised by the current estimated waiting time
+ *   of the execution queue. Every probe_interval decisions, the other path is taken once to refresh its cost.<br>
+ * - The operations of an instance with #OPTIGA_LIB_SECURITY_CLASS_CHIP_ONLY are always executed by OPTIGA.<br>
+ * - The sequences of #optiga_crypt_hash_start, #optiga_crypt_hash_update and #optiga_crypt_hash_finalize are not decided
+ *   by the policy, since the state of the sequence is bound to the path it is started with.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]      me                                    Valid instance of #optiga_crypt_t created using #optiga_crypt_create.
+ * \param[in]      p_policy                              Policy as defined in #optiga_lib_offload_policy_t, NULL to remove the policy.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                 Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT     Wrong Input arguments provided.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_set_offload_policy(optiga_crypt_t * me,
+                                                                   const optiga_lib_offload_policy_t * p_policy);
+
+/**
+ * \brief Sets the security class of the operations of the instance.
+ *
+ * \details
+ * Sets the security class of the operations of the instance, as considered by the offload policy.
+ * - With #OPTIGA_LIB_SECURITY_CLASS_CHIP_ONLY, the operations of the instance are always executed by OPTIGA,
+ *   irrespective of the policy and the offload settings of the instance.<br>
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]      me                                    Valid instance of #optiga_crypt_t created using #optiga_crypt_create.
+ * \param[in]      security_class                        Security class as defined in #optiga_lib_security_class_t.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                 Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT     Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE   The previous operation with the same instance is not complete.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_set_security_class(optiga_crypt_t * me,
+                                                                   optiga_lib_security_class_t security_class);
+
+/**
+ * \brief Retrieves the cost model and the decisions of the offload policy for an operation.
+ *
+ * \details
+ * Retrieves the average costs on host and by OPTIGA and the counts of the decisions for an operation,
+ * shared by all the instances.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The decisions are counted, even if no policy is set.
+ *
+ * \param[in]      me                                    Valid instance of #optiga_crypt_t created using #optiga_crypt_create.
+ * \param[in]      operation                             Operation as defined in #optiga_lib_offload_operation_t.
+ * \param[out]     p_stats                               Pointer to statistics, must not be NULL.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                 Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT     Wrong Input arguments provided.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_get_offload_stats(const optiga_crypt_t * me,
+                                                                  optiga_lib_offload_operation_t operation,
+                                                                  optiga_lib_offload_stats_t * p_stats);
+#endif //OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
+
 #ifdef OPTIGA_CRYPT_ECDH_ENABLED
  /**
  * \brief Calculates the shared secret using ECDH algorithm.<br>
@@ -652,6 +1571,59 @@ LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_tls_prf(optiga_crypt_t * me,
                                                          uint16_t derived_key_length,
                                                          bool_t export_to_host,
                                                          uint8_t * derived_key); 
+
+#if defined (OPTIGA_CRYPT_TLS_HANDSHAKE_ENABLED) && defined (OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED) && defined (OPTIGA_CRYPT_ECDH_ENABLED)
+/**
+ * \brief Derives the key block of a TLS 1.2 ECDHE handshake.<br>
+ *
+ * \details
+ * Derives the key block of a TLS 1.2 ECDHE handshake, as one chain of commands.
+ * - Generates the ephemeral key pair into the session and exports the public key.<br>
+ * - Calculates the shared secret (pre-master secret) with the public key of the peer into the session.<br>
+ * - Derives the master secret into the session, using label "master secret" and seed client random | server random.<br>
+ * - Derives the key block to host, using label "key expansion" and seed server random | client random.<br>
+ * - The commands are executed back to back under one acquisition of the lock and the session, using
+ *   #optiga_cmd_execute_chain. The chain stops at the first failed command.<br>
+ * - The callback registered with instance (#optiga_crypt_create) gets invoked once, when the key block is derived.
+ *
+ * \pre
+ * - The application on OPTIGA must be opened using #optiga_util_open_application.<br>
+ *
+ * \note
+ * - The master secret remains in the session of the instance, e.g. for the verify data of the Finished message
+ *   using #optiga_crypt_tls_prf with #OPTIGA_KEY_ID_SESSION_BASED.
+ * - For <b>protected I2C communication</b>, Refer #OPTIGA_CRYPT_SET_COMMS_PROTECTION_LEVEL
+ *      - Default protection level for this API is OPTIGA_COMMS_COMMAND_PROTECTION.
+ * - Error codes from lower layers is returned as it is to the application.<br>
+ *
+ * \param[in]         me                                       Valid instance of #optiga_crypt_t created using #optiga_crypt_create.
+ * \param[in]         curve_id                                 ECC curve of the ephemeral key pair as #optiga_ecc_curve_t.
+ * \param[in]         peer_public_key                          Public key of the peer (ServerKeyExchange), must not be NULL.
+ * \param[in,out]     public_key                               Buffer to store the exported ephemeral public key (ClientKeyExchange).
+ * \param[in,out]     public_key_length                        Length of the public key buffer, updated with the length of the public key.
+ * \param[in]         type                                     Type of scheme to be used for TLS PRF as #optiga_tls_prf_type_t.
+ * \param[in]         client_random                            Client random of #OPTIGA_CRYPT_TLS_RANDOM_LENGTH bytes, must not be NULL.
+ * \param[in]         server_random                            Server random of #OPTIGA_CRYPT_TLS_RANDOM_LENGTH bytes, must not be NULL.
+ * \param[in]         key_block_length                         Length of the key block.
+ * \param[in,out]     key_block                                Buffer with a minimum size of key_block_length, must not be NULL.
+ *
+ * \retval            #OPTIGA_CRYPT_SUCCESS                    Successful invocation
+ * \retval            #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided
+ * \retval            #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      The previous operation with the same instance is not complete
+ * \retval            #OPTIGA_DEVICE_ERROR                     Command execution failure in OPTIGA and the LSB indicates the error code.
+ *                                                             (Refer Solution Reference Manual)
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_tls_handshake_key_block(optiga_crypt_t * me,
+                                                                         optiga_ecc_curve_t curve_id,
+                                                                         public_key_from_host_t * peer_public_key,
+                                                                         uint8_t * public_key,
+                                                                         uint16_t * public_key_length,
+                                                                         optiga_tls_prf_type_t type,
+                                                                         const uint8_t * client_random,
+                                                                         const uint8_t * server_random,
+                                                                         uint16_t key_block_length,
+                                                                         uint8_t * key_block);
+#endif //(OPTIGA_CRYPT_TLS_HANDSHAKE_ENABLED) && (OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED) && (OPTIGA_CRYPT_ECDH_ENABLED)
 #endif // OPTIGA_CRYPT_TLS_PRF_SHA256_ENABLED || OPTIGA_CRYPT_TLS_PRF_SHA384_ENABLED || OPTIGA_CRYPT_TLS_PRF_SHA512_ENABLED                                                         
                                                 
 #ifdef OPTIGA_CRYPT_TLS_PRF_SHA256_ENABLED                                                         
@@ -1024,6 +1996,45 @@ LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_rsa_verify(optiga_crypt_t * me,
                                                             uint16_t salt_length);
 #endif //OPTIGA_CRYPT_RSA_VERIFY_ENABLED
 
+#ifdef OPTIGA_CRYPT_VERIFY_BATCH_ENABLED
+/**
+ * \brief Verifies several ECDSA and RSA signatures.
+ *
+ * \details
+ * Verifies several ECDSA and RSA signatures, e.g. the signatures of a certificate chain.
+ * - The ECDSA signatures with public key from host are verified on host first, if offloading is enabled using
+ *   #optiga_crypt_set_verify_offload and the curve is supported by the crypto library on host.<br>
+ * - The remaining signatures are verified by OPTIGA in chunks of OPTIGA_CRYPT_VERIFY_BATCH_CHUNK_SIZE, using #optiga_cmd_execute_batch.
+ *   The verify commands of a chunk are issued back to back under one acquisition of the OPTIGA lock.<br>
+ * - The status of each item is updated with the result of the respective verification.<br>
+ * - The callback registered with instance (#optiga_crypt_create) gets invoked once, when all the items are verified
+ *   or the batch is aborted due to a failure of the communication.
+ *
+ * \pre
+ * - The application on OPTIGA must be opened using #optiga_util_open_application before using this API.<br>
+ *
+ * \note
+ * - For <b>protected I2C communication</b>, Refer #OPTIGA_CRYPT_SET_COMMS_PROTECTION_LEVEL. The protection level applies to each verify command.
+ * - The items and the buffers referred by the items must be valid until the callback is invoked.
+ * - The callback is invoked with #OPTIGA_LIB_SUCCESS, if all the signatures are verified successfully. Otherwise it is invoked with
+ *   the status of the first failed item.
+ * - The items are verified in an order different than the order of the items. Hence, the batch does not validate a chain by itself,
+ *   e.g. a certificate verified in the batch can not be used as the public key source of another item of the same batch.
+ * - If all the items are verified on host, the callback is invoked before this API returns.
+ *
+ * \param[in]      me                                       Valid instance of #optiga_crypt_t created using #optiga_crypt_create.
+ * \param[in,out]  items                                    Items to be verified, must not be NULL.
+ * \param[in]      item_count                               Number of items, must not be zero.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      The previous operation with the same instance is not complete.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_verify_batch(optiga_crypt_t * me,
+                                                              optiga_crypt_verify_item_t * items,
+                                                              uint16_t item_count);
+#endif //OPTIGA_CRYPT_VERIFY_BATCH_ENABLED
+
 #ifdef OPTIGA_CRYPT_RSA_PRE_MASTER_SECRET_ENABLED
 /**
  * \brief Generates a pre-master secret.
@@ -1918,6 +2929,8 @@ LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_rsa_encrypt_session(optiga_cryp
  * - The strict sequence is terminated
  *   - In case of an error from lower layer.<br>
  *   - Same instance is used for other service layer APIs (except #optiga_crypt_hmac_update and #optiga_crypt_hmac_finalize).<br>
+ * - If coalescing is enabled (Refer #optiga_crypt_set_update_coalescing), the start is deferred and sent along with the
+ *   coalesced data. Hence a short HMAC, whose data fits into the buffer, costs a single command.<br>
  *
  * \param[in]         me                                    Valid instance of #optiga_crypt_t created using #optiga_crypt_create.
  * \param[in]         type                                  HMAC type
@@ -1964,6 +2977,9 @@ LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_rsa_encrypt_session(optiga_cryp
  * - Error codes from lower layers is returned as it is to the application.<br>
  * - The strict sequence is terminated in case of an error from lower layer<br>
  * - Invoking this API without successful completion of #optiga_crypt_hmac_start throws #OPTIGA_CMD_ERROR_INVALID_INPUT error.<br>
+ * - If coalescing is enabled (Refer #optiga_crypt_set_update_coalescing), the input data is sent along with the data of further updates.<br>
+ * - With coalescing, the input data is coalesced only for a sequence started by #optiga_crypt_hmac_start while coalescing
+ *   is enabled. Otherwise it is sent right away and OPTIGA enforces the sequence.<br>
  *
  * \param[in]         me                                    Valid instance of #optiga_crypt_t created using #optiga_crypt_create.
  * \param[in]         input_data                            Pointer to input data for HMAC generation.
@@ -2032,6 +3048,65 @@ LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_rsa_encrypt_session(optiga_cryp
                                                                 uint8_t * mac,
                                                                 uint32_t * mac_length);
 #endif //OPTIGA_CRYPT_HMAC_ENABLED
+
+#ifdef OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+/**
+ * \brief Enables or disables the coalescing of small hash and hmac updates on host.
+ *
+ * \details
+ * Enables or disables the coalescing of small updates in the instance.<br>
+ * - With coalescing, the data of #optiga_crypt_hash_update (host data) and #optiga_crypt_hmac_update is copied into
+ *   the buffer of the instance, instead of being sent to OPTIGA right away.
+ * - The buffer is sent, once it is filled up to #OPTIGA_CRYPT_COALESCING_BUFFER_SIZE, and by
+ *   #optiga_crypt_hash_finalize, #optiga_crypt_hmac_finalize or #optiga_crypt_update_flush.
+ * - Hence many small updates cost a single command.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - If the data of an update is coalesced, the callback registered with instance is invoked before the API returns.
+ * - The buffer holds the data of one sequence (one hash context or the hmac sequence) at a time.
+ *   Updating another sequence, before the coalesced data is flushed, returns #OPTIGA_CRYPT_ERROR_INVALID_INPUT.
+ * - The coalesced data is discarded, if a command of the sequence fails or #optiga_crypt_hmac_start is invoked again.
+ * - The start of the hmac sequence is coalesced as well. Errors of the secret or the type are hence returned by the
+ *   API, which sends the coalesced data.
+ *
+ * \param[in]      me                                    Valid instance of #optiga_crypt_t created using #optiga_crypt_create.
+ * \param[in]      enable                                TRUE to enable, FALSE to disable the coalescing.
+ *                                                       - The coalesced data must be flushed before disabling.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                 Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT     Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE   The previous operation with the same instance is not complete.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_set_update_coalescing(optiga_crypt_t * me,
+                                                                       bool_t enable);
+
+/**
+ * \brief Sends the data coalesced from the previous updates to OPTIGA.
+ *
+ * \details
+ * Sends the data coalesced from the previous updates as a single update of the sequence.<br>
+ * - If no data is coalesced, the callback registered with instance is invoked before the API returns.
+ * - The callback registered with instance (#optiga_crypt_create) gets invoked, when the operation is asynchronously completed.
+ *
+ * \pre
+ * - Coalescing must be enabled using #optiga_crypt_set_update_coalescing.
+ *
+ * \note
+ * - Error codes from lower layer will be returned as it is.
+ *
+ * \param[in]      me                                    Valid instance of #optiga_crypt_t created using #optiga_crypt_create.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                 Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT     Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE   The previous operation with the same instance is not complete.
+ * \retval         #OPTIGA_DEVICE_ERROR                  Command execution failure in OPTIGA and the LSB indicates the error code.
+ *                                                       (Refer Solution Reference Manual)
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_update_flush(optiga_crypt_t * me);
+#endif //OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
                                                                 
 #ifdef OPTIGA_CRYPT_HKDF_ENABLED
 /**
@@ -2305,6 +3380,60 @@ _STATIC_INLINE LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_hkdf_sha512(opti
                               export_to_host,
                               derived_key));
 }
+
+#if defined (OPTIGA_CRYPT_TLS13_KEY_SCHEDULE_ENABLED) && defined (OPTIGA_CRYPT_ECDH_ENABLED)
+/**
+ * \brief Derives the handshake secrets of a TLS 1.3 (EC)DHE handshake.<br>
+ *
+ * \details
+ * Derives the handshake secrets of a TLS 1.3 (EC)DHE handshake (RFC 8446, section 7.1), as one chain of commands.
+ * - Calculates the (EC)DHE shared secret with the public key of the peer into the session.<br>
+ * - Derives client_handshake_traffic_secret and server_handshake_traffic_secret, using HKDF with the salt,
+ *   the shared secret and the HkdfLabel of "c hs traffic" and "s hs traffic" with the transcript hash.<br>
+ * - Derives the salt of the master secret, using the HkdfLabel of "derived" with the hash of empty string.<br>
+ * - The commands are executed back to back under one acquisition of the lock and the session, using
+ *   #optiga_cmd_execute_chain. The chain stops at the first failed command.<br>
+ * - The callback registered with instance (#optiga_crypt_create) gets invoked once, when all the secrets are derived.
+ *
+ * \pre
+ * - The application on OPTIGA must be opened using #optiga_util_open_application.<br>
+ * - The ephemeral key pair must be generated into the session of the instance, using #optiga_crypt_ecc_generate_keypair
+ *   with #OPTIGA_KEY_ID_SESSION_BASED.
+ *
+ * \note
+ * - The HKDF of OPTIGA is the extract followed by the expand, where the secret stored in OPTIGA is the input keying
+ *   material. Hence only the secrets expanded from the handshake secret are derived by OPTIGA. The traffic keys and IVs
+ *   (HKDF-Expand-Label of the traffic secrets) and the master secret are derived by the TLS stack on host.
+ * - The shared secret remains in the session of the instance.
+ * - For <b>protected I2C communication</b>, Refer #OPTIGA_CRYPT_SET_COMMS_PROTECTION_LEVEL
+ *      - Default protection level for this API is OPTIGA_COMMS_COMMAND_PROTECTION.
+ * - Error codes from lower layers is returned as it is to the application.<br>
+ *
+ * \param[in]         me                                       Valid instance of #optiga_crypt_t created using #optiga_crypt_create.
+ * \param[in]         type                                     Type of HKDF as #optiga_hkdf_type_t, the hash of the cipher suite.
+ * \param[in]         peer_public_key                          Public key of the peer (key_share of ServerHello), must not be NULL.
+ * \param[in]         salt                                     Derive-Secret(Early Secret, "derived", "") of hash length, must not be NULL.
+ * \param[in]         transcript_hash                          Transcript hash of ClientHello to ServerHello of hash length, must not be NULL.
+ * \param[in,out]     client_handshake_secret                  Buffer of hash length for client_handshake_traffic_secret, must not be NULL.
+ * \param[in,out]     server_handshake_secret                  Buffer of hash length for server_handshake_traffic_secret, must not be NULL.
+ * \param[in,out]     master_secret_salt                       Buffer of hash length for Derive-Secret(Handshake Secret, "derived", ""),
+ *                                                             must not be NULL.
+ *
+ * \retval            #OPTIGA_CRYPT_SUCCESS                    Successful invocation
+ * \retval            #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided
+ * \retval            #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      The previous operation with the same instance is not complete
+ * \retval            #OPTIGA_DEVICE_ERROR                     Command execution failure in OPTIGA and the LSB indicates the error code.
+ *                                                             (Refer Solution Reference Manual)
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_tls13_handshake_secrets(optiga_crypt_t * me,
+                                                                         optiga_hkdf_type_t type,
+                                                                         public_key_from_host_t * peer_public_key,
+                                                                         const uint8_t * salt,
+                                                                         const uint8_t * transcript_hash,
+                                                                         uint8_t * client_handshake_secret,
+                                                                         uint8_t * server_handshake_secret,
+                                                                         uint8_t * master_secret_salt);
+#endif //(OPTIGA_CRYPT_TLS13_KEY_SCHEDULE_ENABLED) && (OPTIGA_CRYPT_ECDH_ENABLED)
 #endif //OPTIGA_CRYPT_HKDF_ENABLED
 
 #ifdef OPTIGA_CRYPT_SYM_GENERATE_KEY_ENABLED
@@ -2490,6 +3619,575 @@ LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_clear_auto_state(optiga_crypt_t
                                                                   uint16_t secret);
 
 #endif //OPTIGA_CRYPT_CLEAR_AUTO_STATE_ENABLED
+
+#if defined (OPTIGA_CRYPT_HMAC_AUTHORIZE_ENABLED) && defined (OPTIGA_CRYPT_SYM_DECRYPT_ENABLED)
+/**
+ * \brief Authorizes with the HMAC of an auth code and executes the protected commands, as one chain of commands.<br>
+ *
+ * \details
+ * Executes the flow of #optiga_crypt_generate_auth_code, #optiga_crypt_hmac_verify, the protected commands and
+ * #optiga_crypt_clear_auto_state under one acquisition of the lock and the session, using #optiga_cmd_execute_chain.
+ * - Generates the auth code (optional data | random) into the session.<br>
+ * - Calculates the HMAC of the auth code on host, using the hmac_callback (#OPTIGA_CMD_BATCH_ITEM_HOST).<br>
+ * - Verifies the HMAC with the secret, which sets the AUTO state of the secret.<br>
+ * - Executes the protected items of the caller back to back, e.g. reading a data object with the AUTO access condition.<br>
+ * - Clears the AUTO state, if requested. Otherwise the AUTO state remains valid for the further operations.<br>
+ * - The callback registered with instance (#optiga_crypt_create) gets invoked once, when the chain is completed.
+ *
+ * \pre
+ * - The application on OPTIGA must be opened using #optiga_util_open_application.<br>
+ * - The data object specified by input <b>secret</b> must have a secret written into it.<br>
+ *
+ * \note
+ * - The chain stops at the first failed command. If a protected item fails after the HMAC verification,
+ *   the AUTO state is still cleared (if requested) and the status of the failed item is reported.
+ * - The status of each protected item is updated, once the callback is invoked.
+ * - The session is released by the HMAC verification, hence the protected items must not use the session.
+ * - The protected items and the parameters referred by the items must be valid until the callback is invoked.
+ * - For <b>protected I2C communication</b>, Refer #OPTIGA_CRYPT_SET_COMMS_PROTECTION_LEVEL.
+ *      - Default protection level for this API is #OPTIGA_COMMS_RESPONSE_PROTECTION.
+ * - Error codes from lower layers is returned as it is to the application.<br>
+ *
+ * \param[in]         me                                    Valid instance of #optiga_crypt_t created using #optiga_crypt_create.
+ * \param[in]         rng_type                              Type of random data generator as #optiga_rng_type_t.
+ * \param[in]         type                                  HMAC type as #optiga_hmac_type_t
+ * \param[in]         secret                                OPTIGA OID with input secret, data object type must be AUTOREF.
+ * \param[in]         optional_data                         Optional data that gets prepended to the random, can be NULL.
+ * \param[in]         optional_data_length                  Length of the optional data. It is ignored if optional_data is NULL.
+ * \param[in]         random_data_length                    Length of the random.
+ *                                                          - Minimum length is 8 bytes.
+ *                                                          - Maximum length of optional data and random is
+ *                                                            #OPTIGA_CRYPT_HMAC_AUTHORIZE_MAX_INPUT_LENGTH.
+ * \param[in]         hmac_callback                         Callback to calculate the HMAC on host, must not be NULL.
+ * \param[in]         hmac_context                          Context of the hmac_callback.
+ * \param[in,out]     protected_items                       Pointer to array of protected items (Refer #optiga_cmd_execute_chain),
+ *                                                          can be NULL if protected_item_count is 0.
+ * \param[in]         protected_item_count                  Number of protected items, up to OPTIGA_CMD_BATCH_MAX_ITEMS less
+ *                                                          #OPTIGA_CRYPT_HMAC_AUTHORIZE_STEPS and one for the clear AUTO state.
+ * \param[in]         clear_auto_state                      TRUE to clear the AUTO state after the protected items.
+ *
+ * \retval            #OPTIGA_CRYPT_SUCCESS                 Successful invocation
+ * \retval            #OPTIGA_CRYPT_ERROR_INVALID_INPUT     Wrong Input arguments provided
+ * \retval            #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE   The previous operation with the same instance is not complete
+ * \retval            #OPTIGA_DEVICE_ERROR                  Command execution failure in OPTIGA and the LSB indicates the error code.
+ *                                                          (Refer Solution Reference Manual)
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_hmac_authorize(optiga_crypt_t * me,
+                                                                optiga_rng_type_t rng_type,
+                                                                optiga_hmac_type_t type,
+                                                                uint16_t secret,
+                                                                const uint8_t * optional_data,
+                                                                uint16_t optional_data_length,
+                                                                uint16_t random_data_length,
+                                                                optiga_crypt_hmac_callback_t hmac_callback,
+                                                                void * hmac_context,
+                                                                optiga_cmd_batch_item_t * protected_items,
+                                                                uint8_t protected_item_count,
+                                                                bool_t clear_auto_state);
+#endif //(OPTIGA_CRYPT_HMAC_AUTHORIZE_ENABLED) && (OPTIGA_CRYPT_SYM_DECRYPT_ENABLED)
+
+#ifdef OPTIGA_LIB_SYNC_API_ENABLED
+#ifdef OPTIGA_CRYPT_RANDOM_ENABLED
+/**
+ * \brief Generates a random number and blocks the caller until completion.
+ *
+ * \details
+ * Synchronous variant of #optiga_crypt_random.
+ * - Invokes #optiga_crypt_random and blocks the caller on the PAL wait object of the instance, until the operation is completed.<br>
+ * - The callback handler registered with the instance is not invoked.<br>
+ *
+ * \pre
+ * - Same as #optiga_crypt_random.
+ *
+ * \note
+ * - Must not be invoked from the callback handler or from the context which executes the OPTIGA events (Refer pal_os_event.h).
+ *
+ * \param[in]      me                                     Refer #optiga_crypt_random.
+ * \param[in]      rng_type                               Refer #optiga_crypt_random.
+ * \param[in,out]  random_data                            Refer #optiga_crypt_random.
+ * \param[in]      random_data_length                     Refer #optiga_crypt_random.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful completion of the operation.
+ * \retval    Error code                             As returned by #optiga_crypt_random or reported on completion of the operation.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_random_sync(optiga_crypt_t * me,
+                                                             optiga_rng_type_t rng_type,
+                                                             uint8_t * random_data,
+                                                             uint16_t random_data_length);
+#endif //OPTIGA_CRYPT_RANDOM_ENABLED
+
+#ifdef OPTIGA_CRYPT_HASH_ENABLED
+/**
+ * \brief Generates the hash of the data and blocks the caller until completion.
+ *
+ * \details
+ * Synchronous variant of #optiga_crypt_hash.
+ * - Invokes #optiga_crypt_hash and blocks the caller on the PAL wait object of the instance, until the operation is completed.<br>
+ * - The callback handler registered with the instance is not invoked.<br>
+ *
+ * \pre
+ * - Same as #optiga_crypt_hash.
+ *
+ * \note
+ * - Must not be invoked from the callback handler or from the context which executes the OPTIGA events (Refer pal_os_event.h).
+ *
+ * \param[in]      me                                     Refer #optiga_crypt_hash.
+ * \param[in]      hash_algorithm                         Refer #optiga_crypt_hash.
+ * \param[in]      source_of_data_to_hash                 Refer #optiga_crypt_hash.
+ * \param[in]      data_to_hash                           Refer #optiga_crypt_hash.
+ * \param[in,out]  hash_output                            Refer #optiga_crypt_hash.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful completion of the operation.
+ * \retval    Error code                             As returned by #optiga_crypt_hash or reported on completion of the operation.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_hash_sync(optiga_crypt_t * me,
+                                                           optiga_hash_type_t hash_algorithm,
+                                                           uint8_t source_of_data_to_hash,
+                                                           const void * data_to_hash,
+                                                           uint8_t * hash_output);
+#endif //OPTIGA_CRYPT_HASH_ENABLED
+
+#ifdef OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED
+/**
+ * \brief Generates an ECC key pair and blocks the caller until completion.
+ *
+ * \details
+ * Synchronous variant of #optiga_crypt_ecc_generate_keypair.
+ * - Invokes #optiga_crypt_ecc_generate_keypair and blocks the caller on the PAL wait object of the instance, until the operation is completed.<br>
+ * - The callback handler registered with the instance is not invoked.<br>
+ *
+ * \pre
+ * - Same as #optiga_crypt_ecc_generate_keypair.
+ *
+ * \note
+ * - Must not be invoked from the callback handler or from the context which executes the OPTIGA events (Refer pal_os_event.h).
+ *
+ * \param[in]      me                                     Refer #optiga_crypt_ecc_generate_keypair.
+ * \param[in]      curve_id                               Refer #optiga_crypt_ecc_generate_keypair.
+ * \param[in]      key_usage                              Refer #optiga_crypt_ecc_generate_keypair.
+ * \param[in]      export_private_key                     Refer #optiga_crypt_ecc_generate_keypair.
+ * \param[in,out]  private_key                            Refer #optiga_crypt_ecc_generate_keypair.
+ * \param[in,out]  public_key                             Refer #optiga_crypt_ecc_generate_keypair.
+ * \param[in,out]  public_key_length                      Refer #optiga_crypt_ecc_generate_keypair.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful completion of the operation.
+ * \retval    Error code                             As returned by #optiga_crypt_ecc_generate_keypair or reported on completion of the operation.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_ecc_generate_keypair_sync(optiga_crypt_t * me,
+                                                                           optiga_ecc_curve_t curve_id,
+                                                                           uint8_t key_usage,
+                                                                           bool_t export_private_key,
+                                                                           void * private_key,
+                                                                           uint8_t * public_key,
+                                                                           uint16_t * public_key_length);
+#endif //OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED
+
+#ifdef OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
+/**
+ * \brief Generates an ECDSA signature and blocks the caller until completion.
+ *
+ * \details
+ * Synchronous variant of #optiga_crypt_ecdsa_sign.
+ * - Invokes #optiga_crypt_ecdsa_sign and blocks the caller on the PAL wait object of the instance, until the operation is completed.<br>
+ * - The callback handler registered with the instance is not invoked.<br>
+ *
+ * \pre
+ * - Same as #optiga_crypt_ecdsa_sign.
+ *
+ * \note
+ * - Must not be invoked from the callback handler or from the context which executes the OPTIGA events (Refer pal_os_event.h).
+ *
+ * \param[in]      me                                     Refer #optiga_crypt_ecdsa_sign.
+ * \param[in]      digest                                 Refer #optiga_crypt_ecdsa_sign.
+ * \param[in]      digest_length                          Refer #optiga_crypt_ecdsa_sign.
+ * \param[in]      private_key                            Refer #optiga_crypt_ecdsa_sign.
+ * \param[in,out]  signature                              Refer #optiga_crypt_ecdsa_sign.
+ * \param[in,out]  signature_length                       Refer #optiga_crypt_ecdsa_sign.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful completion of the operation.
+ * \retval    Error code                             As returned by #optiga_crypt_ecdsa_sign or reported on completion of the operation.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_ecdsa_sign_sync(optiga_crypt_t * me,
+                                                                 const uint8_t * digest,
+                                                                 uint8_t digest_length,
+                                                                 optiga_key_id_t private_key,
+                                                                 uint8_t * signature,
+                                                                 uint16_t * signature_length);
+#endif //OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
+
+#ifdef OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED
+/**
+ * \brief Verifies an ECDSA signature and blocks the caller until completion.
+ *
+ * \details
+ * Synchronous variant of #optiga_crypt_ecdsa_verify.
+ * - Invokes #optiga_crypt_ecdsa_verify and blocks the caller on the PAL wait object of the instance, until the operation is completed.<br>
+ * - The callback handler registered with the instance is not invoked.<br>
+ *
+ * \pre
+ * - Same as #optiga_crypt_ecdsa_verify.
+ *
+ * \note
+ * - Must not be invoked from the callback handler or from the context which executes the OPTIGA events (Refer pal_os_event.h).
+ *
+ * \param[in]      me                                     Refer #optiga_crypt_ecdsa_verify.
+ * \param[in]      digest                                 Refer #optiga_crypt_ecdsa_verify.
+ * \param[in]      digest_length                          Refer #optiga_crypt_ecdsa_verify.
+ * \param[in]      signature                              Refer #optiga_crypt_ecdsa_verify.
+ * \param[in]      signature_length                       Refer #optiga_crypt_ecdsa_verify.
+ * \param[in]      public_key_source_type                 Refer #optiga_crypt_ecdsa_verify.
+ * \param[in]      public_key                             Refer #optiga_crypt_ecdsa_verify.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful completion of the operation.
+ * \retval    Error code                             As returned by #optiga_crypt_ecdsa_verify or reported on completion of the operation.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_ecdsa_verify_sync(optiga_crypt_t * me,
+                                                                   const uint8_t * digest,
+                                                                   uint8_t digest_length,
+                                                                   const uint8_t * signature,
+                                                                   uint16_t signature_length,
+                                                                   uint8_t public_key_source_type,
+                                                                   const void * public_key);
+#endif //OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED
+
+#ifdef OPTIGA_CRYPT_ECDH_ENABLED
+/**
+ * \brief Calculates the shared secret using ECDH and blocks the caller until completion.
+ *
+ * \details
+ * Synchronous variant of #optiga_crypt_ecdh.
+ * - Invokes #optiga_crypt_ecdh and blocks the caller on the PAL wait object of the instance, until the operation is completed.<br>
+ * - The callback handler registered with the instance is not invoked.<br>
+ *
+ * \pre
+ * - Same as #optiga_crypt_ecdh.
+ *
+ * \note
+ * - Must not be invoked from the callback handler or from the context which executes the OPTIGA events (Refer pal_os_event.h).
+ *
+ * \param[in]      me                                     Refer #optiga_crypt_ecdh.
+ * \param[in]      private_key                            Refer #optiga_crypt_ecdh.
+ * \param[in,out]  public_key                             Refer #optiga_crypt_ecdh.
+ * \param[in]      export_to_host                         Refer #optiga_crypt_ecdh.
+ * \param[in,out]  shared_secret                          Refer #optiga_crypt_ecdh.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful completion of the operation.
+ * \retval    Error code                             As returned by #optiga_crypt_ecdh or reported on completion of the operation.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_ecdh_sync(optiga_crypt_t * me,
+                                                           optiga_key_id_t private_key,
+                                                           public_key_from_host_t * public_key,
+                                                           bool_t export_to_host,
+                                                           uint8_t * shared_secret);
+#endif //OPTIGA_CRYPT_ECDH_ENABLED
+
+#ifdef OPTIGA_CRYPT_RSA_SIGN_ENABLED
+/**
+ * \brief Generates an RSA signature and blocks the caller until completion.
+ *
+ * \details
+ * Synchronous variant of #optiga_crypt_rsa_sign.
+ * - Invokes #optiga_crypt_rsa_sign and blocks the caller on the PAL wait object of the instance, until the operation is completed.<br>
+ * - The callback handler registered with the instance is not invoked.<br>
+ *
+ * \pre
+ * - Same as #optiga_crypt_rsa_sign.
+ *
+ * \note
+ * - Must not be invoked from the callback handler or from the context which executes the OPTIGA events (Refer pal_os_event.h).
+ *
+ * \param[in]      me                                     Refer #optiga_crypt_rsa_sign.
+ * \param[in]      signature_scheme                       Refer #optiga_crypt_rsa_sign.
+ * \param[in]      digest                                 Refer #optiga_crypt_rsa_sign.
+ * \param[in]      digest_length                          Refer #optiga_crypt_rsa_sign.
+ * \param[in]      private_key                            Refer #optiga_crypt_rsa_sign.
+ * \param[in,out]  signature                              Refer #optiga_crypt_rsa_sign.
+ * \param[in,out]  signature_length                       Refer #optiga_crypt_rsa_sign.
+ * \param[in]      salt_length                            Refer #optiga_crypt_rsa_sign.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful completion of the operation.
+ * \retval    Error code                             As returned by #optiga_crypt_rsa_sign or reported on completion of the operation.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_rsa_sign_sync(optiga_crypt_t * me,
+                                                               optiga_rsa_signature_scheme_t signature_scheme,
+                                                               const uint8_t * digest,
+                                                               uint8_t digest_length,
+                                                               optiga_key_id_t private_key,
+                                                               uint8_t * signature,
+                                                               uint16_t * signature_length,
+                                                               uint16_t salt_length);
+#endif //OPTIGA_CRYPT_RSA_SIGN_ENABLED
+
+#ifdef OPTIGA_CRYPT_RSA_VERIFY_ENABLED
+/**
+ * \brief Verifies an RSA signature and blocks the caller until completion.
+ *
+ * \details
+ * Synchronous variant of #optiga_crypt_rsa_verify.
+ * - Invokes #optiga_crypt_rsa_verify and blocks the caller on the PAL wait object of the instance, until the operation is completed.<br>
+ * - The callback handler registered with the instance is not invoked.<br>
+ *
+ * \pre
+ * - Same as #optiga_crypt_rsa_verify.
+ *
+ * \note
+ * - Must not be invoked from the callback handler or from the context which executes the OPTIGA events (Refer pal_os_event.h).
+ *
+ * \param[in]      me                                     Refer #optiga_crypt_rsa_verify.
+ * \param[in]      signature_scheme                       Refer #optiga_crypt_rsa_verify.
+ * \param[in]      digest                                 Refer #optiga_crypt_rsa_verify.
+ * \param[in]      digest_length                          Refer #optiga_crypt_rsa_verify.
+ * \param[in]      signature                              Refer #optiga_crypt_rsa_verify.
+ * \param[in]      signature_length                       Refer #optiga_crypt_rsa_verify.
+ * \param[in]      public_key_source_type                 Refer #optiga_crypt_rsa_verify.
+ * \param[in]      public_key                             Refer #optiga_crypt_rsa_verify.
+ * \param[in]      salt_length                            Refer #optiga_crypt_rsa_verify.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful completion of the operation.
+ * \retval    Error code                             As returned by #optiga_crypt_rsa_verify or reported on completion of the operation.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_rsa_verify_sync(optiga_crypt_t * me,
+                                                                 optiga_rsa_signature_scheme_t signature_scheme,
+                                                                 const uint8_t * digest,
+                                                                 uint8_t digest_length,
+                                                                 const uint8_t * signature,
+                                                                 uint16_t signature_length,
+                                                                 uint8_t public_key_source_type,
+                                                                 const void * public_key,
+                                                                 uint16_t salt_length);
+#endif //OPTIGA_CRYPT_RSA_VERIFY_ENABLED
+
+#ifdef OPTIGA_CRYPT_HKDF_ENABLED
+/**
+ * \brief Derives the key using HKDF and blocks the caller until completion.
+ *
+ * \details
+ * Synchronous variant of #optiga_crypt_hkdf.
+ * - Invokes #optiga_crypt_hkdf and blocks the caller on the PAL wait object of the instance, until the operation is completed.<br>
+ * - The callback handler registered with the instance is not invoked.<br>
+ *
+ * \pre
+ * - Same as #optiga_crypt_hkdf.
+ *
+ * \note
+ * - Must not be invoked from the callback handler or from the context which executes the OPTIGA events (Refer pal_os_event.h).
+ *
+ * \param[in]      me                                     Refer #optiga_crypt_hkdf.
+ * \param[in]      type                                   Refer #optiga_crypt_hkdf.
+ * \param[in]      secret                                 Refer #optiga_crypt_hkdf.
+ * \param[in]      salt                                   Refer #optiga_crypt_hkdf.
+ * \param[in]      salt_length                            Refer #optiga_crypt_hkdf.
+ * \param[in]      info                                   Refer #optiga_crypt_hkdf.
+ * \param[in]      info_length                            Refer #optiga_crypt_hkdf.
+ * \param[in]      derived_key_length                     Refer #optiga_crypt_hkdf.
+ * \param[in]      export_to_host                         Refer #optiga_crypt_hkdf.
+ * \param[in,out]  derived_key                            Refer #optiga_crypt_hkdf.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful completion of the operation.
+ * \retval    Error code                             As returned by #optiga_crypt_hkdf or reported on completion of the operation.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_hkdf_sync(optiga_crypt_t * me,
+                                                           optiga_hkdf_type_t type,
+                                                           uint16_t secret,
+                                                           const uint8_t * salt,
+                                                           uint16_t salt_length,
+                                                           const uint8_t * info,
+                                                           uint16_t info_length,
+                                                           uint16_t derived_key_length,
+                                                           bool_t export_to_host,
+                                                           uint8_t * derived_key);
+#endif //OPTIGA_CRYPT_HKDF_ENABLED
+#endif //OPTIGA_LIB_SYNC_API_ENABLED
+
+#ifdef OPTIGA_CRYPT_OPERATION_QUEUE_ENABLED
+/**
+ * \brief Queues an operation, which generates a random number.
+ *
+ * \details
+ * Operation handle variant of #optiga_crypt_random.
+ * - The parameters of the operation are held in the operation handle, hence any number of operations can be queued
+ *   on the instance, up to #OPTIGA_CRYPT_OPERATION_QUEUE_SIZE, without #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE.<br>
+ * - The operation is started right away, if the instance is free. Else it is started once the preceding operations
+ *   of the instance are completed, in the order of queuing.<br>
+ * - The handler of the operation gets invoked instead of the callback handler registered with the instance,
+ *   when the operation is asynchronously completed.<br>
+ *
+ * \pre
+ * - Same as #optiga_crypt_random.
+ *
+ * \note
+ * - The operation handle and the arguments must be valid until the handler of the operation is invoked.
+ * - An operation which fails to start from the queue is completed with the error code to the handler of the operation.
+ * - Operations must not be queued while a start, update (continue) and final sequence is ongoing on the instance.
+ *
+ * \param[in]      me                                     Refer #optiga_crypt_random.
+ * \param[in,out]  p_operation                            Operation handle supplied by the caller, must not be NULL.
+ * \param[in]      rng_type                               Refer #optiga_crypt_random.
+ * \param[in,out]  random_data                            Refer #optiga_crypt_random.
+ * \param[in]      random_data_length                     Refer #optiga_crypt_random.
+ * \param[in]      handler                                Pointer to callback function of the operation, must not be NULL.
+ * \param[in]      caller_context                         Pointer to upper layer context of the operation.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Operation is started or queued.
+ * \retval    #OPTIGA_CRYPT_ERROR_INVALID_INPUT      Wrong Input arguments provided.
+ * \retval    #OPTIGA_CRYPT_ERROR_MEMORY_INSUFFICIENT #OPTIGA_CRYPT_OPERATION_QUEUE_SIZE operations are already queued.
+ * \retval    Error code                             As returned by #optiga_crypt_random, if the operation is started right away.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_operation_random(optiga_crypt_t * me,
+                                                                  optiga_crypt_operation_t * p_operation,
+                                                                  optiga_rng_type_t rng_type,
+                                                                  uint8_t * random_data,
+                                                                  uint16_t random_data_length,
+                                                                  callback_handler_t handler,
+                                                                  void * caller_context);
+
+/**
+ * \brief Queues an operation, which calculates a hash.
+ *
+ * \details
+ * Operation handle variant of #optiga_crypt_hash, refer #optiga_crypt_operation_random.
+ *
+ * \pre
+ * - Same as #optiga_crypt_hash.
+ *
+ * \note
+ * - Refer #optiga_crypt_operation_random.
+ *
+ * \param[in]      me                                     Refer #optiga_crypt_hash.
+ * \param[in,out]  p_operation                            Operation handle supplied by the caller, must not be NULL.
+ * \param[in]      hash_algorithm                         Refer #optiga_crypt_hash.
+ * \param[in]      source_of_data_to_hash                 Refer #optiga_crypt_hash.
+ * \param[in]      data_to_hash                           Refer #optiga_crypt_hash.
+ * \param[in,out]  hash_output                            Refer #optiga_crypt_hash.
+ * \param[in]      handler                                Pointer to callback function of the operation, must not be NULL.
+ * \param[in]      caller_context                         Pointer to upper layer context of the operation.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Operation is started or queued.
+ * \retval    #OPTIGA_CRYPT_ERROR_INVALID_INPUT      Wrong Input arguments provided.
+ * \retval    #OPTIGA_CRYPT_ERROR_MEMORY_INSUFFICIENT #OPTIGA_CRYPT_OPERATION_QUEUE_SIZE operations are already queued.
+ * \retval    Error code                             As returned by #optiga_crypt_hash, if the operation is started right away.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_operation_hash(optiga_crypt_t * me,
+                                                                optiga_crypt_operation_t * p_operation,
+                                                                optiga_hash_type_t hash_algorithm,
+                                                                uint8_t source_of_data_to_hash,
+                                                                const void * data_to_hash,
+                                                                uint8_t * hash_output,
+                                                                callback_handler_t handler,
+                                                                void * caller_context);
+
+/**
+ * \brief Queues an operation, which generates an ECDSA signature.
+ *
+ * \details
+ * Operation handle variant of #optiga_crypt_ecdsa_sign, refer #optiga_crypt_operation_random.
+ *
+ * \pre
+ * - Same as #optiga_crypt_ecdsa_sign.
+ *
+ * \note
+ * - Refer #optiga_crypt_operation_random.
+ *
+ * \param[in]      me                                     Refer #optiga_crypt_ecdsa_sign.
+ * \param[in,out]  p_operation                            Operation handle supplied by the caller, must not be NULL.
+ * \param[in]      digest                                 Refer #optiga_crypt_ecdsa_sign.
+ * \param[in]      digest_length                          Refer #optiga_crypt_ecdsa_sign.
+ * \param[in]      private_key                            Refer #optiga_crypt_ecdsa_sign.
+ * \param[in,out]  signature                              Refer #optiga_crypt_ecdsa_sign.
+ * \param[in,out]  signature_length                       Refer #optiga_crypt_ecdsa_sign.
+ * \param[in]      handler                                Pointer to callback function of the operation, must not be NULL.
+ * \param[in]      caller_context                         Pointer to upper layer context of the operation.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Operation is started or queued.
+ * \retval    #OPTIGA_CRYPT_ERROR_INVALID_INPUT      Wrong Input arguments provided.
+ * \retval    #OPTIGA_CRYPT_ERROR_MEMORY_INSUFFICIENT #OPTIGA_CRYPT_OPERATION_QUEUE_SIZE operations are already queued.
+ * \retval    Error code                             As returned by #optiga_crypt_ecdsa_sign, if the operation is started right away.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_operation_ecdsa_sign(optiga_crypt_t * me,
+                                                                      optiga_crypt_operation_t * p_operation,
+                                                                      const uint8_t * digest,
+                                                                      uint8_t digest_length,
+                                                                      optiga_key_id_t private_key,
+                                                                      uint8_t * signature,
+                                                                      uint16_t * signature_length,
+                                                                      callback_handler_t handler,
+                                                                      void * caller_context);
+
+/**
+ * \brief Queues an operation, which verifies an ECDSA signature.
+ *
+ * \details
+ * Operation handle variant of #optiga_crypt_ecdsa_verify, refer #optiga_crypt_operation_random.
+ *
+ * \pre
+ * - Same as #optiga_crypt_ecdsa_verify.
+ *
+ * \note
+ * - Refer #optiga_crypt_operation_random.
+ *
+ * \param[in]      me                                     Refer #optiga_crypt_ecdsa_verify.
+ * \param[in,out]  p_operation                            Operation handle supplied by the caller, must not be NULL.
+ * \param[in]      digest                                 Refer #optiga_crypt_ecdsa_verify.
+ * \param[in]      digest_length                          Refer #optiga_crypt_ecdsa_verify.
+ * \param[in]      signature                              Refer #optiga_crypt_ecdsa_verify.
+ * \param[in]      signature_length                       Refer #optiga_crypt_ecdsa_verify.
+ * \param[in]      public_key_source_type                 Refer #optiga_crypt_ecdsa_verify.
+ * \param[in]      public_key                             Refer #optiga_crypt_ecdsa_verify.
+ * \param[in]      handler                                Pointer to callback function of the operation, must not be NULL.
+ * \param[in]      caller_context                         Pointer to upper layer context of the operation.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Operation is started or queued.
+ * \retval    #OPTIGA_CRYPT_ERROR_INVALID_INPUT      Wrong Input arguments provided.
+ * \retval    #OPTIGA_CRYPT_ERROR_MEMORY_INSUFFICIENT #OPTIGA_CRYPT_OPERATION_QUEUE_SIZE operations are already queued.
+ * \retval    Error code                             As returned by #optiga_crypt_ecdsa_verify, if the operation is started right away.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_operation_ecdsa_verify(optiga_crypt_t * me,
+                                                                        optiga_crypt_operation_t * p_operation,
+                                                                        const uint8_t * digest,
+                                                                        uint8_t digest_length,
+                                                                        const uint8_t * signature,
+                                                                        uint16_t signature_length,
+                                                                        uint8_t public_key_source_type,
+                                                                        const void * public_key,
+                                                                        callback_handler_t handler,
+                                                                        void * caller_context);
+
+/**
+ * \brief Queues an operation, which generates a shared secret using ECDH.
+ *
+ * \details
+ * Operation handle variant of #optiga_crypt_ecdh, refer #optiga_crypt_operation_random.
+ *
+ * \pre
+ * - Same as #optiga_crypt_ecdh.
+ *
+ * \note
+ * - Refer #optiga_crypt_operation_random.
+ *
+ * \param[in]      me                                     Refer #optiga_crypt_ecdh.
+ * \param[in,out]  p_operation                            Operation handle supplied by the caller, must not be NULL.
+ * \param[in]      private_key                            Refer #optiga_crypt_ecdh.
+ * \param[in]      public_key                             Refer #optiga_crypt_ecdh.
+ * \param[in]      export_to_host                         Refer #optiga_crypt_ecdh.
+ * \param[in,out]  shared_secret                          Refer #optiga_crypt_ecdh.
+ * \param[in]      handler                                Pointer to callback function of the operation, must not be NULL.
+ * \param[in]      caller_context                         Pointer to upper layer context of the operation.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Operation is started or queued.
+ * \retval    #OPTIGA_CRYPT_ERROR_INVALID_INPUT      Wrong Input arguments provided.
+ * \retval    #OPTIGA_CRYPT_ERROR_MEMORY_INSUFFICIENT #OPTIGA_CRYPT_OPERATION_QUEUE_SIZE operations are already queued.
+ * \retval    Error code                             As returned by #optiga_crypt_ecdh, if the operation is started right away.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_operation_ecdh(optiga_crypt_t * me,
+                                                                optiga_crypt_operation_t * p_operation,
+                                                                optiga_key_id_t private_key,
+                                                                public_key_from_host_t * public_key,
+                                                                bool_t export_to_host,
+                                                                uint8_t * shared_secret,
+                                                                callback_handler_t handler,
+                                                                void * caller_context);
+#endif //OPTIGA_CRYPT_OPERATION_QUEUE_ENABLED
+
 /**
  * \brief Enables the protected I2C communication with OPTIGA for CRYPT instances
  *
@@ -0,0 +1,258 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_crypt_cq.h
+*
+* \brief   This file implements the prototype declarations of OPTIGA Crypt completion queue, which reports the completion of crypt operations to an event loop.
+*
+* \ingroup  grOptigaCrypt
+*
+* @{
+*/
+
+#ifndef _OPTIGA_CRYPT_CQ_H_
+#define _OPTIGA_CRYPT_CQ_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "optiga/optiga_crypt.h"
+#include "optiga/pal/pal_os_wait.h"
+
+#ifdef OPTIGA_CRYPT_CQ_ENABLED
+
+/** \brief Completion of an operation submitted to the completion queue */
+typedef struct optiga_crypt_cq_completion
+{
+    /// User tag supplied while submitting the operation
+    void * user_tag;
+    /// Status of the completed operation
+    optiga_lib_status_t status;
+}optiga_crypt_cq_completion_t;
+
+/** \brief Slot of the completion queue, which holds one crypt instance for one operation in flight */
+typedef struct optiga_crypt_cq_slot
+{
+    /// Crypt instance
+    optiga_crypt_t * p_crypt;
+    /// Completion queue which owns the slot
+    void * p_cq;
+    /// User tag of the operation
+    void * user_tag;
+    /// Status of the completed operation
+    optiga_lib_status_t status;
+    /// Next slot in the free list or completed list
+    uint8_t next_index;
+}optiga_crypt_cq_slot_t;
+
+/** \brief OPTIGA crypt completion queue structure */
+typedef struct optiga_crypt_cq
+{
+    /// Slots supplied by the caller, one per operation in flight
+    optiga_crypt_cq_slot_t * p_slots;
+    /// Number of slots
+    uint8_t depth;
+    /// First free slot
+    uint8_t free_head;
+    /// First completed slot, not yet reaped
+    uint8_t completed_head;
+    /// Last completed slot, not yet reaped
+    uint8_t completed_tail;
+    /// Number of submitted operations, not yet reaped
+    uint8_t in_flight;
+    /// Wait object signaled on completion of an operation
+    pal_os_wait_t completion_wait;
+}optiga_crypt_cq_t;
+
+/**
+ * \brief Initializes the crypt completion queue.
+ *
+ * \details
+ * Initializes the crypt completion queue.
+ * - Creates one crypt instance for each slot, associated with the OPTIGA instance.
+ * - Creates the wait object, which is signaled on completion of an operation.
+ *
+ * \pre
+ * - The application on OPTIGA must be opened using #optiga_util_open_application before submitting operations.
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ * - Each slot consumes one slot of the OPTIGA instance registry. Refer #optiga_cmd_set_registry for more operations in flight.
+ * - The slots must be valid until #optiga_crypt_cq_deinit is invoked.
+ *
+ * \param[in,out]  me                                       Pointer to completion queue, must not be NULL.
+ * \param[in]      optiga_instance_id                       Indicates the OPTIGA instance to which the operations are submitted.
+ * \param[in]      p_slots                                  Pointer to array of slots, must not be NULL.
+ * \param[in]      depth                                    Number of slots, must be in the range 1 to 254.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR                      Creation of crypt instance or wait object failed.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_cq_init(optiga_crypt_cq_t * me,
+                                                         uint8_t optiga_instance_id,
+                                                         optiga_crypt_cq_slot_t * p_slots,
+                                                         uint8_t depth);
+
+/**
+ * \brief De-initializes the crypt completion queue.
+ *
+ * \details
+ * De-initializes the crypt completion queue, destroys the crypt instances and the wait object.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in,out]  me                                       Pointer to completion queue, must not be NULL.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      Operations are in flight or not reaped.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_cq_deinit(optiga_crypt_cq_t * me);
+
+/**
+ * \brief Acquires a crypt instance to submit an operation.
+ *
+ * \details
+ * Acquires a free crypt instance of the completion queue, and binds the user tag to it.
+ * - Any asynchronous optiga_crypt API can be invoked once with the crypt instance.
+ * - On completion of the operation, the user tag and status are queued and the wait object is signaled.
+ * - The crypt instance is returned to the completion queue, when the completion is reaped.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - If the optiga_crypt API returns with failure, release the crypt instance using #optiga_crypt_cq_cancel.
+ *
+ * \param[in,out]  me                                       Pointer to completion queue, must not be NULL.
+ * \param[in]      user_tag                                 User tag, reported on completion.
+ *
+ * \retval         #optiga_crypt_t *                         Crypt instance to submit the operation.
+ * \retval         NULL                                     All the slots are in use.
+ */
+LIBRARY_EXPORTS optiga_crypt_t * optiga_crypt_cq_acquire(optiga_crypt_cq_t * me,
+                                                         void * user_tag);
+
+/**
+ * \brief Returns a crypt instance, which was acquired but not submitted.
+ *
+ * \details
+ * Returns a crypt instance to completion queue, if the operation failed to start.
+ *
+ * \pre
+ * - The crypt instance is acquired using #optiga_crypt_cq_acquire.
+ *
+ * \note
+ * - None
+ *
+ * \param[in,out]  me                                       Pointer to completion queue, must not be NULL.
+ * \param[in]      p_crypt                                  Crypt instance acquired from the completion queue.
+ *
+ */
+LIBRARY_EXPORTS void optiga_crypt_cq_cancel(optiga_crypt_cq_t * me,
+                                            const optiga_crypt_t * p_crypt);
+
+/**
+ * \brief Provides the pollable descriptor of the completion queue.
+ *
+ * \details
+ * Provides the descriptor which becomes readable, when completions are available to be reaped.
+ * - The descriptor can be registered with epoll, poll or select of the event loop. (e.g. eventfd on Linux)
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Returns -1 on platforms without pollable descriptor. Use #optiga_crypt_cq_wait instead.
+ *
+ * \param[in]      me                                       Pointer to completion queue, must not be NULL.
+ *
+ * \retval         Descriptor                               Pollable descriptor.
+ * \retval         -1                                       Platform does not provide pollable descriptor.
+ */
+LIBRARY_EXPORTS int32_t optiga_crypt_cq_get_descriptor(const optiga_crypt_cq_t * me);
+
+/**
+ * \brief Blocks the caller until a completion is available.
+ *
+ * \details
+ * Blocks the caller on the wait object of the completion queue, until a completion is available to be reaped.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Must not be invoked from the context which executes the OPTIGA events (Refer pal_os_event.h).
+ *
+ * \param[in,out]  me                                       Pointer to completion queue, must not be NULL.
+ *
+ */
+LIBRARY_EXPORTS void optiga_crypt_cq_wait(optiga_crypt_cq_t * me);
+
+/**
+ * \brief Reaps the completed operations.
+ *
+ * \details
+ * Reaps the completed operations in order of completion, without blocking.
+ * - Copies the user tag and status of up to max_completions operations.
+ * - Returns the crypt instances of the reaped operations to the completion queue.
+ * - Clears the signaled state of the descriptor. It is signaled again, if completions are left.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in,out]  me                                       Pointer to completion queue, must not be NULL.
+ * \param[out]     p_completions                            Pointer to array of completions, must not be NULL.
+ * \param[in]      max_completions                          Number of elements in p_completions.
+ *
+ * \retval         Number of completions copied to p_completions.
+ */
+LIBRARY_EXPORTS uint8_t optiga_crypt_cq_reap(optiga_crypt_cq_t * me,
+                                             optiga_crypt_cq_completion_t * p_completions,
+                                             uint8_t max_completions);
+
+#endif //OPTIGA_CRYPT_CQ_ENABLED
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_OPTIGA_CRYPT_CQ_H_*/
+
+/**
+* @}
+*/
@@ -0,0 +1,253 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_crypt_data_key.h
+*
+* \brief   This file implements the prototype declarations of OPTIGA Crypt data keys, which derives a key per object from a secret in OPTIGA and encrypts the data of the object on host.
+*
+* \ingroup  grOptigaCrypt
+*
+* @{
+*/
+
+#ifndef _OPTIGA_CRYPT_DATA_KEY_H_
+#define _OPTIGA_CRYPT_DATA_KEY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "optiga/optiga_crypt.h"
+#include "optiga/pal/pal_crypt.h"
+
+#ifdef OPTIGA_CRYPT_DATA_KEY_ENABLED
+
+/// Length of the tag of the encrypted data (AES128 CCM)
+#define OPTIGA_CRYPT_DATA_KEY_TAG_LENGTH            (0x10)
+
+/** \brief Data key cached on host */
+typedef struct optiga_crypt_data_key_entry
+{
+    /// Identifier of the object
+    uint8_t object_id[OPTIGA_CRYPT_DATA_KEY_MAX_ID_LENGTH];
+    /// AES128 key of the object
+    uint8_t key[PAL_CRYPT_AES128_KEY_LENGTH];
+    /// Time of the derivation in milliseconds
+    uint32_t derivation_time;
+    /// Length of the identifier of the object
+    uint8_t object_id_length;
+    /// Indicates the entry holds a key
+    uint8_t valid;
+}optiga_crypt_data_key_entry_t;
+
+/** \brief OPTIGA crypt data key structure */
+typedef struct optiga_crypt_data_key
+{
+    /// Data keys cached on host
+    optiga_crypt_data_key_entry_t cache[OPTIGA_CRYPT_DATA_KEY_CACHE_SIZE];
+    /// Crypt instance, which derives the data keys
+    optiga_crypt_t * p_crypt;
+    /// Number of data keys derived by OPTIGA
+    uint32_t derivations;
+    /// Number of operations served with a cached data key
+    uint32_t hits;
+    /// OID of the secret in OPTIGA, from which the data keys are derived
+    uint16_t secret_oid;
+    /// Indicates a data key is derived by OPTIGA
+    uint8_t deriving;
+}optiga_crypt_data_key_t;
+
+/**
+ * \brief Initializes the data keys.
+ *
+ * \details
+ * Initializes the data keys and creates the crypt instance, which derives the data keys.
+ * - With #OPTIGA_CRYPT_DATA_KEY_LOCKED_MEMORY_ENABLED, the cache of the data keys is locked in memory using
+ *   #pal_os_memory_lock, hence it is neither swapped nor part of a core dump.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ * - The data keys must be valid until #optiga_crypt_data_key_deinit is invoked.
+ * - The secret must be a data object of type PRESSEC or a session context, which allows the derivation
+ *   (Refer #optiga_crypt_hkdf).
+ *
+ * \param[in,out]  me                                       Pointer to data keys, must not be NULL.
+ * \param[in]      optiga_instance_id                       Indicates the OPTIGA instance, which derives the data keys.
+ * \param[in]      secret_oid                               OID of the secret in OPTIGA.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR                      Creation of crypt instance or locking of the memory failed.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_data_key_init(optiga_crypt_data_key_t * me,
+                                                               uint8_t optiga_instance_id,
+                                                               uint16_t secret_oid);
+
+/**
+ * \brief De-initializes the data keys.
+ *
+ * \details
+ * De-initializes the data keys, erases the cached data keys and destroys the crypt instance.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in,out]  me                                       Pointer to data keys, must not be NULL.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      A data key is derived.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_data_key_deinit(optiga_crypt_data_key_t * me);
+
+/**
+ * \brief Erases the cached data keys.
+ *
+ * \details
+ * Erases the cached data keys, e.g. once the device is locked. The next operation of each object derives its data key again.
+ *
+ * \pre
+ * - The data keys must be initialized using #optiga_crypt_data_key_init.
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in,out]  me                                       Pointer to data keys, must not be NULL.
+ */
+LIBRARY_EXPORTS void optiga_crypt_data_key_flush(optiga_crypt_data_key_t * me);
+
+/**
+ * \brief Encrypts the data of an object using the data key of the object.
+ *
+ * \details
+ * Encrypts the data with AES128 CCM on host using the pal crypt library.
+ * - The data key of the object is derived by OPTIGA using #optiga_crypt_hkdf (SHA256) from the secret,
+ *   with the identifier of the object as info.
+ * - The data key is cached on host for #OPTIGA_CRYPT_DATA_KEY_TTL milliseconds, hence OPTIGA is used once per object
+ *   and the data is encrypted at the speed of the host, instead of being transferred to OPTIGA.
+ *
+ * \pre
+ * - The data keys must be initialized using #optiga_crypt_data_key_init.
+ *
+ * \note
+ * - This API blocks the caller, if the data key is derived by OPTIGA. Must not be invoked from the callback handler
+ *   or from the context which executes the OPTIGA events (Refer pal_os_event.h).
+ * - One data key is derived at a time, a concurrent derivation returns #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE.
+ * - The nonce must never be used twice with the same object, e.g. a counter or a random value from OPTIGA.
+ * - The length of a call is limited by the pal crypt library. A larger object is encrypted as several records,
+ *   each with its own nonce.
+ *
+ * \param[in,out]  me                                       Pointer to data keys, must not be NULL.
+ * \param[in]      object_id                                Identifier of the object, must not be NULL.
+ * \param[in]      object_id_length                         Length of the identifier, up to #OPTIGA_CRYPT_DATA_KEY_MAX_ID_LENGTH.
+ * \param[in]      nonce                                    Nonce of the data, must not be NULL.
+ * \param[in]      nonce_length                             Length of the nonce, 7 to 13 bytes.
+ * \param[in]      associated_data                          Data authenticated along with the data, NULL if none.
+ * \param[in]      associated_data_length                   Length of the associated data.
+ * \param[in]      plain_data                               Data to be encrypted, must not be NULL.
+ * \param[in]      plain_data_length                        Length of the data to be encrypted.
+ * \param[out]     encrypted_data                           Buffer to store the encrypted data followed by the tag, must have
+ *                                                          plain_data_length + #OPTIGA_CRYPT_DATA_KEY_TAG_LENGTH bytes.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      Another data key is derived.
+ * \retval         #OPTIGA_CRYPT_ERROR                      Encryption on host failed.
+ * \retval         #OPTIGA_DEVICE_ERROR                     Command execution failure in OPTIGA and the LSB indicates the error code.
+ *                                                          (Refer Solution Reference Manual)
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_data_key_encrypt(optiga_crypt_data_key_t * me,
+                                                                  const uint8_t * object_id,
+                                                                  uint8_t object_id_length,
+                                                                  const uint8_t * nonce,
+                                                                  uint8_t nonce_length,
+                                                                  const uint8_t * associated_data,
+                                                                  uint16_t associated_data_length,
+                                                                  const uint8_t * plain_data,
+                                                                  uint16_t plain_data_length,
+                                                                  uint8_t * encrypted_data);
+
+/**
+ * \brief Decrypts the data of an object using the data key of the object.
+ *
+ * \details
+ * Verifies the tag and decrypts the data with AES128 CCM on host, the same as #optiga_crypt_data_key_encrypt.
+ *
+ * \pre
+ * - The data keys must be initialized using #optiga_crypt_data_key_init.
+ *
+ * \note
+ * - Refer #optiga_crypt_data_key_encrypt.
+ *
+ * \param[in,out]  me                                       Pointer to data keys, must not be NULL.
+ * \param[in]      object_id                                Identifier of the object, must not be NULL.
+ * \param[in]      object_id_length                         Length of the identifier, up to #OPTIGA_CRYPT_DATA_KEY_MAX_ID_LENGTH.
+ * \param[in]      nonce                                    Nonce of the data, must not be NULL.
+ * \param[in]      nonce_length                             Length of the nonce, 7 to 13 bytes.
+ * \param[in]      associated_data                          Data authenticated along with the data, NULL if none.
+ * \param[in]      associated_data_length                   Length of the associated data.
+ * \param[in]      encrypted_data                           Encrypted data followed by the tag, must not be NULL.
+ * \param[in]      encrypted_data_length                    Length of the encrypted data including the tag.
+ * \param[out]     plain_data                               Buffer to store the decrypted data, must have
+ *                                                          encrypted_data_length - #OPTIGA_CRYPT_DATA_KEY_TAG_LENGTH bytes.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      Another data key is derived.
+ * \retval         #OPTIGA_CRYPT_ERROR                      Verification of the tag or decryption on host failed.
+ * \retval         #OPTIGA_DEVICE_ERROR                     Command execution failure in OPTIGA and the LSB indicates the error code.
+ *                                                          (Refer Solution Reference Manual)
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_data_key_decrypt(optiga_crypt_data_key_t * me,
+                                                                  const uint8_t * object_id,
+                                                                  uint8_t object_id_length,
+                                                                  const uint8_t * nonce,
+                                                                  uint8_t nonce_length,
+                                                                  const uint8_t * associated_data,
+                                                                  uint16_t associated_data_length,
+                                                                  const uint8_t * encrypted_data,
+                                                                  uint16_t encrypted_data_length,
+                                                                  uint8_t * plain_data);
+
+#endif //OPTIGA_CRYPT_DATA_KEY_ENABLED
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_OPTIGA_CRYPT_DATA_KEY_H_*/
+
+/**
+* @}
+*/
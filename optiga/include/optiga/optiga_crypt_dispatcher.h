@@ -0,0 +1,318 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_crypt_dispatcher.h
+*
+* \brief   This file implements the prototype declarations of OPTIGA Crypt dispatcher, which spreads crypt operations across OPTIGA instances.
+*
+* \ingroup  grOptigaCrypt
+*
+* @{
+*/
+
+#ifndef _OPTIGA_CRYPT_DISPATCHER_H_
+#define _OPTIGA_CRYPT_DISPATCHER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "optiga/optiga_crypt.h"
+
+#ifdef OPTIGA_CRYPT_DISPATCHER_ENABLED
+
+/// Total number of crypt instances (lanes) of the dispatcher
+#define OPTIGA_CRYPT_DISPATCHER_MAX_LANES   (OPTIGA_MAX_NUMBER_OF_INSTANCES * OPTIGA_CRYPT_DISPATCHER_LANES_PER_INSTANCE)
+
+/** \brief Utilisation counters of an OPTIGA instance in the dispatcher */
+typedef struct optiga_crypt_dispatcher_stats
+{
+    /// Number of operations dispatched to the OPTIGA instance
+    uint32_t dispatched_operations;
+    /// Number of operations completed (successful or failed)
+    uint32_t completed_operations;
+    /// Number of operations completed with failure
+    uint32_t failed_operations;
+    /// Total time the operations were in flight (in microseconds)
+    uint32_t busy_time_us;
+    /// Number of operations currently in flight
+    uint8_t in_flight;
+}optiga_crypt_dispatcher_stats_t;
+
+/** \brief Crypt instance (lane) of the dispatcher, which executes one operation at a time */
+typedef struct optiga_crypt_dispatcher_lane
+{
+    /// Crypt instance
+    optiga_crypt_t * p_crypt;
+    /// Dispatcher which owns the lane
+    void * p_dispatcher;
+    /// Start time of the operation in flight (in microseconds)
+    uint32_t start_time;
+    /// Callback handler of the operation in flight
+    callback_handler_t handler;
+    /// Caller context of the operation in flight
+    void * caller_context;
+    /// OPTIGA instance of the crypt instance
+    uint8_t optiga_instance_id;
+    /// Indicates an operation is in flight
+    uint8_t in_flight;
+}optiga_crypt_dispatcher_lane_t;
+
+/** \brief Key affinity, binds a key OID to the OPTIGA instance holding the key */
+typedef struct optiga_crypt_dispatcher_key_affinity
+{
+    /// Key OID
+    uint16_t key_oid;
+    /// OPTIGA instance holding the key
+    uint8_t optiga_instance_id;
+}optiga_crypt_dispatcher_key_affinity_t;
+
+/** \brief OPTIGA crypt dispatcher structure */
+typedef struct optiga_crypt_dispatcher
+{
+    /// Crypt instances (lanes) of all OPTIGA instances
+    optiga_crypt_dispatcher_lane_t lanes[OPTIGA_CRYPT_DISPATCHER_MAX_LANES];
+    /// Key affinity table
+    optiga_crypt_dispatcher_key_affinity_t key_affinity[OPTIGA_CRYPT_DISPATCHER_MAX_KEY_AFFINITY];
+    /// Number of entries in key affinity table
+    uint8_t key_affinity_count;
+    /// Utilisation counters of each OPTIGA instance
+    optiga_crypt_dispatcher_stats_t stats[OPTIGA_MAX_NUMBER_OF_INSTANCES];
+}optiga_crypt_dispatcher_t;
+
+/**
+ * \brief Initializes the crypt dispatcher.
+ *
+ * \details
+ * Initializes the crypt dispatcher.
+ * - Creates #OPTIGA_CRYPT_DISPATCHER_LANES_PER_INSTANCE crypt instances for each OPTIGA instance.
+ * - Clears the key affinity table and the utilisation counters.
+ *
+ * \pre
+ * - The application on each OPTIGA must be opened using #optiga_util_open_application before dispatching operations.
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ * - Each lane consumes one slot of the OPTIGA instance registry.
+ *
+ * \param[in,out]  me                                       Pointer to dispatcher, must not be NULL.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR                      Creation of crypt instance failed.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_dispatcher_init(optiga_crypt_dispatcher_t * me);
+
+/**
+ * \brief De-initializes the crypt dispatcher.
+ *
+ * \details
+ * De-initializes the crypt dispatcher and destroys the crypt instances.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in,out]  me                                       Valid dispatcher initialized using #optiga_crypt_dispatcher_init.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      An operation is in flight.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_dispatcher_deinit(optiga_crypt_dispatcher_t * me);
+
+/**
+ * \brief Binds a key OID to an OPTIGA instance.
+ *
+ * \details
+ * Binds a key OID to an OPTIGA instance. The operations using the key are dispatched only to the OPTIGA instance.
+ * - Binding an already bound key OID updates the OPTIGA instance.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - A key without affinity is considered to be available in all OPTIGA instances.
+ *
+ * \param[in,out]  me                                       Valid dispatcher initialized using #optiga_crypt_dispatcher_init.
+ * \param[in]      key_oid                                  Key OID.
+ * \param[in]      optiga_instance_id                       OPTIGA instance holding the key.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR                      Key affinity table is full.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_dispatcher_set_key_affinity(optiga_crypt_dispatcher_t * me,
+                                                                             uint16_t key_oid,
+                                                                             uint8_t optiga_instance_id);
+
+/**
+ * \brief Retrieves the utilisation counters of an OPTIGA instance.
+ *
+ * \details
+ * Retrieves the utilisation counters of an OPTIGA instance.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]      me                                       Valid dispatcher initialized using #optiga_crypt_dispatcher_init.
+ * \param[in]      optiga_instance_id                       OPTIGA instance.
+ * \param[out]     p_stats                                  Pointer to store the counters, must not be NULL.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_dispatcher_get_stats(const optiga_crypt_dispatcher_t * me,
+                                                                      uint8_t optiga_instance_id,
+                                                                      optiga_crypt_dispatcher_stats_t * p_stats);
+
+#ifdef OPTIGA_CRYPT_RANDOM_ENABLED
+/**
+ * \brief Generates a random number on the least busy OPTIGA instance.
+ *
+ * \details
+ * Dispatches #optiga_crypt_random to the least busy OPTIGA instance.
+ * - The handler gets invoked with the caller context, when the operation is asynchronously completed.
+ *
+ * \pre
+ * - Refer #optiga_crypt_random.
+ *
+ * \note
+ * - Refer #optiga_crypt_random for the arguments.
+ *
+ * \param[in,out]  me                                       Valid dispatcher initialized using #optiga_crypt_dispatcher_init.
+ * \param[in]      rng_type                                 Type of random data generator.
+ * \param[in,out]  random_data                              Pointer to the buffer into which random data is stored, must not be NULL.
+ * \param[in]      random_data_length                       Length of random data to be generated.
+ * \param[in]      handler                                  Pointer to callback function, must not be NULL.
+ * \param[in]      caller_context                           Pointer to upper layer context.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      All lanes are busy.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_dispatcher_random(optiga_crypt_dispatcher_t * me,
+                                                                   optiga_rng_type_t rng_type,
+                                                                   uint8_t * random_data,
+                                                                   uint16_t random_data_length,
+                                                                   callback_handler_t handler,
+                                                                   void * caller_context);
+#endif //OPTIGA_CRYPT_RANDOM_ENABLED
+
+#ifdef OPTIGA_CRYPT_HASH_ENABLED
+/**
+ * \brief Calculates a hash on the least busy OPTIGA instance.
+ *
+ * \details
+ * Dispatches #optiga_crypt_hash to the least busy OPTIGA instance.
+ * - The handler gets invoked with the caller context, when the operation is asynchronously completed.
+ *
+ * \pre
+ * - Refer #optiga_crypt_hash.
+ *
+ * \note
+ * - Refer #optiga_crypt_hash for the arguments.
+ * - If the source of data is in OPTIGA, the OID of the data is used for key affinity.
+ *
+ * \param[in,out]  me                                       Valid dispatcher initialized using #optiga_crypt_dispatcher_init.
+ * \param[in]      hash_algorithm                           Hash algorithm of #optiga_hash_type_t.
+ * \param[in]      source_of_data_to_hash                   Data from host / Data in OPTIGA.
+ * \param[in]      data_to_hash                             Data for hashing either in #hash_data_from_host_t or in #hash_data_in_optiga_t
+ * \param[inout]   hash_output                              Pointer to the valid buffer to store hash output.
+ * \param[in]      handler                                  Pointer to callback function, must not be NULL.
+ * \param[in]      caller_context                           Pointer to upper layer context.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      All lanes are busy.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_dispatcher_hash(optiga_crypt_dispatcher_t * me,
+                                                                 optiga_hash_type_t hash_algorithm,
+                                                                 uint8_t source_of_data_to_hash,
+                                                                 const void * data_to_hash,
+                                                                 uint8_t * hash_output,
+                                                                 callback_handler_t handler,
+                                                                 void * caller_context);
+#endif //OPTIGA_CRYPT_HASH_ENABLED
+
+#ifdef OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
+/**
+ * \brief Generates a signature on the least busy OPTIGA instance holding the key.
+ *
+ * \details
+ * Dispatches #optiga_crypt_ecdsa_sign to the least busy OPTIGA instance, which holds the private key.
+ * - The handler gets invoked with the caller context, when the operation is asynchronously completed.
+ *
+ * \pre
+ * - Refer #optiga_crypt_ecdsa_sign.
+ * - If the private key is available only in one OPTIGA instance, the affinity must be set using #optiga_crypt_dispatcher_set_key_affinity.
+ *
+ * \note
+ * - Refer #optiga_crypt_ecdsa_sign for the arguments.
+ * - Session based keys (#OPTIGA_KEY_ID_SESSION_BASED) are not supported, since the session is bound to a crypt instance.
+ *
+ * \param[in,out]  me                                       Valid dispatcher initialized using #optiga_crypt_dispatcher_init.
+ * \param[in]      digest                                   Digest on which signature is generated.
+ * \param[in]      digest_length                            Length of the input digest.
+ * \param[in]      private_key                              Private key OID to generate signature.
+ * \param[in,out]  signature                                Pointer to store generated signature, must not be NULL.
+ * \param[in,out]  signature_length                         Length of signature.
+ * \param[in]      handler                                  Pointer to callback function, must not be NULL.
+ * \param[in]      caller_context                           Pointer to upper layer context.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      All lanes of the OPTIGA instances holding the key are busy.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_dispatcher_ecdsa_sign(optiga_crypt_dispatcher_t * me,
+                                                                       const uint8_t * digest,
+                                                                       uint8_t digest_length,
+                                                                       optiga_key_id_t private_key,
+                                                                       uint8_t * signature,
+                                                                       uint16_t * signature_length,
+                                                                       callback_handler_t handler,
+                                                                       void * caller_context);
+#endif //OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
+
+#endif //OPTIGA_CRYPT_DISPATCHER_ENABLED
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_OPTIGA_CRYPT_DISPATCHER_H_*/
+
+/**
+* @}
+*/
+
@@ -0,0 +1,269 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_crypt_hash_mux.h
+*
+* \brief   This file implements the prototype declarations of OPTIGA Crypt hash multiplexer, which runs several hash sequences over one crypt instance.
+*
+* \ingroup  grOptigaCrypt
+*
+* @{
+*/
+
+#ifndef _OPTIGA_CRYPT_HASH_MUX_H_
+#define _OPTIGA_CRYPT_HASH_MUX_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "optiga/optiga_crypt.h"
+
+#ifdef OPTIGA_CRYPT_HASH_MUX_ENABLED
+
+/** \brief Hash sequence of the hash multiplexer */
+typedef struct optiga_crypt_hash_mux_sequence
+{
+    /// Hash context of the sequence, provided by the caller
+    optiga_hash_context_t * p_hash_ctx;
+    /// Data of the updates, which is not yet sent to OPTIGA
+    uint8_t buffer[OPTIGA_CRYPT_HASH_MUX_BUFFER_SIZE];
+    /// Length of the data in the buffer
+    uint16_t buffered_length;
+    /// Indicates the sequence is hashed on host
+    uint8_t on_host;
+    /// Indicates the sequence is started
+    uint8_t in_use;
+}optiga_crypt_hash_mux_sequence_t;
+
+/** \brief OPTIGA crypt hash multiplexer structure */
+typedef struct optiga_crypt_hash_mux
+{
+    /// Crypt instance, which executes the operations of all the sequences
+    optiga_crypt_t * p_crypt;
+    /// Callback handler of the caller, invoked on completion of an operation
+    callback_handler_t caller_handler;
+    /// Context of the caller, provided to the callback handler
+    void * caller_context;
+    /// Hash sequences
+    optiga_crypt_hash_mux_sequence_t sequence[OPTIGA_CRYPT_HASH_MUX_MAX_SEQUENCES];
+    /// Data from host, which is sent for the hash update
+    hash_data_from_host_t update_data;
+    /// Data of the caller, which is taken once the buffer of the sequence is sent
+    const uint8_t * p_remaining_data;
+    /// Length of the data of the caller, which is taken once the buffer of the sequence is sent
+    uint32_t remaining_length;
+    /// Output buffer of the finalize, which is invoked once the buffer of the sequence is sent
+    uint8_t * p_hash_output;
+    /// Sequence of the ongoing operation
+    uint8_t current;
+    /// Step to be taken, once the ongoing command is completed
+    uint8_t next_step;
+    /// Indicates the ongoing operation finalizes the sequence
+    uint8_t finalizing;
+    /// Indicates an operation is ongoing
+    uint8_t ongoing;
+}optiga_crypt_hash_mux_t;
+
+/**
+ * \brief Initializes the hash multiplexer.
+ *
+ * \details
+ * Initializes the hash multiplexer and creates the crypt instance, which executes the operations of all the sequences.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ * - The hash multiplexer must be valid until #optiga_crypt_hash_mux_deinit is invoked.
+ *
+ * \param[in,out]  me                                       Pointer to hash multiplexer, must not be NULL.
+ * \param[in]      optiga_instance_id                       Indicates the OPTIGA instance, which executes the sequences.
+ * \param[in]      handler                                  Callback handler, invoked on completion of an operation.
+ * \param[in]      caller_context                           Context of the caller, provided to the callback handler.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR                      Creation of crypt instance failed.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_hash_mux_init(optiga_crypt_hash_mux_t * me,
+                                                               uint8_t optiga_instance_id,
+                                                               callback_handler_t handler,
+                                                               void * caller_context);
+
+/**
+ * \brief De-initializes the hash multiplexer.
+ *
+ * \details
+ * De-initializes the hash multiplexer, erases the buffered data of all the sequences and destroys the crypt instance.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in,out]  me                                       Pointer to hash multiplexer, must not be NULL.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      An operation is ongoing.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_hash_mux_deinit(optiga_crypt_hash_mux_t * me);
+
+/**
+ * \brief Starts a hash sequence of the hash multiplexer.
+ *
+ * \details
+ * Assigns a free sequence to the hash context and starts the hash sequence.
+ * - A sequence on host is calculated using the pal crypt library and never transfers the context over the interface.
+ * - A sequence in OPTIGA uses #optiga_crypt_hash_start, the context is exported to the context buffer.
+ * - The callback registered with #optiga_crypt_hash_mux_init gets invoked, when the operation is completed.
+ *
+ * \pre
+ * - The hash multiplexer must be initialized using #optiga_crypt_hash_mux_init.
+ *
+ * \note
+ * - A sequence on host requires #OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED. Refer #optiga_crypt_set_hash_offload.
+ * - The <b>context_buffer</b> of the hash context must not be NULL, since the context of each sequence is exported.
+ * - The hash context must be valid until the sequence is finalized or closed.
+ *
+ * \param[in,out]  me                                       Pointer to hash multiplexer, must not be NULL.
+ * \param[in,out]  hash_ctx                                 Pointer to #optiga_hash_context_t of the sequence, must not be NULL.
+ * \param[in]      on_host                                  TRUE to calculate the sequence on host, FALSE to calculate it in OPTIGA.
+ * \param[out]     p_sequence_id                            Identifier of the sequence, used for the further operations.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      An operation is ongoing.
+ * \retval         #OPTIGA_CRYPT_ERROR_MEMORY_INSUFFICIENT  All the sequences are in use.
+ * \retval         #OPTIGA_DEVICE_ERROR                     Command execution failure in OPTIGA and the LSB indicates the error code.
+ *                                                          (Refer Solution Reference Manual)
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_hash_mux_start(optiga_crypt_hash_mux_t * me,
+                                                                optiga_hash_context_t * hash_ctx,
+                                                                bool_t on_host,
+                                                                uint8_t * p_sequence_id);
+
+/**
+ * \brief Updates a hash sequence of the hash multiplexer with data from host.
+ *
+ * \details
+ * Updates the sequence with the data.
+ * - For a sequence in OPTIGA, the data is copied into the buffer of the sequence. The buffer is sent, once it is
+ *   filled up to #OPTIGA_CRYPT_HASH_MUX_BUFFER_SIZE or the sequence is finalized.
+ * - Hence the context of a sequence is imported to and exported from OPTIGA once per buffer, instead of once per update,
+ *   even if the updates of several sequences are interleaved.
+ * - The callback registered with #optiga_crypt_hash_mux_init gets invoked, when the operation is completed.
+ *
+ * \pre
+ * - The sequence must be started using #optiga_crypt_hash_mux_start.
+ *
+ * \note
+ * - If the data is hashed on host or buffered, the callback is invoked before the API returns.
+ * - The data must be valid until the callback is invoked.
+ * - The sequence is closed, if the operation fails.
+ *
+ * \param[in,out]  me                                       Pointer to hash multiplexer, must not be NULL.
+ * \param[in]      sequence_id                              Identifier of the sequence from #optiga_crypt_hash_mux_start.
+ * \param[in]      data                                     Pointer to the data to be hashed, must not be NULL.
+ * \param[in]      data_length                              Length of the data.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      An operation is ongoing.
+ * \retval         #OPTIGA_DEVICE_ERROR                     Command execution failure in OPTIGA and the LSB indicates the error code.
+ *                                                          (Refer Solution Reference Manual)
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_hash_mux_update(optiga_crypt_hash_mux_t * me,
+                                                                 uint8_t sequence_id,
+                                                                 const uint8_t * data,
+                                                                 uint32_t data_length);
+
+/**
+ * \brief Finalizes a hash sequence of the hash multiplexer.
+ *
+ * \details
+ * Sends the buffered data of the sequence, finalizes the sequence and releases it.
+ * - The callback registered with #optiga_crypt_hash_mux_init gets invoked, when the operation is completed.
+ *
+ * \pre
+ * - The sequence must be started using #optiga_crypt_hash_mux_start.
+ *
+ * \note
+ * - If the digest is calculated on host, the callback is invoked before the API returns.
+ * - The sequence is released, irrespective of the result of the operation.
+ *
+ * \param[in,out]  me                                       Pointer to hash multiplexer, must not be NULL.
+ * \param[in]      sequence_id                              Identifier of the sequence from #optiga_crypt_hash_mux_start.
+ * \param[out]     hash_output                              Pointer to buffer to store the digest, must not be NULL.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      An operation is ongoing.
+ * \retval         #OPTIGA_DEVICE_ERROR                     Command execution failure in OPTIGA and the LSB indicates the error code.
+ *                                                          (Refer Solution Reference Manual)
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_hash_mux_finalize(optiga_crypt_hash_mux_t * me,
+                                                                   uint8_t sequence_id,
+                                                                   uint8_t * hash_output);
+
+/**
+ * \brief Closes a hash sequence of the hash multiplexer without finalizing it.
+ *
+ * \details
+ * Erases the buffered data of the sequence and releases it, for example if the connection of a transcript is closed.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in,out]  me                                       Pointer to hash multiplexer, must not be NULL.
+ * \param[in]      sequence_id                              Identifier of the sequence from #optiga_crypt_hash_mux_start.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      An operation of the sequence is ongoing.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_hash_mux_close(optiga_crypt_hash_mux_t * me,
+                                                                uint8_t sequence_id);
+
+#endif //OPTIGA_CRYPT_HASH_MUX_ENABLED
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_OPTIGA_CRYPT_HASH_MUX_H_*/
+
+/**
+* @}
+*/
@@ -0,0 +1,214 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_crypt_key_pool.h
+*
+* \brief   This file implements the prototype declarations of OPTIGA Crypt key pool, which pregenerates persistent keypairs in reserved key OIDs.
+*
+* \ingroup  grOptigaCrypt
+*
+* @{
+*/
+
+#ifndef _OPTIGA_CRYPT_KEY_POOL_H_
+#define _OPTIGA_CRYPT_KEY_POOL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "optiga/optiga_crypt.h"
+
+#ifdef OPTIGA_CRYPT_KEY_POOL_ENABLED
+
+#ifdef OPTIGA_CRYPT_RSA_GENERATE_KEYPAIR_ENABLED
+/// Maximum length of the public key (DER BIT STRING of the RSA public key) for RSA 2048
+#define OPTIGA_CRYPT_KEY_POOL_MAX_PUBLIC_KEY_LENGTH                 (0x114)
+#else
+/// Maximum length of the public key (DER BIT STRING of the uncompressed point) for ECC NIST P521
+#define OPTIGA_CRYPT_KEY_POOL_MAX_PUBLIC_KEY_LENGTH                 (0x8A)
+#endif
+
+/** \brief Entry of the key pool, which holds one key OID */
+typedef struct optiga_crypt_key_pool_entry
+{
+    /// Public key of the keypair
+    uint8_t public_key[OPTIGA_CRYPT_KEY_POOL_MAX_PUBLIC_KEY_LENGTH];
+    /// Length of the public key
+    uint16_t public_key_length;
+    /// Key OID, which holds the private key
+    uint16_t key_oid;
+    /// State of the entry (empty, generating, ready or assigned)
+    uint8_t state;
+}optiga_crypt_key_pool_entry_t;
+
+/** \brief OPTIGA crypt key pool structure */
+typedef struct optiga_crypt_key_pool
+{
+    /// Entries of the pool
+    optiga_crypt_key_pool_entry_t entries[OPTIGA_CRYPT_KEY_POOL_SIZE];
+    /// Crypt instance, which generates the keypairs
+    optiga_crypt_t * p_crypt;
+    /// Number of entries (key OIDs) of the pool
+    uint8_t entry_count;
+    /// Number of keypairs to be kept ready
+    uint8_t ready_count;
+    /// ECC curve (#optiga_ecc_curve_t) or RSA key type (#optiga_rsa_key_type_t) of the keypairs
+    uint8_t key_type;
+    /// Key usage of the keypairs
+    uint8_t key_usage;
+    /// TRUE, if the last generation failed. It is retried with the next acquire or release.
+    bool_t refill_failed;
+}optiga_crypt_key_pool_t;
+
+/**
+ * \brief Initializes the key pool and starts the generation of the keypairs.
+ *
+ * \details
+ * Initializes the key pool with the reserved key OIDs and starts the generation of the keypairs.
+ * - Creates one crypt instance with #OPTIGA_LIB_PRIORITY_LOW, hence the keypairs are generated one after the other
+ *   when no other request is waiting in the command queue.
+ * - Keeps ready_count keypairs generated, the public keys are exported and kept in the pool.
+ *   The remaining key OIDs are used to refill the pool, once keypairs are acquired.
+ *
+ * \pre
+ * - The application on OPTIGA must be opened using #optiga_util_open_application.
+ *
+ * \note
+ * - This API is implemented in synchronous mode, the generation of keypairs is asynchronous.
+ * - The key OIDs are overwritten with fresh keypairs, hence they must not hold keys in use (e.g. 0xE0F0).
+ *   ECC keys are generated into 0xE0F1 - 0xE0F3, RSA keys into 0xE0FC - 0xE0FD.
+ * - The state of the pool is kept in RAM only. After a restart, the pool is initialized again with the key OIDs,
+ *   which are not assigned.
+ *
+ * \param[in,out]  me                                       Pointer to key pool, must not be NULL.
+ * \param[in]      optiga_instance_id                       Indicates the OPTIGA instance in which the keypairs are generated.
+ * \param[in]      key_type                                 ECC curve (#optiga_ecc_curve_t) or RSA key type (#optiga_rsa_key_type_t).
+ * \param[in]      key_usage                                Key usage of the keypairs, value of #optiga_key_usage_t.
+ * \param[in]      p_key_oids                               Key OIDs reserved for the pool, must not be NULL.
+ * \param[in]      key_oid_count                            Number of key OIDs, up to #OPTIGA_CRYPT_KEY_POOL_SIZE.
+ * \param[in]      ready_count                              Number of keypairs to be kept ready, up to key_oid_count.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR                      Creation of crypt instance failed.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_key_pool_init(optiga_crypt_key_pool_t * me,
+                                                               uint8_t optiga_instance_id,
+                                                               uint8_t key_type,
+                                                               uint8_t key_usage,
+                                                               const uint16_t * p_key_oids,
+                                                               uint8_t key_oid_count,
+                                                               uint8_t ready_count);
+
+/**
+ * \brief De-initializes the key pool.
+ *
+ * \details
+ * De-initializes the key pool and destroys the crypt instance.
+ * - The keypairs remain in the key OIDs.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in,out]  me                                       Pointer to key pool, must not be NULL.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      A keypair is being generated.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_key_pool_deinit(optiga_crypt_key_pool_t * me);
+
+/**
+ * \brief Assigns a pregenerated keypair of the key pool.
+ *
+ * \details
+ * Assigns a ready keypair, without any command to OPTIGA, and starts the refill of the pool.
+ * - Returns the key OID, which holds the private key, and the public key.
+ * - The key OID is not used by the pool anymore, until it is released using #optiga_crypt_key_pool_release.
+ * - The generation of keypairs, which failed earlier, is retried.
+ *
+ * \pre
+ * - The pool must be initialized using #optiga_crypt_key_pool_init.
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ * - The caller typically updates the metadata of the key OID afterwards (e.g. the lifecycle state or the access conditions).
+ * - If no keypair is ready, #OPTIGA_CRYPT_ERROR is returned. The caller can generate the keypair on its own instead.
+ *
+ * \param[in,out]  me                                       Pointer to key pool, must not be NULL.
+ * \param[out]     p_key_oid                                Pointer to store the key OID, must not be NULL.
+ * \param[out]     p_public_key                             Buffer to store the public key, must not be NULL.
+ * \param[in,out]  p_public_key_length                      Length of the buffer, updated with the length of the public key.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_MEMORY_INSUFFICIENT  Buffer of the public key is too small.
+ * \retval         #OPTIGA_CRYPT_ERROR                      No keypair is ready.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_key_pool_acquire(optiga_crypt_key_pool_t * me,
+                                                                  uint16_t * p_key_oid,
+                                                                  uint8_t * p_public_key,
+                                                                  uint16_t * p_public_key_length);
+
+/**
+ * \brief Returns an assigned key OID to the key pool.
+ *
+ * \details
+ * Returns the key OID assigned using #optiga_crypt_key_pool_acquire, e.g. once the key of a tenant is revoked.
+ * - The keypair is not handed out again, a fresh keypair is generated into the key OID when the pool is refilled.
+ *
+ * \pre
+ * - The metadata of the key OID must still allow the key generation.
+ *
+ * \note
+ * - This API is implemented in synchronous mode, the generation of the keypair is asynchronous.
+ *
+ * \param[in,out]  me                                       Pointer to key pool, must not be NULL.
+ * \param[in]      key_oid                                  Key OID returned by #optiga_crypt_key_pool_acquire.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_key_pool_release(optiga_crypt_key_pool_t * me,
+                                                                  uint16_t key_oid);
+
+#endif //OPTIGA_CRYPT_KEY_POOL_ENABLED
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_OPTIGA_CRYPT_KEY_POOL_H_*/
+
+/**
+* @}
+*/
@@ -0,0 +1,201 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_crypt_keypair_cache.h
+*
+* \brief   This file implements the prototype declarations of OPTIGA Crypt keypair cache, which pregenerates ephemeral ECC keypairs in session contexts.
+*
+* \ingroup  grOptigaCrypt
+*
+* @{
+*/
+
+#ifndef _OPTIGA_CRYPT_KEYPAIR_CACHE_H_
+#define _OPTIGA_CRYPT_KEYPAIR_CACHE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "optiga/optiga_crypt.h"
+
+#ifdef OPTIGA_CRYPT_KEYPAIR_CACHE_ENABLED
+
+/// Maximum length of the public key (DER BIT STRING of the uncompressed point) for ECC NIST P521
+#define OPTIGA_CRYPT_KEYPAIR_CACHE_MAX_PUBLIC_KEY_LENGTH            (0x8A)
+
+/** \brief Entry of the keypair cache, which holds one ephemeral keypair in the session context of its crypt instance */
+typedef struct optiga_crypt_keypair_cache_entry
+{
+    /// Crypt instance, which holds the session context with the private key
+    optiga_crypt_t * p_crypt;
+    /// Keypair cache which owns the entry
+    void * p_cache;
+    /// Callback handler of the caller, which acquired the entry
+    callback_handler_t caller_handler;
+    /// Context of the caller, which acquired the entry
+    void * caller_context;
+    /// Public key of the keypair
+    uint8_t public_key[OPTIGA_CRYPT_KEYPAIR_CACHE_MAX_PUBLIC_KEY_LENGTH];
+    /// Length of the public key
+    uint16_t public_key_length;
+    /// State of the entry (empty, generating, ready or in use)
+    uint8_t state;
+}optiga_crypt_keypair_cache_entry_t;
+
+/** \brief OPTIGA crypt keypair cache structure */
+typedef struct optiga_crypt_keypair_cache
+{
+    /// Entries of the cache
+    optiga_crypt_keypair_cache_entry_t entries[OPTIGA_CRYPT_KEYPAIR_CACHE_SIZE];
+    /// Curve of the keypairs
+    optiga_ecc_curve_t curve_id;
+    /// Key usage of the keypairs
+    uint8_t key_usage;
+}optiga_crypt_keypair_cache_t;
+
+/**
+ * \brief Initializes the keypair cache and starts the generation of the keypairs.
+ *
+ * \details
+ * Initializes the keypair cache and starts the generation of the keypairs.
+ * - Creates one crypt instance with #OPTIGA_LIB_PRIORITY_LOW per entry, hence the keypairs are generated
+ *   when no other request is waiting in the command queue.
+ * - Each entry acquires one session context (#OPTIGA_KEY_ID_SESSION_BASED) of OPTIGA, which holds the private key.
+ *
+ * \pre
+ * - The application on OPTIGA must be opened using #optiga_util_open_application.
+ *
+ * \note
+ * - This API is implemented in synchronous mode, the generation of keypairs is asynchronous.
+ * - #OPTIGA_CRYPT_KEYPAIR_CACHE_SIZE session contexts are kept acquired by the cache, until #optiga_crypt_keypair_cache_deinit.
+ *   The remaining session contexts are available for other instances.
+ *
+ * \param[in,out]  me                                       Pointer to keypair cache, must not be NULL.
+ * \param[in]      optiga_instance_id                       Indicates the OPTIGA instance in which the keypairs are generated.
+ * \param[in]      curve_id                                 ECC curve of the keypairs, value of #optiga_ecc_curve_t.
+ * \param[in]      key_usage                                Key usage of the keypairs, value of #optiga_key_usage_t.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR                      Creation of crypt instance failed.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_keypair_cache_init(optiga_crypt_keypair_cache_t * me,
+                                                                    uint8_t optiga_instance_id,
+                                                                    optiga_ecc_curve_t curve_id,
+                                                                    uint8_t key_usage);
+
+/**
+ * \brief De-initializes the keypair cache.
+ *
+ * \details
+ * De-initializes the keypair cache, destroys the crypt instances and hence releases the session contexts.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in,out]  me                                       Pointer to keypair cache, must not be NULL.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      A keypair is being generated or an entry is acquired.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_keypair_cache_deinit(optiga_crypt_keypair_cache_t * me);
+
+/**
+ * \brief Acquires a pregenerated keypair from the keypair cache.
+ *
+ * \details
+ * Acquires a pregenerated keypair, without any command to OPTIGA.
+ * - Returns the crypt instance, which holds the private key in its session context, and the public key.
+ * - The private key is used with the returned crypt instance and #OPTIGA_KEY_ID_SESSION_BASED (e.g. #optiga_crypt_ecdh).
+ * - The callback handler provided here is invoked, on completion of the operations with the returned crypt instance.
+ * - The generation of keypairs, which failed earlier, is retried.
+ *
+ * \pre
+ * - The cache must be initialized using #optiga_crypt_keypair_cache_init.
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ * - Each keypair is handed out only once. Release the crypt instance using #optiga_crypt_keypair_cache_release,
+ *   which generates a fresh keypair into the session context.
+ * - If no keypair is ready, NULL is returned. The caller can use #optiga_crypt_ecc_generate_keypair instead.
+ *
+ * \param[in,out]  me                                       Pointer to keypair cache, must not be NULL.
+ * \param[in]      handler                                  Callback handler for the operations with the returned crypt instance.
+ * \param[in]      caller_context                           Context of the caller, provided to the callback handler.
+ * \param[out]     pp_public_key                            Pointer to store the pointer to the public key, must not be NULL.
+ *                                                          - The public key is valid until the crypt instance is released.
+ * \param[out]     p_public_key_length                      Pointer to store the length of the public key, must not be NULL.
+ *
+ * \retval         #optiga_crypt_t *                         Crypt instance, which holds the private key.
+ * \retval         NULL                                     No keypair is ready or wrong input arguments provided.
+ */
+LIBRARY_EXPORTS optiga_crypt_t * optiga_crypt_keypair_cache_acquire(optiga_crypt_keypair_cache_t * me,
+                                                                    callback_handler_t handler,
+                                                                    void * caller_context,
+                                                                    const uint8_t ** pp_public_key,
+                                                                    uint16_t * p_public_key_length);
+
+/**
+ * \brief Releases an acquired keypair and starts the generation of a fresh keypair.
+ *
+ * \details
+ * Releases the crypt instance acquired using #optiga_crypt_keypair_cache_acquire.
+ * - The keypair is not handed out again, a fresh keypair is generated into the session context.
+ *
+ * \pre
+ * - The operations with the crypt instance must be completed.
+ *
+ * \note
+ * - This API is implemented in synchronous mode, the generation of the keypair is asynchronous.
+ *
+ * \param[in,out]  me                                       Pointer to keypair cache, must not be NULL.
+ * \param[in]      p_crypt                                  Crypt instance returned by #optiga_crypt_keypair_cache_acquire.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      The operation with the crypt instance is not complete.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_keypair_cache_release(optiga_crypt_keypair_cache_t * me,
+                                                                       optiga_crypt_t * p_crypt);
+
+#endif //OPTIGA_CRYPT_KEYPAIR_CACHE_ENABLED
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_OPTIGA_CRYPT_KEYPAIR_CACHE_H_*/
+
+/**
+* @}
+*/
@@ -0,0 +1,189 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_crypt_random_pool.h
+*
+* \brief   This file implements the prototype declarations of OPTIGA Crypt random pool, which serves random bytes prefetched from OPTIGA.
+*
+* \ingroup  grOptigaCrypt
+*
+* @{
+*/
+
+#ifndef _OPTIGA_CRYPT_RANDOM_POOL_H_
+#define _OPTIGA_CRYPT_RANDOM_POOL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "optiga/optiga_crypt.h"
+
+#ifdef OPTIGA_CRYPT_RANDOM_POOL_ENABLED
+
+/** \brief OPTIGA crypt random pool structure */
+typedef struct optiga_crypt_random_pool
+{
+    /// Crypt instance, which refills the pool
+    optiga_crypt_t * p_crypt;
+    /// Random bytes, which are not yet served
+    uint8_t pool[OPTIGA_CRYPT_RANDOM_POOL_SIZE];
+    /// Buffer to receive the random bytes of the ongoing refill
+    uint8_t refill_buffer[OPTIGA_CRYPT_RANDOM_POOL_REFILL_SIZE];
+    /// Number of random bytes available in the pool
+    uint16_t available;
+    /// Refill is started, once the available bytes are less than this
+    uint16_t low_water_mark;
+    /// Type of random number generator used for the refill
+    optiga_rng_type_t rng_type;
+    /// Indicates a refill is ongoing
+    uint8_t refill_ongoing;
+    /// Indicates the random bytes of the ongoing refill are discarded on completion
+    uint8_t refill_discarded;
+}optiga_crypt_random_pool_t;
+
+/**
+ * \brief Initializes the random pool and starts filling it.
+ *
+ * \details
+ * Initializes the random pool and starts filling it.
+ * - Creates a crypt instance with #OPTIGA_LIB_PRIORITY_LOW for the pool, hence the refills are executed
+ *   when no other request is waiting in the command queue.
+ * - The pool is refilled in steps of #OPTIGA_CRYPT_RANDOM_POOL_REFILL_SIZE, until it is full.
+ * - A refill is started again, once the available bytes are less than the low water mark.
+ *
+ * <b>Security</b><br>
+ * - The random bytes are generated by OPTIGA and served as they are, no derivation is done on host.
+ * - Every byte is served only once. Served bytes are erased from the pool, hence a later read of the host memory
+ *   does not reveal any random bytes served earlier (backtracking resistance).
+ * - The bytes, which are not yet served, are kept in host memory. A read of the host memory reveals the next
+ *   random bytes to be served, up to #OPTIGA_CRYPT_RANDOM_POOL_SIZE (no prediction resistance for pooled bytes).
+ * - Use #optiga_crypt_random_pool_flush to discard the pooled bytes, or #optiga_crypt_random directly,
+ *   where the random bytes must be generated right at the time of the request (e.g. long-term keys).
+ *
+ * \pre
+ * - The application on OPTIGA must be opened using #optiga_util_open_application.
+ *
+ * \note
+ * - This API is implemented in synchronous mode, the refills are asynchronous.
+ * - The pool instance must be valid until #optiga_crypt_random_pool_deinit is invoked.
+ *
+ * \param[in,out]  me                                       Pointer to random pool, must not be NULL.
+ * \param[in]      optiga_instance_id                       Indicates the OPTIGA instance from which the random bytes are fetched.
+ * \param[in]      rng_type                                 Type of random number generator, value of #optiga_rng_type_t.
+ * \param[in]      low_water_mark                           Refill is started, once the available bytes are less than this.
+ *                                                          - Must not be greater than #OPTIGA_CRYPT_RANDOM_POOL_SIZE.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR                      Creation of crypt instance failed.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_random_pool_init(optiga_crypt_random_pool_t * me,
+                                                                  uint8_t optiga_instance_id,
+                                                                  optiga_rng_type_t rng_type,
+                                                                  uint16_t low_water_mark);
+
+/**
+ * \brief De-initializes the random pool.
+ *
+ * \details
+ * De-initializes the random pool, erases the pooled bytes and destroys the crypt instance.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in,out]  me                                       Pointer to random pool, must not be NULL.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      A refill is ongoing.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_random_pool_deinit(optiga_crypt_random_pool_t * me);
+
+/**
+ * \brief Serves random bytes from the random pool.
+ *
+ * \details
+ * Serves random bytes from the random pool, without any command to OPTIGA.
+ * - The served bytes are erased from the pool.
+ * - Starts a refill, if the available bytes are less than the low water mark.
+ *
+ * \pre
+ * - The pool must be initialized using #optiga_crypt_random_pool_init.
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ * - Unlike #optiga_crypt_random, there is no minimum length.
+ * - If not enough bytes are available, nothing is served. The caller can use #optiga_crypt_random instead.
+ *
+ * \param[in,out]  me                                       Pointer to random pool, must not be NULL.
+ * \param[out]     p_random                                 Pointer to the buffer to store the random bytes, must not be NULL.
+ * \param[in]      length                                   Number of random bytes, must not be 0.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_MEMORY_INSUFFICIENT  Not enough random bytes available in the pool.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_random_pool_get(optiga_crypt_random_pool_t * me,
+                                                                 uint8_t * p_random,
+                                                                 uint16_t length);
+
+/**
+ * \brief Discards the random bytes of the random pool.
+ *
+ * \details
+ * Discards (erases) the random bytes, which are not yet served, and the bytes of the ongoing refill.
+ * - The pool is filled again with random bytes generated after this call, starting with the next #optiga_crypt_random_pool_get.
+ *
+ * \pre
+ * - The pool must be initialized using #optiga_crypt_random_pool_init.
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in,out]  me                                       Pointer to random pool, must not be NULL.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_random_pool_flush(optiga_crypt_random_pool_t * me);
+
+#endif //OPTIGA_CRYPT_RANDOM_POOL_ENABLED
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_OPTIGA_CRYPT_RANDOM_POOL_H_*/
+
+/**
+* @}
+*/
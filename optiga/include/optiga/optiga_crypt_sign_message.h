@@ -0,0 +1,264 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_crypt_sign_message.h
+*
+* \brief   This file implements the prototype declarations of OPTIGA Crypt sign message, which hashes messages of arbitrary length on host and signs the digests with OPTIGA.
+*
+* \ingroup  grOptigaCrypt
+*
+* @{
+*/
+
+#ifndef _OPTIGA_CRYPT_SIGN_MESSAGE_H_
+#define _OPTIGA_CRYPT_SIGN_MESSAGE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "optiga/optiga_crypt.h"
+
+#ifdef OPTIGA_CRYPT_SIGN_MESSAGE_ENABLED
+
+/// Length of the digest of a message (SHA256)
+#define OPTIGA_CRYPT_SIGN_MESSAGE_DIGEST_LENGTH     (32)
+
+/**
+ * \brief Reads the next part of the message.
+ *
+ * \details
+ * Reads up to the requested number of bytes from the current position of the message, e.g. using read() on a
+ * file descriptor.
+ *
+ * \param[in]      p_io_ctx                                 Context provided with the message.
+ * \param[out]     p_buffer                                 Buffer to store the bytes.
+ * \param[in]      length                                   Size of the buffer.
+ * \param[out]     p_read_length                            Number of bytes stored, 0 at the end of the message.
+ *
+ * \retval         #OPTIGA_LIB_SUCCESS                      The bytes are read, any other value aborts the message.
+ */
+typedef optiga_lib_status_t (* optiga_crypt_sign_message_reader_t)(void * p_io_ctx,
+                                                                    uint8_t * p_buffer,
+                                                                    uint16_t length,
+                                                                    uint16_t * p_read_length);
+
+/** \brief Message to be signed, provided by the caller and queued until it is signed by OPTIGA */
+typedef struct optiga_crypt_sign_message_request
+{
+    /// Digest of the message, calculated on host
+    uint8_t digest[OPTIGA_CRYPT_SIGN_MESSAGE_DIGEST_LENGTH];
+    /// Private key OID
+    optiga_key_id_t private_key;
+    /// Buffer to store the signature
+    uint8_t * signature;
+    /// Length of the signature buffer, updated with the length of the signature
+    uint16_t * signature_length;
+    /// Callback handler of the message, invoked once the message is signed
+    callback_handler_t handler;
+    /// Caller context of the message, provided to the callback handler
+    void * caller_context;
+    /// Next message to be signed
+    struct optiga_crypt_sign_message_request * p_next;
+    /// RSA signature scheme, only for RSA signatures
+    optiga_rsa_signature_scheme_t rsa_signature_scheme;
+    /// Indicates the message is signed with RSA
+    uint8_t rsa;
+}optiga_crypt_sign_message_request_t;
+
+/** \brief OPTIGA crypt sign message structure */
+typedef struct optiga_crypt_sign_message
+{
+    /// Crypt instance, which signs the digests
+    optiga_crypt_t * p_crypt;
+    /// Message signed by OPTIGA
+    optiga_crypt_sign_message_request_t * p_current;
+    /// First hashed message waiting for OPTIGA
+    optiga_crypt_sign_message_request_t * p_queue_head;
+    /// Last hashed message waiting for OPTIGA
+    optiga_crypt_sign_message_request_t * p_queue_tail;
+}optiga_crypt_sign_message_t;
+
+/**
+ * \brief Initializes the sign message instance.
+ *
+ * \details
+ * Initializes the sign message instance and creates the crypt instance, which signs the digests.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ * - The sign message instance must be valid until #optiga_crypt_sign_message_deinit is invoked.
+ *
+ * \param[in,out]  me                                       Pointer to sign message instance, must not be NULL.
+ * \param[in]      optiga_instance_id                       Indicates the OPTIGA instance, which signs the digests.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR                      Creation of crypt instance failed.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_sign_message_init(optiga_crypt_sign_message_t * me,
+                                                                   uint8_t optiga_instance_id);
+
+/**
+ * \brief De-initializes the sign message instance.
+ *
+ * \details
+ * De-initializes the sign message instance and destroys the crypt instance.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in,out]  me                                       Pointer to sign message instance, must not be NULL.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      A message is not yet signed.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_sign_message_deinit(optiga_crypt_sign_message_t * me);
+
+#ifdef OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
+/**
+ * \brief Signs a message of arbitrary length using ECDSA with the private key from OPTIGA.
+ *
+ * \details
+ * Calculates the SHA256 digest of the message on host using the pal crypt library and signs it using #optiga_crypt_ecdsa_sign.
+ * - The message is hashed from the buffer (e.g. a memory mapped file) in one step, or read in chunks of
+ *   #OPTIGA_CRYPT_SIGN_MESSAGE_CHUNK_SIZE using the reader, if the buffer is NULL.
+ * - The message is hashed before this API returns, without waiting for OPTIGA. If OPTIGA signs another message, the
+ *   digest is queued and signed on completion of that message. Hence the next message is hashed while OPTIGA signs
+ *   the current one.
+ * - The callback handler of the message gets invoked, once the message is signed.
+ *
+ * \pre
+ * - The sign message instance must be initialized using #optiga_crypt_sign_message_init.
+ * - The private key must be available at private key OID in OPTIGA.
+ *
+ * \note
+ * - This API is asynchronous. The callback handler is not invoked, if this API returns an error.
+ * - The reader is invoked from the context of the caller. Messages may be hashed from several threads at the same time.
+ * - The request, the signature buffer and the signature length must be valid until the callback is invoked.
+ *   The message and the reader are not used anymore, once this API returns.
+ * - The signature format is the same as #optiga_crypt_ecdsa_sign.
+ *
+ * \param[in,out]  me                                       Pointer to sign message instance, must not be NULL.
+ * \param[in,out]  p_request                                Request of the message, must not be NULL.
+ * \param[in]      message                                  Pointer to the message, NULL to use the reader.
+ * \param[in]      message_length                           Length of the message, if the message is a buffer.
+ * \param[in]      reader                                   Reads the message, if message is NULL.
+ * \param[in]      p_io_ctx                                 Context provided to the reader.
+ * \param[in]      private_key                              Private key OID in OPTIGA.
+ * \param[in,out]  signature                                Pointer to buffer to store the signature.
+ * \param[in,out]  signature_length                         Length of the signature buffer, updated with the length of the signature.
+ * \param[in]      handler                                  Callback handler, invoked once the message is signed.
+ * \param[in]      caller_context                           Context of the caller, provided to the callback handler.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR                      Hashing of the message failed or aborted by the reader.
+ * \retval         #OPTIGA_DEVICE_ERROR                     Command execution failure in OPTIGA and the LSB indicates the error code.
+ *                                                          (Refer Solution Reference Manual)
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_sign_message_ecdsa(optiga_crypt_sign_message_t * me,
+                                                                    optiga_crypt_sign_message_request_t * p_request,
+                                                                    const uint8_t * message,
+                                                                    uint32_t message_length,
+                                                                    optiga_crypt_sign_message_reader_t reader,
+                                                                    void * p_io_ctx,
+                                                                    optiga_key_id_t private_key,
+                                                                    uint8_t * signature,
+                                                                    uint16_t * signature_length,
+                                                                    callback_handler_t handler,
+                                                                    void * caller_context);
+#endif //OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
+
+#ifdef OPTIGA_CRYPT_RSA_SIGN_ENABLED
+/**
+ * \brief Signs a message of arbitrary length using RSA with the private key from OPTIGA.
+ *
+ * \details
+ * Calculates the SHA256 digest of the message on host and signs it using #optiga_crypt_rsa_sign,
+ * the same as #optiga_crypt_sign_message_ecdsa.
+ *
+ * \pre
+ * - The sign message instance must be initialized using #optiga_crypt_sign_message_init.
+ * - The private key must be available at private key OID in OPTIGA.
+ *
+ * \note
+ * - Only #OPTIGA_RSASSA_PKCS1_V15_SHA256 is supported, since the digest is calculated with SHA256.
+ * - Refer #optiga_crypt_sign_message_ecdsa.
+ *
+ * \param[in,out]  me                                       Pointer to sign message instance, must not be NULL.
+ * \param[in,out]  p_request                                Request of the message, must not be NULL.
+ * \param[in]      signature_scheme                         RSA signature scheme.
+ * \param[in]      message                                  Pointer to the message, NULL to use the reader.
+ * \param[in]      message_length                           Length of the message, if the message is a buffer.
+ * \param[in]      reader                                   Reads the message, if message is NULL.
+ * \param[in]      p_io_ctx                                 Context provided to the reader.
+ * \param[in]      private_key                              Private key OID in OPTIGA.
+ * \param[in,out]  signature                                Pointer to buffer to store the signature.
+ * \param[in,out]  signature_length                         Length of the signature buffer, updated with the length of the signature.
+ * \param[in]      handler                                  Callback handler, invoked once the message is signed.
+ * \param[in]      caller_context                           Context of the caller, provided to the callback handler.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR                      Hashing of the message failed or aborted by the reader.
+ * \retval         #OPTIGA_DEVICE_ERROR                     Command execution failure in OPTIGA and the LSB indicates the error code.
+ *                                                          (Refer Solution Reference Manual)
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_sign_message_rsa(optiga_crypt_sign_message_t * me,
+                                                                  optiga_crypt_sign_message_request_t * p_request,
+                                                                  optiga_rsa_signature_scheme_t signature_scheme,
+                                                                  const uint8_t * message,
+                                                                  uint32_t message_length,
+                                                                  optiga_crypt_sign_message_reader_t reader,
+                                                                  void * p_io_ctx,
+                                                                  optiga_key_id_t private_key,
+                                                                  uint8_t * signature,
+                                                                  uint16_t * signature_length,
+                                                                  callback_handler_t handler,
+                                                                  void * caller_context);
+#endif //OPTIGA_CRYPT_RSA_SIGN_ENABLED
+
+#endif //OPTIGA_CRYPT_SIGN_MESSAGE_ENABLED
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_OPTIGA_CRYPT_SIGN_MESSAGE_H_*/
+
+/**
+* @}
+*/
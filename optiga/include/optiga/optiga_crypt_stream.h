@@ -0,0 +1,296 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_crypt_stream.h
+*
+* \brief   This file implements the prototype declarations of OPTIGA Crypt stream, which encrypts and decrypts data of arbitrary length with the symmetric key of OPTIGA.
+*
+* \ingroup  grOptigaCrypt
+*
+* @{
+*/
+
+#ifndef _OPTIGA_CRYPT_STREAM_H_
+#define _OPTIGA_CRYPT_STREAM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "optiga/optiga_crypt.h"
+
+#ifdef OPTIGA_CRYPT_STREAM_ENABLED
+
+/**
+ * \brief Reads the input of the stream.
+ *
+ * \details
+ * Must copy exactly the requested number of bytes from the offset of the input to the buffer.
+ *
+ * \param[in]      p_io_ctx                                 Context provided to #optiga_crypt_stream_encrypt or #optiga_crypt_stream_decrypt.
+ * \param[in]      offset                                   Offset of the bytes in the input.
+ * \param[out]     p_buffer                                 Buffer to store the bytes.
+ * \param[in]      length                                   Number of bytes to be read.
+ *
+ * \retval         #OPTIGA_LIB_SUCCESS                      The bytes are read, any other value aborts the stream.
+ */
+typedef optiga_lib_status_t (* optiga_crypt_stream_reader_t)(void * p_io_ctx,
+                                                              uint32_t offset,
+                                                              uint8_t * p_buffer,
+                                                              uint16_t length);
+
+/**
+ * \brief Writes the output of the stream.
+ *
+ * \details
+ * Receives the encrypted or decrypted bytes of a chunk, in the order of the input.
+ *
+ * \param[in]      p_io_ctx                                 Context provided to #optiga_crypt_stream_encrypt or #optiga_crypt_stream_decrypt.
+ * \param[in]      offset                                   Offset of the bytes in the output.
+ * \param[in]      p_data                                   Encrypted or decrypted bytes, valid only during the call.
+ * \param[in]      length                                   Number of bytes.
+ *
+ * \retval         #OPTIGA_LIB_SUCCESS                      The bytes are written, any other value aborts the stream.
+ */
+typedef optiga_lib_status_t (* optiga_crypt_stream_writer_t)(void * p_io_ctx,
+                                                              uint32_t offset,
+                                                              const uint8_t * p_data,
+                                                              uint16_t length);
+
+/** \brief OPTIGA crypt stream structure */
+typedef struct optiga_crypt_stream
+{
+    /// Crypt instance, which executes the chunks of the stream
+    optiga_crypt_t * p_crypt;
+    /// Callback handler of the caller, invoked on completion of the stream
+    callback_handler_t caller_handler;
+    /// Context of the caller, provided to the callback handler
+    void * caller_context;
+    /// Reads the input, NULL if the input is a buffer
+    optiga_crypt_stream_reader_t reader;
+    /// Writes the output, NULL if the output is a buffer
+    optiga_crypt_stream_writer_t writer;
+    /// Context provided to the reader and writer
+    void * p_io_ctx;
+    /// Input buffer, if no reader is provided
+    const uint8_t * p_input;
+    /// Output buffer, if no writer is provided
+    uint8_t * p_output;
+    /// IV of the stream, used by the first chunk
+    const uint8_t * p_iv;
+    /// Chunks read from the input, the next chunk is read while the current one is executed by OPTIGA
+    uint8_t in_buffer[2][OPTIGA_CRYPT_STREAM_CHUNK_SIZE];
+    /// Output of the chunks, the output of a chunk is written while the next one is executed by OPTIGA
+    uint8_t out_buffer[2][OPTIGA_CRYPT_STREAM_CHUNK_SIZE];
+    /// Length of the output of each chunk
+    uint32_t out_length[2];
+    /// Length of the input and the output
+    uint32_t total_length;
+    /// Offset of the next chunk to be executed
+    uint32_t submit_offset;
+    /// Offset of the chunk executed by OPTIGA
+    uint32_t current_offset;
+    /// Status, which aborts the stream on completion of the current chunk
+    optiga_lib_status_t abort_status;
+    /// Symmetric key OID
+    optiga_key_id_t symmetric_key_oid;
+    /// Length of the IV
+    uint16_t iv_length;
+    /// Length of the chunk executed by OPTIGA
+    uint16_t current_length;
+    /// Encryption mode
+    optiga_symmetric_encryption_mode_t encryption_mode;
+    /// Buffer index of the next chunk to be executed
+    uint8_t submit_index;
+    /// Indicates the stream decrypts the input
+    uint8_t decrypt;
+    /// Indicates the next chunk is read from the input
+    uint8_t next_prepared;
+    /// Indicates the current chunk is completed, while the next chunk is not yet read
+    uint8_t waiting;
+    /// Indicates a stream is ongoing
+    uint8_t ongoing;
+}optiga_crypt_stream_t;
+
+/**
+ * \brief Initializes the stream.
+ *
+ * \details
+ * Initializes the stream and creates the crypt instance, which executes the chunks of the streams.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ * - The stream must be valid until #optiga_crypt_stream_deinit is invoked.
+ *
+ * \param[in,out]  me                                       Pointer to stream, must not be NULL.
+ * \param[in]      optiga_instance_id                       Indicates the OPTIGA instance, which executes the streams.
+ * \param[in]      handler                                  Callback handler, invoked on completion of a stream.
+ * \param[in]      caller_context                           Context of the caller, provided to the callback handler.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR                      Creation of crypt instance failed.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_stream_init(optiga_crypt_stream_t * me,
+                                                             uint8_t optiga_instance_id,
+                                                             callback_handler_t handler,
+                                                             void * caller_context);
+
+/**
+ * \brief De-initializes the stream.
+ *
+ * \details
+ * De-initializes the stream, erases the chunks and destroys the crypt instance.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in,out]  me                                       Pointer to stream, must not be NULL.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      A stream is ongoing.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_stream_deinit(optiga_crypt_stream_t * me);
+
+#ifdef OPTIGA_CRYPT_SYM_ENCRYPT_ENABLED
+/**
+ * \brief Encrypts data of arbitrary length using the symmetric key from OPTIGA.
+ *
+ * \details
+ * Encrypts the input in chunks of #OPTIGA_CRYPT_STREAM_CHUNK_SIZE, using #optiga_crypt_symmetric_encrypt
+ * for a single chunk or #optiga_crypt_symmetric_encrypt_start, _continue and _final otherwise.
+ * - The input is read from the buffer, or using the reader, if the buffer is NULL.
+ * - The output is stored to the buffer, or delivered incrementally to the writer, if the buffer is NULL.
+ * - While a chunk is executed by OPTIGA, the next chunk is read and the output of the previous chunk is written.
+ * - The callback registered with #optiga_crypt_stream_init gets invoked, on completion of the stream or the first error.
+ *
+ * \pre
+ * - The stream must be initialized using #optiga_crypt_stream_init.
+ * - Symmetric key must be available at symmetric key OID in OPTIGA.
+ *
+ * \note
+ * - This API is asynchronous. The reader and writer are invoked from the callback context of the chunks,
+ *   except for the first chunk, which is read before this API returns.
+ * - Only #OPTIGA_SYMMETRIC_ECB and #OPTIGA_SYMMETRIC_CBC are supported. No padding is performed, hence
+ *   the total length must be block aligned.
+ * - The buffers, the IV and the context must be valid until the callback is invoked.
+ *
+ * \param[in,out]  me                                       Pointer to stream, must not be NULL.
+ * \param[in]      encryption_mode                          Symmetric encryption mode.
+ * \param[in]      symmetric_key_oid                        OPTIGA symmetric key OID.
+ * \param[in]      iv                                       Pointer to the IV, only for CBC mode.
+ * \param[in]      iv_length                                Length of the IV, only for CBC mode.
+ * \param[in]      plain_data                               Pointer to the data to be encrypted, NULL to use the reader.
+ * \param[in]      reader                                   Reads the data to be encrypted, if plain_data is NULL.
+ * \param[in]      plain_data_length                        Length of the data to be encrypted, must be block aligned and not 0.
+ * \param[out]     encrypted_data                           Pointer to buffer of plain_data_length to store encrypted data, NULL to use the writer.
+ * \param[in]      writer                                   Writes the encrypted data, if encrypted_data is NULL.
+ * \param[in]      p_io_ctx                                 Context provided to the reader and writer.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      A stream is ongoing.
+ * \retval         #OPTIGA_DEVICE_ERROR                     Command execution failure in OPTIGA and the LSB indicates the error code.
+ *                                                          (Refer Solution Reference Manual)
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_stream_encrypt(optiga_crypt_stream_t * me,
+                                                                optiga_symmetric_encryption_mode_t encryption_mode,
+                                                                optiga_key_id_t symmetric_key_oid,
+                                                                const uint8_t * iv,
+                                                                uint16_t iv_length,
+                                                                const uint8_t * plain_data,
+                                                                optiga_crypt_stream_reader_t reader,
+                                                                uint32_t plain_data_length,
+                                                                uint8_t * encrypted_data,
+                                                                optiga_crypt_stream_writer_t writer,
+                                                                void * p_io_ctx);
+#endif //OPTIGA_CRYPT_SYM_ENCRYPT_ENABLED
+
+#ifdef OPTIGA_CRYPT_SYM_DECRYPT_ENABLED
+/**
+ * \brief Decrypts data of arbitrary length using the symmetric key from OPTIGA.
+ *
+ * \details
+ * Decrypts the input in chunks of #OPTIGA_CRYPT_STREAM_CHUNK_SIZE, the same as #optiga_crypt_stream_encrypt.
+ *
+ * \pre
+ * - The stream must be initialized using #optiga_crypt_stream_init.
+ * - Symmetric key must be available at symmetric key OID in OPTIGA.
+ *
+ * \note
+ * - Refer #optiga_crypt_stream_encrypt.
+ *
+ * \param[in,out]  me                                       Pointer to stream, must not be NULL.
+ * \param[in]      encryption_mode                          Symmetric encryption mode.
+ * \param[in]      symmetric_key_oid                        OPTIGA symmetric key OID.
+ * \param[in]      iv                                       Pointer to the IV, only for CBC mode.
+ * \param[in]      iv_length                                Length of the IV, only for CBC mode.
+ * \param[in]      encrypted_data                           Pointer to the data to be decrypted, NULL to use the reader.
+ * \param[in]      reader                                   Reads the data to be decrypted, if encrypted_data is NULL.
+ * \param[in]      encrypted_data_length                    Length of the data to be decrypted, must be block aligned and not 0.
+ * \param[out]     plain_data                               Pointer to buffer of encrypted_data_length to store plain data, NULL to use the writer.
+ * \param[in]      writer                                   Writes the plain data, if plain_data is NULL.
+ * \param[in]      p_io_ctx                                 Context provided to the reader and writer.
+ *
+ * \retval         #OPTIGA_CRYPT_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_CRYPT_ERROR_INVALID_INPUT        Wrong Input arguments provided.
+ * \retval         #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE      A stream is ongoing.
+ * \retval         #OPTIGA_DEVICE_ERROR                     Command execution failure in OPTIGA and the LSB indicates the error code.
+ *                                                          (Refer Solution Reference Manual)
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_crypt_stream_decrypt(optiga_crypt_stream_t * me,
+                                                                optiga_symmetric_encryption_mode_t encryption_mode,
+                                                                optiga_key_id_t symmetric_key_oid,
+                                                                const uint8_t * iv,
+                                                                uint16_t iv_length,
+                                                                const uint8_t * encrypted_data,
+                                                                optiga_crypt_stream_reader_t reader,
+                                                                uint32_t encrypted_data_length,
+                                                                uint8_t * plain_data,
+                                                                optiga_crypt_stream_writer_t writer,
+                                                                void * p_io_ctx);
+#endif //OPTIGA_CRYPT_SYM_DECRYPT_ENABLED
+
+#endif //OPTIGA_CRYPT_STREAM_ENABLED
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_OPTIGA_CRYPT_STREAM_H_*/
+
+/**
+* @}
+*/
@@ -95,6 +95,84 @@ extern "C" {
     #define OPTIGA_CRYPT_HMAC_VERIFY_ENABLED
     /** @brief OPTIGA CRYPT clear AUTO state feature enable/disable macro */
     #define OPTIGA_CRYPT_CLEAR_AUTO_STATE_ENABLED   
+    /** @brief OPTIGA CRYPT dispatcher (load balancing across OPTIGA instances) feature enable/disable macro */
+    #define OPTIGA_CRYPT_DISPATCHER_ENABLED
+    /** @brief Number of crypt instances (operations in flight) of the dispatcher per OPTIGA instance */
+    #define OPTIGA_CRYPT_DISPATCHER_LANES_PER_INSTANCE  (0x02)
+    /** @brief Maximum number of key affinity entries of the dispatcher */
+    #define OPTIGA_CRYPT_DISPATCHER_MAX_KEY_AFFINITY    (0x08)
+    /** @brief OPTIGA CRYPT completion queue (completions reaped by an event loop) feature enable/disable macro */
+    #define OPTIGA_CRYPT_CQ_ENABLED
+    /** @brief OPTIGA CRYPT coalescing of small hash and hmac updates (batched on host) feature enable/disable macro */
+    #define OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+    /** @brief OPTIGA CRYPT hashing of data from host using the pal crypt library (offloaded to host) feature enable/disable macro */
+    //#define OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED
+    /** @brief OPTIGA CRYPT verification of ECDSA signature with public key from host using the pal crypt library (offloaded to host) feature enable/disable macro */
+    //#define OPTIGA_CRYPT_ECDSA_VERIFY_OFFLOAD_ENABLED
+    /** @brief OPTIGA CRYPT cache of successful ECDSA verifications (repeated chain validation served on host) feature enable/disable macro */
+    //#define OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+    /** @brief Number of verifications held in the verification cache */
+    #define OPTIGA_CRYPT_VERIFY_CACHE_SIZE              (0x08)
+    /** @brief OPTIGA CRYPT offload policy (host or OPTIGA chosen per operation by a measured cost model) feature enable/disable macro */
+    #define OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
+    /** @brief OPTIGA CRYPT ECDSA signature formats (raw r||s and DER SEQUENCE besides the DER INTEGERs of OPTIGA) feature enable/disable macro */
+    #define OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+    /** @brief OPTIGA CRYPT random pool (random bytes prefetched into host memory) feature enable/disable macro */
+    #define OPTIGA_CRYPT_RANDOM_POOL_ENABLED
+    /** @brief Size of the random pool in bytes */
+    #define OPTIGA_CRYPT_RANDOM_POOL_SIZE               (0x100)
+    /** @brief Number of random bytes fetched with one refill of the random pool, must be in the range 8 to 256 */
+    #define OPTIGA_CRYPT_RANDOM_POOL_REFILL_SIZE        (0x40)
+    /** @brief OPTIGA CRYPT keypair cache (ephemeral ECC keypairs pregenerated in session contexts) feature enable/disable macro */
+    #define OPTIGA_CRYPT_KEYPAIR_CACHE_ENABLED
+    /** @brief Number of keypairs pregenerated by the keypair cache, each keeps one of the 4 session contexts of OPTIGA acquired */
+    #define OPTIGA_CRYPT_KEYPAIR_CACHE_SIZE             (0x02)
+    /** @brief OPTIGA CRYPT key pool (persistent keypairs pregenerated in reserved key OIDs) feature enable/disable macro */
+    #define OPTIGA_CRYPT_KEY_POOL_ENABLED
+    /** @brief Maximum number of key OIDs of a key pool, e.g. 0xE0F1 - 0xE0F3 for ECC keys */
+    #define OPTIGA_CRYPT_KEY_POOL_SIZE                  (0x03)
+    /** @brief OPTIGA CRYPT stream (pipelined symmetric encryption and decryption of arbitrary length) feature enable/disable macro */
+    #define OPTIGA_CRYPT_STREAM_ENABLED
+    /** @brief Length of a chunk of the stream, must be block aligned. Each stream holds 4 chunks (2 input, 2 output) */
+    #define OPTIGA_CRYPT_STREAM_CHUNK_SIZE              (0x100)
+    /** @brief OPTIGA CRYPT operation handles (one-shot operations queued on an instance) feature enable/disable macro */
+    #define OPTIGA_CRYPT_OPERATION_QUEUE_ENABLED
+    /** @brief Maximum number of operation handles queued on a crypt instance, while an operation is ongoing */
+    #define OPTIGA_CRYPT_OPERATION_QUEUE_SIZE           (0x08)
+    /** @brief OPTIGA CRYPT batched ECDSA signing of several digests with one private key feature enable/disable macro */
+    #define OPTIGA_CRYPT_ECDSA_SIGN_BATCH_ENABLED
+    /** @brief Number of digests signed under one acquisition of the lock, must not exceed OPTIGA_CMD_BATCH_MAX_ITEMS */
+    #define OPTIGA_CRYPT_ECDSA_SIGN_BATCH_CHUNK_SIZE    (0x04)
+    /** @brief OPTIGA CRYPT batched verification of several signatures (prefiltered on host) feature enable/disable macro */
+    #define OPTIGA_CRYPT_VERIFY_BATCH_ENABLED
+    /** @brief Number of signatures verified by OPTIGA under one acquisition of the lock, must not exceed OPTIGA_CMD_BATCH_MAX_ITEMS */
+    #define OPTIGA_CRYPT_VERIFY_BATCH_CHUNK_SIZE        (0x04)
+    /** @brief OPTIGA CRYPT TLS 1.2 ECDHE key block derivation as one chain of commands feature enable/disable macro */
+    #define OPTIGA_CRYPT_TLS_HANDSHAKE_ENABLED
+    /** @brief OPTIGA CRYPT TLS 1.3 handshake secrets derivation as one chain of commands feature enable/disable macro */
+    #define OPTIGA_CRYPT_TLS13_KEY_SCHEDULE_ENABLED
+    /** @brief OPTIGA CRYPT HMAC authorization (auth code, HMAC verify, protected commands and clear AUTO state) as one chain of commands feature enable/disable macro */
+    #define OPTIGA_CRYPT_HMAC_AUTHORIZE_ENABLED
+    /** @brief OPTIGA CRYPT hash multiplexer (several hash sequences with buffered updates over one instance) feature enable/disable macro */
+    #define OPTIGA_CRYPT_HASH_MUX_ENABLED
+    /** @brief Maximum number of hash sequences of a hash multiplexer */
+    #define OPTIGA_CRYPT_HASH_MUX_MAX_SEQUENCES         (0x04)
+    /** @brief Size of the buffer of a hash sequence in OPTIGA, whose updates are sent in one command */
+    #define OPTIGA_CRYPT_HASH_MUX_BUFFER_SIZE           (0x100)
+    /** @brief OPTIGA CRYPT sign message (messages hashed on host while OPTIGA signs the previous digest) feature enable/disable macro */
+    #define OPTIGA_CRYPT_SIGN_MESSAGE_ENABLED
+    /** @brief Size of the chunks read from the reader of a message, held on the stack of the caller */
+    #define OPTIGA_CRYPT_SIGN_MESSAGE_CHUNK_SIZE        (0x100)
+    /** @brief OPTIGA CRYPT data keys (per object AES keys derived by OPTIGA, data encrypted on host) feature enable/disable macro */
+    #define OPTIGA_CRYPT_DATA_KEY_ENABLED
+    /** @brief Number of data keys cached on host */
+    #define OPTIGA_CRYPT_DATA_KEY_CACHE_SIZE            (0x04)
+    /** @brief Time in milliseconds, for which a data key is cached on host */
+    #define OPTIGA_CRYPT_DATA_KEY_TTL                   (60000U)
+    /** @brief Maximum length of the identifier of an object, from which its data key is derived */
+    #define OPTIGA_CRYPT_DATA_KEY_MAX_ID_LENGTH         (0x20)
+    /** @brief Cache of the data keys locked in memory, neither swapped nor dumped (Linux) feature enable/disable macro */
+    //#define OPTIGA_CRYPT_DATA_KEY_LOCKED_MEMORY_ENABLED
 
     /** @brief OPTIGA COMMS shielded connection feature.
      *         To disable the feature, undefine the macro
@@ -108,6 +186,8 @@ extern "C" {
      *         Cold Reset - (0) : This is applicable if the host platform has GPIO option for RST and VDD.    \n
      *         Soft Reset - (1) : This is applicable if the host platform doesn't have GPIO options for VDD and RST.  \n
      *         Warm Reset - (2) : This is applicable if the host platform doesn't have GPIO option for VDD. \n
+     *         Warm Attach - (3) : No reset. This is applicable, if OPTIGA is powered and was initialized before
+     *                             (e.g. restart of the host application). \n
      *         Any other value will lead to error
      */
 	#ifndef OPTIGA_COMMS_DEFAULT_RESET_TYPE
@@ -118,10 +198,380 @@ extern "C" {
      *         To disable the check, undefine the macro
      */
     #define OPTIGA_LIB_DEBUG_NULL_CHECK
-    /** @brief Maximum number of instance registration */
+    /** @brief Maximum number of OPTIGA devices (instances) driven by the host.
+     *         Each instance has its own comms stack, pal os event and scheduler.
+     *         For each instance, an entry must be provided in ifx_i2c_context_list (ifx_i2c_config.c)
+     */
+    #define OPTIGA_MAX_NUMBER_OF_INSTANCES              (0x01)
+    /** @brief Maximum number of instance registration in default registry. Refer optiga_cmd_set_registry to register more */
     #define OPTIGA_CMD_MAX_REGISTRATIONS                (0x06)
+    /** @brief Event driven command scheduler.
+     *         Scheduler is woken up when a request is posted or a lock is released, instead of periodic polling.
+     *         To use periodic polling, undefine the macro
+     */
+    #define OPTIGA_CMD_EVENT_DRIVEN_SCHEDULER
+    /** @brief Waiting time in execution queue after which a request is promoted by one priority class (in microseconds) */
+    #define OPTIGA_CMD_PRIORITY_AGING_TIME_US           (500000U)
+    /** @brief Maximum number of commands in a command batch. Refer optiga_cmd_execute_batch */
+    #define OPTIGA_CMD_BATCH_MAX_ITEMS                  (0x10)
+    /** @brief Session pool with lease time and fail fast acquisition of the session contexts. Refer optiga_crypt_set_session_policy */
+    #define OPTIGA_CMD_SESSION_POOL_ENABLED
+    /** @brief Blocking (synchronous) variants of util and crypt APIs, which wait on PAL wait object (pal_os_wait.h).
+     *         To disable the feature, undefine the macro
+     */
+    #define OPTIGA_LIB_SYNC_API_ENABLED
+    /** @brief Double buffered APDUs. The next APDU is prepared in a second buffer, while OPTIGA processes the current one.
+     *         To use a single communication buffer, undefine the macro
+     */
+    #define OPTIGA_CMD_DOUBLE_BUFFERED_APDU
+    /** @brief Run to I/O execution. The instance granted by the scheduler and the states following a response are
+     *         executed right away till the next I/O, instead of being triggered through the pal os event.
+     *         To enable, define the macro
+     */
+    //#define OPTIGA_CMD_RUN_TO_IO_ENABLED
+    /** @brief Lazy device error. If OPTIGA responds with failure and the command does not analyze the error code,
+     *         OPTIGA_DEVICE_ERROR_CODE_NOT_READ is reported right away, without reading the Last Error Code (0xF1C2).
+     *         The error code is read by the application using optiga_util_read_data (0xF1C2), if required, before
+     *         the next command is sent to OPTIGA. To report the error code of OPTIGA with each failure, undefine the macro
+     */
+    //#define OPTIGA_CMD_LAZY_DEVICE_ERROR_ENABLED
+    /** @brief Deadline of the requests. A request, which is still waiting in the execution queue once the deadline of
+     *         the instance is elapsed, is dropped without being sent to OPTIGA and completes with
+     *         OPTIGA_CMD_ERROR_DEADLINE_EXPIRED. Refer optiga_crypt_set_deadline. To disable the feature, undefine the macro
+     */
+    #define OPTIGA_CMD_DEADLINE_ENABLED
+    /** @brief Cancellation of the requests. A cancelled request, which is waiting in the execution queue, is dropped
+     *         without being sent to OPTIGA. The result of a request, which is dispatched already, is discarded.
+     *         Both complete with OPTIGA_CMD_ERROR_CANCELLED. Refer optiga_crypt_cancel. To disable the feature, undefine the macro
+     */
+    #define OPTIGA_CMD_CANCEL_ENABLED
+    /** @brief Strict lock hold time. Once a hold time is set using optiga_util_set_strict_lock_timeout, a sequence under
+     *         strict lock (e.g. hash or symmetric start, continue and final with the context in OPTIGA), whose next step
+     *         is not sent within the hold time while further requests wait, loses the strict lock. Its next step
+     *         completes with OPTIGA_CMD_ERROR_STRICT_LOCK_REVOKED. To disable the feature, undefine the macro
+     */
+    #define OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+    /** @brief Weighted fair sharing of OPTIGA among tenants. The instances are tagged with a tenant using
+     *         optiga_util_set_tenant or optiga_crypt_set_tenant. Within a priority class, the command scheduler serves
+     *         the tenant first, which has consumed the least OPTIGA time relative to its weight (refer
+     *         optiga_util_set_tenant_weight), instead of the earliest request. The OPTIGA time consumed by each tenant
+     *         is retrieved using optiga_util_get_tenant_stats. To disable the feature, undefine the macro
+     */
+    #define OPTIGA_CMD_FAIR_SHARE_ENABLED
+    /** @brief Number of tenants, among which OPTIGA is shared */
+    #define OPTIGA_CMD_FAIR_SHARE_MAX_TENANTS           (0x04)
+    /** @brief Admission control of the execution queue. The time a request is served (dispatch till release of
+     *         the slot) is measured, from which the waiting time of a new request is estimated. Using
+     *         optiga_util_try_admit or optiga_crypt_try_admit, a caller learns before invoking an operation, whether
+     *         it is served within its maximum waiting time. A callback set using optiga_util_set_queue_watermark is
+     *         invoked, once the number of waiting requests reaches the high watermark and once it falls back to the
+     *         low watermark. Refer optiga_util_get_queue_load. To disable the feature, undefine the macro
+     */
+    #define OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+    /** @brief Health monitor. The physical layer reports an unresponsive slave, once it does not acknowledge for
+     *         OPTIGA_COMMS_UNRESPONSIVE_TIME_MS. With OPTIGA_COMMS_DL_RESEND_BACKOFF_ENABLED, the data link layer also
+     *         stops resending a frame after this time, instead of retrying until TL_MAX_EXIT_TIMEOUT. On such a
+     *         communication failure, the command scheduler recovers OPTIGA with a soft reset (status register read
+     *         and soft reset, warm reset if it fails) and opens the application, up to
+     *         OPTIGA_CMD_RECOVERY_MAX_ATTEMPTS times per request. Only a read of a data object or of random data is
+     *         resent, the failure of the other commands is reported. The queued requests wait for the recovery.
+     *         Refer optiga_util_get_health_stats. To enable the feature, define the macro
+     */
+    //#define OPTIGA_CMD_HEALTH_MONITOR_ENABLED
+    /** @brief Time in milliseconds, after which a slave that does not respond is reported as unresponsive */
+    #define OPTIGA_COMMS_UNRESPONSIVE_TIME_MS           (100U)
+    /** @brief Maximum number of recoveries of OPTIGA for a request */
+    #define OPTIGA_CMD_RECOVERY_MAX_ATTEMPTS            (1U)
+    /** @brief Zero copy transmission. Single fragment packets are framed in place of the APDU, in the room reserved
+     *         by the command layer, instead of being copied to the frame buffer.
+     *         To disable the feature, undefine the macro
+     */
+    #define OPTIGA_COMMS_ZERO_COPY_TX
+    /** @brief Zero copy reception. The data of a read data object response is reassembled by the transport layer
+     *         directly in the user provided buffer, instead of the communication buffer. Responses protected by the
+     *         shielded connection are decrypted in the communication buffer and copied as before.
+     *         To disable the feature, undefine the macro
+     */
+    #define OPTIGA_COMMS_ZERO_COPY_RX
+    /** @brief Data ready interrupt. The status register is read on the data ready edge signalled through pal gpio
+     *         (refer pal_gpio_register_irq), instead of polling it. Polling is kept as fallback for a missed edge.
+     *         To enable the feature, define the macro and provide optiga_irq_0 in the pal
+     */
+    //#define OPTIGA_COMMS_DATA_READY_IRQ_ENABLED
+    /** @brief Adaptive polling. The first status register read for a response is scheduled near the expected execution
+     *         time of the command, which is refined with the measured execution times, followed by a tight backoff.
+     *         To poll with the fixed interval, undefine the macro
+     */
+    #define OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+    /** @brief Number of commands (command code and parameter), whose execution time is tracked for adaptive polling */
+    #define OPTIGA_CMD_EXECUTION_TIME_CACHE_SIZE        (0x08)
+    /** @brief ACK piggybacking. The ACK of the last frame of a response is not sent as control frame, it is carried
+     *         by the next data frame (command) instead. This saves one frame transmission per command.
+     *         To enable the feature, define the macro (the slave must accept the deferred ACK)
+     */
+    //#define OPTIGA_COMMS_ACK_PIGGYBACK_ENABLED
+    /** @brief Speculative read. The ACK of a transmitted data frame is read from the DATA register with the control frame
+     *         length, without reading the STATUS register first. This saves two I2C transactions per frame. If the slave
+     *         NACKs the read, the STATUS register is polled. Any other frame is rejected by the data link layer checks.
+     *         To enable the feature, define the macro (the slave must NACK the DATA register read, until a frame is ready)
+     */
+    //#define OPTIGA_COMMS_SPECULATIVE_READ_ENABLED
+    /** @brief Adaptive bitrate. The I2C master bitrate is halved on repeated frame errors, down to 100 KHz, and probed
+     *         back up to the negotiated frequency after error free frames.
+     *         To keep the negotiated frequency, undefine the macro
+     */
+    #define OPTIGA_COMMS_ADAPTIVE_BITRATE_ENABLED
+    /** @brief Data link layer resend backoff. A frame is resent after an exponential backoff with jitter, whose base
+     *         depends on the error (CRC error, NACK or timeout), and the time spent in recovery is counted.
+     *         To resend immediately, undefine the macro
+     */
+    #define OPTIGA_COMMS_DL_RESEND_BACKOFF_ENABLED
+    /** @brief Fast startup. The negotiation starts STARTUP_MIN_TIME_USEC after a reset, instead of waiting the full
+     *         start up time. The slave NACKs its address until it is ready, which is retried by the physical layer.
+     *         Correct startup depends on the retries of the physical layer covering the remaining start up time.
+     *         To enable the fast startup, define the macro
+     */
+    //#define OPTIGA_COMMS_FAST_STARTUP_ENABLED
+    /** @brief Warm reattach. With the reset type Warm Attach - (3), the link state (negotiated parameters, frame counters
+     *         and the shielded connection session) is saved using pal_os_datastore on close and restored on open.
+     *         The device is kept powered on close and the reconnect costs one register read, instead of the negotiation
+     *         and handshake. The saved link state contains the session key, hence the datastore must be protected.
+     *         To enable, define the macro
+     */
+    //#define OPTIGA_COMMS_WARM_REATTACH_ENABLED
+    /** @brief Shared link (Linux). The processes, which use the same OPTIGA, exchange one transaction at a time under
+     *         a lock file and hand over the link state (data link layer frame counters and the shielded connection
+     *         session) through it (pal_os_lock_acquire_shared_link), instead of resyncing and handshaking on each change
+     *         of the owner. All the processes must open with the reset type Warm Attach - (3), the same frequency and
+     *         frame size, and close without the hibernate. To enable, define the macro
+     */
+    //#define OPTIGA_COMMS_SHARED_LINK_ENABLED
+    /** @brief Negotiation cache. The frequency and frame size negotiated with the slave are cached in RAM and applied
+     *         on the next initialization with the same slave address and configuration, without reading the slave
+     *         registers. On the first error with cached parameters, the negotiation is repeated.
+     *         To negotiate on every initialization, undefine the macro
+     */
+    #define OPTIGA_COMMS_PL_NEGOTIATION_CACHE_ENABLED
+    /** @brief Bus enumeration (ifx_i2c_enumerate_bus). The devices sharing one I2C bus are released from reset one at
+     *         a time and moved to sequential persistent slave addresses, the map is stored using pal_os_datastore.
+     *         To enable, define the macro
+     */
+    //#define OPTIGA_COMMS_BUS_ENUMERATION_ENABLED
+    /** @brief Trampolined layer callbacks. The events of the physical, data link, transport and presentation layer to
+     *         the upper layer are queued and dispatched in a loop, instead of nested calls. Hence the completion of
+     *         a frame occupies the stack of one layer at a time, independent of the number of layers and retries.
+     *         To invoke the upper layer handlers nested, undefine the macro
+     */
+    #define OPTIGA_COMMS_EVENT_TRAMPOLINE_ENABLED
+    /** @brief Stack usage measurement of the IFX I2C protocol stack (optiga_comms_get_stack_usage), to size the stack
+     *         of the task running the pal os event. To enable, define the macro
+     */
+    //#define OPTIGA_COMMS_STACK_USAGE_ENABLED
+    /** @brief Shielded connection uses the AES hardware accelerator of the platform for AES CCM (pal_crypt_aes128_ccm_hw.c).
+     *         To enable, define the macro and provide the pal_crypt_aes128_hw_* functions in the pal
+     */
+    //#define OPTIGA_PAL_CRYPT_HW_AES_ENABLED
+    /** @brief Log-structured flash datastore (pal_os_datastore_log.c). The MCU pals append the manage context and the
+     *         hibernate context as records with CRC to a flash area of sectors, instead of an erase per write.
+     *         To enable, define the macro and provide the pal_os_datastore_flash_* functions in the pal
+     */
+    //#define OPTIGA_PAL_DATASTORE_LOG_ENABLED
+    /** @brief Number of the flash sectors of the datastore log, at least 2 */
+    #define OPTIGA_PAL_DATASTORE_LOG_SECTOR_COUNT          (2U)
+    /** @brief Size of a flash sector of the datastore log in bytes (erase unit of the flash) */
+    #define OPTIGA_PAL_DATASTORE_LOG_SECTOR_SIZE           (4096U)
+    /** @brief Program unit of the flash in bytes (e.g. 4 for ESP32, 256 for XMC4800), each record is padded to it */
+    #define OPTIGA_PAL_DATASTORE_LOG_PROGRAM_UNIT          (4U)
+    /** @brief Maximum length of the data of a record */
+    #define OPTIGA_PAL_DATASTORE_LOG_MAX_RECORD_LENGTH     (0x48U)
+    /** @brief Maximum number of the datastore ids in the datastore log */
+    #define OPTIGA_PAL_DATASTORE_LOG_MAX_IDS               (4U)
+    /** @brief Protection policy table, which provides the protection level per command and OID (optiga_cmd_set_protection_policy).
+     *         To disable the feature, undefine the macro
+     */
+    #define OPTIGA_COMMS_PROTECTION_POLICY_ENABLED
+    /** @brief Session key rollover. The shielded connection session is renegotiated by the command scheduler, when
+     *         the command queue is idle and the sequence numbers or the age of the session reach the limits below.
+     *         To renegotiate only inline with the next command (sequence number exhausted or re-establish), undefine the macro
+     */
+    #define OPTIGA_COMMS_KEY_ROLLOVER_ENABLED
+    /** @brief Sequence number of the session, from which the session key rollover is done */
+    #define OPTIGA_COMMS_KEY_ROLLOVER_SEQUENCE_NUMBER   (0xFFFF0000)
+    /** @brief Age of the session in milliseconds, from which the session key rollover is done (0 to disable) */
+    #define OPTIGA_COMMS_KEY_ROLLOVER_AGE_MS            (0U)
+    /** @brief Fast resume. The restore of the application from hibernate powers up the device without the reset low time,
+     *         if the device is powered off since the hibernate, and the resume latency is measured (optiga_util_get_resume_stats).
+     *         To disable the feature, undefine the macro
+     */
+    #define OPTIGA_LIB_FAST_RESUME_ENABLED
+    /** @brief Auto hibernate. The command scheduler hibernates the application on OPTIGA, once the command queue is idle
+     *         for the idle time set using optiga_util_set_auto_hibernate, and restores it transparently on the next request.
+     *         To enable the feature, define the macro
+     */
+    //#define OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+    /** @brief Lazy open. Once enabled using optiga_util_set_lazy_open, the command scheduler opens the communication and
+     *         the application on the first request, or in the background with pre-open, instead of optiga_util_open_application.
+     *         Requires OPTIGA_CMD_AUTO_HIBERNATE_ENABLED. To enable the feature, define the macro
+     */
+    //#define OPTIGA_CMD_LAZY_OPEN_ENABLED
+    /** @brief Performance governor. Once a policy is set using optiga_util_set_performance_policy, the command scheduler
+     *         raises the current limitation of OPTIGA (0xE0C4) on a burst of queued requests and drops it, once the command
+     *         queue is idle, bounded by the power budget of the host (optiga_util_set_power_budget).
+     *         Requires OPTIGA_CMD_AUTO_HIBERNATE_ENABLED. To disable the feature, undefine the macro
+     */
+    #define OPTIGA_CMD_PERFORMANCE_GOVERNOR_ENABLED
+    /** @brief Security event counter pacing. Once a policy is set using optiga_util_set_sec_policy, the command scheduler
+     *         tracks the security event counter (0xE0C5) and holds back the SEC raising requests (HMAC verification,
+     *         protected update), while the SEC estimated is above the threshold, to keep OPTIGA out of its delays.
+     *         Requires OPTIGA_CMD_AUTO_HIBERNATE_ENABLED. To enable the feature, define the macro
+     */
+    //#define OPTIGA_CMD_SEC_PACING_ENABLED
+    /** @brief Deferred execution. The requests of an instance marked using optiga_util_set_deferrable or
+     *         optiga_crypt_set_deferrable do not restore the hibernated application. They wait till a request, which
+     *         is not deferrable, restores the application or their maximum delay elapses, and are then served in one
+     *         batch. Requires OPTIGA_CMD_AUTO_HIBERNATE_ENABLED. To disable the feature, undefine the macro
+     */
+    #define OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+    /** @brief Read cache. The data objects registered using optiga_util_read_cache_register are cached on host, once read,
+     *         and the repeated reads using optiga_util_read_data are served from host memory. A write to the data object
+     *         drops its cached data. To enable the feature, define the macro
+     */
+    //#define OPTIGA_UTIL_READ_CACHE_ENABLED
+    /** @brief Number of data objects in the read cache */
+    #define OPTIGA_UTIL_READ_CACHE_SIZE                 (0x03)
+    /** @brief Maximum number of bytes cached per data object, larger data objects are cached partly */
+    #define OPTIGA_UTIL_READ_CACHE_MAX_OBJECT_SIZE      (0x0300)
+    /** @brief Shared read cache (Linux). The read cache is backed by a memory segment, which is shared by the processes
+     *         using the same OPTIGA (pal_os_memory_shared_acquire). The data object read by one process is served to the
+     *         other processes from the segment as well. A write to a data object or a protected update increments the
+     *         generation of the segment, which drops the data cached by all the processes before.
+     *         Requires OPTIGA_UTIL_READ_CACHE_ENABLED. To enable, define the macro
+     */
+    //#define OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+    /** @brief Number of data objects in the shared segment of the read cache, of all the processes and instances */
+    #define OPTIGA_UTIL_READ_CACHE_SHARED_SIZE          (0x08)
+    /** @brief Metadata cache. The metadata read from OPTIGA is parsed (sizes, access conditions, LcsO) and cached on host,
+     *         which is retrieved using optiga_util_metadata_cache_get. A write to the object drops its cached metadata.
+     *         To disable the feature, undefine the macro
+     */
+    #define OPTIGA_UTIL_METADATA_CACHE_ENABLED
+    /** @brief Number of objects in the metadata cache */
+    #define OPTIGA_UTIL_METADATA_CACHE_SIZE             (0x08)
+    /** @brief Read of several data objects (optiga_util_read_data_multiple) with the reads issued back to back
+     *         under one acquisition of the lock. To disable the feature, undefine the macro
+     */
+    #define OPTIGA_UTIL_READ_DATA_MULTIPLE_ENABLED
+    /** @brief Number of data objects read under one acquisition of the lock, must not exceed OPTIGA_CMD_BATCH_MAX_ITEMS */
+    #define OPTIGA_UTIL_READ_DATA_MULTIPLE_CHUNK_SIZE   (0x04)
+    /** @brief Differential write (OPTIGA_UTIL_WRITE_DIFFERENTIAL), which writes only the bytes differing from the
+     *         current data of the data object (read cache or read from OPTIGA). To enable the feature, define the macro
+     */
+    //#define OPTIGA_UTIL_DIFFERENTIAL_WRITE_ENABLED
+    /** @brief Maximum number of changed ranges written by a differential write, further changes extend the last range */
+    #define OPTIGA_UTIL_DIFFERENTIAL_WRITE_MAX_RANGES   (0x04)
+    /** @brief Number of unchanged bytes between two changed ranges, up to which the ranges are written with one command */
+    #define OPTIGA_UTIL_DIFFERENTIAL_WRITE_MERGE_GAP    (0x10)
+    /** @brief Coalescing of the increments of the counter data objects (optiga_util_add_count), which are written
+     *         with one update count. To disable the feature, undefine the macro
+     */
+    #define OPTIGA_UTIL_COUNT_COALESCING_ENABLED
+    /** @brief Number of pending increments of a counter data object, which triggers the flush */
+    #define OPTIGA_UTIL_COUNT_COALESCING_THRESHOLD      (0x10)
+    /** @brief Maximum age of the pending increments in milliseconds, checked by optiga_util_add_count */
+    #define OPTIGA_UTIL_COUNT_COALESCING_INTERVAL_MS    (60000U)
+    /** @brief Number of increments after which the pending increments are stored to the datastore.
+     *         1 stores each increment, a higher value saves writes to the datastore, but loses up to value - 1
+     *         increments on a reset of the host
+     */
+    #define OPTIGA_UTIL_COUNT_COALESCING_SAVE_INTERVAL  (0x01)
+    /** @brief Protected update stream. The data set is fed from a reader (file, socket), in fragments which are read
+     *         while the previous one is executed by OPTIGA. Only two fragments are buffered on host.
+     *         To disable the feature, undefine the macro
+     */
+    #define OPTIGA_UTIL_PROTECTED_UPDATE_STREAM_ENABLED
+    /** @brief Protected update check. The manifest (structure, ES-256 signature with the trust anchor public key held
+     *         on host) and the digest chain of the fragments are checked on host, before they are sent to OPTIGA.
+     *         To disable the feature, undefine the macro
+     */
+    #define OPTIGA_UTIL_PROTECTED_UPDATE_CHECK_ENABLED
+    /** @brief Capability probe. On the first open application, the ESW build number is read from the coprocessor UID
+     *         and the crypt APIs, which are not supported by the OPTIGA (e.g. symmetric, HMAC and HKDF on OPTIGA Trust M
+     *         V1), fail with OPTIGA_CRYPT_ERROR_UNSUPPORTED (optiga_util_get_capabilities). Hence one image built with
+     *         the configuration of V3 serves both versions. To disable the feature, undefine the macro
+     */
+    #define OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+    /** @brief !!!OPTIGA_LIB_PORTING_REQUIRED ESW build number (BCD), from which OPTIGA is taken as OPTIGA Trust M V3 */
+    #define OPTIGA_LIB_CAPABILITY_M_V3_MIN_BUILD_NUMBER (0x2440)
+    /** @brief Memory pool. pal_os_malloc and pal_os_calloc allocate the instances from fixed blocks in two size classes,
+     *         in constant time and without fragmenting the heap. Allocations, which do not fit, fall back to the heap
+     *         and are counted (pal_os_memory_get_pool_stats). To enable the feature, define the macro
+     */
+    //#define OPTIGA_LIB_MEMORY_POOL_ENABLED
+    /** @brief Size of the small blocks (command and util instances) */
+    #define OPTIGA_LIB_MEMORY_POOL_SMALL_BLOCK_SIZE     (0x0100)
+    /** @brief Number of the small blocks */
+    #define OPTIGA_LIB_MEMORY_POOL_SMALL_BLOCK_COUNT    (0x06)
+    /** @brief Size of the large blocks (crypt instances) */
+    #define OPTIGA_LIB_MEMORY_POOL_LARGE_BLOCK_SIZE     (0x0700)
+    /** @brief Number of the large blocks */
+    #define OPTIGA_LIB_MEMORY_POOL_LARGE_BLOCK_COUNT    (0x02)
+    /** @brief Event queue. The optiga cmd scheduler and the comms stack register their callbacks on events of their own,
+     *         which are multiplexed onto the os event of the platform and pending at distinct deadlines, instead of
+     *         overwriting the single registered callback. To disable the feature, undefine the macro
+     */
+    #define OPTIGA_LIB_EVENT_QUEUE_ENABLED
+    /** @brief Number of events of the event queue (one for optiga cmd and one for comms per optiga instance) */
+    #define OPTIGA_LIB_EVENT_QUEUE_SIZE                 (0x04)
+    /** @brief Datastore cache. The manage context and the context handle are written to the datastore of the platform
+     *         (pal_os_datastore_write) only if they differ from the cached copy of the last write. Writes within
+     *         OPTIGA_LIB_DATASTORE_CACHE_WINDOW_MS after the last write of the same datastore id are held in the cache
+     *         and written with the next hibernate. To disable the feature, undefine the macro
+     */
+    #define OPTIGA_LIB_DATASTORE_CACHE_ENABLED
+    /** @brief Number of datastore ids held in the cache */
+    #define OPTIGA_LIB_DATASTORE_CACHE_ENTRIES          (0x04)
+    /** @brief Maximum length of the data of a datastore id held in the cache, longer data is written through */
+    #define OPTIGA_LIB_DATASTORE_CACHE_ENTRY_SIZE       (0x48)
+    /** @brief Window in milliseconds, in which the writes of a datastore id are coalesced. 0 writes all the changes */
+    #define OPTIGA_LIB_DATASTORE_CACHE_WINDOW_MS        (0)
+    /** @brief Latency tracing. The layers (scheduler, cmd, presentation, transport, data link and physical layer) and the
+     *         command execution on OPTIGA record begin and end events with microsecond time stamps, which are read from
+     *         a ring buffer (optiga_lib_trace_read) or passed to a callback (optiga_lib_trace_set_callback).
+     *         To enable, define the macro
+     */
+    //#define OPTIGA_LIB_TRACE_ENABLED
+    /** @brief Number of events in the trace ring buffer, must be a power of 2 */
+    #define OPTIGA_LIB_TRACE_BUFFER_SIZE                (0x40)
+    /** @brief Runtime statistics. The number of executions and the latencies of each command, the link errors
+     *         (retransmits, resyncs, chaining errors and decryption failures), the queue depth high water mark and the
+     *         busy time of OPTIGA are accumulated and retrieved using optiga_util_get_statistics.
+     *         To disable, undefine the macro
+     */
+    #define OPTIGA_LIB_STATISTICS_ENABLED
+    /** @brief Number of command codes, of which the statistics are held separately */
+    #define OPTIGA_LIB_STATISTICS_COMMAND_COUNT         (0x10)
+    /** @brief Host CPU cost profiling. The cycles spent in the CRC calculation, the fragmentation, the encryption and
+     *         decryption of the shielded connection, the APDU encoding, the response processing and the logger are
+     *         accumulated with the cycle counter of the pal (pal_os_timer_get_cycle_count) and retrieved using
+     *         optiga_lib_profile_get. To enable, define the macro
+     */
+    //#define OPTIGA_LIB_PROFILE_ENABLED
+    /** @brief Low RAM profile. The communication buffer and the frame size are reduced and the features, which hold
+     *         RAM in addition (refer the end of this file), are disabled, for a static RAM of the library below 2 KB. The instances are allocated from
+     *         the heap (about 0.3 KB for one util and one crypt instance). The data of read, write, hash, symmetric and HMAC commands is chunked to the communication buffer.
+     *         The commands with data, which cannot be chunked and exceeds the buffer (e.g. RSA keys, protected update
+     *         fragments), fail with OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT. To enable, define the macro
+     */
+    //#define OPTIGA_LIB_LOW_RAM_PROFILE
+#ifdef OPTIGA_LIB_LOW_RAM_PROFILE
+    /** @brief Maximum buffer size required to communicate with OPTIGA, not less than 0xF0 */
+    #define OPTIGA_MAX_COMMS_BUFFER_SIZE                (0x100)
+    /** @brief Data link layer frame size, which sizes the frame buffers of the protocol stack */
+    #define IFX_I2C_FRAME_SIZE                          (0x40U)
+#else
     /** @brief Maximum buffer size required to communicate with OPTIGA */
     #define OPTIGA_MAX_COMMS_BUFFER_SIZE                (0x615) //1557 in decimal
+#endif //OPTIGA_LIB_LOW_RAM_PROFILE
 
     /** @brief Macro to enable logger \n
     * Enable macro OPTIGA_LIB_ENABLE_UTIL_LOGGING for Util Service layer logging     \n
@@ -143,6 +593,16 @@ extern "C" {
     //#define OPTIGA_LIB_ENABLE_COMMS_LOGGING
 #endif
 /// @endcond
+    /** @brief Deferred logger. The messages, status values, byte arrays and the debug statements of the protocol
+     *         stack (IFX_I2C_LOG) are recorded unformatted with their raw arguments into a ring buffer, which is
+     *         formatted later using optiga_lib_logger_flush or exported using optiga_lib_logger_read.
+     *         To enable, define the macro
+     */
+    //#define OPTIGA_LIB_LOGGER_DEFERRED_ENABLED
+    /** @brief Size of the ring buffer of the deferred logger in bytes, must be a power of 2 */
+    #define OPTIGA_LIB_LOGGER_DEFERRED_BUFFER_SIZE      (0x800)
+    /** @brief Maximum number of bytes of a record of the deferred logger, longer data is truncated */
+    #define OPTIGA_LIB_LOGGER_DEFERRED_MAX_DATA         (0x100)
 
     /* Below are the example macros for protected update not for any feature */
     /** @brief OPTIGA UTIL confidentiality protected update feature enable/disable macro */      
@@ -151,6 +611,71 @@ extern "C" {
     #define EXAMPLE_OPTIGA_UTIL_PROTECTED_UPDATE_OBJECT_KEY_ENABLED    
     /** @brief OPTIGA UTIL metadata object protected update feature enable/disable macro */      
     #define EXAMPLE_OPTIGA_UTIL_PROTECTED_UPDATE_OBJECT_METADATA_ENABLED    
+
+#ifdef OPTIGA_LIB_LOW_RAM_PROFILE
+    // The features holding buffers, caches or instances of their own are disabled by the low RAM profile
+    #undef OPTIGA_CRYPT_DISPATCHER_ENABLED
+    #undef OPTIGA_CRYPT_CQ_ENABLED
+    #undef OPTIGA_CRYPT_UPDATE_COALESCING_ENABLED
+    #undef OPTIGA_CRYPT_RANDOM_POOL_ENABLED
+    #undef OPTIGA_CRYPT_KEYPAIR_CACHE_ENABLED
+    #undef OPTIGA_CRYPT_KEY_POOL_ENABLED
+    #undef OPTIGA_CRYPT_STREAM_ENABLED
+    #undef OPTIGA_CRYPT_OPERATION_QUEUE_ENABLED
+    #undef OPTIGA_CRYPT_ECDSA_SIGN_BATCH_ENABLED
+    #undef OPTIGA_CRYPT_VERIFY_BATCH_ENABLED
+    #undef OPTIGA_CRYPT_TLS_HANDSHAKE_ENABLED
+    #undef OPTIGA_CRYPT_TLS13_KEY_SCHEDULE_ENABLED
+    #undef OPTIGA_CRYPT_HMAC_AUTHORIZE_ENABLED
+    #undef OPTIGA_CRYPT_HASH_MUX_ENABLED
+    #undef OPTIGA_CRYPT_DATA_KEY_ENABLED
+    #undef OPTIGA_CMD_DOUBLE_BUFFERED_APDU
+    #undef OPTIGA_UTIL_READ_CACHE_ENABLED
+    #undef OPTIGA_UTIL_METADATA_CACHE_ENABLED
+    #undef OPTIGA_CRYPT_VERIFY_CACHE_ENABLED
+    #undef OPTIGA_UTIL_READ_DATA_MULTIPLE_ENABLED
+    #undef OPTIGA_UTIL_DIFFERENTIAL_WRITE_ENABLED
+    #undef OPTIGA_UTIL_COUNT_COALESCING_ENABLED
+    #undef OPTIGA_UTIL_PROTECTED_UPDATE_STREAM_ENABLED
+    #undef OPTIGA_LIB_MEMORY_POOL_ENABLED
+    #undef OPTIGA_LIB_DATASTORE_CACHE_ENABLED
+    #undef OPTIGA_LIB_STATISTICS_ENABLED
+    #undef OPTIGA_COMMS_SHIELDED_CONNECTION
+#endif //OPTIGA_LIB_LOW_RAM_PROFILE
+
+#ifndef OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+    // The lazy open, the performance governor and the SEC pacing are executed with the internal instance of the auto hibernate
+    #undef OPTIGA_CMD_LAZY_OPEN_ENABLED
+    #undef OPTIGA_CMD_PERFORMANCE_GOVERNOR_ENABLED
+    #undef OPTIGA_CMD_SEC_PACING_ENABLED
+    // The deferred requests wait for the restore of the hibernated application
+    #undef OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+#endif //OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+
+#ifndef OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+    // The raw signature (r || s) of the manifest is converted to the DER INTEGERs expected by pal crypt
+    #undef OPTIGA_UTIL_PROTECTED_UPDATE_CHECK_ENABLED
+#endif //OPTIGA_CRYPT_ECDSA_SIGNATURE_FORMAT_ENABLED
+
+#if !defined(OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED) && !defined(OPTIGA_CRYPT_ECDSA_VERIFY_OFFLOAD_ENABLED)
+    // The offload policy decides between the offloaded operations on host and OPTIGA
+    #undef OPTIGA_CRYPT_OFFLOAD_POLICY_ENABLED
+#endif
+
+#ifndef OPTIGA_CRYPT_HASH_OFFLOAD_ENABLED
+    // The messages are hashed using the pal crypt library
+    #undef OPTIGA_CRYPT_SIGN_MESSAGE_ENABLED
+#endif
+
+#if !defined(OPTIGA_LIB_SYNC_API_ENABLED) || !defined(OPTIGA_CRYPT_HKDF_ENABLED)
+    // The data keys are derived by OPTIGA using the synchronous HKDF
+    #undef OPTIGA_CRYPT_DATA_KEY_ENABLED
+#endif
+
+#ifndef OPTIGA_UTIL_READ_CACHE_ENABLED
+    // The shared segment backs the entries of the read cache
+    #undef OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+#endif //OPTIGA_UTIL_READ_CACHE_ENABLED
     
 
 #ifdef __cplusplus
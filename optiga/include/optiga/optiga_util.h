@@ -44,16 +44,83 @@ extern "C" {
 #endif
 
 #include "optiga/cmd/optiga_cmd.h"
+#ifdef OPTIGA_LIB_SYNC_API_ENABLED
+#include "optiga/pal/pal_os_wait.h"
+#endif //OPTIGA_LIB_SYNC_API_ENABLED
 
 /// Option to only write the data object
 #define OPTIGA_UTIL_WRITE_ONLY      (0x00)
 /// Option to erase and write the data object
 #define OPTIGA_UTIL_ERASE_AND_WRITE (0x40)
+#ifdef OPTIGA_UTIL_DIFFERENTIAL_WRITE_ENABLED
+/// Option to write only the bytes, which differ from the current data of the data object
+#define OPTIGA_UTIL_WRITE_DIFFERENTIAL (0x80)
+#endif //OPTIGA_UTIL_DIFFERENTIAL_WRITE_ENABLED
 
 
 /// To Initialize a clean application context
 #define OPTIGA_UTIL_CONTEXT_NONE        (0x00)
 
+#ifdef OPTIGA_UTIL_METADATA_CACHE_ENABLED
+/// Maximum length of the metadata of an object
+#define OPTIGA_UTIL_METADATA_MAX_LENGTH (0x40)
+#endif //OPTIGA_UTIL_METADATA_CACHE_ENABLED
+
+#ifdef OPTIGA_UTIL_READ_DATA_MULTIPLE_ENABLED
+/// Read item to read the data of the data object
+#define OPTIGA_UTIL_READ_ITEM_DATA      (0x00)
+/// Read item to read the metadata of the data object
+#define OPTIGA_UTIL_READ_ITEM_METADATA  (0x01)
+
+/** \brief Data object read by #optiga_util_read_data_multiple */
+typedef struct optiga_util_read_item
+{
+    /// OID of the data object
+    uint16_t oid;
+    /// Offset within the data object, ignored for the metadata
+    uint16_t offset;
+    /// Size of the buffer, updated with the length of the data read on completion
+    uint16_t length;
+    /// #OPTIGA_UTIL_READ_ITEM_DATA or #OPTIGA_UTIL_READ_ITEM_METADATA
+    uint8_t read_type;
+    /// Buffer to which the data is read
+    uint8_t * buffer;
+    /// Result of the read, updated on completion
+    optiga_lib_status_t status;
+}optiga_util_read_item_t;
+#endif //OPTIGA_UTIL_READ_DATA_MULTIPLE_ENABLED
+
+#ifdef OPTIGA_UTIL_COUNT_COALESCING_ENABLED
+/// OID of the first counter data object
+#define OPTIGA_UTIL_COUNTER_OID_FIRST   (0xE120)
+/// Number of counter data objects (0xE120 - 0xE123)
+#define OPTIGA_UTIL_COUNTER_OID_COUNT   (0x04)
+/// Flushes the pending increments of all the counter data objects
+#define OPTIGA_UTIL_COUNTER_OID_ALL     (0x0000)
+#endif //OPTIGA_UTIL_COUNT_COALESCING_ENABLED
+
+#ifdef OPTIGA_UTIL_PROTECTED_UPDATE_CHECK_ENABLED
+/// Length of the digest of a fragment (SHA-256), which is appended to each fragment except the final fragment
+#define OPTIGA_UTIL_PROTECTED_UPDATE_DIGEST_LENGTH      (0x20)
+
+/** \brief Check of a protected update data set on host */
+typedef struct optiga_util_protected_update_check
+{
+    /// Public key of the trust anchor, NULL if the signature of the manifest is verified only by OPTIGA
+    const public_key_from_host_t * p_trust_anchor;
+    /// OID of the trust anchor, which must be the key identifier of the manifest
+    uint16_t trust_anchor_oid;
+    /// Digest of the next fragment, taken from the manifest or the previous fragment
+    uint8_t next_fragment_digest[OPTIGA_UTIL_PROTECTED_UPDATE_DIGEST_LENGTH];
+    /// Length of the payload, which is not yet sent with the fragments
+    uint32_t remaining_length;
+    /// Indicates the payload is encrypted, hence the fragments hold the MAC and the remaining length is not checked
+    uint8_t encrypted;
+    /// Indicates the manifest is checked and the next fragment is expected
+    uint8_t fragment_expected;
+}optiga_util_protected_update_check_t;
+#endif //OPTIGA_UTIL_PROTECTED_UPDATE_CHECK_ENABLED
+
 /** \brief union for OPTIGA util parameters */
 typedef union optiga_util_params
 {
@@ -84,7 +151,100 @@ struct optiga_util
     /// To provide the presentation layer protocol version to be used
     uint8_t protocol_version;
 #endif //OPTIGA_COMMS_SHIELDED_CONNECTION
-
+#ifdef OPTIGA_LIB_SYNC_API_ENABLED
+    /// Wait object on which the caller of synchronous API is blocked
+    pal_os_wait_t sync_wait;
+    /// Status of the operation invoked using synchronous API
+    optiga_lib_status_t sync_status;
+    /// Indicates the ongoing operation is invoked using synchronous API
+    uint8_t sync_ongoing;
+#endif //OPTIGA_LIB_SYNC_API_ENABLED
+    /// Callback which reports the progress of write data
+    optiga_lib_progress_callback_t progress_callback;
+    /// Context for progress callback
+    void * progress_context;
+#ifdef OPTIGA_UTIL_READ_CACHE_ENABLED
+    /// Status of the open application, which is reported once the read cache is preloaded
+    optiga_lib_status_t read_cache_open_status;
+    /// Length of the data object being preloaded
+    uint16_t read_cache_preload_length;
+    /// Entry of the read cache, from which the next data object to be preloaded is searched
+    uint8_t read_cache_preload_index;
+    /// State of the preload of the read cache
+    uint8_t read_cache_preload_state;
+#endif //OPTIGA_UTIL_READ_CACHE_ENABLED
+#ifdef OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+    /// Coprocessor UID, from which the capabilities of OPTIGA are probed
+    uint8_t capability_uid[0x1B];
+    /// Length of the coprocessor UID read
+    uint16_t capability_uid_length;
+    /// State of the probe of the capabilities
+    uint8_t capability_probe_state;
+#endif //OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+#ifdef OPTIGA_UTIL_METADATA_CACHE_ENABLED
+    /// Objects, whose metadata is being loaded into the metadata cache
+    const uint16_t * p_metadata_cache_oids;
+    /// Status of the load, which is reported once the metadata of all the objects is loaded
+    optiga_lib_status_t metadata_cache_load_status;
+    /// Buffer to read the metadata, which is parsed on completion
+    uint8_t metadata_cache_buffer[OPTIGA_UTIL_METADATA_MAX_LENGTH];
+    /// Length of the metadata read
+    uint16_t metadata_cache_length;
+    /// Number of objects to be loaded
+    uint8_t metadata_cache_count;
+    /// Next object to be loaded
+    uint8_t metadata_cache_index;
+    /// Indicates the load of the metadata cache is ongoing
+    uint8_t metadata_cache_load_ongoing;
+#endif //OPTIGA_UTIL_METADATA_CACHE_ENABLED
+#ifdef OPTIGA_UTIL_READ_DATA_MULTIPLE_ENABLED
+    /// Command batch items of the ongoing chunk of the reads
+    optiga_cmd_batch_item_t read_multiple_batch_items[OPTIGA_UTIL_READ_DATA_MULTIPLE_CHUNK_SIZE];
+    /// Parameters of the commands of the ongoing chunk of the reads
+    optiga_get_data_object_params_t read_multiple_params[OPTIGA_UTIL_READ_DATA_MULTIPLE_CHUNK_SIZE];
+    /// Index of the read item of each command of the ongoing chunk
+    uint16_t read_multiple_map[OPTIGA_UTIL_READ_DATA_MULTIPLE_CHUNK_SIZE];
+    /// Items of the reads
+    optiga_util_read_item_t * p_read_multiple_items;
+    /// Number of read items, zero if no read of multiple data objects is ongoing
+    uint16_t read_multiple_count;
+    /// Next item to be read
+    uint16_t read_multiple_index;
+    /// Number of commands of the ongoing chunk
+    uint8_t read_multiple_chunk_count;
+#endif //OPTIGA_UTIL_READ_DATA_MULTIPLE_ENABLED
+#ifdef OPTIGA_UTIL_DIFFERENTIAL_WRITE_ENABLED
+    /// Data of the differential write
+    const uint8_t * p_diff_write_buffer;
+    /// Changed ranges (start and end, relative to the offset of the write) of the differential write
+    uint16_t diff_write_ranges[OPTIGA_UTIL_DIFFERENTIAL_WRITE_MAX_RANGES][2];
+    /// OID of the differential write
+    uint16_t diff_write_oid;
+    /// Offset of the differential write
+    uint16_t diff_write_offset;
+    /// Length of the differential write
+    uint16_t diff_write_length;
+    /// Length of the current data read from OPTIGA for the comparison
+    uint16_t diff_write_read_length;
+    /// Number of changed ranges
+    uint8_t diff_write_range_count;
+    /// Changed range being written
+    uint8_t diff_write_range_index;
+    /// State of the differential write
+    uint8_t diff_write_state;
+#endif //OPTIGA_UTIL_DIFFERENTIAL_WRITE_ENABLED
+#ifdef OPTIGA_UTIL_COUNT_COALESCING_ENABLED
+    /// Counter data object being flushed
+    uint8_t count_flush_index;
+    /// Index after the last counter data object to be flushed, zero if no flush is ongoing
+    uint8_t count_flush_end;
+    /// Increment written by the ongoing update count
+    uint8_t count_flush_value;
+#endif //OPTIGA_UTIL_COUNT_COALESCING_ENABLED
+#ifdef OPTIGA_UTIL_PROTECTED_UPDATE_CHECK_ENABLED
+    /// Check of the protected update, which is applied before the manifest and the fragments are sent (NULL if none)
+    optiga_util_protected_update_check_t * p_protected_update_check;
+#endif //OPTIGA_UTIL_PROTECTED_UPDATE_CHECK_ENABLED
 };
 /** \brief OPTIGA util instance structure type*/
 typedef struct optiga_util optiga_util_t;
@@ -137,47 +297,881 @@ void optiga_util_set_comms_params(optiga_util_t * me,
  *      - Default protection level for this API is #OPTIGA_COMMS_DEFAULT_PROTECTION_LEVEL.
  *      - Default protocol version for this API is #OPTIGA_COMMS_PROTOCOL_VERSION_PRE_SHARED_SECRET.
  *
- * \param[in]   optiga_instance_id    Indicates the OPTIGA instance to be associated with #optiga_util_t. Value should be defined as below
- *                                    - #OPTIGA_INSTANCE_ID_0 : Indicate created instance will be part of OPTIGA with slave address 0x30.
- * \param[in]   handler               Valid pointer to callback function
- * \param[in]   caller_context        Pointer to upper layer context, contains user context data
+ * \param[in]   optiga_instance_id    Indicates the OPTIGA instance to be associated with #optiga_util_t. Value should be defined as below
+ *                                    - #OPTIGA_INSTANCE_ID_0 : Indicate created instance will be part of OPTIGA with slave address 0x30.
+ *                                    - #OPTIGA_INSTANCE_ID_1 : Indicate created instance will be part of second OPTIGA (if configured).
+ *                                    - #OPTIGA_INSTANCE_ID_ANY : Indicate created instance will be part of least loaded OPTIGA.
+ * \param[in]   handler               Valid pointer to callback function
+ * \param[in]   caller_context        Pointer to upper layer context, contains user context data
+ *
+ * \retval      #optiga_util_t        On success function will return pointer of #optiga_util_t
+ * \retval      NULL                Input arguments are NULL.<br>
+ *                                  Low layer function fails.<br>
+ *                                  OPTIGA_CMD_MAX_REGISTRATIONS number of instances are already created.
+ *
+ * <b>Example</b><br>
+ * main_xmc4800_sample.c
+ */
+LIBRARY_EXPORTS optiga_util_t * optiga_util_create(uint8_t optiga_instance_id,
+                                                   callback_handler_t handler,
+                                                   void * caller_context);
+
+/**
+ * \brief De-Initializes the OPTIGA util instance.
+ *
+ *\details
+ * De-Initializes the #optiga_util_t instance.
+ * - De-allocate the memory of the #optiga_util_t instance.
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ *  - User must take care to nullify the instance pointer.
+ *  - Invoke this API only after all the asynchronous process is completed otherwise the behavior of software stack is not defined.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ * \retval     #OPTIGA_UTIL_ERROR_INSTANCE_IN_USE    The previous operation with the same instance is not complete
+ *
+ * <b>Example</b><br>
+ * main_xmc4800_sample.c
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_destroy(optiga_util_t * me);
+
+/**
+ * \brief Sets the priority class of the OPTIGA util instance in command execution queue.
+ *
+ *\details
+ * Sets the priority class of the #optiga_util_t instance in command execution queue.
+ * - Requests of higher priority class are served first, requests of same class in order of arrival.<br>
+ * - A waiting request is promoted by one class for every <b>OPTIGA_CMD_PRIORITY_AGING_TIME_US</b>, to avoid starvation.<br>
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ * - Default priority of an instance is #OPTIGA_LIB_PRIORITY_NORMAL.
+ * - The priority is applied from the next API invocation and remains until changed.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[in]  priority                              Priority class as defined in #optiga_lib_priority_t
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_set_priority(optiga_util_t * me,
+                                                             optiga_lib_priority_t priority);
+
+#ifdef OPTIGA_CMD_DEADLINE_ENABLED
+/**
+ * \brief Sets the deadline of the operations of the OPTIGA util instance in command execution queue.
+ *
+ *\details
+ * Sets the deadline of the operations of the #optiga_util_t instance in command execution queue.
+ * - An operation, which is still waiting in the queue deadline_us after its invocation, is dropped without being
+ *   sent to OPTIGA.<br>
+ * - The callback of the dropped operation is invoked with #OPTIGA_CMD_ERROR_DEADLINE_EXPIRED.<br>
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ * - Default is no deadline (0), the operations wait till they are served.
+ * - The deadline is applied from the next API invocation and remains until changed.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[in]  deadline_us                           Deadline in microseconds after the invocation, 0 for no deadline
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_set_deadline(optiga_util_t * me,
+                                                             uint32_t deadline_us);
+#endif //OPTIGA_CMD_DEADLINE_ENABLED
+
+#ifdef OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+/**
+ * \brief Marks the operations of the OPTIGA util instance as deferrable, while the application is hibernated.
+ *
+ *\details
+ * Sets the maximum delay, for which the operations of the #optiga_util_t instance wait for a restore of the application
+ * hibernated by the auto hibernate (refer #optiga_util_set_auto_hibernate).
+ * - A deferrable operation (e.g. a counter update or a metadata read) does not wake OPTIGA. It is served once an
+ *   operation, which is not deferrable, restores the application, or once its maximum delay elapses.<br>
+ * - All the deferrable operations waiting are served after the same restore, hence the restore is paid once for them.<br>
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ * - Default is 0, the operations are not deferrable.
+ * - The maximum delay is applied from the next API invocation and remains until changed.
+ * - While the application is open, the deferrable operations are served without delay.
+ * - The number of deferred operations is retrieved using #optiga_util_get_auto_hibernate_stats.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[in]  max_delay_ms                          Maximum delay in milliseconds, 0 if not deferrable
+ *                                                   - Must not be greater than #OPTIGA_CMD_AUTO_HIBERNATE_MAX_IDLE_TIME_MS.
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_set_deferrable(optiga_util_t * me,
+                                                               uint32_t max_delay_ms);
+#endif //OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+
+#ifdef OPTIGA_CMD_CANCEL_ENABLED
+/**
+ * \brief Cancels the ongoing operation of the OPTIGA util instance.
+ *
+ *\details
+ * Cancels the ongoing operation of the #optiga_util_t instance.
+ * - An operation, which is waiting in the command execution queue, is dropped without being sent to OPTIGA.<br>
+ * - The result of an operation, which is sent to OPTIGA already, is discarded once OPTIGA responds.<br>
+ * - The callback of the cancelled operation is invoked with #OPTIGA_CMD_ERROR_CANCELLED.<br>
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode, the operation is completed later through the callback.
+ * - A write operation, which is sent to OPTIGA already, may still be applied to the data object.
+ * - The API has no effect, if no operation is ongoing.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_cancel(optiga_util_t * me);
+#endif //OPTIGA_CMD_CANCEL_ENABLED
+
+#ifdef OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+/**
+ * \brief Sets the maximum time, for which a multi-step sequence keeps OPTIGA between two of its steps.
+ *
+ *\details
+ * Sets the hold time of the strict locks of the OPTIGA associated with the instance, which applies to all the
+ * instances of the OPTIGA (util and crypt).
+ * - A sequence with the context in OPTIGA (e.g. #optiga_crypt_hash_start with the context kept in OPTIGA, symmetric
+ *   or HMAC start, continue and final, protected update) holds a strict lock, which makes the further requests
+ *   wait till the sequence is finalized.
+ * - Once a step of such a sequence is completed, the next step must be sent within the hold time, if further
+ *   requests wait. Otherwise the strict lock is revoked and the waiting requests are served, hence a slow streaming
+ *   caller does not block the latency critical operations of the other instances.
+ * - The next continue or final of the revoked sequence completes with #OPTIGA_CMD_ERROR_STRICT_LOCK_REVOKED.
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ * - Default is 0, the strict lock is held till the sequence is finalized.
+ * - Sequences with the hash context exported to host memory release the lock after each step and are not affected.
+ *   This is the yielding alternative for a caller, which is slow to provide the next chunk.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[in]  max_hold_time_ms                      Hold time in milliseconds (up to 3600000), 0 to hold till the final
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_set_strict_lock_timeout(optiga_util_t * me,
+                                                                        uint32_t max_hold_time_ms);
+#endif //OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+
+#ifdef OPTIGA_CMD_FAIR_SHARE_ENABLED
+/**
+ * \brief Sets the tenant of the OPTIGA util instance, among which OPTIGA is shared.
+ *
+ *\details
+ * Sets the tenant, to which the operations of the #optiga_util_t instance are accounted.
+ * - Within a priority class, the requests of the tenant are served first, which has consumed the least OPTIGA time
+ *   relative to its weight. Hence a tenant with a long running bulk operation does not take most of the OPTIGA time
+ *   from the further tenants.<br>
+ * - The OPTIGA time of each command is measured from sending of the command till the reception of the response.<br>
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ * - Default tenant of an instance is 0, which also accounts the internal requests (e.g. auto hibernate).
+ * - The tenant is applied from the next API invocation and remains until changed.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[in]  tenant                                Tenant, less than OPTIGA_CMD_FAIR_SHARE_MAX_TENANTS
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_set_tenant(optiga_util_t * me,
+                                                           uint8_t tenant);
+
+/**
+ * \brief Sets the weight of a tenant, among which OPTIGA is shared.
+ *
+ *\details
+ * Sets the weight of a tenant of the OPTIGA associated with the instance, which applies to all the instances
+ * (util and crypt) of the tenant.
+ * - While several tenants wait, each tenant is served with the share weight / sum of the weights of the
+ *   waiting tenants of the OPTIGA time, e.g. a tenant of weight 3 gets three times the OPTIGA time of a tenant
+ *   of weight 1.<br>
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ * - Default weight of each tenant is #OPTIGA_CMD_FAIR_SHARE_DEFAULT_WEIGHT, a weight of 0 sets the default weight.
+ * - The priority classes are served before the fair sharing, which applies within a priority class.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[in]  tenant                                Tenant, less than OPTIGA_CMD_FAIR_SHARE_MAX_TENANTS
+ * \param[in]  weight                                Weight of the tenant
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_set_tenant_weight(optiga_util_t * me,
+                                                                  uint8_t tenant,
+                                                                  uint8_t weight);
+
+/**
+ * \brief Retrieves the weight and the consumed OPTIGA time of a tenant.
+ *
+ *\details
+ * Retrieves the weight, the number of served requests and commands and the accumulated OPTIGA time of a tenant
+ * of the OPTIGA associated with the instance.
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[in]  tenant                                Tenant, less than OPTIGA_CMD_FAIR_SHARE_MAX_TENANTS
+ * \param[out] p_stats                               Valid pointer to store the statistics
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_get_tenant_stats(optiga_util_t * me,
+                                                                 uint8_t tenant,
+                                                                 optiga_lib_tenant_stats_t * p_stats);
+#endif //OPTIGA_CMD_FAIR_SHARE_ENABLED
+
+#ifdef OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+/**
+ * \brief Checks, whether an operation of the OPTIGA util instance is served within the maximum waiting time.
+ *
+ *\details
+ * Estimates the waiting time in the command execution queue of an operation, which is invoked now.
+ * - Each request in the queue and the request in service is assumed to take the average service time, which is
+ *   measured from the dispatch of a request till the release of its slot.<br>
+ * - Hence a caller learns about the load before invoking the operation, instead of retrying on
+ *   #OPTIGA_UTIL_ERROR_INSTANCE_IN_USE.<br>
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ * - No operation is queued, the caller invokes the operation if admitted or sheds the load otherwise.
+ * - The estimate does not consider the priority class of the instance.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[in]  max_wait_us                           Maximum waiting time of the operation in microseconds
+ * \param[out] p_estimated_wait_us                   Pointer to store the estimated waiting time, can be NULL
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Estimated waiting time is within the maximum waiting time
+ * \retval     #OPTIGA_UTIL_ERROR_QUEUE_FULL         Estimated waiting time exceeds the maximum waiting time
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_try_admit(const optiga_util_t * me,
+                                                          uint32_t max_wait_us,
+                                                          uint32_t * p_estimated_wait_us);
+
+/**
+ * \brief Sets the watermarks of the command execution queue and the callback, which reports their crossing.
+ *
+ *\details
+ * Sets the watermarks of the number of requests waiting in the command execution queue of the OPTIGA associated
+ * with the instance.
+ * - The callback is invoked with is_high TRUE, once the waiting requests reach the high watermark.<br>
+ * - The callback is invoked with is_high FALSE, once the waiting requests fall back to the low watermark.<br>
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ * - The callback is invoked in the context of the command scheduler, hence it must return without waiting for OPTIGA.
+ * - A NULL callback disables the watermarks.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[in]  high_watermark                        Waiting requests reporting the high load, at most OPTIGA_CMD_MAX_REGISTRATIONS
+ * \param[in]  low_watermark                         Waiting requests reporting the normal load, less than high_watermark
+ * \param[in]  callback                              Watermark callback, NULL to disable
+ * \param[in]  context                               Context passed to the callback
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_set_queue_watermark(const optiga_util_t * me,
+                                                                    uint8_t high_watermark,
+                                                                    uint8_t low_watermark,
+                                                                    optiga_lib_queue_watermark_callback_t callback,
+                                                                    void * context);
+
+/**
+ * \brief Retrieves the load of the command execution queue.
+ *
+ *\details
+ * Retrieves the waiting requests, the free slots for further instances, the average service time, the estimated
+ * waiting time and the number of rejected operations of the OPTIGA associated with the instance.
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[out] p_load                                Valid pointer to store the load
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_get_queue_load(const optiga_util_t * me,
+                                                               optiga_lib_queue_load_t * p_load);
+#endif //OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+
+/**
+ * \brief Retrieves the waiting time statistics of a priority class in command execution queue.
+ *
+ *\details
+ * Retrieves the number of served requests, accumulated and maximum waiting time of a priority class
+ * in the command execution queue of the OPTIGA associated with the instance.
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[in]  priority                              Priority class as defined in #optiga_lib_priority_t
+ * \param[out] p_stats                               Valid pointer to store the statistics
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_get_queue_wait_stats(optiga_util_t * me,
+                                                                     optiga_lib_priority_t priority,
+                                                                     optiga_lib_queue_wait_stats_t * p_stats);
+
+#ifdef OPTIGA_COMMS_DL_RESEND_BACKOFF_ENABLED
+/**
+ * \brief Retrieves the error recovery statistics of the communication with OPTIGA.
+ *
+ *\details
+ * Retrieves the number of corrupted, not acknowledged and timed out frames, the number of resynchronizations
+ * and the time spent in error recovery of the communication with the OPTIGA associated with the instance.
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[out] p_stats                               Valid pointer to store the statistics
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_get_comms_recovery_stats(optiga_util_t * me,
+                                                                         optiga_lib_comms_recovery_stats_t * p_stats);
+#endif
+
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+/**
+ * \brief Retrieves the runtime statistics of the OPTIGA associated with the instance.
+ *
+ *\details
+ * Retrieves the statistics, which are accumulated since the start of the host application.
+ * - Number of executions, failures and minimum, average and maximum latency of each command code.
+ * - Current and maximum number of requests waiting in the execution queue.
+ * - Retransmitted frames, resynchronizations, chaining errors and decryption failures of the communication.
+ * - Time, for which OPTIGA was busy executing the commands.
+ * - Duty cycle of OPTIGA: time executing, in I2C transfers, idle awake and hibernated, the number of resets,
+ *   hibernates and restores (e.g. to tune the auto hibernate, the polling and the current limitation in 0xE0C4).
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ * - The statistics are shared by all the instances of the same OPTIGA.
+ * - Idle awake time includes the time, which OPTIGA spends in its own sleep mode (see sleep activation delay).
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[out] p_stats                               Valid pointer to store the statistics
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_get_statistics(optiga_util_t * me,
+                                                               optiga_lib_statistics_t * p_stats);
+#endif
+
+#ifdef OPTIGA_LIB_FAST_RESUME_ENABLED
+/**
+ * \brief Retrieves the latency statistics of the application restore from hibernate.
+ *
+ *\details
+ * Retrieves the number of successful and failed restores, the latency of the last restore including its part spent in
+ * the power up and negotiation of the communication, the accumulated and maximum latency of the restores of the
+ * OPTIGA associated with the instance.
+ * - A restore is measured from the start of the communication until the application is restored,
+ *   using #optiga_util_open_application with perform_restore.
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[out] p_stats                               Valid pointer to store the statistics
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_get_resume_stats(optiga_util_t * me,
+                                                                 optiga_lib_resume_stats_t * p_stats);
+#endif
+
+#ifdef OPTIGA_CMD_HEALTH_MONITOR_ENABLED
+/**
+ * \brief Retrieves the statistics of the recovery of OPTIGA from communication failures.
+ *
+ *\details
+ * Retrieves the number of successful and failed recoveries, the number of soft and warm resets and the time of the
+ * last recovery of the OPTIGA associated with the instance.
+ * - A command, which fails since OPTIGA does not respond for OPTIGA_COMMS_UNRESPONSIVE_TIME_MS, is followed by
+ *   the soft reset (warm reset, if the soft reset fails) and the open of the application. Only a read of a data
+ *   object or of random data is resent, since OPTIGA might have executed the command. The failure of the other
+ *   commands is reported, the queued requests are served after the recovery.
+ * - The reset discards the sessions and the shielded connection session on OPTIGA, hence the commands which depend
+ *   on them might still fail after the recovery.
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[out] p_stats                               Valid pointer to store the statistics
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_get_health_stats(optiga_util_t * me,
+                                                                 optiga_lib_health_stats_t * p_stats);
+#endif
+
+#ifdef OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+/**
+ * \brief Sets the idle time, after which the application on OPTIGA is hibernated automatically.
+ *
+ *\details
+ * Sets the idle time of the command queue of the OPTIGA associated with the instance.
+ * - Once no command is queued or executed for the idle time, the application is hibernated.
+ * - The application is restored on the next command of any instance, before the command is executed.
+ *   Hence the caller need not close and open the application around idle periods.
+ * - If the restore fails, the application is opened with a fresh context, hence the session contexts and
+ *   the shielded connection session are lost in that case.
+ *
+ *\pre
+ * - The application on OPTIGA must be opened using #optiga_util_open_application.
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ * - The hibernate and restore are executed with an internal instance, which is created on first use
+ *   and occupies one registration of the command queue.
+ * - Use #optiga_util_get_auto_hibernate_stats to observe the idle time, the hibernates and the restore latency.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[in]  idle_time_ms                          Idle time in milliseconds, 0 disables the auto hibernate.
+ *                                                   - Must not be greater than #OPTIGA_CMD_AUTO_HIBERNATE_MAX_IDLE_TIME_MS.
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ * \retval     #OPTIGA_UTIL_ERROR                    Creation of the internal instance failed
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_set_auto_hibernate(optiga_util_t * me,
+                                                                   uint32_t idle_time_ms);
+
+/**
+ * \brief Retrieves the statistics of the auto hibernate.
+ *
+ *\details
+ * Retrieves the configured idle time, the number of successful and failed hibernates and restores,
+ * the latency of the last restore and the maximum latency of the restores of the OPTIGA associated with the instance.
+ * - A restore is measured from the start of the restore until the application is restored.
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[out] p_stats                               Valid pointer to store the statistics
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_get_auto_hibernate_stats(optiga_util_t * me,
+                                                                         optiga_lib_auto_hibernate_stats_t * p_stats);
+
+#ifdef OPTIGA_CMD_LAZY_OPEN_ENABLED
+/**
+ * \brief Enables the open of the application on OPTIGA on the first operation.
+ *
+ *\details
+ * Enables the lazy open of the OPTIGA associated with the instance.
+ * - While the application is not opened, the first operation of any util or crypt instance opens the communication
+ *   and the application with a clean context, before the operation is executed.
+ *   Hence #optiga_util_open_application need not be invoked at startup.
+ * - With pre-open, the application is opened right away in the background, hence the startup is not blocked and the
+ *   first operation does not wait for the complete open.
+ * - An #optiga_util_open_application or #optiga_util_close_application invoked by the caller is executed as it is,
+ *   e.g. to restore a hibernated application.
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ * - The open is executed with the internal instance of the auto hibernate, which is created on first use
+ *   and occupies one registration of the command queue.
+ * - If the open fails, the waiting operations fail. The open is tried again with the next operation.
+ * - The data objects registered for the read cache preload are not preloaded by the lazy open.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[in]  enable                                TRUE to enable, FALSE to disable the lazy open.
+ * \param[in]  pre_open                              TRUE to open the application in the background right away.
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ * \retval     #OPTIGA_UTIL_ERROR                    Creation of the internal instance failed
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_set_lazy_open(optiga_util_t * me,
+                                                              bool_t enable,
+                                                              bool_t pre_open);
+#endif //OPTIGA_CMD_LAZY_OPEN_ENABLED
+
+#ifdef OPTIGA_CMD_PERFORMANCE_GOVERNOR_ENABLED
+/**
+ * \brief Sets the policy of the performance governor, which manages the current limitation of OPTIGA at runtime.
+ *
+ *\details
+ * Sets the policy, with which the command scheduler writes the current limitation (0xE0C4) of the OPTIGA associated
+ * with the instance, instead of a current limitation set once at provisioning.
+ * - Once the number of requests waiting in the command queue reaches the burst queue depth (e.g. a burst of TLS
+ *   handshakes or provisioning), the burst current limitation is written, before the waiting requests are served.
+ * - Once no command is queued or executed for the idle time, the idle current limitation is written.
+ * - Both are bounded by the power budget set using #optiga_util_set_power_budget.
+ * - The current limitation is stored in NVM of OPTIGA, hence a further write is done not earlier than the hold time
+ *   after the last write. Only a current limitation above a lowered power budget is dropped right away.
+ *
+ *\pre
+ * - The application on OPTIGA must be opened using #optiga_util_open_application.
+ * - The access condition for change of 0xE0C4 must be satisfied without a session or protection (e.g. ALW).
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ * - The writes are executed with the internal instance of the auto hibernate, which is created on first use
+ *   and occupies one registration of the command queue.
+ * - A current limitation, whose write failed, is not written again until another current limitation is written.
+ * - Use #optiga_util_get_performance_stats to observe the current limitation and the number of writes.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[in]  p_policy                              Policy of the governor, NULL disables the governor.
+ *                                                   - The current limitations must be within 6 - 15 mA and the burst
+ *                                                     queue depth must not be 0.
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ * \retval     #OPTIGA_UTIL_ERROR                    Creation of the internal instance failed
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_set_performance_policy(optiga_util_t * me,
+                                                                       const optiga_lib_performance_policy_t * p_policy);
+
+/**
+ * \brief Sets the power budget of the host, which bounds the current limitation written by the performance governor.
+ *
+ *\details
+ * Sets the maximum current limitation of the OPTIGA associated with the instance.
+ * - A current limitation above the power budget is dropped to the power budget with the next scheduler run.
+ * - The burst and idle current limitations of the policy are bounded by the power budget.
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[in]  max_current_limit                     Maximum current limitation in mA (6 - 15), 0 removes the power budget.
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_set_power_budget(optiga_util_t * me,
+                                                                 uint8_t max_current_limit);
+
+/**
+ * \brief Retrieves the state and statistics of the performance governor.
+ *
+ *\details
+ * Retrieves the current limitation written by the governor, the power budget and the number of raises, drops
+ * and failed writes of the current limitation of the OPTIGA associated with the instance.
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[out] p_stats                               Valid pointer to store the statistics
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_get_performance_stats(optiga_util_t * me,
+                                                                      optiga_lib_performance_stats_t * p_stats);
+#endif //OPTIGA_CMD_PERFORMANCE_GOVERNOR_ENABLED
+
+#ifdef OPTIGA_CMD_SEC_PACING_ENABLED
+/**
+ * \brief Sets the policy of the pacing of the operations, which raise the security event counter (SEC) on a failure.
+ *
+ *\details
+ * Sets the policy, with which the command scheduler tracks the SEC (0xE0C5) of the OPTIGA associated with the instance
+ * and paces the SEC raising requests, so that OPTIGA is kept out of the delays it applies at a high SEC.
+ * - The SEC is read, once the policy is set and after each failed SEC raising command. In between, the SEC is
+ *   estimated from the last read SEC, decreased by one with each decay time.
+ * - The SEC raising requests are the HMAC verification (#optiga_crypt_hmac_verify, DecryptSym) and the start of a
+ *   protected update (SetObjectProtected). While the estimated SEC is at or above the pacing threshold, they wait in
+ *   the command queue and the further requests are served first.
+ * - While a SEC raising request waits, the SEC is read again after the refresh time, which corrects the estimate.
+ *
+ *\pre
+ * - The application on OPTIGA must be opened using #optiga_util_open_application.
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ * - The reads are executed with the internal instance of the auto hibernate, which is created on first use
+ *   and occupies one registration of the command queue.
+ * - The continue and final of an ongoing protected update hold the strict lock and are not paced.
+ * - Use #optiga_util_get_sec_stats to observe the estimated SEC and the paced requests.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[in]  p_policy                              Policy of the pacing, NULL disables the pacing.
+ *                                                   - The decay time must not be 0, if the pacing threshold is not 0.
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ * \retval     #OPTIGA_UTIL_ERROR                    Creation of the internal instance failed
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_set_sec_policy(optiga_util_t * me,
+                                                               const optiga_lib_sec_policy_t * p_policy);
+
+/**
+ * \brief Retrieves the state and statistics of the SEC pacing.
+ *
+ *\details
+ * Retrieves the estimated and the last read security event counter, the number of reads, of failed SEC raising
+ * commands and of paced requests of the OPTIGA associated with the instance.
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[out] p_stats                               Valid pointer to store the statistics
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_get_sec_stats(optiga_util_t * me,
+                                                              optiga_lib_sec_stats_t * p_stats);
+#endif //OPTIGA_CMD_SEC_PACING_ENABLED
+#endif
+
+#ifdef OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+/**
+ * \brief Retrieves the capabilities of the OPTIGA associated with the instance.
+ *
+ *\details
+ * Retrieves the capabilities, which are probed from the ESW build number in the coprocessor UID (0xE0C2) on the first
+ * #optiga_util_open_application of the OPTIGA.
+ * - OPTIGA Trust M V3 (build number from #OPTIGA_LIB_CAPABILITY_M_V3_MIN_BUILD_NUMBER) has #OPTIGA_LIB_CAPABILITIES_M_V3.<br>
+ * - The crypt APIs, which require a capability not supported, fail with #OPTIGA_CRYPT_ERROR_UNSUPPORTED without
+ *   sending a command, hence the application can pick its path (e.g. HMAC on OPTIGA or on host) at runtime.<br>
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ * - The features are compiled in with the configuration of OPTIGA Trust M V3, which runs on OPTIGA Trust M V1 also.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[out] p_capabilities                        Valid pointer to store the capabilities along with
+ *                                                   #OPTIGA_LIB_CAPABILITY_PROBED, 0 if OPTIGA is not yet probed
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_get_capabilities(const optiga_util_t * me,
+                                                                 uint32_t * p_capabilities);
+#endif //OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+
+#ifdef OPTIGA_UTIL_READ_CACHE_ENABLED
+/**
+ * \brief Registers a data object in the read cache, which serves the repeated reads from host memory.
+ *
+ *\details
+ * Registers a data object in the read cache of the OPTIGA associated with the instance.
+ * - The data read from offset 0 of the data object using #optiga_util_read_data is cached, up to
+ *   #OPTIGA_UTIL_READ_CACHE_MAX_OBJECT_SIZE bytes. Later reads of the cached data are served from host memory,
+ *   without any command to OPTIGA.
+ * - The cached data is dropped, when the data object or its metadata is written (e.g. #optiga_util_write_data,
+ *   #optiga_util_write_metadata), and all the cached data is dropped with the protected update.
+ * - If preload is TRUE, the data object is read with the next #optiga_util_open_application, before its
+ *   completion is reported. A failed preload is not reported, the data object is read from OPTIGA on demand.
+ * - The read cache is shared by the instances of the same OPTIGA.
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ * - Register only data objects, which are not updated by OPTIGA itself (e.g. device certificate, trust anchors,
+ *   coprocessor UID), but not counters or the security event counter.
+ * - Cached data is served regardless of the read access condition and the protection level of the read.
+ * - With #OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED, the data read by one process is served to the other processes,
+ *   which registered the same data object, and a write by any process drops the data cached by all of them.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[in]  optiga_oid                            OID of data object
+ * \param[in]  preload                               TRUE, to read the data object with the next open application
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ * \retval     #OPTIGA_UTIL_ERROR_MEMORY_INSUFFICIENT No free entry in the read cache (#OPTIGA_UTIL_READ_CACHE_SIZE)
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_read_cache_register(optiga_util_t * me,
+                                                                    uint16_t optiga_oid,
+                                                                    bool_t preload);
+
+/**
+ * \brief Unregisters a data object from the read cache.
+ *
+ *\details
+ * Unregisters a data object from the read cache and drops its cached data.
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[in]  optiga_oid                            OID of data object, 0x0000 unregisters all the data objects
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided or data object is not registered
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_read_cache_unregister(optiga_util_t * me,
+                                                                      uint16_t optiga_oid);
+#endif
+
+#ifdef OPTIGA_UTIL_METADATA_CACHE_ENABLED
+/**
+ * \brief Loads the metadata of the objects from OPTIGA into the metadata cache.
+ *
+ *\details
+ * Reads the metadata of the objects, which is not cached yet, and caches its parsed view
+ * (#optiga_lib_metadata_info_t: maximum size, used size, change/read/execute access conditions, LcsO, data object type).
+ * - The metadata read using #optiga_util_read_metadata is cached as well.
+ * - The cached metadata is dropped, when the object or its metadata is written (e.g. #optiga_util_write_data,
+ *   #optiga_util_write_metadata), and all the cached metadata is dropped with the protected update.
+ * - The metadata cache holds up to #OPTIGA_UTIL_METADATA_CACHE_SIZE objects, the oldest entry is replaced first.
+ * - The metadata cache is shared by the instances of the same OPTIGA.
+ *
+ *\pre
+ * - The application on OPTIGA must be opened using #optiga_util_open_application before using this API.
  *
- * \retval      #optiga_util_t        On success function will return pointer of #optiga_util_t
- * \retval      NULL                Input arguments are NULL.<br>
- *                                  Low layer function fails.<br>
- *                                  OPTIGA_CMD_MAX_REGISTRATIONS number of instances are already created.
+ *\note
+ * - The metadata of all the objects is loaded, even if the read of some fails. The first failure is reported.
+ * - The list of objects must be valid until the operation is completed.
+ * - If the metadata of all the objects is cached, the callback handler is invoked before this API returns.
  *
- * <b>Example</b><br>
- * main_xmc4800_sample.c
+ * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[in]  p_optiga_oids                         List of OIDs of the objects
+ * \param[in]  count                                 Number of OIDs in the list, must not be 0
+ *
+ * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
+ * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
+ * \retval     #OPTIGA_UTIL_ERROR_INSTANCE_IN_USE    The previous operation with the same instance is not complete
  */
-LIBRARY_EXPORTS optiga_util_t * optiga_util_create(uint8_t optiga_instance_id,
-                                                   callback_handler_t handler,
-                                                   void * caller_context);
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_metadata_cache_load(optiga_util_t * me,
+                                                                    const uint16_t * p_optiga_oids,
+                                                                    uint8_t count);
 
 /**
- * \brief De-Initializes the OPTIGA util instance.
+ * \brief Retrieves the parsed metadata of an object from the metadata cache.
  *
  *\details
- * De-Initializes the #optiga_util_t instance.
- * - De-allocate the memory of the #optiga_util_t instance.
+ * Retrieves the parsed metadata of an object, without any command to OPTIGA.
+ * - Object lookups and access policy checks can be done using the cached view, instead of reading and parsing the metadata.
  *
  *\pre
  * - None
  *
  *\note
- *  - User must take care to nullify the instance pointer.
- *  - Invoke this API only after all the asynchronous process is completed otherwise the behavior of software stack is not defined.
+ * - This API is implemented in synchronous mode.
+ * - If the metadata is not cached, load it using #optiga_util_metadata_cache_load or #optiga_util_read_metadata.
  *
  * \param[in]  me                                    Valid instance of #optiga_util_t
+ * \param[in]  optiga_oid                            OID of the object
+ * \param[out] p_info                                Valid pointer to store the parsed metadata
  *
  * \retval     #OPTIGA_LIB_SUCCESS                   Successful invocation
  * \retval     #OPTIGA_UTIL_ERROR_INVALID_INPUT      Wrong Input arguments provided
- * \retval     #OPTIGA_UTIL_ERROR_INSTANCE_IN_USE    The previous operation with the same instance is not complete
- *
- * <b>Example</b><br>
- * main_xmc4800_sample.c
+ * \retval     #OPTIGA_UTIL_ERROR                    Metadata of the object is not cached
  */
-LIBRARY_EXPORTS optiga_lib_status_t optiga_util_destroy(optiga_util_t * me);
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_metadata_cache_get(optiga_util_t * me,
+                                                                   uint16_t optiga_oid,
+                                                                   optiga_lib_metadata_info_t * p_info);
+#endif
 
 /**
  * \brief Initializes the communication with optiga and open the application on OPTIGA.
@@ -266,6 +1260,8 @@ LIBRARY_EXPORTS optiga_lib_status_t optiga_util_close_application(optiga_util_t
  * - Error codes from lower layers will be returned as it is.
  * - The maximum value of the <b>*length</b> parameter must be the size of buffer <b>buffer</b>. In case the value is greater than buffer size, memory corruption can occur.<br>
  * - If any errors occur while retrieving the data, <b>*length</b> parameter is set to 0.
+ * - If the data object is registered using #optiga_util_read_cache_register and its data is cached, the read is served
+ *   from host memory and the callback handler is invoked before this API returns.
  *
  * \param[in]      me                                     Valid instance of #optiga_util_t created using #optiga_util_create.
  * \param[in]      optiga_oid                             OID of data object
@@ -329,6 +1325,85 @@ LIBRARY_EXPORTS optiga_lib_status_t optiga_util_read_metadata(optiga_util_t * me
                                                               uint8_t * buffer,
                                                               uint16_t * length);
 
+/**
+ * \brief Reads data from optiga and streams it to a callback.
+ *
+ *\details
+ * Retrieves the requested data that is stored in the user provided data object, chunk wise.<br>
+ * - Invokes #optiga_cmd_get_data_object API and based on the input arguments, read the data from the data object.
+ * - Each chunk is delivered to the stream callback as soon as it is received, hence no buffer for the complete data is required.
+ * - Completion is notified by the callback handler registered with the instance, after the last chunk is delivered.
+ *
+ *\pre
+ * - The application on OPTIGA must be opened using #optiga_util_open_application before using this API.
+ *
+ *\note
+ * - For <b>protected I2C communication</b>, Refer #OPTIGA_UTIL_SET_COMMS_PROTECTION_LEVEL
+ * - Error codes from lower layers will be returned as it is.
+ * - The chunk is valid only during the stream callback, which is invoked in the context of OPTIGA events (Refer pal_os_event.h).
+ * - If any errors occur while retrieving the data, <b>*length</b> parameter is set to 0.
+ *
+ * \param[in]      me                                     Valid instance of #optiga_util_t created using #optiga_util_create.
+ * \param[in]      optiga_oid                             OID of data object
+ *                                                        - It should be a valid data object, otherwise OPTIGA returns an error.<br>
+ * \param[in]      offset                                 Offset from within data object
+ *                                                        - It must be valid offset from within data object, otherwise OPTIGA returns an error.<br>
+ * \param[in]      stream_callback                        Valid pointer to the callback, which receives the chunks
+ * \param[in]      stream_context                         Context provided to the stream callback
+ * \param[in,out]  length                                 Valid pointer to the maximum length of data to be read from data object
+ *                                                        - When the data is successfully retrieved, it is updated with actual data length retrieved
+ *
+ * \retval         #OPTIGA_UTIL_SUCCESS                   Successful invocation
+ * \retval         #OPTIGA_UTIL_ERROR_INVALID_INPUT       Wrong Input arguments provided
+ * \retval         #OPTIGA_UTIL_ERROR_INSTANCE_IN_USE     The previous operation with the same instance is not complete
+ * \retval         #OPTIGA_DEVICE_ERROR                   Command execution failure in OPTIGA and the LSB indicates the error code.
+ *                                                        (Refer Solution Reference Manual)
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_read_data_stream(optiga_util_t * me,
+                                                                 uint16_t optiga_oid,
+                                                                 uint16_t offset,
+                                                                 optiga_lib_stream_callback_t stream_callback,
+                                                                 void * stream_context,
+                                                                 uint16_t * length);
+
+#ifdef OPTIGA_UTIL_READ_DATA_MULTIPLE_ENABLED
+/**
+ * \brief Reads the data or metadata of several data objects from optiga.
+ *
+ *\details
+ * Reads the data objects of the items, e.g. UID, certificates and counters of an inventory at startup.<br>
+ * - Reads the items in chunks of #OPTIGA_UTIL_READ_DATA_MULTIPLE_CHUNK_SIZE, using #optiga_cmd_execute_batch.
+ *   The reads of a chunk are issued back to back under one acquisition of the lock, and the data objects larger
+ *   than the communication buffer are read in several commands as with #optiga_util_read_data.<br>
+ * - The data objects cached in the read cache (Refer #optiga_util_read_cache_register) are served from host memory.<br>
+ * - A failure of a read reported by OPTIGA does not stop the reads, the length of the respective item is set to 0.<br>
+ * - Completion is notified by the callback handler registered with the instance, once all the items are read.
+ *
+ *\pre
+ * - The application on OPTIGA must be opened using #optiga_util_open_application before using this API.
+ *
+ *\note
+ * - For <b>protected I2C communication</b>, Refer #OPTIGA_UTIL_SET_COMMS_PROTECTION_LEVEL.
+ *   The protection level applies to the reads of all the items.
+ * - The items and the buffers must be valid until the operation is completed.
+ * - The callback handler is invoked with #OPTIGA_LIB_SUCCESS, if all the items are read successfully.
+ *   Otherwise it is invoked with the status of the first failed item, the status of each item is updated.
+ * - If the reads are aborted due to a failure of the communication, the remaining items get the failure status.
+ * - If all the items are served from the read cache, the callback handler is invoked before this API returns.
+ *
+ * \param[in]      me                                     Valid instance of #optiga_util_t created using #optiga_util_create.
+ * \param[in,out]  items                                  Valid pointer to the array of items
+ * \param[in]      item_count                             Number of items, must not be 0
+ *
+ * \retval         #OPTIGA_UTIL_SUCCESS                   Successful invocation
+ * \retval         #OPTIGA_UTIL_ERROR_INVALID_INPUT       Wrong Input arguments provided
+ * \retval         #OPTIGA_UTIL_ERROR_INSTANCE_IN_USE     The previous operation with the same instance is not complete
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_read_data_multiple(optiga_util_t * me,
+                                                                   optiga_util_read_item_t * items,
+                                                                   uint16_t item_count);
+#endif //OPTIGA_UTIL_READ_DATA_MULTIPLE_ENABLED
+
 /**
  * \brief Writes data to optiga.
  *
@@ -344,11 +1419,17 @@ LIBRARY_EXPORTS optiga_lib_status_t optiga_util_read_metadata(optiga_util_t * me
  * - Error codes from lower layers will be returned as it is.<br>
  * - The maximum value of the <b>length parameter</b> is size of <b>buffer</b>. In case the value is greater than buffer size, incorrect values can get written into the data object in OPTIGA.<br>
  * - In case the write_type provided is other than <b>erase and write(0x00)</b> or <b>write only(0x40)</b>, the function returns #OPTIGA_UTIL_ERROR_INVALID_INPUT.<br>
+ * - With #OPTIGA_UTIL_WRITE_DIFFERENTIAL, the data is compared with the current data of the data object, taken from the
+ *   read cache or read from OPTIGA. Only the changed ranges are written at their offsets (as with write only),
+ *   and nothing is written if the data object holds the data already.
+ *   Ranges closer than #OPTIGA_UTIL_DIFFERENTIAL_WRITE_MERGE_GAP bytes are written with one command.
+ *   If the current data cannot be read, the complete data is written.<br>
  *
  * \param[in]      me                                        Valid instance of #optiga_util_t created using #optiga_util_create.
  * \param[in]      optiga_oid                                OID of data object
  *                                                           - It should be a valid data object, otherwise OPTIGA returns an error.<br>
- * \param[in]      write_type                                Type of write must be either #OPTIGA_UTIL_WRITE_ONLY or #OPTIGA_UTIL_ERASE_AND_WRITE.<br>
+ * \param[in]      write_type                                Type of write must be either #OPTIGA_UTIL_WRITE_ONLY, #OPTIGA_UTIL_ERASE_AND_WRITE
+ *                                                           or #OPTIGA_UTIL_WRITE_DIFFERENTIAL.<br>
  * \param[in]      offset                                    Offset from within data object
  *                                                           - It must be valid offset from within data object, otherwise OPTIGA returns an error.<br>
  * \param[in]      buffer                                    Valid pointer to the buffer with user data to write
@@ -370,6 +1451,33 @@ LIBRARY_EXPORTS optiga_lib_status_t optiga_util_write_data(optiga_util_t * me,
                                                            const uint8_t * buffer,
                                                            uint16_t length);
 
+/**
+ * \brief Registers the callback which reports the progress of #optiga_util_write_data.
+ *
+ *\details
+ * Registers the callback which reports the progress of #optiga_util_write_data in the instance.
+ * - Data larger than the communication buffer is written in multiple chunks, by retaining the lock across all the chunks.
+ * - The callback is invoked after each chunk is acknowledged by OPTIGA, with the length written so far.
+ * - The registered callback is used by all the subsequent writes of the instance. Register NULL to stop the reporting.
+ *
+ *\pre
+ * - None
+ *
+ *\note
+ * - The callback is invoked in the context of OPTIGA events (Refer pal_os_event.h).
+ *
+ * \param[in,out]  me                                        Valid instance of #optiga_util_t created using #optiga_util_create.
+ * \param[in]      progress_callback                         Callback which reports the progress, or NULL
+ * \param[in]      progress_context                          Context provided to the progress callback
+ *
+ * \retval         #OPTIGA_UTIL_SUCCESS                      Successful invocation
+ * \retval         #OPTIGA_UTIL_ERROR_INVALID_INPUT          Wrong Input arguments provided
+ * \retval         #OPTIGA_UTIL_ERROR_INSTANCE_IN_USE        The previous operation with the same instance is not complete
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_set_progress_callback(optiga_util_t * me,
+                                                                      optiga_lib_progress_callback_t progress_callback,
+                                                                      void * progress_context);
+
 /**
  * \brief Writes metadata for the user provided data object.
  *
@@ -517,6 +1625,119 @@ LIBRARY_EXPORTS optiga_lib_status_t optiga_util_protected_update_final(optiga_ut
                                                                        const uint8_t * fragment,
                                                                        uint16_t fragment_length);
 
+#ifdef OPTIGA_UTIL_PROTECTED_UPDATE_CHECK_ENABLED
+/**
+ * \brief Initializes the check of a protected update data set on host.
+ *
+ * \details
+ * Initializes the check, which rejects an invalid data set before it is sent to OPTIGA.
+ * - The public key of the trust anchor is held by the caller (e.g. read once from the trust anchor object),
+ *   hence no command is sent to OPTIGA for the check.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ * - The check and the public key must be valid until the protected update is completed.
+ *
+ * \param[in,out]  p_check                                  Pointer to check, must not be NULL.
+ * \param[in]      trust_anchor_oid                         OID of the trust anchor, which must be the key identifier of the manifest.
+ * \param[in]      p_trust_anchor                           Public key of the trust anchor (ECC), NULL to skip the signature check.
+ *
+ * \retval         #OPTIGA_UTIL_SUCCESS                     Successful invocation.
+ * \retval         #OPTIGA_UTIL_ERROR_INVALID_INPUT         Wrong Input arguments provided.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_protected_update_check_init(optiga_util_protected_update_check_t * p_check,
+                                                                           uint16_t trust_anchor_oid,
+                                                                           const public_key_from_host_t * p_trust_anchor);
+
+/**
+ * \brief Checks the manifest of a protected update data set on host.
+ *
+ * \details
+ * Checks the manifest (COSE_Sign1) as it is checked by OPTIGA, without any command to OPTIGA.
+ * - The structure of the manifest, the key identifier and the digest of the first fragment are checked.<br>
+ * - The ES-256 signature is verified with the public key of the trust anchor using the pal crypt library.
+ *   Other signature algorithms (e.g. RSA-SSA-PKCS1-V1_5-SHA-256) are verified only by OPTIGA.<br>
+ * - On success, the digest of the first fragment is expected by #optiga_util_protected_update_check_fragment.
+ *
+ * \pre
+ * - The check must be initialized using #optiga_util_protected_update_check_init.
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in,out]  p_check                                  Pointer to check, must not be NULL.
+ * \param[in]      manifest                                 Manifest, must not be NULL.
+ * \param[in]      manifest_length                          Length of the manifest.
+ *
+ * \retval         #OPTIGA_UTIL_SUCCESS                     The manifest is valid.
+ * \retval         #OPTIGA_UTIL_ERROR_INVALID_INPUT         Wrong Input arguments provided.
+ * \retval         #OPTIGA_UTIL_ERROR_PROTECTED_UPDATE_INVALID  The manifest is not valid.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_protected_update_check_manifest(optiga_util_protected_update_check_t * p_check,
+                                                                               const uint8_t * manifest,
+                                                                               uint16_t manifest_length);
+
+/**
+ * \brief Checks the next fragment of a protected update data set on host.
+ *
+ * \details
+ * Checks the fragment against the digest chain, without any command to OPTIGA.
+ * - The SHA-256 digest of the fragment must match the digest of the manifest or of the previous fragment.<br>
+ * - A fragment, which is not the final fragment, ends with the digest of the next fragment.<br>
+ * - The payload of a fragment, which is not encrypted, must not exceed the size of the payload in the manifest.
+ *   The final fragment must complete it.
+ *
+ * \pre
+ * - The manifest must be checked using #optiga_util_protected_update_check_manifest.
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ * - A rejected fragment ends the check, the manifest must be checked again.
+ *
+ * \param[in,out]  p_check                                  Pointer to check, must not be NULL.
+ * \param[in]      fragment                                 Fragment, must not be NULL.
+ * \param[in]      fragment_length                          Length of the fragment.
+ * \param[in]      final                                    TRUE, if the fragment is the final fragment.
+ *
+ * \retval         #OPTIGA_UTIL_SUCCESS                     The fragment is valid.
+ * \retval         #OPTIGA_UTIL_ERROR_INVALID_INPUT         Wrong Input arguments provided.
+ * \retval         #OPTIGA_UTIL_ERROR_PROTECTED_UPDATE_INVALID  The fragment is not valid or not expected.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_protected_update_check_fragment(optiga_util_protected_update_check_t * p_check,
+                                                                               const uint8_t * fragment,
+                                                                               uint16_t fragment_length,
+                                                                               bool_t final);
+
+/**
+ * \brief Sets the check of the protected updates of the instance.
+ *
+ * \details
+ * Sets the check, which is applied by #optiga_util_protected_update_start, _continue and _final of the instance.
+ * - The manifest and each fragment are checked before they are sent to OPTIGA.
+ *   A rejected manifest or fragment is not sent and #OPTIGA_UTIL_ERROR_PROTECTED_UPDATE_INVALID is returned.<br>
+ * - The check applies to #optiga_util_protected_update_stream_start as well, if set for the util instance of the stream.
+ *
+ * \pre
+ * - The check must be initialized using #optiga_util_protected_update_check_init.
+ *
+ * \note
+ * - If a fragment is rejected, the strict sequence of the protected update is still held.
+ *   It is released using #optiga_util_protected_update_final with NULL fragment, which is not checked.
+ *
+ * \param[in]      me                                       Valid instance of #optiga_util_t created using #optiga_util_create.
+ * \param[in]      p_check                                  Check to be applied, NULL to send the data set unchecked.
+ *
+ * \retval         #OPTIGA_UTIL_SUCCESS                     Successful invocation.
+ * \retval         #OPTIGA_UTIL_ERROR_INVALID_INPUT         Wrong Input arguments provided.
+ * \retval         #OPTIGA_UTIL_ERROR_INSTANCE_IN_USE       The previous operation with the same instance is not complete.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_set_protected_update_check(optiga_util_t * me,
+                                                                          optiga_util_protected_update_check_t * p_check);
+#endif //OPTIGA_UTIL_PROTECTED_UPDATE_CHECK_ENABLED
+
 /**
  * \brief Increments the counter object by a value specified by user.
  *
@@ -550,6 +1771,263 @@ LIBRARY_EXPORTS optiga_lib_status_t optiga_util_update_count(optiga_util_t * me,
                                                              uint16_t optiga_counter_oid,
                                                              uint8_t count);
 
+#ifdef OPTIGA_UTIL_COUNT_COALESCING_ENABLED
+/**
+ * \brief Adds an increment to a counter object, which is written to OPTIGA together with further increments.
+ *
+ *\details
+ * Accumulates the increments of a counter object (0xE120 - 0xE123) on the host and writes their sum with one
+ * update count, instead of one transaction per increment.<br>
+ * - The pending increments are flushed, once they reach #OPTIGA_UTIL_COUNT_COALESCING_THRESHOLD or the first of them is
+ *   older than #OPTIGA_UTIL_COUNT_COALESCING_INTERVAL_MS. Otherwise the increment is only recorded.<br>
+ * - The pending increments are stored to the datastore #OPTIGA_UTIL_PENDING_COUNT_ID every
+ *   #OPTIGA_UTIL_COUNT_COALESCING_SAVE_INTERVAL increments and restored once per OPTIGA, hence at most
+ *   #OPTIGA_UTIL_COUNT_COALESCING_SAVE_INTERVAL - 1 increments are lost on a reset of the host.
+ *   Without the datastore, up to #OPTIGA_UTIL_COUNT_COALESCING_THRESHOLD - 1 increments are lost.<br>
+ *
+ *\pre
+ * - The application on OPTIGA must be opened using #optiga_util_open_application before using this API.<br>
+ *
+ *\note
+ * - The pending increments are not yet accounted by OPTIGA. Flush them with #optiga_util_flush_count before an
+ *   operation, whose access condition refers to the counter object (e.g. the usage of a key limited by the counter).<br>
+ * - The pending increments are shared by all the instances of an OPTIGA. Only the first OPTIGA uses the datastore.<br>
+ * - If the increment is only recorded, the callback handler is invoked with #OPTIGA_LIB_SUCCESS through the scheduler.<br>
+ * - If a flush fails, the increments remain pending and the failure is reported.<br>
+ * - For <b>protected I2C communication</b>, Refer #OPTIGA_UTIL_SET_COMMS_PROTECTION_LEVEL
+ *
+ * \param[in]      me                                        Valid instance of #optiga_util_t created using #optiga_util_create.
+ * \param[in]      optiga_counter_oid                        OID of counter data object (0xE120 - 0xE123)
+ * \param[in]      count                                     Increment to be added
+ *
+ * \retval         #OPTIGA_UTIL_SUCCESS                      Successful invocation
+ * \retval         #OPTIGA_UTIL_ERROR_INVALID_INPUT          Wrong Input arguments provided
+ * \retval         #OPTIGA_UTIL_ERROR_INSTANCE_IN_USE        The previous operation with the same instance is not complete
+ * \retval         #OPTIGA_DEVICE_ERROR                      Command execution failure in OPTIGA and the LSB indicates the error code.
+ *                                                           (Refer Solution Reference Manual)
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_add_count(optiga_util_t * me,
+                                                          uint16_t optiga_counter_oid,
+                                                          uint8_t count);
+
+/**
+ * \brief Writes the pending increments of a counter object to OPTIGA.
+ *
+ *\details
+ * Writes the increments accumulated by #optiga_util_add_count with update count.<br>
+ * - The sum is written with one update count, or one per 255 increments.<br>
+ *
+ *\pre
+ * - The application on OPTIGA must be opened using #optiga_util_open_application before using this API.<br>
+ *
+ *\note
+ * - To be invoked before an operation, whose access condition refers to the counter object, and before the application
+ *   is closed. It can also be invoked periodically, since #optiga_util_add_count checks the interval only when invoked.<br>
+ * - If no increment is pending, the callback handler is invoked with #OPTIGA_LIB_SUCCESS through the scheduler.<br>
+ * - The increments being written by another instance are not written again.<br>
+ * - For <b>protected I2C communication</b>, Refer #OPTIGA_UTIL_SET_COMMS_PROTECTION_LEVEL
+ *
+ * \param[in]      me                                        Valid instance of #optiga_util_t created using #optiga_util_create.
+ * \param[in]      optiga_counter_oid                        OID of counter data object (0xE120 - 0xE123),
+ *                                                           or #OPTIGA_UTIL_COUNTER_OID_ALL
+ *
+ * \retval         #OPTIGA_UTIL_SUCCESS                      Successful invocation
+ * \retval         #OPTIGA_UTIL_ERROR_INVALID_INPUT          Wrong Input arguments provided
+ * \retval         #OPTIGA_UTIL_ERROR_INSTANCE_IN_USE        The previous operation with the same instance is not complete
+ * \retval         #OPTIGA_DEVICE_ERROR                      Command execution failure in OPTIGA and the LSB indicates the error code.
+ *                                                           (Refer Solution Reference Manual)
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_flush_count(optiga_util_t * me,
+                                                            uint16_t optiga_counter_oid);
+#endif //OPTIGA_UTIL_COUNT_COALESCING_ENABLED
+
+#ifdef OPTIGA_LIB_SYNC_API_ENABLED
+/**
+ * \brief Opens the application on OPTIGA and blocks the caller until completion.
+ *
+ * \details
+ * Synchronous variant of #optiga_util_open_application.
+ * - Invokes #optiga_util_open_application and blocks the caller on the PAL wait object of the instance, until the operation is completed.<br>
+ * - The callback handler registered with the instance is not invoked.<br>
+ *
+ * \pre
+ * - Same as #optiga_util_open_application.
+ *
+ * \note
+ * - Must not be invoked from the callback handler or from the context which executes the OPTIGA events (Refer pal_os_event.h).
+ *
+ * \param[in]      me                                     Refer #optiga_util_open_application.
+ * \param[in]      perform_restore                        Refer #optiga_util_open_application.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful completion of the operation.
+ * \retval    Error code                             As returned by #optiga_util_open_application or reported on completion of the operation.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_open_application_sync(optiga_util_t * me,
+                                                                      bool_t perform_restore);
+
+/**
+ * \brief Closes the application on OPTIGA and blocks the caller until completion.
+ *
+ * \details
+ * Synchronous variant of #optiga_util_close_application.
+ * - Invokes #optiga_util_close_application and blocks the caller on the PAL wait object of the instance, until the operation is completed.<br>
+ * - The callback handler registered with the instance is not invoked.<br>
+ *
+ * \pre
+ * - Same as #optiga_util_close_application.
+ *
+ * \note
+ * - Must not be invoked from the callback handler or from the context which executes the OPTIGA events (Refer pal_os_event.h).
+ *
+ * \param[in]      me                                     Refer #optiga_util_close_application.
+ * \param[in]      perform_hibernate                      Refer #optiga_util_close_application.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful completion of the operation.
+ * \retval    Error code                             As returned by #optiga_util_close_application or reported on completion of the operation.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_close_application_sync(optiga_util_t * me,
+                                                                       bool_t perform_hibernate);
+
+/**
+ * \brief Reads the data from a data object and blocks the caller until completion.
+ *
+ * \details
+ * Synchronous variant of #optiga_util_read_data.
+ * - Invokes #optiga_util_read_data and blocks the caller on the PAL wait object of the instance, until the operation is completed.<br>
+ * - The callback handler registered with the instance is not invoked.<br>
+ *
+ * \pre
+ * - Same as #optiga_util_read_data.
+ *
+ * \note
+ * - Must not be invoked from the callback handler or from the context which executes the OPTIGA events (Refer pal_os_event.h).
+ *
+ * \param[in]      me                                     Refer #optiga_util_read_data.
+ * \param[in]      optiga_oid                             Refer #optiga_util_read_data.
+ * \param[in]      offset                                 Refer #optiga_util_read_data.
+ * \param[in,out]  buffer                                 Refer #optiga_util_read_data.
+ * \param[in,out]  length                                 Refer #optiga_util_read_data.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful completion of the operation.
+ * \retval    Error code                             As returned by #optiga_util_read_data or reported on completion of the operation.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_read_data_sync(optiga_util_t * me,
+                                                               uint16_t optiga_oid,
+                                                               uint16_t offset,
+                                                               uint8_t * buffer,
+                                                               uint16_t * length);
+
+/**
+ * \brief Reads the metadata of a data object and blocks the caller until completion.
+ *
+ * \details
+ * Synchronous variant of #optiga_util_read_metadata.
+ * - Invokes #optiga_util_read_metadata and blocks the caller on the PAL wait object of the instance, until the operation is completed.<br>
+ * - The callback handler registered with the instance is not invoked.<br>
+ *
+ * \pre
+ * - Same as #optiga_util_read_metadata.
+ *
+ * \note
+ * - Must not be invoked from the callback handler or from the context which executes the OPTIGA events (Refer pal_os_event.h).
+ *
+ * \param[in]      me                                     Refer #optiga_util_read_metadata.
+ * \param[in]      optiga_oid                             Refer #optiga_util_read_metadata.
+ * \param[in,out]  buffer                                 Refer #optiga_util_read_metadata.
+ * \param[in,out]  length                                 Refer #optiga_util_read_metadata.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful completion of the operation.
+ * \retval    Error code                             As returned by #optiga_util_read_metadata or reported on completion of the operation.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_read_metadata_sync(optiga_util_t * me,
+                                                                   uint16_t optiga_oid,
+                                                                   uint8_t * buffer,
+                                                                   uint16_t * length);
+
+/**
+ * \brief Writes the data to a data object and blocks the caller until completion.
+ *
+ * \details
+ * Synchronous variant of #optiga_util_write_data.
+ * - Invokes #optiga_util_write_data and blocks the caller on the PAL wait object of the instance, until the operation is completed.<br>
+ * - The callback handler registered with the instance is not invoked.<br>
+ *
+ * \pre
+ * - Same as #optiga_util_write_data.
+ *
+ * \note
+ * - Must not be invoked from the callback handler or from the context which executes the OPTIGA events (Refer pal_os_event.h).
+ *
+ * \param[in]      me                                     Refer #optiga_util_write_data.
+ * \param[in]      optiga_oid                             Refer #optiga_util_write_data.
+ * \param[in]      write_type                             Refer #optiga_util_write_data.
+ * \param[in]      offset                                 Refer #optiga_util_write_data.
+ * \param[in]      buffer                                 Refer #optiga_util_write_data.
+ * \param[in]      length                                 Refer #optiga_util_write_data.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful completion of the operation.
+ * \retval    Error code                             As returned by #optiga_util_write_data or reported on completion of the operation.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_write_data_sync(optiga_util_t * me,
+                                                                uint16_t optiga_oid,
+                                                                uint8_t write_type,
+                                                                uint16_t offset,
+                                                                const uint8_t * buffer,
+                                                                uint16_t length);
+
+/**
+ * \brief Writes the metadata of a data object and blocks the caller until completion.
+ *
+ * \details
+ * Synchronous variant of #optiga_util_write_metadata.
+ * - Invokes #optiga_util_write_metadata and blocks the caller on the PAL wait object of the instance, until the operation is completed.<br>
+ * - The callback handler registered with the instance is not invoked.<br>
+ *
+ * \pre
+ * - Same as #optiga_util_write_metadata.
+ *
+ * \note
+ * - Must not be invoked from the callback handler or from the context which executes the OPTIGA events (Refer pal_os_event.h).
+ *
+ * \param[in]      me                                     Refer #optiga_util_write_metadata.
+ * \param[in]      optiga_oid                             Refer #optiga_util_write_metadata.
+ * \param[in]      buffer                                 Refer #optiga_util_write_metadata.
+ * \param[in]      length                                 Refer #optiga_util_write_metadata.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful completion of the operation.
+ * \retval    Error code                             As returned by #optiga_util_write_metadata or reported on completion of the operation.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_write_metadata_sync(optiga_util_t * me,
+                                                                    uint16_t optiga_oid,
+                                                                    const uint8_t * buffer,
+                                                                    uint8_t length);
+
+/**
+ * \brief Increments a monotonic counter and blocks the caller until completion.
+ *
+ * \details
+ * Synchronous variant of #optiga_util_update_count.
+ * - Invokes #optiga_util_update_count and blocks the caller on the PAL wait object of the instance, until the operation is completed.<br>
+ * - The callback handler registered with the instance is not invoked.<br>
+ *
+ * \pre
+ * - Same as #optiga_util_update_count.
+ *
+ * \note
+ * - Must not be invoked from the callback handler or from the context which executes the OPTIGA events (Refer pal_os_event.h).
+ *
+ * \param[in]      me                                     Refer #optiga_util_update_count.
+ * \param[in]      optiga_counter_oid                     Refer #optiga_util_update_count.
+ * \param[in]      count                                  Refer #optiga_util_update_count.
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS                    Successful completion of the operation.
+ * \retval    Error code                             As returned by #optiga_util_update_count or reported on completion of the operation.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_update_count_sync(optiga_util_t * me,
+                                                                  uint16_t optiga_counter_oid,
+                                                                  uint8_t count);
+#endif //OPTIGA_LIB_SYNC_API_ENABLED
+
 /**
  * \brief Enables the protected I2C communication with OPTIGA for UTIL instances
  *
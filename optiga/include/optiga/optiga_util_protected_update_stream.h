@@ -0,0 +1,212 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_util_protected_update_stream.h
+*
+* \brief   This file implements the prototype declarations of OPTIGA Util protected update stream, which feeds the manifest and the fragments of a protected update data set from a reader.
+*
+* \ingroup  grOptigaUtil
+*
+* @{
+*/
+
+#ifndef _OPTIGA_UTIL_PROTECTED_UPDATE_STREAM_H_
+#define _OPTIGA_UTIL_PROTECTED_UPDATE_STREAM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "optiga/optiga_util.h"
+
+#ifdef OPTIGA_UTIL_PROTECTED_UPDATE_STREAM_ENABLED
+
+/// Length of the fragments of a protected update data set, except the final fragment which may be shorter
+#define OPTIGA_UTIL_PROTECTED_UPDATE_FRAGMENT_SIZE          (0x0280)
+
+/**
+ * \brief Reads the protected update data set.
+ *
+ * \details
+ * Reads the next bytes of the data set, which is the manifest followed by the fragments (e.g. as a file or a socket).
+ * - Must read the requested number of bytes. Fewer bytes are read only at the end of the data set.
+ *
+ * \param[in]      p_io_ctx                                 Context provided to #optiga_util_protected_update_stream_start.
+ * \param[out]     p_buffer                                 Buffer to store the bytes.
+ * \param[in]      length                                   Number of bytes to be read.
+ * \param[out]     p_read_length                            Number of bytes read, less than length only at the end of the data set.
+ *
+ * \retval         #OPTIGA_LIB_SUCCESS                      The bytes are read, any other value aborts the stream.
+ */
+typedef optiga_lib_status_t (* optiga_util_protected_update_reader_t)(void * p_io_ctx,
+                                                                       uint8_t * p_buffer,
+                                                                       uint16_t length,
+                                                                       uint16_t * p_read_length);
+
+/** \brief OPTIGA util protected update stream structure */
+typedef struct optiga_util_protected_update_stream
+{
+    /// Util instance, which executes the protected update
+    optiga_util_t * p_util;
+    /// Callback handler of the caller, invoked on completion of the stream
+    callback_handler_t caller_handler;
+    /// Context of the caller, provided to the callback handler
+    void * caller_context;
+    /// Reads the data set
+    optiga_util_protected_update_reader_t reader;
+    /// Context provided to the reader
+    void * p_io_ctx;
+    /// Manifest and fragments, the next fragment is read while the current one is written to OPTIGA
+    uint8_t buffer[2][OPTIGA_UTIL_PROTECTED_UPDATE_FRAGMENT_SIZE];
+    /// Length of the manifest or fragment of each buffer
+    uint16_t length[2];
+    /// Indicates the fragment of the buffer is the final fragment
+    uint8_t final[2];
+    /// First byte of the fragment after the last read fragment, read ahead to detect the final fragment
+    uint8_t lookahead;
+    /// Indicates the lookahead byte is valid
+    uint8_t lookahead_valid;
+    /// Indicates the reader reached the end of the data set
+    uint8_t end_of_data;
+    /// Status, which aborts the stream on completion of the current fragment
+    optiga_lib_status_t abort_status;
+    /// Buffer index of the next fragment to be written
+    uint8_t submit_index;
+    /// Indicates the next fragment is read from the data set
+    uint8_t next_prepared;
+    /// Indicates the current fragment is completed, while the next fragment is not yet read
+    uint8_t waiting;
+    /// Indicates the final fragment is written
+    uint8_t final_submitted;
+    /// Indicates the strict sequence of the aborted stream is released
+    uint8_t releasing;
+    /// Indicates a stream is ongoing
+    uint8_t ongoing;
+}optiga_util_protected_update_stream_t;
+
+/**
+ * \brief Initializes the stream.
+ *
+ * \details
+ * Initializes the stream and creates the util instance, which executes the protected updates.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ * - The stream must be valid until #optiga_util_protected_update_stream_deinit is invoked.
+ * - For <b>protected I2C communication</b>, set the protection level of the util instance of the stream (p_util)
+ *   using #OPTIGA_UTIL_SET_COMMS_PROTECTION_LEVEL before #optiga_util_protected_update_stream_start.
+ *
+ * \param[in,out]  me                                       Pointer to stream, must not be NULL.
+ * \param[in]      optiga_instance_id                       Indicates the OPTIGA instance, which executes the streams.
+ * \param[in]      handler                                  Callback handler, invoked on completion of a stream.
+ * \param[in]      caller_context                           Context of the caller, provided to the callback handler.
+ *
+ * \retval         #OPTIGA_UTIL_SUCCESS                     Successful invocation.
+ * \retval         #OPTIGA_UTIL_ERROR_INVALID_INPUT         Wrong Input arguments provided.
+ * \retval         #OPTIGA_UTIL_ERROR                       Creation of util instance failed.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_protected_update_stream_init(optiga_util_protected_update_stream_t * me,
+                                                                             uint8_t optiga_instance_id,
+                                                                             callback_handler_t handler,
+                                                                             void * caller_context);
+
+/**
+ * \brief De-initializes the stream.
+ *
+ * \details
+ * De-initializes the stream, erases the fragments and destroys the util instance.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - This API is implemented in synchronous mode.
+ *
+ * \param[in,out]  me                                       Pointer to stream, must not be NULL.
+ *
+ * \retval         #OPTIGA_UTIL_SUCCESS                     Successful invocation.
+ * \retval         #OPTIGA_UTIL_ERROR_INVALID_INPUT         Wrong Input arguments provided.
+ * \retval         #OPTIGA_UTIL_ERROR_INSTANCE_IN_USE       A stream is ongoing.
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_protected_update_stream_deinit(optiga_util_protected_update_stream_t * me);
+
+/**
+ * \brief Executes the protected update of the data set provided by the reader.
+ *
+ * \details
+ * Reads the data set and writes it to OPTIGA using #optiga_util_protected_update_start, _continue and _final.
+ * - The manifest (COSE_Sign1) is read item by item, until the CBOR structure is complete.
+ *   Hence the length of the manifest is not required to be known in advance.
+ * - The fragments following the manifest are read in #OPTIGA_UTIL_PROTECTED_UPDATE_FRAGMENT_SIZE bytes.
+ *   A fragment is the final fragment, once the end of the data set is reached (one byte is read ahead).
+ * - While a fragment is written to OPTIGA, the next fragment is read. Hence the memory is bounded by two fragments,
+ *   independent of the size of the data set.
+ * - The callback registered with #optiga_util_protected_update_stream_init gets invoked, on completion of the
+ *   stream or the first error. If the stream is aborted by the reader, the strict sequence is released.
+ *
+ * \pre
+ * - The stream must be initialized using #optiga_util_protected_update_stream_init.
+ * - The application on OPTIGA must be opened using #optiga_util_open_application.
+ *
+ * \note
+ * - This API is asynchronous. The reader is invoked from the callback context of the fragments,
+ *   except for the manifest and the first fragment, which are read before this API returns.
+ * - Indefinite length CBOR items are not supported in the manifest, which must not exceed
+ *   #OPTIGA_UTIL_PROTECTED_UPDATE_FRAGMENT_SIZE bytes.
+ * - The context must be valid until the callback is invoked.
+ *
+ * \param[in,out]  me                                       Pointer to stream, must not be NULL.
+ * \param[in]      manifest_version                         Version of the manifest, refer #optiga_util_protected_update_start.
+ * \param[in]      reader                                   Reads the data set, must not be NULL.
+ * \param[in]      p_io_ctx                                 Context provided to the reader.
+ *
+ * \retval         #OPTIGA_UTIL_SUCCESS                     Successful invocation.
+ * \retval         #OPTIGA_UTIL_ERROR_INVALID_INPUT         Wrong Input arguments provided, or the manifest is invalid.
+ * \retval         #OPTIGA_UTIL_ERROR_INSTANCE_IN_USE       A stream is ongoing.
+ * \retval         #OPTIGA_DEVICE_ERROR                     Command execution failure in OPTIGA and the LSB indicates the error code.
+ *                                                          (Refer Solution Reference Manual)
+ */
+LIBRARY_EXPORTS optiga_lib_status_t optiga_util_protected_update_stream_start(optiga_util_protected_update_stream_t * me,
+                                                                              uint8_t manifest_version,
+                                                                              optiga_util_protected_update_reader_t reader,
+                                                                              void * p_io_ctx);
+
+#endif //OPTIGA_UTIL_PROTECTED_UPDATE_STREAM_ENABLED
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_OPTIGA_UTIL_PROTECTED_UPDATE_STREAM_H_*/
+
+/**
+* @}
+*/
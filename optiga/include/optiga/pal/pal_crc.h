@@ -0,0 +1,77 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_crc.h
+*
+* \brief   This file provides the prototype declarations of PAL CRC.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#ifndef _PAL_CRC_H_
+#define _PAL_CRC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "pal.h"
+
+/**
+ * \brief Calculates the CRC16 of the data using the CRC unit of the platform.
+ *
+ * \details
+ * Calculates the CRC16 of the data using the CRC unit of the platform.
+ * - The CRC16 is calculated with the reflected CCITT polynomial 0x8408 (CRC-16/KERMIT),
+ *   the seed 0 and without final XOR. The CRC16 of "123456789" is 0x2189.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Required only if IFX_I2C_DL_CRC_IMPLEMENTATION is IFX_I2C_DL_CRC_HARDWARE.
+ * - It is invoked for every frame sent and received by the IFX I2C data link layer.
+ *
+ * \param[in] p_data                 Pointer to the data
+ * \param[in] data_length            Length of the data
+ *
+ * \retval    uint16_t               CRC16 of the data
+ */
+LIBRARY_EXPORTS uint16_t pal_crc16_calculate(const uint8_t * p_data, uint16_t data_length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _PAL_CRC_H_ */
+
+/**
+* @}
+*/
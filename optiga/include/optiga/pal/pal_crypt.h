@@ -46,13 +46,37 @@ extern "C" {
 #include "optiga/common/optiga_lib_types.h"
 #include "optiga/pal/pal.h"
 
-/** \brief PAL crypt context structure */
+/// Number of AES CCM key schedules, which are kept in #pal_crypt_t (e.g. encryption and decryption key of a session)
+#define PAL_CRYPT_AES128_CCM_KEY_CONTEXTS   (0x02)
+/// Length of the AES128 key
+#define PAL_CRYPT_AES128_KEY_LENGTH         (0x10)
+
+/** \brief PAL crypt context structure, must be initialized with zero */
 typedef struct pal_crypt_t
 {
     /// callback
     void * callback_ctx;
+    /// Key schedules of the crypto library for AES CCM, which are kept for the next operation with the same key
+    void * p_ccm_key_context[PAL_CRYPT_AES128_CCM_KEY_CONTEXTS];
+    /// Keys of the AES CCM key schedules
+    uint8_t ccm_key[PAL_CRYPT_AES128_CCM_KEY_CONTEXTS][PAL_CRYPT_AES128_KEY_LENGTH];
+    /// Key schedule, which is replaced by the next new key
+    uint8_t ccm_next_key_context;
 }pal_crypt_t;
 
+/// ECC curve NIST P256 for #pal_crypt_ecdsa_verify (same as #OPTIGA_ECC_CURVE_NIST_P_256)
+#define PAL_CRYPT_ECC_NIST_P_256            (0x03)
+/// ECC curve NIST P384 for #pal_crypt_ecdsa_verify (same as #OPTIGA_ECC_CURVE_NIST_P_384)
+#define PAL_CRYPT_ECC_NIST_P_384            (0x04)
+/// ECC curve NIST P521 for #pal_crypt_ecdsa_verify (same as #OPTIGA_ECC_CURVE_NIST_P_521)
+#define PAL_CRYPT_ECC_NIST_P_521            (0x05)
+/// ECC curve Brainpool P256R1 for #pal_crypt_ecdsa_verify (same as #OPTIGA_ECC_CURVE_BRAIN_POOL_P_256R1)
+#define PAL_CRYPT_ECC_BRAINPOOL_P_256R1     (0x13)
+/// ECC curve Brainpool P384R1 for #pal_crypt_ecdsa_verify (same as #OPTIGA_ECC_CURVE_BRAIN_POOL_P_384R1)
+#define PAL_CRYPT_ECC_BRAINPOOL_P_384R1     (0x15)
+/// ECC curve Brainpool P512R1 for #pal_crypt_ecdsa_verify (same as #OPTIGA_ECC_CURVE_BRAIN_POOL_P_512R1)
+#define PAL_CRYPT_ECC_BRAINPOOL_P_512R1     (0x16)
+
 /**
  * \brief Derives the key using the TLS PRF SHA256 for a given secret.
  *
@@ -102,6 +126,8 @@ LIBRARY_EXPORTS pal_status_t pal_crypt_tls_prf_sha256(pal_crypt_t* p_pal_crypt,
  * \note
  * - If <b>mac_size</b> is set to 8 AES128_CCM_8 algorithm will be used for encryption.
  * - If <b>mac_size</b> is set to 16 AES128_CCM algorithm will be used for encryption.
+ * - If <b>p_pal_crypt</b> is not NULL, the key schedule is kept in the crypt context for the next operation with the
+ *   same key, until #pal_crypt_release_keys. Otherwise the key schedule is set up for this operation only.
  *
  * \param[in]           p_pal_crypt                 Crypt context                                                      
  * \param[in]           p_plain_text                Valid pointer to plain text data.
@@ -142,6 +168,8 @@ LIBRARY_EXPORTS pal_status_t pal_crypt_encrypt_aes128_ccm(pal_crypt_t* p_pal_cry
  * \note
  * - If <b>mac_size</b> is set to 8 AES128_CCM_8 algorithm will be used for decryption.
  * - If <b>mac_size</b> is set to 16 AES128_CCM algorithm will be used for decryption.
+ * - If <b>p_pal_crypt</b> is not NULL, the key schedule is kept in the crypt context for the next operation with the
+ *   same key, until #pal_crypt_release_keys. Otherwise the key schedule is set up for this operation only.
  *
  * \param[in]           p_pal_crypt                 Crypt context
  * \param[in]           p_cipher_text               Valid pointer to the Cipher text + MAC data.
@@ -168,6 +196,202 @@ LIBRARY_EXPORTS pal_status_t pal_crypt_decrypt_aes128_ccm(pal_crypt_t* p_pal_cry
                                                           uint8_t mac_size,
                                                           uint8_t * p_plain_text);
 
+/**
+ * \brief Starts the SHA256 digest calculation on host.
+ *
+ * \details
+ * Starts the SHA256 digest calculation on host.
+ * - Initializes the state of the crypto library in the context buffer provided by the caller.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The context buffer holds the state of the crypto library between the calls, hence it must not be modified by the caller.
+ * - A crypto library may reference an allocated state from the context buffer (OpenSSL), hence a started calculation
+ *   must be completed using #pal_crypt_sha256_finalize, unless #pal_crypt_sha256_update fails.
+ *
+ * \param[in]           p_pal_crypt             Crypt context
+ * \param[in,out]       p_context               Valid pointer to the buffer to hold the state of the digest calculation.
+ * \param[in]           context_length          Length of the context buffer.
+ *
+ * \retval              PAL_STATUS_SUCCESS      In case of success
+ * \retval              PAL_STATUS_FAILURE      In case of failure or if the context buffer is too small
+ */
+LIBRARY_EXPORTS pal_status_t pal_crypt_sha256_start(pal_crypt_t* p_pal_crypt,
+                                                    uint8_t * p_context,
+                                                    uint16_t context_length);
+
+/**
+ * \brief Updates the SHA256 digest calculation on host with the input data.
+ *
+ * \details
+ * Updates the SHA256 digest calculation on host with the input data.
+ *
+ * \pre
+ * - The context buffer must be initialized using #pal_crypt_sha256_start.
+ *
+ * \note
+ * - None
+ *
+ * \param[in]           p_pal_crypt             Crypt context
+ * \param[in,out]       p_context               Valid pointer to the buffer holding the state of the digest calculation.
+ * \param[in]           context_length          Length of the context buffer.
+ * \param[in]           p_data                  Valid pointer to the data to be hashed.
+ * \param[in]           data_length             Length of the data to be hashed.
+ *
+ * \retval              PAL_STATUS_SUCCESS      In case of success
+ * \retval              PAL_STATUS_FAILURE      In case of failure
+ */
+LIBRARY_EXPORTS pal_status_t pal_crypt_sha256_update(pal_crypt_t* p_pal_crypt,
+                                                     uint8_t * p_context,
+                                                     uint16_t context_length,
+                                                     const uint8_t * p_data,
+                                                     uint32_t data_length);
+
+/**
+ * \brief Finalizes the SHA256 digest calculation on host and provides the digest.
+ *
+ * \details
+ * Finalizes the SHA256 digest calculation on host and provides the digest.
+ *
+ * \pre
+ * - The context buffer must be initialized using #pal_crypt_sha256_start.
+ *
+ * \note
+ * - None
+ *
+ * \param[in]           p_pal_crypt             Crypt context
+ * \param[in,out]       p_context               Valid pointer to the buffer holding the state of the digest calculation.
+ * \param[in]           context_length          Length of the context buffer.
+ * \param[in,out]       p_digest                Valid pointer to store the digest. Buffer length must be at-least 32 bytes.
+ *
+ * \retval              PAL_STATUS_SUCCESS      In case of success
+ * \retval              PAL_STATUS_FAILURE      In case of failure
+ */
+LIBRARY_EXPORTS pal_status_t pal_crypt_sha256_finalize(pal_crypt_t* p_pal_crypt,
+                                                       uint8_t * p_context,
+                                                       uint16_t context_length,
+                                                       uint8_t * p_digest);
+
+/**
+ * \brief Verifies the ECDSA signature of the digest using the public key on host.
+ *
+ * \details
+ * Verifies the ECDSA signature of the digest using the public key on host.
+ * - The formats of signature and public key are same as for OPTIGA.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The signature is the content of the DER SEQUENCE, i.e. r and s encoded as DER INTEGERs.
+ * - The public key is a DER BIT STRING, which contains the uncompressed point.
+ *
+ * \param[in]           p_pal_crypt                 Crypt context
+ * \param[in]           curve_id                    ECC curve of the public key (PAL_CRYPT_ECC_*).
+ * \param[in]           p_digest                    Valid pointer to the digest.
+ * \param[in]           digest_length               Length of the digest.
+ * \param[in]           p_signature                 Valid pointer to the signature.
+ * \param[in]           signature_length            Length of the signature.
+ * \param[in]           p_public_key                Valid pointer to the public key.
+ * \param[in]           public_key_length           Length of the public key.
+ *
+ * \retval              PAL_STATUS_SUCCESS          If the signature is verified successfully
+ * \retval              PAL_STATUS_FAILURE          If the signature verification failed
+ * \retval              PAL_STATUS_INVALID_INPUT    If the curve is not supported or the public key is invalid
+ */
+LIBRARY_EXPORTS pal_status_t pal_crypt_ecdsa_verify(pal_crypt_t* p_pal_crypt,
+                                                    uint8_t curve_id,
+                                                    const uint8_t * p_digest,
+                                                    uint16_t digest_length,
+                                                    const uint8_t * p_signature,
+                                                    uint16_t signature_length,
+                                                    const uint8_t * p_public_key,
+                                                    uint16_t public_key_length);
+
+/**
+ * \brief Releases the key schedules kept in the crypt context.
+ *
+ * \details
+ * Releases the key schedules kept in the crypt context.
+ * - Frees the key schedules of the crypto library and erases the keys.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - To be invoked, once the keys are not used anymore (e.g. end of session).
+ *
+ * \param[in,out]       p_pal_crypt                 Crypt context
+ *
+ * \retval              PAL_STATUS_SUCCESS          In case of success
+ * \retval              PAL_STATUS_FAILURE          In case of failure
+ */
+LIBRARY_EXPORTS pal_status_t pal_crypt_release_keys(pal_crypt_t* p_pal_crypt);
+
+/**
+ * \brief Loads the AES128 key into a key context of the AES hardware accelerator.
+ *
+ * \details
+ * Loads the AES128 key into a key context of the AES hardware accelerator.
+ * - Allocates the key context, if <b>*pp_key_context</b> is NULL. Otherwise, the key context is loaded with the new key.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - To be provided by the platform, if #OPTIGA_PAL_CRYPT_HW_AES_ENABLED is defined.
+ *   The AES CCM operations are then implemented on top of it (pal_crypt_aes128_ccm_hw.c).
+ *
+ * \param[in,out]       pp_key_context              Pointer to the key context of the AES hardware accelerator
+ * \param[in]           p_key                       AES128 key
+ *
+ * \retval              PAL_STATUS_SUCCESS          In case of success
+ * \retval              PAL_STATUS_FAILURE          In case of failure
+ */
+LIBRARY_EXPORTS pal_status_t pal_crypt_aes128_hw_set_key(void ** pp_key_context, const uint8_t * p_key);
+
+/**
+ * \brief Encrypts one AES block (ECB) using the AES hardware accelerator.
+ *
+ * \details
+ * Encrypts one AES block (ECB) using the AES hardware accelerator.
+ *
+ * \pre
+ * - The key context is loaded using #pal_crypt_aes128_hw_set_key.
+ *
+ * \note
+ * - To be provided by the platform, if #OPTIGA_PAL_CRYPT_HW_AES_ENABLED is defined.
+ * - <b>p_input</b> and <b>p_output</b> can be the same buffer.
+ *
+ * \param[in]           p_key_context               Key context of the AES hardware accelerator
+ * \param[in]           p_input                     Input block of 16 bytes
+ * \param[out]          p_output                    Output block of 16 bytes
+ *
+ * \retval              PAL_STATUS_SUCCESS          In case of success
+ * \retval              PAL_STATUS_FAILURE          In case of failure
+ */
+LIBRARY_EXPORTS pal_status_t pal_crypt_aes128_hw_encrypt_block(void * p_key_context,
+                                                               const uint8_t * p_input,
+                                                               uint8_t * p_output);
+
+/**
+ * \brief Erases and frees the key context of the AES hardware accelerator.
+ *
+ * \details
+ * Erases and frees the key context of the AES hardware accelerator.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - To be provided by the platform, if #OPTIGA_PAL_CRYPT_HW_AES_ENABLED is defined.
+ *
+ * \param[in]           p_key_context               Key context of the AES hardware accelerator, NULL is ignored
+ */
+LIBRARY_EXPORTS void pal_crypt_aes128_hw_release_key(void * p_key_context);
+
 /**
  * \brief Gets the external crypto library version number.
  *
@@ -55,6 +55,11 @@ typedef struct pal_gpio
 
 } pal_gpio_t;
 
+/**
+ * \brief Callback invoked on the interrupt of the GPIO pin.
+ */
+typedef void (*pal_gpio_irq_handler_t)(void * p_context);
+
 /**
  * \brief Function to transmit and receive a packet.
  *
@@ -133,6 +138,33 @@ LIBRARY_EXPORTS pal_status_t pal_gpio_init(const pal_gpio_t * p_gpio_context);
  */
 LIBRARY_EXPORTS pal_status_t pal_gpio_deinit(const pal_gpio_t * p_gpio_context);
 
+/**
+ * \brief Function to register a handler for the interrupt of the GPIO pin.
+ *
+ * \details
+ * Function to register a handler for the interrupt of the GPIO pin.
+ * - Configures the pin as input and enables the interrupt on the edge, which signals the data ready state of the slave.
+ * - The handler is invoked in interrupt context with the provided context.
+ * - Passing NULL as handler disables the interrupt.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Required only if OPTIGA_COMMS_DATA_READY_IRQ_ENABLED is defined.
+ * - If the platform does not support the interrupt, return #PAL_STATUS_FAILURE. The status register is polled then.
+ *
+ * \param[in] p_gpio_context                         Valid pointer to PAL layer GPIO context
+ * \param[in] handler                                Handler to be invoked on the interrupt
+ * \param[in] p_context                              Context to be provided to the handler
+ *
+ * \retval    #PAL_STATUS_SUCCESS                    On successful execution
+ * \retval    #PAL_STATUS_FAILURE                    On failure
+ */
+LIBRARY_EXPORTS pal_status_t pal_gpio_register_irq(const pal_gpio_t * p_gpio_context,
+                                                   pal_gpio_irq_handler_t handler,
+                                                   void * p_context);
+
 
 #ifdef __cplusplus
 }
@@ -63,6 +63,10 @@ typedef struct pal_i2c
     void * p_upper_layer_ctx;
     /// Pointer to store the callers handler
     void * upper_layer_event_handler;
+#ifdef PAL_I2C_MUX
+    /// Pointer to the platform specific path of I2C multiplexer channels to the slave, NULL if directly on the bus
+    const void * p_mux_path;
+#endif
 
 } pal_i2c_t;
 
@@ -50,6 +50,7 @@ extern "C" {
 extern pal_i2c_t optiga_pal_i2c_context_0;
 extern pal_gpio_t optiga_vdd_0;
 extern pal_gpio_t optiga_reset_0;
+extern pal_gpio_t optiga_irq_0;
 
 #ifdef __cplusplus
 }
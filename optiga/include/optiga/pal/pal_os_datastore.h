@@ -44,6 +44,7 @@ extern "C" {
 #endif
 
 #include "optiga/pal/pal.h"
+#include "optiga/optiga_lib_config.h"
 
 /// Identifier to store and read OPTIGA Platform Binding Shared secret on host platform
 #define OPTIGA_PLATFORM_BINDING_SHARED_SECRET_ID        (0x11)
@@ -66,6 +67,22 @@ extern "C" {
 // set OPTIGA_COMMS_MANAGE_CONTEXT_ID to OPTIGA_LIB_PAL_DATA_STORE_NOT_CONFIGURED.
 #define OPTIGA_HIBERNATE_CONTEXT_ID                     (0x33)
 
+// !!!OPTIGA_LIB_PORTING_REQUIRED
+// Identifier to store and read OPTIGA communication link state on host platform for the warm reattach,
+// The link state must persist across restarts of the host application (e.g. in a file or NVM).
+#define OPTIGA_COMMS_LINK_STATE_ID                      (0x44)
+
+// !!!OPTIGA_LIB_PORTING_REQUIRED
+// Identifier to store and read the pending increments of the counter data objects (optiga_util_add_count),
+// If the pending increments are to be stored in volatile memory only,
+// set OPTIGA_UTIL_PENDING_COUNT_ID to OPTIGA_LIB_PAL_DATA_STORE_NOT_CONFIGURED.
+#define OPTIGA_UTIL_PENDING_COUNT_ID                    (0x55)
+
+// !!!OPTIGA_LIB_PORTING_REQUIRED
+// Identifier to store and read the slave addresses assigned by the bus enumeration (ifx_i2c_enumerate_bus),
+// The map must persist across restarts of the host, else the devices are enumerated again on every boot.
+#define OPTIGA_COMMS_BUS_MAP_ID                         (0x66)
+
 /// @cond hidden
 /// Size of application context handle buffer
 #define APP_CONTEXT_SIZE        (0x08)
@@ -119,6 +136,232 @@ pal_status_t pal_os_datastore_write(uint16_t datastore_id,
                                     const uint8_t * p_buffer,
                                     uint16_t length);
 
+/**
+ * \brief Reads the latest record of the datastore_id from the flash log.
+ *
+ * \details
+ * Reads the latest record of the datastore_id from the log-structured flash datastore (pal_os_datastore_log.c).
+ * - The location of the latest valid record of each datastore_id is held in a RAM index, which is built by scanning
+ *   the flash on the first access. Hence a read is one flash read.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Invoked by pal_os_datastore_read of the platform, if #OPTIGA_PAL_DATASTORE_LOG_ENABLED is defined.
+ *
+ * \param[in]     datastore_id          Datastore id from where the data should be read.
+ * \param[out]    p_buffer              Valid Pointer to output buffer
+ * \param[in,out] p_buffer_length       Valid Pointer to the buffer length, updated with the length read
+ *
+ * \retval        #PAL_STATUS_SUCCESS   On successful execution
+ * \retval        #PAL_STATUS_FAILURE   No record of the datastore_id, the buffer is too small or the flash failed
+ */
+pal_status_t pal_os_datastore_log_read(uint16_t datastore_id,
+                                       uint8_t * p_buffer,
+                                       uint16_t * p_buffer_length);
+
+/**
+ * \brief Appends a record of the datastore_id to the flash log.
+ *
+ * \details
+ * Appends a record of the datastore_id to the log-structured flash datastore (pal_os_datastore_log.c).
+ * - The record (header, data and CRC) is programmed at the end of the active sector, without an erase.
+ * - Once the active sector is full, the latest records are copied to the next sector (round robin), which is erased
+ *   for it. Hence each sector is erased once per cycle through all the sectors.
+ * - A record torn by a power loss fails its CRC and the previous record of the datastore_id stays valid.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Invoked by pal_os_datastore_write of the platform, if #OPTIGA_PAL_DATASTORE_LOG_ENABLED is defined.
+ *
+ * \param[in] datastore_id          Datastore id where the data should be written.
+ * \param[in] p_buffer              Valid pointer to the input buffer
+ * \param[in] length                Length of the data, up to #OPTIGA_PAL_DATASTORE_LOG_MAX_RECORD_LENGTH
+ *
+ * \retval    #PAL_STATUS_SUCCESS   On successful execution
+ * \retval    #PAL_STATUS_FAILURE   The data is too long, the index is full or the flash failed
+ */
+pal_status_t pal_os_datastore_log_write(uint16_t datastore_id,
+                                        const uint8_t * p_buffer,
+                                        uint16_t length);
+
+/**
+ * \brief Erases a sector of the flash area of the datastore log.
+ *
+ * \details
+ * Erases a sector of #OPTIGA_PAL_DATASTORE_LOG_SECTOR_SIZE bytes, all the bytes read as 0xFF afterwards.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - To be provided by the platform, if #OPTIGA_PAL_DATASTORE_LOG_ENABLED is defined.
+ *
+ * \param[in] sector                Index of the sector, less than #OPTIGA_PAL_DATASTORE_LOG_SECTOR_COUNT
+ *
+ * \retval    #PAL_STATUS_SUCCESS   On successful execution
+ * \retval    #PAL_STATUS_FAILURE   On failure
+ */
+pal_status_t pal_os_datastore_flash_erase(uint8_t sector);
+
+/**
+ * \brief Programs erased bytes of a sector of the flash area of the datastore log.
+ *
+ * \details
+ * Programs the data at the offset of the sector.
+ * - The offset and length are multiples of #OPTIGA_PAL_DATASTORE_LOG_PROGRAM_UNIT.
+ * - Each byte is programmed once between two erases of the sector.
+ *
+ * \pre
+ * - The bytes are erased.
+ *
+ * \note
+ * - To be provided by the platform, if #OPTIGA_PAL_DATASTORE_LOG_ENABLED is defined.
+ *
+ * \param[in] sector                Index of the sector
+ * \param[in] offset                Offset in the sector
+ * \param[in] p_data                Data to be programmed
+ * \param[in] length                Length of the data
+ *
+ * \retval    #PAL_STATUS_SUCCESS   On successful execution
+ * \retval    #PAL_STATUS_FAILURE   On failure
+ */
+pal_status_t pal_os_datastore_flash_program(uint8_t sector, uint16_t offset, const uint8_t * p_data, uint16_t length);
+
+/**
+ * \brief Reads from a sector of the flash area of the datastore log.
+ *
+ * \details
+ * Reads the data at the offset of the sector.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - To be provided by the platform, if #OPTIGA_PAL_DATASTORE_LOG_ENABLED is defined.
+ *
+ * \param[in]  sector               Index of the sector
+ * \param[in]  offset               Offset in the sector
+ * \param[out] p_data               Buffer for the data
+ * \param[in]  length               Length of the data
+ *
+ * \retval    #PAL_STATUS_SUCCESS   On successful execution
+ * \retval    #PAL_STATUS_FAILURE   On failure
+ */
+pal_status_t pal_os_datastore_flash_read(uint8_t sector, uint16_t offset, uint8_t * p_data, uint16_t length);
+
+#ifdef OPTIGA_LIB_DATASTORE_CACHE_ENABLED
+/** \brief Counters of the datastore cache */
+typedef struct pal_os_datastore_cache_stats
+{
+    /// Number of writes requested by the library
+    uint32_t writes;
+    /// Number of writes skipped, as the data is unchanged
+    uint32_t skipped_writes;
+    /// Number of deferred writes replaced by a later write within #OPTIGA_LIB_DATASTORE_CACHE_WINDOW_MS
+    uint32_t coalesced_writes;
+    /// Number of writes to the datastore of the platform (pal_os_datastore_write)
+    uint32_t nvm_writes;
+}pal_os_datastore_cache_stats_t;
+
+/// Reads the datastore id through the datastore cache
+#define PAL_OS_DATASTORE_READ(datastore_id, p_buffer, p_buffer_length) \
+    pal_os_datastore_cache_read((datastore_id), (p_buffer), (p_buffer_length))
+/// Writes the datastore id through the datastore cache
+#define PAL_OS_DATASTORE_WRITE(datastore_id, p_buffer, length) \
+    pal_os_datastore_cache_write((datastore_id), (p_buffer), (length))
+/// Writes the deferred data of the datastore cache
+#define PAL_OS_DATASTORE_FLUSH()    pal_os_datastore_cache_flush()
+
+/**
+ * \brief Writes data of a datastore_id through the datastore cache.
+ *
+ * \details
+ * Writes data of a datastore_id through the datastore cache (pal_os_datastore_cache.c).
+ * - The write is skipped, if the data is equal to the cached copy of the datastore_id.
+ * - Else the data is written with #pal_os_datastore_write, unless the last write of the datastore_id is less than
+ *   #OPTIGA_LIB_DATASTORE_CACHE_WINDOW_MS ago. Then the data is held in the cache until the next write after the
+ *   window or #pal_os_datastore_cache_flush.
+ * - Data longer than #OPTIGA_LIB_DATASTORE_CACHE_ENTRY_SIZE or of more datastore ids than
+ *   #OPTIGA_LIB_DATASTORE_CACHE_ENTRIES is written through.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The cache assumes the library is the only writer of the datastore ids.
+ *
+ * \param[in] datastore_id          Datastore id where the data should be written.
+ * \param[in] p_buffer              Valid pointer to the input buffer
+ * \param[in] length                Length of the data to be written
+ *
+ * \retval    #PAL_STATUS_SUCCESS   On successful execution
+ * \retval    #PAL_STATUS_FAILURE   On failure of #pal_os_datastore_write
+ */
+pal_status_t pal_os_datastore_cache_write(uint16_t datastore_id,
+                                          const uint8_t * p_buffer,
+                                          uint16_t length);
+
+/**
+ * \brief Reads data of a datastore_id through the datastore cache.
+ *
+ * \details
+ * Returns the cached copy of the datastore_id, else reads it with #pal_os_datastore_read and caches it.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]     datastore_id          Datastore id from where the data should be read.
+ * \param[out]    p_buffer              Valid Pointer to output buffer
+ * \param[in,out] p_buffer_length       Valid Pointer to the buffer length, updated with the length read
+ *
+ * \retval        #PAL_STATUS_SUCCESS   On successful execution
+ * \retval        #PAL_STATUS_FAILURE   On failure
+ */
+pal_status_t pal_os_datastore_cache_read(uint16_t datastore_id,
+                                         uint8_t * p_buffer,
+                                         uint16_t * p_buffer_length);
+
+/**
+ * \brief Writes the data held in the datastore cache.
+ *
+ * \details
+ * Writes the data of all the datastore ids, which is deferred within #OPTIGA_LIB_DATASTORE_CACHE_WINDOW_MS.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Invoked by the library, once the hibernate context is stored.
+ *
+ * \retval    #PAL_STATUS_SUCCESS   On successful execution
+ * \retval    #PAL_STATUS_FAILURE   On failure of any of the writes
+ */
+pal_status_t pal_os_datastore_cache_flush(void);
+
+/**
+ * \brief Returns the counters of the datastore cache.
+ *
+ * \param[out] p_stats              Valid pointer to the counters
+ */
+void pal_os_datastore_cache_get_stats(pal_os_datastore_cache_stats_t * p_stats);
+#else
+/// Reads the datastore id from the datastore of the platform
+#define PAL_OS_DATASTORE_READ(datastore_id, p_buffer, p_buffer_length) \
+    pal_os_datastore_read((datastore_id), (p_buffer), (p_buffer_length))
+/// Writes the datastore id to the datastore of the platform
+#define PAL_OS_DATASTORE_WRITE(datastore_id, p_buffer, length) \
+    pal_os_datastore_write((datastore_id), (p_buffer), (length))
+/// Nothing is deferred without the datastore cache
+#define PAL_OS_DATASTORE_FLUSH()    (PAL_STATUS_SUCCESS)
+#endif //OPTIGA_LIB_DATASTORE_CACHE_ENABLED
+
 #ifdef __cplusplus
 }
 #endif
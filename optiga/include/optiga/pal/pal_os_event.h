@@ -43,6 +43,7 @@ extern "C" {
 #endif
 
 #include "optiga/common/optiga_lib_types.h"
+#include "optiga/optiga_lib_config.h"
 
 /**
  * \brief typedef for Callback function when timer elapses.
@@ -180,6 +181,100 @@ LIBRARY_EXPORTS void pal_os_event_start(pal_os_event_t * p_pal_os_event,
  */
 LIBRARY_EXPORTS void pal_os_event_stop(pal_os_event_t * p_pal_os_event);
 
+#ifdef OPTIGA_LIB_EVENT_QUEUE_ENABLED
+/**
+ * \brief Creates an event of the event queue.
+ *
+ * \details
+ * Creates an event, which is multiplexed with the other events of the queue onto the os event of the platform.
+ *  - Each event has one registered callback, the same as the os event of the platform.
+ *  - The callbacks of the different events are pending at the same time, each at its own deadline.
+ *  - The callbacks are invoked from the context of the os event of the platform.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The events and the registrations are protected using #pal_os_lock_enter_critical_section, hence a callback can
+ *   be registered from an interrupt, if the platform supports the registration of the os event from an interrupt.
+ *
+ * \param[in] callback                      Callback function to be registered internally
+ * \param[in] callback_args                 Arguement to be passed to registered callback
+ *
+ * \retval    NULL                           All the events (#OPTIGA_LIB_EVENT_QUEUE_SIZE) are in use
+ * \retval    pal_os_event_t*                Pointer to the event
+ */
+pal_os_event_t * pal_os_event_queue_create(register_callback callback, void * callback_args);
+
+/**
+ * \brief Destroys an event of the event queue.
+ *
+ * \details
+ * Drops the pending callback and releases the event.
+ *
+ * \pre
+ * - The event must be created using #pal_os_event_queue_create.
+ *
+ * \note
+ * - None
+ *
+ * \param[in] p_pal_os_event                Pointer to the event
+ */
+void pal_os_event_queue_destroy(pal_os_event_t * p_pal_os_event);
+
+/**
+ * \brief Registers the callback of an event of the event queue, to trigger once when the time expires.
+ *
+ * \details
+ * Replaces the pending callback of the event, the pending callbacks of the other events are not affected.
+ *
+ * \pre
+ * - The event must be created using #pal_os_event_queue_create.
+ *
+ * \note
+ * - None
+ *
+ * \param[in] p_pal_os_event        Pointer to the event
+ * \param[in] callback              Callback function pointer
+ * \param[in] callback_args         Callback arguments
+ * \param[in] time_us               time in micro seconds to trigger the call back
+ */
+void pal_os_event_queue_register_callback_oneshot(pal_os_event_t * p_pal_os_event,
+                                                  register_callback callback,
+                                                  void * callback_args,
+                                                  uint32_t time_us);
+
+/**
+ * \brief Starts an event of the event queue, the same as #pal_os_event_start.
+ *
+ * \param[in] p_pal_os_event                Pointer to the event
+ * \param[in] callback                      Callback function to be registered internally
+ * \param[in] callback_args                 Arguement to be passed to registered callback
+ */
+void pal_os_event_queue_start(pal_os_event_t * p_pal_os_event, register_callback callback, void * callback_args);
+
+/**
+ * \brief Stops an event of the event queue and drops its pending callback.
+ *
+ * \param[in] p_pal_os_event                Pointer to the event
+ */
+void pal_os_event_queue_stop(pal_os_event_t * p_pal_os_event);
+
+/// Os event APIs used by the host library, which are served by the event queue
+#define PAL_OS_EVENT_CREATE                         pal_os_event_queue_create
+#define PAL_OS_EVENT_DESTROY                        pal_os_event_queue_destroy
+#define PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT      pal_os_event_queue_register_callback_oneshot
+#define PAL_OS_EVENT_START                          pal_os_event_queue_start
+#define PAL_OS_EVENT_STOP                           pal_os_event_queue_stop
+#else
+/// Os event APIs used by the host library, which are served by the platform
+#define PAL_OS_EVENT_CREATE                         pal_os_event_create
+#define PAL_OS_EVENT_DESTROY                        pal_os_event_destroy
+#define PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT      pal_os_event_register_callback_oneshot
+#define PAL_OS_EVENT_START                          pal_os_event_start
+#define PAL_OS_EVENT_STOP                           pal_os_event_stop
+#endif //OPTIGA_LIB_EVENT_QUEUE_ENABLED
+
 #ifdef __cplusplus
 }
 #endif
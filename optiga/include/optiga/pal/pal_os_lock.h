@@ -43,6 +43,10 @@ extern "C" {
 #endif
 
 #include "pal.h"
+
+/// Time out of #pal_os_lock_acquire_timeout, which waits until the lock is available
+#define PAL_OS_LOCK_WAIT_FOREVER        (0xFFFFFFFF)
+
 /**
  * @brief PAL OS lock structure .
  */
@@ -107,6 +111,28 @@ void pal_os_lock_destroy(pal_os_lock_t * p_lock);
  */
 pal_status_t pal_os_lock_acquire(pal_os_lock_t * p_lock);
 
+/**
+ * \brief Acquires a lock, waiting up to the time out.
+ *
+ * \details
+ * Acquires the lock associated with the instance of #pal_os_lock_t.
+ * - Blocks the calling thread until the lock is released by another thread or the time out elapses.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Implemented by the platforms with threads (e.g. Linux), where #pal_os_lock_acquire blocks as well.
+ * - A time out of 0 tries once, #PAL_OS_LOCK_WAIT_FOREVER waits until the lock is available.
+ *
+ * \param[in] p_lock         Valid instance of #pal_os_lock_t.
+ * \param[in] timeout_ms     Time out in milliseconds.
+ *
+ * \retval    #PAL_STATUS_SUCCESS  The lock is acquired.
+ * \retval    #PAL_STATUS_FAILURE  The lock is not available within the time out.
+ */
+pal_status_t pal_os_lock_acquire_timeout(pal_os_lock_t * p_lock, uint32_t timeout_ms);
+
 /**
  * \brief Releases the lock.
  *
@@ -155,6 +181,46 @@ void pal_os_lock_enter_critical_section(void);
  */
 void pal_os_lock_exit_critical_section(void);
 
+/**
+ * \brief Acquires the link to OPTIGA, which is shared with other processes.
+ *
+ * \details
+ * Acquires the link, which is used by the IFX I2C protocol stack with OPTIGA_COMMS_SHARED_LINK_ENABLED.
+ * - Blocks the calling thread until the link is released by the other process.
+ * - Reads the link state, which is stored by the last owner of the link. The state is all zero, if none is stored.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Implemented by the platforms with processes (e.g. Linux). The link is released, if the owning process terminates.
+ *
+ * \param[out] p_link_state  Buffer to store the link state.
+ * \param[in]  length        Length of the link state.
+ *
+ * \retval    #PAL_STATUS_SUCCESS  The link is acquired.
+ * \retval    #PAL_STATUS_FAILURE  The link could not be acquired.
+ */
+pal_status_t pal_os_lock_acquire_shared_link(uint8_t * p_link_state, uint16_t length);
+
+/**
+ * \brief Releases the link to OPTIGA, which is shared with other processes.
+ *
+ * \details
+ * Stores the link state for the next owner of the link and releases the link.
+ *
+ * \pre
+ * - The link is acquired using #pal_os_lock_acquire_shared_link.
+ *
+ * \note
+ * - Implemented by the platforms with processes (e.g. Linux).
+ *
+ * \param[in] p_link_state   Link state to be stored.
+ * \param[in] length         Length of the link state.
+ *
+ */
+void pal_os_lock_release_shared_link(const uint8_t * p_link_state, uint16_t length);
+
 #ifdef __cplusplus
 }
 #endif
@@ -44,6 +44,31 @@ extern "C" {
 #endif
 
 #include "pal.h"
+#include "optiga/optiga_lib_config.h"
+
+#ifdef OPTIGA_LIB_MEMORY_POOL_ENABLED
+/// Size class of the memory pool with #OPTIGA_LIB_MEMORY_POOL_SMALL_BLOCK_SIZE blocks
+#define PAL_OS_MEMORY_POOL_SMALL    (0x00)
+/// Size class of the memory pool with #OPTIGA_LIB_MEMORY_POOL_LARGE_BLOCK_SIZE blocks
+#define PAL_OS_MEMORY_POOL_LARGE    (0x01)
+/// Number of size classes of the memory pool
+#define PAL_OS_MEMORY_POOL_COUNT    (0x02)
+
+/** \brief Usage of one size class of the memory pool */
+typedef struct pal_os_memory_pool_stats
+{
+    /// Size of the blocks in bytes
+    uint16_t block_size;
+    /// Number of blocks
+    uint16_t block_count;
+    /// Number of blocks currently allocated
+    uint16_t blocks_in_use;
+    /// Maximum number of blocks allocated at the same time
+    uint16_t high_water_mark;
+    /// Number of allocations served by the platform heap, since the size class was exhausted or too small
+    uint32_t fallback_count;
+}pal_os_memory_pool_stats_t;
+#endif //OPTIGA_LIB_MEMORY_POOL_ENABLED
 
 
 /**
@@ -150,6 +175,165 @@ LIBRARY_EXPORTS void pal_os_memcpy(void * p_destination, const void * p_source,
  */
 LIBRARY_EXPORTS void pal_os_memset(void * p_buffer, uint32_t value, uint32_t size);
 
+#ifdef OPTIGA_LIB_MEMORY_POOL_ENABLED
+/**
+ * \brief Allocates a block from the fixed block memory pool.
+ *
+ * <br>
+ *
+ * \details
+ * - Allocates a block from the smallest size class, which fits the block size, in constant time.
+ * - If the size class is exhausted, the block is allocated from the larger size class.
+ * - Used by pal_os_malloc and pal_os_calloc of the platform, which fall back to the platform heap if NULL is returned.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The content of the block is not initialized.
+ * - The block size and the number of blocks of the size classes are configured in optiga_lib_config.h.
+ *
+ * \param[in] block_size         Size of the block
+ *
+ * \retval  Block Pointer  Memory allocation is successful
+ * \retval  NULL           Block size is 0, larger than the size classes or the pool is exhausted
+ */
+LIBRARY_EXPORTS void * pal_os_memory_pool_alloc(uint32_t block_size);
+
+/**
+ * \brief Returns a block to the fixed block memory pool.
+ *
+ * <br>
+ *
+ * \details
+ * - Returns the block to its size class in constant time, if the block is part of the pool.
+ * - Used by pal_os_free of the platform, which frees the block using the platform heap if FALSE is returned.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in] p_block      Pointer to memory block to be freed
+ *
+ * \retval  TRUE   Block is returned to the pool
+ * \retval  FALSE  Block is not part of the pool
+ */
+LIBRARY_EXPORTS bool_t pal_os_memory_pool_free(void * p_block);
+
+/**
+ * \brief Provides the usage of one size class of the fixed block memory pool.
+ *
+ * <br>
+ *
+ * \details
+ * - Provides the blocks in use, the high water mark and the allocations which fell back to the platform heap.
+ * - Used to size #OPTIGA_LIB_MEMORY_POOL_SMALL_BLOCK_COUNT and #OPTIGA_LIB_MEMORY_POOL_LARGE_BLOCK_COUNT
+ *   for the instances created by the application.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]  size_class      Size class, #PAL_OS_MEMORY_POOL_SMALL or #PAL_OS_MEMORY_POOL_LARGE
+ * \param[out] p_stats         Pointer to store the usage
+ *
+ * \retval  #PAL_STATUS_SUCCESS        Usage is provided
+ * \retval  #PAL_STATUS_INVALID_INPUT  Wrong input arguments provided
+ */
+LIBRARY_EXPORTS pal_status_t pal_os_memory_get_pool_stats(uint8_t size_class, pal_os_memory_pool_stats_t * p_stats);
+#endif //OPTIGA_LIB_MEMORY_POOL_ENABLED
+
+#ifdef OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+/**
+ * \brief Acquires the memory segment, which is shared by the processes using the same OPTIGA.
+ *
+ * <br>
+ *
+ * \details
+ * - Maps the segment of the size into the process on the first invocation. A segment, which is created, is zero filled.
+ * - Blocks the calling thread until the segment is released by the other process, hence one process at a time
+ *   accesses it.
+ * - Used by the shared read cache (#OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED).
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Implemented by the platforms with processes (e.g. Linux). The segment is released, if the owning process terminates.
+ * - Return NULL, if no segment is available. The read cache is local to the process then.
+ *
+ * \param[in] size         Size of the segment in bytes
+ *
+ * \retval  Segment Pointer  Segment is acquired
+ * \retval  NULL             Segment is not available
+ */
+LIBRARY_EXPORTS void * pal_os_memory_shared_acquire(uint32_t size);
+
+/**
+ * \brief Releases the memory segment, which is acquired using #pal_os_memory_shared_acquire.
+ *
+ * <br>
+ *
+ * \details
+ * - The segment stays mapped for the next acquire.
+ *
+ * \pre
+ * - The segment is acquired using #pal_os_memory_shared_acquire.
+ *
+ * \note
+ * - Implemented by the platforms with processes (e.g. Linux).
+ */
+LIBRARY_EXPORTS void pal_os_memory_shared_release(void);
+#endif //OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+
+#ifdef OPTIGA_CRYPT_DATA_KEY_LOCKED_MEMORY_ENABLED
+/**
+ * \brief Locks the memory holding keys.
+ *
+ * <br>
+ *
+ * \details
+ * - Keeps the memory resident (not swapped) and excludes it from core dumps.
+ * - Used by the data keys (#OPTIGA_CRYPT_DATA_KEY_LOCKED_MEMORY_ENABLED).
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Implemented by the platforms with virtual memory (e.g. Linux). The whole pages holding the memory are locked.
+ *
+ * \param[in] p_buffer     Memory to be locked
+ * \param[in] size         Size of the memory in bytes
+ *
+ * \retval  PAL_STATUS_SUCCESS  Memory is locked
+ * \retval  PAL_STATUS_FAILURE  Memory cannot be locked (e.g. limit of the locked memory of the process)
+ */
+LIBRARY_EXPORTS pal_status_t pal_os_memory_lock(void * p_buffer, uint32_t size);
+
+/**
+ * \brief Unlocks the memory, which is locked using #pal_os_memory_lock.
+ *
+ * <br>
+ *
+ * \details
+ * - The keys must be erased before the memory is unlocked.
+ *
+ * \pre
+ * - The memory is locked using #pal_os_memory_lock.
+ *
+ * \note
+ * - Implemented by the platforms with virtual memory (e.g. Linux).
+ *
+ * \param[in] p_buffer     Memory to be unlocked
+ * \param[in] size         Size of the memory in bytes
+ */
+LIBRARY_EXPORTS void pal_os_memory_unlock(void * p_buffer, uint32_t size);
+#endif //OPTIGA_CRYPT_DATA_KEY_LOCKED_MEMORY_ENABLED
+
 #ifdef __cplusplus
 }
 #endif
@@ -79,6 +79,24 @@ uint32_t pal_os_timer_get_time_in_microseconds(void);
  */
 uint32_t pal_os_timer_get_time_in_milliseconds(void);
 
+/**
+ * \brief Gets the value of a free running cycle counter of the host
+ *
+ * \details
+ * Get the current value of the cycle counter (e.g. DWT CYCCNT of Cortex-M), used by the host CPU cost profiling
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Required only if OPTIGA_LIB_PROFILE_ENABLED is defined.
+ * - Hosts without an accessible cycle counter return a count of a finer resolution than microseconds
+ *   (e.g. nanoseconds), the counter is expected to wrap around at 32 bit.
+ *
+ * \retval  uint32_t cycle count
+ */
+uint32_t pal_os_timer_get_cycle_count(void);
+
 /**
  * \brief Waits or delay until the supplied milliseconds
  *
@@ -0,0 +1,178 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_os_wait.h
+*
+* \brief   This file provides the prototype declarations of PAL OS wait object functionalities
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#ifndef _PAL_OS_WAIT_H_
+#define _PAL_OS_WAIT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "pal.h"
+/**
+ * @brief PAL OS wait object structure.
+ */
+typedef struct pal_os_wait
+{
+    /// Platform specific wait object (e.g. semaphore)
+    void * os_wait_object;
+    /// Signaled state, used by the platforms without wait object
+    volatile uint8_t is_signaled;
+} pal_os_wait_t;
+
+/**
+ * \brief Creates a wait object.
+ *
+ * \details
+ * Creates a wait object to the instance of #pal_os_wait_t.
+ * - The wait object is created in non signaled state.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in] p_wait          Valid instance of #pal_os_wait_t.
+ *
+ * \retval    #PAL_STATUS_SUCCESS  Wait object is created.
+ * \retval    #PAL_STATUS_FAILURE  Wait object creation failed.
+ */
+pal_status_t pal_os_wait_create(pal_os_wait_t * p_wait);
+
+/**
+ * \brief Destroys the wait object.
+ *
+ * \details
+ * Destroys the wait object of the instance of #pal_os_wait_t.
+ *
+ * \pre
+ * - No caller is blocked on the wait object.
+ *
+ * \note
+ * - None
+ *
+ * \param[in] p_wait          Valid instance of #pal_os_wait_t.
+ *
+ */
+void pal_os_wait_destroy(pal_os_wait_t * p_wait);
+
+/**
+ * \brief Blocks the caller until the wait object is signaled.
+ *
+ * \details
+ * Blocks the caller until the wait object is signaled, without consuming CPU time where the platform allows.
+ * - Returns immediately, if the wait object is already signaled.
+ * - The wait object is in non signaled state on return.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Must not be invoked from the context in which #pal_os_event_t callbacks are executed.
+ *
+ * \param[in] p_wait          Valid instance of #pal_os_wait_t.
+ *
+ */
+void pal_os_wait_for_signal(pal_os_wait_t * p_wait);
+
+/**
+ * \brief Signals the wait object.
+ *
+ * \details
+ * Signals the wait object and wakes up the caller blocked in #pal_os_wait_for_signal.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Can be invoked from the context in which #pal_os_event_t callbacks are executed (e.g. timer interrupt or signal handler).
+ *
+ * \param[in] p_wait          Valid instance of #pal_os_wait_t.
+ *
+ */
+void pal_os_wait_signal(pal_os_wait_t * p_wait);
+
+/**
+ * \brief Clears the signaled state of the wait object without blocking.
+ *
+ * \details
+ * Clears the signaled state of the wait object without blocking.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in] p_wait          Valid instance of #pal_os_wait_t.
+ *
+ * \retval    TRUE             Wait object was signaled.
+ * \retval    FALSE            Wait object was not signaled.
+ */
+bool_t pal_os_wait_clear_signal(pal_os_wait_t * p_wait);
+
+/**
+ * \brief Provides the pollable descriptor of the wait object.
+ *
+ * \details
+ * Provides the descriptor of the wait object, which becomes readable when the wait object is signaled.
+ * - The descriptor can be used with poll, select or epoll by an event loop.
+ * - The signaled state is cleared using #pal_os_wait_clear_signal or #pal_os_wait_for_signal.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - Available only on platforms with file descriptors (e.g. eventfd on Linux).
+ *
+ * \param[in] p_wait          Valid instance of #pal_os_wait_t.
+ *
+ * \retval    Descriptor       Pollable descriptor of the wait object.
+ * \retval    -1               Platform does not provide pollable descriptor.
+ */
+int32_t pal_os_wait_get_descriptor(const pal_os_wait_t * p_wait);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_PAL_OS_WAIT_H_ */
+
+/**
+ * @}
+ */
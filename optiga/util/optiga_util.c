@@ -39,6 +39,9 @@
 #include "optiga/common/optiga_lib_logger.h"
 #include "optiga/common/optiga_lib_common_internal.h"
 #include "optiga/pal/pal_os_memory.h"
+#ifdef OPTIGA_UTIL_PROTECTED_UPDATE_CHECK_ENABLED
+#include "optiga/pal/pal_crypt.h"
+#endif //OPTIGA_UTIL_PROTECTED_UPDATE_CHECK_ENABLED
 
 #if defined (OPTIGA_LIB_ENABLE_LOGGING) && defined (OPTIGA_LIB_ENABLE_UTIL_LOGGING)
 
@@ -81,16 +84,729 @@
 extern void optiga_cmd_set_shielded_connection_option(optiga_cmd_t * me, uint8_t value,
                                                       uint8_t shielded_connection_option);
 
+#ifdef OPTIGA_UTIL_READ_CACHE_ENABLED
+// No preload of the read cache is pending
+#define OPTIGA_UTIL_READ_CACHE_PRELOAD_NONE         (0x00)
+// Read cache is preloaded, once the open application is completed
+#define OPTIGA_UTIL_READ_CACHE_PRELOAD_OPEN         (0x01)
+// Registered data objects are being preloaded
+#define OPTIGA_UTIL_READ_CACHE_PRELOAD_ONGOING      (0x02)
+#endif //OPTIGA_UTIL_READ_CACHE_ENABLED
+
+#ifdef OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+// No probe of the capabilities is pending
+#define OPTIGA_UTIL_CAPABILITY_PROBE_NONE           (0x00)
+// Capabilities are probed, once the open application is completed
+#define OPTIGA_UTIL_CAPABILITY_PROBE_OPEN           (0x01)
+// Coprocessor UID is being read
+#define OPTIGA_UTIL_CAPABILITY_PROBE_ONGOING        (0x02)
+// Coprocessor UID data object
+#define OPTIGA_UTIL_COPROCESSOR_UID_OID             (0xE0C2)
+// Offset of the ESW build number (BCD coded) in the coprocessor UID
+#define OPTIGA_UTIL_COPROCESSOR_UID_BUILD_OFFSET    (25)
+#endif //OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+
+#ifdef OPTIGA_UTIL_DIFFERENTIAL_WRITE_ENABLED
+// No differential write is ongoing
+#define OPTIGA_UTIL_DIFF_WRITE_NONE                 (0x00)
+// Current data of the data object is read from OPTIGA and compared
+#define OPTIGA_UTIL_DIFF_WRITE_COMPARE              (0x01)
+// Changed ranges are being written
+#define OPTIGA_UTIL_DIFF_WRITE_RANGES               (0x02)
+// Number of bytes of the read cache compared at once
+#define OPTIGA_UTIL_DIFF_WRITE_CACHE_CHUNK_SIZE     (0x20)
+#endif //OPTIGA_UTIL_DIFFERENTIAL_WRITE_ENABLED
+
+#ifdef OPTIGA_UTIL_PROTECTED_UPDATE_CHECK_ENABLED
+// Major types of CBOR items
+#define OPTIGA_UTIL_CBOR_UNSIGNED_INTEGER           (0x00)
+#define OPTIGA_UTIL_CBOR_NEGATIVE_INTEGER           (0x01)
+#define OPTIGA_UTIL_CBOR_BYTE_STRING                (0x02)
+#define OPTIGA_UTIL_CBOR_TEXT_STRING                (0x03)
+#define OPTIGA_UTIL_CBOR_ARRAY                      (0x04)
+#define OPTIGA_UTIL_CBOR_MAP                        (0x05)
+#define OPTIGA_UTIL_CBOR_TAG                        (0x06)
+#define OPTIGA_UTIL_CBOR_SIMPLE                     (0x07)
+// Additional information of CBOR items, which indicates a 1 byte argument. 2 and 4 byte arguments follow
+#define OPTIGA_UTIL_CBOR_ARGUMENT_1_BYTE            (0x18)
+#define OPTIGA_UTIL_CBOR_ARGUMENT_4_BYTES           (0x1A)
+// Simple value nil
+#define OPTIGA_UTIL_CBOR_NIL                        (0xF6)
+// COSE_Sign1 tag
+#define OPTIGA_UTIL_COSE_SIGN1_TAG                  (0xD2)
+// Header label of the algorithm and of the key identifier
+#define OPTIGA_UTIL_COSE_LABEL_ALG                  (0x01)
+#define OPTIGA_UTIL_COSE_LABEL_KID                  (0x04)
+// Algorithm ES-256 (-7), held as the argument of the negative integer
+#define OPTIGA_UTIL_COSE_ALG_ES256                  (0x06)
+// Integrity check of the first fragment (-1), held as the argument of the negative integer
+#define OPTIGA_UTIL_MANIFEST_PROCESS_INTEGRITY      (0x00)
+// Digest algorithm SHA-256
+#define OPTIGA_UTIL_MANIFEST_DIGEST_SHA256          (0x29)
+// Length of the key identifier and of the storage identifier (OID)
+#define OPTIGA_UTIL_MANIFEST_OID_LENGTH             (0x02)
+// Maximum length of the raw signature of the manifest (ECC NIST P 521)
+#define OPTIGA_UTIL_MANIFEST_MAX_SIGNATURE_LENGTH   (0x84)
+
+// Reader of the CBOR items of the manifest
+typedef struct optiga_util_cbor_reader
+{
+    // CBOR encoded data
+    const uint8_t * p_data;
+    // Length of the data
+    uint32_t length;
+    // Offset of the next item
+    uint32_t offset;
+} optiga_util_cbor_reader_t;
+#endif //OPTIGA_UTIL_PROTECTED_UPDATE_CHECK_ENABLED
+
+
+
+#ifdef OPTIGA_UTIL_READ_CACHE_ENABLED
+/*
+* Starts the read of the next data object to be preloaded into the read cache.
+* Returns FALSE, if no more data object is to be preloaded.
+*/
+_STATIC_H bool_t optiga_util_read_cache_preload_next(optiga_util_t * me)
+{
+    optiga_get_data_object_params_t * p_params = &me->params.optiga_get_data_object_params;
+    uint8_t * p_buffer;
+    uint16_t oid;
+
+    p_buffer = optiga_cmd_read_cache_get_preload(me->my_cmd, &me->read_cache_preload_index, &oid);
+    if (NULL != p_buffer)
+    {
+        pal_os_memset(&me->params, 0x00, sizeof(optiga_util_params_t));
+        me->read_cache_preload_length = OPTIGA_UTIL_READ_CACHE_MAX_OBJECT_SIZE;
+        p_params->oid = oid;
+        p_params->offset = 0;
+        p_params->data_or_metadata = 0;
+        // the data is read into the entry, which caches it on completion
+        p_params->buffer = p_buffer;
+        p_params->bytes_to_read = me->read_cache_preload_length;
+        p_params->ref_bytes_to_read = &me->read_cache_preload_length;
+        OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
+        OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
+        //lint --e{534} suppress "The status is reported to the event handler"
+        optiga_cmd_get_data_object(me->my_cmd, p_params->data_or_metadata, p_params);
+    }
+    return ((NULL != p_buffer) ? TRUE : FALSE);
+}
+#endif //OPTIGA_UTIL_READ_CACHE_ENABLED
+
+#ifdef OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+/*
+* Reads the coprocessor UID once the open application is completed and sets the capabilities of OPTIGA from the
+* ESW build number. Returns TRUE, if the read is started and the open application is reported on its completion.
+*/
+_STATIC_H bool_t optiga_util_capability_probe_resume(optiga_util_t * me, optiga_lib_status_t * p_event)
+{
+    optiga_get_data_object_params_t * p_params = &me->params.optiga_get_data_object_params;
+    bool_t is_resumed = FALSE;
+    uint16_t build_number;
+
+    if (OPTIGA_UTIL_CAPABILITY_PROBE_OPEN == me->capability_probe_state)
+    {
+        me->capability_probe_state = OPTIGA_UTIL_CAPABILITY_PROBE_NONE;
+        // OPTIGA is probed once, the later opens use the capabilities probed
+        if ((OPTIGA_LIB_SUCCESS == *p_event) && (0 == optiga_cmd_get_capabilities(me->my_cmd)))
+        {
+            pal_os_memset(&me->params, 0x00, sizeof(optiga_util_params_t));
+            me->capability_uid_length = sizeof(me->capability_uid);
+            p_params->oid = OPTIGA_UTIL_COPROCESSOR_UID_OID;
+            p_params->offset = 0;
+            p_params->data_or_metadata = 0;
+            p_params->buffer = me->capability_uid;
+            p_params->bytes_to_read = me->capability_uid_length;
+            p_params->ref_bytes_to_read = &me->capability_uid_length;
+            me->capability_probe_state = OPTIGA_UTIL_CAPABILITY_PROBE_ONGOING;
+            OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
+            OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
+            //lint --e{534} suppress "The status is reported to the event handler"
+            optiga_cmd_get_data_object(me->my_cmd, p_params->data_or_metadata, p_params);
+            is_resumed = TRUE;
+        }
+    }
+    else if (OPTIGA_UTIL_CAPABILITY_PROBE_ONGOING == me->capability_probe_state)
+    {
+        me->capability_probe_state = OPTIGA_UTIL_CAPABILITY_PROBE_NONE;
+        // A failed probe leaves all the features to be attempted, the open application is successful anyway
+        if ((OPTIGA_LIB_SUCCESS == *p_event) &&
+            ((OPTIGA_UTIL_COPROCESSOR_UID_BUILD_OFFSET + 2) <= me->capability_uid_length))
+        {
+            optiga_common_get_uint16(&me->capability_uid[OPTIGA_UTIL_COPROCESSOR_UID_BUILD_OFFSET], &build_number);
+            // The build numbers are BCD coded, hence compared as is
+            optiga_cmd_set_capabilities(me->my_cmd,
+                                        (OPTIGA_LIB_CAPABILITY_M_V3_MIN_BUILD_NUMBER <= build_number) ?
+                                        OPTIGA_LIB_CAPABILITIES_M_V3 : OPTIGA_LIB_CAPABILITIES_M_V1);
+        }
+        *p_event = OPTIGA_LIB_SUCCESS;
+    }
+    return (is_resumed);
+}
+#endif //OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+
+#ifdef OPTIGA_UTIL_METADATA_CACHE_ENABLED
+/*
+* Starts the read of the metadata of the next object to be loaded, whose metadata is not cached.
+* Returns FALSE, if no more object is to be loaded.
+*/
+_STATIC_H bool_t optiga_util_metadata_cache_load_next(optiga_util_t * me)
+{
+    optiga_get_data_object_params_t * p_params = &me->params.optiga_get_data_object_params;
+    optiga_lib_metadata_info_t info;
+    bool_t read_started = FALSE;
+
+    while ((FALSE == read_started) && (me->metadata_cache_index < me->metadata_cache_count))
+    {
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_metadata_cache_get(me->my_cmd,
+                                                                me->p_metadata_cache_oids[me->metadata_cache_index],
+                                                                &info))
+        {
+            pal_os_memset(&me->params, 0x00, sizeof(optiga_util_params_t));
+            me->metadata_cache_length = sizeof(me->metadata_cache_buffer);
+            p_params->oid = me->p_metadata_cache_oids[me->metadata_cache_index];
+            p_params->offset = 0;
+            // the metadata read is parsed and cached on completion
+            p_params->data_or_metadata = 1;
+            p_params->buffer = me->metadata_cache_buffer;
+            p_params->bytes_to_read = me->metadata_cache_length;
+            p_params->ref_bytes_to_read = &me->metadata_cache_length;
+            OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
+            OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
+            if (OPTIGA_LIB_SUCCESS == optiga_cmd_get_data_object(me->my_cmd, p_params->data_or_metadata, p_params))
+            {
+                read_started = TRUE;
+            }
+            else if (OPTIGA_LIB_SUCCESS == me->metadata_cache_load_status)
+            {
+                me->metadata_cache_load_status = OPTIGA_UTIL_ERROR;
+            }
+            else
+            {
+                // The first failure is reported
+            }
+        }
+        me->metadata_cache_index++;
+    }
+    return (read_started);
+}
+#endif //OPTIGA_UTIL_METADATA_CACHE_ENABLED
+
+_STATIC_H void optiga_util_reset_protection_level(optiga_util_t * me);
+
+#ifdef OPTIGA_UTIL_READ_DATA_MULTIPLE_ENABLED
+/*
+* Issues the reads of the next chunk of the items, under one acquisition of the lock.
+* The items served by the read cache are skipped.
+*/
+_STATIC_H optiga_lib_status_t optiga_util_read_multiple_next_chunk(optiga_util_t * me)
+{
+    optiga_util_read_item_t * p_item;
+    optiga_get_data_object_params_t * p_params;
+    uint8_t index = 0;
+
+    for (; (me->read_multiple_index < me->read_multiple_count) && (index < OPTIGA_UTIL_READ_DATA_MULTIPLE_CHUNK_SIZE);
+         me->read_multiple_index++)
+    {
+        p_item = &me->p_read_multiple_items[me->read_multiple_index];
+        if (OPTIGA_LIB_BUSY != p_item->status)
+        {
+            continue;
+        }
+        p_params = &me->read_multiple_params[index];
+        pal_os_memset(p_params, 0x00, sizeof(optiga_get_data_object_params_t));
+
+        p_params->oid = p_item->oid;
+        p_params->offset = p_item->offset;
+        p_params->data_or_metadata = p_item->read_type;
+        p_params->buffer = p_item->buffer;
+        p_params->bytes_to_read = p_item->length;
+        p_params->ref_bytes_to_read = &p_item->length;
+
+        me->read_multiple_batch_items[index].cmd_type = OPTIGA_CMD_BATCH_ITEM_GET_DATA_OBJECT;
+        me->read_multiple_batch_items[index].cmd_param = p_item->read_type;
+        me->read_multiple_batch_items[index].params = p_params;
+        me->read_multiple_map[index] = me->read_multiple_index;
+        index++;
+    }
+    me->read_multiple_chunk_count = index;
+    if (0U == index)
+    {
+        return (OPTIGA_UTIL_ERROR_INVALID_INPUT);
+    }
+    OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
+    OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
+
+    return (optiga_cmd_execute_batch(me->my_cmd, me->read_multiple_batch_items, index));
+}
+
+/*
+* Ends the reads, the items which are not read get the status provided.
+* Returns the status of the first failed item.
+*/
+_STATIC_H optiga_lib_status_t optiga_util_read_multiple_end(optiga_util_t * me,
+                                                            optiga_lib_status_t abort_status)
+{
+    optiga_lib_status_t return_value = OPTIGA_LIB_SUCCESS;
+    uint16_t index;
+
+    for (index = 0; index < me->read_multiple_count; index++)
+    {
+        if (OPTIGA_LIB_BUSY == me->p_read_multiple_items[index].status)
+        {
+            me->p_read_multiple_items[index].status = abort_status;
+            me->p_read_multiple_items[index].length = 0;
+        }
+        if ((OPTIGA_LIB_SUCCESS == return_value) && (OPTIGA_LIB_SUCCESS != me->p_read_multiple_items[index].status))
+        {
+            return_value = me->p_read_multiple_items[index].status;
+        }
+    }
+    me->read_multiple_count = 0;
+    optiga_util_reset_protection_level(me);
+    return (return_value);
+}
+
+/*
+* Takes the results of the completed chunk and issues the next chunk of the reads.
+* Returns TRUE, if the reads are continued with the next chunk.
+*/
+_STATIC_H bool_t optiga_util_read_multiple_resume(optiga_util_t * me,
+                                                  optiga_lib_status_t * p_event)
+{
+    bool_t is_resumed = FALSE;
+    uint8_t index;
+
+    do
+    {
+        if (0U == me->read_multiple_count)
+        {
+            break;
+        }
+        for (index = 0; index < me->read_multiple_chunk_count; index++)
+        {
+            me->p_read_multiple_items[me->read_multiple_map[index]].status = me->read_multiple_batch_items[index].status;
+        }
+
+        // A failed read reported by OPTIGA does not stop the reads, a failure of the communication does
+        if ((OPTIGA_LIB_SUCCESS == *p_event) || (OPTIGA_DEVICE_ERROR == (*p_event & OPTIGA_DEVICE_ERROR)))
+        {
+            if (OPTIGA_LIB_SUCCESS == optiga_util_read_multiple_next_chunk(me))
+            {
+                is_resumed = TRUE;
+                break;
+            }
+        }
+        *p_event = optiga_util_read_multiple_end(me, *p_event);
+    } while (FALSE);
+    return (is_resumed);
+}
+#endif //OPTIGA_UTIL_READ_DATA_MULTIPLE_ENABLED
+
+#ifdef OPTIGA_UTIL_DIFFERENTIAL_WRITE_ENABLED
+/*
+* Records the changed bytes from start till end (excluded), relative to the offset of the write.
+* A range closer than the merge gap to the previous one is merged, since a separate command costs more than the
+* unchanged bytes in between. Once all the ranges are used, the last range is extended.
+*/
+_STATIC_H void optiga_util_diff_write_mark(optiga_util_t * me, uint16_t start, uint16_t end)
+{
+    uint8_t last = me->diff_write_range_count - 1U;
+
+    if ((0U != me->diff_write_range_count) &&
+        (((uint32_t)start <= ((uint32_t)me->diff_write_ranges[last][1] + OPTIGA_UTIL_DIFFERENTIAL_WRITE_MERGE_GAP)) ||
+         (OPTIGA_UTIL_DIFFERENTIAL_WRITE_MAX_RANGES == me->diff_write_range_count)))
+    {
+        me->diff_write_ranges[last][1] = end;
+    }
+    else
+    {
+        me->diff_write_ranges[me->diff_write_range_count][0] = start;
+        me->diff_write_ranges[me->diff_write_range_count][1] = end;
+        me->diff_write_range_count++;
+    }
+}
+
+/*
+* Compares the current data at the position (relative to the offset of the write) with the data to be written
+*/
+_STATIC_H void optiga_util_diff_write_compare(optiga_util_t * me,
+                                              const uint8_t * p_current,
+                                              uint16_t position,
+                                              uint16_t length)
+{
+    const uint8_t * p_data = me->p_diff_write_buffer + position;
+    uint16_t index = 0;
+    uint16_t start;
+
+    if (position < me->diff_write_length)
+    {
+        length = MIN(length, (me->diff_write_length - position));
+        while (index < length)
+        {
+            if (p_current[index] == p_data[index])
+            {
+                index++;
+                continue;
+            }
+            start = index;
+            while ((index < length) && (p_current[index] != p_data[index]))
+            {
+                index++;
+            }
+            optiga_util_diff_write_mark(me, position + start, position + index);
+        }
+    }
+}
+
+/*
+* Receives the current data read from OPTIGA chunk wise
+*/
+_STATIC_H void optiga_util_diff_write_stream_callback(void * context,
+                                                      const uint8_t * p_chunk,
+                                                      uint16_t chunk_length,
+                                                      uint16_t chunk_offset)
+{
+    optiga_util_diff_write_compare((optiga_util_t *)context, p_chunk, chunk_offset, chunk_length);
+}
+
+#ifdef OPTIGA_UTIL_READ_CACHE_ENABLED
+/*
+* Compares the data to be written with the cached data of the data object.
+* The data beyond the cached part is considered as changed.
+* Returns FALSE, if the data object is not cached.
+*/
+_STATIC_H bool_t optiga_util_diff_write_compare_cached(optiga_util_t * me)
+{
+    uint8_t cached_data[OPTIGA_UTIL_DIFF_WRITE_CACHE_CHUNK_SIZE];
+    uint16_t position = 0;
+    uint16_t length;
+    uint16_t requested_length;
+
+    while (position < me->diff_write_length)
+    {
+        requested_length = (uint16_t)MIN(sizeof(cached_data), (uint16_t)(me->diff_write_length - position));
+        length = requested_length;
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_read_cache_get(me->my_cmd,
+                                                            me->diff_write_oid,
+                                                            me->diff_write_offset + position,
+                                                            cached_data,
+                                                            &length))
+        {
+            break;
+        }
+        optiga_util_diff_write_compare(me, cached_data, position, length);
+        position += length;
+        // End of the data object is reached
+        if (length < requested_length)
+        {
+            break;
+        }
+    }
+    if ((0U != position) && (position < me->diff_write_length))
+    {
+        optiga_util_diff_write_mark(me, position, me->diff_write_length);
+    }
+    return ((0U != position) ? TRUE : FALSE);
+}
+#endif //OPTIGA_UTIL_READ_CACHE_ENABLED
+
+/*
+* Writes the current changed range of the differential write
+*/
+_STATIC_H optiga_lib_status_t optiga_util_diff_write_range(optiga_util_t * me)
+{
+    optiga_set_data_object_params_t * p_params = &me->params.optiga_set_data_object_params;
+    uint16_t start = me->diff_write_ranges[me->diff_write_range_index][0];
+
+    pal_os_memset(&me->params, 0x00, sizeof(optiga_util_params_t));
+    p_params->oid = me->diff_write_oid;
+    p_params->offset = me->diff_write_offset + start;
+    p_params->data_or_metadata = 0;
+    p_params->buffer = me->p_diff_write_buffer + start;
+    p_params->size = me->diff_write_ranges[me->diff_write_range_index][1] - start;
+    p_params->write_type = OPTIGA_UTIL_WRITE_ONLY;
+    OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
+    OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
+
+    return (optiga_cmd_set_data_object(me->my_cmd, OPTIGA_UTIL_WRITE_ONLY, p_params));
+}
+
+/*
+* Takes the result of the comparison or of the written range and writes the next changed range.
+* Returns TRUE, if the differential write is continued.
+*/
+_STATIC_H bool_t optiga_util_diff_write_resume(optiga_util_t * me,
+                                               optiga_lib_status_t * p_event)
+{
+    bool_t is_resumed = FALSE;
+
+    do
+    {
+        if (OPTIGA_UTIL_DIFF_WRITE_NONE == me->diff_write_state)
+        {
+            break;
+        }
+        if (OPTIGA_UTIL_DIFF_WRITE_COMPARE == me->diff_write_state)
+        {
+            if (OPTIGA_LIB_SUCCESS != *p_event)
+            {
+                // The current data is unknown (e.g. the data object is not readable), the complete data is written
+                me->diff_write_range_count = 0;
+                me->diff_write_read_length = 0;
+            }
+            if (me->diff_write_read_length < me->diff_write_length)
+            {
+                // The data beyond the end of the data object is new
+                optiga_util_diff_write_mark(me, me->diff_write_read_length, me->diff_write_length);
+            }
+            *p_event = OPTIGA_LIB_SUCCESS;
+            me->diff_write_state = OPTIGA_UTIL_DIFF_WRITE_RANGES;
+        }
+        else if (OPTIGA_LIB_SUCCESS == *p_event)
+        {
+            me->diff_write_range_index++;
+        }
+        else
+        {
+            // The failure of the write is reported
+        }
+
+        if ((OPTIGA_LIB_SUCCESS == *p_event) && (me->diff_write_range_index < me->diff_write_range_count))
+        {
+            *p_event = optiga_util_diff_write_range(me);
+            if (OPTIGA_LIB_SUCCESS == *p_event)
+            {
+                is_resumed = TRUE;
+                break;
+            }
+        }
+        me->diff_write_state = OPTIGA_UTIL_DIFF_WRITE_NONE;
+        optiga_util_reset_protection_level(me);
+    } while (FALSE);
+    return (is_resumed);
+}
+#endif //OPTIGA_UTIL_DIFFERENTIAL_WRITE_ENABLED
+
+#ifdef OPTIGA_UTIL_COUNT_COALESCING_ENABLED
+/*
+* Issues the update count for the next counter data object to be flushed, with up to 255 pending increments.
+* Returns TRUE, if the update count is issued.
+*/
+_STATIC_H bool_t optiga_util_count_flush_next(optiga_util_t * me, optiga_lib_status_t * p_status)
+{
+    optiga_set_data_object_params_t * p_params = &me->params.optiga_set_data_object_params;
+    bool_t is_issued = FALSE;
+
+    *p_status = OPTIGA_LIB_SUCCESS;
+    while (me->count_flush_index < me->count_flush_end)
+    {
+        // The increments reserved by another instance are written by that instance
+        me->count_flush_value = optiga_cmd_pending_count_reserve(me->my_cmd, me->count_flush_index);
+        if (0U == me->count_flush_value)
+        {
+            me->count_flush_index++;
+            continue;
+        }
+        pal_os_memset(&me->params, 0x00, sizeof(optiga_util_params_t));
+        p_params->oid = OPTIGA_UTIL_COUNTER_OID_FIRST + me->count_flush_index;
+        p_params->count = me->count_flush_value;
+        p_params->buffer = NULL;
+        p_params->data_or_metadata = 0;
+        p_params->size = 1;
+        p_params->write_type = OPTIGA_UTIL_COUNT_DATA_OBJECT;
+        OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
+        OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
+
+        *p_status = optiga_cmd_set_data_object(me->my_cmd, OPTIGA_UTIL_COUNT_DATA_OBJECT, p_params);
+        if (OPTIGA_LIB_SUCCESS == *p_status)
+        {
+            is_issued = TRUE;
+        }
+        else
+        {
+            optiga_cmd_pending_count_release(me->my_cmd, me->count_flush_index, me->count_flush_value, FALSE);
+        }
+        break;
+    }
+    return (is_issued);
+}
+
+/*
+* Takes the result of the update count and flushes the next pending increments.
+* Returns TRUE, if the flush is continued.
+*/
+_STATIC_H bool_t optiga_util_count_flush_resume(optiga_util_t * me,
+                                                optiga_lib_status_t * p_event)
+{
+    bool_t is_resumed = FALSE;
+
+    do
+    {
+        if (0U == me->count_flush_end)
+        {
+            break;
+        }
+        // On a failure the increments remain pending
+        optiga_cmd_pending_count_release(me->my_cmd,
+                                         me->count_flush_index,
+                                         me->count_flush_value,
+                                         (OPTIGA_LIB_SUCCESS == *p_event) ? TRUE : FALSE);
+        if (OPTIGA_LIB_SUCCESS == *p_event)
+        {
+            if (TRUE == optiga_util_count_flush_next(me, p_event))
+            {
+                is_resumed = TRUE;
+                break;
+            }
+        }
+        me->count_flush_end = 0;
+        optiga_util_reset_protection_level(me);
+    } while (FALSE);
+    return (is_resumed);
+}
 
+#endif //OPTIGA_UTIL_COUNT_COALESCING_ENABLED
 
 _STATIC_H void optiga_util_generic_event_handler(void * me,
                                                  optiga_lib_status_t event)
 {
     optiga_util_t * p_optiga_util = (optiga_util_t *)me;
+    bool_t report_event = TRUE;
+
+#ifdef OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+    // The capabilities are probed before the read cache is preloaded
+    if (TRUE == optiga_util_capability_probe_resume(p_optiga_util, &event))
+    {
+        report_event = FALSE;
+    }
+#endif //OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+#ifdef OPTIGA_UTIL_READ_CACHE_ENABLED
+    if ((TRUE == report_event) &&
+        (OPTIGA_UTIL_READ_CACHE_PRELOAD_OPEN == p_optiga_util->read_cache_preload_state))
+    {
+        // Open application is completed, the registered data objects are preloaded before it is reported
+        p_optiga_util->read_cache_open_status = event;
+        p_optiga_util->read_cache_preload_index = 0;
+        p_optiga_util->read_cache_preload_state = OPTIGA_UTIL_READ_CACHE_PRELOAD_ONGOING;
+    }
+    if ((TRUE == report_event) &&
+        (OPTIGA_UTIL_READ_CACHE_PRELOAD_ONGOING == p_optiga_util->read_cache_preload_state))
+    {
+        // A failed preload leaves the data object to be read on demand
+        if ((OPTIGA_LIB_SUCCESS == p_optiga_util->read_cache_open_status) &&
+            (TRUE == optiga_util_read_cache_preload_next(p_optiga_util)))
+        {
+            report_event = FALSE;
+        }
+        else
+        {
+            p_optiga_util->read_cache_preload_state = OPTIGA_UTIL_READ_CACHE_PRELOAD_NONE;
+            event = p_optiga_util->read_cache_open_status;
+        }
+    }
+#endif //OPTIGA_UTIL_READ_CACHE_ENABLED
+#ifdef OPTIGA_UTIL_METADATA_CACHE_ENABLED
+    if (TRUE == p_optiga_util->metadata_cache_load_ongoing)
+    {
+        // The remaining objects are loaded and the first failure is reported
+        if ((OPTIGA_LIB_SUCCESS != event) && (OPTIGA_LIB_SUCCESS == p_optiga_util->metadata_cache_load_status))
+        {
+            p_optiga_util->metadata_cache_load_status = event;
+        }
+        if (TRUE == optiga_util_metadata_cache_load_next(p_optiga_util))
+        {
+            report_event = FALSE;
+        }
+        else
+        {
+            p_optiga_util->metadata_cache_load_ongoing = FALSE;
+            event = p_optiga_util->metadata_cache_load_status;
+        }
+    }
+#endif //OPTIGA_UTIL_METADATA_CACHE_ENABLED
+#ifdef OPTIGA_UTIL_READ_DATA_MULTIPLE_ENABLED
+    // The operation of the caller is completed, once all the chunks of the reads are completed
+    if ((TRUE == report_event) && (TRUE == optiga_util_read_multiple_resume(p_optiga_util, &event)))
+    {
+        report_event = FALSE;
+    }
+#endif //OPTIGA_UTIL_READ_DATA_MULTIPLE_ENABLED
+#ifdef OPTIGA_UTIL_DIFFERENTIAL_WRITE_ENABLED
+    // The operation of the caller is completed, once all the changed ranges are written
+    if ((TRUE == report_event) && (TRUE == optiga_util_diff_write_resume(p_optiga_util, &event)))
+    {
+        report_event = FALSE;
+    }
+#endif //OPTIGA_UTIL_DIFFERENTIAL_WRITE_ENABLED
+#ifdef OPTIGA_UTIL_COUNT_COALESCING_ENABLED
+    // The flush is completed, once the pending increments of all the requested counter data objects are written
+    if ((TRUE == report_event) && (TRUE == optiga_util_count_flush_resume(p_optiga_util, &event)))
+    {
+        report_event = FALSE;
+    }
+#endif //OPTIGA_UTIL_COUNT_COALESCING_ENABLED
+    if (TRUE == report_event)
+    {
+        p_optiga_util->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+#ifdef OPTIGA_LIB_SYNC_API_ENABLED
+        if (TRUE == p_optiga_util->sync_ongoing)
+        {
+            // Wake up the caller of synchronous API instead of invoking the callback handler
+            p_optiga_util->sync_status = event;
+            pal_os_wait_signal(&p_optiga_util->sync_wait);
+        }
+        else
+#endif //OPTIGA_LIB_SYNC_API_ENABLED
+        {
+            p_optiga_util->handler(p_optiga_util->caller_context, event);
+        }
+    }
+}
+
+#ifdef OPTIGA_LIB_SYNC_API_ENABLED
+/*
+* Marks the instance for synchronous completion of the next operation
+*/
+_STATIC_H optiga_lib_status_t optiga_util_sync_begin(optiga_util_t * me)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        // Completion of an ongoing asynchronous operation must not be taken as synchronous completion
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        me->sync_ongoing = TRUE;
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
 
-    p_optiga_util->instance_state = OPTIGA_LIB_INSTANCE_FREE;
-    p_optiga_util->handler(p_optiga_util->caller_context, event);
+/*
+* Blocks until the operation started with the return_value is completed
+*/
+_STATIC_H optiga_lib_status_t optiga_util_sync_end(optiga_util_t * me, optiga_lib_status_t return_value)
+{
+    if (OPTIGA_LIB_SUCCESS == return_value)
+    {
+        pal_os_wait_for_signal(&me->sync_wait);
+        return_value = me->sync_status;
+    }
+    me->sync_ongoing = FALSE;
+    return (return_value);
 }
+#endif //OPTIGA_LIB_SYNC_API_ENABLED
 
 _STATIC_H void optiga_util_reset_protection_level(optiga_util_t * me)
 {
@@ -102,20 +818,1405 @@ _STATIC_H void optiga_util_reset_protection_level(optiga_util_t * me)
     }
 }
 
-_STATIC_H optiga_lib_status_t optiga_util_write_data_wrapper(optiga_util_t * me,
-                                                             uint16_t optiga_oid,
-                                                             uint8_t write_type,
-                                                             uint16_t offset,
-                                                             const uint8_t * p_buffer,
-                                                             uint16_t length)
+_STATIC_H optiga_lib_status_t optiga_util_write_data_wrapper(optiga_util_t * me,
+                                                             uint16_t optiga_oid,
+                                                             uint8_t write_type,
+                                                             uint16_t offset,
+                                                             const uint8_t * p_buffer,
+                                                             uint16_t length)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR;
+    optiga_set_data_object_params_t * p_params;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == p_buffer))
+        {
+            return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+
+        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+        p_params = (optiga_set_data_object_params_t *)&(me->params.optiga_set_data_object_params);
+        pal_os_memset(&me->params,0x00,sizeof(optiga_util_params_t));
+
+        if (OPTIGA_UTIL_COUNT_DATA_OBJECT == write_type)
+        {
+            p_params->count = p_buffer[0];
+            p_params->buffer = NULL;
+        }
+        else
+        {
+            p_params->count = 0;
+            p_params->buffer = p_buffer;
+        }
+        p_params->oid = optiga_oid;
+        p_params->offset = offset;
+        p_params->data_or_metadata = 0;//for Data
+        p_params->size = length;
+        p_params->written_size = 0;
+        p_params->write_type = write_type;
+        p_params->acknowledged_size = 0;
+        p_params->progress_callback = me->progress_callback;
+        p_params->progress_context = me->progress_context;
+
+        OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
+        OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
+
+        return_value = optiga_cmd_set_data_object(me->my_cmd, write_type, (optiga_set_data_object_params_t *)p_params);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+        }
+    } while (FALSE);
+    optiga_util_reset_protection_level(me);
+
+    return (return_value);
+}
+
+#ifdef OPTIGA_UTIL_DIFFERENTIAL_WRITE_ENABLED
+/*
+* Starts the differential write with the comparison against the read cache, or against the current data read from OPTIGA
+*/
+_STATIC_H optiga_lib_status_t optiga_util_diff_write_start(optiga_util_t * me,
+                                                           uint16_t optiga_oid,
+                                                           uint16_t offset,
+                                                           const uint8_t * p_buffer,
+                                                           uint16_t length)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+    optiga_get_data_object_params_t * p_params;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == p_buffer))
+        {
+            break;
+        }
+#endif
+        if (0U == length)
+        {
+            break;
+        }
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+
+        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+        me->p_diff_write_buffer = p_buffer;
+        me->diff_write_oid = optiga_oid;
+        me->diff_write_offset = offset;
+        me->diff_write_length = length;
+        me->diff_write_range_count = 0;
+        me->diff_write_range_index = 0;
+        me->diff_write_state = OPTIGA_UTIL_DIFF_WRITE_RANGES;
+#ifdef OPTIGA_UTIL_READ_CACHE_ENABLED
+        if (TRUE == optiga_util_diff_write_compare_cached(me))
+        {
+            if (0U == me->diff_write_range_count)
+            {
+                // The data object holds the data already, no command is sent and the completion is reported
+                // through the scheduler, hence the callback is not invoked before optiga_util_write_data returns
+                me->diff_write_state = OPTIGA_UTIL_DIFF_WRITE_NONE;
+                optiga_util_reset_protection_level(me);
+                return_value = optiga_cmd_complete_on_host(me->my_cmd, OPTIGA_LIB_SUCCESS);
+            }
+            else
+            {
+                return_value = optiga_util_diff_write_range(me);
+            }
+        }
+        else
+#endif //OPTIGA_UTIL_READ_CACHE_ENABLED
+        {
+            // The current data is compared chunk wise as it is received, without a buffer for it
+            p_params = &me->params.optiga_get_data_object_params;
+            pal_os_memset(&me->params, 0x00, sizeof(optiga_util_params_t));
+            me->diff_write_read_length = length;
+            p_params->oid = optiga_oid;
+            p_params->offset = offset;
+            p_params->data_or_metadata = 0;
+            p_params->bytes_to_read = length;
+            p_params->ref_bytes_to_read = &me->diff_write_read_length;
+            p_params->stream_callback = optiga_util_diff_write_stream_callback;
+            p_params->stream_context = me;
+            OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
+            OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
+            me->diff_write_state = OPTIGA_UTIL_DIFF_WRITE_COMPARE;
+            return_value = optiga_cmd_get_data_object(me->my_cmd, p_params->data_or_metadata, p_params);
+        }
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            me->diff_write_state = OPTIGA_UTIL_DIFF_WRITE_NONE;
+            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+        }
+    } while (FALSE);
+    // The protection level is kept for the read and the writes of the changed ranges
+    if (OPTIGA_LIB_SUCCESS != return_value)
+    {
+        optiga_util_reset_protection_level(me);
+    }
+
+    return (return_value);
+}
+#endif //OPTIGA_UTIL_DIFFERENTIAL_WRITE_ENABLED
+
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+void optiga_util_set_comms_params(optiga_util_t * me,
+                                  uint8_t parameter_type,
+                                  uint8_t value)
+{
+    switch (parameter_type)
+    {
+        case OPTIGA_COMMS_PROTECTION_LEVEL:
+        {
+            me->protection_level = value;
+            break;
+        }
+        case OPTIGA_COMMS_PROTOCOL_VERSION:
+        {
+            me->protocol_version = value;
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+}
+#endif
+
+optiga_util_t * optiga_util_create(uint8_t optiga_instance_id,
+                                   callback_handler_t handler,
+                                   void * caller_context)
+{
+    optiga_util_t * me = NULL;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == handler)
+        {
+            break;
+        }
+#endif
+        me = (optiga_util_t *)pal_os_calloc(1, sizeof(optiga_util_t));
+        if (NULL == me)
+        {
+            break;
+        }
+
+        me->handler = handler;
+        me->caller_context = caller_context;
+        me->instance_state = OPTIGA_LIB_SUCCESS;
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+        me->protocol_version = OPTIGA_COMMS_PROTOCOL_VERSION_PRE_SHARED_SECRET;
+        me->protection_level = OPTIGA_COMMS_DEFAULT_PROTECTION_LEVEL;
+#endif
+        me->my_cmd = optiga_cmd_create(optiga_instance_id, optiga_util_generic_event_handler, me);
+        if (NULL == me->my_cmd)
+        {
+            pal_os_free(me);
+            me = NULL;
+            break;
+        }
+#ifdef OPTIGA_LIB_SYNC_API_ENABLED
+        if (PAL_STATUS_SUCCESS != pal_os_wait_create(&me->sync_wait))
+        {
+            (void)optiga_cmd_destroy(me->my_cmd);
+            pal_os_free(me);
+            me = NULL;
+        }
+#endif //OPTIGA_LIB_SYNC_API_ENABLED
+    } while (FALSE);
+
+    return (me);
+}
+
+optiga_lib_status_t optiga_util_destroy(optiga_util_t * me)
+{
+    optiga_lib_status_t return_value;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        return_value = optiga_cmd_destroy(me->my_cmd);
+#ifdef OPTIGA_LIB_SYNC_API_ENABLED
+        pal_os_wait_destroy(&me->sync_wait);
+#endif //OPTIGA_LIB_SYNC_API_ENABLED
+        pal_os_free(me);
+    } while (FALSE);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_set_priority(optiga_util_t * me,
+                                             optiga_lib_priority_t priority)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_set_priority(me->my_cmd, (uint8_t)priority))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+
+#ifdef OPTIGA_CMD_DEADLINE_ENABLED
+optiga_lib_status_t optiga_util_set_deadline(optiga_util_t * me,
+                                             uint32_t deadline_us)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            break;
+        }
+#endif
+        return_value = optiga_cmd_set_deadline(me->my_cmd, deadline_us);
+    } while (FALSE);
+    return (return_value);
+}
+#endif //OPTIGA_CMD_DEADLINE_ENABLED
+
+#ifdef OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+optiga_lib_status_t optiga_util_set_deferrable(optiga_util_t * me,
+                                               uint32_t max_delay_ms)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_set_deferrable(me->my_cmd, max_delay_ms))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+#endif //OPTIGA_CMD_DEFERRED_EXECUTION_ENABLED
+
+#ifdef OPTIGA_CMD_CANCEL_ENABLED
+optiga_lib_status_t optiga_util_cancel(optiga_util_t * me)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            break;
+        }
+#endif
+        return_value = OPTIGA_LIB_SUCCESS;
+        // Nothing to be cancelled, if no operation is ongoing
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = optiga_cmd_cancel(me->my_cmd);
+        }
+    } while (FALSE);
+    return (return_value);
+}
+#endif //OPTIGA_CMD_CANCEL_ENABLED
+
+#ifdef OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+optiga_lib_status_t optiga_util_set_strict_lock_timeout(optiga_util_t * me,
+                                                        uint32_t max_hold_time_ms)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_set_strict_lock_timeout(me->my_cmd, max_hold_time_ms))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+#endif //OPTIGA_CMD_STRICT_LOCK_TIMEOUT_ENABLED
+
+#ifdef OPTIGA_CMD_FAIR_SHARE_ENABLED
+optiga_lib_status_t optiga_util_set_tenant(optiga_util_t * me,
+                                           uint8_t tenant)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_set_tenant(me->my_cmd, tenant))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_set_tenant_weight(optiga_util_t * me,
+                                                  uint8_t tenant,
+                                                  uint8_t weight)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_set_tenant_weight(me->my_cmd, tenant, weight))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_get_tenant_stats(optiga_util_t * me,
+                                                 uint8_t tenant,
+                                                 optiga_lib_tenant_stats_t * p_stats)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == p_stats))
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_get_tenant_stats(me->my_cmd, tenant, p_stats))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+#endif //OPTIGA_CMD_FAIR_SHARE_ENABLED
+
+#ifdef OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+optiga_lib_status_t optiga_util_try_admit(const optiga_util_t * me,
+                                          uint32_t max_wait_us,
+                                          uint32_t * p_estimated_wait_us)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_try_admit(me->my_cmd, max_wait_us, p_estimated_wait_us))
+        {
+            return_value = OPTIGA_UTIL_ERROR_QUEUE_FULL;
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_set_queue_watermark(const optiga_util_t * me,
+                                                    uint8_t high_watermark,
+                                                    uint8_t low_watermark,
+                                                    optiga_lib_queue_watermark_callback_t callback,
+                                                    void * context)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_set_queue_watermark(me->my_cmd,
+                                                                 high_watermark,
+                                                                 low_watermark,
+                                                                 callback,
+                                                                 context))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_get_queue_load(const optiga_util_t * me,
+                                               optiga_lib_queue_load_t * p_load)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == p_load))
+        {
+            break;
+        }
+#endif
+        optiga_cmd_get_queue_load(me->my_cmd, p_load);
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+#endif //OPTIGA_CMD_ADMISSION_CONTROL_ENABLED
+
+optiga_lib_status_t optiga_util_get_queue_wait_stats(optiga_util_t * me,
+                                                     optiga_lib_priority_t priority,
+                                                     optiga_lib_queue_wait_stats_t * p_stats)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == p_stats))
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_get_queue_wait_stats(me->my_cmd, (uint8_t)priority, p_stats))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+
+#ifdef OPTIGA_COMMS_DL_RESEND_BACKOFF_ENABLED
+optiga_lib_status_t optiga_util_get_comms_recovery_stats(optiga_util_t * me,
+                                                         optiga_lib_comms_recovery_stats_t * p_stats)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == p_stats))
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_get_comms_recovery_stats(me->my_cmd, p_stats))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+#endif
+
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+optiga_lib_status_t optiga_util_get_statistics(optiga_util_t * me,
+                                               optiga_lib_statistics_t * p_stats)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == p_stats))
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_get_statistics(me->my_cmd, p_stats))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+#endif
+
+#ifdef OPTIGA_LIB_FAST_RESUME_ENABLED
+optiga_lib_status_t optiga_util_get_resume_stats(optiga_util_t * me,
+                                                 optiga_lib_resume_stats_t * p_stats)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == p_stats))
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_get_resume_stats(me->my_cmd, p_stats))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+#endif
+
+#ifdef OPTIGA_CMD_HEALTH_MONITOR_ENABLED
+optiga_lib_status_t optiga_util_get_health_stats(optiga_util_t * me,
+                                                 optiga_lib_health_stats_t * p_stats)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == p_stats))
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_get_health_stats(me->my_cmd, p_stats))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+#endif
+
+#ifdef OPTIGA_CMD_AUTO_HIBERNATE_ENABLED
+optiga_lib_status_t optiga_util_set_auto_hibernate(optiga_util_t * me,
+                                                   uint32_t idle_time_ms)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+    optiga_lib_status_t cmd_status;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            break;
+        }
+#endif
+        cmd_status = optiga_cmd_set_auto_hibernate(me->my_cmd, idle_time_ms);
+        if (OPTIGA_CMD_ERROR_INVALID_INPUT == cmd_status)
+        {
+            break;
+        }
+        return_value = (OPTIGA_LIB_SUCCESS == cmd_status) ? OPTIGA_LIB_SUCCESS : OPTIGA_UTIL_ERROR;
+    } while (FALSE);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_get_auto_hibernate_stats(optiga_util_t * me,
+                                                         optiga_lib_auto_hibernate_stats_t * p_stats)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == p_stats))
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_get_auto_hibernate_stats(me->my_cmd, p_stats))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+
+#ifdef OPTIGA_CMD_LAZY_OPEN_ENABLED
+optiga_lib_status_t optiga_util_set_lazy_open(optiga_util_t * me,
+                                              bool_t enable,
+                                              bool_t pre_open)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            break;
+        }
+#endif
+        return_value = (OPTIGA_LIB_SUCCESS == optiga_cmd_set_lazy_open(me->my_cmd, enable, pre_open)) ?
+                       OPTIGA_LIB_SUCCESS : OPTIGA_UTIL_ERROR;
+    } while (FALSE);
+    return (return_value);
+}
+#endif //OPTIGA_CMD_LAZY_OPEN_ENABLED
+
+#ifdef OPTIGA_CMD_PERFORMANCE_GOVERNOR_ENABLED
+optiga_lib_status_t optiga_util_set_performance_policy(optiga_util_t * me,
+                                                       const optiga_lib_performance_policy_t * p_policy)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+    optiga_lib_status_t cmd_status;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            break;
+        }
+#endif
+        cmd_status = optiga_cmd_set_performance_policy(me->my_cmd, p_policy);
+        if (OPTIGA_CMD_ERROR_INVALID_INPUT == cmd_status)
+        {
+            break;
+        }
+        return_value = (OPTIGA_LIB_SUCCESS == cmd_status) ? OPTIGA_LIB_SUCCESS : OPTIGA_UTIL_ERROR;
+    } while (FALSE);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_set_power_budget(optiga_util_t * me,
+                                                 uint8_t max_current_limit)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_set_power_budget(me->my_cmd, max_current_limit))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_get_performance_stats(optiga_util_t * me,
+                                                      optiga_lib_performance_stats_t * p_stats)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == p_stats))
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_get_performance_stats(me->my_cmd, p_stats))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+#endif //OPTIGA_CMD_PERFORMANCE_GOVERNOR_ENABLED
+
+#ifdef OPTIGA_CMD_SEC_PACING_ENABLED
+optiga_lib_status_t optiga_util_set_sec_policy(optiga_util_t * me,
+                                               const optiga_lib_sec_policy_t * p_policy)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+    optiga_lib_status_t cmd_status;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            break;
+        }
+#endif
+        cmd_status = optiga_cmd_set_sec_policy(me->my_cmd, p_policy);
+        if (OPTIGA_CMD_ERROR_INVALID_INPUT == cmd_status)
+        {
+            break;
+        }
+        return_value = (OPTIGA_LIB_SUCCESS == cmd_status) ? OPTIGA_LIB_SUCCESS : OPTIGA_UTIL_ERROR;
+    } while (FALSE);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_get_sec_stats(optiga_util_t * me,
+                                              optiga_lib_sec_stats_t * p_stats)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == p_stats))
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_get_sec_stats(me->my_cmd, p_stats))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+#endif //OPTIGA_CMD_SEC_PACING_ENABLED
+#endif
+
+#ifdef OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+optiga_lib_status_t optiga_util_get_capabilities(const optiga_util_t * me,
+                                                 uint32_t * p_capabilities)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == p_capabilities))
+        {
+            break;
+        }
+#endif
+        *p_capabilities = optiga_cmd_get_capabilities(me->my_cmd);
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+#endif //OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+
+#ifdef OPTIGA_UTIL_READ_CACHE_ENABLED
+optiga_lib_status_t optiga_util_read_cache_register(optiga_util_t * me,
+                                                    uint16_t optiga_oid,
+                                                    bool_t preload)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+    optiga_lib_status_t cmd_status;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            break;
+        }
+#endif
+        cmd_status = optiga_cmd_read_cache_register(me->my_cmd, optiga_oid, preload);
+        if (OPTIGA_CMD_ERROR_INVALID_INPUT == cmd_status)
+        {
+            break;
+        }
+        return_value = (OPTIGA_LIB_SUCCESS == cmd_status) ? OPTIGA_LIB_SUCCESS : OPTIGA_UTIL_ERROR_MEMORY_INSUFFICIENT;
+    } while (FALSE);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_read_cache_unregister(optiga_util_t * me,
+                                                      uint16_t optiga_oid)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            break;
+        }
+#endif
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_read_cache_unregister(me->my_cmd, optiga_oid))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+#endif
+
+#ifdef OPTIGA_UTIL_METADATA_CACHE_ENABLED
+optiga_lib_status_t optiga_util_metadata_cache_load(optiga_util_t * me,
+                                                    const uint16_t * p_optiga_oids,
+                                                    uint8_t count)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR;
+    OPTIGA_UTIL_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == p_optiga_oids))
+        {
+            return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+        if (0 == count)
+        {
+            return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+            break;
+        }
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+
+        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+        me->p_metadata_cache_oids = p_optiga_oids;
+        me->metadata_cache_count = count;
+        me->metadata_cache_index = 0;
+        me->metadata_cache_load_status = OPTIGA_LIB_SUCCESS;
+        me->metadata_cache_load_ongoing = TRUE;
+        if (FALSE == optiga_util_metadata_cache_load_next(me))
+        {
+            // Metadata of all the objects is cached already, the completion is reported right away
+            me->metadata_cache_load_ongoing = FALSE;
+            optiga_util_generic_event_handler(me, OPTIGA_LIB_SUCCESS);
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    optiga_util_reset_protection_level(me);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_metadata_cache_get(optiga_util_t * me,
+                                                   uint16_t optiga_oid,
+                                                   optiga_lib_metadata_info_t * p_info)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == p_info))
+        {
+            break;
+        }
+#endif
+        return_value = OPTIGA_UTIL_ERROR;
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_metadata_cache_get(me->my_cmd, optiga_oid, p_info))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+#endif
+
+optiga_lib_status_t optiga_util_open_application(optiga_util_t * me,
+                                                 bool_t perform_restore)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR;
+
+    OPTIGA_UTIL_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+
+        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+        OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
+        OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+        if (FALSE == perform_restore)
+        {
+            OPTIGA_PROTECTION_MANAGE_CONTEXT(me->my_cmd, OPTIGA_COMMS_SESSION_CONTEXT_NONE);
+        }
+        else
+        {
+             OPTIGA_PROTECTION_MANAGE_CONTEXT(me->my_cmd, OPTIGA_COMMS_SESSION_CONTEXT_RESTORE);
+        }
+#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+
+#ifdef OPTIGA_UTIL_READ_CACHE_ENABLED
+        me->read_cache_preload_state = OPTIGA_UTIL_READ_CACHE_PRELOAD_OPEN;
+#endif //OPTIGA_UTIL_READ_CACHE_ENABLED
+#ifdef OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+        me->capability_probe_state = OPTIGA_UTIL_CAPABILITY_PROBE_OPEN;
+#endif //OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+        return_value = optiga_cmd_open_application(me->my_cmd, perform_restore, NULL);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+#ifdef OPTIGA_UTIL_READ_CACHE_ENABLED
+            me->read_cache_preload_state = OPTIGA_UTIL_READ_CACHE_PRELOAD_NONE;
+#endif //OPTIGA_UTIL_READ_CACHE_ENABLED
+#ifdef OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+            me->capability_probe_state = OPTIGA_UTIL_CAPABILITY_PROBE_NONE;
+#endif //OPTIGA_LIB_CAPABILITY_PROBE_ENABLED
+            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+        }
+
+    } while (FALSE);
+    optiga_util_reset_protection_level(me);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_close_application(optiga_util_t * me,
+                                                  bool_t perform_hibernate)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR;
+    OPTIGA_UTIL_LOG_MESSAGE(__FUNCTION__);
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+
+        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+        OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
+        OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
+
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+        if (FALSE == perform_hibernate)
+        {
+            OPTIGA_PROTECTION_MANAGE_CONTEXT(me->my_cmd, OPTIGA_COMMS_SESSION_CONTEXT_NONE);
+        }
+        else
+        {
+            OPTIGA_PROTECTION_MANAGE_CONTEXT(me->my_cmd, OPTIGA_COMMS_SESSION_CONTEXT_SAVE);
+        }
+#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+
+        return_value = optiga_cmd_close_application(me->my_cmd, perform_hibernate, NULL);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+        }
+
+    } while (FALSE);
+    optiga_util_reset_protection_level(me);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_read_data(optiga_util_t * me,
+                                          uint16_t optiga_oid,
+                                          uint16_t offset,
+                                          uint8_t * buffer,
+                                          uint16_t * length)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR;
+    optiga_get_data_object_params_t * p_params;
+    OPTIGA_UTIL_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) ||
+            (NULL == buffer) || (NULL == length))
+        {
+            return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+
+        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+#ifdef OPTIGA_UTIL_READ_CACHE_ENABLED
+        // Cached data is served without any command to OPTIGA, the completion is reported right away
+        if (OPTIGA_LIB_SUCCESS == optiga_cmd_read_cache_get(me->my_cmd, optiga_oid, offset, buffer, length))
+        {
+            optiga_util_generic_event_handler(me, OPTIGA_LIB_SUCCESS);
+            return_value = OPTIGA_LIB_SUCCESS;
+            break;
+        }
+#endif //OPTIGA_UTIL_READ_CACHE_ENABLED
+        p_params = (optiga_get_data_object_params_t *)&(me->params.optiga_get_data_object_params);
+        pal_os_memset(&me->params,0x00,sizeof(optiga_util_params_t));
+
+        p_params->oid = optiga_oid;
+        p_params->offset = offset;
+        // set option to read data
+        p_params->data_or_metadata = 0;
+        p_params->buffer = buffer;
+        p_params->bytes_to_read = *length;
+        p_params->ref_bytes_to_read = length;
+        p_params->accumulated_size = 0;
+        p_params->last_read_size = 0;
+
+        OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
+        OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
+
+        return_value = optiga_cmd_get_data_object(me->my_cmd, p_params->data_or_metadata, p_params);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+        }
+
+    } while (FALSE);
+    optiga_util_reset_protection_level(me);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_read_data_stream(optiga_util_t * me,
+                                                 uint16_t optiga_oid,
+                                                 uint16_t offset,
+                                                 optiga_lib_stream_callback_t stream_callback,
+                                                 void * stream_context,
+                                                 uint16_t * length)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR;
+    optiga_get_data_object_params_t * p_params;
+    OPTIGA_UTIL_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) ||
+            (NULL == stream_callback) || (NULL == length))
+        {
+            return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+
+        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+        p_params = (optiga_get_data_object_params_t *)&(me->params.optiga_get_data_object_params);
+        pal_os_memset(&me->params,0x00,sizeof(optiga_util_params_t));
+
+        p_params->oid = optiga_oid;
+        p_params->offset = offset;
+        // set option to read data
+        p_params->data_or_metadata = 0;
+        p_params->buffer = NULL;
+        p_params->stream_callback = stream_callback;
+        p_params->stream_context = stream_context;
+        p_params->bytes_to_read = *length;
+        p_params->ref_bytes_to_read = length;
+        p_params->accumulated_size = 0;
+        p_params->last_read_size = 0;
+
+        OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
+        OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
+
+        return_value = optiga_cmd_get_data_object(me->my_cmd, p_params->data_or_metadata, p_params);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+        }
+
+    } while (FALSE);
+    optiga_util_reset_protection_level(me);
+
+    return (return_value);
+}
+
+#ifdef OPTIGA_UTIL_READ_DATA_MULTIPLE_ENABLED
+optiga_lib_status_t optiga_util_read_data_multiple(optiga_util_t * me,
+                                                   optiga_util_read_item_t * items,
+                                                   uint16_t item_count)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+    uint16_t index;
+    OPTIGA_UTIL_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == items))
+        {
+            break;
+        }
+#endif
+        if (0U == item_count)
+        {
+            break;
+        }
+        for (index = 0; index < item_count; index++)
+        {
+            if ((NULL == items[index].buffer) || (OPTIGA_UTIL_READ_ITEM_METADATA < items[index].read_type))
+            {
+                break;
+            }
+        }
+        if (index < item_count)
+        {
+            break;
+        }
+
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+
+        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+        for (index = 0; index < item_count; index++)
+        {
+            items[index].status = OPTIGA_LIB_BUSY;
+#ifdef OPTIGA_UTIL_READ_CACHE_ENABLED
+            // Cached data is served without any command to OPTIGA
+            if ((OPTIGA_UTIL_READ_ITEM_DATA == items[index].read_type) &&
+                (OPTIGA_LIB_SUCCESS == optiga_cmd_read_cache_get(me->my_cmd,
+                                                                 items[index].oid,
+                                                                 items[index].offset,
+                                                                 items[index].buffer,
+                                                                 &items[index].length)))
+            {
+                items[index].status = OPTIGA_LIB_SUCCESS;
+            }
+#endif //OPTIGA_UTIL_READ_CACHE_ENABLED
+        }
+        me->p_read_multiple_items = items;
+        me->read_multiple_count = item_count;
+        me->read_multiple_index = 0;
+
+        // The protection level is kept for the reads of all the chunks
+        return_value = optiga_util_read_multiple_next_chunk(me);
+        if (0U == me->read_multiple_chunk_count)
+        {
+            // All the items are served from the read cache, hence the callback is invoked right away
+            return_value = OPTIGA_LIB_SUCCESS;
+            optiga_util_generic_event_handler(me, optiga_util_read_multiple_end(me, OPTIGA_LIB_SUCCESS));
+            break;
+        }
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            me->read_multiple_count = 0;
+            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+        }
+    } while (FALSE);
+    if (OPTIGA_LIB_SUCCESS != return_value)
+    {
+        optiga_util_reset_protection_level(me);
+    }
+
+    return (return_value);
+}
+#endif //OPTIGA_UTIL_READ_DATA_MULTIPLE_ENABLED
+
+optiga_lib_status_t optiga_util_read_metadata(optiga_util_t * me,
+                                              uint16_t optiga_oid,
+                                              uint8_t * buffer,
+                                              uint16_t * length)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR;
+    optiga_get_data_object_params_t * p_params;
+    OPTIGA_UTIL_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd) ||
+            (NULL == buffer) || (NULL == length))
+        {
+            return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+
+        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+        p_params = (optiga_get_data_object_params_t *)&(me->params.optiga_get_data_object_params);
+        pal_os_memset(&me->params,0x00,sizeof(optiga_util_params_t));
+
+        p_params->oid = optiga_oid;
+        p_params->offset = 0;
+        // set option to read metadata
+        p_params->data_or_metadata = 1;//for metadata
+        p_params->buffer = buffer;
+        p_params->bytes_to_read = *length;
+        p_params->ref_bytes_to_read = length;
+        p_params->accumulated_size = 0;
+        p_params->last_read_size = 0;
+        OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
+        OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
+
+        return_value = optiga_cmd_get_data_object(me->my_cmd, p_params->data_or_metadata,
+                                                  (optiga_get_data_object_params_t *)p_params);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+        }
+    } while (FALSE);
+    optiga_util_reset_protection_level(me);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_write_data(optiga_util_t * me,
+                                           uint16_t optiga_oid,
+                                           uint8_t write_type,
+                                           uint16_t offset,
+                                           const uint8_t * buffer,
+                                           uint16_t length)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+    OPTIGA_UTIL_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_UTIL_DIFFERENTIAL_WRITE_ENABLED
+        if (OPTIGA_UTIL_WRITE_DIFFERENTIAL == write_type)
+        {
+            return_value = optiga_util_diff_write_start(me, optiga_oid, offset, buffer, length);
+            break;
+        }
+#endif //OPTIGA_UTIL_DIFFERENTIAL_WRITE_ENABLED
+        if ((OPTIGA_UTIL_WRITE_ONLY != write_type) && (OPTIGA_UTIL_ERASE_AND_WRITE != write_type))
+        {
+            break;
+        }
+        return_value =  optiga_util_write_data_wrapper(me,
+                                                       optiga_oid,
+                                                       write_type,
+                                                       offset,
+                                                       buffer,
+                                                       length);
+    } while (FALSE);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_set_progress_callback(optiga_util_t * me,
+                                                      optiga_lib_progress_callback_t progress_callback,
+                                                      void * progress_context)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR;
+    OPTIGA_UTIL_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+            break;
+        }
+#endif
+
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+
+        me->progress_callback = progress_callback;
+        me->progress_context = progress_context;
+        return_value = OPTIGA_UTIL_SUCCESS;
+    } while (FALSE);
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_write_metadata(optiga_util_t * me,
+                                               uint16_t optiga_oid,
+                                               const uint8_t * buffer,
+                                               uint8_t length)
 {
     optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR;
     optiga_set_data_object_params_t * p_params;
-
+    OPTIGA_UTIL_LOG_MESSAGE(__FUNCTION__);
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == p_buffer))
+        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == buffer))
         {
             return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
             break;
@@ -132,27 +2233,19 @@ _STATIC_H optiga_lib_status_t optiga_util_write_data_wrapper(optiga_util_t * me,
         p_params = (optiga_set_data_object_params_t *)&(me->params.optiga_set_data_object_params);
         pal_os_memset(&me->params,0x00,sizeof(optiga_util_params_t));
 
-        if (OPTIGA_UTIL_COUNT_DATA_OBJECT == write_type)
-        {
-            p_params->count = p_buffer[0];
-            p_params->buffer = NULL;
-        }
-        else
-        {
-            p_params->count = 0;
-            p_params->buffer = p_buffer;
-        }
         p_params->oid = optiga_oid;
-        p_params->offset = offset;
-        p_params->data_or_metadata = 0;//for Data
+        p_params->offset = 0;
+        //for Metadata
+        p_params->data_or_metadata = 1;
+        p_params->buffer = buffer;
         p_params->size = length;
+        p_params->write_type = 1;
         p_params->written_size = 0;
-        p_params->write_type = write_type;
-
         OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
         OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
 
-        return_value = optiga_cmd_set_data_object(me->my_cmd, write_type, (optiga_set_data_object_params_t *)p_params);
+        return_value = optiga_cmd_set_data_object(me->my_cmd, p_params->write_type,
+                                                  (optiga_set_data_object_params_t *)p_params);
         if (OPTIGA_LIB_SUCCESS != return_value)
         {
             me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
@@ -163,373 +2256,582 @@ _STATIC_H optiga_lib_status_t optiga_util_write_data_wrapper(optiga_util_t * me,
     return (return_value);
 }
 
-#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
-void optiga_util_set_comms_params(optiga_util_t * me,
-                                  uint8_t parameter_type,
-                                  uint8_t value)
-{
-    switch (parameter_type)
-    {
-        case OPTIGA_COMMS_PROTECTION_LEVEL:
-        {
-            me->protection_level = value;
-            break;
-        }
-        case OPTIGA_COMMS_PROTOCOL_VERSION:
-        {
-            me->protocol_version = value;
-            break;
-        }
-        default:
-        {
-            break;
-        }
-    }
-}
-#endif
-
-optiga_util_t * optiga_util_create(uint8_t optiga_instance_id,
-                                   callback_handler_t handler,
-                                   void * caller_context)
+#ifdef OPTIGA_UTIL_PROTECTED_UPDATE_CHECK_ENABLED
+/*
+* Reads the header of the next CBOR item. Indefinite length and 8 byte arguments are not used by the manifest
+*/
+_STATIC_H optiga_lib_status_t optiga_util_cbor_get_header(optiga_util_cbor_reader_t * p_reader,
+                                                          uint8_t * p_major_type,
+                                                          uint32_t * p_argument)
 {
-    optiga_util_t * me = NULL;
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_PROTECTED_UPDATE_INVALID;
+    uint8_t info;
+    uint8_t argument_length;
+    uint8_t index;
 
     do
     {
-#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if (NULL == handler)
+        if (p_reader->offset >= p_reader->length)
         {
             break;
         }
-#endif
-        me = (optiga_util_t *)pal_os_calloc(1, sizeof(optiga_util_t));
-        if (NULL == me)
+        *p_major_type = p_reader->p_data[p_reader->offset] >> 5;
+        info = p_reader->p_data[p_reader->offset] & 0x1F;
+        p_reader->offset++;
+        *p_argument = info;
+        if (OPTIGA_UTIL_CBOR_ARGUMENT_4_BYTES < info)
         {
             break;
         }
-
-        me->handler = handler;
-        me->caller_context = caller_context;
-        me->instance_state = OPTIGA_LIB_SUCCESS;
-#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
-        me->protocol_version = OPTIGA_COMMS_PROTOCOL_VERSION_PRE_SHARED_SECRET;
-        me->protection_level = OPTIGA_COMMS_DEFAULT_PROTECTION_LEVEL;
-#endif
-        me->my_cmd = optiga_cmd_create(optiga_instance_id, optiga_util_generic_event_handler, me);
-        if (NULL == me->my_cmd)
+        if (OPTIGA_UTIL_CBOR_ARGUMENT_1_BYTE <= info)
         {
-            pal_os_free(me);
-            me = NULL;
+            argument_length = (uint8_t)(1U << (info - OPTIGA_UTIL_CBOR_ARGUMENT_1_BYTE));
+            if ((p_reader->length - p_reader->offset) < argument_length)
+            {
+                break;
+            }
+            *p_argument = 0;
+            for (index = 0; index < argument_length; index++)
+            {
+                *p_argument = (*p_argument << 8) | p_reader->p_data[p_reader->offset++];
+            }
         }
+        return_value = OPTIGA_LIB_SUCCESS;
     } while (FALSE);
 
-    return (me);
+    return (return_value);
 }
 
-optiga_lib_status_t optiga_util_destroy(optiga_util_t * me)
+/*
+* Reads the next CBOR item, which must be of the major type with the argument
+*/
+_STATIC_H optiga_lib_status_t optiga_util_cbor_expect(optiga_util_cbor_reader_t * p_reader,
+                                                      uint8_t major_type,
+                                                      uint32_t argument)
 {
-    optiga_lib_status_t return_value;
+    uint8_t item_major_type;
+    uint32_t item_argument;
+
+    return (((OPTIGA_LIB_SUCCESS == optiga_util_cbor_get_header(p_reader, &item_major_type, &item_argument)) &&
+             (major_type == item_major_type) && (argument == item_argument)) ?
+             OPTIGA_LIB_SUCCESS : OPTIGA_UTIL_ERROR_PROTECTED_UPDATE_INVALID);
+}
+
+/*
+* Reads the next CBOR item, which must be a byte string
+*/
+_STATIC_H optiga_lib_status_t optiga_util_cbor_get_byte_string(optiga_util_cbor_reader_t * p_reader,
+                                                               const uint8_t ** pp_value,
+                                                               uint32_t * p_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_PROTECTED_UPDATE_INVALID;
+    uint8_t major_type;
 
     do
     {
-#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if (NULL == me)
-        {
-            return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
-            break;
-        }
-#endif
-        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        if ((OPTIGA_LIB_SUCCESS != optiga_util_cbor_get_header(p_reader, &major_type, p_length)) ||
+            (OPTIGA_UTIL_CBOR_BYTE_STRING != major_type) || ((p_reader->length - p_reader->offset) < *p_length))
         {
-            return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
             break;
         }
-        return_value = optiga_cmd_destroy(me->my_cmd);
-        pal_os_free(me);
+        *pp_value = &p_reader->p_data[p_reader->offset];
+        p_reader->offset += *p_length;
+        return_value = OPTIGA_LIB_SUCCESS;
     } while (FALSE);
+
     return (return_value);
 }
 
-optiga_lib_status_t optiga_util_open_application(optiga_util_t * me,
-                                                 bool_t perform_restore)
+/*
+* Skips the next CBOR item including the nested items
+*/
+_STATIC_H optiga_lib_status_t optiga_util_cbor_skip(optiga_util_cbor_reader_t * p_reader)
 {
-    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR;
+    optiga_lib_status_t return_value = OPTIGA_LIB_SUCCESS;
+    uint32_t pending_items = 1;
+    uint32_t argument;
+    uint8_t major_type;
 
-    OPTIGA_UTIL_LOG_MESSAGE(__FUNCTION__);
-    do
+    while ((0U != pending_items) && (OPTIGA_LIB_SUCCESS == return_value))
     {
-#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd))
+        pending_items--;
+        return_value = optiga_util_cbor_get_header(p_reader, &major_type, &argument);
+        if (OPTIGA_LIB_SUCCESS != return_value)
         {
-            return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
             break;
         }
-#endif
-
-        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        // Every byte or nested item takes at least one byte, hence larger lengths do not fit into the data anyway
+        if ((OPTIGA_UTIL_CBOR_BYTE_STRING <= major_type) && (OPTIGA_UTIL_CBOR_MAP >= major_type) &&
+            (argument > (p_reader->length - p_reader->offset)))
         {
-            return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
+            return_value = OPTIGA_UTIL_ERROR_PROTECTED_UPDATE_INVALID;
             break;
         }
-
-        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
-        OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
-        OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
-#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
-        if (FALSE == perform_restore)
-        {
-            OPTIGA_PROTECTION_MANAGE_CONTEXT(me->my_cmd, OPTIGA_COMMS_SESSION_CONTEXT_NONE);
-        }
-        else
+        switch (major_type)
         {
-             OPTIGA_PROTECTION_MANAGE_CONTEXT(me->my_cmd, OPTIGA_COMMS_SESSION_CONTEXT_RESTORE);
+            case OPTIGA_UTIL_CBOR_BYTE_STRING:
+            case OPTIGA_UTIL_CBOR_TEXT_STRING:
+            {
+                p_reader->offset += argument;
+                break;
+            }
+            case OPTIGA_UTIL_CBOR_ARRAY:
+            {
+                pending_items += argument;
+                break;
+            }
+            case OPTIGA_UTIL_CBOR_MAP:
+            {
+                pending_items += (argument * 2U);
+                break;
+            }
+            case OPTIGA_UTIL_CBOR_TAG:
+            {
+                pending_items++;
+                break;
+            }
+            default:
+            {
+                // Integers and simple values are complete with the argument
+                break;
+            }
         }
-#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
+    }
 
-        return_value = optiga_cmd_open_application(me->my_cmd, perform_restore, NULL);
-        if (OPTIGA_LIB_SUCCESS != return_value)
-        {
-            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
-        }
+    return (return_value);
+}
 
-    } while (FALSE);
-    optiga_util_reset_protection_level(me);
+/*
+* Encodes the header of a byte string of the given length, returns the length of the header
+*/
+_STATIC_H uint8_t optiga_util_cbor_set_byte_string_header(uint8_t * p_header, uint32_t length)
+{
+    uint8_t header_length = 1;
 
-    return (return_value);
+    if (length < OPTIGA_UTIL_CBOR_ARGUMENT_1_BYTE)
+    {
+        p_header[0] = (uint8_t)((OPTIGA_UTIL_CBOR_BYTE_STRING << 5) | length);
+    }
+    else if (length <= 0xFFU)
+    {
+        p_header[0] = (OPTIGA_UTIL_CBOR_BYTE_STRING << 5) | OPTIGA_UTIL_CBOR_ARGUMENT_1_BYTE;
+        p_header[header_length++] = (uint8_t)length;
+    }
+    else
+    {
+        p_header[0] = (OPTIGA_UTIL_CBOR_BYTE_STRING << 5) | (OPTIGA_UTIL_CBOR_ARGUMENT_1_BYTE + 1U);
+        optiga_common_set_uint16(&p_header[header_length], (uint16_t)length);
+        header_length += 2U;
+    }
+    return (header_length);
 }
 
-optiga_lib_status_t optiga_util_close_application(optiga_util_t * me,
-                                                  bool_t perform_hibernate)
+/*
+* Verifies the ES-256 signature of the manifest over the Sig_structure ["Signature1", protected, h'', payload].
+* As in the protected update data set tool, the context string is encoded as a byte string
+*/
+_STATIC_H optiga_lib_status_t optiga_util_protected_update_check_signature(const public_key_from_host_t * p_trust_anchor,
+                                                                           const uint8_t * p_protected,
+                                                                           uint32_t protected_length,
+                                                                           const uint8_t * p_payload,
+                                                                           uint32_t payload_length,
+                                                                           const uint8_t * p_signature,
+                                                                           uint32_t signature_length)
 {
-    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR;
-    OPTIGA_UTIL_LOG_MESSAGE(__FUNCTION__);
+    const uint8_t sig_structure_context[] = {0x84, 0x4A, 'S', 'i', 'g', 'n', 'a', 't', 'u', 'r', 'e', '1'};
+    const uint8_t external_aad[] = {0x40};
+    uint8_t hash_context[OPTIGA_HASH_CONTEXT_LENGTH_SHA_256];
+    uint8_t digest[OPTIGA_UTIL_PROTECTED_UPDATE_DIGEST_LENGTH];
+    uint8_t der_signature[OPTIGA_UTIL_MANIFEST_MAX_SIGNATURE_LENGTH + OPTIGA_ECDSA_SIGNATURE_DER_OVERHEAD];
+    uint16_t der_signature_length = sizeof(der_signature);
+    uint8_t header[3];
+    uint8_t header_length;
+    pal_status_t pal_return_value;
+
+    pal_return_value = pal_crypt_sha256_start(NULL, hash_context, sizeof(hash_context));
+    if (PAL_STATUS_SUCCESS == pal_return_value)
+    {
+        pal_return_value = pal_crypt_sha256_update(NULL, hash_context, sizeof(hash_context),
+                                                   sig_structure_context, sizeof(sig_structure_context));
+    }
+    header_length = optiga_util_cbor_set_byte_string_header(header, protected_length);
+    if (PAL_STATUS_SUCCESS == pal_return_value)
+    {
+        pal_return_value = pal_crypt_sha256_update(NULL, hash_context, sizeof(hash_context), header, header_length);
+    }
+    if (PAL_STATUS_SUCCESS == pal_return_value)
+    {
+        pal_return_value = pal_crypt_sha256_update(NULL, hash_context, sizeof(hash_context), p_protected, protected_length);
+    }
+    if (PAL_STATUS_SUCCESS == pal_return_value)
+    {
+        pal_return_value = pal_crypt_sha256_update(NULL, hash_context, sizeof(hash_context),
+                                                   external_aad, sizeof(external_aad));
+    }
+    header_length = optiga_util_cbor_set_byte_string_header(header, payload_length);
+    if (PAL_STATUS_SUCCESS == pal_return_value)
+    {
+        pal_return_value = pal_crypt_sha256_update(NULL, hash_context, sizeof(hash_context), header, header_length);
+    }
+    if (PAL_STATUS_SUCCESS == pal_return_value)
+    {
+        pal_return_value = pal_crypt_sha256_update(NULL, hash_context, sizeof(hash_context), p_payload, payload_length);
+    }
+    if (PAL_STATUS_SUCCESS == pal_return_value)
+    {
+        pal_return_value = pal_crypt_sha256_finalize(NULL, hash_context, sizeof(hash_context), digest);
+    }
+    // pal crypt expects the DER INTEGERs, the manifest holds r || s
+    if ((PAL_STATUS_SUCCESS == pal_return_value) &&
+        ((OPTIGA_UTIL_MANIFEST_MAX_SIGNATURE_LENGTH < signature_length) ||
+         (OPTIGA_LIB_SUCCESS != optiga_common_ecdsa_signature_to_der(p_signature,
+                                                                     (uint16_t)signature_length,
+                                                                     (uint8_t)OPTIGA_ECDSA_SIGNATURE_FORMAT_RAW,
+                                                                     der_signature,
+                                                                     &der_signature_length))))
+    {
+        pal_return_value = PAL_STATUS_FAILURE;
+    }
+    if (PAL_STATUS_SUCCESS == pal_return_value)
+    {
+        pal_return_value = pal_crypt_ecdsa_verify(NULL,
+                                                  p_trust_anchor->key_type,
+                                                  digest,
+                                                  sizeof(digest),
+                                                  der_signature,
+                                                  der_signature_length,
+                                                  p_trust_anchor->public_key,
+                                                  p_trust_anchor->length);
+    }
+    pal_os_memset(hash_context, 0x00, sizeof(hash_context));
+
+    return ((PAL_STATUS_SUCCESS == pal_return_value) ? OPTIGA_LIB_SUCCESS : OPTIGA_UTIL_ERROR_PROTECTED_UPDATE_INVALID);
+}
+
+/*
+* Parses the payload of the manifest [version, nil, nil, resource, processors, target]
+* and takes the length of the payload and the digest of the first fragment
+*/
+_STATIC_H optiga_lib_status_t optiga_util_protected_update_check_payload(optiga_util_protected_update_check_t * p_check,
+                                                                         const uint8_t * p_payload,
+                                                                         uint32_t payload_length)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_PROTECTED_UPDATE_INVALID;
+    optiga_util_cbor_reader_t reader = {p_payload, payload_length, 0};
+    optiga_util_cbor_reader_t digest_info_reader;
+    const uint8_t * p_value;
+    uint32_t length;
+    uint8_t major_type;
 
     do
     {
-#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd))
+        if ((OPTIGA_LIB_SUCCESS != optiga_util_cbor_expect(&reader, OPTIGA_UTIL_CBOR_ARRAY, 6)) ||
+            (OPTIGA_LIB_SUCCESS != optiga_util_cbor_expect(&reader, OPTIGA_UTIL_CBOR_UNSIGNED_INTEGER, 1)) ||
+            (OPTIGA_LIB_SUCCESS != optiga_util_cbor_expect(&reader, OPTIGA_UTIL_CBOR_SIMPLE, OPTIGA_UTIL_CBOR_NIL & 0x1FU)) ||
+            (OPTIGA_LIB_SUCCESS != optiga_util_cbor_expect(&reader, OPTIGA_UTIL_CBOR_SIMPLE, OPTIGA_UTIL_CBOR_NIL & 0x1FU)))
         {
-            return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
             break;
         }
-#endif
-
-        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        // Resource [type, size, version, additional info]
+        if ((OPTIGA_LIB_SUCCESS != optiga_util_cbor_expect(&reader, OPTIGA_UTIL_CBOR_ARRAY, 4)) ||
+            (OPTIGA_LIB_SUCCESS != optiga_util_cbor_get_header(&reader, &major_type, &length)) ||
+            (OPTIGA_UTIL_CBOR_NEGATIVE_INTEGER != major_type) ||
+            (OPTIGA_LIB_SUCCESS != optiga_util_cbor_get_header(&reader, &major_type, &p_check->remaining_length)) ||
+            (OPTIGA_UTIL_CBOR_UNSIGNED_INTEGER != major_type) || (0U == p_check->remaining_length) ||
+            (OPTIGA_LIB_SUCCESS != optiga_util_cbor_skip(&reader)) ||
+            (OPTIGA_LIB_SUCCESS != optiga_util_cbor_skip(&reader)))
         {
-            return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
             break;
         }
-
-        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
-        OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
-        OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
-
-#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
-        if (FALSE == perform_hibernate)
+        // Processors [[-1, bstr .cbor [SHA-256, digest of first fragment]], decrypt or nil]
+        if ((OPTIGA_LIB_SUCCESS != optiga_util_cbor_expect(&reader, OPTIGA_UTIL_CBOR_ARRAY, 2)) ||
+            (OPTIGA_LIB_SUCCESS != optiga_util_cbor_expect(&reader, OPTIGA_UTIL_CBOR_ARRAY, 2)) ||
+            (OPTIGA_LIB_SUCCESS != optiga_util_cbor_expect(&reader, OPTIGA_UTIL_CBOR_NEGATIVE_INTEGER,
+                                                           OPTIGA_UTIL_MANIFEST_PROCESS_INTEGRITY)) ||
+            (OPTIGA_LIB_SUCCESS != optiga_util_cbor_get_byte_string(&reader, &p_value, &length)))
         {
-            OPTIGA_PROTECTION_MANAGE_CONTEXT(me->my_cmd, OPTIGA_COMMS_SESSION_CONTEXT_NONE);
+            break;
         }
-        else
+        digest_info_reader.p_data = p_value;
+        digest_info_reader.length = length;
+        digest_info_reader.offset = 0;
+        if ((OPTIGA_LIB_SUCCESS != optiga_util_cbor_expect(&digest_info_reader, OPTIGA_UTIL_CBOR_ARRAY, 2)) ||
+            (OPTIGA_LIB_SUCCESS != optiga_util_cbor_expect(&digest_info_reader, OPTIGA_UTIL_CBOR_UNSIGNED_INTEGER,
+                                                           OPTIGA_UTIL_MANIFEST_DIGEST_SHA256)) ||
+            (OPTIGA_LIB_SUCCESS != optiga_util_cbor_get_byte_string(&digest_info_reader, &p_value, &length)) ||
+            (OPTIGA_UTIL_PROTECTED_UPDATE_DIGEST_LENGTH != length) || (digest_info_reader.length != digest_info_reader.offset))
         {
-            OPTIGA_PROTECTION_MANAGE_CONTEXT(me->my_cmd, OPTIGA_COMMS_SESSION_CONTEXT_SAVE);
+            break;
         }
-#endif //OPTIGA_COMMS_SHIELDED_CONNECTION
-
-        return_value = optiga_cmd_close_application(me->my_cmd, perform_hibernate, NULL);
-        if (OPTIGA_LIB_SUCCESS != return_value)
+        pal_os_memcpy(p_check->next_fragment_digest, p_value, OPTIGA_UTIL_PROTECTED_UPDATE_DIGEST_LENGTH);
+        p_check->encrypted = ((reader.offset < reader.length) && (OPTIGA_UTIL_CBOR_NIL == reader.p_data[reader.offset])) ?
+                             FALSE : TRUE;
+        // Decrypt step and target [component identifier, storage identifier]
+        if ((OPTIGA_LIB_SUCCESS != optiga_util_cbor_skip(&reader)) ||
+            (OPTIGA_LIB_SUCCESS != optiga_util_cbor_expect(&reader, OPTIGA_UTIL_CBOR_ARRAY, 2)) ||
+            (OPTIGA_LIB_SUCCESS != optiga_util_cbor_get_byte_string(&reader, &p_value, &length)) ||
+            (OPTIGA_LIB_SUCCESS != optiga_util_cbor_get_byte_string(&reader, &p_value, &length)) ||
+            (OPTIGA_UTIL_MANIFEST_OID_LENGTH != length) || (reader.length != reader.offset))
         {
-            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+            break;
         }
-
+        return_value = OPTIGA_LIB_SUCCESS;
     } while (FALSE);
-    optiga_util_reset_protection_level(me);
 
     return (return_value);
 }
 
-optiga_lib_status_t optiga_util_read_data(optiga_util_t * me,
-                                          uint16_t optiga_oid,
-                                          uint16_t offset,
-                                          uint8_t * buffer,
-                                          uint16_t * length)
+optiga_lib_status_t optiga_util_protected_update_check_init(optiga_util_protected_update_check_t * p_check,
+                                                           uint16_t trust_anchor_oid,
+                                                           const public_key_from_host_t * p_trust_anchor)
 {
-    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR;
-    optiga_get_data_object_params_t * p_params;
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
     OPTIGA_UTIL_LOG_MESSAGE(__FUNCTION__);
+
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) ||
-            (NULL == buffer) || (NULL == length))
+        if (NULL == p_check)
         {
-            return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
             break;
         }
 #endif
-
-        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        if ((NULL != p_trust_anchor) && (NULL == p_trust_anchor->public_key))
         {
-            return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
             break;
         }
-
-        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
-        p_params = (optiga_get_data_object_params_t *)&(me->params.optiga_get_data_object_params);
-        pal_os_memset(&me->params,0x00,sizeof(optiga_util_params_t));
-
-        p_params->oid = optiga_oid;
-        p_params->offset = offset;
-        // set option to read data
-        p_params->data_or_metadata = 0;
-        p_params->buffer = buffer;
-        p_params->bytes_to_read = *length;
-        p_params->ref_bytes_to_read = length;
-        p_params->accumulated_size = 0;
-        p_params->last_read_size = 0;
-
-        OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
-        OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
-
-        return_value = optiga_cmd_get_data_object(me->my_cmd, p_params->data_or_metadata, p_params);
-        if (OPTIGA_LIB_SUCCESS != return_value)
-        {
-            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
-        }
-
+        pal_os_memset(p_check, 0x00, sizeof(optiga_util_protected_update_check_t));
+        p_check->trust_anchor_oid = trust_anchor_oid;
+        p_check->p_trust_anchor = p_trust_anchor;
+        return_value = OPTIGA_UTIL_SUCCESS;
     } while (FALSE);
-    optiga_util_reset_protection_level(me);
 
     return (return_value);
 }
-
-optiga_lib_status_t optiga_util_read_metadata(optiga_util_t * me,
-                                              uint16_t optiga_oid,
-                                              uint8_t * buffer,
-                                              uint16_t * length)
+
+optiga_lib_status_t optiga_util_protected_update_check_manifest(optiga_util_protected_update_check_t * p_check,
+                                                               const uint8_t * manifest,
+                                                               uint16_t manifest_length)
 {
-    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR;
-    optiga_get_data_object_params_t * p_params;
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+    optiga_util_cbor_reader_t reader = {manifest, manifest_length, 0};
+    optiga_util_cbor_reader_t header_reader;
+    const uint8_t * p_protected = NULL;
+    const uint8_t * p_payload = NULL;
+    const uint8_t * p_signature = NULL;
+    const uint8_t * p_value;
+    uint32_t protected_length = 0;
+    uint32_t payload_length = 0;
+    uint32_t signature_length = 0;
+    uint32_t algorithm = 0;
+    uint32_t label;
+    uint32_t pairs;
+    uint32_t length;
+    uint16_t kid = 0;
+    uint8_t major_type;
     OPTIGA_UTIL_LOG_MESSAGE(__FUNCTION__);
+
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) ||
-            (NULL == buffer) || (NULL == length))
+        if ((NULL == p_check) || (NULL == manifest))
         {
-            return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
             break;
         }
 #endif
-
-        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        p_check->fragment_expected = FALSE;
+        return_value = OPTIGA_UTIL_ERROR_PROTECTED_UPDATE_INVALID;
+        // COSE_Sign1 [protected, unprotected, payload, signature], the tag is optional
+        if ((0U != manifest_length) && (OPTIGA_UTIL_COSE_SIGN1_TAG == manifest[0]))
+        {
+            reader.offset++;
+        }
+        if ((OPTIGA_LIB_SUCCESS != optiga_util_cbor_expect(&reader, OPTIGA_UTIL_CBOR_ARRAY, 4)) ||
+            (OPTIGA_LIB_SUCCESS != optiga_util_cbor_get_byte_string(&reader, &p_protected, &protected_length)))
         {
-            return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
             break;
         }
-
-        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
-        p_params = (optiga_get_data_object_params_t *)&(me->params.optiga_get_data_object_params);
-        pal_os_memset(&me->params,0x00,sizeof(optiga_util_params_t));
-
-        p_params->oid = optiga_oid;
-        p_params->offset = 0;
-        // set option to read metadata
-        p_params->data_or_metadata = 1;//for metadata
-        p_params->buffer = buffer;
-        p_params->bytes_to_read = *length;
-        p_params->ref_bytes_to_read = length;
-        p_params->accumulated_size = 0;
-        p_params->last_read_size = 0;
-        OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
-        OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
-
-        return_value = optiga_cmd_get_data_object(me->my_cmd, p_params->data_or_metadata,
-                                                  (optiga_get_data_object_params_t *)p_params);
+        // Protected header {1: algorithm}
+        header_reader.p_data = p_protected;
+        header_reader.length = protected_length;
+        header_reader.offset = 0;
+        if ((OPTIGA_LIB_SUCCESS != optiga_util_cbor_expect(&header_reader, OPTIGA_UTIL_CBOR_MAP, 1)) ||
+            (OPTIGA_LIB_SUCCESS != optiga_util_cbor_expect(&header_reader, OPTIGA_UTIL_CBOR_UNSIGNED_INTEGER,
+                                                           OPTIGA_UTIL_COSE_LABEL_ALG)) ||
+            (OPTIGA_LIB_SUCCESS != optiga_util_cbor_get_header(&header_reader, &major_type, &algorithm)) ||
+            (OPTIGA_UTIL_CBOR_NEGATIVE_INTEGER != major_type) || (header_reader.length != header_reader.offset))
+        {
+            break;
+        }
+        // Unprotected header {4: key identifier of the trust anchor}
+        if ((OPTIGA_LIB_SUCCESS != optiga_util_cbor_get_header(&reader, &major_type, &pairs)) ||
+            (OPTIGA_UTIL_CBOR_MAP != major_type))
+        {
+            break;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
+        for (; (0U != pairs) && (OPTIGA_LIB_SUCCESS == return_value); pairs--)
+        {
+            return_value = optiga_util_cbor_get_header(&reader, &major_type, &label);
+            if (OPTIGA_LIB_SUCCESS != return_value)
+            {
+                break;
+            }
+            if ((OPTIGA_UTIL_CBOR_UNSIGNED_INTEGER == major_type) && (OPTIGA_UTIL_COSE_LABEL_KID == label))
+            {
+                return_value = optiga_util_cbor_get_byte_string(&reader, &p_value, &length);
+                if ((OPTIGA_LIB_SUCCESS == return_value) && (OPTIGA_UTIL_MANIFEST_OID_LENGTH == length))
+                {
+                    kid = (uint16_t)((p_value[0] << 8) | p_value[1]);
+                }
+            }
+            else
+            {
+                return_value = optiga_util_cbor_skip(&reader);
+            }
+        }
+        if ((OPTIGA_LIB_SUCCESS != return_value) || (p_check->trust_anchor_oid != kid))
+        {
+            return_value = OPTIGA_UTIL_ERROR_PROTECTED_UPDATE_INVALID;
+            break;
+        }
+        return_value = OPTIGA_UTIL_ERROR_PROTECTED_UPDATE_INVALID;
+        if ((OPTIGA_LIB_SUCCESS != optiga_util_cbor_get_byte_string(&reader, &p_payload, &payload_length)) ||
+            (OPTIGA_LIB_SUCCESS != optiga_util_cbor_get_byte_string(&reader, &p_signature, &signature_length)) ||
+            (reader.length != reader.offset))
+        {
+            break;
+        }
+        return_value = optiga_util_protected_update_check_payload(p_check, p_payload, payload_length);
         if (OPTIGA_LIB_SUCCESS != return_value)
         {
-            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+            break;
         }
+        // Other algorithms (RSA) are verified only by OPTIGA
+        if ((NULL != p_check->p_trust_anchor) && (OPTIGA_UTIL_COSE_ALG_ES256 == algorithm))
+        {
+            return_value = optiga_util_protected_update_check_signature(p_check->p_trust_anchor,
+                                                                        p_protected,
+                                                                        protected_length,
+                                                                        p_payload,
+                                                                        payload_length,
+                                                                        p_signature,
+                                                                        signature_length);
+            if (OPTIGA_LIB_SUCCESS != return_value)
+            {
+                break;
+            }
+        }
+        p_check->fragment_expected = TRUE;
     } while (FALSE);
-    optiga_util_reset_protection_level(me);
 
     return (return_value);
 }
 
-optiga_lib_status_t optiga_util_write_data(optiga_util_t * me,
-                                           uint16_t optiga_oid,
-                                           uint8_t write_type,
-                                           uint16_t offset,
-                                           const uint8_t * buffer,
-                                           uint16_t length)
+optiga_lib_status_t optiga_util_protected_update_check_fragment(optiga_util_protected_update_check_t * p_check,
+                                                               const uint8_t * fragment,
+                                                               uint16_t fragment_length,
+                                                               bool_t final)
 {
     optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+    uint8_t hash_context[OPTIGA_HASH_CONTEXT_LENGTH_SHA_256];
+    uint8_t digest[OPTIGA_UTIL_PROTECTED_UPDATE_DIGEST_LENGTH];
+    uint8_t difference = 0;
+    uint16_t payload_length;
+    uint8_t index;
+    pal_status_t pal_return_value;
     OPTIGA_UTIL_LOG_MESSAGE(__FUNCTION__);
+
     do
     {
-        if ((OPTIGA_UTIL_WRITE_ONLY != write_type) && (OPTIGA_UTIL_ERASE_AND_WRITE != write_type))
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == p_check) || (NULL == fragment))
         {
             break;
         }
-        return_value =  optiga_util_write_data_wrapper(me,
-                                                       optiga_oid,
-                                                       write_type,
-                                                       offset,
-                                                       buffer,
-                                                       length);
+#endif
+        return_value = OPTIGA_UTIL_ERROR_PROTECTED_UPDATE_INVALID;
+        if ((FALSE == p_check->fragment_expected) ||
+            ((FALSE == final) && (OPTIGA_UTIL_PROTECTED_UPDATE_DIGEST_LENGTH >= fragment_length)))
+        {
+            p_check->fragment_expected = FALSE;
+            break;
+        }
+        p_check->fragment_expected = FALSE;
+
+        pal_return_value = pal_crypt_sha256_start(NULL, hash_context, sizeof(hash_context));
+        if (PAL_STATUS_SUCCESS == pal_return_value)
+        {
+            pal_return_value = pal_crypt_sha256_update(NULL, hash_context, sizeof(hash_context), fragment, fragment_length);
+        }
+        if (PAL_STATUS_SUCCESS == pal_return_value)
+        {
+            pal_return_value = pal_crypt_sha256_finalize(NULL, hash_context, sizeof(hash_context), digest);
+        }
+        pal_os_memset(hash_context, 0x00, sizeof(hash_context));
+        if (PAL_STATUS_SUCCESS != pal_return_value)
+        {
+            break;
+        }
+        for (index = 0; index < OPTIGA_UTIL_PROTECTED_UPDATE_DIGEST_LENGTH; index++)
+        {
+            difference |= (uint8_t)(digest[index] ^ p_check->next_fragment_digest[index]);
+        }
+        if (0U != difference)
+        {
+            break;
+        }
+
+        // The encrypted fragments hold the MAC in addition to the payload
+        payload_length = (TRUE == final) ? fragment_length : (fragment_length - OPTIGA_UTIL_PROTECTED_UPDATE_DIGEST_LENGTH);
+        if (FALSE == p_check->encrypted)
+        {
+            if ((payload_length > p_check->remaining_length) ||
+                ((TRUE == final) && (payload_length != p_check->remaining_length)))
+            {
+                break;
+            }
+            p_check->remaining_length -= payload_length;
+        }
+        if (FALSE == final)
+        {
+            pal_os_memcpy(p_check->next_fragment_digest,
+                          &fragment[payload_length],
+                          OPTIGA_UTIL_PROTECTED_UPDATE_DIGEST_LENGTH);
+            p_check->fragment_expected = TRUE;
+        }
+        return_value = OPTIGA_LIB_SUCCESS;
     } while (FALSE);
+
     return (return_value);
 }
 
-optiga_lib_status_t optiga_util_write_metadata(optiga_util_t * me,
-                                               uint16_t optiga_oid,
-                                               const uint8_t * buffer,
-                                               uint8_t length)
+optiga_lib_status_t optiga_util_set_protected_update_check(optiga_util_t * me,
+                                                          optiga_util_protected_update_check_t * p_check)
 {
-    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR;
-    optiga_set_data_object_params_t * p_params;
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
     OPTIGA_UTIL_LOG_MESSAGE(__FUNCTION__);
+
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
-        if ((NULL == me) || (NULL == me->my_cmd) || (NULL == buffer))
+        if (NULL == me)
         {
-            return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
             break;
         }
 #endif
-
         if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
         {
             return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
             break;
         }
-
-        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
-        p_params = (optiga_set_data_object_params_t *)&(me->params.optiga_set_data_object_params);
-        pal_os_memset(&me->params,0x00,sizeof(optiga_util_params_t));
-
-        p_params->oid = optiga_oid;
-        p_params->offset = 0;
-        //for Metadata
-        p_params->data_or_metadata = 1;
-        p_params->buffer = buffer;
-        p_params->size = length;
-        p_params->write_type = 1;
-        p_params->written_size = 0;
-        OPTIGA_PROTECTION_ENABLE(me->my_cmd, me);
-        OPTIGA_PROTECTION_SET_VERSION(me->my_cmd, me);
-
-        return_value = optiga_cmd_set_data_object(me->my_cmd, p_params->write_type,
-                                                  (optiga_set_data_object_params_t *)p_params);
-        if (OPTIGA_LIB_SUCCESS != return_value)
-        {
-            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
-        }
+        me->p_protected_update_check = p_check;
+        return_value = OPTIGA_UTIL_SUCCESS;
     } while (FALSE);
-    optiga_util_reset_protection_level(me);
 
     return (return_value);
 }
+#endif //OPTIGA_UTIL_PROTECTED_UPDATE_CHECK_ENABLED
 
 _STATIC_H optiga_lib_status_t optiga_util_protected_update(optiga_util_t * me,
                                                            uint8_t manifest_version,
@@ -547,6 +2849,21 @@ _STATIC_H optiga_lib_status_t optiga_util_protected_update(optiga_util_t * me,
             return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
             break;
         }
+#ifdef OPTIGA_UTIL_PROTECTED_UPDATE_CHECK_ENABLED
+        // An invalid data set is rejected before it is sent, the release of the strict sequence (NULL) is not checked
+        if ((NULL != me->p_protected_update_check) && (NULL != p_buffer))
+        {
+            return_value = (OPTIGA_SET_PROTECTED_UPDATE_START == set_obj_tag) ?
+                           optiga_util_protected_update_check_manifest(me->p_protected_update_check, p_buffer, buffer_length) :
+                           optiga_util_protected_update_check_fragment(me->p_protected_update_check, p_buffer, buffer_length,
+                                                                       (OPTIGA_SET_PROTECTED_UPDATE_FINAL == set_obj_tag) ?
+                                                                       TRUE : FALSE);
+            if (OPTIGA_LIB_SUCCESS != return_value)
+            {
+                break;
+            }
+        }
+#endif //OPTIGA_UTIL_PROTECTED_UPDATE_CHECK_ENABLED
 
         me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
         p_params = (optiga_set_object_protected_params_t *)&(me->params.optiga_set_object_protected_params);
@@ -667,6 +2984,244 @@ optiga_lib_status_t optiga_util_update_count(optiga_util_t * me,
                                            sizeof(count_value)));
 }
 
+#ifdef OPTIGA_UTIL_COUNT_COALESCING_ENABLED
+/*
+* Flushes the pending increments of the counter data objects from first till end (excluded)
+*/
+_STATIC_H optiga_lib_status_t optiga_util_count_flush_start(optiga_util_t * me, uint8_t first, uint8_t end)
+{
+    optiga_lib_status_t return_value;
+
+    me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+    me->count_flush_index = first;
+    me->count_flush_end = end;
+    if (FALSE == optiga_util_count_flush_next(me, &return_value))
+    {
+        me->count_flush_end = 0;
+        optiga_util_reset_protection_level(me);
+        if (OPTIGA_LIB_SUCCESS == return_value)
+        {
+            // No increment is pending, the completion is reported through the scheduler
+            return_value = optiga_cmd_complete_on_host(me->my_cmd, OPTIGA_LIB_SUCCESS);
+        }
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+        }
+    }
+    return (return_value);
+}
+optiga_lib_status_t optiga_util_add_count(optiga_util_t * me,
+                                          uint16_t optiga_counter_oid,
+                                          uint8_t count)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+    bool_t flush_due;
+    uint8_t index;
+
+    OPTIGA_UTIL_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            break;
+        }
+#endif
+        if ((optiga_counter_oid < OPTIGA_UTIL_COUNTER_OID_FIRST) ||
+            (optiga_counter_oid >= (OPTIGA_UTIL_COUNTER_OID_FIRST + OPTIGA_UTIL_COUNTER_OID_COUNT)) ||
+            (0U == count))
+        {
+            break;
+        }
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        index = (uint8_t)(optiga_counter_oid - OPTIGA_UTIL_COUNTER_OID_FIRST);
+        // The pending increments are held by the OPTIGA context, shared by all the instances
+        if (OPTIGA_LIB_SUCCESS != optiga_cmd_pending_count_add(me->my_cmd, index, count, &flush_due))
+        {
+            return_value = OPTIGA_UTIL_ERROR_MEMORY_INSUFFICIENT;
+            break;
+        }
+        if (TRUE == flush_due)
+        {
+            return_value = optiga_util_count_flush_start(me, index, index + 1);
+            break;
+        }
+        // The increment is only recorded, the completion is reported through the scheduler
+        optiga_util_reset_protection_level(me);
+        me->instance_state = OPTIGA_LIB_INSTANCE_BUSY;
+        return_value = optiga_cmd_complete_on_host(me->my_cmd, OPTIGA_LIB_SUCCESS);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            me->instance_state = OPTIGA_LIB_INSTANCE_FREE;
+        }
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_flush_count(optiga_util_t * me,
+                                            uint16_t optiga_counter_oid)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+    uint8_t index;
+
+    OPTIGA_UTIL_LOG_MESSAGE(__FUNCTION__);
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->my_cmd))
+        {
+            break;
+        }
+#endif
+        if ((OPTIGA_UTIL_COUNTER_OID_ALL != optiga_counter_oid) &&
+            ((optiga_counter_oid < OPTIGA_UTIL_COUNTER_OID_FIRST) ||
+             (optiga_counter_oid >= (OPTIGA_UTIL_COUNTER_OID_FIRST + OPTIGA_UTIL_COUNTER_OID_COUNT))))
+        {
+            break;
+        }
+        if (OPTIGA_LIB_INSTANCE_BUSY == me->instance_state)
+        {
+            return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        if (OPTIGA_UTIL_COUNTER_OID_ALL == optiga_counter_oid)
+        {
+            return_value = optiga_util_count_flush_start(me, 0, OPTIGA_UTIL_COUNTER_OID_COUNT);
+        }
+        else
+        {
+            index = (uint8_t)(optiga_counter_oid - OPTIGA_UTIL_COUNTER_OID_FIRST);
+            return_value = optiga_util_count_flush_start(me, index, index + 1);
+        }
+    } while (FALSE);
+
+    return (return_value);
+}
+#endif //OPTIGA_UTIL_COUNT_COALESCING_ENABLED
+
+#ifdef OPTIGA_LIB_SYNC_API_ENABLED
+optiga_lib_status_t optiga_util_open_application_sync(optiga_util_t * me,
+                                                      bool_t perform_restore)
+{
+    optiga_lib_status_t return_value = optiga_util_sync_begin(me);
+
+    if (OPTIGA_LIB_SUCCESS == return_value)
+    {
+        return_value = optiga_util_sync_end(me, optiga_util_open_application(me,
+                                                                             perform_restore));
+    }
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_close_application_sync(optiga_util_t * me,
+                                                       bool_t perform_hibernate)
+{
+    optiga_lib_status_t return_value = optiga_util_sync_begin(me);
+
+    if (OPTIGA_LIB_SUCCESS == return_value)
+    {
+        return_value = optiga_util_sync_end(me, optiga_util_close_application(me,
+                                                                              perform_hibernate));
+    }
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_read_data_sync(optiga_util_t * me,
+                                               uint16_t optiga_oid,
+                                               uint16_t offset,
+                                               uint8_t * buffer,
+                                               uint16_t * length)
+{
+    optiga_lib_status_t return_value = optiga_util_sync_begin(me);
+
+    if (OPTIGA_LIB_SUCCESS == return_value)
+    {
+        return_value = optiga_util_sync_end(me, optiga_util_read_data(me,
+                                                                      optiga_oid,
+                                                                      offset,
+                                                                      buffer,
+                                                                      length));
+    }
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_read_metadata_sync(optiga_util_t * me,
+                                                   uint16_t optiga_oid,
+                                                   uint8_t * buffer,
+                                                   uint16_t * length)
+{
+    optiga_lib_status_t return_value = optiga_util_sync_begin(me);
+
+    if (OPTIGA_LIB_SUCCESS == return_value)
+    {
+        return_value = optiga_util_sync_end(me, optiga_util_read_metadata(me,
+                                                                          optiga_oid,
+                                                                          buffer,
+                                                                          length));
+    }
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_write_data_sync(optiga_util_t * me,
+                                                uint16_t optiga_oid,
+                                                uint8_t write_type,
+                                                uint16_t offset,
+                                                const uint8_t * buffer,
+                                                uint16_t length)
+{
+    optiga_lib_status_t return_value = optiga_util_sync_begin(me);
+
+    if (OPTIGA_LIB_SUCCESS == return_value)
+    {
+        return_value = optiga_util_sync_end(me, optiga_util_write_data(me,
+                                                                       optiga_oid,
+                                                                       write_type,
+                                                                       offset,
+                                                                       buffer,
+                                                                       length));
+    }
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_write_metadata_sync(optiga_util_t * me,
+                                                    uint16_t optiga_oid,
+                                                    const uint8_t * buffer,
+                                                    uint8_t length)
+{
+    optiga_lib_status_t return_value = optiga_util_sync_begin(me);
+
+    if (OPTIGA_LIB_SUCCESS == return_value)
+    {
+        return_value = optiga_util_sync_end(me, optiga_util_write_metadata(me,
+                                                                           optiga_oid,
+                                                                           buffer,
+                                                                           length));
+    }
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_update_count_sync(optiga_util_t * me,
+                                                  uint16_t optiga_counter_oid,
+                                                  uint8_t count)
+{
+    optiga_lib_status_t return_value = optiga_util_sync_begin(me);
+
+    if (OPTIGA_LIB_SUCCESS == return_value)
+    {
+        return_value = optiga_util_sync_end(me, optiga_util_update_count(me,
+                                                                         optiga_counter_oid,
+                                                                         count));
+    }
+    return (return_value);
+}
+#endif //OPTIGA_LIB_SYNC_API_ENABLED
+
 /**
 * @}
 */
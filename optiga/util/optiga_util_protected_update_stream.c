@@ -0,0 +1,513 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_util_protected_update_stream.c
+*
+* \brief   This file implements the OPTIGA Util protected update stream, which feeds the manifest and the fragments of a protected update data set from a reader.
+*
+* \ingroup  grOptigaUtil
+*
+* @{
+*/
+
+#include "optiga/optiga_util_protected_update_stream.h"
+#include "optiga/common/optiga_lib_common_internal.h"
+#include "optiga/pal/pal_os_lock.h"
+#include "optiga/pal/pal_os_memory.h"
+
+#ifdef OPTIGA_UTIL_PROTECTED_UPDATE_STREAM_ENABLED
+
+/// Major types of CBOR items
+#define OPTIGA_UTIL_CBOR_BYTE_STRING        (0x02)
+#define OPTIGA_UTIL_CBOR_TEXT_STRING        (0x03)
+#define OPTIGA_UTIL_CBOR_ARRAY              (0x04)
+#define OPTIGA_UTIL_CBOR_MAP                (0x05)
+#define OPTIGA_UTIL_CBOR_TAG                (0x06)
+/// Additional information of CBOR items, which indicates a 1 byte argument. 2 and 4 byte arguments follow
+#define OPTIGA_UTIL_CBOR_ARGUMENT_1_BYTE    (0x18)
+#define OPTIGA_UTIL_CBOR_ARGUMENT_4_BYTES   (0x1A)
+
+/*
+* Completes the stream and invokes the callback of the caller
+*/
+_STATIC_H void optiga_util_protected_update_stream_complete(optiga_util_protected_update_stream_t * me,
+                                                            optiga_lib_status_t status)
+{
+    // The data set of the caller is not kept once the stream is completed
+    pal_os_memset(me->buffer, 0, sizeof(me->buffer));
+    me->ongoing = FALSE;
+    if (NULL != me->caller_handler)
+    {
+        me->caller_handler(me->caller_context, status);
+    }
+}
+
+/*
+* Aborts the stream. The strict sequence acquired by the protected update start is released first
+*/
+_STATIC_H void optiga_util_protected_update_stream_release(optiga_util_protected_update_stream_t * me,
+                                                           optiga_lib_status_t status)
+{
+    me->abort_status = status;
+    me->releasing = TRUE;
+    if (OPTIGA_LIB_SUCCESS != optiga_util_protected_update_final(me->p_util, NULL, 0))
+    {
+        optiga_util_protected_update_stream_complete(me, status);
+    }
+}
+
+/*
+* Reads exactly the requested number of bytes of the manifest
+*/
+_STATIC_H optiga_lib_status_t optiga_util_protected_update_stream_read_exact(optiga_util_protected_update_stream_t * me,
+                                                                             uint32_t length)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+    uint16_t read_length = 0;
+
+    do
+    {
+        if ((me->length[0] + length) > OPTIGA_UTIL_PROTECTED_UPDATE_FRAGMENT_SIZE)
+        {
+            break;
+        }
+        if (0 == length)
+        {
+            return_value = OPTIGA_LIB_SUCCESS;
+            break;
+        }
+        return_value = me->reader(me->p_io_ctx, &me->buffer[0][me->length[0]], (uint16_t)length, &read_length);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            break;
+        }
+        if (read_length != length)
+        {
+            // The data set ends within the manifest
+            return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+            break;
+        }
+        me->length[0] += (uint16_t)length;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+/*
+* Reads the manifest into the first buffer, by reading the CBOR items until the structure is complete
+*/
+_STATIC_H optiga_lib_status_t optiga_util_protected_update_stream_read_manifest(optiga_util_protected_update_stream_t * me)
+{
+    optiga_lib_status_t return_value = OPTIGA_LIB_SUCCESS;
+    uint32_t pending_items = 1;
+    uint32_t argument;
+    uint16_t offset;
+    uint8_t major_type;
+    uint8_t info;
+    uint8_t index;
+
+    me->length[0] = 0;
+    while ((0 != pending_items) && (OPTIGA_LIB_SUCCESS == return_value))
+    {
+        pending_items--;
+        offset = me->length[0];
+        return_value = optiga_util_protected_update_stream_read_exact(me, 1);
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            break;
+        }
+        major_type = me->buffer[0][offset] >> 5;
+        info = me->buffer[0][offset] & 0x1F;
+        argument = info;
+        if (OPTIGA_UTIL_CBOR_ARGUMENT_4_BYTES < info)
+        {
+            // Indefinite length and 8 byte arguments
+            return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+            break;
+        }
+        if (OPTIGA_UTIL_CBOR_ARGUMENT_1_BYTE <= info)
+        {
+            offset = me->length[0];
+            return_value = optiga_util_protected_update_stream_read_exact(me, 1UL << (info - OPTIGA_UTIL_CBOR_ARGUMENT_1_BYTE));
+            if (OPTIGA_LIB_SUCCESS != return_value)
+            {
+                break;
+            }
+            argument = 0;
+            for (index = 0; index < (1U << (info - OPTIGA_UTIL_CBOR_ARGUMENT_1_BYTE)); index++)
+            {
+                argument = (argument << 8) | me->buffer[0][offset + index];
+            }
+        }
+        // Every item takes at least one byte, hence larger arguments do not fit into the buffer anyway
+        if (OPTIGA_UTIL_PROTECTED_UPDATE_FRAGMENT_SIZE < argument)
+        {
+            return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+            break;
+        }
+        switch (major_type)
+        {
+            case OPTIGA_UTIL_CBOR_BYTE_STRING:
+            case OPTIGA_UTIL_CBOR_TEXT_STRING:
+            {
+                return_value = optiga_util_protected_update_stream_read_exact(me, argument);
+                break;
+            }
+            case OPTIGA_UTIL_CBOR_ARRAY:
+            {
+                pending_items += argument;
+                break;
+            }
+            case OPTIGA_UTIL_CBOR_MAP:
+            {
+                pending_items += (argument * 2);
+                break;
+            }
+            case OPTIGA_UTIL_CBOR_TAG:
+            {
+                pending_items++;
+                break;
+            }
+            default:
+            {
+                // Integers and simple values are complete with the argument
+                break;
+            }
+        }
+    }
+
+    return (return_value);
+}
+
+/*
+* Reads the next fragment into the buffer and reads one byte ahead, to detect the final fragment
+*/
+_STATIC_H optiga_lib_status_t optiga_util_protected_update_stream_read_fragment(optiga_util_protected_update_stream_t * me,
+                                                                                uint8_t index)
+{
+    optiga_lib_status_t return_value = OPTIGA_LIB_SUCCESS;
+    uint16_t length = 0;
+    uint16_t read_length = 0;
+
+    do
+    {
+        if (TRUE == me->lookahead_valid)
+        {
+            me->buffer[index][length++] = me->lookahead;
+            me->lookahead_valid = FALSE;
+        }
+        if (FALSE == me->end_of_data)
+        {
+            return_value = me->reader(me->p_io_ctx, &me->buffer[index][length],
+                                      (OPTIGA_UTIL_PROTECTED_UPDATE_FRAGMENT_SIZE - length), &read_length);
+            if (OPTIGA_LIB_SUCCESS != return_value)
+            {
+                break;
+            }
+            me->end_of_data = (read_length < (OPTIGA_UTIL_PROTECTED_UPDATE_FRAGMENT_SIZE - length)) ? TRUE : FALSE;
+            length += read_length;
+        }
+        if (FALSE == me->end_of_data)
+        {
+            return_value = me->reader(me->p_io_ctx, &me->lookahead, 1, &read_length);
+            if (OPTIGA_LIB_SUCCESS != return_value)
+            {
+                break;
+            }
+            me->lookahead_valid = (1 == read_length) ? TRUE : FALSE;
+            me->end_of_data = (1 == read_length) ? FALSE : TRUE;
+        }
+        if (0 == length)
+        {
+            // The data set has no fragment after the manifest
+            return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+            break;
+        }
+        me->length[index] = length;
+        me->final[index] = ((TRUE == me->end_of_data) && (FALSE == me->lookahead_valid)) ? TRUE : FALSE;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+/*
+* Writes the next fragment to OPTIGA, using protected update continue or final
+*/
+_STATIC_H optiga_lib_status_t optiga_util_protected_update_stream_submit(optiga_util_protected_update_stream_t * me)
+{
+    optiga_lib_status_t return_value;
+    uint8_t index = me->submit_index;
+
+    me->submit_index ^= 1U;
+    if (TRUE == me->final[index])
+    {
+        me->final_submitted = TRUE;
+        return_value = optiga_util_protected_update_final(me->p_util, me->buffer[index], me->length[index]);
+    }
+    else
+    {
+        return_value = optiga_util_protected_update_continue(me->p_util, me->buffer[index], me->length[index]);
+    }
+    return (return_value);
+}
+
+/*
+* Reads the next fragment into the free buffer and submits it, if the current fragment is already completed
+*/
+_STATIC_H void optiga_util_protected_update_stream_prepare(optiga_util_protected_update_stream_t * me)
+{
+    optiga_lib_status_t status;
+    uint8_t submit_now = FALSE;
+    uint8_t abort_now = FALSE;
+
+    status = optiga_util_protected_update_stream_read_fragment(me, me->submit_index);
+
+    pal_os_lock_enter_critical_section();
+    if (OPTIGA_LIB_SUCCESS != status)
+    {
+        // The stream is aborted once no fragment is executed by OPTIGA anymore
+        me->abort_status = status;
+        abort_now = me->waiting;
+    }
+    else if (TRUE == me->waiting)
+    {
+        submit_now = TRUE;
+    }
+    else
+    {
+        me->next_prepared = TRUE;
+    }
+    me->waiting = FALSE;
+    pal_os_lock_exit_critical_section();
+
+    if (TRUE == abort_now)
+    {
+        optiga_util_protected_update_stream_release(me, status);
+    }
+    else if (TRUE == submit_now)
+    {
+        status = optiga_util_protected_update_stream_submit(me);
+        if (OPTIGA_LIB_SUCCESS != status)
+        {
+            optiga_util_protected_update_stream_release(me, status);
+        }
+        else if (FALSE == me->final_submitted)
+        {
+            optiga_util_protected_update_stream_prepare(me);
+        }
+        else
+        {
+            // Stream is completed with the final fragment
+        }
+    }
+    else
+    {
+        // Fragment is submitted on completion of the current one
+    }
+}
+
+/*
+* Event handler of the stream instance, submits the next fragment on completion of the manifest or a fragment
+*/
+_STATIC_H void optiga_util_protected_update_stream_event_handler(void * p_ctx, optiga_lib_status_t event)
+{
+    optiga_util_protected_update_stream_t * me = (optiga_util_protected_update_stream_t *)p_ctx;
+    optiga_lib_status_t status = event;
+    uint8_t submit_now;
+
+    do
+    {
+        if (TRUE == me->releasing)
+        {
+            optiga_util_protected_update_stream_complete(me, me->abort_status);
+            break;
+        }
+        // The strict sequence is terminated by OPTIGA, on error or with the final fragment
+        if ((OPTIGA_LIB_SUCCESS != status) || (TRUE == me->final_submitted))
+        {
+            optiga_util_protected_update_stream_complete(me, status);
+            break;
+        }
+
+        pal_os_lock_enter_critical_section();
+        submit_now = me->next_prepared;
+        me->next_prepared = FALSE;
+        // A failed read is reported either here or by the reader, once waiting is set
+        status = me->abort_status;
+        me->waiting = ((FALSE == submit_now) && (OPTIGA_LIB_SUCCESS == status)) ? TRUE : FALSE;
+        pal_os_lock_exit_critical_section();
+
+        if (OPTIGA_LIB_SUCCESS != status)
+        {
+            optiga_util_protected_update_stream_release(me, status);
+            break;
+        }
+        if (TRUE == submit_now)
+        {
+            // The next fragment is read, while this one is executed by OPTIGA
+            status = optiga_util_protected_update_stream_submit(me);
+            if (OPTIGA_LIB_SUCCESS != status)
+            {
+                optiga_util_protected_update_stream_release(me, status);
+                break;
+            }
+            if (FALSE == me->final_submitted)
+            {
+                optiga_util_protected_update_stream_prepare(me);
+            }
+        }
+    } while (FALSE);
+}
+
+optiga_lib_status_t optiga_util_protected_update_stream_init(optiga_util_protected_update_stream_t * me,
+                                                             uint8_t optiga_instance_id,
+                                                             callback_handler_t handler,
+                                                             void * caller_context)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        pal_os_memset(me, 0, sizeof(optiga_util_protected_update_stream_t));
+        me->caller_handler = handler;
+        me->caller_context = caller_context;
+
+        return_value = OPTIGA_UTIL_ERROR;
+        me->p_util = optiga_util_create(optiga_instance_id, optiga_util_protected_update_stream_event_handler, me);
+        if (NULL == me->p_util)
+        {
+            break;
+        }
+        return_value = OPTIGA_UTIL_SUCCESS;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_protected_update_stream_deinit(optiga_util_protected_update_stream_t * me)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == me)
+        {
+            break;
+        }
+#endif
+        if (TRUE == me->ongoing)
+        {
+            return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
+            break;
+        }
+        if (NULL != me->p_util)
+        {
+            //lint --e{534} suppress "Instance is free, return value is not required to be checked"
+            optiga_util_destroy(me->p_util);
+        }
+        pal_os_memset(me, 0, sizeof(optiga_util_protected_update_stream_t));
+        return_value = OPTIGA_UTIL_SUCCESS;
+    } while (FALSE);
+
+    return (return_value);
+}
+
+optiga_lib_status_t optiga_util_protected_update_stream_start(optiga_util_protected_update_stream_t * me,
+                                                              uint8_t manifest_version,
+                                                              optiga_util_protected_update_reader_t reader,
+                                                              void * p_io_ctx)
+{
+    optiga_lib_status_t return_value = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == me) || (NULL == me->p_util))
+        {
+            break;
+        }
+#endif
+        if (NULL == reader)
+        {
+            break;
+        }
+
+        pal_os_lock_enter_critical_section();
+        if (TRUE == me->ongoing)
+        {
+            return_value = OPTIGA_UTIL_ERROR_INSTANCE_IN_USE;
+        }
+        me->ongoing = TRUE;
+        pal_os_lock_exit_critical_section();
+        if (OPTIGA_UTIL_ERROR_INSTANCE_IN_USE == return_value)
+        {
+            break;
+        }
+
+        me->reader = reader;
+        me->p_io_ctx = p_io_ctx;
+        me->lookahead_valid = FALSE;
+        me->end_of_data = FALSE;
+        me->abort_status = OPTIGA_LIB_SUCCESS;
+        me->next_prepared = FALSE;
+        me->waiting = FALSE;
+        me->final_submitted = FALSE;
+        me->releasing = FALSE;
+        // The manifest is kept in the first buffer until it is written, the first fragment is read into the second
+        me->submit_index = 1;
+
+        return_value = optiga_util_protected_update_stream_read_manifest(me);
+        if (OPTIGA_LIB_SUCCESS == return_value)
+        {
+            return_value = optiga_util_protected_update_start(me->p_util, manifest_version,
+                                                              me->buffer[0], me->length[0]);
+        }
+        if (OPTIGA_LIB_SUCCESS != return_value)
+        {
+            pal_os_memset(me->buffer, 0, sizeof(me->buffer));
+            me->ongoing = FALSE;
+            break;
+        }
+        optiga_util_protected_update_stream_prepare(me);
+    } while (FALSE);
+
+    return (return_value);
+}
+
+#endif //OPTIGA_UTIL_PROTECTED_UPDATE_STREAM_ENABLED
+
+/**
+* @}
+*/
@@ -0,0 +1,310 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_ipc_server.c
+*
+* \brief   This file implements the crypto service on CM0+, which executes the requests of CM4 with the host library.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include "optiga/optiga_util.h"
+#include "optiga/optiga_crypt.h"
+#include "optiga_ipc.h"
+#include "cy_pdl.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/// Priority of the server task, which dispatches the queued requests to the workers
+#ifndef OPTIGA_IPC_SERVER_TASK_PRIORITY
+#define OPTIGA_IPC_SERVER_TASK_PRIORITY     (configMAX_PRIORITIES - 2)
+#endif
+
+/// @cond hidden
+typedef struct optiga_ipc_worker
+{
+    /// Util instance of the worker
+    optiga_util_t * p_util;
+    /// Crypt instance of the worker
+    optiga_crypt_t * p_crypt;
+    /// Request executed by the worker, NULL if the worker is free
+    optiga_ipc_request_t * volatile p_request;
+}optiga_ipc_worker_t;
+
+static optiga_ipc_worker_t optiga_ipc_workers[OPTIGA_IPC_WORKER_COUNT];
+
+/* Requests received from CM4. Written by the IPC interrupt (head) and read by the server task (tail) */
+static optiga_ipc_request_t * volatile optiga_ipc_queue[OPTIGA_IPC_QUEUE_SIZE];
+static volatile uint8_t optiga_ipc_queue_head = 0;
+static volatile uint8_t optiga_ipc_queue_tail = 0;
+
+static TaskHandle_t optiga_ipc_server_task_handle = NULL;
+/// @endcond
+
+/*
+* Responds the completed request to CM4, the same pointer is passed back
+*/
+_STATIC_H void optiga_ipc_server_respond(optiga_ipc_request_t * p_request)
+{
+    cy_en_ipc_pipe_status_t pipe_status;
+
+    do
+    {
+        // Pipe is busy only until CM4 acknowledged the previous response
+        pipe_status = Cy_IPC_Pipe_SendMessage(CY_IPC_EP_CYPIPE_CM4_ADDR,
+                                              CY_IPC_EP_CYPIPE_CM0_ADDR,
+                                              (void *)p_request,
+                                              NULL);
+    } while (CY_IPC_PIPE_ERROR_SEND_BUSY == pipe_status);
+}
+
+/*
+* Callback of the util and crypt instances, completes the request of the worker
+*/
+_STATIC_H void optiga_ipc_server_worker_callback(void * p_ctx, optiga_lib_status_t event)
+{
+    optiga_ipc_worker_t * p_worker = (optiga_ipc_worker_t *)p_ctx;
+    optiga_ipc_request_t * p_request = p_worker->p_request;
+
+    p_request->status = event;
+    p_worker->p_request = NULL;
+    optiga_ipc_server_respond(p_request);
+
+    // Queued requests are dispatched to the free worker
+    xTaskNotifyGive(optiga_ipc_server_task_handle);
+}
+
+/*
+* Invokes the API of the requested service with the instance of the worker
+*/
+_STATIC_H optiga_lib_status_t optiga_ipc_server_dispatch(const optiga_ipc_worker_t * p_worker,
+                                                         const optiga_ipc_request_t * p_request)
+{
+    optiga_lib_status_t return_status = OPTIGA_IPC_ERROR_SERVICE;
+    const uintptr_t * args = p_request->args;
+
+    switch (p_request->service)
+    {
+        case OPTIGA_IPC_UTIL_OPEN_APPLICATION:
+        {
+            return_status = optiga_util_open_application(p_worker->p_util, (bool_t)args[0]);
+        }
+        break;
+        case OPTIGA_IPC_UTIL_CLOSE_APPLICATION:
+        {
+            return_status = optiga_util_close_application(p_worker->p_util, (bool_t)args[0]);
+        }
+        break;
+        case OPTIGA_IPC_UTIL_READ_DATA:
+        {
+            return_status = optiga_util_read_data(p_worker->p_util, (uint16_t)args[0], (uint16_t)args[1],
+                                                  (uint8_t *)args[2], (uint16_t *)args[3]);
+        }
+        break;
+        case OPTIGA_IPC_UTIL_READ_METADATA:
+        {
+            return_status = optiga_util_read_metadata(p_worker->p_util, (uint16_t)args[0],
+                                                      (uint8_t *)args[1], (uint16_t *)args[2]);
+        }
+        break;
+        case OPTIGA_IPC_UTIL_WRITE_DATA:
+        {
+            return_status = optiga_util_write_data(p_worker->p_util, (uint16_t)args[0], (uint8_t)args[1],
+                                                   (uint16_t)args[2], (const uint8_t *)args[3], (uint16_t)args[4]);
+        }
+        break;
+#ifdef OPTIGA_CRYPT_RANDOM_ENABLED
+        case OPTIGA_IPC_CRYPT_RANDOM:
+        {
+            return_status = optiga_crypt_random(p_worker->p_crypt, (optiga_rng_type_t)args[0],
+                                                (uint8_t *)args[1], (uint16_t)args[2]);
+        }
+        break;
+#endif //OPTIGA_CRYPT_RANDOM_ENABLED
+#ifdef OPTIGA_CRYPT_HASH_ENABLED
+        case OPTIGA_IPC_CRYPT_HASH:
+        {
+            return_status = optiga_crypt_hash(p_worker->p_crypt, (optiga_hash_type_t)args[0], (uint8_t)args[1],
+                                              (const void *)args[2], (uint8_t *)args[3]);
+        }
+        break;
+#endif //OPTIGA_CRYPT_HASH_ENABLED
+#ifdef OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED
+        case OPTIGA_IPC_CRYPT_ECC_GENERATE_KEYPAIR:
+        {
+            return_status = optiga_crypt_ecc_generate_keypair(p_worker->p_crypt, (optiga_ecc_curve_t)args[0],
+                                                              (uint8_t)args[1], (bool_t)args[2], (void *)args[3],
+                                                              (uint8_t *)args[4], (uint16_t *)args[5]);
+        }
+        break;
+#endif //OPTIGA_CRYPT_ECC_GENERATE_KEYPAIR_ENABLED
+#ifdef OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
+        case OPTIGA_IPC_CRYPT_ECDSA_SIGN:
+        {
+            return_status = optiga_crypt_ecdsa_sign(p_worker->p_crypt, (const uint8_t *)args[0], (uint8_t)args[1],
+                                                    (optiga_key_id_t)args[2], (uint8_t *)args[3],
+                                                    (uint16_t *)args[4]);
+        }
+        break;
+#endif //OPTIGA_CRYPT_ECDSA_SIGN_ENABLED
+#ifdef OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED
+        case OPTIGA_IPC_CRYPT_ECDSA_VERIFY:
+        {
+            return_status = optiga_crypt_ecdsa_verify(p_worker->p_crypt, (const uint8_t *)args[0], (uint8_t)args[1],
+                                                      (const uint8_t *)args[2], (uint16_t)args[3],
+                                                      (uint8_t)args[4], (const void *)args[5]);
+        }
+        break;
+#endif //OPTIGA_CRYPT_ECDSA_VERIFY_ENABLED
+#ifdef OPTIGA_CRYPT_ECDH_ENABLED
+        case OPTIGA_IPC_CRYPT_ECDH:
+        {
+            return_status = optiga_crypt_ecdh(p_worker->p_crypt, (optiga_key_id_t)args[0],
+                                              (public_key_from_host_t *)args[1], (bool_t)args[2],
+                                              (uint8_t *)args[3]);
+        }
+        break;
+#endif //OPTIGA_CRYPT_ECDH_ENABLED
+        default:
+            break;
+    }
+
+    return (return_status);
+}
+
+/*
+* Dispatches the queued requests to the free workers, in the order of reception
+*/
+_STATIC_H void optiga_ipc_server_task(void * pvParameters)
+{
+    optiga_ipc_request_t * p_request;
+    optiga_lib_status_t return_status;
+    uint8_t index;
+
+    while (1)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        for (index = 0; index < OPTIGA_IPC_WORKER_COUNT; index++)
+        {
+            // A request, which is not started, leaves the worker free for the next queued request
+            while ((NULL == optiga_ipc_workers[index].p_request) && (optiga_ipc_queue_tail != optiga_ipc_queue_head))
+            {
+                p_request = optiga_ipc_queue[optiga_ipc_queue_tail];
+                optiga_ipc_queue_tail = (uint8_t)((optiga_ipc_queue_tail + 1U) % OPTIGA_IPC_QUEUE_SIZE);
+
+                optiga_ipc_workers[index].p_request = p_request;
+                return_status = optiga_ipc_server_dispatch(&optiga_ipc_workers[index], p_request);
+                if (OPTIGA_LIB_SUCCESS != return_status)
+                {
+                    // Worker callback is not invoked for the request
+                    optiga_ipc_workers[index].p_request = NULL;
+                    p_request->status = return_status;
+                    optiga_ipc_server_respond(p_request);
+                }
+            }
+        }
+    }
+}
+
+/*
+* Receives the requests of CM4, invoked from the IPC interrupt
+*/
+_STATIC_H void optiga_ipc_server_receive(uint32_t * msg_ptr)
+{
+    optiga_ipc_request_t * p_request = (optiga_ipc_request_t *)msg_ptr;
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    uint8_t next_head = (uint8_t)((optiga_ipc_queue_head + 1U) % OPTIGA_IPC_QUEUE_SIZE);
+
+    if (next_head == optiga_ipc_queue_tail)
+    {
+        p_request->status = OPTIGA_IPC_ERROR_QUEUE_FULL;
+        optiga_ipc_server_respond(p_request);
+    }
+    else
+    {
+        optiga_ipc_queue[optiga_ipc_queue_head] = p_request;
+        optiga_ipc_queue_head = next_head;
+        vTaskNotifyGiveFromISR(optiga_ipc_server_task_handle, &higher_priority_task_woken);
+        portYIELD_FROM_ISR(higher_priority_task_woken);
+    }
+}
+
+optiga_lib_status_t optiga_ipc_server_init(void)
+{
+    optiga_lib_status_t return_status = OPTIGA_IPC_ERROR;
+    uint8_t index;
+
+    do
+    {
+        for (index = 0; index < OPTIGA_IPC_WORKER_COUNT; index++)
+        {
+            optiga_ipc_workers[index].p_util = optiga_util_create(OPTIGA_INSTANCE_ID_0,
+                                                                  optiga_ipc_server_worker_callback,
+                                                                  &optiga_ipc_workers[index]);
+            optiga_ipc_workers[index].p_crypt = optiga_crypt_create(OPTIGA_INSTANCE_ID_0,
+                                                                    optiga_ipc_server_worker_callback,
+                                                                    &optiga_ipc_workers[index]);
+            if ((NULL == optiga_ipc_workers[index].p_util) || (NULL == optiga_ipc_workers[index].p_crypt))
+            {
+                break;
+            }
+        }
+        if (OPTIGA_IPC_WORKER_COUNT != index)
+        {
+            break;
+        }
+
+        if (pdPASS != xTaskCreate(optiga_ipc_server_task,
+                                  "optiga_ipc",
+                                  configMINIMAL_STACK_SIZE * 2,
+                                  NULL,
+                                  OPTIGA_IPC_SERVER_TASK_PRIORITY,
+                                  &optiga_ipc_server_task_handle))
+        {
+            break;
+        }
+
+        if (CY_IPC_PIPE_SUCCESS != Cy_IPC_Pipe_RegisterCallback(CY_IPC_EP_CYPIPE_ADDR,
+                                                                optiga_ipc_server_receive,
+                                                                OPTIGA_IPC_PIPE_CLIENT_ID))
+        {
+            break;
+        }
+        return_status = OPTIGA_IPC_SUCCESS;
+    } while (FALSE);
+
+    return (return_status);
+}
+
+/**
+* @}
+*/
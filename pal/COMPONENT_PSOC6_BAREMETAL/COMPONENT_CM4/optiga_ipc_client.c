@@ -0,0 +1,102 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_ipc_client.c
+*
+* \brief   This file implements the access of the CM4 applications to the crypto service on CM0+.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include "optiga_ipc.h"
+#include "cy_pdl.h"
+
+/*
+* Receives the completed requests of CM0+, invoked from the IPC interrupt
+*/
+static void optiga_ipc_client_receive(uint32_t * msg_ptr)
+{
+    optiga_ipc_request_t * p_request = (optiga_ipc_request_t *)msg_ptr;
+
+    if (NULL != p_request->callback)
+    {
+        p_request->callback(p_request->callback_ctx, p_request->status);
+    }
+}
+
+optiga_lib_status_t optiga_ipc_client_init(void)
+{
+    optiga_lib_status_t return_status = OPTIGA_IPC_ERROR;
+
+    if (CY_IPC_PIPE_SUCCESS == Cy_IPC_Pipe_RegisterCallback(CY_IPC_EP_CYPIPE_ADDR,
+                                                            optiga_ipc_client_receive,
+                                                            OPTIGA_IPC_PIPE_CLIENT_ID))
+    {
+        return_status = OPTIGA_IPC_SUCCESS;
+    }
+
+    return (return_status);
+}
+
+optiga_lib_status_t optiga_ipc_submit(optiga_ipc_request_t * p_request)
+{
+    optiga_lib_status_t return_status = OPTIGA_IPC_ERROR_INVALID_INPUT;
+    cy_en_ipc_pipe_status_t pipe_status;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == p_request)
+        {
+            break;
+        }
+#endif
+        p_request->pipe_header = _VAL2FLD(CY_IPC_PIPE_MSG_CLIENT, OPTIGA_IPC_PIPE_CLIENT_ID);
+        p_request->status = OPTIGA_IPC_BUSY;
+
+        // Only the pointer is passed, CM0+ accesses the request and the buffers in place
+        pipe_status = Cy_IPC_Pipe_SendMessage(CY_IPC_EP_CYPIPE_CM0_ADDR,
+                                              CY_IPC_EP_CYPIPE_CM4_ADDR,
+                                              (void *)p_request,
+                                              NULL);
+        if (CY_IPC_PIPE_ERROR_SEND_BUSY == pipe_status)
+        {
+            return_status = OPTIGA_IPC_BUSY;
+            break;
+        }
+        return_status = (CY_IPC_PIPE_SUCCESS == pipe_status) ? OPTIGA_IPC_SUCCESS : OPTIGA_IPC_ERROR;
+    } while (FALSE);
+
+    return (return_status);
+}
+
+/**
+* @}
+*/
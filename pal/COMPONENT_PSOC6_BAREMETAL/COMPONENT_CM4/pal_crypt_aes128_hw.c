@@ -0,0 +1,123 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2021 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+*
+* \file pal_crypt_aes128_hw.c
+*
+* \brief   This file implements the platform abstraction layer APIs for the AES hardware accelerator (Crypto block).
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include "optiga/common/optiga_lib_common.h"
+#include "optiga/pal/pal_crypt.h"
+#include "optiga/pal/pal_os_memory.h"
+#include "cy_pdl.h"
+
+#ifdef OPTIGA_PAL_CRYPT_HW_AES_ENABLED
+
+/* Key context of the Crypto block */
+typedef struct pal_crypt_aes128_hw_context
+{
+    cy_stc_crypto_aes_state_t aes_state;
+    cy_stc_crypto_aes_buffers_t aes_buffers;
+}pal_crypt_aes128_hw_context_t;
+
+pal_status_t pal_crypt_aes128_hw_set_key(void ** pp_key_context, const uint8_t * p_key)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    pal_crypt_aes128_hw_context_t * p_context = (pal_crypt_aes128_hw_context_t *)(*pp_key_context);
+
+    do
+    {
+        if (NULL == p_context)
+        {
+            if (CY_CRYPTO_SUCCESS != Cy_Crypto_Core_Enable(CRYPTO))
+            {
+                break;
+            }
+            p_context = (pal_crypt_aes128_hw_context_t *)pal_os_calloc(1, sizeof(pal_crypt_aes128_hw_context_t));
+            if (NULL == p_context)
+            {
+                break;
+            }
+            *pp_key_context = p_context;
+        }
+        else
+        {
+            //lint --e{534} suppress "The key is replaced, return value is not required to be checked"
+            Cy_Crypto_Core_Aes_Free(CRYPTO, &p_context->aes_state);
+        }
+        // The key is copied into the buffers of the key context, which are used by the Crypto block
+        if (CY_CRYPTO_SUCCESS != Cy_Crypto_Core_Aes_Init(CRYPTO,
+                                                         p_key,
+                                                         CY_CRYPTO_KEY_AES_128,
+                                                         &p_context->aes_state,
+                                                         &p_context->aes_buffers))
+        {
+            break;
+        }
+        return_status = PAL_STATUS_SUCCESS;
+    } while (FALSE);
+    return (return_status);
+}
+
+pal_status_t pal_crypt_aes128_hw_encrypt_block(void * p_key_context,
+                                               const uint8_t * p_input,
+                                               uint8_t * p_output)
+{
+    pal_crypt_aes128_hw_context_t * p_context = (pal_crypt_aes128_hw_context_t *)p_key_context;
+
+    return ((CY_CRYPTO_SUCCESS == Cy_Crypto_Core_Aes_Ecb(CRYPTO,
+                                                         CY_CRYPTO_ENCRYPT,
+                                                         p_output,
+                                                         p_input,
+                                                         &p_context->aes_state)) ? PAL_STATUS_SUCCESS :
+                                                                                   PAL_STATUS_FAILURE);
+}
+
+void pal_crypt_aes128_hw_release_key(void * p_key_context)
+{
+    pal_crypt_aes128_hw_context_t * p_context = (pal_crypt_aes128_hw_context_t *)p_key_context;
+
+    if (NULL != p_context)
+    {
+        //lint --e{534} suppress "The key context is freed, return value is not required to be checked"
+        Cy_Crypto_Core_Aes_Free(CRYPTO, &p_context->aes_state);
+        pal_os_memset(p_context, 0, sizeof(pal_crypt_aes128_hw_context_t));
+        pal_os_free(p_context);
+    }
+}
+
+#endif //OPTIGA_PAL_CRYPT_HW_AES_ENABLED
+
+/**
+* @}
+*/
@@ -42,6 +42,33 @@
 #include "optiga/pal/pal_ifx_i2c_config.h"
 #include "pal_psoc6_config.h"
 
+#ifdef OPTIGA_COMMS_DATA_READY_IRQ_ENABLED
+/// @cond hidden
+/* Handler and context registered for the data ready interrupt */
+static pal_gpio_irq_handler_t pal_gpio_irq_handler = NULL;
+static void * pal_gpio_irq_context = NULL;
+
+/* Invoked in interrupt context by the GPIO driver, the interrupt also wakes up the CPU from deep sleep */
+static void pal_gpio_irq_callback(void * callback_arg, cyhal_gpio_event_t event)
+{
+    pal_gpio_irq_handler_t handler = pal_gpio_irq_handler;
+
+    (void)callback_arg;
+    (void)event;
+    if (NULL != handler)
+    {
+        handler(pal_gpio_irq_context);
+    }
+}
+
+static cyhal_gpio_callback_data_t pal_gpio_irq_callback_data =
+{
+    .callback = pal_gpio_irq_callback,
+    .callback_arg = NULL
+};
+/// @endcond
+#endif
+
 pal_status_t pal_gpio_init(const pal_gpio_t * p_gpio_context)
 {
     pal_status_t return_status = PAL_STATUS_FAILURE;
@@ -72,6 +99,50 @@ pal_status_t pal_gpio_deinit(const pal_gpio_t * p_gpio_context)
     return PAL_STATUS_SUCCESS;
 }
 
+#ifdef OPTIGA_COMMS_DATA_READY_IRQ_ENABLED
+pal_status_t pal_gpio_register_irq(const pal_gpio_t * p_gpio_context,
+                                   pal_gpio_irq_handler_t handler,
+                                   void * p_context)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    cyhal_gpio_t pin;
+
+    do
+    {
+        if ((p_gpio_context == NULL) || (p_gpio_context->p_gpio_hw == NULL) ||
+            (NC == (cyhal_gpio_t)((pal_gpio_itf_t *)p_gpio_context->p_gpio_hw)->pin))
+        {
+            // No pin connected, hence the status register is polled
+            break;
+        }
+        pin = (cyhal_gpio_t)((pal_gpio_itf_t *)p_gpio_context->p_gpio_hw)->pin;
+        if (NULL != pal_gpio_irq_handler)
+        {
+            /* The previous handler is removed */
+            cyhal_gpio_enable_event(pin, CYHAL_GPIO_IRQ_RISE, PAL_GPIO_IRQ_PRIO, false);
+            cyhal_gpio_free(pin);
+            pal_gpio_irq_handler = NULL;
+        }
+        if (NULL == handler)
+        {
+            return_status = PAL_STATUS_SUCCESS;
+            break;
+        }
+        if (CY_RSLT_SUCCESS != cyhal_gpio_init(pin, CYHAL_GPIO_DIR_INPUT, CYHAL_GPIO_DRIVE_NONE, false))
+        {
+            break;
+        }
+        pal_gpio_irq_context = p_context;
+        pal_gpio_irq_handler = handler;
+        cyhal_gpio_register_callback(pin, &pal_gpio_irq_callback_data);
+        cyhal_gpio_enable_event(pin, CYHAL_GPIO_IRQ_RISE, PAL_GPIO_IRQ_PRIO, true);
+        return_status = PAL_STATUS_SUCCESS;
+    } while (false);
+
+    return return_status;
+}
+#endif
+
 void pal_gpio_set_high(const pal_gpio_t * p_gpio_context)
 {
     if ((p_gpio_context != NULL) && (p_gpio_context->p_gpio_hw != NULL))
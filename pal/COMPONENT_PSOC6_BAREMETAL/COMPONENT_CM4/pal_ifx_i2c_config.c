@@ -73,6 +73,15 @@ pal_gpio_itf_t reset_config =
     .init_state = true
 };
 
+#ifdef OPTIGA_COMMS_DATA_READY_IRQ_ENABLED
+/* PSoC6 specific gpio config data for the data ready interrupt */
+pal_gpio_itf_t irq_config = 
+{
+    .pin = PIN_IRQ,
+    .init_state = false
+};
+#endif
+
 /**
  * \brief PAL I2C configuration for OPTIGA. 
  */
@@ -106,6 +115,17 @@ pal_gpio_t optiga_reset_0 =
     .p_gpio_hw = ((void*)&reset_config)
 };
 
+#ifdef OPTIGA_COMMS_DATA_READY_IRQ_ENABLED
+/**
+ * \brief PAL data ready interrupt pin configuration for OPTIGA.
+ */
+pal_gpio_t optiga_irq_0 =
+{
+    // Platform specific GPIO context for the pin signaling the data ready state, also a wakeup source of deep sleep.
+    .p_gpio_hw = ((void*)&irq_config)
+};
+#endif
+
 /**
 * @}
 */
@@ -36,10 +36,12 @@
 */
 
 #include "optiga/pal/pal_os_event.h"
+#include "optiga/pal/pal_os_timer.h"
 #include "optiga/pal/pal.h"
 #include "cy_pdl.h"
 #include "cyhal.h"
 #include "cybsp.h"
+#include "pal_psoc6_config.h"
 
 
 /// @cond hidden
@@ -51,6 +53,124 @@ static pal_os_event_t pal_os_event_0 = {0};
 /* Timer object used */
 cyhal_timer_t pal_os_event_timer_obj;
 
+#ifdef PAL_OS_EVENT_DEEPSLEEP_ENABLED
+/* Frequency of the LPTimer, clocked by the low frequency clock */
+#define PAL_OS_EVENT_LPTIMER_FREQUENCY_HZ   (32768U)
+
+extern void pal_os_timer_add_deep_sleep_time(uint32_t time_us);
+
+/* LPTimer waking up the CPU from deep sleep ahead of the next event */
+static cyhal_lptimer_t pal_os_event_lptimer_obj;
+/* Time stamp in microseconds, at which the registered callback is due */
+static uint32_t pal_os_event_deadline_us;
+/* TRUE while a callback is registered and not yet invoked */
+static volatile bool_t pal_os_event_armed = FALSE;
+/* LPTimer count at the transition to deep sleep */
+static uint32_t pal_os_event_deepsleep_start_count;
+
+/* Provides the time until the registered callback is due, 0 if it is overdue */
+static uint32_t pal_os_event_get_remaining_time(void)
+{
+    int32_t remaining_us = (int32_t)(pal_os_event_deadline_us - pal_os_timer_get_time_in_microseconds());
+
+    return ((remaining_us > 0) ? (uint32_t)remaining_us : 0U);
+}
+#endif
+
+static void pal_os_event_timer_start(uint32_t time_us)
+{
+  cyhal_timer_cfg_t timer_cfg =
+    {
+        .compare_value = 0,                       /* Timer compare value, not used */
+        .period = time_us * CYHAL_TIMER_SCALING,  /* Defines the timer period */
+        .direction = CYHAL_TIMER_DIR_UP,          /* Timer counts up */
+        .is_compare = false,                      /* Don't use compare mode */
+        .is_continuous = false,                   /* Run the timer indefinitely */
+        .value = 0                                /* Initial value of counter */
+    };
+
+    // !!!OPTIGA_LIB_PORTING_REQUIRED
+    // The following steps related to TIMER must be taken care while porting to different platform
+    //lint --e{534} suppress "Error handling is not required so return value is not checked"
+    cyhal_timer_configure(&pal_os_event_timer_obj, &timer_cfg);
+    cyhal_timer_start(&pal_os_event_timer_obj);
+}
+
+#ifdef PAL_OS_EVENT_DEEPSLEEP_ENABLED
+/*
+ * Invoked by the system power management around deep sleep of the CPU.
+ * - Deep sleep is refused if the next event is due too soon, the CPU then enters sleep.
+ * - The LPTimer is programmed to wake up the CPU ahead of the next event. Without a registered callback, the CPU is
+ *   woken up by the data ready pin or the application. An ongoing I2C transfer is guarded by the driver of the SCB.
+ * - The TCPWM timers do not count in deep sleep. The slept time is added to the time base and the event timer is
+ *   started again for the time remaining after the wakeup, so that the callback is invoked at the same time.
+ */
+static bool pal_os_event_syspm_callback(cyhal_syspm_callback_state_t state,
+                                        cyhal_syspm_callback_mode_t mode,
+                                        void * callback_arg)
+{
+    bool allow_transition = true;
+    uint32_t remaining_us;
+    uint32_t slept_ticks;
+
+    (void)state;
+    (void)callback_arg;
+    switch (mode)
+    {
+        case CYHAL_SYSPM_CHECK_READY:
+        {
+            if (FALSE == pal_os_event_armed)
+            {
+                break;
+            }
+            remaining_us = pal_os_event_get_remaining_time();
+            if (remaining_us < PAL_OS_EVENT_DEEPSLEEP_MIN_TIME_US)
+            {
+                allow_transition = false;
+                break;
+            }
+            remaining_us -= PAL_OS_EVENT_DEEPSLEEP_WAKEUP_TIME_US;
+            //lint --e{534} suppress "A failure only results in a late wakeup by the event timer"
+            cyhal_lptimer_set_delay(&pal_os_event_lptimer_obj,
+                                    (uint32_t)(((uint64_t)remaining_us * PAL_OS_EVENT_LPTIMER_FREQUENCY_HZ) / 1000000U));
+            break;
+        }
+        case CYHAL_SYSPM_BEFORE_TRANSITION:
+        {
+            pal_os_event_deepsleep_start_count = cyhal_lptimer_read(&pal_os_event_lptimer_obj);
+            break;
+        }
+        case CYHAL_SYSPM_AFTER_TRANSITION:
+        {
+            slept_ticks = cyhal_lptimer_read(&pal_os_event_lptimer_obj) - pal_os_event_deepsleep_start_count;
+            pal_os_timer_add_deep_sleep_time(
+                (uint32_t)(((uint64_t)slept_ticks * 1000000U) / PAL_OS_EVENT_LPTIMER_FREQUENCY_HZ));
+            if (TRUE == pal_os_event_armed)
+            {
+                remaining_us = pal_os_event_get_remaining_time();
+                cyhal_timer_stop(&pal_os_event_timer_obj);
+                pal_os_event_timer_start((0U != remaining_us) ? remaining_us : 1U);
+            }
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+    return allow_transition;
+}
+
+static cyhal_syspm_callback_data_t pal_os_event_syspm_callback_data =
+{
+    .callback = pal_os_event_syspm_callback,
+    .states = CYHAL_SYSPM_CB_CPU_DEEPSLEEP,
+    .ignore_modes = (cyhal_syspm_callback_mode_t)0,
+    .args = NULL,
+    .next = NULL
+};
+#endif
+
 void pal_os_event_start(pal_os_event_t * p_pal_os_event, register_callback callback, void * callback_args)
 {
     if (FALSE == p_pal_os_event->is_event_triggered)
@@ -85,6 +205,9 @@ void pal_os_event_trigger_registered_callback(void)
     // The following steps related to TIMER must be taken care while porting to different platform
     cyhal_timer_stop(&pal_os_event_timer_obj);
     cyhal_timer_reset(&pal_os_event_timer_obj);
+#ifdef PAL_OS_EVENT_DEEPSLEEP_ENABLED
+    pal_os_event_armed = FALSE;
+#endif
     /// If callback_ctx is NULL then callback function will have unexpected behavior 
     if (pal_os_event_0.callback_registered)
     {
@@ -99,29 +222,24 @@ void pal_os_event_register_callback_oneshot(pal_os_event_t * p_pal_os_event,
                                              void * callback_args,
                                              uint32_t time_us)
 {
-  cyhal_timer_cfg_t timer_cfg =
-    {
-        .compare_value = 0,                       /* Timer compare value, not used */
-        .period = time_us * CYHAL_TIMER_SCALING,  /* Defines the timer period */
-        .direction = CYHAL_TIMER_DIR_UP,          /* Timer counts up */
-        .is_compare = false,                      /* Don't use compare mode */
-        .is_continuous = false,                   /* Run the timer indefinitely */
-        .value = 0                                /* Initial value of counter */
-    };
     p_pal_os_event->callback_registered = callback;
     p_pal_os_event->callback_ctx = callback_args;
-
-    // !!!OPTIGA_LIB_PORTING_REQUIRED
-    // The following steps related to TIMER must be taken care while porting to different platform
-    //lint --e{534} suppress "Error handling is not required so return value is not checked"
-    cyhal_timer_configure(&pal_os_event_timer_obj, &timer_cfg);
-    cyhal_timer_start(&pal_os_event_timer_obj);
+#ifdef PAL_OS_EVENT_DEEPSLEEP_ENABLED
+    pal_os_event_deadline_us = pal_os_timer_get_time_in_microseconds() + time_us;
+    pal_os_event_armed = TRUE;
+#endif
+    pal_os_event_timer_start(time_us);
 }
 
 //lint --e{818,715} suppress "As there is no implementation, pal_os_event is not used"
 void pal_os_event_destroy(pal_os_event_t * pal_os_event)
 {
     cyhal_timer_free (&pal_os_event_timer_obj);
+#ifdef PAL_OS_EVENT_DEEPSLEEP_ENABLED
+    pal_os_event_armed = FALSE;
+    cyhal_syspm_unregister_callback(&pal_os_event_syspm_callback_data);
+    cyhal_lptimer_free(&pal_os_event_lptimer_obj);
+#endif
 }
 
 void pal_os_event_init(void)
@@ -165,6 +283,16 @@ void pal_os_event_init(void)
         /* Set the event on which timer interrupt occurs and enable it */
         cyhal_timer_enable_event(&pal_os_event_timer_obj, CYHAL_TIMER_IRQ_ALL, PAL_OS_EVENT_INTR_PRIO, true);
 
+#ifdef PAL_OS_EVENT_DEEPSLEEP_ENABLED
+        /* The LPTimer keeps running in deep sleep, its compare match interrupt only wakes up the CPU */
+        cy_hal_status = cyhal_lptimer_init(&pal_os_event_lptimer_obj);
+        if(CY_RSLT_SUCCESS != cy_hal_status)
+        {
+          break;
+        }
+        cyhal_lptimer_enable_event(&pal_os_event_lptimer_obj, CYHAL_LPTIMER_COMPARE_MATCH, PAL_OS_EVENT_INTR_PRIO, true);
+        cyhal_syspm_register_callback(&pal_os_event_syspm_callback_data);
+#endif
     } while (false);
 }
 
@@ -49,6 +49,11 @@
 /* struct for storing total time elapsed since the timer was started */
 static uint32_t seconds_count;
 
+/* Time spent in deep sleep, during which the timer does not count */
+static uint32_t deep_sleep_time_us;
+static uint32_t deep_sleep_time_ms;
+static uint32_t deep_sleep_remainder_us;
+
 /* Timer object used for accessing the timer */
 static cyhal_timer_t timer_obj;
 /* Timer configurtion parameters */
@@ -71,7 +76,8 @@ static void isr_timer(void *callback_arg, cyhal_timer_event_t event);
 uint32_t pal_os_timer_get_time_in_microseconds(void)
 {
     /* Convert the total timer tick value to microseconds */
-    uint32_t time_in_microseconds = (cyhal_timer_read((cyhal_timer_t *) &timer_obj) + (seconds_count * 1000000));
+    uint32_t time_in_microseconds = (cyhal_timer_read((cyhal_timer_t *) &timer_obj) + (seconds_count * 1000000) +
+                                     deep_sleep_time_us);
     
     return (time_in_microseconds);
 }
@@ -79,7 +85,8 @@ uint32_t pal_os_timer_get_time_in_microseconds(void)
 uint32_t pal_os_timer_get_time_in_milliseconds(void)
 {
     /* Convert the total timer tick value to milliseconds */
-    uint32_t time_in_milliseconds = (((uint32_t) (cyhal_timer_read((cyhal_timer_t *) &timer_obj) / 1000)) + (seconds_count * 1000));
+    uint32_t time_in_milliseconds = (((uint32_t) (cyhal_timer_read((cyhal_timer_t *) &timer_obj) / 1000)) + (seconds_count * 1000) +
+                                     deep_sleep_time_ms);
 
     return (time_in_milliseconds);
 }
@@ -105,6 +112,15 @@ void pal_os_timer_delay_in_milliseconds(uint16_t milliseconds)
     cyhal_system_delay_ms (milliseconds);
 }
 
+/* Invoked after the wakeup from deep sleep with the time measured by the LPTimer */
+void pal_os_timer_add_deep_sleep_time(uint32_t time_us)
+{
+    deep_sleep_time_us += time_us;
+    deep_sleep_remainder_us += time_us;
+    deep_sleep_time_ms += deep_sleep_remainder_us / 1000U;
+    deep_sleep_remainder_us %= 1000U;
+}
+
 pal_status_t pal_timer_init(void)
 {
     pal_status_t return_status = PAL_STATUS_FAILURE;
@@ -0,0 +1,100 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_os_wait.c
+*
+* \brief   This file implements the platform abstraction layer APIs for os wait object (signaled state and WFI).
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include "optiga/pal/pal_os_wait.h"
+#include "optiga/pal/pal_os_lock.h"
+#include "cy_pdl.h"
+#include "cyhal.h"
+#include "pal_psoc6_config.h"
+
+pal_status_t pal_os_wait_create(pal_os_wait_t * p_wait)
+{
+    p_wait->os_wait_object = NULL;
+    p_wait->is_signaled = FALSE;
+    return PAL_STATUS_SUCCESS;
+}
+
+//lint --e{715} suppress "p_wait is not used here as there is no wait object to be freed."
+//lint --e{818} suppress "Not declared as pointer as nothing needs to be updated in the pointer."
+void pal_os_wait_destroy(pal_os_wait_t * p_wait)
+{
+
+}
+
+void pal_os_wait_for_signal(pal_os_wait_t * p_wait)
+{
+    // The OPTIGA events are executed from timer interrupt, which wakes up the core
+    while (FALSE == p_wait->is_signaled)
+    {
+#ifdef PAL_OS_EVENT_DEEPSLEEP_ENABLED
+        // Deep sleep is refused while the next event is due soon or an I2C transfer is ongoing
+        if (CY_RSLT_SUCCESS != cyhal_syspm_deepsleep())
+        {
+            (void)cyhal_syspm_sleep();
+        }
+#else
+        __WFI();
+#endif
+    }
+    p_wait->is_signaled = FALSE;
+}
+
+void pal_os_wait_signal(pal_os_wait_t * p_wait)
+{
+    p_wait->is_signaled = TRUE;
+}
+
+bool_t pal_os_wait_clear_signal(pal_os_wait_t * p_wait)
+{
+    bool_t was_signaled;
+
+    pal_os_lock_enter_critical_section();
+    was_signaled = (uint8_t)p_wait->is_signaled;
+    p_wait->is_signaled = FALSE;
+    pal_os_lock_exit_critical_section();
+    return was_signaled;
+}
+
+//lint --e{715} suppress "p_wait is not used here as there is no pollable descriptor."
+int32_t pal_os_wait_get_descriptor(const pal_os_wait_t * p_wait)
+{
+    return (-1);
+}
+
+/**
+* @}
+*/
@@ -49,6 +49,18 @@ extern "C" {
 #define PIN_VDD 	(P6_5)
 #define PIN_RESET 	(P9_0)
 
+/* Pin used for the data ready interrupt (OPTIGA_COMMS_DATA_READY_IRQ_ENABLED), NC if it is not connected */
+#define PIN_IRQ     (NC)
+/* Priority of the data ready interrupt */
+#define PAL_GPIO_IRQ_PRIO   (4U)
+
+/* Puts the CPU into deep sleep while waiting for the OPTIGA events, woken up by the LPTimer or the data ready pin */
+#define PAL_OS_EVENT_DEEPSLEEP_ENABLED
+/* Shortest time in microseconds until the next event, for which deep sleep is entered instead of sleep */
+#define PAL_OS_EVENT_DEEPSLEEP_MIN_TIME_US      (2000U)
+/* Time in microseconds the LPTimer wakes up ahead of the event, covering the wakeup from deep sleep */
+#define PAL_OS_EVENT_DEEPSLEEP_WAKEUP_TIME_US   (500U)
+
 /* GPIO interface data */
 typedef struct pal_gpio_itf
 {
@@ -0,0 +1,195 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_ipc.h
+*
+* \brief   This file defines the IPC interface between the OPTIGA host library on CM0+ (crypto service)
+*          and the applications on CM4 of PSoC6.
+*
+* \details
+* In the dual core configuration, the host library (comms stack, command scheduler, util and crypt) and the
+* COMPONENT_CM0P PAL are built for CM0+ only. The CM0+ application invokes #optiga_ipc_server_init after
+* #pal_init. CM4 links only optiga_ipc_client.c and submits the requests using #optiga_ipc_submit.
+* - The request is passed as a pointer through the IPC pipe. The buffers referred by the arguments remain in the
+*   memory of the application (zero-copy), hence the request and the buffers must be valid until the callback.
+* - CM4 does not run any part of the OPTIGA protocol, neither the I2C link nor the polling of the status.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#ifndef _OPTIGA_IPC_H_
+#define _OPTIGA_IPC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "optiga/common/optiga_lib_common.h"
+
+/// Client ID of the IPC pipe, used for the OPTIGA requests and responses
+#ifndef OPTIGA_IPC_PIPE_CLIENT_ID
+#define OPTIGA_IPC_PIPE_CLIENT_ID                   (0x05U)
+#endif
+/// Number of requests, which are executed concurrently on CM0+ (one util and one crypt instance each)
+#ifndef OPTIGA_IPC_WORKER_COUNT
+#define OPTIGA_IPC_WORKER_COUNT                     (0x02U)
+#endif
+/// Number of requests, which are queued on CM0+ while all the workers are busy
+#ifndef OPTIGA_IPC_QUEUE_SIZE
+#define OPTIGA_IPC_QUEUE_SIZE                       (0x08U)
+#endif
+/// Maximum number of arguments of a service
+#define OPTIGA_IPC_MAX_ARGS                         (0x06U)
+
+/// IPC API execution is successful
+#define OPTIGA_IPC_SUCCESS                          (0x0000)
+/// IPC pipe is busy
+#define OPTIGA_IPC_BUSY                             (0x0001)
+/// IPC API execution failed
+#define OPTIGA_IPC_ERROR                            (0x0C02)
+/// IPC API execution with wrong input arguments provided
+#define OPTIGA_IPC_ERROR_INVALID_INPUT              (0x0C03)
+/// Request could not be queued, since the queue on CM0+ is full
+#define OPTIGA_IPC_ERROR_QUEUE_FULL                 (0x0C04)
+/// Requested service is not supported by the server
+#define OPTIGA_IPC_ERROR_SERVICE                    (0x0C05)
+
+/**
+ * \brief Services of the crypto core. The arguments are listed in the order of the args of #optiga_ipc_request_t,
+ *        the same as the parameters of the API (without the instance).
+ */
+typedef enum optiga_ipc_service
+{
+    /// #optiga_util_open_application: perform_restore
+    OPTIGA_IPC_UTIL_OPEN_APPLICATION = 0x01,
+    /// #optiga_util_close_application: perform_hibernate
+    OPTIGA_IPC_UTIL_CLOSE_APPLICATION,
+    /// #optiga_util_read_data: optiga_oid, offset, buffer, length
+    OPTIGA_IPC_UTIL_READ_DATA,
+    /// #optiga_util_read_metadata: optiga_oid, buffer, length
+    OPTIGA_IPC_UTIL_READ_METADATA,
+    /// #optiga_util_write_data: optiga_oid, write_type, offset, buffer, length
+    OPTIGA_IPC_UTIL_WRITE_DATA,
+    /// #optiga_crypt_random: rng_type, random_data, random_data_length
+    OPTIGA_IPC_CRYPT_RANDOM,
+    /// #optiga_crypt_hash: hash_algorithm, source_of_data_to_hash, data_to_hash, hash_output
+    OPTIGA_IPC_CRYPT_HASH,
+    /// #optiga_crypt_ecc_generate_keypair: curve_id, key_usage, export_private_key, private_key, public_key, public_key_length
+    OPTIGA_IPC_CRYPT_ECC_GENERATE_KEYPAIR,
+    /// #optiga_crypt_ecdsa_sign: digest, digest_length, private_key, signature, signature_length
+    OPTIGA_IPC_CRYPT_ECDSA_SIGN,
+    /// #optiga_crypt_ecdsa_verify: digest, digest_length, signature, signature_length, public_key_source_type, public_key
+    OPTIGA_IPC_CRYPT_ECDSA_VERIFY,
+    /// #optiga_crypt_ecdh: private_key, public_key, export_to_host, shared_secret
+    OPTIGA_IPC_CRYPT_ECDH
+}optiga_ipc_service_t;
+
+/** \brief Request to the crypto core, passed through the IPC pipe by pointer */
+typedef struct optiga_ipc_request
+{
+    /// Client ID of the IPC pipe message, must be the first member
+    uint32_t pipe_header;
+    /// Service to be invoked, value of #optiga_ipc_service_t
+    uint32_t service;
+    /// Arguments of the service, pointers refer to the buffers of the application
+    uintptr_t args[OPTIGA_IPC_MAX_ARGS];
+    /// Status of the request, return value of the API if it fails, else the event of the API callback
+    volatile optiga_lib_status_t status;
+    /// Callback of the application, invoked on CM4 on completion of the request
+    callback_handler_t callback;
+    /// Context of the application, provided to the callback
+    void * callback_ctx;
+}optiga_ipc_request_t;
+
+/**
+ * \brief Initializes the crypto service on CM0+.
+ *
+ * \details
+ * Creates the util and crypt instances of the workers, the server task and registers the IPC pipe callback.
+ *
+ * \pre
+ * - The PAL must be initialized using #pal_init and the IPC pipe must be started (Cy_IPC_Pipe_Init).
+ *
+ * \note
+ * - Invoked on CM0+ only. The application on OPTIGA is opened by the request #OPTIGA_IPC_UTIL_OPEN_APPLICATION.
+ *
+ * \retval         #OPTIGA_IPC_SUCCESS                      Successful invocation.
+ * \retval         #OPTIGA_IPC_ERROR                        Creation of the instances, task or pipe callback failed.
+ */
+optiga_lib_status_t optiga_ipc_server_init(void);
+
+/**
+ * \brief Initializes the access to the crypto service on CM4.
+ *
+ * \details
+ * Registers the IPC pipe callback, which invokes the callbacks of the completed requests.
+ *
+ * \pre
+ * - The IPC pipe must be started (Cy_IPC_Pipe_Init).
+ *
+ * \note
+ * - Invoked on CM4 only.
+ *
+ * \retval         #OPTIGA_IPC_SUCCESS                      Successful invocation.
+ * \retval         #OPTIGA_IPC_ERROR                        Registration of the pipe callback failed.
+ */
+optiga_lib_status_t optiga_ipc_client_init(void);
+
+/**
+ * \brief Submits a request to the crypto service.
+ *
+ * \details
+ * Submits the request to CM0+, which executes it with the host library and responds through the IPC pipe.
+ * - The callback of the request is invoked with the status of the request, from the IPC interrupt of CM4.
+ *
+ * \pre
+ * - The access to the crypto service must be initialized using #optiga_ipc_client_init.
+ *
+ * \note
+ * - This API is asynchronous. The request and the buffers referred by the arguments must be valid until the callback.
+ * - If the queue of CM0+ is full, the callback is invoked with #OPTIGA_IPC_ERROR_QUEUE_FULL.
+ *
+ * \param[in,out]  p_request                                Request with service, args and callback set, must not be NULL.
+ *
+ * \retval         #OPTIGA_IPC_SUCCESS                      Request is submitted.
+ * \retval         #OPTIGA_IPC_BUSY                         IPC pipe is busy, the request is not submitted.
+ * \retval         #OPTIGA_IPC_ERROR_INVALID_INPUT          Wrong input arguments provided.
+ */
+optiga_lib_status_t optiga_ipc_submit(optiga_ipc_request_t * p_request);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_OPTIGA_IPC_H_*/
+
+/**
+* @}
+*/
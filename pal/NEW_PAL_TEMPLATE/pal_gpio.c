@@ -57,6 +57,22 @@ pal_status_t pal_gpio_deinit(const pal_gpio_t * p_gpio_context)
     return PAL_STATUS_SUCCESS;
 }
 
+pal_status_t pal_gpio_register_irq(const pal_gpio_t * p_gpio_context,
+                                   pal_gpio_irq_handler_t handler,
+                                   void * p_context)
+{
+    pal_status_t status = PAL_STATUS_FAILURE;
+
+    if ((p_gpio_context != NULL) && (p_gpio_context->p_gpio_hw != NULL))
+    {
+        // !!!OPTIGA_LIB_PORTING_REQUIRED
+        // Your function to set the pin as input and enable the edge interrupt,
+        // which invokes handler(p_context). Disable the interrupt, if handler is NULL.
+        // Return PAL_STATUS_FAILURE, if the interrupt is not supported.
+    }
+    return status;
+}
+
 void pal_gpio_set_high(const pal_gpio_t * p_gpio_context)
 {
     if ((p_gpio_context != NULL) && (p_gpio_context->p_gpio_hw != NULL))
@@ -87,6 +87,17 @@ pal_gpio_t optiga_reset_0 =
     (void*)&reset_pin
 };
 
+/**
+ * \brief PAL data ready interrupt pin configuration for OPTIGA (OPTIGA_COMMS_DATA_READY_IRQ_ENABLED).
+ */
+pal_gpio_t optiga_irq_0 =
+{
+    // !!!OPTIGA_LIB_PORTING_REQUIRED
+    // Platform specific GPIO context for the pin used for the data ready interrupt.
+    // Use NULL, if no such pin is available
+    NULL
+};
+
 /**
 * @}
 */
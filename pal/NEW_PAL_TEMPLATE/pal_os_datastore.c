@@ -35,6 +35,7 @@
 * @{
 */
 
+#include "optiga/common/optiga_lib_common.h"
 #include "optiga/pal/pal_os_datastore.h"
 /// @cond hidden
 
@@ -42,6 +43,12 @@
 #define LENGTH_SIZE                (0x02)
 /// Size of data store buffer to hold the shielded connection manage context information (2 bytes length field + 64(0x40) bytes context)
 #define MANAGE_CONTEXT_BUFFER_SIZE      (0x42)
+/// Size of data store buffer to hold the communication link state for the warm reattach
+#define LINK_STATE_BUFFER_SIZE          (0x48)
+/// Size of data store buffer to hold the pending increments of the counter data objects
+#define PENDING_COUNT_BUFFER_SIZE       (0x08)
+/// Size of data store buffer to hold the slave addresses assigned by the bus enumeration
+#define BUS_MAP_BUFFER_SIZE             (0x03)
 
 //Internal buffer to store the shielded connection manage context information (length field + Data)
 uint8_t data_store_manage_context_buffer [LENGTH_SIZE + MANAGE_CONTEXT_BUFFER_SIZE];
@@ -49,6 +56,15 @@ uint8_t data_store_manage_context_buffer [LENGTH_SIZE + MANAGE_CONTEXT_BUFFER_SI
 //Internal buffer to store the optiga application context data during hibernate(length field + Data)
 uint8_t data_store_app_context_buffer [LENGTH_SIZE + APP_CONTEXT_SIZE];
 
+//Internal buffer to store the communication link state for the warm reattach (length field + Data)
+uint8_t data_store_link_state_buffer [LENGTH_SIZE + LINK_STATE_BUFFER_SIZE];
+
+//Internal buffer to store the pending increments of the counter data objects (length field + Data)
+uint8_t data_store_pending_count_buffer [LENGTH_SIZE + PENDING_COUNT_BUFFER_SIZE];
+
+//Internal buffer to store the slave addresses assigned by the bus enumeration (length field + Data)
+uint8_t data_store_bus_map_buffer [LENGTH_SIZE + BUS_MAP_BUFFER_SIZE];
+
 //Internal buffer to store the generated platform binding shared secret on Host (length field + shared secret)
 uint8_t optiga_platform_binding_shared_secret [LENGTH_SIZE + OPTIGA_SHARED_SECRET_MAX_LENGTH] = 
 {
@@ -62,6 +78,29 @@ uint8_t optiga_platform_binding_shared_secret [LENGTH_SIZE + OPTIGA_SHARED_SECRE
     0x31 ,0x32 ,0x33 ,0x34 ,0x35 ,0x36 ,0x37 ,0x38 ,0x39 ,0x3A ,0x3B ,0x3C ,0x3D ,0x3E ,0x3F ,0x40
 };
 
+#ifdef OPTIGA_PAL_DATASTORE_LOG_ENABLED
+// !!!OPTIGA_LIB_PORTING_REQUIRED
+// The flash area of the datastore log (pal_os_datastore_log.c) consists of OPTIGA_PAL_DATASTORE_LOG_SECTOR_COUNT
+// sectors of OPTIGA_PAL_DATASTORE_LOG_SECTOR_SIZE bytes, reserved for it in the flash of the platform.
+pal_status_t pal_os_datastore_flash_erase(uint8_t sector)
+{
+    // Erase the sector with the flash driver of the platform
+    return PAL_STATUS_FAILURE;
+}
+
+pal_status_t pal_os_datastore_flash_program(uint8_t sector, uint16_t offset, const uint8_t * p_data, uint16_t length)
+{
+    // Program the data with the flash driver of the platform, in units of OPTIGA_PAL_DATASTORE_LOG_PROGRAM_UNIT
+    return PAL_STATUS_FAILURE;
+}
+
+pal_status_t pal_os_datastore_flash_read(uint8_t sector, uint16_t offset, uint8_t * p_data, uint16_t length)
+{
+    // Read the data with the flash driver of the platform (e.g. copy from the memory mapped flash)
+    return PAL_STATUS_FAILURE;
+}
+#endif
+
 
 pal_status_t pal_os_datastore_write(uint16_t datastore_id,
                                     const uint8_t * p_buffer,
@@ -70,6 +109,13 @@ pal_status_t pal_os_datastore_write(uint16_t datastore_id,
     pal_status_t return_status = PAL_STATUS_FAILURE;
     uint8_t offset = 0;
 
+#ifdef OPTIGA_PAL_DATASTORE_LOG_ENABLED
+    // The contexts saved on every hibernate are appended to the flash log
+    if ((OPTIGA_COMMS_MANAGE_CONTEXT_ID == datastore_id) || (OPTIGA_HIBERNATE_CONTEXT_ID == datastore_id))
+    {
+        return pal_os_datastore_log_write(datastore_id, p_buffer, length);
+    }
+#endif
     switch(datastore_id)
     {
         case OPTIGA_PLATFORM_BINDING_SHARED_SECRET_ID:
@@ -114,6 +160,50 @@ pal_status_t pal_os_datastore_write(uint16_t datastore_id,
             return_status = PAL_STATUS_SUCCESS;
             break;
         }
+        case OPTIGA_COMMS_LINK_STATE_ID:
+        {
+            // !!!OPTIGA_LIB_PORTING_REQUIRED
+            // This has to be enhanced by user only, the link state must be
+            // stored in memory, which persists across restarts of the host
+            // application (e.g. NVM or retained RAM).
+            if (length <= LINK_STATE_BUFFER_SIZE)
+            {
+                data_store_link_state_buffer[offset++] = (uint8_t)(length>>8);
+                data_store_link_state_buffer[offset++] = (uint8_t)(length);
+                memcpy(&data_store_link_state_buffer[offset],p_buffer,length);
+                return_status = PAL_STATUS_SUCCESS;
+            }
+            break;
+        }
+        case OPTIGA_UTIL_PENDING_COUNT_ID:
+        {
+            // !!!OPTIGA_LIB_PORTING_REQUIRED
+            // This has to be enhanced by user only, the pending increments must be
+            // stored in memory, which persists across resets of the host
+            // (e.g. NVM or retained RAM), otherwise they are lost on a reset.
+            if (length <= PENDING_COUNT_BUFFER_SIZE)
+            {
+                data_store_pending_count_buffer[offset++] = (uint8_t)(length>>8);
+                data_store_pending_count_buffer[offset++] = (uint8_t)(length);
+                memcpy(&data_store_pending_count_buffer[offset],p_buffer,length);
+                return_status = PAL_STATUS_SUCCESS;
+            }
+            break;
+        }
+        case OPTIGA_COMMS_BUS_MAP_ID:
+        {
+            // !!!OPTIGA_LIB_PORTING_REQUIRED
+            // This has to be enhanced by user only, the map must be stored in
+            // NVM, otherwise the devices are enumerated again on every boot.
+            if (length <= BUS_MAP_BUFFER_SIZE)
+            {
+                data_store_bus_map_buffer[offset++] = (uint8_t)(length>>8);
+                data_store_bus_map_buffer[offset++] = (uint8_t)(length);
+                memcpy(&data_store_bus_map_buffer[offset],p_buffer,length);
+                return_status = PAL_STATUS_SUCCESS;
+            }
+            break;
+        }
         default:
         {
             break;
@@ -131,6 +221,12 @@ pal_status_t pal_os_datastore_read(uint16_t datastore_id,
     uint16_t data_length;
     uint8_t offset = 0;
 
+#ifdef OPTIGA_PAL_DATASTORE_LOG_ENABLED
+    if ((OPTIGA_COMMS_MANAGE_CONTEXT_ID == datastore_id) || (OPTIGA_HIBERNATE_CONTEXT_ID == datastore_id))
+    {
+        return pal_os_datastore_log_read(datastore_id, p_buffer, p_buffer_length);
+    }
+#endif
     switch(datastore_id)
     {
         case OPTIGA_PLATFORM_BINDING_SHARED_SECRET_ID:
@@ -177,6 +273,51 @@ pal_status_t pal_os_datastore_read(uint16_t datastore_id,
             return_status = PAL_STATUS_SUCCESS;
             break;
         }
+        case OPTIGA_COMMS_LINK_STATE_ID:
+        {
+            // !!!OPTIGA_LIB_PORTING_REQUIRED
+            // This has to be enhanced by user only, if the link state is
+            // stored in NVM, else this is not required to be enhanced.
+            data_length = (uint16_t) (data_store_link_state_buffer[offset++] << 8);
+            data_length |= (uint16_t)(data_store_link_state_buffer[offset++]);
+            if (data_length <= *p_buffer_length)
+            {
+                memcpy(p_buffer, &data_store_link_state_buffer[offset], data_length);
+                *p_buffer_length = data_length;
+                return_status = PAL_STATUS_SUCCESS;
+            }
+            break;
+        }
+        case OPTIGA_UTIL_PENDING_COUNT_ID:
+        {
+            // !!!OPTIGA_LIB_PORTING_REQUIRED
+            // This has to be enhanced by user only, if the pending increments are
+            // stored in NVM, else this is not required to be enhanced.
+            data_length = (uint16_t) (data_store_pending_count_buffer[offset++] << 8);
+            data_length |= (uint16_t)(data_store_pending_count_buffer[offset++]);
+            if (data_length <= *p_buffer_length)
+            {
+                memcpy(p_buffer, &data_store_pending_count_buffer[offset], data_length);
+                *p_buffer_length = data_length;
+                return_status = PAL_STATUS_SUCCESS;
+            }
+            break;
+        }
+        case OPTIGA_COMMS_BUS_MAP_ID:
+        {
+            // !!!OPTIGA_LIB_PORTING_REQUIRED
+            // This has to be enhanced by user only, if the map is stored in NVM,
+            // else this is not required to be enhanced.
+            data_length = (uint16_t) (data_store_bus_map_buffer[offset++] << 8);
+            data_length |= (uint16_t)(data_store_bus_map_buffer[offset++]);
+            if (data_length <= *p_buffer_length)
+            {
+                memcpy(p_buffer, &data_store_bus_map_buffer[offset], data_length);
+                *p_buffer_length = data_length;
+                return_status = PAL_STATUS_SUCCESS;
+            }
+            break;
+        }
         default:
         {
             *p_buffer_length = 0;
@@ -0,0 +1,98 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2021 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+*
+* \file pal_crypt_aes128_hw.c
+*
+* \brief   This file implements the platform abstraction layer APIs for the AES hardware accelerator (AES peripheral).
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include "optiga/common/optiga_lib_common.h"
+#include "optiga/pal/pal_crypt.h"
+#include "optiga/pal/pal_os_memory.h"
+#include "hwcrypto/aes.h"
+
+#ifdef OPTIGA_PAL_CRYPT_HW_AES_ENABLED
+
+/// Length of the AES128 key in bits
+#define PAL_CRYPT_AES128_KEY_BITS       (128U)
+
+pal_status_t pal_crypt_aes128_hw_set_key(void ** pp_key_context, const uint8_t * p_key)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    esp_aes_context * p_context = (esp_aes_context *)(*pp_key_context);
+
+    do
+    {
+        if (NULL == p_context)
+        {
+            p_context = (esp_aes_context *)pal_os_calloc(1, sizeof(esp_aes_context));
+            if (NULL == p_context)
+            {
+                break;
+            }
+            esp_aes_init(p_context);
+            *pp_key_context = p_context;
+        }
+        // The key is loaded into the AES peripheral with each block, the peripheral is shared with mbedTLS
+        if (0 != esp_aes_setkey(p_context, p_key, PAL_CRYPT_AES128_KEY_BITS))
+        {
+            break;
+        }
+        return_status = PAL_STATUS_SUCCESS;
+    } while (FALSE);
+    return (return_status);
+}
+
+pal_status_t pal_crypt_aes128_hw_encrypt_block(void * p_key_context,
+                                               const uint8_t * p_input,
+                                               uint8_t * p_output)
+{
+    return ((0 == esp_aes_crypt_ecb((esp_aes_context *)p_key_context, ESP_AES_ENCRYPT, p_input, p_output)) ?
+            PAL_STATUS_SUCCESS : PAL_STATUS_FAILURE);
+}
+
+void pal_crypt_aes128_hw_release_key(void * p_key_context)
+{
+    if (NULL != p_key_context)
+    {
+        // Erases the key of the context
+        esp_aes_free((esp_aes_context *)p_key_context);
+        pal_os_free(p_key_context);
+    }
+}
+
+#endif //OPTIGA_PAL_CRYPT_HW_AES_ENABLED
+
+/**
+* @}
+*/
@@ -37,20 +37,52 @@
 
 
 #include "optiga/pal/pal_i2c.h"
-#include "driver/i2c.h"
 #include "esp_log.h"
+#include "esp_idf_version.h"
+
+/*
+* From ESP-IDF v5.2 on, the transfers are started asynchronously on the bus/device API (driver/i2c_master.h)
+* and the completion is reported from the I2C ISR. Hence the calling task is not blocked during the transfer.
+* Define PAL_I2C_LEGACY_DRIVER to use the legacy driver, which executes the transfers synchronously
+* with a preallocated command link.
+*/
+#if !defined(PAL_I2C_LEGACY_DRIVER) && (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 2, 0))
+#define PAL_I2C_MASTER_BUS_API
+#endif
+
+#ifdef PAL_I2C_MASTER_BUS_API
+#include "driver/i2c_master.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#else
+#include "driver/i2c.h"
+#endif
+
+/// Timeout of a transfer in milliseconds
+#ifndef PAL_I2C_TRANSFER_TIMEOUT_MS
+#define PAL_I2C_TRANSFER_TIMEOUT_MS     (1000)
+#endif
 
+#ifdef PAL_I2C_MASTER_BUS_API
+/// Priority of the task, which invokes the upper layer handler on completion of the transfers
+#ifndef PAL_I2C_TASK_PRIORITY
+#define PAL_I2C_TASK_PRIORITY           (configMAX_PRIORITIES - 1)
+#endif
+/// Stack size of the task in words, which invokes the upper layer handler on completion of the transfers
+#ifndef PAL_I2C_TASK_STACK_SIZE
+#define PAL_I2C_TASK_STACK_SIZE         (configMINIMAL_STACK_SIZE * 5)
+#endif
+#else
 #define PAL_I2C_MASTER_TX_BUF_DISABLE   0                /*!< I2C master do not need buffer */
 #define PAL_I2C_MASTER_RX_BUF_DISABLE   0                /*!< I2C master do not need buffer */
 
-#define CONFIG_PAL_I2C_INIT_ENABLE 1
-
 #define WRITE_BIT                       I2C_MASTER_WRITE /*!< I2C master write */
 #define READ_BIT                        I2C_MASTER_READ  /*!< I2C master read */
 #define ACK_CHECK_EN                    0x1              /*!< I2C master will check ack from slave*/
 #define ACK_CHECK_DIS                   0x0              /*!< I2C master will not check ack from slave */
 #define ACK_VAL                         0x0              /*!< I2C ack value */
 #define NACK_VAL                        0x1              /*!< I2C nack value */
+#endif //PAL_I2C_MASTER_BUS_API
 
 /// @cond hidden
 typedef struct esp32_i2c_ctx {
@@ -60,43 +92,154 @@ typedef struct esp32_i2c_ctx {
 	uint32_t bitrate;
 }esp32_i2c_ctx_t;
 
-/* Varibale to indicate the re-entrant count of the i2c bus acquire function*/
-static volatile uint32_t g_entry_count = 0;
-
 /* Pointer to the current pal i2c context*/
-static pal_i2c_t * gp_pal_i2c_current_ctx;
+static const pal_i2c_t * gp_pal_i2c_current_ctx;
+
+#ifdef PAL_I2C_MASTER_BUS_API
+/* Bus, device and completion of the transfers */
+static i2c_master_bus_handle_t pal_i2c_bus = NULL;
+static i2c_master_dev_handle_t pal_i2c_device = NULL;
+static uint8_t pal_i2c_device_address;
+static TaskHandle_t pal_i2c_task = NULL;
+static volatile uint16_t pal_i2c_event = PAL_I2C_EVENT_ERROR;
+#else
+/* Command link of the transfers, allocated once instead of for every transfer */
+static uint8_t pal_i2c_cmd_link_buffer[I2C_LINK_RECOMMENDED_SIZE(1)];
+#endif //PAL_I2C_MASTER_BUS_API
 
 /// @endcond
 
+static void pal_i2c_invoke_upper_layer_callback(const pal_i2c_t * p_pal_i2c_ctx, uint16_t event)
+{
+    upper_layer_callback_t upper_layer_handler;
+
+    upper_layer_handler = (upper_layer_callback_t)p_pal_i2c_ctx->upper_layer_event_handler;
+    upper_layer_handler(p_pal_i2c_ctx->p_upper_layer_ctx, event);
+}
+
+#ifdef PAL_I2C_MASTER_BUS_API
+/*
+* Completion of the transfer, invoked from the I2C ISR.
+* The upper layer handler is invoked from the task, since it continues the protocol with the next transfer.
+*/
+static bool pal_i2c_transfer_done(i2c_master_dev_handle_t i2c_dev, const i2c_master_event_data_t * evt_data, void * arg)
+{
+    BaseType_t higher_priority_task_woken = pdFALSE;
+
+    pal_i2c_event = (I2C_EVENT_DONE == evt_data->event) ? PAL_I2C_EVENT_SUCCESS : PAL_I2C_EVENT_ERROR;
+    vTaskNotifyGiveFromISR(pal_i2c_task, &higher_priority_task_woken);
+
+    return (pdFALSE != higher_priority_task_woken);
+}
+
+static void pal_i2c_completion_task(void * pvParameters)
+{
+    do
+    {
+        if (0 != ulTaskNotifyTake(pdTRUE, portMAX_DELAY))
+        {
+            pal_i2c_invoke_upper_layer_callback(gp_pal_i2c_current_ctx, pal_i2c_event);
+        }
+    } while(1);
+}
+
+/*
+* Adds the device with the slave address of the context to the bus, once the address changes
+*/
+static esp_err_t pal_i2c_select_device(const pal_i2c_t * p_i2c_context)
+{
+    esp32_i2c_ctx_t * master_ctx = (esp32_i2c_ctx_t*)p_i2c_context->p_i2c_hw_config;
+    i2c_device_config_t device_config = {
+        .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+        .device_address = p_i2c_context->slave_address,
+        .scl_speed_hz = master_ctx->bitrate,
+    };
+    i2c_master_event_callbacks_t callbacks = {
+        .on_trans_done = pal_i2c_transfer_done,
+    };
+    esp_err_t ret = ESP_OK;
+
+    do {
+        if ((NULL != pal_i2c_device) && (pal_i2c_device_address == p_i2c_context->slave_address))
+        {
+            break;
+        }
+        if (NULL != pal_i2c_device)
+        {
+            (void)i2c_master_bus_rm_device(pal_i2c_device);
+            pal_i2c_device = NULL;
+        }
+        ret = i2c_master_bus_add_device(pal_i2c_bus, &device_config, &pal_i2c_device);
+        if (ESP_OK != ret)
+        {
+            break;
+        }
+        // Registered callbacks make transmit and receive asynchronous
+        ret = i2c_master_register_event_callbacks(pal_i2c_device, &callbacks, NULL);
+        if (ESP_OK != ret)
+        {
+            (void)i2c_master_bus_rm_device(pal_i2c_device);
+            pal_i2c_device = NULL;
+            break;
+        }
+        pal_i2c_device_address = p_i2c_context->slave_address;
+    } while(0);
+
+    return ret;
+}
+#endif //PAL_I2C_MASTER_BUS_API
 
 pal_status_t pal_i2c_init(const pal_i2c_t* p_i2c_context)
 {
-	int master_port;
 	esp32_i2c_ctx_t* master_ctx;
+#ifdef PAL_I2C_MASTER_BUS_API
+    i2c_master_bus_config_t bus_config = {0};
+#else
 	i2c_config_t conf;
-	
-#if 1 //def CONFIG_PAL_I2C_INIT_ENABLE	
+#endif
+
 	ESP_LOGI("pal_i2c", "Initialize pal_i2c_init  ");
 
 	if ((p_i2c_context == NULL) || (p_i2c_context->p_i2c_hw_config == NULL))
 		return PAL_STATUS_FAILURE;
-	
+
 	master_ctx = (esp32_i2c_ctx_t*)p_i2c_context->p_i2c_hw_config;
-	master_port = master_ctx->port;
-	
+
+#ifdef PAL_I2C_MASTER_BUS_API
+    if (NULL == pal_i2c_task)
+    {
+        if (pdPASS != xTaskCreate(pal_i2c_completion_task, "otx_i2c_tsk", PAL_I2C_TASK_STACK_SIZE,
+                                  NULL, PAL_I2C_TASK_PRIORITY, &pal_i2c_task))
+        {
+            return PAL_STATUS_FAILURE;
+        }
+    }
+    bus_config.i2c_port = master_ctx->port;
+    bus_config.sda_io_num = master_ctx->sda_io;
+    bus_config.scl_io_num = master_ctx->scl_io;
+    bus_config.clk_source = I2C_CLK_SRC_DEFAULT;
+    bus_config.glitch_ignore_cnt = 7;
+    // One transfer is queued at a time by the upper layer
+    bus_config.trans_queue_depth = 1;
+    bus_config.flags.enable_internal_pullup = 1;
+    if (ESP_OK != i2c_new_master_bus(&bus_config, &pal_i2c_bus))
+    {
+        return PAL_STATUS_FAILURE;
+    }
+#else
     conf.mode = I2C_MODE_MASTER;
     conf.sda_io_num = master_ctx->sda_io;
     conf.sda_pullup_en = GPIO_PULLUP_ENABLE;
     conf.scl_io_num = master_ctx->scl_io;
     conf.scl_pullup_en = GPIO_PULLUP_ENABLE;
     conf.master.clk_speed = master_ctx->bitrate;
-    i2c_param_config(master_port, &conf);
-    i2c_driver_install(master_port, conf.mode,
+    i2c_param_config(master_ctx->port, &conf);
+    i2c_driver_install(master_ctx->port, conf.mode,
                        PAL_I2C_MASTER_TX_BUF_DISABLE,
                        PAL_I2C_MASTER_RX_BUF_DISABLE, 0);
-	
+#endif //PAL_I2C_MASTER_BUS_API
+
     ESP_LOGI("pal_i2c", "init successful");
-#endif
 
     return PAL_STATUS_SUCCESS;
 }
@@ -105,51 +248,68 @@ pal_status_t pal_i2c_deinit(const pal_i2c_t* p_i2c_context)
 {
 	esp32_i2c_ctx_t* master_ctx;
 
-#if 1    //def CONFIG_PAL_I2C_INIT_ENABLE			
 	if ((p_i2c_context == NULL) || (p_i2c_context->p_i2c_hw_config == NULL))
 		return PAL_STATUS_FAILURE;
-	
+
 	master_ctx = (esp32_i2c_ctx_t*)p_i2c_context->p_i2c_hw_config;
-	
+
+#ifdef PAL_I2C_MASTER_BUS_API
+    (void)master_ctx;
+    if (NULL != pal_i2c_device)
+    {
+        (void)i2c_master_bus_rm_device(pal_i2c_device);
+        pal_i2c_device = NULL;
+    }
+    if (NULL != pal_i2c_bus)
+    {
+        (void)i2c_del_master_bus(pal_i2c_bus);
+        pal_i2c_bus = NULL;
+    }
+#else
 	i2c_driver_delete(master_ctx->port);
-#endif
-	
+#endif //PAL_I2C_MASTER_BUS_API
+
     return PAL_STATUS_SUCCESS;
 }
 
 pal_status_t pal_i2c_write(const pal_i2c_t * p_i2c_context, uint8_t * p_data, uint16_t length)
 {
     pal_status_t status = PAL_STATUS_FAILURE;
-	upper_layer_callback_t upper_layer_handler;
-	int i2c_master_port;
-	esp32_i2c_ctx_t* master_ctx;
-
-	gp_pal_i2c_current_ctx = p_i2c_context;
+    esp_err_t ret;
 
 	if ((p_i2c_context == NULL) || (p_i2c_context->p_i2c_hw_config == NULL))
 		return status;
 
-	master_ctx = (esp32_i2c_ctx_t*)p_i2c_context->p_i2c_hw_config;
-	i2c_master_port = master_ctx->port;
+	gp_pal_i2c_current_ctx = p_i2c_context;
 
-	i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+#ifdef PAL_I2C_MASTER_BUS_API
+    ret = pal_i2c_select_device(p_i2c_context);
+    if (ESP_OK == ret)
+    {
+        // Completion is reported by pal_i2c_transfer_done
+        ret = i2c_master_transmit(pal_i2c_device, p_data, length, PAL_I2C_TRANSFER_TIMEOUT_MS);
+        if (ESP_OK == ret)
+        {
+            return PAL_STATUS_SUCCESS;
+        }
+    }
+#else
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(pal_i2c_cmd_link_buffer, sizeof(pal_i2c_cmd_link_buffer));
 
     i2c_master_start(cmd);
     i2c_master_write_byte(cmd, (p_i2c_context->slave_address << 1) | WRITE_BIT, ACK_CHECK_EN);
     i2c_master_write(cmd, p_data, length, ACK_CHECK_EN);
     i2c_master_stop(cmd);
-    esp_err_t ret = i2c_master_cmd_begin(i2c_master_port, cmd, 1000 / portTICK_RATE_MS);
-    i2c_cmd_link_delete(cmd);
-
-	upper_layer_handler = (upper_layer_callback_t)p_i2c_context->upper_layer_event_handler;
+    ret = i2c_master_cmd_begin(((esp32_i2c_ctx_t*)p_i2c_context->p_i2c_hw_config)->port, cmd,
+                               pdMS_TO_TICKS(PAL_I2C_TRANSFER_TIMEOUT_MS));
+    i2c_cmd_link_delete_static(cmd);
+#endif //PAL_I2C_MASTER_BUS_API
 
 	if (ret == ESP_OK) {
-        //ESP_LOG_BUFFER_HEX("pal_i2c : W:", p_data, length);
-		upper_layer_handler(p_i2c_context->p_upper_layer_ctx, PAL_I2C_EVENT_SUCCESS);
+		pal_i2c_invoke_upper_layer_callback(p_i2c_context, PAL_I2C_EVENT_SUCCESS);
 		status = PAL_STATUS_SUCCESS;
 	} else {
-        //ESP_LOGI("pal_i2c", "W-Failure");
-        upper_layer_handler(p_i2c_context->p_upper_layer_ctx , PAL_I2C_EVENT_ERROR);
+        pal_i2c_invoke_upper_layer_callback(p_i2c_context, PAL_I2C_EVENT_ERROR);
 	}
 
     return status;
@@ -158,22 +318,30 @@ pal_status_t pal_i2c_write(const pal_i2c_t * p_i2c_context, uint8_t * p_data, ui
 pal_status_t pal_i2c_read(const pal_i2c_t * p_i2c_context, uint8_t * p_data, uint16_t length)
 {
     pal_status_t status = PAL_STATUS_FAILURE;
-    upper_layer_callback_t upper_layer_handler;
-	int i2c_master_port;
-	esp32_i2c_ctx_t* master_ctx;
-
-	gp_pal_i2c_current_ctx = p_i2c_context;
+    esp_err_t ret;
 
 	if (length == 0)
         return status;
-	
+
 	if ((p_i2c_context == NULL) || (p_i2c_context->p_i2c_hw_config == NULL))
 		return status;
 
-	master_ctx = (esp32_i2c_ctx_t*)p_i2c_context->p_i2c_hw_config;
-	i2c_master_port = master_ctx->port;
-	
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+	gp_pal_i2c_current_ctx = p_i2c_context;
+
+#ifdef PAL_I2C_MASTER_BUS_API
+    ret = pal_i2c_select_device(p_i2c_context);
+    if (ESP_OK == ret)
+    {
+        // Completion is reported by pal_i2c_transfer_done
+        ret = i2c_master_receive(pal_i2c_device, p_data, length, PAL_I2C_TRANSFER_TIMEOUT_MS);
+        if (ESP_OK == ret)
+        {
+            return PAL_STATUS_SUCCESS;
+        }
+    }
+#else
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(pal_i2c_cmd_link_buffer, sizeof(pal_i2c_cmd_link_buffer));
+
     i2c_master_start(cmd);
     i2c_master_write_byte(cmd, ( p_i2c_context->slave_address << 1 ) | READ_BIT, ACK_CHECK_EN);
     if (length > 1) {
@@ -181,18 +349,16 @@ pal_status_t pal_i2c_read(const pal_i2c_t * p_i2c_context, uint8_t * p_data, uin
     }
     i2c_master_read_byte(cmd, p_data + length - 1, NACK_VAL);
     i2c_master_stop(cmd);
-    esp_err_t ret = i2c_master_cmd_begin(i2c_master_port, cmd, 1000 / portTICK_RATE_MS);
-    i2c_cmd_link_delete(cmd);
-	
-    upper_layer_handler = (upper_layer_callback_t)p_i2c_context->upper_layer_event_handler;
-	
+    ret = i2c_master_cmd_begin(((esp32_i2c_ctx_t*)p_i2c_context->p_i2c_hw_config)->port, cmd,
+                               pdMS_TO_TICKS(PAL_I2C_TRANSFER_TIMEOUT_MS));
+    i2c_cmd_link_delete_static(cmd);
+#endif //PAL_I2C_MASTER_BUS_API
+
 	if (ret == ESP_OK) {
-        //ESP_LOG_BUFFER_HEX("pal_i2c : R:", p_data, length);
-		upper_layer_handler(p_i2c_context->p_upper_layer_ctx , PAL_I2C_EVENT_SUCCESS);
+		pal_i2c_invoke_upper_layer_callback(p_i2c_context, PAL_I2C_EVENT_SUCCESS);
 		status = PAL_STATUS_SUCCESS;
 	} else {
-        //ESP_LOGI("pal_i2c", "R-Failure");
-        upper_layer_handler(p_i2c_context->p_upper_layer_ctx , PAL_I2C_EVENT_ERROR);
+        pal_i2c_invoke_upper_layer_callback(p_i2c_context, PAL_I2C_EVENT_ERROR);
 	}
 
     return status;
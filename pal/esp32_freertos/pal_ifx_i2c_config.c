@@ -38,7 +38,14 @@
 #include "optiga/pal/pal_gpio.h"
 #include "optiga/pal/pal_i2c.h"
 #include "optiga/ifx_i2c/ifx_i2c_config.h"
+#include "esp_idf_version.h"
+
+// Port numbers are provided by the driver used in pal_i2c.c
+#if !defined(PAL_I2C_LEGACY_DRIVER) && (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 2, 0))
+#include "driver/i2c_types.h"
+#else
 #include "driver/i2c.h"
+#endif
 
 /*!< gpio number for I2C master clock */
  #ifndef CONFIG_PAL_I2C_MASTER_SCL_IO
@@ -35,7 +35,11 @@
 * @{
 */
 
+#include "optiga/common/optiga_lib_common.h"
 #include "optiga/pal/pal_os_datastore.h"
+#ifdef OPTIGA_PAL_DATASTORE_LOG_ENABLED
+#include "esp_partition.h"
+#endif
 /// @cond hidden
 
 /// Size of length field 
@@ -62,6 +66,61 @@ uint8_t optiga_platform_binding_shared_secret [LENGTH_SIZE + OPTIGA_SHARED_SECRE
     0x31 ,0x32 ,0x33 ,0x34 ,0x35 ,0x36 ,0x37 ,0x38 ,0x39 ,0x3A ,0x3B ,0x3C ,0x3D ,0x3E ,0x3F ,0x40
 };
 
+#ifdef OPTIGA_PAL_DATASTORE_LOG_ENABLED
+/// Label of the data partition, which holds the sectors of the datastore log
+#ifndef PAL_OS_DATASTORE_PARTITION_LABEL
+#define PAL_OS_DATASTORE_PARTITION_LABEL        "optiga_ds"
+#endif
+
+// Provides the data partition of the datastore log, which must hold all its sectors
+static const esp_partition_t * pal_os_datastore_partition(void)
+{
+    static const esp_partition_t * p_partition = NULL;
+
+    if (NULL == p_partition)
+    {
+        p_partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                               PAL_OS_DATASTORE_PARTITION_LABEL);
+        if ((NULL != p_partition) &&
+            (p_partition->size < (OPTIGA_PAL_DATASTORE_LOG_SECTOR_COUNT * OPTIGA_PAL_DATASTORE_LOG_SECTOR_SIZE)))
+        {
+            p_partition = NULL;
+        }
+    }
+    return p_partition;
+}
+
+pal_status_t pal_os_datastore_flash_erase(uint8_t sector)
+{
+    const esp_partition_t * p_partition = pal_os_datastore_partition();
+
+    return (((NULL != p_partition) &&
+             (ESP_OK == esp_partition_erase_range(p_partition, (size_t)sector * OPTIGA_PAL_DATASTORE_LOG_SECTOR_SIZE,
+                                                  OPTIGA_PAL_DATASTORE_LOG_SECTOR_SIZE))) ?
+            PAL_STATUS_SUCCESS : PAL_STATUS_FAILURE);
+}
+
+pal_status_t pal_os_datastore_flash_program(uint8_t sector, uint16_t offset, const uint8_t * p_data, uint16_t length)
+{
+    const esp_partition_t * p_partition = pal_os_datastore_partition();
+
+    return (((NULL != p_partition) &&
+             (ESP_OK == esp_partition_write(p_partition,
+                                            ((size_t)sector * OPTIGA_PAL_DATASTORE_LOG_SECTOR_SIZE) + offset,
+                                            p_data, length))) ? PAL_STATUS_SUCCESS : PAL_STATUS_FAILURE);
+}
+
+pal_status_t pal_os_datastore_flash_read(uint8_t sector, uint16_t offset, uint8_t * p_data, uint16_t length)
+{
+    const esp_partition_t * p_partition = pal_os_datastore_partition();
+
+    return (((NULL != p_partition) &&
+             (ESP_OK == esp_partition_read(p_partition,
+                                           ((size_t)sector * OPTIGA_PAL_DATASTORE_LOG_SECTOR_SIZE) + offset,
+                                           p_data, length))) ? PAL_STATUS_SUCCESS : PAL_STATUS_FAILURE);
+}
+#endif
+
 
 pal_status_t pal_os_datastore_write(uint16_t datastore_id,
                                     const uint8_t * p_buffer,
@@ -70,6 +129,13 @@ pal_status_t pal_os_datastore_write(uint16_t datastore_id,
     pal_status_t return_status = PAL_STATUS_FAILURE;
     uint8_t offset = 0;
 
+#ifdef OPTIGA_PAL_DATASTORE_LOG_ENABLED
+    // The contexts saved on every hibernate are appended to the flash log
+    if ((OPTIGA_COMMS_MANAGE_CONTEXT_ID == datastore_id) || (OPTIGA_HIBERNATE_CONTEXT_ID == datastore_id))
+    {
+        return pal_os_datastore_log_write(datastore_id, p_buffer, length);
+    }
+#endif
     switch(datastore_id)
     {
         case OPTIGA_PLATFORM_BINDING_SHARED_SECRET_ID:
@@ -131,6 +197,12 @@ pal_status_t pal_os_datastore_read(uint16_t datastore_id,
     uint16_t data_length;
     uint8_t offset = 0;
 
+#ifdef OPTIGA_PAL_DATASTORE_LOG_ENABLED
+    if ((OPTIGA_COMMS_MANAGE_CONTEXT_ID == datastore_id) || (OPTIGA_HIBERNATE_CONTEXT_ID == datastore_id))
+    {
+        return pal_os_datastore_log_read(datastore_id, p_buffer, p_buffer_length);
+    }
+#endif
     switch(datastore_id)
     {
         case OPTIGA_PLATFORM_BINDING_SHARED_SECRET_ID:
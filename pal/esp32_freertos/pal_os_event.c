@@ -38,8 +38,8 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/timers.h"
 #include "freertos/task.h"
-#include "freertos/semphr.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "optiga/pal/pal_os_timer.h"
 #include "optiga/pal/pal_os_event.h"
 #include "optiga/pal/pal.h"
@@ -48,9 +48,38 @@
 /// @cond hidden
 void pal_os_event_delayms(uint32_t time_ms);
 
-static pal_os_event_t pal_os_event_0 = {0};
+/// Number of events, one for each OPTIGA instance
+#ifdef OPTIGA_MAX_NUMBER_OF_INSTANCES
+#define PAL_OS_EVENT_MAX_INSTANCES OPTIGA_MAX_NUMBER_OF_INSTANCES
+#else
+#define PAL_OS_EVENT_MAX_INSTANCES (1)
+#endif
+
+/*
+* Priority of the task, which invokes the registered callbacks.
+* The callbacks drive the OPTIGA protocol, hence the task is preferred over the application tasks.
+*/
+#ifndef PAL_OS_EVENT_TASK_PRIORITY
+#define PAL_OS_EVENT_TASK_PRIORITY      (configMAX_PRIORITIES - 1)
+#endif
+/// Stack size of the task in words, which invokes the registered callbacks
+#ifndef PAL_OS_EVENT_TASK_STACK_SIZE
+#define PAL_OS_EVENT_TASK_STACK_SIZE    (configMINIMAL_STACK_SIZE * 5)
+#endif
+/// Delays from one tick on are scheduled with the FreeRTOS timer, shorter delays with esp_timer
+#define PAL_OS_EVENT_TICK_PERIOD_US     (portTICK_PERIOD_MS * 1000U)
+
+/// Index of the event in the list
+#define PAL_OS_EVENT_INDEX(p_event)     ((uint32_t)((p_event) - pal_os_event_list))
+
+static pal_os_event_t pal_os_event_list[PAL_OS_EVENT_MAX_INSTANCES] = {0};
 uint32_t timeout = 0;
 
+static TaskHandle_t      pal_os_event_task = NULL;
+// Each event has its own timers, the expiry sets the bit of the event in the notification value of the task
+static TimerHandle_t     pal_os_event_timer_list[PAL_OS_EVENT_MAX_INSTANCES];
+static esp_timer_handle_t pal_os_event_us_timer_list[PAL_OS_EVENT_MAX_INSTANCES];
+
 void pal_os_event_start(pal_os_event_t * p_pal_os_event, register_callback callback, void * callback_args)
 {
     if (FALSE == p_pal_os_event->is_event_triggered)
@@ -69,124 +98,146 @@ void pal_os_event_stop(pal_os_event_t * p_pal_os_event)
 
 pal_os_event_t * pal_os_event_create(register_callback callback, void * callback_args)
 {
+    pal_os_event_t * p_pal_os_event = &pal_os_event_list[0];
+    uint8_t index;
+
     if (( NULL != callback )&&( NULL != callback_args ))
     {
-        pal_os_event_start(&pal_os_event_0,callback,callback_args);
+        // Pick the first event, which is not in use by another OPTIGA instance
+        for (index = 0; index < PAL_OS_EVENT_MAX_INSTANCES; index++)
+        {
+            if (NULL == pal_os_event_list[index].os_timer)
+            {
+                break;
+            }
+        }
+        if (PAL_OS_EVENT_MAX_INSTANCES == index)
+        {
+            ESP_LOGE("pal_os_event", "No free event");
+            return (NULL);
+        }
+        p_pal_os_event = &pal_os_event_list[index];
+        p_pal_os_event->os_timer = &pal_os_event_timer_list[index];
+        pal_os_event_start(p_pal_os_event,callback,callback_args);
     }
-    return (&pal_os_event_0);
+    return (p_pal_os_event);
 }
 
-/// @endcond
-
-SemaphoreHandle_t xSemaphore = NULL;
-TimerHandle_t     xTimer = NULL;
-
 /**
-*  Timer callback handler. 
+*  Timer callback handler.
 *
-*  This get called from the TIMER elapse event.<br>
-*  Once the timer expires, the registered callback funtion gets called from the timer event handler, if
-*  the call back is not NULL.<br>
-*
-*\param[in] args Callback argument
+*  This get called from the TIMER elapse event (FreeRTOS timer service task or esp_timer task).<br>
+*  The registered callback is not invoked from the timer context, which might lead to a corruption.
+*  Instead, the event task is notified directly, which invokes the registered callback funtion.<br>
 *
 */
-void vTimerCallback( TimerHandle_t xTimer )
+static void pal_os_event_notify(const pal_os_event_t * p_pal_os_event)
+{
+    (void)xTaskNotify(pal_os_event_task, (1UL << PAL_OS_EVENT_INDEX(p_pal_os_event)), eSetBits);
+}
+
+static void vTimerCallback( TimerHandle_t xTimer )
 {
     /* Optionally do something if the pxTimer parameter is NULL. */
     configASSERT( xTimer );
+    // Timer ID carries the event
+    pal_os_event_notify((const pal_os_event_t *)pvTimerGetTimerID(xTimer));
+}
 
-    /*
-     * You can't call callback from the timer callback, this might lead to a corruption
-     * Use a semaphore instead
-     * */
-    xSemaphoreGive( xSemaphore );
+static void pal_os_event_us_timer_callback(void * args)
+{
+    pal_os_event_notify((const pal_os_event_t *)args);
 }
 
 /// @endcond
 
 void pal_os_event_trigger_registered_callback(void)
 {
-	register_callback func = NULL;
-	void * func_args = NULL;
-
-	/* 
-    See if we can obtain the element from the semaphore.  If the semaphore is not
-	available wait block the task to see if it becomes free.
-	portMAX_DELAY works only if INCLUDE_vTaskSuspend id define to 1
-	*/
-	//printf("vTaskCallbackHandler\r\n");
-	do {
-		if( xSemaphoreTake( xSemaphore, ( TickType_t ) portMAX_DELAY ) == pdTRUE )
+    register_callback func = NULL;
+    void * func_args = NULL;
+    uint32_t pending = 0;
+    uint32_t index;
+
+    do
+    {
+        // Callback is registered by the upper layer before the timer is started, hence visible on notification
+        if (pdTRUE == xTaskNotifyWait(0, 0xFFFFFFFFUL, &pending, portMAX_DELAY))
         {
-			if (pal_os_event_0.callback_registered)
-			{
-				func = pal_os_event_0.callback_registered;
-                pal_os_event_0.callback_registered = NULL;
-				func_args = pal_os_event_0.callback_ctx;
-				func((void*)func_args);
-			}
-		}
-	} while(1);
+            // Several events might have expired meanwhile, each is invoked once
+            for (index = 0; index < PAL_OS_EVENT_MAX_INSTANCES; index++)
+            {
+                if ((0 != (pending & (1UL << index))) && (NULL != pal_os_event_list[index].callback_registered))
+                {
+                    func = pal_os_event_list[index].callback_registered;
+                    pal_os_event_list[index].callback_registered = NULL;
+                    func_args = pal_os_event_list[index].callback_ctx;
+                    func((void*)func_args);
+                }
+            }
+        }
+    } while(1);
 }
 
-void _pal_os_event_trigger_registered_callback( void * pvParameters )
+static void _pal_os_event_trigger_registered_callback( void * pvParameters )
 {
-	pal_os_event_trigger_registered_callback();
+    pal_os_event_trigger_registered_callback();
 }
 
 pal_status_t pal_os_event_init(void)
 {
-	pal_status_t status = PAL_STATUS_FAILURE;
-	BaseType_t xReturned;
-	
-	do {
-		/* Create a semaphore and take it now */
-		xSemaphore = xSemaphoreCreateBinary();
-		if( xSemaphore == NULL )
-		{
-			break;
-		}
-
-		xSemaphoreTake( xSemaphore, ( TickType_t ) 10 );
-
-		/* Create the handler for the callbacks. */
-		xReturned = xTaskCreate(pal_os_event_trigger_registered_callback,       /* Function that implements the task. */
-								"otx_os_tsk",                /* Text name for the task. */
-								configMINIMAL_STACK_SIZE*5,  /* Stack size in words, not bytes. */
-								NULL,        /* Parameter passed into the task. */
-								5,           /* Priority at which the task is created. */
-								NULL );      /* Used to pass out the created task's handle. */
-		if( xReturned != pdPASS )
-		{
-			break;
-		}
+    pal_status_t status = PAL_STATUS_FAILURE;
+    BaseType_t xReturned;
+    uint8_t index;
+    esp_timer_create_args_t us_timer_args = {
+        .callback = pal_os_event_us_timer_callback,
+        .arg = NULL,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "otx_os_us_tmr"
+    };
+
+    do {
+        /* Create the handler for the callbacks. */
+        xReturned = xTaskCreate(_pal_os_event_trigger_registered_callback, /* Function that implements the task. */
+                                "otx_os_tsk",                  /* Text name for the task. */
+                                PAL_OS_EVENT_TASK_STACK_SIZE,  /* Stack size in words, not bytes. */
+                                NULL,                          /* Parameter passed into the task. */
+                                PAL_OS_EVENT_TASK_PRIORITY,    /* Priority at which the task is created. */
+                                &pal_os_event_task );          /* Used to pass out the created task's handle. */
+        if( xReturned != pdPASS )
+        {
+            break;
+        }
 
         ESP_LOGI("pal_os_event", "Init : Create Timer");
-#if 0        
-		xTimer = xTimerCreate("otx_os_tmr",        /* Just a text name, not used by the kernel. */
-							  1 / portTICK_PERIOD_MS,    /* The timer period in ticks. */
-							  pdFALSE,         /* The timers will auto-reload themselves when they expire. */
-							  ( void * ) NULL,   /* Assign each timer a unique id equal to its array index. */
-							  vTimerCallback  /* Each timer calls the same callback when it expires. */
-							  );
-#endif
-        xTimer = xTimerCreate("otx_os_tmr2", 
-                              pdMS_TO_TICKS(10), 
-                              pdFALSE, 
-                              (void *)0, 
-                              vTimerCallback);
-
-        if( xTimer == NULL )
-		{
-			break;
-		}
+        for (index = 0; index < PAL_OS_EVENT_MAX_INSTANCES; index++)
+        {
+            // Period is set on every registration
+            pal_os_event_timer_list[index] = xTimerCreate("otx_os_tmr2",
+                                                          1,
+                                                          pdFALSE,
+                                                          (void *)&pal_os_event_list[index],
+                                                          vTimerCallback);
+
+            if( pal_os_event_timer_list[index] == NULL )
+            {
+                break;
+            }
+            us_timer_args.arg = (void *)&pal_os_event_list[index];
+            if (ESP_OK != esp_timer_create(&us_timer_args, &pal_os_event_us_timer_list[index]))
+            {
+                break;
+            }
+        }
+        if (PAL_OS_EVENT_MAX_INSTANCES != index)
+        {
+            break;
+        }
         ESP_LOGI("pal_os_event", "Init : Create Timer successful");
-		status = PAL_STATUS_SUCCESS;
+        status = PAL_STATUS_SUCCESS;
+
+    } while(0);
 
-	} while(0);
-				
-	return status;
+    return status;
 }
 
 void pal_os_event_register_callback_oneshot(pal_os_event_t * p_pal_os_event,
@@ -195,21 +246,25 @@ void pal_os_event_register_callback_oneshot(pal_os_event_t * p_pal_os_event,
                                             uint32_t time_us)
 
 {
-	if (time_us < 1000) {
-		time_us = 1000;
-	}
-    else {
-        if (time_us%1000) time_us++;
-    }
+    uint32_t index = PAL_OS_EVENT_INDEX(p_pal_os_event);
 
-    //timeout = (time_us/1000);
-    //if (time_us%1000) timeout++;
     p_pal_os_event->callback_registered = callback;
     p_pal_os_event->callback_ctx = callback_args;
 
-    //ESP_LOGI("pal_os_event", "oneShot : %d", time_us);
-	//xTimerChangePeriod( xTimer, (time_us / 1000) / portTICK_PERIOD_MS, 10);
-    xTimerChangePeriod(xTimer, pdMS_TO_TICKS(10), portMAX_DELAY);
+    if (time_us < PAL_OS_EVENT_TICK_PERIOD_US)
+    {
+        // Sub tick delays (e.g. guard times and polling) are scheduled in microseconds
+        //lint --e{534} suppress "Timer is stopped, if it is not yet expired"
+        esp_timer_stop(pal_os_event_us_timer_list[index]);
+        esp_timer_start_once(pal_os_event_us_timer_list[index], (uint64_t)time_us);
+    }
+    else
+    {
+        // Rounded up to the next tick, hence the callback is never invoked before the requested delay
+        xTimerChangePeriod(pal_os_event_timer_list[index],
+                           (TickType_t)((time_us + PAL_OS_EVENT_TICK_PERIOD_US - 1U) / PAL_OS_EVENT_TICK_PERIOD_US),
+                           portMAX_DELAY);
+    }
 }
 
 void pal_os_event_delayms(uint32_t time_ms)
@@ -220,7 +275,15 @@ void pal_os_event_delayms(uint32_t time_ms)
 
 void pal_os_event_destroy(pal_os_event_t * pal_os_event)
 {
-    
+    uint32_t index = PAL_OS_EVENT_INDEX(pal_os_event);
+
+    //lint --e{534} suppress "The timers are stopped, if they are not yet expired"
+    esp_timer_stop(pal_os_event_us_timer_list[index]);
+    xTimerStop(pal_os_event_timer_list[index], portMAX_DELAY);
+    pal_os_event->callback_registered = NULL;
+    pal_os_event->is_event_triggered = FALSE;
+    // event is free for next create
+    pal_os_event->os_timer = NULL;
 }
 
 /**
@@ -40,17 +40,49 @@
 
 void * pal_os_malloc(uint32_t block_size)
 {
+#ifdef OPTIGA_LIB_MEMORY_POOL_ENABLED
+    void * p_block = pal_os_memory_pool_alloc(block_size);
+
+    return ((NULL != p_block) ? p_block : malloc(block_size));
+#else
     return (malloc(block_size));
+#endif //OPTIGA_LIB_MEMORY_POOL_ENABLED
 }
 
 void * pal_os_calloc(uint32_t number_of_blocks , uint32_t block_size)
 {
+#ifdef OPTIGA_LIB_MEMORY_POOL_ENABLED
+    void * p_block = NULL;
+
+    // Overflowing sizes are left to the platform heap
+    if ((0 == number_of_blocks) || (block_size <= (0xFFFFFFFFU / number_of_blocks)))
+    {
+        p_block = pal_os_memory_pool_alloc(number_of_blocks * block_size);
+    }
+    if (NULL != p_block)
+    {
+        memset(p_block, 0, number_of_blocks * block_size);
+    }
+    else
+    {
+        p_block = calloc(number_of_blocks, block_size);
+    }
+    return (p_block);
+#else
     return (calloc(number_of_blocks, block_size));
+#endif //OPTIGA_LIB_MEMORY_POOL_ENABLED
 }
 
 void pal_os_free(void * p_block)
 {
+#ifdef OPTIGA_LIB_MEMORY_POOL_ENABLED
+    if (FALSE == pal_os_memory_pool_free(p_block))
+    {
+        free(p_block);
+    }
+#else
     free(p_block);
+#endif //OPTIGA_LIB_MEMORY_POOL_ENABLED
 }
 
 void pal_os_memcpy(void * p_destination, const void * p_source, uint32_t size)
@@ -91,6 +91,18 @@
 #define false 0
 #define true 1
 
+// Asynchronous operation submits the transfers in batches
+#if defined(PAL_USB_ASYNC) && !defined(PAL_USB_BATCHED_TRANSFERS)
+#define PAL_USB_BATCHED_TRANSFERS
+#endif
+
+#ifdef PAL_USB_BATCHED_TRANSFERS
+/// Maximum number of data bytes in one FT260 I2C report
+#define PAL_USB_I2C_REPORT_DATA_SIZE    (HID_REPORT_SIZE - 4)
+/// Maximum number of transfers of a batch, which covers the largest frame
+#define PAL_USB_MAX_BATCH_SIZE          (8)
+#endif //PAL_USB_BATCHED_TRANSFERS
+
 /**********************************************************************************************************************
  * ENUMS
  *********************************************************************************************************************/
@@ -106,6 +118,39 @@
 */
 LIBRARY_EXPORTS void get_pal_context(void *_optiga_pal_i2c_context_0,int32_t context_type);
 
+#ifdef PAL_USB_BATCHED_TRANSFERS
+/** @brief Transfers of an I2C operation, which are submitted together */
+typedef struct pal_usb_batch
+{
+    /// Interrupt transfers of the reports
+    struct libusb_transfer * transfers[PAL_USB_MAX_BATCH_SIZE];
+    /// Output and input reports
+    uint8_t reports[PAL_USB_MAX_BATCH_SIZE][HID_REPORT_SIZE];
+    /// Endpoint of each report
+    uint8_t endpoints[PAL_USB_MAX_BATCH_SIZE];
+    /// Number of transfers in the batch
+    uint8_t count;
+    /// Number of transfers in flight
+    volatile int32_t pending;
+    /// Indicates a transfer of the batch failed
+    volatile uint8_t failed;
+#ifdef PAL_USB_ASYNC
+    /// Control transfer reading the I2C status
+    struct libusb_transfer * status_transfer;
+    /// Setup and data of the status control transfer
+    uint8_t status_buffer[LIBUSB_CONTROL_SETUP_SIZE + HID_REPORT_SIZE];
+    /// Pal i2c context of the ongoing operation, NULL while the bus is free
+    const pal_i2c_t * volatile p_i2c_context;
+    /// Buffer of the ongoing read
+    uint8_t * p_read_data;
+    /// Length of the ongoing operation
+    uint16_t length;
+    /// Ongoing operation, write or read
+    uint8_t operation;
+#endif //PAL_USB_ASYNC
+} pal_usb_batch_t;
+#endif //PAL_USB_BATCHED_TRANSFERS
+
 /** @brief PAL I2C context structure */
 typedef struct pal_usb
 {
@@ -115,7 +160,29 @@ typedef struct pal_usb
     uint8_t hid_ep_in;
     /// Endpoint to write to device
     uint8_t hid_ep_out;
+#ifdef PAL_USB_BATCHED_TRANSFERS
+    /// Transfers of the ongoing I2C operation, one per device
+    pal_usb_batch_t batch;
+#endif
    
 } pal_usb_t;
 
+#ifdef PAL_USB_ASYNC
+/**
+ * \brief Handles the pending libusb events and completes the asynchronous I2C operations.
+ *
+ * \details
+ * Waits on the pollfds of libusb (libusb_get_pollfds) for up to timeout_ms and handles the ready events.
+ * - The completed transfers drive the I2C operations, the upper layer handlers are invoked from here.
+ * - Invoked by the event thread of the PAL, or by the event loop of the application if
+ *   PAL_USB_EXTERNAL_EVENT_LOOP is defined.
+ *
+ * \param[in] timeout_ms   Maximum time to wait for an event, 0 to handle only the ready events
+ *
+ * \retval  #PAL_STATUS_SUCCESS  Events are handled
+ * \retval  #PAL_STATUS_FAILURE  Polling or handling of the events failed
+ */
+pal_status_t pal_usb_handle_events(int32_t timeout_ms);
+#endif //PAL_USB_ASYNC
+
 #endif
@@ -66,6 +66,12 @@ optiga_comms_t optiga_comms = {
 _STATIC_H optiga_lib_status_t check_optiga_comms_state(optiga_comms_t *p_ctx);
 _STATIC_H void ifx_i2c_event_handler(void* p_ctx, optiga_lib_status_t event);
 
+optiga_comms_t * optiga_comms_create_instance(uint8_t optiga_instance_id, callback_handler_t callback, void * context)
+{
+    // Only one OPTIGA is supported over USB
+    return ((OPTIGA_INSTANCE_ID_0 == optiga_instance_id) ? optiga_comms_create(callback, context) : NULL);
+}
+
 optiga_comms_t * optiga_comms_create(callback_handler_t callback, void * context)
 {
     optiga_comms_t * p_optiga_comms = NULL;
@@ -46,6 +46,11 @@
 #endif
 #include "pal_usb.h"
 #include "pal_common.h"
+#ifdef PAL_USB_ASYNC
+#include <poll.h>
+#include <pthread.h>
+#include <errno.h>
+#endif
 
 /**********************************************************************************************************************
  * MACROS
@@ -59,6 +64,15 @@
 #endif
 
 #define WAIT_500_MS    (500)
+
+#ifdef PAL_USB_ASYNC
+/// Maximum time the event thread waits on the pollfds, before checking for the stop request
+#ifndef PAL_USB_EVENT_POLL_TIMEOUT_MS
+#define PAL_USB_EVENT_POLL_TIMEOUT_MS   (100)
+#endif
+/// Maximum number of pollfds of libusb, covers the internal ones and the opened devices
+#define PAL_USB_MAX_POLLFDS             (16)
+#endif
 /// @cond hidden
 /*********************************************************************************************************************
  * LOCAL DATA
@@ -67,10 +81,78 @@
 extern pal_usb_t usb_events;
 static libusb_device_handle *dev_handle = NULL; //a device handle
 static uint8_t hw_initialised = 0;
+#if defined(PAL_USB_ASYNC) && !defined(PAL_USB_EXTERNAL_EVENT_LOOP)
+static pthread_t pal_usb_event_thread;
+static volatile uint8_t pal_usb_event_thread_running = FALSE;
+#endif
 
 /**********************************************************************************************************************
  * LOCAL ROUTINES
  *********************************************************************************************************************/
+#ifdef PAL_USB_ASYNC
+pal_status_t pal_usb_handle_events(int32_t timeout_ms)
+{
+    const struct libusb_pollfd ** usb_pollfds;
+    struct pollfd fds[PAL_USB_MAX_POLLFDS];
+    struct timeval next_timeout;
+    struct timeval zero_timeout = {0, 0};
+    nfds_t count = 0;
+    int32_t libusb_timeout_ms;
+    pal_status_t status = PAL_STATUS_FAILURE;
+
+    do
+    {
+        // The pollfds are fetched each time, since they change when devices are opened or closed
+        usb_pollfds = libusb_get_pollfds(NULL);
+        if (NULL == usb_pollfds)
+        {
+            break;
+        }
+        while ((count < PAL_USB_MAX_POLLFDS) && (NULL != usb_pollfds[count]))
+        {
+            fds[count].fd = usb_pollfds[count]->fd;
+            fds[count].events = usb_pollfds[count]->events;
+            fds[count].revents = 0;
+            count++;
+        }
+        libusb_free_pollfds(usb_pollfds);
+
+        // Timeouts of the transfers are handled by libusb, hence the wait ends at the next one
+        if (1 == libusb_get_next_timeout(NULL, &next_timeout))
+        {
+            libusb_timeout_ms = (int32_t)((next_timeout.tv_sec * 1000) + (next_timeout.tv_usec / 1000));
+            if (libusb_timeout_ms < timeout_ms)
+            {
+                timeout_ms = libusb_timeout_ms;
+            }
+        }
+        if ((0 > poll(fds, count, timeout_ms)) && (EINTR != errno))
+        {
+            LOG_PAL("poll failed\n.");
+            break;
+        }
+        if (0 != libusb_handle_events_timeout_completed(NULL, &zero_timeout, NULL))
+        {
+            break;
+        }
+        status = PAL_STATUS_SUCCESS;
+    } while (0);
+
+    return status;
+}
+
+#ifndef PAL_USB_EXTERNAL_EVENT_LOOP
+// Completes the asynchronous transfers of all the opened devices
+static void * pal_usb_event_loop(void * arg)
+{
+    while (TRUE == pal_usb_event_thread_running)
+    {
+        (void)pal_usb_handle_events(PAL_USB_EVENT_POLL_TIMEOUT_MS);
+    }
+    return NULL;
+}
+#endif
+#endif //PAL_USB_ASYNC
 
 pal_status_t pal_init(void)
 {
@@ -138,6 +220,15 @@ pal_status_t pal_init(void)
 				break;
 			}
 
+#if defined(PAL_USB_ASYNC) && !defined(PAL_USB_EXTERNAL_EVENT_LOOP)
+			pal_usb_event_thread_running = TRUE;
+			if (0 != pthread_create(&pal_usb_event_thread, NULL, pal_usb_event_loop, NULL))
+			{
+				pal_usb_event_thread_running = FALSE;
+				break;
+			}
+#endif
+
 			LOG_PAL("LibUSB PAL initialised\n");
 
 			ret = PAL_STATUS_SUCCESS;
@@ -153,5 +244,12 @@ pal_status_t pal_init(void)
 
 pal_status_t pal_deinit(void)
 {
+#if defined(PAL_USB_ASYNC) && !defined(PAL_USB_EXTERNAL_EVENT_LOOP)
+    if (TRUE == pal_usb_event_thread_running)
+    {
+        pal_usb_event_thread_running = FALSE;
+        (void)pthread_join(pal_usb_event_thread, NULL);
+    }
+#endif
     return PAL_STATUS_SUCCESS;
 }
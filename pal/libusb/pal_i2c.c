@@ -58,6 +58,22 @@
 #define LOG_PAL(...) //printf(__VA_ARGS__)
 #endif
 
+/*
+* Define PAL_USB_BATCHED_TRANSFERS to submit all the USB transfers of an I2C write or read at once
+* (libusb_submit_transfer), instead of one blocking transfer after the other.
+* - A write is split into reports of up to PAL_USB_I2C_REPORT_DATA_SIZE bytes, which are in flight together.
+* - A read submits the read request and the input reports together, hence the data is returned in the next USB frames.
+*   The status poll is done only if the read fails.
+*
+* Define PAL_USB_ASYNC (Linux) to return from pal_i2c_write and pal_i2c_read right after the submission.
+* - The completion of the transfers drives the operation (status poll) and invokes the upper layer handler
+*   from pal_usb_handle_events, which is run by the event thread started in pal_init.
+* - The state of the operation is kept in the #pal_usb_t of the device, hence each device has its own bus.
+*/
+#if defined(PAL_USB_ASYNC) && defined(__WIN32__)
+#error "PAL_USB_ASYNC requires poll based libusb event handling (Linux)"
+#endif
+
 /// @cond hidden
 /*********************************************************************************************************************
  * LOCAL DATA
@@ -190,6 +206,384 @@ uint16_t usb_i2c_poll_operation_result(pal_i2c_t * p_i2c_context)
     }
 }
 
+#ifdef PAL_USB_BATCHED_TRANSFERS
+#ifdef PAL_USB_ASYNC
+// Completions are handled by the event thread, while the batch might still be submitted
+#define PAL_USB_BATCH_ACQUIRE(p_batch)      ((void)__sync_add_and_fetch(&(p_batch)->pending, 1))
+#define PAL_USB_BATCH_RELEASE(p_batch)      (0 == __sync_sub_and_fetch(&(p_batch)->pending, 1))
+
+#define PAL_USB_OPERATION_WRITE             (0x01)
+#define PAL_USB_OPERATION_READ              (0x02)
+
+static void pal_usb_async_batch_done(pal_usb_t * pal_usb);
+#else
+#define PAL_USB_BATCH_ACQUIRE(p_batch)      ((p_batch)->pending++)
+#define PAL_USB_BATCH_RELEASE(p_batch)      (0 == --(p_batch)->pending)
+#endif
+
+static void LIBUSB_CALL pal_usb_batch_transfer_done(struct libusb_transfer * transfer)
+{
+    pal_usb_t * pal_usb = (pal_usb_t *)transfer->user_data;
+
+    // Input reports are shorter than requested, if the bridge has less data
+    if ((LIBUSB_TRANSFER_COMPLETED != transfer->status) ||
+        ((0 == (transfer->endpoint & LIBUSB_ENDPOINT_IN)) && (transfer->actual_length != transfer->length)))
+    {
+        pal_usb->batch.failed = TRUE;
+    }
+    if (PAL_USB_BATCH_RELEASE(&pal_usb->batch))
+    {
+#ifdef PAL_USB_ASYNC
+        pal_usb_async_batch_done(pal_usb);
+#endif
+    }
+}
+
+// Submits all the transfers of the batch, returns TRUE if none of them is in flight anymore
+static uint8_t pal_usb_batch_submit(pal_usb_t * pal_usb)
+{
+    pal_usb_batch_t * p_batch = &pal_usb->batch;
+    uint8_t index;
+    uint8_t submitted;
+
+    // The batch is owned until all the transfers are submitted
+    p_batch->pending = 1;
+    p_batch->failed = FALSE;
+    for (submitted = 0; submitted < p_batch->count; submitted++)
+    {
+        libusb_fill_interrupt_transfer(p_batch->transfers[submitted],
+                                       pal_usb->handle,
+                                       p_batch->endpoints[submitted],
+                                       p_batch->reports[submitted],
+                                       HID_REPORT_SIZE,
+                                       pal_usb_batch_transfer_done,
+                                       pal_usb,
+                                       USB_TIMEOUT);
+        PAL_USB_BATCH_ACQUIRE(p_batch);
+        if (0 != libusb_submit_transfer(p_batch->transfers[submitted]))
+        {
+            (void)PAL_USB_BATCH_RELEASE(p_batch);
+            p_batch->failed = TRUE;
+            break;
+        }
+    }
+    if (TRUE == p_batch->failed)
+    {
+        // Completed transfers are not found, hence only the pending ones are cancelled
+        for (index = 0; index < submitted; index++)
+        {
+            (void)libusb_cancel_transfer(p_batch->transfers[index]);
+        }
+    }
+
+    return (PAL_USB_BATCH_RELEASE(p_batch) ? TRUE : FALSE);
+}
+
+#ifndef PAL_USB_ASYNC
+// Submits all the transfers of the batch and waits for their completion
+static uint16_t pal_usb_batch_run(pal_usb_t * pal_usb)
+{
+    pal_usb_batch_t * p_batch = &pal_usb->batch;
+    uint8_t index;
+    uint8_t cancelled = FALSE;
+
+    if (FALSE == pal_usb_batch_submit(pal_usb))
+    {
+        while (0 < p_batch->pending)
+        {
+            if ((TRUE == p_batch->failed) && (FALSE == cancelled))
+            {
+                for (index = 0; index < p_batch->count; index++)
+                {
+                    (void)libusb_cancel_transfer(p_batch->transfers[index]);
+                }
+                cancelled = TRUE;
+            }
+            (void)libusb_handle_events_completed(NULL, NULL);
+        }
+    }
+
+    return ((TRUE == p_batch->failed) ? PAL_I2C_EVENT_ERROR : PAL_I2C_EVENT_SUCCESS);
+}
+#endif
+
+// Prepares the reports of a write, split into reports of up to PAL_USB_I2C_REPORT_DATA_SIZE bytes
+static pal_status_t pal_usb_i2c_prepare_write(pal_usb_t * pal_usb, uint8_t slave_address,
+                                              const uint8_t * p_data, uint16_t length)
+{
+    pal_usb_batch_t * p_batch = &pal_usb->batch;
+    uint16_t offset = 0;
+    uint16_t chunk;
+    uint8_t * report;
+
+    if ((0 == length) || (length > (PAL_USB_MAX_BATCH_SIZE * PAL_USB_I2C_REPORT_DATA_SIZE)))
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    p_batch->count = 0;
+    while (offset < length)
+    {
+        chunk = ((length - offset) > PAL_USB_I2C_REPORT_DATA_SIZE) ? PAL_USB_I2C_REPORT_DATA_SIZE :
+                                                                     (length - offset);
+        report = p_batch->reports[p_batch->count];
+        memset(report, 0x00, HID_REPORT_SIZE);
+        report[0] = REPORT_ID_I2C_WRITE_REQ;
+        report[1] = slave_address;
+        // Start with the first report and stop with the last one, the reports in between continue the write
+        report[2] = ((0 == offset) ? I2C_FLAG_START : 0) | (((offset + chunk) == length) ? I2C_FLAG_STOP : 0);
+        report[3] = (uint8_t)chunk;
+        memcpy(&report[4], &p_data[offset], chunk);
+        p_batch->endpoints[p_batch->count] = pal_usb->hid_ep_out;
+        p_batch->count++;
+        offset += chunk;
+    }
+    return PAL_STATUS_SUCCESS;
+}
+
+// Prepares the read request and the input reports of a read
+static pal_status_t pal_usb_i2c_prepare_read(pal_usb_t * pal_usb, uint8_t slave_address, uint16_t length)
+{
+    pal_usb_batch_t * p_batch = &pal_usb->batch;
+    uint8_t * report = p_batch->reports[0];
+    uint8_t index;
+
+    if ((0 == length) || (length > ((PAL_USB_MAX_BATCH_SIZE - 1) * PAL_USB_I2C_REPORT_DATA_SIZE)))
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    memset(report, 0x00, HID_REPORT_SIZE);
+    report[0] = REPORT_ID_I2C_READ_REQ;
+    report[1] = slave_address;
+    report[2] = I2C_FLAG_START | I2C_FLAG_STOP;
+    report[3] = (uint8_t)length;
+    report[4] = (uint8_t)(length >> 8);
+    p_batch->endpoints[0] = pal_usb->hid_ep_out;
+    // Input reports are pending already, when the bridge starts to return the data
+    p_batch->count = (uint8_t)(1 + ((length + PAL_USB_I2C_REPORT_DATA_SIZE - 1) / PAL_USB_I2C_REPORT_DATA_SIZE));
+    for (index = 1; index < p_batch->count; index++)
+    {
+        memset(p_batch->reports[index], 0x00, HID_REPORT_SIZE);
+        p_batch->endpoints[index] = pal_usb->hid_ep_in;
+    }
+    return PAL_STATUS_SUCCESS;
+}
+
+// Copies the data of the input reports, fails if the bridge returned less or more than requested
+static pal_status_t pal_usb_i2c_collect_read(pal_usb_t * pal_usb, uint8_t * p_data, uint16_t length)
+{
+    pal_usb_batch_t * p_batch = &pal_usb->batch;
+    uint16_t received = 0;
+    uint8_t * report;
+    uint8_t index;
+
+    for (index = 1; (FALSE == p_batch->failed) && (index < p_batch->count); index++)
+    {
+        report = p_batch->reports[index];
+        if ((report[1] > PAL_USB_I2C_REPORT_DATA_SIZE) || ((received + report[1]) > length))
+        {
+            break;
+        }
+        memcpy(&p_data[received], &report[2], report[1]);
+        received += report[1];
+    }
+    return ((received == length) ? PAL_STATUS_SUCCESS : PAL_STATUS_FAILURE);
+}
+
+#ifndef PAL_USB_ASYNC
+static uint16_t pal_usb_i2c_write_batched(pal_i2c_t * p_i2c_context, const uint8_t * p_data, uint16_t length)
+{
+    pal_usb_t * pal_usb = (pal_usb_t * ) p_i2c_context->p_i2c_hw_config;
+    uint16_t result = PAL_I2C_EVENT_ERROR;
+
+    do
+    {
+        if (PAL_STATUS_SUCCESS != pal_usb_i2c_prepare_write(pal_usb, p_i2c_context->slave_address, p_data, length))
+        {
+            break;
+        }
+        if (PAL_I2C_EVENT_SUCCESS != pal_usb_batch_run(pal_usb))
+        {
+            break;
+        }
+        // NACK of the slave (e.g. busy) is reported only by the status
+        result = (usb_i2c_poll_operation_result(p_i2c_context) == PAL_STATUS_SUCCESS) ? PAL_I2C_EVENT_SUCCESS :
+                                                                                         PAL_I2C_EVENT_ERROR;
+    } while (0);
+
+    return result;
+}
+
+static uint16_t pal_usb_i2c_read_batched(pal_i2c_t * p_i2c_context, uint8_t * p_data, uint16_t length)
+{
+    pal_usb_t * pal_usb = (pal_usb_t * ) p_i2c_context->p_i2c_hw_config;
+    uint16_t result = PAL_I2C_EVENT_ERROR;
+
+    do
+    {
+        if (PAL_STATUS_SUCCESS != pal_usb_i2c_prepare_read(pal_usb, p_i2c_context->slave_address, length))
+        {
+            break;
+        }
+        (void)pal_usb_batch_run(pal_usb);
+        if (PAL_STATUS_SUCCESS == pal_usb_i2c_collect_read(pal_usb, p_data, length))
+        {
+            result = PAL_I2C_EVENT_SUCCESS;
+            break;
+        }
+        // Status is read to complete the failed operation on the bridge (e.g. NACK of the slave)
+        (void)usb_i2c_poll_operation_result(p_i2c_context);
+    } while (0);
+
+    return result;
+}
+#else
+// Completes the ongoing operation of the device and invokes the upper layer handler
+static void pal_usb_async_complete(pal_usb_t * pal_usb, optiga_lib_status_t event)
+{
+    const pal_i2c_t * p_i2c_context = pal_usb->batch.p_i2c_context;
+
+    // The bus is free again, the upper layer handler may start the next operation
+    pal_usb->batch.p_i2c_context = NULL;
+    //lint --e{611} suppress "void* function pointer is type casted to app_event_handler_t type"
+    ((upper_layer_callback_t)(p_i2c_context->upper_layer_event_handler))
+                                                    (p_i2c_context->p_upper_layer_ctx, event);
+}
+
+static void LIBUSB_CALL pal_usb_async_status_done(struct libusb_transfer * transfer);
+
+// Submits the control transfer reading the I2C status of the bridge
+static void pal_usb_async_poll_status(pal_usb_t * pal_usb)
+{
+    pal_usb_batch_t * p_batch = &pal_usb->batch;
+
+    libusb_fill_control_setup(p_batch->status_buffer,
+                              LIBUSB_ENDPOINT_IN | LIBUSB_REQUEST_TYPE_CLASS | LIBUSB_RECIPIENT_INTERFACE,
+                              HID_REQ_GET_REPORT,
+                              (HID_REPORT_TYPE_FEATURE << 8) | REPORT_ID_I2C_STATUS,
+                              USB_INTERFACE,
+                              HID_REPORT_SIZE);
+    libusb_fill_control_transfer(p_batch->status_transfer,
+                                 pal_usb->handle,
+                                 p_batch->status_buffer,
+                                 pal_usb_async_status_done,
+                                 pal_usb,
+                                 USB_TIMEOUT);
+    if (0 != libusb_submit_transfer(p_batch->status_transfer))
+    {
+        pal_usb_async_complete(pal_usb, PAL_I2C_EVENT_ERROR);
+    }
+}
+
+// Evaluates the I2C status the same as usb_i2c_poll_operation_result, polls again while the bridge is busy
+static void LIBUSB_CALL pal_usb_async_status_done(struct libusb_transfer * transfer)
+{
+    pal_usb_t * pal_usb = (pal_usb_t *)transfer->user_data;
+    uint8_t * report = libusb_control_transfer_get_data(transfer);
+
+    do
+    {
+        if ((LIBUSB_TRANSFER_COMPLETED != transfer->status) || (5 != transfer->actual_length))
+        {
+            pal_usb_async_complete(pal_usb, PAL_I2C_EVENT_ERROR);
+            break;
+        }
+        if (!(report[1] & I2C_STATUS_CONTROLLER_BUSY))
+        {
+            if (report[1] & I2C_STATUS_ERROR_CONDITION)
+            {
+                pal_usb_async_complete(pal_usb, PAL_I2C_EVENT_ERROR);
+                break;
+            }
+            if ((report[1] & I2C_STATUS_CONTROLLER_IDLE) && !(report[1] & I2C_STATUS_BUS_BUSY))
+            {
+                // A failed read completes with error, after the bridge is idle again
+                pal_usb_async_complete(pal_usb, (TRUE == pal_usb->batch.failed) ? PAL_I2C_EVENT_ERROR :
+                                                                                  PAL_I2C_EVENT_SUCCESS);
+                break;
+            }
+        }
+        pal_usb_async_poll_status(pal_usb);
+    } while (0);
+}
+
+// Continues the ongoing operation, after all the transfers of the batch are completed
+static void pal_usb_async_batch_done(pal_usb_t * pal_usb)
+{
+    pal_usb_batch_t * p_batch = &pal_usb->batch;
+
+    do
+    {
+        if (PAL_USB_OPERATION_WRITE == p_batch->operation)
+        {
+            if (TRUE == p_batch->failed)
+            {
+                pal_usb_async_complete(pal_usb, PAL_I2C_EVENT_ERROR);
+                break;
+            }
+            // NACK of the slave (e.g. busy) is reported only by the status
+            pal_usb_async_poll_status(pal_usb);
+            break;
+        }
+        if (PAL_STATUS_SUCCESS == pal_usb_i2c_collect_read(pal_usb, p_batch->p_read_data, p_batch->length))
+        {
+            pal_usb_async_complete(pal_usb, PAL_I2C_EVENT_SUCCESS);
+            break;
+        }
+        // Status is read to complete the failed operation on the bridge (e.g. NACK of the slave)
+        p_batch->failed = TRUE;
+        pal_usb_async_poll_status(pal_usb);
+    } while (0);
+}
+
+// Starts an I2C operation, which is completed by pal_usb_handle_events
+static pal_status_t pal_usb_i2c_start(const pal_i2c_t * p_i2c_context, uint8_t operation,
+                                      uint8_t * p_data, uint16_t length)
+{
+    pal_usb_t * pal_usb = (pal_usb_t * ) p_i2c_context->p_i2c_hw_config;
+    pal_status_t status = PAL_STATUS_FAILURE;
+
+    do
+    {
+        // Each device has its own bus, which is busy until the completion of the ongoing operation
+        if (NULL != pal_usb->batch.p_i2c_context)
+        {
+            status = PAL_STATUS_I2C_BUSY;
+            //lint --e{611} suppress "void* function pointer is type casted to app_event_handler_t type"
+            ((upper_layer_callback_t)(p_i2c_context->upper_layer_event_handler))
+                                                        (p_i2c_context->p_upper_layer_ctx, PAL_I2C_EVENT_BUSY);
+            break;
+        }
+        if (PAL_USB_OPERATION_WRITE == operation)
+        {
+            status = pal_usb_i2c_prepare_write(pal_usb, p_i2c_context->slave_address, p_data, length);
+        }
+        else
+        {
+            status = pal_usb_i2c_prepare_read(pal_usb, p_i2c_context->slave_address, length);
+        }
+        if (PAL_STATUS_SUCCESS != status)
+        {
+            //lint --e{611} suppress "void* function pointer is type casted to app_event_handler_t type"
+            ((upper_layer_callback_t)(p_i2c_context->upper_layer_event_handler))
+                                                        (p_i2c_context->p_upper_layer_ctx, PAL_I2C_EVENT_ERROR);
+            break;
+        }
+        pal_usb->batch.p_i2c_context = p_i2c_context;
+        pal_usb->batch.operation = operation;
+        pal_usb->batch.p_read_data = p_data;
+        pal_usb->batch.length = length;
+        if (TRUE == pal_usb_batch_submit(pal_usb))
+        {
+            // Nothing is in flight, e.g. the submission failed
+            pal_usb_async_batch_done(pal_usb);
+        }
+    } while (0);
+
+    return status;
+}
+#endif //PAL_USB_ASYNC
+#endif //PAL_USB_BATCHED_TRANSFERS
+
 /// @endcond
 /**********************************************************************************************************************
  * API IMPLEMENTATION
@@ -220,6 +614,32 @@ uint16_t usb_i2c_poll_operation_result(pal_i2c_t * p_i2c_context)
  */
 pal_status_t pal_i2c_init(const pal_i2c_t * p_i2c_context)
 {
+#ifdef PAL_USB_BATCHED_TRANSFERS
+    pal_usb_batch_t * p_batch = &((pal_usb_t * ) p_i2c_context->p_i2c_hw_config)->batch;
+    uint8_t index;
+
+    for (index = 0; index < PAL_USB_MAX_BATCH_SIZE; index++)
+    {
+        if (NULL == p_batch->transfers[index])
+        {
+            p_batch->transfers[index] = libusb_alloc_transfer(0);
+            if (NULL == p_batch->transfers[index])
+            {
+                return PAL_STATUS_FAILURE;
+            }
+        }
+    }
+#ifdef PAL_USB_ASYNC
+    if (NULL == p_batch->status_transfer)
+    {
+        p_batch->status_transfer = libusb_alloc_transfer(0);
+        if (NULL == p_batch->status_transfer)
+        {
+            return PAL_STATUS_FAILURE;
+        }
+    }
+#endif
+#endif //PAL_USB_BATCHED_TRANSFERS
     return PAL_STATUS_SUCCESS;
 }
 
@@ -247,6 +667,20 @@ pal_status_t pal_i2c_init(const pal_i2c_t * p_i2c_context)
  */
 pal_status_t pal_i2c_deinit(const pal_i2c_t * p_i2c_context)
 {
+#ifdef PAL_USB_BATCHED_TRANSFERS
+    pal_usb_batch_t * p_batch = &((pal_usb_t * ) p_i2c_context->p_i2c_hw_config)->batch;
+    uint8_t index;
+
+    for (index = 0; index < PAL_USB_MAX_BATCH_SIZE; index++)
+    {
+        libusb_free_transfer(p_batch->transfers[index]);
+        p_batch->transfers[index] = NULL;
+    }
+#ifdef PAL_USB_ASYNC
+    libusb_free_transfer(p_batch->status_transfer);
+    p_batch->status_transfer = NULL;
+#endif
+#endif //PAL_USB_BATCHED_TRANSFERS
     LOG_PAL("pal_i2c_deinit\n. ");
     return PAL_STATUS_SUCCESS;
 }
@@ -292,19 +726,43 @@ pal_status_t pal_i2c_write(const pal_i2c_t * p_i2c_context, uint8_t * p_data, ui
     pal_usb_t * pal_usb;
     uint8_t report[HID_REPORT_SIZE] = {0};
 
+#ifdef PAL_USB_ASYNC
+    (void)usb_lib_status;
+    (void)transfered;
+    (void)pal_usb;
+    (void)report;
+    status = pal_usb_i2c_start(p_i2c_context, PAL_USB_OPERATION_WRITE, p_data, length);
+#else
     pal_usb = (pal_usb_t * ) p_i2c_context->p_i2c_hw_config;
+#ifndef PAL_USB_BATCHED_TRANSFERS
     report[0] = REPORT_ID_I2C_WRITE_REQ;
     report[1] = p_i2c_context->slave_address;
     report[2] = I2C_FLAG_START | I2C_FLAG_STOP;
     report[3] = (uint8_t)length;
 
     memcpy(&report[4], p_data, length);
+#endif
     //Acquire the I2C bus before read/write
 
     if (PAL_STATUS_SUCCESS == pal_i2c_acquire(p_i2c_context))
     {
         gp_pal_i2c_current_ctx = (pal_i2c_t *)p_i2c_context;
 
+#ifdef PAL_USB_BATCHED_TRANSFERS
+        (void)pal_usb;
+        (void)report;
+        (void)usb_lib_status;
+        (void)transfered;
+        if (PAL_I2C_EVENT_SUCCESS == pal_usb_i2c_write_batched(gp_pal_i2c_current_ctx, p_data, length))
+        {
+            i2c_master_end_of_transmit_callback();
+            status = PAL_STATUS_SUCCESS;
+        }
+        else
+        {
+            invoke_upper_layer_callback(gp_pal_i2c_current_ctx, PAL_I2C_EVENT_ERROR);
+        }
+#else
         //Invoke the low level i2c master driver API to write to the bus
         usb_lib_status = libusb_interrupt_transfer(pal_usb->handle,
                                                    pal_usb->hid_ep_out,
@@ -333,6 +791,7 @@ pal_status_t pal_i2c_write(const pal_i2c_t * p_i2c_context, uint8_t * p_data, ui
                 invoke_upper_layer_callback(gp_pal_i2c_current_ctx, PAL_I2C_EVENT_ERROR);
             }
         }
+#endif //PAL_USB_BATCHED_TRANSFERS
     }
     else
     {
@@ -341,6 +800,7 @@ pal_status_t pal_i2c_write(const pal_i2c_t * p_i2c_context, uint8_t * p_data, ui
         ((upper_layer_callback_t)(p_i2c_context->upper_layer_event_handler))
                                                         (p_i2c_context->p_upper_layer_ctx, PAL_I2C_EVENT_BUSY);
     }
+#endif //PAL_USB_ASYNC
 
     return status;
 }
@@ -385,6 +845,13 @@ pal_status_t pal_i2c_read(const pal_i2c_t * p_i2c_context, uint8_t * p_data, uin
     pal_usb_t * pal_usb;
     LOG_PAL("[IFX-HAL]: I2C RX (%d)\n", length);
 
+#ifdef PAL_USB_ASYNC
+    (void)transfered;
+    (void)report;
+    (void)rx_result;
+    (void)pal_usb;
+    usb_lib_status = pal_usb_i2c_start(p_i2c_context, PAL_USB_OPERATION_READ, p_data, length);
+#else
     report[0] = REPORT_ID_I2C_READ_REQ;
     report[1] = p_i2c_context->slave_address;
     report[2] = I2C_FLAG_START | I2C_FLAG_STOP;
@@ -395,6 +862,21 @@ pal_status_t pal_i2c_read(const pal_i2c_t * p_i2c_context, uint8_t * p_data, uin
     if (PAL_STATUS_SUCCESS == pal_i2c_acquire(p_i2c_context))
     {
         gp_pal_i2c_current_ctx = (pal_i2c_t *)p_i2c_context;
+#ifdef PAL_USB_BATCHED_TRANSFERS
+        (void)pal_usb;
+        (void)report;
+        (void)rx_result;
+        (void)transfered;
+        if (PAL_I2C_EVENT_SUCCESS == pal_usb_i2c_read_batched(gp_pal_i2c_current_ctx, p_data, length))
+        {
+            usb_lib_status = PAL_STATUS_SUCCESS;
+            i2c_master_end_of_receive_callback();
+        }
+        else
+        {
+            invoke_upper_layer_callback(gp_pal_i2c_current_ctx, PAL_I2C_EVENT_ERROR);
+        }
+#else
         usb_lib_status = libusb_interrupt_transfer(pal_usb->handle,
                                                    pal_usb->hid_ep_out,
                                                    report,
@@ -434,6 +916,7 @@ pal_status_t pal_i2c_read(const pal_i2c_t * p_i2c_context, uint8_t * p_data, uin
             //Release I2C Bus
             pal_i2c_release((void * )p_i2c_context);
         }
+#endif //PAL_USB_BATCHED_TRANSFERS
     }
     else
     {
@@ -442,6 +925,7 @@ pal_status_t pal_i2c_read(const pal_i2c_t * p_i2c_context, uint8_t * p_data, uin
         ((upper_layer_callback_t)(p_i2c_context->upper_layer_event_handler))
                                                         (p_i2c_context->p_upper_layer_ctx, PAL_I2C_EVENT_BUSY);
     }
+#endif //PAL_USB_ASYNC
     return usb_lib_status;
 }
 
@@ -67,27 +67,43 @@
 
 /// @cond hidden
 
-static pal_os_event_t pal_os_event_0 = {0};
+/// Number of events, one for each OPTIGA instance
+#ifdef OPTIGA_MAX_NUMBER_OF_INSTANCES
+#define PAL_OS_EVENT_MAX_INSTANCES OPTIGA_MAX_NUMBER_OF_INSTANCES
+#else
+#define PAL_OS_EVENT_MAX_INSTANCES (1)
+#endif
+/// Index of the event in the list
+#define PAL_OS_EVENT_INDEX(p_event) ((p_event) - pal_os_event_list)
+
+static pal_os_event_t pal_os_event_list[PAL_OS_EVENT_MAX_INSTANCES] = {0};
+#define pal_os_event_0 (pal_os_event_list[0])
 #ifdef __WIN32__
+// The timers of all the events are created on one timer queue
 HANDLE gTimerQueue = NULL;
-HANDLE gTimer = NULL;
+static HANDLE timer_list[PAL_OS_EVENT_MAX_INSTANCES];
+static uint8_t timer_count = 0;
 #else
 #define CLOCKID CLOCK_REALTIME
 #define SIG SIGRTMIN
-static     timer_t timerid;
+static     timer_t timerid_list[PAL_OS_EVENT_MAX_INSTANCES];
 #endif
 
+static void pal_os_event_trigger(pal_os_event_t * p_pal_os_event);
+
 #ifdef __WIN32__
 VOID CALLBACK TimerRoutine(PVOID lpParam, BOOLEAN TimerOrWaitFired)
 {
-	pal_os_event_trigger_registered_callback();
+	// timer of each event carries the event as parameter
+	pal_os_event_trigger((pal_os_event_t *)lpParam);
 	//printf("<- \r\n");
 }
 #else
 static void handler(int sig, siginfo_t *si, void *uc)
 {
 	TRUSTM_PAL_EVENT_DBGFN(">");
-	pal_os_event_trigger_registered_callback();
+	// timer of each event carries the event as signal value
+	pal_os_event_trigger((pal_os_event_t *)si->si_value.sival_ptr);
 	TRUSTM_PAL_EVENT_DBGFN("<");
 }
 #endif
@@ -107,36 +123,76 @@ void pal_os_event_stop(pal_os_event_t * p_pal_os_event)
     p_pal_os_event->is_event_triggered = FALSE;
 }
 
+/*
+* Picks the first event, which is not in use by another OPTIGA instance
+*/
+static pal_os_event_t * pal_os_event_allocate(void)
+{
+    uint8_t index;
+
+    for (index = 0; index < PAL_OS_EVENT_MAX_INSTANCES; index++)
+    {
+        if (NULL == pal_os_event_list[index].os_timer)
+        {
+            return (&pal_os_event_list[index]);
+        }
+    }
+    TRUSTM_PAL_EVENT_ERRFN("No free event\n");
+    return (NULL);
+}
+
+void pal_os_event_trigger_registered_callback(void)
+{
+    pal_os_event_trigger(&pal_os_event_0);
+}
+
 #ifdef __WIN32__
 pal_os_event_t * pal_os_event_create(register_callback callback, void * callback_args)
 {	
+	pal_os_event_t * p_pal_os_event = &pal_os_event_0;
+
 	if ((NULL != callback) && (NULL != callback_args))
 	{
-		// Create the timer queue.
-		gTimerQueue = CreateTimerQueue();
-		if (NULL == gTimerQueue)
+		p_pal_os_event = pal_os_event_allocate();
+		if (NULL == p_pal_os_event)
 		{
-			printf("CreateTimerQueue failed (%d)\n", GetLastError());
 			return NULL;
 		}
-		pal_os_event_start(&pal_os_event_0, callback, callback_args);
+		// Create the timer queue with the first event
+		if (NULL == gTimerQueue)
+		{
+			gTimerQueue = CreateTimerQueue();
+			if (NULL == gTimerQueue)
+			{
+				printf("CreateTimerQueue failed (%d)\n", GetLastError());
+				return NULL;
+			}
+		}
+		timer_count++;
+		p_pal_os_event->os_timer = &timer_list[PAL_OS_EVENT_INDEX(p_pal_os_event)];
+		pal_os_event_start(p_pal_os_event, callback, callback_args);
 	}
     
-    return (&pal_os_event_0);
+    return (p_pal_os_event);
 }
 
 
-void pal_os_event_trigger_registered_callback(void)
+static void pal_os_event_trigger(pal_os_event_t * p_pal_os_event)
 {
     register_callback callback;
+    HANDLE * p_timer = &timer_list[PAL_OS_EVENT_INDEX(p_pal_os_event)];
 
-	DeleteTimerQueueTimer( gTimerQueue, gTimer, NULL );
+	if (NULL != *p_timer)
+	{
+		DeleteTimerQueueTimer( gTimerQueue, *p_timer, NULL );
+		*p_timer = NULL;
+	}
 
-    if (pal_os_event_0.callback_registered)
+    if (p_pal_os_event->callback_registered)
     {
-        callback = pal_os_event_0.callback_registered;
-        pal_os_event_0.callback_registered = NULL;
-        callback((void * )pal_os_event_0.callback_ctx);
+        callback = p_pal_os_event->callback_registered;
+        p_pal_os_event->callback_registered = NULL;
+        callback((void * )p_pal_os_event->callback_ctx);
     }
 
 }
@@ -163,8 +219,8 @@ void pal_os_event_register_callback_oneshot(pal_os_event_t * p_pal_os_event,
 		p_pal_os_event->callback_ctx = callback_args;
 
 		// Set a timer to call the timer routine.
-		if (!CreateTimerQueueTimer(&gTimer, gTimerQueue,
-			(WAITORTIMERCALLBACK)TimerRoutine, &uTimerLoad, 0, 0, 0))
+		if (!CreateTimerQueueTimer(&timer_list[PAL_OS_EVENT_INDEX(p_pal_os_event)], gTimerQueue,
+			(WAITORTIMERCALLBACK)TimerRoutine, (PVOID)p_pal_os_event, uTimerLoad, 0, 0))
 		{
 			printf("CreateTimerQueueTimer failed (%d)\n", GetLastError());
 			return;
@@ -175,15 +231,28 @@ void pal_os_event_register_callback_oneshot(pal_os_event_t * p_pal_os_event,
 //lint --e{818,715} suppress "As there is no implementation, pal_os_event is not used"
 void pal_os_event_destroy(pal_os_event_t * pal_os_event)
 { 
-	if (!DeleteTimerQueue(gTimerQueue))
-		printf("DeleteTimerQueue failed (%d)\n", GetLastError());
+	if ((NULL == pal_os_event) || (NULL == pal_os_event->os_timer))
+	{
+		return;
+	}
+	pal_os_event_stop(pal_os_event);
+	pal_os_event->callback_registered = NULL;
+	// event is free for next create
+	pal_os_event->os_timer = NULL;
+	// The timer queue is deleted with the last event, which deletes the pending timers
+	if (0 == --timer_count)
+	{
+		if (!DeleteTimerQueue(gTimerQueue))
+			printf("DeleteTimerQueue failed (%d)\n", GetLastError());
 
-	gTimerQueue = NULL;
+		gTimerQueue = NULL;
+	}
 }
 #else
 
 pal_os_event_t * pal_os_event_create(register_callback callback, void * callback_args)
 {
+    pal_os_event_t * p_pal_os_event = &pal_os_event_0;
     struct sigevent sev;
     struct sigaction sa;
     
@@ -191,6 +260,12 @@ pal_os_event_t * pal_os_event_create(register_callback callback, void * callback
     
     if(( NULL != callback )&&( NULL != callback_args ))
     {
+        p_pal_os_event = pal_os_event_allocate();
+        if (NULL == p_pal_os_event)
+        {
+            return (NULL);
+        }
+
         /* Establishing handler for signal */
         sa.sa_flags = SA_SIGINFO;
         sa.sa_sigaction = handler;
@@ -205,44 +280,50 @@ pal_os_event_t * pal_os_event_create(register_callback callback, void * callback
 
         sev.sigev_notify = SIGEV_SIGNAL;
         sev.sigev_signo = SIG;
-        sev.sigev_value.sival_ptr = &timerid;
-        if (timer_create(CLOCKID, &sev, &timerid) == -1)
+        sev.sigev_value.sival_ptr = p_pal_os_event;
+        if (timer_create(CLOCKID, &sev, &timerid_list[PAL_OS_EVENT_INDEX(p_pal_os_event)]) == -1)
         {
             printf("error in timer_create\n");
             exit(1);
         }
+        p_pal_os_event->os_timer = &timerid_list[PAL_OS_EVENT_INDEX(p_pal_os_event)];
 
-        pal_os_event_start(&pal_os_event_0,callback,callback_args);
+        pal_os_event_start(p_pal_os_event,callback,callback_args);
     }
     
     TRUSTM_PAL_EVENT_DBGFN("<");
     
-    return (&pal_os_event_0);
+    return (p_pal_os_event);
 }
 	
-void pal_os_event_trigger_registered_callback(void)
+static void pal_os_event_trigger(pal_os_event_t * p_pal_os_event)
 {
     register_callback callback;
     struct itimerspec its;
 
     TRUSTM_PAL_EVENT_DBGFN(">");  
     
+    if (NULL == p_pal_os_event->os_timer)
+    {
+        return;
+    }
+
     its.it_value.tv_sec = 0;
     its.it_value.tv_nsec = 0;
     its.it_interval.tv_sec = 0;
     its.it_interval.tv_nsec = 0;
     
-    if (timer_settime(timerid, 0, &its, NULL) == -1)
+    if (timer_settime(*(timer_t *)p_pal_os_event->os_timer, 0, &its, NULL) == -1)
     {
         fprintf(stderr, "Error in timer_settime\n");
         exit(1);
     }
 
-    if (pal_os_event_0.callback_registered)
+    if (p_pal_os_event->callback_registered)
     {
-        callback = pal_os_event_0.callback_registered;
-        pal_os_event_0.callback_registered = NULL;
-        callback((void * )pal_os_event_0.callback_ctx);
+        callback = p_pal_os_event->callback_registered;
+        p_pal_os_event->callback_registered = NULL;
+        callback((void * )p_pal_os_event->callback_ctx);
     }
 
     TRUSTM_PAL_EVENT_DBGFN("<"); 
@@ -271,7 +352,7 @@ void pal_os_event_register_callback_oneshot(pal_os_event_t * p_pal_os_event,
     its.it_interval.tv_sec = 0;
     its.it_interval.tv_nsec = 0;
     
-    if (( ret = timer_settime(timerid, 0, &its, NULL)) == -1)    
+    if (( ret = timer_settime(*(timer_t *)p_pal_os_event->os_timer, 0, &its, NULL)) == -1)    
     {
         int errsv = errno;
         fprintf(stderr,"timer_settime FAILED!!!\n");
@@ -293,11 +374,13 @@ void pal_os_event_register_callback_oneshot(pal_os_event_t * p_pal_os_event,
 void pal_os_event_destroy(pal_os_event_t * pal_os_event)
 {
     TRUSTM_PAL_EVENT_DBGFN(">");
-    if (pal_os_event != NULL)
-        pal_os_event_stop(pal_os_event);
-    if (timerid != 0)
+    if ((pal_os_event != NULL) && (NULL != pal_os_event->os_timer))
     {
-        timer_delete(timerid);
+        pal_os_event_stop(pal_os_event);
+        timer_delete(*(timer_t *)pal_os_event->os_timer);
+        // event is free for next create
+        pal_os_event->os_timer = NULL;
+        pal_os_event->callback_registered = NULL;
     }
     TRUSTM_PAL_EVENT_DBGFN("<"); 
 }
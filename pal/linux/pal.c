@@ -35,6 +35,11 @@
 */
 
 #include "optiga/pal/pal.h"
+#ifdef PAL_LOGGER_ASYNC
+#include "optiga/pal/pal_logger.h"
+
+extern pal_logger_t logger_console;
+#endif
 
 /**
  * @brief Initializes the PAL layer
@@ -53,7 +58,12 @@
  */
 pal_status_t pal_init(void)
 {
+#ifdef PAL_LOGGER_ASYNC
+    // Starts the drain thread of the asynchronous logger
+    return pal_logger_init(&logger_console);
+#else
     return PAL_STATUS_SUCCESS;
+#endif
 }
 
 /**
@@ -73,7 +83,12 @@ pal_status_t pal_init(void)
  */
 pal_status_t pal_deinit(void)
 {
+#ifdef PAL_LOGGER_ASYNC
+    // Writes the pending messages of the asynchronous logger
+    return pal_logger_deinit(&logger_console);
+#else
     return PAL_STATUS_SUCCESS;
+#endif
 }
 
 /**
@@ -39,7 +39,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
+#include <string.h>
 #include "errno.h"
+#ifdef PAL_GPIO_CHARDEV
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+#endif
 
 #include "optiga/pal/pal_gpio.h"
 #include "optiga/pal/pal_ifx_i2c_config.h"
@@ -51,6 +57,77 @@
 #define LOW  0
 #define HIGH 1
 
+// Define PAL_GPIO_CHARDEV to drive the lines through the GPIO character device (/dev/gpiochipN, uAPI v2)
+// instead of the deprecated sysfs interface.
+// - The line is requested once at init and its handle is kept open, setting a value is one ioctl.
+// - The interrupt pin is requested as an edge event line, see pal_gpio_register_irq.
+#ifdef PAL_GPIO_CHARDEV
+/// GPIO chip used, unless the chip is set in the GPIO context (pal_linux_gpio_t)
+#ifndef PAL_GPIO_CHIP
+#define PAL_GPIO_CHIP "/dev/gpiochip0"
+#endif
+/// Edge of the interrupt pin, which signals the data ready state
+#ifndef PAL_GPIO_IRQ_EDGE
+#define PAL_GPIO_IRQ_EDGE GPIO_V2_LINE_FLAG_EDGE_RISING
+#endif
+
+// Requests the line with the flags and returns the line handle
+static int pal_gpio_request_line(const pal_linux_gpio_t * gpio, uint64_t flags)
+{
+    struct gpio_v2_line_request request;
+    int chip_fd;
+    int line_fd = -1;
+
+    chip_fd = open((NULL != gpio->chip) ? gpio->chip : PAL_GPIO_CHIP, O_RDONLY | O_CLOEXEC);
+    if (-1 == chip_fd) {
+        fprintf(stderr, "Failed to open gpio chip!\n");
+        return(-1);
+    }
+    memset(&request, 0, sizeof(request));
+    request.offsets[0] = gpio->pin_nr;
+    request.num_lines = 1;
+    request.config.flags = flags;
+    strncpy(request.consumer, "optiga", sizeof(request.consumer) - 1);
+    if (-1 == ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &request)) {
+        fprintf(stderr, "Failed to request gpio line %d!\n", gpio->pin_nr);
+    }
+    else {
+        line_fd = request.fd;
+    }
+    // The line handle stays valid without the chip handle
+    close(chip_fd);
+    return(line_fd);
+}
+
+// Waits for the edge events of the line and invokes the handler
+static void * pal_gpio_irq_thread(void * p_args)
+{
+    pal_linux_gpio_t * gpio = (pal_linux_gpio_t *)p_args;
+    struct gpio_v2_line_event event;
+
+    while (sizeof(event) == read(gpio->fd, &event, sizeof(event)))
+    {
+        gpio->irq_handler(gpio->irq_context);
+    }
+    return(NULL);
+}
+
+// Releases the edge event line
+static void pal_gpio_irq_release(pal_linux_gpio_t * gpio)
+{
+    if (NULL != gpio->irq_handler)
+    {
+        pthread_cancel(gpio->irq_thread);
+        pthread_join(gpio->irq_thread, NULL);
+        gpio->irq_handler = NULL;
+    }
+    if (-1 != gpio->fd)
+    {
+        close(gpio->fd);
+        gpio->fd = -1;
+    }
+}
+#else
 
 static int
 GPIOExport(int pin)
@@ -119,10 +196,20 @@ GPIODirection(int pin, int dir)
     return(0);
 }
 
+#endif //PAL_GPIO_CHARDEV
+
 static int
 GPIOWrite(pal_linux_gpio_t* pin, int value)
 {
+#ifdef PAL_GPIO_CHARDEV
+    struct gpio_v2_line_values values;
+
+    values.mask = 1;
+    values.bits = (value == LOW) ? 0 : 1;
+    if (-1 == ioctl(pin->fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &values))
+#else
     if (write(pin->fd, value == LOW ? "0" : "1", 1) != 1) 
+#endif
 	{
         // can't use printf, because it may execute in signal handler
 		int errsv = errno;
@@ -134,11 +221,25 @@ GPIOWrite(pal_linux_gpio_t* pin, int value)
     return(0);
 }
 
+#ifndef PAL_GPIO_CHARDEV
 #define GPIO_VALUE_FMT_STR "/sys/class/gpio/gpio%d/value"
+#endif
 
 //lint --e{714,715} suppress "This function is used for to support multiple platforms "
 pal_status_t pal_gpio_init(const pal_gpio_t * p_gpio_context)
 {
+#ifdef PAL_GPIO_CHARDEV
+    if (p_gpio_context->p_gpio_hw != NULL)
+    {
+        pal_linux_gpio_t* gpio = p_gpio_context->p_gpio_hw;
+
+        gpio->fd = pal_gpio_request_line(gpio, GPIO_V2_LINE_FLAG_OUTPUT);
+        if (-1 == gpio->fd)
+            return(2);
+    }
+
+    return PAL_STATUS_SUCCESS;
+#else
 #define VALUE_MAX 30
     char path[VALUE_MAX] = {0};
 
@@ -171,6 +272,7 @@ pal_status_t pal_gpio_init(const pal_gpio_t * p_gpio_context)
     }
 
     return PAL_STATUS_SUCCESS;
+#endif
 }
 
 //lint --e{714,715} suppress "This function is used for to support multiple platforms "
@@ -179,6 +281,10 @@ pal_status_t pal_gpio_deinit(const pal_gpio_t * p_gpio_context)
     if (p_gpio_context->p_gpio_hw != NULL)
     {
         pal_linux_gpio_t* gpio = (pal_linux_gpio_t*)(p_gpio_context->p_gpio_hw);
+#ifdef PAL_GPIO_CHARDEV
+        // Releasing the line handle releases the line
+        pal_gpio_irq_release(gpio);
+#else
         /*
          * Disable GPIO pins
          */
@@ -186,11 +292,54 @@ pal_status_t pal_gpio_deinit(const pal_gpio_t * p_gpio_context)
             return(1);
 
         close(gpio->fd);
+#endif
     }
         
     return PAL_STATUS_SUCCESS;
 }
 
+//lint --e{714,715} suppress "This function is used for to support multiple platforms "
+pal_status_t pal_gpio_register_irq(const pal_gpio_t * p_gpio_context,
+                                   pal_gpio_irq_handler_t handler,
+                                   void * p_context)
+{
+#ifdef PAL_GPIO_CHARDEV
+    pal_status_t status = PAL_STATUS_FAILURE;
+    pal_linux_gpio_t* gpio;
+
+    if ((p_gpio_context != NULL) && (p_gpio_context->p_gpio_hw != NULL))
+    {
+        gpio = (pal_linux_gpio_t*)(p_gpio_context->p_gpio_hw);
+        // The line is requested again as input with edge detection, or released if handler is NULL
+        pal_gpio_irq_release(gpio);
+        status = PAL_STATUS_SUCCESS;
+        if (NULL != handler)
+        {
+            status = PAL_STATUS_FAILURE;
+            gpio->fd = pal_gpio_request_line(gpio, GPIO_V2_LINE_FLAG_INPUT | PAL_GPIO_IRQ_EDGE);
+            if (-1 != gpio->fd)
+            {
+                gpio->irq_handler = handler;
+                gpio->irq_context = p_context;
+                if (0 == pthread_create(&gpio->irq_thread, NULL, pal_gpio_irq_thread, gpio))
+                {
+                    status = PAL_STATUS_SUCCESS;
+                }
+                else
+                {
+                    gpio->irq_handler = NULL;
+                    pal_gpio_irq_release(gpio);
+                }
+            }
+        }
+    }
+    return status;
+#else
+    // Edge interrupts on sysfs GPIOs are not delivered to this pal, hence the status register is polled
+    return PAL_STATUS_FAILURE;
+#endif
+}
+
 void pal_gpio_set_high(const pal_gpio_t * p_gpio_context)
 {
     if ((p_gpio_context != NULL) && (p_gpio_context->p_gpio_hw != NULL))
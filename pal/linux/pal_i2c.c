@@ -35,13 +35,25 @@
 */
 
 #include <linux/i2c-dev.h>
+#ifdef PAL_I2C_RDWR
+#include <linux/i2c.h>
+#endif
 #include <fcntl.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
+#ifdef PAL_I2C_ASYNC
+#include <pthread.h>
+#endif
 
 #include "optiga/pal/pal_i2c.h"
+#if defined(PAL_I2C_RECORD) || defined(PAL_I2C_MUX)
+#include "optiga/pal/pal_os_timer.h"
+#endif
 #include "pal_linux.h"
 
+// The replay PAL (pal_i2c_replay.c) replaces the bus transfers, if PAL_I2C_REPLAY is defined
+#ifndef PAL_I2C_REPLAY
+
 #if IFX_I2C_LOG_HAL == 1
 #define LOG_HAL IFX_I2C_LOG
 #else
@@ -49,130 +61,487 @@
 #define LOG_HAL(...) //printf(__VA_ARGS__)
 #endif
 
-/// I2C device
+/// Default I2C device, used unless the bus device is set in the platform specific context (pal_linux_t)
 char * i2c_if = "/dev/i2c-1";
 
+// Define PAL_I2C_RDWR to transfer with I2C_RDWR ioctl instead of read/write on the I2C_SLAVE address.
+// - The register address write (1 byte) is held back and sent along with the following read as one combined
+//   transaction (repeated start), hence a register read or a STATUS poll costs one system call instead of two.
+// - The slave address is taken from the context with every transfer, hence a changed address is applied right away.
+
+// Define PAL_I2C_RECORD to record the transfers to a file with pal_linux_i2c_record_start (pal_i2c_record.c).
+// - The recording is replayed without I2C hardware by pal_i2c_replay.c, if PAL_I2C_REPLAY is defined.
+
+// Define PAL_I2C_ASYNC to run the transfers on a dedicated I/O thread (linked with -lpthread).
+// - pal_i2c_write/pal_i2c_read return right after queuing the transfer, the caller (event thread) is free meanwhile.
+// - The completion (upper layer callback) is invoked on the I/O thread, hence the stack unwinds with every transfer.
+
+// Define PAL_I2C_MUX to reach the devices behind PCA9548 style I2C multiplexers (p_mux_path of pal_i2c_t).
+// - Several chips with the same slave address (e.g. 0x30) share one bus, each on its own multiplexer channel.
+// - The channels are switched only if the path differs from the selected one, the consecutive transfers of a
+//   channel are grouped for PAL_LINUX_I2C_MUX_CHANNEL_HOLD_US (see pal_linux.h).
+// - Each chip is driven by its own OPTIGA instance, the bus is free while a chip processes a command, hence the
+//   other chips use the bus during the busy time (the STATUS polling of a busy chip is one short read).
+// - The multiplexers are expected with all the channels disabled on the first pal_i2c_init of the bus (e.g. reset).
+
 // Slave address not initialization
 #define IFXI2C_SLAVE_ADDRESS_INIT 0xFFFF
 #define PAL_I2C_MASTER_MAX_BITRATE 100
 #define WAIT_500_MS	(500)
 /// @cond hidden
 
-void i2c_master_end_of_transmit_callback(void);
-void i2c_master_end_of_receive_callback(void);
+void i2c_master_end_of_transmit_callback(const pal_i2c_t * p_i2c_context);
+void i2c_master_end_of_receive_callback(const pal_i2c_t * p_i2c_context);
 void invoke_upper_layer_callback (const pal_i2c_t* p_pal_i2c_ctx, optiga_lib_status_t event);
-uint16_t usb_i2c_poll_operation_result(pal_i2c_t* p_i2c_context);
 
-/* Varibale to indicate the re-entrant count of the i2c bus acquire function*/
-static volatile uint32_t g_entry_count = 0;
+#ifdef PAL_I2C_MUX
+// Checks whether the path of the device is selected, no path (NULL) selects the slaves directly on the bus
+static uint8_t pal_i2c_mux_is_selected(const pal_linux_t * pal_linux, const pal_linux_i2c_mux_path_t * p_path)
+{
+    uint8_t hop_count = (NULL != p_path) ? p_path->hop_count : 0;
+    uint8_t index;
 
-/* Pointer to the current pal i2c context*/
-static pal_i2c_t * gp_pal_i2c_current_ctx;
+    if (hop_count != pal_linux->mux_selected.hop_count)
+    {
+        return FALSE;
+    }
+    for (index = 0; index < hop_count; index++)
+    {
+        if ((p_path->hops[index].mux_address != pal_linux->mux_selected.hops[index].mux_address) ||
+            (p_path->hops[index].channel != pal_linux->mux_selected.hops[index].channel))
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+#endif
 
-//lint --e{715} suppress the unused p_i2c_context variable lint error , since this is kept for future enhancements
-static pal_status_t pal_i2c_acquire(const void * p_i2c_context)
+// Acquires the bus of the device, the devices on the same bus share the platform specific context
+static pal_status_t pal_i2c_acquire(const pal_i2c_t * p_i2c_context)
 {
-    if (0 == g_entry_count)
+    pal_linux_t * pal_linux = (pal_linux_t *)p_i2c_context->p_i2c_hw_config;
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+
+    // The devices may be driven from different threads, hence the bus is acquired atomically
+    if (__sync_bool_compare_and_swap(&pal_linux->entry_count, 0, 1))
     {
-        g_entry_count++;
-        if (1 == g_entry_count)
+#ifdef PAL_I2C_MUX
+        // The selected channel is held for the following transfers of its devices, another channel waits
+        if ((FALSE == pal_i2c_mux_is_selected(pal_linux, (const pal_linux_i2c_mux_path_t *)p_i2c_context->p_mux_path)) &&
+            ((pal_os_timer_get_time_in_microseconds() - pal_linux->mux_last_transfer_time_us) <
+             PAL_LINUX_I2C_MUX_CHANNEL_HOLD_US))
         {
-            return PAL_STATUS_SUCCESS;
+            __sync_lock_release(&pal_linux->entry_count);
+            return return_status;
         }
+#endif
+        pal_linux->p_current_ctx = p_i2c_context;
+        return_status = PAL_STATUS_SUCCESS;
     }
-    return PAL_STATUS_FAILURE;
+    return return_status;
 }
 
 // I2C release bus function
-//lint --e{715} suppress the unused p_i2c_context variable lint, since this is kept for future enhancements
-static void pal_i2c_release(const void* p_i2c_context)
+static void pal_i2c_release(const pal_i2c_t * p_i2c_context)
 {
-    g_entry_count = 0;
+    pal_linux_t * pal_linux = (pal_linux_t *)p_i2c_context->p_i2c_hw_config;
+
+    pal_linux->p_current_ctx = NULL;
+    __sync_lock_release(&pal_linux->entry_count);
 }
-/// @endcond
 
-void invoke_upper_layer_callback (const pal_i2c_t * p_pal_i2c_ctx, optiga_lib_status_t event)
+#ifdef PAL_I2C_RDWR
+// Writes the pending register address to its device
+static int32_t pal_i2c_rdwr_send_pending(pal_linux_t * pal_linux)
 {
-    upper_layer_callback_t  upper_layer_handler;
-    //lint --e{611} suppress "void* function pointer is type casted to upper_layer_callback_t  type"
-    upper_layer_handler = (upper_layer_callback_t )p_pal_i2c_ctx->upper_layer_event_handler;
+    struct i2c_msg message;
+    struct i2c_rdwr_ioctl_data transfer;
+
+    pal_linux->pending_register_valid = FALSE;
+    message.addr = pal_linux->pending_register_address;
+    message.flags = 0;
+    message.len = 1;
+    message.buf = &pal_linux->pending_register;
+    transfer.msgs = &message;
+    transfer.nmsgs = 1;
+    return (int32_t)ioctl(pal_linux->i2c_handle, I2C_RDWR, &transfer);
+}
 
-    upper_layer_handler(p_pal_i2c_ctx->p_upper_layer_ctx , event);
+// Writes the pending register address of another device, before the bus is used for a different slave address
+static int32_t pal_i2c_rdwr_flush(pal_linux_t * pal_linux, uint8_t slave_address)
+{
+    int32_t status = 0;
 
-    //Release I2C Bus
-    pal_i2c_release(p_pal_i2c_ctx->p_upper_layer_ctx );
+    if ((TRUE == pal_linux->pending_register_valid) && (slave_address != pal_linux->pending_register_address))
+    {
+        status = pal_i2c_rdwr_send_pending(pal_linux);
+    }
+    return status;
 }
 
-/// @cond hidden
-// I2C driver callback function when the transmit is completed successfully
-void i2c_master_end_of_transmit_callback(void)
+// Writes the data as one I2C_RDWR message, a register address alone is held back for the following read
+static int32_t pal_i2c_rdwr_write(const pal_i2c_t * p_i2c_context, uint8_t * p_data, uint16_t length)
 {
-    invoke_upper_layer_callback(gp_pal_i2c_current_ctx, PAL_I2C_EVENT_SUCCESS);
+    pal_linux_t * pal_linux = (pal_linux_t *)p_i2c_context->p_i2c_hw_config;
+    struct i2c_msg message;
+    struct i2c_rdwr_ioctl_data transfer;
+    int32_t status;
+
+    status = pal_i2c_rdwr_flush(pal_linux, p_i2c_context->slave_address);
+    if (0 > status)
+    {
+        // The error is reported to the device, which transfers now
+    }
+    else if (1 == length)
+    {
+        pal_linux->pending_register = p_data[0];
+        pal_linux->pending_register_address = p_i2c_context->slave_address;
+        pal_linux->pending_register_valid = TRUE;
+    }
+    else
+    {
+        pal_linux->pending_register_valid = FALSE;
+        message.addr = p_i2c_context->slave_address;
+        message.flags = 0;
+        message.len = length;
+        message.buf = p_data;
+        transfer.msgs = &message;
+        transfer.nmsgs = 1;
+        status = ioctl(pal_linux->i2c_handle, I2C_RDWR, &transfer);
+    }
+    return status;
 }
 
+// Reads the data, preceded by the pending register address write in the same transaction
+static int32_t pal_i2c_rdwr_read(const pal_i2c_t * p_i2c_context, uint8_t * p_data, uint16_t length)
+{
+    pal_linux_t * pal_linux = (pal_linux_t *)p_i2c_context->p_i2c_hw_config;
+    struct i2c_msg messages[2];
+    struct i2c_rdwr_ioctl_data transfer;
+    uint8_t index = 0;
+    int32_t status;
+
+    status = pal_i2c_rdwr_flush(pal_linux, p_i2c_context->slave_address);
+    if (0 <= status)
+    {
+        // The register address stays pending, hence a retried read (e.g. NACK while busy) writes it again
+        if (TRUE == pal_linux->pending_register_valid)
+        {
+            messages[index].addr = p_i2c_context->slave_address;
+            messages[index].flags = 0;
+            messages[index].len = 1;
+            messages[index].buf = &pal_linux->pending_register;
+            index++;
+        }
+        messages[index].addr = p_i2c_context->slave_address;
+        messages[index].flags = I2C_M_RD;
+        messages[index].len = length;
+        messages[index].buf = p_data;
+        index++;
+        transfer.msgs = messages;
+        transfer.nmsgs = index;
+        status = (int32_t)ioctl(pal_linux->i2c_handle, I2C_RDWR, &transfer);
+    }
+    return status;
+}
+#endif
 
-// I2C driver callback function when the receive is completed successfully
-void i2c_master_end_of_receive_callback(void)
+#ifdef PAL_I2C_MUX
+// Writes the control byte (one bit per enabled channel) to a multiplexer
+static int32_t pal_i2c_mux_write(pal_linux_t * pal_linux, uint8_t mux_address, uint8_t control)
 {
-	invoke_upper_layer_callback(gp_pal_i2c_current_ctx, PAL_I2C_EVENT_SUCCESS);
+    int32_t status;
+#ifdef PAL_I2C_RDWR
+    struct i2c_msg message;
+    struct i2c_rdwr_ioctl_data transfer;
+
+    message.addr = mux_address;
+    message.flags = 0;
+    message.len = 1;
+    message.buf = &control;
+    transfer.msgs = &message;
+    transfer.nmsgs = 1;
+    status = (int32_t)ioctl(pal_linux->i2c_handle, I2C_RDWR, &transfer);
+#else
+    status = 0;
+    if (mux_address != pal_linux->current_slave_address)
+    {
+        status = ioctl(pal_linux->i2c_handle, I2C_SLAVE, mux_address);
+        if (0 <= status)
+        {
+            pal_linux->current_slave_address = mux_address;
+        }
+    }
+    if (0 <= status)
+    {
+        status = (int32_t)write(pal_linux->i2c_handle, &control, 1);
+    }
+#endif
+    pal_linux->mux_switch_count++;
+    return status;
 }
 
-// I2C error callback function
-void i2c_master_error_detected_callback(void)
+// Selects the multiplexer channels of the device, only the hops which differ from the selected path are written
+static int32_t pal_i2c_mux_select(pal_linux_t * pal_linux, const pal_linux_i2c_mux_path_t * p_path)
 {
-    //I2C_MASTER_t *p_i2c_master;
-    //
-    //p_i2c_master = gp_pal_i2c_current_ctx->p_i2c_hw_config;
-    //if (I2C_MASTER_IsTxBusy(p_i2c_master))
-    //{
-    //    //lint --e{534} suppress "Return value is not required to be checked"
-    //    I2C_MASTER_AbortTransmit(p_i2c_master);
-    //    while (I2C_MASTER_IsTxBusy(p_i2c_master)){}
-    //}  
-
-    //if (I2C_MASTER_IsRxBusy(p_i2c_master)) 
-    //{
-    //    //lint --e{534} suppress "Return value is not required to be checked"
-    //    I2C_MASTER_AbortReceive(p_i2c_master);
-    //    while (I2C_MASTER_IsRxBusy(p_i2c_master)){}
-    //}
-
-    invoke_upper_layer_callback(gp_pal_i2c_current_ctx, PAL_I2C_EVENT_ERROR);
+    pal_linux_i2c_mux_path_t * p_selected = &pal_linux->mux_selected;
+    uint8_t hop_count = (NULL != p_path) ? p_path->hop_count : 0;
+    uint8_t common = 0;
+    uint8_t index;
+    int32_t status = 0;
+
+    if (TRUE == pal_i2c_mux_is_selected(pal_linux, p_path))
+    {
+        return status;
+    }
+#ifdef PAL_I2C_RDWR
+    // The pending register address belongs to the device on the selected channel
+    if (TRUE == pal_linux->pending_register_valid)
+    {
+        status = pal_i2c_rdwr_send_pending(pal_linux);
+    }
+#endif
+    while ((common < hop_count) && (common < p_selected->hop_count) &&
+           (p_path->hops[common].mux_address == p_selected->hops[common].mux_address) &&
+           (p_path->hops[common].channel == p_selected->hops[common].channel))
+    {
+        common++;
+    }
+    // The deeper multiplexers are disconnected first, they are reachable only through the selected upper channels.
+    // Another multiplexer at the same depth is disconnected, else two slaves with the same address respond.
+    for (index = p_selected->hop_count; (0 <= status) && (index > common); index--)
+    {
+        if ((index - 1U < hop_count) && (index - 1U == common) &&
+            (p_path->hops[common].mux_address == p_selected->hops[common].mux_address))
+        {
+            // Overwritten with the new channel
+            continue;
+        }
+        status = pal_i2c_mux_write(pal_linux, p_selected->hops[index - 1U].mux_address, 0x00);
+    }
+    for (index = common; (0 <= status) && (index < hop_count); index++)
+    {
+        status = pal_i2c_mux_write(pal_linux, p_path->hops[index].mux_address,
+                                   (uint8_t)(1U << p_path->hops[index].channel));
+    }
+    if ((0 <= status) && (NULL != p_path))
+    {
+        *p_selected = *p_path;
+    }
+    else
+    {
+        // The state of the multiplexers is unknown, hence all the hops are written with the next transfer
+        p_selected->hop_count = 0;
+    }
+    return status;
 }
+#endif
 
+// Transfers the data with the configured system calls
+static int32_t pal_i2c_transfer(const pal_i2c_t * p_i2c_context, uint8_t * p_data, uint16_t length, uint8_t is_read)
+{
+    int32_t transfer_status;
+#ifdef PAL_I2C_RECORD
+    uint32_t start_time_us = pal_os_timer_get_time_in_microseconds();
+#endif
+#ifdef PAL_I2C_MUX
+    transfer_status = pal_i2c_mux_select((pal_linux_t *)p_i2c_context->p_i2c_hw_config,
+                                         (const pal_linux_i2c_mux_path_t *)p_i2c_context->p_mux_path);
+    if (0 > transfer_status)
+    {
+        return transfer_status;
+    }
+#endif
+#ifdef PAL_I2C_RDWR
+    transfer_status = (TRUE == is_read) ? pal_i2c_rdwr_read(p_i2c_context, p_data, length) :
+                                          pal_i2c_rdwr_write(p_i2c_context, p_data, length);
+#else
+    pal_linux_t * pal_linux = (pal_linux_t *)p_i2c_context->p_i2c_hw_config;
+
+    transfer_status = 0;
+    // The devices on the bus share the handle, the slave address is selected once it changes
+    if (p_i2c_context->slave_address != pal_linux->current_slave_address)
+    {
+        transfer_status = ioctl(pal_linux->i2c_handle, I2C_SLAVE, p_i2c_context->slave_address);
+        if (0 <= transfer_status)
+        {
+            pal_linux->current_slave_address = p_i2c_context->slave_address;
+        }
+    }
+    if (0 <= transfer_status)
+    {
+        transfer_status = (TRUE == is_read) ? (int32_t)read(pal_linux->i2c_handle, p_data, length) :
+                                              (int32_t)write(pal_linux->i2c_handle, p_data, length);
+    }
+#endif
+#ifdef PAL_I2C_RECORD
+    pal_linux_i2c_record(p_i2c_context->slave_address, p_data, length, is_read, transfer_status, start_time_us);
+#endif
+#ifdef PAL_I2C_MUX
+    ((pal_linux_t *)p_i2c_context->p_i2c_hw_config)->mux_last_transfer_time_us = pal_os_timer_get_time_in_microseconds();
+#endif
+    return transfer_status;
+}
 
-void i2c_master_nack_received_callback(void)
+#ifdef PAL_I2C_ASYNC
+// I/O thread of a bus, the transfers of one bus are done one after the other
+static void * pal_i2c_async_thread(void * p_args)
+{
+    pal_linux_t * pal_linux = (pal_linux_t *)p_args;
+    const pal_i2c_t * p_i2c_context;
+    uint8_t * p_data;
+    uint16_t length;
+    uint8_t is_read;
+    int32_t transfer_status;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&pal_linux->async_mutex);
+        while (FALSE == pal_linux->async_is_pending)
+        {
+            pthread_cond_wait(&pal_linux->async_queued, &pal_linux->async_mutex);
+        }
+        // Only one transfer is outstanding at a time, the bus is acquired until its completion
+        p_i2c_context = (const pal_i2c_t *)pal_linux->p_current_ctx;
+        p_data = pal_linux->p_async_data;
+        length = pal_linux->async_length;
+        is_read = pal_linux->async_is_read;
+        pal_linux->async_is_pending = FALSE;
+        pthread_mutex_unlock(&pal_linux->async_mutex);
+
+        transfer_status = pal_i2c_transfer(p_i2c_context, p_data, length, is_read);
+        if (0 > transfer_status)
+        {
+            LOG_HAL("[IFX-HAL]: I2C transfer ERROR %d\n.", transfer_status);
+            //lint --e{611} suppress "void* function pointer is type casted to upper_layer_callback_t  type"
+            ((upper_layer_callback_t )(p_i2c_context->upper_layer_event_handler))
+                                                       (p_i2c_context->p_upper_layer_ctx  , PAL_I2C_EVENT_ERROR);
+            //Release I2C Bus
+            pal_i2c_release(p_i2c_context);
+        }
+        else
+        {
+            invoke_upper_layer_callback(p_i2c_context, PAL_I2C_EVENT_SUCCESS);
+        }
+    }
+    return (NULL);
+}
+
+static int pal_i2c_async_start_thread(pal_linux_t * pal_linux)
+{
+    pal_linux->async_is_pending = FALSE;
+    pthread_mutex_init(&pal_linux->async_mutex, NULL);
+    pthread_cond_init(&pal_linux->async_queued, NULL);
+    return pthread_create(&pal_linux->async_thread, NULL, pal_i2c_async_thread, pal_linux);
+}
+
+static void pal_i2c_async_stop_thread(pal_linux_t * pal_linux)
+{
+    // The bus is idle, the thread waits for the next transfer
+    pthread_cancel(pal_linux->async_thread);
+    pthread_join(pal_linux->async_thread, NULL);
+    pthread_cond_destroy(&pal_linux->async_queued);
+    pthread_mutex_destroy(&pal_linux->async_mutex);
+}
+
+static void pal_i2c_async_submit(const pal_i2c_t * p_i2c_context, uint8_t * p_data, uint16_t length, uint8_t is_read)
+{
+    pal_linux_t * pal_linux = (pal_linux_t *)p_i2c_context->p_i2c_hw_config;
+
+    pthread_mutex_lock(&pal_linux->async_mutex);
+    pal_linux->p_async_data = p_data;
+    pal_linux->async_length = length;
+    pal_linux->async_is_read = is_read;
+    pal_linux->async_is_pending = TRUE;
+    pthread_cond_signal(&pal_linux->async_queued);
+    pthread_mutex_unlock(&pal_linux->async_mutex);
+}
+#endif
+/// @endcond
+
+void invoke_upper_layer_callback (const pal_i2c_t * p_pal_i2c_ctx, optiga_lib_status_t event)
 {
-    i2c_master_error_detected_callback();
+    upper_layer_callback_t  upper_layer_handler;
+    //lint --e{611} suppress "void* function pointer is type casted to upper_layer_callback_t  type"
+    upper_layer_handler = (upper_layer_callback_t )p_pal_i2c_ctx->upper_layer_event_handler;
+
+    upper_layer_handler(p_pal_i2c_ctx->p_upper_layer_ctx , event);
+
+    //Release I2C Bus
+    pal_i2c_release(p_pal_i2c_ctx);
 }
 
-void i2c_master_arbitration_lost_callback(void)
+/// @cond hidden
+// I2C driver callback function when the transmit is completed successfully
+void i2c_master_end_of_transmit_callback(const pal_i2c_t * p_i2c_context)
 {
-    i2c_master_error_detected_callback();
+    invoke_upper_layer_callback(p_i2c_context, PAL_I2C_EVENT_SUCCESS);
 }
 
 
+// I2C driver callback function when the receive is completed successfully
+void i2c_master_end_of_receive_callback(const pal_i2c_t * p_i2c_context)
+{
+	invoke_upper_layer_callback(p_i2c_context, PAL_I2C_EVENT_SUCCESS);
+}
+
 /// @endcond
 
 pal_status_t pal_i2c_init(const pal_i2c_t* p_i2c_context)
 {
-	int32_t ret = PAL_I2C_EVENT_ERROR;
+	int32_t ret = PAL_STATUS_SUCCESS;
 	pal_linux_t *pal_linux;
 	do
 	{
 		pal_linux = (pal_linux_t*) p_i2c_context->p_i2c_hw_config;
-		pal_linux->i2c_handle = open(i2c_if, O_RDWR);
+		// The devices on the same bus share the handle, it is opened by the first one
+		if (0 != pal_linux->open_count)
+		{
+			pal_linux->open_count++;
+			break;
+		}
+		pal_linux->i2c_handle = open((NULL != pal_linux->i2c_device) ? pal_linux->i2c_device : i2c_if, O_RDWR);
+		if (0 > pal_linux->i2c_handle)
+		{
+			LOG_HAL("open returned an error = %d\n", pal_linux->i2c_handle);
+			ret = PAL_STATUS_FAILURE;
+			break;
+		}
 		LOG_HAL("IFX OPTIGA TRUST X Logs \n");
-		
+		pal_linux->p_current_ctx = NULL;
+		pal_linux->entry_count = 0;
+#ifdef PAL_I2C_MUX
+		pal_linux->mux_selected.hop_count = 0;
+		pal_linux->mux_last_transfer_time_us = pal_os_timer_get_time_in_microseconds() - PAL_LINUX_I2C_MUX_CHANNEL_HOLD_US;
+		pal_linux->mux_switch_count = 0;
+#endif
+#ifdef PAL_I2C_ASYNC
+		if (0 != pal_i2c_async_start_thread(pal_linux))
+		{
+			LOG_HAL("I/O thread could not be created\n");
+			close(pal_linux->i2c_handle);
+			ret = PAL_STATUS_FAILURE;
+			break;
+		}
+#endif
+#ifdef PAL_I2C_RDWR
+		pal_linux->pending_register_valid = FALSE;
+#else
 		// Assign the slave address
 		ret = ioctl(pal_linux->i2c_handle, I2C_SLAVE, p_i2c_context->slave_address);
 		if(PAL_STATUS_SUCCESS != ret)
 		{
 			LOG_HAL((uint32_t)pal_linux->i2c_handle, "ioctl returned an error = ", ret);
+#ifdef PAL_I2C_ASYNC
+			pal_i2c_async_stop_thread(pal_linux);
+#endif
+			close(pal_linux->i2c_handle);
 			break;
 		}
-		
-		//start_transceive_thread();
+		pal_linux->current_slave_address = p_i2c_context->slave_address;
+#endif
+		pal_linux->open_count = 1;
 	}while(0);
     return ret;
 }
@@ -180,8 +549,17 @@ pal_status_t pal_i2c_init(const pal_i2c_t* p_i2c_context)
 
 pal_status_t pal_i2c_deinit(const pal_i2c_t* p_i2c_context)
 {
+	pal_linux_t *pal_linux = (pal_linux_t*) p_i2c_context->p_i2c_hw_config;
+
 	LOG_HAL("pal_i2c_deinit\n. ");
-	
+	// The handle is closed with the last device on the bus
+	if ((0 != pal_linux->open_count) && (0 == --pal_linux->open_count))
+	{
+#ifdef PAL_I2C_ASYNC
+		pal_i2c_async_stop_thread(pal_linux);
+#endif
+		close(pal_linux->i2c_handle);
+	}
     return PAL_STATUS_SUCCESS;
 }
 
@@ -189,10 +567,10 @@ pal_status_t pal_i2c_deinit(const pal_i2c_t* p_i2c_context)
 pal_status_t pal_i2c_write(const pal_i2c_t* p_i2c_context,uint8_t* p_data , uint16_t length)
 {
     pal_status_t status = PAL_STATUS_FAILURE;
+#ifndef PAL_I2C_ASYNC
     int32_t i2c_write_status;
-	pal_linux_t *pal_linux;
+#endif
 
-	pal_linux = (pal_linux_t*) p_i2c_context->p_i2c_hw_config;
 	LOG_HAL("[IFX-HAL]: I2C TX (%d): ", length);
 #if 1
     for (int i = 0; i < length; i++)
@@ -203,11 +581,13 @@ pal_status_t pal_i2c_write(const pal_i2c_t* p_i2c_context,uint8_t* p_data , uint
     LOG_HAL("\n");
     if(PAL_STATUS_SUCCESS == pal_i2c_acquire(p_i2c_context))
     {
-        gp_pal_i2c_current_ctx = (pal_i2c_t *)p_i2c_context;
-
+#ifdef PAL_I2C_ASYNC
+        // The transfer and its completion are done on the I/O thread
+        pal_i2c_async_submit(p_i2c_context, p_data, length, FALSE);
+        status = PAL_STATUS_SUCCESS;
+#else
         //Invoke the low level i2c master driver API to write to the bus
-
-		i2c_write_status = write(pal_linux->i2c_handle, p_data, length);
+		i2c_write_status = pal_i2c_transfer(p_i2c_context, p_data, length, FALSE);
         if (0 > i2c_write_status)
         {
             //If I2C Master fails to invoke the write operation, invoke upper layer event handler with error.
@@ -217,14 +597,15 @@ pal_status_t pal_i2c_write(const pal_i2c_t* p_i2c_context,uint8_t* p_data , uint
                                                        (p_i2c_context->p_upper_layer_ctx  , PAL_I2C_EVENT_ERROR);
             
             //Release I2C Bus
-            pal_i2c_release((void *)p_i2c_context);
+            pal_i2c_release(p_i2c_context);
         }
         else
         {
-        	i2c_master_end_of_transmit_callback();
+        	i2c_master_end_of_transmit_callback(p_i2c_context);
             status = PAL_STATUS_SUCCESS;
 			//transmission_completed = true;
         }
+#endif
     }
     else
     {
@@ -241,15 +622,16 @@ pal_status_t pal_i2c_write(const pal_i2c_t* p_i2c_context,uint8_t* p_data , uint
 pal_status_t pal_i2c_read(const pal_i2c_t* p_i2c_context , uint8_t* p_data , uint16_t length)
 {
     int32_t i2c_read_status = PAL_STATUS_FAILURE;
-	pal_linux_t *pal_linux;
-    
 
-	pal_linux = (pal_linux_t*) p_i2c_context->p_i2c_hw_config;
     //Acquire the I2C bus before read/write
     if (PAL_STATUS_SUCCESS == pal_i2c_acquire(p_i2c_context))
     {    
-        gp_pal_i2c_current_ctx = (pal_i2c_t *)p_i2c_context;
-		i2c_read_status = read(pal_linux->i2c_handle,p_data, length);
+#ifdef PAL_I2C_ASYNC
+        // The transfer and its completion are done on the I/O thread
+        pal_i2c_async_submit(p_i2c_context, p_data, length, TRUE);
+        i2c_read_status = PAL_STATUS_SUCCESS;
+#else
+		i2c_read_status = pal_i2c_transfer(p_i2c_context, p_data, length, TRUE);
 		if (0 > i2c_read_status)
 		{
     		LOG_HAL("[IFX-HAL]: libusb_interrupt_transfer ERROR %d\n.", i2c_read_status);
@@ -257,7 +639,7 @@ pal_status_t pal_i2c_read(const pal_i2c_t* p_i2c_context , uint8_t* p_data , uin
             ((upper_layer_callback_t )(p_i2c_context->upper_layer_event_handler))
                                                        (p_i2c_context->p_upper_layer_ctx  , PAL_I2C_EVENT_ERROR);
 													   			//Release I2C Bus
-			pal_i2c_release((void *)p_i2c_context);
+			pal_i2c_release(p_i2c_context);
     		return i2c_read_status;
 		}
 		else
@@ -270,10 +652,11 @@ pal_status_t pal_i2c_read(const pal_i2c_t* p_i2c_context , uint8_t* p_data , uin
 			}
 #endif
 			
-			i2c_master_end_of_receive_callback();
+			i2c_master_end_of_receive_callback(p_i2c_context);
 			i2c_read_status = PAL_STATUS_SUCCESS;
 			//reception_started = true;
         }
+#endif
     }
     else
     {
@@ -314,11 +697,16 @@ pal_status_t pal_i2c_set_bitrate(const pal_i2c_t* p_i2c_context , uint16_t bitra
         //lint --e{611} suppress "void* function pointer is type casted to upper_layer_callback_t  type"
         ((upper_layer_callback_t)(p_i2c_context->upper_layer_event_handler))(p_i2c_context->p_upper_layer_ctx  , event);
     }
-    //Release I2C Bus
-    pal_i2c_release((void *)p_i2c_context);
+    //Release I2C Bus, unless it is held by another device
+    if (PAL_STATUS_SUCCESS == return_status)
+    {
+        pal_i2c_release(p_i2c_context);
+    }
     return return_status;
 }
 
+#endif //PAL_I2C_REPLAY
+
 /**
 * @}
 */
@@ -0,0 +1,165 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_i2c_record.c
+*
+* \brief   This file implements the recording of the I2C transfers of the Linux PAL to a compact binary file.
+*
+* \details
+* The recording is enabled with PAL_I2C_RECORD, the format is described in pal_linux.h.
+* - The records are buffered by the file stream, hence the recording costs no system call per transfer.
+* - The transfers of several buses are recorded in the order of their completion.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <pthread.h>
+#include <stdio.h>
+
+#include "optiga/pal/pal_os_timer.h"
+#include "pal_linux.h"
+
+#ifdef PAL_I2C_RECORD
+
+/// @cond hidden
+typedef struct pal_i2c_record
+{
+    /// Recording file, NULL if the recording is not started
+    FILE * p_file;
+    /// Start time of the recording
+    uint32_t start_time_us;
+    /// Indicates a record could not be written
+    uint8_t write_failed;
+} pal_i2c_record_t;
+
+static pal_i2c_record_t pal_i2c_record;
+// Guards the recording, the buses may be driven from different threads
+static pthread_mutex_t pal_i2c_record_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void pal_i2c_record_put_u16(uint8_t * p_buffer, uint16_t value)
+{
+    p_buffer[0] = (uint8_t)value;
+    p_buffer[1] = (uint8_t)(value >> 8);
+}
+
+static void pal_i2c_record_put_u32(uint8_t * p_buffer, uint32_t value)
+{
+    pal_i2c_record_put_u16(p_buffer, (uint16_t)value);
+    pal_i2c_record_put_u16(p_buffer + 2, (uint16_t)(value >> 16));
+}
+/// @endcond
+
+pal_status_t pal_linux_i2c_record_start(const char * p_file_name)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    uint8_t header[PAL_LINUX_I2C_RECORD_FILE_HEADER_SIZE] = {0};
+
+    pthread_mutex_lock(&pal_i2c_record_mutex);
+    do
+    {
+        if ((NULL != pal_i2c_record.p_file) || (NULL == p_file_name))
+        {
+            break;
+        }
+        pal_i2c_record.p_file = fopen(p_file_name, "wb");
+        if (NULL == pal_i2c_record.p_file)
+        {
+            break;
+        }
+        header[0] = (uint8_t)PAL_LINUX_I2C_RECORD_MAGIC[0];
+        header[1] = (uint8_t)PAL_LINUX_I2C_RECORD_MAGIC[1];
+        header[2] = (uint8_t)PAL_LINUX_I2C_RECORD_MAGIC[2];
+        header[3] = (uint8_t)PAL_LINUX_I2C_RECORD_MAGIC[3];
+        header[4] = PAL_LINUX_I2C_RECORD_VERSION;
+        pal_i2c_record.write_failed = (sizeof(header) != fwrite(header, 1, sizeof(header), pal_i2c_record.p_file));
+        pal_i2c_record.start_time_us = pal_os_timer_get_time_in_microseconds();
+        return_status = PAL_STATUS_SUCCESS;
+    } while (0);
+    pthread_mutex_unlock(&pal_i2c_record_mutex);
+
+    return return_status;
+}
+
+pal_status_t pal_linux_i2c_record_stop(void)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+
+    pthread_mutex_lock(&pal_i2c_record_mutex);
+    if (NULL != pal_i2c_record.p_file)
+    {
+        if ((0 == fclose(pal_i2c_record.p_file)) && (FALSE == pal_i2c_record.write_failed))
+        {
+            return_status = PAL_STATUS_SUCCESS;
+        }
+        pal_i2c_record.p_file = NULL;
+    }
+    pthread_mutex_unlock(&pal_i2c_record_mutex);
+
+    return return_status;
+}
+
+void pal_linux_i2c_record(uint8_t slave_address,
+                          const uint8_t * p_data,
+                          uint16_t length,
+                          uint8_t is_read,
+                          int32_t transfer_status,
+                          uint32_t start_time_us)
+{
+    uint8_t header[PAL_LINUX_I2C_RECORD_HEADER_SIZE];
+    uint32_t end_time_us = pal_os_timer_get_time_in_microseconds();
+    uint16_t data_length = length;
+
+    pthread_mutex_lock(&pal_i2c_record_mutex);
+    if (NULL != pal_i2c_record.p_file)
+    {
+        header[0] = (TRUE == is_read) ? PAL_LINUX_I2C_RECORD_FLAG_READ : 0;
+        if (0 > transfer_status)
+        {
+            header[0] |= PAL_LINUX_I2C_RECORD_FLAG_ERROR;
+            // A failed read has no data
+            data_length = (TRUE == is_read) ? 0 : length;
+        }
+        header[1] = slave_address;
+        pal_i2c_record_put_u16(&header[2], length);
+        pal_i2c_record_put_u32(&header[4], start_time_us - pal_i2c_record.start_time_us);
+        pal_i2c_record_put_u32(&header[8], end_time_us - start_time_us);
+        if ((sizeof(header) != fwrite(header, 1, sizeof(header), pal_i2c_record.p_file)) ||
+            (data_length != fwrite(p_data, 1, data_length, pal_i2c_record.p_file)))
+        {
+            pal_i2c_record.write_failed = TRUE;
+        }
+    }
+    pthread_mutex_unlock(&pal_i2c_record_mutex);
+}
+
+#endif //PAL_I2C_RECORD
+
+/**
+* @}
+*/
@@ -0,0 +1,265 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_i2c_replay.c
+*
+* \brief   This file implements the I2C PAL, which replays a recording of pal_i2c_record.c instead of using the bus.
+*
+* \details
+* The replay PAL is enabled with PAL_I2C_REPLAY, which excludes the implementation of pal_i2c.c.
+* - The recording is loaded into memory, hence the replay adds only a copy per transfer to the cost of the stack.
+* - The transfers are completed synchronously with the recorded status, like the blocking transfers of pal_i2c.c.
+* - A transfer, which differs from the recording, is still completed with the recorded response and counted as
+*   divergence. A transfer beyond the end of the recording fails with #PAL_I2C_EVENT_ERROR.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "optiga/pal/pal_i2c.h"
+#include "pal_linux.h"
+
+#ifdef PAL_I2C_REPLAY
+
+/// @cond hidden
+typedef struct pal_i2c_replay
+{
+    /// Recording loaded into memory, NULL if the replay is not started
+    uint8_t * p_recording;
+    /// Size of the recording
+    uint32_t size;
+    /// Offset of the next record
+    uint32_t offset;
+    /// Duration of the transfers in percent of the recorded duration
+    uint16_t time_scale_percent;
+    /// Number of the transfers, which differ from the recording or exceed it
+    uint32_t divergences;
+} pal_i2c_replay_t;
+
+static pal_i2c_replay_t pal_i2c_replay;
+
+static uint16_t pal_i2c_replay_get_u16(const uint8_t * p_buffer)
+{
+    return (uint16_t)(p_buffer[0] | (p_buffer[1] << 8));
+}
+
+static uint32_t pal_i2c_replay_get_u32(const uint8_t * p_buffer)
+{
+    return (uint32_t)pal_i2c_replay_get_u16(p_buffer) | ((uint32_t)pal_i2c_replay_get_u16(p_buffer + 2) << 16);
+}
+
+// Waits for the scaled duration of the recorded transfer
+static void pal_i2c_replay_delay(uint32_t duration_us)
+{
+    struct timespec delay;
+    uint64_t scaled_us = ((uint64_t)duration_us * pal_i2c_replay.time_scale_percent) / 100;
+
+    if (0 != scaled_us)
+    {
+        delay.tv_sec = (time_t)(scaled_us / 1000000);
+        delay.tv_nsec = (long)((scaled_us % 1000000) * 1000);
+        while (0 != nanosleep(&delay, &delay))
+        {
+            // Interrupted by a signal, the remaining time is waited
+        }
+    }
+}
+
+static void pal_i2c_replay_complete(const pal_i2c_t * p_i2c_context, optiga_lib_status_t event)
+{
+    //lint --e{611} suppress "void* function pointer is type casted to upper_layer_callback_t  type"
+    ((upper_layer_callback_t)(p_i2c_context->upper_layer_event_handler))(p_i2c_context->p_upper_layer_ctx, event);
+}
+
+// Completes the transfer with the next record, the data of a read is copied from the record
+static pal_status_t pal_i2c_replay_transfer(const pal_i2c_t * p_i2c_context,
+                                            uint8_t * p_data,
+                                            uint16_t length,
+                                            uint8_t is_read)
+{
+    const uint8_t * p_record;
+    uint32_t data_length;
+    uint16_t record_length;
+    uint8_t flags;
+    optiga_lib_status_t event = PAL_I2C_EVENT_ERROR;
+
+    do
+    {
+        if ((NULL == pal_i2c_replay.p_recording) ||
+            (PAL_LINUX_I2C_RECORD_HEADER_SIZE > (pal_i2c_replay.size - pal_i2c_replay.offset)))
+        {
+            pal_i2c_replay.divergences++;
+            break;
+        }
+        p_record = &pal_i2c_replay.p_recording[pal_i2c_replay.offset];
+        flags = p_record[0];
+        record_length = pal_i2c_replay_get_u16(&p_record[2]);
+        data_length = (PAL_LINUX_I2C_RECORD_FLAG_READ | PAL_LINUX_I2C_RECORD_FLAG_ERROR) ==
+                      (flags & (PAL_LINUX_I2C_RECORD_FLAG_READ | PAL_LINUX_I2C_RECORD_FLAG_ERROR)) ? 0 : record_length;
+        if (data_length > (pal_i2c_replay.size - pal_i2c_replay.offset - PAL_LINUX_I2C_RECORD_HEADER_SIZE))
+        {
+            // Truncated recording
+            pal_i2c_replay.divergences++;
+            pal_i2c_replay.offset = pal_i2c_replay.size;
+            break;
+        }
+        pal_i2c_replay.offset += PAL_LINUX_I2C_RECORD_HEADER_SIZE + data_length;
+
+        if ((is_read != (flags & PAL_LINUX_I2C_RECORD_FLAG_READ)) ||
+            (p_i2c_context->slave_address != p_record[1]) ||
+            (length != record_length) ||
+            ((FALSE == is_read) && (0 != memcmp(p_data, &p_record[PAL_LINUX_I2C_RECORD_HEADER_SIZE], length))))
+        {
+            pal_i2c_replay.divergences++;
+        }
+        if (TRUE == is_read)
+        {
+            memcpy(p_data, &p_record[PAL_LINUX_I2C_RECORD_HEADER_SIZE], (data_length < length) ? data_length : length);
+        }
+        pal_i2c_replay_delay(pal_i2c_replay_get_u32(&p_record[8]));
+        if (0 == (flags & PAL_LINUX_I2C_RECORD_FLAG_ERROR))
+        {
+            event = PAL_I2C_EVENT_SUCCESS;
+        }
+    } while (0);
+
+    pal_i2c_replay_complete(p_i2c_context, event);
+    return (PAL_I2C_EVENT_SUCCESS == event) ? PAL_STATUS_SUCCESS : PAL_STATUS_FAILURE;
+}
+/// @endcond
+
+pal_status_t pal_linux_i2c_replay_start(const char * p_file_name, uint16_t time_scale_percent)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    FILE * p_file = NULL;
+    long size;
+
+    do
+    {
+        if ((NULL != pal_i2c_replay.p_recording) || (NULL == p_file_name))
+        {
+            break;
+        }
+        p_file = fopen(p_file_name, "rb");
+        if ((NULL == p_file) || (0 != fseek(p_file, 0, SEEK_END)))
+        {
+            break;
+        }
+        size = ftell(p_file);
+        if ((PAL_LINUX_I2C_RECORD_FILE_HEADER_SIZE > size) || (0 != fseek(p_file, 0, SEEK_SET)))
+        {
+            break;
+        }
+        pal_i2c_replay.p_recording = (uint8_t *)malloc((size_t)size);
+        if (NULL == pal_i2c_replay.p_recording)
+        {
+            break;
+        }
+        if (((size_t)size != fread(pal_i2c_replay.p_recording, 1, (size_t)size, p_file)) ||
+            (0 != memcmp(pal_i2c_replay.p_recording, PAL_LINUX_I2C_RECORD_MAGIC, 4)) ||
+            (PAL_LINUX_I2C_RECORD_VERSION != pal_i2c_replay.p_recording[4]))
+        {
+            free(pal_i2c_replay.p_recording);
+            pal_i2c_replay.p_recording = NULL;
+            break;
+        }
+        pal_i2c_replay.size = (uint32_t)size;
+        pal_i2c_replay.offset = PAL_LINUX_I2C_RECORD_FILE_HEADER_SIZE;
+        pal_i2c_replay.time_scale_percent = time_scale_percent;
+        pal_i2c_replay.divergences = 0;
+        return_status = PAL_STATUS_SUCCESS;
+    } while (0);
+
+    if (NULL != p_file)
+    {
+        fclose(p_file);
+    }
+    return return_status;
+}
+
+pal_status_t pal_linux_i2c_replay_stop(uint32_t * p_divergences)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+
+    if (NULL != pal_i2c_replay.p_recording)
+    {
+        if ((0 == pal_i2c_replay.divergences) && (pal_i2c_replay.size == pal_i2c_replay.offset))
+        {
+            return_status = PAL_STATUS_SUCCESS;
+        }
+        if (NULL != p_divergences)
+        {
+            *p_divergences = pal_i2c_replay.divergences;
+        }
+        free(pal_i2c_replay.p_recording);
+        pal_i2c_replay.p_recording = NULL;
+    }
+    return return_status;
+}
+
+pal_status_t pal_i2c_init(const pal_i2c_t * p_i2c_context)
+{
+    // The bus is not used, the replay must be started
+    return (NULL != pal_i2c_replay.p_recording) ? PAL_STATUS_SUCCESS : PAL_STATUS_FAILURE;
+}
+
+pal_status_t pal_i2c_deinit(const pal_i2c_t * p_i2c_context)
+{
+    return PAL_STATUS_SUCCESS;
+}
+
+pal_status_t pal_i2c_set_bitrate(const pal_i2c_t * p_i2c_context, uint16_t bitrate)
+{
+    // Not a bus transfer, hence not recorded
+    if (0 != p_i2c_context->upper_layer_event_handler)
+    {
+        pal_i2c_replay_complete(p_i2c_context, PAL_I2C_EVENT_SUCCESS);
+    }
+    return PAL_STATUS_SUCCESS;
+}
+
+pal_status_t pal_i2c_write(const pal_i2c_t * p_i2c_context, uint8_t * p_data, uint16_t length)
+{
+    return pal_i2c_replay_transfer(p_i2c_context, p_data, length, FALSE);
+}
+
+pal_status_t pal_i2c_read(const pal_i2c_t * p_i2c_context, uint8_t * p_data, uint16_t length)
+{
+    return pal_i2c_replay_transfer(p_i2c_context, p_data, length, TRUE);
+}
+
+#endif //PAL_I2C_REPLAY
+
+/**
+* @}
+*/
@@ -38,6 +38,9 @@
 #define _PAL_LINUX_H_
 
 #include "optiga/pal/pal.h"
+#if defined(PAL_I2C_ASYNC) || defined(PAL_GPIO_CHARDEV)
+#include <pthread.h>
+#endif
 
 #define false 0
 #define true 1
@@ -46,18 +49,255 @@
 #define LOW 0
 typedef uint16_t gpio_pin_t;
 
-/** @brief PAL I2C context structure */
+#ifdef PAL_I2C_MUX
+/// Maximum number of cascaded I2C multiplexers between the bus and a slave
+#ifndef PAL_LINUX_I2C_MUX_MAX_DEPTH
+#define PAL_LINUX_I2C_MUX_MAX_DEPTH                 (0x02U)
+#endif
+/**
+ * Time in microseconds, the selected channel is held for the following transfers after a transfer on it.
+ * A device on another channel gets #PAL_I2C_EVENT_BUSY meanwhile and retries with the polling interval of the
+ * physical layer, hence the consecutive transfers of a frame exchange are not interleaved with channel switches.
+ * 0 switches the channel with every request.
+ */
+#ifndef PAL_LINUX_I2C_MUX_CHANNEL_HOLD_US
+#define PAL_LINUX_I2C_MUX_CHANNEL_HOLD_US           (250U)
+#endif
+
+/**
+ * @brief Path of PCA9548 style I2C multiplexer channels from the bus to a slave.
+ *
+ * Referenced by p_mux_path of the PAL I2C context of the device. The hops are ordered from the bus to the slave,
+ * e.g. the chips with the default slave address 0x30 behind two 8 channel multiplexers 0x70 and 0x71:
+ * - {1, {{0x70, 0}}} ... {1, {{0x70, 7}}} and {1, {{0x71, 0}}} ... {1, {{0x71, 7}}}
+ */
+typedef struct pal_linux_i2c_mux_path
+{
+    /// Number of the valid hops
+    uint8_t hop_count;
+    struct
+    {
+        /// Slave address of the multiplexer
+        uint8_t mux_address;
+        /// Channel (0 to 7) of the multiplexer
+        uint8_t channel;
+    } hops[PAL_LINUX_I2C_MUX_MAX_DEPTH];
+} pal_linux_i2c_mux_path_t;
+#endif
+
+/**
+ * @brief PAL I2C context structure, one per I2C bus.
+ *
+ * The devices on the same bus (e.g. several slave addresses on "/dev/i2c-1") share one context, hence the bus is
+ * arbitrated between them. Devices on different buses use separate contexts and run concurrently.
+ */
 typedef struct pal_linux
 {
     /// This field consists the handle for I2c device
     int32_t i2c_handle;
     /// Pointer to store the callers handler
     void * upper_layer_event_handler;
+    /// I2C bus device (e.g. "/dev/i2c-1"), the default bus device is used if NULL
+    const char * i2c_device;
+    /// Context of the device, which holds the bus
+    const void * p_current_ctx;
+    /// Indicates the bus is acquired, the devices on the same bus share this context
+    volatile uint32_t entry_count;
+    /// Number of the devices, which initialized the bus
+    uint8_t open_count;
+    /// Slave address selected on the bus handle
+    uint8_t current_slave_address;
+#ifdef PAL_I2C_MUX
+    /// Multiplexer channels selected on the bus, invalid once hop_count is 0
+    pal_linux_i2c_mux_path_t mux_selected;
+    /// End of the last transfer on the selected channels
+    uint32_t mux_last_transfer_time_us;
+    /// Number of the channel switches (control byte writes to a multiplexer)
+    uint32_t mux_switch_count;
+#endif
+#ifdef PAL_I2C_RDWR
+    /// Register address written, which is sent along with the following read as a combined transaction
+    uint8_t pending_register;
+    /// Slave address of the pending register address
+    uint8_t pending_register_address;
+    /// Indicates the register address is pending
+    uint8_t pending_register_valid;
+#endif
+#ifdef PAL_I2C_ASYNC
+    /// I/O thread of the bus
+    pthread_t async_thread;
+    /// Guards the queued transfer
+    pthread_mutex_t async_mutex;
+    /// Signals the I/O thread, once a transfer is queued
+    pthread_cond_t async_queued;
+    /// Data to be written or buffer to be read into by the queued transfer
+    uint8_t * p_async_data;
+    /// Length of the queued transfer
+    uint16_t async_length;
+    /// Indicates the queued transfer is a read
+    uint8_t async_is_read;
+    /// Indicates a transfer is queued
+    uint8_t async_is_pending;
+#endif
 } pal_linux_t;
 
 typedef struct pal_linux_gpio {
     gpio_pin_t pin_nr;
     int fd;
+#ifdef PAL_GPIO_CHARDEV
+    /// GPIO chip of the line (e.g. "/dev/gpiochip0"), the default chip is used if NULL
+    const char * chip;
+    /// Handler of the edge event, invoked on the event thread of the line
+    void (*irq_handler)(void *);
+    /// Context provided to the handler
+    void * irq_context;
+    /// Thread, which waits for the edge events of the line
+    pthread_t irq_thread;
+#endif
 } pal_linux_gpio_t;
 
+#if defined(PAL_I2C_RECORD) || defined(PAL_I2C_REPLAY)
+/**
+ * Format of the I2C recording, all the values are little endian:
+ * - File header: magic "OPTR", version (1 byte) and 3 reserved bytes.
+ * - One record per pal_i2c_write/pal_i2c_read: flags (1 byte), slave address (1 byte), length (2 bytes),
+ *   start time relative to the start of the recording (4 bytes) and duration (4 bytes) in microseconds, followed
+ *   by the data written or read. A failed read has no data.
+ */
+/// Magic of the recording file
+#define PAL_LINUX_I2C_RECORD_MAGIC                  "OPTR"
+/// Version of the recording format
+#define PAL_LINUX_I2C_RECORD_VERSION                (0x01U)
+/// Size of the file header
+#define PAL_LINUX_I2C_RECORD_FILE_HEADER_SIZE       (0x08U)
+/// Size of the record header
+#define PAL_LINUX_I2C_RECORD_HEADER_SIZE            (0x0CU)
+/// Record flag, the transfer is a read
+#define PAL_LINUX_I2C_RECORD_FLAG_READ              (0x01U)
+/// Record flag, the transfer failed (e.g. NACK while OPTIGA is busy)
+#define PAL_LINUX_I2C_RECORD_FLAG_ERROR             (0x02U)
+#endif
+
+#ifdef PAL_I2C_RECORD
+/**
+ * @brief Starts the recording of the I2C transfers.
+ *
+ * Each pal_i2c_write and pal_i2c_read of all the buses is written to the file with its time stamps, before the
+ * upper layer is informed. The recording is replayed by the replay PAL (pal_i2c_replay.c, PAL_I2C_REPLAY).
+ *
+ * @param[in] p_file_name   Name of the recording file, which is overwritten
+ *
+ * @retval    PAL_STATUS_SUCCESS   Recording is started
+ * @retval    PAL_STATUS_FAILURE   Recording is already started or the file cannot be created
+ */
+pal_status_t pal_linux_i2c_record_start(const char * p_file_name);
+
+/**
+ * @brief Stops the recording of the I2C transfers and completes the file.
+ *
+ * @retval    PAL_STATUS_SUCCESS   Recording file is completed
+ * @retval    PAL_STATUS_FAILURE   Recording is not started or the file cannot be written
+ */
+pal_status_t pal_linux_i2c_record_stop(void);
+
+/// @cond hidden
+// Records a transfer of pal_i2c.c, transfer_status is the result of the system call (negative on failure)
+void pal_linux_i2c_record(uint8_t slave_address,
+                          const uint8_t * p_data,
+                          uint16_t length,
+                          uint8_t is_read,
+                          int32_t transfer_status,
+                          uint32_t start_time_us);
+/// @endcond
+#endif
+
+#ifdef PAL_I2C_REPLAY
+/**
+ * @brief Starts the replay of an I2C recording.
+ *
+ * The replay PAL (pal_i2c_replay.c) replaces the bus transfers of pal_i2c.c. It completes the transfers of the stack with
+ * the recorded status and responses in the recorded order, without I2C hardware. Hence the host side cost of the
+ * protocol stack is measured deterministically. Responses of the shielded connection are only valid with the
+ * session keys of the recording, hence such recordings are replayed up to the handshake.
+ *
+ * @pre Invoked before pal_i2c_init.
+ *
+ * @param[in] p_file_name           Name of the recording file
+ * @param[in] time_scale_percent    Duration of the transfers in percent of the recorded duration, 0 completes the
+ *                                  transfers without delay
+ *
+ * @retval    PAL_STATUS_SUCCESS   Replay is started
+ * @retval    PAL_STATUS_FAILURE   Replay is already started or the file is not a valid recording
+ */
+pal_status_t pal_linux_i2c_replay_start(const char * p_file_name, uint16_t time_scale_percent);
+
+/**
+ * @brief Stops the replay of an I2C recording.
+ *
+ * @param[out] p_divergences        Number of the transfers which differ from the recording (type, slave address,
+ *                                  length or data written) or exceed it, can be NULL
+ *
+ * @retval    PAL_STATUS_SUCCESS   The stack issued exactly the recorded transfers
+ * @retval    PAL_STATUS_FAILURE   Replay is not started, the stack diverged or the recording is not consumed
+ */
+pal_status_t pal_linux_i2c_replay_stop(uint32_t * p_divergences);
+#endif
+
+#ifdef PAL_LOGGER_ASYNC
+/// Size of the ring of the asynchronous logger in bytes, must be a power of 2
+#ifndef PAL_LOGGER_ASYNC_BUFFER_SIZE
+#define PAL_LOGGER_ASYNC_BUFFER_SIZE                (0x4000U)
+#endif
+/// Time, which pal_logger_deinit waits for the pending messages to be written
+#define PAL_LOGGER_ASYNC_FLUSH_TIMEOUT_MS           (1000U)
+
+/**
+ * @brief Waits until the messages queued by pal_logger_write are written to the console.
+ *
+ * With PAL_LOGGER_ASYNC, pal_logger_write queues the message in a lock-free ring and returns without blocking.
+ * A drain thread, started by pal_logger_init (invoked by pal_init), writes the messages to the console. Hence
+ * logging from the comms state machine in the timer signal context does not change the timing of the protocol.
+ * Messages, which do not fit in the ring or are written while another message is queued (e.g. from the signal
+ * context interrupting the application), are dropped.
+ *
+ * @param[in] timeout_ms   Maximum time to wait
+ *
+ * @retval    PAL_STATUS_SUCCESS   All the queued messages are written
+ * @retval    PAL_STATUS_FAILURE   The messages are not written within the time or the drain thread is not started
+ */
+pal_status_t pal_linux_logger_flush(uint32_t timeout_ms);
+
+/**
+ * @brief Provides the number of messages dropped by the asynchronous logger.
+ *
+ * @retval    Number of dropped messages
+ */
+uint32_t pal_linux_logger_get_dropped_count(void);
+#endif
+
+#ifdef OPTIGA_LIB_TRACE_ENABLED
+/**
+ * @brief Starts the export of the trace events to a file in the Chrome trace event format.
+ *
+ * The events recorded by the library layers are written by a thread of the PAL, nested per instance. The file is
+ * opened in chrome://tracing or in the Perfetto UI. Events recorded before the start are discarded.
+ *
+ * @param[in] p_file_name   Name of the trace file, which is overwritten
+ *
+ * @retval    PAL_STATUS_SUCCESS   Export is started
+ * @retval    PAL_STATUS_FAILURE   Export is already started or the file cannot be created
+ */
+pal_status_t pal_linux_trace_export_start(const char * p_file_name);
+
+/**
+ * @brief Stops the export of the trace events.
+ *
+ * Writes the remaining events, closes the slices which are still open and completes the trace file.
+ *
+ * @retval    PAL_STATUS_SUCCESS   Trace file is completed
+ * @retval    PAL_STATUS_FAILURE   Export is not started or the file cannot be written
+ */
+pal_status_t pal_linux_trace_export_stop(void);
+#endif
+
 #endif
@@ -36,6 +36,14 @@
 */
 
 #include "optiga/pal/pal_logger.h"
+#include "pal_linux.h"
+#include <stdio.h>
+#ifdef PAL_LOGGER_ASYNC
+#include <pthread.h>
+#include <semaphore.h>
+#include <string.h>
+#include <time.h>
+#endif
 
 ///
 
@@ -46,20 +54,227 @@ pal_logger_t logger_console =
         .logger_tx_flag = 1
 };
 
+/// @cond hidden
+static void pal_logger_console_write(const uint8_t * p_log_data, uint32_t log_data_length)
+{
+    printf("pal_loger_write : ");
+    fwrite(p_log_data, 1, log_data_length, stdout);
+    printf("\n");
+}
+
+#ifdef PAL_LOGGER_ASYNC
+
+#if (0 != (PAL_LOGGER_ASYNC_BUFFER_SIZE & (PAL_LOGGER_ASYNC_BUFFER_SIZE - 1)))
+#error "PAL_LOGGER_ASYNC_BUFFER_SIZE must be a power of 2"
+#endif
+
+// Each message is stored as its length (2 bytes) followed by the data
+#define PAL_LOGGER_ASYNC_LENGTH_SIZE        (2U)
+// Interval of polling the drain, while the pending messages are flushed
+#define PAL_LOGGER_ASYNC_FLUSH_POLL_US      (1000U)
+
+static uint8_t pal_logger_async_buffer[PAL_LOGGER_ASYNC_BUFFER_SIZE];
+// Message being written to the console by the drain thread
+static uint8_t pal_logger_async_message[PAL_LOGGER_ASYNC_BUFFER_SIZE];
+// Positions of the ring, the head is written by the producer and the tail by the drain thread only
+static uint32_t pal_logger_async_head = 0;
+static uint32_t pal_logger_async_tail = 0;
+// Held by the producer while it writes to the ring, a concurrent or nested producer drops its message
+static uint32_t pal_logger_async_producer_busy = 0;
+static uint32_t pal_logger_async_dropped_count = 0;
+// Posted per message, sem_post is async signal safe, hence messages are written from the timer signal context
+static sem_t pal_logger_async_pending;
+static pthread_t pal_logger_async_thread;
+static volatile uint8_t pal_logger_async_started = 0;
+
+static void pal_logger_async_put(uint32_t position, const uint8_t * p_data, uint32_t length)
+{
+    uint32_t offset = position & (PAL_LOGGER_ASYNC_BUFFER_SIZE - 1);
+    uint32_t first_length = PAL_LOGGER_ASYNC_BUFFER_SIZE - offset;
+
+    if (first_length > length)
+    {
+        first_length = length;
+    }
+    memcpy(&pal_logger_async_buffer[offset], p_data, first_length);
+    memcpy(pal_logger_async_buffer, p_data + first_length, length - first_length);
+}
+
+static void pal_logger_async_get(uint32_t position, uint8_t * p_data, uint32_t length)
+{
+    uint32_t offset = position & (PAL_LOGGER_ASYNC_BUFFER_SIZE - 1);
+    uint32_t first_length = PAL_LOGGER_ASYNC_BUFFER_SIZE - offset;
+
+    if (first_length > length)
+    {
+        first_length = length;
+    }
+    memcpy(p_data, &pal_logger_async_buffer[offset], first_length);
+    memcpy(p_data + first_length, pal_logger_async_buffer, length - first_length);
+}
+
+/*
+* Queues the message without blocking, returns PAL_STATUS_FAILURE if it is dropped
+*/
+static pal_status_t pal_logger_async_write(const uint8_t * p_log_data, uint32_t log_data_length)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    uint8_t length[PAL_LOGGER_ASYNC_LENGTH_SIZE];
+    uint32_t head;
+    uint32_t tail;
+
+    do
+    {
+        if (0 != __atomic_exchange_n(&pal_logger_async_producer_busy, 1, __ATOMIC_ACQUIRE))
+        {
+            __atomic_fetch_add(&pal_logger_async_dropped_count, 1, __ATOMIC_RELAXED);
+            break;
+        }
+        head = pal_logger_async_head;
+        tail = __atomic_load_n(&pal_logger_async_tail, __ATOMIC_ACQUIRE);
+        if ((log_data_length > 0xFFFFU) ||
+            ((PAL_LOGGER_ASYNC_BUFFER_SIZE - (head - tail)) < (PAL_LOGGER_ASYNC_LENGTH_SIZE + log_data_length)))
+        {
+            __atomic_fetch_add(&pal_logger_async_dropped_count, 1, __ATOMIC_RELAXED);
+        }
+        else
+        {
+            length[0] = (uint8_t)log_data_length;
+            length[1] = (uint8_t)(log_data_length >> 8);
+            pal_logger_async_put(head, length, PAL_LOGGER_ASYNC_LENGTH_SIZE);
+            pal_logger_async_put(head + PAL_LOGGER_ASYNC_LENGTH_SIZE, p_log_data, log_data_length);
+            // The message is visible to the drain thread, once the head is released
+            __atomic_store_n(&pal_logger_async_head, head + PAL_LOGGER_ASYNC_LENGTH_SIZE + log_data_length,
+                             __ATOMIC_RELEASE);
+            (void)sem_post(&pal_logger_async_pending);
+            return_status = PAL_STATUS_SUCCESS;
+        }
+        __atomic_store_n(&pal_logger_async_producer_busy, 0, __ATOMIC_RELEASE);
+    } while (0);
+
+    return return_status;
+}
+
+/*
+* Drain thread, writes the queued messages to the console
+*/
+static void * pal_logger_async_drain(void * p_arg)
+{
+    uint8_t length[PAL_LOGGER_ASYNC_LENGTH_SIZE];
+    uint32_t head;
+    uint32_t tail;
+    uint32_t message_length;
+
+    (void)p_arg;
+    for (;;)
+    {
+        if (0 != sem_wait(&pal_logger_async_pending))
+        {
+            // Interrupted by a signal
+            continue;
+        }
+        tail = pal_logger_async_tail;
+        head = __atomic_load_n(&pal_logger_async_head, __ATOMIC_ACQUIRE);
+        while (head != tail)
+        {
+            pal_logger_async_get(tail, length, PAL_LOGGER_ASYNC_LENGTH_SIZE);
+            message_length = (uint32_t)length[0] | ((uint32_t)length[1] << 8);
+            pal_logger_async_get(tail + PAL_LOGGER_ASYNC_LENGTH_SIZE, pal_logger_async_message, message_length);
+            tail += PAL_LOGGER_ASYNC_LENGTH_SIZE + message_length;
+            __atomic_store_n(&pal_logger_async_tail, tail, __ATOMIC_RELEASE);
+            pal_logger_console_write(pal_logger_async_message, message_length);
+        }
+        fflush(stdout);
+    }
+    return NULL;
+}
+#endif //PAL_LOGGER_ASYNC
+/// @endcond
+
+pal_status_t pal_logger_init(void * p_logger_context)
+{
+    pal_status_t return_status = PAL_STATUS_SUCCESS;
+
+    (void)p_logger_context;
+#ifdef PAL_LOGGER_ASYNC
+    do
+    {
+        if (0 != pal_logger_async_started)
+        {
+            break;
+        }
+        if (0 != sem_init(&pal_logger_async_pending, 0, 0))
+        {
+            return_status = PAL_STATUS_FAILURE;
+            break;
+        }
+        if (0 != pthread_create(&pal_logger_async_thread, NULL, pal_logger_async_drain, NULL))
+        {
+            (void)sem_destroy(&pal_logger_async_pending);
+            return_status = PAL_STATUS_FAILURE;
+            break;
+        }
+        pal_logger_async_started = 1;
+    } while (0);
+#endif
+    return return_status;
+}
+
+pal_status_t pal_logger_deinit(void * p_logger_context)
+{
+    (void)p_logger_context;
+#ifdef PAL_LOGGER_ASYNC
+    // The drain thread is kept, since messages may still be written after the deinitialization
+    (void)pal_linux_logger_flush(PAL_LOGGER_ASYNC_FLUSH_TIMEOUT_MS);
+#endif
+    return PAL_STATUS_SUCCESS;
+}
+
 pal_status_t pal_logger_write(void * p_logger_context, const uint8_t * p_log_data, uint32_t log_data_length)
 {
-    int i;
+    pal_status_t return_status = PAL_STATUS_SUCCESS;
+
+    (void)p_logger_context;
+#ifdef PAL_LOGGER_ASYNC
+    if (0 != pal_logger_async_started)
+    {
+        return_status = pal_logger_async_write(p_log_data, log_data_length);
+    }
+    else
+#endif
+    {
+        // Written synchronously, until the drain thread is started by pal_logger_init
+        pal_logger_console_write(p_log_data, log_data_length);
+    }
+
+    return return_status;
+}
 
-	printf("pal_loger_write : ");
-	for (i=0; i<log_data_length;i++)
-	{
-		printf("%c",*(p_log_data+i));
-	}
-	printf("\n");
+#ifdef PAL_LOGGER_ASYNC
+pal_status_t pal_linux_logger_flush(uint32_t timeout_ms)
+{
+    struct timespec poll_interval = {0, PAL_LOGGER_ASYNC_FLUSH_POLL_US * 1000};
+    uint32_t waited_us = 0;
 
+    while (__atomic_load_n(&pal_logger_async_tail, __ATOMIC_ACQUIRE) !=
+           __atomic_load_n(&pal_logger_async_head, __ATOMIC_ACQUIRE))
+    {
+        if ((0 == pal_logger_async_started) || (waited_us >= (timeout_ms * 1000U)))
+        {
+            return PAL_STATUS_FAILURE;
+        }
+        (void)nanosleep(&poll_interval, NULL);
+        waited_us += PAL_LOGGER_ASYNC_FLUSH_POLL_US;
+    }
     return PAL_STATUS_SUCCESS;
 }
 
+uint32_t pal_linux_logger_get_dropped_count(void)
+{
+    return __atomic_load_n(&pal_logger_async_dropped_count, __ATOMIC_RELAXED);
+}
+#endif //PAL_LOGGER_ASYNC
+
 
 /**
 * @}
@@ -1,192 +1,392 @@
-/**
-* \copyright
-* MIT License
-*
-* Copyright (c) 2020 Infineon Technologies AG
-*
-* Permission is hereby granted, free of charge, to any person obtaining a copy
-* of this software and associated documentation files (the "Software"), to deal
-* in the Software without restriction, including without limitation the rights
-* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
-* copies of the Software, and to permit persons to whom the Software is
-* furnished to do so, subject to the following conditions:
-*
-* The above copyright notice and this permission notice shall be included in all
-* copies or substantial portions of the Software.
-*
-* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-* SOFTWARE
-*
-* \endcopyright
-*
-* \author Infineon Technologies AG
-*
-* \file pal_os_datastore.c
-*
-* \brief   This file implements the platform abstraction layer APIs for data store.
-*
-* \ingroup  grPAL
-*
-* @{
-*/
-
-#include "optiga/pal/pal_os_datastore.h"
-/// @cond hidden
-
-/// Size of length field 
-#define LENGTH_SIZE                (0x02)
-/// Size of data store buffer to hold the shielded connection manage context information (2 bytes length field + 64(0x40) bytes context)
-#define MANAGE_CONTEXT_BUFFER_SIZE      (0x42)
-
-//Internal buffer to store the shielded connection manage context information (length field + Data)
-uint8_t data_store_manage_context_buffer [LENGTH_SIZE + MANAGE_CONTEXT_BUFFER_SIZE];
-
-//Internal buffer to store the optiga application context data during hibernate(length field + Data)
-uint8_t data_store_app_context_buffer [LENGTH_SIZE + APP_CONTEXT_SIZE];
-
-//Internal buffer to store the generated platform binding shared secret on Host (length field + shared secret)
-uint8_t optiga_platform_binding_shared_secret [LENGTH_SIZE + OPTIGA_SHARED_SECRET_MAX_LENGTH] = 
-{
-    // Length of the shared secret, followed after the length information
-    0x00 ,0x40, 
-    // Shared secret. Buffer is defined to the maximum supported length [64 bytes]. 
-    // But the actual size used is to be specified in the length field.
-    0x01 ,0x02 ,0x03 ,0x04 ,0x05 ,0x06 ,0x07 ,0x08 ,0x09 ,0x0A ,0x0B ,0x0C ,0x0D ,0x0E ,0x0F ,0x10,
-    0x11 ,0x12 ,0x13 ,0x14 ,0x15 ,0x16 ,0x17 ,0x18 ,0x19 ,0x1A ,0x1B ,0x1C ,0x1D ,0x1E ,0x1F ,0x20,
-    0x21 ,0x22 ,0x23 ,0x24 ,0x25 ,0x26 ,0x27 ,0x28 ,0x29 ,0x2A ,0x2B ,0x2C ,0x2D ,0x2E ,0x2F ,0x30,
-    0x31 ,0x32 ,0x33 ,0x34 ,0x35 ,0x36 ,0x37 ,0x38 ,0x39 ,0x3A ,0x3B ,0x3C ,0x3D ,0x3E ,0x3F ,0x40
-};
-
-
-pal_status_t pal_os_datastore_write(uint16_t datastore_id,
-                                    const uint8_t * p_buffer,
-                                    uint16_t length)
-{
-    pal_status_t return_status = PAL_STATUS_FAILURE;
-    uint8_t offset = 0;
-
-    switch(datastore_id)
-    {
-        case OPTIGA_PLATFORM_BINDING_SHARED_SECRET_ID:
-        {
-            // !!!OPTIGA_LIB_PORTING_REQUIRED
-            // This has to be enhanced by user only, in case of updating
-            // the platform binding shared secret during the runtime into NVM.
-            // In current implementation, platform binding shared secret is 
-            // stored in RAM.
-            if (length <= OPTIGA_SHARED_SECRET_MAX_LENGTH)
-            {
-                optiga_platform_binding_shared_secret[offset++] = (uint8_t)(length>>8);
-                optiga_platform_binding_shared_secret[offset++] = (uint8_t)(length);
-                memcpy(&optiga_platform_binding_shared_secret[offset], p_buffer, length);
-                return_status = PAL_STATUS_SUCCESS;
-            }
-            break;
-        }
-        case OPTIGA_COMMS_MANAGE_CONTEXT_ID:
-        {
-            // !!!OPTIGA_LIB_PORTING_REQUIRED
-            // This has to be enhanced by user only, in case of storing 
-            // the manage context information in non-volatile memory 
-            // to reuse for later during hard reset scenarios where the 
-            // RAM gets flushed out.
-            data_store_manage_context_buffer[offset++] = (uint8_t)(length>>8);
-            data_store_manage_context_buffer[offset++] = (uint8_t)(length);
-            memcpy(&data_store_manage_context_buffer[offset],p_buffer,length);
-            return_status = PAL_STATUS_SUCCESS;
-            break;
-        }
-        case OPTIGA_HIBERNATE_CONTEXT_ID:
-        {
-            // !!!OPTIGA_LIB_PORTING_REQUIRED
-            // This has to be enhanced by user only, in case of storing 
-            // the application context information in non-volatile memory 
-            // to reuse for later during hard reset scenarios where the 
-            // RAM gets flushed out.
-            data_store_app_context_buffer[offset++] = (uint8_t)(length>>8);
-            data_store_app_context_buffer[offset++] = (uint8_t)(length);
-            memcpy(&data_store_app_context_buffer[offset],p_buffer,length);
-            return_status = PAL_STATUS_SUCCESS;
-            break;
-        }
-        default:
-        {
-            break;
-        }
-    }
-    return return_status;
-}
-
-
-pal_status_t pal_os_datastore_read(uint16_t datastore_id, 
-                                   uint8_t * p_buffer, 
-                                   uint16_t * p_buffer_length)
-{
-    pal_status_t return_status = PAL_STATUS_FAILURE;
-    uint16_t data_length;
-    uint8_t offset = 0;
-
-    switch(datastore_id)
-    {
-        case OPTIGA_PLATFORM_BINDING_SHARED_SECRET_ID:
-        {
-            // !!!OPTIGA_LIB_PORTING_REQUIRED
-            // This has to be enhanced by user only,
-            // if the platform binding shared secret is stored in non-volatile 
-            // memory with a specific location and not as a context segment 
-            // else updating the share secret content is good enough.
-
-            data_length = (uint16_t) (optiga_platform_binding_shared_secret[offset++] << 8);
-            data_length |= (uint16_t)(optiga_platform_binding_shared_secret[offset++]);
-            if (data_length <= OPTIGA_SHARED_SECRET_MAX_LENGTH)
-            {
-                memcpy(p_buffer,&optiga_platform_binding_shared_secret[offset], data_length);
-                *p_buffer_length = data_length;
-                return_status = PAL_STATUS_SUCCESS;
-            }
-            break;
-        }
-        case OPTIGA_COMMS_MANAGE_CONTEXT_ID:
-        {
-            // !!!OPTIGA_LIB_PORTING_REQUIRED
-            // This has to be enhanced by user only,
-            // if manage context information is stored in NVM during the hibernate, 
-            // else this is not required to be enhanced.
-            data_length = (uint16_t) (data_store_manage_context_buffer[offset++] << 8);
-            data_length |= (uint16_t)(data_store_manage_context_buffer[offset++]);
-            memcpy(p_buffer, &data_store_manage_context_buffer[offset], data_length);
-            *p_buffer_length = data_length;
-            return_status = PAL_STATUS_SUCCESS;
-            break;
-        }
-        case OPTIGA_HIBERNATE_CONTEXT_ID:
-        {
-            // !!!OPTIGA_LIB_PORTING_REQUIRED
-            // This has to be enhanced by user only,
-            // if application context information is stored in NVM during the hibernate, 
-            // else this is not required to be enhanced.
-            data_length = (uint16_t) (data_store_app_context_buffer[offset++] << 8);
-            data_length |= (uint16_t)(data_store_app_context_buffer[offset++]);
-            memcpy(p_buffer, &data_store_app_context_buffer[offset], data_length);
-            *p_buffer_length = data_length;
-            return_status = PAL_STATUS_SUCCESS;
-            break;
-        }
-        default:
-        {
-            *p_buffer_length = 0;
-            break;
-        }
-    }
-
-    return return_status;
-}
-/// @endcond
-/**
-* @}
-*/
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_os_datastore.c
+*
+* \brief   This file implements the platform abstraction layer APIs for data store.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "optiga/pal/pal_os_datastore.h"
+/// @cond hidden
+
+/// Size of length field 
+#define LENGTH_SIZE                (0x02)
+/// Size of data store buffer to hold the shielded connection manage context information (2 bytes length field + 64(0x40) bytes context)
+#define MANAGE_CONTEXT_BUFFER_SIZE      (0x42)
+/// File to store the communication link state, which must persist across restarts of the host application
+#ifndef LINK_STATE_FILE
+#define LINK_STATE_FILE                 "/var/tmp/optiga_link_state"
+#endif
+/// File to store the pending increments of the counter data objects, which must persist across restarts of the host application
+#ifndef PENDING_COUNT_FILE
+#define PENDING_COUNT_FILE              "/var/tmp/optiga_pending_count"
+#endif
+/// File to store the slave addresses assigned by the bus enumeration, which must persist across restarts of the host
+#ifndef BUS_MAP_FILE
+#define BUS_MAP_FILE                    "/var/tmp/optiga_bus_map"
+#endif
+/// Define PAL_OS_DATASTORE_DIR (e.g. "/var/lib/optiga") to persist the shared secret, the manage context and
+/// the hibernate context in files of the directory, hence the contexts are restored after a restart of the host application
+/// Set to 0 to skip the fsync of file and directory, a write is still atomic but may be lost on power loss
+#ifndef PAL_OS_DATASTORE_FSYNC
+#define PAL_OS_DATASTORE_FSYNC          (1)
+#endif
+/// Maximum length of the path of a datastore file
+#define DATASTORE_PATH_MAX_LENGTH       (0x100)
+
+//Internal buffer to store the shielded connection manage context information (length field + Data)
+uint8_t data_store_manage_context_buffer [LENGTH_SIZE + MANAGE_CONTEXT_BUFFER_SIZE];
+
+//Internal buffer to store the optiga application context data during hibernate(length field + Data)
+uint8_t data_store_app_context_buffer [LENGTH_SIZE + APP_CONTEXT_SIZE];
+
+//Internal buffer to store the generated platform binding shared secret on Host (length field + shared secret)
+uint8_t optiga_platform_binding_shared_secret [LENGTH_SIZE + OPTIGA_SHARED_SECRET_MAX_LENGTH] = 
+{
+    // Length of the shared secret, followed after the length information
+    0x00 ,0x40, 
+    // Shared secret. Buffer is defined to the maximum supported length [64 bytes]. 
+    // But the actual size used is to be specified in the length field.
+    0x01 ,0x02 ,0x03 ,0x04 ,0x05 ,0x06 ,0x07 ,0x08 ,0x09 ,0x0A ,0x0B ,0x0C ,0x0D ,0x0E ,0x0F ,0x10,
+    0x11 ,0x12 ,0x13 ,0x14 ,0x15 ,0x16 ,0x17 ,0x18 ,0x19 ,0x1A ,0x1B ,0x1C ,0x1D ,0x1E ,0x1F ,0x20,
+    0x21 ,0x22 ,0x23 ,0x24 ,0x25 ,0x26 ,0x27 ,0x28 ,0x29 ,0x2A ,0x2B ,0x2C ,0x2D ,0x2E ,0x2F ,0x30,
+    0x31 ,0x32 ,0x33 ,0x34 ,0x35 ,0x36 ,0x37 ,0x38 ,0x39 ,0x3A ,0x3B ,0x3C ,0x3D ,0x3E ,0x3F ,0x40
+};
+
+
+/**
+* Writes the data to the file atomically
+*
+* - The data is written to a temporary file, which replaces the file by rename.
+*   Hence the file holds either the previous or the new data, even if the host application is terminated during the write.
+* - The files are accessible to the owner only, as they contain session keys and secrets.
+*/
+static pal_status_t pal_os_datastore_file_write(const char * p_path, const uint8_t * p_buffer, uint16_t length)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    char temp_path[DATASTORE_PATH_MAX_LENGTH];
+    char directory[DATASTORE_PATH_MAX_LENGTH];
+    char * p_separator;
+    int file_descriptor;
+    int written = FALSE;
+
+    do
+    {
+        if ((int)sizeof(temp_path) <= snprintf(temp_path, sizeof(temp_path), "%s.tmp", p_path))
+        {
+            break;
+        }
+        file_descriptor = open(temp_path, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+        if (0 > file_descriptor)
+        {
+            break;
+        }
+        if ((ssize_t)length == write(file_descriptor, p_buffer, length))
+        {
+            written = ((0 == PAL_OS_DATASTORE_FSYNC) || (0 == fsync(file_descriptor))) ? TRUE : FALSE;
+        }
+        close(file_descriptor);
+        if ((TRUE != written) || (0 != rename(temp_path, p_path)))
+        {
+            (void)unlink(temp_path);
+            break;
+        }
+#if (0 != PAL_OS_DATASTORE_FSYNC)
+        // The rename is durable, once the directory entry is synced
+        strncpy(directory, p_path, sizeof(directory) - 1);
+        directory[sizeof(directory) - 1] = '\0';
+        p_separator = strrchr(directory, '/');
+        if (NULL != p_separator)
+        {
+            // Keeps the root directory, if the file is located there
+            p_separator[(p_separator == directory) ? 1 : 0] = '\0';
+            file_descriptor = open(directory, O_RDONLY | O_DIRECTORY);
+            if (0 <= file_descriptor)
+            {
+                (void)fsync(file_descriptor);
+                close(file_descriptor);
+            }
+        }
+#else
+        (void)directory;
+        (void)p_separator;
+#endif
+        return_status = PAL_STATUS_SUCCESS;
+    } while (0);
+    return return_status;
+}
+
+/**
+* Reads up to the provided length from the file, a missing file is reported as failure
+*/
+static pal_status_t pal_os_datastore_file_read(const char * p_path, uint8_t * p_buffer, uint16_t * p_buffer_length)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    int file_descriptor;
+    ssize_t read_length;
+
+    file_descriptor = open(p_path, O_RDONLY);
+    if (0 <= file_descriptor)
+    {
+        read_length = read(file_descriptor, p_buffer, *p_buffer_length);
+        if (0 <= read_length)
+        {
+            *p_buffer_length = (uint16_t)read_length;
+            return_status = PAL_STATUS_SUCCESS;
+        }
+        close(file_descriptor);
+    }
+    return return_status;
+}
+
+#ifdef PAL_OS_DATASTORE_DIR
+// Builds the path of the file, which persists the data of the datastore id
+static const char * pal_os_datastore_path(uint16_t datastore_id, char * p_path)
+{
+    (void)snprintf(p_path, DATASTORE_PATH_MAX_LENGTH, "%s/optiga_datastore_%04X", PAL_OS_DATASTORE_DIR, datastore_id);
+    return p_path;
+}
+#endif
+
+pal_status_t pal_os_datastore_write(uint16_t datastore_id,
+                                    const uint8_t * p_buffer,
+                                    uint16_t length)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    uint8_t offset = 0;
+#ifdef PAL_OS_DATASTORE_DIR
+    char path[DATASTORE_PATH_MAX_LENGTH];
+#endif
+
+    switch(datastore_id)
+    {
+        case OPTIGA_PLATFORM_BINDING_SHARED_SECRET_ID:
+        {
+            // !!!OPTIGA_LIB_PORTING_REQUIRED
+            // This has to be enhanced by user only, in case of updating
+            // the platform binding shared secret during the runtime into NVM.
+            // In current implementation, platform binding shared secret is 
+            // stored in RAM.
+            if (length <= OPTIGA_SHARED_SECRET_MAX_LENGTH)
+            {
+                optiga_platform_binding_shared_secret[offset++] = (uint8_t)(length>>8);
+                optiga_platform_binding_shared_secret[offset++] = (uint8_t)(length);
+                memcpy(&optiga_platform_binding_shared_secret[offset], p_buffer, length);
+                return_status = PAL_STATUS_SUCCESS;
+#ifdef PAL_OS_DATASTORE_DIR
+                return_status = pal_os_datastore_file_write(pal_os_datastore_path(datastore_id, path), p_buffer, length);
+#endif
+            }
+            break;
+        }
+        case OPTIGA_COMMS_MANAGE_CONTEXT_ID:
+        {
+            // !!!OPTIGA_LIB_PORTING_REQUIRED
+            // This has to be enhanced by user only, in case of storing 
+            // the manage context information in non-volatile memory 
+            // to reuse for later during hard reset scenarios where the 
+            // RAM gets flushed out.
+            data_store_manage_context_buffer[offset++] = (uint8_t)(length>>8);
+            data_store_manage_context_buffer[offset++] = (uint8_t)(length);
+            memcpy(&data_store_manage_context_buffer[offset],p_buffer,length);
+            return_status = PAL_STATUS_SUCCESS;
+#ifdef PAL_OS_DATASTORE_DIR
+            return_status = pal_os_datastore_file_write(pal_os_datastore_path(datastore_id, path), p_buffer, length);
+#endif
+            break;
+        }
+        case OPTIGA_HIBERNATE_CONTEXT_ID:
+        {
+            // !!!OPTIGA_LIB_PORTING_REQUIRED
+            // This has to be enhanced by user only, in case of storing 
+            // the application context information in non-volatile memory 
+            // to reuse for later during hard reset scenarios where the 
+            // RAM gets flushed out.
+            data_store_app_context_buffer[offset++] = (uint8_t)(length>>8);
+            data_store_app_context_buffer[offset++] = (uint8_t)(length);
+            memcpy(&data_store_app_context_buffer[offset],p_buffer,length);
+            return_status = PAL_STATUS_SUCCESS;
+#ifdef PAL_OS_DATASTORE_DIR
+            return_status = pal_os_datastore_file_write(pal_os_datastore_path(datastore_id, path), p_buffer, length);
+#endif
+            break;
+        }
+        case OPTIGA_COMMS_LINK_STATE_ID:
+        {
+            // The link state contains the session key of the shielded connection,
+            // hence the file is accessible to the owner only.
+            return_status = pal_os_datastore_file_write(LINK_STATE_FILE, p_buffer, length);
+            break;
+        }
+        case OPTIGA_UTIL_PENDING_COUNT_ID:
+        {
+            return_status = pal_os_datastore_file_write(PENDING_COUNT_FILE, p_buffer, length);
+            break;
+        }
+        case OPTIGA_COMMS_BUS_MAP_ID:
+        {
+            return_status = pal_os_datastore_file_write(BUS_MAP_FILE, p_buffer, length);
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+    return return_status;
+}
+
+
+pal_status_t pal_os_datastore_read(uint16_t datastore_id, 
+                                   uint8_t * p_buffer, 
+                                   uint16_t * p_buffer_length)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    uint16_t data_length;
+    uint8_t offset = 0;
+#ifdef PAL_OS_DATASTORE_DIR
+    char path[DATASTORE_PATH_MAX_LENGTH];
+#endif
+
+#ifdef PAL_OS_DATASTORE_DIR
+    // The persisted data is used, if available. Otherwise the data of the RAM buffers (e.g. default shared secret).
+    switch(datastore_id)
+    {
+        case OPTIGA_PLATFORM_BINDING_SHARED_SECRET_ID:
+        {
+            data_length = OPTIGA_SHARED_SECRET_MAX_LENGTH;
+            break;
+        }
+        case OPTIGA_COMMS_MANAGE_CONTEXT_ID:
+        {
+            data_length = MANAGE_CONTEXT_BUFFER_SIZE;
+            break;
+        }
+        case OPTIGA_HIBERNATE_CONTEXT_ID:
+        {
+            data_length = APP_CONTEXT_SIZE;
+            break;
+        }
+        default:
+        {
+            data_length = 0;
+            break;
+        }
+    }
+    if ((0 != data_length) &&
+        (PAL_STATUS_SUCCESS == pal_os_datastore_file_read(pal_os_datastore_path(datastore_id, path), p_buffer, &data_length)))
+    {
+        *p_buffer_length = data_length;
+        return_status = PAL_STATUS_SUCCESS;
+    }
+    else
+#endif
+    switch(datastore_id)
+    {
+        case OPTIGA_PLATFORM_BINDING_SHARED_SECRET_ID:
+        {
+            // !!!OPTIGA_LIB_PORTING_REQUIRED
+            // This has to be enhanced by user only,
+            // if the platform binding shared secret is stored in non-volatile 
+            // memory with a specific location and not as a context segment 
+            // else updating the share secret content is good enough.
+
+            data_length = (uint16_t) (optiga_platform_binding_shared_secret[offset++] << 8);
+            data_length |= (uint16_t)(optiga_platform_binding_shared_secret[offset++]);
+            if (data_length <= OPTIGA_SHARED_SECRET_MAX_LENGTH)
+            {
+                memcpy(p_buffer,&optiga_platform_binding_shared_secret[offset], data_length);
+                *p_buffer_length = data_length;
+                return_status = PAL_STATUS_SUCCESS;
+            }
+            break;
+        }
+        case OPTIGA_COMMS_MANAGE_CONTEXT_ID:
+        {
+            // !!!OPTIGA_LIB_PORTING_REQUIRED
+            // This has to be enhanced by user only,
+            // if manage context information is stored in NVM during the hibernate, 
+            // else this is not required to be enhanced.
+            data_length = (uint16_t) (data_store_manage_context_buffer[offset++] << 8);
+            data_length |= (uint16_t)(data_store_manage_context_buffer[offset++]);
+            memcpy(p_buffer, &data_store_manage_context_buffer[offset], data_length);
+            *p_buffer_length = data_length;
+            return_status = PAL_STATUS_SUCCESS;
+            break;
+        }
+        case OPTIGA_HIBERNATE_CONTEXT_ID:
+        {
+            // !!!OPTIGA_LIB_PORTING_REQUIRED
+            // This has to be enhanced by user only,
+            // if application context information is stored in NVM during the hibernate, 
+            // else this is not required to be enhanced.
+            data_length = (uint16_t) (data_store_app_context_buffer[offset++] << 8);
+            data_length |= (uint16_t)(data_store_app_context_buffer[offset++]);
+            memcpy(p_buffer, &data_store_app_context_buffer[offset], data_length);
+            *p_buffer_length = data_length;
+            return_status = PAL_STATUS_SUCCESS;
+            break;
+        }
+        case OPTIGA_COMMS_LINK_STATE_ID:
+        {
+            // Reads up to the provided buffer length, a missing file is reported as failure
+            return_status = pal_os_datastore_file_read(LINK_STATE_FILE, p_buffer, p_buffer_length);
+            break;
+        }
+        case OPTIGA_UTIL_PENDING_COUNT_ID:
+        {
+            return_status = pal_os_datastore_file_read(PENDING_COUNT_FILE, p_buffer, p_buffer_length);
+            break;
+        }
+        case OPTIGA_COMMS_BUS_MAP_ID:
+        {
+            return_status = pal_os_datastore_file_read(BUS_MAP_FILE, p_buffer, p_buffer_length);
+            break;
+        }
+        default:
+        {
+            *p_buffer_length = 0;
+            break;
+        }
+    }
+
+    return return_status;
+}
+/// @endcond
+/**
+* @}
+*/
@@ -34,12 +34,24 @@
 * @{
 */
 
+#if defined(PAL_OS_EVENT_THREAD) && !defined(_GNU_SOURCE)
+// CPU affinity of the worker thread
+#define _GNU_SOURCE
+#endif
 #include <stdlib.h>
 #include <stdint.h>
 #include <unistd.h>
 #include <stdio.h>
 #include <signal.h>
 #include <time.h>
+#ifdef PAL_OS_EVENT_THREAD
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#endif
+#include "optiga/optiga_lib_config.h"
 #include "optiga/pal/pal_os_timer.h"
 #include "optiga/pal/pal_os_event.h"
 
@@ -61,22 +73,234 @@
 
 #endif
 
-#define CLOCKID CLOCK_REALTIME
+#define CLOCKID CLOCK_MONOTONIC
 #define SIG SIGRTMIN
 
+/// Waits shorter than this are spun on the clock, longer waits sleep on the timer and spin only for the last part of it
+#define PAL_OS_EVENT_SPIN_THRESHOLD_US (100)
+
+// Define PAL_OS_EVENT_THREAD to run the events on a dedicated worker thread (timerfd + epoll) instead of
+// the SIGRTMIN timer signal, so that no application thread is interrupted and no signal is used by the library.
+// The thread is linked with -lpthread.
+#ifdef PAL_OS_EVENT_THREAD
+/// Real time (SCHED_FIFO) priority of the worker thread, 0 keeps the default scheduling policy
+#ifndef PAL_OS_EVENT_THREAD_PRIORITY
+#define PAL_OS_EVENT_THREAD_PRIORITY (0)
+#endif
+/// CPU to which the worker thread is pinned, -1 does not pin the thread
+#ifndef PAL_OS_EVENT_THREAD_CPU
+#define PAL_OS_EVENT_THREAD_CPU (-1)
+#endif
+#endif
+
+/// Number of events, one for each OPTIGA instance
+#ifdef OPTIGA_MAX_NUMBER_OF_INSTANCES
+#define PAL_OS_EVENT_MAX_INSTANCES OPTIGA_MAX_NUMBER_OF_INSTANCES
+#else
+#define PAL_OS_EVENT_MAX_INSTANCES (1)
+#endif
+
+static void pal_os_event_trigger(pal_os_event_t * p_pal_os_event);
+
+/// @cond hidden
+
+static pal_os_event_t pal_os_event_list[PAL_OS_EVENT_MAX_INSTANCES] = {0};
+// Time (CLOCKID) at which the registered callback of each event is due
+static struct timespec deadline_list[PAL_OS_EVENT_MAX_INSTANCES];
+#define pal_os_event_0 (pal_os_event_list[0])
+
+#ifndef PAL_OS_EVENT_THREAD
+static timer_t timerid_list[PAL_OS_EVENT_MAX_INSTANCES];
 
 static void handler(int sig, siginfo_t *si, void *uc)
 {
 	TRUSTM_PAL_EVENT_DBGFN(">");    
-	pal_os_event_trigger_registered_callback();
+	// timer of each event carries the event as signal value
+	pal_os_event_trigger((pal_os_event_t *)si->si_value.sival_ptr);
 	TRUSTM_PAL_EVENT_DBGFN("<");    
 }
 
+static int pal_os_event_create_timer(pal_os_event_t * p_pal_os_event, uint8_t index)
+{
+    struct sigevent sev;
+    struct sigaction sa;
 
-/// @cond hidden
+    /* Establishing handler for signal */
+    sa.sa_flags = SA_SIGINFO;
+    sa.sa_sigaction = handler;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(SIG, &sa, NULL) == -1)
+    {
+        printf("sigaction\n");
+        return (-1);
+    }
+
+    /* Create the timer */
+    sev.sigev_notify = SIGEV_SIGNAL;
+    sev.sigev_signo = SIG;
+    sev.sigev_value.sival_ptr = p_pal_os_event;
+    if (timer_create(CLOCKID, &sev, &timerid_list[index]) == -1)
+    {
+        printf("timer_create\n");
+        return (-1);
+    }
+    p_pal_os_event->os_timer = &timerid_list[index];
+    return (0);
+}
+
+static int pal_os_event_set_timer(const pal_os_event_t * p_pal_os_event, int flags, const struct itimerspec * p_its)
+{
+    return (timer_settime(*(timer_t *)p_pal_os_event->os_timer, (0 != flags) ? TIMER_ABSTIME : 0, p_its, NULL));
+}
+
+static void pal_os_event_delete_timer(const pal_os_event_t * p_pal_os_event)
+{
+    timer_delete(*(timer_t *)p_pal_os_event->os_timer);
+}
+
+#define pal_os_event_enter()
+#define pal_os_event_exit()
+
+#else
+static int timer_fd_list[PAL_OS_EVENT_MAX_INSTANCES];
+// epoll instance of the worker thread, which waits on the timerfd of all the events
+static int epoll_fd = -1;
+static pthread_t event_thread;
+// Serializes the registration of callbacks from the application threads with the worker thread
+static pthread_mutex_t event_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+#define pal_os_event_enter() pthread_mutex_lock(&event_mutex)
+#define pal_os_event_exit()  pthread_mutex_unlock(&event_mutex)
+
+static void * pal_os_event_thread(void * p_args)
+{
+    struct epoll_event events[PAL_OS_EVENT_MAX_INSTANCES];
+    uint64_t expirations;
+    int count;
+    int index;
+
+    (void)p_args;
+    for (;;)
+    {
+        count = epoll_wait(epoll_fd, events, PAL_OS_EVENT_MAX_INSTANCES, -1);
+        if (-1 == count)
+        {
+            if (EINTR != errno)
+            {
+                TRUSTM_PAL_EVENT_ERRFN("epoll_wait failed\n");
+                break;
+            }
+            continue;
+        }
+        for (index = 0; index < count; index++)
+        {
+            // timerfd of each event carries the event as epoll data, the read acknowledges the expiry
+            if (sizeof(expirations) == read(*(int *)((pal_os_event_t *)events[index].data.ptr)->os_timer,
+                                            &expirations, sizeof(expirations)))
+            {
+                pal_os_event_trigger((pal_os_event_t *)events[index].data.ptr);
+            }
+        }
+    }
+    return (NULL);
+}
 
-static pal_os_event_t pal_os_event_0 = {0};
-static 	timer_t timerid;
+static int pal_os_event_start_thread(void)
+{
+    pthread_attr_t attr;
+    struct sched_param param;
+    int status;
+#if PAL_OS_EVENT_THREAD_CPU >= 0
+    cpu_set_t cpu_set;
+#endif
+
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (-1 == epoll_fd)
+    {
+        return (-1);
+    }
+    pthread_attr_init(&attr);
+#if PAL_OS_EVENT_THREAD_PRIORITY > 0
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+    param.sched_priority = PAL_OS_EVENT_THREAD_PRIORITY;
+    pthread_attr_setschedparam(&attr, &param);
+#else
+    (void)param;
+#endif
+#if PAL_OS_EVENT_THREAD_CPU >= 0
+    CPU_ZERO(&cpu_set);
+    CPU_SET(PAL_OS_EVENT_THREAD_CPU, &cpu_set);
+    pthread_attr_setaffinity_np(&attr, sizeof(cpu_set), &cpu_set);
+#endif
+    status = pthread_create(&event_thread, &attr, pal_os_event_thread, NULL);
+    if (0 != status)
+    {
+        // Real time priority requires privileges, fall back to the default scheduling policy
+        TRUSTM_PAL_EVENT_MSGFN("Worker thread created with default attributes (%d)\n", status);
+        status = pthread_create(&event_thread, NULL, pal_os_event_thread, NULL);
+    }
+    pthread_attr_destroy(&attr);
+    if (0 != status)
+    {
+        close(epoll_fd);
+        epoll_fd = -1;
+        return (-1);
+    }
+    return (0);
+}
+
+static int pal_os_event_create_timer(pal_os_event_t * p_pal_os_event, uint8_t index)
+{
+    struct epoll_event event;
+
+    // The worker thread is started with the first event and serves all the events
+    if ((-1 == epoll_fd) && (-1 == pal_os_event_start_thread()))
+    {
+        printf("pal_os_event_start_thread\n");
+        return (-1);
+    }
+    timer_fd_list[index] = timerfd_create(CLOCKID, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (-1 == timer_fd_list[index])
+    {
+        printf("timerfd_create\n");
+        return (-1);
+    }
+    event.events = EPOLLIN;
+    event.data.ptr = p_pal_os_event;
+    if (-1 == epoll_ctl(epoll_fd, EPOLL_CTL_ADD, timer_fd_list[index], &event))
+    {
+        printf("epoll_ctl\n");
+        close(timer_fd_list[index]);
+        return (-1);
+    }
+    p_pal_os_event->os_timer = &timer_fd_list[index];
+    return (0);
+}
+
+static int pal_os_event_set_timer(const pal_os_event_t * p_pal_os_event, int flags, const struct itimerspec * p_its)
+{
+    return (timerfd_settime(*(int *)p_pal_os_event->os_timer, (0 != flags) ? TFD_TIMER_ABSTIME : 0, p_its, NULL));
+}
+
+static void pal_os_event_delete_timer(const pal_os_event_t * p_pal_os_event)
+{
+    (void)epoll_ctl(epoll_fd, EPOLL_CTL_DEL, *(int *)p_pal_os_event->os_timer, NULL);
+    close(*(int *)p_pal_os_event->os_timer);
+}
+#endif //PAL_OS_EVENT_THREAD
+
+// Spins on the clock until the deadline, the timer has already fired for long waits
+static void pal_os_event_spin_until(const struct timespec * p_deadline)
+{
+    struct timespec now;
+
+    do
+    {
+        clock_gettime(CLOCKID, &now);
+    } while ((now.tv_sec < p_deadline->tv_sec) ||
+             ((now.tv_sec == p_deadline->tv_sec) && (now.tv_nsec < p_deadline->tv_nsec)));
+}
 
 void pal_os_event_start(pal_os_event_t * p_pal_os_event, register_callback callback, void * callback_args)
 {
@@ -112,7 +336,7 @@ void pal_os_event_disarm(void)
 	its.it_interval.tv_sec = 0;
 	its.it_interval.tv_nsec = 0;
 	
-	if (timer_settime(timerid, 0, &its, NULL) == -1)
+	if (pal_os_event_set_timer(&pal_os_event_0, 0, &its) == -1)
 	{
 		printf("Error in timer_settime\n");
 	    exit(1);
@@ -129,9 +353,9 @@ void pal_os_event_arm(void)
 	its.it_value.tv_sec = 0;
 	its.it_value.tv_nsec = 1000000;
 	its.it_interval.tv_sec = 0;
-	its.it_interval.tv_nsec = 294967296;
+	its.it_interval.tv_nsec = 0;
 	
-	if (timer_settime(timerid, 0, &its, NULL) == -1)
+	if (pal_os_event_set_timer(&pal_os_event_0, 0, &its) == -1)
 	{
 		printf("Error in timer_settime\n");
 	    exit(1);
@@ -143,63 +367,64 @@ void pal_os_event_arm(void)
 void pal_os_event_destroy1(void)
 {
     TRUSTM_PAL_EVENT_DBGFN(">");    
-    timer_delete(timerid);
+    pal_os_event_delete_timer(&pal_os_event_0);
     TRUSTM_PAL_EVENT_DBGFN("<");    
 }
 
 pal_os_event_t * pal_os_event_create(register_callback callback, void * callback_args)
 {
-    struct sigevent sev;
-    struct sigaction sa;
+    pal_os_event_t * p_pal_os_event = &pal_os_event_0;
+    uint8_t index;
 
     TRUSTM_PAL_EVENT_DBGFN(">");    
 	
     if(( NULL != callback )&&( NULL != callback_args ))
     {
-		/* Establishing handler for signal */
-		
-        sa.sa_flags = SA_SIGINFO;
-        sa.sa_sigaction = handler;
-        sigemptyset(&sa.sa_mask);
-        if (sigaction(SIG, &sa, NULL) == -1)
+        // Pick the first event without timer
+        for (index = 0; index < PAL_OS_EVENT_MAX_INSTANCES; index++)
         {
-            printf("sigaction\n");
-            exit(1);
+            if (NULL == pal_os_event_list[index].os_timer)
+            {
+                break;
+            }
         }
+        if (PAL_OS_EVENT_MAX_INSTANCES == index)
+        {
+            TRUSTM_PAL_EVENT_ERRFN("No free event\n");
+            return (NULL);
+        }
+        p_pal_os_event = &pal_os_event_list[index];
 
-        /* Create the timer */
-
-        sev.sigev_notify = SIGEV_SIGNAL;
-        sev.sigev_signo = SIG;
-        sev.sigev_value.sival_ptr = &timerid;
-        if (timer_create(CLOCKID, &sev, &timerid) == -1)
+        if (-1 == pal_os_event_create_timer(p_pal_os_event, index))
         {
-            printf("timer_create\n");
             exit(1);
         }
 
-        pal_os_event_start(&pal_os_event_0,callback,callback_args);
+        pal_os_event_start(p_pal_os_event,callback,callback_args);
     }
 
     TRUSTM_PAL_EVENT_DBGFN("<");    
     
-    return (&pal_os_event_0);
+    return (p_pal_os_event);
 }
 
-void pal_os_event_trigger_registered_callback(void)
+static void pal_os_event_trigger(pal_os_event_t * p_pal_os_event)
 {
     register_callback callback;
     struct itimerspec its;
+    struct timespec deadline;
 
     // !!!OPTIGA_LIB_PORTING_REQUIRED
     // The following steps related to TIMER must be taken care while porting to different platform
     // TBD
     TRUSTM_PAL_EVENT_DBGFN(">");    
 
-    if (pal_os_event_0.callback_registered)
+    pal_os_event_enter();
+    callback = (NULL != p_pal_os_event) ? p_pal_os_event->callback_registered : NULL;
+    if (NULL != callback)
     {
-        callback = pal_os_event_0.callback_registered;
-        pal_os_event_0.callback_registered = NULL;
+        p_pal_os_event->callback_registered = NULL;
+        deadline = deadline_list[p_pal_os_event - pal_os_event_list];
 	
 	// Stop the timer
 	its.it_value.tv_sec = 0;
@@ -207,18 +432,29 @@ void pal_os_event_trigger_registered_callback(void)
 	its.it_interval.tv_sec = 0;
 	its.it_interval.tv_nsec = 0;
 
-	if (timer_settime(timerid, 0, &its, NULL) == -1)
+	if (pal_os_event_set_timer(p_pal_os_event, 0, &its) == -1)
 	{
 	    TRUSTM_PAL_EVENT_ERRFN("Fail to stop the timer\n");
 	    exit(1);
 	}
-	
-        callback((void * )pal_os_event_0.callback_ctx);
+    }
+    pal_os_event_exit();
+
+    // The callback registers the next callback, hence it is invoked outside of the lock
+    if (NULL != callback)
+    {
+        pal_os_event_spin_until(&deadline);
+        callback((void * )p_pal_os_event->callback_ctx);
     }
     
     TRUSTM_PAL_EVENT_DBGFN("<");    
     
 }
+
+void pal_os_event_trigger_registered_callback(void)
+{
+    pal_os_event_trigger(&pal_os_event_0);
+}
 /// @endcond
 
 void pal_os_event_register_callback_oneshot(pal_os_event_t * p_pal_os_event,
@@ -227,6 +463,7 @@ void pal_os_event_register_callback_oneshot(pal_os_event_t * p_pal_os_event,
                                              uint32_t time_us)
 {
 	struct itimerspec its;
+	struct timespec * p_deadline = &deadline_list[p_pal_os_event - pal_os_event_list];
 	long long freq_nanosecs;
 	//sigset_t mask;
 
@@ -234,37 +471,55 @@ void pal_os_event_register_callback_oneshot(pal_os_event_t * p_pal_os_event,
 
 
 	//uint8_t scheduler_timer;
+    pal_os_event_enter();
     p_pal_os_event->callback_registered = callback;
     p_pal_os_event->callback_ctx = callback_args;
 	
 	/* Start the timer */
 
-	freq_nanosecs = time_us * 1000;
-	its.it_value.tv_sec = freq_nanosecs / 1000000000;
-	its.it_value.tv_nsec = freq_nanosecs % 1000000000;
-	its.it_interval.tv_sec = its.it_value.tv_sec;
-	its.it_interval.tv_nsec = its.it_value.tv_nsec;
+	clock_gettime(CLOCKID, p_deadline);
+	freq_nanosecs = p_deadline->tv_nsec + ((long long)time_us * 1000);
+	p_deadline->tv_sec += freq_nanosecs / 1000000000;
+	p_deadline->tv_nsec = freq_nanosecs % 1000000000;
 
-	//printf("freq_nanosecs = %lld\n", time_us * 1000);
-	//printf("its.it_value.tv_sec = %lld", freq_nanosecs / 1000000000);
-	//printf("its.it_value.tv_nsec = %lld\n", freq_nanosecs % 1000000000);
-	//printf("its.it_interval.tv_sec = %lld\n", its.it_value.tv_sec);
-	//printf("its.it_interval.tv_nsec = %lld\n", its.it_value.tv_nsec);
+	// One shot timer: the timer fires once, the callback registers the next event if any
+	its.it_interval.tv_sec = 0;
+	its.it_interval.tv_nsec = 0;
+	if (time_us < PAL_OS_EVENT_SPIN_THRESHOLD_US)
+	{
+	    // Timer latency exceeds short waits (e.g. guard time), fire right away and spin until the deadline
+	    its.it_value.tv_sec = 0;
+	    its.it_value.tv_nsec = 1;
+	}
+	else
+	{
+	    // Wake up ahead of the deadline by the timer latency and spin the rest
+	    freq_nanosecs = ((long long)p_deadline->tv_sec * 1000000000) + p_deadline->tv_nsec -
+	                    (PAL_OS_EVENT_SPIN_THRESHOLD_US * 1000);
+	    its.it_value.tv_sec = freq_nanosecs / 1000000000;
+	    its.it_value.tv_nsec = freq_nanosecs % 1000000000;
+	}
 
-	
-	if (timer_settime(timerid, 0, &its, NULL) == -1)
+	if (pal_os_event_set_timer(p_pal_os_event, (time_us < PAL_OS_EVENT_SPIN_THRESHOLD_US) ? 0 : 1, &its) == -1)
 	{
 		printf("timer_settime\n");
 	    exit(1);
 	}
+    pal_os_event_exit();
 	TRUSTM_PAL_EVENT_DBGFN("<");    
 }
 
-//lint --e{818,715} suppress "As there is no implementation, pal_os_event is not used"
 void pal_os_event_destroy(pal_os_event_t * pal_os_event)
 {
     TRUSTM_PAL_EVENT_DBGFN(">");    
-    timer_delete(timerid);
+    if ((NULL != pal_os_event) && (NULL != pal_os_event->os_timer))
+    {
+        pal_os_event_delete_timer(pal_os_event);
+        // event is free for next create
+        pal_os_event->os_timer = NULL;
+        pal_os_event->callback_registered = NULL;
+        pal_os_event->is_event_triggered = FALSE;
+    }
     TRUSTM_PAL_EVENT_DBGFN("<");    
 
 }
@@ -36,8 +36,53 @@
 
 #include "optiga/pal/pal_os_lock.h"
 
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/file.h>
+#include <time.h>
+#include <unistd.h>
+
+/// Lock file of the link to OPTIGA shared by the processes, which also holds the link state (tmpfs, hence in memory)
+#ifndef PAL_OS_LOCK_SHARED_LINK_PATH
+#define PAL_OS_LOCK_SHARED_LINK_PATH    "/dev/shm/optiga_shared_link"
+#endif
+
+/// @cond hidden
+// Guards the state of all the locks, the waiters block on the condition until a lock is released
+static pthread_mutex_t lock_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t lock_released;
+// Critical sections may nest (e.g. a scheduler callback invoked from within one), hence recursive
+static pthread_mutex_t critical_section_mutex;
+static uint32_t critical_section_depth;
+static sigset_t critical_section_old_mask;
+static pthread_once_t lock_init_once = PTHREAD_ONCE_INIT;
+// Lock file of the shared link, opened on the first acquire and kept open for the lifetime of the process
+static int shared_link_fd = -1;
+
+static void pal_os_lock_init(void)
+{
+    pthread_condattr_t cond_attr;
+    pthread_mutexattr_t mutex_attr;
+
+    // Time outs are measured on the monotonic clock, hence not affected by clock adjustments
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&lock_released, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
+
+    pthread_mutexattr_init(&mutex_attr);
+    pthread_mutexattr_settype(&mutex_attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&critical_section_mutex, &mutex_attr);
+    pthread_mutexattr_destroy(&mutex_attr);
+}
+/// @endcond
+
 void pal_os_lock_create(pal_os_lock_t * p_lock, uint8_t lock_type)
 {
+    (void)pthread_once(&lock_init_once, pal_os_lock_init);
     p_lock->type = lock_type;
     p_lock->lock = 0;
 }
@@ -49,39 +94,134 @@ void pal_os_lock_destroy(pal_os_lock_t * p_lock)
     
 }
 
-pal_status_t pal_os_lock_acquire(pal_os_lock_t * p_lock)
+pal_status_t pal_os_lock_acquire_timeout(pal_os_lock_t * p_lock, uint32_t timeout_ms)
 {
     pal_status_t return_status = PAL_STATUS_FAILURE;
+    struct timespec deadline;
+    int wait_status = 0;
 
-    if (!(p_lock->lock))
+    (void)pthread_once(&lock_init_once, pal_os_lock_init);
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000)
     {
-        p_lock->lock++;
-        if (1 != p_lock->lock)
-        {
-            p_lock->lock--;
-        }
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock(&lock_mutex);
+    while ((0 != p_lock->lock) && (0 != timeout_ms) && (ETIMEDOUT != wait_status))
+    {
+        wait_status = (PAL_OS_LOCK_WAIT_FOREVER == timeout_ms) ?
+                      pthread_cond_wait(&lock_released, &lock_mutex) :
+                      pthread_cond_timedwait(&lock_released, &lock_mutex, &deadline);
+    }
+    if (0 == p_lock->lock)
+    {
+        p_lock->lock = 1;
         return_status = PAL_STATUS_SUCCESS;
     }
+    pthread_mutex_unlock(&lock_mutex);
     return return_status;
 }
 
+pal_status_t pal_os_lock_acquire(pal_os_lock_t * p_lock)
+{
+    // The callers (e.g. PKCS#11) serialize threads with the lock, hence block until it is available
+    return pal_os_lock_acquire_timeout(p_lock, PAL_OS_LOCK_WAIT_FOREVER);
+}
+
 void pal_os_lock_release(pal_os_lock_t * p_lock)
 {
+    pthread_mutex_lock(&lock_mutex);
     if (0 != p_lock->lock)
     {
-        p_lock->lock--;
+        p_lock->lock = 0;
+        pthread_cond_broadcast(&lock_released);
     }
+    pthread_mutex_unlock(&lock_mutex);
 }
 
 void pal_os_lock_enter_critical_section()
 {
+    sigset_t event_mask;
+    sigset_t old_mask;
+
+    (void)pthread_once(&lock_init_once, pal_os_lock_init);
+    // The timer signal of the event backend must not interrupt the critical section on this thread,
+    // the event thread backend is kept out by the mutex
+    sigemptyset(&event_mask);
+    sigaddset(&event_mask, SIGRTMIN);
+    pthread_sigmask(SIG_BLOCK, &event_mask, &old_mask);
+    pthread_mutex_lock(&critical_section_mutex);
+    if (0 == critical_section_depth)
+    {
+        critical_section_old_mask = old_mask;
+    }
+    critical_section_depth++;
 }
 
 void pal_os_lock_exit_critical_section()
 {
+    critical_section_depth--;
+    if (0 == critical_section_depth)
+    {
+        pthread_sigmask(SIG_SETMASK, &critical_section_old_mask, NULL);
+    }
+    pthread_mutex_unlock(&critical_section_mutex);
+}
+
+pal_status_t pal_os_lock_acquire_shared_link(uint8_t * p_link_state, uint16_t length)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    ssize_t read_length;
+    int lock_status;
+
+    do
+    {
+        if (-1 == shared_link_fd)
+        {
+            // Only the processes of the same user share the link, since the link state holds the session key
+            shared_link_fd = open(PAL_OS_LOCK_SHARED_LINK_PATH, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+            if (-1 == shared_link_fd)
+            {
+                break;
+            }
+        }
+        // The lock is released by the kernel, if the owning process terminates
+        do
+        {
+            lock_status = flock(shared_link_fd, LOCK_EX);
+        } while ((-1 == lock_status) && (EINTR == errno));
+        if (-1 == lock_status)
+        {
+            break;
+        }
+        read_length = pread(shared_link_fd, p_link_state, length, 0);
+        if ((ssize_t)length != read_length)
+        {
+            // No link state is stored yet
+            memset(p_link_state, 0, length);
+        }
+        return_status = PAL_STATUS_SUCCESS;
+    } while (0);
+    return return_status;
+}
+
+void pal_os_lock_release_shared_link(const uint8_t * p_link_state, uint16_t length)
+{
+    if (-1 != shared_link_fd)
+    {
+        if ((ssize_t)length != pwrite(shared_link_fd, p_link_state, length, 0))
+        {
+            // A partially written link state is not continued by the next owner, which resyncs instead
+            (void)ftruncate(shared_link_fd, 0);
+        }
+        (void)flock(shared_link_fd, LOCK_UN);
+    }
 }
 
 /**
 * @}
 */
-
@@ -37,19 +37,76 @@
 
 #include "optiga/pal/pal_os_memory.h"
 
+#ifdef OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// Segment of the read cache shared by the processes (tmpfs, hence in memory)
+#ifndef PAL_OS_MEMORY_SHARED_PATH
+#define PAL_OS_MEMORY_SHARED_PATH    "/dev/shm/optiga_read_cache"
+#endif
+
+/// @cond hidden
+// Segment file and mapping, set up on the first acquire and kept for the lifetime of the process
+static int shared_fd = -1;
+static void * p_shared_segment = NULL;
+/// @endcond
+#endif //OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+
+#ifdef OPTIGA_CRYPT_DATA_KEY_LOCKED_MEMORY_ENABLED
+#include <sys/mman.h>
+#include <unistd.h>
+#endif //OPTIGA_CRYPT_DATA_KEY_LOCKED_MEMORY_ENABLED
+
 void * pal_os_malloc(uint32_t block_size)
 {
+#ifdef OPTIGA_LIB_MEMORY_POOL_ENABLED
+    void * p_block = pal_os_memory_pool_alloc(block_size);
+
+    return ((NULL != p_block) ? p_block : malloc(block_size));
+#else
     return (malloc(block_size));
+#endif //OPTIGA_LIB_MEMORY_POOL_ENABLED
 }
 
 void * pal_os_calloc(uint32_t number_of_blocks , uint32_t block_size)
 {
+#ifdef OPTIGA_LIB_MEMORY_POOL_ENABLED
+    void * p_block = NULL;
+
+    // Overflowing sizes are left to the platform heap
+    if ((0 == number_of_blocks) || (block_size <= (0xFFFFFFFFU / number_of_blocks)))
+    {
+        p_block = pal_os_memory_pool_alloc(number_of_blocks * block_size);
+    }
+    if (NULL != p_block)
+    {
+        memset(p_block, 0, number_of_blocks * block_size);
+    }
+    else
+    {
+        p_block = calloc(number_of_blocks, block_size);
+    }
+    return (p_block);
+#else
     return (calloc(number_of_blocks, block_size));
+#endif //OPTIGA_LIB_MEMORY_POOL_ENABLED
 }
 
 void pal_os_free(void * p_block)
 {
+#ifdef OPTIGA_LIB_MEMORY_POOL_ENABLED
+    if (FALSE == pal_os_memory_pool_free(p_block))
+    {
+        free(p_block);
+    }
+#else
     free(p_block);
+#endif //OPTIGA_LIB_MEMORY_POOL_ENABLED
 }
 
 void pal_os_memcpy(void * p_destination, const void * p_source, uint32_t size)
@@ -62,6 +119,98 @@ void pal_os_memset(void * p_buffer, uint32_t value, uint32_t size)
     memset(p_buffer, (int32_t)value, size);
 }
 
+#ifdef OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+void * pal_os_memory_shared_acquire(uint32_t size)
+{
+    void * p_segment = NULL;
+    struct stat segment_stat;
+    int lock_status;
+
+    do
+    {
+        if (-1 == shared_fd)
+        {
+            // Only the processes of the same user share the cached data objects
+            shared_fd = open(PAL_OS_MEMORY_SHARED_PATH, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+            if (-1 == shared_fd)
+            {
+                break;
+            }
+        }
+        // The lock is released by the kernel, if the owning process terminates
+        do
+        {
+            lock_status = flock(shared_fd, LOCK_EX);
+        } while ((-1 == lock_status) && (EINTR == errno));
+        if (-1 == lock_status)
+        {
+            break;
+        }
+        if (NULL == p_shared_segment)
+        {
+            if (0 != fstat(shared_fd, &segment_stat))
+            {
+                (void)flock(shared_fd, LOCK_UN);
+                break;
+            }
+            // The segment is created zero filled, a segment of another layout (e.g. other configuration) is not used
+            if ((0 == segment_stat.st_size) && (0 != ftruncate(shared_fd, (off_t)size)))
+            {
+                (void)flock(shared_fd, LOCK_UN);
+                break;
+            }
+            if ((0 != segment_stat.st_size) && ((off_t)size != segment_stat.st_size))
+            {
+                (void)flock(shared_fd, LOCK_UN);
+                break;
+            }
+            p_segment = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, shared_fd, 0);
+            if (MAP_FAILED == p_segment)
+            {
+                p_segment = NULL;
+                (void)flock(shared_fd, LOCK_UN);
+                break;
+            }
+            p_shared_segment = p_segment;
+        }
+        p_segment = p_shared_segment;
+    } while (0);
+    return (p_segment);
+}
+
+void pal_os_memory_shared_release(void)
+{
+    (void)flock(shared_fd, LOCK_UN);
+}
+#endif //OPTIGA_UTIL_READ_CACHE_SHARED_ENABLED
+
+#ifdef OPTIGA_CRYPT_DATA_KEY_LOCKED_MEMORY_ENABLED
+pal_status_t pal_os_memory_lock(void * p_buffer, uint32_t size)
+{
+    uintptr_t page_size = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)p_buffer & ~(page_size - 1U);
+    uintptr_t end = ((uintptr_t)p_buffer + size + page_size - 1U) & ~(page_size - 1U);
+
+    if (0 != mlock(p_buffer, size))
+    {
+        return (PAL_STATUS_FAILURE);
+    }
+    // Not supported by every kernel, the memory stays locked anyway
+    (void)madvise((void *)start, end - start, MADV_DONTDUMP);
+    return (PAL_STATUS_SUCCESS);
+}
+
+void pal_os_memory_unlock(void * p_buffer, uint32_t size)
+{
+    uintptr_t page_size = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)p_buffer & ~(page_size - 1U);
+    uintptr_t end = ((uintptr_t)p_buffer + size + page_size - 1U) & ~(page_size - 1U);
+
+    (void)madvise((void *)start, end - start, MADV_DODUMP);
+    (void)munlock(p_buffer, size);
+}
+#endif //OPTIGA_CRYPT_DATA_KEY_LOCKED_MEMORY_ENABLED
+
 /**
 * @}
 */
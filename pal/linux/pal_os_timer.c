@@ -35,7 +35,7 @@
 */
 
 #include <errno.h>
-#include <sys/time.h> 
+#include <stdlib.h>
 #include <stdio.h>
 #include "stdint.h"
 #include <time.h>
@@ -57,35 +57,46 @@ LIBRARY_EXPORTS void pal_os_timer_delay_in_milliseconds(uint16_t milliseconds);
 
 /// @cond hidden 
 /**
-* Gets tick count value in milliseconds
+* Gets the monotonic time in microseconds
+*
+* - CLOCK_MONOTONIC_RAW is neither stepped nor slewed by NTP, hence the timeouts are not affected by clock adjustments.
+* - The time is accumulated in 64 bit, the callers truncate it to 32 bit and use wrap safe differences.
 *
 *\param[in] none
 *
 
-* \retval  uint32_t time in milliseconds 
+* \retval  uint64_t time in microseconds 
 */
-static uint32_t pal_os_get_clock_tick_count() 
+static uint64_t pal_os_get_clock_time_in_microseconds(void) 
 {
-    uint32_t       now_ms = 0;
-    struct timeval tv;
+    uint64_t       now_us = 0;
+    struct timespec ts;
 
-    // gettimeofday() returns 0 for success, or -1 for failure
-    if (0 == gettimeofday(&tv, NULL))
+    // clock_gettime() returns 0 for success, or -1 for failure
+    if (0 == clock_gettime(CLOCK_MONOTONIC_RAW, &ts))
     {
-    	now_ms = ((tv.tv_sec * 1000) + (tv.tv_usec / 1000));
+    	now_us = ((uint64_t)ts.tv_sec * 1000000) + ((uint64_t)ts.tv_nsec / 1000);
     }
     else
     {
-    	now_ms = 0;
+    	now_us = 0;
     	exit(-1);
     }
-    //LOG(LOG_PREFIX "pal_os_timer_get_time_in_milliseconds() <\n");
-    return now_ms;
+    return now_us;
 }
 
 uint32_t pal_os_timer_get_time_in_microseconds(void)
 {
-	return pal_os_get_clock_tick_count()*1000;
+	return (uint32_t)pal_os_get_clock_time_in_microseconds();
+}
+
+// Linux provides no portable access to the cycle counter, hence the monotonic time in nanoseconds is used
+uint32_t pal_os_timer_get_cycle_count(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint32_t)(((uint64_t)ts.tv_sec * 1000000000) + (uint64_t)ts.tv_nsec);
 }
 
 /**
@@ -95,7 +106,7 @@ uint32_t pal_os_timer_get_time_in_microseconds(void)
  */
 uint32_t pal_os_timer_get_time_in_milliseconds(void)
 {
-    return pal_os_get_clock_tick_count();
+    return (uint32_t)(pal_os_get_clock_time_in_microseconds() / 1000);
 }
 
 /**
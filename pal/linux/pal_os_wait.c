@@ -0,0 +1,124 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_os_wait.c
+*
+* \brief   This file implements the platform abstraction layer APIs for os wait object (eventfd).
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include "optiga/pal/pal_os_wait.h"
+
+#include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+
+pal_status_t pal_os_wait_create(pal_os_wait_t * p_wait)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    int * p_event_fd = (int *)malloc(sizeof(int));
+
+    if (NULL != p_event_fd)
+    {
+        // Non blocking, so that the signaled state can be cleared without blocking
+        *p_event_fd = eventfd(0, EFD_NONBLOCK);
+        if (-1 != *p_event_fd)
+        {
+            p_wait->os_wait_object = p_event_fd;
+            p_wait->is_signaled = FALSE;
+            return_status = PAL_STATUS_SUCCESS;
+        }
+        else
+        {
+            free(p_event_fd);
+        }
+    }
+    return return_status;
+}
+
+void pal_os_wait_destroy(pal_os_wait_t * p_wait)
+{
+    if (NULL != p_wait->os_wait_object)
+    {
+        (void)close(*(int *)p_wait->os_wait_object);
+        free(p_wait->os_wait_object);
+        p_wait->os_wait_object = NULL;
+    }
+}
+
+bool_t pal_os_wait_clear_signal(pal_os_wait_t * p_wait)
+{
+    uint64_t count;
+    bool_t was_signaled = FALSE;
+
+    if (sizeof(count) == read(*(int *)p_wait->os_wait_object, &count, sizeof(count)))
+    {
+        was_signaled = TRUE;
+    }
+    p_wait->is_signaled = FALSE;
+    return was_signaled;
+}
+
+void pal_os_wait_for_signal(pal_os_wait_t * p_wait)
+{
+    struct pollfd poll_fd;
+
+    poll_fd.fd = *(int *)p_wait->os_wait_object;
+    poll_fd.events = POLLIN;
+    while (FALSE == pal_os_wait_clear_signal(p_wait))
+    {
+        // The timer signal which drives the OPTIGA events interrupts the poll, so poll again
+        if ((-1 == poll(&poll_fd, 1, -1)) && (EINTR != errno))
+        {
+            break;
+        }
+    }
+}
+
+void pal_os_wait_signal(pal_os_wait_t * p_wait)
+{
+    uint64_t count = 1;
+
+    // write is async signal safe, the callbacks are invoked from the timer signal handler
+    p_wait->is_signaled = TRUE;
+    (void)write(*(int *)p_wait->os_wait_object, &count, sizeof(count));
+}
+
+int32_t pal_os_wait_get_descriptor(const pal_os_wait_t * p_wait)
+{
+    return (int32_t)(*(const int *)p_wait->os_wait_object);
+}
+
+/**
+* @}
+*/
@@ -0,0 +1,363 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_trace_export.c
+*
+* \brief   This file implements the export of the latency trace events to a file in the Chrome trace event format.
+*
+* \details
+* A thread reads the trace ring buffer periodically and writes the events as duration slices, which load in
+* chrome://tracing and in the Perfetto UI (ui.perfetto.dev).
+* - Each instance (execution queue slot) has its own track. The operation of the instance nests its queue waits, the
+*   APDU encoding and the exchange through comms, which in turn nests the events of the protocol stack layers.
+* - The execution on OPTIGA overlaps the physical layer polling, hence it is exported as an asynchronous slice.
+* - Events without a matching begin event (e.g. overwritten in the ring buffer) are skipped, begin events without an
+*   end event are closed along with the enclosing slice.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "optiga/common/optiga_lib_trace.h"
+#include "pal_linux.h"
+
+#ifdef OPTIGA_LIB_TRACE_ENABLED
+
+/// Interval, in which the trace ring buffer is read
+#define PAL_TRACE_EXPORT_POLL_INTERVAL_US       (10000U)
+/// Number of events read from the trace ring buffer at once
+#define PAL_TRACE_EXPORT_READ_COUNT             (0x20U)
+/// Number of tracks, the track of the events outside the exchange of an instance and one track per instance
+#define PAL_TRACE_EXPORT_TRACK_COUNT            (0x101U)
+/// Maximum number of nested slices of a track
+#define PAL_TRACE_EXPORT_MAX_DEPTH              (0x08U)
+
+/// @cond hidden
+typedef struct pal_trace_export
+{
+    /// Trace file, NULL if the export is not started
+    FILE * p_file;
+    /// Thread, which reads the ring buffer and writes the file
+    pthread_t thread;
+    /// Indicates the thread is to continue
+    volatile uint8_t running;
+    /// Indicates no event is written yet
+    uint8_t first_event;
+    /// Time stamp of the last event, extended to 64 bit
+    uint64_t time_us;
+    /// Time stamp of the last event, as recorded
+    uint32_t last_time_us;
+    /// Track of the instance, which started the last exchange through comms (0 if no exchange is ongoing)
+    uint16_t active_track;
+    /// Layers of the open slices of each track
+    uint8_t open_layers[PAL_TRACE_EXPORT_TRACK_COUNT][PAL_TRACE_EXPORT_MAX_DEPTH];
+    /// Number of the open slices of each track
+    uint8_t depth[PAL_TRACE_EXPORT_TRACK_COUNT];
+    /// Indicates the name of the track is written
+    uint8_t named[PAL_TRACE_EXPORT_TRACK_COUNT];
+} pal_trace_export_t;
+
+static pal_trace_export_t pal_trace_export;
+
+static const char * const pal_trace_export_layer_names[] =
+{
+    "scheduler", "cmd", "comms", "presentation", "transport", "data link", "physical", "chip", "api"
+};
+
+static void pal_trace_export_write(const char * p_phase,
+                                   const char * p_name,
+                                   uint8_t layer,
+                                   uint16_t track,
+                                   const char * p_args)
+{
+    fprintf(pal_trace_export.p_file,
+            "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%s\",\"ts\":%llu,\"pid\":1,\"tid\":%u%s%s}",
+            (TRUE == pal_trace_export.first_event) ? "\n" : ",\n",
+            p_name,
+            pal_trace_export_layer_names[layer],
+            p_phase,
+            (unsigned long long)pal_trace_export.time_us,
+            track,
+            (NULL != p_args) ? "," : "",
+            (NULL != p_args) ? p_args : "");
+    pal_trace_export.first_event = FALSE;
+}
+
+static void pal_trace_export_name_track(uint16_t track)
+{
+    char name[0x20];
+
+    if (FALSE == pal_trace_export.named[track])
+    {
+        pal_trace_export.named[track] = TRUE;
+        if (0 == track)
+        {
+            sprintf(name, "comms");
+        }
+        else
+        {
+            sprintf(name, "instance %u", (unsigned)(track - 1));
+        }
+        fprintf(pal_trace_export.p_file,
+                "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                (TRUE == pal_trace_export.first_event) ? "\n" : ",\n",
+                track,
+                name);
+        pal_trace_export.first_event = FALSE;
+    }
+}
+
+static void pal_trace_export_slice_name(const optiga_lib_trace_event_t * p_event, char * p_name)
+{
+    uint8_t value = OPTIGA_LIB_TRACE_GET_VALUE(p_event->code);
+
+    switch (p_event->layer)
+    {
+        case OPTIGA_LIB_TRACE_LAYER_API:
+            sprintf(p_name, "operation 0x%02X", value);
+            break;
+        case OPTIGA_LIB_TRACE_LAYER_SCHEDULER:
+            sprintf(p_name, "queue wait");
+            break;
+        case OPTIGA_LIB_TRACE_LAYER_CMD:
+            sprintf(p_name, "encode apdu");
+            break;
+        case OPTIGA_LIB_TRACE_LAYER_COMMS:
+            sprintf(p_name, "apdu 0x%02X", value);
+            break;
+        case OPTIGA_LIB_TRACE_LAYER_PRL:
+            sprintf(p_name, (OPTIGA_LIB_TRACE_PRL_ENCRYPT == p_event->code) ? "encrypt" : "decrypt");
+            break;
+        case OPTIGA_LIB_TRACE_LAYER_TL:
+            sprintf(p_name, "packet");
+            break;
+        case OPTIGA_LIB_TRACE_LAYER_DL:
+            sprintf(p_name, "frame");
+            break;
+        default:
+            sprintf(p_name, "i2c");
+            break;
+    }
+}
+
+static void pal_trace_export_event(const optiga_lib_trace_event_t * p_event)
+{
+    uint16_t track;
+    uint8_t * p_depth;
+    uint8_t index;
+    char name[0x20];
+    char args[0x30];
+
+    if (OPTIGA_LIB_TRACE_LAYER_API < p_event->layer)
+    {
+        return;
+    }
+
+    // Wrap safe, the events of different contexts may be recorded slightly out of order
+    if (FALSE == pal_trace_export.first_event)
+    {
+        pal_trace_export.time_us += (uint64_t)(int64_t)(int32_t)(p_event->time_us - pal_trace_export.last_time_us);
+    }
+    pal_trace_export.last_time_us = p_event->time_us;
+
+    if ((OPTIGA_LIB_TRACE_LAYER_API == p_event->layer) || (OPTIGA_LIB_TRACE_LAYER_COMMS >= p_event->layer))
+    {
+        track = (uint16_t)(OPTIGA_LIB_TRACE_GET_INSTANCE(p_event->code) + 1);
+    }
+    else
+    {
+        track = pal_trace_export.active_track;
+    }
+    pal_trace_export_name_track(track);
+
+    if (OPTIGA_LIB_TRACE_LAYER_CHIP == p_event->layer)
+    {
+        sprintf(args, "\"id\":%u", track);
+        pal_trace_export_write((OPTIGA_LIB_TRACE_EVENT_BEGIN == p_event->type) ? "b" : "e",
+                               "execution", p_event->layer, track, args);
+        return;
+    }
+
+    p_depth = &pal_trace_export.depth[track];
+    if (OPTIGA_LIB_TRACE_EVENT_BEGIN == p_event->type)
+    {
+        if (PAL_TRACE_EXPORT_MAX_DEPTH > *p_depth)
+        {
+            pal_trace_export.open_layers[track][(*p_depth)++] = p_event->layer;
+            pal_trace_export_slice_name(p_event, name);
+            sprintf(args, "\"args\":{\"code\":%u}", OPTIGA_LIB_TRACE_GET_VALUE(p_event->code));
+            pal_trace_export_write("B", name, p_event->layer, track, args);
+        }
+        if (OPTIGA_LIB_TRACE_LAYER_COMMS == p_event->layer)
+        {
+            pal_trace_export.active_track = track;
+        }
+        return;
+    }
+
+    for (index = *p_depth; index > 0; index--)
+    {
+        if (p_event->layer == pal_trace_export.open_layers[track][index - 1])
+        {
+            break;
+        }
+    }
+    if (0 == index)
+    {
+        return;
+    }
+    // Slices of the unmatched begin events are closed along with the enclosing slice
+    while (*p_depth > index)
+    {
+        (*p_depth)--;
+        pal_trace_export_write("E", "", pal_trace_export.open_layers[track][*p_depth], track, NULL);
+    }
+    (*p_depth)--;
+    sprintf(args, "\"args\":{\"code\":%u,\"error\":%u}",
+            OPTIGA_LIB_TRACE_GET_VALUE(p_event->code),
+            (OPTIGA_LIB_TRACE_EVENT_ERROR == p_event->type) ? 1U : 0U);
+    pal_trace_export_write("E", "", p_event->layer, track, args);
+    if (OPTIGA_LIB_TRACE_LAYER_COMMS == p_event->layer)
+    {
+        pal_trace_export.active_track = 0;
+    }
+}
+
+static uint16_t pal_trace_export_drain(void)
+{
+    optiga_lib_trace_event_t events[PAL_TRACE_EXPORT_READ_COUNT];
+    uint16_t count;
+    uint16_t index;
+
+    count = optiga_lib_trace_read(events, PAL_TRACE_EXPORT_READ_COUNT);
+    for (index = 0; index < count; index++)
+    {
+        pal_trace_export_event(&events[index]);
+    }
+    return (count);
+}
+
+static void * pal_trace_export_thread(void * p_arg)
+{
+    (void)p_arg;
+    while (TRUE == pal_trace_export.running)
+    {
+        if (0 == pal_trace_export_drain())
+        {
+            usleep(PAL_TRACE_EXPORT_POLL_INTERVAL_US);
+        }
+    }
+    return (NULL);
+}
+/// @endcond
+
+pal_status_t pal_linux_trace_export_start(const char * p_file_name)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    optiga_lib_trace_event_t events[PAL_TRACE_EXPORT_READ_COUNT];
+
+    do
+    {
+        if ((NULL == p_file_name) || (NULL != pal_trace_export.p_file))
+        {
+            break;
+        }
+        pal_trace_export.p_file = fopen(p_file_name, "w");
+        if (NULL == pal_trace_export.p_file)
+        {
+            break;
+        }
+        memset(pal_trace_export.depth, 0, sizeof(pal_trace_export.depth));
+        memset(pal_trace_export.named, 0, sizeof(pal_trace_export.named));
+        pal_trace_export.first_event = TRUE;
+        pal_trace_export.time_us = 0;
+        pal_trace_export.active_track = 0;
+        // Events recorded before the start are discarded
+        while (0 != optiga_lib_trace_read(events, PAL_TRACE_EXPORT_READ_COUNT))
+        {
+        }
+        fprintf(pal_trace_export.p_file, "{\"traceEvents\":[");
+        pal_trace_export.running = TRUE;
+        if (0 != pthread_create(&pal_trace_export.thread, NULL, pal_trace_export_thread, NULL))
+        {
+            pal_trace_export.running = FALSE;
+            fclose(pal_trace_export.p_file);
+            pal_trace_export.p_file = NULL;
+            break;
+        }
+        return_status = PAL_STATUS_SUCCESS;
+    } while (FALSE);
+
+    return (return_status);
+}
+
+pal_status_t pal_linux_trace_export_stop(void)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    uint16_t track;
+
+    do
+    {
+        if (NULL == pal_trace_export.p_file)
+        {
+            break;
+        }
+        pal_trace_export.running = FALSE;
+        (void)pthread_join(pal_trace_export.thread, NULL);
+        while (0 != pal_trace_export_drain())
+        {
+        }
+        // Slices, which are still open, end at the last event
+        for (track = 0; track < PAL_TRACE_EXPORT_TRACK_COUNT; track++)
+        {
+            while (0 != pal_trace_export.depth[track])
+            {
+                pal_trace_export.depth[track]--;
+                pal_trace_export_write("E", "", pal_trace_export.open_layers[track][pal_trace_export.depth[track]],
+                                       track, NULL);
+            }
+        }
+        fprintf(pal_trace_export.p_file, "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_events\":%u}}\n",
+                (unsigned)optiga_lib_trace_get_dropped_count());
+        return_status = (0 == fclose(pal_trace_export.p_file)) ? PAL_STATUS_SUCCESS : PAL_STATUS_FAILURE;
+        pal_trace_export.p_file = NULL;
+    } while (FALSE);
+
+    return (return_status);
+}
+
+#endif //OPTIGA_LIB_TRACE_ENABLED
+
+/**
+* @}
+*/
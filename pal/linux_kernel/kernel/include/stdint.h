@@ -0,0 +1,10 @@
+/*
+* Maps the header of the C library, which is included by optiga_lib_types.h, to the kernel.
+* The fixed width integer types (uint8_t ... uint64_t, uintptr_t) are provided by the kernel.
+*/
+#ifndef _PAL_KERNEL_STDINT_H_
+#define _PAL_KERNEL_STDINT_H_
+
+#include <linux/types.h>
+
+#endif /* _PAL_KERNEL_STDINT_H_ */
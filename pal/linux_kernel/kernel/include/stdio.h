@@ -0,0 +1,10 @@
+/*
+* Maps the header of the C library, which is included by optiga_lib_types.h, to the kernel.
+* Only the logging of the library refers to the standard output, which is disabled in the kernel.
+*/
+#ifndef _PAL_KERNEL_STDIO_H_
+#define _PAL_KERNEL_STDIO_H_
+
+#include <linux/printk.h>
+
+#endif /* _PAL_KERNEL_STDIO_H_ */
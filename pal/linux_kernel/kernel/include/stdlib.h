@@ -0,0 +1,10 @@
+/*
+* Maps the header of the C library, which is included by optiga_lib_types.h, to the kernel.
+* The memory of the library is allocated with pal_os_malloc, which maps to kmalloc.
+*/
+#ifndef _PAL_KERNEL_STDLIB_H_
+#define _PAL_KERNEL_STDLIB_H_
+
+#include <linux/kernel.h>
+
+#endif /* _PAL_KERNEL_STDLIB_H_ */
@@ -0,0 +1,10 @@
+/*
+* Maps the header of the C library, which is included by optiga_lib_types.h, to the kernel.
+* memcpy, memset and memcmp are provided by the kernel.
+*/
+#ifndef _PAL_KERNEL_STRING_H_
+#define _PAL_KERNEL_STRING_H_
+
+#include <linux/string.h>
+
+#endif /* _PAL_KERNEL_STRING_H_ */
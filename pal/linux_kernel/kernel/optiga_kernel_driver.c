@@ -0,0 +1,500 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_kernel_driver.c
+*
+* \brief   This file implements the kernel module of the kernel transport, which provides OPTIGA as character device.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+/*
+* The module executes optiga comms (optiga_comms_ifx_i2c.c) with the IFX I2C protocol stack on the PAL work queue of
+* the kernel and provides the APDU exchange to the processes through ioctl (../optiga_kernel.h). A process is blocked
+* in the ioctl until the response is received, the requests of all processes are executed one after the other.
+*
+* The module is built with the sources of the library, e.g. with the Kbuild of the kernel tree
+*
+*     obj-m += optiga.o
+*     optiga-y := pal/linux_kernel/kernel/optiga_kernel_driver.o pal/linux_kernel/kernel/pal.o \
+*                 pal/linux_kernel/kernel/pal_gpio.o pal/linux_kernel/kernel/pal_i2c.o \
+*                 pal/linux_kernel/kernel/pal_ifx_i2c_config.o pal/linux_kernel/kernel/pal_os_event.o \
+*                 pal/linux_kernel/kernel/pal_os_lock.o pal/linux_kernel/kernel/pal_os_memory.o \
+*                 pal/linux_kernel/kernel/pal_os_timer.o optiga/comms/optiga_comms_ifx_i2c.o \
+*                 optiga/comms/ifx_i2c/ifx_i2c.o optiga/comms/ifx_i2c/ifx_i2c_config.o \
+*                 optiga/comms/ifx_i2c/ifx_i2c_data_link_layer.o optiga/comms/ifx_i2c/ifx_i2c_physical_layer.o \
+*                 optiga/comms/ifx_i2c/ifx_i2c_presentation_layer.o optiga/comms/ifx_i2c/ifx_i2c_transport_layer.o \
+*                 optiga/common/optiga_lib_common.o
+*     ccflags-y := -I$(src)/pal/linux_kernel/kernel/include -I$(src)/pal/linux_kernel/kernel -I$(src)/optiga/include \
+*                  -DOPTIGA_LIB_EXTERNAL='"optiga_lib_config_kernel.h"'
+*
+* The processes use optiga_comms_kernel.c instead of optiga_comms_ifx_i2c.c and the protocol stack.
+*/
+
+#include <linux/completion.h>
+#include <linux/fs.h>
+#include <linux/miscdevice.h>
+#include <linux/module.h>
+#include <linux/mutex.h>
+#include <linux/of.h>
+#include <linux/slab.h>
+#include <linux/uaccess.h>
+#include "optiga/comms/optiga_comms.h"
+#include "optiga/ifx_i2c/ifx_i2c_config.h"
+#include "optiga/pal/pal_ifx_i2c_config.h"
+#include "optiga/pal/pal_os_event.h"
+#include "pal_kernel.h"
+#include "../optiga_kernel.h"
+
+/// @cond hidden
+// Operations of optiga comms, which are executed on the PAL work queue
+#define OPTIGA_KERNEL_OPERATION_OPEN                (0x01)
+#define OPTIGA_KERNEL_OPERATION_CLOSE               (0x02)
+#define OPTIGA_KERNEL_OPERATION_RESET               (0x03)
+#define OPTIGA_KERNEL_OPERATION_TRANSCEIVE          (0x04)
+
+/**
+ * @brief OPTIGA, which is provided as character device.
+ */
+typedef struct optiga_kernel_device
+{
+    /// Character device
+    struct miscdevice misc;
+    /// Serializes the requests of all processes
+    struct mutex lock;
+    /// Starts the operation on the PAL work queue
+    struct work_struct request_work;
+    /// Completion of the operation, reported by optiga comms
+    struct completion done;
+    /// optiga comms of OPTIGA, NULL if OPTIGA is not bound
+    optiga_comms_t * p_comms;
+    /// Operation and its arguments
+    uint8_t operation;
+    uint8_t reset_type;
+    uint16_t tx_length;
+    uint16_t rx_length;
+    uint32_t response_time_hint_us;
+    /// Result of the operation
+    optiga_lib_status_t status;
+    /// Number of files, which opened the link
+    uint32_t link_users;
+    /// APDUs of the operation, referenced by the protocol stack until the completion
+    uint8_t tx_buffer[OPTIGA_MAX_COMMS_BUFFER_SIZE];
+    uint8_t rx_buffer[OPTIGA_MAX_COMMS_BUFFER_SIZE];
+} optiga_kernel_device_t;
+
+/**
+ * @brief State of an open file of the character device.
+ */
+typedef struct optiga_kernel_file
+{
+    /// Indicates the file opened the link
+    bool link_open;
+} optiga_kernel_file_t;
+
+// The protocol stack has one context for each OPTIGA instance, the module drives OPTIGA instance 0
+static optiga_kernel_device_t optiga_kernel_device;
+
+// Invoked by optiga comms on the PAL work queue
+static void optiga_kernel_comms_handler(void * p_ctx, optiga_lib_status_t event)
+{
+    optiga_kernel_device_t * p_device = (optiga_kernel_device_t *)p_ctx;
+
+    p_device->status = event;
+    complete(&p_device->done);
+}
+
+// Starts the operation on the PAL work queue, where the protocol stack runs
+static void optiga_kernel_request_work(struct work_struct * p_work)
+{
+    optiga_kernel_device_t * p_device = container_of(p_work, optiga_kernel_device_t, request_work);
+    optiga_lib_status_t status;
+
+    switch (p_device->operation)
+    {
+        case OPTIGA_KERNEL_OPERATION_OPEN:
+            status = optiga_comms_open(p_device->p_comms);
+            break;
+        case OPTIGA_KERNEL_OPERATION_CLOSE:
+            status = optiga_comms_close(p_device->p_comms);
+            break;
+        case OPTIGA_KERNEL_OPERATION_RESET:
+            status = optiga_comms_reset(p_device->p_comms, p_device->reset_type);
+            break;
+        default:
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+            p_device->p_comms->response_time_hint_us = p_device->response_time_hint_us;
+#endif
+            p_device->rx_length = sizeof(p_device->rx_buffer);
+            status = optiga_comms_transceive(p_device->p_comms,
+                                             p_device->tx_buffer,
+                                             p_device->tx_length,
+                                             p_device->rx_buffer,
+                                             &p_device->rx_length);
+            break;
+    }
+    // The operation is not started, hence no completion is reported by optiga comms
+    if (OPTIGA_COMMS_SUCCESS != status)
+    {
+        optiga_kernel_comms_handler(p_device, status);
+    }
+}
+
+// Executes the operation and waits for its completion, the caller holds the lock
+static optiga_lib_status_t optiga_kernel_execute(optiga_kernel_device_t * p_device, uint8_t operation)
+{
+    reinit_completion(&p_device->done);
+    p_device->operation = operation;
+    (void)queue_work(pal_kernel_work_q, &p_device->request_work);
+    // The buffers are referenced by the protocol stack until the completion, which is bounded by its time outs
+    wait_for_completion(&p_device->done);
+    return (p_device->status);
+}
+
+static int optiga_kernel_open(struct inode * p_inode, struct file * p_file)
+{
+    optiga_kernel_file_t * p_kernel_file = kzalloc(sizeof(optiga_kernel_file_t), GFP_KERNEL);
+
+    (void)p_inode;
+    if (NULL == p_kernel_file)
+    {
+        return -ENOMEM;
+    }
+    p_file->private_data = p_kernel_file;
+    return 0;
+}
+
+// Releases the link of the file, the link to OPTIGA is closed by the last user. The caller holds the lock
+static optiga_lib_status_t optiga_kernel_close_link(optiga_kernel_device_t * p_device,
+                                                    optiga_kernel_file_t * p_kernel_file)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_SUCCESS;
+
+    if (p_kernel_file->link_open)
+    {
+        p_kernel_file->link_open = false;
+        p_device->link_users--;
+        if (0 == p_device->link_users)
+        {
+            status = optiga_kernel_execute(p_device, OPTIGA_KERNEL_OPERATION_CLOSE);
+        }
+    }
+    return (status);
+}
+
+static int optiga_kernel_release(struct inode * p_inode, struct file * p_file)
+{
+    optiga_kernel_device_t * p_device = &optiga_kernel_device;
+    optiga_kernel_file_t * p_kernel_file = (optiga_kernel_file_t *)p_file->private_data;
+
+    (void)p_inode;
+    mutex_lock(&p_device->lock);
+    if (NULL != p_device->p_comms)
+    {
+        (void)optiga_kernel_close_link(p_device, p_kernel_file);
+    }
+    mutex_unlock(&p_device->lock);
+    kfree(p_kernel_file);
+    return 0;
+}
+
+static long optiga_kernel_link(optiga_kernel_device_t * p_device,
+                               optiga_kernel_file_t * p_kernel_file,
+                               unsigned int cmd,
+                               void __user * p_arg)
+{
+    struct optiga_kernel_link link;
+
+    if (0 != copy_from_user(&link, p_arg, sizeof(link)))
+    {
+        return -EFAULT;
+    }
+    link.status = OPTIGA_COMMS_SUCCESS;
+    switch (cmd)
+    {
+        case OPTIGA_KERNEL_IOC_OPEN:
+        {
+            // OPTIGA is reset, unless another file uses the link
+            if ((0 == p_device->link_users) || ((1 == p_device->link_users) && p_kernel_file->link_open))
+            {
+                link.status = optiga_kernel_execute(p_device, OPTIGA_KERNEL_OPERATION_OPEN);
+            }
+            if ((OPTIGA_COMMS_SUCCESS == link.status) && (!p_kernel_file->link_open))
+            {
+                p_kernel_file->link_open = true;
+                p_device->link_users++;
+            }
+        }
+        break;
+        case OPTIGA_KERNEL_IOC_CLOSE:
+        {
+            link.status = optiga_kernel_close_link(p_device, p_kernel_file);
+        }
+        break;
+        default:
+        {
+            p_device->reset_type = link.reset_type;
+            link.status = optiga_kernel_execute(p_device, OPTIGA_KERNEL_OPERATION_RESET);
+        }
+        break;
+    }
+    return (0 != copy_to_user(p_arg, &link, sizeof(link))) ? -EFAULT : 0;
+}
+
+static long optiga_kernel_transceive(optiga_kernel_device_t * p_device, void __user * p_arg)
+{
+    struct optiga_kernel_transceive transceive;
+
+    if (0 != copy_from_user(&transceive, p_arg, sizeof(transceive)))
+    {
+        return -EFAULT;
+    }
+    if ((0 == transceive.tx_length) || (transceive.tx_length > sizeof(p_device->tx_buffer)))
+    {
+        return -EINVAL;
+    }
+    if (0 != copy_from_user(p_device->tx_buffer, u64_to_user_ptr(transceive.tx_data), transceive.tx_length))
+    {
+        return -EFAULT;
+    }
+    p_device->tx_length = transceive.tx_length;
+    p_device->response_time_hint_us = transceive.response_time_hint_us;
+    transceive.response_time_us = 0;
+
+    transceive.status = optiga_kernel_execute(p_device, OPTIGA_KERNEL_OPERATION_TRANSCEIVE);
+    if (OPTIGA_COMMS_SUCCESS == transceive.status)
+    {
+        if (p_device->rx_length > transceive.rx_length)
+        {
+            // The response does not fit into the buffer of the process
+            transceive.status = OPTIGA_COMMS_ERROR;
+        }
+        else if (0 != copy_to_user(u64_to_user_ptr(transceive.rx_data), p_device->rx_buffer, p_device->rx_length))
+        {
+            return -EFAULT;
+        }
+        else
+        {
+            transceive.rx_length = p_device->rx_length;
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+            transceive.response_time_us = p_device->p_comms->response_time_us;
+#endif
+        }
+    }
+    return (0 != copy_to_user(p_arg, &transceive, sizeof(transceive))) ? -EFAULT : 0;
+}
+
+static long optiga_kernel_ioctl(struct file * p_file, unsigned int cmd, unsigned long arg)
+{
+    optiga_kernel_device_t * p_device = &optiga_kernel_device;
+    optiga_kernel_file_t * p_kernel_file = (optiga_kernel_file_t *)p_file->private_data;
+    void __user * p_arg = (void __user *)arg;
+    long result;
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+    optiga_lib_comms_stats_t statistics;
+
+    // The statistics are read in a critical section, hence not blocked by the ongoing request
+    if (OPTIGA_KERNEL_IOC_GET_STATISTICS(sizeof(optiga_lib_comms_stats_t)) == cmd)
+    {
+        if ((NULL == READ_ONCE(p_device->p_comms)) ||
+            (OPTIGA_COMMS_SUCCESS != optiga_comms_get_statistics(p_device->p_comms, &statistics)))
+        {
+            return -ENODEV;
+        }
+        return (0 != copy_to_user(p_arg, &statistics, sizeof(statistics))) ? -EFAULT : 0;
+    }
+#endif
+
+    // Interrupted before the request is accepted, it is restarted or issued again by the process
+    if (0 != mutex_lock_interruptible(&p_device->lock))
+    {
+        return -ERESTARTSYS;
+    }
+    switch (cmd)
+    {
+        case OPTIGA_KERNEL_IOC_OPEN:
+        case OPTIGA_KERNEL_IOC_CLOSE:
+        case OPTIGA_KERNEL_IOC_RESET:
+            result = (NULL == p_device->p_comms) ? -ENODEV : optiga_kernel_link(p_device, p_kernel_file, cmd, p_arg);
+            break;
+        case OPTIGA_KERNEL_IOC_TRANSCEIVE:
+            if (NULL == p_device->p_comms)
+            {
+                result = -ENODEV;
+            }
+            else if (!p_kernel_file->link_open)
+            {
+                // Only a file, which opened the link, exchanges APDUs
+                result = -ENOTCONN;
+            }
+            else
+            {
+                result = optiga_kernel_transceive(p_device, p_arg);
+            }
+            break;
+        default:
+            result = -ENOTTY;
+            break;
+    }
+    mutex_unlock(&p_device->lock);
+    return (result);
+}
+
+static const struct file_operations optiga_kernel_fops =
+{
+    .owner = THIS_MODULE,
+    .open = optiga_kernel_open,
+    .release = optiga_kernel_release,
+    .unlocked_ioctl = optiga_kernel_ioctl,
+    .compat_ioctl = compat_ptr_ioctl,
+};
+
+// Binds the PAL contexts of OPTIGA instance 0 to the I2C client
+static int optiga_kernel_probe(struct i2c_client * client)
+{
+    optiga_kernel_device_t * p_device = &optiga_kernel_device;
+    struct device * dev = &client->dev;
+    int result;
+
+    if (NULL != p_device->p_comms)
+    {
+        return -EBUSY;
+    }
+    kernel_vdd_0.desc = devm_gpiod_get_optional(dev, "vdd", GPIOD_OUT_HIGH);
+    if (IS_ERR(kernel_vdd_0.desc))
+    {
+        return PTR_ERR(kernel_vdd_0.desc);
+    }
+    kernel_reset_0.desc = devm_gpiod_get_optional(dev, "reset", GPIOD_OUT_HIGH);
+    if (IS_ERR(kernel_reset_0.desc))
+    {
+        return PTR_ERR(kernel_reset_0.desc);
+    }
+    kernel_irq_0.irq = client->irq;
+    kernel_i2c_ctx_0.client = client;
+    optiga_pal_i2c_context_0.slave_address = (uint8_t)client->addr;
+    ifx_i2c_context_0.slave_address = (uint8_t)client->addr;
+
+    result = pal_kernel_init();
+    if (0 != result)
+    {
+        return result;
+    }
+    mutex_init(&p_device->lock);
+    init_completion(&p_device->done);
+    INIT_WORK(&p_device->request_work, optiga_kernel_request_work);
+    p_device->link_users = 0;
+    do
+    {
+        result = -ENOMEM;
+        p_device->p_comms = optiga_comms_create(optiga_kernel_comms_handler, p_device);
+        if (NULL == p_device->p_comms)
+        {
+            break;
+        }
+        p_device->p_comms->p_pal_os_event_ctx = pal_os_event_create(NULL, NULL);
+        if (NULL == p_device->p_comms->p_pal_os_event_ctx)
+        {
+            break;
+        }
+        p_device->misc.minor = MISC_DYNAMIC_MINOR;
+        p_device->misc.name = OPTIGA_KERNEL_DEVICE_NAME;
+        p_device->misc.fops = &optiga_kernel_fops;
+        p_device->misc.parent = dev;
+        result = misc_register(&p_device->misc);
+    } while (0);
+
+    if (0 != result)
+    {
+        if ((NULL != p_device->p_comms) && (NULL != p_device->p_comms->p_pal_os_event_ctx))
+        {
+            pal_os_event_destroy((pal_os_event_t *)p_device->p_comms->p_pal_os_event_ctx);
+        }
+        p_device->p_comms = NULL;
+        pal_kernel_deinit();
+    }
+    return result;
+}
+
+static void optiga_kernel_remove(struct i2c_client * client)
+{
+    optiga_kernel_device_t * p_device = &optiga_kernel_device;
+
+    (void)client;
+    misc_deregister(&p_device->misc);
+    // The files, which are still open, fail with ENODEV from now on
+    mutex_lock(&p_device->lock);
+    if (0 != p_device->link_users)
+    {
+        (void)optiga_kernel_execute(p_device, OPTIGA_KERNEL_OPERATION_CLOSE);
+        p_device->link_users = 0;
+    }
+    pal_os_event_destroy((pal_os_event_t *)p_device->p_comms->p_pal_os_event_ctx);
+    pal_kernel_deinit();
+    WRITE_ONCE(p_device->p_comms, NULL);
+    kernel_i2c_ctx_0.client = NULL;
+    mutex_unlock(&p_device->lock);
+}
+
+static const struct of_device_id optiga_kernel_of_match[] =
+{
+    { .compatible = "infineon,optiga-trust-m" },
+    { }
+};
+MODULE_DEVICE_TABLE(of, optiga_kernel_of_match);
+
+static const struct i2c_device_id optiga_kernel_id[] =
+{
+    { "optiga-trust-m", 0 },
+    { }
+};
+MODULE_DEVICE_TABLE(i2c, optiga_kernel_id);
+
+static struct i2c_driver optiga_kernel_driver =
+{
+    .driver =
+    {
+        .name = "optiga",
+        .of_match_table = optiga_kernel_of_match,
+    },
+    .probe = optiga_kernel_probe,
+    .remove = optiga_kernel_remove,
+    .id_table = optiga_kernel_id,
+};
+module_i2c_driver(optiga_kernel_driver);
+/// @endcond
+
+MODULE_DESCRIPTION("OPTIGA Trust M kernel transport");
+MODULE_AUTHOR("Infineon Technologies AG");
+MODULE_LICENSE("Dual MIT/GPL");
+
+/**
+* @}
+*/
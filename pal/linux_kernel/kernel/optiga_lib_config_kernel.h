@@ -0,0 +1,67 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_lib_config_kernel.h
+*
+* \brief   This file defines the configuration of the protocol stack in the kernel transport (OPTIGA_LIB_EXTERNAL).
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#ifndef _OPTIGA_LIB_CONFIG_KERNEL_H_
+#define _OPTIGA_LIB_CONFIG_KERNEL_H_
+
+/*
+* The kernel module runs optiga comms and the protocol stack only, the default configuration applies otherwise.
+* The features, which require the crypto PAL, the datastore, the logger or the event queue of the library, are not
+* available in the kernel.
+*/
+#include "optiga/optiga_lib_config_m_v3.h"
+
+    /** @brief The shielded connection is not provided by the kernel transport */
+    #undef OPTIGA_COMMS_SHIELDED_CONNECTION
+    #undef OPTIGA_COMMS_PROTECTION_POLICY_ENABLED
+    #undef OPTIGA_COMMS_KEY_ROLLOVER_ENABLED
+    /** @brief The complete APDUs are copied between the process and the kernel */
+    #undef OPTIGA_COMMS_ZERO_COPY_TX
+    #undef OPTIGA_COMMS_ZERO_COPY_RX
+    #undef OPTIGA_LIB_EVENT_QUEUE_ENABLED
+    #undef OPTIGA_LIB_MEMORY_POOL_ENABLED
+    #undef OPTIGA_LIB_DATASTORE_CACHE_ENABLED
+    #undef OPTIGA_LIB_ENABLE_LOGGING
+    #undef OPTIGA_LIB_TRACE_ENABLED
+    /** @brief The data ready interrupt is used, if an interrupt is assigned to OPTIGA in the devicetree */
+    #define OPTIGA_COMMS_DATA_READY_IRQ_ENABLED
+
+#endif /* _OPTIGA_LIB_CONFIG_KERNEL_H_*/
+
+/**
+* @}
+*/
@@ -0,0 +1,139 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_gpio.c
+*
+* \brief   This file implements the platform abstraction layer APIs for GPIO.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+
+#include <linux/interrupt.h>
+#include "optiga/pal/pal_gpio.h"
+#include "pal_kernel.h"
+
+/// @cond hidden
+// Provides the pin of the context, NULL if no pin is assigned in the devicetree
+static pal_kernel_gpio_t * pal_gpio_get(const pal_gpio_t * p_gpio_context)
+{
+    pal_kernel_gpio_t * gpio = NULL;
+
+    if ((p_gpio_context != NULL) && (p_gpio_context->p_gpio_hw != NULL))
+    {
+        gpio = (pal_kernel_gpio_t *)p_gpio_context->p_gpio_hw;
+    }
+    return gpio;
+}
+
+// Invoked in interrupt context, the physical layer only schedules the read of the status register
+static irqreturn_t pal_gpio_irq_callback(int irq, void * p_data)
+{
+    pal_kernel_gpio_t * gpio = (pal_kernel_gpio_t *)p_data;
+    pal_gpio_irq_handler_t handler = READ_ONCE(gpio->irq_handler);
+
+    (void)irq;
+    if (NULL != handler)
+    {
+        handler(gpio->irq_context);
+    }
+    return IRQ_HANDLED;
+}
+/// @endcond
+
+pal_status_t pal_gpio_init(const pal_gpio_t * p_gpio_context)
+{
+    // The pins are requested as outputs (active) on probe
+    (void)p_gpio_context;
+    return PAL_STATUS_SUCCESS;
+}
+
+pal_status_t pal_gpio_deinit(const pal_gpio_t * p_gpio_context)
+{
+    (void)pal_gpio_register_irq(p_gpio_context, NULL, NULL);
+    return PAL_STATUS_SUCCESS;
+}
+
+pal_status_t pal_gpio_register_irq(const pal_gpio_t * p_gpio_context,
+                                   pal_gpio_irq_handler_t handler,
+                                   void * p_context)
+{
+    pal_kernel_gpio_t * gpio = pal_gpio_get(p_gpio_context);
+
+    if ((NULL == gpio) || (gpio->irq <= 0))
+    {
+        // No interrupt in the devicetree, hence the status register is polled
+        return (NULL == handler) ? PAL_STATUS_SUCCESS : PAL_STATUS_FAILURE;
+    }
+    if (NULL == handler)
+    {
+        WRITE_ONCE(gpio->irq_handler, NULL);
+        if (gpio->irq_requested)
+        {
+            free_irq(gpio->irq, gpio);
+            gpio->irq_requested = false;
+        }
+        return PAL_STATUS_SUCCESS;
+    }
+    gpio->irq_context = p_context;
+    WRITE_ONCE(gpio->irq_handler, handler);
+    // The trigger (edge to the active level of the pin) is taken from the devicetree
+    if ((!gpio->irq_requested) && (0 != request_irq(gpio->irq, pal_gpio_irq_callback, 0, "optiga", gpio)))
+    {
+        WRITE_ONCE(gpio->irq_handler, NULL);
+        return PAL_STATUS_FAILURE;
+    }
+    gpio->irq_requested = true;
+    return PAL_STATUS_SUCCESS;
+}
+
+void pal_gpio_set_high(const pal_gpio_t * p_gpio_context)
+{
+    pal_kernel_gpio_t * gpio = pal_gpio_get(p_gpio_context);
+
+    if ((NULL != gpio) && (NULL != gpio->desc))
+    {
+        gpiod_set_value_cansleep(gpio->desc, 1);
+    }
+}
+
+void pal_gpio_set_low(const pal_gpio_t * p_gpio_context)
+{
+    pal_kernel_gpio_t * gpio = pal_gpio_get(p_gpio_context);
+
+    if ((NULL != gpio) && (NULL != gpio->desc))
+    {
+        gpiod_set_value_cansleep(gpio->desc, 0);
+    }
+}
+
+/**
+* @}
+*/
@@ -0,0 +1,179 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_i2c.c
+*
+* \brief   This file implements the platform abstraction layer(pal) APIs for I2C.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+
+#include "optiga/pal/pal_i2c.h"
+#include "pal_kernel.h"
+
+/*
+* The transfers are executed by i2c_master_send and i2c_master_recv on the PAL work queue, hence the calling work is
+* not blocked during the transfer and the upper layer is informed on the PAL work queue.
+*/
+
+/// @cond hidden
+static pal_status_t pal_i2c_acquire(pal_kernel_i2c_t * p_bus, const pal_i2c_t * p_i2c_context)
+{
+    // A busy bus is retried by the upper layer
+    if (0 == atomic_cmpxchg(&p_bus->entry_count, 0, 1))
+    {
+        p_bus->p_current_ctx = p_i2c_context;
+        return PAL_STATUS_SUCCESS;
+    }
+    return PAL_STATUS_FAILURE;
+}
+
+static void pal_i2c_release(pal_kernel_i2c_t * p_bus)
+{
+    atomic_set(&p_bus->entry_count, 0);
+}
+
+static void pal_i2c_invoke_upper_layer_callback(const pal_i2c_t * p_pal_i2c_ctx, uint16_t event)
+{
+    upper_layer_callback_t upper_layer_handler;
+
+    upper_layer_handler = (upper_layer_callback_t)p_pal_i2c_ctx->upper_layer_event_handler;
+    upper_layer_handler(p_pal_i2c_ctx->p_upper_layer_ctx, event);
+}
+
+/*
+* Transfer on the PAL work queue.
+* The bus is released before the upper layer is informed, since it continues the protocol with the next transfer.
+*/
+static void pal_i2c_completion_work(struct work_struct * p_work)
+{
+    pal_kernel_i2c_t * p_bus = container_of(p_work, pal_kernel_i2c_t, completion_work);
+    const pal_i2c_t * p_i2c_context = (const pal_i2c_t *)p_bus->p_current_ctx;
+    int result;
+
+    if (p_bus->read)
+    {
+        result = i2c_master_recv(p_bus->client, (char *)p_bus->p_buffer, p_bus->length);
+    }
+    else
+    {
+        result = i2c_master_send(p_bus->client, (const char *)p_bus->p_buffer, p_bus->length);
+    }
+    pal_i2c_release(p_bus);
+    // A NACK of OPTIGA, while it is busy, is reported as error and polled again by the upper layer
+    pal_i2c_invoke_upper_layer_callback(p_i2c_context, (result == p_bus->length) ? PAL_I2C_EVENT_SUCCESS :
+                                                                                 PAL_I2C_EVENT_ERROR);
+}
+
+static pal_status_t pal_i2c_transfer(const pal_i2c_t * p_i2c_context, uint8_t * p_data, uint16_t length, bool read)
+{
+    pal_kernel_i2c_t * p_bus;
+
+    if ((p_i2c_context == NULL) || (p_i2c_context->p_i2c_hw_config == NULL) || (0 == length))
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    p_bus = (pal_kernel_i2c_t *)p_i2c_context->p_i2c_hw_config;
+
+    if (PAL_STATUS_SUCCESS != pal_i2c_acquire(p_bus, p_i2c_context))
+    {
+        pal_i2c_invoke_upper_layer_callback(p_i2c_context, PAL_I2C_EVENT_BUSY);
+        return PAL_STATUS_I2C_BUSY;
+    }
+
+    // The buffer is referenced by the work until the completion
+    p_bus->p_buffer = p_data;
+    p_bus->length = length;
+    p_bus->read = read;
+    (void)queue_work(pal_kernel_work_q, &p_bus->completion_work);
+    return PAL_STATUS_SUCCESS;
+}
+/// @endcond
+
+pal_status_t pal_i2c_init(const pal_i2c_t * p_i2c_context)
+{
+    pal_kernel_i2c_t * p_bus;
+
+    if ((p_i2c_context == NULL) || (p_i2c_context->p_i2c_hw_config == NULL))
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    p_bus = (pal_kernel_i2c_t *)p_i2c_context->p_i2c_hw_config;
+    if (NULL == p_bus->client)
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    // The work item is not initialized again while a transfer is in progress
+    if (0 == atomic_read(&p_bus->entry_count))
+    {
+        INIT_WORK(&p_bus->completion_work, pal_i2c_completion_work);
+    }
+    return PAL_STATUS_SUCCESS;
+}
+
+pal_status_t pal_i2c_deinit(const pal_i2c_t * p_i2c_context)
+{
+    (void)p_i2c_context;
+    return PAL_STATUS_SUCCESS;
+}
+
+pal_status_t pal_i2c_write(const pal_i2c_t * p_i2c_context, uint8_t * p_data, uint16_t length)
+{
+    return pal_i2c_transfer(p_i2c_context, p_data, length, false);
+}
+
+pal_status_t pal_i2c_read(const pal_i2c_t * p_i2c_context, uint8_t * p_data, uint16_t length)
+{
+    return pal_i2c_transfer(p_i2c_context, p_data, length, true);
+}
+
+pal_status_t pal_i2c_set_bitrate(const pal_i2c_t * p_i2c_context, uint16_t bitrate)
+{
+    (void)bitrate;
+
+    if ((p_i2c_context == NULL) || (p_i2c_context->p_i2c_hw_config == NULL))
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    // The bitrate of the I2C adapter is configured in its devicetree node (clock-frequency), it is not changed by
+    // a client. OPTIGA supports up to 1 MHz, hence the adapter is configured with at most the negotiated bitrate
+    if (0 != p_i2c_context->upper_layer_event_handler)
+    {
+        //lint --e{611} suppress "void* function pointer is type casted to upper_layer_callback_t  type"
+        ((upper_layer_callback_t)(p_i2c_context->upper_layer_event_handler))(p_i2c_context->p_upper_layer_ctx,
+                                                                             PAL_I2C_EVENT_SUCCESS);
+    }
+    return PAL_STATUS_SUCCESS;
+}
+
+/**
+* @}
+*/
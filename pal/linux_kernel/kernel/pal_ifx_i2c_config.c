@@ -0,0 +1,111 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_ifx_i2c_config.c
+*
+* \brief   This file implements platform abstraction layer configurations for ifx i2c protocol.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include "optiga/pal/pal_gpio.h"
+#include "optiga/pal/pal_i2c.h"
+#include "optiga/ifx_i2c/ifx_i2c_config.h"
+#include "pal_kernel.h"
+
+/*
+* The contexts are bound to the I2C client of OPTIGA on probe (optiga_kernel_driver.c), e.g. from the devicetree node
+*
+*     &i2c1 {
+*         optiga@30 {
+*             compatible = "infineon,optiga-trust-m";
+*             reg = <0x30>;
+*             reset-gpios = <&gpio 25 GPIO_ACTIVE_HIGH>;
+*             interrupt-parent = <&gpio>;
+*             interrupts = <27 IRQ_TYPE_EDGE_RISING>;
+*         };
+*     };
+*
+* The vdd, reset and interrupt are optional.
+*/
+
+pal_kernel_i2c_t kernel_i2c_ctx_0 = {0};
+
+pal_kernel_gpio_t kernel_vdd_0 = {0};
+
+pal_kernel_gpio_t kernel_reset_0 = {0};
+
+pal_kernel_gpio_t kernel_irq_0 = {0};
+
+/**
+ * \brief PAL I2C configuration for OPTIGA.
+ */
+pal_i2c_t optiga_pal_i2c_context_0 =
+{
+    /// Pointer to I2C master platform specific context
+    (void*)&kernel_i2c_ctx_0,
+    /// Slave address
+    0x30,
+    /// Upper layer context
+    NULL,
+    /// Callback event handler
+    NULL
+};
+
+/**
+ * \brief PAL vdd pin configuration for OPTIGA.
+ */
+pal_gpio_t optiga_vdd_0 =
+{
+    // Platform specific GPIO context for the pin used to toggle Vdd.
+    (void*)&kernel_vdd_0
+};
+
+/**
+ * \brief PAL reset pin configuration for OPTIGA.
+ */
+pal_gpio_t optiga_reset_0 =
+{
+    // Platform specific GPIO context for the pin used to toggle Reset.
+    (void*)&kernel_reset_0
+};
+
+/**
+ * \brief PAL data ready interrupt pin configuration for OPTIGA.
+ */
+pal_gpio_t optiga_irq_0 =
+{
+    // Platform specific GPIO context for the pin signaling the data ready state.
+    (void*)&kernel_irq_0
+};
+
+/**
+* @}
+*/
@@ -0,0 +1,115 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_kernel.h
+*
+* \brief   This file provides the prototype declarations w.r.t the Linux kernel.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#ifndef _PAL_KERNEL_H_
+#define _PAL_KERNEL_H_
+
+#include <linux/atomic.h>
+#include <linux/gpio/consumer.h>
+#include <linux/i2c.h>
+#include <linux/workqueue.h>
+#include "optiga/pal/pal.h"
+#include "optiga/pal/pal_gpio.h"
+
+/**
+ * @brief PAL I2C context structure.
+ */
+typedef struct pal_kernel_i2c
+{
+    /// I2C client of OPTIGA, assigned on probe
+    struct i2c_client * client;
+    /// Context of the device, which holds the bus
+    const void * p_current_ctx;
+    /// Buffer and length of the transfer in progress, it must remain valid until the completion
+    uint8_t * p_buffer;
+    uint16_t length;
+    /// Direction of the transfer in progress
+    bool read;
+    /// Executes the transfer on the PAL work queue and informs the upper layer
+    struct work_struct completion_work;
+    /// Indicates the bus is acquired
+    atomic_t entry_count;
+} pal_kernel_i2c_t;
+
+/**
+ * @brief PAL GPIO context structure, one per pin.
+ */
+typedef struct pal_kernel_gpio
+{
+    /// Pin from the devicetree (e.g. reset-gpios), NULL if not assigned
+    struct gpio_desc * desc;
+    /// Interrupt of the data ready pin (interrupts of the devicetree node), 0 if not assigned
+    int irq;
+    /// Indicates the interrupt is requested
+    bool irq_requested;
+    /// Handler registered by pal_gpio_register_irq
+    pal_gpio_irq_handler_t irq_handler;
+    /// Context provided to the handler
+    void * irq_context;
+} pal_kernel_gpio_t;
+
+/**
+ * @brief Ordered work queue, on which the PAL informs the upper layers.
+ *
+ * The I2C transfers and the expired events are serialized on it, hence the protocol stack never runs concurrently
+ * with itself and the I2C transfers may sleep. The queue is created by pal_kernel_init.
+ */
+extern struct workqueue_struct * pal_kernel_work_q;
+
+/// PAL contexts of OPTIGA (pal_ifx_i2c_config.c), bound to the I2C client on probe
+extern pal_kernel_i2c_t kernel_i2c_ctx_0;
+extern pal_kernel_gpio_t kernel_vdd_0;
+extern pal_kernel_gpio_t kernel_reset_0;
+extern pal_kernel_gpio_t kernel_irq_0;
+
+/**
+ * \brief Creates the PAL work queue.
+ *
+ * \retval  0 or negative errno
+ */
+int pal_kernel_init(void);
+
+/**
+ * \brief Destroys the PAL work queue, after the pending work is completed.
+ */
+void pal_kernel_deinit(void);
+
+#endif /* _PAL_KERNEL_H_ */
+
+/**
+* @}
+*/
@@ -0,0 +1,191 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_os_event.c
+*
+* \brief   This file implements the platform abstraction layer APIs for os event/scheduler.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include <linux/hrtimer.h>
+#include <linux/spinlock.h>
+#include "optiga/pal/pal_os_event.h"
+#include "optiga/pal/pal.h"
+#include "pal_kernel.h"
+
+/// @cond hidden
+/// Number of events, one for each OPTIGA instance
+#ifdef OPTIGA_MAX_NUMBER_OF_INSTANCES
+#define PAL_OS_EVENT_MAX_INSTANCES      OPTIGA_MAX_NUMBER_OF_INSTANCES
+#else
+#define PAL_OS_EVENT_MAX_INSTANCES      (1)
+#endif
+
+/// Index of the event in the list
+#define PAL_OS_EVENT_INDEX(p_event)     ((uint32_t)((p_event) - pal_os_event_list))
+
+/*
+* Each event has its own high resolution timer and work item. The timer expires in interrupt context and queues the
+* work on the PAL work queue, hence the registered callback is never invoked from the interrupt and the delay is
+* scheduled in microseconds.
+*/
+typedef struct pal_os_event_kernel
+{
+    struct hrtimer timer;
+    struct work_struct work;
+} pal_os_event_kernel_t;
+
+static pal_os_event_t pal_os_event_list[PAL_OS_EVENT_MAX_INSTANCES] = {0};
+static pal_os_event_kernel_t pal_os_event_kernel_list[PAL_OS_EVENT_MAX_INSTANCES];
+// Protects the registered callbacks, which are registered from the data ready interrupt as well
+static DEFINE_SPINLOCK(pal_os_event_spinlock);
+
+static enum hrtimer_restart pal_os_event_timer_handler(struct hrtimer * p_timer)
+{
+    pal_os_event_kernel_t * p_kernel = container_of(p_timer, pal_os_event_kernel_t, timer);
+
+    (void)queue_work(pal_kernel_work_q, &p_kernel->work);
+    return HRTIMER_NORESTART;
+}
+
+static void pal_os_event_work_handler(struct work_struct * p_work)
+{
+    pal_os_event_kernel_t * p_kernel = container_of(p_work, pal_os_event_kernel_t, work);
+    pal_os_event_t * p_pal_os_event = &pal_os_event_list[p_kernel - pal_os_event_kernel_list];
+    register_callback func;
+    void * func_args;
+    unsigned long flags;
+
+    // Callback is registered again by the upper layer for the next expiry
+    spin_lock_irqsave(&pal_os_event_spinlock, flags);
+    func = p_pal_os_event->callback_registered;
+    func_args = p_pal_os_event->callback_ctx;
+    p_pal_os_event->callback_registered = NULL;
+    spin_unlock_irqrestore(&pal_os_event_spinlock, flags);
+    if (NULL != func)
+    {
+        func(func_args);
+    }
+}
+/// @endcond
+
+void pal_os_event_start(pal_os_event_t * p_pal_os_event, register_callback callback, void * callback_args)
+{
+    if (FALSE == p_pal_os_event->is_event_triggered)
+    {
+        p_pal_os_event->is_event_triggered = TRUE;
+        pal_os_event_register_callback_oneshot(p_pal_os_event,callback,callback_args,1000);
+    }
+}
+
+void pal_os_event_stop(pal_os_event_t * p_pal_os_event)
+{
+    //lint --e{714} suppress "The API pal_os_event_stop is not exposed in header file but used as extern in 
+    //optiga_cmd.c"
+    p_pal_os_event->is_event_triggered = FALSE;
+}
+
+pal_os_event_t * pal_os_event_create(register_callback callback, void * callback_args)
+{
+    pal_os_event_kernel_t * p_kernel;
+    uint8_t index;
+
+    // Pick the first event, which is not in use
+    for (index = 0; index < PAL_OS_EVENT_MAX_INSTANCES; index++)
+    {
+        if (NULL == pal_os_event_list[index].os_timer)
+        {
+            break;
+        }
+    }
+    if (PAL_OS_EVENT_MAX_INSTANCES == index)
+    {
+        return (NULL);
+    }
+    p_kernel = &pal_os_event_kernel_list[index];
+    hrtimer_init(&p_kernel->timer, CLOCK_MONOTONIC, HRTIMER_MODE_REL);
+    p_kernel->timer.function = pal_os_event_timer_handler;
+    INIT_WORK(&p_kernel->work, pal_os_event_work_handler);
+    pal_os_event_list[index].os_timer = p_kernel;
+
+    if (( NULL != callback )&&( NULL != callback_args ))
+    {
+        pal_os_event_start(&pal_os_event_list[index],callback,callback_args);
+    }
+    return (&pal_os_event_list[index]);
+}
+
+void pal_os_event_trigger_registered_callback(void)
+{
+    // The registered callbacks are invoked by the work handler of the events, hence the pending ones are expired now
+    uint8_t index;
+
+    for (index = 0; index < PAL_OS_EVENT_MAX_INSTANCES; index++)
+    {
+        if ((NULL != pal_os_event_list[index].os_timer) && (NULL != pal_os_event_list[index].callback_registered))
+        {
+            (void)queue_work(pal_kernel_work_q, &pal_os_event_kernel_list[index].work);
+        }
+    }
+}
+
+void pal_os_event_register_callback_oneshot(pal_os_event_t * p_pal_os_event,
+                                            register_callback callback,
+                                            void * callback_args,
+                                            uint32_t time_us)
+{
+    pal_os_event_kernel_t * p_kernel = &pal_os_event_kernel_list[PAL_OS_EVENT_INDEX(p_pal_os_event)];
+    unsigned long flags;
+
+    // Safe from the interrupt context (e.g. the data ready interrupt), a pending expiry is replaced
+    spin_lock_irqsave(&pal_os_event_spinlock, flags);
+    p_pal_os_event->callback_registered = callback;
+    p_pal_os_event->callback_ctx = callback_args;
+    hrtimer_start(&p_kernel->timer, ns_to_ktime((u64)time_us * NSEC_PER_USEC), HRTIMER_MODE_REL);
+    spin_unlock_irqrestore(&pal_os_event_spinlock, flags);
+}
+
+void pal_os_event_destroy(pal_os_event_t * pal_os_event)
+{
+    pal_os_event_kernel_t * p_kernel = &pal_os_event_kernel_list[PAL_OS_EVENT_INDEX(pal_os_event)];
+
+    // Not invoked on the PAL work queue, since the pending work is waited for
+    pal_os_event->callback_registered = NULL;
+    hrtimer_cancel(&p_kernel->timer);
+    cancel_work_sync(&p_kernel->work);
+    pal_os_event->is_event_triggered = FALSE;
+    // event is free for next create
+    pal_os_event->os_timer = NULL;
+}
+
+/**
+* @}
+*/
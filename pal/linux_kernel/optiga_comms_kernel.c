@@ -0,0 +1,495 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_comms_kernel.c
+*
+* \brief   This file implements optiga comms on Linux with the kernel transport, which exchanges complete APDUs with
+*          the OPTIGA character device.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include "optiga/comms/optiga_comms.h"
+#include "optiga/common/optiga_lib_common_internal.h"
+#include "optiga/pal/pal_os_event.h"
+#include "optiga/pal/pal_os_memory.h"
+#ifdef OPTIGA_PAL_INIT_ENABLED
+#include "optiga/pal/pal.h"
+#endif
+#include "optiga_kernel.h"
+
+/*
+* This file replaces optiga_comms_ifx_i2c.c (and the ifx_i2c protocol stack) on Linux, if OPTIGA is driven by the
+* kernel module in kernel/. The Linux PAL is still required for the events, the timer and the memory.
+*
+* The ioctl blocks until the response is received, hence it is issued by a worker thread of the instance and the
+* completion is reported to the upper layer in the context of the pal os event, as with optiga_comms_ifx_i2c.c.
+*
+* The shielded connection is not provided by the kernel transport, a command with a protection level other than
+* OPTIGA_COMMS_NO_PROTECTION fails.
+*/
+
+/// @cond hidden
+
+/// Character device of OPTIGA
+#ifndef OPTIGA_COMMS_KERNEL_DEVICE
+#define OPTIGA_COMMS_KERNEL_DEVICE                  "/dev/" OPTIGA_KERNEL_DEVICE_NAME
+#endif
+
+/// Optiga comms is in use
+#define OPTIGA_COMMS_INUSE                          (0x01)
+/// Optiga comms is free
+#define OPTIGA_COMMS_FREE                           (0x00)
+
+// Operations of optiga comms, which are executed by the worker thread
+#define OPTIGA_KERNEL_OPERATION_NONE                (0x00)
+#define OPTIGA_KERNEL_OPERATION_OPEN                (0x01)
+#define OPTIGA_KERNEL_OPERATION_CLOSE               (0x02)
+#define OPTIGA_KERNEL_OPERATION_RESET               (0x03)
+#define OPTIGA_KERNEL_OPERATION_TRANSCEIVE          (0x04)
+
+/**
+ * @brief Kernel transport of an OPTIGA instance.
+ */
+typedef struct optiga_kernel_device
+{
+    /// File descriptor of the character device, -1 if not opened
+    int fd;
+    /// Worker thread, which issues the blocking ioctl
+    pthread_t worker;
+    /// Protects the operation, which is handed to the worker thread
+    pthread_mutex_t mutex;
+    pthread_cond_t condition;
+    /// Indicates the worker thread is started
+    uint8_t worker_started;
+    /// Operation for the worker thread
+    uint8_t operation;
+    /// Argument of the link operations
+    struct optiga_kernel_link link;
+    /// Argument of the APDU exchange
+    struct optiga_kernel_transceive transceive;
+    /// Length of the receive buffer of the ongoing transceive
+    uint16_t * p_rx_data_len;
+    /// Result of the operation, reported to the upper layer
+    optiga_lib_status_t event;
+#ifdef OPTIGA_LIB_EVENT_QUEUE_ENABLED
+    /// Event of the completion, in parallel to the scheduler of optiga cmd
+    pal_os_event_t * pal_os_event_ctx;
+#endif
+} optiga_kernel_device_t;
+
+//lint --e{785} suppress "Only required fields are initialized by default, the rest are assigned on the first use"
+_STATIC_H optiga_kernel_device_t optiga_kernel_device =
+{
+    -1,
+    0,
+    PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_COND_INITIALIZER,
+};
+
+//lint --e{785} suppress "Only required fields are initialized by default, the rest are assigned on create"
+optiga_comms_t optiga_comms = {
+                               (void *)&optiga_kernel_device,
+                               NULL,
+                               NULL,
+                               0,
+                               0,
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+                               0,
+                               0,
+                               0,
+#endif
+                               NULL};
+
+#ifdef OPTIGA_PAL_INIT_ENABLED
+_STATIC_H uint8_t pal_init_state = FALSE;
+#endif
+
+_STATIC_H optiga_lib_status_t check_optiga_comms_state(optiga_comms_t * p_ctx);
+_STATIC_H void optiga_kernel_event_handler(void * p_ctx);
+
+/*
+* Executes the operations of the instance with the character device
+*/
+_STATIC_H void * optiga_kernel_worker(void * p_arg)
+{
+    optiga_comms_t * p_ctx = (optiga_comms_t *)p_arg;
+    optiga_kernel_device_t * p_device = (optiga_kernel_device_t *)p_ctx->p_comms_ctx;
+    void * p_pal_os_event_ctx;
+    unsigned long request;
+    void * p_request_arg;
+    uint16_t * p_status;
+    uint8_t operation;
+    int result;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&p_device->mutex);
+        while (OPTIGA_KERNEL_OPERATION_NONE == p_device->operation)
+        {
+            pthread_cond_wait(&p_device->condition, &p_device->mutex);
+        }
+        operation = p_device->operation;
+        p_device->operation = OPTIGA_KERNEL_OPERATION_NONE;
+        pthread_mutex_unlock(&p_device->mutex);
+
+        p_request_arg = &p_device->link;
+        p_status = &p_device->link.status;
+        switch (operation)
+        {
+            case OPTIGA_KERNEL_OPERATION_OPEN:
+                request = OPTIGA_KERNEL_IOC_OPEN;
+                break;
+            case OPTIGA_KERNEL_OPERATION_CLOSE:
+                request = OPTIGA_KERNEL_IOC_CLOSE;
+                break;
+            case OPTIGA_KERNEL_OPERATION_RESET:
+                request = OPTIGA_KERNEL_IOC_RESET;
+                break;
+            default:
+                request = OPTIGA_KERNEL_IOC_TRANSCEIVE;
+                p_request_arg = &p_device->transceive;
+                p_status = &p_device->transceive.status;
+                break;
+        }
+
+        // Interrupted by a signal before the request is accepted by the kernel, hence it is issued again
+        do
+        {
+            result = ioctl(p_device->fd, request, p_request_arg);
+        } while ((0 != result) && (EINTR == errno));
+        p_device->event = (0 == result) ? *p_status : OPTIGA_COMMS_ERROR;
+
+        p_pal_os_event_ctx = p_ctx->p_pal_os_event_ctx;
+#ifdef OPTIGA_LIB_EVENT_QUEUE_ENABLED
+        if (NULL != p_device->pal_os_event_ctx)
+        {
+            p_pal_os_event_ctx = p_device->pal_os_event_ctx;
+        }
+#endif
+        PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT((pal_os_event_t *)p_pal_os_event_ctx,
+                                               optiga_kernel_event_handler,
+                                               (void *)p_ctx,
+                                               1);
+    }
+    return (NULL);
+}
+
+/*
+* Hands the operation to the worker thread, the device is opened and the worker thread is started on the first use
+*/
+_STATIC_H optiga_lib_status_t optiga_kernel_start(optiga_comms_t * p_ctx, uint8_t operation)
+{
+    optiga_kernel_device_t * p_device = (optiga_kernel_device_t *)p_ctx->p_comms_ctx;
+
+    if (-1 == p_device->fd)
+    {
+        p_device->fd = open(OPTIGA_COMMS_KERNEL_DEVICE, O_RDWR | O_CLOEXEC);
+        if (-1 == p_device->fd)
+        {
+            return (OPTIGA_COMMS_ERROR);
+        }
+    }
+    if (FALSE == p_device->worker_started)
+    {
+        if (0 != pthread_create(&p_device->worker, NULL, optiga_kernel_worker, (void *)p_ctx))
+        {
+            return (OPTIGA_COMMS_ERROR);
+        }
+        p_device->worker_started = TRUE;
+    }
+#ifdef OPTIGA_LIB_EVENT_QUEUE_ENABLED
+    // the completion is scheduled on its own event, in parallel to the scheduler of optiga cmd
+    if (NULL == p_device->pal_os_event_ctx)
+    {
+        p_device->pal_os_event_ctx = PAL_OS_EVENT_CREATE(NULL, NULL);
+    }
+#endif
+
+    pthread_mutex_lock(&p_device->mutex);
+    p_device->operation = operation;
+    pthread_cond_signal(&p_device->condition);
+    pthread_mutex_unlock(&p_device->mutex);
+    return (OPTIGA_COMMS_SUCCESS);
+}
+
+/*
+* Starts the link operation, the state is released again if it is not started
+*/
+_STATIC_H optiga_lib_status_t optiga_kernel_start_link(optiga_comms_t * p_ctx, uint8_t operation, uint8_t reset_type)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_ERROR;
+    optiga_kernel_device_t * p_device;
+
+    if (OPTIGA_COMMS_SUCCESS == check_optiga_comms_state(p_ctx))
+    {
+        p_device = (optiga_kernel_device_t *)p_ctx->p_comms_ctx;
+        pal_os_memset(&p_device->link, 0, sizeof(p_device->link));
+        p_device->link.reset_type = reset_type;
+        status = optiga_kernel_start(p_ctx, operation);
+        if (OPTIGA_COMMS_SUCCESS != status)
+        {
+            p_ctx->state = OPTIGA_COMMS_FREE;
+        }
+    }
+    return (status);
+}
+
+optiga_comms_t * optiga_comms_create(callback_handler_t callback, void * context)
+{
+    return (optiga_comms_create_instance(OPTIGA_INSTANCE_ID_0, callback, context));
+}
+
+optiga_comms_t * optiga_comms_create_instance(uint8_t optiga_instance_id, callback_handler_t callback, void * context)
+{
+    optiga_comms_t * p_optiga_comms = NULL;
+
+    do
+    {
+        // The kernel module drives one OPTIGA
+        if (OPTIGA_INSTANCE_ID_0 != optiga_instance_id)
+        {
+            break;
+        }
+        p_optiga_comms = &optiga_comms;
+
+        if (FALSE == p_optiga_comms->instance_init_state)
+        {
+#ifdef OPTIGA_PAL_INIT_ENABLED
+            if (FALSE == pal_init_state)
+            {
+                if (PAL_STATUS_SUCCESS != pal_init())
+                {
+                    p_optiga_comms = NULL;
+                    break;
+                }
+                pal_init_state = TRUE;
+            }
+#endif
+            p_optiga_comms->upper_layer_handler = callback;
+            p_optiga_comms->p_upper_layer_ctx = context;
+            p_optiga_comms->instance_init_state = TRUE;
+        }
+    } while (FALSE);
+    return (p_optiga_comms);
+}
+
+//lint --e{715} suppress "p_optiga_cmd is not used here as it is placeholder for future."
+//lint --e{818} suppress "Not declared as pointer as nothing needs to be updated in the pointer."
+void optiga_comms_destroy(optiga_comms_t * p_optiga_cmd)
+{
+}
+
+optiga_lib_status_t optiga_comms_set_callback_handler(optiga_comms_t * p_optiga_comms, callback_handler_t handler)
+{
+    p_optiga_comms->upper_layer_handler = handler;
+    return (0);
+}
+
+optiga_lib_status_t optiga_comms_set_callback_context(optiga_comms_t * p_optiga_comms, void * context)
+{
+    p_optiga_comms->p_upper_layer_ctx = context;
+    return (0);
+}
+
+/// @endcond
+
+optiga_lib_status_t optiga_comms_open(optiga_comms_t * p_ctx)
+{
+    return (optiga_kernel_start_link(p_ctx, OPTIGA_KERNEL_OPERATION_OPEN, 0));
+}
+
+optiga_lib_status_t optiga_comms_reset(optiga_comms_t * p_ctx, uint8_t reset_type)
+{
+    return (optiga_kernel_start_link(p_ctx, OPTIGA_KERNEL_OPERATION_RESET, reset_type));
+}
+
+optiga_lib_status_t optiga_comms_transceive(optiga_comms_t * p_ctx,
+                                            const uint8_t * p_tx_data,
+                                            uint16_t tx_data_length,
+                                            uint8_t * p_rx_data,
+                                            uint16_t * p_rx_data_len)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_ERROR;
+    optiga_kernel_device_t * p_device;
+
+    if (OPTIGA_COMMS_SUCCESS == check_optiga_comms_state(p_ctx))
+    {
+        p_device = (optiga_kernel_device_t *)p_ctx->p_comms_ctx;
+#ifdef OPTIGA_COMMS_ZERO_COPY_RX
+        // The kernel stores the complete response to the rx buffer
+        p_ctx->p_rx_destination = NULL;
+        p_ctx->rx_destination_length = 0;
+#endif
+        do
+        {
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+            if (OPTIGA_COMMS_NO_PROTECTION != p_ctx->protection_level)
+            {
+                break;
+            }
+#endif
+            if (OPTIGA_COMMS_DATA_OFFSET > *p_rx_data_len)
+            {
+                break;
+            }
+            pal_os_memset(&p_device->transceive, 0, sizeof(p_device->transceive));
+            p_device->transceive.tx_data = (uintptr_t)(p_tx_data + OPTIGA_COMMS_DATA_OFFSET);
+            p_device->transceive.tx_length = tx_data_length;
+            p_device->transceive.rx_data = (uintptr_t)(p_rx_data + OPTIGA_COMMS_DATA_OFFSET);
+            p_device->transceive.rx_length = *p_rx_data_len - OPTIGA_COMMS_DATA_OFFSET;
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+            p_device->transceive.response_time_hint_us = p_ctx->response_time_hint_us;
+            p_ctx->response_time_hint_us = 0;
+            p_ctx->response_time_us = 0;
+#endif
+            p_device->p_rx_data_len = p_rx_data_len;
+            status = optiga_kernel_start(p_ctx, OPTIGA_KERNEL_OPERATION_TRANSCEIVE);
+        } while (FALSE);
+
+        if (OPTIGA_COMMS_SUCCESS != status)
+        {
+            p_ctx->state = OPTIGA_COMMS_FREE;
+        }
+    }
+    return (status);
+}
+
+optiga_lib_status_t optiga_comms_close(optiga_comms_t * p_ctx)
+{
+    return (optiga_kernel_start_link(p_ctx, OPTIGA_KERNEL_OPERATION_CLOSE, 0));
+}
+
+#ifdef OPTIGA_COMMS_DL_RESEND_BACKOFF_ENABLED
+optiga_lib_status_t optiga_comms_get_recovery_stats(const optiga_comms_t * p_ctx,
+                                                    optiga_lib_comms_recovery_stats_t * p_stats)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_ERROR;
+    if ((NULL != p_ctx) && (NULL != p_ctx->p_comms_ctx) && (NULL != p_stats))
+    {
+        // The link is recovered in the kernel, it is not exported by the character device
+        pal_os_memset(p_stats, 0, sizeof(optiga_lib_comms_recovery_stats_t));
+        status = OPTIGA_COMMS_SUCCESS;
+    }
+    return (status);
+}
+#endif
+
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+optiga_lib_status_t optiga_comms_get_statistics(const optiga_comms_t * p_ctx,
+                                                optiga_lib_comms_stats_t * p_stats)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_ERROR;
+    const optiga_kernel_device_t * p_device;
+
+    if ((NULL != p_ctx) && (NULL != p_ctx->p_comms_ctx) && (NULL != p_stats))
+    {
+        // Statistics of the link in the kernel, accumulated over all processes
+        p_device = (const optiga_kernel_device_t *)p_ctx->p_comms_ctx;
+        if ((-1 != p_device->fd) &&
+            (0 == ioctl(p_device->fd, OPTIGA_KERNEL_IOC_GET_STATISTICS(sizeof(optiga_lib_comms_stats_t)), p_stats)))
+        {
+            status = OPTIGA_COMMS_SUCCESS;
+        }
+    }
+    return (status);
+}
+#endif
+
+#ifdef OPTIGA_COMMS_STACK_USAGE_ENABLED
+optiga_lib_status_t optiga_comms_get_stack_usage(const optiga_comms_t * p_ctx,
+                                                 uint32_t * p_stack_high_water)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_ERROR;
+    if ((NULL != p_ctx) && (NULL != p_ctx->p_comms_ctx) && (NULL != p_stack_high_water))
+    {
+        // The protocol stack runs in the kernel
+        *p_stack_high_water = 0;
+        status = OPTIGA_COMMS_SUCCESS;
+    }
+    return (status);
+}
+#endif
+
+#if defined (OPTIGA_COMMS_SHIELDED_CONNECTION) && defined (OPTIGA_COMMS_KEY_ROLLOVER_ENABLED)
+//lint --e{715} suppress "The kernel transport has no shielded connection, hence no session to renegotiate"
+optiga_lib_status_t optiga_comms_rollover(optiga_comms_t * p_ctx)
+{
+    return (OPTIGA_COMMS_ERROR);
+}
+
+//lint --e{715} suppress "The kernel transport has no shielded connection, hence no session to renegotiate"
+bool_t optiga_comms_rollover_due(const optiga_comms_t * p_ctx)
+{
+    return (FALSE);
+}
+#endif
+
+/// @cond hidden
+_STATIC_H optiga_lib_status_t check_optiga_comms_state(optiga_comms_t * p_ctx)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_ERROR;
+    if ((NULL != p_ctx) && (OPTIGA_COMMS_INUSE != p_ctx->state))
+    {
+        p_ctx->state = OPTIGA_COMMS_INUSE;
+        status = OPTIGA_COMMS_SUCCESS;
+    }
+    return (status);
+}
+
+/*
+* Completes the operation, which is executed by the worker thread, and notifies the upper layer
+*/
+_STATIC_H void optiga_kernel_event_handler(void * p_ctx)
+{
+    optiga_comms_t * p_optiga_comms = (optiga_comms_t *)p_ctx;
+    optiga_kernel_device_t * p_device = (optiga_kernel_device_t *)p_optiga_comms->p_comms_ctx;
+
+    if ((OPTIGA_COMMS_SUCCESS == p_device->event) && (NULL != p_device->p_rx_data_len))
+    {
+        *p_device->p_rx_data_len = p_device->transceive.rx_length;
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+        p_optiga_comms->response_time_us = p_device->transceive.response_time_us;
+#endif
+    }
+    p_device->p_rx_data_len = NULL;
+    p_optiga_comms->upper_layer_handler(p_optiga_comms->p_upper_layer_ctx, p_device->event);
+    p_optiga_comms->state = OPTIGA_COMMS_FREE;
+}
+
+/// @endcond
+/**
+* @}
+*/
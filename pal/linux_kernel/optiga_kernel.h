@@ -0,0 +1,114 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_kernel.h
+*
+* \brief   This file defines the interface of the OPTIGA character device, which is provided by the kernel transport.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#ifndef _OPTIGA_KERNEL_H_
+#define _OPTIGA_KERNEL_H_
+
+#include <linux/ioctl.h>
+#include <linux/types.h>
+
+/**
+ * The kernel module (kernel/optiga_kernel_driver.c) executes the protocol stack (PL/DL/TL) of the IFX I2C protocol
+ * and provides OPTIGA as character device. One ioctl transfers one complete APDU, hence a command costs a single
+ * crossing to the kernel instead of one for each I2C transfer and each poll of the status register.
+ * The accesses of all processes are serialized by the kernel.
+ */
+
+/// Name of the character device (/dev/optiga)
+#define OPTIGA_KERNEL_DEVICE_NAME                   "optiga"
+
+/// Type of the ioctl commands
+#define OPTIGA_KERNEL_IOC_MAGIC                     'O'
+
+/**
+ * @brief Argument of the link operations (open, close and reset).
+ */
+struct optiga_kernel_link
+{
+    /// Reset type of OPTIGA_KERNEL_IOC_RESET (ifx_i2c_reset_type_t), ignored otherwise
+    __u8 reset_type;
+    /// Reserved, must be 0
+    __u8 reserved;
+    /// Result of the operation (OPTIGA_COMMS_SUCCESS or the error reported by optiga comms in the kernel)
+    __u16 status;
+};
+
+/**
+ * @brief Argument of the APDU exchange (OPTIGA_KERNEL_IOC_TRANSCEIVE).
+ */
+struct optiga_kernel_transceive
+{
+    /// Address of the command APDU in the process
+    __u64 tx_data;
+    /// Address of the buffer for the response APDU in the process
+    __u64 rx_data;
+    /// Length of the command APDU
+    __u16 tx_length;
+    /// Size of the response buffer, updated with the length of the response APDU
+    __u16 rx_length;
+    /// Result of the exchange (OPTIGA_COMMS_SUCCESS or the error reported by optiga comms in the kernel)
+    __u16 status;
+    /// Reserved, must be 0
+    __u16 reserved;
+    /// Expected execution time of the command in microseconds (0 if unknown)
+    __u32 response_time_hint_us;
+    /// Measured time until the response was ready in microseconds, 0 if not measured
+    __u32 response_time_us;
+};
+
+/// Opens the link to OPTIGA. The link is shared by all users of the device, only the first open resets OPTIGA
+#define OPTIGA_KERNEL_IOC_OPEN          _IOWR(OPTIGA_KERNEL_IOC_MAGIC, 0x01, struct optiga_kernel_link)
+/// Closes the link of the caller, the link to OPTIGA is closed by the last user
+#define OPTIGA_KERNEL_IOC_CLOSE         _IOWR(OPTIGA_KERNEL_IOC_MAGIC, 0x02, struct optiga_kernel_link)
+/// Resets the link to OPTIGA with the reset type
+#define OPTIGA_KERNEL_IOC_RESET         _IOWR(OPTIGA_KERNEL_IOC_MAGIC, 0x03, struct optiga_kernel_link)
+/**
+ * Sends the command APDU and receives the response APDU, the caller is blocked until the response is received.
+ * The link is to be opened by the file using OPTIGA_KERNEL_IOC_OPEN, else the command is rejected (ENOTCONN).
+ */
+#define OPTIGA_KERNEL_IOC_TRANSCEIVE    _IOWR(OPTIGA_KERNEL_IOC_MAGIC, 0x04, struct optiga_kernel_transceive)
+/**
+ * Provides the link statistics of the kernel (optiga_lib_comms_stats_t, OPTIGA_LIB_STATISTICS_ENABLED).
+ * The size of the structure is part of the command, hence a module with a different layout rejects it (ENOTTY).
+ */
+#define OPTIGA_KERNEL_IOC_GET_STATISTICS(size)      _IOC(_IOC_READ, OPTIGA_KERNEL_IOC_MAGIC, 0x05, (size))
+
+#endif /* _OPTIGA_KERNEL_H_ */
+
+/**
+* @}
+*/
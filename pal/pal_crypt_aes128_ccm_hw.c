@@ -0,0 +1,419 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+*
+* \file pal_crypt_aes128_ccm_hw.c
+*
+* \brief   This file implements the platform abstraction layer APIs for AES CCM using the AES hardware accelerator of the platform.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include "optiga/common/optiga_lib_common.h"
+#include "optiga/pal/pal_crypt.h"
+#include "optiga/pal/pal_os_memory.h"
+
+#ifdef OPTIGA_PAL_CRYPT_HW_AES_ENABLED
+
+/// @cond hidden
+
+/// AES block size
+#define PAL_CRYPT_AES_BLOCK_SIZE                (16U)
+/// Minimum nonce length of AES CCM
+#define PAL_CRYPT_CCM_MIN_NONCE_LENGTH          (7U)
+/// Maximum nonce length of AES CCM
+#define PAL_CRYPT_CCM_MAX_NONCE_LENGTH          (13U)
+/// Associated data length, up to which it is encoded with 2 bytes
+#define PAL_CRYPT_CCM_MAX_ASSOCIATED_LENGTH     (0xFEFFU)
+
+/*
+* Provides the key context of the AES hardware accelerator with the key loaded. Without crypt context,
+* the local key context is loaded. With crypt context, the key context is kept for the next call with the same key.
+*/
+static void * pal_crypt_ccm_key_context(pal_crypt_t * p_pal_crypt, void ** pp_local_key_context, const uint8_t * p_key)
+{
+    void * p_key_context = NULL;
+    uint8_t index;
+
+    do
+    {
+        if (NULL == p_pal_crypt)
+        {
+            if (PAL_STATUS_SUCCESS == pal_crypt_aes128_hw_set_key(pp_local_key_context, p_key))
+            {
+                p_key_context = *pp_local_key_context;
+            }
+            break;
+        }
+        for (index = 0; index < PAL_CRYPT_AES128_CCM_KEY_CONTEXTS; index++)
+        {
+            if ((NULL != p_pal_crypt->p_ccm_key_context[index]) &&
+                (0 == memcmp(p_pal_crypt->ccm_key[index], p_key, PAL_CRYPT_AES128_KEY_LENGTH)))
+            {
+                p_key_context = p_pal_crypt->p_ccm_key_context[index];
+                break;
+            }
+        }
+        if (NULL != p_key_context)
+        {
+            break;
+        }
+
+        // Key context of a new key replaces the one, which is loaded first
+        index = p_pal_crypt->ccm_next_key_context;
+        p_pal_crypt->ccm_next_key_context = (uint8_t)((index + 1) % PAL_CRYPT_AES128_CCM_KEY_CONTEXTS);
+        if (PAL_STATUS_SUCCESS != pal_crypt_aes128_hw_set_key(&p_pal_crypt->p_ccm_key_context[index], p_key))
+        {
+            pal_crypt_aes128_hw_release_key(p_pal_crypt->p_ccm_key_context[index]);
+            p_pal_crypt->p_ccm_key_context[index] = NULL;
+            break;
+        }
+        pal_os_memcpy(p_pal_crypt->ccm_key[index], p_key, PAL_CRYPT_AES128_KEY_LENGTH);
+        p_key_context = p_pal_crypt->p_ccm_key_context[index];
+    } while (FALSE);
+
+    return (p_key_context);
+}
+
+/*
+* Absorbs the data into the CBC-MAC and encrypts the MAC block, whenever it is filled
+*/
+static pal_status_t pal_crypt_ccm_mac_update(void * p_key_context,
+                                             uint8_t * p_mac,
+                                             uint8_t * p_mac_offset,
+                                             const uint8_t * p_data,
+                                             uint16_t data_length)
+{
+    pal_status_t return_status = PAL_STATUS_SUCCESS;
+    uint16_t index;
+
+    for (index = 0; index < data_length; index++)
+    {
+        p_mac[*p_mac_offset] ^= p_data[index];
+        (*p_mac_offset)++;
+        if (PAL_CRYPT_AES_BLOCK_SIZE == *p_mac_offset)
+        {
+            *p_mac_offset = 0;
+            return_status = pal_crypt_aes128_hw_encrypt_block(p_key_context, p_mac, p_mac);
+            if (PAL_STATUS_SUCCESS != return_status)
+            {
+                break;
+            }
+        }
+    }
+    return (return_status);
+}
+
+/*
+* Calculates the CBC-MAC of AES CCM over the associated data and the plain text (RFC 3610 section 2.2)
+*/
+static pal_status_t pal_crypt_ccm_mac(void * p_key_context,
+                                      const uint8_t * p_nonce,
+                                      uint8_t nonce_length,
+                                      const uint8_t * p_associated_data,
+                                      uint16_t associated_data_length,
+                                      const uint8_t * p_plain_text,
+                                      uint16_t plain_text_length,
+                                      uint8_t mac_size,
+                                      uint8_t * p_mac)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    uint8_t mac_offset = 0;
+    uint8_t associated_data_header[2];
+
+    do
+    {
+        // B_0 : Flags | Nonce | Length of plain text
+        pal_os_memset(p_mac, 0, PAL_CRYPT_AES_BLOCK_SIZE);
+        p_mac[0] = (uint8_t)((((mac_size - 2U) / 2U) << 3) | (PAL_CRYPT_AES_BLOCK_SIZE - 2U - nonce_length));
+        if (0U != associated_data_length)
+        {
+            p_mac[0] |= 0x40U;
+        }
+        pal_os_memcpy(&p_mac[1], p_nonce, nonce_length);
+        p_mac[PAL_CRYPT_AES_BLOCK_SIZE - 2U] = (uint8_t)(plain_text_length >> 8);
+        p_mac[PAL_CRYPT_AES_BLOCK_SIZE - 1U] = (uint8_t)(plain_text_length);
+        if (PAL_STATUS_SUCCESS != pal_crypt_aes128_hw_encrypt_block(p_key_context, p_mac, p_mac))
+        {
+            break;
+        }
+
+        // Associated data with 2 bytes length, padded with zero to block size
+        if (0U != associated_data_length)
+        {
+            associated_data_header[0] = (uint8_t)(associated_data_length >> 8);
+            associated_data_header[1] = (uint8_t)(associated_data_length);
+            if ((PAL_STATUS_SUCCESS != pal_crypt_ccm_mac_update(p_key_context, p_mac, &mac_offset,
+                                                                associated_data_header,
+                                                                sizeof(associated_data_header))) ||
+                (PAL_STATUS_SUCCESS != pal_crypt_ccm_mac_update(p_key_context, p_mac, &mac_offset,
+                                                                p_associated_data, associated_data_length)))
+            {
+                break;
+            }
+            if ((0U != mac_offset) &&
+                (PAL_STATUS_SUCCESS != pal_crypt_aes128_hw_encrypt_block(p_key_context, p_mac, p_mac)))
+            {
+                break;
+            }
+            mac_offset = 0;
+        }
+
+        // Plain text, padded with zero to block size
+        if (PAL_STATUS_SUCCESS != pal_crypt_ccm_mac_update(p_key_context, p_mac, &mac_offset,
+                                                           p_plain_text, plain_text_length))
+        {
+            break;
+        }
+        if ((0U != mac_offset) &&
+            (PAL_STATUS_SUCCESS != pal_crypt_aes128_hw_encrypt_block(p_key_context, p_mac, p_mac)))
+        {
+            break;
+        }
+        return_status = PAL_STATUS_SUCCESS;
+    } while (FALSE);
+    return (return_status);
+}
+
+/*
+* Applies the key stream of AES CCM (CTR mode) starting with the given counter (RFC 3610 section 2.3)
+*/
+static pal_status_t pal_crypt_ccm_ctr(void * p_key_context,
+                                      const uint8_t * p_nonce,
+                                      uint8_t nonce_length,
+                                      uint16_t counter,
+                                      const uint8_t * p_input,
+                                      uint8_t * p_output,
+                                      uint16_t length)
+{
+    pal_status_t return_status = PAL_STATUS_SUCCESS;
+    uint8_t counter_block[PAL_CRYPT_AES_BLOCK_SIZE];
+    uint8_t key_stream[PAL_CRYPT_AES_BLOCK_SIZE];
+    uint16_t offset = 0;
+    uint8_t index;
+
+    // A_i : Flags | Nonce | Counter i
+    pal_os_memset(counter_block, 0, sizeof(counter_block));
+    counter_block[0] = (uint8_t)(PAL_CRYPT_AES_BLOCK_SIZE - 2U - nonce_length);
+    pal_os_memcpy(&counter_block[1], p_nonce, nonce_length);
+    while (offset < length)
+    {
+        counter_block[PAL_CRYPT_AES_BLOCK_SIZE - 2U] = (uint8_t)(counter >> 8);
+        counter_block[PAL_CRYPT_AES_BLOCK_SIZE - 1U] = (uint8_t)(counter);
+        return_status = pal_crypt_aes128_hw_encrypt_block(p_key_context, counter_block, key_stream);
+        if (PAL_STATUS_SUCCESS != return_status)
+        {
+            break;
+        }
+        for (index = 0; (index < PAL_CRYPT_AES_BLOCK_SIZE) && (offset < length); index++)
+        {
+            p_output[offset] = p_input[offset] ^ key_stream[index];
+            offset++;
+        }
+        counter++;
+    }
+    pal_os_memset(key_stream, 0, sizeof(key_stream));
+    return (return_status);
+}
+
+/*
+* Checks the AES CCM parameters, which are supported with 2 bytes length field of the plain text
+*/
+static bool_t pal_crypt_ccm_check_parameters(uint16_t nonce_length, uint16_t associated_data_length, uint8_t mac_size)
+{
+    return ((nonce_length >= PAL_CRYPT_CCM_MIN_NONCE_LENGTH) && (nonce_length <= PAL_CRYPT_CCM_MAX_NONCE_LENGTH) &&
+            (mac_size >= 4U) && (mac_size <= PAL_CRYPT_AES_BLOCK_SIZE) && (0U == (mac_size & 0x01U)) &&
+            (associated_data_length <= PAL_CRYPT_CCM_MAX_ASSOCIATED_LENGTH)) ? TRUE : FALSE;
+}
+
+/// @endcond
+
+pal_status_t pal_crypt_encrypt_aes128_ccm(pal_crypt_t* p_pal_crypt,
+                                          const uint8_t * p_plain_text,
+                                          uint16_t plain_text_length,
+                                          const uint8_t * p_encrypt_key,
+                                          const uint8_t * p_nonce,
+                                          uint16_t nonce_length,
+                                          const uint8_t * p_associated_data,
+                                          uint16_t associated_data_length,
+                                          uint8_t mac_size,
+                                          uint8_t * p_cipher_text)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    uint8_t mac_output[PAL_CRYPT_AES_BLOCK_SIZE];
+    void * p_local_key_context = NULL;
+    void * p_key_context;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == p_cipher_text) || (NULL == p_plain_text) ||
+            (NULL == p_nonce) || (NULL == p_associated_data) || (NULL == p_encrypt_key))
+        {
+            break;
+        }
+#endif
+        if (FALSE == pal_crypt_ccm_check_parameters(nonce_length, associated_data_length, mac_size))
+        {
+            break;
+        }
+        p_key_context = pal_crypt_ccm_key_context(p_pal_crypt, &p_local_key_context, p_encrypt_key);
+        if (NULL == p_key_context)
+        {
+            break;
+        }
+        // MAC is calculated first, hence the cipher text can overwrite the plain text
+        if (PAL_STATUS_SUCCESS != pal_crypt_ccm_mac(p_key_context, p_nonce, (uint8_t)nonce_length,
+                                                    p_associated_data, associated_data_length,
+                                                    p_plain_text, plain_text_length,
+                                                    mac_size, mac_output))
+        {
+            break;
+        }
+        if (PAL_STATUS_SUCCESS != pal_crypt_ccm_ctr(p_key_context, p_nonce, (uint8_t)nonce_length, 1,
+                                                    p_plain_text, p_cipher_text, plain_text_length))
+        {
+            break;
+        }
+        if (PAL_STATUS_SUCCESS != pal_crypt_ccm_ctr(p_key_context, p_nonce, (uint8_t)nonce_length, 0,
+                                                    mac_output, mac_output, mac_size))
+        {
+            break;
+        }
+        pal_os_memcpy((p_cipher_text + plain_text_length), mac_output, mac_size);
+        return_status = PAL_STATUS_SUCCESS;
+    } while (FALSE);
+    pal_crypt_aes128_hw_release_key(p_local_key_context);
+    pal_os_memset(mac_output, 0, sizeof(mac_output));
+    return return_status;
+}
+
+pal_status_t pal_crypt_decrypt_aes128_ccm(pal_crypt_t* p_pal_crypt,
+                                          const uint8_t * p_cipher_text,
+                                          uint16_t cipher_text_length,
+                                          const uint8_t * p_decrypt_key,
+                                          const uint8_t * p_nonce,
+                                          uint16_t nonce_length,
+                                          const uint8_t * p_associated_data,
+                                          uint16_t associated_data_length,
+                                          uint8_t mac_size,
+                                          uint8_t * p_plain_text)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    uint8_t mac_output[PAL_CRYPT_AES_BLOCK_SIZE];
+    void * p_local_key_context = NULL;
+    void * p_key_context;
+    uint16_t plain_text_length;
+    uint8_t mac_difference = 0;
+    uint8_t index;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if ((NULL == p_plain_text) || (NULL == p_cipher_text) ||
+            (NULL == p_nonce) || (NULL == p_associated_data) || (NULL == p_decrypt_key))
+        {
+            break;
+        }
+#endif
+        if ((FALSE == pal_crypt_ccm_check_parameters(nonce_length, associated_data_length, mac_size)) ||
+            (cipher_text_length < mac_size))
+        {
+            break;
+        }
+        plain_text_length = cipher_text_length - mac_size;
+        p_key_context = pal_crypt_ccm_key_context(p_pal_crypt, &p_local_key_context, p_decrypt_key);
+        if (NULL == p_key_context)
+        {
+            break;
+        }
+        if (PAL_STATUS_SUCCESS != pal_crypt_ccm_ctr(p_key_context, p_nonce, (uint8_t)nonce_length, 1,
+                                                    p_cipher_text, p_plain_text, plain_text_length))
+        {
+            break;
+        }
+        if ((PAL_STATUS_SUCCESS != pal_crypt_ccm_mac(p_key_context, p_nonce, (uint8_t)nonce_length,
+                                                     p_associated_data, associated_data_length,
+                                                     p_plain_text, plain_text_length,
+                                                     mac_size, mac_output)) ||
+            (PAL_STATUS_SUCCESS != pal_crypt_ccm_ctr(p_key_context, p_nonce, (uint8_t)nonce_length, 0,
+                                                     mac_output, mac_output, mac_size)))
+        {
+            pal_os_memset(p_plain_text, 0, plain_text_length);
+            break;
+        }
+        // MAC is compared in constant time
+        for (index = 0; index < mac_size; index++)
+        {
+            mac_difference |= (uint8_t)(mac_output[index] ^ p_cipher_text[plain_text_length + index]);
+        }
+        if (0U != mac_difference)
+        {
+            // Plain text of a forged cipher text is not released
+            pal_os_memset(p_plain_text, 0, plain_text_length);
+            break;
+        }
+        return_status = PAL_STATUS_SUCCESS;
+    } while (FALSE);
+    pal_crypt_aes128_hw_release_key(p_local_key_context);
+    pal_os_memset(mac_output, 0, sizeof(mac_output));
+    return return_status;
+}
+
+pal_status_t pal_crypt_release_keys(pal_crypt_t* p_pal_crypt)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    uint8_t index;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == p_pal_crypt)
+        {
+            break;
+        }
+#endif
+        for (index = 0; index < PAL_CRYPT_AES128_CCM_KEY_CONTEXTS; index++)
+        {
+            pal_crypt_aes128_hw_release_key(p_pal_crypt->p_ccm_key_context[index]);
+            p_pal_crypt->p_ccm_key_context[index] = NULL;
+        }
+        pal_os_memset(p_pal_crypt->ccm_key, 0, sizeof(p_pal_crypt->ccm_key));
+        p_pal_crypt->ccm_next_key_context = 0;
+        return_status = PAL_STATUS_SUCCESS;
+    } while (FALSE);
+    return return_status;
+}
+
+#endif //OPTIGA_PAL_CRYPT_HW_AES_ENABLED
+
+/**
+* @}
+*/
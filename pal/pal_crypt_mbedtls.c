@@ -39,11 +39,64 @@
 #include "optiga/pal/pal_crypt.h"
 #include "optiga/pal/pal_os_memory.h"
 #include "mbedtls/ccm.h"
+#include "mbedtls/ecdsa.h"
 #include "mbedtls/md.h"
+#include "mbedtls/sha256.h"
 #include "mbedtls/ssl.h"
 #include "mbedtls/version.h"
 
-#define PAL_CRYPT_MAX_LABEL_SEED_LENGTH     (96U)
+/// Maximum length of the ECDSA signature (r and s as DER INTEGERs) for ECC NIST P521
+#define PAL_CRYPT_ECDSA_MAX_SIGNATURE_LENGTH    (0x8A)
+/// Block size of SHA256, which is the size of the HMAC pads
+#define PAL_CRYPT_SHA256_BLOCK_SIZE         (64U)
+/// Digest size of SHA256
+#define PAL_CRYPT_SHA256_DIGEST_SIZE        (32U)
+
+/*
+* Completes one HMAC SHA256 over up to three message parts, starting from the precomputed inner and outer pad states.
+* Hence the pads are not hashed again for each HMAC of the PRF.
+*/
+static int pal_crypt_hmac_sha256_finish(const mbedtls_sha256_context * p_inner_pad_context,
+                                        const mbedtls_sha256_context * p_outer_pad_context,
+                                        mbedtls_sha256_context * p_work_context,
+                                        const uint8_t * p_part_1,
+                                        uint16_t part_1_length,
+                                        const uint8_t * p_part_2,
+                                        uint16_t part_2_length,
+                                        const uint8_t * p_part_3,
+                                        uint16_t part_3_length,
+                                        uint8_t * p_hmac)
+{
+    int result;
+    uint8_t inner_digest[PAL_CRYPT_SHA256_DIGEST_SIZE];
+
+    mbedtls_sha256_clone(p_work_context, p_inner_pad_context);
+    result = mbedtls_sha256_update_ret(p_work_context, p_part_1, part_1_length);
+    if ((0 == result) && (0 != part_2_length))
+    {
+        result = mbedtls_sha256_update_ret(p_work_context, p_part_2, part_2_length);
+    }
+    if ((0 == result) && (0 != part_3_length))
+    {
+        result = mbedtls_sha256_update_ret(p_work_context, p_part_3, part_3_length);
+    }
+    if (0 == result)
+    {
+        result = mbedtls_sha256_finish_ret(p_work_context, inner_digest);
+    }
+    if (0 == result)
+    {
+        mbedtls_sha256_clone(p_work_context, p_outer_pad_context);
+        result = mbedtls_sha256_update_ret(p_work_context, inner_digest, sizeof(inner_digest));
+    }
+    if (0 == result)
+    {
+        result = mbedtls_sha256_finish_ret(p_work_context, p_hmac);
+    }
+    memset(inner_digest, 0x00, sizeof(inner_digest));
+    return (result);
+}
+
 //lint --e{818, 715, 830} suppress "argument "p_pal_crypt" is not used in the implementation but kept for future use"
 pal_status_t pal_crypt_tls_prf_sha256(pal_crypt_t* p_pal_crypt,
                                       const uint8_t * p_secret,
@@ -55,20 +108,22 @@ pal_status_t pal_crypt_tls_prf_sha256(pal_crypt_t* p_pal_crypt,
                                       uint8_t * p_derived_key,
                                       uint16_t derived_key_length)
 {
-    #define PAL_CRYPT_DIGEST_MAX_SIZE    (32U)
-
     pal_status_t return_value = PAL_STATUS_FAILURE;
-    uint8_t message_digest_length = PAL_CRYPT_DIGEST_MAX_SIZE;
-    uint16_t derive_key_len_index, hmac_checksum_result_index;
+    uint16_t derive_key_len_index = 0;
     uint16_t hmac_result_length;
-    uint8_t md_hmac_temp_array[PAL_CRYPT_MAX_LABEL_SEED_LENGTH + PAL_CRYPT_DIGEST_MAX_SIZE];
-    uint8_t hmac_checksum_result[PAL_CRYPT_DIGEST_MAX_SIZE];
-    const mbedtls_md_info_t *message_digest_info;
-    mbedtls_md_context_t message_digest_context;
-    uint16_t final_seed_length = 0;
-       
-    mbedtls_md_init(&message_digest_context);
-    
+    uint16_t index;
+    uint8_t key_pad[PAL_CRYPT_SHA256_BLOCK_SIZE];
+    uint8_t a_value[PAL_CRYPT_SHA256_DIGEST_SIZE];
+    uint8_t hmac_checksum_result[PAL_CRYPT_SHA256_DIGEST_SIZE];
+    mbedtls_sha256_context inner_pad_context;
+    mbedtls_sha256_context outer_pad_context;
+    mbedtls_sha256_context work_context;
+
+    mbedtls_sha256_init(&inner_pad_context);
+    mbedtls_sha256_init(&outer_pad_context);
+    mbedtls_sha256_init(&work_context);
+    memset(key_pad, 0x00, sizeof(key_pad));
+
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
@@ -78,91 +133,158 @@ pal_status_t pal_crypt_tls_prf_sha256(pal_crypt_t* p_pal_crypt,
         }
 #endif  //OPTIGA_LIB_DEBUG_NULL_CHECK
 
-        if (sizeof(md_hmac_temp_array ) < (uint32_t)(message_digest_length + label_length + seed_length))
+        // HMAC key, a key longer than the block size is hashed
+        if (secret_length > PAL_CRYPT_SHA256_BLOCK_SIZE)
         {
-            return_value = PAL_STATUS_INVALID_INPUT;
-            break;
+            if (0 != mbedtls_sha256_ret(p_secret, secret_length, key_pad, 0))
+            {
+                break;
+            }
         }
-
-        message_digest_info = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
-
-        memcpy(md_hmac_temp_array + message_digest_length, p_label, label_length);
-        memcpy(md_hmac_temp_array + message_digest_length + label_length, p_seed, seed_length);
-        final_seed_length = label_length + seed_length;
-
-        if (0 != (mbedtls_md_setup(&message_digest_context,message_digest_info,1)))
+        else
         {
-            return_value = PAL_STATUS_INVALID_INPUT;
-            break;
+            memcpy(key_pad, p_secret, secret_length);
         }
 
-        if (0 != mbedtls_md_hmac_starts(&message_digest_context, p_secret, secret_length))
+        // Inner and outer pads are hashed once, the states are cloned for each HMAC
+        for (index = 0; index < PAL_CRYPT_SHA256_BLOCK_SIZE; index++)
+        {
+            key_pad[index] ^= 0x36;
+        }
+        if ((0 != mbedtls_sha256_starts_ret(&inner_pad_context, 0)) ||
+            (0 != mbedtls_sha256_update_ret(&inner_pad_context, key_pad, sizeof(key_pad))))
         {
             break;
         }
-       
-        if (0 != mbedtls_md_hmac_update(&message_digest_context, md_hmac_temp_array + message_digest_length, final_seed_length))
+        for (index = 0; index < PAL_CRYPT_SHA256_BLOCK_SIZE; index++)
+        {
+            key_pad[index] ^= (0x36 ^ 0x5C);
+        }
+        if ((0 != mbedtls_sha256_starts_ret(&outer_pad_context, 0)) ||
+            (0 != mbedtls_sha256_update_ret(&outer_pad_context, key_pad, sizeof(key_pad))))
         {
             break;
         }
-        
-        if (0 != mbedtls_md_hmac_finish(&message_digest_context, md_hmac_temp_array))
+
+        // A(1) = HMAC(secret, label + seed)
+        if (0 != pal_crypt_hmac_sha256_finish(&inner_pad_context, &outer_pad_context, &work_context,
+                                              p_label, label_length, p_seed, seed_length, NULL, 0, a_value))
         {
             break;
         }
 
-        for (derive_key_len_index = 0; derive_key_len_index < derived_key_length; 
-             derive_key_len_index += message_digest_length)
+        while (derive_key_len_index < derived_key_length)
         {
-            if (0 != mbedtls_md_hmac_reset(&message_digest_context))
+            hmac_result_length = (uint16_t)(derived_key_length - derive_key_len_index);
+            if (PAL_CRYPT_SHA256_DIGEST_SIZE < hmac_result_length)
             {
-                break;
+                hmac_result_length = PAL_CRYPT_SHA256_DIGEST_SIZE;
             }
-            if (0 != mbedtls_md_hmac_update(&message_digest_context, md_hmac_temp_array, 
-                            message_digest_length + final_seed_length))
+
+            // P_hash block = HMAC(secret, A(i) + label + seed), a complete block is written to the output directly
+            if (0 != pal_crypt_hmac_sha256_finish(&inner_pad_context, &outer_pad_context, &work_context,
+                                                  a_value, sizeof(a_value),
+                                                  p_label, label_length,
+                                                  p_seed, seed_length,
+                                                  (PAL_CRYPT_SHA256_DIGEST_SIZE == hmac_result_length) ?
+                                                  &p_derived_key[derive_key_len_index] : hmac_checksum_result))
             {
-                break;                
+                break;
             }
-            if (0 != mbedtls_md_hmac_finish(&message_digest_context, hmac_checksum_result))
+            if (PAL_CRYPT_SHA256_DIGEST_SIZE != hmac_result_length)
             {
-                break;                                
+                memcpy(&p_derived_key[derive_key_len_index], hmac_checksum_result, hmac_result_length);
             }
+            derive_key_len_index += hmac_result_length;
 
-            if (0 != mbedtls_md_hmac_reset(&message_digest_context))
+            // A(i+1) = HMAC(secret, A(i)), only if another block is required
+            if ((derive_key_len_index < derived_key_length) &&
+                (0 != pal_crypt_hmac_sha256_finish(&inner_pad_context, &outer_pad_context, &work_context,
+                                                   a_value, sizeof(a_value), NULL, 0, NULL, 0, a_value)))
             {
-                break;                
+                break;
             }
-            if (0 != mbedtls_md_hmac_update(&message_digest_context, md_hmac_temp_array, message_digest_length))
+        }
+        if (derive_key_len_index >= derived_key_length)
+        {
+            return_value = PAL_STATUS_SUCCESS;
+        }
+    } while (FALSE);
+
+    mbedtls_sha256_free(&inner_pad_context);
+    mbedtls_sha256_free(&outer_pad_context);
+    mbedtls_sha256_free(&work_context);
+
+    memset(key_pad, 0x00, sizeof(key_pad));
+    memset(a_value, 0x00, sizeof(a_value));
+    memset(hmac_checksum_result, 0x00, sizeof(hmac_checksum_result));
+    return return_value;
+}
+
+#ifndef OPTIGA_PAL_CRYPT_HW_AES_ENABLED
+/*
+* Provides the CCM context with the key schedule of the key. Without crypt context, the local context is set up.
+* With crypt context, the key schedule is kept for the next call with the same key.
+*/
+static mbedtls_ccm_context * pal_crypt_ccm_context(pal_crypt_t * p_pal_crypt,
+                                                   mbedtls_ccm_context * p_local_context,
+                                                   const uint8_t * p_key)
+{
+    mbedtls_ccm_context * p_ccm_context = NULL;
+    uint8_t index;
+
+    do
+    {
+        if (NULL == p_pal_crypt)
+        {
+            if (0 == mbedtls_ccm_setkey(p_local_context, MBEDTLS_CIPHER_ID_AES, p_key, 8 * PAL_CRYPT_AES128_KEY_LENGTH))
             {
-                break;                                
+                p_ccm_context = p_local_context;
             }
-            if (0 != mbedtls_md_hmac_finish(&message_digest_context, md_hmac_temp_array))
+            break;
+        }
+        for (index = 0; index < PAL_CRYPT_AES128_CCM_KEY_CONTEXTS; index++)
+        {
+            if ((NULL != p_pal_crypt->p_ccm_key_context[index]) &&
+                (0 == memcmp(p_pal_crypt->ccm_key[index], p_key, PAL_CRYPT_AES128_KEY_LENGTH)))
             {
-                break;                                
+                p_ccm_context = (mbedtls_ccm_context * )p_pal_crypt->p_ccm_key_context[index];
+                break;
             }
+        }
+        if (NULL != p_ccm_context)
+        {
+            break;
+        }
 
-            hmac_result_length = ((derive_key_len_index + message_digest_length) > derived_key_length) ? 
-                                  (derived_key_length % message_digest_length) : (message_digest_length);
-
-            for (hmac_checksum_result_index = 0; hmac_checksum_result_index < hmac_result_length; 
-                 hmac_checksum_result_index++)
+        // Key schedule of a new key replaces the one, which is set up first
+        index = p_pal_crypt->ccm_next_key_context;
+        p_pal_crypt->ccm_next_key_context = (uint8_t)((index + 1) % PAL_CRYPT_AES128_CCM_KEY_CONTEXTS);
+        if (NULL == p_pal_crypt->p_ccm_key_context[index])
+        {
+            p_pal_crypt->p_ccm_key_context[index] = pal_os_calloc(1, sizeof(mbedtls_ccm_context));
+            if (NULL == p_pal_crypt->p_ccm_key_context[index])
             {
-                p_derived_key[derive_key_len_index + hmac_checksum_result_index] = 
-                                                                    hmac_checksum_result[hmac_checksum_result_index];
+                break;
             }
         }
-        if (derive_key_len_index >= derived_key_length)
+        else
         {
-            return_value = PAL_STATUS_SUCCESS;
+            mbedtls_ccm_free((mbedtls_ccm_context * )p_pal_crypt->p_ccm_key_context[index]);
+        }
+        mbedtls_ccm_init((mbedtls_ccm_context * )p_pal_crypt->p_ccm_key_context[index]);
+        if (0 != mbedtls_ccm_setkey((mbedtls_ccm_context * )p_pal_crypt->p_ccm_key_context[index],
+                                    MBEDTLS_CIPHER_ID_AES, p_key, 8 * PAL_CRYPT_AES128_KEY_LENGTH))
+        {
+            pal_os_free(p_pal_crypt->p_ccm_key_context[index]);
+            p_pal_crypt->p_ccm_key_context[index] = NULL;
+            break;
         }
+        memcpy(p_pal_crypt->ccm_key[index], p_key, PAL_CRYPT_AES128_KEY_LENGTH);
+        p_ccm_context = (mbedtls_ccm_context * )p_pal_crypt->p_ccm_key_context[index];
     } while (FALSE);
-    
-    mbedtls_md_free(&message_digest_context);
 
-    memset(md_hmac_temp_array, 0x00, sizeof(md_hmac_temp_array));
-    memset(hmac_checksum_result, 0x00, sizeof(hmac_checksum_result));    
-    #undef PAL_CRYPT_DIGEST_MAX_SIZE
-    return return_value;
+    return (p_ccm_context);
 }
 
 //lint --e{818, 715, 830} suppress "argument "p_pal_crypt" is not used in the implementation but kept for future use"
@@ -177,12 +299,12 @@ pal_status_t pal_crypt_encrypt_aes128_ccm(pal_crypt_t* p_pal_crypt,
                                           uint8_t mac_size,
                                           uint8_t * p_cipher_text)
 {
-    #define AES128_KEY_BITS_SIZE    (16U)
     #define MAC_TAG_BUFFER_SIZE     (16U)
     
     pal_status_t return_status = PAL_STATUS_FAILURE;
     uint8_t mac_output[MAC_TAG_BUFFER_SIZE];
     mbedtls_ccm_context sEncrypt;
+    mbedtls_ccm_context * p_ccm_context;
 
     mbedtls_ccm_init(&sEncrypt);
 
@@ -196,12 +318,13 @@ pal_status_t pal_crypt_encrypt_aes128_ccm(pal_crypt_t* p_pal_crypt,
         }
 #endif
 
-        if (0 != mbedtls_ccm_setkey(&sEncrypt, MBEDTLS_CIPHER_ID_AES, p_encrypt_key, 8 * AES128_KEY_BITS_SIZE))
+        p_ccm_context = pal_crypt_ccm_context(p_pal_crypt, &sEncrypt, p_encrypt_key);
+        if (NULL == p_ccm_context)
         {
             break;
         }
         
-        if (0 != mbedtls_ccm_encrypt_and_tag(&sEncrypt,
+        if (0 != mbedtls_ccm_encrypt_and_tag(p_ccm_context,
                                               plain_text_length,
                                               p_nonce,
                                               nonce_length,
@@ -220,7 +343,6 @@ pal_status_t pal_crypt_encrypt_aes128_ccm(pal_crypt_t* p_pal_crypt,
         return_status = PAL_STATUS_SUCCESS;
     } while (FALSE);
     mbedtls_ccm_free(&sEncrypt);
-    #undef AES128_KEY_BITS_SIZE
     #undef MAC_TAG_BUFFER_SIZE    
     return return_status;
 }
@@ -237,9 +359,9 @@ pal_status_t pal_crypt_decrypt_aes128_ccm(pal_crypt_t* p_pal_crypt,
                                           uint8_t mac_size,
                                           uint8_t * p_plain_text)
 {
-    #define AES128_KEY_BITS_SIZE    (16U)
     pal_status_t return_status = PAL_STATUS_FAILURE;
     mbedtls_ccm_context sDecrypt;
+    mbedtls_ccm_context * p_ccm_context;
 
     mbedtls_ccm_init(&sDecrypt);
 
@@ -253,12 +375,13 @@ pal_status_t pal_crypt_decrypt_aes128_ccm(pal_crypt_t* p_pal_crypt,
         }
 #endif
 
-        if (0 != mbedtls_ccm_setkey(&sDecrypt, MBEDTLS_CIPHER_ID_AES, p_decrypt_key, 8 * AES128_KEY_BITS_SIZE))
+        p_ccm_context = pal_crypt_ccm_context(p_pal_crypt, &sDecrypt, p_decrypt_key);
+        if (NULL == p_ccm_context)
         {
             break;
         }
 
-        if (0 != mbedtls_ccm_auth_decrypt(&sDecrypt,
+        if (0 != mbedtls_ccm_auth_decrypt(p_ccm_context,
                                           (cipher_text_length - mac_size),
                                           p_nonce,
                                           nonce_length,
@@ -274,10 +397,207 @@ pal_status_t pal_crypt_decrypt_aes128_ccm(pal_crypt_t* p_pal_crypt,
         return_status = PAL_STATUS_SUCCESS;
     } while (FALSE);
     mbedtls_ccm_free(&sDecrypt);
-    #undef AES128_KEY_BITS_SIZE
     return return_status;
 }
 
+pal_status_t pal_crypt_release_keys(pal_crypt_t* p_pal_crypt)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    uint8_t index;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == p_pal_crypt)
+        {
+            break;
+        }
+#endif
+        for (index = 0; index < PAL_CRYPT_AES128_CCM_KEY_CONTEXTS; index++)
+        {
+            if (NULL != p_pal_crypt->p_ccm_key_context[index])
+            {
+                // Frees the key schedule, which is zeroized by mbedTLS
+                mbedtls_ccm_free((mbedtls_ccm_context * )p_pal_crypt->p_ccm_key_context[index]);
+                pal_os_free(p_pal_crypt->p_ccm_key_context[index]);
+                p_pal_crypt->p_ccm_key_context[index] = NULL;
+            }
+        }
+        pal_os_memset(p_pal_crypt->ccm_key, 0, sizeof(p_pal_crypt->ccm_key));
+        p_pal_crypt->ccm_next_key_context = 0;
+        return_status = PAL_STATUS_SUCCESS;
+    } while (FALSE);
+    return return_status;
+}
+
+#endif //OPTIGA_PAL_CRYPT_HW_AES_ENABLED
+
+//lint --e{818, 715, 830} suppress "argument "p_pal_crypt" is not used in the implementation but kept for future use"
+pal_status_t pal_crypt_sha256_start(pal_crypt_t* p_pal_crypt,
+                                    uint8_t * p_context,
+                                    uint16_t context_length)
+{
+    pal_status_t return_value = PAL_STATUS_FAILURE;
+    mbedtls_sha256_context sha256_context;
+
+    do
+    {
+        // State of the library is kept in the buffer of the caller between the calls
+        if (sizeof(sha256_context) > context_length)
+        {
+            break;
+        }
+        mbedtls_sha256_init(&sha256_context);
+        if (0 != mbedtls_sha256_starts_ret(&sha256_context, 0))
+        {
+            break;
+        }
+        pal_os_memcpy(p_context, &sha256_context, sizeof(sha256_context));
+        return_value = PAL_STATUS_SUCCESS;
+    } while (FALSE);
+    mbedtls_sha256_free(&sha256_context);
+    return return_value;
+}
+
+//lint --e{818, 715, 830} suppress "argument "p_pal_crypt" is not used in the implementation but kept for future use"
+pal_status_t pal_crypt_sha256_update(pal_crypt_t* p_pal_crypt,
+                                     uint8_t * p_context,
+                                     uint16_t context_length,
+                                     const uint8_t * p_data,
+                                     uint32_t data_length)
+{
+    pal_status_t return_value = PAL_STATUS_FAILURE;
+    mbedtls_sha256_context sha256_context;
+
+    do
+    {
+        if (sizeof(sha256_context) > context_length)
+        {
+            break;
+        }
+        pal_os_memcpy(&sha256_context, p_context, sizeof(sha256_context));
+        if (0 != mbedtls_sha256_update_ret(&sha256_context, p_data, data_length))
+        {
+            break;
+        }
+        pal_os_memcpy(p_context, &sha256_context, sizeof(sha256_context));
+        return_value = PAL_STATUS_SUCCESS;
+    } while (FALSE);
+    return return_value;
+}
+
+//lint --e{818, 715, 830} suppress "argument "p_pal_crypt" is not used in the implementation but kept for future use"
+pal_status_t pal_crypt_sha256_finalize(pal_crypt_t* p_pal_crypt,
+                                       uint8_t * p_context,
+                                       uint16_t context_length,
+                                       uint8_t * p_digest)
+{
+    pal_status_t return_value = PAL_STATUS_FAILURE;
+    mbedtls_sha256_context sha256_context;
+
+    do
+    {
+        if (sizeof(sha256_context) > context_length)
+        {
+            break;
+        }
+        pal_os_memcpy(&sha256_context, p_context, sizeof(sha256_context));
+        if (0 != mbedtls_sha256_finish_ret(&sha256_context, p_digest))
+        {
+            break;
+        }
+        return_value = PAL_STATUS_SUCCESS;
+    } while (FALSE);
+    mbedtls_sha256_free(&sha256_context);
+    return return_value;
+}
+
+//lint --e{818, 715, 830} suppress "argument "p_pal_crypt" is not used in the implementation but kept for future use"
+pal_status_t pal_crypt_ecdsa_verify(pal_crypt_t* p_pal_crypt,
+                                    uint8_t curve_id,
+                                    const uint8_t * p_digest,
+                                    uint16_t digest_length,
+                                    const uint8_t * p_signature,
+                                    uint16_t signature_length,
+                                    const uint8_t * p_public_key,
+                                    uint16_t public_key_length)
+{
+    pal_status_t return_value = PAL_STATUS_INVALID_INPUT;
+    uint8_t der_signature[PAL_CRYPT_ECDSA_MAX_SIGNATURE_LENGTH + 3];
+    uint16_t der_signature_length = 0;
+    uint16_t public_key_header_length;
+    mbedtls_ecp_group_id group_id;
+    mbedtls_ecdsa_context ecdsa_context;
+
+    mbedtls_ecdsa_init(&ecdsa_context);
+    do
+    {
+        switch (curve_id)
+        {
+            case PAL_CRYPT_ECC_NIST_P_256: group_id = MBEDTLS_ECP_DP_SECP256R1; break;
+            case PAL_CRYPT_ECC_NIST_P_384: group_id = MBEDTLS_ECP_DP_SECP384R1; break;
+            case PAL_CRYPT_ECC_NIST_P_521: group_id = MBEDTLS_ECP_DP_SECP521R1; break;
+            case PAL_CRYPT_ECC_BRAINPOOL_P_256R1: group_id = MBEDTLS_ECP_DP_BP256R1; break;
+            case PAL_CRYPT_ECC_BRAINPOOL_P_384R1: group_id = MBEDTLS_ECP_DP_BP384R1; break;
+            case PAL_CRYPT_ECC_BRAINPOOL_P_512R1: group_id = MBEDTLS_ECP_DP_BP512R1; break;
+            default: group_id = MBEDTLS_ECP_DP_NONE; break;
+        }
+        if (MBEDTLS_ECP_DP_NONE == group_id)
+        {
+            break;
+        }
+        // Signature is the content of the DER SEQUENCE, hence the SEQUENCE header is added
+        if (PAL_CRYPT_ECDSA_MAX_SIGNATURE_LENGTH < signature_length)
+        {
+            break;
+        }
+        der_signature[der_signature_length++] = 0x30;
+        if (0x7F < signature_length)
+        {
+            der_signature[der_signature_length++] = 0x81;
+        }
+        der_signature[der_signature_length++] = (uint8_t)signature_length;
+        pal_os_memcpy(&der_signature[der_signature_length], p_signature, signature_length);
+        der_signature_length += signature_length;
+
+        // Public key is a DER BIT STRING (tag, length and unused bits) with the uncompressed point
+        public_key_header_length = 3;
+        if ((public_key_length > 1) && (0x81 == p_public_key[1]))
+        {
+            public_key_header_length = 4;
+        }
+        if ((public_key_length <= public_key_header_length) || (0x03 != p_public_key[0]))
+        {
+            break;
+        }
+        // Curves, which are not enabled in the library, are reported as invalid input
+        if (0 != mbedtls_ecp_group_load(&ecdsa_context.grp, group_id))
+        {
+            break;
+        }
+        if (0 != mbedtls_ecp_point_read_binary(&ecdsa_context.grp,
+                                               &ecdsa_context.Q,
+                                               &p_public_key[public_key_header_length],
+                                               public_key_length - public_key_header_length))
+        {
+            break;
+        }
+
+        return_value = PAL_STATUS_FAILURE;
+        if (0 != mbedtls_ecdsa_read_signature(&ecdsa_context,
+                                              p_digest,
+                                              digest_length,
+                                              der_signature,
+                                              der_signature_length))
+        {
+            break;
+        }
+        return_value = PAL_STATUS_SUCCESS;
+    } while (FALSE);
+    mbedtls_ecdsa_free(&ecdsa_context);
+    return return_value;
+}
+
 pal_status_t pal_crypt_version(uint8_t * p_crypt_lib_version_info, uint16_t * length)
 {
     pal_status_t return_value  = PAL_STATUS_FAILURE;    
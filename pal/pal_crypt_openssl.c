@@ -43,6 +43,15 @@
 #include <openssl/hmac.h>
 #include <openssl/opensslv.h>
 #include <openssl/kdf.h>
+#include <openssl/objects.h>
+#include <openssl/x509.h>
+
+/// Maximum length of the ECDSA signature (r and s as DER INTEGERs) for ECC NIST P521
+#define PAL_CRYPT_ECDSA_MAX_SIGNATURE_LENGTH    (0x8A)
+/// Maximum length of the public key (DER BIT STRING with the uncompressed point) for ECC NIST P521
+#define PAL_CRYPT_ECC_MAX_PUBLIC_KEY_LENGTH     (0x89)
+/// Maximum length of the DER AlgorithmIdentifier (id-ecPublicKey and the named curve)
+#define PAL_CRYPT_ECC_MAX_ALGORITHM_LENGTH      (0x20)
 
 #define PAL_CRYPT_MAX_LABEL_SEED_LENGTH     (96U)
 
@@ -105,6 +114,152 @@ pal_status_t pal_crypt_tls_prf_sha256(pal_crypt_t* p_pal_crypt,
     return return_value;
 }
 
+/// Context of a kept CCM key schedule, which depends on the direction, MAC size and nonce length as well
+typedef struct pal_crypt_ccm_key_context
+{
+    EVP_CIPHER_CTX * ctx;
+    uint16_t nonce_length;
+    uint8_t mac_size;
+    int encrypt;
+} pal_crypt_ccm_key_context_t;
+
+/*
+* Provides the cipher context with key, nonce and tag set. Without crypt context, a new cipher context is created.
+* With crypt context, the key schedule is kept for the next call with the same key and only the nonce is set.
+*/
+static EVP_CIPHER_CTX * pal_crypt_ccm_context(pal_crypt_t * p_pal_crypt,
+                                              int encrypt,
+                                              const uint8_t * p_key,
+                                              const uint8_t * p_nonce,
+                                              uint16_t nonce_length,
+                                              uint8_t mac_size,
+                                              uint8_t * p_tag)
+{
+    pal_crypt_ccm_key_context_t * p_key_context = NULL;
+    EVP_CIPHER_CTX * ctx = NULL;
+    const EVP_CIPHER * cipher = EVP_aes_128_ccm();
+    const uint8_t * p_new_key = p_key;
+    uint8_t index = 0;
+    uint8_t is_ready = FALSE;
+
+    do
+    {
+        if (NULL == p_pal_crypt)
+        {
+            ctx = EVP_CIPHER_CTX_new();
+        }
+        else
+        {
+            for (index = 0; index < PAL_CRYPT_AES128_CCM_KEY_CONTEXTS; index++)
+            {
+                p_key_context = (pal_crypt_ccm_key_context_t *)p_pal_crypt->p_ccm_key_context[index];
+                if ((NULL != p_key_context) && (mac_size == p_key_context->mac_size) &&
+                    (nonce_length == p_key_context->nonce_length) && (encrypt == p_key_context->encrypt) &&
+                    (0 == memcmp(p_pal_crypt->ccm_key[index], p_key, PAL_CRYPT_AES128_KEY_LENGTH)))
+                {
+                    // Key schedule is kept, only the nonce and tag are set
+                    cipher = NULL;
+                    p_new_key = NULL;
+                    break;
+                }
+                p_key_context = NULL;
+            }
+            if (NULL == p_key_context)
+            {
+                // Key schedule of a new key replaces the one, which is set up first
+                index = p_pal_crypt->ccm_next_key_context;
+                p_pal_crypt->ccm_next_key_context = (uint8_t)((index + 1) % PAL_CRYPT_AES128_CCM_KEY_CONTEXTS);
+                p_key_context = (pal_crypt_ccm_key_context_t *)p_pal_crypt->p_ccm_key_context[index];
+                if (NULL == p_key_context)
+                {
+                    p_key_context = (pal_crypt_ccm_key_context_t *)pal_os_calloc(1, sizeof(pal_crypt_ccm_key_context_t));
+                    if (NULL == p_key_context)
+                    {
+                        break;
+                    }
+                    p_pal_crypt->p_ccm_key_context[index] = p_key_context;
+                    p_key_context->ctx = EVP_CIPHER_CTX_new();
+                }
+                else
+                {
+                    EVP_CIPHER_CTX_reset(p_key_context->ctx);
+                }
+                // Invalidates the slot, until the key is set
+                p_key_context->mac_size = 0;
+            }
+            ctx = p_key_context->ctx;
+        }
+        if (NULL == ctx)
+        {
+            break;
+        }
+
+        // Set cipher type and mode
+        if (!(EVP_CipherInit_ex(ctx, cipher, NULL, NULL, NULL, encrypt)))
+        {
+            break;
+        }
+        // Setting IV length (nonce length)
+        if (!(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_CCM_SET_IVLEN, nonce_length, NULL)))
+        {
+            break;
+        }
+        // Set tag length and for decryption the expected tag value
+        if (!(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_CCM_SET_TAG, mac_size, p_tag)))
+        {
+            break;
+        }
+        // Initialise key (only if not kept) and IV
+        if (!(EVP_CipherInit_ex(ctx, NULL, NULL, p_new_key, p_nonce, encrypt)))
+        {
+            break;
+        }
+        if ((NULL != p_key_context) && (NULL != p_new_key))
+        {
+            memcpy(p_pal_crypt->ccm_key[index], p_key, PAL_CRYPT_AES128_KEY_LENGTH);
+            p_key_context->nonce_length = nonce_length;
+            p_key_context->mac_size = mac_size;
+            p_key_context->encrypt = encrypt;
+        }
+        is_ready = TRUE;
+    } while (FALSE);
+
+    if (FALSE == is_ready)
+    {
+        if (NULL == p_pal_crypt)
+        {
+            EVP_CIPHER_CTX_free(ctx);
+        }
+        else
+        {
+            //lint --e{534} suppress "Crypt context is not NULL, hence return value is not required to be checked"
+            pal_crypt_release_keys(p_pal_crypt);
+        }
+        ctx = NULL;
+    }
+    return (ctx);
+}
+
+/*
+* Ends the use of the cipher context. A kept key schedule, which failed, is released.
+*/
+static void pal_crypt_ccm_context_done(pal_crypt_t * p_pal_crypt, EVP_CIPHER_CTX * ctx, pal_status_t status)
+{
+    if (NULL == p_pal_crypt)
+    {
+        EVP_CIPHER_CTX_free(ctx);
+    }
+    else if ((NULL != ctx) && (PAL_STATUS_SUCCESS != status))
+    {
+        //lint --e{534} suppress "Crypt context is not NULL, hence return value is not required to be checked"
+        pal_crypt_release_keys(p_pal_crypt);
+    }
+    else
+    {
+        // Key schedule is kept for the next call
+    }
+}
+
 pal_status_t pal_crypt_encrypt_aes128_ccm(pal_crypt_t* p_pal_crypt,
                                           const uint8_t * p_plain_text,
                                           uint16_t plain_text_length,
@@ -119,7 +274,7 @@ pal_status_t pal_crypt_encrypt_aes128_ccm(pal_crypt_t* p_pal_crypt,
     pal_status_t return_status = PAL_STATUS_FAILURE;
     uint8_t mac_output[16];
 
-	EVP_CIPHER_CTX *ctx;
+	EVP_CIPHER_CTX *ctx = NULL;
 	int outlen;
 	int ciphertextlen;
 	
@@ -133,28 +288,8 @@ pal_status_t pal_crypt_encrypt_aes128_ccm(pal_crypt_t* p_pal_crypt,
         }
 #endif
 		
-		if (!(ctx = EVP_CIPHER_CTX_new()))
-        {
-            break;
-        }
-			
-		// Set cipher type and mode
-		if (!(EVP_EncryptInit_ex(ctx, EVP_aes_128_ccm(), NULL, NULL, NULL)))
-        {
-            break;
-        }
-		
-		// Setting IV length (nonce length)	
-		if(!(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_CCM_SET_IVLEN, nonce_length, NULL)))
-        {
-            break;
-        }
-			
-		// Set tag length
-		EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_CCM_SET_TAG, mac_size, NULL);
-
-		// Initialise key and IV 
-		if(!(EVP_EncryptInit_ex(ctx, NULL, NULL, p_encrypt_key, p_nonce)))
+		// Set cipher type and mode, IV length, tag length, key and IV
+		if (!(ctx = pal_crypt_ccm_context(p_pal_crypt, 1, p_encrypt_key, p_nonce, nonce_length, mac_size, NULL)))
         {
             break;
         }
@@ -194,7 +329,7 @@ pal_status_t pal_crypt_encrypt_aes128_ccm(pal_crypt_t* p_pal_crypt,
 	
         return_status = PAL_STATUS_SUCCESS;
     } while (FALSE);
-	EVP_CIPHER_CTX_free(ctx);
+	pal_crypt_ccm_context_done(p_pal_crypt, ctx, return_status);
     return return_status;
 }
 
@@ -210,7 +345,7 @@ pal_status_t pal_crypt_decrypt_aes128_ccm(pal_crypt_t* p_pal_crypt,
                                           uint8_t * p_plain_text)
 {
     pal_status_t return_status = PAL_STATUS_FAILURE;
-	EVP_CIPHER_CTX *ctx;
+	EVP_CIPHER_CTX *ctx = NULL;
 	uint8_t outbuf[1560];
     int outlen;
 
@@ -224,28 +359,9 @@ pal_status_t pal_crypt_decrypt_aes128_ccm(pal_crypt_t* p_pal_crypt,
         }
 #endif
 		
-		if (!(ctx = EVP_CIPHER_CTX_new()))
-		{
-			break;
-		}
-			
-		// Set cipher type and mode
-		if (!(EVP_DecryptInit_ex(ctx, EVP_aes_128_ccm(), NULL, NULL, NULL)))
-		{
-			break;
-		}
-		
-		// Setting IV length (nonce length)	
-		if(!(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_CCM_SET_IVLEN, nonce_length, NULL)))
-		{
-			break;
-		}
-			
-		// Set expected tag value 
-		EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_CCM_SET_TAG, mac_size, (uint8_t *) &p_cipher_text[cipher_text_length - mac_size]);
-
-		// Initialise key and IV 
-		if(!(EVP_DecryptInit_ex(ctx, NULL, NULL, p_decrypt_key, p_nonce)))
+		// Set cipher type and mode, IV length, expected tag value, key and IV
+		if (!(ctx = pal_crypt_ccm_context(p_pal_crypt, 0, p_decrypt_key, p_nonce, nonce_length, mac_size,
+		                                  (uint8_t *) &p_cipher_text[cipher_text_length - mac_size])))
 		{
 			break;
 		}
@@ -271,10 +387,270 @@ pal_status_t pal_crypt_decrypt_aes128_ccm(pal_crypt_t* p_pal_crypt,
 			
         return_status = PAL_STATUS_SUCCESS;
     } while (FALSE);
-	EVP_CIPHER_CTX_free(ctx);    
+	pal_crypt_ccm_context_done(p_pal_crypt, ctx, return_status);
+    return return_status;
+}
+
+pal_status_t pal_crypt_release_keys(pal_crypt_t* p_pal_crypt)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    pal_crypt_ccm_key_context_t * p_key_context;
+    uint8_t index;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == p_pal_crypt)
+        {
+            break;
+        }
+#endif
+        for (index = 0; index < PAL_CRYPT_AES128_CCM_KEY_CONTEXTS; index++)
+        {
+            p_key_context = (pal_crypt_ccm_key_context_t *)p_pal_crypt->p_ccm_key_context[index];
+            if (NULL != p_key_context)
+            {
+                // Frees the key schedule, which is cleansed by OpenSSL
+                EVP_CIPHER_CTX_free(p_key_context->ctx);
+                pal_os_free(p_key_context);
+                p_pal_crypt->p_ccm_key_context[index] = NULL;
+            }
+        }
+        pal_os_memset(p_pal_crypt->ccm_key, 0, sizeof(p_pal_crypt->ccm_key));
+        p_pal_crypt->ccm_next_key_context = 0;
+        return_status = PAL_STATUS_SUCCESS;
+    } while (FALSE);
     return return_status;
 }
 
+pal_status_t pal_crypt_sha256_start(pal_crypt_t* p_pal_crypt,
+                                    uint8_t * p_context,
+                                    uint16_t context_length)
+{
+    pal_status_t return_value = PAL_STATUS_FAILURE;
+    EVP_MD_CTX * md_context = NULL;
+
+    do
+    {
+        // The digest context of the library is referenced from the buffer of the caller between the calls,
+        // it is released by pal_crypt_sha256_finalize or by a failing pal_crypt_sha256_update
+        if (sizeof(md_context) > context_length)
+        {
+            break;
+        }
+        md_context = EVP_MD_CTX_new();
+        if (NULL == md_context)
+        {
+            break;
+        }
+        if (1 != EVP_DigestInit_ex(md_context, EVP_sha256(), NULL))
+        {
+            EVP_MD_CTX_free(md_context);
+            md_context = NULL;
+            break;
+        }
+        return_value = PAL_STATUS_SUCCESS;
+    } while (FALSE);
+    if (sizeof(md_context) <= context_length)
+    {
+        pal_os_memcpy(p_context, &md_context, sizeof(md_context));
+    }
+    return return_value;
+}
+
+pal_status_t pal_crypt_sha256_update(pal_crypt_t* p_pal_crypt,
+                                     uint8_t * p_context,
+                                     uint16_t context_length,
+                                     const uint8_t * p_data,
+                                     uint32_t data_length)
+{
+    pal_status_t return_value = PAL_STATUS_FAILURE;
+    EVP_MD_CTX * md_context = NULL;
+
+    do
+    {
+        if (sizeof(md_context) > context_length)
+        {
+            break;
+        }
+        pal_os_memcpy(&md_context, p_context, sizeof(md_context));
+        if (NULL == md_context)
+        {
+            break;
+        }
+        if (1 != EVP_DigestUpdate(md_context, p_data, data_length))
+        {
+            EVP_MD_CTX_free(md_context);
+            pal_os_memset(p_context, 0x00, sizeof(md_context));
+            break;
+        }
+        return_value = PAL_STATUS_SUCCESS;
+    } while (FALSE);
+    return return_value;
+}
+
+pal_status_t pal_crypt_sha256_finalize(pal_crypt_t* p_pal_crypt,
+                                       uint8_t * p_context,
+                                       uint16_t context_length,
+                                       uint8_t * p_digest)
+{
+    pal_status_t return_value = PAL_STATUS_FAILURE;
+    EVP_MD_CTX * md_context = NULL;
+
+    do
+    {
+        if (sizeof(md_context) > context_length)
+        {
+            break;
+        }
+        pal_os_memcpy(&md_context, p_context, sizeof(md_context));
+        pal_os_memset(p_context, 0x00, sizeof(md_context));
+        if (NULL == md_context)
+        {
+            break;
+        }
+        if (1 != EVP_DigestFinal_ex(md_context, p_digest, NULL))
+        {
+            break;
+        }
+        return_value = PAL_STATUS_SUCCESS;
+    } while (FALSE);
+    EVP_MD_CTX_free(md_context);
+    return return_value;
+}
+
+// Wraps the public key (DER BIT STRING) into a DER SubjectPublicKeyInfo with the named curve
+static EVP_PKEY * pal_crypt_ecc_public_key(int curve_nid,
+                                           const uint8_t * p_public_key,
+                                           uint16_t public_key_length)
+{
+    EVP_PKEY * p_key = NULL;
+    ASN1_OBJECT * p_algorithm_oid = OBJ_nid2obj(NID_X9_62_id_ecPublicKey);
+    ASN1_OBJECT * p_curve_oid = OBJ_nid2obj(curve_nid);
+    uint8_t public_key_info[PAL_CRYPT_ECC_MAX_ALGORITHM_LENGTH + PAL_CRYPT_ECC_MAX_PUBLIC_KEY_LENGTH + 3];
+    uint8_t * p_der_out;
+    const uint8_t * p_der_in;
+    int algorithm_length;
+    uint16_t content_length;
+    uint16_t header_length = 2;
+
+    do
+    {
+        if ((NULL == p_algorithm_oid) || (NULL == p_curve_oid) || (PAL_CRYPT_ECC_MAX_PUBLIC_KEY_LENGTH < public_key_length))
+        {
+            break;
+        }
+        algorithm_length = i2d_ASN1_OBJECT(p_algorithm_oid, NULL) + i2d_ASN1_OBJECT(p_curve_oid, NULL);
+        if ((0 >= algorithm_length) || ((PAL_CRYPT_ECC_MAX_ALGORITHM_LENGTH - 2) < algorithm_length))
+        {
+            break;
+        }
+        content_length = (uint16_t)(2 + algorithm_length + public_key_length);
+        if (0x7F < content_length)
+        {
+            header_length = 3;
+        }
+
+        // SEQUENCE { SEQUENCE { id-ecPublicKey, named curve }, BIT STRING }
+        p_der_out = public_key_info;
+        *p_der_out++ = 0x30;
+        if (3 == header_length)
+        {
+            *p_der_out++ = 0x81;
+        }
+        *p_der_out++ = (uint8_t)content_length;
+        *p_der_out++ = 0x30;
+        *p_der_out++ = (uint8_t)algorithm_length;
+        (void)i2d_ASN1_OBJECT(p_algorithm_oid, &p_der_out);
+        (void)i2d_ASN1_OBJECT(p_curve_oid, &p_der_out);
+        pal_os_memcpy(p_der_out, p_public_key, public_key_length);
+
+        p_der_in = public_key_info;
+        p_key = d2i_PUBKEY(NULL, &p_der_in, (long)(header_length + content_length));
+    } while (FALSE);
+    return p_key;
+}
+
+pal_status_t pal_crypt_ecdsa_verify(pal_crypt_t* p_pal_crypt,
+                                    uint8_t curve_id,
+                                    const uint8_t * p_digest,
+                                    uint16_t digest_length,
+                                    const uint8_t * p_signature,
+                                    uint16_t signature_length,
+                                    const uint8_t * p_public_key,
+                                    uint16_t public_key_length)
+{
+    pal_status_t return_value = PAL_STATUS_INVALID_INPUT;
+    uint8_t der_signature[PAL_CRYPT_ECDSA_MAX_SIGNATURE_LENGTH + 3];
+    uint16_t der_signature_length = 0;
+    uint16_t public_key_header_length;
+    int curve_nid;
+    EVP_PKEY * p_key = NULL;
+    EVP_PKEY_CTX * p_verify_context = NULL;
+
+    do
+    {
+        switch (curve_id)
+        {
+            case PAL_CRYPT_ECC_NIST_P_256: curve_nid = NID_X9_62_prime256v1; break;
+            case PAL_CRYPT_ECC_NIST_P_384: curve_nid = NID_secp384r1; break;
+            case PAL_CRYPT_ECC_NIST_P_521: curve_nid = NID_secp521r1; break;
+            case PAL_CRYPT_ECC_BRAINPOOL_P_256R1: curve_nid = NID_brainpoolP256r1; break;
+            case PAL_CRYPT_ECC_BRAINPOOL_P_384R1: curve_nid = NID_brainpoolP384r1; break;
+            case PAL_CRYPT_ECC_BRAINPOOL_P_512R1: curve_nid = NID_brainpoolP512r1; break;
+            default: curve_nid = NID_undef; break;
+        }
+        if (NID_undef == curve_nid)
+        {
+            break;
+        }
+        // Signature is the content of the DER SEQUENCE, hence the SEQUENCE header is added
+        if (PAL_CRYPT_ECDSA_MAX_SIGNATURE_LENGTH < signature_length)
+        {
+            break;
+        }
+        der_signature[der_signature_length++] = 0x30;
+        if (0x7F < signature_length)
+        {
+            der_signature[der_signature_length++] = 0x81;
+        }
+        der_signature[der_signature_length++] = (uint8_t)signature_length;
+        pal_os_memcpy(&der_signature[der_signature_length], p_signature, signature_length);
+        der_signature_length += signature_length;
+
+        // Public key is a DER BIT STRING (tag, length and unused bits) with the uncompressed point
+        public_key_header_length = 3;
+        if ((public_key_length > 1) && (0x81 == p_public_key[1]))
+        {
+            public_key_header_length = 4;
+        }
+        if ((public_key_length <= public_key_header_length) || (0x03 != p_public_key[0]))
+        {
+            break;
+        }
+        p_key = pal_crypt_ecc_public_key(curve_nid, p_public_key, public_key_length);
+        if (NULL == p_key)
+        {
+            break;
+        }
+
+        return_value = PAL_STATUS_FAILURE;
+        p_verify_context = EVP_PKEY_CTX_new(p_key, NULL);
+        if ((NULL == p_verify_context) || (1 != EVP_PKEY_verify_init(p_verify_context)))
+        {
+            break;
+        }
+        if (1 != EVP_PKEY_verify(p_verify_context, der_signature, der_signature_length, p_digest, digest_length))
+        {
+            break;
+        }
+        return_value = PAL_STATUS_SUCCESS;
+    } while (FALSE);
+    EVP_PKEY_CTX_free(p_verify_context);
+    EVP_PKEY_free(p_key);
+    return return_value;
+}
+
 pal_status_t pal_crypt_version(uint8_t * p_crypt_lib_version_info, uint16_t * length)
 {
     pal_status_t return_value  = PAL_STATUS_FAILURE;    
@@ -37,13 +37,20 @@
 
 #include "optiga/pal/pal_crypt.h"
 #include "optiga/pal/pal_memory_mgmt.h"
+#include "optiga/pal/pal_os_memory.h"
+#include <string.h>
 
 /// @cond hidden
 //lint --e{123,617,537} suppress "Suppress ctype.h in Keil + Warning mpi_class.h is both a module and an include file + Repeated include"
 #include <wolfssl\wolfcrypt\aes.h>
+#include <wolfssl\wolfcrypt\sha256.h>
+#include <wolfssl\wolfcrypt\ecc.h>
 #include <wolfssl\optiga_wolfssl_tls.h>
 /// @endcond
 
+/// Maximum length of the ECDSA signature (r and s as DER INTEGERs) for ECC NIST P521
+#define PAL_CRYPT_ECDSA_MAX_SIGNATURE_LENGTH    (0x8A)
+
 pal_status_t pal_crypt_tls_prf_sha256(pal_crypt_t* p_pal_crypt,
                                       const uint8_t * p_secret,
                                       uint16_t secret_length,
@@ -89,6 +96,64 @@ pal_status_t pal_crypt_tls_prf_sha256(pal_crypt_t* p_pal_crypt,
     return return_value;
 }
 
+/*
+* Provides the AES context with the key schedule of the key. Without crypt context, the local context is set up.
+* With crypt context, the key schedule is kept for the next call with the same key.
+*/
+static Aes * pal_crypt_ccm_context(pal_crypt_t * p_pal_crypt, Aes * p_local_context, const uint8_t * p_key)
+{
+    Aes * p_aes_context = NULL;
+    uint8_t index;
+
+    do
+    {
+        if (NULL == p_pal_crypt)
+        {
+            if (0 == wc_AesCcmSetKey(p_local_context, p_key, PAL_CRYPT_AES128_KEY_LENGTH))
+            {
+                p_aes_context = p_local_context;
+            }
+            break;
+        }
+        for (index = 0; index < PAL_CRYPT_AES128_CCM_KEY_CONTEXTS; index++)
+        {
+            if ((NULL != p_pal_crypt->p_ccm_key_context[index]) &&
+                (0 == memcmp(p_pal_crypt->ccm_key[index], p_key, PAL_CRYPT_AES128_KEY_LENGTH)))
+            {
+                p_aes_context = (Aes * )p_pal_crypt->p_ccm_key_context[index];
+                break;
+            }
+        }
+        if (NULL != p_aes_context)
+        {
+            break;
+        }
+
+        // Key schedule of a new key replaces the one, which is set up first
+        index = p_pal_crypt->ccm_next_key_context;
+        p_pal_crypt->ccm_next_key_context = (uint8_t)((index + 1) % PAL_CRYPT_AES128_CCM_KEY_CONTEXTS);
+        if (NULL == p_pal_crypt->p_ccm_key_context[index])
+        {
+            p_pal_crypt->p_ccm_key_context[index] = pal_os_calloc(1, sizeof(Aes));
+            if (NULL == p_pal_crypt->p_ccm_key_context[index])
+            {
+                break;
+            }
+        }
+        if (0 != wc_AesCcmSetKey((Aes * )p_pal_crypt->p_ccm_key_context[index], p_key, PAL_CRYPT_AES128_KEY_LENGTH))
+        {
+            pal_os_memset(p_pal_crypt->p_ccm_key_context[index], 0, sizeof(Aes));
+            pal_os_free(p_pal_crypt->p_ccm_key_context[index]);
+            p_pal_crypt->p_ccm_key_context[index] = NULL;
+            break;
+        }
+        pal_os_memcpy(p_pal_crypt->ccm_key[index], p_key, PAL_CRYPT_AES128_KEY_LENGTH);
+        p_aes_context = (Aes * )p_pal_crypt->p_ccm_key_context[index];
+    } while (FALSE);
+
+    return (p_aes_context);
+}
+
 pal_status_t pal_crypt_encrypt_aes128_ccm(pal_crypt_t* p_pal_crypt,
                                           const uint8_t * p_plain_text,
                                           uint16_t plain_text_length,
@@ -102,12 +167,9 @@ pal_status_t pal_crypt_encrypt_aes128_ccm(pal_crypt_t* p_pal_crypt,
 {
     pal_status_t return_value = PAL_STATUS_FAILURE;
     Aes encrypt;
+    Aes * p_aes_context;
     uint8_t mac_output[16];
         
-    (void )p_pal_crypt;
-    
-    #define AES128_KEY_SIZE         (16U)
-        
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
@@ -118,11 +180,12 @@ pal_status_t pal_crypt_encrypt_aes128_ccm(pal_crypt_t* p_pal_crypt,
         }
 #endif
 
-        if (0 != wc_AesCcmSetKey(&encrypt, p_encrypt_key, AES128_KEY_SIZE))
+        p_aes_context = pal_crypt_ccm_context(p_pal_crypt, &encrypt, p_encrypt_key);
+        if (NULL == p_aes_context)
         {
             break;
         }
-        if (0 != wc_AesCcmEncrypt(&encrypt,
+        if (0 != wc_AesCcmEncrypt(p_aes_context,
                                   p_cipher_text,
                                   p_plain_text,
                                   plain_text_length,
@@ -140,7 +203,6 @@ pal_status_t pal_crypt_encrypt_aes128_ccm(pal_crypt_t* p_pal_crypt,
         pal_os_memcpy((p_cipher_text + plain_text_length), mac_output, mac_size);
         return_value = PAL_STATUS_SUCCESS;
     } while (FALSE);
-    #undef AES128_KEY_SIZE
     return return_value;
 }
 
@@ -157,10 +219,8 @@ pal_status_t pal_crypt_decrypt_aes128_ccm(pal_crypt_t* p_pal_crypt,
 {
     pal_status_t return_value = PAL_STATUS_FAILURE;
     Aes decrypt;
+    Aes * p_aes_context;
 
-    (void )p_pal_crypt;
-    
-    #define AES128_KEY_SIZE     (16U)
     do
     {
 #ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
@@ -170,13 +230,14 @@ pal_status_t pal_crypt_decrypt_aes128_ccm(pal_crypt_t* p_pal_crypt,
             break;
         }
 #endif
-        if (0 != wc_AesCcmSetKey(&decrypt, p_decrypt_key, AES128_KEY_SIZE))
+        p_aes_context = pal_crypt_ccm_context(p_pal_crypt, &decrypt, p_decrypt_key);
+        if (NULL == p_aes_context)
         {
             break;
         }
 
 
-        if (0 != wc_AesCcmDecrypt(&decrypt,
+        if (0 != wc_AesCcmDecrypt(p_aes_context,
                                   p_plain_text,
                                   p_cipher_text,
                                   (cipher_text_length - mac_size),
@@ -192,7 +253,202 @@ pal_status_t pal_crypt_decrypt_aes128_ccm(pal_crypt_t* p_pal_crypt,
 
         return_value = PAL_STATUS_SUCCESS;
     } while (FALSE);
-    #undef AES128_KEY_SIZE
+    return return_value;
+}
+
+pal_status_t pal_crypt_release_keys(pal_crypt_t* p_pal_crypt)
+{
+    pal_status_t return_value = PAL_STATUS_FAILURE;
+    uint8_t index;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == p_pal_crypt)
+        {
+            break;
+        }
+#endif
+        for (index = 0; index < PAL_CRYPT_AES128_CCM_KEY_CONTEXTS; index++)
+        {
+            if (NULL != p_pal_crypt->p_ccm_key_context[index])
+            {
+                // Key schedule is erased before it is freed
+                pal_os_memset(p_pal_crypt->p_ccm_key_context[index], 0, sizeof(Aes));
+                pal_os_free(p_pal_crypt->p_ccm_key_context[index]);
+                p_pal_crypt->p_ccm_key_context[index] = NULL;
+            }
+        }
+        pal_os_memset(p_pal_crypt->ccm_key, 0, sizeof(p_pal_crypt->ccm_key));
+        p_pal_crypt->ccm_next_key_context = 0;
+        return_value = PAL_STATUS_SUCCESS;
+    } while (FALSE);
+    return return_value;
+}
+
+pal_status_t pal_crypt_sha256_start(pal_crypt_t* p_pal_crypt,
+                                    uint8_t * p_context,
+                                    uint16_t context_length)
+{
+    pal_status_t return_value = PAL_STATUS_FAILURE;
+    wc_Sha256 sha256_context;
+
+    (void )p_pal_crypt;
+
+    do
+    {
+        // State of the library is kept in the buffer of the caller between the calls
+        if (sizeof(sha256_context) > context_length)
+        {
+            break;
+        }
+        if (0 != wc_InitSha256(&sha256_context))
+        {
+            break;
+        }
+        pal_os_memcpy(p_context, &sha256_context, sizeof(sha256_context));
+        return_value = PAL_STATUS_SUCCESS;
+    } while (0);
+    return return_value;
+}
+
+pal_status_t pal_crypt_sha256_update(pal_crypt_t* p_pal_crypt,
+                                     uint8_t * p_context,
+                                     uint16_t context_length,
+                                     const uint8_t * p_data,
+                                     uint32_t data_length)
+{
+    pal_status_t return_value = PAL_STATUS_FAILURE;
+    wc_Sha256 sha256_context;
+
+    (void )p_pal_crypt;
+
+    do
+    {
+        if (sizeof(sha256_context) > context_length)
+        {
+            break;
+        }
+        pal_os_memcpy(&sha256_context, p_context, sizeof(sha256_context));
+        if (0 != wc_Sha256Update(&sha256_context, p_data, data_length))
+        {
+            break;
+        }
+        pal_os_memcpy(p_context, &sha256_context, sizeof(sha256_context));
+        return_value = PAL_STATUS_SUCCESS;
+    } while (0);
+    return return_value;
+}
+
+pal_status_t pal_crypt_sha256_finalize(pal_crypt_t* p_pal_crypt,
+                                       uint8_t * p_context,
+                                       uint16_t context_length,
+                                       uint8_t * p_digest)
+{
+    pal_status_t return_value = PAL_STATUS_FAILURE;
+    wc_Sha256 sha256_context;
+
+    (void )p_pal_crypt;
+
+    do
+    {
+        if (sizeof(sha256_context) > context_length)
+        {
+            break;
+        }
+        pal_os_memcpy(&sha256_context, p_context, sizeof(sha256_context));
+        if (0 != wc_Sha256Final(&sha256_context, p_digest))
+        {
+            break;
+        }
+        wc_Sha256Free(&sha256_context);
+        return_value = PAL_STATUS_SUCCESS;
+    } while (0);
+    return return_value;
+}
+
+pal_status_t pal_crypt_ecdsa_verify(pal_crypt_t* p_pal_crypt,
+                                    uint8_t curve_id,
+                                    const uint8_t * p_digest,
+                                    uint16_t digest_length,
+                                    const uint8_t * p_signature,
+                                    uint16_t signature_length,
+                                    const uint8_t * p_public_key,
+                                    uint16_t public_key_length)
+{
+    pal_status_t return_value = PAL_STATUS_INVALID_INPUT;
+    uint8_t der_signature[PAL_CRYPT_ECDSA_MAX_SIGNATURE_LENGTH + 3];
+    uint16_t der_signature_length = 0;
+    uint16_t public_key_header_length;
+    int ecc_curve_id;
+    int verify_status = 0;
+    ecc_key ecc_public_key;
+
+    (void )p_pal_crypt;
+
+    do
+    {
+        switch (curve_id)
+        {
+            case PAL_CRYPT_ECC_NIST_P_256: ecc_curve_id = ECC_SECP256R1; break;
+            case PAL_CRYPT_ECC_NIST_P_384: ecc_curve_id = ECC_SECP384R1; break;
+            case PAL_CRYPT_ECC_NIST_P_521: ecc_curve_id = ECC_SECP521R1; break;
+            case PAL_CRYPT_ECC_BRAINPOOL_P_256R1: ecc_curve_id = ECC_BRAINPOOLP256R1; break;
+            case PAL_CRYPT_ECC_BRAINPOOL_P_384R1: ecc_curve_id = ECC_BRAINPOOLP384R1; break;
+            case PAL_CRYPT_ECC_BRAINPOOL_P_512R1: ecc_curve_id = ECC_BRAINPOOLP512R1; break;
+            default: ecc_curve_id = ECC_CURVE_INVALID; break;
+        }
+        if (ECC_CURVE_INVALID == ecc_curve_id)
+        {
+            break;
+        }
+        // Signature is the content of the DER SEQUENCE, hence the SEQUENCE header is added
+        if (PAL_CRYPT_ECDSA_MAX_SIGNATURE_LENGTH < signature_length)
+        {
+            break;
+        }
+        der_signature[der_signature_length++] = 0x30;
+        if (0x7F < signature_length)
+        {
+            der_signature[der_signature_length++] = 0x81;
+        }
+        der_signature[der_signature_length++] = (uint8_t)signature_length;
+        pal_os_memcpy(&der_signature[der_signature_length], p_signature, signature_length);
+        der_signature_length += signature_length;
+
+        // Public key is a DER BIT STRING (tag, length and unused bits) with the uncompressed point
+        public_key_header_length = 3;
+        if ((public_key_length > 1) && (0x81 == p_public_key[1]))
+        {
+            public_key_header_length = 4;
+        }
+        if ((public_key_length <= public_key_header_length) || (0x03 != p_public_key[0]))
+        {
+            break;
+        }
+        if (0 != wc_ecc_init(&ecc_public_key))
+        {
+            return_value = PAL_STATUS_FAILURE;
+            break;
+        }
+        if (0 == wc_ecc_import_x963_ex(&p_public_key[public_key_header_length],
+                                       public_key_length - public_key_header_length,
+                                       &ecc_public_key,
+                                       ecc_curve_id))
+        {
+            return_value = PAL_STATUS_FAILURE;
+            if ((0 == wc_ecc_verify_hash(der_signature,
+                                         der_signature_length,
+                                         p_digest,
+                                         digest_length,
+                                         &verify_status,
+                                         &ecc_public_key)) && (1 == verify_status))
+            {
+                return_value = PAL_STATUS_SUCCESS;
+            }
+        }
+        wc_ecc_free(&ecc_public_key);
+    } while (0);
     return return_value;
 }
 
@@ -0,0 +1,266 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_os_datastore_cache.c
+*
+* \brief   This file implements the write-back cache in front of pal_os_datastore_read and pal_os_datastore_write of
+*          the platforms, which skips the writes of unchanged data and coalesces bursts of writes.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include "optiga/pal/pal_os_datastore.h"
+#include "optiga/pal/pal_os_memory.h"
+#include "optiga/pal/pal_os_timer.h"
+
+#ifdef OPTIGA_LIB_DATASTORE_CACHE_ENABLED
+
+/** \brief Cached copy of the data of one datastore id */
+typedef struct pal_os_datastore_cache_entry
+{
+    /// Datastore id of the entry
+    uint16_t datastore_id;
+    /// Length of the cached data
+    uint16_t length;
+    /// Time of the last write to the datastore in milliseconds
+    uint32_t last_write_time_ms;
+    /// Indicates the entry holds the content of the datastore id
+    uint8_t valid;
+    /// Indicates the cached data is not yet written to the datastore
+    uint8_t dirty;
+    /// Cached data
+    uint8_t data[OPTIGA_LIB_DATASTORE_CACHE_ENTRY_SIZE];
+}pal_os_datastore_cache_entry_t;
+
+_STATIC_H pal_os_datastore_cache_entry_t pal_os_datastore_cache[OPTIGA_LIB_DATASTORE_CACHE_ENTRIES];
+_STATIC_H pal_os_datastore_cache_stats_t pal_os_datastore_cache_stats;
+
+/*
+* Returns the entry of the datastore id, else a free entry (with valid set to FALSE) or NULL if all are taken
+*/
+_STATIC_H pal_os_datastore_cache_entry_t * pal_os_datastore_cache_find(uint16_t datastore_id)
+{
+    pal_os_datastore_cache_entry_t * p_free = NULL;
+    uint8_t index;
+
+    for (index = 0; index < OPTIGA_LIB_DATASTORE_CACHE_ENTRIES; index++)
+    {
+        if (FALSE == pal_os_datastore_cache[index].valid)
+        {
+            if (NULL == p_free)
+            {
+                p_free = &pal_os_datastore_cache[index];
+            }
+        }
+        else if (datastore_id == pal_os_datastore_cache[index].datastore_id)
+        {
+            return (&pal_os_datastore_cache[index]);
+        }
+    }
+    return (p_free);
+}
+
+/*
+* Compares the cached data with the data to be written
+*/
+_STATIC_H bool_t pal_os_datastore_cache_is_equal(const pal_os_datastore_cache_entry_t * p_entry,
+                                                 const uint8_t * p_buffer,
+                                                 uint16_t length)
+{
+    uint16_t index;
+
+    if (length != p_entry->length)
+    {
+        return (FALSE);
+    }
+    for (index = 0; index < length; index++)
+    {
+        if (p_buffer[index] != p_entry->data[index])
+        {
+            return (FALSE);
+        }
+    }
+    return (TRUE);
+}
+
+/*
+* Writes the cached data of the entry to the datastore, the entry is dropped if the write fails
+*/
+_STATIC_H pal_status_t pal_os_datastore_cache_write_back(pal_os_datastore_cache_entry_t * p_entry)
+{
+    pal_status_t return_status;
+
+    return_status = pal_os_datastore_write(p_entry->datastore_id, p_entry->data, p_entry->length);
+    pal_os_datastore_cache_stats.nvm_writes++;
+    if (PAL_STATUS_SUCCESS == return_status)
+    {
+        p_entry->dirty = FALSE;
+        p_entry->last_write_time_ms = pal_os_timer_get_time_in_milliseconds();
+    }
+    else
+    {
+        // The content of the datastore is unknown
+        p_entry->valid = FALSE;
+        p_entry->dirty = FALSE;
+    }
+    return (return_status);
+}
+
+pal_status_t pal_os_datastore_cache_write(uint16_t datastore_id,
+                                          const uint8_t * p_buffer,
+                                          uint16_t length)
+{
+    pal_os_datastore_cache_entry_t * p_entry;
+    pal_status_t return_status = PAL_STATUS_SUCCESS;
+
+    do
+    {
+        pal_os_datastore_cache_stats.writes++;
+        p_entry = pal_os_datastore_cache_find(datastore_id);
+        if ((NULL == p_entry) || (OPTIGA_LIB_DATASTORE_CACHE_ENTRY_SIZE < length))
+        {
+            // Not cached, hence written through
+            if (NULL != p_entry)
+            {
+                p_entry->valid = FALSE;
+                p_entry->dirty = FALSE;
+            }
+            return_status = pal_os_datastore_write(datastore_id, p_buffer, length);
+            pal_os_datastore_cache_stats.nvm_writes++;
+            break;
+        }
+        if (TRUE == p_entry->valid)
+        {
+            if (TRUE == pal_os_datastore_cache_is_equal(p_entry, p_buffer, length))
+            {
+                pal_os_datastore_cache_stats.skipped_writes++;
+                break;
+            }
+            pal_os_memcpy(p_entry->data, p_buffer, length);
+            p_entry->length = length;
+#if (0 < OPTIGA_LIB_DATASTORE_CACHE_WINDOW_MS)
+            // Within the window after the last write, the data is held until the next write or flush
+            if ((uint32_t)(pal_os_timer_get_time_in_milliseconds() - p_entry->last_write_time_ms) <
+                OPTIGA_LIB_DATASTORE_CACHE_WINDOW_MS)
+            {
+                if (TRUE == p_entry->dirty)
+                {
+                    pal_os_datastore_cache_stats.coalesced_writes++;
+                }
+                p_entry->dirty = TRUE;
+                break;
+            }
+#endif
+        }
+        else
+        {
+            p_entry->datastore_id = datastore_id;
+            p_entry->length = length;
+            pal_os_memcpy(p_entry->data, p_buffer, length);
+            p_entry->valid = TRUE;
+        }
+        return_status = pal_os_datastore_cache_write_back(p_entry);
+    } while (FALSE);
+
+    return (return_status);
+}
+
+pal_status_t pal_os_datastore_cache_read(uint16_t datastore_id,
+                                         uint8_t * p_buffer,
+                                         uint16_t * p_buffer_length)
+{
+    pal_os_datastore_cache_entry_t * p_entry;
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+
+    do
+    {
+        p_entry = pal_os_datastore_cache_find(datastore_id);
+        if ((NULL != p_entry) && (TRUE == p_entry->valid))
+        {
+            if (*p_buffer_length < p_entry->length)
+            {
+                break;
+            }
+            pal_os_memcpy(p_buffer, p_entry->data, p_entry->length);
+            *p_buffer_length = p_entry->length;
+            return_status = PAL_STATUS_SUCCESS;
+            break;
+        }
+        return_status = pal_os_datastore_read(datastore_id, p_buffer, p_buffer_length);
+        // The content read is cached, hence a later write of the same content is skipped
+        if ((PAL_STATUS_SUCCESS == return_status) && (NULL != p_entry) &&
+            (OPTIGA_LIB_DATASTORE_CACHE_ENTRY_SIZE >= *p_buffer_length))
+        {
+            p_entry->datastore_id = datastore_id;
+            p_entry->length = *p_buffer_length;
+            pal_os_memcpy(p_entry->data, p_buffer, *p_buffer_length);
+            p_entry->last_write_time_ms = pal_os_timer_get_time_in_milliseconds() - OPTIGA_LIB_DATASTORE_CACHE_WINDOW_MS;
+            p_entry->dirty = FALSE;
+            p_entry->valid = TRUE;
+        }
+    } while (FALSE);
+
+    return (return_status);
+}
+
+pal_status_t pal_os_datastore_cache_flush(void)
+{
+    pal_status_t return_status = PAL_STATUS_SUCCESS;
+    uint8_t index;
+
+    for (index = 0; index < OPTIGA_LIB_DATASTORE_CACHE_ENTRIES; index++)
+    {
+        if ((TRUE == pal_os_datastore_cache[index].valid) && (TRUE == pal_os_datastore_cache[index].dirty))
+        {
+            if (PAL_STATUS_SUCCESS != pal_os_datastore_cache_write_back(&pal_os_datastore_cache[index]))
+            {
+                return_status = PAL_STATUS_FAILURE;
+            }
+        }
+    }
+    return (return_status);
+}
+
+void pal_os_datastore_cache_get_stats(pal_os_datastore_cache_stats_t * p_stats)
+{
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+    if (NULL == p_stats)
+    {
+        return;
+    }
+#endif
+    pal_os_memcpy(p_stats, &pal_os_datastore_cache_stats, sizeof(pal_os_datastore_cache_stats_t));
+}
+
+#endif //OPTIGA_LIB_DATASTORE_CACHE_ENABLED
+
+/**
+* @}
+*/
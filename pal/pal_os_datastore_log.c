@@ -0,0 +1,449 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_os_datastore_log.c
+*
+* \brief   This file implements the log-structured flash datastore, which serves pal_os_datastore of the MCU platforms.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include "optiga/common/optiga_lib_common.h"
+#include "optiga/pal/pal_os_datastore.h"
+#include "optiga/pal/pal_os_memory.h"
+
+#ifdef OPTIGA_PAL_DATASTORE_LOG_ENABLED
+
+/// @cond hidden
+
+/// Size rounded up to the program unit of the flash
+#define PAL_OS_DATASTORE_LOG_ALIGN(size)        ((((size) + OPTIGA_PAL_DATASTORE_LOG_PROGRAM_UNIT - 1U) / \
+                                                  OPTIGA_PAL_DATASTORE_LOG_PROGRAM_UNIT) * OPTIGA_PAL_DATASTORE_LOG_PROGRAM_UNIT)
+/// Size of the sector header (magic and sequence number)
+#define PAL_OS_DATASTORE_LOG_SECTOR_HEADER      (0x08U)
+/// Size of the record header (datastore id, length, marker and CRC)
+#define PAL_OS_DATASTORE_LOG_RECORD_HEADER      (0x08U)
+/// Offset of the CRC in the record header, the CRC covers the bytes before it and the data
+#define PAL_OS_DATASTORE_LOG_CRC_OFFSET         (0x06U)
+/// Marker of a record, distinguishes a programmed record header from erased flash
+#define PAL_OS_DATASTORE_LOG_RECORD_MARKER      (0x5AA5U)
+/// Erased datastore id, marks the end of the records in a sector
+#define PAL_OS_DATASTORE_LOG_ERASED_ID          (0xFFFFU)
+/// Size of a record in the flash
+#define PAL_OS_DATASTORE_LOG_RECORD_SIZE(length) PAL_OS_DATASTORE_LOG_ALIGN(PAL_OS_DATASTORE_LOG_RECORD_HEADER + (length))
+/// Offset of the first record of a sector
+#define PAL_OS_DATASTORE_LOG_FIRST_RECORD       PAL_OS_DATASTORE_LOG_ALIGN(PAL_OS_DATASTORE_LOG_SECTOR_HEADER)
+/// Size of the largest record
+#define PAL_OS_DATASTORE_LOG_MAX_RECORD_SIZE    PAL_OS_DATASTORE_LOG_RECORD_SIZE(OPTIGA_PAL_DATASTORE_LOG_MAX_RECORD_LENGTH)
+
+#if (OPTIGA_PAL_DATASTORE_LOG_SECTOR_COUNT < 2U)
+#error "OPTIGA_PAL_DATASTORE_LOG_SECTOR_COUNT must be at least 2"
+#endif
+#if ((PAL_OS_DATASTORE_LOG_FIRST_RECORD + ((OPTIGA_PAL_DATASTORE_LOG_MAX_IDS + 1U) * \
+      PAL_OS_DATASTORE_LOG_MAX_RECORD_SIZE)) > OPTIGA_PAL_DATASTORE_LOG_SECTOR_SIZE)
+#error "OPTIGA_PAL_DATASTORE_LOG_SECTOR_SIZE must hold the latest record of each id and a new record"
+#endif
+
+/** \brief Location of the latest valid record of a datastore id in the active sector */
+typedef struct pal_os_datastore_log_entry
+{
+    /// Datastore id, #PAL_OS_DATASTORE_LOG_ERASED_ID if the entry is free
+    uint16_t datastore_id;
+    /// Offset of the record in the active sector
+    uint16_t offset;
+    /// Length of the data
+    uint16_t length;
+}pal_os_datastore_log_entry_t;
+
+/** \brief State of the datastore log */
+typedef struct pal_os_datastore_log
+{
+    /// RAM index of the records
+    pal_os_datastore_log_entry_t index[OPTIGA_PAL_DATASTORE_LOG_MAX_IDS];
+    /// Sequence number of the active sector
+    uint32_t sequence_number;
+    /// Offset of the next record in the active sector
+    uint16_t write_offset;
+    /// Sector, which holds the latest records
+    uint8_t active_sector;
+    /// Indicates the index is built from the flash
+    uint8_t mounted;
+}pal_os_datastore_log_t;
+
+_STATIC_H pal_os_datastore_log_t pal_os_datastore_log;
+
+/// Record being programmed or copied, padded with the erased value to the program unit
+_STATIC_H uint8_t pal_os_datastore_log_record[PAL_OS_DATASTORE_LOG_MAX_RECORD_SIZE];
+
+/// Magic of a sector, which is in use
+_STATIC_H const uint8_t pal_os_datastore_log_magic[4] = {'O', 'D', 'S', 'L'};
+
+/*
+* Calculates the CRC16 (reflected CCITT polynomial 0x8408) of the data, continued from the given CRC
+*/
+_STATIC_H uint16_t pal_os_datastore_log_crc16(uint16_t crc, const uint8_t * p_data, uint16_t data_length)
+{
+    uint16_t index;
+    uint8_t bit;
+
+    for (index = 0; index < data_length; index++)
+    {
+        crc ^= p_data[index];
+        for (bit = 0; bit < 8U; bit++)
+        {
+            crc = (uint16_t)((0U != (crc & 0x0001U)) ? ((crc >> 1) ^ 0x8408U) : (crc >> 1));
+        }
+    }
+    return (crc);
+}
+
+/*
+* Provides the index entry of the datastore id, a free entry is assigned if allowed
+*/
+_STATIC_H pal_os_datastore_log_entry_t * pal_os_datastore_log_find(uint16_t datastore_id, bool_t assign)
+{
+    pal_os_datastore_log_entry_t * p_free = NULL;
+    uint8_t index;
+
+    for (index = 0; index < OPTIGA_PAL_DATASTORE_LOG_MAX_IDS; index++)
+    {
+        if (datastore_id == pal_os_datastore_log.index[index].datastore_id)
+        {
+            return (&pal_os_datastore_log.index[index]);
+        }
+        if ((NULL == p_free) && (PAL_OS_DATASTORE_LOG_ERASED_ID == pal_os_datastore_log.index[index].datastore_id))
+        {
+            p_free = &pal_os_datastore_log.index[index];
+        }
+    }
+    if ((TRUE == assign) && (NULL != p_free))
+    {
+        p_free->datastore_id = datastore_id;
+    }
+    return ((TRUE == assign) ? p_free : NULL);
+}
+
+/*
+* Reads the record at the offset into the record buffer and checks it, returns the length of its data.
+* The record is skipped (size only) if its CRC fails, the scan is stopped (0xFFFF) at the end of the records.
+*/
+_STATIC_H uint16_t pal_os_datastore_log_read_record(uint8_t sector, uint16_t offset, bool_t * p_is_valid)
+{
+    uint8_t * p_record = pal_os_datastore_log_record;
+    uint16_t length;
+    uint16_t crc;
+
+    *p_is_valid = FALSE;
+    if ((offset + PAL_OS_DATASTORE_LOG_RECORD_HEADER > OPTIGA_PAL_DATASTORE_LOG_SECTOR_SIZE) ||
+        (PAL_STATUS_SUCCESS != pal_os_datastore_flash_read(sector, offset, p_record, PAL_OS_DATASTORE_LOG_RECORD_HEADER)))
+    {
+        return (0xFFFFU);
+    }
+    length = (uint16_t)((p_record[2] << 8) | p_record[3]);
+    if (PAL_OS_DATASTORE_LOG_ERASED_ID == (uint16_t)((p_record[0] << 8) | p_record[1]))
+    {
+        return (0xFFFFU);
+    }
+    // A header, which is torn beyond its length, ends the scan
+    if ((OPTIGA_PAL_DATASTORE_LOG_MAX_RECORD_LENGTH < length) ||
+        (PAL_OS_DATASTORE_LOG_RECORD_MARKER != (uint16_t)((p_record[4] << 8) | p_record[5])) ||
+        (offset + PAL_OS_DATASTORE_LOG_RECORD_SIZE(length) > OPTIGA_PAL_DATASTORE_LOG_SECTOR_SIZE) ||
+        (PAL_STATUS_SUCCESS != pal_os_datastore_flash_read(sector,
+                                                            (uint16_t)(offset + PAL_OS_DATASTORE_LOG_RECORD_HEADER),
+                                                            &p_record[PAL_OS_DATASTORE_LOG_RECORD_HEADER],
+                                                            length)))
+    {
+        return (0xFFFFU);
+    }
+    crc = pal_os_datastore_log_crc16(0, p_record, PAL_OS_DATASTORE_LOG_CRC_OFFSET);
+    crc = pal_os_datastore_log_crc16(crc, &p_record[PAL_OS_DATASTORE_LOG_RECORD_HEADER], length);
+    *p_is_valid = (crc == (uint16_t)((p_record[6] << 8) | p_record[7])) ? TRUE : FALSE;
+    return (length);
+}
+
+/*
+* Programs the sector header, which makes the sector the active one
+*/
+_STATIC_H pal_status_t pal_os_datastore_log_commit_sector(uint8_t sector, uint32_t sequence_number)
+{
+    uint8_t * p_header = pal_os_datastore_log_record;
+
+    pal_os_memset(p_header, 0xFF, PAL_OS_DATASTORE_LOG_FIRST_RECORD);
+    pal_os_memcpy(p_header, pal_os_datastore_log_magic, sizeof(pal_os_datastore_log_magic));
+    optiga_common_set_uint32(&p_header[4], sequence_number);
+    return (pal_os_datastore_flash_program(sector, 0, p_header, PAL_OS_DATASTORE_LOG_FIRST_RECORD));
+}
+
+/*
+* Selects the sector with the highest sequence number and builds the index from its records
+*/
+_STATIC_H pal_status_t pal_os_datastore_log_mount(void)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    pal_os_datastore_log_entry_t * p_entry;
+    uint8_t header[PAL_OS_DATASTORE_LOG_SECTOR_HEADER];
+    uint32_t sequence_number;
+    bool_t is_found = FALSE;
+    bool_t is_valid;
+    uint16_t length;
+    uint16_t offset;
+    uint8_t sector;
+
+    do
+    {
+        for (sector = 0; sector < OPTIGA_PAL_DATASTORE_LOG_SECTOR_COUNT; sector++)
+        {
+            if ((PAL_STATUS_SUCCESS == pal_os_datastore_flash_read(sector, 0, header, sizeof(header))) &&
+                (pal_os_datastore_log_magic[0] == header[0]) && (pal_os_datastore_log_magic[1] == header[1]) &&
+                (pal_os_datastore_log_magic[2] == header[2]) && (pal_os_datastore_log_magic[3] == header[3]))
+            {
+                sequence_number = optiga_common_get_uint32(&header[4]);
+                if ((FALSE == is_found) || (sequence_number > pal_os_datastore_log.sequence_number))
+                {
+                    pal_os_datastore_log.sequence_number = sequence_number;
+                    pal_os_datastore_log.active_sector = sector;
+                    is_found = TRUE;
+                }
+            }
+        }
+        for (offset = 0; offset < OPTIGA_PAL_DATASTORE_LOG_MAX_IDS; offset++)
+        {
+            pal_os_datastore_log.index[offset].datastore_id = PAL_OS_DATASTORE_LOG_ERASED_ID;
+        }
+        if (FALSE == is_found)
+        {
+            // The flash area is used for the first time
+            pal_os_datastore_log.active_sector = 0;
+            pal_os_datastore_log.sequence_number = 1;
+            if ((PAL_STATUS_SUCCESS != pal_os_datastore_flash_erase(0)) ||
+                (PAL_STATUS_SUCCESS != pal_os_datastore_log_commit_sector(0, 1)))
+            {
+                break;
+            }
+        }
+
+        offset = PAL_OS_DATASTORE_LOG_FIRST_RECORD;
+        for (;;)
+        {
+            length = pal_os_datastore_log_read_record(pal_os_datastore_log.active_sector, offset, &is_valid);
+            if (0xFFFFU == length)
+            {
+                break;
+            }
+            if (TRUE == is_valid)
+            {
+                p_entry = pal_os_datastore_log_find((uint16_t)((pal_os_datastore_log_record[0] << 8) |
+                                                               pal_os_datastore_log_record[1]), TRUE);
+                if (NULL != p_entry)
+                {
+                    p_entry->offset = offset;
+                    p_entry->length = length;
+                }
+            }
+            offset += (uint16_t)PAL_OS_DATASTORE_LOG_RECORD_SIZE(length);
+        }
+        // Unless the records end with erased flash, the next write continues in a fresh sector
+        if ((offset + PAL_OS_DATASTORE_LOG_RECORD_HEADER <= OPTIGA_PAL_DATASTORE_LOG_SECTOR_SIZE) &&
+            (PAL_OS_DATASTORE_LOG_ERASED_ID != (uint16_t)((pal_os_datastore_log_record[0] << 8) |
+                                                          pal_os_datastore_log_record[1])))
+        {
+            offset = OPTIGA_PAL_DATASTORE_LOG_SECTOR_SIZE;
+        }
+        pal_os_datastore_log.write_offset = offset;
+        pal_os_datastore_log.mounted = TRUE;
+        return_status = PAL_STATUS_SUCCESS;
+    } while (FALSE);
+    return (return_status);
+}
+
+/*
+* Copies the latest records to the next sector, which becomes the active one once its header is programmed.
+* Until then, the active sector stays valid, hence a power loss during the copy loses no record.
+*/
+_STATIC_H pal_status_t pal_os_datastore_log_compact(void)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    uint16_t new_offset[OPTIGA_PAL_DATASTORE_LOG_MAX_IDS];
+    pal_os_datastore_log_entry_t * p_entry;
+    uint8_t sector = (uint8_t)((pal_os_datastore_log.active_sector + 1U) % OPTIGA_PAL_DATASTORE_LOG_SECTOR_COUNT);
+    uint16_t offset = PAL_OS_DATASTORE_LOG_FIRST_RECORD;
+    uint16_t record_size;
+    bool_t is_valid;
+    uint8_t index;
+
+    do
+    {
+        if (PAL_STATUS_SUCCESS != pal_os_datastore_flash_erase(sector))
+        {
+            break;
+        }
+        for (index = 0; index < OPTIGA_PAL_DATASTORE_LOG_MAX_IDS; index++)
+        {
+            p_entry = &pal_os_datastore_log.index[index];
+            if (PAL_OS_DATASTORE_LOG_ERASED_ID == p_entry->datastore_id)
+            {
+                continue;
+            }
+            record_size = (uint16_t)PAL_OS_DATASTORE_LOG_RECORD_SIZE(p_entry->length);
+            (void)pal_os_datastore_log_read_record(pal_os_datastore_log.active_sector, p_entry->offset, &is_valid);
+            pal_os_memset(&pal_os_datastore_log_record[PAL_OS_DATASTORE_LOG_RECORD_HEADER + p_entry->length], 0xFF,
+                          record_size - (PAL_OS_DATASTORE_LOG_RECORD_HEADER + p_entry->length));
+            if ((TRUE != is_valid) ||
+                (PAL_STATUS_SUCCESS != pal_os_datastore_flash_program(sector, offset, pal_os_datastore_log_record,
+                                                                      record_size)))
+            {
+                break;
+            }
+            new_offset[index] = offset;
+            offset += record_size;
+        }
+        if ((OPTIGA_PAL_DATASTORE_LOG_MAX_IDS != index) ||
+            (PAL_STATUS_SUCCESS != pal_os_datastore_log_commit_sector(sector,
+                                                                      pal_os_datastore_log.sequence_number + 1U)))
+        {
+            break;
+        }
+        for (index = 0; index < OPTIGA_PAL_DATASTORE_LOG_MAX_IDS; index++)
+        {
+            if (PAL_OS_DATASTORE_LOG_ERASED_ID != pal_os_datastore_log.index[index].datastore_id)
+            {
+                pal_os_datastore_log.index[index].offset = new_offset[index];
+            }
+        }
+        pal_os_datastore_log.active_sector = sector;
+        pal_os_datastore_log.sequence_number++;
+        pal_os_datastore_log.write_offset = offset;
+        return_status = PAL_STATUS_SUCCESS;
+    } while (FALSE);
+    return (return_status);
+}
+
+/// @endcond
+
+pal_status_t pal_os_datastore_log_read(uint16_t datastore_id,
+                                       uint8_t * p_buffer,
+                                       uint16_t * p_buffer_length)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    pal_os_datastore_log_entry_t * p_entry;
+
+    do
+    {
+        if ((FALSE == pal_os_datastore_log.mounted) && (PAL_STATUS_SUCCESS != pal_os_datastore_log_mount()))
+        {
+            break;
+        }
+        p_entry = pal_os_datastore_log_find(datastore_id, FALSE);
+        if ((NULL == p_entry) || (p_entry->length > *p_buffer_length))
+        {
+            break;
+        }
+        return_status = pal_os_datastore_flash_read(pal_os_datastore_log.active_sector,
+                                                    (uint16_t)(p_entry->offset + PAL_OS_DATASTORE_LOG_RECORD_HEADER),
+                                                    p_buffer,
+                                                    p_entry->length);
+        if (PAL_STATUS_SUCCESS == return_status)
+        {
+            *p_buffer_length = p_entry->length;
+        }
+    } while (FALSE);
+    return (return_status);
+}
+
+pal_status_t pal_os_datastore_log_write(uint16_t datastore_id,
+                                        const uint8_t * p_buffer,
+                                        uint16_t length)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    pal_os_datastore_log_entry_t * p_entry;
+    uint8_t * p_record = pal_os_datastore_log_record;
+    uint16_t record_size = (uint16_t)PAL_OS_DATASTORE_LOG_RECORD_SIZE(length);
+    uint16_t crc;
+
+    do
+    {
+        if ((OPTIGA_PAL_DATASTORE_LOG_MAX_RECORD_LENGTH < length) || (PAL_OS_DATASTORE_LOG_ERASED_ID == datastore_id))
+        {
+            break;
+        }
+        if ((FALSE == pal_os_datastore_log.mounted) && (PAL_STATUS_SUCCESS != pal_os_datastore_log_mount()))
+        {
+            break;
+        }
+        if ((NULL == pal_os_datastore_log_find(datastore_id, FALSE)) &&
+            (NULL == pal_os_datastore_log_find(PAL_OS_DATASTORE_LOG_ERASED_ID, FALSE)))
+        {
+            // The index is full
+            break;
+        }
+        // The sector is erased only once it is full, hence each sector is erased once per cycle through all of them
+        if (((uint32_t)pal_os_datastore_log.write_offset + record_size > OPTIGA_PAL_DATASTORE_LOG_SECTOR_SIZE) &&
+            (PAL_STATUS_SUCCESS != pal_os_datastore_log_compact()))
+        {
+            break;
+        }
+
+        p_record[0] = (uint8_t)(datastore_id >> 8);
+        p_record[1] = (uint8_t)(datastore_id);
+        p_record[2] = (uint8_t)(length >> 8);
+        p_record[3] = (uint8_t)(length);
+        p_record[4] = (uint8_t)(PAL_OS_DATASTORE_LOG_RECORD_MARKER >> 8);
+        p_record[5] = (uint8_t)(PAL_OS_DATASTORE_LOG_RECORD_MARKER);
+        pal_os_memcpy(&p_record[PAL_OS_DATASTORE_LOG_RECORD_HEADER], p_buffer, length);
+        pal_os_memset(&p_record[PAL_OS_DATASTORE_LOG_RECORD_HEADER + length], 0xFF,
+                      record_size - (PAL_OS_DATASTORE_LOG_RECORD_HEADER + length));
+        crc = pal_os_datastore_log_crc16(0, p_record, PAL_OS_DATASTORE_LOG_CRC_OFFSET);
+        crc = pal_os_datastore_log_crc16(crc, p_buffer, length);
+        p_record[6] = (uint8_t)(crc >> 8);
+        p_record[7] = (uint8_t)(crc);
+
+        return_status = pal_os_datastore_flash_program(pal_os_datastore_log.active_sector,
+                                                       pal_os_datastore_log.write_offset,
+                                                       p_record,
+                                                       record_size);
+        if (PAL_STATUS_SUCCESS != return_status)
+        {
+            // The partially programmed record is not followed by others, the next write continues in a fresh sector
+            pal_os_datastore_log.write_offset = OPTIGA_PAL_DATASTORE_LOG_SECTOR_SIZE;
+            break;
+        }
+        p_entry = pal_os_datastore_log_find(datastore_id, TRUE);
+        p_entry->offset = pal_os_datastore_log.write_offset;
+        p_entry->length = length;
+        pal_os_datastore_log.write_offset += record_size;
+    } while (FALSE);
+    return (return_status);
+}
+
+#endif //OPTIGA_PAL_DATASTORE_LOG_ENABLED
+
+/**
+* @}
+*/
@@ -0,0 +1,264 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_os_event_queue.c
+*
+* \brief   This file implements the event queue, which multiplexes several events onto the os event of the platform.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include "optiga/pal/pal_os_event.h"
+#include "optiga/pal/pal_os_timer.h"
+#include "optiga/pal/pal_os_lock.h"
+
+#ifdef OPTIGA_LIB_EVENT_QUEUE_ENABLED
+
+/// Minimum delay of the os event of the platform, some platforms disarm the timer for a delay of 0
+#define PAL_OS_EVENT_QUEUE_MIN_DELAY_US     (1U)
+
+/// Deadline a is before deadline b, independent of the overflow of the time
+#define PAL_OS_EVENT_QUEUE_IS_BEFORE(a, b)  (0 > (int32_t)((uint32_t)(a) - (uint32_t)(b)))
+
+/** \brief Event of the queue */
+typedef struct pal_os_event_queue_slot
+{
+    /// Event provided to the owner, must be the first member
+    pal_os_event_t event;
+    /// Time of the registered callback in microseconds
+    uint32_t deadline_us;
+    /// Indicates the registered callback is pending
+    uint8_t pending;
+    /// Indicates the slot is owned
+    uint8_t in_use;
+}pal_os_event_queue_slot_t;
+
+/** \brief Event queue */
+typedef struct pal_os_event_queue
+{
+    /// Events of the queue
+    pal_os_event_queue_slot_t slots[OPTIGA_LIB_EVENT_QUEUE_SIZE];
+    /// Os event of the platform, which is registered for the earliest deadline
+    pal_os_event_t * p_platform_event;
+    /// Deadline, for which the os event of the platform is registered
+    uint32_t armed_deadline_us;
+    /// Indicates the os event of the platform is registered
+    uint8_t armed;
+    /// Indicates the due callbacks are being invoked
+    uint8_t dispatching;
+}pal_os_event_queue_t;
+
+_STATIC_H pal_os_event_queue_t pal_os_event_queue;
+
+_STATIC_H void pal_os_event_queue_dispatch(void * p_args);
+
+/*
+* Registers the os event of the platform for the earliest pending deadline, invoked in the critical section.
+* While the callbacks are invoked, this is done once at the end of the dispatch.
+*/
+_STATIC_H void pal_os_event_queue_arm(void)
+{
+    pal_os_event_queue_slot_t * p_earliest = NULL;
+    uint32_t now_us;
+    uint32_t delay_us = PAL_OS_EVENT_QUEUE_MIN_DELAY_US;
+    uint8_t index;
+
+    do
+    {
+        if (TRUE == pal_os_event_queue.dispatching)
+        {
+            break;
+        }
+        for (index = 0; index < OPTIGA_LIB_EVENT_QUEUE_SIZE; index++)
+        {
+            if ((TRUE == pal_os_event_queue.slots[index].pending) &&
+                ((NULL == p_earliest) ||
+                 PAL_OS_EVENT_QUEUE_IS_BEFORE(pal_os_event_queue.slots[index].deadline_us, p_earliest->deadline_us)))
+            {
+                p_earliest = &pal_os_event_queue.slots[index];
+            }
+        }
+        // An already registered os event, which is not needed anymore, finds no due callback
+        if (NULL == p_earliest)
+        {
+            break;
+        }
+        if ((TRUE == pal_os_event_queue.armed) && (p_earliest->deadline_us == pal_os_event_queue.armed_deadline_us))
+        {
+            break;
+        }
+        now_us = pal_os_timer_get_time_in_microseconds();
+        if (PAL_OS_EVENT_QUEUE_IS_BEFORE(now_us + PAL_OS_EVENT_QUEUE_MIN_DELAY_US, p_earliest->deadline_us))
+        {
+            delay_us = p_earliest->deadline_us - now_us;
+        }
+        pal_os_event_queue.armed = TRUE;
+        pal_os_event_queue.armed_deadline_us = p_earliest->deadline_us;
+        pal_os_event_register_callback_oneshot(pal_os_event_queue.p_platform_event,
+                                               pal_os_event_queue_dispatch,
+                                               &pal_os_event_queue,
+                                               delay_us);
+    } while (FALSE);
+}
+
+/*
+* Invokes the due callbacks in the order of their deadlines, from the context of the os event of the platform
+*/
+//lint --e{715} suppress "p_args is not used, the queue is a singleton"
+_STATIC_H void pal_os_event_queue_dispatch(void * p_args)
+{
+    pal_os_event_queue_slot_t * p_due;
+    register_callback callback;
+    void * callback_ctx;
+    uint32_t now_us;
+    uint8_t index;
+
+    pal_os_lock_enter_critical_section();
+    pal_os_event_queue.armed = FALSE;
+    pal_os_event_queue.dispatching = TRUE;
+    do
+    {
+        p_due = NULL;
+        now_us = pal_os_timer_get_time_in_microseconds();
+        for (index = 0; index < OPTIGA_LIB_EVENT_QUEUE_SIZE; index++)
+        {
+            if ((TRUE == pal_os_event_queue.slots[index].pending) &&
+                !PAL_OS_EVENT_QUEUE_IS_BEFORE(now_us, pal_os_event_queue.slots[index].deadline_us) &&
+                ((NULL == p_due) ||
+                 PAL_OS_EVENT_QUEUE_IS_BEFORE(pal_os_event_queue.slots[index].deadline_us, p_due->deadline_us)))
+            {
+                p_due = &pal_os_event_queue.slots[index];
+            }
+        }
+        if (NULL == p_due)
+        {
+            break;
+        }
+        p_due->pending = FALSE;
+        callback = p_due->event.callback_registered;
+        callback_ctx = p_due->event.callback_ctx;
+        // The callback registers the next callbacks, hence it is invoked outside the critical section
+        pal_os_lock_exit_critical_section();
+        if (NULL != callback)
+        {
+            callback(callback_ctx);
+        }
+        pal_os_lock_enter_critical_section();
+    } while (TRUE);
+    pal_os_event_queue.dispatching = FALSE;
+    pal_os_event_queue_arm();
+    pal_os_lock_exit_critical_section();
+}
+
+pal_os_event_t * pal_os_event_queue_create(register_callback callback, void * callback_args)
+{
+    pal_os_event_queue_slot_t * p_slot = NULL;
+    uint8_t index;
+
+    pal_os_lock_enter_critical_section();
+    if (NULL == pal_os_event_queue.p_platform_event)
+    {
+        // The first dispatch finds no due callback
+        pal_os_event_queue.p_platform_event = pal_os_event_create(pal_os_event_queue_dispatch, &pal_os_event_queue);
+    }
+    for (index = 0; index < OPTIGA_LIB_EVENT_QUEUE_SIZE; index++)
+    {
+        if (FALSE == pal_os_event_queue.slots[index].in_use)
+        {
+            p_slot = &pal_os_event_queue.slots[index];
+            p_slot->in_use = TRUE;
+            p_slot->pending = FALSE;
+            p_slot->event.is_event_triggered = FALSE;
+            p_slot->event.callback_registered = NULL;
+            p_slot->event.callback_ctx = NULL;
+            p_slot->event.os_timer = NULL;
+            break;
+        }
+    }
+    pal_os_lock_exit_critical_section();
+
+    if ((NULL != p_slot) && (NULL != callback) && (NULL != callback_args))
+    {
+        pal_os_event_queue_start(&p_slot->event, callback, callback_args);
+    }
+    return ((NULL != p_slot) ? &p_slot->event : NULL);
+}
+
+void pal_os_event_queue_destroy(pal_os_event_t * p_pal_os_event)
+{
+    pal_os_event_queue_slot_t * p_slot = (pal_os_event_queue_slot_t *)p_pal_os_event;
+
+    pal_os_lock_enter_critical_section();
+    p_slot->pending = FALSE;
+    p_slot->in_use = FALSE;
+    p_slot->event.callback_registered = NULL;
+    pal_os_lock_exit_critical_section();
+}
+
+void pal_os_event_queue_register_callback_oneshot(pal_os_event_t * p_pal_os_event,
+                                                  register_callback callback,
+                                                  void * callback_args,
+                                                  uint32_t time_us)
+{
+    pal_os_event_queue_slot_t * p_slot = (pal_os_event_queue_slot_t *)p_pal_os_event;
+
+    pal_os_lock_enter_critical_section();
+    p_slot->event.callback_registered = callback;
+    p_slot->event.callback_ctx = callback_args;
+    p_slot->deadline_us = pal_os_timer_get_time_in_microseconds() + time_us;
+    p_slot->pending = TRUE;
+    pal_os_event_queue_arm();
+    pal_os_lock_exit_critical_section();
+}
+
+void pal_os_event_queue_start(pal_os_event_t * p_pal_os_event, register_callback callback, void * callback_args)
+{
+    if (FALSE == p_pal_os_event->is_event_triggered)
+    {
+        p_pal_os_event->is_event_triggered = TRUE;
+        pal_os_event_queue_register_callback_oneshot(p_pal_os_event, callback, callback_args, 1000);
+    }
+}
+
+void pal_os_event_queue_stop(pal_os_event_t * p_pal_os_event)
+{
+    pal_os_event_queue_slot_t * p_slot = (pal_os_event_queue_slot_t *)p_pal_os_event;
+
+    pal_os_lock_enter_critical_section();
+    p_pal_os_event->is_event_triggered = FALSE;
+    p_slot->pending = FALSE;
+    pal_os_lock_exit_critical_section();
+}
+
+#endif //OPTIGA_LIB_EVENT_QUEUE_ENABLED
+
+/**
+* @}
+*/
@@ -0,0 +1,216 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_os_memory_pool.c
+*
+* \brief   This file implements the fixed block memory pool, which serves pal_os_malloc and pal_os_calloc of the platforms.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include "optiga/pal/pal_os_memory.h"
+#include "optiga/pal/pal_os_lock.h"
+
+#ifdef OPTIGA_LIB_MEMORY_POOL_ENABLED
+
+/// Block size rounded up to the alignment of the blocks
+#define PAL_OS_MEMORY_POOL_ALIGNED_SIZE(size)   (((size) + sizeof(pal_os_memory_pool_block_t) - 1) / \
+                                                 sizeof(pal_os_memory_pool_block_t))
+
+/** \brief Unit of the pool storage, aligned for any of the instances and linking the free blocks */
+typedef union pal_os_memory_pool_block
+{
+    /// Next free block, valid only while the block is free
+    union pal_os_memory_pool_block * p_next;
+    /// Alignment of 64 bit members
+    uint64_t alignment;
+}pal_os_memory_pool_block_t;
+
+/** \brief Size class of the pool */
+typedef struct pal_os_memory_pool
+{
+    /// First block of the storage
+    pal_os_memory_pool_block_t * p_start;
+    /// End of the storage
+    pal_os_memory_pool_block_t * p_end;
+    /// Head of the free list
+    pal_os_memory_pool_block_t * p_free;
+    /// Usage of the size class
+    pal_os_memory_pool_stats_t stats;
+    /// Indicates the free list is linked
+    uint8_t initialized;
+}pal_os_memory_pool_t;
+
+_STATIC_H pal_os_memory_pool_block_t pal_os_memory_pool_small_storage
+    [OPTIGA_LIB_MEMORY_POOL_SMALL_BLOCK_COUNT * PAL_OS_MEMORY_POOL_ALIGNED_SIZE(OPTIGA_LIB_MEMORY_POOL_SMALL_BLOCK_SIZE)];
+_STATIC_H pal_os_memory_pool_block_t pal_os_memory_pool_large_storage
+    [OPTIGA_LIB_MEMORY_POOL_LARGE_BLOCK_COUNT * PAL_OS_MEMORY_POOL_ALIGNED_SIZE(OPTIGA_LIB_MEMORY_POOL_LARGE_BLOCK_SIZE)];
+
+_STATIC_H pal_os_memory_pool_t pal_os_memory_pool[PAL_OS_MEMORY_POOL_COUNT] =
+{
+    {
+        pal_os_memory_pool_small_storage,
+        pal_os_memory_pool_small_storage + (sizeof(pal_os_memory_pool_small_storage) /
+                                            sizeof(pal_os_memory_pool_block_t)),
+        NULL,
+        {OPTIGA_LIB_MEMORY_POOL_SMALL_BLOCK_SIZE, OPTIGA_LIB_MEMORY_POOL_SMALL_BLOCK_COUNT, 0, 0, 0},
+        FALSE
+    },
+    {
+        pal_os_memory_pool_large_storage,
+        pal_os_memory_pool_large_storage + (sizeof(pal_os_memory_pool_large_storage) /
+                                            sizeof(pal_os_memory_pool_block_t)),
+        NULL,
+        {OPTIGA_LIB_MEMORY_POOL_LARGE_BLOCK_SIZE, OPTIGA_LIB_MEMORY_POOL_LARGE_BLOCK_COUNT, 0, 0, 0},
+        FALSE
+    }
+};
+
+/*
+* Links the blocks of the size class into the free list, on the first allocation
+*/
+_STATIC_H void pal_os_memory_pool_link(pal_os_memory_pool_t * p_pool)
+{
+    pal_os_memory_pool_block_t * p_block = p_pool->p_start;
+    uint16_t block_units = (uint16_t)PAL_OS_MEMORY_POOL_ALIGNED_SIZE(p_pool->stats.block_size);
+    uint16_t index;
+
+    p_pool->p_free = NULL;
+    for (index = 0; index < p_pool->stats.block_count; index++)
+    {
+        p_block->p_next = p_pool->p_free;
+        p_pool->p_free = p_block;
+        p_block += block_units;
+    }
+    p_pool->initialized = TRUE;
+}
+
+void * pal_os_memory_pool_alloc(uint32_t block_size)
+{
+    pal_os_memory_pool_t * p_pool;
+    pal_os_memory_pool_block_t * p_block = NULL;
+    uint8_t index;
+    uint8_t size_class = PAL_OS_MEMORY_POOL_COUNT;
+
+    pal_os_lock_enter_critical_section();
+    for (index = 0; index < PAL_OS_MEMORY_POOL_COUNT; index++)
+    {
+        p_pool = &pal_os_memory_pool[index];
+        if ((0 == block_size) || (block_size > p_pool->stats.block_size))
+        {
+            continue;
+        }
+        if (PAL_OS_MEMORY_POOL_COUNT == size_class)
+        {
+            size_class = index;
+        }
+        if (FALSE == p_pool->initialized)
+        {
+            pal_os_memory_pool_link(p_pool);
+        }
+        // An exhausted size class borrows from the larger one
+        if (NULL != p_pool->p_free)
+        {
+            p_block = p_pool->p_free;
+            p_pool->p_free = p_block->p_next;
+            p_pool->stats.blocks_in_use++;
+            if (p_pool->stats.blocks_in_use > p_pool->stats.high_water_mark)
+            {
+                p_pool->stats.high_water_mark = p_pool->stats.blocks_in_use;
+            }
+            break;
+        }
+    }
+    if ((NULL == p_block) && (0 != block_size))
+    {
+        // Oversized requests are accounted to the large size class
+        pal_os_memory_pool[(PAL_OS_MEMORY_POOL_COUNT == size_class) ? PAL_OS_MEMORY_POOL_LARGE :
+                                                                     size_class].stats.fallback_count++;
+    }
+    pal_os_lock_exit_critical_section();
+
+    return ((void *)p_block);
+}
+
+bool_t pal_os_memory_pool_free(void * p_block)
+{
+    pal_os_memory_pool_t * p_pool;
+    pal_os_memory_pool_block_t * p_pool_block = (pal_os_memory_pool_block_t *)p_block;
+    bool_t freed = FALSE;
+    uint8_t index;
+
+    pal_os_lock_enter_critical_section();
+    for (index = 0; index < PAL_OS_MEMORY_POOL_COUNT; index++)
+    {
+        p_pool = &pal_os_memory_pool[index];
+        if ((p_pool_block >= p_pool->p_start) && (p_pool_block < p_pool->p_end))
+        {
+            p_pool_block->p_next = p_pool->p_free;
+            p_pool->p_free = p_pool_block;
+            p_pool->stats.blocks_in_use--;
+            freed = TRUE;
+            break;
+        }
+    }
+    pal_os_lock_exit_critical_section();
+
+    return (freed);
+}
+
+pal_status_t pal_os_memory_get_pool_stats(uint8_t size_class, pal_os_memory_pool_stats_t * p_stats)
+{
+    pal_status_t return_status = PAL_STATUS_INVALID_INPUT;
+
+    do
+    {
+#ifdef OPTIGA_LIB_DEBUG_NULL_CHECK
+        if (NULL == p_stats)
+        {
+            break;
+        }
+#endif
+        if (PAL_OS_MEMORY_POOL_COUNT <= size_class)
+        {
+            break;
+        }
+        pal_os_lock_enter_critical_section();
+        pal_os_memcpy(p_stats, &pal_os_memory_pool[size_class].stats, sizeof(pal_os_memory_pool_stats_t));
+        pal_os_lock_exit_critical_section();
+        return_status = PAL_STATUS_SUCCESS;
+    } while (FALSE);
+
+    return (return_status);
+}
+
+#endif //OPTIGA_LIB_MEMORY_POOL_ENABLED
+
+/**
+* @}
+*/
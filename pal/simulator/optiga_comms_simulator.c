@@ -0,0 +1,1369 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_comms_simulator.c
+*
+* \brief   This file implements optiga comms with simulated OPTIGA instances, which execute the APDUs on the host.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include "optiga/comms/optiga_comms.h"
+#include "optiga/common/optiga_lib_common_internal.h"
+#include "optiga/pal/pal_os_event.h"
+#include "optiga/pal/pal_os_lock.h"
+#include "optiga/pal/pal_os_memory.h"
+#ifdef OPTIGA_PAL_INIT_ENABLED
+#include "optiga/pal/pal.h"
+#endif
+#include "optiga_simulator.h"
+#include "mbedtls/ecdsa.h"
+#include "mbedtls/sha256.h"
+
+/// @cond hidden
+
+/// Optiga comms is in use
+#define OPTIGA_COMMS_INUSE                          (0x01)
+/// Optiga comms is free
+#define OPTIGA_COMMS_FREE                           (0x00)
+
+// Operations of optiga comms, which are completed by the simulator event
+#define OPTIGA_SIMULATOR_OPERATION_OPEN             (0x01)
+#define OPTIGA_SIMULATOR_OPERATION_CLOSE            (0x02)
+#define OPTIGA_SIMULATOR_OPERATION_RESET            (0x03)
+#define OPTIGA_SIMULATOR_OPERATION_TRANSCEIVE       (0x04)
+#define OPTIGA_SIMULATOR_OPERATION_ROLLOVER         (0x05)
+
+// Reset types, the same as ifx_i2c_reset_type_t
+#define OPTIGA_SIMULATOR_SOFT_RESET                 (0x01)
+
+// APDU header (command/status, parameter, length) and response status
+#define OPTIGA_SIMULATOR_APDU_HEADER_SIZE           (0x04)
+#define OPTIGA_SIMULATOR_APDU_SUCCESS               (0x00)
+#define OPTIGA_SIMULATOR_APDU_FAILURE               (0xFF)
+#define OPTIGA_SIMULATOR_CLEAR_LAST_ERROR           (0x80)
+#define OPTIGA_SIMULATOR_TLV_HEADER_SIZE            (0x03)
+
+// Command codes, without the clear last error bit
+#define OPTIGA_SIMULATOR_CMD_GET_DATA_OBJECT        (0x01)
+#define OPTIGA_SIMULATOR_CMD_SET_DATA_OBJECT        (0x02)
+#define OPTIGA_SIMULATOR_CMD_GET_RANDOM             (0x0C)
+#define OPTIGA_SIMULATOR_CMD_CALC_HASH              (0x30)
+#define OPTIGA_SIMULATOR_CMD_CALC_SIGN              (0x31)
+#define OPTIGA_SIMULATOR_CMD_OPEN_APPLICATION       (0x70)
+#define OPTIGA_SIMULATOR_CMD_CLOSE_APPLICATION      (0x71)
+#define OPTIGA_SIMULATOR_CMD_COUNT                  (0x80)
+
+// Device error codes, as reported in the last error code data object
+#define OPTIGA_SIMULATOR_NO_ERROR                   (0x00)
+#define OPTIGA_SIMULATOR_ERROR_INVALID_OID          (0x01)
+#define OPTIGA_SIMULATOR_ERROR_INVALID_PARAM        (0x03)
+#define OPTIGA_SIMULATOR_ERROR_INVALID_LENGTH       (0x04)
+#define OPTIGA_SIMULATOR_ERROR_INVALID_DATA         (0x05)
+#define OPTIGA_SIMULATOR_ERROR_INTERNAL             (0x06)
+#define OPTIGA_SIMULATOR_ERROR_BOUNDARY_EXCEEDED    (0x08)
+#define OPTIGA_SIMULATOR_ERROR_INVALID_COMMAND      (0x0A)
+#define OPTIGA_SIMULATOR_ERROR_OUT_OF_SEQUENCE      (0x0B)
+
+// Data objects and parameters of the commands
+#define OPTIGA_SIMULATOR_OID_COPROCESSOR_UID        (0xE0C2)
+#define OPTIGA_SIMULATOR_OID_LAST_ERROR_CODE        (0xF1C2)
+#define OPTIGA_SIMULATOR_COPROCESSOR_UID_SIZE       (0x1B)
+#define OPTIGA_SIMULATOR_READ_METADATA              (0x01)
+#define OPTIGA_SIMULATOR_WRITE_ONLY                 (0x00)
+#define OPTIGA_SIMULATOR_WRITE_METADATA             (0x01)
+#define OPTIGA_SIMULATOR_COUNT_DATA_OBJECT          (0x02)
+#define OPTIGA_SIMULATOR_ERASE_AND_WRITE            (0x40)
+#define OPTIGA_SIMULATOR_RANDOM_PRE_MASTER_SECRET   (0x04)
+#define OPTIGA_SIMULATOR_RANDOM_MIN_LENGTH          (0x0008)
+#define OPTIGA_SIMULATOR_RANDOM_MAX_LENGTH          (0x0100)
+#define OPTIGA_SIMULATOR_OPEN_RESTORE               (0x01)
+#define OPTIGA_SIMULATOR_CLOSE_HIBERNATE            (0x01)
+#define OPTIGA_SIMULATOR_SIGN_DIGEST_TAG            (0x01)
+#define OPTIGA_SIMULATOR_SIGN_OID_TAG               (0x03)
+#define OPTIGA_SIMULATOR_ECDSA_WITHOUT_HASH         (0x11)
+#define OPTIGA_SIMULATOR_MAX_DIGEST_SIZE            (0x40)
+#define OPTIGA_SIMULATOR_SHA256_SIZE                (0x20)
+
+// Software keys 0xE0F0 - 0xE0F3
+#define OPTIGA_SIMULATOR_KEY_OID_FIRST              (0xE0F0)
+#define OPTIGA_SIMULATOR_KEY_COUNT                  (0x04)
+#define OPTIGA_SIMULATOR_MAX_SIGNATURE_SIZE         (MBEDTLS_ECDSA_MAX_LEN)
+#define OPTIGA_SIMULATOR_PUBLIC_KEY_SIZE            (0x44)
+
+/** \brief Data object of a simulated OPTIGA instance */
+typedef struct optiga_simulator_data_object
+{
+    /// Data of the data object
+    uint8_t data[OPTIGA_SIMULATOR_MAX_DATA_OBJECT_SIZE];
+    /// Object identifier
+    uint16_t oid;
+    /// Used size of the data object
+    uint16_t length;
+    /// Indicates the entry is in use
+    uint8_t in_use;
+} optiga_simulator_data_object_t;
+
+/** \brief State of a simulated OPTIGA instance */
+typedef struct optiga_simulator_device
+{
+    /// Data objects, kept over the resets
+    optiga_simulator_data_object_t data_objects[OPTIGA_SIMULATOR_MAX_DATA_OBJECTS];
+    /// Execution time of the commands in microseconds, indexed by the command code
+    uint32_t execution_time_us[OPTIGA_SIMULATOR_CMD_COUNT];
+    /// Software keys, generated on the first use
+    mbedtls_ecdsa_context keys[OPTIGA_SIMULATOR_KEY_COUNT];
+    /// Indicates the software key is generated
+    uint8_t key_generated[OPTIGA_SIMULATOR_KEY_COUNT];
+    /// Hash context resident in OPTIGA
+    mbedtls_sha256_context hash_context;
+    /// Response APDU of the last command, copied to the receive buffer on completion
+    uint8_t response[OPTIGA_MAX_COMMS_BUFFER_SIZE];
+    /// Length of the response APDU
+    uint16_t response_length;
+    /// Receive buffer and length of the ongoing transceive
+    uint8_t * p_rx_data;
+    uint16_t * p_rx_data_len;
+#ifdef OPTIGA_COMMS_ZERO_COPY_RX
+    /// Destination of the received data of the ongoing transceive, refer optiga_comms_t
+    uint8_t * p_rx_destination;
+    uint16_t rx_destination_offset;
+    uint16_t rx_destination_size;
+#endif
+    /// Time until the ongoing operation completes in microseconds
+    uint32_t completion_time_us;
+    /// State of the deterministic random number generator
+    uint32_t random_state;
+#ifdef OPTIGA_LIB_EVENT_QUEUE_ENABLED
+    /// Event of the simulator, in parallel to the scheduler of optiga cmd
+    pal_os_event_t * pal_os_event_ctx;
+#endif
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+    /// Link statistics, accumulated since the start
+    optiga_lib_comms_stats_t statistics;
+    /// Remainders of the execution and I2C times in microseconds, which are accounted in milliseconds
+    uint32_t execution_time_remainder_us;
+    uint32_t i2c_time_remainder_us;
+#endif
+    /// Ongoing operation and the type of the reset
+    uint8_t operation;
+    uint8_t reset_type;
+    /// Last device error code
+    uint8_t last_error;
+    /// States of the communication and the application
+    uint8_t initialized;
+    uint8_t link_open;
+    uint8_t application_open;
+    uint8_t hibernated;
+    uint8_t hash_context_valid;
+} optiga_simulator_device_t;
+
+/*
+* Default execution times of the commands on OPTIGA Trust M
+*/
+_STATIC_H const uint32_t optiga_simulator_default_execution_time[][2] =
+{
+    {0x01, 2000U},       // GetDataObject
+    {0x02, 15000U},      // SetDataObject
+    {0x03, 25000U},      // SetObjectProtected
+    {0x0C, 3000U},       // GetRandom
+    {0x14, 5000U},       // EncryptSym
+    {0x15, 5000U},       // DecryptSym
+    {0x1E, 40000U},      // EncryptAsym
+    {0x1F, 200000U},     // DecryptAsym
+    {0x30, 2000U},       // CalcHash
+    {0x31, 60000U},      // CalcSign
+    {0x32, 80000U},      // VerifySign
+    {0x33, 60000U},      // CalcSSec
+    {0x34, 10000U},      // DeriveKey
+    {0x38, 60000U},      // GenKeyPair
+    {0x39, 5000U},       // GenSymKey
+    {0x70, 10000U},      // OpenApplication
+    {0x71, 10000U}       // CloseApplication
+};
+
+_STATIC_H optiga_simulator_device_t optiga_simulator_device_list[OPTIGA_MAX_NUMBER_OF_INSTANCES];
+
+//lint --e{785} suppress "Only required fields are initialized by default, the rest are assigned on create"
+optiga_comms_t optiga_comms = {
+                               (void *)&optiga_simulator_device_list[0],
+                               NULL,
+                               NULL,
+                               0,
+                               0,
+#ifdef OPTIGA_COMMS_SHIELDED_CONNECTION
+                               0,
+                               0,
+                               0,
+#endif
+                               NULL};
+
+#if (OPTIGA_MAX_NUMBER_OF_INSTANCES > 1)
+// optiga comms of additional OPTIGA instances, comms context is assigned from optiga_simulator_device_list
+//lint --e{785} suppress "Only required fields are initialized by default, the rest are assigned on create"
+_STATIC_H optiga_comms_t optiga_comms_list[OPTIGA_MAX_NUMBER_OF_INSTANCES - 1] = {0};
+#endif
+
+#ifdef OPTIGA_PAL_INIT_ENABLED
+// pal is initialized once for all OPTIGA instances
+_STATIC_H uint8_t pal_init_state = FALSE;
+#endif
+
+_STATIC_H optiga_lib_status_t check_optiga_comms_state(optiga_comms_t * p_ctx);
+_STATIC_H void optiga_simulator_event_handler(void * p_ctx);
+
+/*
+* Provides the state of a simulated OPTIGA instance, initialized on the first use
+*/
+_STATIC_H optiga_simulator_device_t * optiga_simulator_get_device(uint8_t optiga_instance_id)
+{
+    optiga_simulator_device_t * p_device = NULL;
+    uint8_t index;
+
+    if (OPTIGA_MAX_NUMBER_OF_INSTANCES > optiga_instance_id)
+    {
+        p_device = &optiga_simulator_device_list[optiga_instance_id];
+        if (FALSE == p_device->initialized)
+        {
+            for (index = 0; index < OPTIGA_SIMULATOR_CMD_COUNT; index++)
+            {
+                p_device->execution_time_us[index] = OPTIGA_SIMULATOR_DEFAULT_EXECUTION_TIME_US;
+            }
+            for (index = 0; index < (sizeof(optiga_simulator_default_execution_time) /
+                                     sizeof(optiga_simulator_default_execution_time[0])); index++)
+            {
+                p_device->execution_time_us[optiga_simulator_default_execution_time[index][0]] =
+                    optiga_simulator_default_execution_time[index][1];
+            }
+            for (index = 0; index < OPTIGA_SIMULATOR_KEY_COUNT; index++)
+            {
+                mbedtls_ecdsa_init(&p_device->keys[index]);
+            }
+            // Each instance provides a different sequence of random numbers, which is the same in every run
+            p_device->random_state = 0x4F505449UL + optiga_instance_id;
+
+            // Coprocessor UID, the batch number identifies the instance
+            p_device->data_objects[0].in_use = TRUE;
+            p_device->data_objects[0].oid = OPTIGA_SIMULATOR_OID_COPROCESSOR_UID;
+            p_device->data_objects[0].length = OPTIGA_SIMULATOR_COPROCESSOR_UID_SIZE;
+            p_device->data_objects[0].data[0] = 0xCD;
+            p_device->data_objects[0].data[1] = 0x16;
+            p_device->data_objects[0].data[2] = 0x33;
+            p_device->data_objects[0].data[16] = optiga_instance_id;
+            // ESW build number of OPTIGA Trust M V3
+            p_device->data_objects[0].data[25] = 0x24;
+            p_device->data_objects[0].data[26] = 0x40;
+            p_device->initialized = TRUE;
+        }
+    }
+    return (p_device);
+}
+
+/*
+* Deterministic random number generator (xorshift), the interface is required by mbed TLS
+*/
+_STATIC_H int optiga_simulator_random(void * p_rng, unsigned char * p_output, size_t output_length)
+{
+    optiga_simulator_device_t * p_device = (optiga_simulator_device_t *)p_rng;
+    uint32_t state = p_device->random_state;
+    size_t index;
+
+    for (index = 0; index < output_length; index++)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        p_output[index] = (uint8_t)state;
+    }
+    p_device->random_state = state;
+    return (0);
+}
+
+/*
+* Scales the simulated time with OPTIGA_SIMULATOR_TIME_SCALE_PERCENT
+*/
+_STATIC_H uint32_t optiga_simulator_scale_time(uint32_t time_us)
+{
+    time_us = ((time_us / 100U) * OPTIGA_SIMULATOR_TIME_SCALE_PERCENT) +
+              (((time_us % 100U) * OPTIGA_SIMULATOR_TIME_SCALE_PERCENT) / 100U);
+    // The completion is always delivered from the event, never inline
+    return ((0U == time_us) ? 1U : time_us);
+}
+
+_STATIC_H optiga_simulator_data_object_t * optiga_simulator_find_data_object(optiga_simulator_device_t * p_device,
+                                                                             uint16_t oid)
+{
+    optiga_simulator_data_object_t * p_data_object = NULL;
+    uint8_t index;
+
+    for (index = 0; index < OPTIGA_SIMULATOR_MAX_DATA_OBJECTS; index++)
+    {
+        if ((TRUE == p_device->data_objects[index].in_use) && (oid == p_device->data_objects[index].oid))
+        {
+            p_data_object = &p_device->data_objects[index];
+            break;
+        }
+    }
+    return (p_data_object);
+}
+
+_STATIC_H optiga_simulator_data_object_t * optiga_simulator_create_data_object(optiga_simulator_device_t * p_device,
+                                                                               uint16_t oid)
+{
+    optiga_simulator_data_object_t * p_data_object = optiga_simulator_find_data_object(p_device, oid);
+    uint8_t index;
+
+    for (index = 0; (NULL == p_data_object) && (index < OPTIGA_SIMULATOR_MAX_DATA_OBJECTS); index++)
+    {
+        if (FALSE == p_device->data_objects[index].in_use)
+        {
+            p_data_object = &p_device->data_objects[index];
+            p_data_object->in_use = TRUE;
+            p_data_object->oid = oid;
+            p_data_object->length = 0;
+        }
+    }
+    return (p_data_object);
+}
+
+/*
+* Provides the software key, which is generated on the first use
+*/
+_STATIC_H mbedtls_ecdsa_context * optiga_simulator_get_key(optiga_simulator_device_t * p_device, uint16_t key_oid)
+{
+    mbedtls_ecdsa_context * p_key = NULL;
+    uint16_t index = (uint16_t)(key_oid - OPTIGA_SIMULATOR_KEY_OID_FIRST);
+
+    do
+    {
+        if ((OPTIGA_SIMULATOR_KEY_OID_FIRST > key_oid) || (OPTIGA_SIMULATOR_KEY_COUNT <= index))
+        {
+            break;
+        }
+        if (FALSE == p_device->key_generated[index])
+        {
+            if (0 != mbedtls_ecdsa_genkey(&p_device->keys[index],
+                                          MBEDTLS_ECP_DP_SECP256R1,
+                                          optiga_simulator_random,
+                                          p_device))
+            {
+                break;
+            }
+            p_device->key_generated[index] = TRUE;
+        }
+        p_key = &p_device->keys[index];
+    } while (FALSE);
+    return (p_key);
+}
+
+_STATIC_H uint8_t optiga_simulator_open_application(optiga_simulator_device_t * p_device, uint8_t param)
+{
+    uint8_t error = OPTIGA_SIMULATOR_NO_ERROR;
+
+    if (OPTIGA_SIMULATOR_OPEN_RESTORE == param)
+    {
+        // Restore requires the context saved by the hibernate
+        if (FALSE == p_device->hibernated)
+        {
+            error = OPTIGA_SIMULATOR_ERROR_OUT_OF_SEQUENCE;
+        }
+    }
+    else
+    {
+        p_device->hash_context_valid = FALSE;
+    }
+    if (OPTIGA_SIMULATOR_NO_ERROR == error)
+    {
+        p_device->hibernated = FALSE;
+        p_device->application_open = TRUE;
+    }
+    return (error);
+}
+
+_STATIC_H uint8_t optiga_simulator_close_application(optiga_simulator_device_t * p_device, uint8_t param)
+{
+    p_device->hibernated = (OPTIGA_SIMULATOR_CLOSE_HIBERNATE == param) ? TRUE : FALSE;
+    p_device->application_open = FALSE;
+    return (OPTIGA_SIMULATOR_NO_ERROR);
+}
+
+_STATIC_H uint8_t optiga_simulator_get_data_object(optiga_simulator_device_t * p_device,
+                                                   uint8_t param,
+                                                   const uint8_t * p_data,
+                                                   uint16_t data_length,
+                                                   uint8_t * p_out,
+                                                   uint16_t * p_out_length)
+{
+    uint8_t error = OPTIGA_SIMULATOR_ERROR_INVALID_LENGTH;
+    optiga_simulator_data_object_t * p_data_object;
+    const uint8_t * p_object = NULL;
+    uint16_t object_length = 0;
+    uint16_t oid;
+    uint16_t offset = 0;
+    uint16_t length = OPTIGA_MAX_COMMS_BUFFER_SIZE;
+
+    do
+    {
+        if ((OPTIGA_SIMULATOR_READ_METADATA == param) ? (2U != data_length) : (6U != data_length))
+        {
+            break;
+        }
+        optiga_common_get_uint16(p_data, &oid);
+        if (OPTIGA_SIMULATOR_READ_METADATA != param)
+        {
+            optiga_common_get_uint16(p_data + 2, &offset);
+            optiga_common_get_uint16(p_data + 4, &length);
+        }
+
+        error = OPTIGA_SIMULATOR_ERROR_INVALID_OID;
+        if (OPTIGA_SIMULATOR_OID_LAST_ERROR_CODE == oid)
+        {
+            p_object = &p_device->last_error;
+            object_length = (OPTIGA_SIMULATOR_NO_ERROR != p_device->last_error) ? 1U : 0U;
+        }
+        else
+        {
+            p_data_object = optiga_simulator_find_data_object(p_device, oid);
+            if (NULL == p_data_object)
+            {
+                break;
+            }
+            p_object = p_data_object->data;
+            object_length = p_data_object->length;
+        }
+
+        if (OPTIGA_SIMULATOR_READ_METADATA == param)
+        {
+            // Metadata with the maximum and the used size only
+            p_out[0] = 0x20;
+            p_out[1] = 0x08;
+            p_out[2] = 0xC4;
+            p_out[3] = 0x02;
+            optiga_common_set_uint16(p_out + 4, OPTIGA_SIMULATOR_MAX_DATA_OBJECT_SIZE);
+            p_out[6] = 0xC5;
+            p_out[7] = 0x02;
+            optiga_common_set_uint16(p_out + 8, object_length);
+            *p_out_length = 10;
+            error = OPTIGA_SIMULATOR_NO_ERROR;
+            break;
+        }
+
+        // Reading from the end of a non-empty data object is reported as boundary exceeded
+        error = OPTIGA_SIMULATOR_ERROR_BOUNDARY_EXCEEDED;
+        if ((offset > object_length) || ((offset == object_length) && (0U != object_length)))
+        {
+            break;
+        }
+        length = MIN(length, (uint16_t)(object_length - offset));
+        length = MIN(length, (uint16_t)(OPTIGA_MAX_COMMS_BUFFER_SIZE - OPTIGA_SIMULATOR_APDU_HEADER_SIZE));
+        pal_os_memcpy(p_out, p_object + offset, length);
+        *p_out_length = length;
+        error = OPTIGA_SIMULATOR_NO_ERROR;
+    } while (FALSE);
+    return (error);
+}
+
+_STATIC_H uint8_t optiga_simulator_set_data_object(optiga_simulator_device_t * p_device,
+                                                   uint8_t param,
+                                                   const uint8_t * p_data,
+                                                   uint16_t data_length)
+{
+    uint8_t error = OPTIGA_SIMULATOR_ERROR_INVALID_LENGTH;
+    optiga_simulator_data_object_t * p_data_object;
+    uint32_t counter;
+    uint16_t oid;
+    uint16_t offset;
+    uint16_t length = (uint16_t)(data_length - 4U);
+
+    do
+    {
+        if (4U > data_length)
+        {
+            break;
+        }
+        optiga_common_get_uint16(p_data, &oid);
+        optiga_common_get_uint16(p_data + 2, &offset);
+
+        error = OPTIGA_SIMULATOR_ERROR_INVALID_OID;
+        if (OPTIGA_SIMULATOR_OID_LAST_ERROR_CODE == oid)
+        {
+            break;
+        }
+        if (OPTIGA_SIMULATOR_WRITE_METADATA == param)
+        {
+            // Metadata is not simulated, only the data object must exist
+            error = (NULL == optiga_simulator_find_data_object(p_device, oid)) ? OPTIGA_SIMULATOR_ERROR_INVALID_OID :
+                                                                                 OPTIGA_SIMULATOR_NO_ERROR;
+            break;
+        }
+        if (OPTIGA_SIMULATOR_COUNT_DATA_OBJECT == param)
+        {
+            // Counter is the first 4 bytes of the data object, the count value is a single byte
+            p_data_object = optiga_simulator_find_data_object(p_device, oid);
+            if (NULL == p_data_object)
+            {
+                break;
+            }
+            error = OPTIGA_SIMULATOR_ERROR_INVALID_DATA;
+            if ((1U != length) || (4U > p_data_object->length))
+            {
+                break;
+            }
+            counter = ((uint32_t)p_data_object->data[0] << 24) | ((uint32_t)p_data_object->data[1] << 16) |
+                      ((uint32_t)p_data_object->data[2] << 8) | (uint32_t)p_data_object->data[3];
+            counter += p_data[4];
+            p_data_object->data[0] = (uint8_t)(counter >> 24);
+            p_data_object->data[1] = (uint8_t)(counter >> 16);
+            p_data_object->data[2] = (uint8_t)(counter >> 8);
+            p_data_object->data[3] = (uint8_t)counter;
+            error = OPTIGA_SIMULATOR_NO_ERROR;
+            break;
+        }
+        if ((OPTIGA_SIMULATOR_WRITE_ONLY != param) && (OPTIGA_SIMULATOR_ERASE_AND_WRITE != param))
+        {
+            error = OPTIGA_SIMULATOR_ERROR_INVALID_PARAM;
+            break;
+        }
+        p_data_object = optiga_simulator_create_data_object(p_device, oid);
+        if (NULL == p_data_object)
+        {
+            break;
+        }
+        error = OPTIGA_SIMULATOR_ERROR_BOUNDARY_EXCEEDED;
+        if (((uint32_t)offset + length) > OPTIGA_SIMULATOR_MAX_DATA_OBJECT_SIZE)
+        {
+            break;
+        }
+        if (OPTIGA_SIMULATOR_ERASE_AND_WRITE == param)
+        {
+            pal_os_memset(p_data_object->data, 0, sizeof(p_data_object->data));
+            p_data_object->length = 0;
+        }
+        else if (offset > p_data_object->length)
+        {
+            break;
+        }
+        pal_os_memcpy(p_data_object->data + offset, p_data + 4, length);
+        if ((offset + length) > p_data_object->length)
+        {
+            p_data_object->length = (uint16_t)(offset + length);
+        }
+        error = OPTIGA_SIMULATOR_NO_ERROR;
+    } while (FALSE);
+    return (error);
+}
+
+_STATIC_H uint8_t optiga_simulator_get_random(optiga_simulator_device_t * p_device,
+                                              uint8_t param,
+                                              const uint8_t * p_data,
+                                              uint16_t data_length,
+                                              uint8_t * p_out,
+                                              uint16_t * p_out_length)
+{
+    uint8_t error = OPTIGA_SIMULATOR_ERROR_INVALID_PARAM;
+    uint16_t length;
+
+    do
+    {
+        if ((OPTIGA_RNG_TYPE_TRNG != param) && (OPTIGA_RNG_TYPE_DRNG != param) &&
+            (OPTIGA_SIMULATOR_RANDOM_PRE_MASTER_SECRET != param))
+        {
+            break;
+        }
+        error = OPTIGA_SIMULATOR_ERROR_INVALID_LENGTH;
+        if (2U > data_length)
+        {
+            break;
+        }
+        optiga_common_get_uint16(p_data, &length);
+        error = OPTIGA_SIMULATOR_ERROR_INVALID_DATA;
+        if ((OPTIGA_SIMULATOR_RANDOM_MIN_LENGTH > length) || (OPTIGA_SIMULATOR_RANDOM_MAX_LENGTH < length))
+        {
+            break;
+        }
+        // The pre-master secret is kept in the session context and not returned
+        if (OPTIGA_SIMULATOR_RANDOM_PRE_MASTER_SECRET != param)
+        {
+            (void)optiga_simulator_random(p_device, p_out, length);
+            *p_out_length = length;
+        }
+        error = OPTIGA_SIMULATOR_NO_ERROR;
+    } while (FALSE);
+    return (error);
+}
+
+_STATIC_H uint8_t optiga_simulator_calc_hash(optiga_simulator_device_t * p_device,
+                                             uint8_t param,
+                                             const uint8_t * p_data,
+                                             uint16_t data_length,
+                                             uint8_t * p_out,
+                                             uint16_t * p_out_length)
+{
+    uint8_t error = OPTIGA_SIMULATOR_ERROR_INVALID_PARAM;
+    optiga_simulator_data_object_t * p_data_object;
+    mbedtls_sha256_context hash_context;
+    const uint8_t * p_hash_data;
+    uint16_t hash_data_length;
+    uint16_t tlv_length;
+    uint16_t index;
+    uint16_t oid;
+    uint16_t offset;
+    uint8_t sequence;
+    uint8_t context_provided = FALSE;
+    uint8_t export_context = FALSE;
+
+    do
+    {
+        if (OPTIGA_HASH_TYPE_SHA_256 != param)
+        {
+            break;
+        }
+        error = OPTIGA_SIMULATOR_ERROR_INVALID_LENGTH;
+        if (OPTIGA_SIMULATOR_TLV_HEADER_SIZE > data_length)
+        {
+            break;
+        }
+        sequence = p_data[0];
+        optiga_common_get_uint16(p_data + 1, &hash_data_length);
+        if ((OPTIGA_SIMULATOR_TLV_HEADER_SIZE + hash_data_length) > data_length)
+        {
+            break;
+        }
+        p_hash_data = p_data + OPTIGA_SIMULATOR_TLV_HEADER_SIZE;
+        index = OPTIGA_SIMULATOR_TLV_HEADER_SIZE + hash_data_length;
+
+        if (0U != (sequence & OPTIGA_CRYPT_HASH_FOR_OID))
+        {
+            // Data is referred by OID, offset and length
+            if (6U != hash_data_length)
+            {
+                break;
+            }
+            optiga_common_get_uint16(p_hash_data, &oid);
+            optiga_common_get_uint16(p_hash_data + 2, &offset);
+            optiga_common_get_uint16(p_hash_data + 4, &hash_data_length);
+            p_data_object = optiga_simulator_find_data_object(p_device, oid);
+            if (NULL == p_data_object)
+            {
+                error = OPTIGA_SIMULATOR_ERROR_INVALID_OID;
+                break;
+            }
+            if (((uint32_t)offset + hash_data_length) > p_data_object->length)
+            {
+                error = OPTIGA_SIMULATOR_ERROR_BOUNDARY_EXCEEDED;
+                break;
+            }
+            p_hash_data = p_data_object->data + offset;
+            sequence &= (uint8_t)(~OPTIGA_CRYPT_HASH_FOR_OID);
+        }
+
+        // Optional intermediate context and the export of the context
+        error = OPTIGA_SIMULATOR_ERROR_INVALID_DATA;
+        while (data_length >= (index + OPTIGA_SIMULATOR_TLV_HEADER_SIZE))
+        {
+            optiga_common_get_uint16(p_data + index + 1, &tlv_length);
+            if ((index + OPTIGA_SIMULATOR_TLV_HEADER_SIZE + tlv_length) > data_length)
+            {
+                break;
+            }
+            if ((OPTIGA_CRYPT_INTERMEDIATE == p_data[index]) && (sizeof(hash_context) == tlv_length))
+            {
+                pal_os_memcpy(&hash_context, p_data + index + OPTIGA_SIMULATOR_TLV_HEADER_SIZE, tlv_length);
+                context_provided = TRUE;
+            }
+            else if (OPTIGA_CRYPT_HASH_CONTX_OUT == p_data[index])
+            {
+                export_context = TRUE;
+            }
+            else
+            {
+                break;
+            }
+            index += OPTIGA_SIMULATOR_TLV_HEADER_SIZE + tlv_length;
+        }
+        if (index != data_length)
+        {
+            break;
+        }
+
+        if ((OPTIGA_CRYPT_HASH_START == sequence) || (OPTIGA_CRYPT_HASH_START_FINAL == sequence))
+        {
+            mbedtls_sha256_init(&hash_context);
+            (void)mbedtls_sha256_starts_ret(&hash_context, 0);
+        }
+        else if ((OPTIGA_CRYPT_HASH_CONTINUE == sequence) || (OPTIGA_CRYPT_HASH_FINAL == sequence))
+        {
+            if (FALSE == context_provided)
+            {
+                if (FALSE == p_device->hash_context_valid)
+                {
+                    error = OPTIGA_SIMULATOR_ERROR_OUT_OF_SEQUENCE;
+                    break;
+                }
+                pal_os_memcpy(&hash_context, &p_device->hash_context, sizeof(hash_context));
+            }
+        }
+        else
+        {
+            break;
+        }
+        (void)mbedtls_sha256_update_ret(&hash_context, p_hash_data, hash_data_length);
+
+        if ((OPTIGA_CRYPT_HASH_START_FINAL == sequence) || (OPTIGA_CRYPT_HASH_FINAL == sequence))
+        {
+            p_out[0] = OPTIGA_CRYPT_HASH_START_FINAL;
+            optiga_common_set_uint16(p_out + 1, OPTIGA_SIMULATOR_SHA256_SIZE);
+            (void)mbedtls_sha256_finish_ret(&hash_context, p_out + OPTIGA_SIMULATOR_TLV_HEADER_SIZE);
+            *p_out_length = OPTIGA_SIMULATOR_TLV_HEADER_SIZE + OPTIGA_SIMULATOR_SHA256_SIZE;
+            p_device->hash_context_valid = FALSE;
+        }
+        else if (TRUE == export_context)
+        {
+            p_out[0] = OPTIGA_CRYPT_INTERMEDIATE;
+            optiga_common_set_uint16(p_out + 1, (uint16_t)sizeof(hash_context));
+            pal_os_memcpy(p_out + OPTIGA_SIMULATOR_TLV_HEADER_SIZE, &hash_context, sizeof(hash_context));
+            *p_out_length = (uint16_t)(OPTIGA_SIMULATOR_TLV_HEADER_SIZE + sizeof(hash_context));
+            p_device->hash_context_valid = FALSE;
+        }
+        else
+        {
+            pal_os_memcpy(&p_device->hash_context, &hash_context, sizeof(hash_context));
+            p_device->hash_context_valid = TRUE;
+        }
+        mbedtls_sha256_free(&hash_context);
+        error = OPTIGA_SIMULATOR_NO_ERROR;
+    } while (FALSE);
+    return (error);
+}
+
+_STATIC_H uint8_t optiga_simulator_calc_sign(optiga_simulator_device_t * p_device,
+                                             uint8_t param,
+                                             const uint8_t * p_data,
+                                             uint16_t data_length,
+                                             uint8_t * p_out,
+                                             uint16_t * p_out_length)
+{
+    uint8_t error = OPTIGA_SIMULATOR_ERROR_INVALID_PARAM;
+    uint8_t signature[OPTIGA_SIMULATOR_MAX_SIGNATURE_SIZE];
+    size_t signature_length = 0;
+    mbedtls_ecdsa_context * p_key;
+    uint16_t digest_length;
+    uint16_t tlv_length;
+    uint16_t key_oid;
+
+    do
+    {
+        if (OPTIGA_SIMULATOR_ECDSA_WITHOUT_HASH != param)
+        {
+            break;
+        }
+        // Digest TLV followed by the key OID TLV
+        error = OPTIGA_SIMULATOR_ERROR_INVALID_DATA;
+        if ((OPTIGA_SIMULATOR_TLV_HEADER_SIZE > data_length) || (OPTIGA_SIMULATOR_SIGN_DIGEST_TAG != p_data[0]))
+        {
+            break;
+        }
+        optiga_common_get_uint16(p_data + 1, &digest_length);
+        if ((OPTIGA_SIMULATOR_MAX_DIGEST_SIZE < digest_length) ||
+            (data_length != ((2U * OPTIGA_SIMULATOR_TLV_HEADER_SIZE) + digest_length + 2U)) ||
+            (OPTIGA_SIMULATOR_SIGN_OID_TAG != p_data[OPTIGA_SIMULATOR_TLV_HEADER_SIZE + digest_length]))
+        {
+            break;
+        }
+        optiga_common_get_uint16(p_data + OPTIGA_SIMULATOR_TLV_HEADER_SIZE + digest_length + 1, &tlv_length);
+        if (2U != tlv_length)
+        {
+            break;
+        }
+        optiga_common_get_uint16(p_data + (2U * OPTIGA_SIMULATOR_TLV_HEADER_SIZE) + digest_length, &key_oid);
+
+        error = OPTIGA_SIMULATOR_ERROR_INVALID_OID;
+        p_key = optiga_simulator_get_key(p_device, key_oid);
+        if (NULL == p_key)
+        {
+            break;
+        }
+        // The hash algorithm only selects the generation of the deterministic nonce
+        error = OPTIGA_SIMULATOR_ERROR_INTERNAL;
+        if (0 != mbedtls_ecdsa_write_signature(p_key,
+                                               MBEDTLS_MD_SHA256,
+                                               p_data + OPTIGA_SIMULATOR_TLV_HEADER_SIZE,
+                                               digest_length,
+                                               signature,
+                                               &signature_length,
+                                               optiga_simulator_random,
+                                               p_device))
+        {
+            break;
+        }
+        // OPTIGA provides r and s without the header of the DER SEQUENCE (short form, as for P-256)
+        pal_os_memcpy(p_out, signature + 2, signature[1]);
+        *p_out_length = signature[1];
+        error = OPTIGA_SIMULATOR_NO_ERROR;
+    } while (FALSE);
+    return (error);
+}
+
+/*
+* Executes the command APDU and prepares the response APDU in the device
+*/
+_STATIC_H void optiga_simulator_execute(optiga_simulator_device_t * p_device,
+                                        const uint8_t * p_apdu,
+                                        uint16_t apdu_length)
+{
+    uint8_t error = OPTIGA_SIMULATOR_ERROR_INVALID_LENGTH;
+    uint8_t * p_out = p_device->response + OPTIGA_SIMULATOR_APDU_HEADER_SIZE;
+    uint16_t out_length = 0;
+    uint16_t data_length = 0;
+    uint8_t cmd = (uint8_t)(p_apdu[0] & (uint8_t)(~OPTIGA_SIMULATOR_CLEAR_LAST_ERROR));
+    uint8_t param = p_apdu[1];
+    const uint8_t * p_data = p_apdu + OPTIGA_SIMULATOR_APDU_HEADER_SIZE;
+
+    if (OPTIGA_SIMULATOR_CLEAR_LAST_ERROR == (p_apdu[0] & OPTIGA_SIMULATOR_CLEAR_LAST_ERROR))
+    {
+        p_device->last_error = OPTIGA_SIMULATOR_NO_ERROR;
+    }
+
+    do
+    {
+        optiga_common_get_uint16(p_apdu + 2, &data_length);
+        if ((OPTIGA_SIMULATOR_APDU_HEADER_SIZE + data_length) != apdu_length)
+        {
+            break;
+        }
+        if ((FALSE == p_device->application_open) && (OPTIGA_SIMULATOR_CMD_OPEN_APPLICATION != cmd))
+        {
+            error = OPTIGA_SIMULATOR_ERROR_OUT_OF_SEQUENCE;
+            break;
+        }
+        switch (cmd)
+        {
+            case OPTIGA_SIMULATOR_CMD_OPEN_APPLICATION:
+            {
+                error = optiga_simulator_open_application(p_device, param);
+            }
+            break;
+            case OPTIGA_SIMULATOR_CMD_CLOSE_APPLICATION:
+            {
+                error = optiga_simulator_close_application(p_device, param);
+            }
+            break;
+            case OPTIGA_SIMULATOR_CMD_GET_DATA_OBJECT:
+            {
+                error = optiga_simulator_get_data_object(p_device, param, p_data, data_length, p_out, &out_length);
+            }
+            break;
+            case OPTIGA_SIMULATOR_CMD_SET_DATA_OBJECT:
+            {
+                error = optiga_simulator_set_data_object(p_device, param, p_data, data_length);
+            }
+            break;
+            case OPTIGA_SIMULATOR_CMD_GET_RANDOM:
+            {
+                error = optiga_simulator_get_random(p_device, param, p_data, data_length, p_out, &out_length);
+            }
+            break;
+            case OPTIGA_SIMULATOR_CMD_CALC_HASH:
+            {
+                error = optiga_simulator_calc_hash(p_device, param, p_data, data_length, p_out, &out_length);
+            }
+            break;
+            case OPTIGA_SIMULATOR_CMD_CALC_SIGN:
+            {
+                error = optiga_simulator_calc_sign(p_device, param, p_data, data_length, p_out, &out_length);
+            }
+            break;
+            default:
+            {
+                error = OPTIGA_SIMULATOR_ERROR_INVALID_COMMAND;
+            }
+            break;
+        }
+    } while (FALSE);
+
+    if (OPTIGA_SIMULATOR_NO_ERROR != error)
+    {
+        p_device->last_error = error;
+        out_length = 0;
+    }
+    p_device->response[0] = (OPTIGA_SIMULATOR_NO_ERROR == error) ? OPTIGA_SIMULATOR_APDU_SUCCESS :
+                                                                   OPTIGA_SIMULATOR_APDU_FAILURE;
+    p_device->response[1] = 0x00;
+    optiga_common_set_uint16(p_device->response + 2, out_length);
+    p_device->response_length = OPTIGA_SIMULATOR_APDU_HEADER_SIZE + out_length;
+    p_device->completion_time_us = p_device->execution_time_us[cmd] +
+                                   ((uint32_t)(apdu_length + p_device->response_length) *
+                                    OPTIGA_SIMULATOR_TRANSFER_TIME_PER_BYTE_US);
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+    pal_os_lock_enter_critical_section();
+    p_device->statistics.busy_time_us += optiga_simulator_scale_time(p_device->execution_time_us[cmd]);
+    p_device->statistics.bus_bytes += (uint32_t)apdu_length + p_device->response_length;
+    p_device->execution_time_remainder_us += optiga_simulator_scale_time(p_device->execution_time_us[cmd]);
+    p_device->statistics.execution_time_ms += p_device->execution_time_remainder_us / 1000U;
+    p_device->execution_time_remainder_us %= 1000U;
+    p_device->i2c_time_remainder_us += optiga_simulator_scale_time((uint32_t)(apdu_length + p_device->response_length) *
+                                                                   OPTIGA_SIMULATOR_TRANSFER_TIME_PER_BYTE_US);
+    p_device->statistics.i2c_time_ms += p_device->i2c_time_remainder_us / 1000U;
+    p_device->i2c_time_remainder_us %= 1000U;
+    pal_os_lock_exit_critical_section();
+#endif
+}
+
+#ifdef OPTIGA_COMMS_ZERO_COPY_RX
+/*
+* Stores the response to the receive buffer, the bytes from the rx destination offset onwards to the rx destination
+* instead. Returns the number of bytes stored to the rx destination
+*/
+_STATIC_H uint16_t optiga_simulator_store_response(const optiga_simulator_device_t * p_device)
+{
+    uint16_t buffer_length = p_device->response_length;
+    uint16_t destination_length = 0;
+    uint16_t response_offset;
+
+    if ((NULL != p_device->p_rx_destination) && (OPTIGA_COMMS_DATA_OFFSET <= p_device->rx_destination_offset))
+    {
+        response_offset = p_device->rx_destination_offset - OPTIGA_COMMS_DATA_OFFSET;
+        if ((response_offset < p_device->response_length) &&
+            ((p_device->response_length - response_offset) <= p_device->rx_destination_size))
+        {
+            buffer_length = response_offset;
+            destination_length = p_device->response_length - response_offset;
+            pal_os_memcpy(p_device->p_rx_destination, p_device->response + response_offset, destination_length);
+        }
+    }
+    pal_os_memcpy(p_device->p_rx_data + OPTIGA_COMMS_DATA_OFFSET, p_device->response, buffer_length);
+    return (destination_length);
+}
+#endif //OPTIGA_COMMS_ZERO_COPY_RX
+
+/*
+* Registers the completion of the operation after the simulated time
+*/
+_STATIC_H void optiga_simulator_start(optiga_comms_t * p_ctx, uint8_t operation, uint32_t time_us)
+{
+    optiga_simulator_device_t * p_device = (optiga_simulator_device_t *)p_ctx->p_comms_ctx;
+    void * p_pal_os_event_ctx = p_ctx->p_pal_os_event_ctx;
+
+#ifdef OPTIGA_LIB_EVENT_QUEUE_ENABLED
+    // the simulator schedules its completion on its own event, in parallel to the scheduler of optiga cmd
+    if (NULL == p_device->pal_os_event_ctx)
+    {
+        p_device->pal_os_event_ctx = PAL_OS_EVENT_CREATE(NULL, NULL);
+    }
+    if (NULL != p_device->pal_os_event_ctx)
+    {
+        p_pal_os_event_ctx = p_device->pal_os_event_ctx;
+    }
+#endif //OPTIGA_LIB_EVENT_QUEUE_ENABLED
+    p_device->operation = operation;
+    p_device->completion_time_us = optiga_simulator_scale_time(time_us);
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+    p_ctx->response_time_hint_us = 0;
+    p_ctx->response_time_us = 0;
+#endif
+    PAL_OS_EVENT_REGISTER_CALLBACK_ONESHOT((pal_os_event_t *)p_pal_os_event_ctx,
+                                           optiga_simulator_event_handler,
+                                           (void *)p_ctx,
+                                           p_device->completion_time_us);
+}
+
+optiga_comms_t * optiga_comms_create(callback_handler_t callback, void * context)
+{
+    return (optiga_comms_create_instance(OPTIGA_INSTANCE_ID_0, callback, context));
+}
+
+optiga_comms_t * optiga_comms_create_instance(uint8_t optiga_instance_id, callback_handler_t callback, void * context)
+{
+    optiga_comms_t * p_optiga_comms = NULL;
+
+    do
+    {
+        if (NULL == optiga_simulator_get_device(optiga_instance_id))
+        {
+            break;
+        }
+        p_optiga_comms = &optiga_comms;
+#if (OPTIGA_MAX_NUMBER_OF_INSTANCES > 1)
+        if (OPTIGA_INSTANCE_ID_0 != optiga_instance_id)
+        {
+            p_optiga_comms = &optiga_comms_list[optiga_instance_id - 1];
+            p_optiga_comms->p_comms_ctx = (void *)&optiga_simulator_device_list[optiga_instance_id];
+        }
+#endif
+
+        if (FALSE == p_optiga_comms->instance_init_state)
+        {
+#ifdef OPTIGA_PAL_INIT_ENABLED
+            if (FALSE == pal_init_state)
+            {
+                if (PAL_STATUS_SUCCESS != pal_init())
+                {
+                    p_optiga_comms = NULL;
+                    break;
+                }
+                pal_init_state = TRUE;
+            }
+#endif
+            p_optiga_comms->upper_layer_handler = callback;
+            p_optiga_comms->p_upper_layer_ctx = context;
+            p_optiga_comms->instance_init_state = TRUE;
+        }
+    } while (FALSE);
+    return (p_optiga_comms);
+}
+
+//lint --e{715} suppress "p_optiga_cmd is not used here as it is placeholder for future."
+//lint --e{818} suppress "Not declared as pointer as nothing needs to be updated in the pointer."
+void optiga_comms_destroy(optiga_comms_t * p_optiga_cmd)
+{
+}
+
+optiga_lib_status_t optiga_comms_set_callback_handler(optiga_comms_t * p_optiga_comms, callback_handler_t handler)
+{
+    p_optiga_comms->upper_layer_handler = handler;
+    return (0);
+}
+
+optiga_lib_status_t optiga_comms_set_callback_context(optiga_comms_t * p_optiga_comms, void * context)
+{
+    p_optiga_comms->p_upper_layer_ctx = context;
+    return (0);
+}
+
+/// @endcond
+
+optiga_lib_status_t optiga_comms_open(optiga_comms_t * p_ctx)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_ERROR;
+    if (OPTIGA_COMMS_SUCCESS == check_optiga_comms_state(p_ctx))
+    {
+        optiga_simulator_start(p_ctx, OPTIGA_SIMULATOR_OPERATION_OPEN, OPTIGA_SIMULATOR_OPEN_TIME_US);
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+        ((optiga_simulator_device_t *)(p_ctx->p_comms_ctx))->statistics.resets++;
+#endif
+        status = OPTIGA_COMMS_SUCCESS;
+    }
+    return (status);
+}
+
+optiga_lib_status_t optiga_comms_reset(optiga_comms_t * p_ctx, uint8_t reset_type)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_ERROR;
+    if (OPTIGA_COMMS_SUCCESS == check_optiga_comms_state(p_ctx))
+    {
+        ((optiga_simulator_device_t *)(p_ctx->p_comms_ctx))->reset_type = reset_type;
+        optiga_simulator_start(p_ctx, OPTIGA_SIMULATOR_OPERATION_RESET, OPTIGA_SIMULATOR_RESET_TIME_US);
+        status = OPTIGA_COMMS_SUCCESS;
+    }
+    return (status);
+}
+
+optiga_lib_status_t optiga_comms_transceive(optiga_comms_t * p_ctx,
+                                            const uint8_t * p_tx_data,
+                                            uint16_t tx_data_length,
+                                            uint8_t * p_rx_data,
+                                            uint16_t * p_rx_data_len)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_ERROR;
+    optiga_simulator_device_t * p_device;
+
+    if (OPTIGA_COMMS_SUCCESS == check_optiga_comms_state(p_ctx))
+    {
+        p_device = (optiga_simulator_device_t *)p_ctx->p_comms_ctx;
+        if ((FALSE == p_device->link_open) || (OPTIGA_SIMULATOR_APDU_HEADER_SIZE > tx_data_length))
+        {
+            p_ctx->state = OPTIGA_COMMS_FREE;
+        }
+        else
+        {
+            // The command is executed right away, the response is delivered after the simulated time
+            optiga_simulator_execute(p_device, p_tx_data + OPTIGA_COMMS_DATA_OFFSET, tx_data_length);
+            p_device->p_rx_data = p_rx_data;
+            p_device->p_rx_data_len = p_rx_data_len;
+#ifdef OPTIGA_COMMS_ZERO_COPY_RX
+            p_device->p_rx_destination = p_ctx->p_rx_destination;
+            p_device->rx_destination_offset = p_ctx->rx_destination_offset;
+            p_device->rx_destination_size = p_ctx->rx_destination_size;
+            p_ctx->p_rx_destination = NULL;
+            p_ctx->rx_destination_length = 0;
+#endif
+            optiga_simulator_start(p_ctx, OPTIGA_SIMULATOR_OPERATION_TRANSCEIVE, p_device->completion_time_us);
+            status = OPTIGA_COMMS_SUCCESS;
+        }
+    }
+    return (status);
+}
+
+optiga_lib_status_t optiga_comms_close(optiga_comms_t * p_ctx)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_ERROR;
+    if (OPTIGA_COMMS_SUCCESS == check_optiga_comms_state(p_ctx))
+    {
+        optiga_simulator_start(p_ctx, OPTIGA_SIMULATOR_OPERATION_CLOSE, 0);
+        status = OPTIGA_COMMS_SUCCESS;
+    }
+    return (status);
+}
+
+#ifdef OPTIGA_COMMS_DL_RESEND_BACKOFF_ENABLED
+optiga_lib_status_t optiga_comms_get_recovery_stats(const optiga_comms_t * p_ctx,
+                                                    optiga_lib_comms_recovery_stats_t * p_stats)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_ERROR;
+    if ((NULL != p_ctx) && (NULL != p_ctx->p_comms_ctx) && (NULL != p_stats))
+    {
+        // The simulated link has no transmission errors
+        pal_os_memset(p_stats, 0, sizeof(optiga_lib_comms_recovery_stats_t));
+        status = OPTIGA_COMMS_SUCCESS;
+    }
+    return (status);
+}
+#endif
+
+#ifdef OPTIGA_LIB_STATISTICS_ENABLED
+optiga_lib_status_t optiga_comms_get_statistics(const optiga_comms_t * p_ctx,
+                                                optiga_lib_comms_stats_t * p_stats)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_ERROR;
+    if ((NULL != p_ctx) && (NULL != p_ctx->p_comms_ctx) && (NULL != p_stats))
+    {
+        // Statistics are updated from the event context of the simulator
+        pal_os_lock_enter_critical_section();
+        pal_os_memcpy(p_stats,
+                      &((optiga_simulator_device_t * )(p_ctx->p_comms_ctx))->statistics,
+                      sizeof(optiga_lib_comms_stats_t));
+        pal_os_lock_exit_critical_section();
+        status = OPTIGA_COMMS_SUCCESS;
+    }
+    return (status);
+}
+#endif
+
+#ifdef OPTIGA_COMMS_STACK_USAGE_ENABLED
+optiga_lib_status_t optiga_comms_get_stack_usage(const optiga_comms_t * p_ctx,
+                                                 uint32_t * p_stack_high_water)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_ERROR;
+    if ((NULL != p_ctx) && (NULL != p_ctx->p_comms_ctx) && (NULL != p_stack_high_water))
+    {
+        // The stack of the protocol is not simulated
+        *p_stack_high_water = 0;
+        status = OPTIGA_COMMS_SUCCESS;
+    }
+    return (status);
+}
+#endif
+
+#if defined (OPTIGA_COMMS_SHIELDED_CONNECTION) && defined (OPTIGA_COMMS_KEY_ROLLOVER_ENABLED)
+optiga_lib_status_t optiga_comms_rollover(optiga_comms_t * p_ctx)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_ERROR;
+    if (OPTIGA_COMMS_SUCCESS == check_optiga_comms_state(p_ctx))
+    {
+        optiga_simulator_start(p_ctx, OPTIGA_SIMULATOR_OPERATION_ROLLOVER, 0);
+        status = OPTIGA_COMMS_SUCCESS;
+    }
+    return (status);
+}
+
+//lint --e{715} suppress "The session of the simulated link is never renegotiated"
+bool_t optiga_comms_rollover_due(const optiga_comms_t * p_ctx)
+{
+    return (FALSE);
+}
+#endif
+
+optiga_lib_status_t optiga_simulator_set_execution_time(uint8_t optiga_instance_id, uint8_t cmd, uint32_t time_us)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_ERROR_INVALID_INPUT;
+    optiga_simulator_device_t * p_device = optiga_simulator_get_device(optiga_instance_id);
+
+    if (NULL != p_device)
+    {
+        pal_os_lock_enter_critical_section();
+        p_device->execution_time_us[cmd & (uint8_t)(~OPTIGA_SIMULATOR_CLEAR_LAST_ERROR)] = time_us;
+        pal_os_lock_exit_critical_section();
+        status = OPTIGA_COMMS_SUCCESS;
+    }
+    return (status);
+}
+
+optiga_lib_status_t optiga_simulator_write_data_object(uint8_t optiga_instance_id,
+                                                       uint16_t oid,
+                                                       const uint8_t * p_data,
+                                                       uint16_t length)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_ERROR_INVALID_INPUT;
+    optiga_simulator_device_t * p_device = optiga_simulator_get_device(optiga_instance_id);
+    optiga_simulator_data_object_t * p_data_object;
+
+    do
+    {
+        if ((NULL == p_device) || ((NULL == p_data) && (0U != length)) ||
+            (OPTIGA_SIMULATOR_MAX_DATA_OBJECT_SIZE < length) || (OPTIGA_SIMULATOR_OID_LAST_ERROR_CODE == oid))
+        {
+            break;
+        }
+        pal_os_lock_enter_critical_section();
+        p_data_object = optiga_simulator_create_data_object(p_device, oid);
+        if (NULL != p_data_object)
+        {
+            if (0U != length)
+            {
+                pal_os_memcpy(p_data_object->data, p_data, length);
+            }
+            p_data_object->length = length;
+        }
+        pal_os_lock_exit_critical_section();
+        status = (NULL != p_data_object) ? OPTIGA_COMMS_SUCCESS : OPTIGA_COMMS_ERROR_MEMORY_INSUFFICIENT;
+    } while (FALSE);
+    return (status);
+}
+
+optiga_lib_status_t optiga_simulator_get_public_key(uint8_t optiga_instance_id,
+                                                    uint16_t key_oid,
+                                                    uint8_t * p_public_key,
+                                                    uint16_t * p_public_key_length)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_ERROR_INVALID_INPUT;
+    optiga_simulator_device_t * p_device = optiga_simulator_get_device(optiga_instance_id);
+    mbedtls_ecdsa_context * p_key;
+    size_t point_length = 0;
+
+    do
+    {
+        if ((NULL == p_device) || (NULL == p_public_key) || (NULL == p_public_key_length) ||
+            (OPTIGA_SIMULATOR_KEY_OID_FIRST > key_oid) ||
+            ((OPTIGA_SIMULATOR_KEY_OID_FIRST + OPTIGA_SIMULATOR_KEY_COUNT) <= key_oid))
+        {
+            break;
+        }
+        status = OPTIGA_COMMS_ERROR_MEMORY_INSUFFICIENT;
+        if (OPTIGA_SIMULATOR_PUBLIC_KEY_SIZE > *p_public_key_length)
+        {
+            break;
+        }
+        status = OPTIGA_COMMS_ERROR;
+        pal_os_lock_enter_critical_section();
+        p_key = optiga_simulator_get_key(p_device, key_oid);
+        if ((NULL != p_key) &&
+            (0 == mbedtls_ecp_point_write_binary(&p_key->grp,
+                                                 &p_key->Q,
+                                                 MBEDTLS_ECP_PF_UNCOMPRESSED,
+                                                 &point_length,
+                                                 p_public_key + 3,
+                                                 (size_t)(*p_public_key_length - 3U))))
+        {
+            // DER BIT STRING without unused bits
+            p_public_key[0] = 0x03;
+            p_public_key[1] = (uint8_t)(point_length + 1U);
+            p_public_key[2] = 0x00;
+            *p_public_key_length = (uint16_t)(point_length + 3U);
+            status = OPTIGA_COMMS_SUCCESS;
+        }
+        pal_os_lock_exit_critical_section();
+    } while (FALSE);
+    return (status);
+}
+
+/// @cond hidden
+_STATIC_H optiga_lib_status_t check_optiga_comms_state(optiga_comms_t * p_ctx)
+{
+    optiga_lib_status_t status = OPTIGA_COMMS_ERROR;
+    if ((NULL != p_ctx) && (OPTIGA_COMMS_INUSE != p_ctx->state))
+    {
+        p_ctx->state = OPTIGA_COMMS_INUSE;
+        status = OPTIGA_COMMS_SUCCESS;
+    }
+    return (status);
+}
+
+/*
+* Completes the operation after the simulated time and notifies the upper layer
+*/
+_STATIC_H void optiga_simulator_event_handler(void * p_ctx)
+{
+    optiga_comms_t * p_optiga_comms = (optiga_comms_t *)p_ctx;
+    optiga_simulator_device_t * p_device = (optiga_simulator_device_t *)p_optiga_comms->p_comms_ctx;
+    optiga_lib_status_t event = OPTIGA_COMMS_SUCCESS;
+
+    switch (p_device->operation)
+    {
+        case OPTIGA_SIMULATOR_OPERATION_OPEN:
+        {
+            p_device->link_open = TRUE;
+        }
+        break;
+        case OPTIGA_SIMULATOR_OPERATION_CLOSE:
+        {
+            p_device->link_open = FALSE;
+            p_device->application_open = FALSE;
+        }
+        break;
+        case OPTIGA_SIMULATOR_OPERATION_RESET:
+        {
+            // Only the soft reset of the protocol keeps the application of OPTIGA
+            if (OPTIGA_SIMULATOR_SOFT_RESET != p_device->reset_type)
+            {
+                p_device->application_open = FALSE;
+                p_device->hash_context_valid = FALSE;
+            }
+            p_device->link_open = TRUE;
+        }
+        break;
+        case OPTIGA_SIMULATOR_OPERATION_TRANSCEIVE:
+        {
+            if ((p_device->response_length + OPTIGA_COMMS_DATA_OFFSET) > *p_device->p_rx_data_len)
+            {
+                event = OPTIGA_COMMS_ERROR;
+                break;
+            }
+#ifdef OPTIGA_COMMS_ZERO_COPY_RX
+            p_optiga_comms->rx_destination_length = optiga_simulator_store_response(p_device);
+#else
+            pal_os_memcpy(p_device->p_rx_data + OPTIGA_COMMS_DATA_OFFSET, p_device->response, p_device->response_length);
+#endif
+            *p_device->p_rx_data_len = p_device->response_length;
+#ifdef OPTIGA_COMMS_ADAPTIVE_POLLING_ENABLED
+            p_optiga_comms->response_time_us = p_device->completion_time_us;
+#endif
+        }
+        break;
+        default:
+            break;
+    }
+    p_optiga_comms->upper_layer_handler(p_optiga_comms->p_upper_layer_ctx, event);
+    p_optiga_comms->state = OPTIGA_COMMS_FREE;
+}
+
+/// @endcond
+/**
+* @}
+*/
@@ -0,0 +1,178 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file optiga_simulator.h
+*
+* \brief   This file defines the configuration and the test APIs of the OPTIGA device simulator.
+*
+* \details
+* The simulator is an implementation of optiga_comms.h, which executes the APDUs on the host instead of sending them
+* to OPTIGA. It is linked instead of optiga/comms/optiga_comms_ifx_i2c.c and the IFX I2C protocol stack, the rest of
+* the host library (optiga cmd, util and crypt) runs unchanged. It is intended for the load and scaling tests of the
+* command scheduler on a host, with any number of simulated OPTIGA instances (OPTIGA_MAX_NUMBER_OF_INSTANCES).
+* - Supported commands: OpenApplication, CloseApplication, GetDataObject, SetDataObject, GetRandom, CalcHash
+*   (SHA256, resident and exported context) and CalcSign (ECDSA with NIST P-256 software keys in 0xE0F0 - 0xE0F3).
+*   Further commands fail with the device error code 0x0A (invalid command field).
+* - The response is delivered after the execution time of the command and the transfer time of the APDUs,
+*   using the pal os event. The execution times can be set per instance and command.
+* - The data objects are kept in RAM. The random numbers and the software keys are derived from a deterministic
+*   generator per instance, hence the simulator must not be used for any purpose other than testing.
+* - Shielded connection is accepted, but the APDUs are not protected.
+* - mbed TLS (externals/mbedtls) is required for the SHA256 and ECDSA calculations, with MBEDTLS_ECDSA_C and
+*   MBEDTLS_ASN1_WRITE_C enabled in the mbed TLS configuration.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#ifndef _OPTIGA_SIMULATOR_H_
+#define _OPTIGA_SIMULATOR_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "optiga/common/optiga_lib_common.h"
+
+/// Maximum number of data objects of a simulated OPTIGA instance
+#ifndef OPTIGA_SIMULATOR_MAX_DATA_OBJECTS
+#define OPTIGA_SIMULATOR_MAX_DATA_OBJECTS           (0x10U)
+#endif
+/// Maximum size of a data object in bytes, the same as the certificate data objects
+#ifndef OPTIGA_SIMULATOR_MAX_DATA_OBJECT_SIZE
+#define OPTIGA_SIMULATOR_MAX_DATA_OBJECT_SIZE       (0x06C0U)
+#endif
+/// Transfer time per byte of the APDUs in microseconds, including the frame overhead at 400 KHz
+#ifndef OPTIGA_SIMULATOR_TRANSFER_TIME_PER_BYTE_US
+#define OPTIGA_SIMULATOR_TRANSFER_TIME_PER_BYTE_US  (25U)
+#endif
+/// Time to open the communication (startup of OPTIGA) in microseconds
+#ifndef OPTIGA_SIMULATOR_OPEN_TIME_US
+#define OPTIGA_SIMULATOR_OPEN_TIME_US               (15000U)
+#endif
+/// Time to complete a reset of OPTIGA in microseconds
+#ifndef OPTIGA_SIMULATOR_RESET_TIME_US
+#define OPTIGA_SIMULATOR_RESET_TIME_US              (10000U)
+#endif
+/// Execution time of the commands, which have no default execution time, in microseconds
+#ifndef OPTIGA_SIMULATOR_DEFAULT_EXECUTION_TIME_US
+#define OPTIGA_SIMULATOR_DEFAULT_EXECUTION_TIME_US  (5000U)
+#endif
+/// Scale of all the simulated times in percent, e.g. 10 to run the tests ten times faster than real time
+#ifndef OPTIGA_SIMULATOR_TIME_SCALE_PERCENT
+#define OPTIGA_SIMULATOR_TIME_SCALE_PERCENT         (100U)
+#endif
+
+/**
+ * \brief Sets the execution time of a command of a simulated OPTIGA instance.
+ *
+ * \details
+ * Sets the time from the reception of the command APDU until the response is ready, without the transfer time.
+ * - The default execution times are the typical execution times of OPTIGA Trust M.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The execution time is applied from the next command, scaled with #OPTIGA_SIMULATOR_TIME_SCALE_PERCENT.
+ *
+ * \param[in]      optiga_instance_id                       Instance of OPTIGA, less than OPTIGA_MAX_NUMBER_OF_INSTANCES.
+ * \param[in]      cmd                                      Command code, with or without the clear last error bit (0x80).
+ * \param[in]      time_us                                  Execution time in microseconds.
+ *
+ * \retval         #OPTIGA_COMMS_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_COMMS_ERROR_INVALID_INPUT        Wrong input arguments provided.
+ */
+optiga_lib_status_t optiga_simulator_set_execution_time(uint8_t optiga_instance_id, uint8_t cmd, uint32_t time_us);
+
+/**
+ * \brief Writes a data object of a simulated OPTIGA instance.
+ *
+ * \details
+ * Creates or replaces the data object, e.g. to provide the certificates before the test.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - The read cache of optiga util is not updated, hence the data objects are written before the application is opened.
+ *
+ * \param[in]      optiga_instance_id                       Instance of OPTIGA, less than OPTIGA_MAX_NUMBER_OF_INSTANCES.
+ * \param[in]      oid                                      Object identifier of the data object.
+ * \param[in]      p_data                                   Data of the data object, can be NULL if length is 0.
+ * \param[in]      length                                   Length of the data, up to #OPTIGA_SIMULATOR_MAX_DATA_OBJECT_SIZE.
+ *
+ * \retval         #OPTIGA_COMMS_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_COMMS_ERROR_INVALID_INPUT        Wrong input arguments provided.
+ * \retval         #OPTIGA_COMMS_ERROR_MEMORY_INSUFFICIENT  All data objects are in use.
+ */
+optiga_lib_status_t optiga_simulator_write_data_object(uint8_t optiga_instance_id,
+                                                       uint16_t oid,
+                                                       const uint8_t * p_data,
+                                                       uint16_t length);
+
+/**
+ * \brief Provides the public key of a software key of a simulated OPTIGA instance.
+ *
+ * \details
+ * Provides the public key of the key 0xE0F0 - 0xE0F3, to verify the signatures of CalcSign.
+ * - The key is generated on the first use.
+ * - The public key is a DER BIT STRING, which contains the uncompressed point, as expected by
+ *   #optiga_crypt_ecdsa_verify and #pal_crypt_ecdsa_verify.
+ *
+ * \pre
+ * - None
+ *
+ * \note
+ * - None
+ *
+ * \param[in]      optiga_instance_id                       Instance of OPTIGA, less than OPTIGA_MAX_NUMBER_OF_INSTANCES.
+ * \param[in]      key_oid                                  Object identifier of the key.
+ * \param[out]     p_public_key                             Buffer to store the public key, must not be NULL.
+ * \param[in,out]  p_public_key_length                      Length of the buffer, updated with the length of the public key.
+ *
+ * \retval         #OPTIGA_COMMS_SUCCESS                    Successful invocation.
+ * \retval         #OPTIGA_COMMS_ERROR_INVALID_INPUT        Wrong input arguments provided.
+ * \retval         #OPTIGA_COMMS_ERROR_MEMORY_INSUFFICIENT  Buffer is too small.
+ * \retval         #OPTIGA_COMMS_ERROR                      Generation of the key failed.
+ */
+optiga_lib_status_t optiga_simulator_get_public_key(uint8_t optiga_instance_id,
+                                                    uint16_t key_oid,
+                                                    uint8_t * p_public_key,
+                                                    uint16_t * p_public_key_length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_OPTIGA_SIMULATOR_H_*/
+
+/**
+* @}
+*/
@@ -38,10 +38,101 @@
 #include <DAVE.h>
 #include "optiga/pal/pal_os_event.h"
 
+// !!!OPTIGA_LIB_PORTING_REQUIRED
+// The events are timed by a CCU4 slice in single shot mode and the registered callback is invoked directly from the
+// period match interrupt of the slice. The slice must not be used by any other part of the application.
+#ifndef PAL_OS_EVENT_CCU4_MODULE
+/// CCU4 module of the event timer
+#define PAL_OS_EVENT_CCU4_MODULE            (CCU41)
+/// CCU4 slice of the event timer
+#define PAL_OS_EVENT_CCU4_SLICE             (CCU41_CC40)
+/// Number of the slice within the module
+#define PAL_OS_EVENT_CCU4_SLICE_NUMBER      (0U)
+/// Interrupt line of the service request node 0 of the module
+#define PAL_OS_EVENT_CCU4_IRQN              (CCU41_0_IRQn)
+/// Handler of the interrupt line
+#define PAL_OS_EVENT_CCU4_IRQ_HANDLER       CCU41_0_IRQHandler
+#endif
+
+#ifndef PAL_OS_EVENT_CCU4_IRQ_PRIORITY
+/// Priority of the event timer interrupt, the registered callbacks are executed at this priority
+#define PAL_OS_EVENT_CCU4_IRQ_PRIORITY      (62U)
+#endif
+
+/// Ticks of the 16 bit slice timer armed at once, longer intervals are timed in several periods
+#define PAL_OS_EVENT_CCU4_MAX_PERIOD_TICKS  (0x10000U)
 
 /// @cond hidden
 
 static pal_os_event_t pal_os_event_0 = {0};
+/// Tick frequency of the slice timer in Hz, 0 until the timer is initialized
+static uint32_t pal_os_event_timer_frequency = 0;
+/// Ticks still to be timed after the currently running period
+static volatile uint32_t pal_os_event_remaining_ticks = 0;
+
+_STATIC_H void pal_os_event_timer_init(void)
+{
+    XMC_CCU4_SLICE_COMPARE_CONFIG_t timer_config = {0};
+    uint32_t ccu_frequency = XMC_SCU_CLOCK_GetCcuClockFrequency();
+    uint8_t prescaler = 0;
+
+    // The largest prescaler keeping a tick within a microsecond gives the longest period at microsecond resolution
+    while ((prescaler < 15U) && ((ccu_frequency >> (prescaler + 1U)) >= 1000000U))
+    {
+        prescaler++;
+    }
+    pal_os_event_timer_frequency = ccu_frequency >> prescaler;
+
+    timer_config.timer_mode = (uint32_t)XMC_CCU4_SLICE_TIMER_COUNT_MODE_EA;
+    timer_config.monoshot = (uint32_t)XMC_CCU4_SLICE_TIMER_REPEAT_MODE_SINGLE;
+    timer_config.prescaler_initval = prescaler;
+
+    XMC_CCU4_Init(PAL_OS_EVENT_CCU4_MODULE, XMC_CCU4_SLICE_MCMS_ACTION_TRANSFER_PR_CR);
+    XMC_CCU4_StartPrescaler(PAL_OS_EVENT_CCU4_MODULE);
+    XMC_CCU4_SLICE_CompareInit(PAL_OS_EVENT_CCU4_SLICE, &timer_config);
+    XMC_CCU4_SLICE_EnableEvent(PAL_OS_EVENT_CCU4_SLICE, XMC_CCU4_SLICE_IRQ_ID_PERIOD_MATCH);
+    XMC_CCU4_SLICE_SetInterruptNode(PAL_OS_EVENT_CCU4_SLICE,
+                                    XMC_CCU4_SLICE_IRQ_ID_PERIOD_MATCH,
+                                    XMC_CCU4_SLICE_SR_ID_0);
+    NVIC_SetPriority(PAL_OS_EVENT_CCU4_IRQN, PAL_OS_EVENT_CCU4_IRQ_PRIORITY);
+    NVIC_EnableIRQ(PAL_OS_EVENT_CCU4_IRQN);
+    XMC_CCU4_EnableClock(PAL_OS_EVENT_CCU4_MODULE, PAL_OS_EVENT_CCU4_SLICE_NUMBER);
+}
+
+_STATIC_H void pal_os_event_timer_stop(void)
+{
+    XMC_CCU4_SLICE_StopTimer(PAL_OS_EVENT_CCU4_SLICE);
+    XMC_CCU4_SLICE_ClearTimer(PAL_OS_EVENT_CCU4_SLICE);
+    XMC_CCU4_SLICE_ClearEvent(PAL_OS_EVENT_CCU4_SLICE, XMC_CCU4_SLICE_IRQ_ID_PERIOD_MATCH);
+    // A period match of an earlier interval must not expire the newly armed one
+    NVIC_ClearPendingIRQ(PAL_OS_EVENT_CCU4_IRQN);
+}
+
+_STATIC_H void pal_os_event_timer_arm(uint32_t ticks)
+{
+    uint32_t period_ticks = (ticks > PAL_OS_EVENT_CCU4_MAX_PERIOD_TICKS) ? PAL_OS_EVENT_CCU4_MAX_PERIOD_TICKS : ticks;
+
+    pal_os_event_remaining_ticks = ticks - period_ticks;
+    pal_os_event_timer_stop();
+    // The period match occurs one tick after the timer reached the period value
+    XMC_CCU4_SLICE_SetTimerPeriodMatch(PAL_OS_EVENT_CCU4_SLICE, (uint16_t)(period_ticks - 1U));
+    XMC_CCU4_EnableShadowTransfer(PAL_OS_EVENT_CCU4_MODULE,
+                                  (uint32_t)XMC_CCU4_SHADOW_TRANSFER_SLICE_0 << (4U * PAL_OS_EVENT_CCU4_SLICE_NUMBER));
+    XMC_CCU4_SLICE_StartTimer(PAL_OS_EVENT_CCU4_SLICE);
+}
+
+void PAL_OS_EVENT_CCU4_IRQ_HANDLER(void)
+{
+    XMC_CCU4_SLICE_ClearEvent(PAL_OS_EVENT_CCU4_SLICE, XMC_CCU4_SLICE_IRQ_ID_PERIOD_MATCH);
+    if (0U != pal_os_event_remaining_ticks)
+    {
+        pal_os_event_timer_arm(pal_os_event_remaining_ticks);
+    }
+    else
+    {
+        pal_os_event_trigger_registered_callback();
+    }
+}
 
 void pal_os_event_start(pal_os_event_t * p_pal_os_event, register_callback callback, void * callback_args)
 {
@@ -61,6 +152,10 @@ void pal_os_event_stop(pal_os_event_t * p_pal_os_event)
 
 pal_os_event_t * pal_os_event_create(register_callback callback, void * callback_args)
 {
+    if (0U == pal_os_event_timer_frequency)
+    {
+        pal_os_event_timer_init();
+    }
     if (( NULL != callback )&&( NULL != callback_args ))
     {
         pal_os_event_start(&pal_os_event_0,callback,callback_args);
@@ -72,12 +167,7 @@ void pal_os_event_trigger_registered_callback(void)
 {
     register_callback callback;
 
-    // !!!OPTIGA_LIB_PORTING_REQUIRED
-    // The following steps related to TIMER must be taken care while porting to different platform
-    TIMER_ClearEvent(&scheduler_timer);
-    //lint --e{534} suppress "Error handling is not required so return value is not checked"
-    TIMER_Stop(&scheduler_timer);
-    TIMER_Clear(&scheduler_timer);
+    pal_os_event_timer_stop();
     /// If callback_ctx is NULL then callback function will have unexpected behavior 
     if (pal_os_event_0.callback_registered)
     {
@@ -92,20 +182,37 @@ void pal_os_event_register_callback_oneshot(pal_os_event_t * p_pal_os_event,
                                              void * callback_args,
                                              uint32_t time_us)
 {
+    uint32_t ticks;
+
+    if (0U == pal_os_event_timer_frequency)
+    {
+        pal_os_event_timer_init();
+    }
+    // Rounded up, so that the callback is never invoked before the requested time elapsed
+    ticks = (uint32_t)((((uint64_t)time_us * pal_os_event_timer_frequency) + 999999U) / 1000000U);
+    if (0U == ticks)
+    {
+        ticks = 1U;
+    }
+
+    // The timer interrupt must not observe a partially registered event
+    NVIC_DisableIRQ(PAL_OS_EVENT_CCU4_IRQN);
     p_pal_os_event->callback_registered = callback;
     p_pal_os_event->callback_ctx = callback_args;
-
-    // !!!OPTIGA_LIB_PORTING_REQUIRED
-    // The following steps related to TIMER must be taken care while porting to different platform
-    //lint --e{534} suppress "Error handling is not required so return value is not checked"
-    TIMER_SetTimeInterval(&scheduler_timer, (time_us * 100));
-    TIMER_Start(&scheduler_timer);
+    pal_os_event_timer_arm(ticks);
+    NVIC_EnableIRQ(PAL_OS_EVENT_CCU4_IRQN);
 }
 
-//lint --e{818,715} suppress "As there is no implementation, pal_os_event is not used"
+//lint --e{818,715} suppress "pal_os_event is not used as there is a single event"
 void pal_os_event_destroy(pal_os_event_t * pal_os_event)
 {
-    
+    if (0U != pal_os_event_timer_frequency)
+    {
+        NVIC_DisableIRQ(PAL_OS_EVENT_CCU4_IRQN);
+        pal_os_event_remaining_ticks = 0;
+        pal_os_event_timer_stop();
+        NVIC_EnableIRQ(PAL_OS_EVENT_CCU4_IRQN);
+    }
 }
 
 /**
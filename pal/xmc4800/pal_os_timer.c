@@ -40,12 +40,39 @@
 
 /// @cond hidden
 static volatile uint32_t g_tick_count = 0;
+/// Microseconds elapsed, extended in software from the DWT cycle counter
+static uint32_t g_time_us = 0;
+/// Cycle count of the last update of g_time_us
+static uint32_t g_time_us_last_cycle_count = 0;
+/// Cycles counted since the last update, which did not add up to a full microsecond yet
+static uint32_t g_time_us_remainder_cycles = 0;
+
+_STATIC_H uint32_t pal_os_timer_update_time_in_microseconds(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint32_t cycles_per_us = SystemCoreClock / 1000000U;
+    uint32_t cycle_count;
+    uint32_t time_us;
+
+    __disable_irq();
+    cycle_count = pal_os_timer_get_cycle_count();
+    // The cycle counter wraps within seconds, it is folded into the microseconds at least with every tick
+    g_time_us_remainder_cycles += cycle_count - g_time_us_last_cycle_count;
+    g_time_us_last_cycle_count = cycle_count;
+    g_time_us += g_time_us_remainder_cycles / cycles_per_us;
+    g_time_us_remainder_cycles %= cycles_per_us;
+    time_us = g_time_us;
+    __set_PRIMASK(primask);
+
+    return (time_us);
+}
 
 void delay_timer_isr(void)
 {
     TIMER_ClearEvent(&tick_timer);
     (void)TIMER_Clear(&tick_timer);
     g_tick_count += 1U;
+    (void)pal_os_timer_update_time_in_microseconds();
 }
 
 /// @endcond
@@ -53,11 +80,8 @@ void delay_timer_isr(void)
 
 uint32_t pal_os_timer_get_time_in_microseconds(void)
 {
-    // !!!OPTIGA_LIB_PORTING_REQUIRED
-    // This API is needed to support optiga cmd scheduler. 
-    static uint32_t count = 0;
-    // The implementation must ensure that every invocation of this API returns a unique value.
-    return (count++);
+    // This API is needed to support optiga cmd scheduler and the deadlines of the event queue.
+    return (pal_os_timer_update_time_in_microseconds());
 }
 
 uint32_t pal_os_timer_get_time_in_milliseconds(void)
@@ -65,6 +89,18 @@ uint32_t pal_os_timer_get_time_in_milliseconds(void)
     return (g_tick_count);
 }
 
+uint32_t pal_os_timer_get_cycle_count(void)
+{
+    // The DWT cycle counter is enabled with the first use
+    if (0U == (DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk))
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0U;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    return (DWT->CYCCNT);
+}
+
 void pal_os_timer_delay_in_milliseconds(uint16_t milliseconds)
 {
     uint32_t start_time;
@@ -38,9 +38,12 @@
 
 #include "optiga/pal/pal.h"
 
+extern pal_status_t pal_os_event_init(void);
+
 pal_status_t pal_init(void)
 {
-    return PAL_STATUS_SUCCESS;
+    // Creates the task, which invokes the callbacks of the OPTIGA host library
+    return pal_os_event_init();
 }
 
 
@@ -47,6 +47,13 @@
  * MACROS
  *********************************************************************************************************************/
 #define PAL_I2C_MASTER_MAX_BITRATE  (400)
+
+/*
+* Define PAL_I2C_DMA_ENABLED to transfer the frames by DMA. The I2C_MASTER APP instance must be configured
+* with DMA as transmit and receive mode in DAVE, hence I2C_MASTER_Transmit and I2C_MASTER_Receive start DMA transfers
+* and the end of transmit/receive callback is the only interrupt per frame. pal_i2c_init fails otherwise,
+* instead of silently falling back to the interrupt per byte transfers.
+*/
 /// @cond hidden
 /*********************************************************************************************************************
  * LOCAL DATA
@@ -237,6 +244,16 @@ pal_status_t pal_i2c_init(const pal_i2c_t* p_i2c_context)
 		if (status == 0) {
 			status = PAL_STATUS_SUCCESS;
 		}
+#ifdef PAL_I2C_DMA_ENABLED
+		if ((I2C_MASTER_TRANSFER_MODE_DMA != i2c_master_0.config->transmit_mode) ||
+		    (I2C_MASTER_TRANSFER_MODE_DMA != i2c_master_0.config->receive_mode))
+		{
+			// The task is not started, hence the next init checks the configuration again
+			vSemaphoreDelete(xIicSemaphoreHandle);
+			xIicSemaphoreHandle = NULL;
+			return PAL_STATUS_FAILURE;
+		}
+#endif //PAL_I2C_DMA_ENABLED
 
 		/* Create the handler for the callbacks. */
 		xTaskCreate( i2c_result_handler,       /* Function that implements the task. */
@@ -34,6 +34,7 @@
  * HEADER FILES
  *********************************************************************************************************************/
 #include "optiga/pal/pal_os_event.h"
+#include "optiga/pal/pal.h"
 
 #include "FreeRTOS.h"
 #include "task.h"
@@ -41,16 +42,38 @@
 /**********************************************************************************************************************
  * MACROS
  *********************************************************************************************************************/
+/*
+* Priority of the task, which invokes the registered callbacks.
+* The callbacks drive the OPTIGA protocol, hence the task is preferred over the application tasks.
+*/
+#ifndef PAL_OS_EVENT_TASK_PRIORITY
+#define PAL_OS_EVENT_TASK_PRIORITY      (configMAX_PRIORITIES - 1)
+#endif
+/// Stack size of the task in words, which invokes the registered callbacks
+#ifndef PAL_OS_EVENT_TASK_STACK_SIZE
+#define PAL_OS_EVENT_TASK_STACK_SIZE    (configMINIMAL_STACK_SIZE * 5)
+#endif
+/// Period of the tick in microseconds
+#define PAL_OS_EVENT_TICK_PERIOD_US     (portTICK_PERIOD_MS * 1000U)
+/// Number of events, one for each OPTIGA instance
+#ifdef OPTIGA_MAX_NUMBER_OF_INSTANCES
+#define PAL_OS_EVENT_MAX_INSTANCES      OPTIGA_MAX_NUMBER_OF_INSTANCES
+#else
+#define PAL_OS_EVENT_MAX_INSTANCES      (1)
+#endif
+/// Index of the event in the list
+#define PAL_OS_EVENT_INDEX(p_event)     ((uint32_t)((p_event) - pal_os_event_list))
 
 /*********************************************************************************************************************
  * LOCAL DATA
  *********************************************************************************************************************/
 /// @cond hidden
-/// Callback function when timer elapses
-static volatile register_callback callback_registered = NULL;
-
-static pal_os_event_t pal_os_event_0 = {0};
-static uint32_t pal_os_ts_0 = 0;
+static pal_os_event_t pal_os_event_list[PAL_OS_EVENT_MAX_INSTANCES] = {0};
+/// Tick count at the registration of the callback of each event
+static TickType_t pal_os_event_ts_start[PAL_OS_EVENT_MAX_INSTANCES] = {0};
+/// Delay of the registered callback of each event in ticks
+static TickType_t pal_os_event_ts_delay[PAL_OS_EVENT_MAX_INSTANCES] = {0};
+static TaskHandle_t pal_os_event_task = NULL;
 
 void pal_os_event_start(pal_os_event_t * p_pal_os_event, register_callback callback, void * callback_args)
 {
@@ -66,37 +89,126 @@ void pal_os_event_stop(pal_os_event_t * p_pal_os_event)
     //lint --e{714} suppress "The API pal_os_event_stop is not exposed in header file but used as extern in
     //optiga_cmd.c"
     p_pal_os_event->is_event_triggered = FALSE;
+    // The scheduler is parked, hence the task blocks until the next registration
+    taskENTER_CRITICAL();
+    p_pal_os_event->callback_registered = NULL;
+    taskEXIT_CRITICAL();
+    if (NULL != pal_os_event_task)
+    {
+        xTaskNotifyGive(pal_os_event_task);
+    }
 }
 
 pal_os_event_t * pal_os_event_create(register_callback callback, void * callback_args)
 {
+    pal_os_event_t * p_pal_os_event = &pal_os_event_list[0];
+    uint8_t index;
+
 	if (( NULL != callback )&&( NULL != callback_args ))
     {
-        pal_os_event_start(&pal_os_event_0,callback,callback_args);
+        // Pick the first event, which is not in use by another OPTIGA instance
+        taskENTER_CRITICAL();
+        for (index = 0; index < PAL_OS_EVENT_MAX_INSTANCES; index++)
+        {
+            if (NULL == pal_os_event_list[index].os_timer)
+            {
+                // The events share the task, the member only marks the event in use
+                pal_os_event_list[index].os_timer = &pal_os_event_ts_delay[index];
+                break;
+            }
+        }
+        taskEXIT_CRITICAL();
+        if (PAL_OS_EVENT_MAX_INSTANCES == index)
+        {
+            return (NULL);
+        }
+        p_pal_os_event = &pal_os_event_list[index];
+        pal_os_event_start(p_pal_os_event,callback,callback_args);
     }
-    return (&pal_os_event_0);
+    return (p_pal_os_event);
 }
 
 /**
-*  Timer callback handler.
+*  Event task handler.
 *
-*  This get called from the TIMER elapse event.<br>
-*  Once the timer expires, the registered callback funtion gets called from the timer event handler, if
-*  the call back is not NULL.<br>
-*
-*\param[in] args Callback argument
+*  The task serves the events of all the OPTIGA instances.<br>
+*  The task blocks until the earliest registered callback is due, and without timeout while no callback is registered.<br>
+*  Hence no tick or timer wakes up the system while the OPTIGA is idle, which lets the idle task enter the
+*  low power mode with configUSE_TICKLESS_IDLE for the whole idle time.<br>
+*  The task is woken up by the registration of a callback (e.g. the submission of a request), and invokes the
+*  registered callback funtion once it is due.<br>
 *
 */
 void pal_os_event_trigger_registered_callback(void)
 {
     register_callback callback;
+    void * callback_ctx = NULL;
+    TickType_t elapsed_ticks;
+    TickType_t wait_ticks;
+    uint32_t index;
+
+    do
+    {
+        callback = NULL;
+        // Blocks indefinitely with INCLUDE_vTaskSuspend
+        wait_ticks = portMAX_DELAY;
+        taskENTER_CRITICAL();
+        for (index = 0; index < PAL_OS_EVENT_MAX_INSTANCES; index++)
+        {
+            if (NULL == pal_os_event_list[index].callback_registered)
+            {
+                continue;
+            }
+            // Elapsed time is not affected by the overflow of the tick count
+            elapsed_ticks = xTaskGetTickCount() - pal_os_event_ts_start[index];
+            if (elapsed_ticks >= pal_os_event_ts_delay[index])
+            {
+                // One due callback at a time, the others are picked up in the next iteration
+                callback = pal_os_event_list[index].callback_registered;
+                callback_ctx = pal_os_event_list[index].callback_ctx;
+                pal_os_event_list[index].callback_registered = NULL;
+                break;
+            }
+            if ((pal_os_event_ts_delay[index] - elapsed_ticks) < wait_ticks)
+            {
+                wait_ticks = pal_os_event_ts_delay[index] - elapsed_ticks;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if (NULL != callback)
+        {
+            callback(callback_ctx);
+        }
+        else
+        {
+            (void)ulTaskNotifyTake(pdTRUE, wait_ticks);
+        }
+    } while (1);
+}
 
-    if ((pal_os_ts_0 != 0) && (pal_os_ts_0 < xTaskGetTickCount()) && pal_os_event_0.callback_registered)
+static void _pal_os_event_trigger_registered_callback(void * pvParameters)
+{
+    pal_os_event_trigger_registered_callback();
+}
+
+pal_status_t pal_os_event_init(void)
+{
+    pal_status_t status = PAL_STATUS_SUCCESS;
+
+    if (NULL == pal_os_event_task)
     {
-    	pal_os_ts_0 = 0;
-		callback = pal_os_event_0.callback_registered;
-		callback((void * )pal_os_event_0.callback_ctx);
+        if (pdPASS != xTaskCreate(_pal_os_event_trigger_registered_callback, /* Function that implements the task. */
+                                  "TrstEvtHndlr",                /* Text name for the task. */
+                                  PAL_OS_EVENT_TASK_STACK_SIZE,  /* Stack size in words, not bytes. */
+                                  NULL,                          /* Parameter passed into the task. */
+                                  PAL_OS_EVENT_TASK_PRIORITY,    /* Priority at which the task is created. */
+                                  &pal_os_event_task))           /* Used to pass out the created task's handle. */
+        {
+            status = PAL_STATUS_FAILURE;
+        }
     }
+    return status;
 }
 /// @endcond
 
@@ -106,8 +218,8 @@ void pal_os_event_trigger_registered_callback(void)
 *
 * <b>API Details:</b>
 *         This function registers the callback function supplied by the caller.<br>
-*         It triggers a timer with the supplied time interval in microseconds.<br>
-*         Once the timer expires, the registered callback function gets called.<br>
+*         It wakes up the event task, which invokes the registered callback function once the supplied time
+*         interval in microseconds is elapsed. The interval is rounded up to the next tick.<br>
 *
 * \param[in] callback              Callback function pointer
 * \param[in] callback_args         Callback arguments
@@ -119,23 +231,33 @@ void pal_os_event_register_callback_oneshot(pal_os_event_t * p_pal_os_event,
                                             void* callback_args,
                                             uint32_t time_us)
 {
-	pal_os_event_0.callback_registered = callback;
-	pal_os_event_0.callback_ctx = callback_args;
-
-	pal_os_ts_0 = xTaskGetTickCount() + pdMS_TO_TICKS(time_us/1000);
+    taskENTER_CRITICAL();
+	p_pal_os_event->callback_registered = callback;
+	p_pal_os_event->callback_ctx = callback_args;
+    pal_os_event_ts_start[PAL_OS_EVENT_INDEX(p_pal_os_event)] = xTaskGetTickCount();
+    pal_os_event_ts_delay[PAL_OS_EVENT_INDEX(p_pal_os_event)] = (TickType_t)((time_us + PAL_OS_EVENT_TICK_PERIOD_US - 1U) / PAL_OS_EVENT_TICK_PERIOD_US);
+    taskEXIT_CRITICAL();
+    // The task recalculates the time to block
+    if (NULL != pal_os_event_task)
+    {
+        xTaskNotifyGive(pal_os_event_task);
+    }
 }
 
 /**
 * @}
 */
 
-//lint --e{818,715} suppress "As there is no implementation, pal_os_event is not used"
 void pal_os_event_destroy(pal_os_event_t * pal_os_event)
 {
-
+    taskENTER_CRITICAL();
+    pal_os_event->callback_registered = NULL;
+    pal_os_event->is_event_triggered = FALSE;
+    // event is free for next create
+    pal_os_event->os_timer = NULL;
+    taskEXIT_CRITICAL();
 }
 
 /**
 * @}
 */
-
@@ -0,0 +1,103 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_os_wait.c
+*
+* \brief   This file implements the platform abstraction layer APIs for os wait object (FreeRTOS semaphore).
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include "optiga/pal/pal_os_wait.h"
+#include "xmc_common.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+pal_status_t pal_os_wait_create(pal_os_wait_t * p_wait)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    SemaphoreHandle_t semaphore = xSemaphoreCreateBinary();
+
+    if (NULL != semaphore)
+    {
+        p_wait->os_wait_object = (void *)semaphore;
+        p_wait->is_signaled = FALSE;
+        return_status = PAL_STATUS_SUCCESS;
+    }
+    return return_status;
+}
+
+void pal_os_wait_destroy(pal_os_wait_t * p_wait)
+{
+    if (NULL != p_wait->os_wait_object)
+    {
+        vSemaphoreDelete((SemaphoreHandle_t)p_wait->os_wait_object);
+        p_wait->os_wait_object = NULL;
+    }
+}
+
+void pal_os_wait_for_signal(pal_os_wait_t * p_wait)
+{
+    (void)xSemaphoreTake((SemaphoreHandle_t)p_wait->os_wait_object, portMAX_DELAY);
+    p_wait->is_signaled = FALSE;
+}
+
+bool_t pal_os_wait_clear_signal(pal_os_wait_t * p_wait)
+{
+    p_wait->is_signaled = FALSE;
+    return (pdTRUE == xSemaphoreTake((SemaphoreHandle_t)p_wait->os_wait_object, 0)) ? TRUE : FALSE;
+}
+
+//lint --e{715} suppress "p_wait is not used here as there is no pollable descriptor."
+int32_t pal_os_wait_get_descriptor(const pal_os_wait_t * p_wait)
+{
+    return (-1);
+}
+
+void pal_os_wait_signal(pal_os_wait_t * p_wait)
+{
+    BaseType_t higher_priority_task_woken = pdFALSE;
+
+    p_wait->is_signaled = TRUE;
+    // Callbacks can be invoked from interrupt context (e.g. tick hook)
+    if (0U != __get_IPSR())
+    {
+        (void)xSemaphoreGiveFromISR((SemaphoreHandle_t)p_wait->os_wait_object, &higher_priority_task_woken);
+        portYIELD_FROM_ISR(higher_priority_task_woken);
+    }
+    else
+    {
+        (void)xSemaphoreGive((SemaphoreHandle_t)p_wait->os_wait_object);
+    }
+}
+
+/**
+* @}
+*/
@@ -0,0 +1,79 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal.c
+*
+* \brief   This file implements the platform abstraction layer APIs.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include <zephyr/init.h>
+#include "optiga/pal/pal.h"
+#include "pal_zephyr.h"
+
+/// @cond hidden
+K_THREAD_STACK_DEFINE(pal_zephyr_work_q_stack, PAL_ZEPHYR_WORK_Q_STACK_SIZE);
+
+struct k_work_q pal_zephyr_work_q;
+
+// Started at boot, since pal_init is only invoked with OPTIGA_PAL_INIT_ENABLED
+static int pal_zephyr_work_q_init(void)
+{
+    const struct k_work_queue_config config = {
+        .name = "optiga_pal",
+        .no_yield = false,
+    };
+
+    k_work_queue_start(&pal_zephyr_work_q,
+                       pal_zephyr_work_q_stack,
+                       K_THREAD_STACK_SIZEOF(pal_zephyr_work_q_stack),
+                       PAL_ZEPHYR_WORK_Q_PRIORITY,
+                       &config);
+    return 0;
+}
+
+SYS_INIT(pal_zephyr_work_q_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+/// @endcond
+
+pal_status_t pal_init(void)
+{
+    return PAL_STATUS_SUCCESS;
+}
+
+
+pal_status_t pal_deinit(void)
+{
+    return PAL_STATUS_SUCCESS;
+}
+
+/**
+* @}
+*/
@@ -0,0 +1,170 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_gpio.c
+*
+* \brief   This file implements the platform abstraction layer APIs for GPIO.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+
+#include "optiga/pal/pal_gpio.h"
+#include "pal_zephyr.h"
+
+/// Edge of the interrupt pin, which signals the data ready state (active level of the devicetree flags)
+#ifndef PAL_GPIO_IRQ_EDGE
+#define PAL_GPIO_IRQ_EDGE           GPIO_INT_EDGE_TO_ACTIVE
+#endif
+
+/// @cond hidden
+// Provides the pin of the context, NULL if no pin is assigned in the devicetree
+static pal_zephyr_gpio_t * pal_gpio_get(const pal_gpio_t * p_gpio_context)
+{
+    pal_zephyr_gpio_t * gpio = NULL;
+
+    if ((p_gpio_context != NULL) && (p_gpio_context->p_gpio_hw != NULL))
+    {
+        gpio = (pal_zephyr_gpio_t *)p_gpio_context->p_gpio_hw;
+        if ((NULL == gpio->spec.port) || (!gpio_is_ready_dt(&gpio->spec)))
+        {
+            gpio = NULL;
+        }
+    }
+    return gpio;
+}
+
+// Invoked in interrupt context by the GPIO driver
+static void pal_gpio_irq_callback(const struct device * port, struct gpio_callback * callback, gpio_port_pins_t pins)
+{
+    pal_zephyr_gpio_t * gpio = CONTAINER_OF(callback, pal_zephyr_gpio_t, callback);
+    pal_gpio_irq_handler_t handler = gpio->irq_handler;
+
+    (void)port;
+    (void)pins;
+    if (NULL != handler)
+    {
+        handler(gpio->irq_context);
+    }
+}
+/// @endcond
+
+pal_status_t pal_gpio_init(const pal_gpio_t * p_gpio_context)
+{
+    pal_zephyr_gpio_t * gpio = pal_gpio_get(p_gpio_context);
+
+    if ((NULL != gpio) && (0 != gpio_pin_configure_dt(&gpio->spec, GPIO_OUTPUT_ACTIVE)))
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    return PAL_STATUS_SUCCESS;
+}
+
+pal_status_t pal_gpio_deinit(const pal_gpio_t * p_gpio_context)
+{
+    pal_zephyr_gpio_t * gpio = pal_gpio_get(p_gpio_context);
+
+    if (NULL != gpio)
+    {
+        (void)pal_gpio_register_irq(p_gpio_context, NULL, NULL);
+        (void)gpio_pin_configure_dt(&gpio->spec, GPIO_DISCONNECTED);
+    }
+    return PAL_STATUS_SUCCESS;
+}
+
+pal_status_t pal_gpio_register_irq(const pal_gpio_t * p_gpio_context,
+                                   pal_gpio_irq_handler_t handler,
+                                   void * p_context)
+{
+    pal_status_t status = PAL_STATUS_FAILURE;
+    pal_zephyr_gpio_t * gpio = pal_gpio_get(p_gpio_context);
+
+    do
+    {
+        if (NULL == gpio)
+        {
+            // No pin in the devicetree, hence the status register is polled
+            break;
+        }
+        // The previous handler is removed, the pin is configured again as input if a handler is provided
+        (void)gpio_pin_interrupt_configure_dt(&gpio->spec, GPIO_INT_DISABLE);
+        if (NULL != gpio->irq_handler)
+        {
+            (void)gpio_remove_callback_dt(&gpio->spec, &gpio->callback);
+            gpio->irq_handler = NULL;
+        }
+        if (NULL == handler)
+        {
+            status = PAL_STATUS_SUCCESS;
+            break;
+        }
+        if (0 != gpio_pin_configure_dt(&gpio->spec, GPIO_INPUT))
+        {
+            break;
+        }
+        gpio->irq_context = p_context;
+        gpio->irq_handler = handler;
+        gpio_init_callback(&gpio->callback, pal_gpio_irq_callback, BIT(gpio->spec.pin));
+        if ((0 != gpio_add_callback_dt(&gpio->spec, &gpio->callback)) ||
+            (0 != gpio_pin_interrupt_configure_dt(&gpio->spec, PAL_GPIO_IRQ_EDGE)))
+        {
+            (void)gpio_remove_callback_dt(&gpio->spec, &gpio->callback);
+            gpio->irq_handler = NULL;
+            break;
+        }
+        status = PAL_STATUS_SUCCESS;
+    } while (0);
+
+    return status;
+}
+
+void pal_gpio_set_high(const pal_gpio_t * p_gpio_context)
+{
+    pal_zephyr_gpio_t * gpio = pal_gpio_get(p_gpio_context);
+
+    if (NULL != gpio)
+    {
+        (void)gpio_pin_set_dt(&gpio->spec, 1);
+    }
+}
+
+void pal_gpio_set_low(const pal_gpio_t * p_gpio_context)
+{
+    pal_zephyr_gpio_t * gpio = pal_gpio_get(p_gpio_context);
+
+    if (NULL != gpio)
+    {
+        (void)gpio_pin_set_dt(&gpio->spec, 0);
+    }
+}
+
+/**
+* @}
+*/
@@ -0,0 +1,232 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_i2c.c
+*
+* \brief   This file implements the platform abstraction layer(pal) APIs for I2C.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+
+#include "optiga/pal/pal_i2c.h"
+#include "pal_zephyr.h"
+
+/*
+* With CONFIG_I2C_CALLBACK, the transfers are started with i2c_transfer_cb and the driver reports the completion from
+* its interrupt. Otherwise the transfer is executed by i2c_transfer on the PAL work queue. In both cases the calling
+* thread is not blocked during the transfer and the upper layer is informed on the PAL work queue.
+*/
+
+/// Maximum bitrate of the I2C master in KHz (I2C_SPEED_FAST_PLUS)
+#ifndef PAL_I2C_MASTER_MAX_BITRATE
+#define PAL_I2C_MASTER_MAX_BITRATE      (1000U)
+#endif
+
+/// @cond hidden
+static pal_status_t pal_i2c_acquire(pal_zephyr_i2c_t * p_bus, const pal_i2c_t * p_i2c_context)
+{
+    // Devices on the same bus share the context, a busy bus is retried by the upper layer
+    if (atomic_cas(&p_bus->entry_count, 0, 1))
+    {
+        p_bus->p_current_ctx = p_i2c_context;
+        return PAL_STATUS_SUCCESS;
+    }
+    return PAL_STATUS_FAILURE;
+}
+
+static void pal_i2c_release(pal_zephyr_i2c_t * p_bus)
+{
+    (void)atomic_set(&p_bus->entry_count, 0);
+}
+
+static void pal_i2c_invoke_upper_layer_callback(const pal_i2c_t * p_pal_i2c_ctx, uint16_t event)
+{
+    upper_layer_callback_t upper_layer_handler;
+
+    upper_layer_handler = (upper_layer_callback_t)p_pal_i2c_ctx->upper_layer_event_handler;
+    upper_layer_handler(p_pal_i2c_ctx->p_upper_layer_ctx, event);
+}
+
+/*
+* Completion of the transfer on the PAL work queue.
+* The bus is released before the upper layer is informed, since it continues the protocol with the next transfer.
+*/
+static void pal_i2c_completion_work(struct k_work * p_work)
+{
+    pal_zephyr_i2c_t * p_bus = CONTAINER_OF(p_work, pal_zephyr_i2c_t, completion_work);
+    const pal_i2c_t * p_i2c_context = (const pal_i2c_t *)p_bus->p_current_ctx;
+
+#ifndef CONFIG_I2C_CALLBACK
+    p_bus->result = i2c_transfer(p_bus->bus, &p_bus->msg, 1, p_i2c_context->slave_address);
+#endif
+    pal_i2c_release(p_bus);
+    // A NACK of OPTIGA, while it is busy, is reported as error and polled again by the upper layer
+    pal_i2c_invoke_upper_layer_callback(p_i2c_context, (0 == p_bus->result) ? PAL_I2C_EVENT_SUCCESS :
+                                                                              PAL_I2C_EVENT_ERROR);
+}
+
+#ifdef CONFIG_I2C_CALLBACK
+// Completion of the transfer, invoked from the interrupt of the I2C driver
+static void pal_i2c_transfer_done(const struct device * dev, int result, void * p_data)
+{
+    pal_zephyr_i2c_t * p_bus = (pal_zephyr_i2c_t *)p_data;
+
+    (void)dev;
+    p_bus->result = result;
+    (void)k_work_submit_to_queue(&pal_zephyr_work_q, &p_bus->completion_work);
+}
+#endif
+
+static pal_status_t pal_i2c_transfer(const pal_i2c_t * p_i2c_context, uint8_t * p_data, uint16_t length, uint8_t flags)
+{
+    pal_status_t status = PAL_STATUS_FAILURE;
+    pal_zephyr_i2c_t * p_bus;
+    int ret;
+
+    if ((p_i2c_context == NULL) || (p_i2c_context->p_i2c_hw_config == NULL) || (0 == length))
+    {
+        return status;
+    }
+    p_bus = (pal_zephyr_i2c_t *)p_i2c_context->p_i2c_hw_config;
+
+    if (PAL_STATUS_SUCCESS != pal_i2c_acquire(p_bus, p_i2c_context))
+    {
+        pal_i2c_invoke_upper_layer_callback(p_i2c_context, PAL_I2C_EVENT_BUSY);
+        return PAL_STATUS_I2C_BUSY;
+    }
+
+    // The message is referenced by the driver until the completion
+    p_bus->msg.buf = p_data;
+    p_bus->msg.len = length;
+    p_bus->msg.flags = flags | I2C_MSG_STOP;
+#ifdef CONFIG_I2C_CALLBACK
+    ret = i2c_transfer_cb(p_bus->bus, &p_bus->msg, 1, p_i2c_context->slave_address, pal_i2c_transfer_done, p_bus);
+#else
+    ret = k_work_submit_to_queue(&pal_zephyr_work_q, &p_bus->completion_work);
+    ret = (ret < 0) ? ret : 0;
+#endif
+    if (0 == ret)
+    {
+        status = PAL_STATUS_SUCCESS;
+    }
+    else
+    {
+        pal_i2c_release(p_bus);
+        pal_i2c_invoke_upper_layer_callback(p_i2c_context, (-EBUSY == ret) ? PAL_I2C_EVENT_BUSY : PAL_I2C_EVENT_ERROR);
+    }
+    return status;
+}
+/// @endcond
+
+pal_status_t pal_i2c_init(const pal_i2c_t * p_i2c_context)
+{
+    pal_zephyr_i2c_t * p_bus;
+
+    if ((p_i2c_context == NULL) || (p_i2c_context->p_i2c_hw_config == NULL))
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    p_bus = (pal_zephyr_i2c_t *)p_i2c_context->p_i2c_hw_config;
+    if (!device_is_ready(p_bus->bus))
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    // Devices on the same bus share the work item, it is not initialized again while a transfer is in progress
+    if (NULL == p_bus->completion_work.handler)
+    {
+        k_work_init(&p_bus->completion_work, pal_i2c_completion_work);
+    }
+    return PAL_STATUS_SUCCESS;
+}
+
+pal_status_t pal_i2c_deinit(const pal_i2c_t * p_i2c_context)
+{
+    (void)p_i2c_context;
+    return PAL_STATUS_SUCCESS;
+}
+
+pal_status_t pal_i2c_write(const pal_i2c_t * p_i2c_context, uint8_t * p_data, uint16_t length)
+{
+    return pal_i2c_transfer(p_i2c_context, p_data, length, I2C_MSG_WRITE);
+}
+
+pal_status_t pal_i2c_read(const pal_i2c_t * p_i2c_context, uint8_t * p_data, uint16_t length)
+{
+    return pal_i2c_transfer(p_i2c_context, p_data, length, I2C_MSG_READ);
+}
+
+pal_status_t pal_i2c_set_bitrate(const pal_i2c_t * p_i2c_context, uint16_t bitrate)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    optiga_lib_status_t event = PAL_I2C_EVENT_ERROR;
+    pal_zephyr_i2c_t * p_bus;
+    uint32_t speed;
+
+    if ((p_i2c_context == NULL) || (p_i2c_context->p_i2c_hw_config == NULL))
+    {
+        return return_status;
+    }
+    p_bus = (pal_zephyr_i2c_t *)p_i2c_context->p_i2c_hw_config;
+
+    //Acquire the I2C bus before setting the bitrate
+    if (PAL_STATUS_SUCCESS == pal_i2c_acquire(p_bus, p_i2c_context))
+    {
+        // If the user provided bitrate is greater than the I2C master hardware maximum supported value,
+        // set the I2C master to its maximum supported value.
+        if (bitrate > PAL_I2C_MASTER_MAX_BITRATE)
+        {
+            bitrate = PAL_I2C_MASTER_MAX_BITRATE;
+        }
+        // Zephyr configures the speed classes only, the bitrate is rounded down to the next class
+        speed = (bitrate >= 1000U) ? I2C_SPEED_FAST_PLUS : ((bitrate >= 400U) ? I2C_SPEED_FAST : I2C_SPEED_STANDARD);
+        if (0 == i2c_configure(p_bus->bus, I2C_MODE_CONTROLLER | I2C_SPEED_SET(speed)))
+        {
+            return_status = PAL_STATUS_SUCCESS;
+            event = PAL_I2C_EVENT_SUCCESS;
+        }
+        pal_i2c_release(p_bus);
+    }
+    else
+    {
+        return_status = PAL_STATUS_I2C_BUSY;
+        event = PAL_I2C_EVENT_BUSY;
+    }
+    if (0 != p_i2c_context->upper_layer_event_handler)
+    {
+        //lint --e{611} suppress "void* function pointer is type casted to upper_layer_callback_t  type"
+        ((upper_layer_callback_t)(p_i2c_context->upper_layer_event_handler))(p_i2c_context->p_upper_layer_ctx, event);
+    }
+    return return_status;
+}
+
+/**
+* @}
+*/
@@ -0,0 +1,125 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_ifx_i2c_config.c
+*
+* \brief   This file implements platform abstraction layer configurations for ifx i2c protocol.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include "optiga/pal/pal_gpio.h"
+#include "optiga/pal/pal_i2c.h"
+#include "optiga/ifx_i2c/ifx_i2c_config.h"
+#include "pal_zephyr.h"
+
+/**
+ * Devicetree node of OPTIGA, a child of the I2C bus with the binding infineon,optiga-trust-m (dts/bindings), e.g.
+ *
+ *     &i2c0 {
+ *         optiga: optiga@30 {
+ *             compatible = "infineon,optiga-trust-m";
+ *             reg = <0x30>;
+ *             reset-gpios = <&gpio0 25 GPIO_ACTIVE_HIGH>;
+ *             irq-gpios = <&gpio0 27 GPIO_ACTIVE_HIGH>;
+ *         };
+ *     };
+ *
+ * The vdd, reset and irq pins are optional.
+ */
+#ifndef PAL_ZEPHYR_OPTIGA_NODE
+#define PAL_ZEPHYR_OPTIGA_NODE                      DT_NODELABEL(optiga)
+#endif
+
+pal_zephyr_i2c_t zephyr_i2c_ctx_0 =
+{
+    .bus = DEVICE_DT_GET(DT_BUS(PAL_ZEPHYR_OPTIGA_NODE)),
+};
+
+pal_zephyr_gpio_t zephyr_vdd_0 =
+{
+    .spec = GPIO_DT_SPEC_GET_OR(PAL_ZEPHYR_OPTIGA_NODE, vdd_gpios, {0}),
+};
+
+pal_zephyr_gpio_t zephyr_reset_0 =
+{
+    .spec = GPIO_DT_SPEC_GET_OR(PAL_ZEPHYR_OPTIGA_NODE, reset_gpios, {0}),
+};
+
+pal_zephyr_gpio_t zephyr_irq_0 =
+{
+    .spec = GPIO_DT_SPEC_GET_OR(PAL_ZEPHYR_OPTIGA_NODE, irq_gpios, {0}),
+};
+
+/**
+ * \brief PAL I2C configuration for OPTIGA.
+ */
+pal_i2c_t optiga_pal_i2c_context_0 =
+{
+    /// Pointer to I2C master platform specific context
+    (void*)&zephyr_i2c_ctx_0,
+    /// Slave address
+    DT_REG_ADDR(PAL_ZEPHYR_OPTIGA_NODE),
+    /// Upper layer context
+    NULL,
+    /// Callback event handler
+    NULL
+};
+
+/**
+ * \brief PAL vdd pin configuration for OPTIGA.
+ */
+pal_gpio_t optiga_vdd_0 =
+{
+    // Platform specific GPIO context for the pin used to toggle Vdd.
+    (void*)&zephyr_vdd_0
+};
+
+/**
+ * \brief PAL reset pin configuration for OPTIGA.
+ */
+pal_gpio_t optiga_reset_0 =
+{
+    // Platform specific GPIO context for the pin used to toggle Reset.
+    (void*)&zephyr_reset_0
+};
+
+/**
+ * \brief PAL data ready interrupt pin configuration for OPTIGA.
+ */
+pal_gpio_t optiga_irq_0 =
+{
+    // Platform specific GPIO context for the pin signaling the data ready state.
+    (void*)&zephyr_irq_0
+};
+
+/**
+* @}
+*/
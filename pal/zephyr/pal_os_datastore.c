@@ -0,0 +1,174 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_os_datastore.c
+*
+* \brief   This file implements the platform abstraction layer APIs for data store.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/settings/settings.h>
+#include "optiga/common/optiga_lib_common.h"
+#include "optiga/pal/pal_os_datastore.h"
+
+/*
+* The datastore ids are stored with the settings subsystem (CONFIG_SETTINGS) under "optiga/<id>", e.g. "optiga/22" for
+* the manage context. The settings backend (NVS, ZMS or FCB) already appends the records to the flash with wear
+* leveling, hence OPTIGA_PAL_DATASTORE_LOG_ENABLED is not used on this platform.
+*/
+
+/// @cond hidden
+/// Subtree of the datastore ids in the settings
+#define PAL_OS_DATASTORE_SETTINGS_SUBTREE      "optiga"
+/// Length of the settings key of a datastore id ("optiga/" and 4 hex digits)
+#define PAL_OS_DATASTORE_SETTINGS_KEY_LENGTH   (sizeof(PAL_OS_DATASTORE_SETTINGS_SUBTREE) + 5)
+
+/// Size of length field 
+#define LENGTH_SIZE                (0x02)
+
+//Default platform binding shared secret on Host (length field + shared secret), used until a secret is stored
+static const uint8_t optiga_platform_binding_shared_secret [LENGTH_SIZE + OPTIGA_SHARED_SECRET_MAX_LENGTH] = 
+{
+    // Length of the shared secret, followed after the length information
+    0x00 ,0x40, 
+    // Shared secret. Buffer is defined to the maximum supported length [64 bytes]. 
+    // But the actual size used is to be specified in the length field.
+    0x01 ,0x02 ,0x03 ,0x04 ,0x05 ,0x06 ,0x07 ,0x08 ,0x09 ,0x0A ,0x0B ,0x0C ,0x0D ,0x0E ,0x0F ,0x10,
+    0x11 ,0x12 ,0x13 ,0x14 ,0x15 ,0x16 ,0x17 ,0x18 ,0x19 ,0x1A ,0x1B ,0x1C ,0x1D ,0x1E ,0x1F ,0x20,
+    0x21 ,0x22 ,0x23 ,0x24 ,0x25 ,0x26 ,0x27 ,0x28 ,0x29 ,0x2A ,0x2B ,0x2C ,0x2D ,0x2E ,0x2F ,0x30,
+    0x31 ,0x32 ,0x33 ,0x34 ,0x35 ,0x36 ,0x37 ,0x38 ,0x39 ,0x3A ,0x3B ,0x3C ,0x3D ,0x3E ,0x3F ,0x40
+};
+
+// Destination of a value loaded from the settings
+typedef struct pal_os_datastore_load
+{
+    uint8_t * p_buffer;
+    uint16_t buffer_length;
+    int32_t read_length;
+} pal_os_datastore_load_t;
+
+static void pal_os_datastore_key(uint16_t datastore_id, char * p_key)
+{
+    (void)snprintf(p_key, PAL_OS_DATASTORE_SETTINGS_KEY_LENGTH, PAL_OS_DATASTORE_SETTINGS_SUBTREE "/%x", datastore_id);
+}
+
+// Invoked by settings_load_subtree_direct for the key and the keys below it
+static int pal_os_datastore_load_callback(const char * p_key,
+                                          size_t length,
+                                          settings_read_cb read_cb,
+                                          void * p_cb_arg,
+                                          void * p_param)
+{
+    pal_os_datastore_load_t * p_load = (pal_os_datastore_load_t *)p_param;
+    const char * p_next;
+
+    // Only the exact key is loaded, the value must fit into the buffer of the caller
+    if ((0 == settings_name_next(p_key, &p_next)) && (length <= p_load->buffer_length))
+    {
+        p_load->read_length = (int32_t)read_cb(p_cb_arg, p_load->p_buffer, length);
+    }
+    return 0;
+}
+
+static pal_status_t pal_os_datastore_init(void)
+{
+    // Initialized once, the following invocations return immediately
+    return (0 == settings_subsys_init()) ? PAL_STATUS_SUCCESS : PAL_STATUS_FAILURE;
+}
+/// @endcond
+
+pal_status_t pal_os_datastore_write(uint16_t datastore_id,
+                                    const uint8_t * p_buffer,
+                                    uint16_t length)
+{
+    char key[PAL_OS_DATASTORE_SETTINGS_KEY_LENGTH];
+
+    if ((OPTIGA_PLATFORM_BINDING_SHARED_SECRET_ID == datastore_id) && (length > OPTIGA_SHARED_SECRET_MAX_LENGTH))
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    if (PAL_STATUS_SUCCESS != pal_os_datastore_init())
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    pal_os_datastore_key(datastore_id, key);
+    // The NVS and ZMS backends do not write an unchanged value to the flash again
+    return (0 == settings_save_one(key, p_buffer, length)) ? PAL_STATUS_SUCCESS : PAL_STATUS_FAILURE;
+}
+
+
+pal_status_t pal_os_datastore_read(uint16_t datastore_id, 
+                                   uint8_t * p_buffer, 
+                                   uint16_t * p_buffer_length)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    char key[PAL_OS_DATASTORE_SETTINGS_KEY_LENGTH];
+    pal_os_datastore_load_t load = {p_buffer, *p_buffer_length, -1};
+    uint16_t data_length;
+
+    do
+    {
+        if (PAL_STATUS_SUCCESS != pal_os_datastore_init())
+        {
+            break;
+        }
+        pal_os_datastore_key(datastore_id, key);
+        if ((0 == settings_load_subtree_direct(key, pal_os_datastore_load_callback, &load)) && (load.read_length >= 0))
+        {
+            *p_buffer_length = (uint16_t)load.read_length;
+            return_status = PAL_STATUS_SUCCESS;
+            break;
+        }
+        if (OPTIGA_PLATFORM_BINDING_SHARED_SECRET_ID == datastore_id)
+        {
+            // !!!OPTIGA_LIB_PORTING_REQUIRED
+            // The default secret is used until the platform binding shared secret is stored during the runtime.
+            data_length = (uint16_t)((optiga_platform_binding_shared_secret[0] << 8) |
+                                     optiga_platform_binding_shared_secret[1]);
+            if (data_length <= *p_buffer_length)
+            {
+                memcpy(p_buffer, &optiga_platform_binding_shared_secret[LENGTH_SIZE], data_length);
+                *p_buffer_length = data_length;
+                return_status = PAL_STATUS_SUCCESS;
+            }
+            break;
+        }
+        *p_buffer_length = 0;
+    } while (0);
+
+    return return_status;
+}
+
+/**
+* @}
+*/
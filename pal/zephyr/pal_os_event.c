@@ -0,0 +1,168 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_os_event.c
+*
+* \brief   This file implements the platform abstraction layer APIs for os event/scheduler.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include "optiga/pal/pal_os_event.h"
+#include "optiga/pal/pal.h"
+#include "pal_zephyr.h"
+
+/// @cond hidden
+/// Number of events, one for each OPTIGA instance
+#ifdef OPTIGA_MAX_NUMBER_OF_INSTANCES
+#define PAL_OS_EVENT_MAX_INSTANCES OPTIGA_MAX_NUMBER_OF_INSTANCES
+#else
+#define PAL_OS_EVENT_MAX_INSTANCES (1)
+#endif
+
+/// Index of the event in the list
+#define PAL_OS_EVENT_INDEX(p_event)     ((uint32_t)((p_event) - pal_os_event_list))
+
+static pal_os_event_t pal_os_event_list[PAL_OS_EVENT_MAX_INSTANCES] = {0};
+
+/*
+* Each event has its own delayable work on the PAL work queue, hence the registered callback is never invoked from
+* the timer interrupt. The delay is rounded up to the next tick of the kernel, the resolution follows
+* CONFIG_SYS_CLOCK_TICKS_PER_SEC (e.g. 1000000 with a tickless kernel schedules in microseconds).
+*/
+static struct k_work_delayable pal_os_event_work_list[PAL_OS_EVENT_MAX_INSTANCES];
+static bool pal_os_event_work_initialized = false;
+
+static void pal_os_event_work_handler(struct k_work * p_work)
+{
+    struct k_work_delayable * p_delayable = k_work_delayable_from_work(p_work);
+    pal_os_event_t * p_pal_os_event = &pal_os_event_list[p_delayable - pal_os_event_work_list];
+    register_callback func = p_pal_os_event->callback_registered;
+
+    // Callback is registered again by the upper layer for the next expiry
+    if (NULL != func)
+    {
+        p_pal_os_event->callback_registered = NULL;
+        func(p_pal_os_event->callback_ctx);
+    }
+}
+/// @endcond
+
+void pal_os_event_start(pal_os_event_t * p_pal_os_event, register_callback callback, void * callback_args)
+{
+    if (FALSE == p_pal_os_event->is_event_triggered)
+    {
+        p_pal_os_event->is_event_triggered = TRUE;
+        pal_os_event_register_callback_oneshot(p_pal_os_event,callback,callback_args,1000);
+    }
+}
+
+void pal_os_event_stop(pal_os_event_t * p_pal_os_event)
+{
+    //lint --e{714} suppress "The API pal_os_event_stop is not exposed in header file but used as extern in 
+    //optiga_cmd.c"
+    p_pal_os_event->is_event_triggered = FALSE;
+}
+
+pal_os_event_t * pal_os_event_create(register_callback callback, void * callback_args)
+{
+    pal_os_event_t * p_pal_os_event = &pal_os_event_list[0];
+    uint8_t index;
+
+    if (!pal_os_event_work_initialized)
+    {
+        for (index = 0; index < PAL_OS_EVENT_MAX_INSTANCES; index++)
+        {
+            k_work_init_delayable(&pal_os_event_work_list[index], pal_os_event_work_handler);
+        }
+        pal_os_event_work_initialized = true;
+    }
+
+    if (( NULL != callback )&&( NULL != callback_args ))
+    {
+        // Pick the first event, which is not in use by another OPTIGA instance
+        for (index = 0; index < PAL_OS_EVENT_MAX_INSTANCES; index++)
+        {
+            if (NULL == pal_os_event_list[index].os_timer)
+            {
+                break;
+            }
+        }
+        if (PAL_OS_EVENT_MAX_INSTANCES == index)
+        {
+            return (NULL);
+        }
+        p_pal_os_event = &pal_os_event_list[index];
+        p_pal_os_event->os_timer = &pal_os_event_work_list[index];
+        pal_os_event_start(p_pal_os_event,callback,callback_args);
+    }
+    return (p_pal_os_event);
+}
+
+void pal_os_event_trigger_registered_callback(void)
+{
+    // The registered callbacks are invoked by the work handler of the events, hence the pending ones are expired now
+    uint8_t index;
+
+    for (index = 0; index < PAL_OS_EVENT_MAX_INSTANCES; index++)
+    {
+        if (NULL != pal_os_event_list[index].callback_registered)
+        {
+            (void)k_work_reschedule_for_queue(&pal_zephyr_work_q, &pal_os_event_work_list[index], K_NO_WAIT);
+        }
+    }
+}
+
+void pal_os_event_register_callback_oneshot(pal_os_event_t * p_pal_os_event,
+                                            register_callback callback,
+                                            void * callback_args,
+                                            uint32_t time_us)
+{
+    p_pal_os_event->callback_registered = callback;
+    p_pal_os_event->callback_ctx = callback_args;
+
+    // Safe from the interrupt context (e.g. the data ready interrupt), a pending expiry is replaced
+    (void)k_work_reschedule_for_queue(&pal_zephyr_work_q,
+                                      &pal_os_event_work_list[PAL_OS_EVENT_INDEX(p_pal_os_event)],
+                                      K_USEC(time_us));
+}
+
+void pal_os_event_destroy(pal_os_event_t * pal_os_event)
+{
+    (void)k_work_cancel_delayable(&pal_os_event_work_list[PAL_OS_EVENT_INDEX(pal_os_event)]);
+    pal_os_event->callback_registered = NULL;
+    pal_os_event->is_event_triggered = FALSE;
+    // event is free for next create
+    pal_os_event->os_timer = NULL;
+}
+
+/**
+* @}
+*/
@@ -0,0 +1,101 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_os_memory.c
+*
+* \brief   This file implements the platform abstraction layer APIs for memory.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include <zephyr/kernel.h>
+#include <string.h>
+#include "optiga/pal/pal_os_memory.h"
+
+void * pal_os_malloc(uint32_t block_size)
+{
+#ifdef OPTIGA_LIB_MEMORY_POOL_ENABLED
+    void * p_block = pal_os_memory_pool_alloc(block_size);
+
+    return ((NULL != p_block) ? p_block : k_malloc(block_size));
+#else
+    return (k_malloc(block_size));
+#endif //OPTIGA_LIB_MEMORY_POOL_ENABLED
+}
+
+void * pal_os_calloc(uint32_t number_of_blocks , uint32_t block_size)
+{
+#ifdef OPTIGA_LIB_MEMORY_POOL_ENABLED
+    void * p_block = NULL;
+
+    // Overflowing sizes are left to the platform heap
+    if ((0 == number_of_blocks) || (block_size <= (0xFFFFFFFFU / number_of_blocks)))
+    {
+        p_block = pal_os_memory_pool_alloc(number_of_blocks * block_size);
+    }
+    if (NULL != p_block)
+    {
+        memset(p_block, 0, number_of_blocks * block_size);
+    }
+    else
+    {
+        p_block = k_calloc(number_of_blocks, block_size);
+    }
+    return (p_block);
+#else
+    return (k_calloc(number_of_blocks, block_size));
+#endif //OPTIGA_LIB_MEMORY_POOL_ENABLED
+}
+
+void pal_os_free(void * p_block)
+{
+#ifdef OPTIGA_LIB_MEMORY_POOL_ENABLED
+    if (FALSE == pal_os_memory_pool_free(p_block))
+    {
+        k_free(p_block);
+    }
+#else
+    k_free(p_block);
+#endif //OPTIGA_LIB_MEMORY_POOL_ENABLED
+}
+
+void pal_os_memcpy(void * p_destination, const void * p_source, uint32_t size)
+{
+    memcpy(p_destination, p_source, size);
+}
+
+void pal_os_memset(void * p_buffer, uint32_t value, uint32_t size)
+{
+    memset(p_buffer, (int32_t)value, size);
+}
+
+/**
+* @}
+*/
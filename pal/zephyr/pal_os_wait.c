@@ -0,0 +1,109 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_os_wait.c
+*
+* \brief   This file implements the platform abstraction layer APIs for wait objects.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#include "optiga/pal/pal_os_wait.h"
+#include <zephyr/kernel.h>
+
+/// @cond hidden
+/// Number of the wait objects, which are used at the same time (e.g. one per OPTIGA instance and layer)
+#ifndef PAL_OS_WAIT_MAX_OBJECTS
+#define PAL_OS_WAIT_MAX_OBJECTS     (4)
+#endif
+
+// Semaphores of the wait objects, taken from the pool without the kernel heap
+static struct k_sem pal_os_wait_sem_list[PAL_OS_WAIT_MAX_OBJECTS];
+static atomic_t pal_os_wait_sem_used = ATOMIC_INIT(0);
+/// @endcond
+
+pal_status_t pal_os_wait_create(pal_os_wait_t * p_wait)
+{
+    pal_status_t return_status = PAL_STATUS_FAILURE;
+    uint8_t index;
+
+    for (index = 0; index < PAL_OS_WAIT_MAX_OBJECTS; index++)
+    {
+        if (!atomic_test_and_set_bit(&pal_os_wait_sem_used, index))
+        {
+            (void)k_sem_init(&pal_os_wait_sem_list[index], 0, 1);
+            p_wait->os_wait_object = (void *)&pal_os_wait_sem_list[index];
+            p_wait->is_signaled = FALSE;
+            return_status = PAL_STATUS_SUCCESS;
+            break;
+        }
+    }
+    return return_status;
+}
+
+void pal_os_wait_destroy(pal_os_wait_t * p_wait)
+{
+    if (NULL != p_wait->os_wait_object)
+    {
+        atomic_clear_bit(&pal_os_wait_sem_used,
+                         (int)((struct k_sem *)p_wait->os_wait_object - pal_os_wait_sem_list));
+        p_wait->os_wait_object = NULL;
+    }
+}
+
+void pal_os_wait_for_signal(pal_os_wait_t * p_wait)
+{
+    (void)k_sem_take((struct k_sem *)p_wait->os_wait_object, K_FOREVER);
+    p_wait->is_signaled = FALSE;
+}
+
+bool_t pal_os_wait_clear_signal(pal_os_wait_t * p_wait)
+{
+    p_wait->is_signaled = FALSE;
+    return (0 == k_sem_take((struct k_sem *)p_wait->os_wait_object, K_NO_WAIT)) ? TRUE : FALSE;
+}
+
+//lint --e{715} suppress "p_wait is not used here as there is no pollable descriptor."
+int32_t pal_os_wait_get_descriptor(const pal_os_wait_t * p_wait)
+{
+    // The semaphore can be waited for along with other kernel objects with k_poll (K_POLL_TYPE_SEM_AVAILABLE)
+    return (-1);
+}
+
+void pal_os_wait_signal(pal_os_wait_t * p_wait)
+{
+    // Callbacks are invoked from the PAL work queue
+    p_wait->is_signaled = TRUE;
+    k_sem_give((struct k_sem *)p_wait->os_wait_object);
+}
+
+/**
+* @}
+*/
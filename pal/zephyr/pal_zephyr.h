@@ -0,0 +1,113 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2020 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_zephyr.h
+*
+* \brief   This file provides the prototype declarations w.r.t Zephyr.
+*
+* \ingroup  grPAL
+*
+* @{
+*/
+
+#ifndef _PAL_ZEPHYR_H_
+#define _PAL_ZEPHYR_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/gpio.h>
+#include "optiga/pal/pal.h"
+#include "optiga/pal/pal_gpio.h"
+
+/**
+ * Stack size of the PAL work queue in bytes.
+ * The I2C completions and the expired events run the protocol stack (including the shielded connection) on it.
+ */
+#ifdef CONFIG_OPTIGA_PAL_WORK_Q_STACK_SIZE
+#define PAL_ZEPHYR_WORK_Q_STACK_SIZE                CONFIG_OPTIGA_PAL_WORK_Q_STACK_SIZE
+#else
+#define PAL_ZEPHYR_WORK_Q_STACK_SIZE                (4096)
+#endif
+
+/// Priority of the PAL work queue, cooperative so that a transfer is not preempted by the application threads
+#ifdef CONFIG_OPTIGA_PAL_WORK_Q_PRIORITY
+#define PAL_ZEPHYR_WORK_Q_PRIORITY                  CONFIG_OPTIGA_PAL_WORK_Q_PRIORITY
+#else
+#define PAL_ZEPHYR_WORK_Q_PRIORITY                  K_PRIO_COOP(7)
+#endif
+
+/**
+ * @brief PAL I2C context structure, one per I2C bus.
+ *
+ * The devices on the same bus share one context, hence the bus is arbitrated between them.
+ */
+typedef struct pal_zephyr_i2c
+{
+    /// I2C bus device (e.g. DEVICE_DT_GET(DT_NODELABEL(i2c0)))
+    const struct device * bus;
+    /// Context of the device, which holds the bus
+    const void * p_current_ctx;
+    /// Message of the transfer in progress, it must remain valid until the completion
+    struct i2c_msg msg;
+    /// Result of the last transfer (0 or negative errno)
+    int result;
+    /// Informs the upper layer about the completion on the PAL work queue
+    struct k_work completion_work;
+    /// Indicates the bus is acquired
+    atomic_t entry_count;
+} pal_zephyr_i2c_t;
+
+/**
+ * @brief PAL GPIO context structure, one per pin.
+ */
+typedef struct pal_zephyr_gpio
+{
+    /// Pin from the devicetree (e.g. GPIO_DT_SPEC_GET(DT_NODELABEL(optiga), reset_gpios))
+    struct gpio_dt_spec spec;
+    /// Callback of the interrupt of the pin
+    struct gpio_callback callback;
+    /// Handler registered by pal_gpio_register_irq
+    pal_gpio_irq_handler_t irq_handler;
+    /// Context provided to the handler
+    void * irq_context;
+} pal_zephyr_gpio_t;
+
+/**
+ * @brief Work queue, on which the PAL informs the upper layers.
+ *
+ * The I2C completions and the expired events are serialized on it, hence the protocol stack is never invoked from an
+ * interrupt and never runs concurrently with itself. The application threads are not blocked by a transfer.
+ * The queue is started at boot (SYS_INIT in pal.c).
+ */
+extern struct k_work_q pal_zephyr_work_q;
+
+#endif /* _PAL_ZEPHYR_H_ */
+
+/**
+* @}
+*/